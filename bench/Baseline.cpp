@@ -0,0 +1,302 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include "Baseline.h"
+
+namespace {
+
+// enough of JSON for the benchmark files: objects, arrays, strings, numbers
+// and the literals, the last three kept as text
+struct Json {
+    enum Kind { object, array, string, scalar } kind = scalar;
+    std::string text;
+    std::vector<Json> items;
+    std::vector<std::pair<std::string, Json>> members;
+
+    const Json* find(const std::string& key) const {
+        for (const auto& m : this->members) {
+            if (m.first == key) {
+                return &m.second;
+            }
+        }
+        return nullptr;
+    }
+};
+
+class Parser {
+public:
+    Parser(const std::string& in, const std::string& path) : in(in), path(path), at(0) {}
+
+    Json document() {
+        Json out = value();
+        skip();
+        if (this->at != this->in.size()) {
+            fail("trailing characters");
+        }
+        return out;
+    }
+
+private:
+    [[noreturn]] void fail(const char* what) const {
+        throw std::runtime_error("Cannot parse baseline " + this->path + ": " + what + " at byte "
+                                 + std::to_string(this->at));
+    }
+
+    void skip() {
+        while (this->at < this->in.size() && std::isspace(static_cast<unsigned char>(this->in[this->at]))) {
+            this->at++;
+        }
+    }
+
+    bool take(char c) {
+        skip();
+        if (this->at < this->in.size() && this->in[this->at] == c) {
+            this->at++;
+            return true;
+        }
+        return false;
+    }
+
+    std::string string() {
+        if (!take('"')) {
+            fail("expected a string");
+        }
+        std::string out;
+        while (this->at < this->in.size() && this->in[this->at] != '"') {
+            char c = this->in[this->at++];
+            if (c == '\\' && this->at < this->in.size()) {
+                c = this->in[this->at++];
+                c = c == 'n' ? '\n' : c == 't' ? '\t' : c;
+            }
+            out += c;
+        }
+        if (!take('"')) {
+            fail("unterminated string");
+        }
+        return out;
+    }
+
+    Json value() {
+        skip();
+        Json out;
+        if (this->at >= this->in.size()) {
+            fail("unexpected end");
+        }
+        const char c = this->in[this->at];
+        if (c == '{') {
+            this->at++;
+            out.kind = Json::object;
+            if (take('}')) {
+                return out;
+            }
+            do {
+                std::string key = string();
+                if (!take(':')) {
+                    fail("expected ':'");
+                }
+                out.members.emplace_back(std::move(key), value());
+            } while (take(','));
+            if (!take('}')) {
+                fail("expected '}'");
+            }
+        } else if (c == '[') {
+            this->at++;
+            out.kind = Json::array;
+            if (take(']')) {
+                return out;
+            }
+            do {
+                out.items.push_back(value());
+            } while (take(','));
+            if (!take(']')) {
+                fail("expected ']'");
+            }
+        } else if (c == '"') {
+            out.kind = Json::string;
+            out.text = string();
+        } else {
+            const std::size_t start = this->at;
+            static const std::string ends = ",}] \t\r\n";
+            while (this->at < this->in.size() && ends.find(this->in[this->at]) == std::string::npos) {
+                this->at++;
+            }
+            if (start == this->at) {
+                fail("expected a value");
+            }
+            out.text = this->in.substr(start, this->at - start);
+        }
+        return out;
+    }
+
+    const std::string& in;
+    const std::string& path;
+    std::size_t at;
+};
+
+// name without its /repeats:N part
+std::string without_repeats(std::string name) {
+    const std::size_t at = name.find("/repeats:");
+    if (at != std::string::npos) {
+        const std::size_t end = name.find('/', at + 1);
+        name.erase(at, end == std::string::npos ? std::string::npos : end - at);
+    }
+    return name;
+}
+
+double nanoseconds_per(const std::string& unit) {
+    return unit == "us" ? 1e3 : unit == "ms" ? 1e6 : unit == "s" ? 1e9 : 1;
+}
+
+// the 97.5% point of Student's t with df degrees of freedom, rounded down to
+// a whole df (which widens the interval slightly)
+double t_quantile(double df) {
+    static const double table[] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+                                   2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+                                   2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    const std::size_t d = static_cast<std::size_t>(std::max(1.0, std::floor(df)));
+    return d <= 30 ? table[d - 1] : d <= 60 ? 2.000 : d <= 120 ? 1.980 : 1.960;
+}
+
+void mean_variance(const std::vector<double>& x, double& mean, double& variance) {
+    mean = 0;
+    for (double v : x) {
+        mean += v;
+    }
+    mean /= static_cast<double>(x.size());
+    variance = 0;
+    for (double v : x) {
+        variance += (v - mean) * (v - mean);
+    }
+    variance = x.size() > 1 ? variance / static_cast<double>(x.size() - 1) : 0;
+}
+
+}
+
+BaselineSamples read_baseline(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Cannot read baseline " + path);
+    }
+    std::stringstream text;
+    text << file.rdbuf();
+    const std::string in = text.str();
+    const Json document = Parser(in, path).document();
+    const Json* benchmarks = document.find("benchmarks");
+    if (!benchmarks || benchmarks->kind != Json::array) {
+        throw std::runtime_error("Cannot parse baseline " + path + ": no benchmarks array");
+    }
+    BaselineSamples out;
+    for (const Json& b : benchmarks->items) {
+        const Json* type = b.find("run_type");
+        const Json* name = b.find("run_name") ? b.find("run_name") : b.find("name");
+        const Json* time = b.find("real_time");
+        const Json* unit = b.find("time_unit");
+        if ((type && type->text != "iteration") || !name || !time || b.find("error_occurred")) {
+            continue;
+        }
+        double ns;
+        try {
+            ns = std::stod(time->text) * nanoseconds_per(unit ? unit->text : "ns");
+        } catch (const std::logic_error&) {
+            throw std::runtime_error("Cannot parse baseline " + path + ": bad time " + time->text);
+        }
+        out[without_repeats(name->text)].push_back(ns);
+    }
+    return out;
+}
+
+void write_baseline(const std::string& path, const BaselineSamples& samples) {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) {
+        throw std::runtime_error("Cannot write baseline " + path);
+    }
+    char date[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+    std::fprintf(f, "{\n  \"context\": {\"date\": \"%s\", \"executable\": \"ecc_bench\"},\n  \"benchmarks\": [", date);
+    bool first = true;
+    for (const auto& named : samples) {
+        std::string name;
+        for (char c : named.first) {
+            name += c == '"' || c == '\\' ? std::string("\\") + c : std::string(1, c);
+        }
+        for (std::size_t i = 0; i < named.second.size(); i++) {
+            std::fprintf(f, "%s\n    {\"name\": \"%s\", \"run_name\": \"%s\", \"run_type\": \"iteration\", "
+                            "\"repetition_index\": %zu, \"real_time\": %.17g, \"time_unit\": \"ns\"}",
+                         first ? "" : ",", name.c_str(), name.c_str(), i, named.second[i]);
+            first = false;
+        }
+    }
+    std::fprintf(f, "\n  ]\n}\n");
+    if (std::fclose(f) != 0) {
+        throw std::runtime_error("Cannot write baseline " + path);
+    }
+}
+
+Comparison compare_samples(const std::string& name, const std::vector<double>& baseline,
+                           const std::vector<double>& current, double threshold) {
+    Comparison c{name, 0, 0, 0, 0, 0, false, false, false};
+    double vb, vc;
+    mean_variance(baseline, c.baseline_mean, vb);
+    mean_variance(current, c.current_mean, vc);
+    c.change = (c.current_mean - c.baseline_mean) / c.baseline_mean;
+    c.interval = baseline.size() > 1 && current.size() > 1;
+    if (!c.interval) {
+        c.low = c.high = c.change;
+        return c;
+    }
+    const double sb = vb / baseline.size(), sc = vc / current.size();
+    const double se = std::sqrt(sb + sc);
+    // Welch-Satterthwaite; identical samples on both sides leave no spread at all
+    const double df = se > 0 ? (sb + sc) * (sb + sc) / (sb * sb / (baseline.size() - 1)
+                                                        + sc * sc / (current.size() - 1)) : 1e9;
+    const double half = t_quantile(df) * se / c.baseline_mean;
+    c.low = c.change - half;
+    c.high = c.change + half;
+    c.regressed = c.low > 0 && c.change > threshold;
+    c.improved = c.high < 0 && c.change < -threshold;
+    return c;
+}
+
+std::size_t report_comparisons(const BaselineSamples& baseline, const BaselineSamples& current, double threshold) {
+    std::size_t width = 9;
+    for (const auto& named : current) {
+        width = std::max(width, named.first.size());
+    }
+    std::printf("\n%-*s %14s %14s %9s %21s\n", static_cast<int>(width), "benchmark", "baseline ns", "current ns",
+                "change", "95% interval");
+    std::size_t regressions = 0;
+    for (const auto& named : current) {
+        const auto base = baseline.find(named.first);
+        if (base == baseline.end()) {
+            std::printf("%-*s (not in the baseline)\n", static_cast<int>(width), named.first.c_str());
+            continue;
+        }
+        const Comparison c = compare_samples(named.first, base->second, named.second, threshold);
+        char interval[40] = "(one sample)";
+        if (c.interval) {
+            std::snprintf(interval, sizeof(interval), "[%+.1f%%, %+.1f%%]", 100 * c.low, 100 * c.high);
+        }
+        std::printf("%-*s %14.1f %14.1f %+8.1f%% %21s%s\n", static_cast<int>(width), c.name.c_str(),
+                    c.baseline_mean, c.current_mean, 100 * c.change, interval,
+                    c.regressed ? "  REGRESSION" : c.improved ? "  improved" : "");
+        regressions += c.regressed;
+    }
+    for (const auto& named : baseline) {
+        if (!current.count(named.first)) {
+            std::printf("%-*s (not run)\n", static_cast<int>(width), named.first.c_str());
+        }
+    }
+    std::printf("%zu regression%s beyond %.1f%%\n", regressions, regressions == 1 ? "" : "s", 100 * threshold);
+    return regressions;
+}
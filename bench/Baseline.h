@@ -0,0 +1,48 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_BASELINE_H
+#define ECC_BASELINE_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+// ecc_bench's regression gate: the real time per iteration of every
+// repetition of every benchmark, in nanoseconds, by name (without the
+// /repeats: part, so baselines of different repetition counts compare)
+typedef std::map<std::string, std::vector<double>> BaselineSamples;
+
+// the iteration runs of a JSON file this wrote or Google Benchmark's
+// --benchmark_out wrote; throws std::runtime_error if it cannot be read or parsed
+BaselineSamples read_baseline(const std::string& path);
+// samples as JSON in the shape of --benchmark_out's; throws std::runtime_error
+// if the file cannot be written
+void write_baseline(const std::string& path, const BaselineSamples& samples);
+
+// A benchmark's current samples against its baseline: the difference of the
+// means with its 95% confidence interval by Welch's t-test, each relative to
+// the baseline mean. It regressed when the whole interval is above zero and
+// the change is above threshold, and improved in the mirror case; with fewer
+// than two samples on either side there is no interval and no verdict.
+struct Comparison {
+    std::string name;
+    double baseline_mean;
+    double current_mean;
+    double change;      // (current - baseline) / baseline
+    double low, high;   // the confidence interval of change
+    bool interval;
+    bool regressed;
+    bool improved;
+};
+
+Comparison compare_samples(const std::string& name, const std::vector<double>& baseline,
+                           const std::vector<double>& current, double threshold);
+
+// the table of comparisons of every benchmark in both, and the names of those
+// in only one; returns the number that regressed
+std::size_t report_comparisons(const BaselineSamples& baseline, const BaselineSamples& current, double threshold);
+
+#endif //ECC_BASELINE_H
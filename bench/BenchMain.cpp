@@ -0,0 +1,102 @@
+//
+// Created by preston on 10/15/2026.
+//
+// ecc_bench's main: Google Benchmark's, plus a regression gate against a
+// stored baseline.
+//
+//     ecc_bench [benchmark flags] [--save_baseline=FILE] [--baseline=FILE]
+//               [--regression_threshold=0.05]
+//
+// --save_baseline writes every repetition's real time per iteration as JSON;
+// --baseline compares this run with such a file (or one --benchmark_out
+// wrote) benchmark by benchmark, and exits with 1 if any regressed: slower by
+// more than the threshold with the 95% interval of the change above zero (see
+// Baseline.h). Either runs each benchmark 10 times unless
+// --benchmark_repetitions says otherwise, as the interval needs repetitions.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+
+#include "Baseline.h"
+#include "benchmark/benchmark.h"
+
+namespace {
+
+// the console output as usual, with the real time of every repetition kept
+class SampleReporter : public benchmark::ConsoleReporter {
+public:
+    void ReportRuns(const std::vector<Run>& runs) override {
+        for (const Run& run : runs) {
+            if (run.run_type != Run::RT_Iteration || run.iterations == 0) {
+                continue;
+            }
+            benchmark::BenchmarkName name = run.run_name;
+            name.repetitions.clear();
+            this->samples[name.str()].push_back(run.GetAdjustedRealTime() * 1e9
+                                                / benchmark::GetTimeUnitMultiplier(run.time_unit));
+        }
+        ConsoleReporter::ReportRuns(runs);
+    }
+
+    BaselineSamples samples;
+};
+
+// the value of --name=value at argv[i], or null if argv[i] is another flag
+const char* flag(const char* arg, const char* name) {
+    const std::size_t n = std::strlen(name);
+    return std::strncmp(arg, name, n) == 0 && arg[n] == '=' ? arg + n + 1 : nullptr;
+}
+
+}
+
+int main(int argc, char** argv) {
+    std::string baseline, save;
+    double threshold = 0.05;
+    bool repetitions = false;
+    std::vector<char*> args;
+    for (int i = 0; i < argc; i++) {
+        if (const char* v = flag(argv[i], "--baseline")) {
+            baseline = v;
+        } else if (const char* v = flag(argv[i], "--save_baseline")) {
+            save = v;
+        } else if (const char* v = flag(argv[i], "--regression_threshold")) {
+            threshold = std::atof(v);
+        } else {
+            repetitions = repetitions || flag(argv[i], "--benchmark_repetitions");
+            args.push_back(argv[i]);
+        }
+    }
+    static char ten[] = "--benchmark_repetitions=10";
+    if ((!baseline.empty() || !save.empty()) && !repetitions) {
+        args.push_back(ten);
+    }
+    int count = static_cast<int>(args.size());
+    args.push_back(nullptr);
+
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) {
+        return 2;
+    }
+    try {
+        // read first, so a bad path fails before the benchmarks run
+        const BaselineSamples stored = baseline.empty() ? BaselineSamples() : read_baseline(baseline);
+        SampleReporter reporter;
+        benchmark::RunSpecifiedBenchmarks(&reporter);
+        benchmark::Shutdown();
+        if (!save.empty()) {
+            write_baseline(save, reporter.samples);
+            std::printf("baseline written to %s\n", save.c_str());
+        }
+        if (!baseline.empty()) {
+            return report_comparisons(stored, reporter.samples, threshold) ? 1 : 0;
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "ecc_bench: %s\n", e.what());
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,314 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <unordered_set>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "BinaryField.h"
+#include "chacha20.h"
+#include "Curve.h"
+#include "ExtensionField.h"
+#include "FieldElement.h"
+#include "FieldVector.h"
+#include "PerfCounters.h"
+#include "Polynomial.h"
+
+// range(0): 0 for the Mersenne prime 2^31 - 1, 1 for the secp256k1 prime (the
+// fixed-width kernels), 2 for the 384-bit prime of P-384 (integer arithmetic)
+static const PrimeField& bench_field(int64_t which) {
+    if (which == 0) {
+        return PrimeField::get(integer(2147483647));
+    }
+    return which == 1 ? Curve::secp256k1().field() : Curve::p384().field();
+}
+
+static FieldElement element(const PrimeField& field, int seed) {
+    return FieldElement(integer(seed), field).power(integer(1000003));
+}
+
+static void BM_FieldAdd(benchmark::State& state) {
+    const PrimeField& field = bench_field(state.range(0));
+    const FieldElement a = element(field, 3), b = element(field, 5);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a + b);
+    }
+}
+BENCHMARK(BM_FieldAdd)->DenseRange(0, 2);
+
+static void BM_FieldMul(benchmark::State& state) {
+    const PrimeField& field = bench_field(state.range(0));
+    const FieldElement a = element(field, 3), b = element(field, 5);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a * b);
+    }
+}
+BENCHMARK(BM_FieldMul)->DenseRange(0, 2);
+
+static void BM_FieldSquare(benchmark::State& state) {
+    const FieldElement a = element(bench_field(state.range(0)), 3);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.square());
+    }
+}
+BENCHMARK(BM_FieldSquare)->DenseRange(0, 2);
+
+static void BM_FieldInverse(benchmark::State& state) {
+    const PrimeField& field = bench_field(state.range(0));
+    const FieldElement one(1, field), a = element(field, 3);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(one / a);
+    }
+}
+BENCHMARK(BM_FieldInverse)->DenseRange(0, 2);
+
+// range(1) inversions at once, per element
+static void BM_FieldBatchInvert(benchmark::State& state) {
+    const PrimeField& field = bench_field(state.range(0));
+    std::vector<FieldElement> elements;
+    for (int64_t i = 0; i < state.range(1); i++) {
+        elements.push_back(element(field, static_cast<int>(i + 2)));
+    }
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        FieldElement::batch_invert(elements);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_FieldBatchInvert)->ArgsProduct({{1, 2}, {16, 256, 4096}});
+
+// range(0): 0 for the portable block function, 1 for the AVX2 kernel
+static void BM_ChaCha20Blocks(benchmark::State& state) {
+    const ChaCha20Kernel* kernel = state.range(0) ? avx2_chacha20_kernel() : nullptr;
+    if (state.range(0) && !kernel) {
+        state.SkipWithError("no AVX2");
+        return;
+    }
+    const uint32_t key[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    const uint32_t nonce[2] = {0, 0};
+    std::vector<uint8_t> out(64 * ChaCha20Rng::BLOCKS);
+    uint64_t counter = 0;
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        chacha20_blocks(out.data(), key, counter, nonce, ChaCha20Rng::BLOCKS, kernel);
+        counter += ChaCha20Rng::BLOCKS;
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(state.iterations() * out.size());
+}
+BENCHMARK(BM_ChaCha20Blocks)->DenseRange(0, 1);
+
+// 4096 uniform elements of the secp256k1 field at once, per element
+static void BM_FieldVectorRandom(benchmark::State& state) {
+    const PrimeField& field = Curve::secp256k1().field();
+    ChaCha20Rng rng;
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(FieldVector::random(field, 4096, rng));
+    }
+    state.SetItemsProcessed(state.iterations() * 4096);
+}
+BENCHMARK(BM_FieldVectorRandom);
+
+// the Legendre exponent (p - 1) / 2 over 1024 elements, per element: range(0)
+// 0 for FieldElement::power one at a time, 1 for FieldVector::pow on one
+// thread, 2 on the shared pool; range(1) 0 for the secp256k1 prime (its fold),
+// 1 for the BN254 prime (Montgomery form)
+static void BM_FieldVectorPow(benchmark::State& state) {
+    const PrimeField& field = state.range(1) ? PrimeField::get(integer(
+            "30644e72e131a029b85045b68181585d97816a916871ca8d3c208c16d87cfd47", 16)) : Curve::secp256k1().field();
+    std::vector<FieldElement> elements;
+    for (int i = 0; i < 1024; i++) {
+        elements.push_back(element(field, i + 2));
+    }
+    const FieldVector v(field, elements);
+    const integer& e = field.legendre_exponent();
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        if (state.range(0) == 0) {
+            for (const FieldElement& x : elements) {
+                benchmark::DoNotOptimize(x.power(e));
+            }
+        } else if (state.range(0) == 1) {
+            benchmark::DoNotOptimize(v.pow(e));
+        } else {
+            benchmark::DoNotOptimize(v.pow(e, WorkStealingPool::shared()));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_FieldVectorPow)->ArgsProduct({{0, 1, 2}, {0, 1}})->Unit(benchmark::kMicrosecond);
+
+// lookups in a set of 4096 elements, half of them present
+static void BM_FieldHashLookup(benchmark::State& state) {
+    const PrimeField& field = bench_field(state.range(0));
+    std::vector<FieldElement> keys;
+    for (int i = 0; i < 8192; i++) {
+        keys.push_back(element(field, i + 2));
+    }
+    const std::unordered_set<FieldElement> set(keys.begin(), keys.begin() + 4096);
+    PerfCounters perf(state);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(set.count(keys[i++ & 8191]));
+    }
+}
+BENCHMARK(BM_FieldHashLookup)->DenseRange(0, 2);
+
+// range(0): 0 for the BN254 tower (fixed-width kernels), 1 for BLS12-381 (lazy
+// reduction of the wide products)
+static Fp12 tower_element(const ExtensionTower& tower, int seed) {
+    const PrimeField& field = tower.prime_field();
+    std::vector<Fp6> halves;
+    for (int h = 0; h < 2; h++) {
+        std::vector<Fp2> c;
+        for (int i = 0; i < 3; i++) {
+            c.emplace_back(element(field, seed + 6 * h + 2 * i), element(field, seed + 6 * h + 2 * i + 1));
+        }
+        halves.emplace_back(tower, c[0], c[1], c[2]);
+    }
+    return Fp12(halves[0], halves[1]);
+}
+
+static void BM_Fp12Mul(benchmark::State& state) {
+    const ExtensionTower& tower = state.range(0) == 0 ? ExtensionTower::bn254() : ExtensionTower::bls12_381();
+    Fp12 a = tower_element(tower, 3);
+    const Fp12 b = tower_element(tower, 17);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        a *= b;
+        benchmark::DoNotOptimize(a);
+    }
+}
+BENCHMARK(BM_Fp12Mul)->DenseRange(0, 1);
+
+static void BM_Fp12Square(benchmark::State& state) {
+    const ExtensionTower& tower = state.range(0) == 0 ? ExtensionTower::bn254() : ExtensionTower::bls12_381();
+    Fp12 a = tower_element(tower, 3);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        a = a.square();
+        benchmark::DoNotOptimize(a);
+    }
+}
+BENCHMARK(BM_Fp12Square)->DenseRange(0, 1);
+
+static void BM_Fp12Frobenius(benchmark::State& state) {
+    const ExtensionTower& tower = state.range(0) == 0 ? ExtensionTower::bn254() : ExtensionTower::bls12_381();
+    Fp12 a = tower_element(tower, 3);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        a = a.frobenius(1);
+        benchmark::DoNotOptimize(a);
+    }
+}
+BENCHMARK(BM_Fp12Frobenius)->DenseRange(0, 1);
+
+// range(0): 0 for sect233's trinomial, 1 for sect283's pentanomial, through
+// the best carry-less kernel
+static const BinaryField& bench_binary_field(int64_t which) {
+    return which == 0 ? BinaryField::sect233() : BinaryField::sect283();
+}
+
+static void BM_BinaryFieldMul(benchmark::State& state) {
+    const BinaryField& field = bench_binary_field(state.range(0));
+    BinaryFieldElement a((integer(1) << (field.degree() - 1)) - 12345, field);
+    const BinaryFieldElement b((integer(1) << (field.degree() - 2)) + 54321, field);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        a *= b;
+        benchmark::DoNotOptimize(a);
+    }
+    state.SetLabel(clmul_kernel().name);
+}
+BENCHMARK(BM_BinaryFieldMul)->DenseRange(0, 1);
+
+static void BM_BinaryFieldInverse(benchmark::State& state) {
+    const BinaryField& field = bench_binary_field(state.range(0));
+    BinaryFieldElement a((integer(1) << (field.degree() - 1)) - 12345, field);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        a = a.inverse();
+        benchmark::DoNotOptimize(a);
+    }
+}
+BENCHMARK(BM_BinaryFieldInverse)->DenseRange(0, 1);
+
+// range(0): 0 for the BLS12-381 group order (the transform), 1 for the
+// secp256k1 order (Karatsuba); range(1) is the number of coefficients of each factor
+static Polynomial bench_polynomial(const PrimeField& field, std::size_t n, int seed) {
+    std::vector<FieldElement> c;
+    for (std::size_t i = 0; i < n; i++) {
+        c.push_back(element(field, seed + static_cast<int>(i)));
+    }
+    return Polynomial(field, std::move(c));
+}
+
+static void BM_PolynomialMul(benchmark::State& state) {
+    const PrimeField& field = state.range(0) == 0 ? Curve::bls12_381().scalar_field() : Curve::secp256k1().scalar_field();
+    const Polynomial a = bench_polynomial(field, state.range(1), 3), b = bench_polynomial(field, state.range(1), 7);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a * b);
+    }
+}
+BENCHMARK(BM_PolynomialMul)->ArgsProduct({{0, 1}, {256, 4096}});
+
+static void BM_PolynomialDivide(benchmark::State& state) {
+    const PrimeField& field = Curve::bls12_381().scalar_field();
+    const Polynomial a = bench_polynomial(field, 2 * state.range(0), 3), b = bench_polynomial(field, state.range(0), 7);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.divmod(b));
+    }
+}
+BENCHMARK(BM_PolynomialDivide)->Arg(4096);
+
+static std::vector<FieldElement> bench_points(const PrimeField& field, std::size_t n) {
+    std::vector<FieldElement> xs;
+    for (std::size_t i = 0; i < n; i++) {
+        xs.emplace_back(integer(static_cast<uint64_t>(i + 1)), field);
+    }
+    return xs;
+}
+
+// range(0): 0 for the O(n^2) Lagrange form, 1 for the subproduct tree
+// (built in the loop); range(1) is the number of points, 67 for a 67-of-100 sharing
+static void BM_Interpolate(benchmark::State& state) {
+    const PrimeField& field = Curve::secp256k1().scalar_field();
+    const std::vector<FieldElement> xs = bench_points(field, state.range(1));
+    const std::vector<FieldElement> ys = bench_polynomial(field, xs.size(), 5).evaluate(xs);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(state.range(0) == 0 ? lagrange_interpolate(xs, ys) : SubproductTree(xs).interpolate(ys));
+    }
+}
+BENCHMARK(BM_Interpolate)->ArgsProduct({{0, 1}, {67, 256, 1024}});
+
+// the secret of a 67-of-100 sharing, the interpolating polynomial at 0
+static void BM_LagrangeEvaluate(benchmark::State& state) {
+    const PrimeField& field = Curve::secp256k1().scalar_field();
+    const std::vector<FieldElement> xs = bench_points(field, 67);
+    const std::vector<FieldElement> ys = bench_polynomial(field, xs.size(), 5).evaluate(xs);
+    const FieldElement zero(0, field);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lagrange_evaluate(xs, ys, zero));
+    }
+}
+BENCHMARK(BM_LagrangeEvaluate);
+
+static void BM_MultipointEvaluate(benchmark::State& state) {
+    const PrimeField& field = Curve::bls12_381().scalar_field();
+    const SubproductTree tree(bench_points(field, state.range(0)));
+    const Polynomial p = bench_polynomial(field, state.range(0), 3);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tree.evaluate(p));
+    }
+}
+BENCHMARK(BM_MultipointEvaluate)->Arg(1024);
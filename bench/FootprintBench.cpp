@@ -0,0 +1,97 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "Curve.h"
+#include "PerfCounters.h"
+#include "Scalar.h"
+#include "uint256.h"
+
+// Bytes per element of each representation, for sizing caches of keys and
+// outputs: the timed loop copies ELEMENTS of them into a vector, and the
+// counters give what one held in a vector costs, sizeof plus heap_bytes()
+// ("bytes/elem"), and the heap part alone ("heap/elem")
+
+static const std::size_t ELEMENTS = 1024;
+
+static integer random_value(std::size_t bits, uint64_t seed) {
+    std::mt19937_64 random(seed);
+    std::vector<uint8_t> bytes((bits + 7) / 8);
+    for (uint8_t& b : bytes) {
+        b = static_cast<uint8_t>(random());
+    }
+    bytes[0] |= 0x80;
+    return integer::from_bytes(bytes.data(), bytes.size()) >> (bytes.size() * 8 - bits);
+}
+
+template <typename T, typename Heap>
+static void copy_and_count(benchmark::State& state, const std::vector<T>& values, Heap heap) {
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        std::vector<T> copy(values);
+        benchmark::DoNotOptimize(copy.data());
+    }
+    std::size_t held = 0;
+    for (const T& v : values) {
+        held += heap(v);
+    }
+    state.counters["heap/elem"] = static_cast<double>(held) / values.size();
+    state.counters["bytes/elem"] = static_cast<double>(held) / values.size() + sizeof(T);
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+
+// range(0): bits of the values
+static void BM_FootprintInteger(benchmark::State& state) {
+    std::vector<integer> values;
+    for (std::size_t i = 0; i < ELEMENTS; i++) {
+        values.push_back(random_value(state.range(0), i));
+    }
+    copy_and_count(state, values, [](const integer& v) { return v.heap_bytes(); });
+}
+BENCHMARK(BM_FootprintInteger)->Arg(64)->Arg(256)->Arg(512)->Arg(1024)->Arg(4096);
+
+// range(0): 0 for secp256k1's field, 1 for 2^521 - 1, which takes the wide path
+static void BM_FootprintFieldElement(benchmark::State& state) {
+    const integer prime = state.range(0) == 0 ? Curve::secp256k1().field().prime() : (integer(1) << 521) - 1;
+    const PrimeField& field = PrimeField::get(prime);
+    std::vector<FieldElement> values;
+    for (std::size_t i = 0; i < ELEMENTS; i++) {
+        values.emplace_back(random_value(prime.bit_length() - 1, i), field);
+    }
+    copy_and_count(state, values, [](const FieldElement& v) { return v.heap_bytes(); });
+}
+BENCHMARK(BM_FootprintFieldElement)->DenseRange(0, 1);
+
+// range(0): 0 for secp256k1, 1 for P-256
+static void BM_FootprintPoint(benchmark::State& state) {
+    const Curve& curve = state.range(0) == 0 ? Curve::secp256k1() : Curve::p256();
+    std::vector<Point> values;
+    for (std::size_t i = 0; i < ELEMENTS; i++) {
+        values.push_back((curve.generator() * random_value(255, i)).normalized());
+    }
+    copy_and_count(state, values, [](const Point& v) { return v.heap_bytes(); });
+}
+BENCHMARK(BM_FootprintPoint)->DenseRange(0, 1)->Unit(benchmark::kMicrosecond);
+
+static void BM_FootprintScalar(benchmark::State& state) {
+    const PrimeField& order = Curve::secp256k1().scalar_field();
+    std::vector<Scalar> values;
+    for (std::size_t i = 0; i < ELEMENTS; i++) {
+        values.emplace_back(random_value(255, i), order);
+    }
+    copy_and_count(state, values, [](const Scalar&) { return std::size_t(0); });
+}
+BENCHMARK(BM_FootprintScalar);
+
+static void BM_FootprintUint256(benchmark::State& state) {
+    std::vector<uint256> values;
+    for (std::size_t i = 0; i < ELEMENTS; i++) {
+        values.push_back(uint256::from_integer(random_value(255, i)));
+    }
+    copy_and_count(state, values, [](const uint256&) { return std::size_t(0); });
+}
+BENCHMARK(BM_FootprintUint256);
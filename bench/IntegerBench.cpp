@@ -0,0 +1,208 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BarrettReducer.h"
+#include "benchmark/benchmark.h"
+#include "Executor.h"
+#include "integer.h"
+#include "modexp.h"
+#include "muhash.h"
+#include "PerfCounters.h"
+#include "PrimeField.h"
+#include "rns.h"
+
+// a value of exactly bits bits, the same for every run
+static integer random_integer(std::size_t bits, uint64_t seed) {
+    std::mt19937_64 random(seed);
+    std::vector<uint8_t> bytes((bits + 7) / 8);
+    for (uint8_t& b : bytes) {
+        b = static_cast<uint8_t>(random());
+    }
+    bytes[0] |= 0x80;
+    return integer::from_bytes(bytes.data(), bytes.size()) >> (bytes.size() * 8 - bits);
+}
+
+static void BM_IntegerAdd(benchmark::State& state) {
+    const integer a = random_integer(state.range(0), 1), b = random_integer(state.range(0), 2);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a + b);
+    }
+}
+BENCHMARK(BM_IntegerAdd)->RangeMultiplier(4)->Range(64, 16384);
+
+static void BM_IntegerMul(benchmark::State& state) {
+    const integer a = random_integer(state.range(0), 1), b = random_integer(state.range(0), 2);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a * b);
+    }
+}
+BENCHMARK(BM_IntegerMul)->RangeMultiplier(4)->Range(64, 16384);
+
+// products of 2^21 and 2^23 bits: range(1) 0 on the calling thread, else the
+// four-step transform on a pool of hardware_concurrency() threads
+static void BM_IntegerMulParallelNtt(benchmark::State& state) {
+    const integer a = random_integer(state.range(0), 1), b = random_integer(state.range(0), 2);
+    WorkStealingPool pool(0);
+    integer::set_executor(state.range(1) ? &pool : nullptr);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a * b);
+    }
+    integer::set_executor(nullptr);
+}
+BENCHMARK(BM_IntegerMulParallelNtt)->ArgsProduct({{1 << 21, 1 << 23}, {0, 1}})->Unit(benchmark::kMillisecond);
+
+// products by one fixed n-bit factor: range(1) 0 through operator*, 1 with
+// the factor held transformed in an NttMultiplier
+static void BM_IntegerMulNttMultiplier(benchmark::State& state) {
+    const integer a = random_integer(state.range(0), 1), b = random_integer(state.range(0), 2);
+    const NttMultiplier times_a(a, b.limb_count());
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(state.range(1) ? times_a(b) : a * b);
+    }
+}
+BENCHMARK(BM_IntegerMulNttMultiplier)->ArgsProduct({{1 << 18, 1 << 20}, {0, 1}})->Unit(benchmark::kMillisecond);
+
+// pow(3, n) and pow(2, n): left-to-right multiplications by one digit, and a shift
+static void BM_IntegerPow(benchmark::State& state) {
+    const integer base(state.range(1));
+    const std::size_t exponent = state.range(0);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pow(base, exponent));
+    }
+}
+BENCHMARK(BM_IntegerPow)->ArgsProduct({{256, 4096, 65536}, {2, 3}});
+
+// a 2n-bit value by an n-bit one
+static void BM_IntegerDivmod(benchmark::State& state) {
+    const integer a = random_integer(2 * state.range(0), 1), b = random_integer(state.range(0), 2);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.divmod(a, b));
+    }
+}
+BENCHMARK(BM_IntegerDivmod)->RangeMultiplier(4)->Range(64, 16384);
+
+static void BM_IntegerStr(benchmark::State& state) {
+    const integer a = random_integer(state.range(0), 1);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.str(10));
+    }
+}
+BENCHMARK(BM_IntegerStr)->RangeMultiplier(4)->Range(64, 16384);
+
+static void BM_IntegerParse(benchmark::State& state) {
+    const std::string digits = random_integer(state.range(0), 1).str(10);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(integer(digits, 10));
+    }
+}
+BENCHMARK(BM_IntegerParse)->RangeMultiplier(4)->Range(64, 16384);
+
+// mulmod by an odd 3072-bit modulus: Barrett reduction of the integer product,
+// against the RNS Montgomery product
+static void BM_BarrettMulmod(benchmark::State& state) {
+    const BarrettReducer reducer(random_integer(3072, 3) | 1);
+    const integer a = random_integer(3000, 1), b = random_integer(3000, 2);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(reducer.mul(a, b));
+    }
+}
+BENCHMARK(BM_BarrettMulmod);
+
+static void BM_RnsMulmod(benchmark::State& state) {
+    const RnsContext rns(random_integer(3072, 3) | 1);
+    const RnsValue a = rns.to_rns(random_integer(3000, 1)), b = rns.to_rns(random_integer(3000, 2));
+    RnsValue out = a;
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        rns.mul(out, a, b);
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK(BM_RnsMulmod);
+
+// g^a h^b y^c mod a 2048-bit p: range(0) 0 for three sliding_window_pow
+// calls, 1 for one multi_pow with its shared squarings
+static void BM_MultiPow(benchmark::State& state) {
+    const integer p = random_integer(2048, 4) | 1;
+    const std::vector<integer> bases = {random_integer(2040, 5), random_integer(2040, 6), random_integer(2040, 7)};
+    const std::vector<integer> exponents = {random_integer(2048, 8), random_integer(2048, 9), random_integer(2048, 10)};
+    const BarrettReducer reducer(p);
+    const auto mul = [&reducer](const integer& x, const integer& y) { return reducer.mul(x, y); };
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        if (state.range(0)) {
+            benchmark::DoNotOptimize(multi_pow(bases, exponents, p));
+        } else {
+            integer product = 1;
+            for (std::size_t i = 0; i < bases.size(); i++) {
+                product = reducer.mul(product, sliding_window_pow(bases[i], exponents[i], integer(1), mul));
+            }
+            benchmark::DoNotOptimize(product);
+        }
+    }
+}
+BENCHMARK(BM_MultiPow)->DenseRange(0, 1)->Unit(benchmark::kMicrosecond);
+
+// MuHash3072's product mod 2^3072 - 1103717, reduced by folding, against
+// Barrett, the generic integer % of the same prime and the field descriptor's
+// own fold of an integer product
+static void BM_Num3072Mulmod(benchmark::State& state) {
+    const integer p = (integer(1) << std::size_t(3072)) - integer(1103717);
+    const integer x = random_integer(3000, 1), y = random_integer(3000, 2);
+    uint8_t bytes[Num3072::BYTE_SIZE];
+    uint3072::from_integer(x).store_le(bytes, sizeof(bytes));
+    const Num3072 a = Num3072::from_bytes(bytes);
+    uint3072::from_integer(y).store_le(bytes, sizeof(bytes));
+    const Num3072 b = Num3072::from_bytes(bytes);
+    const BarrettReducer reducer(p);
+    const PrimeField& field = PrimeField::get(p);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        switch (state.range(0)) {
+            case 0:
+                benchmark::DoNotOptimize(a * b);
+                break;
+            case 1:
+                benchmark::DoNotOptimize(reducer.mul(x, y));
+                break;
+            case 3:
+                benchmark::DoNotOptimize(field.reduce(x * y));
+                break;
+            default:
+                benchmark::DoNotOptimize(x * y % p);
+        }
+    }
+}
+BENCHMARK(BM_Num3072Mulmod)->DenseRange(0, 3);
+
+// MuHash3072 over n items: an element (SHA-256, 384 bytes of ChaCha20) and a
+// product per item, one inversion in finalize; threads parts at once
+static void BM_MuHash(benchmark::State& state) {
+    std::vector<std::string> items;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        items.push_back("utxo " + std::to_string(i));
+    }
+    ThreadExecutor executor(static_cast<unsigned>(state.range(1)));
+    uint8_t out[MuHash3072::DIGEST_SIZE];
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        MuHash3072::of(items, executor).finalize(out);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MuHash)->ArgsProduct({{1000}, {1, 4}})->Unit(benchmark::kMillisecond);
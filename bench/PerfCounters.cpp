@@ -0,0 +1,107 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include "PerfCounters.h"
+
+#ifdef ECC_PERF_COUNTERS
+
+#include <cstdint>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+
+struct Event {
+    const char* name;
+    uint32_t type;
+    uint64_t config;
+};
+
+const Event GROUP[] = {
+    {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {"L1D-miss", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                                     | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    {"LLC-miss", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {"br-miss", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+};
+
+int open_event(const Event& event, int group) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = event.type;
+    attr.config = event.config;
+    attr.disabled = group == -1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID | PERF_FORMAT_TOTAL_TIME_ENABLED
+                       | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+}
+
+}
+
+PerfCounters::PerfCounters(benchmark::State& state) : state(state) {
+    for (int i = 0; i < PerfCounters::EVENTS; i++) {
+        this->fds[i] = i == 0 || this->fds[0] != -1 ? open_event(GROUP[i], i == 0 ? -1 : this->fds[0]) : -1;
+    }
+    if (this->fds[0] != -1) {
+        ioctl(this->fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(this->fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    if (this->fds[0] != -1) {
+        ioctl(this->fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        // nr, time enabled, time running, then a value and id per member
+        uint64_t data[3 + 2 * PerfCounters::EVENTS];
+        const ssize_t got = read(this->fds[0], data, sizeof(data));
+        uint64_t ids[PerfCounters::EVENTS];
+        for (int i = 0; i < PerfCounters::EVENTS; i++) {
+            if (this->fds[i] == -1 || ioctl(this->fds[i], PERF_EVENT_IOC_ID, &ids[i]) != 0) {
+                ids[i] = ~uint64_t(0);
+            }
+        }
+        if (got >= static_cast<ssize_t>(3 * sizeof(uint64_t)) && data[2] != 0 && this->state.iterations() != 0) {
+            const double scale = static_cast<double>(data[1]) / static_cast<double>(data[2]);
+            double value[PerfCounters::EVENTS];
+            bool have[PerfCounters::EVENTS] = {};
+            for (uint64_t m = 0; m < data[0] && 3 + 2 * m + 1 < sizeof(data) / sizeof(data[0]); m++) {
+                for (int i = 0; i < PerfCounters::EVENTS; i++) {
+                    if (ids[i] == data[3 + 2 * m + 1]) {
+                        value[i] = static_cast<double>(data[3 + 2 * m]) * scale;
+                        have[i] = true;
+                    }
+                }
+            }
+            for (int i = 0; i < PerfCounters::EVENTS; i++) {
+                if (have[i] && i != 1) {
+                    this->state.counters[GROUP[i].name] = benchmark::Counter(value[i],
+                                                                              benchmark::Counter::kAvgIterations);
+                }
+            }
+            if (have[0] && have[1] && value[0] > 0) {
+                this->state.counters["IPC"] = value[1] / value[0];
+            }
+        }
+    }
+    for (int fd : this->fds) {
+        if (fd != -1) {
+            close(fd);
+        }
+    }
+}
+
+#else
+
+PerfCounters::PerfCounters(benchmark::State& state) : state(state), fds{-1, -1, -1, -1, -1} {}
+
+PerfCounters::~PerfCounters() = default;
+
+#endif
@@ -0,0 +1,40 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_PERF_COUNTERS_H
+#define ECC_PERF_COUNTERS_H
+
+#include "benchmark/benchmark.h"
+
+// Hardware counters for the timed loop of a benchmark, from perf_event_open:
+// made just before `for (auto _ : state)`, it counts the loop and on
+// destruction adds to state.counters, per iteration,
+//
+//     cycles       CPU cycles
+//     IPC          instructions per cycle (for the whole loop)
+//     L1D-miss     level 1 data cache read misses
+//     LLC-miss     last level cache misses
+//     br-miss      mispredicted branches
+//
+// scaled for the time the group was multiplexed off the PMU. Only user-space
+// events of the calling thread are counted, so work an executor's threads do
+// is not in them. Counters the CPU or kernel will not give (a VM without a
+// virtual PMU, perf_event_paranoid above 2) are left out, and without
+// ECC_PERF_COUNTERS (not Linux, or ECC_BENCH_PERF off) PerfCounters does nothing.
+class PerfCounters {
+public:
+    explicit PerfCounters(benchmark::State& state);
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+private:
+    static const int EVENTS = 5;
+
+    benchmark::State& state;
+    // the group leader (cycles) first; -1 for an event that did not open
+    int fds[EVENTS];
+};
+
+#endif //ECC_PERF_COUNTERS_H
@@ -0,0 +1,252 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "bls12_381.h"
+#include "bulletproofs.h"
+#include "Curve.h"
+#include "dlog.h"
+#include "hash_to_curve.h"
+#include "kzg.h"
+#include "msm.h"
+#include "PerfCounters.h"
+#include "primality.h"
+
+// range(0): 0 for secp256k1, 1 for P-256
+static const Curve& bench_curve(int64_t which) {
+    return which == 0 ? Curve::secp256k1() : Curve::p256();
+}
+
+static integer scalar(uint64_t seed) {
+    std::mt19937_64 random(seed);
+    uint8_t bytes[32];
+    for (uint8_t& b : bytes) {
+        b = static_cast<uint8_t>(random());
+    }
+    return integer::from_bytes(bytes, 32);
+}
+
+static void BM_PointAdd(benchmark::State& state) {
+    const Curve& curve = bench_curve(state.range(0));
+    const Point p = curve.generator() * scalar(1), q = curve.generator() * scalar(2);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(p + q);
+    }
+}
+BENCHMARK(BM_PointAdd)->DenseRange(0, 1);
+
+static void BM_PointDbl(benchmark::State& state) {
+    const Point p = bench_curve(state.range(0)).generator() * scalar(1);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(p.dbl());
+    }
+}
+BENCHMARK(BM_PointDbl)->DenseRange(0, 1);
+
+static void BM_PointMul(benchmark::State& state) {
+    const Curve& curve = bench_curve(state.range(0));
+    const Point p = curve.generator() * scalar(1);
+    const integer k = scalar(2);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(p.mul(k));
+    }
+}
+BENCHMARK(BM_PointMul)->DenseRange(0, 1);
+
+static void BM_PointMulCt(benchmark::State& state) {
+    const Curve& curve = bench_curve(state.range(0));
+    const Point p = curve.generator() * scalar(1);
+    const integer k = scalar(2);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(p.mul_ct(k));
+    }
+}
+BENCHMARK(BM_PointMulCt)->DenseRange(0, 1);
+
+// k G from the curve's precomputed table
+static void BM_GeneratorMul(benchmark::State& state) {
+    const FixedBaseTable& g = bench_curve(state.range(0)).generator_table();
+    const integer k = scalar(2);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(g.mul_ct(k));
+    }
+}
+BENCHMARK(BM_GeneratorMul)->DenseRange(0, 1);
+
+// range(1) points, per point
+static void BM_MultiScalarMul(benchmark::State& state) {
+    const Curve& curve = bench_curve(state.range(0));
+    std::vector<integer> k;
+    std::vector<Point> p;
+    for (int64_t i = 0; i < state.range(1); i++) {
+        k.push_back(scalar(2 * i + 1));
+        p.push_back(curve.generator_table().mul(scalar(2 * i + 2)));
+    }
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(multi_scalar_mul(k, p));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_MultiScalarMul)->ArgsProduct({{0, 1}, {16, 256, 4096}})->Unit(benchmark::kMicrosecond);
+
+// Pippenger over range(1) secp256k1 points in its own window, per point:
+// range(0) 0 for the buckets filled in input order, 1 in bucket order
+// (pippenger_sorted)
+static void BM_PippengerLayout(benchmark::State& state) {
+    const Curve& curve = Curve::secp256k1();
+    std::vector<integer> k;
+    std::vector<Point> p(1, curve.generator());
+    for (int64_t i = 0; i < state.range(1); i++) {
+        k.push_back(scalar(2 * i + 1));
+        if (i > 0) {
+            p.push_back(p.back() + curve.generator());
+        }
+    }
+    Point::batch_normalize(p);
+    const std::size_t c = pippenger_window(p.size(), 256);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(state.range(0) ? pippenger_sorted(k, p, c) : pippenger(k, p, c));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+    state.counters["c"] = static_cast<double>(c);
+}
+BENCHMARK(BM_PippengerLayout)->ArgsProduct({{0, 1}, {64, 128, 256, 4096, 65536, 262144}})->Unit(benchmark::kMillisecond);
+
+// a Pedersen-style commitment to 1024 secp256k1 scalars over fixed
+// generators, per scalar: range(0) the FixedBaseMsm stride, 0 for
+// multi_scalar_mul without tables
+static void BM_FixedBaseMsm(benchmark::State& state) {
+    const Curve& curve = Curve::secp256k1();
+    std::vector<integer> k;
+    std::vector<Point> p;
+    for (int64_t i = 0; i < 1024; i++) {
+        k.push_back(scalar(2 * i + 1));
+        p.push_back(curve.generator_table().mul(scalar(2 * i + 2)));
+    }
+    const std::size_t stride = static_cast<std::size_t>(state.range(0));
+    const FixedBaseMsm msm(p, 256, 0, 1, stride ? stride : 1);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(stride ? msm.mul(k) : multi_scalar_mul(k, p));
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+    state.counters["table"] = static_cast<double>(msm.table_size());
+}
+BENCHMARK(BM_FixedBaseMsm)->Arg(0)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMicrosecond);
+
+// range(0) BLS12-381 pairs in one multi-pairing, per pair: the Miller loops
+// share one accumulator and one final exponentiation
+static void BM_Bls12381MultiPairing(benchmark::State& state) {
+    std::vector<Point> p;
+    std::vector<G2Point> q;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        p.push_back(Curve::bls12_381().generator().mul(scalar(2 * i + 1)));
+        q.push_back(G2Point::generator().mul(scalar(2 * i + 2)));
+    }
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bls12_381_multi_pairing(p, q));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Bls12381MultiPairing)->Arg(1)->Arg(8)->Unit(benchmark::kMillisecond);
+
+// a KZG commitment to range(1) coefficients over BLS12-381: range(0) 0 for
+// multi_scalar_mul over the powers of tau, 1 for the setup's FixedBaseMsm
+static void BM_KzgCommit(benchmark::State& state) {
+    static const KzgSetup setup = KzgSetup::insecure(scalar(7) % KzgSetup::scalar_field().prime(), 4096);
+    std::vector<FieldElement> c;
+    std::vector<integer> k;
+    for (int64_t i = 0; i < state.range(1); i++) {
+        c.emplace_back(scalar(i + 1) % KzgSetup::scalar_field().prime(), KzgSetup::scalar_field());
+        k.push_back(c.back().value());
+    }
+    const Polynomial p(KzgSetup::scalar_field(), c);
+    const std::vector<Point> powers(setup.powers().begin(), setup.powers().begin() + state.range(1));
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(state.range(0) == 0 ? multi_scalar_mul(k, powers) : setup.commit(p));
+    }
+}
+BENCHMARK(BM_KzgCommit)->ArgsProduct({{0, 1}, {256, 4096}})->Unit(benchmark::kMillisecond);
+
+// range(0) 64-bit range proofs verified in one batch, per proof
+static void BM_BulletproofVerify(benchmark::State& state) {
+    static const Bulletproofs bp(64);
+    uint8_t seed[ChaCha20Rng::SEED_SIZE] = {7};
+    ChaCha20Rng rng(seed);
+    std::vector<Point> commitments;
+    std::vector<RangeProof> proofs;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        const Scalar blinding = rng.random_scalar(Curve::secp256k1().scalar_field());
+        const uint64_t value = rng.next();
+        commitments.push_back(pedersen_commit(Scalar(integer(value), Curve::secp256k1().scalar_field()), blinding));
+        proofs.push_back(bp.prove(value, blinding, rng));
+    }
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bp.verify_batch(commitments, proofs));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BulletproofVerify)->Arg(1)->Arg(16)->Arg(64)->Unit(benchmark::kMillisecond);
+
+// 256 messages hashed to range(0) 0 secp256k1, 1 P-256, 2 BLS12-381 G1, one
+// by one for range(1) 0 and in one batch for 1, per message
+static void BM_HashToCurve(benchmark::State& state) {
+    const HashToCurve& h = state.range(0) == 0 ? HashToCurve::secp256k1()
+                         : state.range(0) == 1 ? HashToCurve::p256() : HashToCurve::bls12_381();
+    std::vector<std::string> messages;
+    for (int i = 0; i < 256; i++) {
+        messages.push_back("message " + std::to_string(i));
+    }
+    const std::string dst = "ECC-BENCH-" + h.suite();
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        if (state.range(1)) {
+            benchmark::DoNotOptimize(h.hash_batch(messages, dst));
+        } else {
+            for (const std::string& m : messages) {
+                benchmark::DoNotOptimize(h.hash(m, dst));
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 256);
+}
+BENCHMARK(BM_HashToCurve)->ArgsProduct({{0, 1, 2}, {0, 1}})->Unit(benchmark::kMillisecond);
+
+// a key of 36 bits on y^2 = x^3 + 1 over p = 6q - 1 found by Pollard's rho
+// on range(0) threads, per solve; counters give the additions per solve
+static void BM_DlogRho(benchmark::State& state) {
+    integer q = next_prime(integer(1) << 36);
+    while (!is_probable_prime(6 * q - 1)) {
+        q = next_prime(q + 1);
+    }
+    const integer p = 6 * q - 1;
+    const FieldElement a(0, p), b(1, p);
+    Point g(a, b);
+    for (integer y = 2; g.is_infinity(); y += 1) {
+        const FieldElement fy(y, p);
+        g = Point((fy.square() - b).power((2 * p - 1) / 3), fy, a, b) * 6;
+    }
+    const Point h = g * (integer("31415926535", 10) % q);
+    DlogStats stats;
+    uint64_t seed = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dlog_rho(g, h, q, static_cast<unsigned>(state.range(0)), seed++, &stats));
+    }
+    state.counters["additions"] = benchmark::Counter(double(stats.additions), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_DlogRho)->Arg(1)->Arg(4)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,286 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstdint>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "Curve.h"
+#include "ecdsa.h"
+#include "ecvrf.h"
+#include "key_table_cache.h"
+#include "musig.h"
+#include "PerfCounters.h"
+#include "rsa.h"
+#include "schnorr.h"
+#include "schnorr_halfagg.h"
+#include "sec1.h"
+#include "taproot.h"
+
+static const uint8_t SECRET[32] = {0x4b, 0x1c, 0x07, 0x9e, 0x51, 0x02, 0x33, 0x10, 0x8a, 0x27, 0x6d, 0x40, 0x05, 0x11,
+                                   0x0c, 0x90, 0x7a, 0x3f, 0x21, 0x18, 0x64, 0x09, 0x55, 0x2e, 0x73, 0x01, 0x48, 0x36,
+                                   0x0f, 0x2a, 0x19, 0x5c};
+static const uint8_t HASH[32] = {0xde, 0xad, 0xbe, 0xef};
+
+// range(0): 0 for secp256k1, 1 for P-256
+static const Curve& bench_curve(int64_t which) {
+    return which == 0 ? Curve::secp256k1() : Curve::p256();
+}
+
+static void BM_EcdsaSign(benchmark::State& state) {
+    const Curve& curve = bench_curve(state.range(0));
+    uint8_t signature[64];
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ecdsa_sign(signature, curve, SECRET, HASH, 32));
+    }
+}
+BENCHMARK(BM_EcdsaSign)->DenseRange(0, 1);
+
+static void BM_EcdsaVerify(benchmark::State& state) {
+    const Curve& curve = bench_curve(state.range(0));
+    uint8_t signature[64];
+    ecdsa_sign(signature, curve, SECRET, HASH, 32);
+    const Point q = curve.generator_table().mul(integer::from_bytes(SECRET, 32));
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ecdsa_verify(signature, curve, q, HASH, 32));
+    }
+}
+BENCHMARK(BM_EcdsaVerify)->DenseRange(0, 1);
+
+// the same for a hot key: its tables and G's read from a KeyTableCache
+static void BM_EcdsaVerifyCachedKey(benchmark::State& state) {
+    const Curve& curve = bench_curve(state.range(0));
+    uint8_t signature[64];
+    ecdsa_sign(signature, curve, SECRET, HASH, 32);
+    const Point q = curve.generator_table().mul(integer::from_bytes(SECRET, 32)).normalized();
+    KeyTableCache cache(1 << 20);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ecdsa_verify(signature, curve, q, HASH, 32, cache));
+    }
+}
+BENCHMARK(BM_EcdsaVerifyCachedKey)->DenseRange(0, 1);
+
+static void BM_SchnorrSign(benchmark::State& state) {
+    uint8_t signature[64];
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(schnorr_sign(signature, HASH, 32, SECRET, nullptr));
+    }
+}
+BENCHMARK(BM_SchnorrSign);
+
+static void BM_SchnorrVerify(benchmark::State& state) {
+    uint8_t key[32], signature[64];
+    schnorr_public_key(key, SECRET);
+    schnorr_sign(signature, HASH, 32, SECRET, nullptr);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(schnorr_verify(signature, HASH, 32, key));
+    }
+}
+BENCHMARK(BM_SchnorrVerify);
+
+static void BM_SchnorrVerifyCachedKey(benchmark::State& state) {
+    uint8_t key[32], signature[64];
+    schnorr_public_key(key, SECRET);
+    schnorr_sign(signature, HASH, 32, SECRET, nullptr);
+    KeyTableCache cache(1 << 20);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(schnorr_verify(signature, HASH, 32, key, cache));
+    }
+}
+BENCHMARK(BM_SchnorrVerifyCachedKey);
+
+// range(0) signatures by one batch equation, per signature
+static void BM_SchnorrVerifyBatch(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::vector<uint8_t> keys(32 * n), signatures(64 * n), messages(32 * n);
+    std::vector<SchnorrSigned> items;
+    for (std::size_t i = 0; i < n; i++) {
+        uint8_t secret[32] = {static_cast<uint8_t>(i + 1), static_cast<uint8_t>(i >> 8), 0x5a};
+        messages[32 * i] = static_cast<uint8_t>(i);
+        schnorr_public_key(&keys[32 * i], secret);
+        schnorr_sign(&signatures[64 * i], &messages[32 * i], 32, secret, nullptr);
+        items.push_back(SchnorrSigned{&signatures[64 * i], &messages[32 * i], 32, &keys[32 * i]});
+    }
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(schnorr_verify_batch(items));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SchnorrVerifyBatch)->RangeMultiplier(8)->Range(8, 4096)->Unit(benchmark::kMicrosecond);
+
+// ecdsa_verify_batch on one thread, the inverses of s taken with one inversion
+static void BM_EcdsaVerifyBatch(benchmark::State& state) {
+    const Curve& curve = Curve::secp256k1();
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::vector<uint8_t> signatures(64 * n), hashes(32 * n);
+    std::vector<Point> keys;
+    keys.reserve(n);
+    std::vector<EcdsaJob> jobs;
+    for (std::size_t i = 0; i < n; i++) {
+        uint8_t secret[32] = {static_cast<uint8_t>(i + 1), static_cast<uint8_t>(i >> 8), 0x5a};
+        hashes[32 * i] = static_cast<uint8_t>(i);
+        keys.push_back(*ecdsa_public_key(curve, secret));
+        ecdsa_sign(&signatures[64 * i], curve, secret, &hashes[32 * i], 32);
+        jobs.push_back(EcdsaJob{&signatures[64 * i], &hashes[32 * i], 32, &keys.back()});
+    }
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ecdsa_verify_batch(curve, jobs));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EcdsaVerifyBatch)->RangeMultiplier(8)->Range(8, 512)->Unit(benchmark::kMicrosecond);
+
+// range(1) secp256k1 signatures under one EcdsaSigner, per signature: range(0)
+// 0 for sign() in a loop, 1 for ecdsa_sign_batch on one thread
+static void BM_EcdsaSignBatch(benchmark::State& state) {
+    const Curve& curve = Curve::secp256k1();
+    const std::size_t n = static_cast<std::size_t>(state.range(1));
+    const EcdsaSigner signer(curve, SECRET);
+    std::vector<uint8_t> signatures(64 * n), hashes(32 * n);
+    std::vector<EcdsaSignJob> jobs;
+    for (std::size_t i = 0; i < n; i++) {
+        hashes[32 * i] = static_cast<uint8_t>(i);
+        hashes[32 * i + 1] = static_cast<uint8_t>(i >> 8);
+        jobs.push_back(EcdsaSignJob{&signatures[64 * i], &signer, &hashes[32 * i], 32});
+    }
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        if (state.range(0)) {
+            benchmark::DoNotOptimize(ecdsa_sign_batch(curve, jobs));
+        } else {
+            for (const EcdsaSignJob& job : jobs) {
+                benchmark::DoNotOptimize(signer.sign(job.signature, job.hash, job.length));
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_EcdsaSignBatch)->ArgsProduct({{0, 1}, {64, 512}})->Unit(benchmark::kMicrosecond);
+
+// MuSig2 key aggregation of range(1) cosigners on one thread, aggregated
+// afresh for range(0) 0 and found in MusigKeyAggCache for 1
+static void BM_MusigKeyAgg(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(1));
+    std::vector<uint8_t> keys(33 * n);
+    for (std::size_t i = 0; i < n; i++) {
+        sec1_encode(Curve::secp256k1().mul_base(integer(i) * 7919 + 1), true, &keys[33 * i], 33);
+    }
+    MusigKeyAggCache cache(4);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        if (state.range(0)) {
+            benchmark::DoNotOptimize(cache.aggregate(keys.data(), n));
+        } else {
+            benchmark::DoNotOptimize(MusigKeyAgg::aggregate(keys.data(), n));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK(BM_MusigKeyAgg)->ArgsProduct({{0, 1}, {16, 1000}})->Unit(benchmark::kMicrosecond);
+
+// BIP86 output keys of 4096 internal keys on one thread, by taproot_tweak
+// for range(0) 0 and taproot_tweak_batch for 1, per key
+static void BM_TaprootTweak(benchmark::State& state) {
+    const std::size_t n = 4096;
+    std::vector<uint8_t> keys(32 * n), out(32);
+    for (std::size_t i = 0; i < n; i++) {
+        const uint8_t secret[32] = {static_cast<uint8_t>(i + 1), static_cast<uint8_t>(i >> 8), 0x5a};
+        schnorr_public_key(&keys[32 * i], secret);
+    }
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        if (state.range(0)) {
+            benchmark::DoNotOptimize(taproot_tweak_batch(keys.data(), nullptr, n));
+        } else {
+            for (std::size_t i = 0; i < n; i++) {
+                benchmark::DoNotOptimize(taproot_tweak(out.data(), nullptr, &keys[32 * i], nullptr));
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_TaprootTweak)->DenseRange(0, 1)->Unit(benchmark::kMillisecond);
+
+// range(0) signatures half-aggregated and verified by one equation of 2n + 1
+// points, per signature; against BM_SchnorrVerifyBatch
+static void BM_SchnorrHalfAggVerify(benchmark::State& state) {
+    const std::size_t n = static_cast<std::size_t>(state.range(0));
+    std::vector<uint8_t> keys(32 * n), signatures(64 * n), messages(32 * n), aggregate;
+    std::vector<SchnorrSigned> signed_items;
+    std::vector<SchnorrAggregated> items;
+    for (std::size_t i = 0; i < n; i++) {
+        uint8_t secret[32] = {static_cast<uint8_t>(i + 1), static_cast<uint8_t>(i >> 8), 0x5a};
+        messages[32 * i] = static_cast<uint8_t>(i);
+        schnorr_public_key(&keys[32 * i], secret);
+        schnorr_sign(&signatures[64 * i], &messages[32 * i], 32, secret, nullptr);
+        signed_items.push_back(SchnorrSigned{&signatures[64 * i], &messages[32 * i], 32, &keys[32 * i]});
+        items.push_back(SchnorrAggregated{&keys[32 * i], &messages[32 * i]});
+    }
+    schnorr_half_aggregate(aggregate, signed_items);
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(schnorr_half_verify(aggregate.data(), aggregate.size(), items));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SchnorrHalfAggVerify)->RangeMultiplier(8)->Range(8, 4096)->Unit(benchmark::kMicrosecond);
+
+// 256 secp256k1 VRF proofs on one thread, by Ecvrf::verify for range(0) 0 and
+// one verify_batch of batch-compatible proofs for 1, per proof
+static void BM_EcvrfVerify(benchmark::State& state) {
+    const Ecvrf& suite = Ecvrf::secp256k1_sswu();
+    const std::size_t n = 256;
+    std::vector<uint8_t> keys(Ecvrf::KEY_SIZE * n), proofs(Ecvrf::BATCH_PROOF_SIZE * n), alphas(32 * n);
+    std::vector<uint8_t> betas(Ecvrf::HASH_SIZE * n);
+    std::vector<EcvrfProved> items;
+    for (std::size_t i = 0; i < n; i++) {
+        const uint8_t secret[32] = {static_cast<uint8_t>(i + 1), static_cast<uint8_t>(i >> 8), 0x5a};
+        alphas[32 * i] = static_cast<uint8_t>(i);
+        suite.public_key(&keys[Ecvrf::KEY_SIZE * i], secret);
+        if (state.range(0)) {
+            suite.prove_batchable(&proofs[Ecvrf::BATCH_PROOF_SIZE * i], secret, &alphas[32 * i], 32);
+        } else {
+            suite.prove(&proofs[Ecvrf::BATCH_PROOF_SIZE * i], secret, &alphas[32 * i], 32);
+        }
+        items.push_back(EcvrfProved{&keys[Ecvrf::KEY_SIZE * i], &proofs[Ecvrf::BATCH_PROOF_SIZE * i],
+                                    &alphas[32 * i], 32});
+    }
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        if (state.range(0)) {
+            benchmark::DoNotOptimize(suite.verify_batch(betas.data(), items));
+        } else {
+            for (std::size_t i = 0; i < n; i++) {
+                benchmark::DoNotOptimize(suite.verify(&betas[Ecvrf::HASH_SIZE * i], items[i].public_key,
+                                                      items[i].proof, items[i].alpha, 32));
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_EcvrfVerify)->DenseRange(0, 1)->Unit(benchmark::kMillisecond);
+
+// range(0) modulus bits, range(1) 1 with blinding: the CRT private operation
+// under an RSA signature
+static void BM_RsaPrivate(benchmark::State& state) {
+    const uint8_t seed[32] = {0x72, 0x73, 0x61};
+    ChaCha20Rng rng(seed);
+    RsaKey key = RsaKey::generate(static_cast<std::size_t>(state.range(0)), rng);
+    if (state.range(1)) {
+        key.enable_blinding();
+    }
+    const integer x = rng.random_below(key.modulus());
+    PerfCounters perf(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(key.private_op(x));
+    }
+}
+BENCHMARK(BM_RsaPrivate)->ArgsProduct({{2048, 3072}, {0, 1}})->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,390 @@
+//
+// Created by preston on 10/15/2026.
+//
+// ecc_compare: runs the same 256-bit workloads through this library and the
+// reference libraries, GMP for the arithmetic and libsecp256k1 (when it was
+// found, ECC_HAVE_LIBSECP256K1) for the curve, and prints the time of each
+// per operation with ours / reference. Every input is also checked to give the
+// same result both ways, so the run doubles as a differential test; it exits 1
+// on any mismatch.
+//
+//     ecc_compare [--count N] [--seed S]
+//
+// ECDSA signatures are compared up to the sign of s, since libsecp256k1 only
+// makes low-s ones. MSM is checked against libsecp256k1's public API, one
+// tweak_mul per term and a combine, as it exports no multi-scalar product.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gmp.h>
+
+#include "Curve.h"
+#include "ecdsa.h"
+#include "FieldElement.h"
+#include "integer.h"
+#include "msm.h"
+#include "schnorr.h"
+#include "sec1.h"
+
+#ifdef ECC_HAVE_LIBSECP256K1
+#include <secp256k1.h>
+#include <secp256k1_extrakeys.h>
+#include <secp256k1_schnorrsig.h>
+#endif
+
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+// seconds per call of op: the best of five runs of enough calls to take ten milliseconds
+static double time_op(const function<void()>& op) {
+    size_t calls = 1;
+    for (;;) {
+        const Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < calls; i++) {
+            op();
+        }
+        if (chrono::duration<double>(Clock::now() - start).count() >= 1e-2) {
+            break;
+        }
+        calls *= 2;
+    }
+    double best = 1e30;
+    for (int run = 0; run < 5; run++) {
+        const Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < calls; i++) {
+            op();
+        }
+        best = min(best, chrono::duration<double>(Clock::now() - start).count() / calls);
+    }
+    return best;
+}
+
+// one workload: ours and reference each do all count items once per call,
+// and same(i) says whether they agreed on item i
+struct Workload {
+    string name;
+    size_t count;
+    function<void()> ours;
+    function<void()> reference;
+    function<bool(size_t)> same;
+};
+
+static size_t mismatches = 0;
+
+static void run(const Workload& w) {
+    w.ours();
+    w.reference();
+    size_t wrong = 0;
+    for (size_t i = 0; i < w.count; i++) {
+        if (!w.same(i)) {
+            if (wrong++ == 0) {
+                fprintf(stderr, "%s: item %zu differs\n", w.name.c_str(), i);
+            }
+        }
+    }
+    mismatches += wrong;
+    const double ours = time_op(w.ours) / w.count, reference = time_op(w.reference) / w.count;
+    printf("%-22s %12.1f %12.1f %8.2f%s\n", w.name.c_str(), ours * 1e9, reference * 1e9, ours / reference,
+           wrong ? "  MISMATCH" : "");
+    fflush(stdout);
+}
+
+// the 32 big-endian bytes of x as an mpz
+static void to_mpz(mpz_t out, const integer& x) {
+    uint8_t bytes[32];
+    x.to_bytes(bytes, 32);
+    mpz_import(out, 32, 1, 1, 1, 0, bytes);
+}
+
+// whether x and y are the same non-negative value below 2^256
+static bool equal(const integer& x, const mpz_t y) {
+    uint8_t a[32], b[32] = {0};
+    const size_t len = (mpz_sizeinbase(y, 2) + 7) / 8;
+    if (mpz_sgn(y) < 0 || len > 32) {
+        return false;
+    }
+    x.to_bytes(a, 32);
+    mpz_export(b + 32 - len, nullptr, 1, 1, 1, 0, y);
+    return memcmp(a, b, 32) == 0;
+}
+
+// count values below bound, as integers and their mpz copies
+class Operands {
+public:
+    Operands(size_t count, const integer& bound, mt19937_64& random) : mpz(count) {
+        for (size_t i = 0; i < count; i++) {
+            uint8_t bytes[32];
+            for (uint8_t& b : bytes) {
+                b = static_cast<uint8_t>(random());
+            }
+            values.push_back(integer::from_bytes(bytes, 32) % bound);
+            if (!values.back()) {
+                values.back() = integer(1);
+            }
+            mpz_init(mpz[i].value);
+            to_mpz(mpz[i].value, values.back());
+        }
+    }
+    ~Operands() {
+        for (Mpz& m : mpz) {
+            mpz_clear(m.value);
+        }
+    }
+    Operands(const Operands&) = delete;
+    Operands& operator=(const Operands&) = delete;
+
+    struct Mpz {
+        mpz_t value;
+    };
+    vector<integer> values;
+    vector<Mpz> mpz;
+};
+
+// an mpz per item for the reference results
+class MpzResults {
+public:
+    explicit MpzResults(size_t count) : values(count) {
+        for (Operands::Mpz& m : values) {
+            mpz_init(m.value);
+        }
+    }
+    ~MpzResults() {
+        for (Operands::Mpz& m : values) {
+            mpz_clear(m.value);
+        }
+    }
+    MpzResults(const MpzResults&) = delete;
+    MpzResults& operator=(const MpzResults&) = delete;
+
+    mpz_t& operator[](size_t i) { return values[i].value; }
+
+private:
+    vector<Operands::Mpz> values;
+};
+
+static void arithmetic(size_t count, mt19937_64& random) {
+    const PrimeField& field = Curve::secp256k1().field();
+    const integer& p = field.prime();
+    mpz_t mp;
+    mpz_init(mp);
+    to_mpz(mp, p);
+    const Operands a(count, p, random), b(count, p, random);
+    vector<FieldElement> fa, fb;
+    for (size_t i = 0; i < count; i++) {
+        fa.push_back(FieldElement(a.values[i], field));
+        fb.push_back(FieldElement(b.values[i], field));
+    }
+    vector<integer> ours(count);
+    vector<FieldElement> field_ours(fa);
+    MpzResults reference(count);
+
+    const auto same = [&](size_t i) { return equal(ours[i], reference[i]); };
+    const auto field_same = [&](size_t i) { return equal(field_ours[i].value(), reference[i]); };
+    const auto gmp_mulmod = [&]() {
+        for (size_t i = 0; i < count; i++) {
+            mpz_mul(reference[i], a.mpz[i].value, b.mpz[i].value);
+            mpz_mod(reference[i], reference[i], mp);
+        }
+    };
+    const auto gmp_modinv = [&]() {
+        for (size_t i = 0; i < count; i++) {
+            mpz_invert(reference[i], a.mpz[i].value, mp);
+        }
+    };
+    const auto gmp_powm = [&]() {
+        for (size_t i = 0; i < count; i++) {
+            mpz_powm(reference[i], a.mpz[i].value, b.mpz[i].value, mp);
+        }
+    };
+
+    run({"integer mulmod", count, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            ours[i] = a.values[i] * b.values[i] % p;
+        }
+    }, gmp_mulmod, same});
+    run({"FieldElement mul", count, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            field_ours[i] = fa[i] * fb[i];
+        }
+    }, gmp_mulmod, field_same});
+    run({"integer modinv", count, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            ours[i] = a.values[i].modinv(p);
+        }
+    }, gmp_modinv, same});
+    const FieldElement one(integer(1), field);
+    run({"FieldElement inverse", count, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            field_ours[i] = one / fa[i];
+        }
+    }, gmp_modinv, field_same});
+    run({"integer powmod", count, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            ours[i] = pow(a.values[i], b.values[i], p);
+        }
+    }, gmp_powm, same});
+    run({"FieldElement power", count, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            field_ours[i] = fa[i].power(b.values[i]);
+        }
+    }, gmp_powm, field_same});
+    mpz_clear(mp);
+}
+
+#ifdef ECC_HAVE_LIBSECP256K1
+
+// s of the 64-byte signatures a and b equal, or each the negation of the other mod n
+static bool same_up_to_s(const uint8_t* a, const uint8_t* b, const integer& n) {
+    if (memcmp(a, b, 32) != 0) {
+        return false;
+    }
+    const integer sa = integer::from_bytes(a + 32, 32), sb = integer::from_bytes(b + 32, 32);
+    return sa == sb || sa + sb == n;
+}
+
+static void curve(size_t count, mt19937_64& random) {
+    const Curve& curve = Curve::secp256k1();
+    secp256k1_context* ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+    const Operands secret_values(count, curve.n(), random), scalar_values(count, curve.n(), random);
+    vector<uint8_t> secrets(count * 32), hashes(count * 32), aux(count * 32), keys(count * 33), xonly(count * 32);
+    vector<secp256k1_pubkey> pubkeys(count);
+    vector<secp256k1_keypair> keypairs(count);
+    vector<secp256k1_xonly_pubkey> xonly_keys(count);
+    for (size_t i = 0; i < count; i++) {
+        secret_values.values[i].to_bytes(&secrets[i * 32], 32);
+        for (size_t j = 0; j < 32; j++) {
+            hashes[i * 32 + j] = static_cast<uint8_t>(random());
+            aux[i * 32 + j] = static_cast<uint8_t>(random());
+        }
+        secp256k1_ec_pubkey_create(ctx, &pubkeys[i], &secrets[i * 32]);
+        size_t len = 33;
+        secp256k1_ec_pubkey_serialize(ctx, &keys[i * 33], &len, &pubkeys[i], SECP256K1_EC_COMPRESSED);
+        secp256k1_keypair_create(ctx, &keypairs[i], &secrets[i * 32]);
+        secp256k1_keypair_xonly_pub(ctx, &xonly_keys[i], nullptr, &keypairs[i]);
+        secp256k1_xonly_pubkey_serialize(ctx, &xonly[i * 32], &xonly_keys[i]);
+    }
+    vector<Point> points;
+    for (size_t i = 0; i < count; i++) {
+        points.push_back(sec1_decode(&keys[i * 33], 33, curve).value());
+    }
+
+    vector<uint8_t> ours(count * 64), reference(count * 64);
+    vector<uint8_t> ours_ok(count), reference_ok(count);
+    run({"ECDSA sign", count, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            ecdsa_sign(&ours[i * 64], curve, &secrets[i * 32], &hashes[i * 32], 32);
+        }
+    }, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            secp256k1_ecdsa_signature sig;
+            secp256k1_ecdsa_sign(ctx, &sig, &hashes[i * 32], &secrets[i * 32], nullptr, nullptr);
+            secp256k1_ecdsa_signature_serialize_compact(ctx, &reference[i * 64], &sig);
+        }
+    }, [&](size_t i) { return same_up_to_s(&ours[i * 64], &reference[i * 64], curve.n()); }});
+
+    // every fourth signature spoiled, so both sides must also reject the same ones
+    for (size_t i = 0; i < count; i += 4) {
+        reference[i * 64 + 40] ^= 1;
+    }
+    run({"ECDSA verify", count, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            ours_ok[i] = ecdsa_verify(&reference[i * 64], curve, points[i], &hashes[i * 32], 32) == Status::ok;
+        }
+    }, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            secp256k1_ecdsa_signature sig;
+            secp256k1_ecdsa_signature_parse_compact(ctx, &sig, &reference[i * 64]);
+            reference_ok[i] = secp256k1_ecdsa_verify(ctx, &sig, &hashes[i * 32], &pubkeys[i]) == 1;
+        }
+    }, [&](size_t i) { return ours_ok[i] == reference_ok[i]; }});
+
+    run({"BIP340 sign", count, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            schnorr_sign(&ours[i * 64], &hashes[i * 32], 32, &secrets[i * 32], &aux[i * 32]);
+        }
+    }, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            secp256k1_schnorrsig_sign32(ctx, &reference[i * 64], &hashes[i * 32], &keypairs[i], &aux[i * 32]);
+        }
+    }, [&](size_t i) { return memcmp(&ours[i * 64], &reference[i * 64], 64) == 0; }});
+
+    for (size_t i = 0; i < count; i += 4) {
+        reference[i * 64 + 40] ^= 1;
+    }
+    run({"BIP340 verify", count, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            ours_ok[i] = schnorr_verify(&reference[i * 64], &hashes[i * 32], 32, &xonly[i * 32]) == Status::ok;
+        }
+    }, [&]() {
+        for (size_t i = 0; i < count; i++) {
+            reference_ok[i] = secp256k1_schnorrsig_verify(ctx, &reference[i * 64], &hashes[i * 32], 32,
+                                                          &xonly_keys[i]) == 1;
+        }
+    }, [&](size_t i) { return ours_ok[i] == reference_ok[i]; }});
+
+    // one product of all count terms per call, so the times are per term
+    uint8_t msm_ours[33], msm_reference[33];
+    vector<uint8_t> scalars(count * 32);
+    for (size_t i = 0; i < count; i++) {
+        scalar_values.values[i].to_bytes(&scalars[i * 32], 32);
+    }
+    run({"MSM, per point", count, [&]() {
+        sec1_encode(multi_scalar_mul(scalar_values.values, points), true, msm_ours, 33);
+    }, [&]() {
+        vector<secp256k1_pubkey> terms(pubkeys);
+        vector<const secp256k1_pubkey*> pointers;
+        for (size_t i = 0; i < count; i++) {
+            secp256k1_ec_pubkey_tweak_mul(ctx, &terms[i], &scalars[i * 32]);
+            pointers.push_back(&terms[i]);
+        }
+        secp256k1_pubkey sum;
+        secp256k1_ec_pubkey_combine(ctx, &sum, pointers.data(), count);
+        size_t len = 33;
+        secp256k1_ec_pubkey_serialize(ctx, msm_reference, &len, &sum, SECP256K1_EC_COMPRESSED);
+    }, [&](size_t i) { return i > 0 || memcmp(msm_ours, msm_reference, 33) == 0; }});
+
+    secp256k1_context_destroy(ctx);
+}
+
+#endif
+
+int main(int argc, char** argv) {
+    size_t count = 256;
+    uint64_t seed = 1;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--count") == 0) {
+            count = max<size_t>(strtoull(argv[i + 1], nullptr, 10), 1);
+        } else if (strcmp(argv[i], "--seed") == 0) {
+            seed = strtoull(argv[i + 1], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: ecc_compare [--count N] [--seed S]\n");
+            return 2;
+        }
+    }
+    if (argc % 2 == 0) {
+        fprintf(stderr, "usage: ecc_compare [--count N] [--seed S]\n");
+        return 2;
+    }
+
+    mt19937_64 random(seed);
+    printf("%-22s %12s %12s %8s\n", "ns per operation", "ecc", "reference", "ratio");
+    arithmetic(count, random);
+#ifdef ECC_HAVE_LIBSECP256K1
+    curve(count, random);
+#else
+    printf("(libsecp256k1 not found: sign, verify and MSM not compared)\n");
+#endif
+    if (mismatches) {
+        fprintf(stderr, "%zu results differ from the reference\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
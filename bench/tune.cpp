@@ -0,0 +1,174 @@
+//
+// Created by preston on 10/15/2026.
+//
+// ecc_tune: measures integer's multiplication and radix conversion crossovers
+// on this machine and writes them as an integer_tuning.h, in the manner of
+// GMP's tuneup.
+//
+//     ecc_tune [--out integer_tuning.h] [--max-bits N]
+//
+// Each crossover is tuned in turn, the ones before it already at their tuned
+// values: every candidate threshold is tried over operand sizes spanning its
+// range, and the one whose times, each relative to the best time at its size,
+// add up to the least wins. --max-bits (1048576 by default) bounds the
+// operands, and so how long the NTT crossover takes to find.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "integer.h"
+
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+static integer random_integer(size_t bits, mt19937_64& random) {
+    vector<uint8_t> bytes((bits + 7) / 8);
+    for (uint8_t& b : bytes) {
+        b = static_cast<uint8_t>(random());
+    }
+    bytes[0] |= 0x80;
+    return integer::from_bytes(bytes.data(), bytes.size()) >> (bytes.size() * 8 - bits);
+}
+
+// seconds per call of op: the best of five runs of enough calls to take a millisecond
+static double time_op(const function<void()>& op) {
+    size_t calls = 1;
+    for (;;) {
+        const Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < calls; i++) {
+            op();
+        }
+        if (chrono::duration<double>(Clock::now() - start).count() >= 1e-3) {
+            break;
+        }
+        calls *= 2;
+    }
+    double best = 1e30;
+    for (int run = 0; run < 5; run++) {
+        const Clock::time_point start = Clock::now();
+        for (size_t i = 0; i < calls; i++) {
+            op();
+        }
+        best = min(best, chrono::duration<double>(Clock::now() - start).count() / calls);
+    }
+    return best;
+}
+
+// sizes from lo to hi bits, each about sqrt(2) times the last, multiples of 64
+static vector<size_t> grid(size_t lo, size_t hi) {
+    vector<size_t> out;
+    for (double s = static_cast<double>(lo); s <= static_cast<double>(hi) * 1.01; s *= 1.41421356) {
+        const size_t bits = (static_cast<size_t>(s) + 63) / 64 * 64;
+        if (out.empty() || bits != out.back()) {
+            out.push_back(bits);
+        }
+    }
+    return out;
+}
+
+// the candidate for field of tuning that does best on workload over sizes
+static size_t tune(const char* name, size_t integer::Tuning::*field, const vector<size_t>& candidates,
+                   const vector<size_t>& sizes, const function<function<void()>(size_t)>& workload) {
+    integer::Tuning t = integer::tuning();
+    vector<vector<double>> times(candidates.size(), vector<double>(sizes.size()));
+    for (size_t s = 0; s < sizes.size(); s++) {
+        const function<void()> op = workload(sizes[s]);
+        for (size_t c = 0; c < candidates.size(); c++) {
+            t.*field = candidates[c];
+            integer::set_tuning(t);
+            times[c][s] = time_op(op);
+        }
+    }
+    size_t best = 0;
+    double best_score = 1e30;
+    for (size_t c = 0; c < candidates.size(); c++) {
+        double score = 0;
+        for (size_t s = 0; s < sizes.size(); s++) {
+            double fastest = 1e30;
+            for (size_t k = 0; k < candidates.size(); k++) {
+                fastest = min(fastest, times[k][s]);
+            }
+            score += times[c][s] / fastest;
+        }
+        if (score < best_score) {
+            best_score = score;
+            best = c;
+        }
+    }
+    t.*field = candidates[best];
+    integer::set_tuning(t);
+    fprintf(stderr, "%-16s %8zu bits (%.3f of the best at each size on average)\n", name, candidates[best],
+            best_score / sizes.size());
+    return candidates[best];
+}
+
+int main(int argc, char** argv) {
+    string out = "integer_tuning.h";
+    size_t max_bits = 1 << 20;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--out") == 0) {
+            out = argv[i + 1];
+        } else if (strcmp(argv[i], "--max-bits") == 0) {
+            max_bits = max<size_t>(strtoull(argv[i + 1], nullptr, 10), 4096);
+        } else {
+            fprintf(stderr, "usage: ecc_tune [--out integer_tuning.h] [--max-bits N]\n");
+            return 2;
+        }
+    }
+    if (argc % 2 == 0) {
+        fprintf(stderr, "usage: ecc_tune [--out integer_tuning.h] [--max-bits N]\n");
+        return 2;
+    }
+
+    mt19937_64 random(1);
+    const auto product = [&random](size_t bits) -> function<void()> {
+        const integer a = random_integer(bits, random), b = random_integer(bits, random);
+        return [a, b]() { volatile bool sink = !(a * b); (void) sink; };
+    };
+    const auto digits = [&random](size_t bits) -> function<void()> {
+        const integer a = random_integer(bits, random);
+        return [a]() { volatile size_t sink = a.str(10).size(); (void) sink; };
+    };
+
+    // the later tiers start where the earlier ones were put
+    const size_t comba = tune("comba", &integer::Tuning::comba_bits, grid(128, 4096), grid(128, 8192), product);
+    const size_t karatsuba = tune("karatsuba", &integer::Tuning::karatsuba_bits,
+                                  grid(max<size_t>(256, comba / 2), 16384),
+                                  grid(512, min<size_t>(65536, max_bits)), product);
+    const size_t toom3 = tune("toom3", &integer::Tuning::toom3_bits,
+                              grid(max<size_t>(2048, karatsuba), min<size_t>(262144, max_bits / 2)),
+                              grid(4096, min<size_t>(524288, max_bits)), product);
+    const size_t ntt = tune("ntt", &integer::Tuning::ntt_bits, grid(max<size_t>(8192, toom3), max_bits / 2),
+                            grid(16384, max_bits), product);
+    const size_t radix = tune("radix_dc", &integer::Tuning::radix_dc_bits, grid(512, 65536),
+                              grid(1024, min<size_t>(262144, max_bits)), digits);
+
+    FILE* f = fopen(out.c_str(), "w");
+    if (!f) {
+        fprintf(stderr, "ecc_tune: cannot write %s\n", out.c_str());
+        return 2;
+    }
+    char date[32];
+    const time_t now = time(nullptr);
+    strftime(date, sizeof(date), "%Y-%m-%d", localtime(&now));
+    fprintf(f, "// Generated by ecc_tune on %s for the machine it ran on; see integer.h\n\n", date);
+    const pair<const char*, size_t> values[] = {
+        {"INTEGER_COMBA_BITS", comba}, {"INTEGER_KARATSUBA_BITS", karatsuba}, {"INTEGER_TOOM3_BITS", toom3},
+        {"INTEGER_NTT_BITS", ntt}, {"INTEGER_RADIX_DC_BITS", radix},
+    };
+    for (const auto& v : values) {
+        fprintf(f, "#ifndef %s\n#define %-24s%zu\n#endif\n", v.first, v.first, v.second);
+    }
+    fclose(f);
+    fprintf(stderr, "wrote %s\n", out.c_str());
+    return 0;
+}
@@ -0,0 +1,109 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <stdexcept>
+#include "BarrettReducer.h"
+#include "OperationCounters.h"
+
+typedef INTEGER_DIGIT_T digit;
+typedef INTEGER_DOUBLE_DIGIT_T double_digit;
+
+BarrettReducer::BarrettReducer(const integer& modulus) {
+    if (modulus < 1) {
+        throw std::invalid_argument("Barrett modulus must be positive");
+    }
+    this->m = modulus;
+    this->k = modulus.digits();
+    integer::REP power(2 * this->k + 1, 0);
+    power[2 * this->k] = 1;
+    this->factor = integer(power) / modulus;
+}
+
+// sets r = r - m if r >= m; r and m both have n digits
+static bool subtract_if_ge(digit* r, const digit* m, integer::REP_SIZE_T n) {
+    for (integer::REP_SIZE_T i = n; i > 0; i--) {
+        if (r[i - 1] != m[i - 1]) {
+            if (r[i - 1] < m[i - 1]) {
+                return false;
+            }
+            break;
+        }
+    }
+    digit borrow = 0;
+    for (integer::REP_SIZE_T i = 0; i < n; i++) {
+        const digit d = r[i] - m[i];
+        const digit next = (r[i] < m[i]) | (d < borrow);
+        r[i] = d - borrow;
+        borrow = next;
+    }
+    return true;
+}
+
+integer BarrettReducer::reduce(const integer& x) const {
+    if (x < 0) {
+        const integer r = reduce(-x);
+        return r ? this->m - r : r;
+    }
+    if (x < this->m) {
+        return x;
+    }
+    const integer::REP_SIZE_T k = this->k;
+    if (x.digits() > 2 * k) {
+        return x % this->m;
+    }
+    ECC_COUNT(barrett_reductions);
+
+    const integer::REP& xd = x._value;
+    const integer::REP& md = this->m._value;
+    const integer::REP& mu = this->factor._value;
+    const integer::REP_SIZE_T n = xd.size();
+
+    // q3 = floor(floor(x / b^(k - 1)) * mu / b^(k + 1)), at most 2 below x / m
+    const integer::REP_SIZE_T q1n = n - (k - 1);
+    integer::REP t(q1n + mu.size(), 0);
+    for (integer::REP_SIZE_T i = 0; i < q1n; i++) {
+        double_digit carry = 0;
+        for (integer::REP_SIZE_T j = 0; j < mu.size(); j++) {
+            const double_digit p = static_cast <double_digit> (xd[k - 1 + i]) * mu[j] + t[i + j] + carry;
+            t[i + j] = static_cast <digit> (p);
+            carry = p >> integer::BITS;
+        }
+        t[i + mu.size()] = static_cast <digit> (carry);
+    }
+    const digit* q3 = t.data() + (k + 1);
+    const integer::REP_SIZE_T q3n = t.size() > k + 1 ? t.size() - (k + 1) : 0;
+
+    // r = x - q3 * m, which is below 3m, so only the low k + 1 digits are needed
+    integer::REP r(k + 1, 0);
+    for (integer::REP_SIZE_T i = 0; i < k + 1 && i < n; i++) {
+        r[i] = xd[i];
+    }
+    integer::REP s(k + 1, 0);
+    for (integer::REP_SIZE_T i = 0; i < q3n && i < k + 1; i++) {
+        double_digit carry = 0;
+        integer::REP_SIZE_T j = 0;
+        for (; j < md.size() && i + j < k + 1; j++) {
+            const double_digit p = static_cast <double_digit> (q3[i]) * md[j] + s[i + j] + carry;
+            s[i + j] = static_cast <digit> (p);
+            carry = p >> integer::BITS;
+        }
+        if (i + j < k + 1) {
+            s[i + j] = static_cast <digit> (carry);
+        }
+    }
+    digit borrow = 0;
+    for (integer::REP_SIZE_T i = 0; i < k + 1; i++) {
+        const digit d = r[i] - s[i];
+        const digit next = (r[i] < s[i]) | (d < borrow);
+        r[i] = d - borrow;
+        borrow = next;
+    }
+
+    integer::REP mk(k + 1, 0);
+    for (integer::REP_SIZE_T i = 0; i < k; i++) {
+        mk[i] = md[i];
+    }
+    while (subtract_if_ge(r.data(), mk.data(), k + 1)) {
+    }
+    return integer(r);
+}
@@ -0,0 +1,33 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_BARRETTREDUCER_H
+#define ECC_BARRETTREDUCER_H
+
+#include "integer.h"
+
+// Division-free x mod m for a modulus that is reused (HAC 14.42). With k the
+// number of digits of m and b the digit base, mu = floor(b^2k / m) is computed
+// once; after that any 0 <= x < b^2k, which covers every product of two reduced
+// values, costs two multiplications and at most two subtractions of m. Unlike
+// Montgomery reduction the values stay in ordinary form and m may be even.
+class BarrettReducer {
+public:
+    explicit BarrettReducer(const integer& modulus);
+
+    const integer& modulus() const { return this->m; }
+    const integer& mu() const { return this->factor; }
+
+    // x mod m in [0, m) for any x; values of 2k digits or more fall back to division
+    integer reduce(const integer& x) const;
+    // a * b mod m
+    integer mul(const integer& a, const integer& b) const { return reduce(a * b); }
+
+private:
+    integer m;
+    integer factor;
+    integer::REP_SIZE_T k;
+};
+
+#endif //ECC_BARRETTREDUCER_H
@@ -0,0 +1,324 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+
+#include "BinaryField.h"
+#include "Status.h"
+
+namespace {
+
+// the 128-bit carry-less product of a and b: the multiples of a by every
+// 4-bit polynomial, with a's top three bits cleared so that none overflows,
+// then b four bits at a time, and the three top bits of a added back last
+inline void clmul64(limb_t a, limb_t b, limb_t& lo, limb_t& hi) {
+    limb_t u[16];
+    const limb_t a0 = a & 0x1FFFFFFFFFFFFFFF;
+    u[0] = 0;
+    u[1] = a0;
+    for (std::size_t i = 2; i < 16; i += 2) {
+        u[i] = u[i / 2] << 1;
+        u[i + 1] = u[i] ^ a0;
+    }
+    lo = u[b & 15];
+    hi = 0;
+    for (unsigned i = 4; i < 64; i += 4) {
+        const limb_t t = u[(b >> i) & 15];
+        lo ^= t << i;
+        hi ^= t >> (64 - i);
+    }
+    for (unsigned j = 61; j < 64; j++) {
+        const limb_t mask = 0 - ((a >> j) & 1);
+        lo ^= (b << j) & mask;
+        hi ^= (b >> (64 - j)) & mask;
+    }
+}
+
+void portable_mul(limb_t* out, const limb_t* a, const limb_t* b, std::size_t n) {
+    std::fill(out, out + 2 * n, 0);
+    for (std::size_t i = 0; i < n; i++) {
+        for (std::size_t j = 0; j < n; j++) {
+            limb_t lo, hi;
+            clmul64(a[i], b[j], lo, hi);
+            out[i + j] ^= lo;
+            out[i + j + 1] ^= hi;
+        }
+    }
+}
+
+// the bits of x at the even positions of the result: x^i -> x^2i
+inline limb_t spread32(uint32_t x) {
+    limb_t v = x;
+    v = (v | (v << 16)) & 0x0000FFFF0000FFFF;
+    v = (v | (v << 8)) & 0x00FF00FF00FF00FF;
+    v = (v | (v << 4)) & 0x0F0F0F0F0F0F0F0F;
+    v = (v | (v << 2)) & 0x3333333333333333;
+    v = (v | (v << 1)) & 0x5555555555555555;
+    return v;
+}
+
+// x[0, len) ^= h[0, hn) << shift, dropping what lands past len
+void xor_shifted(limb_t* x, std::size_t len, const limb_t* h, std::size_t hn, unsigned shift) {
+    const std::size_t words = shift / 64;
+    const unsigned bits = shift % 64;
+    for (std::size_t i = 0; i < hn && i + words < len; i++) {
+        x[i + words] ^= h[i] << bits;
+        if (bits && i + words + 1 < len) {
+            x[i + words + 1] ^= h[i] >> (64 - bits);
+        }
+    }
+}
+
+}
+
+const ClmulKernel& portable_clmul_kernel() {
+    static const ClmulKernel kernel = {"portable", portable_mul};
+    return kernel;
+}
+
+const ClmulKernel& clmul_kernel() {
+    static const ClmulKernel* kernel = []() {
+        if (const ClmulKernel* k = pclmul_clmul_kernel()) {
+            return k;
+        }
+        if (const ClmulKernel* k = pmull_clmul_kernel()) {
+            return k;
+        }
+        return &portable_clmul_kernel();
+    }();
+    return *kernel;
+}
+
+// BinaryField
+
+const BinaryField& BinaryField::get(unsigned m, unsigned k1, unsigned k2, unsigned k3) {
+    // never freed: elements keep raw pointers to their field
+    static std::mutex lock;
+    static std::map<std::tuple<unsigned, unsigned, unsigned, unsigned>, std::unique_ptr<const BinaryField>> fields;
+
+    std::lock_guard<std::mutex> guard(lock);
+    const auto key = std::make_tuple(m, k1, k2, k3);
+    auto it = fields.find(key);
+    if (it == fields.end()) {
+        it = fields.emplace(key, std::unique_ptr<const BinaryField>(new BinaryField(m, k1, k2, k3))).first;
+    }
+    return *it->second;
+}
+
+const BinaryField& BinaryField::sect233() {
+    static const BinaryField& field = get(233, 74);
+    return field;
+}
+
+const BinaryField& BinaryField::sect283() {
+    static const BinaryField& field = get(283, 12, 7, 5);
+    return field;
+}
+
+BinaryField::BinaryField(unsigned m, unsigned k1, unsigned k2, unsigned k3) : m(m), k{k1, k2, k3} {
+    const bool trinomial = k2 == 0 && k3 == 0;
+    if (m > 64 * MAX_LIMBS || k1 >= m || k1 == 0 || (!trinomial && !(k1 > k2 && k2 > k3 && k3 > 0))) {
+        throw std::invalid_argument("Binary field needs x^m + x^k1 + 1 or x^m + x^k1 + x^k2 + x^k3 + 1, m > k1 > k2 > k3 > 0");
+    }
+    this->n = (m + 63) / 64;
+}
+
+integer BinaryField::polynomial() const {
+    integer f = integer(1) << this->m;
+    f |= integer(1);
+    for (unsigned t : this->k) {
+        if (t) {
+            f |= integer(1) << t;
+        }
+    }
+    return f;
+}
+
+// x^(m + i) = x^i (x^k1 + x^k2 + x^k3 + 1): the part h at and above x^m is
+// cut off and added back at shifts 0, k1, k2 and k3, until nothing is left
+// above; each fold lowers the degree by m - k1
+void BinaryField::reduce(limb_t* out, limb_t* x) const {
+    const std::size_t len = 2 * this->n;
+    const std::size_t top = this->m / 64;
+    const unsigned bits = this->m % 64;
+    limb_t h[2 * MAX_LIMBS];
+    for (;;) {
+        // h = x >> m
+        const std::size_t hn = len - top;
+        bool any = false;
+        for (std::size_t i = 0; i < hn; i++) {
+            limb_t w = x[top + i] >> bits;
+            if (bits && top + i + 1 < len) {
+                w |= x[top + i + 1] << (64 - bits);
+            }
+            h[i] = w;
+            any |= w != 0;
+        }
+        if (!any) {
+            break;
+        }
+        x[top] &= bits ? (limb_t(1) << bits) - 1 : 0;
+        std::fill(x + top + 1, x + len, 0);
+        xor_shifted(x, len, h, hn, 0);
+        for (unsigned t : this->k) {
+            if (t) {
+                xor_shifted(x, len, h, hn, t);
+            }
+        }
+    }
+    std::copy(x, x + this->n, out);
+}
+
+// BinaryFieldElement
+
+BinaryFieldElement::BinaryFieldElement(const BinaryField& field) : field(&field), v{} {
+}
+
+BinaryFieldElement::BinaryFieldElement(const integer& bits, const BinaryField& field) : BinaryFieldElement(field) {
+    if (bits < 0 || bits.bit_length() > field.degree()) {
+        throw_status(Status::out_of_range, "Polynomial is not below the field degree");
+    }
+    for (std::size_t i = 0; i < field.limbs(); i++) {
+        this->v[i] = bits.extract_bits(64 * i, 64);
+    }
+}
+
+BinaryFieldElement BinaryFieldElement::zero(const BinaryField& field) {
+    return BinaryFieldElement(field);
+}
+
+BinaryFieldElement BinaryFieldElement::one(const BinaryField& field) {
+    BinaryFieldElement out(field);
+    out.v[0] = 1;
+    return out;
+}
+
+bool BinaryFieldElement::is_zero() const {
+    for (std::size_t i = 0; i < this->field->limbs(); i++) {
+        if (this->v[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+integer BinaryFieldElement::value() const {
+    integer out;
+    for (std::size_t i = this->field->limbs(); i-- > 0;) {
+        out = (out << 64) | integer(this->v[i]);
+    }
+    return out;
+}
+
+void BinaryFieldElement::check_field(const BinaryFieldElement& other) const {
+    if (this->field != other.field) {
+        throw_status(Status::field_mismatch, "Cannot combine numbers in different fields");
+    }
+}
+
+BinaryFieldElement& BinaryFieldElement::operator+=(const BinaryFieldElement& other) {
+    check_field(other);
+    for (std::size_t i = 0; i < this->field->limbs(); i++) {
+        this->v[i] ^= other.v[i];
+    }
+    return *this;
+}
+
+BinaryFieldElement& BinaryFieldElement::operator*=(const BinaryFieldElement& other) {
+    check_field(other);
+    limb_t wide[2 * BinaryField::MAX_LIMBS];
+    clmul_kernel().mul(wide, this->v, other.v, this->field->limbs());
+    this->field->reduce(this->v, wide);
+    return *this;
+}
+
+void BinaryFieldElement::square_times(std::size_t count) {
+    const std::size_t n = this->field->limbs();
+    limb_t wide[2 * BinaryField::MAX_LIMBS];
+    for (; count; count--) {
+        for (std::size_t i = 0; i < n; i++) {
+            wide[2 * i] = spread32(static_cast<uint32_t>(this->v[i]));
+            wide[2 * i + 1] = spread32(static_cast<uint32_t>(this->v[i] >> 32));
+        }
+        this->field->reduce(this->v, wide);
+    }
+}
+
+BinaryFieldElement BinaryFieldElement::square() const {
+    BinaryFieldElement out(*this);
+    out.square_times(1);
+    return out;
+}
+
+// Itoh and Tsujii: a^-1 = (a^(2^(m - 1) - 1))^2, and b_k = a^(2^k - 1) has
+// b_(j + k) = b_j^(2^k) b_k, so b_(m - 1) follows the bits of m - 1 from the
+// top, doubling k (b_2k = b_k^(2^k) b_k) and stepping it by one (b_(k + 1) =
+// b_k^2 a) for each set bit
+BinaryFieldElement BinaryFieldElement::inverse() const {
+    if (is_zero()) {
+        throw_status(Status::division_by_zero, "Cannot invert zero");
+    }
+    const unsigned e = this->field->degree() - 1;
+    BinaryFieldElement b = *this;
+    std::size_t k = 1;
+    unsigned top = 0;
+    while ((e >> (top + 1)) != 0) {
+        top++;
+    }
+    for (unsigned i = top; i-- > 0;) {
+        BinaryFieldElement t = b;
+        t.square_times(k);
+        b *= t;
+        k *= 2;
+        if ((e >> i) & 1) {
+            b.square_times(1);
+            b *= *this;
+            k++;
+        }
+    }
+    b.square_times(1);
+    return b;
+}
+
+BinaryFieldElement BinaryFieldElement::sqrt() const {
+    BinaryFieldElement out(*this);
+    out.square_times(this->field->degree() - 1);
+    return out;
+}
+
+BinaryFieldElement BinaryFieldElement::power(const integer& exponent) const {
+    if (exponent < 0) {
+        return inverse().power(-exponent);
+    }
+    BinaryFieldElement out = one(*this->field);
+    for (std::size_t i = exponent.bit_length(); i > 0; i--) {
+        out.square_times(1);
+        if (exponent.test_bit(i - 1)) {
+            out *= *this;
+        }
+    }
+    return out;
+}
+
+unsigned BinaryFieldElement::trace() const {
+    BinaryFieldElement t(*this), sum(*this);
+    for (unsigned i = 1; i < this->field->degree(); i++) {
+        t.square_times(1);
+        sum += t;
+    }
+    return static_cast<unsigned>(sum.v[0] & 1);
+}
+
+bool operator==(const BinaryFieldElement& lhs, const BinaryFieldElement& rhs) {
+    lhs.check_field(rhs);
+    return std::equal(lhs.v, lhs.v + lhs.field->limbs(), rhs.v);
+}
+
+std::ostream& operator<<(std::ostream& os, const BinaryFieldElement& a) {
+    return os << "BinaryFieldElement(" << a.value() << ", " << a.field->degree() << ")";
+}
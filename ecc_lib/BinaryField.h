@@ -0,0 +1,126 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_BINARYFIELD_H
+#define ECC_BINARYFIELD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+#include "integer.h"
+#include "limb.h"
+
+// Carry-less products: polynomials over GF(2) in 64-bit limbs, least
+// significant first, bit i of the polynomial the coefficient of x^i. One table
+// per instruction set, as with the field kernels; clmul_kernel() checks the
+// CPU once and hands out the best the CPU runs.
+struct ClmulKernel {
+    const char* name;
+    // out[0, 2n) = a[0, n) * b[0, n); out must not overlap a or b
+    void (*mul)(limb_t* out, const limb_t* a, const limb_t* b, std::size_t n);
+};
+
+// 64 x 64 products from a table of the 16 multiples of a by 4-bit
+// polynomials, four bits of b a step
+const ClmulKernel& portable_clmul_kernel();
+// PCLMULQDQ, one instruction a limb product; null without it
+const ClmulKernel* pclmul_clmul_kernel();
+// AArch64 PMULL; null on other architectures or without it
+const ClmulKernel* pmull_clmul_kernel();
+const ClmulKernel& clmul_kernel();
+
+// GF(2^m) as GF(2)[x] / f(x) for a trinomial f = x^m + x^k1 + 1 or a
+// pentanomial f = x^m + x^k1 + x^k2 + x^k3 + 1, the reduction polynomials of
+// the SEC 2 and NIST binary curves. Reduction folds the bits at and above x^m
+// down by the few terms of f with shifts and exclusive ors, two folds for
+// k1 <= m / 2, with no division. Descriptors are interned like PrimeField's.
+class BinaryField {
+public:
+    // up to m = 576 bits, which covers sect571
+    static constexpr std::size_t MAX_LIMBS = 9;
+
+    // throws std::invalid_argument unless m > k1 > k2 > k3 >= 0 with m at most
+    // 64 MAX_LIMBS, and k2 = k3 = 0 (a trinomial) or k3 > 0 (a pentanomial)
+    static const BinaryField& get(unsigned m, unsigned k1, unsigned k2 = 0, unsigned k3 = 0);
+    // x^233 + x^74 + 1 (sect233k1, sect233r1)
+    static const BinaryField& sect233();
+    // x^283 + x^12 + x^7 + x^5 + 1 (sect283k1, sect283r1)
+    static const BinaryField& sect283();
+
+    BinaryField(const BinaryField&) = delete;
+    BinaryField& operator=(const BinaryField&) = delete;
+
+    unsigned degree() const { return this->m; }
+    std::size_t limbs() const { return this->n; }
+    // the reduction polynomial as an integer, bit i the coefficient of x^i
+    integer polynomial() const;
+
+    // out[0, n) = x mod f for x of 2n limbs, which is clobbered; out may be x
+    void reduce(limb_t* out, limb_t* x) const;
+
+private:
+    unsigned m;
+    unsigned k[3];          // middle terms, zero past the last
+    std::size_t n;          // limbs of an element
+
+    BinaryField(unsigned m, unsigned k1, unsigned k2, unsigned k3);
+};
+
+// An element of a BinaryField: a polynomial of degree below m. Addition and
+// subtraction are both exclusive or; products go through clmul_kernel() and
+// BinaryField::reduce; squaring spreads the bits out (x^i -> x^2i is linear
+// over GF(2)) by shifts and masks; inversion is Itoh and Tsujii's, about m
+// squarings and 2 log2(m) products; square roots are m - 1 squarings. Not
+// constant time.
+class BinaryFieldElement {
+public:
+    // bit i of bits is the coefficient of x^i; throws std::invalid_argument
+    // for a negative value or one of degree m or more
+    BinaryFieldElement(const integer& bits, const BinaryField& field);
+    static BinaryFieldElement zero(const BinaryField& field);
+    static BinaryFieldElement one(const BinaryField& field);
+
+    const BinaryField& binary_field() const { return *this->field; }
+    bool is_zero() const;
+    integer value() const;
+
+    // every binary operation throws std::runtime_error for elements of
+    // different fields
+    BinaryFieldElement& operator+=(const BinaryFieldElement& other);
+    BinaryFieldElement& operator-=(const BinaryFieldElement& other) { return *this += other; }
+    BinaryFieldElement& operator*=(const BinaryFieldElement& other);
+    // throws std::domain_error for zero
+    BinaryFieldElement& operator/=(const BinaryFieldElement& other) { return *this *= other.inverse(); }
+    friend BinaryFieldElement operator+(BinaryFieldElement lhs, const BinaryFieldElement& rhs) { return lhs += rhs; }
+    friend BinaryFieldElement operator-(BinaryFieldElement lhs, const BinaryFieldElement& rhs) { return lhs += rhs; }
+    friend BinaryFieldElement operator*(BinaryFieldElement lhs, const BinaryFieldElement& rhs) { return lhs *= rhs; }
+    friend BinaryFieldElement operator/(BinaryFieldElement lhs, const BinaryFieldElement& rhs) { return lhs /= rhs; }
+
+    BinaryFieldElement square() const;
+    // throws std::domain_error for zero
+    BinaryFieldElement inverse() const;
+    // every element has exactly one, a^(2^(m - 1))
+    BinaryFieldElement sqrt() const;
+    // exponent < 0 inverts first
+    BinaryFieldElement power(const integer& exponent) const;
+    // a + a^2 + a^4 + ... + a^(2^(m - 1)), which is 0 or 1: whether
+    // z^2 + z = a has a solution (trace 0), as point decompression asks
+    unsigned trace() const;
+
+    friend bool operator==(const BinaryFieldElement& lhs, const BinaryFieldElement& rhs);
+    friend bool operator!=(const BinaryFieldElement& lhs, const BinaryFieldElement& rhs) { return !(lhs == rhs); }
+    friend std::ostream& operator<<(std::ostream& os, const BinaryFieldElement& a);
+
+private:
+    const BinaryField* field;
+    limb_t v[BinaryField::MAX_LIMBS];
+
+    explicit BinaryFieldElement(const BinaryField& field);
+    void check_field(const BinaryFieldElement& other) const;
+    // n squarings in place
+    void square_times(std::size_t n);
+};
+
+#endif //ECC_BINARYFIELD_H
@@ -0,0 +1,54 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include "BinaryField.h"
+
+#if defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#endif
+
+#if defined(__clang__)
+#define ECC_ARMV8_PMULL __attribute__((target("aes")))
+#else
+#define ECC_ARMV8_PMULL __attribute__((target("+crypto")))
+#endif
+
+namespace {
+
+// schoolbook over the limbs, one PMULL (vmull_p64) a limb pair
+ECC_ARMV8_PMULL void pmull_mul(limb_t* out, const limb_t* a, const limb_t* b, std::size_t n) {
+    for (std::size_t i = 0; i < 2 * n; i++) {
+        out[i] = 0;
+    }
+    for (std::size_t i = 0; i < n; i++) {
+        for (std::size_t j = 0; j < n; j++) {
+            const uint64x2_t p = vreinterpretq_u64_p128(vmull_p64(a[i], b[j]));
+            out[i + j] ^= vgetq_lane_u64(p, 0);
+            out[i + j + 1] ^= vgetq_lane_u64(p, 1);
+        }
+    }
+}
+
+}
+
+const ClmulKernel* pmull_clmul_kernel() {
+    static const ClmulKernel kernel = {"pmull", pmull_mul};
+#if defined(__APPLE__)
+    return &kernel;
+#elif defined(__linux__) && defined(HWCAP_PMULL)
+    return (getauxval(AT_HWCAP) & HWCAP_PMULL) ? &kernel : nullptr;
+#else
+    return nullptr;
+#endif
+}
+
+#else
+
+const ClmulKernel* pmull_clmul_kernel() {
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,43 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include "BinaryField.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+#include <immintrin.h>
+
+#define ECC_PCLMUL __attribute__((target("pclmul,sse4.1")))
+
+namespace {
+
+// schoolbook over the limbs, one PCLMULQDQ a limb pair, with the two halves
+// of each 128-bit product added into the row as they come
+ECC_PCLMUL void pclmul_mul(limb_t* out, const limb_t* a, const limb_t* b, std::size_t n) {
+    for (std::size_t i = 0; i < 2 * n; i++) {
+        out[i] = 0;
+    }
+    for (std::size_t i = 0; i < n; i++) {
+        const __m128i ai = _mm_cvtsi64_si128(static_cast<long long>(a[i]));
+        for (std::size_t j = 0; j < n; j++) {
+            const __m128i p = _mm_clmulepi64_si128(ai, _mm_cvtsi64_si128(static_cast<long long>(b[j])), 0x00);
+            out[i + j] ^= static_cast<limb_t>(_mm_cvtsi128_si64(p));
+            out[i + j + 1] ^= static_cast<limb_t>(_mm_extract_epi64(p, 1));
+        }
+    }
+}
+
+}
+
+const ClmulKernel* pclmul_clmul_kernel() {
+    static const ClmulKernel kernel = {"pclmul", pclmul_mul};
+    return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1") ? &kernel : nullptr;
+}
+
+#else
+
+const ClmulKernel* pclmul_clmul_kernel() {
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,115 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include "chacha20.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+#include <immintrin.h>
+
+#define ECC_AVX2 __attribute__((target("avx2")))
+
+// Eight blocks at once, one a lane: vector w holds state word w of every
+// block, so the rounds are the portable ones on vectors and only the counter
+// differs between lanes. The rotations by 16 and 8 are byte shuffles, the
+// others two shifts; the result is transposed back to block order to store.
+
+namespace {
+
+ECC_AVX2 inline __m256i rotl(__m256i x, int n) {
+    return _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - n));
+}
+
+ECC_AVX2 inline void quarter_round(__m256i* x, std::size_t a, std::size_t b, std::size_t c, std::size_t d) {
+    const __m256i rot16 = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+                                           2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+    const __m256i rot8 = _mm256_setr_epi8(3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14,
+                                          3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14);
+    x[a] = _mm256_add_epi32(x[a], x[b]); x[d] = _mm256_shuffle_epi8(_mm256_xor_si256(x[d], x[a]), rot16);
+    x[c] = _mm256_add_epi32(x[c], x[d]); x[b] = rotl(_mm256_xor_si256(x[b], x[c]), 12);
+    x[a] = _mm256_add_epi32(x[a], x[b]); x[d] = _mm256_shuffle_epi8(_mm256_xor_si256(x[d], x[a]), rot8);
+    x[c] = _mm256_add_epi32(x[c], x[d]); x[b] = rotl(_mm256_xor_si256(x[b], x[c]), 7);
+}
+
+// columns r[w] = word w of lanes 0..7 to rows r[l] = words [0, 8) of lane l
+ECC_AVX2 inline void transpose8(__m256i* r) {
+    const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]), t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+    const __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]), t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+    const __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]), t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+    const __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]), t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+    const __m256i u0 = _mm256_unpacklo_epi64(t0, t2), u1 = _mm256_unpackhi_epi64(t0, t2);
+    const __m256i u2 = _mm256_unpacklo_epi64(t1, t3), u3 = _mm256_unpackhi_epi64(t1, t3);
+    const __m256i u4 = _mm256_unpacklo_epi64(t4, t6), u5 = _mm256_unpackhi_epi64(t4, t6);
+    const __m256i u6 = _mm256_unpacklo_epi64(t5, t7), u7 = _mm256_unpackhi_epi64(t5, t7);
+    r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+// every helper is inlined into avx2_blocks, so no vector crosses a call
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+ECC_AVX2 void avx2_blocks(uint8_t* out, const uint32_t* key, uint64_t counter, const uint32_t* nonce) {
+    uint32_t low[8], high[8];
+    for (std::size_t l = 0; l < 8; l++) {
+        low[l] = static_cast<uint32_t>(counter + l);
+        high[l] = static_cast<uint32_t>((counter + l) >> 32);
+    }
+    __m256i in[16];
+    in[0] = _mm256_set1_epi32(0x61707865);
+    in[1] = _mm256_set1_epi32(0x3320646e);
+    in[2] = _mm256_set1_epi32(0x79622d32);
+    in[3] = _mm256_set1_epi32(0x6b206574);
+    for (std::size_t w = 0; w < 8; w++) {
+        in[4 + w] = _mm256_set1_epi32(static_cast<int>(key[w]));
+    }
+    in[12] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(low));
+    in[13] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(high));
+    in[14] = _mm256_set1_epi32(static_cast<int>(nonce[0]));
+    in[15] = _mm256_set1_epi32(static_cast<int>(nonce[1]));
+
+    __m256i x[16];
+    for (std::size_t w = 0; w < 16; w++) {
+        x[w] = in[w];
+    }
+    for (std::size_t i = 0; i < 10; i++) {
+        quarter_round(x, 0, 4, 8, 12);
+        quarter_round(x, 1, 5, 9, 13);
+        quarter_round(x, 2, 6, 10, 14);
+        quarter_round(x, 3, 7, 11, 15);
+        quarter_round(x, 0, 5, 10, 15);
+        quarter_round(x, 1, 6, 11, 12);
+        quarter_round(x, 2, 7, 8, 13);
+        quarter_round(x, 3, 4, 9, 14);
+    }
+    for (std::size_t w = 0; w < 16; w++) {
+        x[w] = _mm256_add_epi32(x[w], in[w]);
+    }
+    transpose8(x);
+    transpose8(x + 8);
+    for (std::size_t l = 0; l < 8; l++) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 64 * l), x[l]);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 64 * l + 32), x[8 + l]);
+    }
+}
+#pragma GCC diagnostic pop
+
+}
+
+const ChaCha20Kernel* avx2_chacha20_kernel() {
+    static const ChaCha20Kernel kernel = {"avx2", 8, avx2_blocks};
+    return __builtin_cpu_supports("avx2") ? &kernel : nullptr;
+}
+
+#else
+
+const ChaCha20Kernel* avx2_chacha20_kernel() {
+    return nullptr;
+}
+
+#endif
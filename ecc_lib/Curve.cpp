@@ -0,0 +1,297 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <algorithm>
+#include <stdexcept>
+
+#include "Curve.h"
+#include "StaticCombTable.h"
+#include "numa.h"
+
+// limbs least significant first; width of them are used, the rest are zero
+struct CurveParameters {
+    const char* name;
+    Curve::backend kind;
+    std::size_t width;
+    limb_t p[6], a[6], b[6], gx[6], gy[6], n[6];
+    limb_t h[2];
+    limb_t beta[4], lambda[4];      // all zero without an endomorphism
+    const limb_t* comb;
+};
+
+namespace {
+
+integer from_limbs(const limb_t* limbs, std::size_t width) {
+    integer out;
+    for (std::size_t i = width; i-- > 0;) {
+        out = (out << 64) | integer(limbs[i]);
+    }
+    return out;
+}
+
+// SEC 2, version 2.0, sections 2.4.1 (secp256k1), 2.4.2 (secp256r1) and 2.5.1 (secp384r1)
+const CurveParameters SECP256K1_PARAMETERS = {
+    "secp256k1", Curve::backend::secp256k1, 4,
+    {0xFFFFFFFEFFFFFC2F, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF},
+    {0, 0, 0, 0},
+    {7, 0, 0, 0},
+    {0x59F2815B16F81798, 0x029BFCDB2DCE28D9, 0x55A06295CE870B07, 0x79BE667EF9DCBBAC},
+    {0x9C47D08FFB10D4B8, 0xFD17B448A6855419, 0x5DA4FBFC0E1108A8, 0x483ADA7726A3C465},
+    {0xBFD25E8CD0364141, 0xBAAEDCE6AF48A03B, 0xFFFFFFFFFFFFFFFE, 0xFFFFFFFFFFFFFFFF},
+    {1, 0},
+    {0xC1396C28719501EE, 0x9CF0497512F58995, 0x6E64479EAC3434E9, 0x7AE96A2B657C0710},
+    {0xDF02967C1B23BD72, 0x122E22EA20816678, 0xA5261C028812645A, 0x5363AD4CC05C30E0},
+    SECP256K1_GENERATOR_COMB.limbs
+};
+
+const CurveParameters P256_PARAMETERS = {
+    "secp256r1", Curve::backend::p256, 4,
+    {0xFFFFFFFFFFFFFFFF, 0x00000000FFFFFFFF, 0x0000000000000000, 0xFFFFFFFF00000001},
+    {0xFFFFFFFFFFFFFFFC, 0x00000000FFFFFFFF, 0x0000000000000000, 0xFFFFFFFF00000001},
+    {0x3BCE3C3E27D2604B, 0x651D06B0CC53B0F6, 0xB3EBBD55769886BC, 0x5AC635D8AA3A93E7},
+    {0xF4A13945D898C296, 0x77037D812DEB33A0, 0xF8BCE6E563A440F2, 0x6B17D1F2E12C4247},
+    {0xCBB6406837BF51F5, 0x2BCE33576B315ECE, 0x8EE7EB4A7C0F9E16, 0x4FE342E2FE1A7F9B},
+    {0xF3B9CAC2FC632551, 0xBCE6FAADA7179E84, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFF00000000},
+    {1, 0},
+    {0, 0, 0, 0},
+    {0, 0, 0, 0},
+    nullptr
+};
+
+const CurveParameters P384_PARAMETERS = {
+    "secp384r1", Curve::backend::generic, 6,
+    {0x00000000FFFFFFFF, 0xFFFFFFFF00000000, 0xFFFFFFFFFFFFFFFE,
+     0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF},
+    {0x00000000FFFFFFFC, 0xFFFFFFFF00000000, 0xFFFFFFFFFFFFFFFE,
+     0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF},
+    {0x2A85C8EDD3EC2AEF, 0xC656398D8A2ED19D, 0x0314088F5013875A,
+     0x181D9C6EFE814112, 0x988E056BE3F82D19, 0xB3312FA7E23EE7E4},
+    {0x3A545E3872760AB7, 0x5502F25DBF55296C, 0x59F741E082542A38,
+     0x6E1D3B628BA79B98, 0x8EB1C71EF320AD74, 0xAA87CA22BE8B0537},
+    {0x7A431D7C90EA0E5F, 0x0A60B1CE1D7E819D, 0xE9DA3113B5F0B8C0,
+     0xF8F41DBD289A147C, 0x5D9E98BF9292DC29, 0x3617DE4A96262C6F},
+    {0xECEC196ACCC52973, 0x581A0DB248B0A77A, 0xC7634D81F4372DDF,
+     0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF},
+    {1, 0},
+    {0, 0, 0, 0},
+    {0, 0, 0, 0},
+    nullptr
+};
+
+// G1 of BLS12-381, y^2 = x^3 + 4 (draft-irtf-cfrg-pairing-friendly-curves,
+// section 4.2.1): the group of prime order r inside E(Fp), of cofactor
+// (x - 1)^2 / 3 for the curve parameter x = -0xd201000000010000
+const CurveParameters BLS12_381_PARAMETERS = {
+    "bls12_381", Curve::backend::generic, 6,
+    {0xB9FEFFFFFFFFAAAB, 0x1EABFFFEB153FFFF, 0x6730D2A0F6B0F624,
+     0x64774B84F38512BF, 0x4B1BA7B6434BACD7, 0x1A0111EA397FE69A},
+    {0, 0, 0, 0, 0, 0},
+    {4, 0, 0, 0, 0, 0},
+    {0xFB3AF00ADB22C6BB, 0x6C55E83FF97A1AEF, 0xA14E3A3F171BAC58,
+     0xC3688C4F9774B905, 0x2695638C4FA9AC0F, 0x17F1D3A73197D794},
+    {0x0CAA232946C5E7E1, 0xD03CC744A2888AE4, 0x00DB18CB2C04B3ED,
+     0xFCF5E095D5D00AF6, 0xA09E30ED741D8AE4, 0x08B3F481E3AAA0F1},
+    {0xFFFFFFFF00000001, 0x53BDA402FFFE5BFE, 0x3339D80809A1D805,
+     0x73EDA753299D7D48, 0, 0},
+    {0x8C00AAAB0000AAAB, 0x396C8C005555E156},
+    {0, 0, 0, 0},
+    {0, 0, 0, 0},
+    nullptr
+};
+
+// the window of every generator table, which the compiled-in one was built with
+constexpr std::size_t TABLE_WINDOW = 4;
+// the window of generator_wnaf: built once, so wider than Point::mul's
+constexpr std::size_t WNAF_WINDOW = 8;
+
+}
+
+Curve::Curve(const CurveParameters& spec)
+        : id(spec.name), kind(spec.kind),
+          fp(&PrimeField::get(from_limbs(spec.p, spec.width))),
+          fn(&PrimeField::get(from_limbs(spec.n, spec.width))),
+          h(from_limbs(spec.h, 2)),
+          ca(from_limbs(spec.a, spec.width), *this->fp),
+          cb(from_limbs(spec.b, spec.width), *this->fp),
+          g(FieldElement(from_limbs(spec.gx, spec.width), *this->fp),
+            FieldElement(from_limbs(spec.gy, spec.width), *this->fp), this->ca, this->cb),
+          beta_v(from_limbs(spec.beta, 4)), lambda_v(from_limbs(spec.lambda, 4)),
+          comb(spec.comb), table_built(false), wnaf_built(false), warming(false) {
+    // the shared pool is started first so that it is destroyed after the
+    // curve, whose destructor may still wait for a warm-up running on it
+    WorkStealingPool::shared();
+}
+
+Curve::~Curve() {
+    if (this->warm_thread.joinable()) {
+        this->warm_thread.join();
+    }
+}
+
+const Curve& Curve::secp256k1() {
+    static const Curve curve(SECP256K1_PARAMETERS);
+    return curve;
+}
+
+const Curve& Curve::p256() {
+    static const Curve curve(P256_PARAMETERS);
+    return curve;
+}
+
+const Curve& Curve::p384() {
+    static const Curve curve(P384_PARAMETERS);
+    return curve;
+}
+
+const Curve& Curve::bls12_381() {
+    static const Curve curve(BLS12_381_PARAMETERS);
+    return curve;
+}
+
+const Curve* Curve::find(const std::string& name) {
+    if (name == "secp256k1") {
+        return &secp256k1();
+    }
+    if (name == "secp256r1" || name == "P-256" || name == "prime256v1") {
+        return &p256();
+    }
+    if (name == "secp384r1" || name == "P-384") {
+        return &p384();
+    }
+    if (name == "bls12_381" || name == "BLS12-381") {
+        return &bls12_381();
+    }
+    return nullptr;
+}
+
+const Curve* Curve::of(const Point& p) {
+    for (const Curve* curve : {&secp256k1(), &p256(), &p384(), &bls12_381()}) {
+        if (&p.curve_a().prime_field() == curve->fp
+            && p.curve_a().value() == curve->ca.value() && p.curve_b().value() == curve->cb.value()) {
+            return curve;
+        }
+    }
+    return nullptr;
+}
+
+const integer& Curve::beta() const {
+    if (!has_endomorphism()) {
+        throw std::domain_error(this->id + " has no efficient endomorphism");
+    }
+    return this->beta_v;
+}
+
+const integer& Curve::lambda() const {
+    if (!has_endomorphism()) {
+        throw std::domain_error(this->id + " has no efficient endomorphism");
+    }
+    return this->lambda_v;
+}
+
+const FixedBaseTable& Curve::generator_table() const {
+    std::call_once(this->table_once, [this]() {
+        const std::size_t bits = n().bit_length();
+        if (this->comb) {
+            this->table.reset(new FixedBaseTable(this->g, bits, TABLE_WINDOW, this->comb));
+        } else {
+            this->table.reset(new FixedBaseTable(this->g, bits, TABLE_WINDOW));
+        }
+        const std::size_t nodes = NumaTopology::system().node_count();
+        if (nodes > 1) {
+            this->node_tables.reset(new std::atomic<const FixedBaseTable*>[nodes]());
+        }
+        this->table_built.store(true, std::memory_order_release);
+    });
+    if (!this->node_tables) {
+        return *this->table;
+    }
+    const std::size_t node = NumaTopology::system().current_node();
+    const FixedBaseTable* local = this->node_tables[node].load(std::memory_order_acquire);
+    return local ? *local : node_table(node);
+}
+
+const FixedBaseTable& Curve::node_table(std::size_t node) const {
+    std::lock_guard<std::mutex> guard(this->node_table_lock);
+    const FixedBaseTable* local = this->node_tables[node].load(std::memory_order_relaxed);
+    if (!local) {
+        this->node_table_storage.emplace_back(new FixedBaseTable(this->table->replicate()));
+        local = this->node_table_storage.back().get();
+        this->node_tables[node].store(local, std::memory_order_release);
+    }
+    return *local;
+}
+
+const WnafTable& Curve::generator_wnaf() const {
+    std::call_once(this->wnaf_once, [this]() {
+        this->wnaf.reset(new WnafTable(this->g.wnaf_table(WNAF_WINDOW)));
+        this->wnaf_built.store(true, std::memory_order_release);
+    });
+    return *this->wnaf;
+}
+
+void Curve::warmup(Executor& executor) const {
+    std::call_once(this->warm_once, [this, &executor]() {
+        this->warming.store(true, std::memory_order_release);
+        this->warm_thread = std::thread([this, &executor]() {
+            executor.run(2, [this](std::size_t task) {
+                if (task == 0) {
+                    generator_table();
+                } else {
+                    generator_wnaf();
+                }
+            });
+        });
+    });
+}
+
+bool Curve::tables_ready() const {
+    return this->table_built.load(std::memory_order_acquire) && this->wnaf_built.load(std::memory_order_acquire);
+}
+
+const FixedBaseTable* Curve::table_if_ready() const {
+    // without a warm-up, the first use builds the table as before
+    if (this->table_built.load(std::memory_order_acquire) || !this->warming.load(std::memory_order_acquire)) {
+        return &generator_table();
+    }
+    return nullptr;
+}
+
+Point Curve::mul_base(const integer& k) const {
+    integer r = k % n();
+    if (r < 0) {
+        r += n();
+    }
+    const FixedBaseTable* table = table_if_ready();
+    return table ? table->mul(r) : this->g.mul(r);
+}
+
+Point Curve::mul_base_ct(const integer& k) const {
+    if (k < 0 || k >= n()) {
+        throw std::invalid_argument("Scalar must be in [0, n)");
+    }
+    const FixedBaseTable* table = table_if_ready();
+    return table ? table->mul_ct(k) : this->g.mul_ct(k);
+}
+
+std::vector<Point> Curve::mul_base_range(const integer& start, std::size_t count) const {
+    // long enough that the inversion is a few multiplications a key, short
+    // enough that the chunk's points stay in cache
+    static constexpr std::size_t CHUNK = 512;
+    std::vector<Point> out;
+    out.reserve(count);
+    Point p = mul_base(start);
+    std::vector<Point> chunk;
+    chunk.reserve(std::min(count, CHUNK));
+    for (std::size_t i = 0; i < count; i++) {
+        chunk.push_back(p);
+        if (chunk.size() == CHUNK || i + 1 == count) {
+            Point::batch_normalize(chunk);
+            out.insert(out.end(), chunk.begin(), chunk.end());
+            chunk.clear();
+        }
+        if (i + 1 < count) {
+            p += this->g;
+        }
+    }
+    return out;
+}
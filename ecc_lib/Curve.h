@@ -0,0 +1,145 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_CURVE_H
+#define ECC_CURVE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Executor.h"
+#include "FieldElement.h"
+#include "FixedBaseTable.h"
+#include "integer.h"
+#include "Point.h"
+#include "PrimeField.h"
+
+struct CurveParameters;
+
+// The domain parameters of a standard curve y^2 = x^3 + ax + b: the field
+// prime p, a, b, the generator G of prime order n and the cofactor h, with
+// everything derived from them. The parameters are compiled in as limbs, so no
+// hex string is parsed; each curve is built once on its first lookup and the
+// same object is returned after that, so looking one up again costs a guard
+// check. The fields come from PrimeField::get(), which binds the special
+// reductions and addition chains, so elements and points made from a Curve
+// take every fast path their prime has.
+class Curve {
+public:
+    // the specialized arithmetic behind the curve's field
+    enum class backend {
+        generic,        // Montgomery (or Barrett above 256 bits) for any prime
+        secp256k1,      // 2^256 - 2^32 - 977 folding, addition chains, GLV endomorphism
+        p256            // Solinas reduction, addition chains for inversion and square roots
+    };
+
+    static const Curve& secp256k1();
+    static const Curve& p256();
+    static const Curve& p384();
+    // G1 of the pairing-friendly BLS12-381, whose G2 and pairing are in bls12_381.h
+    static const Curve& bls12_381();
+    // by SEC 2 or NIST name: "secp256k1", "secp256r1" ("P-256", "prime256v1"),
+    // "secp384r1" ("P-384"), and "bls12_381" ("BLS12-381"); null for any other name
+    static const Curve* find(const std::string& name);
+    // the registered curve p lies on (same field, a and b), or null
+    static const Curve* of(const Point& p);
+
+    Curve(const Curve&) = delete;
+    Curve& operator=(const Curve&) = delete;
+    // waits for a warm-up still running
+    ~Curve();
+
+    const std::string& name() const { return this->id; }
+    backend reduction() const { return this->kind; }
+    const PrimeField& field() const { return *this->fp; }
+    // the field of scalars mod n
+    const PrimeField& scalar_field() const { return *this->fn; }
+    const integer& p() const { return this->fp->prime(); }
+    const integer& n() const { return this->fn->prime(); }
+    const integer& cofactor() const { return this->h; }
+    const FieldElement& a() const { return this->ca; }
+    const FieldElement& b() const { return this->cb; }
+    // normalized, plain representation
+    const Point& generator() const { return this->g; }
+    // the point at infinity
+    Point infinity() const { return Point(this->ca, this->cb); }
+
+    // lambda * (x, y) = (beta * x, y) for a cube root of unity beta mod p and
+    // lambda mod n; beta() and lambda() throw std::domain_error without one
+    bool has_endomorphism() const { return !!this->beta_v; }
+    const integer& beta() const;
+    const integer& lambda() const;
+
+    // multiples of G for scalars below 2^(bits of n) in windows of 4 bits:
+    // compiled in for secp256k1, built on first use (once, from any thread)
+    // for the others. On a machine of several NUMA nodes, the copy of the
+    // calling thread's node (FixedBaseTable::replicate, made by the first
+    // thread to ask from there), so threads pinned to a node read only memory
+    // of that node
+    const FixedBaseTable& generator_table() const;
+    // G's odd multiples for the interleaved wNAF of Point::mul_add, in
+    // windows of 8 and built on first use (once, from any thread), for
+    // verifications that keep the key's tables too (KeyTableCache)
+    const WnafTable& generator_wnaf() const;
+    // builds generator_table and generator_wnaf in the background, as two
+    // tasks handed to executor.run from a thread of the curve's own, and
+    // returns at once: a process warms the curves it serves at startup
+    // without waiting for them. Until the generator table is ready mul_base
+    // and mul_base_ct take the table-free Point::mul and mul_ct rather than
+    // wait for it; generator_table() itself still waits. Later calls do
+    // nothing. executor must outlive the warm-up; WorkStealingPool::shared()
+    // does, as every curve starts that pool in its constructor and so is
+    // destroyed, joining the warm-up, before the pool is
+    void warmup(Executor& executor) const;
+    // whether both generator tables are built, by warmup or a first use
+    bool tables_ready() const;
+
+    // k * G for any k, reduced mod n first
+    Point mul_base(const integer& k) const;
+    // k * G for secret k, 0 <= k < n, by FixedBaseTable::mul_ct; throws
+    // std::invalid_argument for k out of range
+    Point mul_base_ct(const integer& k) const;
+    // (start + i) * G for i in [0, count), normalized: one mul_base, then each
+    // key the last plus G by a mixed addition, and every chunk of keys
+    // normalized with one inversion (Point::batch_normalize), for sequential
+    // key ranges such as test fixtures and derivation scans
+    std::vector<Point> mul_base_range(const integer& start, std::size_t count) const;
+
+private:
+    std::string id;
+    backend kind;
+    const PrimeField* fp;
+    const PrimeField* fn;
+    integer h;
+    FieldElement ca, cb;
+    Point g;
+    integer beta_v, lambda_v;       // zero without an endomorphism
+    const limb_t* comb;             // compiled-in generator table, or null
+    mutable std::once_flag table_once;
+    mutable std::unique_ptr<const FixedBaseTable> table;
+    // one slot per NUMA node when there is more than one
+    mutable std::unique_ptr<std::atomic<const FixedBaseTable*>[]> node_tables;
+    mutable std::vector<std::unique_ptr<const FixedBaseTable>> node_table_storage;
+    mutable std::mutex node_table_lock;
+    mutable std::once_flag wnaf_once;
+    mutable std::unique_ptr<const WnafTable> wnaf;
+    // set as each table's build finishes, and when warmup starts
+    mutable std::atomic<bool> table_built;
+    mutable std::atomic<bool> wnaf_built;
+    mutable std::atomic<bool> warming;
+    mutable std::once_flag warm_once;
+    mutable std::thread warm_thread;
+
+    explicit Curve(const CurveParameters& spec);
+    const FixedBaseTable& node_table(std::size_t node) const;
+    // the generator table, or null while a warm-up is still building it
+    const FixedBaseTable* table_if_ready() const;
+};
+
+#endif //ECC_CURVE_H
@@ -0,0 +1,222 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_CURVE25519FIELD51_H
+#define ECC_CURVE25519FIELD51_H
+
+#include <cstdint>
+#include <ostream>
+
+#include "curve25519.h"
+#include "integer.h"
+#include "modexp.h"
+#include "uint256.h"
+
+// An element of GF(2^255 - 19) as five 51-bit limbs in 64-bit words, least
+// significant first, in the style of curve25519-donna: 2^255 = 19 (mod p), so a
+// product folds its upper columns back in with one multiplication by 19 each.
+// Values are kept loosely reduced rather than below p. Products, squares and
+// mul_small() leave every limb below 2^52; a sum of two such values has limbs
+// below 2^53, and a difference (which adds 4p first) below 2^54. Products and
+// squares take limbs up to 2^54, so any sum or difference of two reduced values
+// can be multiplied directly; nothing wider may be. Every operation runs the
+// same steps for every value. Needs 128-bit products, as Secp256k1Field52.
+#if defined(__SIZEOF_INT128__)
+class Curve25519Field51 {
+public:
+    Curve25519Field51() : n{0, 0, 0, 0, 0} {}
+    explicit Curve25519Field51(uint64_t small) : n{small & M, small >> 51, 0, 0, 0} {}
+    // the 255 low bits of the little-endian in[0, 32), as RFC 7748 decodes u;
+    // values from p to 2^255 - 1 are accepted and reduced
+    static Curve25519Field51 from_bytes(const uint8_t* in) {
+        Curve25519Field51 out;
+        out.n[0] = load64(in) & M;
+        out.n[1] = (load64(in + 6) >> 3) & M;
+        out.n[2] = (load64(in + 12) >> 6) & M;
+        out.n[3] = (load64(in + 19) >> 1) & M;
+        out.n[4] = (load64(in + 24) >> 12) & M;
+        return out;
+    }
+
+    // the value below p, little-endian in out[0, 32)
+    void to_bytes(uint8_t* out) const {
+        uint64_t t[5] = {this->n[0], this->n[1], this->n[2], this->n[3], this->n[4]};
+        carry(t);
+        carry(t);
+        // below 2^255 + 19 now; q = 1 exactly when the value is at least p
+        uint64_t q = (t[0] + 19) >> 51;
+        for (std::size_t i = 1; i < 5; i++) {
+            q = (t[i] + q) >> 51;
+        }
+        t[0] += 19 * q;
+        for (std::size_t i = 0; i < 4; i++) {
+            t[i + 1] += t[i] >> 51;
+            t[i] &= M;
+        }
+        t[4] &= M;
+
+        const uint64_t w[4] = {t[0] | (t[1] << 51), (t[1] >> 13) | (t[2] << 38),
+                               (t[2] >> 26) | (t[3] << 25), (t[3] >> 39) | (t[4] << 12)};
+        for (std::size_t i = 0; i < 32; i++) {
+            out[i] = static_cast<uint8_t>(w[i / 8] >> (8 * (i % 8)));
+        }
+    }
+
+    uint256 to_uint256() const {
+        uint8_t bytes[32];
+        to_bytes(bytes);
+        uint256 out(0);
+        for (std::size_t i = 0; i < 32; i++) {
+            out.limb[i / 8] |= static_cast<limb_t>(bytes[i]) << (8 * (i % 8));
+        }
+        return out;
+    }
+    integer value() const { return to_uint256().to_integer(); }
+
+    friend Curve25519Field51 operator+(const Curve25519Field51& a, const Curve25519Field51& b) {
+        Curve25519Field51 out;
+        for (std::size_t i = 0; i < 5; i++) {
+            out.n[i] = a.n[i] + b.n[i];
+        }
+        return out;
+    }
+
+    friend Curve25519Field51 operator-(const Curve25519Field51& a) { return Curve25519Field51() - a; }
+    // the same value with its limbs carried back below 2^52, as after a product
+    Curve25519Field51 weak_reduce() const {
+        Curve25519Field51 out = *this;
+        carry(out.n);
+        return out;
+    }
+
+    // a + 4p - b, so no limb goes negative for b with limbs below 2^52
+    friend Curve25519Field51 operator-(const Curve25519Field51& a, const Curve25519Field51& b) {
+        Curve25519Field51 out;
+        out.n[0] = a.n[0] + FOUR_P0 - b.n[0];
+        for (std::size_t i = 1; i < 5; i++) {
+            out.n[i] = a.n[i] + FOUR_P - b.n[i];
+        }
+        return out;
+    }
+
+    friend Curve25519Field51 operator*(const Curve25519Field51& a, const Curve25519Field51& b) {
+        const uint64_t a0 = a.n[0], a1 = a.n[1], a2 = a.n[2], a3 = a.n[3], a4 = a.n[4];
+        const uint64_t b0 = b.n[0], b1 = b.n[1], b2 = b.n[2], b3 = b.n[3], b4 = b.n[4];
+        const uint64_t b1_19 = 19 * b1, b2_19 = 19 * b2, b3_19 = 19 * b3, b4_19 = 19 * b4;
+
+        wide_t r[5];
+        r[0] = mul(a0, b0) + mul(a1, b4_19) + mul(a2, b3_19) + mul(a3, b2_19) + mul(a4, b1_19);
+        r[1] = mul(a0, b1) + mul(a1, b0) + mul(a2, b4_19) + mul(a3, b3_19) + mul(a4, b2_19);
+        r[2] = mul(a0, b2) + mul(a1, b1) + mul(a2, b0) + mul(a3, b4_19) + mul(a4, b3_19);
+        r[3] = mul(a0, b3) + mul(a1, b2) + mul(a2, b1) + mul(a3, b0) + mul(a4, b4_19);
+        r[4] = mul(a0, b4) + mul(a1, b3) + mul(a2, b2) + mul(a3, b1) + mul(a4, b0);
+        return reduce(r);
+    }
+
+    // the symmetric cross products doubled instead of repeated: 15 products against 25
+    Curve25519Field51 square() const {
+        const uint64_t a0 = this->n[0], a1 = this->n[1], a2 = this->n[2], a3 = this->n[3], a4 = this->n[4];
+        const uint64_t d0 = 2 * a0, d1 = 2 * a1, a3_19 = 19 * a3, a4_19 = 19 * a4;
+
+        wide_t r[5];
+        r[0] = mul(a0, a0) + mul(d1, a4_19) + mul(2 * a2, a3_19);
+        r[1] = mul(d0, a1) + mul(2 * a2, a4_19) + mul(a3, a3_19);
+        r[2] = mul(d0, a2) + mul(a1, a1) + mul(2 * a3, a4_19);
+        r[3] = mul(d0, a3) + mul(d1, a2) + mul(a4, a4_19);
+        r[4] = mul(d0, a4) + mul(d1, a3) + mul(a2, a2);
+        return reduce(r);
+    }
+
+    // *this * k for k below 2^32, such as the ladder constant 121665
+    Curve25519Field51 mul_small(uint32_t k) const {
+        wide_t r[5];
+        for (std::size_t i = 0; i < 5; i++) {
+            r[i] = mul(this->n[i], k);
+        }
+        return reduce(r);
+    }
+
+    // this^(p - 2): zero for zero, the inverse otherwise; 254 squarings, 11 multiplications
+    Curve25519Field51 inverse() const {
+        return curve25519_fermat_inverse(*this,
+                [](const Curve25519Field51& a, const Curve25519Field51& b) { return a * b; },
+                [](const Curve25519Field51& a) { return a.square(); });
+    }
+
+    // this^((p - 5) / 8), for square roots
+    Curve25519Field51 pow_p58() const {
+        return curve25519_pow_p58(*this,
+                [](const Curve25519Field51& a, const Curve25519Field51& b) { return a * b; },
+                [](const Curve25519Field51& a) { return a.square(); });
+    }
+
+    bool is_zero() const { return to_uint256().is_zero(); }
+    // the low bit of the value below p, the sign of Ed25519's x
+    bool is_odd() const { return to_uint256().limb[0] & 1; }
+
+    // exchanges a and b when mask is all ones, leaves them when it is zero, without a branch
+    static void cswap(uint64_t mask, Curve25519Field51& a, Curve25519Field51& b) {
+        for (std::size_t i = 0; i < 5; i++) {
+            const uint64_t t = mask & (a.n[i] ^ b.n[i]);
+            a.n[i] ^= t;
+            b.n[i] ^= t;
+        }
+    }
+
+    friend bool operator==(const Curve25519Field51& lhs, const Curve25519Field51& rhs) {
+        return lhs.to_uint256() == rhs.to_uint256();
+    }
+    friend bool operator!=(const Curve25519Field51& lhs, const Curve25519Field51& rhs) { return !(lhs == rhs); }
+
+    friend std::ostream& operator<<(std::ostream& os, const Curve25519Field51& a) {
+        return os << "Curve25519Field51(" << a.value() << ")";
+    }
+
+private:
+    typedef unsigned __int128 wide_t;
+
+    static constexpr uint64_t M = (uint64_t(1) << 51) - 1;
+    static constexpr uint64_t FOUR_P0 = 4 * (M - 18);      // limb 0 of 4p; the others are 4M
+    static constexpr uint64_t FOUR_P = 4 * M;
+
+    uint64_t n[5];
+
+    static wide_t mul(uint64_t a, uint64_t b) { return static_cast<wide_t>(a) * b; }
+
+    static uint64_t load64(const uint8_t* in) {
+        uint64_t out = 0;
+        for (std::size_t i = 0; i < 8; i++) {
+            out |= static_cast<uint64_t>(in[i]) << (8 * i);
+        }
+        return out;
+    }
+
+    // one carry pass over 51-bit limbs, the carry out of the top folded back by 19
+    static void carry(uint64_t* t) {
+        for (std::size_t i = 0; i < 4; i++) {
+            t[i + 1] += t[i] >> 51;
+            t[i] &= M;
+        }
+        t[0] += 19 * (t[4] >> 51);
+        t[4] &= M;
+    }
+
+    // the columns of a product down to 51-bit limbs; limb 0 may end just above 2^51
+    static Curve25519Field51 reduce(wide_t* r) {
+        Curve25519Field51 out;
+        for (std::size_t i = 0; i < 4; i++) {
+            r[i + 1] += static_cast<uint64_t>(r[i] >> 51);
+            out.n[i] = static_cast<uint64_t>(r[i]) & M;
+        }
+        const uint64_t top = static_cast<uint64_t>(r[4] >> 51);
+        out.n[4] = static_cast<uint64_t>(r[4]) & M;
+        out.n[0] += 19 * top;
+        out.n[1] += out.n[0] >> 51;
+        out.n[0] &= M;
+        return out;
+    }
+};
+#endif
+
+#endif //ECC_CURVE25519FIELD51_H
@@ -0,0 +1,210 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <chrono>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "Executor.h"
+#include "numa.h"
+
+Executor::function_type Executor::function() {
+    return [this](std::size_t count, const std::function<void(std::size_t)>& task) { this->run(count, task); };
+}
+
+void ThreadExecutor::run(std::size_t count, const std::function<void(std::size_t)>& task) {
+    const std::size_t n = std::min<std::size_t>(this->threads, count);
+    if (n <= 1) {
+        for (std::size_t i = 0; i < count; i++) {
+            task(i);
+        }
+        return;
+    }
+    std::atomic<std::size_t> next(0);
+    std::vector<std::thread> pool;
+    for (std::size_t t = 0; t < n; t++) {
+        pool.emplace_back([&]() {
+            for (std::size_t i = next++; i < count; i = next++) {
+                task(i);
+            }
+        });
+    }
+    for (std::thread& worker : pool) {
+        worker.join();
+    }
+}
+
+namespace {
+
+// the pool and queue of the worker running on this thread, if any
+thread_local const void* current_pool = nullptr;
+thread_local std::size_t current_queue = 0;
+
+}
+
+WorkStealingPool::WorkStealingPool(unsigned threads, const std::vector<int>& cpus)
+        : queued(0), sleeping(0), stopping(false) {
+    if (!threads) {
+        const unsigned hardware = std::thread::hardware_concurrency();
+        threads = hardware > 1 ? hardware - 1 : 0;
+    }
+    for (unsigned i = 0; i <= threads; i++) {
+        this->queues.push_back(std::unique_ptr<Queue>(new Queue()));
+    }
+    // the node of each queue, -1 for unpinned workers and outside callers
+    const NumaTopology& topology = NumaTopology::system();
+    std::vector<long> node(threads + 1, -1);
+    for (unsigned i = 0; i < threads && !cpus.empty() && topology.node_count() > 1; i++) {
+        node[i] = static_cast<long>(topology.node_of(cpus[i % cpus.size()]));
+    }
+    for (std::size_t q = 0; q <= threads; q++) {
+        std::vector<std::size_t> near, far;
+        for (std::size_t k = 1; k <= threads; k++) {
+            const std::size_t other = (q + k) % (threads + 1);
+            (node[q] >= 0 && node[other] == node[q] ? near : far).push_back(other);
+        }
+        this->order.emplace_back(1, q);
+        this->order.back().insert(this->order.back().end(), near.begin(), near.end());
+        this->order.back().insert(this->order.back().end(), far.begin(), far.end());
+    }
+    for (unsigned i = 0; i < threads; i++) {
+        const int cpu = cpus.empty() ? -1 : cpus[i % cpus.size()];
+        this->workers.emplace_back([this, i, cpu]() { work(i, cpu); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> guard(this->sleep_lock);
+        this->stopping = true;
+    }
+    this->wake.notify_all();
+    for (std::thread& worker : this->workers) {
+        worker.join();
+    }
+}
+
+WorkStealingPool& WorkStealingPool::shared() {
+    static WorkStealingPool pool;
+    return pool;
+}
+
+std::size_t WorkStealingPool::own_queue() const {
+    return current_pool == this ? current_queue : this->queues.size() - 1;
+}
+
+void WorkStealingPool::push(std::size_t queue, const Range& range) {
+    {
+        std::lock_guard<std::mutex> guard(this->queues[queue]->lock);
+        this->queues[queue]->ranges.push_back(range);
+        this->queued++;
+    }
+    // queued goes up before sleeping is read, and a worker counts itself
+    // sleeping before it reads queued, so one of the two sees the other
+    if (this->sleeping.load()) {
+        { std::lock_guard<std::mutex> guard(this->sleep_lock); }
+        this->wake.notify_one();
+    }
+}
+
+bool WorkStealingPool::take(std::size_t queue, Range& out) {
+    const std::vector<std::size_t>& order = this->order[queue];
+    for (std::size_t k = 0; k < order.size(); k++) {
+        Queue& q = *this->queues[order[k]];
+        std::lock_guard<std::mutex> guard(q.lock);
+        if (!q.ranges.empty()) {
+            if (k == 0) {
+                out = q.ranges.back();
+                q.ranges.pop_back();
+            } else {
+                out = q.ranges.front();
+                q.ranges.pop_front();
+            }
+            this->queued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::execute(std::size_t queue, Range range) {
+    while (range.end - range.begin > 1) {
+        const std::size_t mid = range.begin + (range.end - range.begin) / 2;
+        push(queue, Range{range.job, mid, range.end});
+        range.end = mid;
+    }
+    Job& job = *range.job;
+    (*job.task)(range.begin);
+    if (job.left.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> guard(job.lock);
+        job.done = true;
+        job.finished.notify_all();
+    }
+}
+
+void WorkStealingPool::work(std::size_t self, int cpu) {
+#if defined(__linux__)
+    if (cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+#else
+    (void) cpu;
+#endif
+    current_pool = this;
+    current_queue = self;
+    for (;;) {
+        Range range;
+        if (take(self, range)) {
+            execute(self, range);
+            continue;
+        }
+        std::unique_lock<std::mutex> guard(this->sleep_lock);
+        this->sleeping++;
+        this->wake.wait(guard, [this]() { return this->stopping || this->queued.load(); });
+        this->sleeping--;
+        if (this->stopping && !this->queued.load()) {
+            return;
+        }
+    }
+}
+
+void WorkStealingPool::run(std::size_t count, const std::function<void(std::size_t)>& task) {
+    if (count <= 1 || this->workers.empty()) {
+        for (std::size_t i = 0; i < count; i++) {
+            task(i);
+        }
+        return;
+    }
+    Job job;
+    job.task = &task;
+    job.left = count;
+    job.done = false;
+
+    // one range for each thread, this one's last so it is the first it takes
+    const std::size_t self = own_queue();
+    const std::size_t parts = std::min(count, this->queues.size());
+    for (std::size_t p = 0; p < parts; p++) {
+        push((self + 1 + p) % this->queues.size(), Range{&job, count * p / parts, count * (p + 1) / parts});
+    }
+
+    for (;;) {
+        Range range;
+        if (take(self, range)) {
+            execute(self, range);
+            continue;
+        }
+        // nothing left to take, but other threads may still split ranges of the job
+        std::unique_lock<std::mutex> guard(job.lock);
+        if (job.done) {
+            return;
+        }
+        job.finished.wait_for(guard, std::chrono::microseconds(50));
+    }
+}
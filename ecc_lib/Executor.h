@@ -0,0 +1,135 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_EXECUTOR_H
+#define ECC_EXECUTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// The scheduler the batch APIs run their parallel work on: multi_scalar_mul
+// and pippenger, ecdsa_verify_batch and ecdsa_recover_batch,
+// schnorr_verify_batch, ed25519_verify_batch, FieldElement::batch_invert and
+// decompress_keys each have an overload taking one. Handing all of them the
+// same Executor keeps every subsystem on one set of threads; a scheduler of
+// the application's own (TBB, folly, an event loop's pool) plugs in by
+// deriving from it or through FunctionExecutor.
+class Executor {
+public:
+    typedef std::function<void(std::size_t count, const std::function<void(std::size_t)>& task)> function_type;
+
+    virtual ~Executor() = default;
+    // calls task(0), .., task(count - 1) in any order and on any threads, and
+    // returns once all of them have finished. The tasks do not throw; the
+    // batch APIs catch inside their tasks and rethrow after run returns
+    virtual void run(std::size_t count, const std::function<void(std::size_t)>& task) = 0;
+    // how many tasks can usefully run at once; the batch APIs cut their work by it
+    virtual std::size_t concurrency() const = 0;
+
+    // run as a function, the msm_executor form the msm and ecdsa code takes;
+    // valid while *this is
+    function_type function();
+};
+
+// an outside scheduler given as a function with run's contract, and the
+// number of tasks it runs at once
+class FunctionExecutor : public Executor {
+public:
+    FunctionExecutor(function_type function, std::size_t concurrency)
+            : fn(std::move(function)), width(concurrency ? concurrency : 1) {}
+    void run(std::size_t count, const std::function<void(std::size_t)>& task) override { this->fn(count, task); }
+    std::size_t concurrency() const override { return this->width; }
+
+private:
+    function_type fn;
+    std::size_t width;
+};
+
+// up to threads new std::threads for each run, each taking the next task until
+// none are left, and joined before run returns; threads <= 1 runs the tasks on
+// the calling thread. What the unsigned threads overloads of the batch APIs use
+class ThreadExecutor : public Executor {
+public:
+    explicit ThreadExecutor(unsigned threads) : threads(threads ? threads : 1) {}
+    void run(std::size_t count, const std::function<void(std::size_t)>& task) override;
+    std::size_t concurrency() const override { return this->threads; }
+
+private:
+    unsigned threads;
+};
+
+// Work stealing over per-thread deques of index ranges. run() deals [0, count)
+// out as one range per thread; a thread splits the range it takes in halves,
+// keeps the lower and pushes the upper back on its own deque, so the largest
+// pieces sit at the front of every deque, where idle threads steal from. The
+// calling thread works too, taking from its own deque and stealing until the
+// last task of its call has finished, so a task may itself call run on the same
+// pool without deadlock. Idle workers sleep until a range is pushed. Pinned
+// workers steal from the others of their NUMA node before those of other
+// nodes; NumaTopology::spread gives a list that covers every node.
+class WorkStealingPool : public Executor {
+public:
+    // threads workers besides the caller, hardware_concurrency() - 1 for 0. With
+    // cpus given, worker i is pinned to cpus[i % cpus.size()] (on Linux;
+    // elsewhere the list is ignored)
+    explicit WorkStealingPool(unsigned threads = 0, const std::vector<int>& cpus = {});
+    ~WorkStealingPool() override;
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void run(std::size_t count, const std::function<void(std::size_t)>& task) override;
+    std::size_t concurrency() const override { return this->workers.size() + 1; }
+
+    // one pool of hardware_concurrency() - 1 unpinned workers for the process,
+    // started on first use
+    static WorkStealingPool& shared();
+
+private:
+    struct Job {
+        const std::function<void(std::size_t)>* task;
+        std::atomic<std::size_t> left;
+        // done is set under lock by the thread that finishes the last task, so
+        // the caller only returns, and frees the job, once nothing touches it
+        std::mutex lock;
+        std::condition_variable finished;
+        bool done;
+    };
+    struct Range {
+        Job* job;
+        std::size_t begin;
+        std::size_t end;
+    };
+    struct Queue {
+        std::mutex lock;
+        std::deque<Range> ranges;
+    };
+
+    // one per worker, and a last one the threads calling run from outside share
+    std::vector<std::unique_ptr<Queue>> queues;
+    // the queues each takes from in turn: its own, those of the workers on its
+    // node, then the rest
+    std::vector<std::vector<std::size_t>> order;
+    std::vector<std::thread> workers;
+    std::atomic<std::size_t> queued;        // ranges in all the queues
+    std::atomic<std::size_t> sleeping;      // workers waiting on wake
+    std::mutex sleep_lock;
+    std::condition_variable wake;
+    bool stopping;
+
+    void push(std::size_t queue, const Range& range);
+    // the back of queue, else the front of the others in order
+    bool take(std::size_t queue, Range& out);
+    void execute(std::size_t queue, Range range);
+    void work(std::size_t self, int cpu);
+    std::size_t own_queue() const;
+};
+
+#endif //ECC_EXECUTOR_H
@@ -0,0 +1,503 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <stdexcept>
+#include <utility>
+
+#include "ExtensionField.h"
+#include "FieldExpression.h"
+#include "Status.h"
+
+namespace {
+
+// an Fp2 value as two unreduced integers, congruent to its coefficients, for
+// primes above 256 bits
+struct WideFp2 {
+    integer c0, c1;
+
+    WideFp2& operator+=(const WideFp2& other) { this->c0 += other.c0; this->c1 += other.c1; return *this; }
+    WideFp2& operator-=(const WideFp2& other) { this->c0 -= other.c0; this->c1 -= other.c1; return *this; }
+    // (xi0 c0 - c1) + (xi0 c1 + c0) u
+    WideFp2 mul_by_xi(uint64_t xi0) const {
+        integer r0 = this->c0 * integer(xi0);
+        integer r1 = this->c1 * integer(xi0);
+        r0 -= this->c1;
+        r1 += this->c0;
+        return {std::move(r0), std::move(r1)};
+    }
+};
+
+FieldElement negated(const FieldElement& e) {
+    return -lazy(e);
+}
+
+const integer& wide(const FieldElement& e) {
+    return FieldExpressionAccess::wide(e);
+}
+
+// the products of the Fp6 formulas, reduced at once (fixed-width primes) or
+// kept unreduced until the end (wide primes)
+struct EagerProducts {
+    typedef Fp2 value;
+    static Fp2 mul(const Fp2& a, const Fp2& b) { return a * b; }
+    static Fp2 sqr(const Fp2& a) { return a.square(); }
+    static Fp2 done(const FieldElement&, const Fp2& v) { return v; }
+};
+
+struct LazyProducts {
+    typedef WideFp2 value;
+    // Karatsuba: a0 b0 - a1 b1 + ((a0 + a1)(b0 + b1) - a0 b0 - a1 b1) u
+    static WideFp2 mul(const Fp2& a, const Fp2& b) {
+        integer v0 = wide(a.c0()) * wide(b.c0());
+        const integer v1 = wide(a.c1()) * wide(b.c1());
+        integer c1 = (wide(a.c0()) + wide(a.c1())) * (wide(b.c0()) + wide(b.c1()));
+        c1 -= v0;
+        c1 -= v1;
+        v0 -= v1;
+        return {std::move(v0), std::move(c1)};
+    }
+    static WideFp2 sqr(const Fp2& a) {
+        integer c0 = (wide(a.c0()) + wide(a.c1())) * (wide(a.c0()) - wide(a.c1()));
+        integer c1 = wide(a.c0()) * wide(a.c1());
+        c1 <<= 1;
+        return {std::move(c0), std::move(c1)};
+    }
+    static Fp2 done(const FieldElement& like, const WideFp2& v) {
+        return Fp2(FieldExpressionAccess::wide_result(like, v.c0), FieldExpressionAccess::wide_result(like, v.c1));
+    }
+};
+
+// Karatsuba over Fp2: v_i = a_i b_i and
+//     c0 = v0 + xi ((a1 + a2)(b1 + b2) - v1 - v2)
+//     c1 = (a0 + a1)(b0 + b1) - v0 - v1 + xi v2
+//     c2 = (a0 + a2)(b0 + b2) - v0 + v1 - v2
+template <class P>
+Fp6 fp6_mul(const Fp6& a, const Fp6& b) {
+    const uint64_t xi0 = a.tower().xi0();
+    const typename P::value v0 = P::mul(a.c0(), b.c0());
+    const typename P::value v1 = P::mul(a.c1(), b.c1());
+    const typename P::value v2 = P::mul(a.c2(), b.c2());
+
+    typename P::value t0 = P::mul(a.c1() + a.c2(), b.c1() + b.c2());
+    t0 -= v1;
+    t0 -= v2;
+    typename P::value c0 = t0.mul_by_xi(xi0);
+    c0 += v0;
+
+    typename P::value c1 = P::mul(a.c0() + a.c1(), b.c0() + b.c1());
+    c1 -= v0;
+    c1 -= v1;
+    c1 += v2.mul_by_xi(xi0);
+
+    typename P::value c2 = P::mul(a.c0() + a.c2(), b.c0() + b.c2());
+    c2 -= v0;
+    c2 += v1;
+    c2 -= v2;
+
+    const FieldElement& like = a.c0().c0();
+    return Fp6(a.tower(), P::done(like, c0), P::done(like, c1), P::done(like, c2));
+}
+
+// Chung-Hasan SQR2: s0 = a0^2, s1 = 2 a0 a1, s2 = (a0 - a1 + a2)^2,
+// s3 = 2 a1 a2, s4 = a2^2 and
+//     c0 = s0 + xi s3,  c1 = s1 + xi s4,  c2 = s1 + s2 + s3 - s0 - s4
+template <class P>
+Fp6 fp6_sqr(const Fp6& a) {
+    const uint64_t xi0 = a.tower().xi0();
+    const typename P::value s0 = P::sqr(a.c0());
+    const typename P::value s1 = P::mul(a.c0().doubled(), a.c1());
+    const typename P::value s2 = P::sqr(a.c0() - a.c1() + a.c2());
+    const typename P::value s3 = P::mul(a.c1().doubled(), a.c2());
+    const typename P::value s4 = P::sqr(a.c2());
+
+    typename P::value c0 = s3.mul_by_xi(xi0);
+    c0 += s0;
+    typename P::value c1 = s4.mul_by_xi(xi0);
+    c1 += s1;
+    typename P::value c2 = s1;
+    c2 += s2;
+    c2 += s3;
+    c2 -= s0;
+    c2 -= s4;
+
+    const FieldElement& like = a.c0().c0();
+    return Fp6(a.tower(), P::done(like, c0), P::done(like, c1), P::done(like, c2));
+}
+
+// (a + b y)^2 in Fp4 = Fp2[y] / (y^2 - xi): a^2 + xi b^2 and (a + b)^2 - a^2 - b^2
+void fp4_square(const Fp2& a, const Fp2& b, uint64_t xi0, Fp2& c0, Fp2& c1) {
+    const Fp2 t0 = a.square();
+    const Fp2 t1 = b.square();
+    c0 = t1.mul_by_xi(xi0) + t0;
+    c1 = (a + b).square() - t0 - t1;
+}
+
+void check_tower(const ExtensionTower& expected, const ExtensionTower& other) {
+    if (&expected != &other) {
+        throw_status(Status::field_mismatch, "Cannot combine elements of different towers");
+    }
+}
+
+}
+
+// Fp2
+
+Fp2::Fp2(const FieldElement& c0, const FieldElement& c1) : a0(c0), a1(c1) {
+    if (&c0.prime_field() != &c1.prime_field()) {
+        throw_status(Status::field_mismatch, "Cannot combine numbers in different fields");
+    }
+}
+
+Fp2 Fp2::zero(const PrimeField& field) {
+    return Fp2(FieldElement(0, field), FieldElement(0, field));
+}
+
+Fp2 Fp2::one(const PrimeField& field) {
+    return Fp2(FieldElement(1, field), FieldElement(0, field));
+}
+
+Fp2& Fp2::operator+=(const Fp2& other) {
+    this->a0 += other.a0;
+    this->a1 += other.a1;
+    return *this;
+}
+
+Fp2& Fp2::operator-=(const Fp2& other) {
+    this->a0 -= other.a0;
+    this->a1 -= other.a1;
+    return *this;
+}
+
+Fp2 operator*(const Fp2& lhs, const Fp2& rhs) {
+    if (!lhs.prime_field().fixed()) {
+        if (&lhs.prime_field() != &rhs.prime_field()) {
+            throw_status(Status::field_mismatch, "Cannot combine numbers in different fields");
+        }
+        return LazyProducts::done(lhs.a0, LazyProducts::mul(lhs, rhs));
+    }
+    const FieldElement v0 = lhs.a0 * rhs.a0;
+    const FieldElement v1 = lhs.a1 * rhs.a1;
+    return Fp2(v0 - v1, (lhs.a0 + lhs.a1) * (rhs.a0 + rhs.a1) - v0 - v1);
+}
+
+Fp2 Fp2::operator-() const {
+    return Fp2(negated(this->a0), negated(this->a1));
+}
+
+Fp2 Fp2::conjugate() const {
+    return Fp2(this->a0, negated(this->a1));
+}
+
+Fp2 Fp2::square() const {
+    if (!this->prime_field().fixed()) {
+        return LazyProducts::done(this->a0, LazyProducts::sqr(*this));
+    }
+    return Fp2((this->a0 + this->a1) * (this->a0 - this->a1), (this->a0 + this->a0) * this->a1);
+}
+
+FieldElement Fp2::norm() const {
+    return lazy(this->a0) * this->a0 + lazy(this->a1) * this->a1;
+}
+
+Fp2 Fp2::inverse() const {
+    const FieldElement n = norm();
+    if (n.is_zero()) {
+        throw_status(Status::division_by_zero, "Cannot invert zero");
+    }
+    const FieldElement d = FieldElement(1, this->prime_field()) / n;
+    return Fp2(this->a0 * d, negated(this->a1 * d));
+}
+
+Fp2 Fp2::mul_by_xi(uint64_t xi0) const {
+    if (xi0 == 1) {
+        return Fp2(this->a0 - this->a1, this->a1 + this->a0);
+    }
+    const integer x(xi0);
+    return Fp2(this->a0 * x - this->a1, this->a1 * x + this->a0);
+}
+
+Fp2 Fp2::power(const integer& exponent) const {
+    if (exponent < 0) {
+        return inverse().power(-exponent);
+    }
+    Fp2 out = one(this->prime_field());
+    for (std::size_t i = exponent.bit_length(); i > 0; i--) {
+        out = out.square();
+        if (exponent.test_bit(i - 1)) {
+            out *= *this;
+        }
+    }
+    return out;
+}
+
+std::ostream& operator<<(std::ostream& os, const Fp2& a) {
+    return os << "(" << a.a0 << " + " << a.a1 << "u)";
+}
+
+// Fp6
+
+Fp6::Fp6(const ExtensionTower& tower, const Fp2& c0, const Fp2& c1, const Fp2& c2)
+    : t(&tower), a0(c0), a1(c1), a2(c2) {
+    const PrimeField* field = &tower.prime_field();
+    if (&c0.prime_field() != field || &c1.prime_field() != field || &c2.prime_field() != field) {
+        throw_status(Status::field_mismatch, "Cannot combine numbers in different fields");
+    }
+}
+
+Fp6 Fp6::zero(const ExtensionTower& tower) {
+    const Fp2 z = Fp2::zero(tower.prime_field());
+    return Fp6(tower, z, z, z);
+}
+
+Fp6 Fp6::one(const ExtensionTower& tower) {
+    const Fp2 z = Fp2::zero(tower.prime_field());
+    return Fp6(tower, Fp2::one(tower.prime_field()), z, z);
+}
+
+Fp6& Fp6::operator+=(const Fp6& other) {
+    check_tower(*this->t, *other.t);
+    this->a0 += other.a0;
+    this->a1 += other.a1;
+    this->a2 += other.a2;
+    return *this;
+}
+
+Fp6& Fp6::operator-=(const Fp6& other) {
+    check_tower(*this->t, *other.t);
+    this->a0 -= other.a0;
+    this->a1 -= other.a1;
+    this->a2 -= other.a2;
+    return *this;
+}
+
+Fp6 operator*(const Fp6& lhs, const Fp6& rhs) {
+    check_tower(*lhs.t, *rhs.t);
+    return lhs.t->prime_field().fixed() ? fp6_mul<EagerProducts>(lhs, rhs) : fp6_mul<LazyProducts>(lhs, rhs);
+}
+
+Fp6 Fp6::operator*(const Fp2& other) const {
+    return Fp6(*this->t, this->a0 * other, this->a1 * other, this->a2 * other);
+}
+
+Fp6 Fp6::operator-() const {
+    return Fp6(*this->t, -this->a0, -this->a1, -this->a2);
+}
+
+Fp6 Fp6::square() const {
+    return this->t->prime_field().fixed() ? fp6_sqr<EagerProducts>(*this) : fp6_sqr<LazyProducts>(*this);
+}
+
+Fp6 Fp6::mul_by_v() const {
+    return Fp6(*this->t, this->a2.mul_by_xi(this->t->xi0()), this->a0, this->a1);
+}
+
+// a0 b0 + xi a2 b1 + ((a0 + a1)(b0 + b1) - a0 b0 - a1 b1) v + (a1 b1 + a2 b0) v^2
+Fp6 Fp6::mul_by_01(const Fp2& b0, const Fp2& b1) const {
+    const Fp2 aa = this->a0 * b0;
+    const Fp2 bb = this->a1 * b1;
+    const Fp2 t1 = (this->a2 * b1).mul_by_xi(this->t->xi0()) + aa;
+    const Fp2 t2 = (b0 + b1) * (this->a0 + this->a1) - aa - bb;
+    const Fp2 t3 = this->a2 * b0 + bb;
+    return Fp6(*this->t, t1, t2, t3);
+}
+
+Fp6 Fp6::mul_by_1(const Fp2& b1) const {
+    return Fp6(*this->t, (this->a2 * b1).mul_by_xi(this->t->xi0()), this->a0 * b1, this->a1 * b1);
+}
+
+// t0 = a0^2 - xi a1 a2, t1 = xi a2^2 - a0 a1, t2 = a1^2 - a0 a2 and
+// (a0 + a1 v + a2 v^2)(t0 + t1 v + t2 v^2) = a0 t0 + xi (a2 t1 + a1 t2), in Fp2
+Fp6 Fp6::inverse() const {
+    const uint64_t xi0 = this->t->xi0();
+    const Fp2 t0 = this->a0.square() - (this->a1 * this->a2).mul_by_xi(xi0);
+    const Fp2 t1 = this->a2.square().mul_by_xi(xi0) - this->a0 * this->a1;
+    const Fp2 t2 = this->a1.square() - this->a0 * this->a2;
+    const Fp2 n = this->a0 * t0 + (this->a2 * t1 + this->a1 * t2).mul_by_xi(xi0);
+    const Fp2 d = n.inverse();
+    return Fp6(*this->t, t0 * d, t1 * d, t2 * d);
+}
+
+Fp6 Fp6::frobenius(std::size_t power) const {
+    power %= 6;
+    if (power == 0) {
+        return *this;
+    }
+    const bool odd = power % 2 == 1;
+    const Fp2 b0 = odd ? this->a0.conjugate() : this->a0;
+    const Fp2 b1 = odd ? this->a1.conjugate() : this->a1;
+    const Fp2 b2 = odd ? this->a2.conjugate() : this->a2;
+    return Fp6(*this->t, b0, b1 * this->t->gamma(power, 2), b2 * this->t->gamma(power, 4));
+}
+
+std::ostream& operator<<(std::ostream& os, const Fp6& a) {
+    return os << "(" << a.a0 << " + " << a.a1 << "v + " << a.a2 << "v^2)";
+}
+
+// Fp12
+
+Fp12::Fp12(const Fp6& c0, const Fp6& c1) : a0(c0), a1(c1) {
+    check_tower(c0.tower(), c1.tower());
+}
+
+Fp12 Fp12::zero(const ExtensionTower& tower) {
+    return Fp12(Fp6::zero(tower), Fp6::zero(tower));
+}
+
+Fp12 Fp12::one(const ExtensionTower& tower) {
+    return Fp12(Fp6::one(tower), Fp6::zero(tower));
+}
+
+bool Fp12::is_one() const {
+    return this->a1.is_zero() && this->a0.c1().is_zero() && this->a0.c2().is_zero()
+        && this->a0.c0().c1().is_zero() && this->a0.c0().c0() == FieldElement(1, this->tower().prime_field());
+}
+
+Fp12& Fp12::operator+=(const Fp12& other) {
+    this->a0 += other.a0;
+    this->a1 += other.a1;
+    return *this;
+}
+
+Fp12& Fp12::operator-=(const Fp12& other) {
+    this->a0 -= other.a0;
+    this->a1 -= other.a1;
+    return *this;
+}
+
+// v0 = a0 b0, v1 = a1 b1: v0 + v v1 + ((a0 + a1)(b0 + b1) - v0 - v1) w
+Fp12 operator*(const Fp12& lhs, const Fp12& rhs) {
+    const Fp6 v0 = lhs.a0 * rhs.a0;
+    const Fp6 v1 = lhs.a1 * rhs.a1;
+    Fp6 c1 = (lhs.a0 + lhs.a1) * (rhs.a0 + rhs.a1);
+    c1 -= v0;
+    c1 -= v1;
+    return Fp12(v0 + v1.mul_by_v(), c1);
+}
+
+// (a0 + a1 w)(b + b4 v w) for b = b0 + b1 v: a0 b + v a1 b4 v and
+// (a0 + a1)(b + b4 v) - a0 b - a1 b4 v, Karatsuba with sparse factors
+Fp12 Fp12::mul_by_014(const Fp2& b0, const Fp2& b1, const Fp2& b4) const {
+    const Fp6 aa = this->a0.mul_by_01(b0, b1);
+    const Fp6 bb = this->a1.mul_by_1(b4);
+    Fp6 c1 = (this->a1 + this->a0).mul_by_01(b0, b1 + b4);
+    c1 -= aa;
+    c1 -= bb;
+    return Fp12(bb.mul_by_v() + aa, c1);
+}
+
+// Granger and Scott, "Faster Squaring in the Cyclotomic Subgroup of Sixth
+// Degree Extensions" (PKC 2010), section 3.2: over Fp2 the element is
+// z0 + z1 w + ... + z5 w^5 viewed as three Fp4 coefficients (z0, z1), (z2, z3),
+// (z4, z5), with z0 = c0.c0, z4 = c0.c1, z3 = c0.c2, z2 = c1.c0, z1 = c1.c1, z5 = c1.c2
+Fp12 Fp12::cyclotomic_square() const {
+    const uint64_t xi0 = this->tower().xi0();
+    Fp2 z0 = this->a0.c0(), z4 = this->a0.c1(), z3 = this->a0.c2();
+    Fp2 z2 = this->a1.c0(), z1 = this->a1.c1(), z5 = this->a1.c2();
+    Fp2 t0 = z0, t1 = z0, t2 = z0, t3 = z0;
+
+    fp4_square(z0, z1, xi0, t0, t1);
+    z0 = (t0 - z0).doubled() + t0;        // 3 t0 - 2 z0
+    z1 = (t1 + z1).doubled() + t1;        // 3 t1 + 2 z1
+
+    fp4_square(z2, z3, xi0, t0, t1);
+    fp4_square(z4, z5, xi0, t2, t3);
+    z4 = (t0 - z4).doubled() + t0;
+    z5 = (t1 + z5).doubled() + t1;
+
+    t0 = t3.mul_by_xi(xi0);
+    z2 = (t0 + z2).doubled() + t0;
+    z3 = (t2 - z3).doubled() + t2;
+
+    const ExtensionTower& tower = this->tower();
+    return Fp12(Fp6(tower, z0, z4, z3), Fp6(tower, z2, z1, z5));
+}
+
+Fp12 Fp12::square() const {
+    const Fp6 ab = this->a0 * this->a1;
+    Fp6 c0 = (this->a0 + this->a1) * (this->a0 + this->a1.mul_by_v());
+    c0 -= ab;
+    c0 -= ab.mul_by_v();
+    return Fp12(c0, ab + ab);
+}
+
+// (a0 + a1 w)(a0 - a1 w) = a0^2 - v a1^2, in Fp6
+Fp12 Fp12::inverse() const {
+    const Fp6 d = (this->a0.square() - this->a1.square().mul_by_v()).inverse();
+    return Fp12(this->a0 * d, -(this->a1 * d));
+}
+
+Fp12 Fp12::frobenius(std::size_t power) const {
+    power %= 12;
+    if (power == 0) {
+        return *this;
+    }
+    const Fp6 b1 = this->a1.frobenius(power);
+    const Fp2& g = this->tower().gamma(power, 1);
+    return Fp12(this->a0.frobenius(power), b1 * g);
+}
+
+Fp12 Fp12::power(const integer& exponent) const {
+    if (exponent < 0) {
+        return inverse().power(-exponent);
+    }
+    Fp12 out = one(this->tower());
+    for (std::size_t i = exponent.bit_length(); i > 0; i--) {
+        out = out.square();
+        if (exponent.test_bit(i - 1)) {
+            out *= *this;
+        }
+    }
+    return out;
+}
+
+std::ostream& operator<<(std::ostream& os, const Fp12& a) {
+    return os << "(" << a.a0 << " + " << a.a1 << "w)";
+}
+
+// ExtensionTower
+
+ExtensionTower::ExtensionTower(const PrimeField& field, uint64_t xi0) : field(&field), x0(xi0) {
+    const integer& p = field.prime();
+    if (p % 12 != 7) {
+        throw std::invalid_argument("Extension tower needs a prime that is 7 mod 12");
+    }
+    const Fp2 x = xi();
+    if (x.norm().is_square()) {
+        throw std::invalid_argument("Extension tower non-residue is a square in Fp2");
+    }
+    if (x.power((p * p - 1) / 3) == Fp2::one(field)) {
+        throw std::invalid_argument("Extension tower non-residue is a cube in Fp2");
+    }
+
+    // gamma(k, 1) = xi^((p - 1) / 6) gamma(k - 1, 1)^p, as
+    // (p^k - 1) / 6 = (p - 1) / 6 + p (p^(k - 1) - 1) / 6
+    const Fp2 g1 = x.power((p - 1) / 6);
+    Fp2 g = Fp2::one(field);
+    this->frob.reserve(12 * 6);
+    for (std::size_t k = 0; k < 12; k++) {
+        if (k > 0) {
+            g = g1 * g.conjugate();
+        }
+        Fp2 gj = Fp2::one(field);
+        for (std::size_t j = 0; j < 6; j++) {
+            this->frob.push_back(gj);
+            gj *= g;
+        }
+    }
+}
+
+const ExtensionTower& ExtensionTower::bls12_381() {
+    static const ExtensionTower tower(PrimeField::get(integer(
+        "1a0111ea397fe69a4b1ba7b6434bacd764774b84f38512bf6730d2a0f6b0f6241eabfffeb153ffffb9feffffffffaaab", 16)), 1);
+    return tower;
+}
+
+const ExtensionTower& ExtensionTower::bn254() {
+    static const ExtensionTower tower(PrimeField::get(integer(
+        "30644e72e131a029b85045b68181585d97816a916871ca8d3c208c16d87cfd47", 16)), 9);
+    return tower;
+}
+
+Fp2 ExtensionTower::xi() const {
+    return Fp2(FieldElement(integer(this->x0), *this->field), FieldElement(1, *this->field));
+}
@@ -0,0 +1,196 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_EXTENSIONFIELD_H
+#define ECC_EXTENSIONFIELD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "FieldElement.h"
+#include "integer.h"
+#include "PrimeField.h"
+
+class ExtensionTower;
+
+// The tower of pairing-friendly curves over a prime p = 7 mod 12:
+//
+//     Fp2  = Fp[u] / (u^2 + 1)
+//     Fp6  = Fp2[v] / (v^3 - xi),    xi = xi0 + u
+//     Fp12 = Fp6[w] / (w^2 - v)
+//
+// so w^6 = xi. Coefficients are FieldElements of the tower's prime field. Every
+// product is Karatsuba at each level (3 base products per Fp2 product, 6 Fp2
+// products per Fp6 product, 3 Fp6 products per Fp12 product), squarings use
+// the complex method in Fp2 and Fp12 and Chung-Hasan in Fp6, and the Frobenius
+// maps are coefficient-wise conjugations and products by constants the tower
+// computes once. For primes above 256 bits the base products of an Fp2 or Fp6
+// product are accumulated unreduced and each output coefficient is reduced
+// once, so an Fp6 product costs 6 reductions rather than 18.
+// Not constant time.
+
+class Fp2 {
+public:
+    Fp2(const FieldElement& c0, const FieldElement& c1);
+    static Fp2 zero(const PrimeField& field);
+    static Fp2 one(const PrimeField& field);
+
+    const FieldElement& c0() const { return this->a0; }
+    const FieldElement& c1() const { return this->a1; }
+    const PrimeField& prime_field() const { return this->a0.prime_field(); }
+    bool is_zero() const { return this->a0.is_zero() && this->a1.is_zero(); }
+
+    Fp2& operator+=(const Fp2& other);
+    Fp2& operator-=(const Fp2& other);
+    Fp2& operator*=(const Fp2& other) { return *this = *this * other; }
+    friend Fp2 operator+(Fp2 lhs, const Fp2& rhs) { return lhs += rhs; }
+    friend Fp2 operator-(Fp2 lhs, const Fp2& rhs) { return lhs -= rhs; }
+    friend Fp2 operator*(const Fp2& lhs, const Fp2& rhs);
+    // by an element of Fp
+    Fp2 operator*(const FieldElement& other) const { return Fp2(this->a0 * other, this->a1 * other); }
+    Fp2 operator-() const;
+
+    // (a0 + a1)(a0 - a1) + 2 a0 a1 u: two base products
+    Fp2 square() const;
+    Fp2 doubled() const { return Fp2(this->a0 + this->a0, this->a1 + this->a1); }
+    // a0 - a1 u, which is also the p-power Frobenius map
+    Fp2 conjugate() const;
+    // a0^2 + a1^2, in Fp
+    FieldElement norm() const;
+    // throws std::domain_error for zero
+    Fp2 inverse() const;
+    // by xi = xi0 + u, with xi0 small
+    Fp2 mul_by_xi(uint64_t xi0) const;
+    Fp2 power(const integer& exponent) const;
+
+    friend bool operator==(const Fp2& lhs, const Fp2& rhs) { return lhs.a0 == rhs.a0 && lhs.a1 == rhs.a1; }
+    friend bool operator!=(const Fp2& lhs, const Fp2& rhs) { return !(lhs == rhs); }
+    friend std::ostream& operator<<(std::ostream& os, const Fp2& a);
+
+private:
+    FieldElement a0, a1;
+};
+
+class Fp6 {
+public:
+    Fp6(const ExtensionTower& tower, const Fp2& c0, const Fp2& c1, const Fp2& c2);
+    static Fp6 zero(const ExtensionTower& tower);
+    static Fp6 one(const ExtensionTower& tower);
+
+    const Fp2& c0() const { return this->a0; }
+    const Fp2& c1() const { return this->a1; }
+    const Fp2& c2() const { return this->a2; }
+    const ExtensionTower& tower() const { return *this->t; }
+    bool is_zero() const { return this->a0.is_zero() && this->a1.is_zero() && this->a2.is_zero(); }
+
+    Fp6& operator+=(const Fp6& other);
+    Fp6& operator-=(const Fp6& other);
+    Fp6& operator*=(const Fp6& other) { return *this = *this * other; }
+    friend Fp6 operator+(Fp6 lhs, const Fp6& rhs) { return lhs += rhs; }
+    friend Fp6 operator-(Fp6 lhs, const Fp6& rhs) { return lhs -= rhs; }
+    friend Fp6 operator*(const Fp6& lhs, const Fp6& rhs);
+    // by an element of Fp2, coefficient-wise
+    Fp6 operator*(const Fp2& other) const;
+    Fp6 operator-() const;
+
+    Fp6 square() const;
+    // by v: (c0, c1, c2) -> (xi c2, c0, c1)
+    Fp6 mul_by_v() const;
+    // by the sparse b0 + b1 v (5 Fp2 products) and b1 v (3), for line functions
+    Fp6 mul_by_01(const Fp2& b0, const Fp2& b1) const;
+    Fp6 mul_by_1(const Fp2& b1) const;
+    // throws std::domain_error for zero
+    Fp6 inverse() const;
+    // x -> x^(p^power)
+    Fp6 frobenius(std::size_t power) const;
+
+    friend bool operator==(const Fp6& lhs, const Fp6& rhs) {
+        return lhs.a0 == rhs.a0 && lhs.a1 == rhs.a1 && lhs.a2 == rhs.a2;
+    }
+    friend bool operator!=(const Fp6& lhs, const Fp6& rhs) { return !(lhs == rhs); }
+    friend std::ostream& operator<<(std::ostream& os, const Fp6& a);
+
+private:
+    const ExtensionTower* t;
+    Fp2 a0, a1, a2;
+};
+
+class Fp12 {
+public:
+    Fp12(const Fp6& c0, const Fp6& c1);
+    static Fp12 zero(const ExtensionTower& tower);
+    static Fp12 one(const ExtensionTower& tower);
+
+    const Fp6& c0() const { return this->a0; }
+    const Fp6& c1() const { return this->a1; }
+    const ExtensionTower& tower() const { return this->a0.tower(); }
+    bool is_zero() const { return this->a0.is_zero() && this->a1.is_zero(); }
+    bool is_one() const;
+
+    Fp12& operator+=(const Fp12& other);
+    Fp12& operator-=(const Fp12& other);
+    Fp12& operator*=(const Fp12& other) { return *this = *this * other; }
+    friend Fp12 operator+(Fp12 lhs, const Fp12& rhs) { return lhs += rhs; }
+    friend Fp12 operator-(Fp12 lhs, const Fp12& rhs) { return lhs -= rhs; }
+    friend Fp12 operator*(const Fp12& lhs, const Fp12& rhs);
+    Fp12 operator-() const { return Fp12(-this->a0, -this->a1); }
+
+    // by the sparse b0 + b1 v + b4 v w, the shape of a pairing's line function
+    // on a twist of type M: 13 Fp2 products rather than 18
+    Fp12 mul_by_014(const Fp2& b0, const Fp2& b1, const Fp2& b4) const;
+
+    // (a0 + a1)(a0 + v a1) - (1 + v) a0 a1 + 2 a0 a1 w: two Fp6 products
+    Fp12 square() const;
+    // the square of an element of the cyclotomic subgroup, x^(p^6 + 1) = 1 (any
+    // value after the easy part of a final exponentiation), by Granger and
+    // Scott: three Fp4 squarings, 9 Fp2 squarings in all. Wrong for other elements.
+    Fp12 cyclotomic_square() const;
+    // a0 - a1 w, the p^6-power Frobenius map, and the inverse on the
+    // cyclotomic subgroup a final exponentiation lands in
+    Fp12 conjugate() const { return Fp12(this->a0, -this->a1); }
+    // throws std::domain_error for zero
+    Fp12 inverse() const;
+    // x -> x^(p^power)
+    Fp12 frobenius(std::size_t power) const;
+    Fp12 power(const integer& exponent) const;
+
+    friend bool operator==(const Fp12& lhs, const Fp12& rhs) { return lhs.a0 == rhs.a0 && lhs.a1 == rhs.a1; }
+    friend bool operator!=(const Fp12& lhs, const Fp12& rhs) { return !(lhs == rhs); }
+    friend std::ostream& operator<<(std::ostream& os, const Fp12& a);
+
+private:
+    Fp6 a0, a1;
+};
+
+// The parameters of one tower and its Frobenius constants,
+// gamma(k, j) = xi^(j (p^k - 1) / 6) for k < 12 and j < 6: v^(p^k) = gamma(k, 2) v
+// and w^(p^k) = gamma(k, 1) w. Elements point at their tower, which must outlive
+// them; the named towers live for the whole program.
+class ExtensionTower {
+public:
+    // throws std::invalid_argument unless p = 7 mod 12 (so u^2 = -1 has no root
+    // and 6 divides p - 1) and xi0 + u is neither a square nor a cube in Fp2,
+    // the conditions for every level to be a field
+    ExtensionTower(const PrimeField& field, uint64_t xi0);
+    ExtensionTower(const ExtensionTower&) = delete;
+    ExtensionTower& operator=(const ExtensionTower&) = delete;
+
+    // BLS12-381, xi = 1 + u, and BN254 (alt_bn128), xi = 9 + u
+    static const ExtensionTower& bls12_381();
+    static const ExtensionTower& bn254();
+
+    const PrimeField& prime_field() const { return *this->field; }
+    uint64_t xi0() const { return this->x0; }
+    Fp2 xi() const;
+    const Fp2& gamma(std::size_t k, std::size_t j) const { return this->frob[(k % 12) * 6 + j]; }
+
+private:
+    const PrimeField* field;
+    uint64_t x0;
+    std::vector<Fp2> frob;      // gamma(k, j) at 6 k + j
+};
+
+#endif //ECC_EXTENSIONFIELD_H
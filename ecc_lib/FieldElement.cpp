@@ -1,79 +1,695 @@
 //
 // Created by preston on 10/1/2023.
 //
+#include <algorithm>
+#include <exception>
 #include <stdexcept>
 #include "FieldElement.h"
+#include "FieldKernels.h"
+#include "hex.h"
+#include "modexp.h"
+#include "OperationCounters.h"
+#include "p256.h"
+#include "trace.h"
 
-FieldElement::FieldElement(const integer& num, const integer& prime) {
-    if (num >= prime || num < 0) {
-        throw std::invalid_argument("Num is out of range");
+FieldElement::FieldElement(const integer& num, const integer& prime)
+        : FieldElement(num, PrimeField::get(prime)) {
+}
+
+FieldElement::FieldElement(const integer& num, const PrimeField& field) {
+    if (num >= field.prime() || num < 0) {
+        throw_status(Status::out_of_range, "Num is out of range");
+    }
+    this->field = &field;
+    this->mont = false;
+    assign(num);
+}
+
+Result<FieldElement> FieldElement::make(const integer& num, const PrimeField& field) noexcept {
+    if (num >= field.prime() || num < 0) {
+        return Status::out_of_range;
+    }
+    FieldElement out(&field, false, unchecked());
+    out.assign(num);
+    return out;
+}
+
+FieldElement::FieldElement(const integer& num, const std::shared_ptr<const MontgomeryContext>& context)
+        : FieldElement(num, PrimeField::get(context->modulus().to_integer())) {
+    this->mont = true;
+    this->fnum = context->to_montgomery(this->fnum);
+}
+
+FieldElement FieldElement::operator+(const FieldElement &other) const & {
+    FieldElement out = *this;
+    out += other;
+    return out;
+}
+
+FieldElement FieldElement::operator-(const FieldElement &other) const & {
+    FieldElement out = *this;
+    out -= other;
+    return out;
+}
+
+FieldElement FieldElement::operator*(const FieldElement &other) const & {
+    FieldElement out = *this;
+    out *= other;
+    return out;
+}
+
+FieldElement FieldElement::operator*(const integer& other) const & {
+    FieldElement out = *this;
+    out *= other;
+    return out;
+}
+
+FieldElement FieldElement::operator/(const FieldElement &other) const & {
+    FieldElement out = *this;
+    out /= other;
+    return out;
+}
+
+FieldElement& FieldElement::operator+=(const FieldElement &other) {
+    check_field(other, "Cannot add two numbers in different fields");
+    ECC_COUNT(field_add);
+
+    if (this->field->fixed()) {
+        this->fnum = fixed_add(this->fnum, operand(other));
+        return *this;
     }
-    this->num = num;
-    this->prime = prime;
+
+    this->num.add_mod(other.num, this->field->prime());
+    return *this;
 }
 
-FieldElement FieldElement::operator+(FieldElement &other) {
-    if (this->prime != other.prime) {
-        throw std::runtime_error("Cannot add two numbers in different fields");
+FieldElement& FieldElement::operator-=(const FieldElement &other) {
+    check_field(other, "Cannot subtract two numbers in different fields");
+    ECC_COUNT(field_add);
+
+    if (this->field->fixed()) {
+        this->fnum = fixed_sub(this->fnum, operand(other));
+        return *this;
     }
 
-    integer calculatedAdd = (this->num + other.num) % this->prime;
+    this->num.sub_mod(other.num, this->field->prime());
+    return *this;
+}
+
+FieldElement& FieldElement::operator*=(const FieldElement &other) {
+    check_field(other, "Cannot multiply two numbers in different fields");
+    ECC_COUNT(field_mul);
+
+    if (this->field->fixed()) {
+        this->fnum = fixed_mul(this->fnum, operand(other));
+        return *this;
+    }
 
-    return {integer(calculatedAdd), this->prime};
+    this->num = natural(this->field->reduce(this->num.value() * other.num.value()));
+    return *this;
 }
 
-FieldElement FieldElement::operator-(FieldElement &other) {
-    if (this->prime != other.prime) {
-        throw std::runtime_error("Cannot subtract two numbers in different fields");
+FieldElement& FieldElement::operator*=(const integer& other) {
+    ECC_COUNT(field_mul);
+    if (this->field->word()) {
+        integer k = other % this->field->prime();
+        if (k < 0) {
+            k += this->field->prime();
+        }
+        this->fnum = uint256(this->field->mul_word(this->fnum.limb[0], uint256::from_integer(k).limb[0]));
+        return *this;
     }
+    return *this = reduced(this->value() * other);
+}
 
-    integer calculatedAdd = (this->num - other.num) % this->prime;
+FieldElement& FieldElement::operator/=(const FieldElement &other) {
+    check_field(other, "Cannot multiply two numbers in different fields");
+    ECC_COUNT(field_inv);
 
-    return {integer(calculatedAdd), this->prime};
+    FieldElement inverse(other.field, other.mont, unchecked());
+    const PrimeField& f = *other.field;
+    if (f.word() && !other.mont && f.is_prime()) {
+        // v^(p - 2), whose steps depend only on the prime
+        if (other.fnum.is_zero()) {
+            throw_status(Status::division_by_zero, "Cannot divide by zero");
+        }
+        inverse.fnum = uint256(sliding_window_pow(other.fnum.limb[0], f.prime_minus_two(), limb_t(1),
+                [&f](limb_t a, limb_t b) { return f.mul_word(a, b); }));
+    } else if (f.montgomery()) {
+        // constant time, so secret values can be divided by
+        const MontgomeryContext* mont = other.montgomery();
+        uint256 v = mont ? mont->from_montgomery(other.fnum) : other.fnum;
+        if (v.is_zero()) {
+            throw_status(Status::division_by_zero, "Cannot divide by zero");
+        }
+        uint256 inv = uint256::modinv_ct(v, f.fixed_prime());
+        inverse.fnum = mont ? mont->to_montgomery(inv) : inv;
+    } else {
+        inverse.assign(other.value().modinv(f.prime()));
+    }
+    return *this *= inverse;
 }
 
-FieldElement FieldElement::operator*(FieldElement &other) {
-    if (this->prime != other.prime) {
-        throw std::runtime_error("Cannot multiply two numbers in different fields");
+FieldElement FieldElement::square() const {
+    ECC_COUNT(field_mul);
+    if (this->field->fixed()) {
+        return fixed_result(fixed_sqr(this->fnum));
     }
+    return wide_result(this->field->reduce(this->num.square().value()));
+}
 
-    integer calculatedAdd = (this->num * other.num) % this->prime;
+FieldElement FieldElement::power(const integer &power) const {
+    const integer& order = this->field->prime_minus_one();
+    integer n = power % order;
+    if (n < 0) {
+        n += order;
+    }
+    return exp(n);
+}
 
-    return {integer(calculatedAdd), this->prime};
+void FieldElement::batch_invert(FieldElement* elements, std::size_t count, unsigned threads) {
+    ThreadExecutor executor(threads);
+    batch_invert(elements, count, executor);
 }
 
-FieldElement FieldElement::operator*(const integer& other) {
-    integer calculatedAdd = (this->num * other) % this->prime;
+void FieldElement::batch_invert(FieldElement* elements, std::size_t count, Executor& executor) {
+    ECC_TRACE_SPAN("batch_invert");
+    // below this many elements per chunk the single inversion saved is not worth a task
+    static constexpr std::size_t MIN_CHUNK = 256;
+    if (count == 0) {
+        return;
+    }
+    for (std::size_t i = 1; i < count; i++) {
+        if (elements[i].field != elements[0].field) {
+            throw std::runtime_error("Cannot batch invert numbers in different fields");
+        }
+    }
 
-    return {integer(calculatedAdd), this->prime};
+    if (executor.concurrency() > 1 && count >= 2 * MIN_CHUNK) {
+        const std::size_t chunks = std::min<std::size_t>(executor.concurrency(), count / MIN_CHUNK);
+        const std::size_t size = (count + chunks - 1) / chunks;
+        std::vector<std::exception_ptr> errors(chunks);
+        executor.run(chunks, [elements, count, size, &errors](std::size_t c) {
+            const std::size_t first = c * size;
+            try {
+                batch_invert(elements + first, std::min(size, count - first), 1);
+            } catch (...) {
+                errors[c] = std::current_exception();
+            }
+        });
+        for (const std::exception_ptr& e : errors) {
+            if (e) {
+                std::rethrow_exception(e);
+            }
+        }
+        return;
+    }
+    batch_invert(elements, count, Scratch::local());
 }
 
-FieldElement FieldElement::operator/(FieldElement &other) {
-    if (this->prime != other.prime) {
-        throw std::runtime_error("Cannot multiply two numbers in different fields");
+void FieldElement::batch_invert(FieldElement* elements, std::size_t count, Scratch& scratch) {
+    if (count == 0) {
+        return;
     }
+    for (std::size_t i = 1; i < count; i++) {
+        if (elements[i].field != elements[0].field) {
+            throw std::runtime_error("Cannot batch invert numbers in different fields");
+        }
+    }
+    Scratch::Frame frame(scratch);
 
-    integer calculatedDiv = (this->num * (pow(other.num, this->prime - 2) % this->prime)) % this->prime;
+    // prefix[i] = elements[0] * ... * elements[i]
+    Scratch::vector<FieldElement> prefix(&scratch);
+    prefix.reserve(count);
+    prefix.push_back(elements[0]);
+    for (std::size_t i = 1; i < count; i++) {
+        prefix.push_back(prefix.back() * elements[i]);
+    }
 
-    return {integer(calculatedDiv), this->prime};
+    FieldElement inverse = elements[0].one() / prefix.back();
+    for (std::size_t i = count - 1; i > 0; i--) {
+        FieldElement inverted = inverse * prefix[i - 1];
+        inverse *= elements[i];
+        elements[i] = std::move(inverted);
+    }
+    elements[0] = inverse;
 }
 
-FieldElement FieldElement::power(const integer &power) {
-    integer n = power % (this->prime - 1);
-    integer calculatedPow = pow(this->num, n) % this->prime;
-    return {calculatedPow, this->prime};
+void FieldElement::batch_invert(std::vector<FieldElement>& elements, unsigned threads) {
+    batch_invert(elements.data(), elements.size(), threads);
 }
 
-bool operator==(const FieldElement &lhs, const FieldElement &rhs) {
-    return lhs.num == rhs.num && lhs.num == rhs.num;
+void FieldElement::batch_invert(std::vector<FieldElement>& elements, Executor& executor) {
+    batch_invert(elements.data(), elements.size(), executor);
 }
 
-bool operator!=(const FieldElement &lhs, const FieldElement &rhs) {
-    return !(lhs == rhs);
+FieldElement FieldElement::select(limb_t mask, const FieldElement& a, const FieldElement& b) {
+    a.check_field(b, "Cannot select between numbers in different fields");
+    if (!a.field->fixed()) {
+        return mask ? a : b;
+    }
+    return a.fixed_result(uint256::select(mask, a.fnum, a.operand(b)));
+}
+
+FieldElement FieldElement::power_ct(const integer &power) const {
+    ECC_COUNT(field_pow);
+    // only oversized or negative exponents are reduced, so in-range secrets skip the division
+    const integer& order = this->field->prime_minus_one();
+    integer n = power;
+    if (n < 0 || n >= order) {
+        n %= order;
+        if (n < 0) {
+            n += order;
+        }
+    }
+
+    if (const MontgomeryContext* context = this->field->montgomery()) {
+        const uint256 e = uint256::from_integer(n);
+        if (this->mont) {
+            return fixed_result(context->pow_ct(this->fnum, e));
+        }
+        return fixed_result(context->from_montgomery(context->pow_ct(context->to_montgomery(this->fnum), e)));
+    }
+
+    // wide primes: the same ladder over field operations, as many steps as the prime has bits
+    return montgomery_ladder_pow(*this, this->field->bits(),
+            [&n](std::size_t i) { return n[i]; },
+            one(),
+            [](const FieldElement& a, const FieldElement& b) { return a * b; },
+            [](FieldElement& a, FieldElement& b, uint64_t mask) {
+                if (mask) {
+                    std::swap(a, b);
+                }
+            },
+            [](const FieldElement& a) { return a.square(); });
+}
+
+// sliding-window exponentiation; every step is a field operation, so
+// intermediates never grow past the size of the prime
+FieldElement FieldElement::exp(const integer &e) const {
+    ECC_COUNT(field_pow);
+    const PrimeField::chain chain = this->field->addition_chain();
+    if (chain != PrimeField::chain::none) {
+        const bool root = e == this->field->sqrt_exponent();
+        if (root || e == this->field->prime_minus_two()) {
+            return fixed_result(chain_exp(chain, root));
+        }
+    }
+    if (const MontgomeryContext* mont = montgomery()) {
+        return fixed_result(mont->pow(this->fnum, e));
+    }
+    if (this->field->word()) {
+        const PrimeField* f = this->field;
+        return fixed_result(uint256(sliding_window_pow(this->fnum.limb[0], e, limb_t(1),
+                [f](limb_t a, limb_t b) { return f->mul_word(a, b); })));
+    }
+    return sliding_window_pow(*this, e, one(),
+            [](const FieldElement& a, const FieldElement& b) { return a * b; },
+            [](const FieldElement& a) { return a.square(); });
+}
+
+// exp((p + 1) / 4) when root is set and exp(p - 2) otherwise, by the addition
+// chains of a known prime
+uint256 FieldElement::chain_exp(PrimeField::chain chain, bool root) const {
+    auto mul = [this](const uint256& a, const uint256& b) { return fixed_mul(a, b); };
+    auto sqr = [this](const uint256& a) { return fixed_sqr(a); };
+    if (chain == PrimeField::chain::secp256k1) {
+        return root ? secp256k1_sqrt_candidate(this->fnum, mul, sqr) : secp256k1_fermat_inverse(this->fnum, mul, sqr);
+    }
+    return root ? p256_sqrt_candidate(this->fnum, mul, sqr) : p256_fermat_inverse(this->fnum, mul, sqr);
+}
+
+// a square root r with r * r == *this; throws std::domain_error for non-residues
+FieldElement FieldElement::sqrt() const {
+    Result<FieldElement> r = try_sqrt();
+    if (!r) {
+        throw_status(r.status(), "Not a quadratic residue");
+    }
+    return std::move(*r);
+}
+
+Result<FieldElement> FieldElement::try_sqrt() const noexcept {
+    FieldElement x = *this;
+    if (this->value() < 2) {
+        return x;
+    }
+
+    const PrimeField& f = *this->field;
+    if (f.two_adicity() == 1) {
+        FieldElement r = exp(f.sqrt_exponent());
+        if (r.square() != x) {
+            return Status::not_a_square;
+        }
+        return r;
+    }
+
+    // Tonelli-Shanks: prime - 1 = odd * 2^s, and a non-residue to start from,
+    // which a composite modulus may not have
+    if (!f.is_prime()) {
+        return Status::bad_modulus;
+    }
+    if (!is_square()) {
+        return Status::not_a_square;
+    }
+    const FieldElement one = this->one();
+    FieldElement z(this->field, this->mont, unchecked());
+    z.assign(f.non_residue());
+
+    FieldElement c = z.exp(f.odd_part());
+    FieldElement t = exp(f.odd_part());
+    FieldElement r = exp(f.sqrt_exponent());
+    std::size_t m = f.two_adicity();
+    while (t != one) {
+        std::size_t i = 0;
+        for (FieldElement t2 = t; t2 != one; t2 = t2.square()) {
+            i++;
+        }
+        FieldElement b = c;
+        for (std::size_t j = 0; j + i + 1 < m; j++) {
+            b = b.square();
+        }
+        m = i;
+        c = b.square();
+        t *= c;
+        r *= b;
+    }
+    return r;
+}
+
+Result<FieldElement> FieldElement::try_add(const FieldElement& other) const noexcept {
+    if (this->field != other.field) {
+        return Status::field_mismatch;
+    }
+    return *this + other;
+}
+
+Result<FieldElement> FieldElement::try_sub(const FieldElement& other) const noexcept {
+    if (this->field != other.field) {
+        return Status::field_mismatch;
+    }
+    return *this - other;
+}
+
+Result<FieldElement> FieldElement::try_mul(const FieldElement& other) const noexcept {
+    if (this->field != other.field) {
+        return Status::field_mismatch;
+    }
+    return *this * other;
+}
+
+Result<FieldElement> FieldElement::try_div(const FieldElement& other) const noexcept {
+    if (this->field != other.field) {
+        return Status::field_mismatch;
+    }
+    if (other.is_zero()) {
+        return Status::division_by_zero;
+    }
+    return *this / other;
+}
+
+bool FieldElement::is_square() const {
+    const PrimeField& f = *this->field;
+    if (f.prime() == 2) {
+        return true;
+    }
+    if (f.word()) {
+        return limb_jacobi(this->fnum.limb[0], f.word_prime(), 1) >= 0;
+    }
+    if (f.fixed()) {
+        return uint256::jacobi(this->fnum, f.fixed_prime()) >= 0;
+    }
+    return integer::jacobi(this->num.value(), f.prime()) >= 0;
+}
+
+integer FieldElement::value() const {
+    if (const MontgomeryContext* mont = montgomery()) {
+        return mont->from_montgomery(this->fnum).to_integer();
+    }
+    return this->field->fixed() ? this->fnum.to_integer() : this->num.value();
+}
+
+void FieldElement::to_bytes(uint8_t* out, std::size_t len) const {
+    if (len < (this->field->bits() + 7) / 8) {
+        throw std::invalid_argument("Buffer is shorter than the field prime");
+    }
+    if (!this->field->fixed()) {
+        this->num.value().to_bytes(out, len);
+        return;
+    }
+    const MontgomeryContext* mont = montgomery();
+    const uint256 v = mont ? mont->from_montgomery(this->fnum) : this->fnum;
+    const std::size_t low = std::min<std::size_t>(len, 32);
+    std::memset(out, 0, len - low);
+    v.store_be(out + len - low, low);
+}
+
+Result<FieldElement> FieldElement::from_bytes(const uint8_t* in, std::size_t len, const PrimeField& field) noexcept {
+    if (!field.fixed()) {
+        return make(integer::from_bytes(in, len), field);
+    }
+    const std::size_t low = std::min<std::size_t>(len, 32);
+    if (std::any_of(in, in + len - low, [](uint8_t byte) { return byte != 0; })) {
+        return Status::out_of_range;
+    }
+    const uint256 v = uint256::load_be(in + len - low, low);
+    if (!(v < field.fixed_prime())) {
+        return Status::out_of_range;
+    }
+    FieldElement out(&field, false, unchecked());
+    out.fnum = v;
+    return out;
+}
+
+std::string FieldElement::to_hex() const {
+    const std::size_t width = (this->field->bits() + 7) / 8;
+    small_vector<uint8_t, 64> bytes(width);
+    to_bytes(bytes.data(), width);
+    std::string out(2 * width, '0');
+    hex_encode(bytes.data(), width, &out[0]);
+    return out;
+}
+
+Result<FieldElement> FieldElement::from_hex(const char* in, std::size_t len, const PrimeField& field) noexcept {
+    small_vector<uint8_t, 64> bytes(len / 2);
+    if (hex_decode(in, len, bytes.data()) != Status::ok) {
+        return Status::bad_digit;
+    }
+    return from_bytes(bytes.data(), bytes.size(), field);
+}
+
+Status FieldElement::serialize(const FieldElement* in, std::size_t count, uint8_t* out, std::size_t capacity) noexcept {
+    if (!count) {
+        return Status::ok;
+    }
+    const PrimeField& field = *in[0].field;
+    const std::size_t width = wire_size(field);
+    for (std::size_t i = 1; i < count; i++) {
+        if (in[i].field != &field) {
+            return Status::field_mismatch;
+        }
+    }
+    if (capacity / width < count) {
+        return Status::buffer_too_small;
+    }
+    if (!field.fixed()) {
+        for (std::size_t i = 0; i < count; i++) {
+            in[i].num.value().to_bytes(out + i * width, width, integer::endian::little);
+        }
+        return Status::ok;
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        const MontgomeryContext* mont = in[i].montgomery();
+        (mont ? mont->from_montgomery(in[i].fnum) : in[i].fnum).store_le(out + i * width, width);
+    }
+    return Status::ok;
+}
+
+Status FieldElement::deserialize(const uint8_t* in, std::size_t len, const PrimeField& field,
+                                 std::vector<FieldElement>& out) noexcept {
+    const std::size_t width = wire_size(field);
+    if (len % width) {
+        return Status::bad_encoding;
+    }
+    const std::size_t count = len / width;
+    if (!field.fixed()) {
+        std::vector<integer> values;
+        integer::deserialize(in, len, width, values);
+        for (const integer& value : values) {
+            if (value >= field.prime()) {
+                return Status::out_of_range;
+            }
+        }
+        out.reserve(out.size() + count);
+        for (const integer& value : values) {
+            out.push_back(FieldElement(value, field));
+        }
+        return Status::ok;
+    }
+    if (!uint256::all_below_le(in, count, width, field.fixed_prime())) {
+        return Status::out_of_range;
+    }
+    out.reserve(out.size() + count);
+    for (std::size_t i = 0; i < count; i++) {
+        out.push_back(FieldElement(&field, false, unchecked()));
+        out.back().fnum = uint256::load_le(in + i * width, width);
+    }
+    return Status::ok;
+}
+
+void FieldElement::check_field(const FieldElement &other, const char* message) const {
+    if (this->field != other.field) {
+        throw_status(Status::field_mismatch, message);
+    }
+}
+
+// stores value, already in [0, prime), in this element's representation
+void FieldElement::assign(const integer &value) {
+    if (this->field->fixed()) {
+        this->fnum = uint256::from_integer(value);
+        if (const MontgomeryContext* mont = montgomery()) {
+            this->fnum = mont->to_montgomery(this->fnum);
+        }
+    } else {
+        this->num = natural(value);
+        this->fnum = uint256::zero();
+    }
+}
+
+// other's fixed-width value in the same representation as this->fnum
+uint256 FieldElement::operand(const FieldElement &other) const {
+    if (this->mont == other.mont) {
+        return other.fnum;
+    }
+    const MontgomeryContext* context = this->field->montgomery();
+    return this->mont ? context->to_montgomery(other.fnum) : context->from_montgomery(other.fnum);
+}
+
+uint256 FieldElement::fixed_add(const uint256& a, const uint256& b) const {
+    if (this->field->word()) {
+        const limb_t p = this->field->word_prime();
+        const limb_t sum = a.limb[0] + b.limb[0];
+        return uint256(sum >= p ? sum - p : sum);
+    }
+    const uint256& p = this->field->fixed_prime();
+    uint256 out;
+    limb_t carry = uint256::add(out, a, b);
+    if (carry || out >= p) {
+        out -= p;
+    }
+    return out;
+}
+
+uint256 FieldElement::fixed_sub(const uint256& a, const uint256& b) const {
+    if (this->field->word()) {
+        const limb_t difference = a.limb[0] - b.limb[0];
+        return uint256(a.limb[0] < b.limb[0] ? difference + this->field->word_prime() : difference);
+    }
+    uint256 out;
+    if (uint256::sub(out, a, b)) {
+        out += this->field->fixed_prime();
+    }
+    return out;
+}
+
+uint256 FieldElement::fixed_mul(const uint256& a, const uint256& b) const {
+    if (const MontgomeryContext* mont = montgomery()) {
+        return mont->mul(a, b);
+    }
+    if (this->field->word()) {
+        return uint256(this->field->mul_word(a.limb[0], b.limb[0]));
+    }
+    uint512 product = field_kernels().mul_wide(a, b);
+    if (PrimeField::fold_fn fold = this->field->fold()) {
+        return fold(product);
+    }
+    if (this->field->pseudo_mersenne()) {
+        return this->field->fold_c(product);
+    }
+    return uint256::from_integer(this->field->barrett().reduce(product.to_integer()));
+}
+
+uint256 FieldElement::fixed_sqr(const uint256& a) const {
+    if (const MontgomeryContext* mont = montgomery()) {
+        return mont->sqr(a);
+    }
+    if (this->field->word()) {
+        return uint256(this->field->mul_word(a.limb[0], a.limb[0]));
+    }
+    uint512 product = uint256::sqr_wide(a);
+    if (PrimeField::fold_fn fold = this->field->fold()) {
+        return fold(product);
+    }
+    if (this->field->pseudo_mersenne()) {
+        return this->field->fold_c(product);
+    }
+    return uint256::from_integer(this->field->barrett().reduce(product.to_integer()));
+}
+
+// brings any integer into [0, prime) and wraps it in this element's field
+FieldElement FieldElement::reduced(const integer &value) const {
+    FieldElement out(this->field, this->mont, unchecked());
+    out.assign(this->field->reduce(value));
+    return out;
+}
+
+FieldElement FieldElement::fixed_result(const uint256& v) const {
+    FieldElement out(this->field, this->mont, unchecked());
+    out.fnum = v;
+    return out;
+}
+
+FieldElement FieldElement::wide_result(integer&& v) const {
+    FieldElement out(this->field, this->mont, unchecked());
+    out.num = natural(std::move(v));
+    return out;
+}
+
+FieldElement FieldElement::one() const {
+    FieldElement out(this->field, this->mont, unchecked());
+    out.assign(1);
+    return out;
+}
+
+bool FieldElement::equals(const FieldElement& other) const {
+    if (this->field != other.field) {
+        return false;
+    }
+    if (!this->field->fixed()) {
+        return this->num == other.num;
+    }
+    return operand(other) == this->fnum;
+}
+
+uint64_t FieldElement::hash(uint64_t seed) const {
+    seed ^= reinterpret_cast<uintptr_t>(this->field);
+    if (!this->field->fixed()) {
+        return this->num.hash(seed);
+    }
+    const MontgomeryContext* mont = montgomery();
+    const uint256 plain = mont ? mont->from_montgomery(this->fnum) : this->fnum;
+    return hash_words(plain.limb, uint256::BITS / 64, seed);
+}
+
+to_chars_result to_chars(char* first, char* last, const FieldElement& a, int base) noexcept {
+    return to_chars(first, last, a.value(), base);
+}
+
+from_chars_result from_chars(const char* first, const char* last, FieldElement& out, const PrimeField& field,
+                             int base) noexcept {
+    integer value;
+    const from_chars_result read = from_chars(first, last, value, base);
+    if (read.status != Status::ok) {
+        return read;
+    }
+    Result<FieldElement> element = FieldElement::make(value, field);
+    if (!element.ok()) {
+        return {first, element.status()};
+    }
+    out = std::move(*element);
+    return read;
 }
 
 ostream &operator<<(ostream &os, const FieldElement &a) {
-    os << "FieldElement_" << a.prime << "(" << a.num << ")";
+    os << "FieldElement_" << a.field->prime() << "(" << a.value() << ")";
     return os;
 }
-
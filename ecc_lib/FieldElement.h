@@ -5,27 +5,191 @@
 #ifndef ECC_FIELDELEMENT_H
 #define ECC_FIELDELEMENT_H
 
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Executor.h"
+#include "Scratch.h"
 #include "integer.h"
+#include "MontgomeryContext.h"
+#include "natural.h"
+#include "PrimeField.h"
+#include "secp256k1.h"
+#include "Status.h"
+#include "uint256.h"
 
 using namespace std;
 
 class FieldElement {
 public:
     FieldElement(const integer& num, const integer& prime);
+    FieldElement(const integer& num, const PrimeField& field);
+    // keeps the element in Montgomery form under context, so products need no division
+    FieldElement(const integer& num, const std::shared_ptr<const MontgomeryContext>& context);
+    // the element num of field, or Status::out_of_range where the constructor throws
+    static Result<FieldElement> make(const integer& num, const PrimeField& field) noexcept;
+
+    // each operator has an rvalue overload that reuses the temporary, so chains
+    // like a * b + c allocate no intermediate elements
+    FieldElement operator+(const FieldElement& other) const &;
+    FieldElement operator-(const FieldElement& other) const &;
+    FieldElement operator*(const FieldElement& other) const &;
+    FieldElement operator*(const integer& other) const &;
+    FieldElement operator/(const FieldElement& other) const &;
+    FieldElement operator+(const FieldElement& other) && { *this += other; return std::move(*this); }
+    FieldElement operator-(const FieldElement& other) && { *this -= other; return std::move(*this); }
+    FieldElement operator*(const FieldElement& other) && { *this *= other; return std::move(*this); }
+    FieldElement operator*(const integer& other) && { *this *= other; return std::move(*this); }
+    FieldElement operator/(const FieldElement& other) && { *this /= other; return std::move(*this); }
+
+    FieldElement& operator+=(const FieldElement& other);
+    FieldElement& operator-=(const FieldElement& other);
+    FieldElement& operator*=(const FieldElement& other);
+    FieldElement& operator*=(const integer& other);
+    FieldElement& operator/=(const FieldElement& other);
+
+    // *this * *this through the squaring kernels
+    FieldElement square() const;
+    FieldElement power(const integer& power) const;
+    // power for secret exponents: a Montgomery ladder over fixed-width limbs whose
+    // sequence of operations does not depend on the exponent
+    FieldElement power_ct(const integer& power) const;
+    FieldElement sqrt() const;
+    // whether sqrt() succeeds (zero is a square), from the Jacobi symbol rather
+    // than an exponentiation; Montgomery form keeps the symbol since 2^256 is a square
+    bool is_square() const;
 
-    FieldElement operator+(FieldElement &other);
-    FieldElement operator-(FieldElement &other);
-    FieldElement operator*(FieldElement &other);
-    FieldElement operator*(const integer& other);
-    FieldElement operator/(FieldElement &other);
-    FieldElement power(const integer& power);
+    // the operators and sqrt() without exceptions: Status::field_mismatch,
+    // Status::division_by_zero or Status::not_a_square where they throw
+    Result<FieldElement> try_add(const FieldElement& other) const noexcept;
+    Result<FieldElement> try_sub(const FieldElement& other) const noexcept;
+    Result<FieldElement> try_mul(const FieldElement& other) const noexcept;
+    Result<FieldElement> try_div(const FieldElement& other) const noexcept;
+    Result<FieldElement> try_sqrt() const noexcept;
 
-    friend bool operator==(const FieldElement& lhs, const FieldElement& rhs);
-    friend bool operator!=(const FieldElement& lhs, const FieldElement& rhs);
+    // replaces each of elements[0, count) by its inverse with one inversion and
+    // 3(count - 1) multiplications (Montgomery's trick); large batches are split
+    // into a chunk per executor.concurrency(), each inverted as a task of
+    // executor. threads runs them on a ThreadExecutor of that many threads
+    static void batch_invert(FieldElement* elements, std::size_t count, unsigned threads = 1);
+    static void batch_invert(std::vector<FieldElement>& elements, unsigned threads = 1);
+    static void batch_invert(FieldElement* elements, std::size_t count, Executor& executor);
+    static void batch_invert(std::vector<FieldElement>& elements, Executor& executor);
+    // on the calling thread, with the prefix products on scratch
+    static void batch_invert(FieldElement* elements, std::size_t count, Scratch& scratch);
+    // a when mask is all ones, b when it is zero, for secret masks: no branch on
+    // mask for primes of at most 256 bits (wider ones select with a branch, as
+    // in power_ct). a and b must be in the same field; the result takes a's form
+    static FieldElement select(limb_t mask, const FieldElement& a, const FieldElement& b);
+
+    // elements of one field in one representation compare their limbs alone;
+    // otherwise one of them is converted first
+    friend bool operator==(const FieldElement& lhs, const FieldElement& rhs) {
+        if (lhs.field == rhs.field && lhs.mont == rhs.mont && lhs.field->fixed()) {
+            return lhs.fnum == rhs.fnum;
+        }
+        return lhs.equals(rhs);
+    }
+    friend bool operator!=(const FieldElement& lhs, const FieldElement& rhs) { return !(lhs == rhs); }
+    // hash_words of value() under seed and the field, the same in either
+    // representation; std::hash <FieldElement> is this under hash_seed()
+    uint64_t hash(uint64_t seed) const;
     friend ostream& operator<<( ostream& os, const FieldElement& a );
+    integer value() const;
+    // value() in exactly len big-endian bytes, zero padded, straight from the
+    // limbs for primes of at most 256 bits; throws std::invalid_argument if len
+    // is shorter than the prime
+    void to_bytes(uint8_t* out, std::size_t len) const;
+    // the big-endian value in[0, len) as an element of field, or Status::out_of_range
+    // if it is not below the prime; no integer is built for primes of at most 256 bits
+    static Result<FieldElement> from_bytes(const uint8_t* in, std::size_t len, const PrimeField& field) noexcept;
+    // to_bytes at the width of the prime as lower case hex, through the hex codec
+    std::string to_hex() const;
+    // the big-endian hex in[0, len), either case, as an element of field:
+    // Status::bad_digit for an odd len or a character that is not a hex digit
+    static Result<FieldElement> from_hex(const char* in, std::size_t len, const PrimeField& field) noexcept;
+
+    // The wire format: value() little-endian in exactly wire_size(field) bytes,
+    // the width of the prime (32 for secp256k1 and P-256). For primes of at most
+    // 256 bits in the plain representation, an element's bytes on a
+    // little-endian host are its limbs, copied as they are.
+    static std::size_t wire_size(const PrimeField& field) { return (field.bits() + 7) / 8; }
+    // in[0, count), all of one field, back to back into out: Status::field_mismatch
+    // if the fields differ, Status::buffer_too_small if capacity is short of
+    // count * wire_size; nothing is written then
+    static Status serialize(const FieldElement* in, std::size_t count, uint8_t* out, std::size_t capacity) noexcept;
+    static Status serialize(const std::vector<FieldElement>& in, uint8_t* out, std::size_t capacity) noexcept {
+        return serialize(in.data(), in.size(), out, capacity);
+    }
+    // the len / wire_size(field) elements at in, appended to out: Status::bad_encoding
+    // if the size does not divide len, Status::out_of_range if any value is
+    // not below the prime. All of them are range checked in one pass before
+    // any is built, so out is unchanged on an error
+    static Status deserialize(const uint8_t* in, std::size_t len, const PrimeField& field,
+                              std::vector<FieldElement>& out) noexcept;
+    // value() == 0 without leaving Montgomery form
+    bool is_zero() const { return this->field->fixed() ? this->fnum.is_zero() : this->num.is_zero(); }
+    const PrimeField& prime_field() const { return *this->field; }
+    // heap bytes held beyond sizeof(FieldElement), those of num: 0 for primes
+    // of up to 256 bits. The PrimeField is shared and not counted
+    std::size_t heap_bytes() const { return this->num.heap_bytes(); }
+
 private:
-    integer num;
-    integer prime;
+    // evaluates lazy(...) chains, see FieldExpression.h
+    friend struct FieldExpressionAccess;
+    // runs the fixed-width arithmetic below on its own limbs, see FieldVector.h
+    friend class FieldVector;
+    // keeps its entries as raw limbs, see FixedBaseTable.h
+    friend class FixedBaseTable;
+
+    // elements of fields whose prime fits in 256 bits live in fnum;
+    // num is only used for wider primes
+    const PrimeField* field;
+    natural num;
+    uint256 fnum;
+    // set when fnum holds the Montgomery form num * 2^256 mod prime
+    bool mont;
+
+    // The public constructors are the only place values are range checked;
+    // every internal result is already reduced and is built through these,
+    // starting from an element that is zero until assigned.
+    struct unchecked {};
+    FieldElement(const PrimeField* field, bool mont, unchecked) : field(field), fnum(0), mont(mont) {}
+    // the reduced v as an element of this element's field and representation
+    FieldElement fixed_result(const uint256& v) const;
+    FieldElement wide_result(integer&& v) const;
+    FieldElement one() const;
+
+    const MontgomeryContext* montgomery() const { return this->mont ? this->field->montgomery() : nullptr; }
+    void check_field(const FieldElement& other, const char* message) const;
+    bool equals(const FieldElement& other) const;
+    void assign(const integer& value);
+    uint256 operand(const FieldElement& other) const;
+    // the fixed-width arithmetic behind the operators, on values below the
+    // prime in this element's representation
+    uint256 fixed_add(const uint256& a, const uint256& b) const;
+    uint256 fixed_sub(const uint256& a, const uint256& b) const;
+    uint256 fixed_mul(const uint256& a, const uint256& b) const;
+    uint256 fixed_sqr(const uint256& a) const;
+    FieldElement exp(const integer& e) const;
+    uint256 chain_exp(PrimeField::chain chain, bool root) const;
+    FieldElement reduced(const integer & value) const;
+};
+
+// value() in base 2-16 as to_chars(char*, char*, const integer&, int) writes it
+to_chars_result to_chars(char* first, char* last, const FieldElement& a, int base = 10) noexcept;
+// a value in base 2-16 as from_chars(const char*, const char*, integer&, int)
+// reads it, into out as an element of field: Status::out_of_range (out
+// unchanged, ptr at first) if it is negative or not below the prime
+from_chars_result from_chars(const char* first, const char* last, FieldElement& out, const PrimeField& field,
+                             int base = 10) noexcept;
+
+namespace std {
+template <>
+struct hash<FieldElement> {
+    std::size_t operator()(const FieldElement& a) const { return static_cast<std::size_t>(a.hash(hash_seed())); }
 };
+}
 
 #endif //ECC_FIELDELEMENT_H
@@ -0,0 +1,381 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_FIELDEXPRESSION_H
+#define ECC_FIELDEXPRESSION_H
+
+#include <cstdint>
+#include <type_traits>
+
+#include "FieldElement.h"
+#include "integer.h"
+#include "OperationCounters.h"
+#include "uint256.h"
+
+// Lazy FieldElement arithmetic. lazy(x) wraps an element, and +, -, * with
+// elements, other expressions and built-in integers then build a tree of
+// operations instead of a value. The tree is evaluated once, when it is stored
+// in a FieldElement or compared:
+//
+//     FieldElement y2 = lazy(x) * x * x + b;
+//     FieldElement t = 3 * lazy(x) * x - lazy(a) * 2;
+//
+// For primes that fit in 256 bits every intermediate is a uint256 on the stack,
+// computed with the kernels of the eager operators (squaring where both factors
+// are one element). For wider primes sums, differences and multiples by a
+// constant stay unreduced integers, a factor is reduced only once it has
+// outgrown the prime, products inside a sum are accumulated in place, and the
+// result is reduced once when it is stored.
+//
+// An expression refers to the elements it was built from, so store it before
+// the statement ends; never keep one in an auto variable.
+
+// the FieldElement internals the expression nodes evaluate with
+struct FieldExpressionAccess {
+    static const PrimeField& field(const FieldElement& e) { return *e.field; }
+    static void check(const FieldElement& like, const FieldElement& e) {
+        like.check_field(e, "Cannot combine numbers in different fields");
+    }
+    static uint256 operand(const FieldElement& like, const FieldElement& e) { return like.operand(e); }
+    static const integer& wide(const FieldElement& e) { return e.num.value(); }
+
+    static uint256 add(const FieldElement& like, const uint256& a, const uint256& b) { return like.fixed_add(a, b); }
+    static uint256 sub(const FieldElement& like, const uint256& a, const uint256& b) { return like.fixed_sub(a, b); }
+    static uint256 mul(const FieldElement& like, const uint256& a, const uint256& b) { return like.fixed_mul(a, b); }
+    static uint256 sqr(const FieldElement& like, const uint256& a) { return like.fixed_sqr(a); }
+
+    // a wide value congruent to the element below the prime, reduced if it is
+    // negative or longer than the prime so that a product of two stays in
+    // reduction range
+    static const integer& factor(const FieldElement& like, const integer& v, integer& scratch) {
+        if (v < 0 || v.bit_length() > like.field->bits()) {
+            scratch = like.field->reduce(v);
+            return scratch;
+        }
+        return v;
+    }
+
+    static FieldElement fixed_result(const FieldElement& like, const uint256& v) { return like.fixed_result(v); }
+    static FieldElement wide_result(const FieldElement& like, const integer& v) {
+        return like.wide_result(like.field->reduce(v));
+    }
+};
+
+// Every node provides
+//     anchor()               the leftmost element, whose field and representation the result takes
+//     check(like)            throws unless every element is in like's field
+//     fixed(like)            the reduced value in like's representation, for fixed-width fields
+//     wide(out)              out = a value congruent to the node, for wide fields
+//     accumulate(out, sub)   out += or -= a value congruent to the node
+//     wide_ref(scratch)      a value congruent to the node, in scratch unless one is at hand
+template <class E>
+struct FieldExpression {
+    const E& self() const { return static_cast<const E&>(*this); }
+
+    void accumulate(integer& out, bool subtract) const {
+        integer v;
+        self().wide(v);
+        if (subtract) {
+            out -= v;
+        } else {
+            out += v;
+        }
+    }
+
+    const integer& wide_ref(integer& scratch) const {
+        self().wide(scratch);
+        return scratch;
+    }
+
+    operator FieldElement() const {
+        const FieldElement& like = self().anchor();
+        self().check(like);
+        if (FieldExpressionAccess::field(like).fixed()) {
+            return FieldExpressionAccess::fixed_result(like, self().fixed(like));
+        }
+        integer out;
+        self().wide(out);
+        return FieldExpressionAccess::wide_result(like, out);
+    }
+};
+
+struct FieldLeaf : FieldExpression<FieldLeaf> {
+    explicit FieldLeaf(const FieldElement& element) : element(element) {}
+
+    const FieldElement& anchor() const { return this->element; }
+    void check(const FieldElement& like) const { FieldExpressionAccess::check(like, this->element); }
+    uint256 fixed(const FieldElement& like) const { return FieldExpressionAccess::operand(like, this->element); }
+    void wide(integer& out) const { out = FieldExpressionAccess::wide(this->element); }
+    const integer& wide_ref(integer&) const { return FieldExpressionAccess::wide(this->element); }
+    void accumulate(integer& out, bool subtract) const {
+        if (subtract) {
+            out -= FieldExpressionAccess::wide(this->element);
+        } else {
+            out += FieldExpressionAccess::wide(this->element);
+        }
+    }
+
+    const FieldElement& element;
+};
+
+template <class L, class R>
+struct FieldSum : FieldExpression<FieldSum<L, R>> {
+    FieldSum(const L& l, const R& r) : l(l), r(r) {}
+
+    const FieldElement& anchor() const { return this->l.anchor(); }
+    void check(const FieldElement& like) const { this->l.check(like); this->r.check(like); }
+    uint256 fixed(const FieldElement& like) const {
+        ECC_COUNT(field_add);
+        return FieldExpressionAccess::add(like, this->l.fixed(like), this->r.fixed(like));
+    }
+    void wide(integer& out) const {
+        ECC_COUNT(field_add);
+        this->l.wide(out);
+        this->r.accumulate(out, false);
+    }
+    void accumulate(integer& out, bool subtract) const {
+        ECC_COUNT(field_add);
+        this->l.accumulate(out, subtract);
+        this->r.accumulate(out, subtract);
+    }
+
+    L l;
+    R r;
+};
+
+template <class L, class R>
+struct FieldDifference : FieldExpression<FieldDifference<L, R>> {
+    FieldDifference(const L& l, const R& r) : l(l), r(r) {}
+
+    const FieldElement& anchor() const { return this->l.anchor(); }
+    void check(const FieldElement& like) const { this->l.check(like); this->r.check(like); }
+    uint256 fixed(const FieldElement& like) const {
+        ECC_COUNT(field_add);
+        return FieldExpressionAccess::sub(like, this->l.fixed(like), this->r.fixed(like));
+    }
+    void wide(integer& out) const {
+        ECC_COUNT(field_add);
+        this->l.wide(out);
+        this->r.accumulate(out, true);
+    }
+    void accumulate(integer& out, bool subtract) const {
+        ECC_COUNT(field_add);
+        this->l.accumulate(out, subtract);
+        this->r.accumulate(out, !subtract);
+    }
+
+    L l;
+    R r;
+};
+
+template <class L, class R>
+struct FieldProduct : FieldExpression<FieldProduct<L, R>> {
+    FieldProduct(const L& l, const R& r) : l(l), r(r) {}
+
+    const FieldElement& anchor() const { return this->l.anchor(); }
+    void check(const FieldElement& like) const { this->l.check(like); this->r.check(like); }
+    uint256 fixed(const FieldElement& like) const {
+        ECC_COUNT(field_mul);
+        if (square()) {
+            return FieldExpressionAccess::sqr(like, this->l.fixed(like));
+        }
+        return FieldExpressionAccess::mul(like, this->l.fixed(like), this->r.fixed(like));
+    }
+    void wide(integer& out) const {
+        ECC_COUNT(field_mul);
+        integer ls, rs;
+        const integer& a = FieldExpressionAccess::factor(anchor(), this->l.wide_ref(ls), ls);
+        if (square()) {
+            out = a.square();
+            return;
+        }
+        const integer& b = FieldExpressionAccess::factor(anchor(), this->r.wide_ref(rs), rs);
+        out = a * b;
+    }
+    void accumulate(integer& out, bool subtract) const {
+        ECC_COUNT(field_mul);
+        integer ls, rs;
+        const integer& a = FieldExpressionAccess::factor(anchor(), this->l.wide_ref(ls), ls);
+        const integer& b = square() ? a : FieldExpressionAccess::factor(anchor(), this->r.wide_ref(rs), rs);
+        if (subtract) {
+            out.submul(a, b);
+        } else {
+            out.addmul(a, b);
+        }
+    }
+
+    L l;
+    R r;
+
+private:
+    // x * x, for the squaring kernels
+    bool square() const {
+        if constexpr (std::is_same<L, FieldLeaf>::value && std::is_same<R, FieldLeaf>::value) {
+            return &this->l.element == &this->r.element;
+        }
+        return false;
+    }
+};
+
+// the node times a built-in integer constant
+template <class E>
+struct FieldMultiple : FieldExpression<FieldMultiple<E>> {
+    template <typename Z>
+    FieldMultiple(const E& e, Z k) : e(e), magnitude(static_cast<std::uint64_t>(k)), negative(false) {
+        if constexpr (std::is_signed<Z>::value) {
+            if (k < 0) {
+                this->magnitude = 0 - this->magnitude;
+                this->negative = true;
+            }
+        }
+    }
+
+    const FieldElement& anchor() const { return this->e.anchor(); }
+    void check(const FieldElement& like) const { this->e.check(like); }
+    uint256 fixed(const FieldElement& like) const {
+        ECC_COUNT(field_mul);
+        // double and add, so the value never leaves the field
+        const uint256 x = this->e.fixed(like);
+        uint256 out = uint256::zero();
+        std::size_t top = 0;
+        while (top < 64 && (this->magnitude >> top)) {
+            top++;
+        }
+        for (std::size_t i = top; i > 0; i--) {
+            out = FieldExpressionAccess::add(like, out, out);
+            if ((this->magnitude >> (i - 1)) & 1) {
+                out = FieldExpressionAccess::add(like, out, x);
+            }
+        }
+        return this->negative ? FieldExpressionAccess::sub(like, uint256::zero(), out) : out;
+    }
+    void wide(integer& out) const {
+        ECC_COUNT(field_mul);
+        this->e.wide(out);
+        out *= this->magnitude;
+        if (this->negative) {
+            out = -out;
+        }
+    }
+    void accumulate(integer& out, bool subtract) const {
+        ECC_COUNT(field_mul);
+        integer scratch;
+        const integer& v = this->e.wide_ref(scratch);
+        if (subtract != this->negative) {
+            out.submul(v, integer(this->magnitude));
+        } else {
+            out.addmul(v, integer(this->magnitude));
+        }
+    }
+
+    E e;
+    std::uint64_t magnitude;
+    bool negative;
+};
+
+// starts a lazy expression at element
+inline FieldLeaf lazy(const FieldElement& element) {
+    return FieldLeaf(element);
+}
+
+// the operators take nodes by their own type, so they match exactly and beat
+// integer's operator templates, whose converting constructor accepts anything
+template <class E, class T = void>
+using if_field_expression = typename std::enable_if<std::is_base_of<FieldExpression<E>, E>::value, T>::type;
+
+template <class E, class Z, class T>
+using if_field_scalar = typename std::enable_if<std::is_base_of<FieldExpression<E>, E>::value
+        && std::is_integral<Z>::value, T>::type;
+
+template <class L, class R, class = if_field_expression<L>, class = if_field_expression<R>>
+FieldSum<L, R> operator+(const L& lhs, const R& rhs) {
+    return FieldSum<L, R>(lhs, rhs);
+}
+
+template <class L, class = if_field_expression<L>>
+FieldSum<L, FieldLeaf> operator+(const L& lhs, const FieldElement& rhs) {
+    return FieldSum<L, FieldLeaf>(lhs, FieldLeaf(rhs));
+}
+
+template <class R, class = if_field_expression<R>>
+FieldSum<FieldLeaf, R> operator+(const FieldElement& lhs, const R& rhs) {
+    return FieldSum<FieldLeaf, R>(FieldLeaf(lhs), rhs);
+}
+
+template <class L, class R, class = if_field_expression<L>, class = if_field_expression<R>>
+FieldDifference<L, R> operator-(const L& lhs, const R& rhs) {
+    return FieldDifference<L, R>(lhs, rhs);
+}
+
+template <class L, class = if_field_expression<L>>
+FieldDifference<L, FieldLeaf> operator-(const L& lhs, const FieldElement& rhs) {
+    return FieldDifference<L, FieldLeaf>(lhs, FieldLeaf(rhs));
+}
+
+template <class R, class = if_field_expression<R>>
+FieldDifference<FieldLeaf, R> operator-(const FieldElement& lhs, const R& rhs) {
+    return FieldDifference<FieldLeaf, R>(FieldLeaf(lhs), rhs);
+}
+
+template <class L, class R, class = if_field_expression<L>, class = if_field_expression<R>>
+FieldProduct<L, R> operator*(const L& lhs, const R& rhs) {
+    return FieldProduct<L, R>(lhs, rhs);
+}
+
+template <class L, class = if_field_expression<L>>
+FieldProduct<L, FieldLeaf> operator*(const L& lhs, const FieldElement& rhs) {
+    return FieldProduct<L, FieldLeaf>(lhs, FieldLeaf(rhs));
+}
+
+template <class R, class = if_field_expression<R>>
+FieldProduct<FieldLeaf, R> operator*(const FieldElement& lhs, const R& rhs) {
+    return FieldProduct<FieldLeaf, R>(FieldLeaf(lhs), rhs);
+}
+
+template <class E, class Z>
+if_field_scalar<E, Z, FieldMultiple<E>> operator*(const E& lhs, Z rhs) {
+    return FieldMultiple<E>(lhs, rhs);
+}
+
+template <class Z, class E>
+if_field_scalar<E, Z, FieldMultiple<E>> operator*(Z lhs, const E& rhs) {
+    return FieldMultiple<E>(rhs, lhs);
+}
+
+template <class E>
+if_field_expression<E, FieldMultiple<E>> operator-(const E& rhs) {
+    return FieldMultiple<E>(rhs, -1);
+}
+
+template <class L, class R, class = if_field_expression<L>, class = if_field_expression<R>>
+bool operator==(const L& lhs, const R& rhs) {
+    return FieldElement(lhs) == FieldElement(rhs);
+}
+
+template <class L, class = if_field_expression<L>>
+bool operator==(const L& lhs, const FieldElement& rhs) {
+    return FieldElement(lhs) == rhs;
+}
+
+template <class R, class = if_field_expression<R>>
+bool operator==(const FieldElement& lhs, const R& rhs) {
+    return lhs == FieldElement(rhs);
+}
+
+template <class L, class R, class = if_field_expression<L>, class = if_field_expression<R>>
+bool operator!=(const L& lhs, const R& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class L, class = if_field_expression<L>>
+bool operator!=(const L& lhs, const FieldElement& rhs) {
+    return !(lhs == rhs);
+}
+
+template <class R, class = if_field_expression<R>>
+bool operator!=(const FieldElement& lhs, const R& rhs) {
+    return !(lhs == rhs);
+}
+
+#endif //ECC_FIELDEXPRESSION_H
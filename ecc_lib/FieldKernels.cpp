@@ -0,0 +1,165 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include "FieldKernels.h"
+#include "MontgomeryContext.h"
+#include "secp256k1.h"
+
+static uint256 portable_montgomery_mul(const uint256& a, const uint256& b, const uint256& p, limb_t n0) {
+    return montgomery_mul(a, b, p, n0);
+}
+
+static uint512 portable_mul_wide(const uint256& a, const uint256& b) {
+    return uint256::mul_wide(a, b);
+}
+
+static void portable_mul(uint256* out, const uint256* a, const uint256* b, std::size_t n, const uint256& p, limb_t n0) {
+    for (std::size_t i = 0; i < n; i++) {
+        out[i] = montgomery_mul(a[i], b[i], p, n0);
+    }
+}
+
+static void portable_add(uint256* out, const uint256* a, const uint256* b, std::size_t n, const uint256& p) {
+    for (std::size_t i = 0; i < n; i++) {
+        out[i] = montgomery_add(a[i], b[i], p);
+    }
+}
+
+static void portable_sub(uint256* out, const uint256* a, const uint256* b, std::size_t n, const uint256& p) {
+    for (std::size_t i = 0; i < n; i++) {
+        out[i] = montgomery_sub(a[i], b[i], p);
+    }
+}
+
+const FieldKernels& portable_field_kernels() {
+    static const FieldKernels kernels = {"portable", portable_montgomery_mul, portable_mul_wide,
+            secp256k1_reduce_p_portable, portable_mul, portable_add, portable_sub};
+    return kernels;
+}
+
+// every backend, fastest first
+static const FieldBackend BACKENDS[] = {
+    FieldBackend::avx512ifma,
+    FieldBackend::avx2,
+    FieldBackend::adx,
+    FieldBackend::neon,
+    FieldBackend::simd128,
+    FieldBackend::portable,
+};
+
+const char* field_backend_name(FieldBackend backend) {
+    switch (backend) {
+        case FieldBackend::portable:
+            return "portable";
+        case FieldBackend::adx:
+            return "adx";
+        case FieldBackend::avx2:
+            return "avx2";
+        case FieldBackend::avx512ifma:
+            return "avx512ifma";
+        case FieldBackend::neon:
+            return "neon";
+        case FieldBackend::simd128:
+            return "simd128";
+    }
+    throw std::invalid_argument("Unknown field backend");
+}
+
+const FieldKernels* field_kernels(FieldBackend backend) {
+    switch (backend) {
+        case FieldBackend::portable:
+            return &portable_field_kernels();
+        case FieldBackend::adx:
+            return adx_field_kernels();
+        case FieldBackend::avx2:
+            return avx2_field_kernels();
+        case FieldBackend::avx512ifma:
+            return avx512ifma_field_kernels();
+        case FieldBackend::neon:
+            return neon_field_kernels();
+        case FieldBackend::simd128:
+            return simd128_field_kernels();
+    }
+    return nullptr;
+}
+
+bool field_backend_supported(FieldBackend backend) {
+    return field_kernels(backend) != nullptr;
+}
+
+std::vector<FieldBackend> supported_field_backends() {
+    std::vector<FieldBackend> out;
+    for (FieldBackend backend : BACKENDS) {
+        if (field_backend_supported(backend)) {
+            out.push_back(backend);
+        }
+    }
+    return out;
+}
+
+FieldBackend best_field_backend() {
+    return supported_field_backends().front();
+}
+
+// the startup choice: ECC_FIELD_BACKEND when it names a supported backend
+static FieldBackend initial_field_backend() {
+    if (const char* name = std::getenv("ECC_FIELD_BACKEND")) {
+        for (FieldBackend backend : BACKENDS) {
+            if (std::strcmp(name, field_backend_name(backend)) == 0 && field_backend_supported(backend)) {
+                return backend;
+            }
+        }
+    }
+    return best_field_backend();
+}
+
+// the backend and its table, published together so a reader never sees one without the other
+struct ActiveBackend {
+    FieldBackend backend;
+    const FieldKernels* kernels;
+};
+
+static std::atomic<const ActiveBackend*>& active_backend() {
+    static const ActiveBackend initial = []() {
+        const FieldBackend backend = initial_field_backend();
+        return ActiveBackend{backend, field_kernels(backend)};
+    }();
+    static std::atomic<const ActiveBackend*> active(&initial);
+    return active;
+}
+
+FieldBackend field_backend() {
+    return active_backend().load(std::memory_order_acquire)->backend;
+}
+
+const FieldKernels& field_kernels() {
+    return *active_backend().load(std::memory_order_acquire)->kernels;
+}
+
+void force_field_backend(FieldBackend backend) {
+    // one descriptor per backend, built once, so switching never frees one a reader may hold
+    static const ActiveBackend choices[] = {
+        {FieldBackend::portable, field_kernels(FieldBackend::portable)},
+        {FieldBackend::adx, field_kernels(FieldBackend::adx)},
+        {FieldBackend::avx2, field_kernels(FieldBackend::avx2)},
+        {FieldBackend::avx512ifma, field_kernels(FieldBackend::avx512ifma)},
+        {FieldBackend::neon, field_kernels(FieldBackend::neon)},
+        {FieldBackend::simd128, field_kernels(FieldBackend::simd128)},
+    };
+    for (const ActiveBackend& choice : choices) {
+        if (choice.backend == backend) {
+            if (!choice.kernels) {
+                throw std::invalid_argument(std::string("Field backend ") + field_backend_name(backend)
+                        + " is not supported on this CPU");
+            }
+            active_backend().store(&choice, std::memory_order_release);
+            return;
+        }
+    }
+    throw std::invalid_argument("Unknown field backend");
+}
@@ -0,0 +1,90 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_FIELDKERNELS_H
+#define ECC_FIELDKERNELS_H
+
+#include <cstddef>
+#include <vector>
+
+#include "limb.h"
+#include "uint256.h"
+
+// The 256-bit field kernels underneath MontgomeryContext, FieldElement and
+// secp256k1_reduce_p, one table per instruction set. The x86 vector and
+// assembly variants are compiled for their instruction sets with target
+// attributes, so the library still runs on any x86-64; the AArch64 table is
+// built only there, and the WebAssembly SIMD128 table only in a build with
+// -msimd128. field_kernels() checks the CPU once and hands out the best
+// table it supports. Each table also carries the best kernels of the tables
+// below it that the CPU can run.
+struct FieldKernels {
+    const char* name;
+
+    // single operations: a * b / 2^256 mod p for a, b < p, the full 512-bit
+    // product, and secp256k1_reduce_p
+    uint256 (*montgomery_mul)(const uint256& a, const uint256& b, const uint256& p, limb_t n0);
+    uint512 (*mul_wide)(const uint256& a, const uint256& b);
+    uint256 (*secp256k1_reduce_p)(const uint512& x);
+
+    // Montgomery arithmetic over many independent operands at once, for callers
+    // with a batch of unrelated field operations (verifying many signatures,
+    // evaluating many points): out[i] = a[i] op b[i] mod p for every i < n, with
+    // every value in Montgomery form (R = 2^256) and below the odd prime p. out
+    // may be a or b, but must not otherwise overlap them.
+    void (*mul)(uint256* out, const uint256* a, const uint256* b, std::size_t n, const uint256& p, limb_t n0);
+    void (*add)(uint256* out, const uint256* a, const uint256* b, std::size_t n, const uint256& p);
+    void (*sub)(uint256* out, const uint256* a, const uint256* b, std::size_t n, const uint256& p);
+};
+
+// the C++ limb loops from MontgomeryContext.h, uint256.h and secp256k1.h
+const FieldKernels& portable_field_kernels();
+// MULX with ADCX/ADOX, so each row of a product runs two carry chains at once;
+// null without BMI2 and ADX
+const FieldKernels* adx_field_kernels();
+// four lanes of 64-bit limbs for batched add and sub; null without AVX2
+const FieldKernels* avx2_field_kernels();
+// eight lanes of 52-bit limbs for batched multiplication with VPMADD52;
+// null without AVX-512 IFMA
+const FieldKernels* avx512ifma_field_kernels();
+// AArch64: MUL/UMULH rows with ADDS/ADCS carry chains, and two lanes of
+// 64-bit limbs for batched add and sub; null on other architectures
+const FieldKernels* neon_field_kernels();
+// WebAssembly SIMD128: four lanes of 32-bit limbs for batched multiplication,
+// add and sub; null unless built for it
+const FieldKernels* simd128_field_kernels();
+
+// The backends above by name, for choosing one explicitly. Every library call
+// that reaches a field kernel goes through field_kernels(), which starts out
+// as best_field_backend(), or as the backend named by the ECC_FIELD_BACKEND
+// environment variable ("portable", "adx", ...) if that is set and supported,
+// and changes only through force_field_backend(). integer arithmetic has one
+// portable implementation and is not affected.
+enum class FieldBackend {
+    portable,
+    adx,
+    avx2,
+    avx512ifma,
+    neon,
+    simd128,
+};
+
+const char* field_backend_name(FieldBackend backend);
+// the table for backend, or null where this CPU cannot run it
+const FieldKernels* field_kernels(FieldBackend backend);
+bool field_backend_supported(FieldBackend backend);
+std::vector<FieldBackend> supported_field_backends();
+// the fastest backend this CPU supports
+FieldBackend best_field_backend();
+
+// the backend in use, and its kernels
+FieldBackend field_backend();
+const FieldKernels& field_kernels();
+
+// switches every later field operation, in all threads, to backend; throws
+// std::invalid_argument if this CPU cannot run it. Meant for startup, tests
+// and benchmarks: elements already computed are the same in every backend.
+void force_field_backend(FieldBackend backend);
+
+#endif //ECC_FIELDKERNELS_H
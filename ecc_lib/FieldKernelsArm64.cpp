@@ -0,0 +1,214 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include "FieldKernels.h"
+#include "MontgomeryContext.h"
+#include "secp256k1.h"
+
+#if defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+
+#include <arm_neon.h>
+
+// AArch64 has no second carry flag, but MUL and UMULH of all four limbs are
+// independent, so a row issues its eight multiplies back to back and then
+// runs two ADDS/ADCS chains, one over the low halves and one over the high.
+// t4 holds the running top limb and t5 collects the row's carry out.
+static inline void arm64_mac_row(limb_t& t0, limb_t& t1, limb_t& t2, limb_t& t3, limb_t& t4, limb_t& t5,
+        const limb_t* a, limb_t b) {
+    limb_t l0, l1, l2, l3, h0, h1, h2, h3;
+    __asm__(
+            "mul   %[l0], %[a0], %[b]\n\t"
+            "umulh %[h0], %[a0], %[b]\n\t"
+            "mul   %[l1], %[a1], %[b]\n\t"
+            "umulh %[h1], %[a1], %[b]\n\t"
+            "mul   %[l2], %[a2], %[b]\n\t"
+            "umulh %[h2], %[a2], %[b]\n\t"
+            "mul   %[l3], %[a3], %[b]\n\t"
+            "umulh %[h3], %[a3], %[b]\n\t"
+            "adds  %[t0], %[t0], %[l0]\n\t"
+            "adcs  %[t1], %[t1], %[l1]\n\t"
+            "adcs  %[t2], %[t2], %[l2]\n\t"
+            "adcs  %[t3], %[t3], %[l3]\n\t"
+            "adcs  %[t4], %[t4], xzr\n\t"
+            "adc   %[t5], %[t5], xzr\n\t"
+            "adds  %[t1], %[t1], %[h0]\n\t"
+            "adcs  %[t2], %[t2], %[h1]\n\t"
+            "adcs  %[t3], %[t3], %[h2]\n\t"
+            "adcs  %[t4], %[t4], %[h3]\n\t"
+            "adc   %[t5], %[t5], xzr\n\t"
+            : [t0] "+r"(t0), [t1] "+r"(t1), [t2] "+r"(t2), [t3] "+r"(t3), [t4] "+r"(t4), [t5] "+r"(t5),
+              [l0] "=&r"(l0), [l1] "=&r"(l1), [l2] "=&r"(l2), [l3] "=&r"(l3),
+              [h0] "=&r"(h0), [h1] "=&r"(h1), [h2] "=&r"(h2), [h3] "=&r"(h3)
+            : [a0] "r"(a[0]), [a1] "r"(a[1]), [a2] "r"(a[2]), [a3] "r"(a[3]), [b] "r"(b)
+            : "cc");
+}
+
+static uint256 arm64_montgomery_mul(const uint256& a, const uint256& b, const uint256& p, limb_t n0) {
+    limb_t t0 = 0, t1 = 0, t2 = 0, t3 = 0, t4 = 0, t5 = 0;
+    for (std::size_t i = 0; i < 4; i++) {
+        arm64_mac_row(t0, t1, t2, t3, t4, t5, a.limb, b.limb[i]);
+        // add m * p so the low limb cancels, then drop it
+        arm64_mac_row(t0, t1, t2, t3, t4, t5, p.limb, t0 * n0);
+        t0 = t1;
+        t1 = t2;
+        t2 = t3;
+        t3 = t4;
+        t4 = t5;
+        t5 = 0;
+    }
+
+    // t < 2p, one conditional subtraction brings it below p
+    uint256 out, reduced;
+    out.limb[0] = t0;
+    out.limb[1] = t1;
+    out.limb[2] = t2;
+    out.limb[3] = t3;
+    const limb_t borrow = uint256::sub(reduced, out, p);
+    return uint256::select(0 - (t4 | (borrow ^ 1)), reduced, out);
+}
+
+static uint512 arm64_mul_wide(const uint256& a, const uint256& b) {
+    uint512 out;
+    limb_t t0 = 0, t1 = 0, t2 = 0, t3 = 0, t4 = 0, t5 = 0;
+    for (std::size_t i = 0; i < 4; i++) {
+        arm64_mac_row(t0, t1, t2, t3, t4, t5, a.limb, b.limb[i]);
+        out.limb[i] = t0;
+        t0 = t1;
+        t1 = t2;
+        t2 = t3;
+        t3 = t4;
+        t4 = t5;
+        t5 = 0;
+    }
+    out.limb[4] = t0;
+    out.limb[5] = t1;
+    out.limb[6] = t2;
+    out.limb[7] = t3;
+    return out;
+}
+
+// the first fold, lo + hi * c, as one row; the second is secp256k1_fold_top_p
+static uint256 arm64_secp256k1_reduce_p(const uint512& x) {
+    limb_t t0 = x.limb[0], t1 = x.limb[1], t2 = x.limb[2], t3 = x.limb[3], t4 = 0, t5 = 0;
+    arm64_mac_row(t0, t1, t2, t3, t4, t5, x.limb + 4, SECP256K1_FIELD_C);
+    uint256 folded;
+    folded.limb[0] = t0;
+    folded.limb[1] = t1;
+    folded.limb[2] = t2;
+    folded.limb[3] = t3;
+    return secp256k1_fold_top_p(folded, t4);
+}
+
+static void arm64_mul(uint256* out, const uint256* a, const uint256* b, std::size_t n, const uint256& p, limb_t n0) {
+    for (std::size_t i = 0; i < n; i++) {
+        out[i] = arm64_montgomery_mul(a[i], b[i], p, n0);
+    }
+}
+
+// NEON: two elements per register set, register j holding limb j of each.
+// NEON has no 64x64-bit multiply, so only add and sub are vectorized; its
+// unsigned compares give the carry and borrow masks directly.
+
+static inline void neon_load2(uint64x2_t* r, const uint256* x) {
+    for (std::size_t j = 0; j < 4; j += 2) {
+        const uint64x2_t e0 = vld1q_u64(x[0].limb + j);
+        const uint64x2_t e1 = vld1q_u64(x[1].limb + j);
+        r[j] = vzip1q_u64(e0, e1);
+        r[j + 1] = vzip2q_u64(e0, e1);
+    }
+}
+
+static inline void neon_store2(uint256* x, const uint64x2_t* r) {
+    for (std::size_t j = 0; j < 4; j += 2) {
+        vst1q_u64(x[0].limb + j, vzip1q_u64(r[j], r[j + 1]));
+        vst1q_u64(x[1].limb + j, vzip2q_u64(r[j], r[j + 1]));
+    }
+}
+
+// s - p with borrow, keeping s where that borrows out (and nothing carried into s)
+static inline void neon_subtract_p_if_ge(uint64x2_t* s, uint64x2_t carry, const uint64x2_t* p) {
+    uint64x2_t d[4];
+    uint64x2_t borrow = vdupq_n_u64(0);
+    for (std::size_t j = 0; j < 4; j++) {
+        const uint64x2_t t = vsubq_u64(s[j], p[j]);
+        const uint64x2_t u = vaddq_u64(t, borrow);
+        borrow = vorrq_u64(vcltq_u64(s[j], p[j]), vcltq_u64(t, u));
+        d[j] = u;
+    }
+    const uint64x2_t use = vorrq_u64(carry, vceqq_u64(borrow, vdupq_n_u64(0)));
+    for (std::size_t j = 0; j < 4; j++) {
+        s[j] = vbslq_u64(use, d[j], s[j]);
+    }
+}
+
+static void neon_add(uint256* out, const uint256* a, const uint256* b, std::size_t n, const uint256& p) {
+    uint64x2_t P[4];
+    for (std::size_t j = 0; j < 4; j++) {
+        P[j] = vdupq_n_u64(p.limb[j]);
+    }
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        uint64x2_t A[4], B[4];
+        neon_load2(A, a + i);
+        neon_load2(B, b + i);
+        uint64x2_t carry = vdupq_n_u64(0);
+        for (std::size_t j = 0; j < 4; j++) {
+            const uint64x2_t t = vaddq_u64(A[j], B[j]);
+            const uint64x2_t u = vsubq_u64(t, carry);
+            carry = vorrq_u64(vcltq_u64(t, A[j]), vcltq_u64(u, t));
+            A[j] = u;
+        }
+        neon_subtract_p_if_ge(A, carry, P);
+        neon_store2(out + i, A);
+    }
+    for (; i < n; i++) {
+        out[i] = montgomery_add(a[i], b[i], p);
+    }
+}
+
+static void neon_sub(uint256* out, const uint256* a, const uint256* b, std::size_t n, const uint256& p) {
+    uint64x2_t P[4];
+    for (std::size_t j = 0; j < 4; j++) {
+        P[j] = vdupq_n_u64(p.limb[j]);
+    }
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        uint64x2_t A[4], B[4];
+        neon_load2(A, a + i);
+        neon_load2(B, b + i);
+        uint64x2_t borrow = vdupq_n_u64(0);
+        for (std::size_t j = 0; j < 4; j++) {
+            const uint64x2_t t = vsubq_u64(A[j], B[j]);
+            const uint64x2_t u = vaddq_u64(t, borrow);
+            borrow = vorrq_u64(vcltq_u64(A[j], B[j]), vcltq_u64(t, u));
+            A[j] = u;
+        }
+        // add p back in the lanes that went negative
+        uint64x2_t carry = vdupq_n_u64(0);
+        for (std::size_t j = 0; j < 4; j++) {
+            const uint64x2_t t = vaddq_u64(A[j], vandq_u64(P[j], borrow));
+            const uint64x2_t u = vsubq_u64(t, carry);
+            carry = vorrq_u64(vcltq_u64(t, A[j]), vcltq_u64(u, t));
+            A[j] = u;
+        }
+        neon_store2(out + i, A);
+    }
+    for (; i < n; i++) {
+        out[i] = montgomery_sub(a[i], b[i], p);
+    }
+}
+
+// Advanced SIMD is part of the AArch64 base architecture, so there is nothing to detect
+const FieldKernels* neon_field_kernels() {
+    static const FieldKernels kernels = {"neon", arm64_montgomery_mul, arm64_mul_wide,
+            arm64_secp256k1_reduce_p, arm64_mul, neon_add, neon_sub};
+    return &kernels;
+}
+
+#else
+
+const FieldKernels* neon_field_kernels() {
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,239 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include "FieldKernels.h"
+#include "MontgomeryContext.h"
+#include "secp256k1.h"
+
+#if defined(__wasm_simd128__)
+
+#include <wasm_simd128.h>
+
+// WebAssembly SIMD128: four elements per register set, register j holding the
+// 32-bit limb j of each, so an element is eight limbs and R is still 2^256.
+// wasm32 has no 64x64 -> 128 bit multiply, but extmul gives the 32x32 -> 64
+// bit products of two lanes, so a batched product runs as two halves of two
+// elements each, with 64-bit column sums; add and sub take their carries from
+// unsigned compares as the NEON kernels do. The single operations stay on the
+// portable limb loops.
+
+// the 4x4 transpose of 32-bit words, its own inverse
+static inline void simd128_transpose(v128_t* r) {
+    const v128_t t0 = wasm_i32x4_shuffle(r[0], r[1], 0, 4, 1, 5);
+    const v128_t t1 = wasm_i32x4_shuffle(r[0], r[1], 2, 6, 3, 7);
+    const v128_t t2 = wasm_i32x4_shuffle(r[2], r[3], 0, 4, 1, 5);
+    const v128_t t3 = wasm_i32x4_shuffle(r[2], r[3], 2, 6, 3, 7);
+    r[0] = wasm_i32x4_shuffle(t0, t2, 0, 1, 4, 5);
+    r[1] = wasm_i32x4_shuffle(t0, t2, 2, 3, 6, 7);
+    r[2] = wasm_i32x4_shuffle(t1, t3, 0, 1, 4, 5);
+    r[3] = wasm_i32x4_shuffle(t1, t3, 2, 3, 6, 7);
+}
+
+static inline void simd128_load4(v128_t* r, const uint256* x) {
+    for (std::size_t j = 0; j < 8; j += 4) {
+        for (std::size_t e = 0; e < 4; e++) {
+            r[j + e] = wasm_v128_load(x[e].limb + j / 2);
+        }
+        simd128_transpose(r + j);
+    }
+}
+
+static inline void simd128_store4(uint256* x, const v128_t* r) {
+    for (std::size_t j = 0; j < 8; j += 4) {
+        v128_t t[4] = {r[j], r[j + 1], r[j + 2], r[j + 3]};
+        simd128_transpose(t);
+        for (std::size_t e = 0; e < 4; e++) {
+            wasm_v128_store(x[e].limb + j / 2, t[e]);
+        }
+    }
+}
+
+// limb j of p in every lane
+static inline uint32_t simd128_limb(const uint256& p, std::size_t j) {
+    return static_cast<uint32_t>(p.limb[j / 2] >> (32 * (j % 2)));
+}
+
+// the 64-bit products of lanes 0 and 1 (half 0) or 2 and 3 (half 1)
+static inline v128_t simd128_extmul(v128_t a, v128_t b, std::size_t half) {
+    return half ? wasm_u64x2_extmul_high_u32x4(a, b) : wasm_u64x2_extmul_low_u32x4(a, b);
+}
+
+// the low words of two halves back in one register of four lanes
+static inline v128_t simd128_pack(v128_t lo, v128_t hi) {
+    return wasm_i32x4_shuffle(lo, hi, 0, 2, 4, 6);
+}
+
+// Montgomery multiplication with 32-bit rows, as montgomery_mul with 64-bit
+// ones: t[h][k] is column k of elements 2h and 2h + 1, below 2^32 between
+// rows, so no column sum (2^32 - 1) + (2^32 - 1)^2 + (2^32 - 1) can overflow.
+static void simd128_mul(uint256* out, const uint256* a, const uint256* b, std::size_t n, const uint256& p,
+        limb_t n0) {
+    const v128_t zero = wasm_i64x2_splat(0);
+    const v128_t mask = wasm_i64x2_splat(0xffffffff);
+    // -p^-1 mod 2^32 is the low word of -p^-1 mod 2^64
+    const v128_t n0v = wasm_i32x4_splat(static_cast<int32_t>(static_cast<uint32_t>(n0)));
+    v128_t P[8], P64[8];
+    for (std::size_t j = 0; j < 8; j++) {
+        P[j] = wasm_i32x4_splat(static_cast<int32_t>(simd128_limb(p, j)));
+        P64[j] = wasm_i64x2_splat(simd128_limb(p, j));
+    }
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        v128_t A[8], B[8];
+        simd128_load4(A, a + i);
+        simd128_load4(B, b + i);
+        v128_t t[2][10];
+        for (std::size_t h = 0; h < 2; h++) {
+            for (std::size_t k = 0; k < 10; k++) {
+                t[h][k] = zero;
+            }
+        }
+        for (std::size_t r = 0; r < 8; r++) {
+            for (std::size_t h = 0; h < 2; h++) {
+                v128_t carry = zero;
+                for (std::size_t j = 0; j < 8; j++) {
+                    const v128_t s = wasm_i64x2_add(wasm_i64x2_add(t[h][j], simd128_extmul(A[j], B[r], h)), carry);
+                    t[h][j] = wasm_v128_and(s, mask);
+                    carry = wasm_u64x2_shr(s, 32);
+                }
+                const v128_t s = wasm_i64x2_add(t[h][8], carry);
+                t[h][8] = wasm_v128_and(s, mask);
+                t[h][9] = wasm_u64x2_shr(s, 32);
+            }
+            // add m * p so the low column cancels, then drop it
+            const v128_t m = wasm_i32x4_mul(simd128_pack(t[0][0], t[1][0]), n0v);
+            for (std::size_t h = 0; h < 2; h++) {
+                v128_t carry = wasm_u64x2_shr(wasm_i64x2_add(t[h][0], simd128_extmul(m, P[0], h)), 32);
+                for (std::size_t j = 1; j < 8; j++) {
+                    const v128_t s = wasm_i64x2_add(wasm_i64x2_add(t[h][j], simd128_extmul(m, P[j], h)), carry);
+                    t[h][j - 1] = wasm_v128_and(s, mask);
+                    carry = wasm_u64x2_shr(s, 32);
+                }
+                const v128_t s = wasm_i64x2_add(t[h][8], carry);
+                t[h][7] = wasm_v128_and(s, mask);
+                t[h][8] = wasm_i64x2_add(t[h][9], wasm_u64x2_shr(s, 32));
+            }
+        }
+
+        // t < 2p, one conditional subtraction brings it below p: a lane that
+        // went negative has its sign bit set
+        v128_t R[8];
+        for (std::size_t h = 0; h < 2; h++) {
+            v128_t d[8];
+            v128_t borrow = zero;
+            for (std::size_t j = 0; j < 8; j++) {
+                const v128_t u = wasm_i64x2_sub(wasm_i64x2_sub(t[h][j], P64[j]), borrow);
+                d[j] = wasm_v128_and(u, mask);
+                borrow = wasm_u64x2_shr(u, 63);
+            }
+            const v128_t use = wasm_v128_or(wasm_i64x2_ne(t[h][8], zero), wasm_i64x2_eq(borrow, zero));
+            for (std::size_t j = 0; j < 8; j++) {
+                t[h][j] = wasm_v128_bitselect(d[j], t[h][j], use);
+            }
+        }
+        for (std::size_t j = 0; j < 8; j++) {
+            R[j] = simd128_pack(t[0][j], t[1][j]);
+        }
+        simd128_store4(out + i, R);
+    }
+    for (; i < n; i++) {
+        out[i] = montgomery_mul(a[i], b[i], p, n0);
+    }
+}
+
+// s - p with borrow, keeping s where that borrows out (and nothing carried into s)
+static inline void simd128_subtract_p_if_ge(v128_t* s, v128_t carry, const v128_t* p) {
+    v128_t d[8];
+    v128_t borrow = wasm_i32x4_splat(0);
+    for (std::size_t j = 0; j < 8; j++) {
+        const v128_t t = wasm_i32x4_sub(s[j], p[j]);
+        const v128_t u = wasm_i32x4_add(t, borrow);
+        borrow = wasm_v128_or(wasm_u32x4_lt(s[j], p[j]), wasm_u32x4_lt(t, u));
+        d[j] = u;
+    }
+    const v128_t use = wasm_v128_or(carry, wasm_i32x4_eq(borrow, wasm_i32x4_splat(0)));
+    for (std::size_t j = 0; j < 8; j++) {
+        s[j] = wasm_v128_bitselect(d[j], s[j], use);
+    }
+}
+
+static void simd128_add(uint256* out, const uint256* a, const uint256* b, std::size_t n, const uint256& p) {
+    v128_t P[8];
+    for (std::size_t j = 0; j < 8; j++) {
+        P[j] = wasm_i32x4_splat(static_cast<int32_t>(simd128_limb(p, j)));
+    }
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        v128_t A[8], B[8];
+        simd128_load4(A, a + i);
+        simd128_load4(B, b + i);
+        v128_t carry = wasm_i32x4_splat(0);
+        for (std::size_t j = 0; j < 8; j++) {
+            const v128_t t = wasm_i32x4_add(A[j], B[j]);
+            const v128_t u = wasm_i32x4_sub(t, carry);
+            carry = wasm_v128_or(wasm_u32x4_lt(t, A[j]), wasm_u32x4_lt(u, t));
+            A[j] = u;
+        }
+        simd128_subtract_p_if_ge(A, carry, P);
+        simd128_store4(out + i, A);
+    }
+    for (; i < n; i++) {
+        out[i] = montgomery_add(a[i], b[i], p);
+    }
+}
+
+static void simd128_sub(uint256* out, const uint256* a, const uint256* b, std::size_t n, const uint256& p) {
+    v128_t P[8];
+    for (std::size_t j = 0; j < 8; j++) {
+        P[j] = wasm_i32x4_splat(static_cast<int32_t>(simd128_limb(p, j)));
+    }
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        v128_t A[8], B[8];
+        simd128_load4(A, a + i);
+        simd128_load4(B, b + i);
+        v128_t borrow = wasm_i32x4_splat(0);
+        for (std::size_t j = 0; j < 8; j++) {
+            const v128_t t = wasm_i32x4_sub(A[j], B[j]);
+            const v128_t u = wasm_i32x4_add(t, borrow);
+            borrow = wasm_v128_or(wasm_u32x4_lt(A[j], B[j]), wasm_u32x4_lt(t, u));
+            A[j] = u;
+        }
+        // add p back in the lanes that went negative
+        v128_t carry = wasm_i32x4_splat(0);
+        for (std::size_t j = 0; j < 8; j++) {
+            const v128_t t = wasm_i32x4_add(A[j], wasm_v128_and(P[j], borrow));
+            const v128_t u = wasm_i32x4_sub(t, carry);
+            carry = wasm_v128_or(wasm_u32x4_lt(t, A[j]), wasm_u32x4_lt(u, t));
+            A[j] = u;
+        }
+        simd128_store4(out + i, A);
+    }
+    for (; i < n; i++) {
+        out[i] = montgomery_sub(a[i], b[i], p);
+    }
+}
+
+static uint256 simd128_montgomery_mul(const uint256& a, const uint256& b, const uint256& p, limb_t n0) {
+    return montgomery_mul(a, b, p, n0);
+}
+
+static uint512 simd128_mul_wide(const uint256& a, const uint256& b) {
+    return uint256::mul_wide(a, b);
+}
+
+// a module using SIMD128 fails validation on an engine without it, so there
+// is nothing to detect at run time
+const FieldKernels* simd128_field_kernels() {
+    static const FieldKernels kernels = {"simd128", simd128_montgomery_mul, simd128_mul_wide,
+            secp256k1_reduce_p_portable, simd128_mul, simd128_add, simd128_sub};
+    return &kernels;
+}
+
+#else
+
+const FieldKernels* simd128_field_kernels() {
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,447 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include "FieldKernels.h"
+#include "MontgomeryContext.h"
+#include "secp256k1.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+#include <cstdint>
+#include <immintrin.h>
+
+#define ECC_ADX __attribute__((target("bmi2,adx")))
+#define ECC_AVX2 __attribute__((target("avx2")))
+#define ECC_AVX512IFMA __attribute__((target("avx512f,avx512ifma")))
+
+// ADX: MULX leaves the flags alone, ADCX carries only through CF and ADOX
+// only through OF, so one row t += src * rdx adds the low halves of the
+// products on one carry chain and the high halves on another. t is six limbs,
+// t5 taking both chains' final carries; z is zeroed by the XOR that clears
+// the flags and stays zero.
+#define ECC_ADX_MAC_ROW(src)                        \
+    "xorl %k[z], %k[z]\n\t"                         \
+    "mulxq 0(%[" src "]), %[lo], %[hi]\n\t"         \
+    "adcxq %[lo], %[t0]\n\t"                        \
+    "adoxq %[hi], %[t1]\n\t"                        \
+    "mulxq 8(%[" src "]), %[lo], %[hi]\n\t"         \
+    "adcxq %[lo], %[t1]\n\t"                        \
+    "adoxq %[hi], %[t2]\n\t"                        \
+    "mulxq 16(%[" src "]), %[lo], %[hi]\n\t"        \
+    "adcxq %[lo], %[t2]\n\t"                        \
+    "adoxq %[hi], %[t3]\n\t"                        \
+    "mulxq 24(%[" src "]), %[lo], %[hi]\n\t"        \
+    "adcxq %[lo], %[t3]\n\t"                        \
+    "adoxq %[hi], %[t4]\n\t"                        \
+    "adcxq %[z], %[t4]\n\t"                         \
+    "adoxq %[z], %[t5]\n\t"                         \
+    "adcxq %[z], %[t5]\n\t"
+
+// drop the finished low limb: t = t >> 64
+#define ECC_ADX_SHIFT                               \
+    "movq %[t1], %[t0]\n\t"                         \
+    "movq %[t2], %[t1]\n\t"                         \
+    "movq %[t3], %[t2]\n\t"                         \
+    "movq %[t4], %[t3]\n\t"                         \
+    "movq %[t5], %[t4]\n\t"                         \
+    "movq %[z], %[t5]\n\t"
+
+// one CIOS step: t += a * b[i], then t += m * p for the m that clears the low
+// limb, and drop it
+#define ECC_ADX_MONT_STEP(offset)                   \
+    "movq " #offset "(%[b]), %%rdx\n\t"             \
+    ECC_ADX_MAC_ROW("a")                            \
+    "movq %[t0], %%rdx\n\t"                         \
+    "imulq %[n0], %%rdx\n\t"                        \
+    ECC_ADX_MAC_ROW("p")                            \
+    ECC_ADX_SHIFT
+
+#define ECC_ADX_WIDE_ROW(offset)                    \
+    "movq " #offset "(%[b]), %%rdx\n\t"             \
+    ECC_ADX_MAC_ROW("a")                            \
+    "movq %[t0], " #offset "(%[out])\n\t"           \
+    ECC_ADX_SHIFT
+
+ECC_ADX static uint256 adx_montgomery_mul(const uint256& a, const uint256& b, const uint256& p, limb_t n0) {
+    limb_t t0 = 0, t1 = 0, t2 = 0, t3 = 0, t4 = 0, t5 = 0, lo, hi, z;
+    __asm__(
+            ECC_ADX_MONT_STEP(0)
+            ECC_ADX_MONT_STEP(8)
+            ECC_ADX_MONT_STEP(16)
+            ECC_ADX_MONT_STEP(24)
+            : [t0] "+&r"(t0), [t1] "+&r"(t1), [t2] "+&r"(t2), [t3] "+&r"(t3), [t4] "+&r"(t4), [t5] "+&r"(t5),
+              [lo] "=&r"(lo), [hi] "=&r"(hi), [z] "=&r"(z)
+            : [a] "r"(a.limb), [b] "r"(b.limb), [p] "r"(p.limb), [n0] "m"(n0)
+            : "rdx", "cc", "memory");
+
+    // t < 2p, one conditional subtraction brings it below p
+    uint256 out, reduced;
+    out.limb[0] = t0;
+    out.limb[1] = t1;
+    out.limb[2] = t2;
+    out.limb[3] = t3;
+    const limb_t borrow = uint256::sub(reduced, out, p);
+    return uint256::select(0 - (t4 | (borrow ^ 1)), reduced, out);
+}
+
+ECC_ADX static uint512 adx_mul_wide(const uint256& a, const uint256& b) {
+    uint512 out;
+    limb_t t0 = 0, t1 = 0, t2 = 0, t3 = 0, t4 = 0, t5 = 0, lo, hi, z;
+    __asm__(
+            ECC_ADX_WIDE_ROW(0)
+            ECC_ADX_WIDE_ROW(8)
+            ECC_ADX_WIDE_ROW(16)
+            ECC_ADX_WIDE_ROW(24)
+            : [t0] "+&r"(t0), [t1] "+&r"(t1), [t2] "+&r"(t2), [t3] "+&r"(t3), [t4] "+&r"(t4), [t5] "+&r"(t5),
+              [lo] "=&r"(lo), [hi] "=&r"(hi), [z] "=&r"(z)
+            : [a] "r"(a.limb), [b] "r"(b.limb), [out] "r"(out.limb)
+            : "rdx", "cc", "memory");
+    out.limb[4] = t0;
+    out.limb[5] = t1;
+    out.limb[6] = t2;
+    out.limb[7] = t3;
+    return out;
+}
+
+// the first fold, lo + hi * c, as one row; the second is secp256k1_fold_top_p
+ECC_ADX static uint256 adx_secp256k1_reduce_p(const uint512& x) {
+    limb_t t0 = x.limb[0], t1 = x.limb[1], t2 = x.limb[2], t3 = x.limb[3], t4 = 0, lo, hi, z;
+    __asm__(
+            "xorl %k[z], %k[z]\n\t"
+            "mulxq 32(%[x]), %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[t0]\n\t"
+            "adoxq %[hi], %[t1]\n\t"
+            "mulxq 40(%[x]), %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[t1]\n\t"
+            "adoxq %[hi], %[t2]\n\t"
+            "mulxq 48(%[x]), %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[t2]\n\t"
+            "adoxq %[hi], %[t3]\n\t"
+            "mulxq 56(%[x]), %[lo], %[hi]\n\t"
+            "adcxq %[lo], %[t3]\n\t"
+            "adoxq %[hi], %[t4]\n\t"
+            "adcxq %[z], %[t4]\n\t"
+            : [t0] "+&r"(t0), [t1] "+&r"(t1), [t2] "+&r"(t2), [t3] "+&r"(t3), [t4] "+&r"(t4),
+              [lo] "=&r"(lo), [hi] "=&r"(hi), [z] "=&r"(z)
+            : [x] "r"(x.limb), "d"(SECP256K1_FIELD_C)
+            : "cc", "memory");
+    uint256 folded;
+    folded.limb[0] = t0;
+    folded.limb[1] = t1;
+    folded.limb[2] = t2;
+    folded.limb[3] = t3;
+    return secp256k1_fold_top_p(folded, t4);
+}
+
+ECC_ADX static void adx_mul(uint256* out, const uint256* a, const uint256* b, std::size_t n, const uint256& p, limb_t n0) {
+    for (std::size_t i = 0; i < n; i++) {
+        out[i] = adx_montgomery_mul(a[i], b[i], p, n0);
+    }
+}
+
+// AVX2: four elements per register set, register j holding limb j of each.
+// There is no unsigned 64-bit compare, so carries come from a signed compare
+// with the sign bits flipped; carry and borrow masks are all ones or zero.
+
+ECC_AVX2 static inline __m256i less_than(__m256i a, __m256i b) {
+    const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+    return _mm256_cmpgt_epi64(_mm256_xor_si256(b, sign), _mm256_xor_si256(a, sign));
+}
+
+// four uint256s in, limb-major out, and back: a 4x4 transpose of 64-bit words
+ECC_AVX2 static inline void transpose(__m256i* r) {
+    const __m256i t0 = _mm256_unpacklo_epi64(r[0], r[1]);
+    const __m256i t1 = _mm256_unpackhi_epi64(r[0], r[1]);
+    const __m256i t2 = _mm256_unpacklo_epi64(r[2], r[3]);
+    const __m256i t3 = _mm256_unpackhi_epi64(r[2], r[3]);
+    r[0] = _mm256_permute2x128_si256(t0, t2, 0x20);
+    r[1] = _mm256_permute2x128_si256(t1, t3, 0x20);
+    r[2] = _mm256_permute2x128_si256(t0, t2, 0x31);
+    r[3] = _mm256_permute2x128_si256(t1, t3, 0x31);
+}
+
+ECC_AVX2 static inline void load4(__m256i* r, const uint256* x) {
+    for (std::size_t i = 0; i < 4; i++) {
+        r[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x[i].limb));
+    }
+    transpose(r);
+}
+
+ECC_AVX2 static inline void store4(uint256* x, __m256i* r) {
+    transpose(r);
+    for (std::size_t i = 0; i < 4; i++) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(x[i].limb), r[i]);
+    }
+}
+
+// s - p with borrow, keeping s where that borrows out (and nothing carried into s)
+ECC_AVX2 static inline void subtract_p_if_ge(__m256i* s, __m256i carry, const __m256i* p) {
+    __m256i d[4];
+    __m256i borrow = _mm256_setzero_si256();
+    for (std::size_t j = 0; j < 4; j++) {
+        const __m256i t = _mm256_sub_epi64(s[j], p[j]);
+        const __m256i u = _mm256_add_epi64(t, borrow);
+        borrow = _mm256_or_si256(less_than(s[j], p[j]), less_than(t, u));
+        d[j] = u;
+    }
+    const __m256i use = _mm256_or_si256(carry, _mm256_cmpeq_epi64(borrow, _mm256_setzero_si256()));
+    for (std::size_t j = 0; j < 4; j++) {
+        s[j] = _mm256_blendv_epi8(s[j], d[j], use);
+    }
+}
+
+ECC_AVX2 static void avx2_add(uint256* out, const uint256* a, const uint256* b, std::size_t n, const uint256& p) {
+    __m256i P[4];
+    for (std::size_t j = 0; j < 4; j++) {
+        P[j] = _mm256_set1_epi64x(static_cast<long long>(p.limb[j]));
+    }
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i A[4], B[4];
+        load4(A, a + i);
+        load4(B, b + i);
+        __m256i carry = _mm256_setzero_si256();
+        for (std::size_t j = 0; j < 4; j++) {
+            const __m256i t = _mm256_add_epi64(A[j], B[j]);
+            const __m256i u = _mm256_sub_epi64(t, carry);
+            carry = _mm256_or_si256(less_than(t, A[j]), less_than(u, t));
+            A[j] = u;
+        }
+        subtract_p_if_ge(A, carry, P);
+        store4(out + i, A);
+    }
+    for (; i < n; i++) {
+        out[i] = montgomery_add(a[i], b[i], p);
+    }
+}
+
+ECC_AVX2 static void avx2_sub(uint256* out, const uint256* a, const uint256* b, std::size_t n, const uint256& p) {
+    __m256i P[4];
+    for (std::size_t j = 0; j < 4; j++) {
+        P[j] = _mm256_set1_epi64x(static_cast<long long>(p.limb[j]));
+    }
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i A[4], B[4];
+        load4(A, a + i);
+        load4(B, b + i);
+        __m256i borrow = _mm256_setzero_si256();
+        for (std::size_t j = 0; j < 4; j++) {
+            const __m256i t = _mm256_sub_epi64(A[j], B[j]);
+            const __m256i u = _mm256_add_epi64(t, borrow);
+            borrow = _mm256_or_si256(less_than(A[j], B[j]), less_than(t, u));
+            A[j] = u;
+        }
+        // add p back in the lanes that went negative
+        __m256i carry = _mm256_setzero_si256();
+        for (std::size_t j = 0; j < 4; j++) {
+            const __m256i addend = _mm256_and_si256(P[j], borrow);
+            const __m256i t = _mm256_add_epi64(A[j], addend);
+            const __m256i u = _mm256_sub_epi64(t, carry);
+            carry = _mm256_or_si256(less_than(t, A[j]), less_than(u, t));
+            A[j] = u;
+        }
+        store4(out + i, A);
+    }
+    for (; i < n; i++) {
+        out[i] = montgomery_sub(a[i], b[i], p);
+    }
+}
+
+// AVX-512 IFMA: eight elements per register set in radix 2^52, five limbs each.
+// VPMADD52LUQ/HUQ add the low and high 52 bits of a 52x52-bit product to a
+// 64-bit lane, so the CIOS accumulators have 12 bits of headroom and carries
+// are only propagated once at the end.
+
+static constexpr uint64_t MASK52 = (uint64_t(1) << 52) - 1;
+
+static inline void to_radix52(const uint256& x, uint64_t* l) {
+    l[0] = x.limb[0] & MASK52;
+    l[1] = ((x.limb[0] >> 52) | (x.limb[1] << 12)) & MASK52;
+    l[2] = ((x.limb[1] >> 40) | (x.limb[2] << 24)) & MASK52;
+    l[3] = ((x.limb[2] >> 28) | (x.limb[3] << 36)) & MASK52;
+    l[4] = x.limb[3] >> 16;
+}
+
+static inline uint256 from_radix52(const uint64_t* l) {
+    uint256 x;
+    x.limb[0] = l[0] | (l[1] << 52);
+    x.limb[1] = (l[1] >> 12) | (l[2] << 40);
+    x.limb[2] = (l[2] >> 24) | (l[3] << 28);
+    x.limb[3] = (l[3] >> 36) | (l[4] << 16);
+    return x;
+}
+
+ECC_AVX512IFMA static inline void normalize52(__m512i* t) {
+    const __m512i mask = _mm512_set1_epi64(MASK52);
+    for (std::size_t j = 0; j < 4; j++) {
+        t[j + 1] = _mm512_add_epi64(t[j + 1], _mm512_srli_epi64(t[j], 52));
+        t[j] = _mm512_and_si512(t[j], mask);
+    }
+}
+
+// t - p in the lanes where that does not borrow, for normalized t < 2p
+ECC_AVX512IFMA static inline void subtract_p_if_ge52(__m512i* t, const __m512i* p) {
+    const __m512i mask = _mm512_set1_epi64(MASK52);
+    __m512i d[5];
+    __m512i borrow = _mm512_setzero_si512();
+    for (std::size_t j = 0; j < 5; j++) {
+        const __m512i x = _mm512_sub_epi64(_mm512_sub_epi64(t[j], p[j]), borrow);
+        borrow = _mm512_srli_epi64(x, 63);
+        d[j] = _mm512_and_si512(x, mask);
+    }
+    const __mmask8 keep = _mm512_cmpeq_epi64_mask(borrow, _mm512_setzero_si512());
+    for (std::size_t j = 0; j < 5; j++) {
+        t[j] = _mm512_mask_blend_epi64(keep, t[j], d[j]);
+    }
+}
+
+// eight products a * b / 2^256 mod p
+ECC_AVX512IFMA static void ifma_mul8(uint256* out, const uint256* a, const uint256* b, const __m512i* P, __m512i n0) {
+    alignas(64) uint64_t A[5][8];
+    alignas(64) uint64_t B[5][8];
+    for (std::size_t lane = 0; lane < 8; lane++) {
+        uint64_t l[5];
+        to_radix52(a[lane], l);
+        for (std::size_t j = 0; j < 5; j++) {
+            A[j][lane] = l[j];
+        }
+        to_radix52(b[lane], l);
+        for (std::size_t j = 0; j < 5; j++) {
+            B[j][lane] = l[j];
+        }
+    }
+
+    const __m512i zero = _mm512_setzero_si512();
+    __m512i av[5];
+    for (std::size_t j = 0; j < 5; j++) {
+        av[j] = _mm512_load_si512(A[j]);
+    }
+    __m512i t[6] = {zero, zero, zero, zero, zero, zero};
+    for (std::size_t i = 0; i < 5; i++) {
+        const __m512i bi = _mm512_load_si512(B[i]);
+        for (std::size_t j = 0; j < 5; j++) {
+            t[j] = _mm512_madd52lo_epu64(t[j], av[j], bi);
+            t[j + 1] = _mm512_madd52hi_epu64(t[j + 1], av[j], bi);
+        }
+        // only the low 52 bits of t[0] matter for m, and the multiply only reads those
+        const __m512i m = _mm512_madd52lo_epu64(zero, t[0], n0);
+        for (std::size_t j = 0; j < 5; j++) {
+            t[j] = _mm512_madd52lo_epu64(t[j], m, P[j]);
+            t[j + 1] = _mm512_madd52hi_epu64(t[j + 1], m, P[j]);
+        }
+        t[0] = _mm512_add_epi64(t[1], _mm512_srli_epi64(t[0], 52));
+        for (std::size_t j = 1; j < 5; j++) {
+            t[j] = t[j + 1];
+        }
+        t[5] = zero;
+    }
+    normalize52(t);
+    subtract_p_if_ge52(t, P);
+
+    // five 52-bit rounds divided by 2^260; four doublings bring that back to 2^256
+    for (std::size_t k = 0; k < 4; k++) {
+        for (std::size_t j = 0; j < 5; j++) {
+            t[j] = _mm512_slli_epi64(t[j], 1);
+        }
+        normalize52(t);
+        subtract_p_if_ge52(t, P);
+    }
+
+    for (std::size_t j = 0; j < 5; j++) {
+        _mm512_store_si512(A[j], t[j]);
+    }
+    for (std::size_t lane = 0; lane < 8; lane++) {
+        uint64_t l[5];
+        for (std::size_t j = 0; j < 5; j++) {
+            l[j] = A[j][lane];
+        }
+        out[lane] = from_radix52(l);
+    }
+}
+
+ECC_AVX512IFMA static void ifma_mul(uint256* out, const uint256* a, const uint256* b, std::size_t n, const uint256& p, limb_t n0) {
+    uint64_t pl[5];
+    to_radix52(p, pl);
+    __m512i P[5];
+    for (std::size_t j = 0; j < 5; j++) {
+        P[j] = _mm512_set1_epi64(static_cast<long long>(pl[j]));
+    }
+    // -p^-1 mod 2^52 is the low 52 bits of -p^-1 mod 2^64
+    const __m512i n52 = _mm512_set1_epi64(static_cast<long long>(n0 & MASK52));
+
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        ifma_mul8(out + i, a + i, b + i, P, n52);
+    }
+    if (i < n) {
+        // zero is a valid operand, so the tail runs as one padded batch
+        uint256 ta[8], tb[8], to[8];
+        for (std::size_t k = 0; k < n - i; k++) {
+            ta[k] = a[i + k];
+            tb[k] = b[i + k];
+        }
+        ifma_mul8(to, ta, tb, P, n52);
+        for (std::size_t k = 0; k < n - i; k++) {
+            out[i + k] = to[k];
+        }
+    }
+}
+
+const FieldKernels* adx_field_kernels() {
+    static const FieldKernels kernels = []() {
+        FieldKernels k = portable_field_kernels();
+        k.name = "adx";
+        k.montgomery_mul = adx_montgomery_mul;
+        k.mul_wide = adx_mul_wide;
+        k.secp256k1_reduce_p = adx_secp256k1_reduce_p;
+        k.mul = adx_mul;
+        return k;
+    }();
+    return __builtin_cpu_supports("bmi2") && __builtin_cpu_supports("adx") ? &kernels : nullptr;
+}
+
+const FieldKernels* avx2_field_kernels() {
+    if (!__builtin_cpu_supports("avx2")) {
+        return nullptr;
+    }
+    static const FieldKernels kernels = []() {
+        const FieldKernels* adx = adx_field_kernels();
+        FieldKernels k = adx ? *adx : portable_field_kernels();
+        k.name = "avx2";
+        k.add = avx2_add;
+        k.sub = avx2_sub;
+        return k;
+    }();
+    return &kernels;
+}
+
+const FieldKernels* avx512ifma_field_kernels() {
+    if (!__builtin_cpu_supports("avx512f") || !__builtin_cpu_supports("avx512ifma")) {
+        return nullptr;
+    }
+    static const FieldKernels kernels = []() {
+        const FieldKernels* avx2 = avx2_field_kernels();
+        FieldKernels k = avx2 ? *avx2 : portable_field_kernels();
+        k.name = "avx512ifma";
+        k.mul = ifma_mul;
+        return k;
+    }();
+    return &kernels;
+}
+
+#else
+
+const FieldKernels* adx_field_kernels() {
+    return nullptr;
+}
+
+const FieldKernels* avx2_field_kernels() {
+    return nullptr;
+}
+
+const FieldKernels* avx512ifma_field_kernels() {
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,439 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "chacha20.h"
+#include "FieldVector.h"
+#include "modexp.h"
+
+namespace {
+
+// elements processed per pass: the partial results of a pass stay on the stack
+// and every inner loop runs over one limb position of all of them
+constexpr std::size_t BLOCK = 64;
+
+// r = a + b mod p on elements [0, lanes) of SoA arrays with the given stride;
+// r may be a
+template <std::size_t L>
+void add_block(limb_t* r, const limb_t* a, const limb_t* b, std::size_t stride, std::size_t lanes, const limb_t* p) {
+    limb_t sum[L][BLOCK], carry[BLOCK], borrow[BLOCK];
+    std::fill(carry, carry + lanes, 0);
+    for (std::size_t j = 0; j < L; j++) {
+        const limb_t* x = a + j * stride;
+        const limb_t* y = b + j * stride;
+        for (std::size_t i = 0; i < lanes; i++) {
+            const limb_t s = x[i] + y[i];
+            const limb_t t = s + carry[i];
+            carry[i] = (s < x[i]) | (t < s);
+            sum[j][i] = t;
+        }
+    }
+
+    // subtract p once when the sum carried out or is at least p
+    std::fill(borrow, borrow + lanes, 0);
+    limb_t diff[L][BLOCK];
+    for (std::size_t j = 0; j < L; j++) {
+        for (std::size_t i = 0; i < lanes; i++) {
+            const limb_t d = sum[j][i] - p[j];
+            const limb_t t = d - borrow[i];
+            borrow[i] = (sum[j][i] < p[j]) | (d < borrow[i]);
+            diff[j][i] = t;
+        }
+    }
+    for (std::size_t i = 0; i < lanes; i++) {
+        borrow[i] = 0 - (carry[i] | (borrow[i] ^ 1));      // all ones to keep the difference
+    }
+    for (std::size_t j = 0; j < L; j++) {
+        limb_t* out = r + j * stride;
+        for (std::size_t i = 0; i < lanes; i++) {
+            out[i] = (diff[j][i] & borrow[i]) | (sum[j][i] & ~borrow[i]);
+        }
+    }
+}
+
+// r = a - b mod p, the same way: add p back where the subtraction borrowed
+template <std::size_t L>
+void sub_block(limb_t* r, const limb_t* a, const limb_t* b, std::size_t stride, std::size_t lanes, const limb_t* p) {
+    limb_t diff[L][BLOCK], borrow[BLOCK], carry[BLOCK];
+    std::fill(borrow, borrow + lanes, 0);
+    for (std::size_t j = 0; j < L; j++) {
+        const limb_t* x = a + j * stride;
+        const limb_t* y = b + j * stride;
+        for (std::size_t i = 0; i < lanes; i++) {
+            const limb_t d = x[i] - y[i];
+            const limb_t t = d - borrow[i];
+            borrow[i] = (x[i] < y[i]) | (d < borrow[i]);
+            diff[j][i] = t;
+        }
+    }
+
+    std::fill(carry, carry + lanes, 0);
+    for (std::size_t j = 0; j < L; j++) {
+        limb_t* out = r + j * stride;
+        for (std::size_t i = 0; i < lanes; i++) {
+            const limb_t s = diff[j][i] + (p[j] & (0 - borrow[i]));
+            const limb_t t = s + carry[i];
+            carry[i] = (s < diff[j][i]) | (t < s);
+            out[i] = t;
+        }
+    }
+}
+
+typedef void (*block_fn)(limb_t*, const limb_t*, const limb_t*, std::size_t, std::size_t, const limb_t*);
+// by the number of limbs, 1 to 4
+const block_fn ADD[4] = {add_block<1>, add_block<2>, add_block<3>, add_block<4>};
+const block_fn SUB[4] = {sub_block<1>, sub_block<2>, sub_block<3>, sub_block<4>};
+
+// runs kernel over all count elements, a block at a time
+void for_blocks(block_fn kernel, limb_t* r, const limb_t* a, const limb_t* b, std::size_t count, const limb_t* p) {
+    for (std::size_t first = 0; first < count; first += BLOCK) {
+        kernel(r + first, a + first, b + first, count, std::min(BLOCK, count - first), p);
+    }
+}
+
+// one step of a shared exponentiation: square the running powers squarings
+// times, then multiply each by its base's odd power digit, unless digit is 0
+struct PowStep {
+    std::size_t squarings;
+    unsigned digit;
+};
+
+// the windows of e > 0 from the top, as sliding_window_pow takes them: each
+// starts and ends on a set bit and is at most w bits long
+std::vector<PowStep> pow_schedule(const integer& e, std::size_t w) {
+    std::vector<PowStep> steps;
+    std::size_t pending = 0;
+    for (std::size_t i = e.bit_length(); i > 0;) {
+        if (!e[i - 1]) {
+            pending++;
+            i--;
+            continue;
+        }
+        std::size_t low = i > w ? i - w : 0;
+        while (!e[low]) {
+            low++;
+        }
+        unsigned digit = 0;
+        for (std::size_t b = i; b > low; b--) {
+            digit = (digit << 1) | static_cast<unsigned>(e[b - 1]);
+        }
+        steps.push_back(PowStep{pending + (i - low), digit});
+        pending = 0;
+        i = low;
+    }
+    if (pending) {
+        steps.push_back(PowStep{pending, 0});
+    }
+    return steps;
+}
+
+// x[i] = x[i]^e for lanes values, e given by its schedule and window width;
+// every step runs across all lanes before the next one starts
+template <typename Mul, typename Sqr>
+void pow_lanes(uint256* x, std::size_t lanes, const std::vector<PowStep>& steps, std::size_t w, Mul mul, Sqr sqr) {
+    // odd[t * lanes + i] = x[i]^(2t + 1)
+    const std::size_t half = std::size_t(1) << (w - 1);
+    std::vector<uint256> odd(half * lanes);
+    uint256 x2[BLOCK];
+    for (std::size_t i = 0; i < lanes; i++) {
+        odd[i] = x[i];
+        x2[i] = sqr(x[i]);
+    }
+    for (std::size_t t = 1; t < half; t++) {
+        for (std::size_t i = 0; i < lanes; i++) {
+            odd[t * lanes + i] = mul(odd[(t - 1) * lanes + i], x2[i]);
+        }
+    }
+
+    // the first window starts the powers, its squarings being of one
+    for (std::size_t i = 0; i < lanes; i++) {
+        x[i] = odd[(steps[0].digit >> 1) * lanes + i];
+    }
+    for (std::size_t k = 1; k < steps.size(); k++) {
+        for (std::size_t s = 0; s < steps[k].squarings; s++) {
+            for (std::size_t i = 0; i < lanes; i++) {
+                x[i] = sqr(x[i]);
+            }
+        }
+        if (steps[k].digit) {
+            const uint256* power = odd.data() + (steps[k].digit >> 1) * lanes;
+            for (std::size_t i = 0; i < lanes; i++) {
+                x[i] = mul(x[i], power[i]);
+            }
+        }
+    }
+}
+
+}
+
+FieldVector::FieldVector(const PrimeField& field, std::size_t count)
+        : field(&field), count(count), width((field.bits() + 63) / 64),
+          zero(0, field) {
+    if (!field.fixed()) {
+        throw std::invalid_argument("FieldVector needs a prime of at most 256 bits");
+    }
+    this->limbs.assign(this->width * count, 0);
+}
+
+FieldVector::FieldVector(const PrimeField& field, const std::vector<FieldElement>& elements)
+        : FieldVector(field, elements.size()) {
+    for (std::size_t i = 0; i < elements.size(); i++) {
+        set(i, elements[i]);
+    }
+}
+
+FieldVector FieldVector::random(const PrimeField& field, std::size_t count, ChaCha20Rng& rng) {
+    FieldVector out(field, count);
+    const uint256& p = field.fixed_prime();
+    const std::size_t top = field.bits() % 64;
+    const limb_t mask = top ? (limb_t(1) << top) - 1 : ~limb_t(0);
+    for (std::size_t i = 0; i < count; i++) {
+        uint256 v(0);
+        do {
+            rng.fill(reinterpret_cast<uint8_t*>(v.limb), out.width * sizeof(limb_t));
+            v.limb[out.width - 1] &= mask;
+        } while (!(v < p));
+        out.store(i, v);
+    }
+    return out;
+}
+
+FieldElement FieldVector::get(std::size_t i) const {
+    return this->zero.fixed_result(load(i));
+}
+
+void FieldVector::set(std::size_t i, const FieldElement& value) {
+    this->zero.check_field(value, "Cannot store a number from a different field");
+    store(i, this->zero.operand(value));
+}
+
+std::vector<FieldElement> FieldVector::elements() const {
+    std::vector<FieldElement> out;
+    out.reserve(this->count);
+    for (std::size_t i = 0; i < this->count; i++) {
+        out.push_back(get(i));
+    }
+    return out;
+}
+
+FieldVector& FieldVector::operator+=(const FieldVector& other) {
+    check(other);
+    for_blocks(ADD[this->width - 1], this->limbs.data(), this->limbs.data(), other.limbs.data(),
+               this->count, this->field->fixed_prime().limb);
+    return *this;
+}
+
+FieldVector& FieldVector::operator-=(const FieldVector& other) {
+    check(other);
+    for_blocks(SUB[this->width - 1], this->limbs.data(), this->limbs.data(), other.limbs.data(),
+               this->count, this->field->fixed_prime().limb);
+    return *this;
+}
+
+FieldVector& FieldVector::operator*=(const FieldVector& other) {
+    check(other);
+    for (std::size_t i = 0; i < this->count; i++) {
+        store(i, this->zero.fixed_mul(load(i), other.load(i)));
+    }
+    return *this;
+}
+
+FieldVector FieldVector::square() const {
+    FieldVector out = *this;
+    for (std::size_t i = 0; i < this->count; i++) {
+        out.store(i, this->zero.fixed_sqr(load(i)));
+    }
+    return out;
+}
+
+FieldVector FieldVector::select(const std::vector<limb_t>& masks, const FieldVector& a, const FieldVector& b) {
+    a.check(b);
+    if (masks.size() != a.count) {
+        throw std::invalid_argument("Vectors must have the same size");
+    }
+    FieldVector out = b;
+    for (std::size_t j = 0; j < a.width; j++) {
+        const limb_t* x = a.limbs.data() + j * a.count;
+        limb_t* y = out.limbs.data() + j * a.count;
+        for (std::size_t i = 0; i < a.count; i++) {
+            y[i] ^= (x[i] ^ y[i]) & masks[i];
+        }
+    }
+    return out;
+}
+
+FieldVector FieldVector::pow(const integer& e, unsigned threads) const {
+    ThreadExecutor executor(threads);
+    return pow(e, executor);
+}
+
+FieldVector FieldVector::pow(const integer& e, Executor& executor) const {
+    const PrimeField& f = *this->field;
+    integer n = e % f.prime_minus_one();
+    if (n < 0) {
+        n += f.prime_minus_one();
+    }
+    FieldVector out(f, this->count);
+    if (n == 0) {
+        for (std::size_t i = 0; i < this->count; i++) {
+            out.store(i, uint256(1));
+        }
+        return out;
+    }
+
+    const PrimeField::chain chain = f.addition_chain();
+    const bool root = chain != PrimeField::chain::none && n == f.sqrt_exponent();
+    const bool by_chain = root || (chain != PrimeField::chain::none && n == f.prime_minus_two());
+    const std::size_t w = exp_window_width(n.bit_length());
+    const std::vector<PowStep> steps = by_chain ? std::vector<PowStep>() : pow_schedule(n, w);
+    // the plain kernels fall back to Barrett through integer for other primes
+    const MontgomeryContext* mont = f.word() || f.fold() || f.pseudo_mersenne() ? nullptr : f.montgomery();
+
+    const std::size_t blocks = (this->count + BLOCK - 1) / BLOCK;
+    const std::size_t chunks = std::min<std::size_t>(std::max<std::size_t>(executor.concurrency(), 1), blocks);
+    executor.run(chunks, [&](std::size_t c) {
+        uint256 x[BLOCK];
+        for (std::size_t b = blocks * c / chunks; b < blocks * (c + 1) / chunks; b++) {
+            const std::size_t first = b * BLOCK;
+            const std::size_t lanes = std::min(BLOCK, this->count - first);
+            for (std::size_t i = 0; i < lanes; i++) {
+                x[i] = load(first + i);
+            }
+            if (by_chain) {
+                for (std::size_t i = 0; i < lanes; i++) {
+                    x[i] = this->zero.fixed_result(x[i]).chain_exp(chain, root);
+                }
+            } else if (mont) {
+                for (std::size_t i = 0; i < lanes; i++) {
+                    x[i] = mont->to_montgomery(x[i]);
+                }
+                pow_lanes(x, lanes, steps, w,
+                        [mont](const uint256& a, const uint256& b) { return mont->mul(a, b); },
+                        [mont](const uint256& a) { return mont->sqr(a); });
+                for (std::size_t i = 0; i < lanes; i++) {
+                    x[i] = mont->from_montgomery(x[i]);
+                }
+            } else {
+                pow_lanes(x, lanes, steps, w,
+                        [this](const uint256& a, const uint256& b) { return this->zero.fixed_mul(a, b); },
+                        [this](const uint256& a) { return this->zero.fixed_sqr(a); });
+            }
+            for (std::size_t i = 0; i < lanes; i++) {
+                out.store(first + i, x[i]);
+            }
+        }
+    });
+    return out;
+}
+
+FieldVector FieldVector::inverse() const {
+    FieldVector out = *this;
+    if (this->count == 0) {
+        return out;
+    }
+
+    // prefix[i] = element 0 * ... * element i
+    std::vector<uint256> prefix(this->count);
+    prefix[0] = load(0);
+    for (std::size_t i = 1; i < this->count; i++) {
+        prefix[i] = this->zero.fixed_mul(prefix[i - 1], load(i));
+    }
+
+    uint256 inv = (this->zero.one() / this->zero.fixed_result(prefix.back())).fnum;
+    for (std::size_t i = this->count - 1; i > 0; i--) {
+        out.store(i, this->zero.fixed_mul(inv, prefix[i - 1]));
+        inv = this->zero.fixed_mul(inv, load(i));
+    }
+    out.store(0, inv);
+    return out;
+}
+
+std::vector<std::size_t> FieldVector::zeros() const {
+    std::vector<std::size_t> out;
+    for (std::size_t i = 0; i < this->count; i++) {
+        limb_t any = 0;
+        for (std::size_t j = 0; j < this->width; j++) {
+            any |= this->limbs[j * this->count + i];
+        }
+        if (!any) {
+            out.push_back(i);
+        }
+    }
+    return out;
+}
+
+FieldVector FieldVector::gather(const std::vector<std::size_t>& index) const {
+    check_index(index);
+    FieldVector out(*this->field, index.size());
+    for (std::size_t j = 0; j < this->width; j++) {
+        const limb_t* from = this->limbs.data() + j * this->count;
+        limb_t* to = out.limbs.data() + j * out.count;
+        for (std::size_t i = 0; i < index.size(); i++) {
+            to[i] = from[index[i]];
+        }
+    }
+    return out;
+}
+
+void FieldVector::scatter(const std::vector<std::size_t>& index, const FieldVector& values) {
+    if (this->field != values.field) {
+        throw std::runtime_error("Cannot combine vectors in different fields");
+    }
+    if (index.size() != values.count) {
+        throw std::invalid_argument("Need one index per value");
+    }
+    check_index(index);
+    for (std::size_t j = 0; j < this->width; j++) {
+        const limb_t* from = values.limbs.data() + j * values.count;
+        limb_t* to = this->limbs.data() + j * this->count;
+        for (std::size_t i = 0; i < index.size(); i++) {
+            to[index[i]] = from[i];
+        }
+    }
+}
+
+bool operator==(const FieldVector& lhs, const FieldVector& rhs) {
+    return lhs.field == rhs.field && lhs.limbs == rhs.limbs;
+}
+
+std::ostream& operator<<(std::ostream& os, const FieldVector& v) {
+    os << "FieldVector_" << v.field->prime() << "(";
+    for (std::size_t i = 0; i < v.count; i++) {
+        os << (i ? ", " : "") << v.load(i).to_integer();
+    }
+    return os << ")";
+}
+
+void FieldVector::check(const FieldVector& other) const {
+    if (this->field != other.field) {
+        throw std::runtime_error("Cannot combine vectors in different fields");
+    }
+    if (this->count != other.count) {
+        throw std::invalid_argument("Vectors must have the same size");
+    }
+}
+
+void FieldVector::check_index(const std::vector<std::size_t>& index) const {
+    for (std::size_t i : index) {
+        if (i >= this->count) {
+            throw std::out_of_range("Index past the end of the vector");
+        }
+    }
+}
+
+uint256 FieldVector::load(std::size_t i) const {
+    uint256 out(0);
+    for (std::size_t j = 0; j < this->width; j++) {
+        out.limb[j] = this->limbs[j * this->count + i];
+    }
+    return out;
+}
+
+void FieldVector::store(std::size_t i, const uint256& v) {
+    for (std::size_t j = 0; j < this->width; j++) {
+        this->limbs[j * this->count + i] = v.limb[j];
+    }
+}
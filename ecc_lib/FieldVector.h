@@ -0,0 +1,99 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_FIELDVECTOR_H
+#define ECC_FIELDVECTOR_H
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+#include "Executor.h"
+#include "FieldElement.h"
+#include "limb.h"
+#include "PrimeField.h"
+#include "uint256.h"
+
+class ChaCha20Rng;
+
+// A fixed number of elements of one prime field, stored structure-of-arrays:
+// limb j of every element is contiguous, so the element-wise additions and
+// subtractions run across elements with no carry chain between neighbours and
+// compile to vector code. Products still need a 64x64 -> 128 bit multiply per
+// limb pair, which has no vector form on common targets, so they go through the
+// scalar field kernels one element at a time, without building FieldElements.
+// Only primes of at most 256 bits; elements are kept in the plain (not
+// Montgomery) representation.
+class FieldVector {
+public:
+    // count zeros; throws std::invalid_argument for primes above 256 bits
+    FieldVector(const PrimeField& field, std::size_t count);
+    // elements must all belong to field
+    FieldVector(const PrimeField& field, const std::vector<FieldElement>& elements);
+    // count elements uniform in [0, p): the limbs of each straight from rng,
+    // the top one masked to the prime's bits, drawn again while not below p
+    static FieldVector random(const PrimeField& field, std::size_t count, ChaCha20Rng& rng);
+
+    std::size_t size() const { return this->count; }
+    const PrimeField& prime_field() const { return *this->field; }
+
+    // scalar access; get returns a plain element, set takes either representation
+    FieldElement get(std::size_t i) const;
+    void set(std::size_t i, const FieldElement& value);
+    std::vector<FieldElement> elements() const;
+
+    // element-wise; both vectors must have the same field and size
+    FieldVector& operator+=(const FieldVector& other);
+    FieldVector& operator-=(const FieldVector& other);
+    FieldVector& operator*=(const FieldVector& other);
+    friend FieldVector operator+(FieldVector lhs, const FieldVector& rhs) { return lhs += rhs; }
+    friend FieldVector operator-(FieldVector lhs, const FieldVector& rhs) { return lhs -= rhs; }
+    friend FieldVector operator*(FieldVector lhs, const FieldVector& rhs) { return lhs *= rhs; }
+    FieldVector square() const;
+    // element i of a where masks[i] is all ones and of b where it is zero,
+    // without a branch on the masks; a and b as for the operators, one mask an element
+    static FieldVector select(const std::vector<limb_t>& masks, const FieldVector& a, const FieldVector& b);
+    // every element to the power e, as FieldElement::power does: e is reduced
+    // mod p - 1 and recoded into sliding windows once, and the resulting
+    // schedule of squarings and multiplications by odd powers runs over a
+    // block of elements at a time, each step across the whole block, so the
+    // independent products overlap. The addition chains of the secp256k1 and
+    // P-256 primes are taken for p - 2 and the square root exponent; primes
+    // with no special-form reduction work in Montgomery form, converted once
+    // each way. The executor overload spreads the blocks over its threads
+    FieldVector pow(const integer& e, unsigned threads = 1) const;
+    FieldVector pow(const integer& e, Executor& executor) const;
+    // every element inverted with a single field inversion (Montgomery's trick);
+    // throws std::domain_error if any element is zero
+    FieldVector inverse() const;
+    // the positions of the elements that are zero, in order
+    std::vector<std::size_t> zeros() const;
+
+    // element i is element index[i] of this vector, for index.size()
+    // elements; both throw std::out_of_range for an index past the end
+    FieldVector gather(const std::vector<std::size_t>& index) const;
+    // element index[i] of this vector becomes element i of values, which
+    // must have the same field and index.size() elements
+    void scatter(const std::vector<std::size_t>& index, const FieldVector& values);
+
+    friend bool operator==(const FieldVector& lhs, const FieldVector& rhs);
+    friend bool operator!=(const FieldVector& lhs, const FieldVector& rhs) { return !(lhs == rhs); }
+    friend std::ostream& operator<<(std::ostream& os, const FieldVector& v);
+
+private:
+    const PrimeField* field;
+    std::size_t count;
+    std::size_t width;              // limbs per element, enough for the prime
+    std::vector<limb_t> limbs;      // limb j of element i at limbs[j * count + i]
+    // zero of the field, whose fixed-width arithmetic the products go through
+    FieldElement zero;
+
+    void check(const FieldVector& other) const;
+    // throws std::out_of_range for an index past the end
+    void check_index(const std::vector<std::size_t>& index) const;
+    uint256 load(std::size_t i) const;
+    void store(std::size_t i, const uint256& v);
+};
+
+#endif //ECC_FIELDVECTOR_H
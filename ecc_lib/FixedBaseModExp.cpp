@@ -0,0 +1,82 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <stdexcept>
+
+#include "FixedBaseModExp.h"
+
+namespace {
+
+void check_exponent(const integer& e, std::size_t bits) {
+    if (e < 0 || e.bit_length() > bits) {
+        throw std::invalid_argument("exponent out of the fixed-base table's range");
+    }
+}
+
+}
+
+FixedBaseModExp::FixedBaseModExp(const integer& base, const integer& modulus, std::size_t bits, std::size_t w)
+        : reducer(modulus), w(w) {
+    if (w < 1 || w > 8) {
+        throw std::invalid_argument("fixed-base window must be 1 to 8 bits");
+    }
+    this->g = this->reducer.reduce(base);
+    this->max_bits = bits ? bits : modulus.bit_length();
+    this->rows = (this->max_bits + w - 1) / w;
+
+    // row i from its base b = g^(2^(w i)) by multiplying up the digits; the
+    // next row's base is b^(2^w - 1) * b
+    const std::size_t digits = (std::size_t(1) << w) - 1;
+    this->table.reserve(this->rows * digits);
+    integer b = this->g;
+    for (std::size_t i = 0; i < this->rows; i++) {
+        this->table.push_back(b);
+        for (std::size_t d = 1; d < digits; d++) {
+            this->table.push_back(this->reducer.mul(this->table.back(), b));
+        }
+        if (i + 1 < this->rows) {
+            b = this->reducer.mul(this->table.back(), b);
+        }
+    }
+}
+
+integer FixedBaseModExp::pow(const integer& e) const {
+    check_exponent(e, this->max_bits);
+    const std::size_t digits = (std::size_t(1) << this->w) - 1;
+    integer result = this->reducer.reduce(1);
+    bool started = false;
+    for (std::size_t i = 0; i < this->rows; i++) {
+        const std::size_t d = e.extract_bits(this->w * i, this->w);
+        if (!d) {
+            continue;
+        }
+        const integer& power = this->table[i * digits + d - 1];
+        if (started) {
+            result = this->reducer.mul(result, power);
+        } else {
+            result = power;
+            started = true;
+        }
+    }
+    return result;
+}
+
+std::vector<integer> FixedBaseModExp::pow(const std::vector<integer>& exponents, Executor& executor) const {
+    // checked here, not in the tasks, so a bad exponent throws on this thread
+    for (const integer& e : exponents) {
+        check_exponent(e, this->max_bits);
+    }
+    const std::size_t count = exponents.size();
+    std::vector<integer> out(count);
+    if (!count) {
+        return out;
+    }
+    const std::size_t chunks = std::min<std::size_t>(std::max<std::size_t>(executor.concurrency(), 1), count);
+    executor.run(chunks, [this, &out, &exponents, count, chunks](std::size_t c) {
+        for (std::size_t i = count * c / chunks; i < count * (c + 1) / chunks; i++) {
+            out[i] = pow(exponents[i]);
+        }
+    });
+    return out;
+}
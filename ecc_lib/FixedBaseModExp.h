@@ -0,0 +1,56 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_FIXEDBASEMODEXP_H
+#define ECC_FIXEDBASEMODEXP_H
+
+#include <cstddef>
+#include <vector>
+
+#include "BarrettReducer.h"
+#include "Executor.h"
+#include "integer.h"
+
+// Precomputed powers of one base mod one modulus, for the g^e mod p of DSA
+// and Diffie-Hellman over Z_p^* with many e, as FixedBaseTable is for k * G:
+// the exponent is cut into windows of w bits and window i selects
+// g^(d 2^(w i)), d < 2^w, from row i of the table, so a power is one
+// multiplication mod p per window and no squarings. For a 2048-bit exponent
+// and w = 4 that is 512 multiplications against the 2048 squarings and ~340
+// multiplications of sliding_window_pow; the table keeps bits / w rows of
+// 2^w - 1 residues, 1.9 MiB for a 2048-bit p. Products are reduced by one
+// BarrettReducer of p, which beats the RNS Montgomery product at these sizes
+// and leaves entries in ordinary form, so p may be even. Build once and
+// share; pow is const. Not constant time.
+class FixedBaseModExp {
+public:
+    // powers of base mod modulus for exponents below 2^bits (the bits of
+    // modulus when 0), windows of w bits (1 to 8). Throws
+    // std::invalid_argument for a modulus below 1 or w out of range
+    FixedBaseModExp(const integer& base, const integer& modulus, std::size_t bits = 0, std::size_t w = 4);
+
+    // base^e mod modulus for 0 <= e < 2^bits; throws std::invalid_argument
+    // for other e
+    integer pow(const integer& e) const;
+    // pow of every exponent, cut over executor's tasks
+    std::vector<integer> pow(const std::vector<integer>& exponents, Executor& executor) const;
+
+    const integer& base() const { return this->g; }
+    const integer& modulus() const { return this->reducer.modulus(); }
+    std::size_t bits() const { return this->max_bits; }
+    std::size_t window() const { return this->w; }
+    // number of stored powers
+    std::size_t size() const { return this->table.size(); }
+
+private:
+    BarrettReducer reducer;
+    integer g;                      // reduced
+    std::size_t w;
+    std::size_t rows;
+    std::size_t max_bits;
+    // row i, digit d > 0 at i * (2^w - 1) + d - 1
+    std::vector<integer> table;
+};
+
+#endif //ECC_FIXEDBASEMODEXP_H
@@ -0,0 +1,326 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "complete.h"
+#include "FixedBaseTable.h"
+#include "huge_pages.h"
+
+// "ECCFBT" in the low bytes, so files in the other byte order fail to load
+static constexpr limb_t MAGIC = 0x0000544246434345;
+// magic, version, flags, width, w, bits
+static constexpr std::size_t HEADER_WORDS = 6;
+// then the prime, a, b and the base point's x and y in plain form, width limbs each
+static constexpr std::size_t HEADER_VALUES = 5;
+// header flag: the coordinates are in Montgomery form
+static constexpr limb_t FLAG_MONTGOMERY = 1;
+
+// words limbs for owned entries, on huge pages for tables large enough
+static std::shared_ptr<limb_t> allocate_entries(std::size_t words) {
+    const PageBlock block = page_allocate(words * sizeof(limb_t));
+    return std::shared_ptr<limb_t>(static_cast<limb_t*>(block.data), [block](limb_t*) { page_free(block); });
+}
+
+FixedBaseTable::FixedBaseTable(const Point& base, std::size_t bits, std::size_t w)
+        : FixedBaseTable(base, bits, w, std::shared_ptr<const limb_t>()) {
+    // row i holds d * B for B = 2^(w i) * base, d = 1 .. 2^w - 1
+    const std::size_t per_row = (std::size_t(1) << w) - 1;
+    std::vector<Point> table;
+    table.reserve(this->count);
+    Point row_base = base;
+    for (std::size_t i = 0; i < this->rows; i++) {
+        table.push_back(row_base);
+        for (std::size_t d = 1; d < per_row; d++) {
+            table.push_back(table.back() + row_base);
+        }
+        for (std::size_t s = 0; s < w; s++) {
+            row_base = row_base.dbl();
+        }
+    }
+    Point::batch_normalize(table);
+
+    std::shared_ptr<limb_t> out = allocate_entries(this->count * 2 * this->width);
+    limb_t* p = out.get();
+    std::memset(p, 0, this->count * 2 * this->width * sizeof(limb_t));
+    for (const Point& point : table) {
+        if (point.is_infinity()) {
+            std::copy(this->prime.begin(), this->prime.end(), p);
+        } else {
+            store(point.X, p);
+            store(point.Y, p + this->width);
+        }
+        p += 2 * this->width;
+    }
+    this->entries = std::move(out);
+}
+
+FixedBaseTable::FixedBaseTable(const Point& base, std::size_t bits, std::size_t w,
+                               std::shared_ptr<const limb_t> entries)
+        : g(base.normalized()), w(w), rows(0), max_bits(bits), count(0),
+          width((base.curve_a().prime_field().bits() + 63) / 64), entries(std::move(entries)) {
+    if (w < 1 || w > 8) {
+        throw std::invalid_argument("Comb window must be between 1 and 8 bits");
+    }
+    this->rows = (bits + w - 1) / w;
+    this->count = this->rows * ((std::size_t(1) << w) - 1);
+    this->prime.resize(this->width);
+    store(this->g.a.prime_field().prime(), this->prime.data());
+}
+
+// shares no ownership: the aliasing constructor on an empty owner
+FixedBaseTable::FixedBaseTable(const Point& base, std::size_t bits, std::size_t w, const limb_t* entries)
+        : FixedBaseTable(base, bits, w, std::shared_ptr<const limb_t>(std::shared_ptr<const limb_t>(), entries)) {
+    const FieldElement one(1, this->g.a.prime_field());
+    if (this->count && !this->g.is_infinity() && entry(0, one) != this->g) {
+        throw std::invalid_argument("Table entries do not start with the base point");
+    }
+}
+
+FixedBaseTable FixedBaseTable::replicate() const {
+    const std::size_t words = this->count * 2 * this->width;
+    std::shared_ptr<limb_t> copy = allocate_entries(words);
+    std::memcpy(copy.get(), this->entries.get(), words * sizeof(limb_t));
+    return FixedBaseTable(this->g, this->max_bits, this->w, std::shared_ptr<const limb_t>(std::move(copy)));
+}
+
+Point FixedBaseTable::mul(const integer& k) const {
+    if (k < 0) {
+        return mul(-k).neg();
+    }
+    if (k.bit_length() > this->max_bits) {
+        throw std::invalid_argument("Scalar is too large for the table");
+    }
+
+    const std::size_t per_row = (std::size_t(1) << this->w) - 1;
+    const FieldElement one(1, this->g.a.prime_field());
+    Point r(this->g.curve_a(), this->g.curve_b());
+    for (std::size_t i = 0; i < this->rows; i++) {
+        const std::size_t d = k.extract_bits(i * this->w, this->w);
+        if (d) {
+            r += entry(i * per_row + d - 1, one);
+        }
+    }
+    return r;
+}
+
+Point FixedBaseTable::mul_ct(const integer& k) const {
+    if (k < 0 || k.bit_length() > this->max_bits) {
+        throw std::invalid_argument("Constant-time scalar must be non-negative and fit the table");
+    }
+    const std::size_t per_row = (std::size_t(1) << this->w) - 1;
+    const std::size_t stride = 2 * this->width;
+    const bool a_zero = this->g.form == Point::a_form::zero;
+    const FieldElement b3 = this->g.b + this->g.b + this->g.b;
+    const FieldElement one(1, this->g.a.prime_field());
+    const FieldElement zero = one - one;
+
+    Homogeneous r{zero, one, zero};
+    std::vector<limb_t> pick(stride);
+    for (std::size_t i = 0; i < this->rows; i++) {
+        const limb_t d = k.extract_bits(i * this->w, this->w);
+        std::fill(pick.begin(), pick.end(), 0);
+        const limb_t* row = this->entries.get() + i * per_row * stride;
+        for (std::size_t e = 1; e <= per_row; e++) {
+            const limb_t x = e ^ d;
+            const limb_t mask = ((x | (0 - x)) >> 63) - 1;
+            for (std::size_t j = 0; j < stride; j++) {
+                pick[j] |= row[(e - 1) * stride + j] & mask;
+            }
+        }
+        // digit zero and an entry at infinity (x = prime) both add (0 : 1 : 0)
+        limb_t diff = 0;
+        for (std::size_t j = 0; j < this->width; j++) {
+            diff |= pick[j] ^ this->prime[j];
+        }
+        const limb_t finite = 0 - (((d | (0 - d)) >> 63) & ((diff | (0 - diff)) >> 63));
+        for (limb_t& limb : pick) {
+            limb &= finite;
+        }
+        const Homogeneous entry{FieldElement::select(finite, coordinate(pick.data()), zero),
+                                FieldElement::select(finite, coordinate(pick.data() + this->width), one),
+                                FieldElement::select(finite, one, zero)};
+        r = complete_add(r, entry, this->g.a, b3, a_zero);
+    }
+
+    if (r.Z.is_zero()) {
+        return Point(this->g.a, this->g.b);
+    }
+    // homogeneous (X : Y : Z) is Jacobian (XZ : YZ^2 : Z)
+    const FieldElement zz = r.Z.square();
+    return Point(r.X * r.Z, r.Y * zz, r.Z, this->g);
+}
+
+Point FixedBaseTable::entry(std::size_t index, const FieldElement& one) const {
+    const limb_t* p = this->entries.get() + index * 2 * this->width;
+    if (std::equal(this->prime.begin(), this->prime.end(), p)) {
+        return Point(this->g.a, this->g.b);
+    }
+    return Point(coordinate(p), coordinate(p + this->width), one, this->g, true);
+}
+
+void FixedBaseTable::store(const integer& value, limb_t* out) const {
+    std::vector<uint8_t> bytes(this->width * sizeof(limb_t));
+    value.to_bytes(bytes.data(), bytes.size(), integer::endian::little);
+    for (std::size_t j = 0; j < this->width; j++) {
+        limb_t limb = 0;
+        for (std::size_t b = sizeof(limb_t); b > 0; b--) {
+            limb = (limb << 8) | bytes[j * sizeof(limb_t) + b - 1];
+        }
+        out[j] = limb;
+    }
+}
+
+void FixedBaseTable::store(const FieldElement& v, limb_t* out) const {
+    if (!this->g.X.field->fixed()) {
+        store(v.num.value(), out);
+        return;
+    }
+    const uint256 raw = this->g.X.operand(v);
+    std::copy(raw.limb, raw.limb + this->width, out);
+}
+
+FieldElement FixedBaseTable::coordinate(const limb_t* in) const {
+    if (!this->g.X.field->fixed()) {
+        std::vector<uint8_t> bytes(this->width * sizeof(limb_t));
+        for (std::size_t i = 0; i < bytes.size(); i++) {
+            bytes[i] = static_cast <uint8_t> (in[i / sizeof(limb_t)] >> (8 * (i % sizeof(limb_t))));
+        }
+        return FieldElement(integer::from_bytes(bytes.data(), bytes.size(), integer::endian::little),
+                            *this->g.X.field);
+    }
+    uint256 raw(0);
+    std::copy(in, in + this->width, raw.limb);
+    return this->g.X.fixed_result(raw);
+}
+
+// FNV-1a over the bytes of words[0, count)
+static limb_t checksum(const limb_t* words, std::size_t count) {
+    limb_t h = 0xcbf29ce484222325;
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(words);
+    for (std::size_t i = 0; i < count * sizeof(limb_t); i++) {
+        h = (h ^ bytes[i]) * 0x100000001b3;
+    }
+    return h;
+}
+
+void FixedBaseTable::save(const std::string& path) const {
+    const std::size_t values = HEADER_WORDS + HEADER_VALUES * this->width;
+    std::vector<limb_t> header(values, 0);
+    header[0] = MAGIC;
+    header[1] = VERSION;
+    header[2] = this->g.X.field->fixed() && this->g.X.mont ? FLAG_MONTGOMERY : 0;
+    header[3] = this->width;
+    header[4] = this->w;
+    header[5] = this->max_bits;
+    limb_t* p = header.data() + HEADER_WORDS;
+    store(this->g.a.prime_field().prime(), p);
+    store(this->g.a.value(), p + this->width);
+    store(this->g.b.value(), p + 2 * this->width);
+    if (!this->g.is_infinity()) {
+        store(this->g.X.value(), p + 3 * this->width);
+        store(this->g.Y.value(), p + 4 * this->width);
+    }
+
+    const std::size_t data = this->count * 2 * this->width;
+    std::vector<limb_t> file(header);
+    file.insert(file.end(), this->entries.get(), this->entries.get() + data);
+    file.push_back(checksum(file.data(), file.size()));
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size() * sizeof(limb_t)));
+    if (!out) {
+        throw std::runtime_error("Cannot write table file " + path);
+    }
+}
+
+// the whole file as words: mapped read-only where there is mmap, so every
+// process reading it shares the page cache, and read into memory elsewhere
+static std::shared_ptr<const limb_t> map_file(const std::string& path, std::size_t& words) {
+#if defined(__unix__) || defined(__APPLE__)
+    const int fd = open(path.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size <= 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        throw std::runtime_error("Cannot read table file " + path);
+    }
+    const std::size_t size = static_cast<std::size_t>(st.st_size);
+    void* map = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        throw std::runtime_error("Cannot map table file " + path);
+    }
+    words = size / sizeof(limb_t);
+    return std::shared_ptr<const limb_t>(static_cast<const limb_t*>(map),
+                                         [size](const limb_t* p) { munmap(const_cast<limb_t*>(p), size); });
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("Cannot read table file " + path);
+    }
+    const std::size_t size = static_cast<std::size_t>(in.tellg());
+    words = size / sizeof(limb_t);
+    std::shared_ptr<limb_t> data(new limb_t[words + 1](), std::default_delete<limb_t[]>());
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(data.get()), static_cast<std::streamsize>(words * sizeof(limb_t)));
+    if (!in) {
+        throw std::runtime_error("Cannot read table file " + path);
+    }
+    return data;
+#endif
+}
+
+FixedBaseTable FixedBaseTable::load(const std::string& path, const Point& base) {
+    std::size_t words = 0;
+    const std::shared_ptr<const limb_t> file = map_file(path, words);
+    const limb_t* h = file.get();
+    if (words < HEADER_WORDS || h[0] != MAGIC) {
+        throw std::runtime_error("Not a fixed-base table file: " + path);
+    }
+    if (h[1] != VERSION) {
+        throw std::runtime_error("Unsupported fixed-base table version in " + path);
+    }
+    if (h[4] < 1 || h[4] > 8) {
+        throw std::runtime_error("Corrupt fixed-base table file " + path);
+    }
+
+    // the entries start after the header; sharing ownership keeps the mapping alive
+    FixedBaseTable table(base, static_cast<std::size_t>(h[5]), static_cast<std::size_t>(h[4]),
+                         std::shared_ptr<const limb_t>());
+    const std::size_t values = HEADER_WORDS + HEADER_VALUES * table.width;
+    if (h[3] != table.width || words != values + table.count * 2 * table.width + 1) {
+        throw std::runtime_error("Corrupt fixed-base table file " + path);
+    }
+    if (checksum(h, words - 1) != h[words - 1]) {
+        throw std::runtime_error("Checksum mismatch in fixed-base table file " + path);
+    }
+
+    // the saved field, curve, base point and representation against base
+    std::vector<limb_t> expected(HEADER_VALUES * table.width, 0);
+    limb_t* p = expected.data();
+    const Point& g = table.g;
+    table.store(g.a.prime_field().prime(), p);
+    table.store(g.a.value(), p + table.width);
+    table.store(g.b.value(), p + 2 * table.width);
+    if (!g.is_infinity()) {
+        table.store(g.X.value(), p + 3 * table.width);
+        table.store(g.Y.value(), p + 4 * table.width);
+    }
+    const limb_t flags = g.X.field->fixed() && g.X.mont ? FLAG_MONTGOMERY : 0;
+    if (!std::equal(expected.begin(), expected.end(), h + HEADER_WORDS) || h[2] != flags) {
+        throw std::invalid_argument("Table file " + path + " holds a different base point");
+    }
+    table.entries = std::shared_ptr<const limb_t>(file, h + values);
+    return table;
+}
@@ -0,0 +1,102 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_FIXEDBASETABLE_H
+#define ECC_FIXEDBASETABLE_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "integer.h"
+#include "limb.h"
+#include "Point.h"
+
+// Precomputed multiples of one fixed point, for k * G with additions only, in
+// the style of libsecp256k1's ecmult_gen: the scalar is cut into windows of w
+// bits and window i selects d * 2^(w i) * G, d < 2^w, from row i of the table.
+// bits / w rows of 2^w - 1 affine points each, so every addition is mixed and
+// there are no doublings. w trades memory for speed: w = 4 keeps 64 rows of 15
+// points for 256-bit scalars and needs 64 additions, w = 8 keeps 32 rows of
+// 255 and needs 32. Build once per base point and share; mul is const.
+// mul reads only the row entries k picks, so it is not constant time; mul_ct
+// reads every one.
+//
+// Entries are stored as raw coordinates, 2 * ceil(bits of the prime / 64)
+// limbs each, in the base point's representation (plain or Montgomery), and
+// copies of a table share them. Entries built here (2 MiB and more, as for
+// w = 8) are on huge pages where huge_page_policy() allows. save() writes them
+// to a file that load() maps read-only, so every process using the file shares
+// its pages and none has to build the table; a StaticCombTable compiled into
+// the binary serves the same.
+class FixedBaseTable {
+public:
+    // multiples for scalars below 2^bits, windows of w bits (1 to 8)
+    FixedBaseTable(const Point& base, std::size_t bits, std::size_t w = 4);
+
+    // a table whose entries were built elsewhere in this class's layout, such
+    // as a StaticCombTable: entries is read in place, not copied, and must
+    // outlive the table and its copies. Throws std::invalid_argument if the
+    // first entry is not base in base's representation
+    FixedBaseTable(const Point& base, std::size_t bits, std::size_t w, const limb_t* entries);
+
+    // k * base for |k| < 2^bits; throws std::invalid_argument for larger k
+    Point mul(const integer& k) const;
+    // the same for secret 0 <= k < 2^bits: each row's entries are all read and
+    // the wanted one kept by mask, and the rows are summed by the complete
+    // formulas of Point::mul_ct, so the steps depend on the table alone (the
+    // masks select without a branch for primes of at most 256 bits). 64
+    // complete additions for w = 4, against mul_ct's 256 doublings and 64
+    // additions. Throws std::invalid_argument for k out of range
+    Point mul_ct(const integer& k) const;
+
+    const Point& base() const { return this->g; }
+    std::size_t bits() const { return this->max_bits; }
+    std::size_t window() const { return this->w; }
+    // number of stored points
+    std::size_t size() const { return this->count; }
+
+    // a copy with entries of its own, written by the calling thread: under
+    // the first-touch policy of Linux and Windows their pages land on the
+    // caller's NUMA node, so threads of that node read the copy locally where
+    // a shared table would be remote for every other node
+    FixedBaseTable replicate() const;
+
+    // Writes the table to path: a versioned header with the field, the curve
+    // and the base point, the entries, and a checksum of all of it, in host
+    // byte order. Throws std::runtime_error if the file cannot be written
+    void save(const std::string& path) const;
+    // Maps a file written by save() (read into memory where there is no mmap);
+    // base must be the saved base point on the same curve, with coordinates in
+    // the same representation. Throws std::runtime_error if the file cannot be
+    // read, is not a table of this version or fails its checksum, and
+    // std::invalid_argument if it holds a different base point
+    static FixedBaseTable load(const std::string& path, const Point& base);
+
+private:
+    // layout version of save(); bump when the header or entries change
+    static constexpr limb_t VERSION = 1;
+
+    Point g;
+    std::size_t w;
+    std::size_t rows;
+    std::size_t max_bits;
+    std::size_t count;
+    std::size_t width;                  // limbs per coordinate
+    // row i, digit d > 0 at entry i * (2^w - 1) + d - 1: x then y, width
+    // limbs each; owned, or inside a file mapping. The point at infinity has
+    // x = prime, which no reduced coordinate equals
+    std::shared_ptr<const limb_t> entries;
+    std::vector<limb_t> prime;
+
+    FixedBaseTable(const Point& base, std::size_t bits, std::size_t w, std::shared_ptr<const limb_t> entries);
+    Point entry(std::size_t index, const FieldElement& one) const;
+    // value in plain form, or v in the base point's representation
+    void store(const integer& value, limb_t* out) const;
+    void store(const FieldElement& v, limb_t* out) const;
+    FieldElement coordinate(const limb_t* in) const;
+};
+
+#endif //ECC_FIXEDBASETABLE_H
@@ -0,0 +1,66 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include "hex.h"
+
+#if defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+
+#include <arm_neon.h>
+
+// NEON is part of every AArch64 CPU. The structure loads and stores do the
+// interleaving: VST2 writes the high and low digits of 16 bytes as 32
+// alternating characters, and VLD2 splits 32 characters the same way. The
+// digits come from TBL on the 16 of them; decoding works as on x86, with
+// unsigned compares on c - '0' and (c | 0x20) - 'a'.
+
+namespace {
+
+void neon_encode(const uint8_t* in, std::size_t len, char* out) {
+    static const uint8_t table[16] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+    const uint8x16_t digits = vld1q_u8(table);
+    std::size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        const uint8x16_t x = vld1q_u8(in + i);
+        uint8x16x2_t pair;
+        pair.val[0] = vqtbl1q_u8(digits, vshrq_n_u8(x, 4));
+        pair.val[1] = vqtbl1q_u8(digits, vandq_u8(x, vdupq_n_u8(0x0F)));
+        vst2q_u8(reinterpret_cast<uint8_t*>(out + 2 * i), pair);
+    }
+    portable_hex_codec()->encode(in + i, len - i, out + 2 * i);
+}
+
+// the nibbles of the 16 characters c, and the invalid ones set in bad
+inline uint8x16_t nibbles(uint8x16_t c, uint8x16_t& bad) {
+    const uint8x16_t digit = vsubq_u8(c, vdupq_n_u8('0'));
+    const uint8x16_t letter = vsubq_u8(vorrq_u8(c, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    const uint8x16_t is_digit = vcltq_u8(digit, vdupq_n_u8(10));
+    const uint8x16_t is_letter = vcltq_u8(letter, vdupq_n_u8(6));
+    bad = vorrq_u8(bad, vmvnq_u8(vorrq_u8(is_digit, is_letter)));
+    return vbslq_u8(is_digit, digit, vaddq_u8(letter, vdupq_n_u8(10)));
+}
+
+bool neon_decode(const char* in, std::size_t len, uint8_t* out) {
+    uint8x16_t bad = vdupq_n_u8(0);
+    std::size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        const uint8x16x2_t pair = vld2q_u8(reinterpret_cast<const uint8_t*>(in + 2 * i));
+        const uint8x16_t hi = nibbles(pair.val[0], bad), lo = nibbles(pair.val[1], bad);
+        vst1q_u8(out + i, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+    }
+    return vmaxvq_u8(bad) == 0 && portable_hex_codec()->decode(in + 2 * i, len - i, out + i);
+}
+
+}
+
+const HexCodec* neon_hex_codec() {
+    static const HexCodec codec = {"neon", neon_encode, neon_decode};
+    return &codec;
+}
+
+#else
+
+const HexCodec* neon_hex_codec() {
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,131 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include "hex.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+#include <immintrin.h>
+
+#define ECC_SSSE3 __attribute__((target("ssse3")))
+#define ECC_AVX2 __attribute__((target("avx2")))
+
+// Encoding splits each byte into its nibbles and looks both up at once with
+// PSHUFB on the 16 digits, then interleaves them high first. Decoding takes
+// the value of a character as c - '0' where it is a digit and (c | 0x20) -
+// 'a' + 10 where it is a letter a to f, from signed range compares (a byte
+// above 0x7F is negative and fails both), and PMADDUBSW with 16 and 1 joins
+// each pair of nibbles into a byte. Every invalid character is ORed into one
+// mask that is tested once at the end.
+
+namespace {
+
+ECC_SSSE3 void ssse3_encode(const uint8_t* in, std::size_t len, char* out) {
+    const __m128i digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    const __m128i low = _mm_set1_epi8(0x0F);
+    std::size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        const __m128i hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(x, 4), low));
+        const __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(x, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    portable_hex_codec()->encode(in + i, len - i, out + 2 * i);
+}
+
+// the nibbles of the 16 characters c, and the invalid ones set in bad
+ECC_SSSE3 inline __m128i nibbles(__m128i c, __m128i& bad) {
+    const __m128i lc = _mm_or_si128(c, _mm_set1_epi8(0x20));
+    const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+                                        _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), c));
+    const __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(lc, _mm_set1_epi8('a' - 1)),
+                                         _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), lc));
+    bad = _mm_or_si128(bad, _mm_andnot_si128(_mm_or_si128(digit, letter), _mm_set1_epi8(-1)));
+    return _mm_or_si128(_mm_and_si128(digit, _mm_sub_epi8(c, _mm_set1_epi8('0'))),
+                        _mm_and_si128(letter, _mm_sub_epi8(lc, _mm_set1_epi8('a' - 10))));
+}
+
+ECC_SSSE3 bool ssse3_decode(const char* in, std::size_t len, uint8_t* out) {
+    const __m128i join = _mm_set1_epi16(0x0110);
+    __m128i bad = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        const __m128i a = nibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * i)), bad);
+        const __m128i b = nibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * i + 16)), bad);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                         _mm_packus_epi16(_mm_maddubs_epi16(a, join), _mm_maddubs_epi16(b, join)));
+    }
+    return _mm_movemask_epi8(bad) == 0 && portable_hex_codec()->decode(in + 2 * i, len - i, out + i);
+}
+
+// the targets of the callers carry over: the helper is inlined into a function
+// compiled for AVX2, so no vector crosses a call
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+ECC_AVX2 void avx2_encode(const uint8_t* in, std::size_t len, char* out) {
+    const __m256i digits = _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+                                            '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    const __m256i low = _mm256_set1_epi8(0x0F);
+    std::size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        const __m256i hi = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(x, 4), low));
+        const __m256i lo = _mm256_shuffle_epi8(digits, _mm256_and_si256(x, low));
+        // the unpacks stay within 128-bit lanes: bytes 0-7 and 16-23, then 8-15 and 24-31
+        const __m256i first = _mm256_unpacklo_epi8(hi, lo), second = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i), _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + 32), _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    ssse3_encode(in + i, len - i, out + 2 * i);
+}
+
+ECC_AVX2 inline __m256i nibbles(__m256i c, __m256i& bad) {
+    const __m256i lc = _mm256_or_si256(c, _mm256_set1_epi8(0x20));
+    const __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)),
+                                           _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+    const __m256i letter = _mm256_and_si256(_mm256_cmpgt_epi8(lc, _mm256_set1_epi8('a' - 1)),
+                                            _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lc));
+    bad = _mm256_or_si256(bad, _mm256_andnot_si256(_mm256_or_si256(digit, letter), _mm256_set1_epi8(-1)));
+    return _mm256_or_si256(_mm256_and_si256(digit, _mm256_sub_epi8(c, _mm256_set1_epi8('0'))),
+                           _mm256_and_si256(letter, _mm256_sub_epi8(lc, _mm256_set1_epi8('a' - 10))));
+}
+
+ECC_AVX2 bool avx2_decode(const char* in, std::size_t len, uint8_t* out) {
+    const __m256i join = _mm256_set1_epi16(0x0110);
+    __m256i bad = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        const __m256i a = nibbles(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 2 * i)), bad);
+        const __m256i b = nibbles(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 2 * i + 32)), bad);
+        // the pack also works per lane, so the middle quarters trade places after
+        const __m256i packed = _mm256_packus_epi16(_mm256_maddubs_epi16(a, join), _mm256_maddubs_epi16(b, join));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+    return _mm256_movemask_epi8(bad) == 0 && ssse3_decode(in + 2 * i, len - i, out + i);
+}
+#pragma GCC diagnostic pop
+
+}
+
+const HexCodec* ssse3_hex_codec() {
+    static const HexCodec codec = {"ssse3", ssse3_encode, ssse3_decode};
+    return __builtin_cpu_supports("ssse3") ? &codec : nullptr;
+}
+
+const HexCodec* avx2_hex_codec() {
+    static const HexCodec codec = {"avx2", avx2_encode, avx2_decode};
+    return __builtin_cpu_supports("avx2") ? &codec : nullptr;
+}
+
+#else
+
+const HexCodec* ssse3_hex_codec() {
+    return nullptr;
+}
+
+const HexCodec* avx2_hex_codec() {
+    return nullptr;
+}
+
+#endif
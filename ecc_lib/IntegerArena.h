@@ -0,0 +1,62 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_INTEGERARENA_H
+#define ECC_INTEGERARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+
+#include "integer.h"
+#include "small_vector.h"
+
+// Routes every integer heap allocation made on this thread to resource while
+// it is alive, then puts the previous resource back. Scopes nest.
+class IntegerMemoryScope {
+public:
+    explicit IntegerMemoryScope(std::pmr::memory_resource* resource) : previous(small_vector_resource()) {
+        small_vector_resource() = resource;
+    }
+    ~IntegerMemoryScope() {
+        small_vector_resource() = this->previous;
+    }
+
+    IntegerMemoryScope(const IntegerMemoryScope&) = delete;
+    IntegerMemoryScope& operator=(const IntegerMemoryScope&) = delete;
+
+private:
+    std::pmr::memory_resource* previous;
+};
+
+// A monotonic arena for the integer temporaries of one job (a verification, a
+// batch): while it lives, integers that outgrow their inline digits on this
+// thread bump-allocate from it, frees cost nothing, and destroying it returns
+// all of the memory at once. Each thread uses its own arena, so nothing is
+// shared and nothing locks.
+//
+// Integer storage from the arena dangles once the arena is gone. Values up to
+// INTEGER_INLINE_BITS never touch the heap and are always safe to hand out;
+// larger results that must outlive the arena should go through keep().
+class IntegerArena {
+public:
+    explicit IntegerArena(std::size_t initial_bytes = 64 * 1024)
+            : resource(initial_bytes, std::pmr::new_delete_resource()), scope(&this->resource) {
+    }
+
+    IntegerArena(const IntegerArena&) = delete;
+    IntegerArena& operator=(const IntegerArena&) = delete;
+
+    // a copy of value in ordinary heap memory, which survives the arena
+    static integer keep(const integer& value) {
+        IntegerMemoryScope heap(std::pmr::new_delete_resource());
+        return integer(value);
+    }
+
+private:
+    // declared first so it is destroyed last, after the scope has let go of it
+    std::pmr::monotonic_buffer_resource resource;
+    IntegerMemoryScope scope;
+};
+
+#endif //ECC_INTEGERARENA_H
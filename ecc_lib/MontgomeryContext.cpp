@@ -0,0 +1,64 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <stdexcept>
+#include "FieldKernels.h"
+#include "MontgomeryContext.h"
+#include "modexp.h"
+
+MontgomeryContext::MontgomeryContext(const integer& prime) {
+    if (prime < 3 || !(prime & 1) || prime.bit_length() > uint256::BITS) {
+        throw std::invalid_argument("Montgomery modulus must be odd and fit in 256 bits");
+    }
+    this->p = uint256::from_integer(prime);
+    this->r = uint256::from_integer((integer(1) << uint256::BITS) % prime);
+    this->r2 = uint256::from_integer((integer(1) << (2 * uint256::BITS)) % prime);
+
+    this->pinv = montgomery_n0(this->p.limb[0]);
+}
+
+uint256 MontgomeryContext::to_montgomery(const uint256& a) const {
+    return mul(a, this->r2);
+}
+
+uint256 MontgomeryContext::from_montgomery(const uint256& a) const {
+    return mul(a, uint256(1));
+}
+
+uint256 MontgomeryContext::mul(const uint256& a, const uint256& b) const {
+    return field_kernels().montgomery_mul(a, b, this->p, this->pinv);
+}
+
+uint256 MontgomeryContext::add(const uint256& a, const uint256& b) const {
+    return montgomery_add(a, b, this->p);
+}
+
+uint256 MontgomeryContext::sub(const uint256& a, const uint256& b) const {
+    return montgomery_sub(a, b, this->p);
+}
+
+void MontgomeryContext::mul(uint256* out, const uint256* a, const uint256* b, std::size_t n) const {
+    field_kernels().mul(out, a, b, n, this->p, this->pinv);
+}
+
+void MontgomeryContext::add(uint256* out, const uint256* a, const uint256* b, std::size_t n) const {
+    field_kernels().add(out, a, b, n, this->p);
+}
+
+void MontgomeryContext::sub(uint256* out, const uint256* a, const uint256* b, std::size_t n) const {
+    field_kernels().sub(out, a, b, n, this->p);
+}
+
+uint256 MontgomeryContext::pow(const uint256& a, const integer& exponent) const {
+    return sliding_window_pow(a, exponent, this->r, [this](const uint256& x, const uint256& y) {
+        return mul(x, y);
+    });
+}
+
+uint256 MontgomeryContext::pow_ct(const uint256& a, const uint256& exponent) const {
+    return montgomery_ladder_pow(a, uint256::BITS,
+            [&exponent](std::size_t i) { return (exponent.limb[i / 64] >> (i % 64)) & 1; },
+            this->r,
+            [this](const uint256& x, const uint256& y) { return mul(x, y); },
+            [](uint256& x, uint256& y, limb_t mask) { uint256::cswap(x, y, mask); });
+}
@@ -0,0 +1,158 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_MONTGOMERYCONTEXT_H
+#define ECC_MONTGOMERYCONTEXT_H
+
+#include <cstddef>
+
+#include "integer.h"
+#include "limb.h"
+#include "uint256.h"
+
+// Precomputed constants for Montgomery arithmetic modulo an odd prime p < 2^256,
+// with R = 2^256. Values in Montgomery form are a * R mod p; mul() multiplies and
+// reduces them in one CIOS pass, so no step needs a division; it runs on the
+// field_kernels() backend for this CPU. mul, add and sub use masks rather than
+// branches for their final corrections.
+class MontgomeryContext {
+public:
+    explicit MontgomeryContext(const integer& prime);
+
+    const uint256& modulus() const { return this->p; }
+    const uint256& one() const { return this->r; }      // R mod p, the Montgomery form of 1
+    const uint256& r_squared() const { return this->r2; }
+    limb_t n0() const { return this->pinv; }            // -p^-1 mod 2^64
+
+    // a * R mod p for a < p
+    uint256 to_montgomery(const uint256& a) const;
+    // a / R mod p
+    uint256 from_montgomery(const uint256& a) const;
+
+    // a * b / R mod p for a, b < p
+    uint256 mul(const uint256& a, const uint256& b) const;
+    uint256 sqr(const uint256& a) const { return mul(a, a); }
+    uint256 add(const uint256& a, const uint256& b) const;
+    uint256 sub(const uint256& a, const uint256& b) const;
+
+    // the same over n independent operands, out[i] = a[i] op b[i], on the
+    // fastest batch kernels this CPU supports (see FieldKernels.h)
+    void mul(uint256* out, const uint256* a, const uint256* b, std::size_t n) const;
+    void add(uint256* out, const uint256* a, const uint256* b, std::size_t n) const;
+    void sub(uint256* out, const uint256* a, const uint256* b, std::size_t n) const;
+
+    // a^exponent for a in Montgomery form, with a sliding window of odd powers
+    uint256 pow(const uint256& a, const integer& exponent) const;
+    // the same in constant time: a Montgomery ladder over all 256 exponent bits
+    uint256 pow_ct(const uint256& a, const uint256& exponent) const;
+
+    friend bool operator==(const MontgomeryContext& lhs, const MontgomeryContext& rhs) {
+        return lhs.p == rhs.p;
+    }
+
+private:
+    uint256 p;
+    uint256 r;
+    uint256 r2;
+    limb_t pinv;
+};
+
+// The kernels behind MontgomeryContext, inline so that callers whose modulus is
+// a compile-time constant get it folded into the limb loops, and constexpr so
+// that they also run in constant expressions.
+
+// -p^-1 mod 2^64 for odd p0; Newton's iteration doubles the correct low bits each step
+constexpr limb_t montgomery_n0(limb_t p0) {
+    limb_t inv = 1;
+    for (int i = 0; i < 6; i++) {
+        inv *= 2 - p0 * inv;
+    }
+    return 0 - inv;
+}
+
+// 2^k mod p for odd p, by doubling; gives R and R^2 when p is known at compile time
+constexpr uint256 montgomery_pow2(std::size_t k, const uint256& p) {
+    uint256 x(1);
+    for (std::size_t i = 0; i < k; i++) {
+        // x = 2x, then subtract p if that carried out or is still >= p
+        limb_t carry = x.limb[3] >> 63;
+        for (std::size_t j = 3; j > 0; j--) {
+            x.limb[j] = (x.limb[j] << 1) | (x.limb[j - 1] >> 63);
+        }
+        x.limb[0] <<= 1;
+        bool ge = carry != 0;
+        if (!ge) {
+            ge = true;
+            for (std::size_t j = 4; j > 0; j--) {
+                if (x.limb[j - 1] != p.limb[j - 1]) {
+                    ge = x.limb[j - 1] > p.limb[j - 1];
+                    break;
+                }
+            }
+        }
+        if (ge) {
+            limb_t borrow = 0;
+            for (std::size_t j = 0; j < 4; j++) {
+                const limb_t d = x.limb[j] - p.limb[j];
+                const limb_t next = (x.limb[j] < p.limb[j]) | (d < borrow);
+                x.limb[j] = d - borrow;
+                borrow = next;
+            }
+        }
+    }
+    return x;
+}
+
+// Coarsely Integrated Operand Scanning: interleave one row of a * b with one
+// limb of reduction, so the running value never grows past 6 limbs
+constexpr uint256 montgomery_mul(const uint256& a, const uint256& b, const uint256& p, limb_t n0) {
+    constexpr std::size_t N = 4;
+    limb_t t[N + 2] = {0, 0, 0, 0, 0, 0};
+
+    for (std::size_t i = 0; i < N; i++) {
+        limb_t carry = 0;
+        for (std::size_t j = 0; j < N; j++) {
+            t[j] = limb_mac(a.limb[j], b.limb[i], t[j], carry);
+        }
+        limb_t k = 0;
+        t[N] = limb_addc(t[N], carry, k);
+        t[N + 1] = k;
+
+        // add m * p so the low limb cancels, then drop it
+        const limb_t m = t[0] * n0;
+        carry = 0;
+        limb_mac(m, p.limb[0], t[0], carry);
+        for (std::size_t j = 1; j < N; j++) {
+            t[j - 1] = limb_mac(m, p.limb[j], t[j], carry);
+        }
+        k = 0;
+        t[N - 1] = limb_addc(t[N], carry, k);
+        t[N] = t[N + 1] + k;
+    }
+
+    // t < 2p, one conditional subtraction brings it below p
+    uint256 out(0);
+    for (std::size_t j = 0; j < N; j++) {
+        out.limb[j] = t[j];
+    }
+    uint256 reduced(0);
+    const limb_t borrow = uint256::sub(reduced, out, p);
+    return uint256::select(0 - (t[N] | (borrow ^ 1)), reduced, out);
+}
+
+constexpr uint256 montgomery_add(const uint256& a, const uint256& b, const uint256& p) {
+    uint256 out(0), reduced(0);
+    const limb_t carry = uint256::add(out, a, b);
+    const limb_t borrow = uint256::sub(reduced, out, p);
+    return uint256::select(0 - (carry | (borrow ^ 1)), reduced, out);
+}
+
+constexpr uint256 montgomery_sub(const uint256& a, const uint256& b, const uint256& p) {
+    uint256 out(0);
+    const limb_t borrow = uint256::sub(out, a, b);
+    uint256::add(out, out, uint256::select(0 - borrow, p, uint256::zero()));
+    return out;
+}
+
+#endif //ECC_MONTGOMERYCONTEXT_H
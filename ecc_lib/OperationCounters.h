@@ -0,0 +1,50 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_OPERATIONCOUNTERS_H
+#define ECC_OPERATIONCOUNTERS_H
+
+#include <cstdint>
+
+// Per-thread counts of the expensive operations underneath integer and
+// FieldElement, for attributing the cost of a high-level operation:
+//
+//     OperationCounters::reset();
+//     verify(...);
+//     OperationCounters counts = OperationCounters::snapshot();
+//
+// Counting is compiled in only with ECC_COUNTERS defined (the ECC_COUNTERS
+// CMake option). Without it ECC_COUNT expands to nothing and snapshot() stays
+// all zeros, so instrumented code costs nothing.
+struct OperationCounters {
+    uint64_t integer_mul = 0;       // integer::operator* and square(), including the recursive algorithms' own calls
+    uint64_t integer_divmod = 0;    // divisions that reach a division algorithm
+    uint64_t integer_ntt_mul = 0;   // products done by NTT
+    uint64_t barrett_reductions = 0;
+    uint64_t allocations = 0;       // integer digit buffers taken from the heap or an arena
+    uint64_t allocated_bytes = 0;
+    uint64_t field_add = 0;         // FieldElement additions and subtractions
+    uint64_t field_mul = 0;
+    uint64_t field_inv = 0;         // single inversions; batch_invert counts one per batch
+    uint64_t field_pow = 0;         // exponentiations, including those inside sqrt
+
+    // the calling thread's counters so far
+    static OperationCounters snapshot() { return local(); }
+    static void reset() { local() = OperationCounters(); }
+
+    static OperationCounters& local() {
+        static thread_local OperationCounters counters;
+        return counters;
+    }
+};
+
+#ifdef ECC_COUNTERS
+#define ECC_COUNT(counter)          (++OperationCounters::local().counter)
+#define ECC_COUNT_ADD(counter, n)   (OperationCounters::local().counter += (n))
+#else
+#define ECC_COUNT(counter)          ((void) 0)
+#define ECC_COUNT_ADD(counter, n)   ((void) 0)
+#endif
+
+#endif //ECC_OPERATIONCOUNTERS_H
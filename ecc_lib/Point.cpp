@@ -0,0 +1,722 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <algorithm>
+#include <stdexcept>
+
+#include "complete.h"
+#include "FixedBaseTable.h"
+#include "modexp.h"
+#include "Point.h"
+
+Point::Point(const FieldElement& a, const FieldElement& b)
+        : X(FieldElement(1, a.prime_field())), Y(X), Z(a - a), a(a), b(b), form(classify(a)), z_one(false),
+          cache(nullptr) {
+    if (&a.prime_field() != &b.prime_field()) {
+        throw std::runtime_error("Curve coefficients must be in the same field");
+    }
+}
+
+Point::Point(const FieldElement& x, const FieldElement& y, const FieldElement& a, const FieldElement& b)
+        : X(x), Y(y), Z(FieldElement(1, x.prime_field())), a(a), b(b), form(classify(a)), z_one(true),
+          cache(nullptr) {
+    const Status status = check_affine(x, y, a, b);
+    if (status != Status::ok) {
+        throw_status(status, status == Status::not_on_curve ? "Point is not on the curve"
+                                                            : "Coordinates and curve must be in the same field");
+    }
+}
+
+Result<Point> Point::make(const FieldElement& x, const FieldElement& y, const FieldElement& a, const FieldElement& b) noexcept {
+    const Status status = check_affine(x, y, a, b);
+    if (status != Status::ok) {
+        return status;
+    }
+    const Point curve(a, b);
+    return Point(x, y, FieldElement(1, x.prime_field()), curve, true);
+}
+
+Result<Point> Point::make(const FieldElement& X, const FieldElement& Y, const FieldElement& Z,
+                          const FieldElement& a, const FieldElement& b) noexcept {
+    const PrimeField* field = &Z.prime_field();
+    if (&X.prime_field() != field || &Y.prime_field() != field || &a.prime_field() != field
+        || &b.prime_field() != field) {
+        return Status::field_mismatch;
+    }
+    const Point curve(a, b);
+    if (Z.is_zero()) {
+        return curve;
+    }
+    const Point p(X, Y, Z, curve, Z == FieldElement(1, *field));
+    if (!p.is_on_curve()) {
+        return Status::not_on_curve;
+    }
+    return p;
+}
+
+Status Point::check_affine(const FieldElement& x, const FieldElement& y, const FieldElement& a, const FieldElement& b) noexcept {
+    const PrimeField* field = &x.prime_field();
+    if (&y.prime_field() != field || &a.prime_field() != field || &b.prime_field() != field) {
+        return Status::field_mismatch;
+    }
+    return y.square() == (x.square() + a) * x + b ? Status::ok : Status::not_on_curve;
+}
+
+Point::Point(const FieldElement& X, const FieldElement& Y, const FieldElement& Z, const Point& curve, bool z_one)
+        : X(X), Y(Y), Z(Z), a(curve.a), b(curve.b), form(curve.form), z_one(z_one), cache(nullptr) {
+}
+
+const Point::Affine* Point::copy_cache(const Point& other) {
+    const Affine* cached = other.cache.load(std::memory_order_acquire);
+    return cached ? new Affine(*cached) : nullptr;
+}
+
+Point::Point(const Point& other)
+        : X(other.X), Y(other.Y), Z(other.Z), a(other.a), b(other.b), form(other.form), z_one(other.z_one),
+          cache(copy_cache(other)) {
+}
+
+Point::Point(Point&& other) noexcept
+        : X(std::move(other.X)), Y(std::move(other.Y)), Z(std::move(other.Z)), a(std::move(other.a)),
+          b(std::move(other.b)), form(other.form), z_one(other.z_one),
+          cache(other.cache.exchange(nullptr, std::memory_order_relaxed)) {
+}
+
+Point& Point::operator=(const Point& other) {
+    if (this != &other) {
+        const Affine* cached = copy_cache(other);
+        this->X = other.X;
+        this->Y = other.Y;
+        this->Z = other.Z;
+        this->a = other.a;
+        this->b = other.b;
+        this->form = other.form;
+        this->z_one = other.z_one;
+        delete this->cache.exchange(cached, std::memory_order_relaxed);
+    }
+    return *this;
+}
+
+Point& Point::operator=(Point&& other) noexcept {
+    if (this != &other) {
+        this->X = std::move(other.X);
+        this->Y = std::move(other.Y);
+        this->Z = std::move(other.Z);
+        this->a = std::move(other.a);
+        this->b = std::move(other.b);
+        this->form = other.form;
+        this->z_one = other.z_one;
+        delete this->cache.exchange(other.cache.exchange(nullptr, std::memory_order_relaxed),
+                                    std::memory_order_relaxed);
+    }
+    return *this;
+}
+
+Point::a_form Point::classify(const FieldElement& a) {
+    if (a.is_zero()) {
+        return a_form::zero;
+    }
+    return (a.value() + 3 == a.prime_field().prime()) ? a_form::minus_three : a_form::generic;
+}
+
+std::pair<FieldElement, FieldElement> Point::affine() const {
+    if (is_infinity()) {
+        throw std::domain_error("The point at infinity has no affine coordinates");
+    }
+    if (this->z_one) {
+        return std::make_pair(this->X, this->Y);
+    }
+    if (const Affine* cached = this->cache.load(std::memory_order_acquire)) {
+        return std::make_pair(cached->x, cached->y);
+    }
+    const FieldElement z = FieldElement(1, this->Z.prime_field()) / this->Z;
+    const FieldElement zz = z.square();
+    const Affine* fresh = new Affine{this->X * zz, this->Y * zz * z};
+    // a thread that got there first published the same coordinates
+    const Affine* expected = nullptr;
+    if (!this->cache.compare_exchange_strong(expected, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        delete fresh;
+        fresh = expected;
+    }
+    return std::make_pair(fresh->x, fresh->y);
+}
+
+bool Point::has_x(const FieldElement& x) const {
+    if (is_infinity()) {
+        return false;
+    }
+    if (this->z_one) {
+        return this->X == x;
+    }
+    const Affine* cached = this->cache.load(std::memory_order_acquire);
+    return cached ? cached->x == x : this->X == x * this->Z.square();
+}
+
+bool Point::is_on_curve() const {
+    if (is_infinity()) {
+        return true;
+    }
+    if (this->z_one) {
+        return check_affine(this->X, this->Y, this->a, this->b) == Status::ok;
+    }
+    const FieldElement z2 = this->Z.square();
+    const FieldElement z4 = z2.square();
+    const FieldElement x2 = this->X.square();
+    const FieldElement rhs = (this->form == a_form::zero ? x2 : x2 + this->a * z4) * this->X + this->b * z4 * z2;
+    return this->Y.square() == rhs;
+}
+
+Point Point::normalized() const {
+    if (this->z_one || is_infinity()) {
+        return *this;
+    }
+    const std::pair<FieldElement, FieldElement> xy = affine();
+    return Point(xy.first, xy.second, FieldElement(1, this->Z.prime_field()), *this, true);
+}
+
+void Point::batch_normalize(std::vector<Point>& points) {
+    batch_normalize(points.data(), points.size(), Scratch::local());
+}
+
+void Point::batch_normalize(Point* points, std::size_t count) {
+    batch_normalize(points, count, Scratch::local());
+}
+
+void Point::batch_normalize(Point* points, std::size_t count, Scratch& scratch) {
+    Scratch::Frame frame(scratch);
+    Scratch::vector<FieldElement> z(&scratch);
+    Scratch::vector<std::size_t> index(&scratch);
+    for (std::size_t i = 0; i < count; i++) {
+        Point& p = points[i];
+        if (p.z_one || p.is_infinity()) {
+            continue;
+        }
+        if (const Affine* cached = p.cache.load(std::memory_order_relaxed)) {
+            p = Point(cached->x, cached->y, FieldElement(1, p.Z.prime_field()), p, true);
+        } else {
+            z.push_back(p.Z);
+            index.push_back(i);
+        }
+    }
+    FieldElement::batch_invert(z.data(), z.size(), scratch);
+    for (std::size_t i = 0; i < z.size(); i++) {
+        Point& p = points[index[i]];
+        const FieldElement zz = z[i].square();
+        p = Point(p.X * zz, p.Y * zz * z[i], FieldElement(1, p.Z.prime_field()), p, true);
+    }
+}
+
+void Point::batch_add(const std::vector<Point>& a, const std::vector<Point>& b, std::vector<Point>& out) {
+    if (a.size() != b.size()) {
+        throw std::invalid_argument("Need as many points on each side");
+    }
+    std::vector<Point> sums;
+    sums.reserve(a.size());
+    std::vector<FieldElement> dx;
+    std::vector<std::size_t> index;
+    for (std::size_t i = 0; i < a.size(); i++) {
+        a[i].check_curve(b[i]);
+        const bool chord = a[i].z_one && b[i].z_one && !a[i].is_infinity() && !b[i].is_infinity()
+                           && a[i].X != b[i].X;
+        sums.push_back(chord ? a[i] : a[i].add(b[i]));
+        if (chord) {
+            dx.push_back(b[i].X - a[i].X);
+            index.push_back(i);
+        }
+    }
+    FieldElement::batch_invert(dx);
+    for (std::size_t j = 0; j < dx.size(); j++) {
+        const Point& p = a[index[j]];
+        const Point& q = b[index[j]];
+        const FieldElement slope = (q.Y - p.Y) * dx[j];
+        const FieldElement x = slope.square() - p.X - q.X;
+        sums[index[j]] = Point(x, slope * (p.X - x) - p.Y, p.Z, p, true);
+    }
+    out = std::move(sums);
+}
+
+// secp256k1: lambda * (x, y) = (beta * x, y), as in libsecp256k1
+static const integer SECP256K1_BETA = (0x7ae96a2b657c07106e64479eac3434e99cf0497512f58995c1396c28719501ee_u256).to_integer();
+
+bool Point::is_secp256k1() const {
+    return this->form == a_form::zero && this->b.value() == integer(7)
+           && this->Z.prime_field().addition_chain() == PrimeField::chain::secp256k1;
+}
+
+std::vector<Point> Point::odd_multiples(std::size_t w) const {
+    std::vector<Point> odd(std::size_t(1) << (w - 2), *this);
+    if (odd.size() > 1) {
+        const Point twice = dbl();
+        for (std::size_t i = 1; i < odd.size(); i++) {
+            odd[i] = odd[i - 1] + twice;
+        }
+    }
+    return odd;
+}
+
+// the digits of |k|, negated for negative k
+static std::vector<int> signed_wnaf(const integer& k, std::size_t w) {
+    std::vector<int> digits = wnaf(k < 0 ? -k : k, w);
+    if (k < 0) {
+        for (int& d : digits) {
+            d = -d;
+        }
+    }
+    return digits;
+}
+
+void Point::wnaf_tables(std::vector<Point>&& odd, std::vector<std::vector<Point>>& tables) const {
+    if (!is_secp256k1()) {
+        tables.push_back(std::move(odd));
+        return;
+    }
+    const FieldElement beta(SECP256K1_BETA, this->Z.prime_field());
+    std::vector<Point> odd_lambda;
+    odd_lambda.reserve(odd.size());
+    for (const Point& p : odd) {
+        odd_lambda.push_back(p.is_infinity() ? p : Point(p.X * beta, p.Y, p.Z, p, p.z_one));
+    }
+    tables.push_back(std::move(odd));
+    tables.push_back(std::move(odd_lambda));
+}
+
+void Point::wnaf_digits(const integer& k, std::size_t w, std::vector<std::vector<int>>& digits) const {
+    if (!is_secp256k1()) {
+        digits.push_back(signed_wnaf(k, w));
+        return;
+    }
+    static const PrimeField& order = PrimeField::get(SECP256K1_ORDER_N.to_integer());
+    const std::pair<Scalar, Scalar> halves = Scalar(k, order).split_lambda();
+    digits.push_back(halves.first.wnaf(w));
+    digits.push_back(halves.second.wnaf(w));
+}
+
+Point Point::wnaf_sum(const std::vector<const std::vector<Point>*>& tables,
+                      const std::vector<std::vector<int>>& digits, const Point& curve) {
+    std::size_t length = 0;
+    for (const std::vector<int>& d : digits) {
+        length = std::max(length, d.size());
+    }
+    Point r(curve.a, curve.b);
+    for (std::size_t i = length; i > 0; i--) {
+        r = r.dbl();
+        for (std::size_t j = 0; j < digits.size(); j++) {
+            const int d = (i <= digits[j].size()) ? digits[j][i - 1] : 0;
+            if (d > 0) {
+                r += (*tables[j])[d >> 1];
+            } else if (d < 0) {
+                r -= (*tables[j])[-d >> 1];
+            }
+        }
+    }
+    return r;
+}
+
+// the addresses of the tables, as wnaf_sum reads them
+static std::vector<const std::vector<Point>*> table_pointers(const std::vector<std::vector<Point>>& tables) {
+    std::vector<const std::vector<Point>*> out;
+    out.reserve(tables.size());
+    for (const std::vector<Point>& t : tables) {
+        out.push_back(&t);
+    }
+    return out;
+}
+
+static void check_window(std::size_t w) {
+    if (w < 2 || w > 8) {
+        throw std::invalid_argument("wNAF window must be between 2 and 8");
+    }
+}
+
+Point Point::mul(const integer& k, std::size_t w) const {
+    check_window(w);
+    std::vector<Point> odd = odd_multiples(w);
+    batch_normalize(odd);
+    std::vector<std::vector<Point>> tables;
+    std::vector<std::vector<int>> digits;
+    wnaf_tables(std::move(odd), tables);
+    wnaf_digits(k, w, digits);
+    return wnaf_sum(table_pointers(tables), digits, *this);
+}
+
+Point Point::mul_add(const integer& u1, const Point& g, const integer& u2, const Point& q, std::size_t w) {
+    return mul_sum({u1, u2}, {g, q}, w);
+}
+
+Point Point::mul_sum(const std::vector<integer>& k, const std::vector<Point>& p, std::size_t w) {
+    check_window(w);
+    if (p.empty() || k.size() != p.size()) {
+        throw std::invalid_argument("Need as many scalars as points, at least one");
+    }
+    // every table in one batch, for a single inversion
+    std::vector<Point> odd;
+    for (const Point& point : p) {
+        p[0].check_curve(point);
+        const std::vector<Point> multiples = point.odd_multiples(w);
+        odd.insert(odd.end(), multiples.begin(), multiples.end());
+    }
+    batch_normalize(odd);
+
+    const std::size_t size = std::size_t(1) << (w - 2);
+    std::vector<std::vector<Point>> tables;
+    std::vector<std::vector<int>> digits;
+    for (std::size_t i = 0; i < p.size(); i++) {
+        p[i].wnaf_tables(std::vector<Point>(odd.begin() + i * size, odd.begin() + (i + 1) * size), tables);
+        p[i].wnaf_digits(k[i], w, digits);
+    }
+    return wnaf_sum(table_pointers(tables), digits, p[0]);
+}
+
+WnafTable Point::wnaf_table(std::size_t w) const {
+    check_window(w);
+    std::vector<Point> odd = odd_multiples(w);
+    batch_normalize(odd);
+    std::vector<std::vector<Point>> tables;
+    wnaf_tables(std::move(odd), tables);
+    return WnafTable(w, std::move(tables));
+}
+
+Point Point::mul_add(const integer& u1, const WnafTable& g, const integer& u2, const WnafTable& q) {
+    g.base().check_curve(q.base());
+    std::vector<const std::vector<Point>*> tables = table_pointers(g.tables);
+    for (const std::vector<Point>& t : q.tables) {
+        tables.push_back(&t);
+    }
+    std::vector<std::vector<int>> digits;
+    g.base().wnaf_digits(u1, g.w, digits);
+    q.base().wnaf_digits(u2, q.w, digits);
+    return wnaf_sum(tables, digits, g.base());
+}
+
+std::size_t WnafTable::size() const {
+    std::size_t out = 0;
+    for (const std::vector<Point>& t : this->tables) {
+        out += t.size();
+    }
+    return out;
+}
+
+std::size_t WnafTable::memory() const {
+    std::size_t out = sizeof(WnafTable) + this->tables.capacity() * sizeof(std::vector<Point>);
+    for (const std::vector<Point>& t : this->tables) {
+        out += t.capacity() * sizeof(Point);
+        for (const Point& p : t) {
+            out += p.heap_bytes();
+        }
+    }
+    return out;
+}
+
+Point Point::mul_add(const integer& u1, const FixedBaseTable& g, const integer& u2, const Point& q) {
+    g.base().check_curve(q);
+    return g.mul(u1) + q.mul(u2);
+}
+
+Point Point::mul_ct(const integer& k) const {
+    static constexpr std::size_t W = 4;
+    const std::size_t bits = this->Z.prime_field().bits() + 1;
+    if (k < 0 || k.bit_length() > bits) {
+        throw std::invalid_argument("Constant-time scalar must be non-negative and at most one bit longer than the prime");
+    }
+    const bool a_zero = this->form == a_form::zero;
+    const FieldElement b3 = this->b + this->b + this->b;
+    const FieldElement zero = this->Z - this->Z;
+    const FieldElement one(1, this->Z.prime_field());
+
+    // table[d] = d * P; Jacobian (X : Y : Z) is homogeneous (XZ : Y : Z^3)
+    std::vector<Homogeneous> table(std::size_t(1) << W, Homogeneous{zero, one, zero});
+    table[1] = Homogeneous{this->X * this->Z, this->Y, this->Z.square() * this->Z};
+    for (std::size_t d = 2; d < table.size(); d++) {
+        table[d] = complete_add(table[d - 1], table[1], this->a, b3, a_zero);
+    }
+
+    Homogeneous r = table[0];
+    for (std::size_t i = (bits + W - 1) / W; i > 0; i--) {
+        for (std::size_t j = 0; j < W; j++) {
+            r = complete_dbl(r, this->a, b3, a_zero);
+        }
+        const limb_t digit = k.extract_bits((i - 1) * W, W);
+        // every entry is read, the one wanted kept by mask
+        Homogeneous entry = table[0];
+        for (std::size_t d = 1; d < table.size(); d++) {
+            const limb_t x = d ^ digit;
+            const limb_t mask = ((x | (0 - x)) >> 63) - 1;
+            entry.X = FieldElement::select(mask, table[d].X, entry.X);
+            entry.Y = FieldElement::select(mask, table[d].Y, entry.Y);
+            entry.Z = FieldElement::select(mask, table[d].Z, entry.Z);
+        }
+        r = complete_add(r, entry, this->a, b3, a_zero);
+    }
+
+    if (r.Z.is_zero()) {
+        return Point(this->a, this->b);
+    }
+    // homogeneous (X : Y : Z) is Jacobian (XZ : YZ^2 : Z)
+    const FieldElement zz = r.Z.square();
+    return Point(r.X * r.Z, r.Y * zz, r.Z, *this);
+}
+
+namespace {
+
+// x-only projective (X : Z) for the affine x = X / Z, the point at infinity (1 : 0)
+struct XOnly {
+    FieldElement X, Z;
+};
+
+// Brier and Joye, "Weierstrass elliptic curves and side-channel attacks"
+// (2002): x(P + Q) from x(P), x(Q) and the affine x of their difference, in the
+// form that adds x(P + Q) + x(P - Q), so it stays correct for x(P - Q) = 0.
+// 7M + 2S, and one more by a unless a = 0
+XOnly xonly_add(const XOnly& p, const XOnly& q, const FieldElement& x_diff, const FieldElement& a,
+                const FieldElement& b4, bool a_zero) {
+    const FieldElement xx = p.X * q.X, zz = p.Z * q.Z;
+    const FieldElement xz = p.X * q.Z, zx = q.X * p.Z;
+    FieldElement t = a_zero ? xx : xx + a * zz;
+    t *= xz + zx;
+    const FieldElement d = (xz - zx).square();
+    return {t + t + b4 * zz.square() - x_diff * d, d};
+}
+
+// x(2P) = (X^2 - aZ^2)^2 - 8bXZ^3, z(2P) = 4Z(X^3 + aXZ^2 + bZ^3); 7M + 3S,
+// and one more by a unless a = 0
+XOnly xonly_dbl(const XOnly& p, const FieldElement& a, const FieldElement& b, const FieldElement& b8,
+                bool a_zero) {
+    const FieldElement xx = p.X.square(), zz = p.Z.square();
+    const FieldElement azz = a_zero ? zz - zz : a * zz;
+    const FieldElement zzz = zz * p.Z;
+    FieldElement z = (p.X * (xx + azz) + b * zzz) * p.Z;
+    z += z;
+    z += z;
+    return {(xx - azz).square() - b8 * (p.X * zzz), z};
+}
+
+}
+
+Result<FieldElement> Point::mul_x(const integer& k, const FieldElement& x, const FieldElement& a,
+                                  const FieldElement& b) noexcept {
+    const PrimeField& field = x.prime_field();
+    if (&a.prime_field() != &field || &b.prime_field() != &field) {
+        return Status::field_mismatch;
+    }
+    const std::size_t bits = field.bits() + 1;
+    if (k < 0 || k.bit_length() > bits) {
+        return Status::out_of_range;
+    }
+    // an x of no point here is one of the quadratic twist, whose small
+    // subgroups would leak bits of k
+    if (!((x.square() + a) * x + b).is_square()) {
+        return Status::not_on_curve;
+    }
+
+    // every constant in x's representation, which sums take from the left
+    const FieldElement zero = x - x;
+    const FieldElement one = zero + FieldElement(1, field);
+    const FieldElement ca = zero + a, cb = zero + b;
+    const bool a_zero = a.is_zero();
+    const FieldElement b4 = (cb + cb) + (cb + cb);
+    const FieldElement b8 = b4 + b4;
+    XOnly r0{one, zero}, r1{x, one};
+
+    // the ladder keeps r1 - r0 = P: every step one addition and one doubling,
+    // with the pair swapped by mask where the bit changes
+    bool swapped = false;
+    for (std::size_t i = bits; i > 0; i--) {
+        const bool bit = k.test_bit(i - 1);
+        const limb_t mask = 0 - static_cast <limb_t> (bit ^ swapped);
+        swapped = bit;
+        XOnly t0{FieldElement::select(mask, r1.X, r0.X), FieldElement::select(mask, r1.Z, r0.Z)};
+        XOnly t1{FieldElement::select(mask, r0.X, r1.X), FieldElement::select(mask, r0.Z, r1.Z)};
+        r1 = xonly_add(t0, t1, x, ca, b4, a_zero);
+        r0 = xonly_dbl(t0, ca, cb, b8, a_zero);
+    }
+    const limb_t mask = 0 - static_cast <limb_t> (swapped);
+    const XOnly r{FieldElement::select(mask, r1.X, r0.X), FieldElement::select(mask, r1.Z, r0.Z)};
+
+    if (r.Z.is_zero()) {
+        return Status::infinity;
+    }
+    return r.X / r.Z;
+}
+
+FieldElement Point::mul_x(const integer& k) const {
+    if (k < 0 || k.bit_length() > this->Z.prime_field().bits() + 1) {
+        throw std::invalid_argument("Constant-time scalar must be non-negative and at most one bit longer than the prime");
+    }
+    Result<FieldElement> r = is_infinity() ? Result<FieldElement>(Status::infinity)
+                                           : mul_x(k, x(), this->a, this->b);
+    if (!r) {
+        throw_status(r.status(), "The point at infinity has no affine coordinates");
+    }
+    return std::move(*r);
+}
+
+// add-2007-bl: 11 multiplications and 5 squarings
+Point Point::add(const Point& other) const {
+    check_curve(other);
+    if (is_infinity()) {
+        return other;
+    }
+    if (other.is_infinity()) {
+        return *this;
+    }
+    if (other.z_one) {
+        return add_mixed(other);
+    }
+    if (this->z_one) {
+        return other.add_mixed(*this);
+    }
+
+    const FieldElement z1z1 = this->Z.square();
+    const FieldElement z2z2 = other.Z.square();
+    const FieldElement u1 = this->X * z2z2;
+    const FieldElement u2 = other.X * z1z1;
+    const FieldElement s1 = this->Y * other.Z * z2z2;
+    const FieldElement s2 = other.Y * this->Z * z1z1;
+    const FieldElement h = u2 - u1;
+    FieldElement r = s2 - s1;
+    if (h.is_zero()) {
+        // the same x: either the same point or its negation
+        return r.is_zero() ? dbl() : Point(this->X, this->Y, h, *this);      // h = 0: infinity
+    }
+
+    const FieldElement i = (h + h).square();
+    const FieldElement j = h * i;
+    r += r;
+    const FieldElement v = u1 * i;
+    const FieldElement x3 = r.square() - j - v - v;
+    const FieldElement s1j = s1 * j;
+    const FieldElement y3 = r * (v - x3) - s1j - s1j;
+    const FieldElement z3 = ((this->Z + other.Z).square() - z1z1 - z2z2) * h;
+    return Point(x3, y3, z3, *this);
+}
+
+// madd-2007-bl, for other.Z = 1: 7 multiplications and 4 squarings
+Point Point::add_mixed(const Point& other) const {
+    const FieldElement z1z1 = this->Z.square();
+    const FieldElement u2 = other.X * z1z1;
+    const FieldElement s2 = other.Y * this->Z * z1z1;
+    const FieldElement h = u2 - this->X;
+    FieldElement r = s2 - this->Y;
+    if (h.is_zero()) {
+        return r.is_zero() ? dbl() : Point(this->X, this->Y, h, *this);      // h = 0: infinity
+    }
+
+    const FieldElement hh = h.square();
+    FieldElement i = hh + hh;
+    i += i;
+    const FieldElement j = h * i;
+    r += r;
+    const FieldElement v = this->X * i;
+    const FieldElement x3 = r.square() - j - v - v;
+    const FieldElement yj = this->Y * j;
+    const FieldElement y3 = r * (v - x3) - yj - yj;
+    const FieldElement z3 = (this->Z + h).square() - z1z1 - hh;
+    return Point(x3, y3, z3, *this);
+}
+
+// Y = 0 gives Z3 = 0 in every formula, so points of order two double to
+// infinity by themselves
+Point Point::dbl() const {
+    if (is_infinity()) {
+        return *this;
+    }
+
+    if (this->form == a_form::zero) {
+        // dbl-2009-l
+        const FieldElement xx = this->X.square();
+        const FieldElement yy = this->Y.square();
+        const FieldElement yyyy = yy.square();
+        FieldElement d = (this->X + yy).square() - xx - yyyy;
+        d += d;
+        const FieldElement e = xx + xx + xx;
+        const FieldElement x3 = e.square() - d - d;
+        FieldElement yyyy8 = yyyy + yyyy;
+        yyyy8 += yyyy8;
+        yyyy8 += yyyy8;
+        const FieldElement y3 = e * (d - x3) - yyyy8;
+        const FieldElement yz = this->Y * this->Z;
+        return Point(x3, y3, yz + yz, *this);
+    }
+
+    if (this->form == a_form::minus_three) {
+        // dbl-2001-b: 3 * X^2 + a * Z^4 = 3 * (X - Z^2) * (X + Z^2)
+        const FieldElement delta = this->Z.square();
+        const FieldElement gamma = this->Y.square();
+        const FieldElement beta = this->X * gamma;
+        const FieldElement t = (this->X - delta) * (this->X + delta);
+        const FieldElement alpha = t + t + t;
+        FieldElement beta4 = beta + beta;
+        beta4 += beta4;
+        const FieldElement x3 = alpha.square() - beta4 - beta4;
+        const FieldElement z3 = (this->Y + this->Z).square() - gamma - delta;
+        FieldElement gamma8 = gamma.square();
+        gamma8 += gamma8;
+        gamma8 += gamma8;
+        gamma8 += gamma8;
+        const FieldElement y3 = alpha * (beta4 - x3) - gamma8;
+        return Point(x3, y3, z3, *this);
+    }
+
+    // dbl-2007-bl
+    const FieldElement xx = this->X.square();
+    const FieldElement yy = this->Y.square();
+    const FieldElement yyyy = yy.square();
+    const FieldElement zz = this->Z.square();
+    FieldElement s = (this->X + yy).square() - xx - yyyy;
+    s += s;
+    const FieldElement m = xx + xx + xx + this->a * zz.square();
+    const FieldElement x3 = m.square() - s - s;
+    FieldElement yyyy8 = yyyy + yyyy;
+    yyyy8 += yyyy8;
+    yyyy8 += yyyy8;
+    const FieldElement y3 = m * (s - x3) - yyyy8;
+    const FieldElement z3 = (this->Y + this->Z).square() - yy - zz;
+    return Point(x3, y3, z3, *this);
+}
+
+Point Point::neg() const {
+    return Point(this->X, (this->Y - this->Y) - this->Y, this->Z, *this, this->z_one);
+}
+
+bool operator==(const Point& lhs, const Point& rhs) {
+    if (lhs.a != rhs.a || lhs.b != rhs.b) {
+        return false;
+    }
+    if (lhs.is_infinity() || rhs.is_infinity()) {
+        return lhs.is_infinity() == rhs.is_infinity();
+    }
+    if (lhs.z_one && rhs.z_one) {
+        return lhs.X == rhs.X && lhs.Y == rhs.Y;
+    }
+    const Point::Affine* l = lhs.z_one ? nullptr : lhs.cache.load(std::memory_order_acquire);
+    const Point::Affine* r = rhs.z_one ? nullptr : rhs.cache.load(std::memory_order_acquire);
+    if ((lhs.z_one || l) && (rhs.z_one || r)) {
+        return (l ? l->x : lhs.X) == (r ? r->x : rhs.X) && (l ? l->y : lhs.Y) == (r ? r->y : rhs.Y);
+    }
+    // X1 / Z1^2 == X2 / Z2^2 and Y1 / Z1^3 == Y2 / Z2^3, cross multiplied
+    const FieldElement z1z1 = lhs.Z.square();
+    const FieldElement z2z2 = rhs.Z.square();
+    return lhs.X * z2z2 == rhs.X * z1z1 && lhs.Y * z2z2 * rhs.Z == rhs.Y * z1z1 * lhs.Z;
+}
+
+uint64_t Point::hash(uint64_t seed) const {
+    if (is_infinity()) {
+        return hash_mix(seed ^ this->a.hash(seed), this->b.hash(seed));
+    }
+    const std::pair<FieldElement, FieldElement> xy = affine();
+    return xy.second.hash(xy.first.hash(seed));
+}
+
+std::ostream& operator<<(std::ostream& os, const Point& p) {
+    if (p.is_infinity()) {
+        return os << "Point(infinity)";
+    }
+    const std::pair<FieldElement, FieldElement> xy = p.affine();
+    return os << "Point(" << xy.first.value() << ", " << xy.second.value() << ")";
+}
+
+void Point::check_curve(const Point& other) const {
+    if (this->a != other.a || this->b != other.b) {
+        throw std::runtime_error("Cannot add points on different curves");
+    }
+}
@@ -0,0 +1,233 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_POINT_H
+#define ECC_POINT_H
+
+#include <atomic>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "FieldElement.h"
+#include "Scalar.h"
+
+// A point of the curve y^2 = x^3 + ax + b over a prime field, kept in Jacobian
+// coordinates (X : Y : Z) for the affine point (X / Z^2, Y / Z^3), so adding
+// and doubling take field multiplications only; the one inversion is paid when
+// the affine coordinates are asked for. The point at infinity has Z = 0.
+// a, b and the coordinates must all be elements of the same field.
+// A point keeps the affine coordinates of its first inversion, so asking for
+// them again (x, y, hash, ==, serializing) costs nothing, and copies keep
+// them too. A point changes only by assignment, which replaces them with the
+// new point's. They are published atomically: a const Point may still be
+// read from many threads at once.
+class FixedBaseTable;
+class WnafTable;
+
+class Point {
+public:
+    // the point at infinity
+    Point(const FieldElement& a, const FieldElement& b);
+    // the affine point (x, y); throws std::invalid_argument if it is not on the curve
+    Point(const FieldElement& x, const FieldElement& y, const FieldElement& a, const FieldElement& b);
+    Point(const Point& other);
+    Point(Point&& other) noexcept;
+    Point& operator=(const Point& other);
+    Point& operator=(Point&& other) noexcept;
+    ~Point() { delete this->cache.load(std::memory_order_relaxed); }
+    // the same without exceptions: Status::field_mismatch unless all four are
+    // in one field, Status::not_on_curve
+    static Result<Point> make(const FieldElement& x, const FieldElement& y, const FieldElement& a, const FieldElement& b) noexcept;
+    // the point with Jacobian coordinates (X : Y : Z), checked by is_on_curve
+    // with no inversion: Status::field_mismatch unless all five are in one
+    // field, Status::not_on_curve. Z = 0 is the point at infinity
+    static Result<Point> make(const FieldElement& X, const FieldElement& Y, const FieldElement& Z,
+                              const FieldElement& a, const FieldElement& b) noexcept;
+
+    bool is_infinity() const { return this->Z.is_zero(); }
+    // Z = 1: set for points built from affine coordinates and by normalized()
+    bool is_normalized() const { return this->z_one; }
+    // the same point with Z = 1, one inversion; the point at infinity is returned as is
+    Point normalized() const;
+    const FieldElement& curve_a() const { return this->a; }
+    const FieldElement& curve_b() const { return this->b; }
+    // heap bytes held beyond sizeof(Point), by the coordinates and the
+    // curve's a and b: 0 on curves of up to 256 bits
+    std::size_t heap_bytes() const {
+        return this->X.heap_bytes() + this->Y.heap_bytes() + this->Z.heap_bytes()
+               + this->a.heap_bytes() + this->b.heap_bytes();
+    }
+
+    // affine coordinates with one inversion, none when normalized or asked
+    // for before; throw std::domain_error at infinity
+    std::pair<FieldElement, FieldElement> affine() const;
+    FieldElement x() const { return affine().first; }
+    FieldElement y() const { return affine().second; }
+    // whether x is the affine x of this point, tested as X = x Z^2 without
+    // the inversion of affine(); false at infinity
+    bool has_x(const FieldElement& x) const;
+    // Y^2 = X^3 + a X Z^4 + b Z^6, the curve's equation in Jacobian
+    // coordinates, so without the inversion of affine(); true at infinity.
+    // Points built by this class always are; this is for coordinates from
+    // elsewhere, or a fault check on a result
+    bool is_on_curve() const;
+
+    // every case is handled: either point at infinity, P + P and P + (-P);
+    // points must be on the same curve. A normalized operand takes the mixed
+    // formula, 7 multiplications and 4 squarings instead of 11 and 5
+    Point add(const Point& other) const;
+    // specialized for a = 0 (2M + 5S) and a = -3 (3M + 5S), generic otherwise
+    Point dbl() const;
+    Point neg() const;
+
+    // k * P by width-w NAF (w from 2 to 8): the odd multiples P, 3P, ..,
+    // (2^(w - 1) - 1)P are normalized together with one inversion, so every
+    // addition is mixed; about bits / (w + 1) of them. Negative k gives -(|k| P).
+    // On secp256k1 k is first split as k1 + k2 * lambda with 128-bit halves
+    // (GLV, Scalar::split_lambda), and k1 * P + k2 * lambda(P) share one run of 128 doublings; lambda(P)
+    // is (beta * x, y), so its table is P's with x scaled. Not constant time.
+    Point mul(const integer& k, std::size_t w = 5) const;
+    // the same for k mod the order of P, as signatures compute it
+    Point mul(const Scalar& k, std::size_t w = 5) const { return mul(k.value(), w); }
+    // k * P for secret k, 0 <= k < 2^(bits of the prime + 1), which covers any
+    // group order: 4-bit windows from the top, each 4 doublings and one addition
+    // of the multiple read by scanning all of 0P, .., 15P with masks, in the
+    // complete formulas of Renes, Costello and Batina (homogeneous coordinates,
+    // no exceptional cases on curves of odd order, such as every prime order
+    // curve, so no branch on any intermediate point). The
+    // sequence of field operations depends on the prime alone, but the field
+    // reductions underneath still branch on their values, so the guarantee
+    // stops at the point layer. Throws std::invalid_argument for k out of range
+    Point mul_ct(const integer& k) const;
+    // x(k * P) for secret k in the same range as mul_ct, by the x-only
+    // Montgomery ladder of Brier and Joye: projective (X : Z) pairs, one
+    // differential addition and one doubling per bit whatever the bit, 14M + 5S
+    // (16M + 5S unless a = 0), the pair swapped by mask. y is never computed, so
+    // P and -P give the same x, and the point at infinity throws std::domain_error
+    FieldElement mul_x(const integer& k) const;
+    // the same from the affine x alone, as in x-only keys and ECDH: the
+    // y^2 = x^3 + ax + b with no y (x on the quadratic twist) is Status::not_on_curve,
+    // k * P at infinity Status::infinity, k out of range Status::out_of_range
+    static Result<FieldElement> mul_x(const integer& k, const FieldElement& x, const FieldElement& a,
+                                      const FieldElement& b) noexcept;
+    // u1 * G + u2 * Q by interleaved wNAF (Strauss-Shamir): both tables are
+    // normalized with one inversion and the two scalars (four GLV halves on
+    // secp256k1) share a single run of doublings
+    static Point mul_add(const integer& u1, const Point& g, const integer& u2, const Point& q, std::size_t w = 5);
+    // sum of k[i] * P[i] by the same interleaving, one table per point and one
+    // inversion for all of them; the cheapest for a few terms, see msm.h for many.
+    // Throws std::invalid_argument on empty input or sizes that differ
+    static Point mul_sum(const std::vector<integer>& k, const std::vector<Point>& p, std::size_t w = 5);
+    // the same with u1 * G read from a precomputed table, which needs no
+    // doublings, so only u2 * Q pays for a doubling run
+    static Point mul_add(const integer& u1, const FixedBaseTable& g, const integer& u2, const Point& q);
+    // the tables mul and mul_add build for P on every call, kept (WnafTable)
+    WnafTable wnaf_table(std::size_t w = 5) const;
+    // u1 * G + u2 * Q by the interleaved wNAF of mul_add with both tables
+    // made already, so only the digits and the doublings are left; throws
+    // std::runtime_error for tables of different curves
+    static Point mul_add(const integer& u1, const WnafTable& g, const integer& u2, const WnafTable& q);
+    // Z = 1 for every point with one inversion (Montgomery's trick), none for
+    // those whose affine coordinates are known already; points at infinity
+    // are left as they are
+    static void batch_normalize(std::vector<Point>& points);
+    static void batch_normalize(Point* points, std::size_t count);
+    // the count points at points, the denominators on scratch
+    static void batch_normalize(Point* points, std::size_t count, Scratch& scratch);
+    // out[i] = a[i] + b[i] in affine coordinates, the slope denominators of all
+    // pairs inverted together, then 2 multiplications and 1 squaring per sum
+    // instead of the 7M + 4S of a mixed addition, and the sum is normalized.
+    // Pairs the chord formula does not cover (an operand at infinity or
+    // not normalized, equal x) take add(). out, which may be a or b, gets
+    // a.size() points; throws std::invalid_argument if b has a different size
+    static void batch_add(const std::vector<Point>& a, const std::vector<Point>& b, std::vector<Point>& out);
+
+    Point operator+(const Point& other) const { return add(other); }
+    Point operator-(const Point& other) const { return add(other.neg()); }
+    Point operator-() const { return neg(); }
+    Point& operator+=(const Point& other) { return *this = add(other); }
+    Point& operator-=(const Point& other) { return *this = add(other.neg()); }
+    Point operator*(const integer& k) const { return mul(k); }
+    friend Point operator*(const integer& k, const Point& p) { return p.mul(k); }
+
+    // the same affine point (or both at infinity) on the same curve,
+    // compared without inversions; two normalized points compare X and Y
+    friend bool operator==(const Point& lhs, const Point& rhs);
+    friend bool operator!=(const Point& lhs, const Point& rhs) { return !(lhs == rhs); }
+    // the affine x then y hashed under seed, so equal points hash alike
+    // however they are held; one inversion unless normalized
+    uint64_t hash(uint64_t seed) const;
+    friend std::ostream& operator<<(std::ostream& os, const Point& p);
+
+private:
+    // rebuilds its entries from raw coordinates
+    friend class FixedBaseTable;
+
+    // the doubling formula a allows
+    enum class a_form { zero, minus_three, generic };
+    struct Affine {
+        FieldElement x, y;
+    };
+
+    FieldElement X, Y, Z;
+    FieldElement a, b;
+    a_form form;
+    bool z_one;
+    // the affine coordinates once computed, never for a normalized point
+    mutable std::atomic<const Affine*> cache;
+
+    Point(const FieldElement& X, const FieldElement& Y, const FieldElement& Z, const Point& curve, bool z_one = false);
+    // Status::ok where the affine constructor accepts its arguments
+    static Status check_affine(const FieldElement& x, const FieldElement& y, const FieldElement& a, const FieldElement& b) noexcept;
+    static a_form classify(const FieldElement& a);
+    // a copy of other's cached coordinates, or null
+    static const Affine* copy_cache(const Point& other);
+    bool is_secp256k1() const;
+    // odd[i] = (2i + 1) * P for i < 2^(w - 2), not normalized
+    std::vector<Point> odd_multiples(std::size_t w) const;
+    // appends the tables of P given its normalized odd multiples: those, and
+    // on secp256k1 those of lambda(P) for the second GLV half
+    void wnaf_tables(std::vector<Point>&& odd, std::vector<std::vector<Point>>& tables) const;
+    // appends the wNAF digits of k * P, one stream per table of wnaf_tables
+    void wnaf_digits(const integer& k, std::size_t w, std::vector<std::vector<int>>& digits) const;
+    // sum of the wNAF digits[j] applied to the normalized *tables[j], with
+    // one shared run of doublings
+    static Point wnaf_sum(const std::vector<const std::vector<Point>*>& tables,
+                          const std::vector<std::vector<int>>& digits, const Point& curve);
+    void check_curve(const Point& other) const;
+    Point add_mixed(const Point& other) const;
+};
+
+// P's odd multiples P, 3P, .., (2^(w - 1) - 1)P for width-w NAF, normalized
+// with one inversion, and on secp256k1 those of lambda(P) as well: the tables
+// Point::mul and Point::mul_add build on every call, kept for a point that is
+// multiplied again and again, such as the generator (Curve::generator_wnaf)
+// or a busy public key (KeyTableCache). Made by Point::wnaf_table
+class WnafTable {
+public:
+    const Point& base() const { return this->tables[0][0]; }
+    std::size_t window() const { return this->w; }
+    // the points held, over all the tables
+    std::size_t size() const;
+    // bytes held, the points' heap bytes included
+    std::size_t memory() const;
+
+private:
+    friend class Point;
+
+    std::size_t w;
+    std::vector<std::vector<Point>> tables;
+
+    WnafTable(std::size_t w, std::vector<std::vector<Point>>&& tables) : w(w), tables(std::move(tables)) {}
+};
+
+namespace std {
+template <>
+struct hash<Point> {
+    std::size_t operator()(const Point& p) const { return static_cast<std::size_t>(p.hash(hash_seed())); }
+};
+}
+
+#endif //ECC_POINT_H
@@ -0,0 +1,638 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "FieldExpression.h"
+#include "Polynomial.h"
+#include "Status.h"
+
+namespace {
+
+typedef std::vector<FieldElement> terms;
+
+// tables of up to this many points are kept once built, larger ones built per call
+const std::size_t NTT_TABLE_CACHE_POINTS = std::size_t(1) << 20;
+// points per task when evaluate splits its points over an executor
+const std::size_t EVALUATE_MIN_CHUNK = 64;
+
+std::size_t log2_ceil(std::size_t n) {
+    std::size_t k = 0;
+    while ((std::size_t(1) << k) < n) {
+        k++;
+    }
+    return k;
+}
+
+// out[0, na + nb - 1) += a[0, na) * b[0, nb)
+void schoolbook(FieldElement* out, const FieldElement* a, std::size_t na, const FieldElement* b, std::size_t nb) {
+    for (std::size_t i = 0; i < na; i++) {
+        if (a[i].is_zero()) {
+            continue;
+        }
+        for (std::size_t j = 0; j < nb; j++) {
+            out[i + j] += a[i] * b[j];
+        }
+    }
+}
+
+// out[0, 2n - 1) += a[0, n) * b[0, n): with a = a0 + a1 x^m and b likewise,
+//     a b = z0 + ((a0 + a1)(b0 + b1) - z0 - z2) x^m + z2 x^2m
+// for z0 = a0 b0 and z2 = a1 b1, three half-size products instead of four
+void karatsuba(FieldElement* out, const FieldElement* a, const FieldElement* b, std::size_t n) {
+    if (n < Polynomial::SCHOOLBOOK_THRESHOLD) {
+        schoolbook(out, a, n, b, n);
+        return;
+    }
+    const std::size_t m = n / 2, h = n - m;
+    const FieldElement zero(0, a[0].prime_field());
+    terms z0(2 * m - 1, zero), z2(2 * h - 1, zero), z1(2 * h - 1, zero);
+    karatsuba(z0.data(), a, b, m);
+    karatsuba(z2.data(), a + m, b + m, h);
+    terms sa(a + m, a + n), sb(b + m, b + n);
+    for (std::size_t i = 0; i < m; i++) {
+        sa[i] += a[i];
+        sb[i] += b[i];
+    }
+    karatsuba(z1.data(), sa.data(), sb.data(), h);
+    for (std::size_t i = 0; i < z0.size(); i++) {
+        z1[i] -= z0[i];
+        out[i] += z0[i];
+    }
+    for (std::size_t i = 0; i < z2.size(); i++) {
+        z1[i] -= z2[i];
+        out[i + 2 * m] += z2[i];
+    }
+    for (std::size_t i = 0; i < z1.size(); i++) {
+        out[i + m] += z1[i];
+    }
+}
+
+// the shorter factor against blocks of the longer one of its own length, so
+// an unbalanced product does not pad the short factor out
+terms karatsuba_product(const terms& a, const terms& b) {
+    const terms& lo = a.size() <= b.size() ? a : b;
+    const terms& hi = a.size() <= b.size() ? b : a;
+    const std::size_t n = lo.size();
+    const FieldElement zero(0, lo[0].prime_field());
+    terms out(a.size() + b.size() - 1 + n, zero);
+    terms block(n, zero);
+    for (std::size_t i = 0; i < hi.size(); i += n) {
+        const std::size_t len = std::min(n, hi.size() - i);
+        std::copy(hi.begin() + i, hi.begin() + i + len, block.begin());
+        std::fill(block.begin() + len, block.end(), zero);
+        karatsuba(out.data() + i, block.data(), lo.data(), n);
+    }
+    out.resize(a.size() + b.size() - 1, zero);
+    return out;
+}
+
+// w^0, .., w^(n/2 - 1) for w a primitive n-th root of unity: g = z^odd for the
+// non-residue z has order exactly 2^s, and w = g^(2^(s - log2 n))
+std::shared_ptr<const terms> make_ntt_table(const PrimeField& field, std::size_t n) {
+    const FieldElement g = FieldElement(field.non_residue(), field).power(field.odd_part());
+    FieldElement w = g;
+    for (std::size_t i = log2_ceil(n); i < field.two_adicity(); i++) {
+        w = w.square();
+    }
+    auto table = std::make_shared<terms>();
+    table->reserve(n / 2);
+    FieldElement t(1, field);
+    for (std::size_t i = 0; i < n / 2; i++) {
+        table->push_back(t);
+        t *= w;
+    }
+    return table;
+}
+
+// the table for transforms of n points over field, built on first use and
+// then shared read-only by every thread
+std::shared_ptr<const terms> ntt_table(const PrimeField& field, std::size_t n) {
+    if (n > NTT_TABLE_CACHE_POINTS) {
+        return make_ntt_table(field, n);
+    }
+    static std::mutex lock;
+    static std::map<std::pair<const PrimeField*, std::size_t>, std::shared_ptr<const terms>> tables;
+    const std::lock_guard<std::mutex> guard(lock);
+    std::shared_ptr<const terms>& table = tables[std::make_pair(&field, n)];
+    if (!table) {
+        table = make_ntt_table(field, n);
+    }
+    return table;
+}
+
+// in place a[k] = sum_i a[i] w^(ik) for n = a.size(), a power of two:
+// bit-reversal permutation, then radix-2 butterflies
+void ntt(terms& a, const terms& w) {
+    const std::size_t n = a.size();
+    for (std::size_t i = 1, j = 0; i < n; i++) {
+        std::size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(a[i], a[j]);
+        }
+    }
+    for (std::size_t len = 2; len <= n; len <<= 1) {
+        const std::size_t half = len / 2, stride = n / len;
+        for (std::size_t i = 0; i < n; i += len) {
+            for (std::size_t j = 0; j < half; j++) {
+                FieldElement v = a[i + j + half] * w[j * stride];
+                a[i + j + half] = a[i + j];
+                a[i + j + half] -= v;
+                a[i + j] += v;
+            }
+        }
+    }
+}
+
+// the inverse transform is the forward one with the outputs 1, .., n - 1 in
+// reverse order (w^-k = w^(n - k)), then scaled by 1 / n
+void inverse_ntt(terms& a, const terms& w) {
+    ntt(a, w);
+    std::reverse(a.begin() + 1, a.end());
+    const FieldElement scale = FieldElement(1, a[0].prime_field()) / FieldElement(integer(a.size()), a[0].prime_field());
+    for (FieldElement& x : a) {
+        x *= scale;
+    }
+}
+
+terms ntt_product(const terms& a, const terms& b) {
+    const PrimeField& field = a[0].prime_field();
+    const std::size_t size = a.size() + b.size() - 1;
+    const std::size_t n = std::size_t(1) << log2_ceil(size);
+    const std::shared_ptr<const terms> w = ntt_table(field, n);
+    const FieldElement zero(0, field);
+    terms fa(a);
+    fa.resize(n, zero);
+    ntt(fa, *w);
+    if (&a == &b) {
+        for (FieldElement& x : fa) {
+            x = x.square();
+        }
+    } else {
+        terms fb(b);
+        fb.resize(n, zero);
+        ntt(fb, *w);
+        for (std::size_t i = 0; i < n; i++) {
+            fa[i] *= fb[i];
+        }
+    }
+    inverse_ntt(fa, *w);
+    fa.resize(size, zero);
+    return fa;
+}
+
+// throws unless xs and ys pair up, nonempty, all of one field
+void check_points(const terms& xs, const terms& ys) {
+    if (xs.empty() || xs.size() != ys.size()) {
+        throw std::invalid_argument("Interpolation needs one value for each of at least one point");
+    }
+    for (std::size_t i = 0; i < xs.size(); i++) {
+        if (&xs[i].prime_field() != &xs[0].prime_field() || &ys[i].prime_field() != &xs[0].prime_field()) {
+            throw_status(Status::field_mismatch, "Cannot interpolate numbers in different fields");
+        }
+    }
+}
+
+// w_j = prod_(k != j) (x_j - x_k), still to be inverted
+terms barycentric_denominators(const terms& xs) {
+    terms d(xs.size(), FieldElement(1, xs[0].prime_field()));
+    for (std::size_t j = 0; j < xs.size(); j++) {
+        for (std::size_t k = 0; k < xs.size(); k++) {
+            if (k != j) {
+                d[j] *= xs[j] - xs[k];
+            }
+        }
+        if (d[j].is_zero()) {
+            throw std::invalid_argument("Interpolation points must be distinct");
+        }
+    }
+    return d;
+}
+
+// the coefficients of x^0, .., x^(n - 1) of p, zero padded
+terms truncated(const terms& p, std::size_t n, const FieldElement& zero) {
+    terms out(p.begin(), p.begin() + std::min(n, p.size()));
+    out.resize(n, zero);
+    return out;
+}
+
+// a * b for nonempty a and b of one field
+terms product(const terms& a, const terms& b) {
+    if (std::min(a.size(), b.size()) < Polynomial::SCHOOLBOOK_THRESHOLD) {
+        terms out(a.size() + b.size() - 1, FieldElement(0, a[0].prime_field()));
+        schoolbook(out.data(), a.data(), a.size(), b.data(), b.size());
+        return out;
+    }
+    if (ntt_friendly(a[0].prime_field(), a.size() + b.size() - 1)) {
+        return ntt_product(a, b);
+    }
+    return karatsuba_product(a, b);
+}
+
+// the quotient of a by a divisor of nb coefficients, from inv, 1 / rev(divisor)
+// to at least m = a.size() - nb + 1 coefficients: rev(q) = rev(a) inv mod x^m
+terms newton_quotient(const terms& a, std::size_t nb, const terms& inv) {
+    const std::size_t m = a.size() - nb + 1;
+    const FieldElement zero(0, a[0].prime_field());
+    const terms ra(a.rbegin(), a.rbegin() + m);
+    terms q = product(ra, truncated(inv, m, zero));
+    q.resize(m, zero);
+    std::reverse(q.begin(), q.end());
+    return q;
+}
+
+}
+
+bool ntt_friendly(const PrimeField& field, std::size_t n) {
+    return field.is_prime() && log2_ceil(n) <= field.two_adicity();
+}
+
+Polynomial::Polynomial(const PrimeField& field) : field(&field) {
+}
+
+Polynomial::Polynomial(const PrimeField& field, std::vector<FieldElement> coefficients)
+        : field(&field), c(std::move(coefficients)) {
+    for (const FieldElement& x : this->c) {
+        if (&x.prime_field() != this->field) {
+            throw_status(Status::field_mismatch, "Cannot build a polynomial from numbers in different fields");
+        }
+    }
+    trim();
+}
+
+Polynomial Polynomial::constant(const FieldElement& c) {
+    return Polynomial(c.prime_field(), {c});
+}
+
+Polynomial Polynomial::linear(const FieldElement& root) {
+    return Polynomial(root.prime_field(), {-lazy(root), FieldElement(1, root.prime_field())});
+}
+
+void Polynomial::check_field(const Polynomial& other) const {
+    if (this->field != other.field) {
+        throw_status(Status::field_mismatch, "Cannot combine polynomials over different fields");
+    }
+}
+
+void Polynomial::trim() {
+    while (!this->c.empty() && this->c.back().is_zero()) {
+        this->c.pop_back();
+    }
+}
+
+FieldElement Polynomial::operator[](std::size_t i) const {
+    return i < this->c.size() ? this->c[i] : FieldElement(0, *this->field);
+}
+
+FieldElement Polynomial::evaluate(const FieldElement& x) const {
+    if (&x.prime_field() != this->field) {
+        throw_status(Status::field_mismatch, "Cannot evaluate a polynomial at a number of another field");
+    }
+    FieldElement out(0, *this->field);
+    for (std::size_t i = this->c.size(); i-- > 0;) {
+        out *= x;
+        out += this->c[i];
+    }
+    return out;
+}
+
+std::vector<FieldElement> Polynomial::evaluate(const std::vector<FieldElement>& points, unsigned threads) const {
+    ThreadExecutor executor(threads);
+    return evaluate(points, executor);
+}
+
+std::vector<FieldElement> Polynomial::evaluate(const std::vector<FieldElement>& points, Executor& executor) const {
+    for (const FieldElement& x : points) {
+        if (&x.prime_field() != this->field) {
+            throw_status(Status::field_mismatch, "Cannot evaluate a polynomial at a number of another field");
+        }
+    }
+    const std::size_t count = points.size();
+    std::vector<FieldElement> out(count, FieldElement(0, *this->field));
+    const std::size_t chunks = std::max<std::size_t>(1, std::min(executor.concurrency(), count / EVALUATE_MIN_CHUNK));
+    const std::size_t size = (count + chunks - 1) / chunks;
+    executor.run(chunks, [this, &points, &out, count, size](std::size_t chunk) {
+        const std::size_t first = chunk * size, last = std::min(count, first + size);
+        for (std::size_t i = this->c.size(); i-- > 0;) {
+            const FieldElement& ci = this->c[i];
+            for (std::size_t j = first; j < last; j++) {
+                out[j] *= points[j];
+                out[j] += ci;
+            }
+        }
+    });
+    return out;
+}
+
+Polynomial& Polynomial::operator+=(const Polynomial& other) {
+    check_field(other);
+    if (this->c.size() < other.c.size()) {
+        this->c.resize(other.c.size(), FieldElement(0, *this->field));
+    }
+    for (std::size_t i = 0; i < other.c.size(); i++) {
+        this->c[i] += other.c[i];
+    }
+    trim();
+    return *this;
+}
+
+Polynomial& Polynomial::operator-=(const Polynomial& other) {
+    check_field(other);
+    if (this->c.size() < other.c.size()) {
+        this->c.resize(other.c.size(), FieldElement(0, *this->field));
+    }
+    for (std::size_t i = 0; i < other.c.size(); i++) {
+        this->c[i] -= other.c[i];
+    }
+    trim();
+    return *this;
+}
+
+Polynomial& Polynomial::operator*=(const FieldElement& k) {
+    if (&k.prime_field() != this->field) {
+        throw_status(Status::field_mismatch, "Cannot scale a polynomial by a number of another field");
+    }
+    if (k.is_zero()) {
+        this->c.clear();
+    }
+    for (FieldElement& x : this->c) {
+        x *= k;
+    }
+    return *this;
+}
+
+Polynomial Polynomial::operator-() const {
+    Polynomial out(*this);
+    for (FieldElement& x : out.c) {
+        x = -lazy(x);
+    }
+    return out;
+}
+
+Polynomial Polynomial::derivative() const {
+    terms d;
+    for (std::size_t i = 1; i < this->c.size(); i++) {
+        d.push_back(this->c[i] * integer(static_cast<uint64_t>(i)));
+    }
+    return Polynomial(*this->field, std::move(d));
+}
+
+Polynomial operator*(const Polynomial& lhs, const Polynomial& rhs) {
+    lhs.check_field(rhs);
+    if (lhs.is_zero() || rhs.is_zero()) {
+        return Polynomial(*lhs.field);
+    }
+    return Polynomial(*lhs.field, product(lhs.c, rhs.c));
+}
+
+// Newton's iteration g <- g (2 - f g) mod x^2k doubles the number of correct
+// coefficients of 1 / f each step, from g = 1 / f_0
+Polynomial Polynomial::inverse_series(std::size_t n) const {
+    if (this->c.empty() || this->c[0].is_zero()) {
+        throw_status(Status::division_by_zero, "Power series with a zero constant term has no inverse");
+    }
+    const FieldElement zero(0, *this->field), two(2, *this->field);
+    terms g = {FieldElement(1, *this->field) / this->c[0]};
+    for (std::size_t k = 1; k < n;) {
+        k = std::min(2 * k, n);
+        terms t = truncated(product(truncated(this->c, k, zero), g), k, zero);
+        for (FieldElement& x : t) {
+            x = -lazy(x);
+        }
+        t[0] += two;
+        g = truncated(product(g, t), k, zero);
+    }
+    return Polynomial(*this->field, truncated(g, n, zero));
+}
+
+// with q of m = deg a - deg b + 1 coefficients, reversing the coefficients
+// turns a = b q + r into rev(a) = rev(b) rev(q) mod x^m, so rev(q) is rev(a)
+// times the first m coefficients of 1 / rev(b), and r = a - b q
+std::pair<Polynomial, Polynomial> Polynomial::divmod(const Polynomial& divisor) const {
+    check_field(divisor);
+    if (divisor.is_zero()) {
+        throw_status(Status::division_by_zero, "Cannot divide by the zero polynomial");
+    }
+    if (this->degree() < divisor.degree()) {
+        return {Polynomial(*this->field), *this};
+    }
+    const FieldElement zero(0, *this->field);
+    const std::size_t nb = divisor.c.size(), m = this->c.size() - nb + 1;
+    if (std::min(m, nb) < SCHOOLBOOK_THRESHOLD) {
+        terms r(this->c), q(m, zero);
+        const FieldElement inv = FieldElement(1, *this->field) / divisor.c.back();
+        for (std::size_t i = m; i-- > 0;) {
+            q[i] = r[i + nb - 1] * inv;
+            if (q[i].is_zero()) {
+                continue;
+            }
+            for (std::size_t j = 0; j < nb; j++) {
+                r[i + j] -= q[i] * divisor.c[j];
+            }
+        }
+        r.resize(nb - 1, zero);
+        return {Polynomial(*this->field, std::move(q)), Polynomial(*this->field, std::move(r))};
+    }
+    const Polynomial inv = Polynomial(*this->field, terms(divisor.c.rbegin(), divisor.c.rend())).inverse_series(m);
+    Polynomial quotient(*this->field, newton_quotient(this->c, nb, inv.c));
+    Polynomial remainder = *this - divisor * quotient;
+    return {std::move(quotient), std::move(remainder)};
+}
+
+bool operator==(const Polynomial& lhs, const Polynomial& rhs) {
+    return lhs.field == rhs.field && lhs.c == rhs.c;
+}
+
+std::ostream& operator<<(std::ostream& os, const Polynomial& p) {
+    os << "Polynomial(";
+    for (std::size_t i = 0; i < p.c.size(); i++) {
+        os << (i ? ", " : "") << p.c[i].value();
+    }
+    return os << ")";
+}
+
+// SubproductTree
+
+SubproductTree::SubproductTree(std::vector<FieldElement> points) : xs(std::move(points)) {
+    if (this->xs.empty()) {
+        throw std::invalid_argument("Subproduct tree needs at least one point");
+    }
+    this->field = &this->xs[0].prime_field();
+    std::vector<Polynomial> level;
+    level.reserve(this->xs.size());
+    for (const FieldElement& x : this->xs) {
+        if (&x.prime_field() != this->field) {
+            throw_status(Status::field_mismatch, "Cannot build a subproduct tree from numbers in different fields");
+        }
+        level.push_back(Polynomial::linear(x));
+    }
+    this->levels.push_back(std::move(level));
+    while (this->levels.back().size() > 1) {
+        const std::vector<Polynomial>& below = this->levels.back();
+        std::vector<Polynomial> above;
+        above.reserve((below.size() + 1) / 2);
+        for (std::size_t i = 0; i + 1 < below.size(); i += 2) {
+            above.push_back(below[i] * below[i + 1]);
+        }
+        if (below.size() % 2) {
+            above.push_back(below.back());
+        }
+        this->levels.push_back(std::move(above));
+    }
+}
+
+void SubproductTree::evaluate(std::size_t level, std::size_t index, const Polynomial& r,
+                              std::vector<FieldElement>& out) const {
+    const std::size_t first = index << level, last = std::min(this->xs.size(), (index + 1) << level);
+    if (last - first < HORNER_POINTS) {
+        for (std::size_t i = first; i < last; i++) {
+            out[i] = r.evaluate(this->xs[i]);
+        }
+        return;
+    }
+    const std::vector<Polynomial>& below = this->levels[level - 1];
+    for (std::size_t child = 2 * index; child < std::min(2 * index + 2, below.size()); child++) {
+        const Polynomial& node = below[child];
+        if (r.degree() < node.degree()) {
+            evaluate(level - 1, child, r, out);
+        } else if (this->inverses.empty() || node.degree() < static_cast<long>(Polynomial::SCHOOLBOOK_THRESHOLD)) {
+            evaluate(level - 1, child, r % node, out);
+        } else {
+            const Polynomial q(*this->field, newton_quotient(r.coefficients(), node.coefficients().size(),
+                                                              this->inverses[level - 1][child].coefficients()));
+            evaluate(level - 1, child, r - node * q, out);
+        }
+    }
+}
+
+std::vector<FieldElement> SubproductTree::evaluate(const Polynomial& p) const {
+    if (&p.prime_field() != this->field) {
+        throw_status(Status::field_mismatch, "Cannot evaluate a polynomial at numbers of another field");
+    }
+    // 1 / rev(node) to as many coefficients as the quotients by the node have,
+    // at most the degree of its sibling
+    std::call_once(this->inverses_once, [this]() {
+        for (std::size_t l = 0; l + 1 < this->levels.size(); l++) {
+            const std::vector<Polynomial>& level = this->levels[l];
+            std::vector<Polynomial> inv;
+            for (std::size_t i = 0; i < level.size(); i++) {
+                const terms& c = level[i].coefficients();
+                const std::size_t sibling = (i ^ 1) < level.size() ? level[i ^ 1].degree() : 0;
+                inv.push_back(Polynomial(*this->field, terms(c.rbegin(), c.rend())).inverse_series(sibling + 1));
+            }
+            this->inverses.push_back(std::move(inv));
+        }
+    });
+    std::vector<FieldElement> out(this->xs.size(), FieldElement(0, *this->field));
+    evaluate(this->levels.size() - 1, 0, p % root(), out);
+    return out;
+}
+
+Polynomial SubproductTree::interpolate(const std::vector<FieldElement>& values) const {
+    check_points(this->xs, values);
+    std::call_once(this->weights_once, [this]() {
+        // without the inverses, which one evaluation does not pay for
+        terms w(this->xs.size(), FieldElement(0, *this->field));
+        evaluate(this->levels.size() - 1, 0, root().derivative(), w);
+        for (const FieldElement& x : w) {
+            if (x.is_zero()) {
+                throw std::invalid_argument("Interpolation points must be distinct");
+            }
+        }
+        FieldElement::batch_invert(w);
+        this->weights = std::move(w);
+    });
+    std::vector<Polynomial> sums;
+    sums.reserve(this->xs.size());
+    for (std::size_t i = 0; i < this->xs.size(); i++) {
+        sums.push_back(Polynomial::constant(values[i] * this->weights[i]));
+    }
+    // a node's sum is its left child's times the right product plus the
+    // right child's times the left product
+    for (std::size_t l = 1; l < this->levels.size(); l++) {
+        const std::vector<Polynomial>& below = this->levels[l - 1];
+        std::vector<Polynomial> above;
+        above.reserve(this->levels[l].size());
+        for (std::size_t i = 0; i + 1 < sums.size(); i += 2) {
+            above.push_back(sums[i] * below[i + 1] + sums[i + 1] * below[i]);
+        }
+        if (sums.size() % 2) {
+            above.push_back(std::move(sums.back()));
+        }
+        sums = std::move(above);
+    }
+    return std::move(sums.front());
+}
+
+Polynomial lagrange_interpolate(const std::vector<FieldElement>& xs, const std::vector<FieldElement>& ys) {
+    check_points(xs, ys);
+    const PrimeField& field = xs[0].prime_field();
+    const std::size_t n = xs.size();
+    terms w = barycentric_denominators(xs);
+    FieldElement::batch_invert(w);
+    // M = prod (x - x_k), one linear factor at a time
+    terms m(n + 1, FieldElement(0, field));
+    m[0] = FieldElement(1, field);
+    for (std::size_t k = 0; k < n; k++) {
+        for (std::size_t i = k + 1; i > 0; i--) {
+            m[i] = m[i - 1] - m[i] * xs[k];
+        }
+        m[0] = -lazy(m[0] * xs[k]);
+    }
+    terms out(n, FieldElement(0, field));
+    for (std::size_t j = 0; j < n; j++) {
+        if (ys[j].is_zero()) {
+            continue;
+        }
+        const FieldElement scale = ys[j] * w[j];
+        // M / (x - x_j) from the top: q_(i - 1) = m_i + x_j q_i
+        FieldElement q = m[n];
+        for (std::size_t i = n; i-- > 0;) {
+            out[i] += scale * q;
+            q *= xs[j];
+            q += m[i];
+        }
+    }
+    return Polynomial(field, std::move(out));
+}
+
+FieldElement lagrange_evaluate(const std::vector<FieldElement>& xs, const std::vector<FieldElement>& ys,
+                               const FieldElement& x) {
+    check_points(xs, ys);
+    if (&x.prime_field() != &xs[0].prime_field()) {
+        throw_status(Status::field_mismatch, "Cannot interpolate numbers in different fields");
+    }
+    const std::size_t n = xs.size();
+    terms d = barycentric_denominators(xs);
+    FieldElement m(1, x.prime_field());
+    for (std::size_t j = 0; j < n; j++) {
+        FieldElement t = x - xs[j];
+        if (t.is_zero()) {
+            return ys[j];
+        }
+        m *= t;
+        d.push_back(std::move(t));
+    }
+    FieldElement::batch_invert(d);
+    FieldElement sum(0, x.prime_field());
+    for (std::size_t j = 0; j < n; j++) {
+        sum += ys[j] * d[j] * d[n + j];
+    }
+    return sum * m;
+}
+
+Polynomial interpolate(const std::vector<FieldElement>& xs, const std::vector<FieldElement>& ys) {
+    if (xs.size() < INTERPOLATE_TREE_POINTS) {
+        return lagrange_interpolate(xs, ys);
+    }
+    return SubproductTree(xs).interpolate(ys);
+}
@@ -0,0 +1,164 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_POLYNOMIAL_H
+#define ECC_POLYNOMIAL_H
+
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "Executor.h"
+#include "FieldElement.h"
+#include "PrimeField.h"
+
+// A polynomial over a PrimeField, the coefficients lowest degree first with
+// no zero at the top, so the zero polynomial has none. Products pick their
+// algorithm by size: schoolbook for short factors, a number-theoretic
+// transform where the field has a root of unity of the power of two order the
+// product needs (p - 1 divisible by it: 2^32 for the BLS12-381 group order),
+// and Karatsuba elsewhere (the secp256k1 group order has only 2^6). Quotients
+// come from a Newton iteration for the inverse of the reversed divisor, two
+// products a doubling, and schoolbook long division for short quotients.
+// Not constant time.
+class Polynomial {
+public:
+    // factors with fewer coefficients than this multiply by schoolbook
+    static constexpr std::size_t SCHOOLBOOK_THRESHOLD = 32;
+
+    // the zero polynomial
+    explicit Polynomial(const PrimeField& field);
+    // throws std::runtime_error unless every coefficient belongs to field
+    Polynomial(const PrimeField& field, std::vector<FieldElement> coefficients);
+    static Polynomial constant(const FieldElement& c);
+    // x - root
+    static Polynomial linear(const FieldElement& root);
+
+    const PrimeField& prime_field() const { return *this->field; }
+    bool is_zero() const { return this->c.empty(); }
+    // -1 for the zero polynomial
+    long degree() const { return static_cast<long>(this->c.size()) - 1; }
+    // the coefficient of x^i, zero past the degree
+    FieldElement operator[](std::size_t i) const;
+    const std::vector<FieldElement>& coefficients() const { return this->c; }
+
+    // the formal derivative
+    Polynomial derivative() const;
+
+    // Horner's rule; throws std::runtime_error for x of another field
+    FieldElement evaluate(const FieldElement& x) const;
+    // Horner's rule at every point at once, the coefficient in the outer loop
+    // so each is read once for all the points; the points are split over the
+    // executor in chunks
+    std::vector<FieldElement> evaluate(const std::vector<FieldElement>& points, unsigned threads = 1) const;
+    std::vector<FieldElement> evaluate(const std::vector<FieldElement>& points, Executor& executor) const;
+
+    // every binary operation throws std::runtime_error for polynomials of
+    // different fields
+    Polynomial& operator+=(const Polynomial& other);
+    Polynomial& operator-=(const Polynomial& other);
+    Polynomial& operator*=(const Polynomial& other) { return *this = *this * other; }
+    Polynomial& operator*=(const FieldElement& k);
+    friend Polynomial operator+(Polynomial lhs, const Polynomial& rhs) { return lhs += rhs; }
+    friend Polynomial operator-(Polynomial lhs, const Polynomial& rhs) { return lhs -= rhs; }
+    friend Polynomial operator*(const Polynomial& lhs, const Polynomial& rhs);
+    friend Polynomial operator*(Polynomial lhs, const FieldElement& k) { return lhs *= k; }
+    friend Polynomial operator*(const FieldElement& k, Polynomial rhs) { return rhs *= k; }
+    Polynomial operator-() const;
+
+    // (quotient, remainder) with deg remainder < deg divisor; throws
+    // std::domain_error for the zero divisor
+    std::pair<Polynomial, Polynomial> divmod(const Polynomial& divisor) const;
+    friend Polynomial operator/(const Polynomial& lhs, const Polynomial& rhs) { return lhs.divmod(rhs).first; }
+    friend Polynomial operator%(const Polynomial& lhs, const Polynomial& rhs) { return lhs.divmod(rhs).second; }
+    // the first n coefficients of 1 / *this as a power series; throws
+    // std::domain_error if the constant coefficient is zero
+    Polynomial inverse_series(std::size_t n) const;
+
+    friend bool operator==(const Polynomial& lhs, const Polynomial& rhs);
+    friend bool operator!=(const Polynomial& lhs, const Polynomial& rhs) { return !(lhs == rhs); }
+    friend std::ostream& operator<<(std::ostream& os, const Polynomial& p);
+
+private:
+    const PrimeField* field;
+    std::vector<FieldElement> c;
+
+    void check_field(const Polynomial& other) const;
+    // drops zero coefficients from the top
+    void trim();
+};
+
+// The subproduct tree of points x_0, .., x_(n - 1): the leaves are the
+// x - x_i, every node the product of its two children, and the root
+// M = (x - x_0) .. (x - x_(n - 1)). Evaluating at every point reduces the
+// polynomial down the tree, each node taking its parent's remainder mod its
+// own product, and interpolation combines the values up it, both in
+// O(M(n) log n) field operations for M(n) the cost of a product (Borodin and
+// Moenck; von zur Gathen and Gerhard, "Modern Computer Algebra", 10.1 and
+// 10.2). Built once, a tree serves every polynomial and every set of values
+// on its points, as an erasure code's fixed evaluation points want.
+class SubproductTree {
+public:
+    // below this many points a node is evaluated by Horner's rule at each
+    // point instead of being split further
+    static constexpr std::size_t HORNER_POINTS = 16;
+
+    // throws std::invalid_argument for no points, std::runtime_error for
+    // points of different fields
+    explicit SubproductTree(std::vector<FieldElement> points);
+
+    const PrimeField& prime_field() const { return *this->field; }
+    const std::vector<FieldElement>& points() const { return this->xs; }
+    // M, of degree n
+    const Polynomial& root() const { return this->levels.back().front(); }
+
+    // p at every point, in the order of points(); throws std::runtime_error
+    // for p of another field
+    std::vector<FieldElement> evaluate(const Polynomial& p) const;
+    // the polynomial of degree below n through (x_i, values[i]): the sum of
+    // values[i] w_i M / (x - x_i) for the barycentric weights w_i = 1 / M'(x_i),
+    // which the first call finds by one multipoint evaluation and one batch
+    // inversion and keeps. Throws std::invalid_argument unless there is a value
+    // for each point and the points are distinct
+    Polynomial interpolate(const std::vector<FieldElement>& values) const;
+
+private:
+    const PrimeField* field;
+    std::vector<FieldElement> xs;
+    // levels[0] the leaves, levels[l][i] the product over points
+    // [i 2^l, (i + 1) 2^l); a node without a sibling moves up unchanged
+    std::vector<std::vector<Polynomial>> levels;
+    // 1 / rev(levels[l][i]) as power series, which the remainders going down
+    // the tree are taken with once the first evaluate has built them
+    mutable std::once_flag inverses_once;
+    mutable std::vector<std::vector<Polynomial>> inverses;
+    mutable std::once_flag weights_once;
+    mutable std::vector<FieldElement> weights;
+
+    void evaluate(std::size_t level, std::size_t index, const Polynomial& r, std::vector<FieldElement>& out) const;
+};
+
+// Lagrange interpolation in O(n^2) for few points, the threshold share counts
+// of Shamir sharing: the barycentric weights w_j = 1 / prod_(k != j) (x_j - x_k)
+// with one batch inversion, then the sum of y_j w_j M / (x - x_j), each quotient
+// by synthetic division. Throws std::invalid_argument unless xs and ys have the
+// same, nonzero, size and the xs are distinct, std::runtime_error for mixed fields
+Polynomial lagrange_interpolate(const std::vector<FieldElement>& xs, const std::vector<FieldElement>& ys);
+// the interpolating polynomial at x alone, M(x) sum y_j w_j / (x - x_j), with
+// the weights and the 1 / (x - x_j) in one batch inversion: the secret of a
+// Shamir sharing is lagrange_evaluate(xs, ys, 0). Throws as lagrange_interpolate
+FieldElement lagrange_evaluate(const std::vector<FieldElement>& xs, const std::vector<FieldElement>& ys,
+                               const FieldElement& x);
+// the polynomial of degree below n through (xs[i], ys[i]): lagrange_interpolate
+// below INTERPOLATE_TREE_POINTS points, a SubproductTree from there
+constexpr std::size_t INTERPOLATE_TREE_POINTS = 256;
+Polynomial interpolate(const std::vector<FieldElement>& xs, const std::vector<FieldElement>& ys);
+
+// whether products of up to n coefficients over field go through the
+// number-theoretic transform: field is prime and p - 1 has a factor 2^k >= n
+bool ntt_friendly(const PrimeField& field, std::size_t n);
+
+#endif //ECC_POLYNOMIAL_H
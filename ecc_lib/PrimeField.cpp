@@ -0,0 +1,137 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <map>
+#include <stdexcept>
+#include "curve25519.h"
+#include "p256.h"
+#include "primality.h"
+#include "PrimeField.h"
+#include "secp256k1.h"
+
+const PrimeField& PrimeField::get(const integer& prime) {
+    // never freed: elements keep raw pointers to their field
+    static std::mutex lock;
+    static std::map<integer, std::unique_ptr<const PrimeField>> fields;
+
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = fields.find(prime);
+    if (it == fields.end()) {
+        it = fields.emplace(prime, std::unique_ptr<const PrimeField>(new PrimeField(prime))).first;
+    }
+    return *it->second;
+}
+
+// the check runs before any member is built from the prime
+static const integer& checked_prime(const integer& prime) {
+    if (prime < 2) {
+        throw std::invalid_argument("Field prime must be at least 2");
+    }
+    return prime;
+}
+
+PrimeField::PrimeField(const integer& prime) : reducer(checked_prime(prime)) {
+    this->p = prime;
+    this->p1 = prime - 1;
+    this->p2 = prime - 2;
+    this->k = prime.bit_length();
+    this->probable_prime = is_probable_prime(prime);
+    this->wide = this->k > uint256::BITS;
+    this->fp = this->wide ? uint256::zero() : uint256::from_integer(prime);
+    if (!this->wide && (prime & 1) && prime >= 3) {
+        this->mont.reset(new MontgomeryContext(prime));
+    }
+    this->folder = nullptr;
+    this->ac = chain::none;
+    if (!this->wide && this->fp == SECP256K1_FIELD_P) {
+        this->folder = secp256k1_reduce_p;
+        this->ac = chain::secp256k1;
+    } else if (!this->wide && this->fp == P256_FIELD_P) {
+        this->folder = p256_reduce_p;
+        this->ac = chain::p256;
+    } else if (!this->wide && this->fp == SECP256K1_ORDER_N) {
+        this->folder = secp256k1_reduce_n;
+    } else if (!this->wide && this->fp == P256_ORDER_N) {
+        this->folder = p256_reduce_n;
+    } else if (!this->wide && this->fp == CURVE25519_FIELD_P) {
+        this->folder = curve25519_reduce_p;
+    }
+
+    // p = 2^k - c; c below 2^(k / 2) makes each fold take off nearly half the bits
+    this->pm_c = 0;
+    this->pm_mask = uint512::zero();
+    const integer c = (integer(1) << this->k) - prime;
+    if (c > 0 && c.bit_length() <= 64 && 2 * c.bit_length() <= this->k) {
+        this->pm_c = uint256::from_integer(c).limb[0];
+        if (this->wide) {
+            this->pm_wide_mask = (integer(1) << this->k) - 1;
+        } else {
+            this->pm_mask = (uint512(1) << this->k) - uint512(1);
+        }
+    }
+
+    // q in mul_word is at most 2 short, so r < 3p must fit in a limb
+    this->wp = 0;
+    this->wmu = 0;
+    if (this->k <= 62) {
+        this->wp = this->fp.limb[0];
+        this->wmu = uint256::from_integer((integer(1) << (2 * this->k)) / prime).limb[0];
+    }
+
+    this->half = this->p1 >> 1;
+    this->odd = this->p1;
+    this->s = 0;
+    while (this->odd != 0 && !this->odd[0]) {
+        this->odd >>= 1;
+        this->s++;
+    }
+    this->sqrt_e = (this->odd + 1) >> 1;
+}
+
+uint256 PrimeField::fold_c(const uint512& x) const {
+    uint512 v = x;
+    for (uint512 hi = v >> this->k; !hi.is_zero(); hi = v >> this->k) {
+        const uint512 lo = v & this->pm_mask;
+        limb_t carry = 0;
+        for (std::size_t i = 0; i < 8; i++) {
+            v.limb[i] = limb_mac(hi.limb[i], this->pm_c, lo.limb[i], carry);
+        }
+    }
+    uint256 out;
+    for (std::size_t i = 0; i < 4; i++) {
+        out.limb[i] = v.limb[i];
+    }
+    if (out >= this->fp) {
+        out -= this->fp;
+    }
+    return out;
+}
+
+integer PrimeField::reduce(const integer& x) const {
+    if (!this->pm_c || x < 0) {
+        return this->reducer.reduce(x);
+    }
+    if (!this->wide) {
+        return x.bit_length() <= 512 ? fold_c(uint512::from_integer(x)).to_integer() : this->reducer.reduce(x);
+    }
+    const integer c(this->pm_c);
+    integer v = x;
+    for (integer hi = v >> this->k; hi != 0; hi = v >> this->k) {
+        v = (v & this->pm_wide_mask) + hi * c;
+    }
+    if (v >= this->p) {
+        v -= this->p;
+    }
+    return v;
+}
+
+const integer& PrimeField::non_residue() const {
+    std::call_once(this->z_once, [this]() {
+        integer candidate = 2;
+        while (candidate < this->p && integer::jacobi(candidate, this->p) != -1) {
+            candidate++;
+        }
+        this->z = candidate;
+    });
+    return this->z;
+}
@@ -0,0 +1,127 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_PRIMEFIELD_H
+#define ECC_PRIMEFIELD_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+#include "BarrettReducer.h"
+#include "integer.h"
+#include "limb.h"
+#include "MontgomeryContext.h"
+#include "uint256.h"
+
+// Everything about one prime field that its elements have in common, computed
+// once. Descriptors are interned: get() hands out the same object for the same
+// prime for the life of the program, so elements hold a plain pointer and two
+// elements are in the same field exactly when those pointers are equal.
+class PrimeField {
+public:
+    // division-free reduction of a full 512-bit product
+    typedef uint256 (*fold_fn)(const uint512&);
+
+    // the descriptor for prime, built on first use; safe to call from any thread
+    static const PrimeField& get(const integer& prime);
+
+    PrimeField(const PrimeField&) = delete;
+    PrimeField& operator=(const PrimeField&) = delete;
+
+    const integer& prime() const { return this->p; }
+    const integer& prime_minus_one() const { return this->p1; }
+    const integer& prime_minus_two() const { return this->p2; }    // Fermat inverse exponent
+    std::size_t bits() const { return this->k; }
+    // whether the modulus passed is_probable_prime when the descriptor was
+    // built; the paths that need a prime (the Fermat inverse of word fields,
+    // Tonelli-Shanks) are only taken when it did
+    bool is_prime() const { return this->probable_prime; }
+
+    // the prime fits in 256 bits, so elements live in a uint256
+    bool fixed() const { return !this->wide; }
+    const uint256& fixed_prime() const { return this->fp; }
+    // Montgomery constants, for odd primes that fit in 256 bits; null otherwise
+    const MontgomeryContext* montgomery() const { return this->mont.get(); }
+    // set for primes with a special-form reduction (the secp256k1 and P-256
+    // primes and orders, 2^255 - 19)
+    fold_fn fold() const { return this->folder; }
+    // c when the prime is 2^bits() - c for a c of one limb below 2^(bits() / 2)
+    // (a pseudo-Mersenne or Solinas prime, such as 2^127 - 1 or MuHash's
+    // 2^3072 - 1103717), else 0. Such a prime is found when the descriptor is
+    // built, and x = hi 2^k + lo is then reduced by folding it to lo + c hi,
+    // a multiplication by one limb, until it fits in k bits, and subtracting p
+    // at most once: no division and no Montgomery form
+    limb_t pseudo_mersenne() const { return this->pm_c; }
+    // x mod p by folding, for pseudo_mersenne() fields
+    uint256 fold_c(const uint512& x) const;
+    // division-free reduction of products of two elements, for primes without
+    // a faster reduction above
+    const BarrettReducer& barrett() const { return this->reducer; }
+    // x mod p for any integer x: folded for pseudo_mersenne() fields, Barrett
+    // otherwise
+    integer reduce(const integer& x) const;
+
+    // primes below 2^62 fit in one limb: elements are kept in limb[0] of their
+    // uint256 and a product of two is reduced with a single-limb Barrett step
+    bool word() const { return this->wp != 0; }
+    limb_t word_prime() const { return this->wp; }
+    // a * b mod p for a, b < p, for word() fields
+    limb_t mul_word(limb_t a, limb_t b) const {
+        limb_t hi;
+        const limb_t lo = limb_mul(a, b, hi);
+        // q = floor(floor(x / 2^(k - 1)) * mu / 2^(k + 1)) is at most 2 below x / p
+        const limb_t t = (lo >> (this->k - 1)) | (hi << (65 - this->k));
+        limb_t qh;
+        const limb_t ql = limb_mul(t, this->wmu, qh);
+        const limb_t q = (ql >> (this->k + 1)) | (qh << (63 - this->k));
+        limb_t r = lo - q * this->wp;
+        r -= this->wp & (0 - static_cast<limb_t>(r >= this->wp));
+        r -= this->wp & (0 - static_cast<limb_t>(r >= this->wp));
+        return r;
+    }
+
+    // primes with hand-written addition chains for the exponents p - 2 and
+    // (p + 1) / 4, which the field's powers take instead of a windowed power
+    enum class chain { none, secp256k1, p256 };
+    chain addition_chain() const { return this->ac; }
+
+    // square roots: prime - 1 = odd * 2^s and sqrt_exponent is (odd + 1) / 2.
+    // For p = 3 mod 4 (s = 1) that is (p + 1) / 4 and the root is one power;
+    // otherwise it is the starting root for Tonelli-Shanks, and non_residue is
+    // the smallest non-square, looked for on first use
+    const integer& sqrt_exponent() const { return this->sqrt_e; }
+    const integer& legendre_exponent() const { return this->half; }    // (p - 1) / 2
+    const integer& odd_part() const { return this->odd; }
+    std::size_t two_adicity() const { return this->s; }
+    const integer& non_residue() const;
+
+private:
+    explicit PrimeField(const integer& prime);
+
+    integer p;
+    integer p1;
+    integer p2;
+    std::size_t k;
+    bool probable_prime;
+    bool wide;
+    uint256 fp;
+    std::unique_ptr<const MontgomeryContext> mont;
+    fold_fn folder;
+    limb_t pm_c;
+    uint512 pm_mask;        // 2^k - 1, for fixed pseudo-Mersenne primes
+    integer pm_wide_mask;   // the same, for wide ones
+    chain ac;
+    BarrettReducer reducer;
+    limb_t wp;
+    limb_t wmu;     // floor(2^2k / p)
+    integer sqrt_e;
+    integer half;
+    integer odd;
+    std::size_t s;
+    mutable std::once_flag z_once;
+    mutable integer z;
+};
+
+#endif //ECC_PRIMEFIELD_H
@@ -0,0 +1,123 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include "ripemd160.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+#include <immintrin.h>
+
+#define ECC_AVX2 __attribute__((target("avx2")))
+
+// Multi-buffer RIPEMD-160: both lines of the compression on eight lanes, step
+// for step. The words are little-endian, so a block is eight 32-byte rows
+// transposed with no byte swap; the rotations are two shifts.
+
+namespace {
+
+// rows r[l] = bytes [0, 32) of lane l to columns r[w] = word w of lanes 0..7
+ECC_AVX2 inline void transpose8(__m256i* r) {
+    const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]), t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+    const __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]), t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+    const __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]), t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+    const __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]), t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+    const __m256i u0 = _mm256_unpacklo_epi64(t0, t2), u1 = _mm256_unpackhi_epi64(t0, t2);
+    const __m256i u2 = _mm256_unpacklo_epi64(t1, t3), u3 = _mm256_unpackhi_epi64(t1, t3);
+    const __m256i u4 = _mm256_unpacklo_epi64(t4, t6), u5 = _mm256_unpackhi_epi64(t4, t6);
+    const __m256i u6 = _mm256_unpacklo_epi64(t5, t7), u7 = _mm256_unpackhi_epi64(t5, t7);
+    r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+// every helper is inlined into avx2_blocks, so no vector crosses a call
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+ECC_AVX2 inline __m256i rotl(__m256i x, int n) {
+    return _mm256_or_si256(_mm256_sll_epi32(x, _mm_cvtsi32_si128(n)), _mm256_srl_epi32(x, _mm_cvtsi32_si128(32 - n)));
+}
+
+ECC_AVX2 inline __m256i f(std::size_t i, __m256i x, __m256i y, __m256i z) {
+    const __m256i ones = _mm256_set1_epi32(-1);
+    switch (i) {
+        case 0:
+            return _mm256_xor_si256(_mm256_xor_si256(x, y), z);
+        case 1:
+            return _mm256_or_si256(_mm256_and_si256(x, y), _mm256_andnot_si256(x, z));
+        case 2:
+            return _mm256_xor_si256(_mm256_or_si256(x, _mm256_xor_si256(y, ones)), z);
+        case 3:
+            return _mm256_or_si256(_mm256_and_si256(x, z), _mm256_andnot_si256(z, y));
+        default:
+            return _mm256_xor_si256(x, _mm256_or_si256(y, _mm256_xor_si256(z, ones)));
+    }
+}
+
+ECC_AVX2 void avx2_blocks(uint32_t* h, const uint8_t* const* in, std::size_t blocks) {
+    __m256i state[5];
+    for (std::size_t i = 0; i < 5; i++) {
+        state[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(h + 8 * i));
+    }
+    for (std::size_t b = 0; b < blocks; b++) {
+        __m256i x[16];
+        for (std::size_t half = 0; half < 2; half++) {
+            for (std::size_t l = 0; l < 8; l++) {
+                x[8 * half + l] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in[l] + 64 * b + 32 * half));
+            }
+            transpose8(x + 8 * half);
+        }
+        __m256i al = state[0], bl = state[1], cl = state[2], dl = state[3], el = state[4];
+        __m256i ar = al, br = bl, cr = cl, dr = dl, er = el;
+        for (std::size_t j = 0; j < 80; j++) {
+            const std::size_t g = j / 16;
+            __m256i t = _mm256_add_epi32(_mm256_add_epi32(al, f(g, bl, cl, dl)),
+                                         _mm256_add_epi32(x[RIPEMD160_R[0][j]],
+                                                          _mm256_set1_epi32(static_cast<int>(RIPEMD160_K[0][g]))));
+            t = _mm256_add_epi32(rotl(t, RIPEMD160_S[0][j]), el);
+            al = el;
+            el = dl;
+            dl = rotl(cl, 10);
+            cl = bl;
+            bl = t;
+            t = _mm256_add_epi32(_mm256_add_epi32(ar, f(4 - g, br, cr, dr)),
+                                 _mm256_add_epi32(x[RIPEMD160_R[1][j]],
+                                                  _mm256_set1_epi32(static_cast<int>(RIPEMD160_K[1][g]))));
+            t = _mm256_add_epi32(rotl(t, RIPEMD160_S[1][j]), er);
+            ar = er;
+            er = dr;
+            dr = rotl(cr, 10);
+            cr = br;
+            br = t;
+        }
+        const __m256i t = _mm256_add_epi32(state[1], _mm256_add_epi32(cl, dr));
+        state[1] = _mm256_add_epi32(state[2], _mm256_add_epi32(dl, er));
+        state[2] = _mm256_add_epi32(state[3], _mm256_add_epi32(el, ar));
+        state[3] = _mm256_add_epi32(state[4], _mm256_add_epi32(al, br));
+        state[4] = _mm256_add_epi32(state[0], _mm256_add_epi32(bl, cr));
+        state[0] = t;
+    }
+    for (std::size_t i = 0; i < 5; i++) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(h + 8 * i), state[i]);
+    }
+}
+#pragma GCC diagnostic pop
+
+}
+
+const Ripemd160MultiBuffer* avx2_ripemd160_multi_buffer() {
+    static const Ripemd160MultiBuffer kernel = {"avx2", 8, avx2_blocks};
+    return __builtin_cpu_supports("avx2") ? &kernel : nullptr;
+}
+
+#else
+
+const Ripemd160MultiBuffer* avx2_ripemd160_multi_buffer() {
+    return nullptr;
+}
+
+#endif
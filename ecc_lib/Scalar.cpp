@@ -0,0 +1,201 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <stdexcept>
+
+#include "modexp.h"
+#include "Scalar.h"
+#include "secp256k1.h"
+#include "Status.h"
+
+static const PrimeField& checked_order(const PrimeField& order) {
+    if (!order.fixed() || !order.fixed_prime().bit(0) || order.fixed_prime() < uint256(3)) {
+        throw std::invalid_argument("Scalar order must be an odd prime of at most 256 bits");
+    }
+    return order;
+}
+
+Scalar::Scalar(const PrimeField& order) : n(&checked_order(order)), v(0) {}
+
+Scalar::Scalar(const integer& k, const PrimeField& order) : n(&checked_order(order)), v(0) {
+    if (k >= 0 && k < order.prime()) {
+        this->v = uint256::from_integer(k);
+        return;
+    }
+    integer r = k % order.prime();
+    if (r < 0) {
+        r += order.prime();
+    }
+    this->v = uint256::from_integer(r);
+}
+
+Scalar Scalar::from_bytes(const uint8_t* in, std::size_t len, const PrimeField& order) {
+    if (len > 64) {
+        throw std::invalid_argument("Scalar::from_bytes takes at most 64 bytes");
+    }
+    checked_order(order);
+    const uint512 x = uint512::load_be(in, len);
+    if (PrimeField::fold_fn fold = order.fold()) {
+        return Scalar(&order, fold(x));
+    }
+    return Scalar(x.to_integer(), order);
+}
+
+void Scalar::check_order(const Scalar& other, const char* message) const {
+    if (this->n != other.n) {
+        throw_status(Status::field_mismatch, message);
+    }
+}
+
+uint256 Scalar::reduce(const uint512& x) const {
+    if (PrimeField::fold_fn fold = this->n->fold()) {
+        return fold(x);
+    }
+    return uint256::from_integer(this->n->barrett().reduce(x.to_integer()));
+}
+
+// the sum is below 2n < 2^257: n comes off when it carried or is not below n
+Scalar Scalar::operator+(const Scalar& other) const {
+    check_order(other, "Cannot add scalars of different orders");
+    uint256 sum, reduced;
+    const limb_t carry = uint256::add(sum, this->v, other.v);
+    const limb_t borrow = uint256::sub(reduced, sum, this->n->fixed_prime());
+    return Scalar(this->n, uint256::select(0 - (carry | (borrow ^ 1)), reduced, sum));
+}
+
+Scalar Scalar::operator-(const Scalar& other) const {
+    check_order(other, "Cannot subtract scalars of different orders");
+    uint256 difference, out;
+    const limb_t borrow = uint256::sub(difference, this->v, other.v);
+    uint256::add(out, difference, uint256::select(0 - borrow, this->n->fixed_prime(), uint256::zero()));
+    return Scalar(this->n, out);
+}
+
+Scalar Scalar::operator*(const Scalar& other) const {
+    check_order(other, "Cannot multiply scalars of different orders");
+    return Scalar(this->n, reduce(uint256::mul_wide(this->v, other.v)));
+}
+
+Scalar Scalar::operator-() const {
+    return Scalar(*this->n) - *this;
+}
+
+Scalar Scalar::inverse() const {
+    const uint256 inv = uint256::modinv_ct(this->v, this->n->fixed_prime());
+    limb_t any = 0;
+    for (std::size_t i = 0; i < 4; i++) {
+        any |= this->v.limb[i];
+    }
+    // modinv_ct leaves garbage for zero; the mask is set for any other value
+    const limb_t nonzero = 0 - ((any | (0 - any)) >> 63);
+    return Scalar(this->n, uint256::select(nonzero, inv, uint256::zero()));
+}
+
+void Scalar::batch_invert(std::vector<Scalar>& scalars) {
+    if (scalars.empty()) {
+        return;
+    }
+    // prefix products with zeros skipped, one inverse, then back down
+    std::vector<Scalar> prefix;
+    prefix.reserve(scalars.size());
+    Scalar product(1, scalars[0].order());
+    for (const Scalar& s : scalars) {
+        prefix.push_back(product);
+        if (!s.is_zero()) {
+            product *= s;
+        }
+    }
+    Scalar inverse = product.inverse();
+    for (std::size_t i = scalars.size(); i-- > 0;) {
+        if (!scalars[i].is_zero()) {
+            const Scalar s = scalars[i];
+            scalars[i] = inverse * prefix[i];
+            inverse *= s;
+        }
+    }
+}
+
+bool Scalar::is_high() const {
+    uint256 difference;
+    return uint256::sub(difference, this->n->fixed_prime() >> 1, this->v) != 0;
+}
+
+void Scalar::to_bytes(uint8_t* out) const {
+    this->v.store_be(out, 32);
+}
+
+Status Scalar::serialize(const Scalar* in, std::size_t count, uint8_t* out, std::size_t capacity) noexcept {
+    for (std::size_t i = 1; i < count; i++) {
+        if (in[i].n != in[0].n) {
+            return Status::field_mismatch;
+        }
+    }
+    if (capacity / WIRE_SIZE < count) {
+        return Status::buffer_too_small;
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        in[i].v.store_le(out + i * WIRE_SIZE, WIRE_SIZE);
+    }
+    return Status::ok;
+}
+
+Status Scalar::deserialize(const uint8_t* in, std::size_t len, const PrimeField& order,
+                           std::vector<Scalar>& out) noexcept {
+    if (!order.fixed() || !order.fixed_prime().bit(0) || order.fixed_prime() < uint256(3)) {
+        return Status::bad_modulus;
+    }
+    if (len % WIRE_SIZE) {
+        return Status::bad_encoding;
+    }
+    const std::size_t count = len / WIRE_SIZE;
+    if (!uint256::all_below_le(in, count, WIRE_SIZE, order.fixed_prime())) {
+        return Status::out_of_range;
+    }
+    out.reserve(out.size() + count);
+    for (std::size_t i = 0; i < count; i++) {
+        out.push_back(Scalar(&order, uint256::load_le(in + i * WIRE_SIZE, WIRE_SIZE)));
+    }
+    return Status::ok;
+}
+
+std::vector<int> Scalar::wnaf(std::size_t w) const {
+    const bool negative = is_high();
+    const uint256 m = negative ? this->n->fixed_prime() - this->v : this->v;
+    std::vector<int> digits = wnaf_digits(m.bits(), [&m](std::size_t i) { return m.bit(i); }, w);
+    if (negative) {
+        for (int& d : digits) {
+            d = -d;
+        }
+    }
+    return digits;
+}
+
+// the secp256k1 endomorphism constants of libsecp256k1: g1 and g2 are
+// round(2^384 * b2 / n) and round(2^384 * -b1 / n) for the short lattice basis
+// (a1, b1), (a2, b2) of the pairs (k1, k2) with k1 + k2 * lambda = 0 mod n
+static constexpr uint256 GLV_G1 = "3086d221a7d46bcde86c90e49284eb153daa8a1471e8ca7fe893209a45dbb031"_hex;
+static constexpr uint256 GLV_G2 = "e4437ed6010e88286f547fa90abfe4c4221208ac9df506c61571b4ae8ac47f71"_hex;
+static constexpr uint256 GLV_MINUS_B1 = "e4437ed6010e88286f547fa90abfe4c3"_hex;
+static constexpr uint256 GLV_MINUS_B2 = "fffffffffffffffffffffffffffffffe8a280ac50774346dd765cda83db1562c"_hex;
+static constexpr uint256 GLV_MINUS_LAMBDA = "ac9c52b33fa3cf1f5ad9e3fd77ed9ba4a880b9fc8ec739c2e0cfc810b51283cf"_hex;
+
+// round(a * g / 2^384), below 2^128 for a < n
+static uint256 mul_shift_384(const uint256& a, const uint256& g) {
+    const uint512 product = uint256::mul_wide(a, g);
+    uint256 out = (product >> 384).resize<4>();
+    uint256::add(out, out, uint256(static_cast<limb_t>(product.bit(383))));
+    return out;
+}
+
+std::pair<Scalar, Scalar> Scalar::split_lambda() const {
+    if (this->n->fixed_prime() != SECP256K1_ORDER_N) {
+        throw std::domain_error("split_lambda needs the secp256k1 group order");
+    }
+    // c1 = round(b2 * k / n), c2 = round(-b1 * k / n); k2 = -c1 * b1 - c2 * b2
+    // and k1 = k - k2 * lambda
+    const Scalar c1(this->n, mul_shift_384(this->v, GLV_G1));
+    const Scalar c2(this->n, mul_shift_384(this->v, GLV_G2));
+    const Scalar k2 = c1 * Scalar(this->n, GLV_MINUS_B1) + c2 * Scalar(this->n, GLV_MINUS_B2);
+    const Scalar k1 = k2 * Scalar(this->n, GLV_MINUS_LAMBDA) + *this;
+    return {k1, k2};
+}
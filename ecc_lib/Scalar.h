@@ -0,0 +1,110 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_SCALAR_H
+#define ECC_SCALAR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "hash.h"
+#include "integer.h"
+#include "PrimeField.h"
+#include "uint256.h"
+
+// An integer mod the prime order n of a group, kept in [0, n) in a uint256:
+// the arithmetic of signatures and of the scalars handed to point
+// multiplication. Products are reduced by the order's fold, which the
+// secp256k1 and P-256 orders have (Curve::scalar_field()), and by Barrett
+// reduction on integer for any other odd order of up to 256 bits. Addition,
+// subtraction, negation, inverse() and is_high() run the same steps for every
+// value; multiplication does as well where the order has a fold.
+class Scalar {
+public:
+    // zero; throws std::invalid_argument for an even order or one above 256 bits
+    explicit Scalar(const PrimeField& order);
+    // k mod n, for any k of either sign
+    Scalar(const integer& k, const PrimeField& order);
+    // the big-endian in[0, len) mod n, len up to 64; throws std::invalid_argument beyond
+    static Scalar from_bytes(const uint8_t* in, std::size_t len, const PrimeField& order);
+
+    // the operands must share an order; throws std::runtime_error otherwise
+    Scalar operator+(const Scalar& other) const;
+    Scalar operator-(const Scalar& other) const;
+    Scalar operator*(const Scalar& other) const;
+    Scalar operator-() const;
+    Scalar& operator+=(const Scalar& other) { return *this = *this + other; }
+    Scalar& operator-=(const Scalar& other) { return *this = *this - other; }
+    Scalar& operator*=(const Scalar& other) { return *this = *this * other; }
+    // 1 / *this by the constant-time safegcd of uint256::modinv_ct; zero maps to zero
+    Scalar inverse() const;
+    // replaces each scalar by its inverse with one inversion and 3(count - 1)
+    // multiplications (Montgomery's trick); zeros stay zero and leave the
+    // others' inverses alone. The scalars must share an order; throws
+    // std::runtime_error otherwise
+    static void batch_invert(std::vector<Scalar>& scalars);
+    // a when mask is all ones, b when it is zero, without a branch on mask; a
+    // and b must share an order
+    static Scalar select(limb_t mask, const Scalar& a, const Scalar& b) {
+        return Scalar(a.n, uint256::select(mask, a.v, b.v));
+    }
+
+    bool is_zero() const { return this->v.is_zero(); }
+    // whether the value is above n / 2, as low-S signature forms test
+    bool is_high() const;
+    const PrimeField& order() const { return *this->n; }
+    const uint256& to_uint256() const { return this->v; }
+    integer value() const { return this->v.to_integer(); }
+    // the value in exactly 32 big-endian bytes
+    void to_bytes(uint8_t* out) const;
+    // The wire format: values back to back, each little-endian in WIRE_SIZE
+    // bytes, which on a little-endian host are the limbs as they are.
+    // Status::field_mismatch if the orders differ, Status::buffer_too_small if
+    // capacity is short of count * WIRE_SIZE; nothing is written then
+    static constexpr std::size_t WIRE_SIZE = 32;
+    static Status serialize(const Scalar* in, std::size_t count, uint8_t* out, std::size_t capacity) noexcept;
+    // the len / WIRE_SIZE values at in, appended to out: Status::bad_modulus for
+    // an order Scalar(order) throws for, Status::bad_encoding if WIRE_SIZE does
+    // not divide len, Status::out_of_range if any is not below the order, found
+    // in one pass before any is kept (out is then unchanged)
+    static Status deserialize(const uint8_t* in, std::size_t len, const PrimeField& order,
+                              std::vector<Scalar>& out) noexcept;
+
+    // width-w NAF digits of the representative of least magnitude, v or v - n,
+    // negated for the latter (see wnaf_digits), so a half of split_lambda() gives
+    // about 130 digits rather than 256
+    std::vector<int> wnaf(std::size_t w) const;
+    // (k1, k2) with k1 + k2 * lambda = *this mod the secp256k1 order, lambda the
+    // cube root of unity of its endomorphism, and k1, k2 each within 2^128 of
+    // zero mod n: the rounding of libsecp256k1 by two fixed 384-bit shifts, no
+    // division. Throws std::domain_error for any other order
+    std::pair<Scalar, Scalar> split_lambda() const;
+
+    friend bool operator==(const Scalar& lhs, const Scalar& rhs) { return lhs.n == rhs.n && lhs.v == rhs.v; }
+    friend bool operator!=(const Scalar& lhs, const Scalar& rhs) { return !(lhs == rhs); }
+    // hash_words of the limbs under seed and the order
+    uint64_t hash(uint64_t seed) const {
+        return hash_words(this->v.limb, uint256::BITS / 64, seed ^ reinterpret_cast<uintptr_t>(this->n));
+    }
+
+private:
+    const PrimeField* n;
+    uint256 v;
+
+    Scalar(const PrimeField* order, const uint256& v) : n(order), v(v) {}
+    void check_order(const Scalar& other, const char* message) const;
+    // x mod n for x below n^2, or below 2^512 where the order has a fold
+    uint256 reduce(const uint512& x) const;
+};
+
+namespace std {
+template <>
+struct hash<Scalar> {
+    std::size_t operator()(const Scalar& a) const { return static_cast<std::size_t>(a.hash(hash_seed())); }
+};
+}
+
+#endif //ECC_SCALAR_H
@@ -0,0 +1,87 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+#include "Scratch.h"
+
+Scratch::Scratch(std::size_t initial_bytes) : block(0), used(0), depth(0), grown(0) {
+    add_block(std::max<std::size_t>(initial_bytes, 64));
+}
+
+Scratch::~Scratch() {
+    for (const PageBlock& b : this->blocks) {
+        page_free(b);
+    }
+}
+
+Scratch& Scratch::local() {
+    static thread_local Scratch scratch;
+    return scratch;
+}
+
+void Scratch::add_block(std::size_t size) {
+    this->blocks.push_back(page_allocate(size));
+    this->grown++;
+}
+
+std::size_t Scratch::capacity() const {
+    std::size_t total = 0;
+    for (const PageBlock& b : this->blocks) {
+        total += b.size;
+    }
+    return total;
+}
+
+std::size_t Scratch::in_use() const {
+    std::size_t total = this->used;
+    for (std::size_t i = 0; i < this->block; i++) {
+        total += this->blocks[i].size;
+    }
+    return total;
+}
+
+void* Scratch::do_allocate(std::size_t bytes, std::size_t alignment) {
+    // the padding to align the start, counted from the block's address
+    const auto padding = [alignment](const char* at) {
+        return (alignment - reinterpret_cast<std::uintptr_t>(at) % alignment) % alignment;
+    };
+    for (;;) {
+        const PageBlock& b = this->blocks[this->block];
+        char* data = static_cast<char*>(b.data);
+        const std::size_t start = this->used + padding(data + this->used);
+        if (start <= b.size && bytes <= b.size - start) {
+            this->used = start + bytes;
+            return data + start;
+        }
+        // on to the next block, past any too small for this
+        if (this->block + 1 == this->blocks.size()) {
+            add_block(std::max(capacity(), bytes + alignment));
+        }
+        this->block++;
+        this->used = 0;
+    }
+}
+
+Scratch::Frame::Frame(Scratch& scratch) : scratch(scratch), block(scratch.block), used(scratch.used) {
+    scratch.depth++;
+}
+
+Scratch::Frame::~Frame() {
+    Scratch& s = this->scratch;
+    s.block = this->block;
+    s.used = this->used;
+    if (--s.depth == 0 && s.blocks.size() > 1 && s.block == 0 && s.used == 0) {
+        // the job needed all of them: one block that holds it all next time
+        const std::size_t total = s.capacity();
+        for (const PageBlock& b : s.blocks) {
+            page_free(b);
+        }
+        s.blocks.clear();
+        s.add_block(total);
+        s.block = 0;
+        s.used = 0;
+    }
+}
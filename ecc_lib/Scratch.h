@@ -0,0 +1,76 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_SCRATCH_H
+#define ECC_SCRATCH_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "huge_pages.h"
+
+// A grow-only arena for the temporary buffers of the batch algorithms:
+// Pippenger's buckets, digits and sums, the prefix products of batch
+// inversion, the denominators of batch normalization. Buffers are
+// Scratch::vector, a std::vector on the arena; a Frame marks the top on entry
+// and gives everything above it back on exit, so frames nest like the calls
+// that open them and the outermost one ends the job. Memory is never returned
+// in between: a job that outgrows the arena adds a block, and when the
+// outermost frame closes the blocks are merged into one of their total size,
+// so from the second job of a size on there are no heap allocations at all.
+// Blocks of 2 MiB and more are on huge pages where the policy allows
+// (huge_pages.h), as the buckets of a large MSM are read at random.
+//
+// One thread uses a Scratch at a time. Each thread has its own in local(),
+// which is where the batch APIs draw from when not handed one and what their
+// tasks use on the worker threads. A Scratch is a std::pmr::memory_resource,
+// so an IntegerMemoryScope (IntegerArena.h) can put integer digits on it too,
+// for integers that do not outlive the frame.
+class Scratch : public std::pmr::memory_resource {
+public:
+    template <typename T>
+    using vector = std::vector<T, std::pmr::polymorphic_allocator<T>>;
+
+    class Frame {
+    public:
+        explicit Frame(Scratch& scratch);
+        ~Frame();
+        Frame(const Frame&) = delete;
+        Frame& operator=(const Frame&) = delete;
+
+    private:
+        Scratch& scratch;
+        std::size_t block;
+        std::size_t used;
+    };
+
+    explicit Scratch(std::size_t initial_bytes = 64 * 1024);
+    ~Scratch() override;
+    Scratch(const Scratch&) = delete;
+    Scratch& operator=(const Scratch&) = delete;
+
+    // bytes held, and bytes handed out in the open frames
+    std::size_t capacity() const;
+    std::size_t in_use() const;
+    // blocks taken from the heap since construction, merges included
+    std::size_t heap_allocations() const { return this->grown; }
+
+    // the calling thread's, made on first use
+    static Scratch& local();
+
+private:
+    std::vector<PageBlock> blocks;
+    std::size_t block;      // the block allocations come from
+    std::size_t used;       // bytes of it taken
+    std::size_t depth;      // open frames
+    std::size_t grown;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    void add_block(std::size_t size);
+};
+
+#endif //ECC_SCRATCH_H
@@ -0,0 +1,314 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_SECP256K1FIELD26_H
+#define ECC_SECP256K1FIELD26_H
+
+#include <cassert>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+
+#include "integer.h"
+#include "secp256k1.h"
+#include "uint256.h"
+
+// Secp256k1Field52 for 32-bit targets: ten 26-bit limbs in 32-bit words, least
+// significant first, so every product is a 32x32 -> 64 bit multiplication and
+// every column of a product fits in 64 bits. The operations, the magnitude
+// rules and the NDEBUG bookkeeping are those of Secp256k1Field52, with 2^26 in
+// place of 2^52: a limb of magnitude m is at most 2m(2^26 - 1), the top one at
+// most 2m(2^22 - 1). With only 6 spare bits per word no value may exceed
+// magnitude 16.
+class Secp256k1Field26 {
+public:
+    static constexpr int MAX_MUL_MAGNITUDE = 8;
+    static constexpr int MAX_MAGNITUDE = 16;
+
+    Secp256k1Field26() : n{0, 0, 0, 0, 0, 0, 0, 0, 0, 0} { set_state(0, true); }
+    // value must be below p
+    explicit Secp256k1Field26(const uint256& value) {
+        if (value >= SECP256K1_FIELD_P) {
+            throw std::invalid_argument("Num is out of range");
+        }
+        for (std::size_t i = 0; i < 10; i++) {
+            const std::size_t bit = 26 * i, limb = bit / 64, shift = bit % 64;
+            uint64_t v = value.limb[limb] >> shift;
+            if (shift > 38 && limb < 3) {
+                v |= value.limb[limb + 1] << (64 - shift);
+            }
+            this->n[i] = static_cast<uint32_t>(v) & M;
+        }
+        set_state(1, true);
+    }
+    explicit Secp256k1Field26(const integer& value) {
+        if (value < 0 || value.bit_length() > uint256::BITS) {
+            throw std::invalid_argument("Num is out of range");
+        }
+        *this = Secp256k1Field26(uint256::from_integer(value));
+    }
+
+    static Secp256k1Field26 one() {
+        Secp256k1Field26 out;
+        out.n[0] = 1;
+        out.set_state(1, true);
+        return out;
+    }
+
+    // the value below p
+    uint256 to_uint256() const {
+        Secp256k1Field26 t = *this;
+        t.normalize();
+        uint256 out(0);
+        for (std::size_t i = 0; i < 10; i++) {
+            const std::size_t bit = 26 * i, limb = bit / 64, shift = bit % 64;
+            out.limb[limb] |= static_cast<uint64_t>(t.n[i]) << shift;
+            if (shift > 38 && limb < 3) {
+                out.limb[limb + 1] |= static_cast<uint64_t>(t.n[i]) >> (64 - shift);
+            }
+        }
+        return out;
+    }
+    integer value() const { return to_uint256().to_integer(); }
+
+    // brings the value below p, magnitude 1, with the same steps for every input
+    void normalize() {
+        uint32_t t[10];
+        for (std::size_t i = 0; i < 10; i++) {
+            t[i] = this->n[i];
+        }
+
+        // fold everything above 2^256 back in, once; after that t[9] is at most 23 bits
+        uint32_t x = t[9] >> 22;
+        t[9] &= M22;
+        t[0] += x * C0;
+        t[1] += x << 6;
+        uint32_t m = M;
+        for (std::size_t i = 0; i < 9; i++) {
+            t[i + 1] += t[i] >> 26;
+            t[i] &= M;
+            if (i >= 2) {
+                m &= t[i];
+            }
+        }
+
+        // what is left is below 2p: subtract p (add 2^256 - p and drop bit 256)
+        // if it carried past 2^256 or is at least p
+        x = (t[9] >> 22) | ((t[9] == M22) & (m == M) & ((t[1] + 0x40 + ((t[0] + C0) >> 26)) > M));
+        t[0] += x * C0;
+        t[1] += x << 6;
+        for (std::size_t i = 0; i < 9; i++) {
+            t[i + 1] += t[i] >> 26;
+            t[i] &= M;
+        }
+        t[9] &= M22;
+
+        for (std::size_t i = 0; i < 10; i++) {
+            this->n[i] = t[i];
+        }
+        set_state(1, true);
+    }
+
+    // magnitude 1 without the final comparison with p; the value may still be p or more
+    void normalize_weak() {
+        const uint32_t x = this->n[9] >> 22;
+        this->n[9] &= M22;
+        this->n[0] += x * C0;
+        this->n[1] += x << 6;
+        for (std::size_t i = 0; i < 9; i++) {
+            this->n[i + 1] += this->n[i] >> 26;
+            this->n[i] &= M;
+        }
+        set_state(1, false);
+    }
+
+    Secp256k1Field26& operator+=(const Secp256k1Field26& other) {
+        for (std::size_t i = 0; i < 10; i++) {
+            this->n[i] += other.n[i];
+        }
+        set_state(magnitude() + other.magnitude(), false);
+        return *this;
+    }
+
+    // *this * k for a small constant k; the magnitude is multiplied by k
+    Secp256k1Field26& mul_int(uint32_t k) {
+        for (std::size_t i = 0; i < 10; i++) {
+            this->n[i] *= k;
+        }
+        set_state(magnitude() * static_cast<int>(k), false);
+        return *this;
+    }
+
+    // p * 2(m + 1) - *this, magnitude m + 1; m must be at least the magnitude
+    Secp256k1Field26 negate(int m) const {
+        assert(m >= magnitude() && m < MAX_MAGNITUDE);
+        const uint32_t k = 2 * static_cast<uint32_t>(m + 1);
+        Secp256k1Field26 out;
+        out.n[0] = P0 * k - this->n[0];
+        out.n[1] = P1 * k - this->n[1];
+        for (std::size_t i = 2; i < 9; i++) {
+            out.n[i] = M * k - this->n[i];
+        }
+        out.n[9] = M22 * k - this->n[9];
+        out.set_state(m + 1, false);
+        return out;
+    }
+
+    Secp256k1Field26& operator*=(const Secp256k1Field26& other) {
+        assert(magnitude() <= MAX_MUL_MAGNITUDE && other.magnitude() <= MAX_MUL_MAGNITUDE);
+        uint64_t columns[19] = {0};
+        for (std::size_t i = 0; i < 10; i++) {
+            for (std::size_t j = 0; j < 10; j++) {
+                columns[i + j] += static_cast<uint64_t>(this->n[i]) * other.n[j];
+            }
+        }
+        reduce(this->n, columns);
+        set_state(1, false);
+        return *this;
+    }
+
+    friend Secp256k1Field26 operator+(Secp256k1Field26 lhs, const Secp256k1Field26& rhs) { return lhs += rhs; }
+    friend Secp256k1Field26 operator*(Secp256k1Field26 lhs, const Secp256k1Field26& rhs) { return lhs *= rhs; }
+
+    // the product columns with each cross product computed once and doubled
+    Secp256k1Field26 square() const {
+        assert(magnitude() <= MAX_MUL_MAGNITUDE);
+        uint64_t columns[19] = {0};
+        for (std::size_t i = 0; i < 10; i++) {
+            for (std::size_t j = i + 1; j < 10; j++) {
+                columns[i + j] += static_cast<uint64_t>(this->n[i]) * this->n[j];
+            }
+        }
+        for (std::size_t k = 0; k < 19; k++) {
+            columns[k] *= 2;
+        }
+        for (std::size_t i = 0; i < 10; i++) {
+            columns[2 * i] += static_cast<uint64_t>(this->n[i]) * this->n[i];
+        }
+        Secp256k1Field26 out;
+        reduce(out.n, columns);
+        out.set_state(1, false);
+        return out;
+    }
+
+    // constant time; throws std::domain_error for zero
+    Secp256k1Field26 inverse() const {
+        const uint256 x = to_uint256();
+        if (x.is_zero()) {
+            throw std::domain_error("Cannot divide by zero");
+        }
+        return Secp256k1Field26(uint256::modinv_ct(x, SECP256K1_FIELD_P));
+    }
+
+    // these look at the value below p, so they work on any magnitude
+    bool is_zero() const { return to_uint256().is_zero(); }
+    friend bool operator==(const Secp256k1Field26& lhs, const Secp256k1Field26& rhs) {
+        return lhs.to_uint256() == rhs.to_uint256();
+    }
+    friend bool operator!=(const Secp256k1Field26& lhs, const Secp256k1Field26& rhs) { return !(lhs == rhs); }
+
+    // the low bit of the value; needs normalize() first
+    bool is_odd() const {
+        assert(normalized());
+        return this->n[0] & 1;
+    }
+
+    const uint32_t* limbs() const { return this->n; }
+
+    // the recorded magnitude, and whether normalize() was the last change;
+    // builds with NDEBUG keep no record and report 1 and false
+    int magnitude() const {
+#ifndef NDEBUG
+        return this->mag;
+#else
+        return 1;
+#endif
+    }
+    bool normalized() const {
+#ifndef NDEBUG
+        return this->norm;
+#else
+        return false;
+#endif
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const Secp256k1Field26& a) {
+        return os << "Secp256k1Field26(" << a.value() << ")";
+    }
+
+private:
+    static constexpr uint32_t M = 0x3FFFFFF;       // 26 bits
+    static constexpr uint32_t M22 = 0x3FFFFF;      // 22 bits, the top limb
+    static constexpr uint32_t P0 = 0x3FFFC2F;      // low limbs of p; then M seven times and M22
+    static constexpr uint32_t P1 = 0x3FFFFBF;
+    static constexpr uint32_t C0 = 0x3D1;          // 2^256 mod p = 2^32 + C0 = (2^6 << 26) + C0
+    // 2^260 mod p = 2^36 + 0x3D10, as limbs 0 and 1
+    static constexpr uint64_t R0 = 0x3D10;
+    static constexpr uint64_t R1 = 0x400;
+
+    uint32_t n[10];
+#ifndef NDEBUG
+    int mag;
+    bool norm;
+#endif
+
+    void set_state(int m, bool normalized) {
+#ifndef NDEBUG
+        assert(m <= MAX_MAGNITUDE);
+        this->mag = m;
+        this->norm = normalized;
+#else
+        (void) m;
+        (void) normalized;
+#endif
+    }
+
+    // r = the 19 product columns of two values of magnitude at most 8 (each
+    // below 10 * 2^60), mod p, magnitude 1
+    static void reduce(uint32_t* r, const uint64_t* columns) {
+        // carry into 26-bit limbs; the top one keeps whatever is left
+        uint64_t t[20];
+        uint64_t carry = 0;
+        for (std::size_t k = 0; k < 19; k++) {
+            const uint64_t v = columns[k] + carry;
+            t[k] = v & M;
+            carry = v >> 26;
+        }
+        t[19] = carry;
+
+        // limbs 10 and up weigh 2^260 = R1 * 2^26 + R0 times limbs 0 and up
+        uint64_t u[11];
+        u[0] = t[0] + t[10] * R0;
+        for (std::size_t j = 1; j < 10; j++) {
+            u[j] = t[j] + t[j + 10] * R0 + t[j + 9] * R1;
+        }
+        u[10] = t[19] * R1;
+        for (std::size_t j = 0; j < 10; j++) {
+            u[j + 1] += u[j] >> 26;
+            u[j] &= M;
+        }
+
+        // once more for the bits left in u[10], then the bits above 2^256
+        u[0] += u[10] * R0;
+        u[1] += u[10] * R1;
+        for (std::size_t j = 0; j < 9; j++) {
+            u[j + 1] += u[j] >> 26;
+            u[j] &= M;
+        }
+        const uint64_t x = u[9] >> 22;
+        u[9] &= M22;
+        u[0] += x * C0;
+        u[1] += x << 6;
+        for (std::size_t j = 0; j < 9; j++) {
+            u[j + 1] += u[j] >> 26;
+            u[j] &= M;
+        }
+
+        for (std::size_t j = 0; j < 10; j++) {
+            r[j] = static_cast<uint32_t>(u[j]);
+        }
+    }
+};
+
+#endif //ECC_SECP256K1FIELD26_H
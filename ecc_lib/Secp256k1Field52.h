@@ -0,0 +1,328 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_SECP256K1FIELD52_H
+#define ECC_SECP256K1FIELD52_H
+
+#include <cassert>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+
+#include "integer.h"
+#include "secp256k1.h"
+#include "uint256.h"
+
+// An element of the secp256k1 field as five 52-bit limbs in 64-bit words,
+// least significant first. The 12 spare bits of each word let sums and small
+// multiples go unreduced: an addition is five word additions with no carries,
+// and products and squares reduce whatever they are given, so a chain of
+// operations needs a full reduction only where its result is compared, tested
+// or converted.
+//
+// In exchange the caller keeps track of how far each value has grown. Its
+// magnitude m bounds every limb by 2m(2^52 - 1) (the top one by 2m(2^48 - 1)).
+// Zero has magnitude 0; values built from numbers and the results of *,
+// square(), normalize() and normalize_weak() have magnitude 1. a + b has the
+// sum of the magnitudes, mul_int(k) multiplies it by k, and negate(m), for any
+// m at least the magnitude, gives m + 1. Products and squares take magnitudes
+// up to 8, and no value may exceed 32. Builds without NDEBUG record each
+// magnitude and assert these limits.
+//
+// The field operations are otherwise those of Secp256k1FieldElement, which
+// reduces after every operation; results agree once normalized. Needs 128-bit
+// products; Secp256k1Field26.h has the 32-bit version.
+#if defined(__SIZEOF_INT128__)
+class Secp256k1Field52 {
+public:
+    static constexpr int MAX_MUL_MAGNITUDE = 8;
+    static constexpr int MAX_MAGNITUDE = 32;
+
+    Secp256k1Field52() : n{0, 0, 0, 0, 0} { set_state(0, true); }
+    // value must be below p
+    explicit Secp256k1Field52(const uint256& value) {
+        if (value >= SECP256K1_FIELD_P) {
+            throw std::invalid_argument("Num is out of range");
+        }
+        this->n[0] = value.limb[0] & M;
+        this->n[1] = (value.limb[0] >> 52) | ((value.limb[1] << 12) & M);
+        this->n[2] = (value.limb[1] >> 40) | ((value.limb[2] << 24) & M);
+        this->n[3] = (value.limb[2] >> 28) | ((value.limb[3] << 36) & M);
+        this->n[4] = value.limb[3] >> 16;
+        set_state(1, true);
+    }
+    explicit Secp256k1Field52(const integer& value) {
+        if (value < 0 || value.bit_length() > uint256::BITS) {
+            throw std::invalid_argument("Num is out of range");
+        }
+        *this = Secp256k1Field52(uint256::from_integer(value));
+    }
+
+    static Secp256k1Field52 one() {
+        Secp256k1Field52 out;
+        out.n[0] = 1;
+        out.set_state(1, true);
+        return out;
+    }
+
+    // the value below p
+    uint256 to_uint256() const {
+        Secp256k1Field52 t = *this;
+        t.normalize();
+        uint256 out;
+        out.limb[0] = t.n[0] | (t.n[1] << 52);
+        out.limb[1] = (t.n[1] >> 12) | (t.n[2] << 40);
+        out.limb[2] = (t.n[2] >> 24) | (t.n[3] << 28);
+        out.limb[3] = (t.n[3] >> 36) | (t.n[4] << 16);
+        return out;
+    }
+    integer value() const { return to_uint256().to_integer(); }
+
+    // brings the value below p, magnitude 1, with the same steps for every input
+    void normalize() {
+        uint64_t t0 = this->n[0], t1 = this->n[1], t2 = this->n[2], t3 = this->n[3], t4 = this->n[4];
+
+        // fold everything above 2^256 back in, once; after that t4 is at most 49 bits
+        uint64_t x = t4 >> 48;
+        t4 &= M48;
+        t0 += x * C;
+        t1 += t0 >> 52; t0 &= M;
+        t2 += t1 >> 52; t1 &= M; uint64_t m = t1;
+        t3 += t2 >> 52; t2 &= M; m &= t2;
+        t4 += t3 >> 52; t3 &= M; m &= t3;
+
+        // what is left is below 2p: subtract p (add 2^256 - p and drop bit 256)
+        // if it carried past 2^256 or is at least p
+        x = (t4 >> 48) | ((t4 == M48) & (m == M) & (t0 >= P0));
+        t0 += x * C;
+        t1 += t0 >> 52; t0 &= M;
+        t2 += t1 >> 52; t1 &= M;
+        t3 += t2 >> 52; t2 &= M;
+        t4 += t3 >> 52; t3 &= M;
+        t4 &= M48;
+
+        this->n[0] = t0; this->n[1] = t1; this->n[2] = t2; this->n[3] = t3; this->n[4] = t4;
+        set_state(1, true);
+    }
+
+    // magnitude 1 without the final comparison with p; the value may still be p or more
+    void normalize_weak() {
+        uint64_t t0 = this->n[0], t1 = this->n[1], t2 = this->n[2], t3 = this->n[3], t4 = this->n[4];
+        const uint64_t x = t4 >> 48;
+        t4 &= M48;
+        t0 += x * C;
+        t1 += t0 >> 52; t0 &= M;
+        t2 += t1 >> 52; t1 &= M;
+        t3 += t2 >> 52; t2 &= M;
+        t4 += t3 >> 52; t3 &= M;
+        this->n[0] = t0; this->n[1] = t1; this->n[2] = t2; this->n[3] = t3; this->n[4] = t4;
+        set_state(1, false);
+    }
+
+    Secp256k1Field52& operator+=(const Secp256k1Field52& other) {
+        for (std::size_t i = 0; i < 5; i++) {
+            this->n[i] += other.n[i];
+        }
+        set_state(magnitude() + other.magnitude(), false);
+        return *this;
+    }
+
+    // *this * k for a small constant k; the magnitude is multiplied by k
+    Secp256k1Field52& mul_int(uint32_t k) {
+        for (std::size_t i = 0; i < 5; i++) {
+            this->n[i] *= k;
+        }
+        set_state(magnitude() * static_cast<int>(k), false);
+        return *this;
+    }
+
+    // p * 2(m + 1) - *this, magnitude m + 1; m must be at least the magnitude
+    Secp256k1Field52 negate(int m) const {
+        assert(m >= magnitude() && m < MAX_MAGNITUDE);
+        const uint64_t k = 2 * static_cast<uint64_t>(m + 1);
+        Secp256k1Field52 out;
+        out.n[0] = P0 * k - this->n[0];
+        out.n[1] = M * k - this->n[1];
+        out.n[2] = M * k - this->n[2];
+        out.n[3] = M * k - this->n[3];
+        out.n[4] = M48 * k - this->n[4];
+        out.set_state(m + 1, false);
+        return out;
+    }
+
+    Secp256k1Field52& operator*=(const Secp256k1Field52& other) {
+        assert(magnitude() <= MAX_MUL_MAGNITUDE && other.magnitude() <= MAX_MUL_MAGNITUDE);
+        mul(this->n, this->n, other.n);
+        set_state(1, false);
+        return *this;
+    }
+
+    friend Secp256k1Field52 operator+(Secp256k1Field52 lhs, const Secp256k1Field52& rhs) { return lhs += rhs; }
+    friend Secp256k1Field52 operator*(Secp256k1Field52 lhs, const Secp256k1Field52& rhs) { return lhs *= rhs; }
+
+    Secp256k1Field52 square() const {
+        assert(magnitude() <= MAX_MUL_MAGNITUDE);
+        Secp256k1Field52 out;
+        sqr(out.n, this->n);
+        out.set_state(1, false);
+        return out;
+    }
+
+    // constant time; throws std::domain_error for zero
+    Secp256k1Field52 inverse() const {
+        const uint256 x = to_uint256();
+        if (x.is_zero()) {
+            throw std::domain_error("Cannot divide by zero");
+        }
+        return Secp256k1Field52(uint256::modinv_ct(x, SECP256K1_FIELD_P));
+    }
+
+    // these look at the value below p, so they work on any magnitude
+    bool is_zero() const { return to_uint256().is_zero(); }
+    friend bool operator==(const Secp256k1Field52& lhs, const Secp256k1Field52& rhs) {
+        return lhs.to_uint256() == rhs.to_uint256();
+    }
+    friend bool operator!=(const Secp256k1Field52& lhs, const Secp256k1Field52& rhs) { return !(lhs == rhs); }
+
+    // the low bit of the value; needs normalize() first
+    bool is_odd() const {
+        assert(normalized());
+        return this->n[0] & 1;
+    }
+
+    const uint64_t* limbs() const { return this->n; }
+
+    // the recorded magnitude, and whether normalize() was the last change;
+    // builds with NDEBUG keep no record and report 1 and false
+    int magnitude() const {
+#ifndef NDEBUG
+        return this->mag;
+#else
+        return 1;
+#endif
+    }
+    bool normalized() const {
+#ifndef NDEBUG
+        return this->norm;
+#else
+        return false;
+#endif
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const Secp256k1Field52& a) {
+        return os << "Secp256k1Field52(" << a.value() << ")";
+    }
+
+private:
+    typedef unsigned __int128 wide_t;
+
+    static constexpr uint64_t M = 0xFFFFFFFFFFFFF;         // 52 bits
+    static constexpr uint64_t M48 = 0xFFFFFFFFFFFF;        // 48 bits, the top limb
+    static constexpr uint64_t P0 = 0xFFFFEFFFFFC2F;        // low limb of p; the others are M, M, M, M48
+    static constexpr uint64_t C = SECP256K1_FIELD_C;       // 2^256 mod p
+    static constexpr uint64_t R = SECP256K1_FIELD_C << 4;  // 2^260 mod p, the weight just past the top limb
+
+    uint64_t n[5];
+#ifndef NDEBUG
+    int mag;
+    bool norm;
+#endif
+
+    void set_state(int m, bool normalized) {
+#ifndef NDEBUG
+        assert(m <= MAX_MAGNITUDE);
+        this->mag = m;
+        this->norm = normalized;
+#else
+        (void) m;
+        (void) normalized;
+#endif
+    }
+
+    // r = a * b mod p, magnitude 1. Columns 5 to 8 of the product are folded
+    // into columns 0 to 3 with 2^260 = R as they are produced, in two
+    // accumulators so no 128-bit sum overflows. r may alias a or b.
+    static void mul(uint64_t* r, const uint64_t* a, const uint64_t* b) {
+        const uint64_t a0 = a[0], a1 = a[1], a2 = a[2], a3 = a[3], a4 = a[4];
+        const uint64_t b0 = b[0], b1 = b[1], b2 = b[2], b3 = b[3], b4 = b[4];
+
+        wide_t d = static_cast<wide_t>(a0) * b3 + static_cast<wide_t>(a1) * b2
+                + static_cast<wide_t>(a2) * b1 + static_cast<wide_t>(a3) * b0;
+        wide_t c = static_cast<wide_t>(a4) * b4;
+        d += (c & M) * R; c >>= 52;
+        const uint64_t t3 = static_cast<uint64_t>(d) & M; d >>= 52;
+
+        d += static_cast<wide_t>(a0) * b4 + static_cast<wide_t>(a1) * b3 + static_cast<wide_t>(a2) * b2
+                + static_cast<wide_t>(a3) * b1 + static_cast<wide_t>(a4) * b0;
+        d += c * R;
+        uint64_t t4 = static_cast<uint64_t>(d) & M; d >>= 52;
+        const uint64_t tx = t4 >> 48; t4 &= M48;
+
+        c = static_cast<wide_t>(a0) * b0;
+        d += static_cast<wide_t>(a1) * b4 + static_cast<wide_t>(a2) * b3
+                + static_cast<wide_t>(a3) * b2 + static_cast<wide_t>(a4) * b1;
+        uint64_t u0 = static_cast<uint64_t>(d) & M; d >>= 52;
+        u0 = (u0 << 4) | tx;
+        c += static_cast<wide_t>(u0) * C;
+        r[0] = static_cast<uint64_t>(c) & M; c >>= 52;
+
+        c += static_cast<wide_t>(a0) * b1 + static_cast<wide_t>(a1) * b0;
+        d += static_cast<wide_t>(a2) * b4 + static_cast<wide_t>(a3) * b3 + static_cast<wide_t>(a4) * b2;
+        c += (d & M) * R; d >>= 52;
+        r[1] = static_cast<uint64_t>(c) & M; c >>= 52;
+
+        c += static_cast<wide_t>(a0) * b2 + static_cast<wide_t>(a1) * b1 + static_cast<wide_t>(a2) * b0;
+        d += static_cast<wide_t>(a3) * b4 + static_cast<wide_t>(a4) * b3;
+        c += (d & M) * R; d >>= 52;
+        r[2] = static_cast<uint64_t>(c) & M; c >>= 52;
+
+        c += d * R + t3;
+        r[3] = static_cast<uint64_t>(c) & M; c >>= 52;
+        c += t4;
+        r[4] = static_cast<uint64_t>(c);
+    }
+
+    // r = a^2 mod p: mul with the symmetric cross products doubled instead of repeated
+    static void sqr(uint64_t* r, const uint64_t* a) {
+        uint64_t a0 = a[0], a4 = a[4];
+        const uint64_t a1 = a[1], a2 = a[2], a3 = a[3];
+
+        wide_t d = static_cast<wide_t>(a0 * 2) * a3 + static_cast<wide_t>(a1 * 2) * a2;
+        wide_t c = static_cast<wide_t>(a4) * a4;
+        d += (c & M) * R; c >>= 52;
+        const uint64_t t3 = static_cast<uint64_t>(d) & M; d >>= 52;
+
+        a4 *= 2;
+        d += static_cast<wide_t>(a0) * a4 + static_cast<wide_t>(a1 * 2) * a3 + static_cast<wide_t>(a2) * a2;
+        d += c * R;
+        uint64_t t4 = static_cast<uint64_t>(d) & M; d >>= 52;
+        const uint64_t tx = t4 >> 48; t4 &= M48;
+
+        c = static_cast<wide_t>(a0) * a0;
+        d += static_cast<wide_t>(a1) * a4 + static_cast<wide_t>(a2 * 2) * a3;
+        uint64_t u0 = static_cast<uint64_t>(d) & M; d >>= 52;
+        u0 = (u0 << 4) | tx;
+        c += static_cast<wide_t>(u0) * C;
+        r[0] = static_cast<uint64_t>(c) & M; c >>= 52;
+
+        a0 *= 2;
+        c += static_cast<wide_t>(a0) * a1;
+        d += static_cast<wide_t>(a2) * a4 + static_cast<wide_t>(a3) * a3;
+        c += (d & M) * R; d >>= 52;
+        r[1] = static_cast<uint64_t>(c) & M; c >>= 52;
+
+        c += static_cast<wide_t>(a0) * a2 + static_cast<wide_t>(a1) * a1;
+        d += static_cast<wide_t>(a3) * a4;
+        c += (d & M) * R; d >>= 52;
+        r[2] = static_cast<uint64_t>(c) & M; c >>= 52;
+
+        c += d * R + t3;
+        r[3] = static_cast<uint64_t>(c) & M; c >>= 52;
+        c += t4;
+        r[4] = static_cast<uint64_t>(c);
+    }
+};
+#endif
+
+#endif //ECC_SECP256K1FIELD52_H
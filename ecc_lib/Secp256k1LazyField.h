@@ -0,0 +1,31 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_SECP256K1LAZYFIELD_H
+#define ECC_SECP256K1LAZYFIELD_H
+
+#include "Secp256k1Field26.h"
+#include "Secp256k1Field52.h"
+
+// The lazily reduced secp256k1 element for this target: five 52-bit limbs
+// where the compiler has 128-bit products, ten 26-bit limbs otherwise. Define
+// SECP256K1_FIELD_LIMB_BITS as 52 or 26 to choose one explicitly; code written
+// against Secp256k1LazyField and its MAX_MAGNITUDE runs unchanged on either.
+#ifndef SECP256K1_FIELD_LIMB_BITS
+#if defined(__SIZEOF_INT128__)
+#define SECP256K1_FIELD_LIMB_BITS 52
+#else
+#define SECP256K1_FIELD_LIMB_BITS 26
+#endif
+#endif
+
+#if SECP256K1_FIELD_LIMB_BITS == 52
+typedef Secp256k1Field52 Secp256k1LazyField;
+#elif SECP256K1_FIELD_LIMB_BITS == 26
+typedef Secp256k1Field26 Secp256k1LazyField;
+#else
+#error "SECP256K1_FIELD_LIMB_BITS must be 52 or 26"
+#endif
+
+#endif //ECC_SECP256K1LAZYFIELD_H
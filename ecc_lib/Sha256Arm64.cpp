@@ -0,0 +1,61 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include "sha256.h"
+
+#if defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#endif
+
+#if defined(__clang__)
+#define ECC_ARMV8_SHA2 __attribute__((target("sha2")))
+#else
+#define ECC_ARMV8_SHA2 __attribute__((target("+crypto")))
+#endif
+
+// SHA256H and SHA256H2 do four rounds on ABCD and EFGH, the second taking
+// ABCD as it was before the first; SHA256SU0 and SHA256SU1 extend the
+// schedule four words at a time. m[g % 4] holds words 4g to 4g + 3.
+ECC_ARMV8_SHA2 static void armv8_blocks(uint32_t* h, const uint8_t* in, std::size_t blocks) {
+    uint32x4_t abcd = vld1q_u32(h), efgh = vld1q_u32(h + 4);
+    for (; blocks; blocks--, in += 64) {
+        const uint32x4_t abcd_in = abcd, efgh_in = efgh;
+        uint32x4_t m[4];
+        for (std::size_t g = 0; g < 16; g++) {
+            if (g < 4) {
+                m[g] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(in + 16 * g)));
+            } else {
+                m[g % 4] = vsha256su1q_u32(vsha256su0q_u32(m[g % 4], m[(g + 1) % 4]), m[(g + 2) % 4], m[(g + 3) % 4]);
+            }
+            const uint32x4_t wk = vaddq_u32(m[g % 4], vld1q_u32(SHA256_K + 4 * g));
+            const uint32x4_t before = abcd;
+            abcd = vsha256hq_u32(abcd, efgh, wk);
+            efgh = vsha256h2q_u32(efgh, before, wk);
+        }
+        abcd = vaddq_u32(abcd, abcd_in);
+        efgh = vaddq_u32(efgh, efgh_in);
+    }
+    vst1q_u32(h, abcd);
+    vst1q_u32(h + 4, efgh);
+}
+
+Sha256Blocks armv8_sha256_blocks() {
+#if defined(__APPLE__)
+    return armv8_blocks;
+#elif defined(__linux__) && defined(HWCAP_SHA2)
+    return (getauxval(AT_HWCAP) & HWCAP_SHA2) ? armv8_blocks : nullptr;
+#else
+    return nullptr;
+#endif
+}
+
+#else
+
+Sha256Blocks armv8_sha256_blocks() {
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,230 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include "sha256.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+
+#include <immintrin.h>
+
+#define ECC_SHA_NI __attribute__((target("sha,sse4.1,ssse3")))
+#define ECC_AVX2 __attribute__((target("avx2")))
+#define ECC_AVX512 __attribute__((target("avx512f,avx512vl,avx2")))
+
+// The SHA extensions keep the state as ABEF and CDGH and do two rounds per
+// SHA256RNDS2, taking the two message words plus constants from the low half
+// of its third operand. SHA256MSG1 and SHA256MSG2 do the two halves of the
+// schedule for four words; the W[t - 7] term between them is an ALIGNR of the
+// last two groups. m[g % 4] holds words 4g to 4g + 3.
+ECC_SHA_NI static void sha_ni_blocks(uint32_t* h, const uint8_t* in, std::size_t blocks) {
+    const __m128i swap = _mm_set_epi64x(0x0C0D0E0F08090A0BULL, 0x0405060700010203ULL);
+    const __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h)), 0xB1);
+    const __m128i efgh = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h + 4)), 0x1B);
+    __m128i abef = _mm_alignr_epi8(abcd, efgh, 8);
+    __m128i cdgh = _mm_blend_epi16(efgh, abcd, 0xF0);
+
+    for (; blocks; blocks--, in += 64) {
+        const __m128i abef_in = abef, cdgh_in = cdgh;
+        __m128i m[4];
+        for (std::size_t g = 0; g < 16; g++) {
+            if (g < 4) {
+                m[g] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16 * g)), swap);
+            } else {
+                const __m128i w = _mm_add_epi32(_mm_sha256msg1_epu32(m[g % 4], m[(g + 1) % 4]),
+                                                _mm_alignr_epi8(m[(g + 3) % 4], m[(g + 2) % 4], 4));
+                m[g % 4] = _mm_sha256msg2_epu32(w, m[(g + 3) % 4]);
+            }
+            const __m128i wk = _mm_add_epi32(m[g % 4],
+                                             _mm_loadu_si128(reinterpret_cast<const __m128i*>(SHA256_K + 4 * g)));
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk);
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(wk, 0x0E));
+        }
+        abef = _mm_add_epi32(abef, abef_in);
+        cdgh = _mm_add_epi32(cdgh, cdgh_in);
+    }
+
+    const __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+    const __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(h), _mm_blend_epi16(feba, dchg, 0xF0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(h + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+Sha256Blocks sha_ni_sha256_blocks() {
+    return __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1") ? sha_ni_blocks : nullptr;
+}
+
+// Multi-buffer: the same rounds on every lane, word for word. Each block is
+// read as eight 32-byte rows, one a lane, and transposed so that vector w
+// holds word w of every lane; the rotations are two shifts with AVX2 and
+// VPRORD with AVX-512, whose VPTERNLOGD also does Ch and Maj in one step.
+
+namespace {
+
+// rows r[l] = bytes [0, 32) of lane l to columns r[w] = word w of lanes 0..7, big-endian
+ECC_AVX2 inline void transpose8(__m256i* r) {
+    const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]), t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+    const __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]), t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+    const __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]), t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+    const __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]), t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+    const __m256i u0 = _mm256_unpacklo_epi64(t0, t2), u1 = _mm256_unpackhi_epi64(t0, t2);
+    const __m256i u2 = _mm256_unpacklo_epi64(t1, t3), u3 = _mm256_unpackhi_epi64(t1, t3);
+    const __m256i u4 = _mm256_unpacklo_epi64(t4, t6), u5 = _mm256_unpackhi_epi64(t4, t6);
+    const __m256i u6 = _mm256_unpacklo_epi64(t5, t7), u7 = _mm256_unpackhi_epi64(t5, t7);
+    const __m256i swap = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+                                         12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    r[0] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u0, u4, 0x20), swap);
+    r[1] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u1, u5, 0x20), swap);
+    r[2] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u2, u6, 0x20), swap);
+    r[3] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u3, u7, 0x20), swap);
+    r[4] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u0, u4, 0x31), swap);
+    r[5] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u1, u5, 0x31), swap);
+    r[6] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u2, u6, 0x31), swap);
+    r[7] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u3, u7, 0x31), swap);
+}
+
+// words 0 to 15 of the block at in[l] + offset for lanes first to first + 7
+ECC_AVX2 inline void load_words8(__m256i* w, const uint8_t* const* in, std::size_t first, std::size_t offset) {
+    for (std::size_t half = 0; half < 2; half++) {
+        __m256i* r = w + 8 * half;
+        for (std::size_t l = 0; l < 8; l++) {
+            r[l] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in[first + l] + offset + 32 * half));
+        }
+        transpose8(r);
+    }
+}
+
+struct Avx2 {
+    typedef __m256i V;
+    static constexpr std::size_t LANES = 8;
+
+    ECC_AVX2 static V load(const uint32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const V*>(p)); }
+    ECC_AVX2 static void store(uint32_t* p, V x) { _mm256_storeu_si256(reinterpret_cast<V*>(p), x); }
+    ECC_AVX2 static V add(V a, V b) { return _mm256_add_epi32(a, b); }
+    ECC_AVX2 static V broadcast(uint32_t x) { return _mm256_set1_epi32(static_cast<int>(x)); }
+    template <int N>
+    ECC_AVX2 static V ror(V x) { return _mm256_or_si256(_mm256_srli_epi32(x, N), _mm256_slli_epi32(x, 32 - N)); }
+    template <int N>
+    ECC_AVX2 static V shr(V x) { return _mm256_srli_epi32(x, N); }
+    ECC_AVX2 static V xor3(V a, V b, V c) { return _mm256_xor_si256(_mm256_xor_si256(a, b), c); }
+    ECC_AVX2 static V ch(V e, V f, V g) { return _mm256_xor_si256(g, _mm256_and_si256(e, _mm256_xor_si256(f, g))); }
+    ECC_AVX2 static V maj(V a, V b, V c) {
+        return _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+    }
+    ECC_AVX2 static void load_words(V* w, const uint8_t* const* in, std::size_t offset) {
+        load_words8(w, in, 0, offset);
+    }
+};
+
+struct Avx512 {
+    typedef __m512i V;
+    static constexpr std::size_t LANES = 16;
+
+    ECC_AVX512 static V load(const uint32_t* p) { return _mm512_loadu_si512(p); }
+    ECC_AVX512 static void store(uint32_t* p, V x) { _mm512_storeu_si512(p, x); }
+    ECC_AVX512 static V add(V a, V b) { return _mm512_add_epi32(a, b); }
+    ECC_AVX512 static V broadcast(uint32_t x) { return _mm512_set1_epi32(static_cast<int>(x)); }
+    template <int N>
+    ECC_AVX512 static V ror(V x) { return _mm512_ror_epi32(x, N); }
+    template <int N>
+    ECC_AVX512 static V shr(V x) { return _mm512_srli_epi32(x, N); }
+    ECC_AVX512 static V xor3(V a, V b, V c) { return _mm512_ternarylogic_epi32(a, b, c, 0x96); }
+    ECC_AVX512 static V ch(V e, V f, V g) { return _mm512_ternarylogic_epi32(e, f, g, 0xCA); }
+    ECC_AVX512 static V maj(V a, V b, V c) { return _mm512_ternarylogic_epi32(a, b, c, 0xE8); }
+    // lanes 0 to 7 in the low half of each word, 8 to 15 in the high
+    ECC_AVX512 static void load_words(V* w, const uint8_t* const* in, std::size_t offset) {
+        __m256i lo[16], hi[16];
+        load_words8(lo, in, 0, offset);
+        load_words8(hi, in, 8, offset);
+        for (std::size_t i = 0; i < 16; i++) {
+            w[i] = _mm512_inserti64x4(_mm512_castsi256_si512(lo[i]), hi[i], 1);
+        }
+    }
+};
+
+// the targets of the callers carry over: each instantiation is inlined into a
+// function compiled for its instruction set, so no vector crosses a call and
+// GCC's warning about the vector ABI does not apply
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+template <typename S>
+__attribute__((always_inline)) inline void multi_blocks(uint32_t* h, const uint8_t* const* in, std::size_t blocks) {
+    typedef typename S::V V;
+    V state[8];
+    for (std::size_t i = 0; i < 8; i++) {
+        state[i] = S::load(h + i * S::LANES);
+    }
+    for (std::size_t b = 0; b < blocks; b++) {
+        V w[16];
+        S::load_words(w, in, 64 * b);
+        V a = state[0], bb = state[1], c = state[2], d = state[3];
+        V e = state[4], f = state[5], g = state[6], hh = state[7];
+        for (std::size_t t = 0; t < 64; t++) {
+            if (t >= 16) {
+                const V w15 = w[(t - 15) % 16], w2 = w[(t - 2) % 16];
+                const V s0 = S::xor3(S::template ror<7>(w15), S::template ror<18>(w15), S::template shr<3>(w15));
+                const V s1 = S::xor3(S::template ror<17>(w2), S::template ror<19>(w2), S::template shr<10>(w2));
+                w[t % 16] = S::add(S::add(w[t % 16], s0), S::add(w[(t - 7) % 16], s1));
+            }
+            const V t1 = S::add(S::add(hh, S::xor3(S::template ror<6>(e), S::template ror<11>(e), S::template ror<25>(e))),
+                                S::add(S::ch(e, f, g), S::add(S::broadcast(SHA256_K[t]), w[t % 16])));
+            const V t2 = S::add(S::xor3(S::template ror<2>(a), S::template ror<13>(a), S::template ror<22>(a)),
+                                S::maj(a, bb, c));
+            hh = g;
+            g = f;
+            f = e;
+            e = S::add(d, t1);
+            d = c;
+            c = bb;
+            bb = a;
+            a = S::add(t1, t2);
+        }
+        state[0] = S::add(state[0], a);
+        state[1] = S::add(state[1], bb);
+        state[2] = S::add(state[2], c);
+        state[3] = S::add(state[3], d);
+        state[4] = S::add(state[4], e);
+        state[5] = S::add(state[5], f);
+        state[6] = S::add(state[6], g);
+        state[7] = S::add(state[7], hh);
+    }
+    for (std::size_t i = 0; i < 8; i++) {
+        S::store(h + i * S::LANES, state[i]);
+    }
+}
+#pragma GCC diagnostic pop
+
+ECC_AVX2 void avx2_blocks(uint32_t* h, const uint8_t* const* in, std::size_t blocks) {
+    multi_blocks<Avx2>(h, in, blocks);
+}
+
+ECC_AVX512 void avx512_blocks(uint32_t* h, const uint8_t* const* in, std::size_t blocks) {
+    multi_blocks<Avx512>(h, in, blocks);
+}
+
+}
+
+const Sha256MultiBuffer* avx2_sha256_multi_buffer() {
+    static const Sha256MultiBuffer kernel = {"avx2", Avx2::LANES, avx2_blocks};
+    return __builtin_cpu_supports("avx2") ? &kernel : nullptr;
+}
+
+const Sha256MultiBuffer* avx512_sha256_multi_buffer() {
+    static const Sha256MultiBuffer kernel = {"avx512", Avx512::LANES, avx512_blocks};
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") ? &kernel : nullptr;
+}
+
+#else
+
+Sha256Blocks sha_ni_sha256_blocks() {
+    return nullptr;
+}
+
+const Sha256MultiBuffer* avx2_sha256_multi_buffer() {
+    return nullptr;
+}
+
+const Sha256MultiBuffer* avx512_sha256_multi_buffer() {
+    return nullptr;
+}
+
+#endif
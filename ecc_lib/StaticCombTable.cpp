@@ -0,0 +1,19 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include "StaticCombTable.h"
+
+static constexpr uint256 secp256k1_g(limb_t l3, limb_t l2, limb_t l1, limb_t l0) {
+    uint256 out(0);
+    out.limb[0] = l0;
+    out.limb[1] = l1;
+    out.limb[2] = l2;
+    out.limb[3] = l3;
+    return out;
+}
+
+constexpr StaticCombTable<Secp256k1FieldPrime, 256, 4> SECP256K1_GENERATOR_COMB =
+        static_comb_table<Secp256k1FieldPrime, 256, 4>(
+                secp256k1_g(0x79BE667EF9DCBBAC, 0x55A06295CE870B07, 0x029BFCDB2DCE28D9, 0x59F2815B16F81798),
+                secp256k1_g(0x483ADA7726A3C465, 0x5DA4FBFC0E1108A8, 0xFD17B448A6855419, 0x9C47D08FFB10D4B8),
+                uint256(0));
@@ -0,0 +1,111 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_STATICCOMBTABLE_H
+#define ECC_STATICCOMBTABLE_H
+
+#include <cstddef>
+
+#include "limb.h"
+#include "secp256k1.h"
+#include "StaticFieldElement.h"
+#include "uint256.h"
+
+// The entries of FixedBaseTable(base, Bits, W) computed by the compiler for a
+// curve y^2 = x^3 + ax + b over StaticFieldElement<Prime>: the rows of
+// d * 2^(W i) * base, affine and in plain form, in FixedBaseTable's layout, so
+// that a constexpr instance lands in .rodata and FixedBaseTable reads it in
+// place with no work at startup (see its static-entries constructor). The base
+// must have prime order above 2^W, so that no entry is at infinity.
+template <class Prime, std::size_t Bits, std::size_t W>
+struct StaticCombTable {
+    static constexpr std::size_t ROWS = (Bits + W - 1) / W;
+    static constexpr std::size_t COUNT = ROWS * ((std::size_t(1) << W) - 1);
+    // limbs per coordinate, as FixedBaseTable picks them
+    static constexpr std::size_t WIDTH = (StaticFieldElement<Prime>::P.bits() + 63) / 64;
+
+    // x then y of each entry, WIDTH limbs each
+    limb_t limbs[COUNT * 2 * WIDTH];
+};
+
+template <class F>
+struct StaticJacobian {
+    F X, Y, Z;
+};
+
+// dbl-2007-bl
+template <class F>
+constexpr StaticJacobian<F> static_jacobian_dbl(const StaticJacobian<F>& p, const F& a) {
+    const F xx = p.X.square(), yy = p.Y.square(), yyyy = yy.square(), zz = p.Z.square();
+    const F s = ((p.X + yy).square() - xx - yyyy) * F(uint256(2));
+    const F m = xx * F(uint256(3)) + a * zz.square();
+    const F x = m.square() - s - s;
+    const F eight = F(uint256(8));
+    return {x, m * (s - x) - eight * yyyy, (p.Y + p.Z).square() - yy - zz};
+}
+
+// add-2007-bl, doubling equal points; p and q are never each other's negation
+// in a table of a base of prime order above 2^W
+template <class F>
+constexpr StaticJacobian<F> static_jacobian_add(const StaticJacobian<F>& p, const StaticJacobian<F>& q, const F& a) {
+    const F z1z1 = p.Z.square(), z2z2 = q.Z.square();
+    const F u1 = p.X * z2z2, u2 = q.X * z1z1;
+    const F s1 = p.Y * q.Z * z2z2, s2 = q.Y * p.Z * z1z1;
+    const F h = u2 - u1, r = (s2 - s1) + (s2 - s1);
+    if (h == F() && r == F()) {
+        return static_jacobian_dbl(p, a);
+    }
+    const F i = (h + h).square(), j = h * i, v = u1 * i;
+    const F x = r.square() - j - v - v;
+    return {x, r * (v - x) - (s1 * j + s1 * j), ((p.Z + q.Z).square() - z1z1 - z2z2) * h};
+}
+
+// the table of the affine base point (x, y) on the curve with coefficient a,
+// all plain values below the prime; Z is normalized with a single inversion
+template <class Prime, std::size_t Bits, std::size_t W>
+constexpr StaticCombTable<Prime, Bits, W> static_comb_table(const uint256& x, const uint256& y, const uint256& a) {
+    typedef StaticFieldElement<Prime> F;
+    typedef StaticCombTable<Prime, Bits, W> Table;
+    constexpr std::size_t PER_ROW = (std::size_t(1) << W) - 1;
+
+    const F fa(a);
+    StaticJacobian<F> points[Table::COUNT] = {};
+    StaticJacobian<F> row = {F(x), F(y), F::one()};
+    for (std::size_t i = 0; i < Table::ROWS; i++) {
+        points[i * PER_ROW] = row;
+        for (std::size_t d = 1; d < PER_ROW; d++) {
+            points[i * PER_ROW + d] = static_jacobian_add(points[i * PER_ROW + d - 1], row, fa);
+        }
+        for (std::size_t s = 0; s < W; s++) {
+            row = static_jacobian_dbl(row, fa);
+        }
+    }
+
+    // prefix[i] = Z_0 * ... * Z_i, then Montgomery's trick back down
+    F prefix[Table::COUNT] = {};
+    prefix[0] = points[0].Z;
+    for (std::size_t i = 1; i < Table::COUNT; i++) {
+        prefix[i] = prefix[i - 1] * points[i].Z;
+    }
+    F inverse = prefix[Table::COUNT - 1].power_ct(F::P - uint256(2));
+
+    Table out = {};
+    for (std::size_t i = Table::COUNT; i > 0; i--) {
+        const F z = (i > 1) ? inverse * prefix[i - 2] : inverse;
+        inverse *= points[i - 1].Z;
+        const F zz = z.square();
+        const uint256 ax = (points[i - 1].X * zz).to_uint256(), ay = (points[i - 1].Y * zz * z).to_uint256();
+        for (std::size_t j = 0; j < Table::WIDTH; j++) {
+            out.limbs[(i - 1) * 2 * Table::WIDTH + j] = ax.limb[j];
+            out.limbs[(i - 1) * 2 * Table::WIDTH + Table::WIDTH + j] = ay.limb[j];
+        }
+    }
+    return out;
+}
+
+// FixedBaseTable(G, 256, 4) for the secp256k1 generator G, 960 entries built
+// at compile time (StaticCombTable.cpp)
+extern const StaticCombTable<Secp256k1FieldPrime, 256, 4> SECP256K1_GENERATOR_COMB;
+
+#endif //ECC_STATICCOMBTABLE_H
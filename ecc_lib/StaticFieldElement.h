@@ -0,0 +1,139 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_STATICFIELDELEMENT_H
+#define ECC_STATICFIELDELEMENT_H
+
+#include <ostream>
+#include <stdexcept>
+
+#include "integer.h"
+#include "modexp.h"
+#include "MontgomeryContext.h"
+#include "secp256k1.h"
+#include "uint256.h"
+
+// the limbs of a StaticFieldElement policy as a uint256
+constexpr uint256 static_field_prime(const limb_t (&p)[4]) {
+    uint256 out(0);
+    for (std::size_t i = 0; i < 4; i++) {
+        out.limb[i] = p[i];
+    }
+    return out;
+}
+
+// An element of a prime field chosen at compile time. Prime is a policy type
+// with a static constexpr limb_t P[4], least significant limb first, holding
+// an odd prime below 2^256. Every Montgomery constant is constexpr, so the
+// compiler sees the modulus in the limb loops of each inlined operation; the
+// runtime-prime FieldElement remains the general case.
+//
+// Elements are plain 32-byte values kept in Montgomery form and never allocate.
+// Everything but the integer conversions, inverse() and power() is constexpr,
+// so tables of elements can be computed by the compiler (see StaticCombTable.h).
+template <class Prime>
+class StaticFieldElement {
+public:
+    static constexpr uint256 P = static_field_prime(Prime::P);
+    static constexpr limb_t N0 = montgomery_n0(P.limb[0]);
+    static constexpr uint256 R = montgomery_pow2(uint256::BITS, P);
+    static constexpr uint256 R2 = montgomery_pow2(2 * uint256::BITS, P);
+
+    static_assert(P.limb[0] & 1, "StaticFieldElement needs an odd prime");
+
+    constexpr StaticFieldElement() : v(0) {}
+    // value must be below the prime
+    constexpr explicit StaticFieldElement(const uint256& value) : v(0) {
+        if (value >= P) {
+            throw std::invalid_argument("Num is out of range");
+        }
+        this->v = montgomery_mul(value, R2, P, N0);
+    }
+    explicit StaticFieldElement(const integer& value) {
+        if (value < 0 || value.bit_length() > uint256::BITS) {
+            throw std::invalid_argument("Num is out of range");
+        }
+        *this = StaticFieldElement(uint256::from_integer(value));
+    }
+
+    static constexpr StaticFieldElement one() {
+        StaticFieldElement out;
+        out.v = R;
+        return out;
+    }
+
+    constexpr uint256 to_uint256() const { return montgomery_mul(this->v, uint256(1), P, N0); }
+    integer value() const { return to_uint256().to_integer(); }
+
+    constexpr StaticFieldElement& operator+=(const StaticFieldElement& other) {
+        this->v = montgomery_add(this->v, other.v, P);
+        return *this;
+    }
+    constexpr StaticFieldElement& operator-=(const StaticFieldElement& other) {
+        this->v = montgomery_sub(this->v, other.v, P);
+        return *this;
+    }
+    constexpr StaticFieldElement& operator*=(const StaticFieldElement& other) {
+        this->v = montgomery_mul(this->v, other.v, P, N0);
+        return *this;
+    }
+    StaticFieldElement& operator/=(const StaticFieldElement& other) {
+        return *this *= other.inverse();
+    }
+
+    friend constexpr StaticFieldElement operator+(StaticFieldElement lhs, const StaticFieldElement& rhs) { return lhs += rhs; }
+    friend constexpr StaticFieldElement operator-(StaticFieldElement lhs, const StaticFieldElement& rhs) { return lhs -= rhs; }
+    friend constexpr StaticFieldElement operator*(StaticFieldElement lhs, const StaticFieldElement& rhs) { return lhs *= rhs; }
+    friend StaticFieldElement operator/(StaticFieldElement lhs, const StaticFieldElement& rhs) { return lhs /= rhs; }
+    constexpr StaticFieldElement operator-() const { return StaticFieldElement() - *this; }
+    constexpr StaticFieldElement square() const { return *this * *this; }
+
+    // constant time; throws std::domain_error for zero
+    StaticFieldElement inverse() const {
+        const uint256 x = to_uint256();
+        if (x.is_zero()) {
+            throw std::domain_error("Cannot divide by zero");
+        }
+        return StaticFieldElement(uint256::modinv_ct(x, P));
+    }
+
+    // any integer exponent, reduced mod p - 1; negative exponents invert
+    StaticFieldElement power(const integer& exponent) const {
+        static const integer order = (P - 1).to_integer();
+        integer n = exponent % order;
+        if (n < 0) {
+            n += order;
+        }
+        StaticFieldElement out;
+        out.v = sliding_window_pow(this->v, n, R, [](const uint256& a, const uint256& b) {
+            return montgomery_mul(a, b, P, N0);
+        });
+        return out;
+    }
+
+    // for secret exponents: a Montgomery ladder over all 256 exponent bits
+    constexpr StaticFieldElement power_ct(const uint256& exponent) const {
+        StaticFieldElement out;
+        out.v = montgomery_ladder_pow(this->v, uint256::BITS,
+                [&exponent](std::size_t i) { return (exponent.limb[i / 64] >> (i % 64)) & 1; },
+                R,
+                [](const uint256& a, const uint256& b) { return montgomery_mul(a, b, P, N0); },
+                [](uint256& a, uint256& b, limb_t mask) { uint256::cswap(a, b, mask); });
+        return out;
+    }
+
+    friend constexpr bool operator==(const StaticFieldElement& lhs, const StaticFieldElement& rhs) { return lhs.v == rhs.v; }
+    friend constexpr bool operator!=(const StaticFieldElement& lhs, const StaticFieldElement& rhs) { return !(lhs == rhs); }
+    friend std::ostream& operator<<(std::ostream& os, const StaticFieldElement& a) {
+        return os << "StaticFieldElement_" << P << "(" << a.value() << ")";
+    }
+
+private:
+    uint256 v;      // value * 2^256 mod P
+};
+
+typedef StaticFieldElement<Secp256k1FieldPrime> Secp256k1FieldElement;
+typedef StaticFieldElement<Secp256k1OrderPrime> Secp256k1Scalar;
+
+#endif //ECC_STATICFIELDELEMENT_H
@@ -0,0 +1,45 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <stdexcept>
+
+#include "Status.h"
+
+const char* status_name(Status status) {
+    switch (status) {
+        case Status::ok: return "ok";
+        case Status::out_of_range: return "out_of_range";
+        case Status::not_on_curve: return "not_on_curve";
+        case Status::bad_encoding: return "bad_encoding";
+        case Status::buffer_too_small: return "buffer_too_small";
+        case Status::bad_signature: return "bad_signature";
+        case Status::field_mismatch: return "field_mismatch";
+        case Status::bad_digit: return "bad_digit";
+        case Status::bad_base: return "bad_base";
+        case Status::division_by_zero: return "division_by_zero";
+        case Status::bad_modulus: return "bad_modulus";
+        case Status::not_invertible: return "not_invertible";
+        case Status::not_a_square: return "not_a_square";
+        case Status::infinity: return "infinity";
+    }
+    return "unknown";
+}
+
+void throw_status(Status status, const std::string& message) {
+    switch (status) {
+        case Status::out_of_range:
+        case Status::not_on_curve:
+        case Status::bad_encoding:
+        case Status::buffer_too_small:
+        case Status::bad_signature:
+            throw std::invalid_argument(message);
+        case Status::division_by_zero:
+        case Status::bad_modulus:
+        case Status::not_invertible:
+        case Status::not_a_square:
+        case Status::infinity:
+            throw std::domain_error(message);
+        default:
+            throw std::runtime_error(message);
+    }
+}
@@ -0,0 +1,66 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_STATUS_H
+#define ECC_STATUS_H
+
+#include <cassert>
+#include <optional>
+#include <string>
+#include <utility>
+
+// Failures the non-throwing entry points report instead of throwing: the
+// try_ and make functions of integer, FieldElement and Point return a Result,
+// and the throwing API is a wrapper that turns a failed status into the
+// exception it documents. They are noexcept, so running out of memory
+// terminates rather than being reported.
+enum class Status {
+    ok,
+    out_of_range,       // std::invalid_argument: a value not below the prime, a negative one
+    not_on_curve,       // std::invalid_argument
+    bad_encoding,       // std::invalid_argument: a malformed serialized point
+    buffer_too_small,   // std::invalid_argument
+    bad_signature,      // std::invalid_argument: a signature that does not verify
+    field_mismatch,     // std::runtime_error: operands of different fields
+    bad_digit,          // std::runtime_error: not a digit of the base, or no digits
+    bad_base,           // std::runtime_error
+    division_by_zero,   // std::domain_error
+    bad_modulus,        // std::domain_error: a modulus below 1, or a composite one where a prime is needed
+    not_invertible,     // std::domain_error
+    not_a_square,       // std::domain_error
+    infinity            // std::domain_error: a result at infinity where a finite point is needed
+};
+
+// the name of status, such as "division_by_zero"
+const char* status_name(Status status);
+// throws the exception status maps to, with message
+[[noreturn]] void throw_status(Status status, const std::string& message);
+
+// A value, or the status saying why there is none, in the manner of C++23's
+// std::expected. Reading the value of a failed result is undefined, as it is
+// for an empty std::optional.
+template <typename T>
+class Result {
+public:
+    Result(T value) : v(std::move(value)), s(Status::ok) {}
+    Result(Status status) : s(status) { assert(status != Status::ok); }
+
+    bool ok() const { return this->s == Status::ok; }
+    explicit operator bool() const { return ok(); }
+    Status status() const { return this->s; }
+
+    const T& operator*() const & { return *this->v; }
+    T& operator*() & { return *this->v; }
+    T&& operator*() && { return std::move(*this->v); }
+    const T* operator->() const { return &*this->v; }
+    T* operator->() { return &*this->v; }
+    // the value, or fallback for a failed result
+    T value_or(T fallback) const & { return ok() ? *this->v : fallback; }
+
+private:
+    std::optional<T> v;
+    Status s;
+};
+
+#endif //ECC_STATUS_H
@@ -0,0 +1,178 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstring>
+
+#include "base58.h"
+#include "sha256.h"
+#include "small_vector.h"
+
+namespace {
+
+const char ALPHABET[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+// 58^5, the base of the limbs of an encoding
+const uint64_t BASE = 656356768;
+const uint32_t POWERS[6] = {1, 58, 3364, 195112, 11316496, 656356768};
+
+// the value of each character, or -1 for one outside the alphabet
+struct DigitTable {
+    int8_t value[256];
+
+    DigitTable() {
+        std::memset(this->value, -1, sizeof(this->value));
+        for (int i = 0; i < 58; i++) {
+            this->value[static_cast<uint8_t>(ALPHABET[i])] = static_cast<int8_t>(i);
+        }
+    }
+};
+
+const DigitTable DIGITS;
+
+// addresses and extended keys fit inline: 82 bytes of an xpub are 23 limbs
+typedef small_vector<uint32_t, 32> Limbs;
+
+// limbs = limbs * mul + carry in limbs of 58^5, growing as needed; the
+// division by the constant is a multiplication
+void mul_add(Limbs& limbs, uint64_t mul, uint64_t carry) {
+    for (std::size_t i = 0; i < limbs.size(); i++) {
+        const uint64_t x = limbs[i] * mul + carry;
+        limbs[i] = static_cast<uint32_t>(x % BASE);
+        carry = x / BASE;
+    }
+    while (carry) {
+        limbs.push_back(static_cast<uint32_t>(carry % BASE));
+        carry /= BASE;
+    }
+}
+
+// the same in limbs of 2^32, a mask and a shift
+void mul_add_words(Limbs& limbs, uint64_t mul, uint64_t carry) {
+    for (std::size_t i = 0; i < limbs.size(); i++) {
+        const uint64_t x = limbs[i] * mul + carry;
+        limbs[i] = static_cast<uint32_t>(x);
+        carry = x >> 32;
+    }
+    if (carry) {
+        limbs.push_back(static_cast<uint32_t>(carry));
+    }
+}
+
+}
+
+// the bytes after the leading zeros four at a time, the odd ones first, into
+// limbs of 58^5
+Result<std::size_t> base58_encode(const uint8_t* in, std::size_t len, char* out, std::size_t capacity) {
+    std::size_t zeros = 0;
+    while (zeros < len && in[zeros] == 0) {
+        zeros++;
+    }
+    Limbs limbs;
+    limbs.reserve((len - zeros) * 138 / 500 + 1);
+    for (std::size_t i = zeros, take = (len - zeros) % 4 ? (len - zeros) % 4 : 4; i < len; i += take, take = 4) {
+        uint64_t word = 0;
+        for (std::size_t j = 0; j < take; j++) {
+            word = (word << 8) | in[i + j];
+        }
+        mul_add(limbs, uint64_t(1) << (8 * take), word);
+    }
+
+    // the top limb without its leading zero digits, every other one in five
+    std::size_t top = 0;
+    if (!limbs.empty()) {
+        for (uint32_t v = limbs.back(); v; v /= 58) {
+            top++;
+        }
+    }
+    const std::size_t size = zeros + top + (limbs.empty() ? 0 : 5 * (limbs.size() - 1));
+    if (capacity < size) {
+        return Status::buffer_too_small;
+    }
+    std::memset(out, '1', zeros);
+    char* p = out + size;
+    for (std::size_t i = 0; i < limbs.size(); i++) {
+        uint32_t v = limbs[i];
+        for (std::size_t d = 0, digits = i + 1 < limbs.size() ? 5 : top; d < digits; d++) {
+            *--p = ALPHABET[v % 58];
+            v /= 58;
+        }
+    }
+    return size;
+}
+
+// the digits after the leading '1's five at a time, the odd ones first, into
+// limbs of 2^32
+Result<std::size_t> base58_decode(const char* in, std::size_t len, uint8_t* out, std::size_t capacity) {
+    std::size_t zeros = 0;
+    while (zeros < len && in[zeros] == '1') {
+        zeros++;
+    }
+    Limbs limbs;
+    limbs.reserve((len - zeros) * 733 / 4000 + 1);
+    for (std::size_t i = zeros, take = (len - zeros) % 5 ? (len - zeros) % 5 : 5; i < len; i += take, take = 5) {
+        uint64_t chunk = 0;
+        for (std::size_t j = 0; j < take; j++) {
+            const int8_t digit = DIGITS.value[static_cast<uint8_t>(in[i + j])];
+            if (digit < 0) {
+                return Status::bad_digit;
+            }
+            chunk = chunk * 58 + static_cast<uint64_t>(digit);
+        }
+        mul_add_words(limbs, POWERS[take], chunk);
+    }
+
+    std::size_t top = 0;
+    if (!limbs.empty()) {
+        for (uint32_t v = limbs.back(); v; v >>= 8) {
+            top++;
+        }
+    }
+    const std::size_t size = zeros + top + (limbs.empty() ? 0 : 4 * (limbs.size() - 1));
+    if (capacity < size) {
+        return Status::buffer_too_small;
+    }
+    std::memset(out, 0, zeros);
+    uint8_t* p = out + size;
+    for (std::size_t i = 0; i < limbs.size(); i++) {
+        uint32_t v = limbs[i];
+        for (std::size_t b = 0, bytes = i + 1 < limbs.size() ? 4 : top; b < bytes; b++) {
+            *--p = static_cast<uint8_t>(v);
+            v >>= 8;
+        }
+    }
+    return size;
+}
+
+Result<std::size_t> base58check_encode(const uint8_t* payload, std::size_t len, char* out,
+                                       std::size_t capacity) {
+    small_vector<uint8_t, 128> data(len + 4);
+    std::memcpy(data.data(), payload, len);
+    uint8_t digest[Sha256::DIGEST_SIZE];
+    Sha256::hash(payload, len, digest);
+    Sha256::hash(digest, sizeof(digest), digest);
+    std::memcpy(data.data() + len, digest, 4);
+    return base58_encode(data.data(), data.size(), out, capacity);
+}
+
+Result<std::size_t> base58check_decode(const char* in, std::size_t len, uint8_t* out, std::size_t capacity) {
+    small_vector<uint8_t, 128> data(base58_max_decoded(len));
+    const Result<std::size_t> size = base58_decode(in, len, data.data(), data.size());
+    if (!size.ok()) {
+        return size.status();
+    }
+    if (*size < 4) {
+        return Status::bad_encoding;
+    }
+    const std::size_t payload = *size - 4;
+    uint8_t digest[Sha256::DIGEST_SIZE];
+    Sha256::hash(data.data(), payload, digest);
+    Sha256::hash(digest, sizeof(digest), digest);
+    if (std::memcmp(digest, data.data() + payload, 4) != 0) {
+        return Status::bad_encoding;
+    }
+    if (capacity < payload) {
+        return Status::buffer_too_small;
+    }
+    std::memcpy(out, data.data(), payload);
+    return payload;
+}
@@ -0,0 +1,43 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_BASE58_H
+#define ECC_BASE58_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Status.h"
+
+// Base58 of Bitcoin addresses and extended keys, in caller-owned buffers: the
+// big-endian number in the bytes written in the digits
+// 123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz, with one '1' for
+// each leading zero byte. The base conversion runs on words, five digits of
+// 58 to a limb below 58^5 < 2^32 one way and 32 bits to a limb the other, so
+// a 25-byte address takes a few dozen 64-bit multiplications rather than one
+// division per digit. Base58Check appends the first 4 bytes of
+// SHA-256(SHA-256(payload)) before encoding. Inputs past the inline buffers
+// of a few hundred bytes allocate, so the functions may throw std::bad_alloc.
+
+// at least the characters of the Base58 of len bytes (log 256 / log 58 is
+// below 1.38), and at least the bytes the decoding of len characters can have
+inline std::size_t base58_max_encoded(std::size_t len) { return len * 138 / 100 + 1; }
+inline std::size_t base58_max_decoded(std::size_t len) { return len; }
+
+// writes the Base58 of in[0, len) to out, with no terminator, and returns the
+// number of characters; Status::buffer_too_small if capacity is less
+Result<std::size_t> base58_encode(const uint8_t* in, std::size_t len, char* out, std::size_t capacity);
+// writes the bytes of the Base58 in[0, len) to out and returns their number;
+// Status::bad_digit for a character outside the alphabet,
+// Status::buffer_too_small if capacity is less
+Result<std::size_t> base58_decode(const char* in, std::size_t len, uint8_t* out, std::size_t capacity);
+
+// base58_encode of payload[0, len) and its checksum
+Result<std::size_t> base58check_encode(const uint8_t* payload, std::size_t len, char* out,
+                                       std::size_t capacity);
+// the payload of the Base58Check in[0, len), as base58_decode, with
+// Status::bad_encoding for fewer than 4 bytes or a checksum that does not match
+Result<std::size_t> base58check_decode(const char* in, std::size_t len, uint8_t* out, std::size_t capacity);
+
+#endif //ECC_BASE58_H
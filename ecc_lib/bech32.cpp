@@ -0,0 +1,301 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include "bech32.h"
+#include "small_vector.h"
+
+namespace {
+
+const char CHARSET[] = "qpzry9x8gf2tvdw0s3jn54khce6mua7l";
+
+// the value the checksum leaves, by variant
+uint32_t residue(Bech32Variant variant) {
+    return variant == Bech32Variant::bech32 ? 1 : 0x2BC830A3;
+}
+
+// one step of the polymod of BIP173: the checksum times x plus v, mod the generator
+constexpr uint32_t step(uint32_t chk, uint32_t v) {
+    const uint32_t GENERATOR[5] = {0x3B6A57B2, 0x26508E6D, 0x1EA119FA, 0x3D4233DD, 0x2A1462B3};
+    const uint32_t top = chk >> 25;
+    chk = ((chk & 0x1FFFFFF) << 5) ^ v;
+    for (std::size_t i = 0; i < 5; i++) {
+        if ((top >> i) & 1) {
+            chk ^= GENERATOR[i];
+        }
+    }
+    return chk;
+}
+
+// Two steps are linear in the checksum: its low 20 bits just move up 10, and
+// what its top 10 bits add is TWO_STEPS[top]
+struct TwoSteps {
+    uint32_t value[1024];
+};
+
+constexpr TwoSteps two_steps() {
+    TwoSteps table{};
+    for (uint32_t t = 0; t < 1024; t++) {
+        table.value[t] = step(step(t << 20, 0), 0);
+    }
+    return table;
+}
+
+constexpr TwoSteps TWO_STEPS = two_steps();
+
+// the polymod of the values in[0, len), two at a time
+uint32_t polymod(const uint8_t* in, std::size_t len) {
+    uint32_t chk = 1;
+    std::size_t i = 0;
+    for (; i + 2 <= len; i += 2) {
+        chk = ((chk & 0xFFFFF) << 10) ^ TWO_STEPS.value[chk >> 20] ^ (static_cast<uint32_t>(in[i]) << 5) ^ in[i + 1];
+    }
+    if (i < len) {
+        chk = step(chk, in[i]);
+    }
+    return chk;
+}
+
+// the value of each character of the alphabet, either case, or -1
+struct CharTable {
+    int8_t value[128];
+};
+
+constexpr CharTable char_table() {
+    CharTable table{};
+    for (std::size_t c = 0; c < 128; c++) {
+        table.value[c] = -1;
+    }
+    for (std::size_t i = 0; i < 32; i++) {
+        const char c = CHARSET[i];
+        table.value[static_cast<std::size_t>(c)] = static_cast<int8_t>(i);
+        if (c >= 'a' && c <= 'z') {
+            table.value[static_cast<std::size_t>(c - 'a' + 'A')] = static_cast<int8_t>(i);
+        }
+    }
+    return table;
+}
+
+constexpr CharTable CHARS = char_table();
+
+char lower(char c) {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// the values the checksum covers: the hrp's high bits, a zero, its low bits, then data
+typedef small_vector<uint8_t, 192> Values;
+
+void expand(Values& values, const char* hrp, std::size_t hrp_len, const uint8_t* data, std::size_t len) {
+    values.resize(2 * hrp_len + 1 + len + 6);
+    for (std::size_t i = 0; i < hrp_len; i++) {
+        const uint8_t c = static_cast<uint8_t>(lower(hrp[i]));
+        values[i] = c >> 5;
+        values[hrp_len + 1 + i] = c & 31;
+    }
+    values[hrp_len] = 0;
+    for (std::size_t i = 0; i < len; i++) {
+        values[2 * hrp_len + 1 + i] = data[i];
+    }
+}
+
+}
+
+Result<std::size_t> bech32_encode(const char* hrp, std::size_t hrp_len, const uint8_t* data, std::size_t len,
+                                  Bech32Variant variant, char* out, std::size_t capacity) noexcept {
+    if (hrp_len == 0) {
+        return Status::bad_encoding;
+    }
+    uint8_t bad = 0;
+    for (std::size_t i = 0; i < hrp_len; i++) {
+        bad |= (hrp[i] < 33) | (hrp[i] > 126);
+    }
+    for (std::size_t i = 0; i < len; i++) {
+        bad |= data[i] >> 5;
+    }
+    if (bad) {
+        return Status::bad_encoding;
+    }
+    const std::size_t size = hrp_len + 1 + len + 6;
+    if (capacity < size) {
+        return Status::buffer_too_small;
+    }
+
+    Values values;
+    expand(values, hrp, hrp_len, data, len);
+    for (std::size_t i = 0; i < 6; i++) {
+        values[values.size() - 6 + i] = 0;
+    }
+    const uint32_t mod = polymod(values.data(), values.size()) ^ residue(variant);
+    for (std::size_t i = 0; i < hrp_len; i++) {
+        out[i] = lower(hrp[i]);
+    }
+    out[hrp_len] = '1';
+    for (std::size_t i = 0; i < len; i++) {
+        out[hrp_len + 1 + i] = CHARSET[data[i]];
+    }
+    for (std::size_t i = 0; i < 6; i++) {
+        out[hrp_len + 1 + len + i] = CHARSET[(mod >> (5 * (5 - i))) & 31];
+    }
+    return size;
+}
+
+Result<Bech32Decoded> bech32_decode(const char* in, std::size_t len, char* hrp, std::size_t hrp_capacity,
+                                    uint8_t* data, std::size_t data_capacity) noexcept {
+    if (len > 90) {
+        return Status::bad_encoding;
+    }
+    bool has_lower = false, has_upper = false, out_of_range = false;
+    std::size_t separator = len;
+    for (std::size_t i = 0; i < len; i++) {
+        has_lower |= in[i] >= 'a' && in[i] <= 'z';
+        has_upper |= in[i] >= 'A' && in[i] <= 'Z';
+        out_of_range |= in[i] < 33 || in[i] > 126;
+        if (in[i] == '1') {
+            separator = i;
+        }
+    }
+    if ((has_lower && has_upper) || out_of_range || separator == len || separator == 0 || separator + 7 > len) {
+        return Status::bad_encoding;
+    }
+    const std::size_t hrp_len = separator, values_len = len - separator - 1;
+    if (hrp_capacity < hrp_len || data_capacity < values_len - 6) {
+        return Status::buffer_too_small;
+    }
+
+    uint8_t values[90];
+    for (std::size_t i = 0; i < values_len; i++) {
+        const int8_t v = CHARS.value[static_cast<uint8_t>(in[separator + 1 + i])];
+        if (v < 0) {
+            return Status::bad_digit;
+        }
+        values[i] = static_cast<uint8_t>(v);
+    }
+    Values expanded;
+    expand(expanded, in, hrp_len, values, values_len);
+    const uint32_t mod = polymod(expanded.data(), expanded.size() - 6);
+    Bech32Variant variant;
+    if (mod == residue(Bech32Variant::bech32)) {
+        variant = Bech32Variant::bech32;
+    } else if (mod == residue(Bech32Variant::bech32m)) {
+        variant = Bech32Variant::bech32m;
+    } else {
+        return Status::bad_encoding;
+    }
+
+    for (std::size_t i = 0; i < hrp_len; i++) {
+        hrp[i] = lower(in[i]);
+    }
+    for (std::size_t i = 0; i + 6 < values_len; i++) {
+        data[i] = values[i];
+    }
+    return Bech32Decoded{variant, hrp_len, values_len - 6};
+}
+
+Result<std::size_t> bech32_from_bytes(const uint8_t* in, std::size_t len, uint8_t* out, std::size_t capacity) noexcept {
+    const std::size_t size = (8 * len + 4) / 5;
+    if (capacity < size) {
+        return Status::buffer_too_small;
+    }
+    std::size_t i = 0, o = 0;
+    for (; i + 5 <= len; i += 5, o += 8) {
+        uint64_t word = 0;
+        for (std::size_t j = 0; j < 5; j++) {
+            word = (word << 8) | in[i + j];
+        }
+        for (std::size_t j = 0; j < 8; j++) {
+            out[o + j] = static_cast<uint8_t>((word >> (35 - 5 * j)) & 31);
+        }
+    }
+    // the last bytes, fewer than five, shifted up to whole values
+    if (i < len) {
+        uint64_t word = 0;
+        for (std::size_t j = i; j < len; j++) {
+            word = (word << 8) | in[j];
+        }
+        const std::size_t bits = 8 * (len - i), values = size - o;
+        word <<= 5 * values - bits;
+        for (std::size_t j = 0; j < values; j++) {
+            out[o + j] = static_cast<uint8_t>((word >> (5 * (values - 1 - j))) & 31);
+        }
+    }
+    return size;
+}
+
+Result<std::size_t> bech32_to_bytes(const uint8_t* in, std::size_t len, uint8_t* out, std::size_t capacity) noexcept {
+    const std::size_t size = 5 * len / 8, padding = 5 * len % 8;
+    uint8_t bad = padding > 4;
+    for (std::size_t i = 0; i < len; i++) {
+        bad |= in[i] >> 5;
+    }
+    // the values after the last whole group of eight, the padding at the bottom
+    const std::size_t whole = len / 8 * 8;
+    uint64_t tail = 0;
+    for (std::size_t i = whole; i < len; i++) {
+        tail = (tail << 5) | in[i];
+    }
+    if (bad || (tail & ((uint64_t(1) << padding) - 1))) {
+        return Status::bad_encoding;
+    }
+    if (capacity < size) {
+        return Status::buffer_too_small;
+    }
+    for (std::size_t i = 0, o = 0; i < whole; i += 8, o += 5) {
+        uint64_t word = 0;
+        for (std::size_t j = 0; j < 8; j++) {
+            word = (word << 5) | in[i + j];
+        }
+        for (std::size_t j = 0; j < 5; j++) {
+            out[o + j] = static_cast<uint8_t>(word >> (32 - 8 * j));
+        }
+    }
+    tail >>= padding;
+    for (std::size_t o = whole / 8 * 5; o < size; o++) {
+        out[o] = static_cast<uint8_t>(tail >> (8 * (size - 1 - o)));
+    }
+    return size;
+}
+
+Result<std::size_t> segwit_address_encode(const char* hrp, std::size_t hrp_len, unsigned version,
+                                          const uint8_t* program, std::size_t len, char* out,
+                                          std::size_t capacity) noexcept {
+    if (version > 16 || len < 2 || len > 40 || (version == 0 && len != 20 && len != 32)) {
+        return Status::bad_encoding;
+    }
+    uint8_t data[1 + 64];
+    data[0] = static_cast<uint8_t>(version);
+    const std::size_t values = *bech32_from_bytes(program, len, data + 1, sizeof(data) - 1);
+    return bech32_encode(hrp, hrp_len, data, 1 + values, version == 0 ? Bech32Variant::bech32 : Bech32Variant::bech32m,
+                         out, capacity);
+}
+
+Result<SegwitAddress> segwit_address_decode(const char* hrp, std::size_t hrp_len, const char* in, std::size_t len,
+                                            uint8_t* program, std::size_t capacity) noexcept {
+    char found[90];
+    uint8_t data[90];
+    const Result<Bech32Decoded> decoded = bech32_decode(in, len, found, sizeof(found), data, sizeof(data));
+    if (!decoded.ok()) {
+        return decoded.status();
+    }
+    bool same = decoded->hrp_len == hrp_len;
+    for (std::size_t i = 0; same && i < hrp_len; i++) {
+        same = found[i] == lower(hrp[i]);
+    }
+    if (!same || decoded->data_len == 0 || data[0] > 16) {
+        return Status::bad_encoding;
+    }
+    const unsigned version = data[0];
+    if (decoded->variant != (version == 0 ? Bech32Variant::bech32 : Bech32Variant::bech32m)) {
+        return Status::bad_encoding;
+    }
+    uint8_t bytes[64];
+    const Result<std::size_t> size = bech32_to_bytes(data + 1, decoded->data_len - 1, bytes, sizeof(bytes));
+    if (!size.ok() || *size < 2 || *size > 40 || (version == 0 && *size != 20 && *size != 32)) {
+        return Status::bad_encoding;
+    }
+    if (capacity < *size) {
+        return Status::buffer_too_small;
+    }
+    for (std::size_t i = 0; i < *size; i++) {
+        program[i] = bytes[i];
+    }
+    return SegwitAddress{version, *size};
+}
@@ -0,0 +1,76 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_BECH32_H
+#define ECC_BECH32_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Status.h"
+
+// Bech32 of BIP173 and Bech32m of BIP350, the strings of segwit and taproot
+// addresses, in caller-owned buffers: a human-readable part, '1', then 5-bit
+// values in the characters qpzry9x8gf2tvdw0s3jn54khce6mua7l, the last six a
+// checksum. The checksum is a BCH code over GF(32) worked two characters at
+// a time through a table of 1024 entries made at compile time, so a 62-character
+// address is 31 lookups. Nothing throws; failures come back as a Status.
+
+enum class Bech32Variant {
+    bech32,
+    bech32m,
+};
+
+// writes hrp[0, hrp_len), '1', the characters of the 5-bit values
+// data[0, len) and the checksum of variant to out, lower case and without a
+// terminator, and returns the number of characters: Status::bad_encoding for
+// an empty hrp, a character of it outside 33 to 126 or a value of 32 or more,
+// Status::buffer_too_small if capacity is less than hrp_len + len + 7
+Result<std::size_t> bech32_encode(const char* hrp, std::size_t hrp_len, const uint8_t* data, std::size_t len,
+                                  Bech32Variant variant, char* out, std::size_t capacity) noexcept;
+
+struct Bech32Decoded {
+    Bech32Variant variant;
+    std::size_t hrp_len;       // characters written to hrp, in lower case
+    std::size_t data_len;      // 5-bit values written to data, checksum excluded
+};
+
+// the string in[0, len), its hrp into hrp and its values into data:
+// Status::bad_encoding for more than 90 characters, mixed case, no '1' with an
+// hrp before it and six characters after, or a checksum of neither variant,
+// Status::bad_digit for a character outside the alphabet after the '1',
+// Status::buffer_too_small if either capacity is less
+Result<Bech32Decoded> bech32_decode(const char* in, std::size_t len, char* hrp, std::size_t hrp_capacity,
+                                    uint8_t* data, std::size_t data_capacity) noexcept;
+
+// the bytes in[0, len) as 5-bit values, five bytes to eight values at a time,
+// the last value padded with zero bits; returns the number, (8 len + 4) / 5,
+// or Status::buffer_too_small
+Result<std::size_t> bech32_from_bytes(const uint8_t* in, std::size_t len, uint8_t* out, std::size_t capacity) noexcept;
+// the 5-bit values in[0, len) back to bytes, eight values to five bytes at a
+// time: Status::bad_encoding for a value of 32 or more, or for padding of
+// more than 4 bits or that is not zero, Status::buffer_too_small
+Result<std::size_t> bech32_to_bytes(const uint8_t* in, std::size_t len, uint8_t* out, std::size_t capacity) noexcept;
+
+// the segwit address of witness version (0 to 16) and program[0, len) under
+// hrp, Bech32 for version 0 and Bech32m after: Status::bad_encoding for a
+// version above 16, a program outside 2 to 40 bytes, or of version 0 and
+// neither 20 nor 32 bytes. At most 90 characters
+Result<std::size_t> segwit_address_encode(const char* hrp, std::size_t hrp_len, unsigned version,
+                                          const uint8_t* program, std::size_t len, char* out,
+                                          std::size_t capacity) noexcept;
+
+struct SegwitAddress {
+    unsigned version;
+    std::size_t program_len;   // bytes written to program, at most 40
+};
+
+// the version and program of the address in[0, len) under hrp (matched
+// without case), with the rules above and the variant its version calls for:
+// the failures of bech32_decode, and Status::bad_encoding for any other hrp or
+// a program that breaks the rules
+Result<SegwitAddress> segwit_address_decode(const char* hrp, std::size_t hrp_len, const char* in, std::size_t len,
+                                            uint8_t* program, std::size_t capacity) noexcept;
+
+#endif //ECC_BECH32_H
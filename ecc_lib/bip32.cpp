@@ -0,0 +1,209 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <cstring>
+#include <stdexcept>
+
+#include "bip32.h"
+#include "Curve.h"
+#include "sec1.h"
+
+namespace {
+
+const PrimeField& order() {
+    return Curve::secp256k1().scalar_field();
+}
+
+// I_L of I as a Scalar, or Status::infinity when it is not below n
+Result<Scalar> left_half(const uint8_t* I) {
+    const uint256 il = uint256::load_be(I, 32);
+    if (!(il < order().fixed_prime())) {
+        return Status::infinity;
+    }
+    return Scalar::from_bytes(I, 32, order());
+}
+
+}
+
+Bip32Key::Bip32Key(bool priv, const Scalar& k, const Point& K, const uint8_t* chain, uint8_t level, uint32_t number)
+        : priv(priv), k(k), K(K.normalized()), mac(chain, 32), level(level), number(number) {
+    sec1_encode(this->K, true, this->encoded, sizeof(this->encoded));
+    std::memcpy(this->chain, chain, sizeof(this->chain));
+}
+
+Result<Bip32Key> Bip32Key::from_seed(const uint8_t* seed, std::size_t len) noexcept {
+    if (len < 16 || len > 64) {
+        return Status::bad_encoding;
+    }
+    static const char key[] = "Bitcoin seed";
+    uint8_t I[Sha512::DIGEST_SIZE];
+    HmacSha512 mac(reinterpret_cast<const uint8_t*>(key), sizeof(key) - 1);
+    mac.update(seed, len);
+    mac.finish(I);
+    const Result<Scalar> k = left_half(I);
+    if (!k || k->is_zero()) {
+        return Status::infinity;
+    }
+    return Bip32Key(true, *k, Curve::secp256k1().mul_base_ct(k->value()), I + 32, 0, 0);
+}
+
+Result<Bip32Key> Bip32Key::from_private(const uint8_t* secret, const uint8_t* chain_code) noexcept {
+    const uint256 d = uint256::load_be(secret, 32);
+    if (d.is_zero() || !(d < order().fixed_prime())) {
+        return Status::out_of_range;
+    }
+    const Scalar k = Scalar::from_bytes(secret, 32, order());
+    return Bip32Key(true, k, Curve::secp256k1().mul_base_ct(k.value()), chain_code, 0, 0);
+}
+
+Result<Bip32Key> Bip32Key::from_public(const Point& key, const uint8_t* chain_code) noexcept {
+    const Curve& curve = Curve::secp256k1();
+    if (key.curve_a() != curve.a() || key.curve_b() != curve.b()) {
+        return Status::not_on_curve;
+    }
+    if (key.is_infinity()) {
+        return Status::infinity;
+    }
+    return Bip32Key(false, Scalar(order()), key, chain_code, 0, 0);
+}
+
+Bip32Key Bip32Key::neutered() const {
+    Bip32Key out = *this;
+    out.priv = false;
+    out.k = Scalar(order());
+    return out;
+}
+
+void Bip32Key::private_key(uint8_t* out) const {
+    if (!this->priv) {
+        throw std::domain_error("A public extended key has no private key");
+    }
+    this->k.to_bytes(out);
+}
+
+Result<Bip32Key> Bip32Key::child(uint32_t i) const noexcept {
+    return std::move(children(i, 1)[0]);
+}
+
+std::vector<Result<Bip32Key>> Bip32Key::children(uint32_t first, std::size_t count) const {
+    if (count > (uint64_t(1) << 32) - first) {
+        throw std::invalid_argument("Child indices must stay below 2^32");
+    }
+    const Curve& curve = Curve::secp256k1();
+    std::vector<Result<Bip32Key>> out(count, Status::infinity);
+    std::vector<Point> keys;
+    std::vector<Scalar> secrets;
+    std::vector<std::size_t> index;
+    std::vector<uint8_t> codes;
+    for (std::size_t j = 0; j < count; j++) {
+        const uint32_t i = static_cast<uint32_t>(first + j);
+        if (((i & HARDENED) && !this->priv) || this->level == 255) {
+            out[j] = Status::out_of_range;
+            continue;
+        }
+        // I = HMAC-SHA512(c, 0x00 || ser256(k) || ser32(i)) hardened, else
+        // HMAC-SHA512(c, serP(K) || ser32(i))
+        uint8_t data[37];
+        if (i & HARDENED) {
+            data[0] = 0x00;
+            this->k.to_bytes(data + 1);
+        } else {
+            std::memcpy(data, this->encoded, 33);
+        }
+        for (std::size_t b = 0; b < 4; b++) {
+            data[33 + b] = static_cast<uint8_t>(i >> (24 - 8 * b));
+        }
+        uint8_t I[Sha512::DIGEST_SIZE];
+        HmacSha512 mac = this->mac;
+        mac.update(data, sizeof(data));
+        mac.finish(I);
+
+        const Result<Scalar> il = left_half(I);
+        if (!il) {
+            continue;
+        }
+        if (this->priv) {
+            const Scalar child = *il + this->k;
+            if (child.is_zero()) {
+                continue;
+            }
+            keys.push_back(curve.mul_base_ct(child.value()));
+            secrets.push_back(child);
+        } else {
+            const Point child = curve.generator_table().mul(il->value()) + this->K;
+            if (child.is_infinity()) {
+                continue;
+            }
+            keys.push_back(child);
+            secrets.push_back(Scalar(order()));
+        }
+        index.push_back(j);
+        codes.insert(codes.end(), I + 32, I + 64);
+    }
+
+    Point::batch_normalize(keys);
+    for (std::size_t m = 0; m < keys.size(); m++) {
+        const std::size_t j = index[m];
+        out[j] = Bip32Key(this->priv, secrets[m], keys[m], codes.data() + 32 * m, this->level + 1,
+                          static_cast<uint32_t>(first + j));
+    }
+    return out;
+}
+
+Result<Bip32Key> Bip32Key::derive(const std::vector<uint32_t>& path) const noexcept {
+    Result<Bip32Key> node = *this;
+    for (uint32_t i : path) {
+        if (!node) {
+            break;
+        }
+        node = node->child(i);
+    }
+    return node;
+}
+
+Bip32Cache::Bip32Cache(const Bip32Key& root, std::size_t capacity) : root(root), capacity(capacity) {}
+
+Result<Bip32Key> Bip32Cache::node(const std::vector<uint32_t>& path) {
+    std::size_t have = 0;
+    Result<Bip32Key> node = this->root;
+    {
+        std::lock_guard<std::mutex> guard(this->lock);
+        for (std::size_t len = path.size(); len > 0; len--) {
+            const auto it = this->nodes.find(std::vector<uint32_t>(path.begin(), path.begin() + len));
+            if (it != this->nodes.end()) {
+                node = it->second;
+                have = len;
+                break;
+            }
+        }
+    }
+    for (std::size_t len = have + 1; len <= path.size() && node; len++) {
+        node = node->child(path[len - 1]);
+        if (node) {
+            std::lock_guard<std::mutex> guard(this->lock);
+            if (this->nodes.size() < this->capacity) {
+                this->nodes.emplace(std::vector<uint32_t>(path.begin(), path.begin() + len), *node);
+            }
+        }
+    }
+    return node;
+}
+
+Result<Bip32Key> Bip32Cache::derive(const std::vector<uint32_t>& path) {
+    if (path.empty()) {
+        return this->root;
+    }
+    const Result<Bip32Key> parent = node(std::vector<uint32_t>(path.begin(), path.end() - 1));
+    return parent ? parent->child(path.back()) : parent;
+}
+
+std::vector<Result<Bip32Key>> Bip32Cache::children(const std::vector<uint32_t>& parent, uint32_t first,
+                                                   std::size_t count) {
+    const Result<Bip32Key> node = this->node(parent);
+    return node ? node->children(first, count) : std::vector<Result<Bip32Key>>(count, node.status());
+}
+
+std::size_t Bip32Cache::size() const {
+    std::lock_guard<std::mutex> guard(this->lock);
+    return this->nodes.size();
+}
@@ -0,0 +1,103 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_BIP32_H
+#define ECC_BIP32_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "Point.h"
+#include "Scalar.h"
+#include "sha512.h"
+#include "Status.h"
+
+// An extended key of BIP32 on secp256k1: a private key k or a public key K
+// with its 32-byte chain code c, from which the children derive by
+// HMAC-SHA512(c, ..). Each key keeps that HMAC keyed with its chain code, so
+// its children pay only for their own data and not for the key's padded
+// blocks, and keeps K normalized with its compressed encoding, which is the
+// data of every non-hardened child. Fingerprints and the Base58 xprv / xpub
+// forms are left to the caller.
+class Bip32Key {
+public:
+    static constexpr uint32_t HARDENED = 0x80000000;
+
+    // the master key of seed[0, len), 16 to 64 bytes: Status::bad_encoding for
+    // another length, Status::infinity when the seed gives no valid key
+    static Result<Bip32Key> from_seed(const uint8_t* seed, std::size_t len) noexcept;
+    // a key of a secret in 32 big-endian bytes (Status::out_of_range when not in
+    // [1, n)) or of a point on secp256k1 (Status::not_on_curve, Status::infinity)
+    static Result<Bip32Key> from_private(const uint8_t* secret, const uint8_t* chain_code) noexcept;
+    static Result<Bip32Key> from_public(const Point& key, const uint8_t* chain_code) noexcept;
+
+    bool is_private() const { return this->priv; }
+    // the same key and chain code without the secret
+    Bip32Key neutered() const;
+    const Point& public_key() const { return this->K; }
+    // the 33-byte compressed encoding of public_key()
+    const uint8_t* public_key_bytes() const { return this->encoded; }
+    const uint8_t* chain_code() const { return this->chain; }
+    // the secret in out[0, 32); throws std::domain_error for a public key
+    void private_key(uint8_t* out) const;
+    uint8_t depth() const { return this->level; }
+    uint32_t child_number() const { return this->number; }
+
+    // CKDpriv of a private key, CKDpub of a public one, for index i; hardened
+    // indices (HARDENED and up) need the private key. Status::out_of_range for a
+    // hardened index of a public key or below depth 255, Status::infinity for
+    // the index with no child (I_L not below n, or a zero key), where BIP32
+    // says to go on to the next index
+    Result<Bip32Key> child(uint32_t i) const noexcept;
+    // child(first + j) for j in [0, count), which must stay below 2^32 (throws
+    // std::invalid_argument beyond), each child's public key normalized with
+    // the others by one inversion. A public key's children are I_L G from the
+    // generator table plus K; a private key's are (I_L + k) G by
+    // FixedBaseTable::mul_ct
+    std::vector<Result<Bip32Key>> children(uint32_t first, std::size_t count) const;
+    // child() along path from this key
+    Result<Bip32Key> derive(const std::vector<uint32_t>& path) const noexcept;
+
+private:
+    bool priv;
+    Scalar k;                   // zero for a public key
+    Point K;
+    uint8_t encoded[33];
+    uint8_t chain[32];
+    HmacSha512 mac;             // keyed with chain
+    uint8_t level;
+    uint32_t number;
+
+    Bip32Key(bool priv, const Scalar& k, const Point& K, const uint8_t* chain, uint8_t level, uint32_t number);
+};
+
+// Paths from one root with their interior nodes kept, so that the many
+// leaves under m/44'/0'/0'/0 cost one child() each after the first. The
+// node for every proper prefix of a derived path is kept, up to capacity
+// nodes, after which nothing more is added; leaves are never kept. Safe to
+// share between threads: one mutex guards the nodes, and derivation runs
+// outside it.
+class Bip32Cache {
+public:
+    explicit Bip32Cache(const Bip32Key& root, std::size_t capacity = 4096);
+
+    Result<Bip32Key> derive(const std::vector<uint32_t>& path);
+    // Bip32Key::children of the node at parent, kept as an interior node
+    std::vector<Result<Bip32Key>> children(const std::vector<uint32_t>& parent, uint32_t first, std::size_t count);
+    std::size_t size() const;
+
+private:
+    Bip32Key root;
+    std::size_t capacity;
+    mutable std::mutex lock;
+    std::map<std::vector<uint32_t>, Bip32Key> nodes;
+
+    // the node at path, deriving from its longest kept prefix and keeping what it makes
+    Result<Bip32Key> node(const std::vector<uint32_t>& path);
+};
+
+#endif //ECC_BIP32_H
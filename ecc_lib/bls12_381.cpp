@@ -0,0 +1,325 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <stdexcept>
+
+#include "bls12_381.h"
+#include "Curve.h"
+
+namespace {
+
+const ExtensionTower& tower() {
+    return ExtensionTower::bls12_381();
+}
+
+Fp2 fp2(const char* c0, const char* c1) {
+    const PrimeField& field = tower().prime_field();
+    return Fp2(FieldElement(integer(c0, 16), field), FieldElement(integer(c1, 16), field));
+}
+
+// 4 (1 + u), the constant of the twist
+const Fp2& twist_b() {
+    static const Fp2 b = fp2("4", "4");
+    return b;
+}
+
+// the G2 point of the Miller loop, in Jacobian coordinates
+struct LoopPoint {
+    Fp2 x, y, z;
+};
+
+// a line through the loop point, as the coefficients of the sparse Fp12
+// element it evaluates to at a G1 point (px, py): (c2, c1 px, c0 py) for
+// Fp12::mul_by_014
+struct Line {
+    Fp2 c0, c1, c2;
+};
+
+// Aranha, Karabina, Longa, Gebotys and Lopez, algorithm 26: r = 2r and the
+// tangent at r
+Line doubling_step(LoopPoint& r) {
+    const Fp2 t0 = r.x.square();
+    const Fp2 t1 = r.y.square();
+    const Fp2 t2 = t1.square();
+    const Fp2 t3 = ((t1 + r.x).square() - t0 - t2).doubled();
+    const Fp2 t4 = t0 + t0 + t0;
+    const Fp2 t6 = r.x + t4;
+    const Fp2 t5 = t4.square();
+    const Fp2 zz = r.z.square();
+    r.x = t5 - t3 - t3;
+    r.z = (r.z + r.y).square() - t1 - zz;
+    r.y = (t3 - r.x) * t4 - t2.doubled().doubled().doubled();
+    const Fp2 c1 = -(t4 * zz).doubled();
+    const Fp2 c2 = (t6.square() - t0 - t5) - t1.doubled().doubled();
+    const Fp2 c0 = (r.z * zz).doubled();
+    return {c0, c1, c2};
+}
+
+// algorithm 27: r = r + q for an affine q and the line through them
+Line addition_step(LoopPoint& r, const Fp2& qx, const Fp2& qy) {
+    const Fp2 zz = r.z.square();
+    const Fp2 yy = qy.square();
+    const Fp2 t0 = zz * qx;
+    const Fp2 t1 = ((qy + r.z).square() - yy - zz) * zz;
+    const Fp2 t2 = t0 - r.x;
+    const Fp2 t3 = t2.square();
+    const Fp2 t4 = t3.doubled().doubled();
+    const Fp2 t5 = t4 * t2;
+    const Fp2 t6 = t1 - r.y - r.y;
+    const Fp2 t9 = t6 * qx;
+    const Fp2 t7 = t4 * r.x;
+    r.x = t6.square() - t5 - t7 - t7;
+    r.z = (r.z + t2).square() - zz - t3;
+    const Fp2 t8 = (t7 - r.x) * t6;
+    r.y = t8 - (r.y * t5).doubled();
+    const Fp2 t10 = (qy + r.z).square() - yy - r.z.square();
+    const Fp2 c2 = t9.doubled() - t10;
+    const Fp2 c0 = r.z.doubled();
+    const Fp2 c1 = (-t6).doubled();
+    return {c0, c1, c2};
+}
+
+void multiply_line(Fp12& f, const Line& line, const FieldElement& px, const FieldElement& py) {
+    f = f.mul_by_014(line.c2, line.c1 * px, line.c0 * py);
+}
+
+// f^x for f in the cyclotomic subgroup, where inversion is conjugation
+Fp12 cyclotomic_exp(const Fp12& f) {
+    Fp12 out = Fp12::one(tower());
+    bool found = false;
+    for (std::size_t b = 64; b > 0; b--) {
+        const bool bit = (BLS12_381_X >> (b - 1)) & 1;
+        if (found) {
+            out = out.cyclotomic_square();
+        } else {
+            found = bit;
+        }
+        if (bit) {
+            out *= f;
+        }
+    }
+    return out.conjugate();
+}
+
+void check_g1(const Point& p) {
+    if (Curve::of(p) != &Curve::bls12_381()) {
+        throw std::invalid_argument("Pairing needs a point of BLS12-381 G1");
+    }
+}
+
+}
+
+// G2Point
+
+G2Point::G2Point() : X(Fp2::one(tower().prime_field())), Y(X), Z(Fp2::zero(tower().prime_field())) {
+}
+
+G2Point::G2Point(const Fp2& x, const Fp2& y) : X(x), Y(y), Z(Fp2::one(tower().prime_field())) {
+    if (&x.prime_field() != &tower().prime_field() || &y.prime_field() != &tower().prime_field()) {
+        throw std::invalid_argument("G2 coordinates must be in the BLS12-381 field");
+    }
+    if (y.square() != x.square() * x + twist_b()) {
+        throw std::invalid_argument("Point is not on the BLS12-381 twist");
+    }
+}
+
+const G2Point& G2Point::generator() {
+    static const G2Point g(
+        fp2("024aa2b2f08f0a91260805272dc51051c6e47ad4fa403b02b4510b647ae3d1770bac0326a805bbefd48056c8c121bdb8",
+            "13e02b6052719f607dacd3a088274f65596bd0d09920b61ab5da61bbdc7f5049334cf11213945d57e5ac7d055d042b7e"),
+        fp2("0ce5d527727d6e118cc9cdc6da2e351aadfd9baa8cbdd3a76d429a695160d12c923ac9cc3baca289e193548608b82801",
+            "0606c4a02ea734cc32acd2b02bc28b99cb3e287e85a763af267492ab572e99ab3f370d275cec1da1aaa9075ff05f79be"));
+    return g;
+}
+
+std::pair<Fp2, Fp2> G2Point::affine() const {
+    if (is_infinity()) {
+        throw std::domain_error("The point at infinity has no affine coordinates");
+    }
+    const Fp2 zi = this->Z.inverse();
+    const Fp2 zi2 = zi.square();
+    return {this->X * zi2, this->Y * zi2 * zi};
+}
+
+// add-2007-bl, falling back to doubling for equal points
+G2Point G2Point::add(const G2Point& other) const {
+    if (is_infinity()) {
+        return other;
+    }
+    if (other.is_infinity()) {
+        return *this;
+    }
+    const Fp2 z1z1 = this->Z.square();
+    const Fp2 z2z2 = other.Z.square();
+    const Fp2 u1 = this->X * z2z2;
+    const Fp2 u2 = other.X * z1z1;
+    const Fp2 s1 = this->Y * other.Z * z2z2;
+    const Fp2 s2 = other.Y * this->Z * z1z1;
+    const Fp2 h = u2 - u1;
+    const Fp2 r = (s2 - s1).doubled();
+    if (h.is_zero()) {
+        return r.is_zero() ? dbl() : G2Point();
+    }
+    const Fp2 i = h.doubled().square();
+    const Fp2 j = h * i;
+    const Fp2 v = u1 * i;
+    const Fp2 x3 = r.square() - j - v.doubled();
+    const Fp2 y3 = r * (v - x3) - (s1 * j).doubled();
+    const Fp2 z3 = ((this->Z + other.Z).square() - z1z1 - z2z2) * h;
+    return G2Point(x3, y3, z3);
+}
+
+// dbl-2009-l, for a = 0
+G2Point G2Point::dbl() const {
+    if (is_infinity()) {
+        return *this;
+    }
+    const Fp2 a = this->X.square();
+    const Fp2 b = this->Y.square();
+    const Fp2 c = b.square();
+    const Fp2 d = ((this->X + b).square() - a - c).doubled();
+    const Fp2 e = a + a + a;
+    const Fp2 f = e.square();
+    const Fp2 x3 = f - d.doubled();
+    const Fp2 y3 = e * (d - x3) - c.doubled().doubled().doubled();
+    const Fp2 z3 = (this->Y * this->Z).doubled();
+    return G2Point(x3, y3, z3);
+}
+
+G2Point G2Point::mul(const integer& k) const {
+    if (k < 0) {
+        return neg().mul(-k);
+    }
+    G2Point out;
+    for (std::size_t i = k.bit_length(); i > 0; i--) {
+        out = out.dbl();
+        if (k.test_bit(i - 1)) {
+            out = out.add(*this);
+        }
+    }
+    return out;
+}
+
+bool G2Point::in_subgroup() const {
+    return mul(Curve::bls12_381().n()).is_infinity();
+}
+
+bool operator==(const G2Point& lhs, const G2Point& rhs) {
+    if (lhs.is_infinity() || rhs.is_infinity()) {
+        return lhs.is_infinity() == rhs.is_infinity();
+    }
+    const Fp2 z1z1 = lhs.Z.square();
+    const Fp2 z2z2 = rhs.Z.square();
+    return lhs.X * z2z2 == rhs.X * z1z1 && lhs.Y * z2z2 * rhs.Z == rhs.Y * z1z1 * lhs.Z;
+}
+
+std::ostream& operator<<(std::ostream& os, const G2Point& p) {
+    if (p.is_infinity()) {
+        return os << "G2Point(infinity)";
+    }
+    const std::pair<Fp2, Fp2> a = p.affine();
+    return os << "G2Point(" << a.first << ", " << a.second << ")";
+}
+
+// pairing
+
+// the loop of Aranha et al. over the bits of |x| below the top one, and a
+// conjugation at the end for x < 0
+Fp12 bls12_381_miller_loop(const Point* p, const G2Point* q, std::size_t count) {
+    std::vector<Point> g1;
+    std::vector<std::pair<Fp2, Fp2>> g2;
+    for (std::size_t i = 0; i < count; i++) {
+        check_g1(p[i]);
+        if (!p[i].is_infinity() && !q[i].is_infinity()) {
+            g1.push_back(p[i]);
+            g2.push_back(q[i].affine());
+        }
+    }
+    Fp12 f = Fp12::one(tower());
+    if (g1.empty()) {
+        return f;
+    }
+    Point::batch_normalize(g1);
+    std::vector<std::pair<FieldElement, FieldElement>> g1_affine;
+    std::vector<LoopPoint> r;
+    const Fp2 one = Fp2::one(tower().prime_field());
+    for (std::size_t i = 0; i < g1.size(); i++) {
+        g1_affine.push_back(g1[i].affine());
+        r.push_back({g2[i].first, g2[i].second, one});
+    }
+
+    bool found = false;
+    for (std::size_t b = 64; b > 0; b--) {
+        const bool bit = ((BLS12_381_X >> 1) >> (b - 1)) & 1;
+        if (!found) {
+            found = bit;
+            continue;
+        }
+        for (std::size_t i = 0; i < r.size(); i++) {
+            multiply_line(f, doubling_step(r[i]), g1_affine[i].first, g1_affine[i].second);
+        }
+        if (bit) {
+            for (std::size_t i = 0; i < r.size(); i++) {
+                multiply_line(f, addition_step(r[i], g2[i].first, g2[i].second), g1_affine[i].first, g1_affine[i].second);
+            }
+        }
+        f = f.square();
+    }
+    for (std::size_t i = 0; i < r.size(); i++) {
+        multiply_line(f, doubling_step(r[i]), g1_affine[i].first, g1_affine[i].second);
+    }
+    return f.conjugate();
+}
+
+// The hard part (p^4 - p^2 + 1) / r is that of Hayashida, Hayasaka and Teruya
+// ("Efficient Final Exponentiation via Cyclotomic Structure for Pairings over
+// Families of Elliptic Curves", 2020), which raises to 3 (p^4 - p^2 + 1) / r:
+// a fixed power of the pairing, still bilinear and non-degenerate as r does
+// not divide 3
+Fp12 bls12_381_final_exponentiation(const Fp12& f) {
+    // f^(p^6 - 1) then ^(p^2 + 1)
+    Fp12 t2 = f.conjugate() * f.inverse();
+    Fp12 t1 = t2;
+    t2 = t2.frobenius(2) * t1;
+
+    t1 = t2.cyclotomic_square().conjugate();
+    Fp12 t3 = cyclotomic_exp(t2);
+    Fp12 t4 = t3.cyclotomic_square();
+    Fp12 t5 = t1 * t3;
+    t1 = cyclotomic_exp(t5);
+    Fp12 t0 = cyclotomic_exp(t1);
+    Fp12 t6 = cyclotomic_exp(t0);
+    t6 *= t4;
+    t4 = cyclotomic_exp(t6);
+    t5 = t5.conjugate();
+    t4 *= t5 * t2;
+    t5 = t2.conjugate();
+    t1 *= t2;
+    t1 = t1.frobenius(3);
+    t6 *= t5;
+    t6 = t6.frobenius(1);
+    t3 *= t0;
+    t3 = t3.frobenius(2);
+    t3 *= t1;
+    t3 *= t6;
+    return t3 * t4;
+}
+
+Fp12 bls12_381_pairing(const Point& p, const G2Point& q) {
+    return bls12_381_final_exponentiation(bls12_381_miller_loop(&p, &q, 1));
+}
+
+Fp12 bls12_381_multi_pairing(const Point* p, const G2Point* q, std::size_t count) {
+    return bls12_381_final_exponentiation(bls12_381_miller_loop(p, q, count));
+}
+
+Fp12 bls12_381_multi_pairing(const std::vector<Point>& p, const std::vector<G2Point>& q) {
+    if (p.size() != q.size()) {
+        throw std::invalid_argument("Multi-pairing needs as many G1 points as G2 points");
+    }
+    return bls12_381_multi_pairing(p.data(), q.data(), p.size());
+}
+
+bool bls12_381_pairing_check(const Point* p, const G2Point* q, std::size_t count) {
+    return bls12_381_multi_pairing(p, q, count).is_one();
+}
@@ -0,0 +1,98 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_BLS12_381_H
+#define ECC_BLS12_381_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "ExtensionField.h"
+#include "integer.h"
+#include "Point.h"
+
+// The curve parameter x = -0xd201000000010000 of BLS12-381: p and the group
+// order r are polynomials in it, and the Miller loop and the hard part of the
+// final exponentiation both walk its bits
+constexpr uint64_t BLS12_381_X = 0xd201000000010000;      // |x|; x is negative
+
+// G2 of BLS12-381: the points of order r on the sextic twist
+// E'(Fp2): y^2 = x^3 + 4 (1 + u), over ExtensionTower::bls12_381()'s Fp2, in
+// Jacobian coordinates (x, y) = (X / Z^2, Y / Z^3). G1 is Curve::bls12_381(),
+// whose points are ordinary Points. Not constant time.
+class G2Point {
+public:
+    // the point at infinity
+    G2Point();
+    // throws std::invalid_argument unless (x, y) is on the twist
+    G2Point(const Fp2& x, const Fp2& y);
+    // draft-irtf-cfrg-pairing-friendly-curves, section 4.2.1
+    static const G2Point& generator();
+
+    bool is_infinity() const { return this->Z.is_zero(); }
+    // throws std::domain_error for the point at infinity
+    std::pair<Fp2, Fp2> affine() const;
+
+    G2Point add(const G2Point& other) const;
+    G2Point dbl() const;
+    G2Point neg() const { return G2Point(this->X, -this->Y, this->Z); }
+    // k * P by double-and-add; k < 0 multiplies -P
+    G2Point mul(const integer& k) const;
+    // r * P is the point at infinity
+    bool in_subgroup() const;
+
+    G2Point operator+(const G2Point& other) const { return add(other); }
+    G2Point operator-(const G2Point& other) const { return add(other.neg()); }
+    G2Point operator-() const { return neg(); }
+    G2Point& operator+=(const G2Point& other) { return *this = add(other); }
+    G2Point operator*(const integer& k) const { return mul(k); }
+    friend G2Point operator*(const integer& k, const G2Point& p) { return p.mul(k); }
+
+    // cross-multiplied by the Z powers, without an inversion
+    friend bool operator==(const G2Point& lhs, const G2Point& rhs);
+    friend bool operator!=(const G2Point& lhs, const G2Point& rhs) { return !(lhs == rhs); }
+    friend std::ostream& operator<<(std::ostream& os, const G2Point& p);
+
+private:
+    Fp2 X, Y, Z;
+
+    G2Point(const Fp2& X, const Fp2& Y, const Fp2& Z) : X(X), Y(Y), Z(Z) {}
+};
+
+// The optimal ate pairing e: G1 x G2 -> GT, the subgroup of order r of Fp12*
+// (Aranha, Karabina, Longa, Gebotys and Lopez, "Faster Explicit Formulas for
+// Computing Pairings over Ordinary Curves", EUROCRYPT 2011). The Miller loop
+// runs over the bits of |x| with the G2 point in Jacobian coordinates, each
+// doubling and addition step giving its line as three Fp2 coefficients, which
+// multiply into the accumulator sparsely (Fp12::mul_by_014). The final
+// exponentiation is the easy part f^((p^6 - 1)(p^2 + 1)) by a conjugation, an
+// inversion and a Frobenius map, then the hard part by Frobenius maps and five
+// exponentiations by x built from cyclotomic squarings.
+//
+// Every function takes G1 points of Curve::bls12_381() and throws
+// std::invalid_argument for points of any other curve; points at infinity
+// in a pair make that pair's factor 1. Neither G1 nor G2 points are checked
+// to be in their subgroups, which is the caller's job (Point::mul by r,
+// G2Point::in_subgroup) for untrusted input.
+
+// the product of the Miller loops of pairs (p[i], q[i]), one accumulator for
+// them all, so every step costs one Fp12 squaring however many pairs there are
+Fp12 bls12_381_miller_loop(const Point* p, const G2Point* q, std::size_t count);
+// f^(3 (p^12 - 1) / r), the cube of the textbook exponent that the hard
+// part's chain yields; every result is the same fixed power of the textbook pairing
+Fp12 bls12_381_final_exponentiation(const Fp12& f);
+
+// e(p, q)
+Fp12 bls12_381_pairing(const Point& p, const G2Point& q);
+// e(p[0], q[0]) * ... * e(p[count - 1], q[count - 1]) with one final
+// exponentiation: the product a batch of BLS signatures verifies through
+Fp12 bls12_381_multi_pairing(const Point* p, const G2Point* q, std::size_t count);
+Fp12 bls12_381_multi_pairing(const std::vector<Point>& p, const std::vector<G2Point>& q);
+// the multi-pairing is 1
+bool bls12_381_pairing_check(const Point* p, const G2Point* q, std::size_t count);
+
+#endif //ECC_BLS12_381_H
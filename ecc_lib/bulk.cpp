@@ -0,0 +1,441 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "bulk.h"
+#include "decompress.h"
+#include "ecdsa.h"
+#include "schnorr.h"
+#include "sha256.h"
+#include "trace.h"
+
+static const char MAGIC[8] = {'E', 'C', 'C', 'B', 'U', 'L', 'K', '\0'};
+static constexpr uint32_t VERSION = 1;
+static constexpr std::size_t HEADER_SIZE = 32;
+
+static void put_le(uint8_t* out, uint64_t v, std::size_t len) {
+    for (std::size_t i = 0; i < len; i++) {
+        out[i] = static_cast<uint8_t>(v >> (8 * i));
+    }
+}
+
+static uint64_t get_le(const uint8_t* in, std::size_t len) {
+    uint64_t v = 0;
+    for (std::size_t i = len; i > 0; i--) {
+        v = (v << 8) | in[i - 1];
+    }
+    return v;
+}
+
+std::size_t bulk_key_size(BulkScheme scheme) {
+    return scheme == BulkScheme::schnorr ? 32 : 33;
+}
+
+std::size_t bulk_record_size(BulkScheme scheme) {
+    return bulk_key_size(scheme) + 32 + 64;
+}
+
+BulkWriter::BulkWriter(const std::string& path, BulkScheme scheme)
+        : path(path), kind(scheme), out(path, std::ios::binary | std::ios::trunc), count(0) {
+    const uint8_t header[HEADER_SIZE] = {};
+    this->out.write(reinterpret_cast<const char*>(header), HEADER_SIZE);
+    if (!this->out) {
+        throw std::runtime_error("Cannot write bulk file " + path);
+    }
+}
+
+BulkWriter::~BulkWriter() {
+    try {
+        close();
+    } catch (...) {
+    }
+}
+
+void BulkWriter::add(const uint8_t* public_key, const uint8_t* hash, const uint8_t* signature) {
+    this->out.write(reinterpret_cast<const char*>(public_key), static_cast<std::streamsize>(bulk_key_size(this->kind)));
+    this->out.write(reinterpret_cast<const char*>(hash), 32);
+    this->out.write(reinterpret_cast<const char*>(signature), 64);
+    if (!this->out) {
+        throw std::runtime_error("Cannot write bulk file " + this->path);
+    }
+    this->count++;
+}
+
+void BulkWriter::close() {
+    if (!this->out.is_open()) {
+        return;
+    }
+    uint8_t header[HEADER_SIZE] = {};
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    put_le(header + 8, VERSION, 4);
+    put_le(header + 12, static_cast<uint32_t>(this->kind), 4);
+    put_le(header + 16, bulk_record_size(this->kind), 4);
+    put_le(header + 24, this->count, 8);
+    this->out.seekp(0);
+    this->out.write(reinterpret_cast<const char*>(header), HEADER_SIZE);
+    this->out.close();
+    if (!this->out) {
+        throw std::runtime_error("Cannot write bulk file " + this->path);
+    }
+}
+
+// the whole file, mapped read-only with sequential access advised where there
+// is mmap, and read into memory elsewhere
+static std::shared_ptr<const uint8_t> map_file(const std::string& path, std::size_t& bytes) {
+#if defined(__unix__) || defined(__APPLE__)
+    const int fd = open(path.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size <= 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        throw std::runtime_error("Cannot read bulk file " + path);
+    }
+    const std::size_t size = static_cast<std::size_t>(st.st_size);
+    void* map = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        throw std::runtime_error("Cannot map bulk file " + path);
+    }
+    madvise(map, size, MADV_SEQUENTIAL);
+    bytes = size;
+    return std::shared_ptr<const uint8_t>(static_cast<const uint8_t*>(map),
+                                          [size](const uint8_t* p) { munmap(const_cast<uint8_t*>(p), size); });
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("Cannot read bulk file " + path);
+    }
+    bytes = static_cast<std::size_t>(in.tellg());
+    std::shared_ptr<uint8_t> data(new uint8_t[bytes + 1], std::default_delete<uint8_t[]>());
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(data.get()), static_cast<std::streamsize>(bytes));
+    if (!in) {
+        throw std::runtime_error("Cannot read bulk file " + path);
+    }
+    return data;
+#endif
+}
+
+BulkFile::BulkFile(const std::string& path) : bytes(0) {
+    this->data = map_file(path, this->bytes);
+    const uint8_t* h = this->data.get();
+    if (this->bytes < HEADER_SIZE || std::memcmp(h, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Not a bulk file: " + path);
+    }
+    if (get_le(h + 8, 4) != VERSION) {
+        throw std::runtime_error("Unsupported bulk file version in " + path);
+    }
+    const uint64_t scheme = get_le(h + 12, 4);
+    if (scheme < 1 || scheme > 3) {
+        throw std::runtime_error("Unknown scheme in bulk file " + path);
+    }
+    this->kind = static_cast<BulkScheme>(scheme);
+    this->stride = bulk_record_size(this->kind);
+    this->count = get_le(h + 24, 8);
+    if (get_le(h + 16, 4) != this->stride || this->count > (this->bytes - HEADER_SIZE) / this->stride) {
+        throw std::runtime_error("Bulk file " + path + " is truncated or has the wrong record size");
+    }
+    this->records = h + HEADER_SIZE;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+// madvise over the whole pages inside records [first, first + n)
+static void advise(const uint8_t* base, std::size_t bytes, const uint8_t* from, const uint8_t* to, int advice) {
+    const std::uintptr_t page = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+    std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(from);
+    std::uintptr_t end = std::min(reinterpret_cast<std::uintptr_t>(to), reinterpret_cast<std::uintptr_t>(base + bytes));
+    // WILLNEED may round outward, DONTNEED only inward
+    if (advice == MADV_WILLNEED) {
+        begin -= begin % page;
+    } else {
+        begin += (page - begin % page) % page;
+        end -= end % page;
+    }
+    if (begin < end) {
+        madvise(reinterpret_cast<void*>(begin), end - begin, advice);
+    }
+}
+#endif
+
+void BulkFile::will_need(uint64_t first, uint64_t n) const {
+#if defined(__unix__) || defined(__APPLE__)
+    first = std::min(first, this->count);
+    n = std::min(n, this->count - first);
+    advise(this->data.get(), this->bytes, record(first), record(first + n), MADV_WILLNEED);
+#else
+    (void) first;
+    (void) n;
+#endif
+}
+
+void BulkFile::done_with(uint64_t first, uint64_t n) const {
+#if defined(__unix__) || defined(__APPLE__)
+    first = std::min(first, this->count);
+    n = std::min(n, this->count - first);
+    advise(this->data.get(), this->bytes, record(first), record(first + n), MADV_DONTNEED);
+#else
+    (void) first;
+    (void) n;
+#endif
+}
+
+// the records of [first, first + n) that fail, in order
+static void verify_ecdsa(const BulkFile& file, const Curve& curve, uint64_t first, std::size_t n, Executor& executor,
+                         std::vector<uint8_t>& keys, std::vector<uint64_t>& invalid) {
+    keys.resize(n * 33);
+    {
+        ECC_TRACE_SPAN("bulk.decode");
+        for (std::size_t i = 0; i < n; i++) {
+            std::memcpy(&keys[i * 33], file.record(first + i), 33);
+        }
+    }
+    const DecompressedKeys points = decompress_keys(keys.data(), n, curve, executor);
+    std::vector<EcdsaJob> jobs;
+    std::vector<std::size_t> index;
+    jobs.reserve(n);
+    for (std::size_t i = 0; i < n; i++) {
+        if (!points.valid(i)) {
+            continue;
+        }
+        const uint8_t* r = file.record(first + i);
+        jobs.push_back(EcdsaJob{r + 65, r + 33, 32, &points.points[i]});
+        index.push_back(i);
+    }
+    const std::vector<Status> results = ecdsa_verify_batch(curve, jobs, executor);
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        if (j < index.size() && index[j] == i) {
+            if (results[j++] != Status::ok) {
+                invalid.push_back(first + i);
+            }
+        } else {
+            invalid.push_back(first + i);
+        }
+    }
+}
+
+static void verify_schnorr(const BulkFile& file, uint64_t first, std::size_t n, Executor& executor,
+                           std::vector<uint64_t>& invalid) {
+    std::vector<SchnorrSigned> items(n);
+    for (std::size_t i = 0; i < n; i++) {
+        const uint8_t* r = file.record(first + i);
+        items[i] = SchnorrSigned{r + 64, r + 32, 32, r};
+    }
+    if (schnorr_verify_batch(items, executor) == Status::ok) {
+        return;
+    }
+    std::vector<uint8_t> bad(n, 0);
+    executor.run(n, [&](std::size_t i) {
+        bad[i] = schnorr_verify(items[i].signature, items[i].message, 32, items[i].public_key) != Status::ok;
+    });
+    for (std::size_t i = 0; i < n; i++) {
+        if (bad[i]) {
+            invalid.push_back(first + i);
+        }
+    }
+}
+
+BulkVerifyResult bulk_verify(const BulkFile& file, Executor& executor, std::size_t chunk) {
+    return bulk_verify_range(file, 0, file.size(), executor, chunk);
+}
+
+// the records of [first, first + n) that fail appended to invalid, with
+// after(end) once the records before end are done, after every chunk
+static void verify_records(const BulkFile& file, uint64_t first, uint64_t n, Executor& executor, std::size_t chunk,
+                           std::vector<uint64_t>& invalid, const std::function<void(uint64_t)>& after) {
+    chunk = std::max<std::size_t>(chunk, 1);
+    std::vector<uint8_t> keys;
+    const uint64_t end = first + n;
+    file.will_need(first, std::min<uint64_t>(chunk, n));
+    for (uint64_t at = first; at < end; at += chunk) {
+        ECC_TRACE_SPAN("bulk.chunk");
+        const std::size_t m = static_cast<std::size_t>(std::min<uint64_t>(chunk, end - at));
+        // the next chunk, but never past the range into records someone else verifies
+        const uint64_t next = std::min(end, at + chunk);
+        file.will_need(next, std::min<uint64_t>(chunk, end - next));
+        switch (file.scheme()) {
+            case BulkScheme::ecdsa_secp256k1:
+                verify_ecdsa(file, Curve::secp256k1(), at, m, executor, keys, invalid);
+                break;
+            case BulkScheme::ecdsa_p256:
+                verify_ecdsa(file, Curve::p256(), at, m, executor, keys, invalid);
+                break;
+            case BulkScheme::schnorr:
+                verify_schnorr(file, at, m, executor, invalid);
+                break;
+        }
+        file.done_with(at, m);
+        if (after) {
+            after(at + m);
+        }
+    }
+}
+
+BulkVerifyResult bulk_verify_range(const BulkFile& file, uint64_t first, uint64_t n, Executor& executor,
+                                   std::size_t chunk) {
+    if (first > file.size() || n > file.size() - first) {
+        throw std::invalid_argument("Records past the end of the bulk file");
+    }
+    BulkVerifyResult result;
+    result.records = n;
+    verify_records(file, first, n, executor, chunk, result.invalid, nullptr);
+    result.valid = result.records - result.invalid.size();
+    return result;
+}
+
+void bulk_fingerprint(const BulkFile& file, uint8_t* out) {
+    Sha256 digest;
+    if (file.size() > 0) {
+        digest.update(file.record(0), file.record_size());
+        digest.update(file.record(file.size() - 1), file.record_size());
+    }
+    digest.finish(out);
+}
+
+// The sidecar of bulk_verify_resumable: a 64-byte header, "ECCRESUM", the
+// version (u32), the scheme (u32), the record size (u32), four zero bytes, the
+// record count (u64) and the bulk_fingerprint, then one entry per checkpoint:
+// the records done (u64), the count n of invalid records found since the
+// entry before (u64), those n record numbers (u64 each), and the first eight
+// bytes of the SHA-256 of the entry so far. An entry cut short or torn by a
+// crash fails its check and is cut off with everything after it.
+static const char RESUME_MAGIC[8] = {'E', 'C', 'C', 'R', 'E', 'S', 'U', 'M'};
+static constexpr std::size_t RESUME_HEADER_SIZE = 64;
+
+static void resume_header(const BulkFile& file, uint8_t* out) {
+    std::memset(out, 0, RESUME_HEADER_SIZE);
+    std::memcpy(out, RESUME_MAGIC, sizeof(RESUME_MAGIC));
+    put_le(out + 8, VERSION, 4);
+    put_le(out + 12, static_cast<uint32_t>(file.scheme()), 4);
+    put_le(out + 16, file.record_size(), 4);
+    put_le(out + 24, file.size(), 8);
+    bulk_fingerprint(file, out + 32);
+}
+
+// the entry for records done, with the invalid ones since the last entry
+static std::vector<uint8_t> resume_entry(uint64_t done, const uint64_t* invalid, std::size_t n) {
+    std::vector<uint8_t> entry(24 + 8 * n);
+    put_le(entry.data(), done, 8);
+    put_le(entry.data() + 8, n, 8);
+    for (std::size_t i = 0; i < n; i++) {
+        put_le(entry.data() + 16 + 8 * i, invalid[i], 8);
+    }
+    uint8_t check[Sha256::DIGEST_SIZE];
+    Sha256::hash(entry.data(), entry.size() - 8, check);
+    std::memcpy(entry.data() + entry.size() - 8, check, 8);
+    return entry;
+}
+
+BulkVerifyResult bulk_verify_resumable(const BulkFile& file, const std::string& checkpoint, Executor& executor,
+                                       std::size_t chunk, double interval) {
+    uint8_t header[RESUME_HEADER_SIZE];
+    resume_header(file, header);
+    BulkVerifyResult result;
+    result.records = file.size();
+    uint64_t done = 0;
+    std::size_t kept = 0;
+    {
+        std::ifstream in(checkpoint, std::ios::binary);
+        const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        // an empty file is one that was created before the header got out
+        if (!bytes.empty()) {
+            if (bytes.size() < RESUME_HEADER_SIZE || std::memcmp(bytes.data(), header, RESUME_HEADER_SIZE) != 0) {
+                throw std::runtime_error("Checkpoint " + checkpoint + " is not of this bulk file");
+            }
+            kept = RESUME_HEADER_SIZE;
+            while (bytes.size() - kept >= 24) {
+                const uint8_t* p = bytes.data() + kept;
+                const uint64_t at = get_le(p, 8), n = get_le(p + 8, 8);
+                if (at < done || at > file.size() || n > at - done || bytes.size() - kept - 24 < 8 * n) {
+                    break;
+                }
+                std::vector<uint64_t> invalid(n);
+                for (std::size_t i = 0; i < n; i++) {
+                    invalid[i] = get_le(p + 16 + 8 * i, 8);
+                }
+                if (resume_entry(at, invalid.data(), n) != std::vector<uint8_t>(p, p + 24 + 8 * n)) {
+                    break;
+                }
+                result.invalid.insert(result.invalid.end(), invalid.begin(), invalid.end());
+                done = at;
+                kept += 24 + 8 * n;
+            }
+        }
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    const int fd = open(checkpoint.c_str(), O_WRONLY | O_CREAT, 0644);
+    if (fd < 0 || ftruncate(fd, static_cast<off_t>(kept)) != 0 || lseek(fd, 0, SEEK_END) < 0
+        || (kept == 0 && write(fd, header, RESUME_HEADER_SIZE) != static_cast<ssize_t>(RESUME_HEADER_SIZE))) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        throw std::runtime_error("Cannot write checkpoint " + checkpoint);
+    }
+    const auto append = [&](const std::vector<uint8_t>& entry) {
+        if (write(fd, entry.data(), entry.size()) != static_cast<ssize_t>(entry.size()) || fsync(fd) != 0) {
+            throw std::runtime_error("Cannot write checkpoint " + checkpoint);
+        }
+    };
+#else
+    std::ofstream out(checkpoint, std::ios::binary | std::ios::in | std::ios::out);
+    if (!out) {
+        out.open(checkpoint, std::ios::binary | std::ios::out);
+    }
+    out.seekp(static_cast<std::streamoff>(kept));
+    if (kept == 0) {
+        out.write(reinterpret_cast<const char*>(header), RESUME_HEADER_SIZE);
+    }
+    const auto append = [&](const std::vector<uint8_t>& entry) {
+        out.write(reinterpret_cast<const char*>(entry.data()), static_cast<std::streamsize>(entry.size()));
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("Cannot write checkpoint " + checkpoint);
+        }
+    };
+#endif
+
+    // one write and one sync per interval, however many chunks it covers
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point last = Clock::now();
+    std::size_t reported = result.invalid.size();
+    const auto save = [&](uint64_t end) {
+        append(resume_entry(end, result.invalid.data() + reported, result.invalid.size() - reported));
+        reported = result.invalid.size();
+        last = Clock::now();
+    };
+    try {
+        verify_records(file, done, file.size() - done, executor, chunk, result.invalid, [&](uint64_t end) {
+            if (end == file.size() || std::chrono::duration<double>(Clock::now() - last).count() >= interval) {
+                save(end);
+            }
+        });
+        if (done == file.size() && kept == 0) {
+            save(done);
+        }
+    } catch (...) {
+#if defined(__unix__) || defined(__APPLE__)
+        close(fd);
+#endif
+        throw;
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    close(fd);
+#endif
+    result.valid = result.records - result.invalid.size();
+    return result;
+}
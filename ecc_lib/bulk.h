@@ -0,0 +1,121 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_BULK_H
+#define ECC_BULK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Executor.h"
+
+// A file of fixed-size signature records for offline jobs, and a verifier that
+// streams through it. The header is 32 bytes, little-endian: "ECCBULK\0", the
+// version (u32), the scheme (u32), the record size (u32), four zero bytes and
+// the record count (u64). Records follow back to back:
+//
+//     ecdsa_secp256k1, ecdsa_p256   33-byte SEC 1 compressed key, 32-byte hash, 64-byte r || s
+//     schnorr                       32-byte x-only key, 32-byte message, 64-byte BIP340 signature
+enum class BulkScheme : uint32_t {
+    ecdsa_secp256k1 = 1,
+    ecdsa_p256 = 2,
+    schnorr = 3,
+};
+
+// bytes of one record of scheme, and of its key
+std::size_t bulk_record_size(BulkScheme scheme);
+std::size_t bulk_key_size(BulkScheme scheme);
+
+// Writes a bulk file record by record; the count in the header is filled in by
+// close(), which the destructor calls. Throws std::runtime_error if the file
+// cannot be written
+class BulkWriter {
+public:
+    BulkWriter(const std::string& path, BulkScheme scheme);
+    ~BulkWriter();
+    BulkWriter(const BulkWriter&) = delete;
+    BulkWriter& operator=(const BulkWriter&) = delete;
+
+    // bulk_key_size(scheme) bytes of key, 32 of hash or message and 64 of signature
+    void add(const uint8_t* public_key, const uint8_t* hash, const uint8_t* signature);
+    uint64_t size() const { return this->count; }
+    void close();
+
+private:
+    std::string path;
+    BulkScheme kind;
+    std::ofstream out;
+    uint64_t count;
+};
+
+// A bulk file mapped read-only (read into memory where there is no mmap), its
+// records read in place. Throws std::runtime_error if the file cannot be read,
+// has another magic or version, an unknown scheme, or fewer bytes than its
+// count of records needs
+class BulkFile {
+public:
+    explicit BulkFile(const std::string& path);
+
+    BulkScheme scheme() const { return this->kind; }
+    uint64_t size() const { return this->count; }
+    std::size_t record_size() const { return this->stride; }
+    const uint8_t* record(uint64_t i) const { return this->records + i * this->stride; }
+
+    // hints to the kernel: records [first, first + n) are wanted soon, so it
+    // reads them in behind the caller's back; and they are done with, so their
+    // pages can go. Nothing where there is no mmap
+    void will_need(uint64_t first, uint64_t n) const;
+    void done_with(uint64_t first, uint64_t n) const;
+
+private:
+    std::shared_ptr<const uint8_t> data;
+    std::size_t bytes;
+    const uint8_t* records;
+    BulkScheme kind;
+    std::size_t stride;
+    uint64_t count;
+};
+
+struct BulkVerifyResult {
+    uint64_t records = 0;
+    uint64_t valid = 0;
+    // the records that did not verify, ascending
+    std::vector<uint64_t> invalid;
+};
+
+// Verifies every record of file, chunk records at a time, on executor. Before
+// a chunk is verified the next one is handed to will_need, so the disk reads it
+// while the CPUs work, and the one before is given up with done_with. In a
+// chunk the keys are lifted together by decompress_keys (ECDSA) and the
+// records checked by ecdsa_verify_batch, or by one schnorr_verify_batch and one
+// schnorr_verify each only when that fails. Hashes, messages and signatures
+// are read from the mapping, not copied
+BulkVerifyResult bulk_verify(const BulkFile& file, Executor& executor, std::size_t chunk = 16384);
+// the same over records [first, first + n) alone, bytes 32 + first
+// record_size() on: records is n, and invalid holds record numbers of the
+// whole file. Throws std::invalid_argument for records past its end
+BulkVerifyResult bulk_verify_range(const BulkFile& file, uint64_t first, uint64_t n, Executor& executor,
+                                   std::size_t chunk = 16384);
+
+// bulk_verify that can be killed and started again. Every interval seconds
+// the count of records done and the invalid ones found since the last time
+// are appended to the sidecar file at checkpoint, in one write and one fsync
+// (the verification does not wait on the disk in between), and a call that
+// finds a sidecar of the same file goes on after its last complete entry
+// without verifying anything before it again. The sidecar stays when the file
+// is done, so another call returns at once; remove it to verify again. Throws
+// std::runtime_error when the sidecar cannot be written or belongs to another
+// file, told apart by bulk_fingerprint
+BulkVerifyResult bulk_verify_resumable(const BulkFile& file, const std::string& checkpoint, Executor& executor,
+                                       std::size_t chunk = 16384, double interval = 10);
+
+// SHA-256 of the first and last records of file into out[0, 32), with its
+// header a cheap test that two copies of a bulk file are the same
+void bulk_fingerprint(const BulkFile& file, uint8_t* out);
+
+#endif //ECC_BULK_H
@@ -0,0 +1,520 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "bulk_cluster.h"
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+typedef std::chrono::steady_clock Clock;
+
+struct BulkCoordinator::Shard {
+    uint64_t first;
+    uint64_t count;
+    unsigned attempts;
+    bool finished;
+    uint64_t valid;
+    std::vector<uint64_t> invalid;
+};
+
+struct BulkCoordinator::Worker {
+    int fd;
+    bool greeted;
+    // bytes received and not yet parsed
+    std::vector<uint8_t> in;
+    // shards sent and not yet answered, in the order they were sent
+    std::deque<std::size_t> assigned;
+    Clock::time_point heard;
+};
+
+namespace {
+
+const char MAGIC[8] = {'E', 'C', 'C', 'S', 'H', 'A', 'R', 'D'};
+constexpr uint32_t VERSION = 1;
+constexpr std::size_t HELLO_SIZE = 64;
+constexpr std::size_t MESSAGE_SIZE = 24;
+
+void put_le(uint8_t* out, uint64_t v, std::size_t len) {
+    for (std::size_t i = 0; i < len; i++) {
+        out[i] = static_cast<uint8_t>(v >> (8 * i));
+    }
+}
+
+uint64_t get_le(const uint8_t* in, std::size_t len) {
+    uint64_t v = 0;
+    for (std::size_t i = 0; i < len; i++) {
+        v |= static_cast<uint64_t>(in[i]) << (8 * i);
+    }
+    return v;
+}
+
+void make_hello(const BulkFile& file, uint8_t* out) {
+    std::memset(out, 0, HELLO_SIZE);
+    std::memcpy(out, MAGIC, 8);
+    put_le(out + 8, VERSION, 4);
+    put_le(out + 12, static_cast<uint32_t>(file.scheme()), 4);
+    put_le(out + 16, file.record_size(), 4);
+    put_le(out + 24, file.size(), 8);
+    bulk_fingerprint(file, out + 32);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+bool send_all(int fd, const uint8_t* data, std::size_t len) {
+    while (len > 0) {
+        const ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        len -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+bool recv_all(int fd, uint8_t* data, std::size_t len) {
+    while (len > 0) {
+        const ssize_t n = recv(fd, data, len, 0);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        len -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+// shard messages are small and answered at once, so Nagle's delay would only stall them
+void no_delay(int fd) {
+    const int on = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+}
+
+#endif
+
+}
+
+BulkCoordinator::BulkCoordinator(const BulkFile& file, uint16_t port, const BulkClusterOptions& options)
+        : file(file), options(options), listener(-1), bound(0), total(0), restored(0), done(0), log(nullptr) {
+    if (options.shard_records == 0 || options.window == 0 || options.attempts == 0 || options.timeout == 0) {
+        throw std::invalid_argument("Bulk cluster options must be positive");
+    }
+    for (uint64_t first = 0; first < file.size(); first += options.shard_records) {
+        this->work.push_back(Shard{first, std::min(options.shard_records, file.size() - first), 0, false, 0, {}});
+    }
+    this->total = this->work.size();
+    make_hello(file, this->hello);
+    if (!options.checkpoint.empty()) {
+        load_checkpoint();
+    }
+    for (std::size_t i = 0; i < this->work.size(); i++) {
+        if (!this->work[i].finished) {
+            this->pending.push_back(i);
+        }
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    this->listener = socket(AF_INET, SOCK_STREAM, 0);
+    if (this->listener < 0) {
+        if (this->log) {
+            std::fclose(this->log);
+        }
+        throw std::runtime_error("Cannot open a socket for workers");
+    }
+    const int on = 1;
+    setsockopt(this->listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+    socklen_t length = sizeof(address);
+    if (::bind(this->listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || listen(this->listener, 64) != 0
+        || getsockname(this->listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        close(this->listener);
+        if (this->log) {
+            std::fclose(this->log);
+        }
+        throw std::runtime_error("Cannot listen for workers on port " + std::to_string(port));
+    }
+    this->bound = ntohs(address.sin_port);
+#else
+    if (this->log) {
+        std::fclose(this->log);
+    }
+    throw std::runtime_error("Bulk clusters need POSIX sockets");
+#endif
+}
+
+BulkCoordinator::~BulkCoordinator() {
+#if defined(__unix__) || defined(__APPLE__)
+    for (const Worker& worker : this->workers) {
+        if (worker.fd >= 0) {
+            close(worker.fd);
+        }
+    }
+    close(this->listener);
+#endif
+    if (this->log) {
+        std::fclose(this->log);
+    }
+}
+
+// The checkpoint is text: a line naming the job, then a line per finished
+// shard, "shard valid invalid...". It is rewritten whole from what parses, so
+// a line cut short by a crash is dropped, and then appended to
+void BulkCoordinator::load_checkpoint() {
+    const std::string& path = this->options.checkpoint;
+    std::ostringstream job;
+    job << "ecc-shards " << VERSION << ' ' << static_cast<uint32_t>(this->file.scheme()) << ' '
+        << this->file.size() << ' ' << this->options.shard_records << ' ';
+    for (std::size_t i = 32; i < HELLO_SIZE; i++) {
+        static const char HEX[] = "0123456789abcdef";
+        job << HEX[this->hello[i] >> 4] << HEX[this->hello[i] & 15];
+    }
+
+    std::ifstream in(path, std::ios::binary);
+    if (in) {
+        std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::size_t at = text.find('\n');
+        if (at == std::string::npos || text.compare(0, at, job.str()) != 0) {
+            throw std::runtime_error("Checkpoint " + path + " is for another job");
+        }
+        for (std::size_t end; (end = text.find('\n', at + 1)) != std::string::npos; at = end) {
+            std::istringstream line(text.substr(at + 1, end - at - 1));
+            uint64_t index, valid, record;
+            if (!(line >> index >> valid) || index >= this->total) {
+                throw std::runtime_error("Corrupt checkpoint " + path);
+            }
+            Shard& shard = this->work[index];
+            std::vector<uint64_t> invalid;
+            while (line >> record) {
+                if (record < shard.first || record >= shard.first + shard.count
+                    || (!invalid.empty() && record <= invalid.back())) {
+                    throw std::runtime_error("Corrupt checkpoint " + path);
+                }
+                invalid.push_back(record);
+            }
+            if (!line.eof() || valid + invalid.size() != shard.count) {
+                throw std::runtime_error("Corrupt checkpoint " + path);
+            }
+            if (!shard.finished) {
+                shard.finished = true;
+                shard.valid = valid;
+                shard.invalid = std::move(invalid);
+                this->restored++;
+            }
+        }
+    }
+    this->done = this->restored;
+
+    const std::string temporary = path + ".tmp";
+    std::FILE* out = std::fopen(temporary.c_str(), "w");
+    if (!out) {
+        throw std::runtime_error("Cannot write checkpoint " + path);
+    }
+    std::fprintf(out, "%s\n", job.str().c_str());
+    for (std::size_t i = 0; i < this->work.size(); i++) {
+        if (this->work[i].finished) {
+            std::fprintf(out, "%zu %llu", i, static_cast<unsigned long long>(this->work[i].valid));
+            for (uint64_t record : this->work[i].invalid) {
+                std::fprintf(out, " %llu", static_cast<unsigned long long>(record));
+            }
+            std::fputc('\n', out);
+        }
+    }
+    const bool written = std::fflush(out) == 0;
+#if defined(__unix__) || defined(__APPLE__)
+    fsync(fileno(out));
+#endif
+    std::fclose(out);
+    if (!written || std::rename(temporary.c_str(), path.c_str()) != 0
+        || !(this->log = std::fopen(path.c_str(), "a"))) {
+        throw std::runtime_error("Cannot write checkpoint " + path);
+    }
+}
+
+void BulkCoordinator::finish(std::size_t index, uint64_t valid, std::vector<uint64_t> invalid) {
+    Shard& shard = this->work[index];
+    shard.finished = true;
+    shard.valid = valid;
+    shard.invalid = std::move(invalid);
+    this->done++;
+    if (this->log) {
+        std::fprintf(this->log, "%zu %llu", index, static_cast<unsigned long long>(valid));
+        for (uint64_t record : shard.invalid) {
+            std::fprintf(this->log, " %llu", static_cast<unsigned long long>(record));
+        }
+        std::fputc('\n', this->log);
+        if (std::fflush(this->log) != 0) {
+            throw std::runtime_error("Cannot write checkpoint " + this->options.checkpoint);
+        }
+#if defined(__unix__) || defined(__APPLE__)
+        fsync(fileno(this->log));
+#endif
+    }
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+bool BulkCoordinator::refill(Worker& worker) {
+    while (worker.greeted && worker.assigned.size() < this->options.window && !this->pending.empty()) {
+        const std::size_t index = this->pending.front();
+        Shard& shard = this->work[index];
+        uint8_t message[MESSAGE_SIZE];
+        put_le(message, index, 8);
+        put_le(message + 8, shard.first, 8);
+        put_le(message + 16, shard.count, 8);
+        this->pending.pop_front();
+        if (worker.assigned.empty()) {
+            // the timeout runs from the first shard a worker holds, not from when it went idle
+            worker.heard = Clock::now();
+        }
+        worker.assigned.push_back(index);
+        shard.attempts++;
+        if (!send_all(worker.fd, message, sizeof(message))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BulkCoordinator::receive(Worker& worker) {
+    uint8_t buffer[65536];
+    const ssize_t got = recv(worker.fd, buffer, sizeof(buffer), 0);
+    if (got <= 0) {
+        return got < 0 && errno == EINTR;
+    }
+    worker.in.insert(worker.in.end(), buffer, buffer + got);
+    worker.heard = Clock::now();
+
+    std::size_t at = 0;
+    if (!worker.greeted) {
+        if (worker.in.size() < HELLO_SIZE) {
+            return true;
+        }
+        if (std::memcmp(worker.in.data(), this->hello, HELLO_SIZE) != 0) {
+            return false;
+        }
+        worker.greeted = true;
+        at = HELLO_SIZE;
+    }
+    while (worker.in.size() - at >= MESSAGE_SIZE) {
+        const uint8_t* message = worker.in.data() + at;
+        const uint64_t index = get_le(message, 8), valid = get_le(message + 8, 8), n = get_le(message + 16, 8);
+        if (worker.assigned.empty() || index != worker.assigned.front()) {
+            return false;
+        }
+        const Shard& shard = this->work[index];
+        if (n > shard.count || valid != shard.count - n) {
+            return false;
+        }
+        if (worker.in.size() - at - MESSAGE_SIZE < 8 * n) {
+            break;
+        }
+        std::vector<uint64_t> invalid(n);
+        for (std::size_t i = 0; i < n; i++) {
+            invalid[i] = get_le(message + MESSAGE_SIZE + 8 * i, 8);
+            if (invalid[i] < shard.first || invalid[i] >= shard.first + shard.count
+                || (i > 0 && invalid[i] <= invalid[i - 1])) {
+                return false;
+            }
+        }
+        at += MESSAGE_SIZE + 8 * n;
+        worker.assigned.pop_front();
+        finish(index, valid, std::move(invalid));
+    }
+    worker.in.erase(worker.in.begin(), worker.in.begin() + at);
+    return refill(worker);
+}
+
+void BulkCoordinator::drop(Worker& worker) {
+    close(worker.fd);
+    worker.fd = -1;
+    for (auto it = worker.assigned.rbegin(); it != worker.assigned.rend(); ++it) {
+        if (this->work[*it].attempts >= this->options.attempts) {
+            throw std::runtime_error("Shard " + std::to_string(*it) + " was not verified in "
+                                     + std::to_string(this->options.attempts) + " attempts");
+        }
+        this->pending.push_front(*it);
+    }
+    worker.assigned.clear();
+}
+
+BulkVerifyResult BulkCoordinator::run() {
+    const auto timeout = std::chrono::seconds(this->options.timeout);
+    while (this->done < this->total) {
+        std::vector<pollfd> ready;
+        ready.push_back(pollfd{this->listener, POLLIN, 0});
+        for (const Worker& worker : this->workers) {
+            ready.push_back(pollfd{worker.fd, POLLIN, 0});
+        }
+        if (poll(ready.data(), ready.size(), 1000) < 0 && errno != EINTR) {
+            throw std::runtime_error("Cannot wait for workers");
+        }
+
+        // the workers polled, then those that went quiet, then the new ones
+        const Clock::time_point now = Clock::now();
+        std::vector<Worker> alive;
+        for (std::size_t i = 0; i < this->workers.size(); i++) {
+            Worker& worker = this->workers[i];
+            bool keep = true;
+            if (ready[i + 1].revents & (POLLIN | POLLHUP | POLLERR)) {
+                keep = receive(worker);
+            }
+            if (keep && now - worker.heard > timeout && (!worker.greeted || !worker.assigned.empty())) {
+                keep = false;
+            }
+            if (keep) {
+                alive.push_back(std::move(worker));
+            } else {
+                drop(worker);
+            }
+        }
+        this->workers = std::move(alive);
+        if (ready[0].revents & POLLIN) {
+            const int fd = accept(this->listener, nullptr, nullptr);
+            if (fd >= 0) {
+                no_delay(fd);
+                this->workers.push_back(Worker{fd, false, {}, {}, Clock::now()});
+            }
+        }
+        // shards given back by a dropped worker go to the others
+        std::vector<Worker> serving;
+        for (Worker& worker : this->workers) {
+            if (refill(worker)) {
+                serving.push_back(std::move(worker));
+            } else {
+                drop(worker);
+            }
+        }
+        this->workers = std::move(serving);
+    }
+
+    uint8_t end[MESSAGE_SIZE] = {};
+    for (const Worker& worker : this->workers) {
+        send_all(worker.fd, end, sizeof(end));
+        close(worker.fd);
+    }
+    this->workers.clear();
+
+    BulkVerifyResult result;
+    result.records = this->file.size();
+    for (const Shard& shard : this->work) {
+        result.invalid.insert(result.invalid.end(), shard.invalid.begin(), shard.invalid.end());
+    }
+    result.valid = result.records - result.invalid.size();
+    return result;
+}
+
+uint64_t bulk_worker(const BulkFile& file, const std::string& host, uint16_t port, Executor& executor,
+                     std::size_t chunk) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addresses) != 0) {
+        throw std::runtime_error("Cannot resolve " + host);
+    }
+    int fd = -1;
+    for (addrinfo* a = addresses; a && fd < 0; a = a->ai_next) {
+        fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (fd >= 0 && connect(fd, a->ai_addr, a->ai_addrlen) != 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(addresses);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot connect to " + host + ":" + std::to_string(port));
+    }
+    no_delay(fd);
+
+    uint8_t hello[HELLO_SIZE];
+    make_hello(file, hello);
+    uint64_t verified = 0;
+    std::vector<uint8_t> out;
+    try {
+        if (!send_all(fd, hello, sizeof(hello))) {
+            throw std::runtime_error("The coordinator closed the connection");
+        }
+        for (;;) {
+            uint8_t message[MESSAGE_SIZE];
+            if (!recv_all(fd, message, sizeof(message))) {
+                throw std::runtime_error("The coordinator closed the connection");
+            }
+            const uint64_t index = get_le(message, 8), first = get_le(message + 8, 8), n = get_le(message + 16, 8);
+            if (n == 0) {
+                break;
+            }
+            if (first > file.size() || n > file.size() - first) {
+                throw std::runtime_error("Shard " + std::to_string(index) + " is past the end of the file");
+            }
+            const BulkVerifyResult result = bulk_verify_range(file, first, n, executor, chunk);
+            out.assign(MESSAGE_SIZE + 8 * result.invalid.size(), 0);
+            put_le(out.data(), index, 8);
+            put_le(out.data() + 8, result.valid, 8);
+            put_le(out.data() + 16, result.invalid.size(), 8);
+            for (std::size_t i = 0; i < result.invalid.size(); i++) {
+                put_le(out.data() + MESSAGE_SIZE + 8 * i, result.invalid[i], 8);
+            }
+            if (!send_all(fd, out.data(), out.size())) {
+                throw std::runtime_error("The coordinator closed the connection");
+            }
+            verified++;
+        }
+    } catch (...) {
+        close(fd);
+        throw;
+    }
+    close(fd);
+    return verified;
+}
+
+#else
+
+bool BulkCoordinator::refill(Worker&) {
+    return false;
+}
+
+bool BulkCoordinator::receive(Worker&) {
+    return false;
+}
+
+void BulkCoordinator::drop(Worker&) {
+}
+
+BulkVerifyResult BulkCoordinator::run() {
+    throw std::runtime_error("Bulk clusters need POSIX sockets");
+}
+
+uint64_t bulk_worker(const BulkFile&, const std::string&, uint16_t, Executor&, std::size_t) {
+    throw std::runtime_error("Bulk clusters need POSIX sockets");
+}
+
+#endif
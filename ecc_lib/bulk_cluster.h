@@ -0,0 +1,105 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_BULK_CLUSTER_H
+#define ECC_BULK_CLUSTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "bulk.h"
+#include "Executor.h"
+
+// bulk_verify spread over machines: a coordinator cuts a bulk file into shards
+// of consecutive records and hands them to workers over TCP, each worker
+// holding its own copy of the file and verifying a shard by bulk_verify_range
+// on its own executor. Messages are little-endian:
+//
+//     worker hello   "ECCSHARD", version (u32), scheme (u32), record size (u32),
+//                    four zero bytes, record count (u64), bulk_fingerprint
+//                    (32 bytes)
+//     assignment     shard (u64), first record (u64), records (u64); zero
+//                    records for no more work
+//     result         shard (u64), valid (u64), invalid count n (u64), then
+//                    the n invalid record numbers (u64 each)
+//
+// A worker whose hello does not match the coordinator's file is closed
+// without an assignment. Workers answer their shards in order, and hold at
+// most window of them at once: the one they verify and those queued behind
+// it, so a slow worker is never buried and a fast one never waits for its
+// next shard. A worker that disconnects, sends something else, or holds
+// shards for timeout seconds without answering is dropped, and its shards go
+// back to the front of the queue.
+struct BulkClusterOptions {
+    // records per shard: the unit of assignment, retry and checkpointing
+    uint64_t shard_records = 1 << 18;
+    std::size_t window = 2;
+    // assignments of one shard before run() gives up on the job
+    unsigned attempts = 3;
+    unsigned timeout = 600;
+    // a file of the finished shards, one line each appended (and synced) as
+    // results come in; a coordinator started on it again hands out only the
+    // others. None when empty
+    std::string checkpoint;
+};
+
+// Listens on port (0 for any free one) of every interface from construction;
+// throws std::runtime_error if it cannot, or if the checkpoint belongs to
+// another file or shard size
+class BulkCoordinator {
+public:
+    BulkCoordinator(const BulkFile& file, uint16_t port, const BulkClusterOptions& options = BulkClusterOptions());
+    ~BulkCoordinator();
+    BulkCoordinator(const BulkCoordinator&) = delete;
+    BulkCoordinator& operator=(const BulkCoordinator&) = delete;
+
+    uint16_t port() const { return this->bound; }
+    uint64_t shards() const { return this->total; }
+    // shards already done by the checkpoint when run() starts
+    uint64_t resumed() const { return this->restored; }
+
+    // serves workers until every shard is done, then sends each the end of
+    // work; the result is that of bulk_verify on the whole file. Throws
+    // std::runtime_error when a shard has been assigned attempts times
+    // without an answer
+    BulkVerifyResult run();
+
+private:
+    struct Shard;
+    struct Worker;
+
+    void load_checkpoint();
+    void finish(std::size_t shard, uint64_t valid, std::vector<uint64_t> invalid);
+    // the next shards to a greeted worker with room; false when a send fails
+    bool refill(Worker& worker);
+    // what the worker sent; false when it closed or broke the protocol
+    bool receive(Worker& worker);
+    void drop(Worker& worker);
+
+    const BulkFile& file;
+    BulkClusterOptions options;
+    std::vector<Shard> work;
+    std::deque<std::size_t> pending;
+    std::vector<Worker> workers;
+    uint8_t hello[64];
+    int listener;
+    uint16_t bound;
+    uint64_t total;
+    uint64_t restored;
+    uint64_t done;
+    std::FILE* log;
+};
+
+// Verifies shards for the coordinator at host:port until it sends the end of
+// work, and returns how many it verified. Throws std::runtime_error if it
+// cannot connect, or when the connection closes before the end of work
+// (among others when the coordinator turns the file away)
+uint64_t bulk_worker(const BulkFile& file, const std::string& host, uint16_t port, Executor& executor,
+                     std::size_t chunk = 16384);
+
+#endif //ECC_BULK_CLUSTER_H
@@ -0,0 +1,394 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+#include "bulletproofs.h"
+#include "Curve.h"
+#include "FixedBaseTable.h"
+#include "sec1.h"
+#include "sha256.h"
+
+namespace {
+
+const PrimeField& order() {
+    return Curve::secp256k1().scalar_field();
+}
+
+// the Fiat-Shamir transcript: every message goes into one running SHA-256,
+// and a challenge is the digest so far mod n, which then joins the transcript
+class Transcript {
+public:
+    explicit Transcript(std::size_t bits) {
+        static const char label[] = "ECC/bulletproofs/range";
+        this->hash.update(reinterpret_cast<const uint8_t*>(label), sizeof(label) - 1);
+        const uint8_t n = static_cast<uint8_t>(bits);
+        this->hash.update(&n, 1);
+    }
+
+    void append(const Point& p) {
+        uint8_t bytes[33];
+        const Result<std::size_t> len = sec1_encode(p, true, bytes, sizeof(bytes));
+        this->hash.update(bytes, *len);
+    }
+
+    void append(const Scalar& k) {
+        uint8_t bytes[32];
+        k.to_bytes(bytes);
+        this->hash.update(bytes, sizeof(bytes));
+    }
+
+    Scalar challenge() {
+        Sha256 copy = this->hash;
+        uint8_t digest[Sha256::DIGEST_SIZE];
+        copy.finish(digest);
+        this->hash.update(digest, sizeof(digest));
+        return Scalar::from_bytes(digest, sizeof(digest), order());
+    }
+
+private:
+    Sha256 hash;
+};
+
+Scalar inner_product(const std::vector<Scalar>& a, const std::vector<Scalar>& b, std::size_t a_first,
+                     std::size_t b_first, std::size_t count) {
+    Scalar sum(order());
+    for (std::size_t i = 0; i < count; i++) {
+        sum += a[a_first + i] * b[b_first + i];
+    }
+    return sum;
+}
+
+// sum k[k_first + i] p[p_first + i] for i < count
+Point msm_range(const std::vector<Scalar>& k, std::size_t k_first, const std::vector<Point>& p, std::size_t p_first,
+               std::size_t count) {
+    std::vector<integer> scalars;
+    std::vector<Point> points;
+    for (std::size_t i = 0; i < count; i++) {
+        scalars.push_back(k[k_first + i].value());
+        points.push_back(p[p_first + i]);
+    }
+    return multi_scalar_mul(scalars, points);
+}
+
+const FixedBaseTable& h_table() {
+    static const FixedBaseTable table(pedersen_h(), 256);
+    return table;
+}
+
+// G, H, then the G_i and the H_i
+std::vector<Point> fixed_points(const std::vector<Point>& g, const std::vector<Point>& h) {
+    std::vector<Point> points = {Curve::secp256k1().generator(), pedersen_h()};
+    points.insert(points.end(), g.begin(), g.end());
+    points.insert(points.end(), h.begin(), h.end());
+    return points;
+}
+
+std::size_t checked_bits(std::size_t bits) {
+    if (bits == 0 || bits > 64 || (bits & (bits - 1)) != 0) {
+        throw std::invalid_argument("Range proofs take a power of two from 1 to 64 bits");
+    }
+    return bits;
+}
+
+std::vector<Point> generators(const char* label, std::size_t count) {
+    std::vector<Point> points;
+    for (std::size_t i = 0; i < count; i++) {
+        points.push_back(hash_to_secp256k1(label, static_cast<uint32_t>(i)));
+    }
+    return points;
+}
+
+// the challenges of one proof, recomputed from its transcript
+struct Challenges {
+    Scalar y, z, x, w;
+    std::vector<Scalar> u;
+};
+
+// appends the challenges to out; false for a proof of the wrong shape
+bool replay(std::size_t bits, std::size_t rounds, const Point& commitment, const RangeProof& proof,
+            std::vector<Challenges>& out) {
+    const PrimeField& n = order();
+    if (proof.L.size() != rounds || proof.R.size() != rounds) {
+        return false;
+    }
+    for (const Scalar* k : {&proof.tau_x, &proof.mu, &proof.t_hat, &proof.a, &proof.b}) {
+        if (&k->order() != &n) {
+            return false;
+        }
+    }
+    Transcript t(bits);
+    t.append(commitment);
+    t.append(proof.A);
+    t.append(proof.S);
+    const Scalar y = t.challenge(), z = t.challenge();
+    t.append(proof.T1);
+    t.append(proof.T2);
+    const Scalar x = t.challenge();
+    t.append(proof.tau_x);
+    t.append(proof.mu);
+    t.append(proof.t_hat);
+    const Scalar w = t.challenge();
+    std::vector<Scalar> u;
+    for (std::size_t j = 0; j < rounds; j++) {
+        t.append(proof.L[j]);
+        t.append(proof.R[j]);
+        u.push_back(t.challenge());
+        if (u.back().is_zero()) {
+            return false;
+        }
+    }
+    if (y.is_zero() || z.is_zero() || x.is_zero()) {
+        return false;
+    }
+    out.push_back({y, z, x, w, std::move(u)});
+    return true;
+}
+
+}
+
+Point hash_to_secp256k1(const std::string& label, uint32_t index) {
+    static const char prefix[] = "ECC/generator";
+    const Curve& curve = Curve::secp256k1();
+    for (uint32_t counter = 0;; counter++) {
+        Sha256 hash;
+        hash.update(reinterpret_cast<const uint8_t*>(prefix), sizeof(prefix) - 1);
+        hash.update(reinterpret_cast<const uint8_t*>(label.data()), label.size());
+        const uint8_t tail[8] = {static_cast<uint8_t>(index >> 24), static_cast<uint8_t>(index >> 16),
+                                 static_cast<uint8_t>(index >> 8), static_cast<uint8_t>(index),
+                                 static_cast<uint8_t>(counter >> 24), static_cast<uint8_t>(counter >> 16),
+                                 static_cast<uint8_t>(counter >> 8), static_cast<uint8_t>(counter)};
+        hash.update(tail, sizeof(tail));
+        uint8_t encoded[33];
+        encoded[0] = 0x02;
+        hash.finish(encoded + 1);
+        const Result<Point> p = sec1_decode(encoded, sizeof(encoded), curve);
+        if (p.ok()) {
+            return *p;
+        }
+    }
+}
+
+const Point& pedersen_h() {
+    static const Point h = hash_to_secp256k1("pedersen", 0);
+    return h;
+}
+
+Point pedersen_commit(const Scalar& value, const Scalar& blinding) {
+    if (&value.order() != &order() || &blinding.order() != &order()) {
+        throw std::runtime_error("Pedersen commitments take scalars mod the secp256k1 order");
+    }
+    return Curve::secp256k1().mul_base_ct(value.value()) + h_table().mul_ct(blinding.value());
+}
+
+Bulletproofs::Bulletproofs(std::size_t bits, unsigned threads)
+        : n(checked_bits(bits)), rounds(0), gs(generators("bulletproofs G", bits)),
+          hs(generators("bulletproofs H", bits)), msm(fixed_points(this->gs, this->hs), 256, 0, threads) {
+    while ((std::size_t(1) << this->rounds) < bits) {
+        this->rounds++;
+    }
+}
+
+RangeProof Bulletproofs::prove(uint64_t value, const Scalar& blinding, ChaCha20Rng& rng) const {
+    const PrimeField& order = ::order();
+    const std::size_t n = this->n;
+    if (n < 64 && (value >> n) != 0) {
+        throw std::invalid_argument("Value does not fit in the range proof's bits");
+    }
+    const Scalar zero(order), one(1, order);
+    const Point& g = Curve::secp256k1().generator();
+    const FixedBaseTable& g_table = Curve::secp256k1().generator_table();
+    // a_L the bits of the value, a_R = a_L - 1, and the blinding vectors s_L, s_R
+    std::vector<Scalar> a_l, a_r, s_l, s_r;
+    for (std::size_t i = 0; i < n; i++) {
+        a_l.push_back((value >> i) & 1 ? one : zero);
+        a_r.push_back(a_l.back() - one);
+        s_l.push_back(rng.random_scalar(order));
+        s_r.push_back(rng.random_scalar(order));
+    }
+    const Scalar alpha = rng.random_scalar(order), rho = rng.random_scalar(order);
+    const Point A = h_table().mul_ct(alpha.value()) + msm_range(a_l, 0, this->gs, 0, n) +
+                    msm_range(a_r, 0, this->hs, 0, n);
+    const Point S = h_table().mul_ct(rho.value()) + msm_range(s_l, 0, this->gs, 0, n) +
+                    msm_range(s_r, 0, this->hs, 0, n);
+
+    Transcript t(n);
+    t.append(pedersen_commit(Scalar(integer(value), order), blinding));
+    t.append(A);
+    t.append(S);
+    const Scalar y = t.challenge(), z = t.challenge();
+    const Scalar zz = z * z;
+
+    // l(X) = l0 + l1 X and r(X) = r0 + r1 X, t(X) = <l(X), r(X)> = t0 + t1 X + t2 X^2
+    std::vector<Scalar> l0, l1 = s_l, r0, r1;
+    Scalar y_i = one, two_i = one;
+    for (std::size_t i = 0; i < n; i++) {
+        l0.push_back(a_l[i] - z);
+        r0.push_back(y_i * (a_r[i] + z) + zz * two_i);
+        r1.push_back(y_i * s_r[i]);
+        y_i *= y;
+        two_i += two_i;
+    }
+    const Scalar t1 = inner_product(l0, r1, 0, 0, n) + inner_product(l1, r0, 0, 0, n);
+    const Scalar t2 = inner_product(l1, r1, 0, 0, n);
+    const Scalar tau1 = rng.random_scalar(order), tau2 = rng.random_scalar(order);
+    const Point T1 = g_table.mul_ct(t1.value()) + h_table().mul_ct(tau1.value());
+    const Point T2 = g_table.mul_ct(t2.value()) + h_table().mul_ct(tau2.value());
+    t.append(T1);
+    t.append(T2);
+    const Scalar x = t.challenge();
+
+    std::vector<Scalar> a(n, zero), b(n, zero);
+    for (std::size_t i = 0; i < n; i++) {
+        a[i] = l0[i] + l1[i] * x;
+        b[i] = r0[i] + r1[i] * x;
+    }
+    const Scalar t_hat = inner_product(a, b, 0, 0, n);
+    const Scalar tau_x = tau2 * x * x + tau1 * x + zz * blinding;
+    const Scalar mu = alpha + rho * x;
+    t.append(tau_x);
+    t.append(mu);
+    t.append(t_hat);
+    const Point q = g * t.challenge().value();
+
+    // the inner-product argument for <a, G> + <b, H'> + <a, b> Q with
+    // H'_i = y^-i H_i, halving a, b, G and H' a round
+    std::vector<Point> gv = this->gs, hv;
+    const Scalar y_inverse = y.inverse();
+    Scalar y_inverse_i = one;
+    for (std::size_t i = 0; i < n; i++) {
+        hv.push_back(this->hs[i].mul(y_inverse_i.value()));
+        y_inverse_i *= y_inverse;
+    }
+    std::vector<Point> L, R;
+    for (std::size_t m = n / 2; m > 0; m /= 2) {
+        const Scalar c_l = inner_product(a, b, 0, m, m), c_r = inner_product(a, b, m, 0, m);
+        L.push_back(msm_range(a, 0, gv, m, m) + msm_range(b, m, hv, 0, m) + q.mul(c_l.value()));
+        R.push_back(msm_range(a, m, gv, 0, m) + msm_range(b, 0, hv, m, m) + q.mul(c_r.value()));
+        t.append(L.back());
+        t.append(R.back());
+        const Scalar u = t.challenge(), u_inverse = u.inverse();
+        for (std::size_t i = 0; i < m; i++) {
+            a[i] = a[i] * u + a[m + i] * u_inverse;
+            b[i] = b[i] * u_inverse + b[m + i] * u;
+            gv[i] = Point::mul_add(u_inverse.value(), gv[i], u.value(), gv[m + i]);
+            hv[i] = Point::mul_add(u.value(), hv[i], u_inverse.value(), hv[m + i]);
+        }
+    }
+    return {A, S, T1, T2, tau_x, mu, t_hat, std::move(L), std::move(R), a[0], b[0]};
+}
+
+bool Bulletproofs::verify(const Point& commitment, const RangeProof& proof, unsigned threads) const {
+    return verify_batch({commitment}, {proof}, threads);
+}
+
+bool Bulletproofs::verify_batch(const std::vector<Point>& commitments, const std::vector<RangeProof>& proofs,
+                                unsigned threads) const {
+    if (commitments.size() != proofs.size()) {
+        throw std::invalid_argument("Need a commitment for every range proof");
+    }
+    if (proofs.empty()) {
+        return true;
+    }
+    const PrimeField& order = ::order();
+    const std::size_t n = this->n;
+    const Scalar zero(order), one(1, order);
+
+    std::vector<Challenges> challenges;
+    Sha256 seed_hash;
+    std::random_device device;
+    for (std::size_t i = 0; i < 8; i++) {
+        const uint32_t word = device();
+        const uint8_t bytes[4] = {static_cast<uint8_t>(word), static_cast<uint8_t>(word >> 8),
+                                  static_cast<uint8_t>(word >> 16), static_cast<uint8_t>(word >> 24)};
+        seed_hash.update(bytes, 4);
+    }
+    for (std::size_t k = 0; k < proofs.size(); k++) {
+        if (!replay(n, this->rounds, commitments[k], proofs[k], challenges)) {
+            return false;
+        }
+        // the last challenge covers the whole transcript but a and b
+        uint8_t bytes[96];
+        (this->rounds ? challenges[k].u.back() : challenges[k].w).to_bytes(bytes);
+        proofs[k].a.to_bytes(bytes + 32);
+        proofs[k].b.to_bytes(bytes + 64);
+        seed_hash.update(bytes, sizeof(bytes));
+    }
+    uint8_t seed[Sha256::DIGEST_SIZE];
+    seed_hash.finish(seed);
+    ChaCha20Rng rng(seed);
+
+    // for each proof, with weight r and c for the check of t_hat, the sum of
+    //   A + x S + c z^2 V + c x T1 + c x^2 T2 + sum u_j^2 L_j + u_j^-2 R_j
+    //   + (w (t_hat - a b) + c (delta - t_hat)) G - (mu + c tau_x) H
+    //   + sum (-z - a s_i) G_i + (z + y^-i (z^2 2^i - b s_(n - 1 - i))) H_i
+    // is infinity, delta = (z - z^2) sum y^i - z^3 sum 2^i
+    std::vector<Scalar> fixed(2 + 2 * n, zero);
+    std::vector<integer> scalars;
+    std::vector<Point> points;
+    std::vector<Scalar> s(n, zero), u_squares(this->rounds, zero), u_inverses(this->rounds, zero);
+    for (std::size_t k = 0; k < proofs.size(); k++) {
+        const RangeProof& p = proofs[k];
+        const Challenges& ch = challenges[k];
+        uint8_t bytes[32] = {0};
+        rng.fill(bytes + 16, 16);
+        const Scalar r = Scalar::from_bytes(bytes, sizeof(bytes), order);
+        rng.fill(bytes + 16, 16);
+        const Scalar c = Scalar::from_bytes(bytes, sizeof(bytes), order);
+        const Scalar zz = ch.z * ch.z, rc = r * c;
+
+        // s_i the product of u_j or u_j^-1 as bit j of i, from the top round, is 1 or 0
+        Scalar all_inverse = one;
+        for (std::size_t j = 0; j < this->rounds; j++) {
+            u_inverses[j] = ch.u[j].inverse();
+            u_squares[j] = ch.u[j] * ch.u[j];
+            all_inverse *= u_inverses[j];
+        }
+        s[0] = all_inverse;
+        for (std::size_t i = 1; i < n; i++) {
+            std::size_t lg = 0;
+            while ((std::size_t(2) << lg) <= i) {
+                lg++;
+            }
+            s[i] = s[i - (std::size_t(1) << lg)] * u_squares[this->rounds - 1 - lg];
+        }
+
+        Scalar y_inverse_i = one, two_i = one, sum_y = zero, y_i = one, sum_two = zero;
+        const Scalar y_inverse = ch.y.inverse();
+        const Scalar ra = r * p.a, rb = r * p.b, rz = r * ch.z;
+        for (std::size_t i = 0; i < n; i++) {
+            fixed[2 + i] -= rz + ra * s[i];
+            fixed[2 + n + i] += rz + y_inverse_i * (r * zz * two_i - rb * s[n - 1 - i]);
+            sum_y += y_i;
+            sum_two += two_i;
+            y_i *= ch.y;
+            y_inverse_i *= y_inverse;
+            two_i += two_i;
+        }
+        const Scalar delta = (ch.z - zz) * sum_y - zz * ch.z * sum_two;
+        fixed[0] += r * ch.w * (p.t_hat - p.a * p.b) + rc * (delta - p.t_hat);
+        fixed[1] -= r * p.mu + rc * p.tau_x;
+
+        const Scalar proof_scalars[5] = {r, r * ch.x, rc * zz, rc * ch.x, rc * ch.x * ch.x};
+        const Point* proof_points[5] = {&p.A, &p.S, &commitments[k], &p.T1, &p.T2};
+        for (std::size_t i = 0; i < 5; i++) {
+            scalars.push_back(proof_scalars[i].value());
+            points.push_back(*proof_points[i]);
+        }
+        for (std::size_t j = 0; j < this->rounds; j++) {
+            scalars.push_back((r * u_squares[j]).value());
+            points.push_back(p.L[j]);
+            scalars.push_back((r * u_inverses[j] * u_inverses[j]).value());
+            points.push_back(p.R[j]);
+        }
+    }
+
+    std::vector<integer> fixed_scalars;
+    for (const Scalar& k : fixed) {
+        fixed_scalars.push_back(k.value());
+    }
+    const Point sum = this->msm.mul(fixed_scalars, threads) + multi_scalar_mul(scalars, points, threads);
+    return sum.is_infinity();
+}
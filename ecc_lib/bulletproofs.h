@@ -0,0 +1,90 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_BULLETPROOFS_H
+#define ECC_BULLETPROOFS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "chacha20.h"
+#include "msm.h"
+#include "Point.h"
+#include "Scalar.h"
+
+// Pedersen commitments and Bulletproofs range proofs on secp256k1 (Bünz,
+// Bootle, Boneh, Poelstra, Wuille and Maxwell, "Bulletproofs: Short Proofs for
+// Confidential Transactions and More", IEEE S&P 2018). Every generator but G
+// is hashed to the curve, so nobody knows a discrete log between any two of
+// them. The challenges are SHA-256 of the transcript so far (Fiat-Shamir).
+
+// the point with x = SHA-256("ECC/generator" || label || index || counter)
+// and even y for the first counter (a big-endian u32, as is index) that gives
+// one: a point of unknown discrete log
+Point hash_to_secp256k1(const std::string& label, uint32_t index);
+
+// H of the Pedersen commitments, hash_to_secp256k1("pedersen", 0)
+const Point& pedersen_h();
+// value G + blinding H, both multiplications constant time; throws
+// std::runtime_error for scalars of an order other than secp256k1's
+Point pedersen_commit(const Scalar& value, const Scalar& blinding);
+
+// a proof that a Pedersen commitment V holds a value in [0, 2^bits): the
+// commitments A and S to the bits and their blinding, T1 and T2 to the
+// coefficients of t(X), the openings tau_x, mu and t_hat at the challenge x,
+// and the inner-product argument, log2(bits) pairs L, R and the last a, b
+struct RangeProof {
+    Point A, S, T1, T2;
+    Scalar tau_x, mu, t_hat;
+    std::vector<Point> L, R;
+    Scalar a, b;
+};
+
+// The generators of range proofs of bits bits, G_i and H_i for i < bits, and
+// a FixedBaseMsm over G, H and all of them built once. Verification folds
+// the whole proof, inner-product argument included, into one multi-scalar
+// multiplication that is infinity for a valid proof (section 6.2 of the
+// paper): the scalars of the generators, the same for every proof shape, go
+// through the fixed-base tables and those of the proof's own points, 5 +
+// 2 log2(bits) of them, through multi_scalar_mul, where a verifier following
+// the protocol pays log2(bits) rounds of folding 2 bits generators. A batch
+// weights each proof's equation by a random 128-bit factor and adds them up,
+// so all the proofs share the generators' part and one Pippenger over their
+// points. Not constant time in verification; the prover's secrets go only
+// into constant-time multiplications by G and H, not into the MSMs over G_i
+// and H_i, whose bits are the value's.
+class Bulletproofs {
+public:
+    // throws std::invalid_argument unless bits is a power of two from 1 to 64
+    explicit Bulletproofs(std::size_t bits = 64, unsigned threads = 1);
+
+    std::size_t bits() const { return this->n; }
+    const std::vector<Point>& g() const { return this->gs; }
+    const std::vector<Point>& h() const { return this->hs; }
+
+    // a proof for pedersen_commit(value, blinding) with its random scalars
+    // drawn from rng; throws std::invalid_argument for value >= 2^bits
+    RangeProof prove(uint64_t value, const Scalar& blinding, ChaCha20Rng& rng = ChaCha20Rng::local()) const;
+    // whether proof shows commitment holds a value in [0, 2^bits): false for
+    // a proof of the wrong shape or with scalars of another order as well
+    bool verify(const Point& commitment, const RangeProof& proof, unsigned threads = 1) const;
+    // whether every proof holds for its commitment, one multi-scalar
+    // multiplication for all of them; the weights are the ChaCha20Rng stream of
+    // a seed hashed from std::random_device and the transcripts, so a batch
+    // with a false proof passes with probability about 2^-128. True for none;
+    // throws std::invalid_argument unless the vectors have the same size
+    bool verify_batch(const std::vector<Point>& commitments, const std::vector<RangeProof>& proofs,
+                      unsigned threads = 1) const;
+
+private:
+    std::size_t n;
+    std::size_t rounds;
+    std::vector<Point> gs, hs;
+    // over G, H, G_0, .., G_(bits - 1), H_0, .., H_(bits - 1)
+    FixedBaseMsm msm;
+};
+
+#endif //ECC_BULLETPROOFS_H
@@ -0,0 +1,143 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+
+#include "chacha20.h"
+#include "secure_zero.h"
+
+namespace {
+
+inline uint32_t rotl(uint32_t x, int n) {
+    return (x << n) | (x >> (32 - n));
+}
+
+inline void quarter_round(uint32_t* x, std::size_t a, std::size_t b, std::size_t c, std::size_t d) {
+    x[a] += x[b]; x[d] = rotl(x[d] ^ x[a], 16);
+    x[c] += x[d]; x[b] = rotl(x[b] ^ x[c], 12);
+    x[a] += x[b]; x[d] = rotl(x[d] ^ x[a], 8);
+    x[c] += x[d]; x[b] = rotl(x[b] ^ x[c], 7);
+}
+
+inline uint32_t load_le32(const uint8_t* in) {
+    return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+           (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+void portable_block(uint8_t* out, const uint32_t* key, uint64_t counter, const uint32_t* nonce) {
+    const uint32_t in[16] = {0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+                             key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7],
+                             static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32), nonce[0], nonce[1]};
+    uint32_t x[16];
+    std::copy(in, in + 16, x);
+    for (std::size_t i = 0; i < 10; i++) {
+        quarter_round(x, 0, 4, 8, 12);
+        quarter_round(x, 1, 5, 9, 13);
+        quarter_round(x, 2, 6, 10, 14);
+        quarter_round(x, 3, 7, 11, 15);
+        quarter_round(x, 0, 5, 10, 15);
+        quarter_round(x, 1, 6, 11, 12);
+        quarter_round(x, 2, 7, 8, 13);
+        quarter_round(x, 3, 4, 9, 14);
+    }
+    for (std::size_t w = 0; w < 16; w++) {
+        const uint32_t v = x[w] + in[w];
+        for (std::size_t b = 0; b < 4; b++) {
+            out[4 * w + b] = static_cast<uint8_t>(v >> (8 * b));
+        }
+    }
+}
+
+}
+
+void chacha20_blocks(uint8_t* out, const uint32_t* key, uint64_t counter, const uint32_t* nonce,
+                     std::size_t blocks, const ChaCha20Kernel* kernel) {
+    if (kernel) {
+        for (; blocks >= kernel->lanes; blocks -= kernel->lanes) {
+            kernel->blocks(out, key, counter, nonce);
+            out += 64 * kernel->lanes;
+            counter += kernel->lanes;
+        }
+    }
+    for (; blocks; blocks--, out += 64, counter++) {
+        portable_block(out, key, counter, nonce);
+    }
+}
+
+ChaCha20Rng::ChaCha20Rng() : used(sizeof(this->buffer)) {
+    std::random_device device;
+    for (uint32_t& k : this->key) {
+        k = device();
+    }
+}
+
+ChaCha20Rng::ChaCha20Rng(const uint8_t* seed) : used(sizeof(this->buffer)) {
+    for (std::size_t i = 0; i < 8; i++) {
+        this->key[i] = load_le32(seed + 4 * i);
+    }
+}
+
+ChaCha20Rng::~ChaCha20Rng() {
+    secure_zero(this->key, sizeof(this->key));
+    secure_zero(this->buffer, sizeof(this->buffer));
+}
+
+void ChaCha20Rng::refill() {
+    // each key makes one refill, so the counter and nonce can start at zero
+    static const uint32_t nonce[2] = {0, 0};
+    chacha20_blocks(this->buffer, this->key, 0, nonce, BLOCKS);
+    for (std::size_t i = 0; i < 8; i++) {
+        this->key[i] = load_le32(this->buffer + 4 * i);
+    }
+    secure_zero(this->buffer, sizeof(this->key));
+    this->used = sizeof(this->key);
+}
+
+void ChaCha20Rng::fill(uint8_t* out, std::size_t len) {
+    while (len) {
+        if (this->used == sizeof(this->buffer)) {
+            refill();
+        }
+        const std::size_t n = std::min(len, sizeof(this->buffer) - this->used);
+        std::memcpy(out, this->buffer + this->used, n);
+        // what was handed out is not kept
+        std::memset(this->buffer + this->used, 0, n);
+        this->used += n;
+        out += n;
+        len -= n;
+    }
+}
+
+uint64_t ChaCha20Rng::next() {
+    uint8_t bytes[8];
+    fill(bytes, sizeof(bytes));
+    return static_cast<uint64_t>(load_le32(bytes)) | (static_cast<uint64_t>(load_le32(bytes + 4)) << 32);
+}
+
+integer ChaCha20Rng::random_below(const integer& n) {
+    if (n < 1) {
+        throw std::domain_error("Error: random_below needs a bound of at least 1");
+    }
+    static constexpr std::size_t DIGIT_BITS = sizeof(INTEGER_DIGIT_T) << 3;
+    const std::size_t bits = n.bit_length();
+    const std::size_t digits = (bits + DIGIT_BITS - 1) / DIGIT_BITS;
+    const INTEGER_DIGIT_T top = (bits % DIGIT_BITS) ? (static_cast<INTEGER_DIGIT_T>(1) << (bits % DIGIT_BITS)) - 1
+                                                    : static_cast<INTEGER_DIGIT_T>(-1);
+    integer::REP rep(digits);
+    while (true) {
+        fill(reinterpret_cast<uint8_t*>(rep.data()), digits * sizeof(INTEGER_DIGIT_T));
+        rep[digits - 1] &= top;
+        integer out(rep);
+        if (out < n) {
+            return out;
+        }
+    }
+}
+
+ChaCha20Rng& ChaCha20Rng::local() {
+    static thread_local ChaCha20Rng rng;
+    return rng;
+}
@@ -0,0 +1,80 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_CHACHA20_H
+#define ECC_CHACHA20_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "FieldElement.h"
+#include "integer.h"
+#include "PrimeField.h"
+#include "Scalar.h"
+
+// The ChaCha20 block function of RFC 8439 with the original 64-bit counter in
+// words 12 and 13 and a 64-bit nonce in 14 and 15: blocks 64-byte keystream
+// blocks for counter, counter + 1, .. into out. The RFC's 32-bit counter and
+// 96-bit nonce are the same state with the first nonce word as the counter's
+// high half. Wide kernels run one block per SIMD lane; AVX2 runs 8, and what
+// is left over past a multiple of lanes goes through the portable code.
+struct ChaCha20Kernel {
+    const char* name;
+    std::size_t lanes;
+    // lanes blocks from counter
+    void (*blocks)(uint8_t* out, const uint32_t* key, uint64_t counter, const uint32_t* nonce);
+};
+
+// null without AVX2
+const ChaCha20Kernel* avx2_chacha20_kernel();
+
+void chacha20_blocks(uint8_t* out, const uint32_t* key, uint64_t counter, const uint32_t* nonce,
+                     std::size_t blocks, const ChaCha20Kernel* kernel);
+inline void chacha20_blocks(uint8_t* out, const uint32_t* key, uint64_t counter, const uint32_t* nonce,
+                            std::size_t blocks) {
+    chacha20_blocks(out, key, counter, nonce, blocks, avx2_chacha20_kernel());
+}
+
+// A random bit generator on ChaCha20 with fast key erasure: each refill makes
+// BLOCKS blocks under the current key, takes the first 32 bytes of them as the
+// next key and hands out the rest, so the state held never reveals output
+// already given. For randomizers, blinding and test values in bulk, far
+// faster than std::random_device or hashing per value. Not thread safe; each
+// thread takes its own, or local().
+class ChaCha20Rng {
+public:
+    static constexpr std::size_t SEED_SIZE = 32;
+    static constexpr std::size_t BLOCKS = 16;
+
+    // seeded with 32 bytes of std::random_device
+    ChaCha20Rng();
+    // the stream of seed[0, 32), the same every time, for reproducible values
+    explicit ChaCha20Rng(const uint8_t* seed);
+    ~ChaCha20Rng();
+    // a copy would repeat the stream
+    ChaCha20Rng(const ChaCha20Rng&) = delete;
+    ChaCha20Rng& operator=(const ChaCha20Rng&) = delete;
+
+    void fill(uint8_t* out, std::size_t len);
+    uint64_t next();
+
+    // uniform in [0, n): bit_length(n) bits in whole digits straight from the
+    // stream, drawn again while not below n, so on average fewer than two
+    // draws; throws std::domain_error if n < 1
+    integer random_below(const integer& n);
+    FieldElement random_element(const PrimeField& field) { return FieldElement(random_below(field.prime()), field); }
+    Scalar random_scalar(const PrimeField& order) { return Scalar(random_below(order.prime()), order); }
+
+    // the calling thread's generator, seeded from the OS on first use
+    static ChaCha20Rng& local();
+
+private:
+    uint32_t key[8];
+    uint8_t buffer[64 * BLOCKS];
+    std::size_t used;           // bytes of buffer handed out, the key's 32 included
+
+    void refill();
+};
+
+#endif //ECC_CHACHA20_H
@@ -0,0 +1,59 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include "complete.h"
+
+Homogeneous complete_add(const Homogeneous& p, const Homogeneous& q, const FieldElement& a, const FieldElement& b3,
+                         bool a_zero) {
+    FieldElement t0 = p.X * q.X, t1 = p.Y * q.Y, t2 = p.Z * q.Z;
+    FieldElement t3 = (p.X + p.Y) * (q.X + q.Y) - (t0 + t1);
+    if (a_zero) {
+        FieldElement t4 = (p.Y + p.Z) * (q.Y + q.Z) - (t1 + t2);
+        FieldElement y3 = (p.X + p.Z) * (q.X + q.Z) - (t0 + t2);
+        t0 = t0 + t0 + t0;
+        t2 = b3 * t2;
+        FieldElement z3 = t1 + t2;
+        t1 -= t2;
+        y3 = b3 * y3;
+        FieldElement x3 = t3 * t1 - t4 * y3;
+        y3 = y3 * t0 + t1 * z3;
+        z3 = z3 * t4 + t0 * t3;
+        return {x3, y3, z3};
+    }
+    FieldElement t4 = (p.X + p.Z) * (q.X + q.Z) - (t0 + t2);
+    FieldElement t5 = (p.Y + p.Z) * (q.Y + q.Z) - (t1 + t2);
+    FieldElement z3 = a * t4 + b3 * t2;
+    FieldElement x3 = t1 - z3;
+    z3 += t1;
+    FieldElement y3 = x3 * z3;
+    t1 = t0 + t0 + t0;
+    t2 = a * t2;
+    t4 = b3 * t4;
+    t1 += t2;
+    t2 = a * (t0 - t2);
+    t4 += t2;
+    y3 += t1 * t4;
+    x3 = t3 * x3 - t5 * t4;
+    z3 = t5 * z3 + t3 * t1;
+    return {x3, y3, z3};
+}
+
+Homogeneous complete_dbl(const Homogeneous& p, const FieldElement& a, const FieldElement& b3, bool a_zero) {
+    if (!a_zero) {
+        return complete_add(p, p, a, b3, false);
+    }
+    FieldElement t0 = p.Y.square();
+    FieldElement z3 = t0 + t0;
+    z3 += z3;
+    z3 += z3;
+    FieldElement t1 = p.Y * p.Z;
+    FieldElement t2 = b3 * p.Z.square();
+    FieldElement x3 = t2 * z3;
+    FieldElement y3 = t0 + t2;
+    z3 = t1 * z3;
+    t0 -= t2 + t2 + t2;
+    y3 = x3 + t0 * y3;
+    x3 = t0 * (p.X * p.Y);
+    x3 += x3;
+    return {x3, y3, z3};
+}
@@ -0,0 +1,25 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_COMPLETE_H
+#define ECC_COMPLETE_H
+
+#include "FieldElement.h"
+
+// homogeneous (X : Y : Z) for the affine (X / Z, Y / Z), with the point at
+// infinity (0 : 1 : 0), for the complete formulas of Point::mul_ct and
+// FixedBaseTable::mul_ct
+struct Homogeneous {
+    FieldElement X, Y, Z;
+};
+
+// Renes, Costello and Batina, "Complete addition formulas for prime order
+// elliptic curves" (2016), algorithm 1 (any a, 12M + 3 by a + 2 by 3b) and
+// algorithm 7 (a = 0, 12M + 2 by 3b); correct for every pair of inputs
+Homogeneous complete_add(const Homogeneous& p, const Homogeneous& q, const FieldElement& a, const FieldElement& b3,
+                         bool a_zero);
+// algorithm 9 for a = 0 (6M + 2S + 1 by 3b), complete_add(p, p) otherwise
+Homogeneous complete_dbl(const Homogeneous& p, const FieldElement& a, const FieldElement& b3, bool a_zero);
+
+#endif //ECC_COMPLETE_H
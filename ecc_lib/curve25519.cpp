@@ -0,0 +1,166 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include "Curve25519Field51.h"
+#include "curve25519.h"
+#include "FieldElement.h"
+#include "PrimeField.h"
+
+const uint256 CURVE25519_FIELD_P = 0x7FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFED_u256;
+
+// two folds of the high half by 38, then at most two subtractions of p, since
+// 2^256 < 3p; the subtractions select rather than branch
+uint256 curve25519_reduce_p(const uint512& x) {
+    uint256 out;
+    limb_t top = 0;
+    for (std::size_t i = 0; i < 4; i++) {
+        out.limb[i] = limb_mac(x.limb[i + 4], 38, x.limb[i], top);
+    }
+    // top < 38, so top * 38 fits a limb and a carry out of this fold cannot happen twice
+    limb_t carry = 0;
+    out.limb[0] = limb_addc(out.limb[0], top * 38, carry);
+    for (std::size_t i = 1; i < 4; i++) {
+        out.limb[i] = limb_addc(out.limb[i], 0, carry);
+    }
+    limb_t k = 0;
+    out.limb[0] = limb_addc(out.limb[0], 38 & (0 - carry), k);
+    for (std::size_t i = 1; i < 4; i++) {
+        out.limb[i] = limb_addc(out.limb[i], 0, k);
+    }
+
+    for (int pass = 0; pass < 2; pass++) {
+        uint256 reduced;
+        const limb_t borrow = uint256::sub(reduced, out, CURVE25519_FIELD_P);
+        out = uint256::select(0 - (borrow ^ 1), reduced, out);
+    }
+    return out;
+}
+
+namespace {
+
+constexpr uint32_t A24 = 121665;        // (486662 - 2) / 4
+
+// The Montgomery ladder of RFC 7748, section 5, over any field type F given
+// its square, multiplication by A24, conditional swap and inversion by ops.
+// One step per bit of the clamped scalar from bit 254 down, the swaps on a
+// mask rather than a branch.
+template <typename F, typename Ops>
+F ladder(const Ops& ops, const uint8_t* k, const F& x1, const F& one, const F& zero) {
+    F x2 = one, z2 = zero, x3 = x1, z3 = one;
+    limb_t swap = 0;
+    for (int t = 254; t >= 0; t--) {
+        const limb_t bit = (k[t >> 3] >> (t & 7)) & 1;
+        swap ^= bit;
+        ops.cswap(0 - swap, x2, x3);
+        ops.cswap(0 - swap, z2, z3);
+        swap = bit;
+
+        const F A = x2 + z2;
+        const F AA = ops.sqr(A);
+        const F B = x2 - z2;
+        const F BB = ops.sqr(B);
+        const F E = AA - BB;
+        const F C = x3 + z3;
+        const F D = x3 - z3;
+        const F DA = D * A;
+        const F CB = C * B;
+        x3 = ops.sqr(DA + CB);
+        z3 = x1 * ops.sqr(DA - CB);
+        x2 = AA * BB;
+        z2 = E * (AA + ops.mul_a24(E));
+    }
+    ops.cswap(0 - swap, x2, x3);
+    ops.cswap(0 - swap, z2, z3);
+    return x2 * ops.invert(z2);
+}
+
+// RFC 7748 decodeScalar25519
+void clamp(uint8_t* k, const uint8_t* scalar) {
+    for (std::size_t i = 0; i < 32; i++) {
+        k[i] = scalar[i];
+    }
+    k[0] &= 248;
+    k[31] &= 127;
+    k[31] |= 64;
+}
+
+Status all_zero_check(const uint8_t* out) {
+    uint8_t any = 0;
+    for (std::size_t i = 0; i < 32; i++) {
+        any |= out[i];
+    }
+    return any ? Status::ok : Status::infinity;
+}
+
+struct ElementOps {
+    FieldElement a24;
+
+    FieldElement sqr(const FieldElement& a) const { return a.square(); }
+    FieldElement mul_a24(const FieldElement& a) const { return a * this->a24; }
+    void cswap(limb_t mask, FieldElement& a, FieldElement& b) const {
+        FieldElement t = FieldElement::select(mask, b, a);
+        b = FieldElement::select(mask, a, b);
+        a = std::move(t);
+    }
+    // the chain maps zero to zero where division would throw
+    FieldElement invert(const FieldElement& a) const {
+        return curve25519_fermat_inverse(a,
+                [](const FieldElement& x, const FieldElement& y) { return x * y; },
+                [](const FieldElement& x) { return x.square(); });
+    }
+};
+
+#if defined(__SIZEOF_INT128__)
+struct Field51Ops {
+    Curve25519Field51 sqr(const Curve25519Field51& a) const { return a.square(); }
+    Curve25519Field51 mul_a24(const Curve25519Field51& a) const { return a.mul_small(A24); }
+    void cswap(limb_t mask, Curve25519Field51& a, Curve25519Field51& b) const {
+        Curve25519Field51::cswap(mask, a, b);
+    }
+    Curve25519Field51 invert(const Curve25519Field51& a) const { return a.inverse(); }
+};
+#endif
+
+}
+
+Status x25519(uint8_t* out, const uint8_t* scalar, const uint8_t* u) noexcept {
+#if defined(__SIZEOF_INT128__)
+    uint8_t k[32];
+    clamp(k, scalar);
+    const Curve25519Field51 x1 = Curve25519Field51::from_bytes(u);
+    ladder(Field51Ops(), k, x1, Curve25519Field51(1), Curve25519Field51(0)).to_bytes(out);
+    return all_zero_check(out);
+#else
+    return x25519_portable(out, scalar, u);
+#endif
+}
+
+Status x25519_base(uint8_t* out, const uint8_t* scalar) noexcept {
+    static const uint8_t base[32] = {9};
+    return x25519(out, scalar, base);
+}
+
+Status x25519_portable(uint8_t* out, const uint8_t* scalar, const uint8_t* u) noexcept {
+    static const PrimeField& field = PrimeField::get(CURVE25519_FIELD_P.to_integer());
+    uint8_t k[32];
+    clamp(k, scalar);
+
+    uint256 u_value(0);
+    for (std::size_t i = 0; i < 32; i++) {
+        u_value.limb[i / 8] |= static_cast<limb_t>(u[i]) << (8 * (i % 8));
+    }
+    u_value.limb[3] &= 0x7FFFFFFFFFFFFFFF;
+    if (u_value >= CURVE25519_FIELD_P) {
+        u_value -= CURVE25519_FIELD_P;
+    }
+
+    const FieldElement x1(u_value.to_integer(), field);
+    const ElementOps ops{FieldElement(A24, field)};
+    const FieldElement r = ladder(ops, k, x1, FieldElement(1, field), FieldElement(0, field));
+
+    const uint256 value = uint256::from_integer(r.value());
+    for (std::size_t i = 0; i < 32; i++) {
+        out[i] = static_cast<uint8_t>(value.limb[i / 8] >> (8 * (i % 8)));
+    }
+    return all_zero_check(out);
+}
@@ -0,0 +1,76 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_CURVE25519_H
+#define ECC_CURVE25519_H
+
+#include <cstdint>
+
+#include "modexp.h"
+#include "Status.h"
+#include "uint256.h"
+
+// Field prime p = 2^255 - 19 of Curve25519 (RFC 7748), the Montgomery curve
+// v^2 = u^3 + 486662 u^2 + u
+extern const uint256 CURVE25519_FIELD_P;
+
+// x mod p for any 512-bit x, using 2^256 = 38 (mod p); no division. PrimeField
+// binds it as the fold of the field, so FieldElements mod p take it as well.
+uint256 curve25519_reduce_p(const uint512& x);
+
+// Addition chains of the reference implementation for the two fixed
+// exponents of the field prime. Both start from a^11 and x250, where xk is
+// a^(2^k - 1): 249 squarings and 10 multiplications.
+template <typename T>
+struct Curve25519ChainStart {
+    T a11, x250;
+};
+
+template <typename T, typename Mul, typename Sqr>
+Curve25519ChainStart<T> curve25519_chain_start(const T& a, Mul mul, Sqr sqr) {
+    const T a2 = sqr(a);
+    const T a9 = mul(repeated_square(a2, 2, sqr), a);
+    const T a11 = mul(a9, a2);
+    const T x5 = mul(sqr(a11), a9);
+    const T x10 = mul(repeated_square(x5, 5, sqr), x5);
+    const T x20 = mul(repeated_square(x10, 10, sqr), x10);
+    const T x40 = mul(repeated_square(x20, 20, sqr), x20);
+    const T x50 = mul(repeated_square(x40, 10, sqr), x10);
+    const T x100 = mul(repeated_square(x50, 50, sqr), x50);
+    const T x200 = mul(repeated_square(x100, 100, sqr), x100);
+    const T x250 = mul(repeated_square(x200, 50, sqr), x50);
+    return {a11, x250};
+}
+
+// a^(p - 2), the inverse of a non-zero a: 254 squarings, 11 multiplications
+template <typename T, typename Mul, typename Sqr>
+T curve25519_fermat_inverse(const T& a, Mul mul, Sqr sqr) {
+    const Curve25519ChainStart<T> x = curve25519_chain_start(a, mul, sqr);
+    // p - 2 = (2^250 - 1) * 2^5 + 11
+    return mul(repeated_square(x.x250, 5, sqr), x.a11);
+}
+
+// a^((p - 5) / 8), from which the square roots of p = 5 (mod 8) are built:
+// 251 squarings, 11 multiplications
+template <typename T, typename Mul, typename Sqr>
+T curve25519_pow_p58(const T& a, Mul mul, Sqr sqr) {
+    const Curve25519ChainStart<T> x = curve25519_chain_start(a, mul, sqr);
+    // (p - 5) / 8 = (2^250 - 1) * 2^2 + 1
+    return mul(repeated_square(x.x250, 2, sqr), a);
+}
+
+// X25519 of RFC 7748, section 5: out = the u-coordinate of scalar * (u, v),
+// all three little-endian 32-byte strings. The scalar is clamped and the top
+// bit of u ignored, as the RFC decodes them, and every u is accepted, so the
+// ladder runs the same steps whatever the inputs. Returns Status::infinity when
+// the result is all zeros (u of small order), which a key exchange must
+// reject; out is written either way. Runs on Curve25519Field51 where there are
+// 128-bit products and on x25519_portable otherwise.
+Status x25519(uint8_t* out, const uint8_t* scalar, const uint8_t* u) noexcept;
+// x25519 of the base point u = 9: the public key of scalar
+Status x25519_base(uint8_t* out, const uint8_t* scalar) noexcept;
+// the same ladder on FieldElements mod p, for any target and as a reference
+Status x25519_portable(uint8_t* out, const uint8_t* scalar, const uint8_t* u) noexcept;
+
+#endif //ECC_CURVE25519_H
@@ -0,0 +1,193 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+#include "Curve.h"
+#include "daemon.h"
+#include "ecdsa.h"
+#include "metrics.h"
+#include "schnorr.h"
+#include "sec1.h"
+#include "secure_zero.h"
+
+static const Curve& ecdsa_curve(BulkScheme scheme) {
+    return scheme == BulkScheme::ecdsa_p256 ? Curve::p256() : Curve::secp256k1();
+}
+
+static bool known(uint32_t scheme) {
+    return scheme >= static_cast<uint32_t>(BulkScheme::ecdsa_secp256k1) &&
+           scheme <= static_cast<uint32_t>(BulkScheme::schnorr);
+}
+
+ShmServer::ShmServer(const std::string& name, std::size_t channels, std::size_t slots)
+        : stopping(false), count(0) {
+    Curve::secp256k1().generator_table();
+    Curve::p256().generator_table();
+    for (std::size_t i = 0; i < channels; i++) {
+        this->channels.emplace_back(new ShmChannel(name + "." + std::to_string(i), slots));
+    }
+    for (std::unique_ptr<ShmChannel>& channel : this->channels) {
+        ShmChannel* c = channel.get();
+        this->threads.emplace_back([this, c]() { serve(*c); });
+    }
+}
+
+ShmServer::~ShmServer() {
+    this->stopping.store(true);
+    for (std::thread& thread : this->threads) {
+        thread.join();
+    }
+}
+
+void ShmServer::serve(ShmChannel& channel) {
+    static Metrics::Counter& requests = Metrics::global().counter("ecc_daemon_requests_total",
+                                                                  "requests ShmServers answered");
+    static Histogram& latency = Metrics::global().histogram("ecc_daemon_request_seconds",
+                                                            "ShmServer requests, taken off the ring to answered");
+    ShmMessage request, response;
+    while (!this->stopping.load(std::memory_order_relaxed)) {
+        if (!channel.requests().wait(std::chrono::milliseconds(50))) {
+            continue;
+        }
+        while (channel.requests().try_pop(request)) {
+            {
+                HistogramTimer timer(latency);
+                handle(request, response);
+            }
+            this->count.fetch_add(1, std::memory_order_relaxed);
+            requests.add();
+            while (!channel.responses().try_push(response)) {
+                // the client is not reading its answers
+                if (this->stopping.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+void ShmServer::handle(ShmMessage& request, ShmMessage& response) noexcept {
+    response.id = request.id;
+    response.op = request.op;
+    response.scheme = request.scheme;
+    response.length = 0;
+    const uint32_t len = request.length;
+    if (!known(request.scheme) || len > ShmMessage::capacity) {
+        response.status = static_cast<uint32_t>(Status::bad_encoding);
+        return;
+    }
+    const BulkScheme scheme = static_cast<BulkScheme>(request.scheme);
+    const uint8_t* body = request.body;
+    Status status = Status::bad_encoding;
+    if (request.op == static_cast<uint32_t>(ShmOp::verify)) {
+        const std::size_t key = bulk_key_size(scheme);
+        if (len >= key + 64) {
+            if (scheme == BulkScheme::schnorr) {
+                status = schnorr_verify(body + key, body + key + 64, len - key - 64, body);
+            } else {
+                const Curve& curve = ecdsa_curve(scheme);
+                const Result<Point> q = sec1_decode(body, key, curve);
+                status = q ? ecdsa_verify(body + key, curve, *q, body + key + 64, len - key - 64) : q.status();
+            }
+        }
+    } else if (request.op == static_cast<uint32_t>(ShmOp::sign) && len >= 64) {
+        if (scheme == BulkScheme::schnorr) {
+            status = schnorr_sign(response.body, body + 64, len - 64, body, body + 32);
+        } else {
+            status = ecdsa_sign(response.body, ecdsa_curve(scheme), body, body + 64, len - 64);
+        }
+        secure_zero(request.body, 32);
+        if (status == Status::ok) {
+            response.length = 64;
+        }
+    }
+    response.status = static_cast<uint32_t>(status);
+}
+
+ShmClient::ShmClient(const std::string& name, std::size_t channels) : next(1) {
+    for (std::size_t i = 0; i < channels && !this->channel; i++) {
+        std::unique_ptr<ShmChannel> c(new ShmChannel(name + "." + std::to_string(i)));
+        if (c->claim()) {
+            this->channel = std::move(c);
+        }
+    }
+    if (!this->channel) {
+        throw std::runtime_error("Every channel of " + name + " is taken");
+    }
+}
+
+ShmClient::~ShmClient() {
+    this->channel->release();
+}
+
+ShmMessage ShmClient::call(ShmMessage& request) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    request.id = this->next++;
+    while (!this->channel->requests().try_push(request)) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            throw std::runtime_error("The daemon is not taking requests");
+        }
+        std::this_thread::yield();
+    }
+    ShmMessage response;
+    for (;;) {
+        while (this->channel->responses().try_pop(response)) {
+            if (response.id == request.id) {
+                return response;
+            }
+        }
+        if (std::chrono::steady_clock::now() > deadline) {
+            throw std::runtime_error("No answer from the daemon");
+        }
+        this->channel->responses().wait(std::chrono::milliseconds(10));
+    }
+}
+
+Status ShmClient::verify(BulkScheme scheme, const uint8_t* public_key, const uint8_t* signature,
+                         const uint8_t* message, std::size_t len) {
+    const std::size_t key = bulk_key_size(scheme);
+    if (len > ShmMessage::capacity - key - 64) {
+        return Status::buffer_too_small;
+    }
+    ShmMessage request;
+    request.op = static_cast<uint32_t>(ShmOp::verify);
+    request.scheme = static_cast<uint32_t>(scheme);
+    request.status = 0;
+    request.length = static_cast<uint32_t>(key + 64 + len);
+    std::memcpy(request.body, public_key, key);
+    std::memcpy(request.body + key, signature, 64);
+    std::memcpy(request.body + key + 64, message, len);
+    return static_cast<Status>(call(request).status);
+}
+
+Result<ShmClient::Signature> ShmClient::sign(BulkScheme scheme, const uint8_t* secret, const uint8_t* message,
+                                             std::size_t len, const uint8_t* aux) {
+    if (len > ShmMessage::capacity - 64) {
+        return Status::buffer_too_small;
+    }
+    ShmMessage request;
+    request.op = static_cast<uint32_t>(ShmOp::sign);
+    request.scheme = static_cast<uint32_t>(scheme);
+    request.status = 0;
+    request.length = static_cast<uint32_t>(64 + len);
+    std::memcpy(request.body, secret, 32);
+    if (aux) {
+        std::memcpy(request.body + 32, aux, 32);
+    } else {
+        std::memset(request.body + 32, 0, 32);
+    }
+    std::memcpy(request.body + 64, message, len);
+    const ShmMessage response = call(request);
+    secure_zero(request.body, 32);
+    const Status status = static_cast<Status>(response.status);
+    if (status != Status::ok) {
+        return status;
+    }
+    Signature signature;
+    std::memcpy(signature.data(), response.body, 64);
+    return signature;
+}
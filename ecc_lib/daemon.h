@@ -0,0 +1,90 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_DAEMON_H
+#define ECC_DAEMON_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bulk.h"
+#include "shm_ring.h"
+#include "Status.h"
+
+// Verification and signing served to co-located processes over ShmChannels,
+// so a client pays neither for loading the library nor for warming the
+// generator tables. Requests (ShmMessage, scheme a BulkScheme):
+//
+//     ShmOp::verify   body: public key (bulk_key_size) || signature (64) || message
+//     ShmOp::sign     body: secret (32) || aux (32, BIP340 only) || message
+//
+// where the message of ECDSA is the hash. The answer's status is the Status
+// of ecdsa_verify, schnorr_verify, ecdsa_sign or schnorr_sign, as uint32_t,
+// with the 64-byte signature in its body after a sign. A secret sits in its
+// ring slot until the slot is reused, so a channel is as private as its 0600
+// mode and no more.
+enum class ShmOp : uint32_t {
+    verify = 1,
+    sign = 2,
+};
+
+// Channels name.0, .., name.(channels - 1), each served by a thread of its own
+// until the server is destroyed. The tables of secp256k1 and P-256 are built
+// before the first channel opens
+class ShmServer {
+public:
+    ShmServer(const std::string& name, std::size_t channels = 1, std::size_t slots = 1024);
+    ~ShmServer();
+    ShmServer(const ShmServer&) = delete;
+    ShmServer& operator=(const ShmServer&) = delete;
+
+    // the answer to request; the secret of a sign request is zeroed in it
+    static void handle(ShmMessage& request, ShmMessage& response) noexcept;
+
+    uint64_t served() const { return this->count.load(std::memory_order_relaxed); }
+
+private:
+    void serve(ShmChannel& channel);
+
+    std::vector<std::unique_ptr<ShmChannel>> channels;
+    std::vector<std::thread> threads;
+    std::atomic<bool> stopping;
+    std::atomic<uint64_t> count;
+};
+
+// One client of a ShmServer, on the first channel of name.0, .., name.(channels
+// - 1) no other client has claimed; throws std::runtime_error when there is
+// none. The calls block for the answer; one client is not for several threads
+class ShmClient {
+public:
+    typedef std::array<uint8_t, 64> Signature;
+
+    explicit ShmClient(const std::string& name, std::size_t channels = 1);
+    ~ShmClient();
+    ShmClient(const ShmClient&) = delete;
+    ShmClient& operator=(const ShmClient&) = delete;
+
+    // Status::buffer_too_small for a message longer than the body has room for
+    Status verify(BulkScheme scheme, const uint8_t* public_key, const uint8_t* signature, const uint8_t* message,
+                  std::size_t len);
+    Result<Signature> sign(BulkScheme scheme, const uint8_t* secret, const uint8_t* message, std::size_t len,
+                           const uint8_t* aux = nullptr);
+
+    // the raw exchange the calls above make: request sent (its id set) and
+    // the answer with that id returned; throws std::runtime_error when none
+    // comes within ten seconds
+    ShmMessage call(ShmMessage& request);
+
+private:
+    std::unique_ptr<ShmChannel> channel;
+    uint64_t next;
+};
+
+#endif //ECC_DAEMON_H
@@ -0,0 +1,161 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <algorithm>
+#include <exception>
+
+#include "decompress.h"
+#include "FieldVector.h"
+#include "modexp.h"
+#include "p256.h"
+#include "secp256k1.h"
+#include "trace.h"
+
+namespace {
+
+void mark(DecompressedKeys& keys, std::size_t i) {
+    keys.invalid[i / 64] |= uint64_t(1) << (i % 64);
+}
+
+// r^2 = v wherever v is a square, for fields with p = 3 mod 4: v^((p + 1) / 4)
+FieldVector root_candidates(const FieldVector& v) {
+    auto mul = [](const FieldVector& a, const FieldVector& b) { return a * b; };
+    auto sqr = [](const FieldVector& a) { return a.square(); };
+    const PrimeField& field = v.prime_field();
+    switch (field.addition_chain()) {
+        case PrimeField::chain::secp256k1:
+            return secp256k1_sqrt_candidate(v, mul, sqr);
+        case PrimeField::chain::p256:
+            return p256_sqrt_candidate(v, mul, sqr);
+        default:
+            break;
+    }
+    FieldVector one(field, v.size());
+    for (std::size_t i = 0; i < v.size(); i++) {
+        one.set(i, FieldElement(1, field));
+    }
+    return sliding_window_pow(v, field.sqrt_exponent(), one, mul, sqr);
+}
+
+// every element set to value
+FieldVector broadcast(const FieldElement& value, std::size_t count) {
+    FieldVector out(value.prime_field(), count);
+    for (std::size_t i = 0; i < count; i++) {
+        out.set(i, value);
+    }
+    return out;
+}
+
+}
+
+std::size_t DecompressedKeys::invalid_count() const {
+    std::size_t n = 0;
+    for (uint64_t word : this->invalid) {
+        for (; word; word &= word - 1) {
+            n++;
+        }
+    }
+    return n;
+}
+
+DecompressedKeys decompress_keys(const uint8_t* data, std::size_t count, const Curve& curve) {
+    ECC_TRACE_SPAN("decompress");
+    const PrimeField& field = curve.field();
+    const std::size_t size = compressed_key_size(curve);
+    DecompressedKeys keys;
+    keys.points.assign(count, curve.infinity());
+    keys.invalid.assign((count + 63) / 64, 0);
+
+    // x of every key, zero for the ones already rejected
+    std::vector<FieldElement> x;
+    x.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+        const uint8_t* key = data + i * size;
+        integer value = integer::from_bytes(key + 1, size - 1);
+        if ((key[0] != 2 && key[0] != 3) || value >= field.prime()) {
+            mark(keys, i);
+            value = 0;
+        }
+        x.emplace_back(value, field);
+    }
+
+    // y^2 = x^3 + ax + b and a candidate y for it
+    std::vector<FieldElement> rhs, y;
+    if (field.fixed() && field.two_adicity() == 1) {
+        const FieldVector xs(field, x);
+        FieldVector r = xs.square() * xs + broadcast(curve.b(), count);
+        if (!curve.a().is_zero()) {
+            r += broadcast(curve.a(), count) * xs;
+        }
+        rhs = r.elements();
+        y = root_candidates(r).elements();
+    } else {
+        for (std::size_t i = 0; i < count; i++) {
+            FieldElement r = x[i].square() * x[i] + curve.a() * x[i] + curve.b();
+            y.push_back(r.is_square() ? r.sqrt() : r);
+            rhs.push_back(std::move(r));
+        }
+    }
+
+    const FieldElement zero(0, field);
+    for (std::size_t i = 0; i < count; i++) {
+        if (!keys.valid(i)) {
+            continue;
+        }
+        if (y[i].square() != rhs[i]) {
+            mark(keys, i);
+            continue;
+        }
+        const bool odd = data[i * size] == 3;
+        if (y[i].value()[0] != odd) {
+            // y = 0 has no odd form
+            if (y[i].is_zero()) {
+                mark(keys, i);
+                continue;
+            }
+            y[i] = zero - y[i];
+        }
+        keys.points[i] = Point(x[i], y[i], curve.a(), curve.b());
+    }
+    return keys;
+}
+
+DecompressedKeys decompress_keys(const uint8_t* data, std::size_t count, const Curve& curve,
+                                 const Executor::function_type& executor, std::size_t parallelism) {
+    // the vector arithmetic wants long chunks; 64 keys is one word of the mask
+    static constexpr std::size_t MIN_CHUNK = 256;
+    const std::size_t chunks = std::max<std::size_t>(1, std::min(std::max<std::size_t>(parallelism, 1),
+                                                                 count / MIN_CHUNK));
+    if (chunks == 1) {
+        return decompress_keys(data, count, curve);
+    }
+    const std::size_t size = compressed_key_size(curve);
+    const std::size_t chunk = ((count + chunks - 1) / chunks + 63) / 64 * 64;
+    DecompressedKeys keys;
+    keys.points.assign(count, curve.infinity());
+    keys.invalid.assign((count + 63) / 64, 0);
+    std::vector<std::exception_ptr> errors(chunks);
+    executor(chunks, [&](std::size_t t) {
+        const std::size_t first = std::min(count, t * chunk), last = std::min(count, first + chunk);
+        if (first == last) {
+            return;
+        }
+        try {
+            DecompressedKeys part = decompress_keys(data + first * size, last - first, curve);
+            std::move(part.points.begin(), part.points.end(), keys.points.begin() + first);
+            std::copy(part.invalid.begin(), part.invalid.end(), keys.invalid.begin() + first / 64);
+        } catch (...) {
+            errors[t] = std::current_exception();
+        }
+    });
+    for (const std::exception_ptr& e : errors) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+    return keys;
+}
+
+DecompressedKeys decompress_keys(const uint8_t* data, std::size_t count, const Curve& curve, Executor& executor) {
+    return decompress_keys(data, count, curve, executor.function(), executor.concurrency());
+}
@@ -0,0 +1,48 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_DECOMPRESS_H
+#define ECC_DECOMPRESS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Curve.h"
+#include "Executor.h"
+#include "Point.h"
+
+// Bulk decompression of SEC 1 compressed public keys: a prefix 0x02 (even y)
+// or 0x03 (odd y) and x in big-endian, 33 bytes on 256-bit curves. Bad keys are
+// reported in a bitmask instead of by exceptions, so one bad key costs no
+// more than a good one.
+
+// bytes of one compressed key on curve
+inline std::size_t compressed_key_size(const Curve& curve) {
+    return 1 + (curve.field().bits() + 7) / 8;
+}
+
+struct DecompressedKeys {
+    // the point of key i, or the point at infinity where the key is invalid
+    std::vector<Point> points;
+    // bit i % 64 of word i / 64 is set where key i is invalid: a prefix other
+    // than 2 or 3, x not below p, or no y with y^2 = x^3 + ax + b
+    std::vector<uint64_t> invalid;
+
+    bool valid(std::size_t i) const { return !((this->invalid[i / 64] >> (i % 64)) & 1); }
+    std::size_t invalid_count() const;
+};
+
+// the count keys at data[i * size, (i + 1) * size), size = compressed_key_size(curve).
+// For fields of at most 256 bits, x^3 + ax + b and the square root candidates
+// of all keys are evaluated together on FieldVectors, the roots by the field's
+// addition chain or one shared power; other fields go key by key
+DecompressedKeys decompress_keys(const uint8_t* data, std::size_t count, const Curve& curve = Curve::secp256k1());
+// the same in chunks of a multiple of 64 keys, one or more per task of
+// executor as msm_executor runs them, each chunk as above; small batches stay in one
+DecompressedKeys decompress_keys(const uint8_t* data, std::size_t count, const Curve& curve,
+                                 const Executor::function_type& executor, std::size_t parallelism);
+DecompressedKeys decompress_keys(const uint8_t* data, std::size_t count, const Curve& curve, Executor& executor);
+
+#endif //ECC_DECOMPRESS_H
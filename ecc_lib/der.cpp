@@ -0,0 +1,113 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstring>
+
+#include "der.h"
+
+namespace {
+
+// whether the len content bytes of an INTEGER at in are what BIP66 allows and
+// fit in 32 bytes: at least one, not negative, no zero in front unless the
+// next byte has its top bit set, and 33 only with that zero
+bool strict_integer(const uint8_t* in, std::size_t len) {
+    if (len == 0) {
+        return false;
+    }
+    const bool padded = len > 1 && in[0] == 0;
+    return (len <= 33) & !(in[0] & 0x80) & (!padded || (in[1] & 0x80) != 0) & (len < 33 || padded);
+}
+
+// the INTEGER content at in, len bytes, right-aligned in out[0, 32)
+void put_fixed(uint8_t* out, const uint8_t* in, std::size_t len) {
+    const std::size_t skip = len > 32;
+    std::memset(out, 0, 32 - (len - skip));
+    std::memcpy(out + 32 - (len - skip), in + skip, len - skip);
+}
+
+// the first byte of the 32-byte v that the INTEGER of v starts from, the last
+// if all are zero
+std::size_t first_byte(const uint8_t* v) {
+    std::size_t first = 0;
+    while (first < 31 && v[first] == 0) {
+        first++;
+    }
+    return first;
+}
+
+// content bytes of the INTEGER of v: from its first byte, and a zero ahead of a top bit
+std::size_t integer_size(const uint8_t* v) {
+    const std::size_t first = first_byte(v);
+    return 32 - first + (v[first] >> 7);
+}
+
+// the INTEGER of v at out, integer_size(v) + 2 bytes
+void put_integer(uint8_t* out, const uint8_t* v) {
+    const std::size_t first = first_byte(v);
+    const std::size_t pad = v[first] >> 7;
+    out[0] = 0x02;
+    out[1] = static_cast<uint8_t>(32 - first + pad);
+    out[2] = 0;
+    std::memcpy(out + 2 + pad, v + first, 32 - first);
+}
+
+}
+
+Result<std::size_t> der_encode(const uint8_t* signature, uint8_t* out, std::size_t capacity) noexcept {
+    const std::size_t r_len = integer_size(signature), s_len = integer_size(signature + 32);
+    const std::size_t size = 6 + r_len + s_len;
+    if (capacity < size) {
+        return Status::buffer_too_small;
+    }
+    out[0] = 0x30;
+    out[1] = static_cast<uint8_t>(size - 2);
+    put_integer(out + 2, signature);
+    put_integer(out + 4 + r_len, signature + 32);
+    return size;
+}
+
+Result<std::size_t> der_encode(const Scalar& r, const Scalar& s, uint8_t* out, std::size_t capacity) noexcept {
+    uint8_t signature[64];
+    r.to_bytes(signature);
+    s.to_bytes(signature + 32);
+    return der_encode(signature, out, capacity);
+}
+
+// 0x30, length, 0x02, length of r, r, 0x02, length of s, s. Only the lengths,
+// which say where the rest lies, are checked before reading on
+Status der_decode(uint8_t* signature, const uint8_t* in, std::size_t len) noexcept {
+    if (len < 8 || len > DER_MAX_SIZE) {
+        return Status::bad_encoding;
+    }
+    const std::size_t r_len = in[3];
+    if (r_len + 7 > len) {
+        return Status::bad_encoding;
+    }
+    const std::size_t s_len = in[5 + r_len];
+    if (r_len + s_len + 6 != len) {
+        return Status::bad_encoding;
+    }
+    const uint8_t* r = in + 4;
+    const uint8_t* s = in + 6 + r_len;
+    const bool valid = (in[0] == 0x30) & (in[1] == len - 2) & (in[2] == 0x02) & (in[4 + r_len] == 0x02)
+                       & strict_integer(r, r_len) & strict_integer(s, s_len);
+    if (!valid) {
+        return Status::bad_encoding;
+    }
+    put_fixed(signature, r, r_len);
+    put_fixed(signature + 32, s, s_len);
+    return Status::ok;
+}
+
+Result<std::pair<Scalar, Scalar>> der_decode(const uint8_t* in, std::size_t len, const PrimeField& order) noexcept {
+    uint8_t signature[64];
+    const Status status = der_decode(signature, in, len);
+    if (status != Status::ok) {
+        return status;
+    }
+    const uint256 r = uint256::load_be(signature, 32), s = uint256::load_be(signature + 32, 32);
+    if (r.is_zero() || s.is_zero() || !(r < order.fixed_prime()) || !(s < order.fixed_prime())) {
+        return Status::out_of_range;
+    }
+    return std::make_pair(Scalar::from_bytes(signature, 32, order), Scalar::from_bytes(signature + 32, 32, order));
+}
@@ -0,0 +1,38 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_DER_H
+#define ECC_DER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "PrimeField.h"
+#include "Scalar.h"
+#include "Status.h"
+
+// ECDSA signatures in the strict DER of BIP66, SEQUENCE { INTEGER r, INTEGER
+// s }, for the 64-byte signatures of ecdsa.h (r then s, 32 big-endian bytes
+// each). Both directions work in caller-owned buffers with no integer, string
+// or allocation, and decoding reads the input once, the checks of BIP66
+// gathered into one verdict rather than a branch apiece. The sighash byte
+// Bitcoin appends is not part of the encoding; callers strip it first.
+
+// the longest encoding, of two 33-byte integers
+constexpr std::size_t DER_MAX_SIZE = 72;
+
+// writes the encoding of signature to out and returns the number of bytes, at
+// most DER_MAX_SIZE; Status::buffer_too_small if capacity is less
+Result<std::size_t> der_encode(const uint8_t* signature, uint8_t* out, std::size_t capacity) noexcept;
+Result<std::size_t> der_encode(const Scalar& r, const Scalar& s, uint8_t* out, std::size_t capacity) noexcept;
+
+// the signature encoded in in[0, len) into signature[0, 64): Status::bad_encoding
+// for anything BIP66 rejects (a wrong tag or length, an empty, negative or
+// zero-padded integer, bytes left over) or for an integer of more than 32 bytes
+Status der_decode(uint8_t* signature, const uint8_t* in, std::size_t len) noexcept;
+// the same as (r, s) mod order, with Status::out_of_range for r or s not in [1, n)
+Result<std::pair<Scalar, Scalar>> der_decode(const uint8_t* in, std::size_t len, const PrimeField& order) noexcept;
+
+#endif //ECC_DER_H
@@ -0,0 +1,505 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "chacha20.h"
+#include "dlog.h"
+#include "Executor.h"
+#include "primality.h"
+
+namespace {
+
+// points normalized with one inversion
+constexpr std::size_t BATCH = 1024;
+// seed of the hashes of x the searches use
+constexpr uint64_t HASH_SEED = 0x9e3779b97f4a7c15;
+
+integer mod(const integer& v, const integer& n) {
+    integer r = v % n;
+    return r < 0 ? r + n : r;
+}
+
+void count(DlogStats* stats, uint64_t additions, uint64_t distinguished = 0, uint64_t restarts = 0) {
+    if (stats) {
+        stats->additions += additions;
+        stats->distinguished += distinguished;
+        stats->restarts += restarts;
+    }
+}
+
+// the baby steps of dlog_bsgs by the hash of their x: linear probing over a
+// power of two of slots at most half full, a slot the step in its low bits
+// and the rest of the hash above them, 0 for empty
+class BabySteps {
+public:
+    explicit BabySteps(uint64_t steps) : bits(1) {
+        while ((uint64_t(1) << this->bits) <= steps) {
+            this->bits++;
+        }
+        std::size_t capacity = 1;
+        while (capacity < 2 * steps) {
+            capacity <<= 1;
+        }
+        this->slots.assign(capacity, 0);
+    }
+
+    void insert(uint64_t hash, uint64_t step) {
+        std::size_t i = hash & (this->slots.size() - 1);
+        while (this->slots[i]) {
+            i = (i + 1) & (this->slots.size() - 1);
+        }
+        this->slots[i] = fingerprint(hash) | step;
+    }
+
+    // calls found(step) for every step stored under hash's fingerprint
+    template <typename Found>
+    void find(uint64_t hash, Found found) const {
+        const uint64_t mask = (uint64_t(1) << this->bits) - 1;
+        for (std::size_t i = hash & (this->slots.size() - 1); this->slots[i];
+             i = (i + 1) & (this->slots.size() - 1)) {
+            if ((this->slots[i] & ~mask) == fingerprint(hash)) {
+                found(this->slots[i] & mask);
+            }
+        }
+    }
+
+private:
+    unsigned bits;      // of a step
+    std::vector<uint64_t> slots;
+
+    uint64_t fingerprint(uint64_t hash) const { return hash >> this->bits << this->bits; }
+};
+
+// one rho walk: P = a g + b h, normalized with even y
+struct Walk {
+    Point p;
+    integer a, b;
+    uint64_t hash = 0;
+    // the point before, and the hashes of it and the one before that
+    Point previous;
+    integer previous_a, previous_b;
+    uint64_t previous_hash = 0, before_previous_hash = 0;
+    // the hash at the start of this window of CYCLE_WINDOW steps and its
+    // smallest point so far
+    uint64_t mark = 0, window = 0;
+    Point lowest;
+    integer lowest_a, lowest_b;
+    uint64_t lowest_hash = 0;
+    uint64_t since_distinguished = 0;
+
+    explicit Walk(const Point& g) : p(g), previous(g), lowest(g) {}
+};
+
+// steps between the checks for fruitless cycles longer than 2, a multiple of
+// the lengths 4, 6, 8, 12 and 16 the negation map makes most often
+constexpr uint64_t CYCLE_WINDOW = 48;
+
+// the state dlog_rho's threads share
+struct RhoSearch {
+    const Point& g;
+    const Point& h;
+    const integer& n;
+    unsigned d;
+    uint64_t give_up;
+    std::vector<Point> steps;
+    std::vector<integer> step_a, step_b;
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> additions{0}, distinguished{0}, restarts{0};
+    std::mutex lock;
+    // the distinguished points by the hash of x
+    struct Entry {
+        FieldElement x;
+        integer a, b;
+    };
+    std::unordered_map<uint64_t, Entry> points;
+    std::optional<integer> answer;
+
+    RhoSearch(const Point& g, const Point& h, const integer& n) : g(g), h(h), n(n) {}
+
+    integer neg(const integer& v) const { return v == 0 ? v : this->n - v; }
+    integer add(const integer& u, const integer& v) const {
+        integer r = u + v;
+        return r >= this->n ? r - this->n : r;
+    }
+
+    // x from a1 + b1 x = a2 + b2 x, if b1 != b2; true once the search is over
+    bool solve(const integer& a1, const integer& b1, const integer& a2, const integer& b2) {
+        if (b1 == b2) {
+            return false;
+        }
+        const integer x = mod((a2 - a1) * mod(b1 - b2, this->n).modinv(this->n), this->n);
+        if (!(this->g * x == this->h)) {
+            return false;
+        }
+        std::lock_guard<std::mutex> guard(this->lock);
+        this->answer = x;
+        this->done = true;
+        return true;
+    }
+
+    // P or -P, whichever has even y, with its a and b to match
+    void canonical(Walk& w) const {
+        if (w.p.y().value().test_bit(0)) {
+            w.p = -w.p;
+            w.a = neg(w.a);
+            w.b = neg(w.b);
+        }
+        w.hash = w.p.x().hash(HASH_SEED);
+    }
+
+    void restart(Walk& w, ChaCha20Rng& rng) const {
+        do {
+            w.a = rng.random_below(this->n);
+            w.b = rng.random_below(this->n);
+            w.p = Point::mul_add(w.a, this->g, w.b, this->h).normalized();
+        } while (w.p.is_infinity());
+        canonical(w);
+        w.previous_hash = w.before_previous_hash = w.hash + 1;
+        w.mark = w.hash;
+        w.window = 0;
+        w.lowest_hash = UINT64_MAX;
+        w.since_distinguished = 0;
+    }
+
+    // on from a fruitless cycle to twice its point p of the smallest hash, the
+    // same whichever point of the cycle the walk is on; false at infinity
+    bool escape(Walk& w, const Point& p, const integer& a, const integer& b) const {
+        w.p = p.dbl().normalized();
+        w.a = add(a, a);
+        w.b = add(b, b);
+        if (w.p.is_infinity()) {
+            return false;
+        }
+        canonical(w);
+        return true;
+    }
+
+    // files a distinguished point; false when the walk has to start again
+    bool report(const Walk& w) {
+        Entry other{w.p.x(), w.a, w.b};
+        {
+            std::lock_guard<std::mutex> guard(this->lock);
+            const auto [it, added] = this->points.emplace(w.hash, other);
+            if (added || it->second.x != other.x) {
+                return true;
+            }
+            other = it->second;
+        }
+        // a walk that met its own trail, or another walk's on the same (a, b)
+        return solve(w.a, w.b, other.a, other.b);
+    }
+
+    void run(std::size_t thread, uint64_t seed) {
+        uint8_t key[ChaCha20Rng::SEED_SIZE] = {0};
+        for (int i = 0; i < 8; i++) {
+            key[i] = static_cast<uint8_t>(seed >> (8 * i));
+            key[8 + i] = static_cast<uint8_t>((thread + 1) >> (8 * i));
+        }
+        ChaCha20Rng rng(key);
+        std::vector<Walk> walks(DLOG_RHO_WALKS, Walk(this->g));
+        for (Walk& w : walks) {
+            restart(w, rng);
+        }
+        const uint64_t distinguished_mask = (uint64_t(1) << this->d) - 1;
+        const uint64_t cap = 20 * (uint64_t(1) << this->d);
+        std::vector<Point> lhs, rhs;
+        std::vector<std::size_t> partition(walks.size());
+        uint64_t local_additions = 0, local_distinguished = 0, local_restarts = 0;
+        while (!this->done) {
+            if (this->additions.load(std::memory_order_relaxed) + local_additions > this->give_up) {
+                break;
+            }
+            lhs.clear();
+            rhs.clear();
+            for (std::size_t i = 0; i < walks.size(); i++) {
+                partition[i] = walks[i].hash % DLOG_RHO_PARTITIONS;
+                lhs.push_back(walks[i].p);
+                rhs.push_back(this->steps[partition[i]]);
+            }
+            Point::batch_add(lhs, rhs, lhs);
+            local_additions += walks.size();
+
+            for (std::size_t i = 0; i < walks.size() && !this->done; i++) {
+                Walk& w = walks[i];
+                const std::size_t k = partition[i];
+                w.before_previous_hash = w.previous_hash;
+                w.previous_hash = w.hash;
+                std::swap(w.previous, w.p);
+                w.previous_a = w.a;
+                w.previous_b = w.b;
+                w.a = add(w.previous_a, this->step_a[k]);
+                w.b = add(w.previous_b, this->step_b[k]);
+                w.p = std::move(lhs[i]);
+                if (w.p.is_infinity()) {
+                    // a + b x = 0
+                    if (!solve(w.a, w.b, 0, 0)) {
+                        restart(w, rng);
+                        local_restarts++;
+                    }
+                    continue;
+                }
+                if (!w.p.is_normalized()) {
+                    w.p = w.p.normalized();
+                }
+                canonical(w);
+                bool escaped = true;
+                if (w.hash == w.before_previous_hash) {
+                    // a 2-cycle, found at once: the commonest by far
+                    escaped = w.previous_hash < w.hash ? escape(w, w.previous, w.previous_a, w.previous_b)
+                                                       : escape(w, w.p, w.a, w.b);
+                    local_additions++;
+                } else {
+                    if (w.hash < w.lowest_hash) {
+                        w.lowest = w.p;
+                        w.lowest_a = w.a;
+                        w.lowest_b = w.b;
+                        w.lowest_hash = w.hash;
+                    }
+                    if (++w.window == CYCLE_WINDOW) {
+                        // back where the window began: a cycle of a length
+                        // dividing it, its smallest point seen
+                        if (w.hash == w.mark) {
+                            escaped = escape(w, w.lowest, w.lowest_a, w.lowest_b);
+                            local_additions++;
+                        }
+                        w.mark = w.hash;
+                        w.window = 0;
+                        w.lowest_hash = UINT64_MAX;
+                    }
+                }
+                if (!escaped) {
+                    restart(w, rng);
+                    local_restarts++;
+                    continue;
+                }
+                if ((w.hash >> 32 & distinguished_mask) == 0) {
+                    local_distinguished++;
+                    w.since_distinguished = 0;
+                    if (!report(w) && !this->done) {
+                        restart(w, rng);
+                        local_restarts++;
+                    }
+                } else if (++w.since_distinguished > cap) {
+                    restart(w, rng);
+                    local_restarts++;
+                }
+            }
+            if (local_additions >= BATCH) {
+                this->additions.fetch_add(local_additions);
+                local_additions = 0;
+            }
+        }
+        this->additions.fetch_add(local_additions);
+        this->distinguished.fetch_add(local_distinguished);
+        this->restarts.fetch_add(local_restarts);
+    }
+};
+
+// a nontrivial factor of composite m with no factor below 1000, by Pollard's
+// rho with Floyd's cycle finding on x^2 + c
+integer split(const integer& m) {
+    for (integer c = 1;; c += 1) {
+        integer x = 2, y = 2, d = 1;
+        while (d == 1) {
+            x = (x * x + c) % m;
+            y = (y * y + c) % m;
+            y = (y * y + c) % m;
+            d = gcd(x - y, m);
+        }
+        if (d != m) {
+            return d;
+        }
+    }
+}
+
+}
+
+Result<integer> dlog_bsgs(const Point& g, const Point& h, const integer& n, DlogStats* stats) {
+    if (n < 1) {
+        throw std::invalid_argument("Group order must be positive");
+    }
+    if (h.is_infinity()) {
+        return integer(0);
+    }
+    const integer m_value = isqrt(n / 2) + 1;
+    if (m_value > integer(DLOG_BSGS_MAX_STEPS)) {
+        throw std::invalid_argument("Group order too large for baby-step giant-step");
+    }
+    const uint64_t m = static_cast<uint64_t>(m_value);
+    const Point base = g.normalized();
+
+    // j g for j = 1, .., m
+    BabySteps table(m);
+    std::vector<Point> batch;
+    Point p(g.curve_a(), g.curve_b());
+    for (uint64_t first = 1; first <= m; first += BATCH) {
+        batch.clear();
+        for (uint64_t j = first; j <= m && j < first + BATCH; j++) {
+            p += base;
+            batch.push_back(p);
+        }
+        Point::batch_normalize(batch);
+        for (std::size_t k = 0; k < batch.size(); k++) {
+            if (!batch[k].is_infinity()) {
+                table.insert(batch[k].x().hash(HASH_SEED), first + k);
+            }
+        }
+    }
+    count(stats, m);
+
+    // h - i s g for s = 2m + 1 and i = 0, .., n / s: x = i s + j or i s - j
+    const integer s = 2 * m_value + 1;
+    const Point stride = (-(base * s)).normalized();
+    const uint64_t giants = static_cast<uint64_t>(n / s) + 1;
+    Point q = h;
+    for (uint64_t first = 0; first < giants; first += BATCH) {
+        batch.clear();
+        for (uint64_t i = first; i < giants && i < first + BATCH; i++) {
+            batch.push_back(q);
+            q += stride;
+        }
+        Point::batch_normalize(batch);
+        count(stats, batch.size());
+        for (std::size_t k = 0; k < batch.size(); k++) {
+            const integer offset = integer(first + k) * s;
+            if (batch[k].is_infinity()) {
+                return mod(offset, n);
+            }
+            std::optional<integer> found;
+            table.find(batch[k].x().hash(HASH_SEED), [&](uint64_t j) {
+                for (const integer& x : {mod(offset + integer(j), n), mod(offset - integer(j), n)}) {
+                    if (!found && base * x == h) {
+                        found = x;
+                    }
+                }
+            });
+            if (found) {
+                return *found;
+            }
+        }
+    }
+    return Status::out_of_range;
+}
+
+Result<integer> dlog_rho(const Point& g, const Point& h, const integer& n, unsigned threads, uint64_t seed,
+                         DlogStats* stats) {
+    if (n < 1) {
+        throw std::invalid_argument("Group order must be positive");
+    }
+    if (n < integer(1 << 16)) {
+        return dlog_bsgs(g, h, n, stats);
+    }
+    if (!is_probable_prime(n)) {
+        return Status::bad_modulus;
+    }
+    if (h.is_infinity()) {
+        return integer(0);
+    }
+    if (!(h * n).is_infinity()) {
+        return Status::out_of_range;
+    }
+
+    RhoSearch search(g, h, n);
+    threads = std::max(threads, 1u);
+    // sqrt(n) steps in all and about 2^8 distinguished points, less what
+    // the walks run on past the collision
+    const std::size_t half = n.bit_length() / 2;
+    std::size_t spare = 4;
+    for (std::size_t w = DLOG_RHO_WALKS * threads; w > 1; w >>= 1) {
+        spare++;
+    }
+    search.d = static_cast<unsigned>(half > spare ? std::min<std::size_t>(half - spare, 24) : 0);
+    search.give_up = 64 * (static_cast<uint64_t>(isqrt(n)) + 1) + (uint64_t(1) << 20);
+
+    uint8_t key[ChaCha20Rng::SEED_SIZE] = {0};
+    for (int i = 0; i < 8; i++) {
+        key[i] = static_cast<uint8_t>(seed >> (8 * i));
+    }
+    ChaCha20Rng rng(key);
+    while (search.steps.size() < DLOG_RHO_PARTITIONS) {
+        const integer a = rng.random_below(n), b = rng.random_below(n);
+        const Point m = Point::mul_add(a, g, b, h);
+        if (!m.is_infinity()) {
+            search.steps.push_back(m);
+            search.step_a.push_back(a);
+            search.step_b.push_back(b);
+        }
+    }
+    Point::batch_normalize(search.steps);
+
+    ThreadExecutor(threads).run(threads, [&](std::size_t t) {
+        search.run(t, seed);
+    });
+    count(stats, search.additions, search.distinguished, search.restarts);
+    if (!search.answer) {
+        return Status::out_of_range;
+    }
+    return *search.answer;
+}
+
+Result<integer> dlog(const Point& g, const Point& h, const integer& n, unsigned threads, DlogStats* stats) {
+    if (n < 1 || !(g * n).is_infinity()) {
+        throw std::invalid_argument("n must be the order of g");
+    }
+    integer x = 0, modulus = 1;
+    for (const auto& [q, e] : factor(n)) {
+        // the digits of x mod q^e in base q, each a log in the subgroup of order q
+        const Point gq = g * (n / q);
+        integer xq = 0, qk = 1;
+        for (std::size_t k = 0; k < e; k++) {
+            const Point hk = (h - g * xq) * (n / (qk * q));
+            const Result<integer> digit = q < (integer(1) << 32) ? dlog_bsgs(gq, hk, q, stats)
+                                                                 : dlog_rho(gq, hk, q, threads, 0, stats);
+            if (!digit) {
+                return digit.status();
+            }
+            xq += *digit * qk;
+            qk *= q;
+        }
+        // x = xq mod q^e, joined to what came before
+        x += modulus * mod((xq - x) * modulus.modinv(qk), qk);
+        modulus *= qk;
+    }
+    if (!(g * x == h)) {
+        return Status::out_of_range;
+    }
+    return x;
+}
+
+std::map<integer, std::size_t> factor(const integer& n) {
+    if (n < 1) {
+        throw std::invalid_argument("Can only factor positive numbers");
+    }
+    std::map<integer, std::size_t> out;
+    integer m = n;
+    for (uint64_t p = 2; p < 1000 && integer(p * p) <= m; p++) {
+        while (m % integer(p) == 0) {
+            out[integer(p)]++;
+            m /= integer(p);
+        }
+    }
+    std::vector<integer> parts;
+    if (m > 1) {
+        parts.push_back(m);
+    }
+    while (!parts.empty()) {
+        const integer part = parts.back();
+        parts.pop_back();
+        if (part < 1000000 || is_probable_prime(part)) {
+            out[part]++;
+            continue;
+        }
+        const integer d = split(part);
+        parts.push_back(d);
+        parts.push_back(part / d);
+    }
+    return out;
+}
@@ -0,0 +1,78 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_DLOG_H
+#define ECC_DLOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+#include "integer.h"
+#include "Point.h"
+#include "Status.h"
+
+// Discrete logarithms in small groups, for test and breakage-analysis
+// tooling: the x in [0, n) with x * g = h, for g of order n on a curve over a
+// small field, up to keys of about 64 bits. Fields of one word run on
+// FieldElement's word-sized path, so these double as a workload for it.
+// Status::out_of_range when h is not a multiple of g; points of different
+// curves throw std::runtime_error, as their sums do. Not constant time.
+
+// what a search did
+struct DlogStats {
+    uint64_t additions = 0;         // point additions: steps of the walks, baby and giant steps
+    uint64_t distinguished = 0;     // distinguished points the rho walks reached
+    uint64_t restarts = 0;          // rho walks begun again, stuck in a cycle or merged with themselves
+};
+
+// the most baby steps dlog_bsgs takes, 2^32: orders up to about 2^65
+constexpr uint64_t DLOG_BSGS_MAX_STEPS = uint64_t(1) << 32;
+
+// baby-step giant-step: m = isqrt(n / 2) + 1 baby steps g, 2g, .., mg, kept
+// as open-addressing slots of 64 bits (the step in the low bits, a
+// fingerprint of its x above), then giant steps h - i(2m + 1)g, each matching
+// the baby step of the same x whether it is +j or -j, so 2m + 1 covers twice
+// the stride of the plain method. Both kinds are normalized in batches with
+// one inversion, and a fingerprint match is confirmed by a multiplication.
+// About 2 sqrt(n / 2) additions and 16 m bytes. Throws std::invalid_argument
+// for n < 1 or more than DLOG_BSGS_MAX_STEPS baby steps
+Result<integer> dlog_bsgs(const Point& g, const Point& h, const integer& n, DlogStats* stats = nullptr);
+
+// walks each thread advances together, their additions batched (Point::batch_add)
+constexpr std::size_t DLOG_RHO_WALKS = 32;
+// the combinations a_k g + b_k h the walks add, one per partition of the points
+constexpr std::size_t DLOG_RHO_PARTITIONS = 32;
+
+// Pollard's rho for prime n with distinguished points (van Oorschot and
+// Wiener): threads threads of DLOG_RHO_WALKS walks each, every step adding
+// the precomputed a_k g + b_k h chosen by a hash of x, and a point whose hash
+// has its top d bits zero is distinguished and shared. Two walks reaching one
+// distinguished point from different (a, b) give x. The negation map keeps
+// the one of P and -P with even y, halving the space to sqrt(pi n / 4) steps
+// in all. The fruitless cycles it makes are left by doubling their point of
+// the smallest hash: 2-cycles as soon as they close, longer ones when a walk
+// is back at the point 48 steps before, and a walk that goes 20 * 2^d steps
+// without a distinguished point starts again. d leaves a few hundred
+// distinguished points per solve; seed fixes the walks. Orders below 2^16 go
+// to dlog_bsgs; Status::bad_modulus for a composite n, Status::out_of_range
+// for h not of order n, or no answer after 64 times the expected steps.
+// Throws std::invalid_argument for n < 1
+Result<integer> dlog_rho(const Point& g, const Point& h, const integer& n, unsigned threads = 1, uint64_t seed = 0,
+                         DlogStats* stats = nullptr);
+
+// Pohlig-Hellman: n factored, and x found modulo every prime power q^e of it
+// one base q digit at a time, each digit a log in the subgroup of order q by
+// dlog_bsgs for q below 2^32 and by dlog_rho above, then the residues joined
+// by the Chinese remainder theorem. n must be the order of g: throws
+// std::invalid_argument when n g is not at infinity or n < 1
+Result<integer> dlog(const Point& g, const Point& h, const integer& n, unsigned threads = 1,
+                     DlogStats* stats = nullptr);
+
+// the prime factorization of n, primes ascending with their exponents: trial
+// division below 1000, then Pollard's rho on what is left until every part
+// passes is_probable_prime. Throws std::invalid_argument for n < 1
+std::map<integer, std::size_t> factor(const integer& n);
+
+#endif //ECC_DLOG_H
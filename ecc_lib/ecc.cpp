@@ -0,0 +1,335 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "bulk.h"
+#include "Curve.h"
+#include "decompress.h"
+#include "ecc.h"
+#include "ecdsa.h"
+#include "Executor.h"
+#include "FieldElement.h"
+#include "FieldVector.h"
+#include "msm.h"
+#include "schnorr.h"
+#include "sec1.h"
+#include "sha256.h"
+#include "tagged_hash.h"
+
+static_assert(static_cast<int>(Status::infinity) == ECC_INFINITY, "ecc_status follows Status");
+static_assert(static_cast<int>(BulkScheme::schnorr) == ECC_SCHNORR, "ecc_scheme follows BulkScheme");
+
+namespace {
+
+// the executor a call's threads argument names
+class CallExecutor {
+public:
+    explicit CallExecutor(unsigned threads)
+            : own(threads), executor(threads == 0 ? static_cast<Executor*>(&WorkStealingPool::shared()) : &own) {}
+    Executor& get() { return *this->executor; }
+
+private:
+    ThreadExecutor own;
+    Executor* executor;
+};
+
+const Curve* find_curve(int curve) {
+    return curve == ECC_SECP256K1 ? &Curve::secp256k1() : curve == ECC_P256 ? &Curve::p256() : nullptr;
+}
+
+bool known_scheme(int scheme) {
+    return scheme >= ECC_ECDSA_SECP256K1 && scheme <= ECC_SCHNORR;
+}
+
+const Curve& ecdsa_curve(int scheme) {
+    return scheme == ECC_ECDSA_P256 ? Curve::p256() : Curve::secp256k1();
+}
+
+// the first status that is not ok, or ok
+int first_failure(const int32_t* results, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++) {
+        if (results[i] != ECC_OK) {
+            return results[i];
+        }
+    }
+    return ECC_OK;
+}
+
+// why the compressed key at key did not decompress
+int key_status(const uint8_t* key, const Curve& curve) {
+    const Result<Point> q = sec1_decode(key, 33, curve);
+    return q ? ECC_NOT_ON_CURVE : static_cast<int>(q.status());
+}
+
+void verify_ecdsa(int scheme, std::size_t count, const uint8_t* keys, const uint8_t* messages, std::size_t len,
+                  const uint8_t* signatures, int32_t* results, Executor& executor) {
+    const Curve& curve = ecdsa_curve(scheme);
+    const DecompressedKeys points = decompress_keys(keys, count, curve, executor);
+    std::vector<EcdsaJob> jobs;
+    std::vector<std::size_t> index;
+    jobs.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+        if (points.valid(i)) {
+            jobs.push_back(EcdsaJob{signatures + i * 64, messages + i * len, len, &points.points[i]});
+            index.push_back(i);
+        } else {
+            results[i] = key_status(keys + i * 33, curve);
+        }
+    }
+    const std::vector<Status> verified = ecdsa_verify_batch(curve, jobs, executor);
+    for (std::size_t j = 0; j < index.size(); j++) {
+        results[index[j]] = static_cast<int32_t>(verified[j]);
+    }
+}
+
+// count elements of the curve's field at in, for the FieldVector batches
+Status load_vector(const Curve& curve, std::size_t count, const uint8_t* in, FieldVector& out) {
+    std::vector<FieldElement> elements;
+    elements.reserve(count);
+    const Status status = FieldElement::deserialize(in, count * FieldElement::wire_size(curve.field()),
+                                                    curve.field(), elements);
+    if (status == Status::ok) {
+        out = FieldVector(curve.field(), elements);
+    }
+    return status;
+}
+
+// out = op(a, b) on FieldVectors, the checks of ecc_field_batch_mul
+template<class Op>
+int field_batch(int curve, std::size_t count, const uint8_t* a, const uint8_t* b, uint8_t* out, Op op) {
+    const Curve* c = find_curve(curve);
+    if (!c || (count && (!a || !b || !out))) {
+        return ECC_OUT_OF_RANGE;
+    }
+    if (count == 0) {
+        return ECC_OK;
+    }
+    try {
+        FieldVector x(c->field(), 0), y(c->field(), 0);
+        Status status = load_vector(*c, count, a, x);
+        if (status == Status::ok) {
+            status = load_vector(*c, count, b, y);
+        }
+        if (status != Status::ok) {
+            return static_cast<int>(status);
+        }
+        op(x, y);
+        return static_cast<int>(FieldElement::serialize(x.elements(), out,
+                                                        count * FieldElement::wire_size(c->field())));
+    } catch (...) {
+        return ECC_INTERNAL;
+    }
+}
+
+}
+
+extern "C" {
+
+int ecc_abi_version(void) {
+    return ECC_ABI_VERSION;
+}
+
+const char* ecc_status_name(int status) {
+    if (status == ECC_INTERNAL) {
+        return "internal";
+    }
+    if (status < ECC_OK || status > ECC_INFINITY) {
+        return "unknown";
+    }
+    return status_name(static_cast<Status>(status));
+}
+
+int ecc_verify_batch(int scheme, size_t count, const uint8_t* keys, const uint8_t* messages, size_t message_len,
+                     const uint8_t* signatures, int32_t* results, unsigned threads) {
+    if (!known_scheme(scheme) || (count && (!keys || !signatures || (message_len && !messages)))) {
+        return ECC_OUT_OF_RANGE;
+    }
+    if (count == 0) {
+        return ECC_OK;
+    }
+    try {
+        CallExecutor executor(threads);
+        if (scheme == ECC_SCHNORR) {
+            std::vector<SchnorrSigned> items(count);
+            for (std::size_t i = 0; i < count; i++) {
+                items[i] = SchnorrSigned{signatures + i * 64, messages + i * message_len, message_len, keys + i * 32};
+            }
+            if (schnorr_verify_batch(items, executor.get()) == Status::ok) {
+                if (results) {
+                    std::fill(results, results + count, ECC_OK);
+                }
+                return ECC_OK;
+            }
+            if (!results) {
+                return ECC_BAD_SIGNATURE;
+            }
+            executor.get().run(count, [&](std::size_t i) {
+                results[i] = static_cast<int32_t>(schnorr_verify(items[i].signature, items[i].message, message_len,
+                                                                 items[i].public_key));
+            });
+            return first_failure(results, count);
+        }
+        std::vector<int32_t> own;
+        if (!results) {
+            own.resize(count);
+            results = own.data();
+        }
+        verify_ecdsa(scheme, count, keys, messages, message_len, signatures, results, executor.get());
+        return first_failure(results, count);
+    } catch (...) {
+        return ECC_INTERNAL;
+    }
+}
+
+int ecc_sign_batch(int scheme, size_t count, const uint8_t* secrets, const uint8_t* messages, size_t message_len,
+                   const uint8_t* aux, uint8_t* signatures, int32_t* results, unsigned threads) {
+    if (!known_scheme(scheme) || (count && (!secrets || !signatures || (message_len && !messages)))) {
+        return ECC_OUT_OF_RANGE;
+    }
+    try {
+        CallExecutor executor(threads);
+        std::vector<int32_t> own;
+        if (!results) {
+            own.resize(count);
+            results = own.data();
+        }
+        executor.get().run(count, [&](std::size_t i) {
+            uint8_t* signature = signatures + i * 64;
+            const uint8_t* message = messages + i * message_len;
+            const Status status = scheme == ECC_SCHNORR
+                                  ? schnorr_sign(signature, message, message_len, secrets + i * 32,
+                                                 aux ? aux + i * 32 : nullptr)
+                                  : ecdsa_sign(signature, ecdsa_curve(scheme), secrets + i * 32, message, message_len);
+            if (status != Status::ok) {
+                std::memset(signature, 0, 64);
+            }
+            results[i] = static_cast<int32_t>(status);
+        });
+        return first_failure(results, count);
+    } catch (...) {
+        return ECC_INTERNAL;
+    }
+}
+
+int ecc_msm(int curve, size_t count, const uint8_t* scalars, const uint8_t* points, uint8_t* out, unsigned threads) {
+    const Curve* c = find_curve(curve);
+    if (!c || !out || (count && (!scalars || !points))) {
+        return ECC_OUT_OF_RANGE;
+    }
+    std::memset(out, 0, 33);
+    if (count == 0) {
+        return ECC_INFINITY;
+    }
+    try {
+        CallExecutor executor(threads);
+        DecompressedKeys lifted = decompress_keys(points, count, *c, executor.get());
+        if (lifted.invalid_count()) {
+            for (std::size_t i = 0; i < count; i++) {
+                if (!lifted.valid(i)) {
+                    return key_status(points + i * 33, *c);
+                }
+            }
+        }
+        std::vector<integer> k;
+        k.reserve(count);
+        for (std::size_t i = 0; i < count; i++) {
+            k.push_back(integer::from_bytes(scalars + i * 32, 32));
+        }
+        const Point sum = multi_scalar_mul(k, lifted.points, executor.get());
+        if (sum.is_infinity()) {
+            return ECC_INFINITY;
+        }
+        return static_cast<int>(sec1_encode(sum, true, out, 33).status());
+    } catch (...) {
+        return ECC_INTERNAL;
+    }
+}
+
+int ecc_field_batch_mul(int curve, size_t count, const uint8_t* a, const uint8_t* b, uint8_t* out,
+                        unsigned threads) {
+    const Curve* c = find_curve(curve);
+    if (!c || (count && (!a || !b || !out))) {
+        return ECC_OUT_OF_RANGE;
+    }
+    try {
+        const PrimeField& field = c->field();
+        const std::size_t size = FieldElement::wire_size(field);
+        std::vector<FieldElement> x, y;
+        x.reserve(count);
+        y.reserve(count);
+        Status status = FieldElement::deserialize(a, count * size, field, x);
+        if (status == Status::ok) {
+            status = FieldElement::deserialize(b, count * size, field, y);
+        }
+        if (status != Status::ok) {
+            return static_cast<int>(status);
+        }
+        CallExecutor executor(threads);
+        const std::size_t chunks = std::min(count, 4 * executor.get().concurrency());
+        executor.get().run(chunks, [&](std::size_t t) {
+            for (std::size_t i = count * t / chunks; i < count * (t + 1) / chunks; i++) {
+                x[i] *= y[i];
+            }
+        });
+        return static_cast<int>(FieldElement::serialize(x, out, count * size));
+    } catch (...) {
+        return ECC_INTERNAL;
+    }
+}
+
+int ecc_field_batch_add(int curve, size_t count, const uint8_t* a, const uint8_t* b, uint8_t* out) {
+    return field_batch(curve, count, a, b, out, [](FieldVector& x, const FieldVector& y) { x += y; });
+}
+
+int ecc_field_batch_sub(int curve, size_t count, const uint8_t* a, const uint8_t* b, uint8_t* out) {
+    return field_batch(curve, count, a, b, out, [](FieldVector& x, const FieldVector& y) { x -= y; });
+}
+
+int ecc_field_batch_inverse(int curve, size_t count, const uint8_t* a, uint8_t* out) {
+    const Curve* c = find_curve(curve);
+    if (!c || (count && (!a || !out))) {
+        return ECC_OUT_OF_RANGE;
+    }
+    if (count == 0) {
+        return ECC_OK;
+    }
+    try {
+        FieldVector x(c->field(), 0);
+        const Status status = load_vector(*c, count, a, x);
+        if (status != Status::ok) {
+            return static_cast<int>(status);
+        }
+        if (!x.zeros().empty()) {
+            return ECC_NOT_INVERTIBLE;
+        }
+        return static_cast<int>(FieldElement::serialize(x.inverse().elements(), out,
+                                                        count * FieldElement::wire_size(c->field())));
+    } catch (...) {
+        return ECC_INTERNAL;
+    }
+}
+
+int ecc_sha256_batch(size_t count, const uint8_t* in, size_t len, uint8_t* out) {
+    if (count && ((len && !in) || !out)) {
+        return ECC_OUT_OF_RANGE;
+    }
+    sha256_many(out, in, len, count);
+    return ECC_OK;
+}
+
+int ecc_tagged_hash_batch(const uint8_t* tag, size_t tag_len, size_t count, const uint8_t* in, size_t len,
+                          uint8_t* out) {
+    if ((tag_len && !tag) || (count && ((len && !in) || !out))) {
+        return ECC_OUT_OF_RANGE;
+    }
+    const Sha256Tag key(tag, tag_len);
+    for (std::size_t i = 0; i < count; i++) {
+        TaggedHash(key).update(in + i * len, len).finish(out + i * 32);
+    }
+    return ECC_OK;
+}
+
+}
@@ -0,0 +1,131 @@
+/*
+ * Created by preston on 10/15/2026.
+ */
+
+#ifndef ECC_ECC_H
+#define ECC_ECC_H
+
+/*
+ * The C ABI of the library, for callers in other languages (Go through cgo,
+ * Rust through bindgen, JavaScript through the ecc_wasm module) and the
+ * ecc_shared library. Every entry point takes a whole batch as flat arrays of
+ * fixed-width encodings, so one foreign call does as much work as the caller
+ * has, and no C++ type crosses it:
+ *
+ *     secrets, scalars   32 bytes, big-endian
+ *     public keys        33-byte SEC 1 compressed (ECDSA, points), 32-byte x-only (BIP340)
+ *     signatures         64 bytes, r || s (ECDSA) or BIP340
+ *     field elements     32 bytes, little-endian: FieldElement's wire format
+ *
+ * Functions return an ecc_status and never throw. threads is 0 for the
+ * library's shared work-stealing pool, 1 for the calling thread alone, or n
+ * for n threads of the call's own.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32) && defined(ECC_SHARED_BUILD)
+#define ECC_API __declspec(dllexport)
+#elif defined(__EMSCRIPTEN__)
+/* Emscripten exports what is marked used, as EMSCRIPTEN_KEEPALIVE does */
+#define ECC_API __attribute__((used, visibility("default")))
+#elif defined(__GNUC__)
+#define ECC_API __attribute__((visibility("default")))
+#else
+#define ECC_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ECC_ABI_VERSION 1
+
+/* the values of the C++ Status, and ecc_internal for anything thrown inside
+ * (out of memory); ecc_out_of_range also for an unknown scheme or curve */
+typedef enum {
+    ECC_OK = 0,
+    ECC_OUT_OF_RANGE = 1,
+    ECC_NOT_ON_CURVE = 2,
+    ECC_BAD_ENCODING = 3,
+    ECC_BUFFER_TOO_SMALL = 4,
+    ECC_BAD_SIGNATURE = 5,
+    ECC_FIELD_MISMATCH = 6,
+    ECC_BAD_DIGIT = 7,
+    ECC_BAD_BASE = 8,
+    ECC_DIVISION_BY_ZERO = 9,
+    ECC_BAD_MODULUS = 10,
+    ECC_NOT_INVERTIBLE = 11,
+    ECC_NOT_A_SQUARE = 12,
+    ECC_INFINITY = 13,
+    ECC_INTERNAL = 100
+} ecc_status;
+
+/* the schemes of the bulk file format */
+typedef enum {
+    ECC_ECDSA_SECP256K1 = 1,
+    ECC_ECDSA_P256 = 2,
+    ECC_SCHNORR = 3
+} ecc_scheme;
+
+typedef enum {
+    ECC_SECP256K1 = 1,
+    ECC_P256 = 2
+} ecc_curve;
+
+/* ECC_ABI_VERSION of the library loaded, to check against the header's */
+ECC_API int ecc_abi_version(void);
+/* the name of status, such as "bad_signature" */
+ECC_API const char* ecc_status_name(int status);
+
+/* Verifies item i: keys[i * key size], messages[i * message_len] (the hash
+ * for ECDSA) and signatures[i * 64], for i < count. With results, results[i]
+ * is the status of item i; without, BIP340 batches are checked by one batch
+ * equation. ECC_OK if every item verifies, else the status of the first that
+ * does not (ECC_BAD_SIGNATURE for such a BIP340 batch) */
+ECC_API int ecc_verify_batch(int scheme, size_t count, const uint8_t* keys, const uint8_t* messages,
+                             size_t message_len, const uint8_t* signatures, int32_t* results, unsigned threads);
+
+/* signatures[i * 64] of messages[i * message_len] under secrets[i * 32], with
+ * aux[i * 32] as BIP340's auxiliary randomness (null for zeros; ignored by the
+ * deterministic ECDSA). results as above; a failed item's signature is zeros */
+ECC_API int ecc_sign_batch(int scheme, size_t count, const uint8_t* secrets, const uint8_t* messages,
+                           size_t message_len, const uint8_t* aux, uint8_t* signatures, int32_t* results,
+                           unsigned threads);
+
+/* sum of scalars[i * 32] * points[i * 33] into out[33], compressed; out is
+ * zeros and the status ECC_INFINITY when the sum is the point at infinity, and
+ * ECC_NOT_ON_CURVE or ECC_BAD_ENCODING when a point does not decode */
+ECC_API int ecc_msm(int curve, size_t count, const uint8_t* scalars, const uint8_t* points, uint8_t* out,
+                    unsigned threads);
+
+/* out[i] = a[i] * b[i] in the curve's base field, count elements of 32 bytes
+ * each; ECC_OUT_OF_RANGE, with nothing written, if any input is not below the
+ * prime. out may be a or b */
+ECC_API int ecc_field_batch_mul(int curve, size_t count, const uint8_t* a, const uint8_t* b, uint8_t* out,
+                                unsigned threads);
+
+/* out[i] = a[i] + b[i] and a[i] - b[i], as ecc_field_batch_mul, on the
+ * structure-of-arrays FieldVector: memory bound, so on the calling thread */
+ECC_API int ecc_field_batch_add(int curve, size_t count, const uint8_t* a, const uint8_t* b, uint8_t* out);
+ECC_API int ecc_field_batch_sub(int curve, size_t count, const uint8_t* a, const uint8_t* b, uint8_t* out);
+
+/* out[i] = 1 / a[i] with one field inversion for the batch (Montgomery's
+ * trick); ECC_NOT_INVERTIBLE, with nothing written, if any a[i] is zero */
+ECC_API int ecc_field_batch_inverse(int curve, size_t count, const uint8_t* a, uint8_t* out);
+
+/* out[i * 32] = SHA-256 of in[i * len, (i + 1) * len), count messages of one
+ * length side by side in the widest multi-buffer kernel the CPU runs */
+ECC_API int ecc_sha256_batch(size_t count, const uint8_t* in, size_t len, uint8_t* out);
+
+/* the same for the BIP340 tagged hash under tag[0, tag_len), every message
+ * started from the tag's midstate */
+ECC_API int ecc_tagged_hash_batch(const uint8_t* tag, size_t tag_len, size_t count, const uint8_t* in, size_t len,
+                                  uint8_t* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ECC_ECC_H */
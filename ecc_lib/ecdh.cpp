@@ -0,0 +1,155 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <cstring>
+
+#include "ecdh.h"
+#include "FieldVector.h"
+#include "Point.h"
+
+namespace {
+
+// the secret in k, Status::out_of_range where it is not in [1, n)
+Status read_secret(integer& k, const Curve& curve, const uint8_t* secret) {
+    k = integer::from_bytes(secret, ecdh_secret_size(curve));
+    return k == 0 || k >= curve.n() ? Status::out_of_range : Status::ok;
+}
+
+// x of the SEC 1 key in[0, len); the twist is left to the ladder
+Result<FieldElement> read_x(const Curve& curve, const uint8_t* in, std::size_t len) {
+    const std::size_t l = ecdh_shared_size(curve);
+    const bool compressed = len == 1 + l && (in[0] == 2 || in[0] == 3);
+    if (!compressed && !(len == 1 + 2 * l && in[0] == 4)) {
+        return Status::bad_encoding;
+    }
+    Result<FieldElement> x = FieldElement::from_bytes(in + 1, l, curve.field());
+    if (!x || compressed) {
+        return x;
+    }
+    const Result<FieldElement> y = FieldElement::from_bytes(in + 1 + l, l, curve.field());
+    if (!y) {
+        return y.status();
+    }
+    if (y->square() != (x->square() + curve.a()) * *x + curve.b()) {
+        return Status::not_on_curve;
+    }
+    return x;
+}
+
+FieldVector broadcast(const FieldElement& value, std::size_t count) {
+    return FieldVector(value.prime_field(), std::vector<FieldElement>(count, value));
+}
+
+}
+
+Status ecdh(uint8_t* shared, const Curve& curve, const uint8_t* secret, const uint8_t* public_key,
+            std::size_t len) noexcept {
+    integer k;
+    const Status secret_status = read_secret(k, curve, secret);
+    if (secret_status != Status::ok) {
+        return secret_status;
+    }
+    const Result<FieldElement> x = read_x(curve, public_key, len);
+    if (!x) {
+        return x.status();
+    }
+    const Result<FieldElement> s = Point::mul_x(k, *x, curve.a(), curve.b());
+    if (!s) {
+        return s.status();
+    }
+    s->to_bytes(shared, ecdh_shared_size(curve));
+    return Status::ok;
+}
+
+std::vector<Status> ecdh_batch(uint8_t* shared, const Curve& curve, const std::vector<EcdhJob>& jobs) {
+    const std::size_t count = jobs.size();
+    const std::size_t size = ecdh_shared_size(curve);
+    std::vector<Status> results(count, Status::ok);
+    if (!curve.field().fixed()) {
+        for (std::size_t i = 0; i < count; i++) {
+            results[i] = ecdh(shared + i * size, curve, jobs[i].secret, jobs[i].public_key, jobs[i].length);
+        }
+        return results;
+    }
+
+    // a job that fails its checks runs as 1 * G and its result is dropped
+    const PrimeField& field = curve.field();
+    const FieldElement gx = curve.generator().x();
+    std::vector<integer> k(count, integer(1));
+    std::vector<FieldElement> x(count, gx);
+    for (std::size_t i = 0; i < count; i++) {
+        integer secret;
+        const Status secret_status = read_secret(secret, curve, jobs[i].secret);
+        Result<FieldElement> xi = read_x(curve, jobs[i].public_key, jobs[i].length);
+        if (xi && !((xi->square() + curve.a()) * *xi + curve.b()).is_square()) {
+            xi = Status::not_on_curve;
+        }
+        results[i] = secret_status != Status::ok ? secret_status : xi.status();
+        if (results[i] == Status::ok) {
+            k[i] = secret;
+            x[i] = *xi;
+        }
+    }
+
+    // the ladder of Point::mul_x on every job at once: r1 - r0 = P in each lane
+    const FieldVector xs(field, x);
+    const bool a_zero = curve.a().is_zero();
+    const FieldVector a = broadcast(curve.a(), count), b = broadcast(curve.b(), count);
+    const FieldVector b4 = (b + b) + (b + b);
+    const FieldVector b8 = b4 + b4;
+    FieldVector x0 = broadcast(FieldElement(1, field), count), z0(field, count);
+    FieldVector x1 = xs, z1 = x0;
+    std::vector<limb_t> masks(count);
+    std::vector<uint8_t> swapped(count, 0);
+    for (std::size_t bit = curve.scalar_field().bits(); bit > 0; bit--) {
+        for (std::size_t i = 0; i < count; i++) {
+            const bool set = k[i].test_bit(bit - 1);
+            masks[i] = 0 - static_cast<limb_t>(set ^ swapped[i]);
+            swapped[i] = set;
+        }
+        const FieldVector tx = FieldVector::select(masks, x1, x0), tz = FieldVector::select(masks, z1, z0);
+        const FieldVector ux = FieldVector::select(masks, x0, x1), uz = FieldVector::select(masks, z0, z1);
+
+        // xonly_add of Point.cpp on (t, u), then xonly_dbl of t
+        const FieldVector xx = tx * ux, zz = tz * uz;
+        const FieldVector xz = tx * uz, zx = ux * tz;
+        FieldVector t = a_zero ? xx : xx + a * zz;
+        t *= xz + zx;
+        const FieldVector d = (xz - zx).square();
+        x1 = t + t + b4 * zz.square() - xs * d;
+        z1 = d;
+
+        const FieldVector txx = tx.square(), tzz = tz.square();
+        const FieldVector azz = a_zero ? FieldVector(field, count) : a * tzz;
+        const FieldVector tzzz = tzz * tz;
+        FieldVector z = (tx * (txx + azz) + b * tzzz) * tz;
+        z += z;
+        z += z;
+        x0 = (txx - azz).square() - b8 * (tx * tzzz);
+        z0 = z;
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        masks[i] = 0 - static_cast<limb_t>(swapped[i]);
+    }
+    const FieldVector rx = FieldVector::select(masks, x1, x0);
+    FieldVector rz = FieldVector::select(masks, z1, z0);
+
+    // Z = 0 only at infinity, which a valid job does not reach; it is set to 1
+    // for the shared inversion and the job failed
+    const FieldElement one(1, field);
+    for (std::size_t i = 0; i < count; i++) {
+        if (rz.get(i).is_zero()) {
+            rz.set(i, one);
+            if (results[i] == Status::ok) {
+                results[i] = Status::infinity;
+            }
+        }
+    }
+    const FieldVector out = rx * rz.inverse();
+    for (std::size_t i = 0; i < count; i++) {
+        if (results[i] == Status::ok) {
+            out.get(i).to_bytes(shared + i * size, size);
+        }
+    }
+    return results;
+}
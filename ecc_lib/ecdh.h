@@ -0,0 +1,52 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_ECDH_H
+#define ECC_ECDH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Curve.h"
+#include "Status.h"
+
+// The Diffie-Hellman primitive of SEC 1 (version 2, section 3.3.1): the affine
+// x of secret * Q, in the big-endian bytes of the field, from a secret of the
+// order's bytes in [1, n) and a peer key Q in any SEC 1 encoding. Only x is
+// used, so the product is the x-only Montgomery ladder of Point::mul_x, which
+// takes the same steps for every secret and rejects an x of the quadratic
+// twist. The curves are of cofactor 1, so secret * Q is never at infinity for
+// a valid Q.
+
+// bytes of a secret and of a shared secret on curve
+inline std::size_t ecdh_secret_size(const Curve& curve) {
+    return (curve.scalar_field().bits() + 7) / 8;
+}
+inline std::size_t ecdh_shared_size(const Curve& curve) {
+    return (curve.field().bits() + 7) / 8;
+}
+
+// Status::ok with the shared secret in shared[0, ecdh_shared_size(curve)),
+// Status::out_of_range for a secret not in [1, n) or a coordinate not below p,
+// Status::bad_encoding for a key that is not compressed or uncompressed SEC 1,
+// Status::not_on_curve for an uncompressed key off the curve or an x with no y
+Status ecdh(uint8_t* shared, const Curve& curve, const uint8_t* secret, const uint8_t* public_key,
+            std::size_t len) noexcept;
+
+struct EcdhJob {
+    const uint8_t* secret;
+    const uint8_t* public_key;
+    std::size_t length;
+};
+
+// ecdh of every job, results[i] for jobs[i] with its shared secret at
+// shared + i * ecdh_shared_size(curve). The ladders run side by side, every
+// coordinate of every job in one FieldVector, so each step is one vector
+// operation across all of the jobs and the final divisions share one
+// inversion; each job's swaps are masked as in Point::mul_x. Fields above 256
+// bits go job by job
+std::vector<Status> ecdh_batch(uint8_t* shared, const Curve& curve, const std::vector<EcdhJob>& jobs);
+
+#endif //ECC_ECDH_H
@@ -0,0 +1,403 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <algorithm>
+#include <functional>
+
+#include "decompress.h"
+#include "ecdsa.h"
+#include "IntegerArena.h"
+#include "metrics.h"
+#include "sec1.h"
+#include "trace.h"
+
+namespace {
+
+bool in_range(const uint256& v, const PrimeField& order) {
+    return !v.is_zero() && v < order.fixed_prime();
+}
+
+// bits2int of RFC 6979, section 2.3.2: the leftmost bits of n of in[0, len)
+uint256 bits2int(const uint8_t* in, std::size_t len, const PrimeField& order) {
+    const std::size_t qlen = order.bits();
+    const std::size_t take = std::min(len, (qlen + 7) / 8);
+    uint256 out(0);
+    for (std::size_t i = 0; i < take; i++) {
+        out.limb[i / 8] |= static_cast<limb_t>(in[take - 1 - i]) << (8 * (i % 8));
+    }
+    return 8 * take > qlen ? out >> (8 * take - qlen) : out;
+}
+
+// below 2^(bits of n) < 2n, so one subtraction of n leaves it reduced
+Scalar hash_scalar(const uint8_t* hash, std::size_t len, const PrimeField& order) {
+    uint256 e = bits2int(hash, len, order);
+    if (!(e < order.fixed_prime())) {
+        e -= order.fixed_prime();
+    }
+    return Scalar(e.to_integer(), order);
+}
+
+// the secret as a uint256 when the curve can sign with it; Status::out_of_range else
+Result<uint256> read_secret(const Curve& curve, const uint8_t* secret) {
+    const PrimeField& order = curve.scalar_field();
+    if (!order.fixed()) {
+        return Status::out_of_range;
+    }
+    const uint256 d = uint256::load_be(secret, 32);
+    if (!in_range(d, order)) {
+        return Status::out_of_range;
+    }
+    return d;
+}
+
+uint256 checked_secret(const Curve& curve, const uint8_t* secret) {
+    const Result<uint256> d = read_secret(curve, secret);
+    if (!d) {
+        throw_status(d.status(), "Secret key is out of range");
+    }
+    return *d;
+}
+
+// whether R is lifted from 33 bytes and n fits a Scalar
+bool can_recover(const Curve& curve) {
+    return curve.scalar_field().fixed() && curve.field().fixed() && curve.field().bits() <= 256;
+}
+
+// the compressed encoding of the R that recid names in key[0, 33), on a curve
+// that can_recover
+Status recovery_key(uint8_t* key, const uint8_t* signature, const Curve& curve, int recid) {
+    const PrimeField& order = curve.scalar_field();
+    uint256 x = uint256::load_be(signature, 32);
+    if (!in_range(x, order) || !in_range(uint256::load_be(signature + 32, 32), order) || recid < 0 || recid > 3) {
+        return Status::bad_encoding;
+    }
+    if ((recid & 2) && uint256::add(x, x, order.fixed_prime())) {
+        return Status::bad_signature;
+    }
+    if (!(x < curve.field().fixed_prime())) {
+        return Status::bad_signature;
+    }
+    key[0] = static_cast<uint8_t>(0x02 | (recid & 1));
+    x.store_be(key + 1, 32);
+    return Status::ok;
+}
+
+// ecdsa_verify with R = u1 * G + u2 * Q from combine(u1, u2), and 1 / s
+// from s_inverse when not null
+template <typename Combine>
+Status verify_with(const uint8_t* signature, const Curve& curve, const Point& public_key, const uint8_t* hash,
+                   std::size_t len, const Scalar* s_inverse, Combine combine) {
+    static Histogram& latency = Metrics::global().histogram("ecc_ecdsa_verify_seconds", "ECDSA signatures verified");
+    HistogramTimer timer(latency);
+    const PrimeField& order = curve.scalar_field();
+    if (!order.fixed()) {
+        return Status::out_of_range;
+    }
+    const uint256 r_value = uint256::load_be(signature, 32), s_value = uint256::load_be(signature + 32, 32);
+    if (!in_range(r_value, order) || !in_range(s_value, order)) {
+        return Status::bad_encoding;
+    }
+    if (public_key.curve_a() != curve.a() || public_key.curve_b() != curve.b()) {
+        return Status::not_on_curve;
+    }
+    if (public_key.is_infinity()) {
+        return Status::infinity;
+    }
+
+    const Scalar r(r_value.to_integer(), order);
+    const Scalar w = s_inverse ? *s_inverse : Scalar(s_value.to_integer(), order).inverse();
+    const Scalar u1 = hash_scalar(hash, len, order) * w;
+    const Scalar u2 = r * w;
+    const Point R = combine(u1, u2);
+
+    // x(R) mod n = r for x(R) = r or r + n, whichever are below p
+    for (integer x = r.value(); x < curve.p(); x += curve.n()) {
+        if (R.has_x(FieldElement(x, curve.field()))) {
+            return Status::ok;
+        }
+    }
+    return Status::bad_signature;
+}
+
+// u1 * G + u2 * R for u1 = -e / r and u2 = s / r
+Result<Point> recovered_key(const uint8_t* signature, const Curve& curve, const Scalar& r_inverse,
+                            const uint8_t* hash, std::size_t len, const Point& R) {
+    const PrimeField& order = curve.scalar_field();
+    const Scalar s = Scalar::from_bytes(signature + 32, 32, order);
+    const Scalar u1 = -(hash_scalar(hash, len, order) * r_inverse);
+    const Scalar u2 = s * r_inverse;
+    const Point q = Point::mul_add(u1.value(), curve.generator_table(), u2.value(), R);
+    if (q.is_infinity()) {
+        return Status::infinity;
+    }
+    return q;
+}
+
+// task(first, last) on contiguous chunks of [0, count), four a worker and
+// none so short that the task overhead shows, each with an IntegerArena
+void run_chunks(std::size_t count, const msm_executor& executor, std::size_t parallelism,
+                const std::function<void(std::size_t, std::size_t)>& task) {
+    static constexpr std::size_t MIN_CHUNK = 16;
+    const std::size_t chunks = std::max<std::size_t>(
+            1, std::min(4 * std::max<std::size_t>(parallelism, 1), count / MIN_CHUNK));
+    const std::size_t size = (count + chunks - 1) / chunks;
+    msm_run_tasks(executor, chunks, [&](std::size_t t) {
+        IntegerArena arena;
+        task(std::min(count, t * size), std::min(count, (t + 1) * size));
+    });
+}
+
+Rfc6979 key_nonces(const uint256& d, const PrimeField& order) {
+    const std::size_t rlen = (order.bits() + 7) / 8;
+    uint8_t x[32];
+    d.store_be(x, rlen);
+    return Rfc6979(x, rlen);
+}
+
+}
+
+Result<Point> ecdsa_public_key(const Curve& curve, const uint8_t* secret) noexcept {
+    const Result<uint256> d = read_secret(curve, secret);
+    if (!d) {
+        return d.status();
+    }
+    return curve.mul_base_ct(d->to_integer());
+}
+
+Status ecdsa_sign(uint8_t* signature, const Curve& curve, const uint8_t* secret, const uint8_t* hash,
+                  std::size_t len) noexcept {
+    const Result<EcdsaSigner> signer = EcdsaSigner::make(curve, secret);
+    if (!signer) {
+        return signer.status();
+    }
+    return signer->sign(signature, hash, len);
+}
+
+EcdsaSigner::EcdsaSigner(const Curve& curve, const uint256& d)
+        : curve(&curve), d(d.to_integer(), curve.scalar_field()), nonces(key_nonces(d, curve.scalar_field())) {}
+
+EcdsaSigner::EcdsaSigner(const Curve& curve, const uint8_t* secret)
+        : EcdsaSigner(curve, checked_secret(curve, secret)) {}
+
+Result<EcdsaSigner> EcdsaSigner::make(const Curve& curve, const uint8_t* secret) noexcept {
+    const Result<uint256> d = read_secret(curve, secret);
+    if (!d) {
+        return d.status();
+    }
+    return EcdsaSigner(curve, *d);
+}
+
+Status EcdsaSigner::sign(uint8_t* signature, const uint8_t* hash, std::size_t len) const noexcept {
+    static Histogram& latency = Metrics::global().histogram("ecc_ecdsa_sign_seconds", "ECDSA signatures made");
+    HistogramTimer timer(latency);
+    const PrimeField& order = this->curve->scalar_field();
+    const Scalar e = hash_scalar(hash, len, order);
+    const std::size_t rlen = (order.bits() + 7) / 8;
+    uint8_t h1[32];
+    e.to_uint256().store_be(h1, rlen);
+    Rfc6979::Drbg nonces = this->nonces.drbg(h1);
+    for (;;) {
+        const uint256 k_value = bits2int(nonces.next(), 32, order);
+        if (!in_range(k_value, order)) {
+            continue;
+        }
+        const Scalar k(k_value.to_integer(), order);
+        const Point R = this->curve->mul_base_ct(k_value.to_integer());
+        const Scalar r(R.x().value(), order);
+        if (r.is_zero()) {
+            continue;
+        }
+        const Scalar s = k.inverse() * (e + r * this->d);
+        if (s.is_zero()) {
+            continue;
+        }
+        r.to_bytes(signature);
+        s.to_bytes(signature + 32);
+        return Status::ok;
+    }
+}
+
+std::vector<Status> ecdsa_sign_batch(const Curve& curve, const std::vector<EcdsaSignJob>& jobs,
+                                     const msm_executor& executor, std::size_t parallelism) {
+    ECC_TRACE_SPAN("ecdsa.sign_batch");
+    static Histogram& latency = Metrics::global().histogram("ecc_ecdsa_sign_batch_seconds", "ecdsa_sign_batch calls");
+    HistogramTimer timer(latency);
+    std::vector<Status> results(jobs.size(), Status::ok);
+    const PrimeField& order = curve.scalar_field();
+    const std::size_t rlen = (order.bits() + 7) / 8;
+    run_chunks(jobs.size(), executor, parallelism, [&](std::size_t first, std::size_t last) {
+        ECC_TRACE_SPAN("ecdsa.sign");
+        // the chunk's jobs on this curve, their e and h1 = int2octets(e)
+        std::vector<std::size_t> index;
+        std::vector<const Rfc6979*> keys;
+        std::vector<Scalar> e;
+        std::vector<uint8_t> h1;
+        for (std::size_t i = first; i < last; i++) {
+            const EcdsaSignJob& job = jobs[i];
+            if (job.signer->curve != &curve) {
+                results[i] = Status::not_on_curve;
+                continue;
+            }
+            index.push_back(i);
+            keys.push_back(&job.signer->nonces);
+            e.push_back(hash_scalar(job.hash, job.length, order));
+            h1.resize(32 * index.size());
+            e.back().to_uint256().store_be(h1.data() + 32 * (index.size() - 1), rlen);
+        }
+        const std::size_t count = index.size();
+        std::vector<uint8_t> candidates(32 * count);
+        Rfc6979::first_candidates(candidates.data(), keys.data(), h1.data(), count);
+
+        // k and k * G, zero and infinity for a candidate out of range
+        std::vector<Scalar> k;
+        std::vector<Point> R;
+        k.reserve(count);
+        R.reserve(count);
+        for (std::size_t j = 0; j < count; j++) {
+            const uint256 k_value = bits2int(candidates.data() + 32 * j, 32, order);
+            if (in_range(k_value, order)) {
+                k.emplace_back(k_value.to_integer(), order);
+                R.push_back(curve.mul_base_ct(k_value.to_integer()));
+            } else {
+                k.emplace_back(order);
+                R.push_back(curve.infinity());
+            }
+        }
+        Point::batch_normalize(R);
+        std::vector<Scalar> k_inverse = k;
+        Scalar::batch_invert(k_inverse);
+
+        for (std::size_t j = 0; j < count; j++) {
+            const EcdsaSignJob& job = jobs[index[j]];
+            if (!k[j].is_zero()) {
+                const Scalar r(R[j].x().value(), order);
+                const Scalar s = k_inverse[j] * (e[j] + r * job.signer->d);
+                if (!r.is_zero() && !s.is_zero()) {
+                    r.to_bytes(job.signature);
+                    s.to_bytes(job.signature + 32);
+                    continue;
+                }
+            }
+            results[index[j]] = job.signer->sign(job.signature, job.hash, job.length);
+        }
+    });
+    return results;
+}
+
+Status ecdsa_verify(const uint8_t* signature, const Curve& curve, const Point& public_key, const uint8_t* hash,
+                    std::size_t len) noexcept {
+    return verify_with(signature, curve, public_key, hash, len, nullptr, [&](const Scalar& u1, const Scalar& u2) {
+        return Point::mul_add(u1.value(), curve.generator(), u2.value(), public_key);
+    });
+}
+
+Status ecdsa_verify(const uint8_t* signature, const Curve& curve, const WnafTable& public_key, const uint8_t* hash,
+                    std::size_t len) noexcept {
+    return verify_with(signature, curve, public_key.base(), hash, len, nullptr,
+                       [&](const Scalar& u1, const Scalar& u2) {
+        return Point::mul_add(u1.value(), curve.generator_wnaf(), u2.value(), public_key);
+    });
+}
+
+std::vector<Status> ecdsa_verify_batch(const Curve& curve, const std::vector<EcdsaJob>& jobs,
+                                       const msm_executor& executor, std::size_t parallelism) {
+    ECC_TRACE_SPAN("ecdsa.batch");
+    static Histogram& latency = Metrics::global().histogram("ecc_ecdsa_verify_batch_seconds",
+                                                            "ecdsa_verify_batch calls");
+    HistogramTimer timer(latency);
+    std::vector<Status> results(jobs.size(), Status::bad_signature);
+    const PrimeField& order = curve.scalar_field();
+    if (!order.fixed()) {
+        std::fill(results.begin(), results.end(), Status::out_of_range);
+        return results;
+    }
+    // 1 / s for the whole batch with one inversion; an s out of [1, n) goes
+    // in as zero, which batch_invert passes over, and its job fails its
+    // range check without reading it
+    std::vector<Scalar> w;
+    w.reserve(jobs.size());
+    for (const EcdsaJob& job : jobs) {
+        const uint256 s = uint256::load_be(job.signature + 32, 32);
+        w.push_back(in_range(s, order) ? Scalar(s.to_integer(), order) : Scalar(order));
+    }
+    Scalar::batch_invert(w);
+    run_chunks(jobs.size(), executor, parallelism, [&](std::size_t first, std::size_t last) {
+        ECC_TRACE_SPAN("ecdsa.verify");
+        for (std::size_t i = first; i < last; i++) {
+            const EcdsaJob& job = jobs[i];
+            const Point& q = *job.public_key;
+            results[i] = verify_with(job.signature, curve, q, job.hash, job.length, &w[i],
+                                     [&](const Scalar& u1, const Scalar& u2) {
+                return Point::mul_add(u1.value(), curve.generator(), u2.value(), q);
+            });
+        }
+    });
+    return results;
+}
+
+Result<Point> ecdsa_recover(const uint8_t* signature, const Curve& curve, int recid, const uint8_t* hash,
+                            std::size_t len) noexcept {
+    if (!can_recover(curve)) {
+        return Status::out_of_range;
+    }
+    uint8_t key[33];
+    const Status lifted = recovery_key(key, signature, curve, recid);
+    if (lifted != Status::ok) {
+        return lifted;
+    }
+    const Result<Point> R = sec1_decode(key, sizeof(key), curve);
+    if (!R) {
+        return Status::bad_signature;
+    }
+    const Scalar r = Scalar::from_bytes(signature, 32, curve.scalar_field());
+    return recovered_key(signature, curve, r.inverse(), hash, len, *R);
+}
+
+std::vector<Result<Point>> ecdsa_recover_batch(const Curve& curve, const std::vector<EcdsaRecoveryJob>& jobs,
+                                               const msm_executor& executor, std::size_t parallelism) {
+    const std::size_t count = jobs.size();
+    std::vector<Result<Point>> results(count, can_recover(curve) ? Status::bad_signature : Status::out_of_range);
+    if (count == 0 || !can_recover(curve)) {
+        return results;
+    }
+    // a job that fails here is lifted as the key 0x02 || 0 .., marked invalid
+    // by decompress_keys and left out of everything after
+    std::vector<uint8_t> keys(count * 33, 0);
+    for (std::size_t i = 0; i < count; i++) {
+        const Status lifted = recovery_key(keys.data() + i * 33, jobs[i].signature, curve, jobs[i].recid);
+        if (lifted != Status::ok) {
+            results[i] = lifted;
+            keys[i * 33] = 0x00;
+        }
+    }
+    const DecompressedKeys R = decompress_keys(keys.data(), count, curve, executor, parallelism);
+
+    // 1 / r for every lifted job, with one inversion
+    const PrimeField& order = curve.scalar_field();
+    std::vector<Scalar> r_inverse;
+    r_inverse.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+        r_inverse.push_back(R.valid(i) ? Scalar::from_bytes(jobs[i].signature, 32, order) : Scalar(order));
+    }
+    Scalar::batch_invert(r_inverse);
+
+    std::vector<Point> keys_out(count, curve.infinity());
+    run_chunks(count, executor, parallelism, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; i++) {
+            if (R.valid(i)) {
+                const EcdsaRecoveryJob& job = jobs[i];
+                results[i] = recovered_key(job.signature, curve, r_inverse[i], job.hash, job.length, R.points[i]);
+                if (results[i]) {
+                    keys_out[i] = *results[i];
+                }
+            }
+        }
+    });
+    Point::batch_normalize(keys_out);
+    for (std::size_t i = 0; i < count; i++) {
+        if (results[i]) {
+            results[i] = keys_out[i];
+        }
+    }
+    return results;
+}
@@ -0,0 +1,167 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_ECDSA_H
+#define ECC_ECDSA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Curve.h"
+#include "msm.h"
+#include "Point.h"
+#include "rfc6979.h"
+#include "Scalar.h"
+#include "Status.h"
+
+// ECDSA of SEC 1 (version 2, section 4.1) on curves whose order n fits in 256
+// bits, secp256k1 and P-256; the others give Status::out_of_range. Secret keys
+// are 32 big-endian bytes in [1, n), signatures r then s in 32 big-endian bytes
+// each, and hash is the digest of the message, of any length, of which the
+// leftmost bits of n are used (bits2int of RFC 6979). The arithmetic mod n is
+// Scalar's.
+
+// secret * G, by FixedBaseTable::mul_ct; Status::out_of_range for a secret not in [1, n)
+Result<Point> ecdsa_public_key(const Curve& curve, const uint8_t* secret) noexcept;
+
+// the signature of hash under secret, with the deterministic nonce of RFC 6979
+// drawn from HMAC_DRBG on SHA-256 whatever hash the digest came from (the RFC's
+// SHA-256 vectors when it is SHA-256). k * G takes FixedBaseTable::mul_ct on the
+// curve's generator table, so the steps do not depend on the nonce. An
+// EcdsaSigner made once does the same for many hashes without the per-key work.
+// Status::out_of_range for a secret not in [1, n)
+Status ecdsa_sign(uint8_t* signature, const Curve& curve, const uint8_t* secret, const uint8_t* hash,
+                  std::size_t len) noexcept;
+
+struct EcdsaSignJob;
+
+// ecdsa_sign under one secret key, with what depends only on the key done when
+// it is made: the checked secret as a Scalar and the HMAC midstates of
+// Rfc6979, so each signature starts its nonce from there.
+class EcdsaSigner {
+public:
+    // throws std::invalid_argument for a secret not in [1, n), or for an order
+    // above 256 bits
+    EcdsaSigner(const Curve& curve, const uint8_t* secret);
+    // Status::out_of_range where the constructor throws
+    static Result<EcdsaSigner> make(const Curve& curve, const uint8_t* secret) noexcept;
+
+    // the signature of ecdsa_sign for hash[0, len)
+    Status sign(uint8_t* signature, const uint8_t* hash, std::size_t len) const noexcept;
+
+private:
+    friend std::vector<Status> ecdsa_sign_batch(const Curve& curve, const std::vector<EcdsaSignJob>& jobs,
+                                                const msm_executor& executor, std::size_t parallelism);
+
+    const Curve* curve;
+    Scalar d;
+    Rfc6979 nonces;
+
+    EcdsaSigner(const Curve& curve, const uint256& d);
+};
+
+struct EcdsaSignJob {
+    uint8_t* signature;             // 64 bytes, written
+    const EcdsaSigner* signer;
+    const uint8_t* hash;
+    std::size_t length;
+};
+
+// signer->sign of every job, results[i] for jobs[i], the same signatures
+// with the per-signature work shared. The jobs are cut into chunks that run
+// as tasks of executor as in ecdsa_verify_batch, and each chunk goes through
+// the steps in turn for all its jobs: the first RFC 6979 candidates together
+// (Rfc6979::first_candidates, on the multi-buffer SHA-256 where there is one),
+// every k * G by the generator table's mul_ct left in Jacobian form, the R
+// normalized with one inversion (Point::batch_normalize) and the k inverted
+// with another (Scalar::batch_invert). A job whose first candidate is out of
+// range or gives r or s of zero is signed again by signer->sign, which moves
+// on to the next candidate. Status::not_on_curve for a signer of another
+// curve, whose signature is not written
+std::vector<Status> ecdsa_sign_batch(const Curve& curve, const std::vector<EcdsaSignJob>& jobs,
+                                     const msm_executor& executor, std::size_t parallelism);
+inline std::vector<Status> ecdsa_sign_batch(const Curve& curve, const std::vector<EcdsaSignJob>& jobs,
+                                            unsigned threads = 1) {
+    return ecdsa_sign_batch(curve, jobs, thread_executor(threads), threads);
+}
+inline std::vector<Status> ecdsa_sign_batch(const Curve& curve, const std::vector<EcdsaSignJob>& jobs,
+                                            Executor& executor) {
+    return ecdsa_sign_batch(curve, jobs, executor.function(), executor.concurrency());
+}
+
+// Status::ok when signature is valid for hash under public_key: u1 * G + u2 * Q
+// by the interleaved wNAF of Point::mul_add (with the GLV split on secp256k1),
+// and its x compared with r in Jacobian coordinates, as X = r Z^2 and, when
+// r + n < p, X = (r + n) Z^2, so no inversion is paid. Status::bad_encoding for
+// r or s not in [1, n), Status::not_on_curve for a key on another curve,
+// Status::infinity for the point at infinity, Status::bad_signature otherwise
+Status ecdsa_verify(const uint8_t* signature, const Curve& curve, const Point& public_key, const uint8_t* hash,
+                    std::size_t len) noexcept;
+// the same with the key's tables made already (Point::wnaf_table) and G's
+// from Curve::generator_wnaf, so neither is built for the call
+Status ecdsa_verify(const uint8_t* signature, const Curve& curve, const WnafTable& public_key, const uint8_t* hash,
+                    std::size_t len) noexcept;
+
+struct EcdsaJob {
+    const uint8_t* signature;       // 64 bytes
+    const uint8_t* hash;
+    std::size_t length;
+    const Point* public_key;
+};
+
+// ecdsa_verify of every job, results[i] for jobs[i], with no dependence
+// between them. The jobs are cut into contiguous chunks, several per worker,
+// that run as tasks of executor (thread_executor hands the next chunk to
+// whichever thread is free, so a slow chunk does not hold the others up), and
+// each chunk keeps its integer temporaries in an IntegerArena of its own
+// thread, so the workers share no allocator. The jobs' 1 / s are taken
+// together first, one inversion for the batch (Scalar::batch_invert); an s
+// of zero or not below n fails its own job and no other. Nothing is written
+// but results.
+std::vector<Status> ecdsa_verify_batch(const Curve& curve, const std::vector<EcdsaJob>& jobs,
+                                       const msm_executor& executor, std::size_t parallelism);
+inline std::vector<Status> ecdsa_verify_batch(const Curve& curve, const std::vector<EcdsaJob>& jobs,
+                                              unsigned threads = 1) {
+    return ecdsa_verify_batch(curve, jobs, thread_executor(threads), threads);
+}
+inline std::vector<Status> ecdsa_verify_batch(const Curve& curve, const std::vector<EcdsaJob>& jobs,
+                                              Executor& executor) {
+    return ecdsa_verify_batch(curve, jobs, executor.function(), executor.concurrency());
+}
+
+// The public key signature on hash was made under, Q = r^-1 (s R - e G) for
+// the R that recid names, as Ethereum's v - 27: bit 0 the parity of R's y,
+// bit 1 set for R's x = r + n rather than r. R is lifted by sec1_decode and Q
+// taken as u1 * G + u2 * R by Point::mul_add on the curve's generator table.
+// Status::bad_encoding for r or s not in [1, n) or recid not in [0, 3],
+// Status::bad_signature for an x not below p or with no point,
+// Status::infinity where Q would be the point at infinity
+Result<Point> ecdsa_recover(const uint8_t* signature, const Curve& curve, int recid, const uint8_t* hash,
+                            std::size_t len) noexcept;
+
+struct EcdsaRecoveryJob {
+    const uint8_t* signature;       // 64 bytes
+    const uint8_t* hash;
+    std::size_t length;
+    int recid;
+};
+
+// ecdsa_recover of every job, results[i] for jobs[i], in affine form. The
+// square roots that lift every R are taken together by decompress_keys, the
+// inverses of every r share one inversion (Montgomery's trick), and so do the
+// normalizations of the keys; the multiplications run in chunks on executor as
+// in ecdsa_verify_batch.
+std::vector<Result<Point>> ecdsa_recover_batch(const Curve& curve, const std::vector<EcdsaRecoveryJob>& jobs,
+                                               const msm_executor& executor, std::size_t parallelism);
+inline std::vector<Result<Point>> ecdsa_recover_batch(const Curve& curve, const std::vector<EcdsaRecoveryJob>& jobs,
+                                                      unsigned threads = 1) {
+    return ecdsa_recover_batch(curve, jobs, thread_executor(threads), threads);
+}
+inline std::vector<Result<Point>> ecdsa_recover_batch(const Curve& curve, const std::vector<EcdsaRecoveryJob>& jobs,
+                                                      Executor& executor) {
+    return ecdsa_recover_batch(curve, jobs, executor.function(), executor.concurrency());
+}
+
+#endif //ECC_ECDSA_H
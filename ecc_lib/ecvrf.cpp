@@ -0,0 +1,610 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstring>
+#include <random>
+
+#include "chacha20.h"
+#include "decompress.h"
+#include "ecvrf.h"
+#include "msm.h"
+#include "rfc6979.h"
+#include "Scalar.h"
+#include "sec1.h"
+#include "sha256.h"
+#include "trace.h"
+
+#if defined(__SIZEOF_INT128__)
+#include "ed25519.h"
+#include "sha512.h"
+#endif
+
+namespace {
+
+// 32 bytes of std::random_device into the seed of a batch's randomizers
+template<class Hash>
+void absorb_device(Hash& hash) {
+    std::random_device device;
+    for (std::size_t i = 0; i < 8; i++) {
+        const uint32_t word = device();
+        const uint8_t bytes[4] = {static_cast<uint8_t>(word), static_cast<uint8_t>(word >> 8),
+                                  static_cast<uint8_t>(word >> 16), static_cast<uint8_t>(word >> 24)};
+        hash.update(bytes, 4);
+    }
+}
+
+// a public key as RFC 9381's string_to_point has it
+Result<Point> decode_key(const uint8_t* key, const Curve& curve) {
+    Result<Point> y = sec1_decode(key, Ecvrf::KEY_SIZE, curve);
+    if (!y) {
+        return y.status() == Status::not_a_square ? Status::not_on_curve : Status::bad_encoding;
+    }
+    return y;
+}
+
+}
+
+Ecvrf::Ecvrf(const Curve& curve, uint8_t suite, const HashToCurve* h2c, const std::string& h2c_suite)
+        : c(&curve), id(suite), h2c(h2c), dst("ECVRF_" + h2c_suite + std::string(1, static_cast<char>(suite))) {}
+
+const Ecvrf& Ecvrf::p256_tai() {
+    static const Ecvrf suite(Curve::p256(), 0x01, nullptr, "");
+    return suite;
+}
+
+const Ecvrf& Ecvrf::p256_sswu() {
+    static const Ecvrf suite(Curve::p256(), 0x02, &HashToCurve::p256(), "P256_XMD:SHA-256_SSWU_NU_");
+    return suite;
+}
+
+const Ecvrf& Ecvrf::secp256k1_sswu() {
+    static const Ecvrf suite(Curve::secp256k1(), 0xFE, &HashToCurve::secp256k1(), "secp256k1_XMD:SHA-256_SSWU_NU_");
+    return suite;
+}
+
+Result<Point> Ecvrf::encode(const uint8_t* public_key, const uint8_t* alpha, std::size_t len) const {
+    if (this->h2c) {
+        std::vector<uint8_t> msg(public_key, public_key + KEY_SIZE);
+        msg.insert(msg.end(), alpha, alpha + len);
+        const Point h = this->h2c->map(hash_to_field(msg.data(), msg.size(),
+                                                     reinterpret_cast<const uint8_t*>(this->dst.data()),
+                                                     this->dst.size(), this->c->field(), 1)[0]);
+        if (h.is_infinity()) {
+            return Status::not_on_curve;
+        }
+        return h;
+    }
+    const uint8_t prefix[2] = {this->id, 0x01};
+    for (unsigned ctr = 0; ctr < 256; ctr++) {
+        const uint8_t suffix[2] = {static_cast<uint8_t>(ctr), 0x00};
+        Sha256 sha;
+        sha.update(prefix, 2);
+        sha.update(public_key, KEY_SIZE);
+        sha.update(alpha, len);
+        sha.update(suffix, 2);
+        uint8_t key[KEY_SIZE] = {0x02};
+        sha.finish(key + 1);
+        const Result<Point> h = sec1_decode(key, KEY_SIZE, *this->c);
+        if (h) {
+            return h;
+        }
+    }
+    return Status::not_on_curve;
+}
+
+integer Ecvrf::challenge(const uint8_t* y, const uint8_t* h, const uint8_t* gamma, const uint8_t* u,
+                         const uint8_t* v) const {
+    const uint8_t prefix[2] = {this->id, 0x02}, suffix = 0x00;
+    Sha256 sha;
+    sha.update(prefix, 2);
+    for (const uint8_t* p : {y, h, gamma, u, v}) {
+        sha.update(p, KEY_SIZE);
+    }
+    sha.update(&suffix, 1);
+    uint8_t digest[32];
+    sha.finish(digest);
+    return (uint256::load_be(digest, 32) >> 128).to_integer();
+}
+
+void Ecvrf::hash_gamma(uint8_t* beta, const uint8_t* gamma) const {
+    const uint8_t prefix[2] = {this->id, 0x03}, suffix = 0x00;
+    Sha256 sha;
+    sha.update(prefix, 2);
+    sha.update(gamma, KEY_SIZE);
+    sha.update(&suffix, 1);
+    sha.finish(beta);
+}
+
+Status Ecvrf::public_key(uint8_t* out, const uint8_t* secret) const noexcept {
+    const uint256 x = uint256::load_be(secret, 32);
+    if (x == uint256(0) || !(x < this->c->scalar_field().fixed_prime())) {
+        return Status::out_of_range;
+    }
+    sec1_encode(this->c->mul_base_ct(x.to_integer()), true, out, KEY_SIZE);
+    return Status::ok;
+}
+
+Status Ecvrf::prove_with(uint8_t* out, bool batchable, const uint8_t* secret, const uint8_t* alpha,
+                         std::size_t len) const noexcept {
+    const Curve& curve = *this->c;
+    const PrimeField& order = curve.scalar_field();
+    uint8_t y[KEY_SIZE];
+    const Status key = public_key(y, secret);
+    if (key != Status::ok) {
+        return key;
+    }
+    const integer x = uint256::load_be(secret, 32).to_integer();
+    const Result<Point> h = encode(y, alpha, len);
+    if (!h) {
+        return h.status();
+    }
+    uint8_t h_string[KEY_SIZE];
+    sec1_encode(*h, true, h_string, KEY_SIZE);
+
+    // RFC 6979 from h1 = SHA-256(h_string) mod n
+    uint8_t h1[32];
+    Sha256::hash(h_string, KEY_SIZE, h1);
+    Scalar::from_bytes(h1, 32, order).to_bytes(h1);
+    Rfc6979::Drbg nonces = Rfc6979(secret, 32).drbg(h1);
+    uint256 k;
+    do {
+        k = uint256::load_be(nonces.next(), 32);
+    } while (k == uint256(0) || !(k < order.fixed_prime()));
+
+    // Gamma, k B and k H under one inversion
+    std::vector<Point> points = {h->mul_ct(x), curve.mul_base_ct(k.to_integer()),
+                                 h->mul_ct(k.to_integer())};
+    uint8_t encoded[3 * KEY_SIZE];
+    sec1_encode_batch(points, true, encoded, sizeof(encoded));
+    const Scalar c(challenge(y, h_string, encoded, encoded + KEY_SIZE, encoded + 2 * KEY_SIZE), order);
+    const Scalar s = Scalar(k.to_integer(), order) + c * Scalar(x, order);
+
+    if (batchable) {
+        std::memcpy(out, encoded, sizeof(encoded));
+        s.to_bytes(out + sizeof(encoded));
+    } else {
+        uint8_t c_bytes[32];
+        c.to_bytes(c_bytes);
+        std::memcpy(out, encoded, KEY_SIZE);
+        std::memcpy(out + KEY_SIZE, c_bytes + 16, 16);
+        s.to_bytes(out + KEY_SIZE + 16);
+    }
+    return Status::ok;
+}
+
+Status Ecvrf::prove(uint8_t* proof, const uint8_t* secret, const uint8_t* alpha, std::size_t len) const noexcept {
+    return prove_with(proof, false, secret, alpha, len);
+}
+
+Status Ecvrf::prove_batchable(uint8_t* proof, const uint8_t* secret, const uint8_t* alpha,
+                              std::size_t len) const noexcept {
+    return prove_with(proof, true, secret, alpha, len);
+}
+
+Status Ecvrf::proof_to_hash(uint8_t* beta, const uint8_t* proof) const noexcept {
+    if (!sec1_decode(proof, KEY_SIZE, *this->c)) {
+        return Status::bad_encoding;
+    }
+    hash_gamma(beta, proof);
+    return Status::ok;
+}
+
+Status Ecvrf::verify(uint8_t* beta, const uint8_t* public_key, const uint8_t* proof, const uint8_t* alpha,
+                     std::size_t len) const noexcept {
+    const Curve& curve = *this->c;
+    const PrimeField& order = curve.scalar_field();
+    const Result<Point> y = decode_key(public_key, curve);
+    if (!y) {
+        return y.status();
+    }
+    const Result<Point> gamma = sec1_decode(proof, KEY_SIZE, curve);
+    if (!gamma) {
+        return Status::bad_encoding;
+    }
+    uint8_t c_bytes[32] = {0};
+    std::memcpy(c_bytes + 16, proof + KEY_SIZE, 16);
+    const integer c = uint256::load_be(c_bytes, 32).to_integer();
+    const uint256 s = uint256::load_be(proof + KEY_SIZE + 16, 32);
+    if (!(s < order.fixed_prime())) {
+        return Status::bad_encoding;
+    }
+    const Result<Point> h = encode(public_key, alpha, len);
+    if (!h) {
+        return h.status();
+    }
+
+    // U = s B - c Y and V = s H - c Gamma, never infinity in an honest proof
+    const integer minus_c = (-Scalar(c, order)).value();
+    std::vector<Point> points = {*h, Point::mul_add(s.to_integer(), curve.generator_table(), minus_c, *y),
+                                 Point::mul_add(s.to_integer(), *h, minus_c, *gamma)};
+    if (points[1].is_infinity() || points[2].is_infinity()) {
+        return Status::bad_signature;
+    }
+    uint8_t encoded[3 * KEY_SIZE];
+    sec1_encode_batch(points, true, encoded, sizeof(encoded));
+    if (challenge(public_key, encoded, proof, encoded + KEY_SIZE, encoded + 2 * KEY_SIZE) != c) {
+        return Status::bad_signature;
+    }
+    hash_gamma(beta, proof);
+    return Status::ok;
+}
+
+Status Ecvrf::verify_batch(uint8_t* betas, const std::vector<EcvrfProved>& items, unsigned threads) const {
+    ThreadExecutor executor(threads);
+    return verify_batch(betas, items, executor);
+}
+
+Status Ecvrf::verify_batch(uint8_t* betas, const std::vector<EcvrfProved>& items, Executor& executor) const {
+    ECC_TRACE_SPAN("ecvrf.verify_batch");
+    const Curve& curve = *this->c;
+    const PrimeField& order = curve.scalar_field();
+    const std::size_t count = items.size();
+    if (!count) {
+        return Status::ok;
+    }
+
+    // every key, then Gamma, U and V of every proof
+    std::vector<uint8_t> keys(4 * count * KEY_SIZE);
+    for (std::size_t i = 0; i < count; i++) {
+        std::memcpy(&keys[KEY_SIZE * i], items[i].public_key, KEY_SIZE);
+        std::memcpy(&keys[KEY_SIZE * (count + 3 * i)], items[i].proof, 3 * KEY_SIZE);
+    }
+    const DecompressedKeys lifted = decompress_keys(keys.data(), 4 * count, curve, executor);
+    for (std::size_t i = 0; i < count; i++) {
+        if (!lifted.valid(i)) {
+            return decode_key(items[i].public_key, curve).status();
+        }
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        if (!lifted.valid(count + 3 * i) || !lifted.valid(count + 3 * i + 1) || !lifted.valid(count + 3 * i + 2)
+            || !(uint256::load_be(items[i].proof + 3 * KEY_SIZE, 32) < order.fixed_prime())) {
+            return Status::bad_encoding;
+        }
+    }
+
+    std::vector<Point> h;
+    if (this->h2c) {
+        std::vector<FieldElement> u;
+        u.reserve(count);
+        for (const EcvrfProved& item : items) {
+            std::vector<uint8_t> msg(item.public_key, item.public_key + KEY_SIZE);
+            msg.insert(msg.end(), item.alpha, item.alpha + item.length);
+            u.push_back(hash_to_field(msg.data(), msg.size(), reinterpret_cast<const uint8_t*>(this->dst.data()),
+                                      this->dst.size(), curve.field(), 1)[0]);
+        }
+        h = this->h2c->map_batch(u);
+        for (const Point& p : h) {
+            if (p.is_infinity()) {
+                return Status::not_on_curve;
+            }
+        }
+    } else {
+        h.reserve(count);
+        for (const EcvrfProved& item : items) {
+            const Result<Point> p = encode(item.public_key, item.alpha, item.length);
+            if (!p) {
+                return p.status();
+            }
+            h.push_back(*p);
+        }
+    }
+    std::vector<uint8_t> h_strings(count * KEY_SIZE);
+    sec1_encode_batch(h, true, h_strings.data(), h_strings.size());
+
+    Sha256 seed_hash;
+    absorb_device(seed_hash);
+    std::vector<integer> c;
+    c.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+        const uint8_t* proof = items[i].proof;
+        c.push_back(challenge(items[i].public_key, &h_strings[KEY_SIZE * i], proof, proof + KEY_SIZE,
+                              proof + 2 * KEY_SIZE));
+        seed_hash.update(items[i].public_key, KEY_SIZE);
+        seed_hash.update(proof, BATCH_PROOF_SIZE);
+        seed_hash.update(&h_strings[KEY_SIZE * i], KEY_SIZE);
+    }
+    uint8_t seed[Sha256::DIGEST_SIZE];
+    seed_hash.finish(seed);
+
+    // z_i and w_i the next 128 bits each of ChaCha20 keyed by the seed
+    ChaCha20Rng rng(seed);
+    std::vector<uint8_t> randomizers(32 * count);
+    rng.fill(randomizers.data(), randomizers.size());
+    Scalar base(order);
+    std::vector<integer> scalars(1);
+    std::vector<Point> points(1, curve.generator());
+    scalars.reserve(5 * count + 1);
+    points.reserve(5 * count + 1);
+    for (std::size_t i = 0; i < count; i++) {
+        const Scalar z = Scalar::from_bytes(&randomizers[32 * i], 16, order);
+        const Scalar w = Scalar::from_bytes(&randomizers[32 * i + 16], 16, order);
+        const Scalar s = Scalar::from_bytes(items[i].proof + 3 * KEY_SIZE, 32, order);
+        const Scalar ci(c[i], order);
+        base += z * s;
+        scalars.push_back((-(z * ci)).value());
+        points.push_back(lifted.points[i]);
+        scalars.push_back((-z).value());
+        points.push_back(lifted.points[count + 3 * i + 1]);
+        scalars.push_back((w * s).value());
+        points.push_back(h[i]);
+        scalars.push_back((-(w * ci)).value());
+        points.push_back(lifted.points[count + 3 * i]);
+        scalars.push_back((-w).value());
+        points.push_back(lifted.points[count + 3 * i + 2]);
+    }
+    scalars[0] = base.value();
+    if (!multi_scalar_mul(scalars, points, executor).is_infinity()) {
+        return Status::bad_signature;
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        hash_gamma(betas + HASH_SIZE * i, items[i].proof);
+    }
+    return Status::ok;
+}
+
+#if defined(__SIZEOF_INT128__)
+
+namespace {
+
+const uint8_t ED25519_SUITE = 0x03;
+
+integer from_le(const uint8_t* in, std::size_t len) {
+    fixed_uint<8> value(0);
+    for (std::size_t i = 0; i < len; i++) {
+        value.limb[i / 8] |= static_cast<limb_t>(in[i]) << (8 * (i % 8));
+    }
+    return value.to_integer();
+}
+
+// 0 <= value < 2^256 into out[0, 32)
+void to_le(const integer& value, uint8_t* out) {
+    const uint256 limbs = uint256::from_integer(value);
+    for (std::size_t i = 0; i < 32; i++) {
+        out[i] = static_cast<uint8_t>(limbs.limb[i / 8] >> (8 * (i % 8)));
+    }
+}
+
+// RFC 8032, section 5.1.5: the scalar from the first half of the hashed secret
+void clamp(uint8_t* a, const uint8_t* h) {
+    std::memcpy(a, h, 32);
+    a[0] &= 248;
+    a[31] &= 127;
+    a[31] |= 64;
+}
+
+// H by try-and-increment: the first counter whose hash starts with a point, times 8
+Result<Ed25519Point> ed25519_encode(const uint8_t* public_key, const uint8_t* alpha, std::size_t len) {
+    const uint8_t prefix[2] = {ED25519_SUITE, 0x01};
+    for (unsigned ctr = 0; ctr < 256; ctr++) {
+        const uint8_t suffix[2] = {static_cast<uint8_t>(ctr), 0x00};
+        Sha512 sha;
+        sha.update(prefix, 2);
+        sha.update(public_key, 32);
+        sha.update(alpha, len);
+        sha.update(suffix, 2);
+        uint8_t digest[64];
+        sha.finish(digest);
+        const Result<Ed25519Point> h = Ed25519Point::from_bytes(digest);
+        if (h) {
+            return h->mul_by_cofactor();
+        }
+    }
+    return Status::not_on_curve;
+}
+
+integer ed25519_challenge(const uint8_t* y, const uint8_t* h, const uint8_t* gamma, const uint8_t* u,
+                          const uint8_t* v) {
+    const uint8_t prefix[2] = {ED25519_SUITE, 0x02}, suffix = 0x00;
+    Sha512 sha;
+    sha.update(prefix, 2);
+    for (const uint8_t* p : {y, h, gamma, u, v}) {
+        sha.update(p, 32);
+    }
+    sha.update(&suffix, 1);
+    uint8_t digest[64];
+    sha.finish(digest);
+    return from_le(digest, 16);
+}
+
+void ed25519_hash_gamma(uint8_t* beta, const Ed25519Point& gamma) {
+    const uint8_t prefix[2] = {ED25519_SUITE, 0x03}, suffix = 0x00;
+    uint8_t g[32];
+    gamma.mul_by_cofactor().to_bytes(g);
+    Sha512 sha;
+    sha.update(prefix, 2);
+    sha.update(g, 32);
+    sha.update(&suffix, 1);
+    sha.finish(beta);
+}
+
+// a key that decodes and is not of small order
+Result<Ed25519Point> ed25519_key(const uint8_t* public_key) {
+    const Result<Ed25519Point> y = Ed25519Point::from_bytes(public_key);
+    if (y && y->mul_by_cofactor().is_identity()) {
+        return Status::infinity;
+    }
+    return y;
+}
+
+Status ed25519_prove_with(uint8_t* out, bool batchable, const uint8_t* secret, const uint8_t* alpha,
+                          std::size_t len) {
+    uint8_t hashed[64], x[32], y[32];
+    Sha512::hash(secret, 32, hashed);
+    clamp(x, hashed);
+    Ed25519Point::mul_base(x).to_bytes(y);
+    const Result<Ed25519Point> h = ed25519_encode(y, alpha, len);
+    if (!h) {
+        return h.status();
+    }
+    uint8_t h_string[32];
+    h->to_bytes(h_string);
+
+    uint8_t nonce[64], k[32];
+    Sha512 sha;
+    sha.update(hashed + 32, 32);
+    sha.update(h_string, 32);
+    sha.finish(nonce);
+    const integer k_value = from_le(nonce, 64) % ed25519_order();
+    to_le(k_value, k);
+
+    uint8_t points[3 * 32];
+    h->mul(x).to_bytes(points);
+    Ed25519Point::mul_base(k).to_bytes(points + 32);
+    h->mul(k).to_bytes(points + 64);
+    const integer c = ed25519_challenge(y, h_string, points, points + 32, points + 64);
+    const integer s = (k_value + c * from_le(x, 32)) % ed25519_order();
+
+    if (batchable) {
+        std::memcpy(out, points, sizeof(points));
+        to_le(s, out + sizeof(points));
+    } else {
+        uint8_t c_bytes[32];
+        to_le(c, c_bytes);
+        std::memcpy(out, points, 32);
+        std::memcpy(out + 32, c_bytes, 16);
+        to_le(s, out + 48);
+    }
+    return Status::ok;
+}
+
+}
+
+Status ecvrf_ed25519_prove(uint8_t* proof, const uint8_t* secret, const uint8_t* alpha, std::size_t len) noexcept {
+    return ed25519_prove_with(proof, false, secret, alpha, len);
+}
+
+Status ecvrf_ed25519_prove_batchable(uint8_t* proof, const uint8_t* secret, const uint8_t* alpha,
+                                     std::size_t len) noexcept {
+    return ed25519_prove_with(proof, true, secret, alpha, len);
+}
+
+Status ecvrf_ed25519_proof_to_hash(uint8_t* beta, const uint8_t* proof) noexcept {
+    const Result<Ed25519Point> gamma = Ed25519Point::from_bytes(proof);
+    if (!gamma) {
+        return Status::bad_encoding;
+    }
+    ed25519_hash_gamma(beta, *gamma);
+    return Status::ok;
+}
+
+Status ecvrf_ed25519_verify(uint8_t* beta, const uint8_t* public_key, const uint8_t* proof, const uint8_t* alpha,
+                            std::size_t len) noexcept {
+    const Result<Ed25519Point> y = ed25519_key(public_key);
+    if (!y) {
+        return y.status();
+    }
+    const Result<Ed25519Point> gamma = Ed25519Point::from_bytes(proof);
+    if (!gamma || from_le(proof + 48, 32) >= ed25519_order()) {
+        return Status::bad_encoding;
+    }
+    const integer c = from_le(proof + 32, 16);
+    const Result<Ed25519Point> h = ed25519_encode(public_key, alpha, len);
+    if (!h) {
+        return h.status();
+    }
+
+    uint8_t c_bytes[32], h_string[32], u[32], v[32];
+    to_le(c, c_bytes);
+    h->to_bytes(h_string);
+    (Ed25519Point::mul_base(proof + 48) - y->mul(c_bytes)).to_bytes(u);
+    (h->mul(proof + 48) - gamma->mul(c_bytes)).to_bytes(v);
+    if (ed25519_challenge(public_key, h_string, proof, u, v) != c) {
+        return Status::bad_signature;
+    }
+    ed25519_hash_gamma(beta, *gamma);
+    return Status::ok;
+}
+
+Status ecvrf_ed25519_verify_batch(uint8_t* betas, const std::vector<EcvrfProved>& items, unsigned threads) {
+    ThreadExecutor executor(threads);
+    return ecvrf_ed25519_verify_batch(betas, items, executor);
+}
+
+Status ecvrf_ed25519_verify_batch(uint8_t* betas, const std::vector<EcvrfProved>& items, Executor& executor) {
+    ECC_TRACE_SPAN("ecvrf.ed25519_verify_batch");
+    const std::size_t count = items.size();
+    if (!count) {
+        return Status::ok;
+    }
+    const integer& order = ed25519_order();
+    // Y, Gamma, U, V and H of every proof
+    std::vector<Ed25519Point> lifted;
+    lifted.reserve(5 * count);
+    for (const EcvrfProved& item : items) {
+        const Result<Ed25519Point> y = ed25519_key(item.public_key);
+        if (!y) {
+            return y.status();
+        }
+        lifted.push_back(*y);
+    }
+    Sha512 seed_hash;
+    absorb_device(seed_hash);
+    std::vector<integer> c(count), s(count);
+    for (std::size_t i = 0; i < count; i++) {
+        const uint8_t* proof = items[i].proof;
+        for (std::size_t j = 0; j < 3; j++) {
+            const Result<Ed25519Point> p = Ed25519Point::from_bytes(proof + 32 * j);
+            if (!p) {
+                return Status::bad_encoding;
+            }
+            lifted.push_back(*p);
+        }
+        s[i] = from_le(proof + 96, 32);
+        if (s[i] >= order) {
+            return Status::bad_encoding;
+        }
+        const Result<Ed25519Point> h = ed25519_encode(items[i].public_key, items[i].alpha, items[i].length);
+        if (!h) {
+            return h.status();
+        }
+        lifted.push_back(*h);
+        uint8_t h_string[32];
+        h->to_bytes(h_string);
+        c[i] = ed25519_challenge(items[i].public_key, h_string, proof, proof + 32, proof + 64);
+        seed_hash.update(items[i].public_key, 32);
+        seed_hash.update(proof, ECVRF_ED25519_BATCH_PROOF_SIZE);
+        seed_hash.update(h_string, 32);
+    }
+    uint8_t seed[Sha512::DIGEST_SIZE];
+    seed_hash.finish(seed);
+
+    // z_i and w_i the next 128 bits each of ChaCha20 keyed by the seed's first half
+    ChaCha20Rng rng(seed);
+    std::vector<uint8_t> randomizers(32 * count);
+    rng.fill(randomizers.data(), randomizers.size());
+    integer base_scalar;
+    std::vector<integer> scalars(1);
+    std::vector<Ed25519Point::Cached> points(1, Ed25519Point::base().cached());
+    scalars.reserve(5 * count + 1);
+    points.reserve(5 * count + 1);
+    for (std::size_t i = 0; i < count; i++) {
+        const integer z = from_le(&randomizers[32 * i], 16);
+        const integer w = from_le(&randomizers[32 * i + 16], 16);
+        const Ed25519Point& gamma = lifted[count + 4 * i];
+        base_scalar += z * s[i];
+        scalars.push_back((order - z * c[i] % order) % order);
+        points.push_back(lifted[i].cached());
+        scalars.push_back((order - z) % order);
+        points.push_back(lifted[count + 4 * i + 1].cached());
+        scalars.push_back(w * s[i] % order);
+        points.push_back(lifted[count + 4 * i + 3].cached());
+        scalars.push_back((order - w * c[i] % order) % order);
+        points.push_back(gamma.cached());
+        scalars.push_back((order - w) % order);
+        points.push_back(lifted[count + 4 * i + 2].cached());
+    }
+    scalars[0] = base_scalar % order;
+
+    const Ed25519Point sum = bucket_msm(scalars, points, pippenger_window(points.size(), order.bit_length()),
+                                        Ed25519Point(), [](Ed25519Point::Cached*, std::size_t, Scratch&) {},
+                                        executor.function(), executor.concurrency(), Scratch::local());
+    if (!sum.mul_by_cofactor().is_identity()) {
+        return Status::bad_signature;
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        ed25519_hash_gamma(betas + ECVRF_ED25519_HASH_SIZE * i, lifted[count + 4 * i]);
+    }
+    return Status::ok;
+}
+
+#endif
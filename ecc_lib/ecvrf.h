@@ -0,0 +1,148 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_ECVRF_H
+#define ECC_ECVRF_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Curve.h"
+#include "Executor.h"
+#include "hash_to_curve.h"
+#include "Status.h"
+
+// The verifiable random functions of RFC 9381 (ECVRF): beta = hash of x H,
+// H the message hashed to the curve, with a proof (Gamma = x H, c, s) that
+// anyone holding Y = x B can check, c = Hash(Y, H, Gamma, U, V) truncated to
+// 16 bytes with U = s B - c Y and V = s H - c Gamma. The verifier has to
+// rebuild U and V to hash them, so those proofs cannot be checked together.
+// The batch-compatible proofs of Badertscher, Gazi, Querejeta-Azurmendi and
+// Russell carry U and V instead of c, (Gamma, U, V, s), with the same beta:
+// c is hashed from them, and a batch is checked by one random linear
+// combination of both equations of every proof, one multi-scalar
+// multiplication. Proving is deterministic; its multiplications by the secret
+// use the mul_ct formulas, but the arithmetic mod n runs on integer, which is
+// not constant time.
+
+// one batch-compatible proof of a message
+struct EcvrfProved {
+    const uint8_t* public_key;
+    const uint8_t* proof;
+    const uint8_t* alpha;
+    std::size_t length;
+};
+
+// One ECVRF suite on a short Weierstrass curve of prime order, SHA-256 and
+// compressed SEC 1 points: ptLen 33, qLen 32, cLen 16
+class Ecvrf {
+public:
+    // Gamma || c || s
+    static constexpr std::size_t PROOF_SIZE = 33 + 16 + 32;
+    // Gamma || U || V || s
+    static constexpr std::size_t BATCH_PROOF_SIZE = 3 * 33 + 32;
+    static constexpr std::size_t KEY_SIZE = 33;
+    static constexpr std::size_t HASH_SIZE = 32;
+
+    // ECVRF-P256-SHA256-TAI, suite 0x01: H by try-and-increment, the first
+    // counter whose hash is the x of a point with even y
+    static const Ecvrf& p256_tai();
+    // ECVRF-P256-SHA256-SSWU, suite 0x02: H by encode_to_curve of
+    // P256_XMD:SHA-256_SSWU_NU_
+    static const Ecvrf& p256_sswu();
+    // the same construction on secp256k1 through
+    // secp256k1_XMD:SHA-256_SSWU_NU_, under suite 0xFE: RFC 9381 defines no
+    // secp256k1 suite, so no other implementation's proofs are claimed
+    static const Ecvrf& secp256k1_sswu();
+
+    const Curve& curve() const { return *this->c; }
+    uint8_t suite() const { return this->id; }
+
+    // the compressed Y = x B of the 32-byte secret x in out[0, 33);
+    // Status::out_of_range for x = 0 or not below n
+    Status public_key(uint8_t* out, const uint8_t* secret) const noexcept;
+    // the proof of alpha[0, len) in proof[0, PROOF_SIZE), its nonce by RFC 6979
+    // from the secret and H; Status::out_of_range as public_key, and
+    // Status::not_on_curve in the 2^-256 case of no counter giving a point
+    Status prove(uint8_t* proof, const uint8_t* secret, const uint8_t* alpha, std::size_t len) const noexcept;
+    // the same as a batch-compatible proof in proof[0, BATCH_PROOF_SIZE)
+    Status prove_batchable(uint8_t* proof, const uint8_t* secret, const uint8_t* alpha,
+                           std::size_t len) const noexcept;
+    // beta of a proof in beta[0, HASH_SIZE), without verifying it: only for
+    // proofs verified already. Status::bad_encoding for a Gamma that does not decode
+    Status proof_to_hash(uint8_t* beta, const uint8_t* proof) const noexcept;
+    // whether proof[0, PROOF_SIZE) is public_key's for alpha[0, len), and then
+    // its beta in beta[0, HASH_SIZE). Status::bad_encoding for a key that does
+    // not decode, Status::not_on_curve for a key x with no point,
+    // Status::bad_encoding for a Gamma that does not decode or s not below n,
+    // Status::bad_signature when c does not match. U and V are two
+    // Strauss-Shamir multiplications, U with B from the generator's table
+    Status verify(uint8_t* beta, const uint8_t* public_key, const uint8_t* proof, const uint8_t* alpha,
+                  std::size_t len) const noexcept;
+    // whether every one of items holds a batch-compatible proof, and then the
+    // beta of item i in betas[HASH_SIZE i, HASH_SIZE (i + 1)). With random
+    // 128-bit z_i and w_i, sum z_i (s_i B - c_i Y_i - U_i) + w_i (s_i H_i -
+    // c_i Gamma_i - V_i) is the point at infinity: 5n + 1 points through
+    // multi_scalar_mul (threads as there), after every key and proof point is
+    // lifted by one decompress_keys and every H mapped with shared
+    // inversions. The first decoding failure as verify, or
+    // Status::bad_signature without saying which proof failed
+    Status verify_batch(uint8_t* betas, const std::vector<EcvrfProved>& items, unsigned threads = 1) const;
+    Status verify_batch(uint8_t* betas, const std::vector<EcvrfProved>& items, Executor& executor) const;
+
+private:
+    const Curve* c;
+    uint8_t id;
+    // null for try-and-increment
+    const HashToCurve* h2c;
+    // "ECVRF_" || h2c suite || suite
+    std::string dst;
+
+    Ecvrf(const Curve& curve, uint8_t suite, const HashToCurve* h2c, const std::string& h2c_suite);
+    // H of public_key[0, 33) and alpha[0, len), normalized
+    Result<Point> encode(const uint8_t* public_key, const uint8_t* alpha, std::size_t len) const;
+    // c of the five encoded points, below 2^128
+    integer challenge(const uint8_t* y, const uint8_t* h, const uint8_t* gamma, const uint8_t* u,
+                      const uint8_t* v) const;
+    // Gamma in out[0, 33), then c and s or U, V and s
+    Status prove_with(uint8_t* out, bool batchable, const uint8_t* secret, const uint8_t* alpha,
+                      std::size_t len) const noexcept;
+    void hash_gamma(uint8_t* beta, const uint8_t* gamma) const;
+};
+
+// ECVRF-EDWARDS25519-SHA512-TAI of RFC 9381, suite 0x03, on the Ed25519Point
+// of ed25519.h, so only where that is. The secret and public key are those
+// of Ed25519: x is the clamped scalar of the hashed secret and the nonce is
+// hashed from its second half and H. ptLen 32, qLen 32, cLen 16, little-endian
+// scalars, and Gamma multiplied by the cofactor 8 before hashing it into the
+// 64-byte beta. The suite 0x04 of RFC 9381 hashes to the curve by Elligator 2,
+// which hash_to_curve.h does not have.
+#if defined(__SIZEOF_INT128__)
+
+constexpr std::size_t ECVRF_ED25519_PROOF_SIZE = 32 + 16 + 32;
+constexpr std::size_t ECVRF_ED25519_BATCH_PROOF_SIZE = 4 * 32;
+constexpr std::size_t ECVRF_ED25519_HASH_SIZE = 64;
+
+// the proof of alpha[0, len) by the 32-byte secret, as Ecvrf::prove and
+// Ecvrf::prove_batchable; Status::not_on_curve in the 2^-256 case of no
+// counter giving a point
+Status ecvrf_ed25519_prove(uint8_t* proof, const uint8_t* secret, const uint8_t* alpha, std::size_t len) noexcept;
+Status ecvrf_ed25519_prove_batchable(uint8_t* proof, const uint8_t* secret, const uint8_t* alpha,
+                                     std::size_t len) noexcept;
+Status ecvrf_ed25519_proof_to_hash(uint8_t* beta, const uint8_t* proof) noexcept;
+// as Ecvrf::verify, with the statuses of Ed25519Point::from_bytes for the key
+// and Status::infinity for a key of small order, which RFC 9381's
+// validate_key rejects
+Status ecvrf_ed25519_verify(uint8_t* beta, const uint8_t* public_key, const uint8_t* proof, const uint8_t* alpha,
+                            std::size_t len) noexcept;
+// as Ecvrf::verify_batch, with the sum multiplied by the cofactor before it is
+// compared to the identity, through bucket_msm as ed25519_verify_batch
+Status ecvrf_ed25519_verify_batch(uint8_t* betas, const std::vector<EcvrfProved>& items, unsigned threads = 1);
+Status ecvrf_ed25519_verify_batch(uint8_t* betas, const std::vector<EcvrfProved>& items, Executor& executor);
+
+#endif
+
+#endif //ECC_ECVRF_H
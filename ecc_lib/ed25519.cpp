@@ -0,0 +1,385 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <random>
+
+#include "chacha20.h"
+#include "ed25519.h"
+
+#if defined(__SIZEOF_INT128__)
+
+#include "msm.h"
+#include "sha512.h"
+
+namespace {
+
+typedef Curve25519Field51 F;
+
+struct Constants {
+    F d, d2, sqrt_m1;
+};
+
+// d = -121665 / 121666 and sqrt(-1) = 2^((p - 1) / 4) = 2 * (2^((p - 5) / 8))^2
+const Constants& constants() {
+    static const Constants c = []() {
+        const F d = -(F(121665) * F(121666).inverse());
+        const F two(2);
+        return Constants{d, d + d, two.pow_p58().square() * two};
+    }();
+    return c;
+}
+
+// the group order, limbs least significant first
+const limb_t ORDER[4] = {0x5812631A5CF5D3ED, 0x14DEF9DEA2F79CD6, 0, 0x1000000000000000};
+
+integer from_le(const uint8_t* in, std::size_t len) {
+    fixed_uint<8> value(0);
+    for (std::size_t i = 0; i < len; i++) {
+        value.limb[i / 8] |= static_cast<limb_t>(in[i]) << (8 * (i % 8));
+    }
+    return value.to_integer();
+}
+
+// 0 <= value < 2^256 into out[0, 32)
+void to_le(const integer& value, uint8_t* out) {
+    const uint256 limbs = uint256::from_integer(value);
+    for (std::size_t i = 0; i < 32; i++) {
+        out[i] = static_cast<uint8_t>(limbs.limb[i / 8] >> (8 * (i % 8)));
+    }
+}
+
+// RFC 8032, section 5.1.5: the scalar from the first half of the hashed secret
+void clamp(uint8_t* a, const uint8_t* h) {
+    for (std::size_t i = 0; i < 32; i++) {
+        a[i] = h[i];
+    }
+    a[0] &= 248;
+    a[31] &= 127;
+    a[31] |= 64;
+}
+
+// SHA-512(R || A || message), the challenge before reduction mod L
+void challenge(uint8_t* h, const uint8_t* R, const uint8_t* A, const uint8_t* message, std::size_t len) {
+    Sha512 sha;
+    sha.update(R, 32);
+    sha.update(A, 32);
+    sha.update(message, len);
+    sha.finish(h);
+}
+
+// k[0, 32) as 64 digits in [-8, 8), least significant first, for k below 2^255
+void signed_nibbles(const uint8_t* k, int8_t* e) {
+    for (std::size_t i = 0; i < 32; i++) {
+        e[2 * i] = static_cast<int8_t>(k[i] & 15);
+        e[2 * i + 1] = static_cast<int8_t>(k[i] >> 4);
+    }
+    int8_t carry = 0;
+    for (std::size_t i = 0; i < 63; i++) {
+        e[i] = static_cast<int8_t>(e[i] + carry);
+        carry = static_cast<int8_t>((e[i] + 8) >> 4);
+        e[i] = static_cast<int8_t>(e[i] - (carry << 4));
+    }
+    e[63] = static_cast<int8_t>(e[63] + carry);
+}
+
+const Ed25519Point::Cached IDENTITY_CACHED = {F(1), F(1), F(0), F(2)};
+
+void cmov(uint64_t mask, Ed25519Point::Cached& r, Ed25519Point::Cached q) {
+    F::cswap(mask, r.y_plus_x, q.y_plus_x);
+    F::cswap(mask, r.y_minus_x, q.y_minus_x);
+    F::cswap(mask, r.t2d, q.t2d);
+    F::cswap(mask, r.z2, q.z2);
+}
+
+// d * table[|d| - 1], table[j] being (j + 1) * P, reading every entry
+Ed25519Point::Cached select(const Ed25519Point::Cached* table, int8_t d) {
+    const uint8_t negative = static_cast<uint8_t>(d) >> 7;
+    const uint8_t magnitude = static_cast<uint8_t>((d ^ -negative) + negative);
+    Ed25519Point::Cached r = IDENTITY_CACHED;
+    for (uint8_t j = 1; j <= 8; j++) {
+        const uint64_t equal = static_cast<uint64_t>(static_cast<uint8_t>(magnitude ^ j)) - 1;
+        cmov(0 - (equal >> 63), r, table[j - 1]);
+    }
+    cmov(0 - static_cast<uint64_t>(negative), r, -r);
+    return r;
+}
+
+// table[8 i + j] = (j + 1) * 16^i * B
+std::vector<Ed25519Point::Cached> base_table() {
+    std::vector<Ed25519Point::Cached> table;
+    table.reserve(64 * 8);
+    Ed25519Point p = Ed25519Point::base();
+    for (std::size_t i = 0; i < 64; i++) {
+        const Ed25519Point::Cached step = p.cached();
+        Ed25519Point m = p;
+        for (std::size_t j = 0; j < 8; j++) {
+            table.push_back(m.cached());
+            m += step;
+        }
+        p = p.dbl().dbl().dbl().dbl();
+    }
+    return table;
+}
+
+// what verifying one signature needs beyond the equation
+struct Parsed {
+    Ed25519Point R, A;
+    integer s, k;
+    uint8_t h[64];
+};
+
+Status parse(const Ed25519Signed& item, Parsed& out) {
+    Result<Ed25519Point> A = Ed25519Point::from_bytes(item.public_key);
+    if (!A) {
+        return A.status();
+    }
+    Result<Ed25519Point> R = Ed25519Point::from_bytes(item.signature);
+    if (!R) {
+        return R.status();
+    }
+    out.s = from_le(item.signature + 32, 32);
+    if (out.s >= ed25519_order()) {
+        return Status::bad_encoding;
+    }
+    out.A = *A;
+    out.R = *R;
+    challenge(out.h, item.signature, item.public_key, item.message, item.length);
+    out.k = from_le(out.h, 64) % ed25519_order();
+    return Status::ok;
+}
+
+}
+
+Ed25519Point::Cached Ed25519Point::Cached::operator-() const {
+    return Cached{this->y_minus_x, this->y_plus_x, -this->t2d, this->z2};
+}
+
+Ed25519Point::Ed25519Point() : X(0), Y(1), Z(1), T(0) {}
+
+const Ed25519Point& Ed25519Point::base() {
+    static const Ed25519Point b = []() {
+        uint8_t y[32];
+        (F(4) * F(5).inverse()).to_bytes(y);
+        return *from_bytes(y);
+    }();
+    return b;
+}
+
+// x^2 = (y^2 - 1) / (d y^2 + 1) = u / v, and x = u v^3 (u v^7)^((p - 5) / 8)
+// is a root of it or of -u / v, the latter fixed by sqrt(-1)
+Result<Ed25519Point> Ed25519Point::from_bytes(const uint8_t* in) noexcept {
+    const Constants& c = constants();
+    const F y = F::from_bytes(in);
+    uint8_t canonical[32];
+    y.to_bytes(canonical);
+    uint8_t diff = static_cast<uint8_t>(canonical[31] ^ (in[31] & 0x7F));
+    for (std::size_t i = 0; i < 31; i++) {
+        diff |= canonical[i] ^ in[i];
+    }
+    if (diff) {
+        return Status::bad_encoding;
+    }
+    const bool sign = in[31] >> 7;
+
+    const F yy = y.square();
+    const F u = yy - F(1);
+    const F v = c.d * yy + F(1);
+    const F v3 = v.square() * v;
+    F x = u * v3 * (u * v3.square() * v).pow_p58();
+    const F vxx = v * x.square();
+    if (vxx != u) {
+        if (vxx != F(1) - yy) {
+            return Status::not_on_curve;
+        }
+        x = x * c.sqrt_m1;
+    }
+    if (x.is_zero() && sign) {
+        return Status::bad_encoding;
+    }
+    if (x.is_odd() != sign) {
+        x = (-x).weak_reduce();
+    }
+    return Ed25519Point(x, y, F(1), x * y);
+}
+
+void Ed25519Point::to_bytes(uint8_t* out) const {
+    const F z_inv = this->Z.inverse();
+    (this->Y * z_inv).to_bytes(out);
+    out[31] |= static_cast<uint8_t>((this->X * z_inv).is_odd() << 7);
+}
+
+Ed25519Point::Cached Ed25519Point::cached() const {
+    return Cached{this->Y + this->X, this->Y - this->X, this->T * constants().d2, this->Z + this->Z};
+}
+
+// add-2008-hwcd-3 with the addend's products by 2d and 2 done ahead
+Ed25519Point Ed25519Point::operator+(const Cached& other) const {
+    const F a = (this->Y + this->X) * other.y_plus_x;
+    const F b = (this->Y - this->X) * other.y_minus_x;
+    const F c = this->T * other.t2d;
+    const F d = this->Z * other.z2;
+    const F e = a - b, h = a + b, g = d + c, f = d - c;
+    return Ed25519Point(e * f, g * h, f * g, e * h);
+}
+
+Ed25519Point Ed25519Point::operator-() const {
+    return Ed25519Point(-this->X, this->Y, this->Z, -this->T);
+}
+
+// dbl-2008-hwcd with every coordinate negated, which is the same point; 2Z^2 + X^2
+// is summed before Y^2 is taken off so that no limb can go below zero
+Ed25519Point Ed25519Point::dbl() const {
+    const F xx = this->X.square();
+    const F yy = this->Y.square();
+    const F zz = this->Z.square();
+    const F h = yy + xx;
+    const F g = yy - xx;
+    const F e = (this->X + this->Y).square() - h;
+    const F f = (zz + zz + xx) - yy;
+    return Ed25519Point(e * f, h * g, g * f, e * h);
+}
+
+Ed25519Point Ed25519Point::mul(const uint8_t* k) const {
+    Cached table[8];
+    const Cached step = cached();
+    Ed25519Point m = *this;
+    for (std::size_t j = 0; j < 8; j++) {
+        table[j] = m.cached();
+        m += step;
+    }
+    int8_t e[64];
+    signed_nibbles(k, e);
+    Ed25519Point r;
+    for (std::size_t i = 64; i-- > 0;) {
+        r = r.dbl().dbl().dbl().dbl();
+        r += select(table, e[i]);
+    }
+    return r;
+}
+
+Ed25519Point Ed25519Point::mul_base(const uint8_t* k) {
+    static const std::vector<Cached> table = base_table();
+    int8_t e[64];
+    signed_nibbles(k, e);
+    Ed25519Point r;
+    for (std::size_t i = 0; i < 64; i++) {
+        r += select(&table[8 * i], e[i]);
+    }
+    return r;
+}
+
+bool Ed25519Point::is_identity() const {
+    return this->X.is_zero() && this->Y == this->Z;
+}
+
+bool operator==(const Ed25519Point& lhs, const Ed25519Point& rhs) {
+    return lhs.X * rhs.Z == rhs.X * lhs.Z && lhs.Y * rhs.Z == rhs.Y * lhs.Z;
+}
+
+const integer& ed25519_order() {
+    static const integer order = []() {
+        uint256 limbs;
+        for (std::size_t i = 0; i < 4; i++) {
+            limbs.limb[i] = ORDER[i];
+        }
+        return limbs.to_integer();
+    }();
+    return order;
+}
+
+void ed25519_public_key(uint8_t* out, const uint8_t* secret) {
+    uint8_t h[64], a[32];
+    Sha512::hash(secret, 32, h);
+    clamp(a, h);
+    Ed25519Point::mul_base(a).to_bytes(out);
+}
+
+void ed25519_sign(uint8_t* signature, const uint8_t* message, std::size_t len, const uint8_t* secret) {
+    uint8_t h[64], a[32], A[32];
+    Sha512::hash(secret, 32, h);
+    clamp(a, h);
+    Ed25519Point::mul_base(a).to_bytes(A);
+
+    uint8_t nonce[64], r_bytes[32];
+    Sha512 sha;
+    sha.update(h + 32, 32);
+    sha.update(message, len);
+    sha.finish(nonce);
+    const integer r = from_le(nonce, 64) % ed25519_order();
+    to_le(r, r_bytes);
+    Ed25519Point::mul_base(r_bytes).to_bytes(signature);
+
+    uint8_t k[64];
+    challenge(k, signature, A, message, len);
+    to_le((r + (from_le(k, 64) % ed25519_order()) * from_le(a, 32)) % ed25519_order(), signature + 32);
+}
+
+Status ed25519_verify(const uint8_t* signature, const uint8_t* message, std::size_t len,
+                      const uint8_t* public_key) noexcept {
+    Parsed parsed;
+    const Status status = parse(Ed25519Signed{signature, message, len, public_key}, parsed);
+    if (status != Status::ok) {
+        return status;
+    }
+    uint8_t k[32];
+    to_le(parsed.k, k);
+    const Ed25519Point check = Ed25519Point::mul_base(signature + 32) - parsed.A.mul(k) - parsed.R;
+    return check.mul_by_cofactor().is_identity() ? Status::ok : Status::bad_signature;
+}
+
+Status ed25519_verify_batch(const std::vector<Ed25519Signed>& items, unsigned threads) {
+    ThreadExecutor executor(threads);
+    return ed25519_verify_batch(items, executor);
+}
+
+Status ed25519_verify_batch(const std::vector<Ed25519Signed>& items, Executor& executor) {
+    if (items.empty()) {
+        return Status::ok;
+    }
+    std::vector<Parsed> parsed(items.size());
+    Sha512 seed_hash;
+    std::random_device device;
+    for (std::size_t i = 0; i < 8; i++) {
+        const uint32_t word = device();
+        const uint8_t bytes[4] = {static_cast<uint8_t>(word), static_cast<uint8_t>(word >> 8),
+                                  static_cast<uint8_t>(word >> 16), static_cast<uint8_t>(word >> 24)};
+        seed_hash.update(bytes, 4);
+    }
+    for (std::size_t i = 0; i < items.size(); i++) {
+        const Status status = parse(items[i], parsed[i]);
+        if (status != Status::ok) {
+            return status;
+        }
+        seed_hash.update(items[i].signature, 64);
+        seed_hash.update(items[i].public_key, 32);
+        seed_hash.update(parsed[i].h, 64);
+    }
+    uint8_t seed[64];
+    seed_hash.finish(seed);
+
+    const integer& order = ed25519_order();
+    std::vector<integer> scalars(1);
+    std::vector<Ed25519Point::Cached> points(1, Ed25519Point::base().cached());
+    integer base_scalar;
+    // z_i the next 128 bits of ChaCha20 keyed by the seed's first half
+    ChaCha20Rng rng(seed);
+    std::vector<uint8_t> randomizers(16 * items.size());
+    rng.fill(randomizers.data(), randomizers.size());
+    for (std::size_t i = 0; i < items.size(); i++) {
+        const integer z = from_le(randomizers.data() + 16 * i, 16);
+
+        base_scalar += z * parsed[i].s;
+        scalars.push_back(z);
+        points.push_back(parsed[i].R.cached());
+        scalars.push_back(z * parsed[i].k % order);
+        points.push_back(parsed[i].A.cached());
+    }
+    scalars[0] = (order - base_scalar % order) % order;
+
+    const Ed25519Point sum = bucket_msm(scalars, points, pippenger_window(points.size(), order.bit_length()),
+                                        Ed25519Point(), [](Ed25519Point::Cached*, std::size_t, Scratch&) {},
+                                        executor.function(), executor.concurrency(), Scratch::local());
+    return sum.mul_by_cofactor().is_identity() ? Status::ok : Status::bad_signature;
+}
+
+#endif
@@ -0,0 +1,117 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_ED25519_H
+#define ECC_ED25519_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Curve25519Field51.h"
+#include "Executor.h"
+#include "integer.h"
+#include "Status.h"
+
+// Ed25519 (RFC 8032) runs on Curve25519Field51, so it is there only where that is
+#if defined(__SIZEOF_INT128__)
+
+// A point of the twisted Edwards curve -x^2 + y^2 = 1 + d x^2 y^2 over
+// GF(2^255 - 19), d = -121665 / 121666, in the extended coordinates of
+// Hisil, Wong, Carter and Dawson: (X : Y : Z : T) with x = X / Z, y = Y / Z and
+// xy = T / Z. The addition law is complete, so one formula adds every pair of
+// points, the identity and a point to itself included, and nothing branches
+// on the points. Adding a Cached point takes 8 multiplications, a doubling 4
+// and 4 squarings.
+class Ed25519Point {
+public:
+    // (Y + X, Y - X, 2dT, 2Z): an addend with its share of the addition done
+    // once, for points that are added many times
+    struct Cached {
+        Curve25519Field51 y_plus_x, y_minus_x, t2d, z2;
+        Cached operator-() const;
+    };
+
+    // the identity (0, 1)
+    Ed25519Point();
+    // the base point B of RFC 8032, with y = 4 / 5 and x even
+    static const Ed25519Point& base();
+
+    // RFC 8032, section 5.1.3: Status::bad_encoding for a y not below p or x = 0
+    // with the sign bit set, Status::not_on_curve when no x fits y
+    static Result<Ed25519Point> from_bytes(const uint8_t* in) noexcept;
+    // y little-endian in out[0, 32), the low bit of x in the top bit
+    void to_bytes(uint8_t* out) const;
+
+    Cached cached() const;
+    Ed25519Point operator+(const Cached& other) const;
+    Ed25519Point operator-(const Cached& other) const { return *this + -other; }
+    Ed25519Point operator+(const Ed25519Point& other) const { return *this + other.cached(); }
+    Ed25519Point operator-(const Ed25519Point& other) const { return *this - other.cached(); }
+    Ed25519Point& operator+=(const Cached& other) { return *this = *this + other; }
+    Ed25519Point& operator-=(const Cached& other) { return *this = *this - other; }
+    Ed25519Point& operator+=(const Ed25519Point& other) { return *this = *this + other; }
+    Ed25519Point operator-() const;
+    Ed25519Point dbl() const;
+    // 8 * *this, which is the identity exactly for the points of small order
+    Ed25519Point mul_by_cofactor() const { return dbl().dbl().dbl(); }
+
+    // k * *this for the little-endian k[0, 32) below 2^255, in signed 4-bit
+    // windows whose table entries are picked by mask: the same steps for every k
+    Ed25519Point mul(const uint8_t* k) const;
+    // k * B the same way from a table of every multiple of B a window can
+    // need, built on first use: 64 additions and no doublings
+    static Ed25519Point mul_base(const uint8_t* k);
+
+    bool is_identity() const;
+    friend bool operator==(const Ed25519Point& lhs, const Ed25519Point& rhs);
+    friend bool operator!=(const Ed25519Point& lhs, const Ed25519Point& rhs) { return !(lhs == rhs); }
+
+private:
+    Curve25519Field51 X, Y, Z, T;
+
+    Ed25519Point(const Curve25519Field51& X, const Curve25519Field51& Y, const Curve25519Field51& Z,
+                 const Curve25519Field51& T)
+            : X(X), Y(Y), Z(Z), T(T) {}
+};
+
+// the order L = 2^252 + 27742317777372353535851937790883648493 of B
+const integer& ed25519_order();
+
+// RFC 8032, section 5.1.5: the 32-byte public key of a 32-byte secret key
+void ed25519_public_key(uint8_t* out, const uint8_t* secret);
+// RFC 8032, section 5.1.6: the 64-byte signature of message[0, len). The
+// point multiplications do not depend on the secret, but the arithmetic mod L
+// runs on integer, which is not constant time.
+void ed25519_sign(uint8_t* signature, const uint8_t* message, std::size_t len, const uint8_t* secret);
+
+// RFC 8032, section 5.1.7, with the cofactored equation 8SB = 8R + 8kA:
+// Status::ok, Status::bad_encoding for an R or public key that does not decode
+// or S not below L, Status::not_on_curve as from_bytes, and Status::bad_signature
+// when the equation fails
+Status ed25519_verify(const uint8_t* signature, const uint8_t* message, std::size_t len,
+                      const uint8_t* public_key) noexcept;
+
+struct Ed25519Signed {
+    const uint8_t* signature;       // 64 bytes
+    const uint8_t* message;
+    std::size_t length;
+    const uint8_t* public_key;      // 32 bytes
+};
+
+// Whether every one of items verifies, as one multi-scalar multiplication:
+// with random 128-bit z_i, 8((-sum z_i S_i) B + sum z_i R_i + sum z_i k_i A_i)
+// is the identity, 2n + 1 points through bucket_msm (threads as in pippenger).
+// The cofactored check of ed25519_verify is the same per signature, so the two
+// agree except with probability 2^-128 when some signature is bad. Returns
+// the first decoding failure, or Status::bad_signature without saying which
+// one failed; ed25519_verify on each finds it. The z_i are the ChaCha20Rng
+// stream of a seed hashed from the inputs and std::random_device.
+Status ed25519_verify_batch(const std::vector<Ed25519Signed>& items, unsigned threads = 1);
+// the same with the multiplication run on executor
+Status ed25519_verify_batch(const std::vector<Ed25519Signed>& items, Executor& executor);
+
+#endif
+
+#endif //ECC_ED25519_H
@@ -0,0 +1,363 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "elgamal.h"
+
+namespace {
+
+// points normalized with one inversion while the table is built
+constexpr std::size_t BATCH = 1024;
+// seed of the hashes of x in the slots; saved tables depend on it
+constexpr uint64_t HASH_SEED = 0x9e3779b97f4a7c15;
+// "ECCELGBS"
+constexpr uint64_t MAGIC = 0x534247454c454345;
+// magic, version, curve, bound, baby steps, slots
+constexpr std::size_t HEADER_WORDS = 6;
+
+const Point& checked_key(const Curve& curve, const Point& key) {
+    if (key.is_infinity() || Curve::of(key) != &curve) {
+        throw std::invalid_argument("ElGamal key must be a finite point of " + curve.name());
+    }
+    return key;
+}
+
+void check_scalar(const Curve& curve, const integer& k) {
+    if (k < 0 || k >= curve.n()) {
+        throw std::invalid_argument("ElGamal plaintext and randomness must be in [0, n)");
+    }
+}
+
+// the affine x of a finite normalized point, hashed the same in every process
+uint64_t x_hash(const Point& p) {
+    return p.x().value().hash(HASH_SEED);
+}
+
+// the field, a, b and generator of curve, for the header of saved tables
+uint64_t curve_id(const Curve& curve) {
+    uint64_t h = HASH_SEED;
+    for (const integer& v : {curve.p(), curve.a().value(), curve.b().value(), curve.generator().x().value(),
+                             curve.generator().y().value()}) {
+        h = v.hash(h);
+    }
+    return h;
+}
+
+// FNV-1a over the bytes of words[0, count), as FixedBaseTable's files
+uint64_t checksum(const uint64_t* words, std::size_t count) {
+    uint64_t h = 0xcbf29ce484222325;
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(words);
+    for (std::size_t i = 0; i < count * sizeof(uint64_t); i++) {
+        h = (h ^ bytes[i]) * 0x100000001b3;
+    }
+    return h;
+}
+
+// the whole file as words: mapped read-only where there is mmap, so every
+// process reading it shares the page cache, and read into memory elsewhere
+std::shared_ptr<const uint64_t> map_file(const std::string& path, std::size_t& words) {
+#if defined(__unix__) || defined(__APPLE__)
+    const int fd = open(path.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size <= 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        throw std::runtime_error("Cannot read table file " + path);
+    }
+    const std::size_t size = static_cast<std::size_t>(st.st_size);
+    void* map = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        throw std::runtime_error("Cannot map table file " + path);
+    }
+    words = size / sizeof(uint64_t);
+    return std::shared_ptr<const uint64_t>(static_cast<const uint64_t*>(map),
+                                           [size](const uint64_t* p) { munmap(const_cast<uint64_t*>(p), size); });
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("Cannot read table file " + path);
+    }
+    const std::size_t size = static_cast<std::size_t>(in.tellg());
+    words = size / sizeof(uint64_t);
+    std::shared_ptr<uint64_t> data(new uint64_t[words + 1](), std::default_delete<uint64_t[]>());
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(data.get()), static_cast<std::streamsize>(words * sizeof(uint64_t)));
+    if (!in) {
+        throw std::runtime_error("Cannot read table file " + path);
+    }
+    return data;
+#endif
+}
+
+std::size_t slot_count(uint64_t steps) {
+    std::size_t capacity = 1;
+    while (capacity < 2 * steps) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+unsigned step_bits(uint64_t steps) {
+    unsigned bits = 1;
+    while (bits < 64 && (uint64_t(1) << bits) <= steps) {
+        bits++;
+    }
+    return bits;
+}
+
+}
+
+ElGamalEncryptor::ElGamalEncryptor(const Curve& curve, const Point& key, std::size_t w)
+        : c(&curve), h(checked_key(curve, key).normalized(), curve.scalar_field().bits(), w) {}
+
+ElGamalCiphertext ElGamalEncryptor::encrypt(const integer& m, const integer& r) const {
+    check_scalar(*this->c, m);
+    check_scalar(*this->c, r);
+    const FixedBaseTable& g = this->c->generator_table();
+    return {g.mul(r), g.mul(m) + this->h.mul(r)};
+}
+
+ElGamalCiphertext ElGamalEncryptor::encrypt(const integer& m, ChaCha20Rng& rng) const {
+    return encrypt(m, rng.random_below(this->c->n()));
+}
+
+std::vector<ElGamalCiphertext> ElGamalEncryptor::encrypt_batch(const std::vector<integer>& m,
+                                                               ChaCha20Rng& rng) const {
+    std::vector<Point> points;
+    points.reserve(2 * m.size());
+    for (const integer& v : m) {
+        ElGamalCiphertext c = encrypt(v, rng);
+        points.push_back(std::move(c.c1));
+        points.push_back(std::move(c.c2));
+    }
+    Point::batch_normalize(points);
+    std::vector<ElGamalCiphertext> out;
+    out.reserve(m.size());
+    for (std::size_t i = 0; i < m.size(); i++) {
+        out.push_back({std::move(points[2 * i]), std::move(points[2 * i + 1])});
+    }
+    return out;
+}
+
+ElGamalCiphertext elgamal_add(const ElGamalCiphertext& a, const ElGamalCiphertext& b) {
+    return {a.c1 + b.c1, a.c2 + b.c2};
+}
+
+std::vector<ElGamalCiphertext> elgamal_tally(const std::vector<ElGamalCiphertext>& ballots, std::size_t candidates,
+                                             Executor& executor) {
+    if (candidates == 0 || ballots.size() % candidates != 0) {
+        throw std::invalid_argument("Ballots must hold one ciphertext per candidate");
+    }
+    if (ballots.empty()) {
+        throw std::invalid_argument("No ballots to tally");
+    }
+    const std::size_t count = ballots.size() / candidates;
+    const std::size_t ranges = std::min(count, 4 * executor.concurrency());
+    const Point zero(ballots[0].c1.curve_a(), ballots[0].c1.curve_b());
+
+    // c1 then c2 of every candidate, per range
+    std::vector<std::vector<Point>> partial(ranges, std::vector<Point>(2 * candidates, zero));
+    std::exception_ptr error;
+    std::mutex lock;
+    executor.run(ranges, [&](std::size_t r) {
+        try {
+            std::vector<Point>& sums = partial[r];
+            for (std::size_t i = count * r / ranges; i < count * (r + 1) / ranges; i++) {
+                const ElGamalCiphertext* ballot = ballots.data() + i * candidates;
+                for (std::size_t j = 0; j < candidates; j++) {
+                    sums[2 * j] += ballot[j].c1;
+                    sums[2 * j + 1] += ballot[j].c2;
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(lock);
+            error = std::current_exception();
+        }
+    });
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    std::vector<Point>& sums = partial[0];
+    for (std::size_t r = 1; r < ranges; r++) {
+        for (std::size_t k = 0; k < sums.size(); k++) {
+            sums[k] += partial[r][k];
+        }
+    }
+    Point::batch_normalize(sums);
+    std::vector<ElGamalCiphertext> out;
+    out.reserve(candidates);
+    for (std::size_t j = 0; j < candidates; j++) {
+        out.push_back({std::move(sums[2 * j]), std::move(sums[2 * j + 1])});
+    }
+    return out;
+}
+
+std::vector<Point> elgamal_decrypt_points(const integer& secret, const std::vector<ElGamalCiphertext>& ciphertexts) {
+    std::vector<Point> points;
+    points.reserve(ciphertexts.size());
+    for (const ElGamalCiphertext& c : ciphertexts) {
+        points.push_back(c.c2 - c.c1 * secret);
+    }
+    Point::batch_normalize(points);
+    return points;
+}
+
+ElGamalDlogTable::ElGamalDlogTable(const Curve& curve, uint64_t bound, uint64_t baby_steps,
+                                   std::shared_ptr<const uint64_t> slots)
+        : c(&curve), max(bound), m(baby_steps), capacity(slot_count(baby_steps)), bits(step_bits(baby_steps)),
+          slots(std::move(slots)) {}
+
+ElGamalDlogTable::ElGamalDlogTable(const Curve& curve, uint64_t bound, uint64_t baby_steps)
+        : c(&curve), max(bound), m(baby_steps) {
+    if (bound < 1) {
+        throw std::invalid_argument("Plaintext bound must be positive");
+    }
+    if (baby_steps > MAX_BABY_STEPS) {
+        throw std::invalid_argument("Too many baby steps for an ElGamal table");
+    }
+    if (this->m == 0) {
+        this->m = static_cast<uint64_t>(isqrt(integer(bound / 2))) + 1;
+    }
+    this->capacity = slot_count(this->m);
+    this->bits = step_bits(this->m);
+
+    // j G for j = 1, .., m
+    std::shared_ptr<uint64_t> table(new uint64_t[this->capacity](), std::default_delete<uint64_t[]>());
+    uint64_t* s = table.get();
+    const Point& g = curve.generator();
+    Point p = curve.infinity();
+    std::vector<Point> batch;
+    for (uint64_t first = 1; first <= this->m; first += BATCH) {
+        batch.clear();
+        for (uint64_t j = first; j <= this->m && j < first + BATCH; j++) {
+            p += g;
+            batch.push_back(p);
+        }
+        Point::batch_normalize(batch);
+        for (std::size_t k = 0; k < batch.size(); k++) {
+            if (batch[k].is_infinity()) {
+                continue;
+            }
+            const uint64_t hash = x_hash(batch[k]);
+            std::size_t i = hash & (this->capacity - 1);
+            while (s[i]) {
+                i = (i + 1) & (this->capacity - 1);
+            }
+            s[i] = fingerprint(hash) | (first + k);
+        }
+    }
+    this->slots = table;
+}
+
+std::vector<Result<uint64_t>> ElGamalDlogTable::solve(const std::vector<Point>& points) const {
+    std::vector<Result<uint64_t>> out(points.size(), Status::out_of_range);
+    const FixedBaseTable& comb = this->c->generator_table();
+    const uint64_t mask = (uint64_t(1) << this->bits) - 1;
+    const uint64_t* s = this->slots.get();
+
+    // P - i s G for s = 2m + 1 and i = 0, .., (bound + m) / s: P = (i s + j) G or (i s - j) G
+    const integer stride = 2 * integer(this->m) + 1;
+    const Point step = (-(this->c->generator() * stride)).normalized();
+    const uint64_t giants = (this->max + this->m) / (2 * this->m + 1) + 1;
+
+    std::vector<Point> walk(points);
+    std::vector<std::size_t> index(points.size());
+    for (std::size_t k = 0; k < index.size(); k++) {
+        index[k] = k;
+    }
+    for (uint64_t i = 0; i < giants && !walk.empty(); i++) {
+        Point::batch_normalize(walk);
+        const integer offset = integer(i) * stride;
+        std::size_t left = 0;
+        for (std::size_t k = 0; k < walk.size(); k++) {
+            const Point& target = points[index[k]];
+            bool found = false;
+            if (walk[k].is_infinity()) {
+                if (offset < integer(this->max)) {
+                    out[index[k]] = static_cast<uint64_t>(offset);
+                    found = true;
+                }
+            } else {
+                const uint64_t hash = x_hash(walk[k]);
+                for (std::size_t n = hash & (this->capacity - 1); s[n] && !found;
+                     n = (n + 1) & (this->capacity - 1)) {
+                    if ((s[n] & ~mask) != fingerprint(hash)) {
+                        continue;
+                    }
+                    const integer j(s[n] & mask);
+                    for (const integer& x : {offset + j, offset - j}) {
+                        if (!found && x >= 0 && x < integer(this->max) && comb.mul(x) == target) {
+                            out[index[k]] = static_cast<uint64_t>(x);
+                            found = true;
+                        }
+                    }
+                }
+            }
+            if (!found) {
+                walk[left] = walk[k] + step;
+                index[left] = index[k];
+                left++;
+            }
+        }
+        walk.erase(walk.begin() + static_cast<std::ptrdiff_t>(left), walk.end());
+        index.resize(left);
+    }
+    return out;
+}
+
+void ElGamalDlogTable::save(const std::string& path) const {
+    std::vector<uint64_t> file = {MAGIC, VERSION, curve_id(*this->c), this->max, this->m, this->capacity};
+    file.insert(file.end(), this->slots.get(), this->slots.get() + this->capacity);
+    file.push_back(checksum(file.data(), file.size()));
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(file.data()),
+              static_cast<std::streamsize>(file.size() * sizeof(uint64_t)));
+    if (!out) {
+        throw std::runtime_error("Cannot write table file " + path);
+    }
+}
+
+ElGamalDlogTable ElGamalDlogTable::load(const std::string& path, const Curve& curve) {
+    std::size_t words = 0;
+    const std::shared_ptr<const uint64_t> file = map_file(path, words);
+    const uint64_t* h = file.get();
+    if (words < HEADER_WORDS || h[0] != MAGIC) {
+        throw std::runtime_error("Not an ElGamal table file: " + path);
+    }
+    if (h[1] != VERSION) {
+        throw std::runtime_error("Unsupported ElGamal table version in " + path);
+    }
+    if (h[3] < 1 || h[4] < 1 || h[4] > MAX_BABY_STEPS || h[5] != slot_count(h[4]) ||
+        words != HEADER_WORDS + h[5] + 1) {
+        throw std::runtime_error("Corrupt ElGamal table file " + path);
+    }
+    if (checksum(h, words - 1) != h[words - 1]) {
+        throw std::runtime_error("Checksum mismatch in ElGamal table file " + path);
+    }
+    if (h[2] != curve_id(curve)) {
+        throw std::invalid_argument("Table file " + path + " was built for another curve");
+    }
+    // the slots start after the header; sharing ownership keeps the mapping alive
+    return ElGamalDlogTable(curve, h[3], h[4], std::shared_ptr<const uint64_t>(file, h + HEADER_WORDS));
+}
+
+std::vector<Result<uint64_t>> elgamal_decrypt(const ElGamalDlogTable& table, const integer& secret,
+                                              const std::vector<ElGamalCiphertext>& ciphertexts) {
+    return table.solve(elgamal_decrypt_points(secret, ciphertexts));
+}
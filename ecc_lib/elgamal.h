@@ -0,0 +1,137 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_ELGAMAL_H
+#define ECC_ELGAMAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "chacha20.h"
+#include "Curve.h"
+#include "Executor.h"
+#include "FixedBaseTable.h"
+#include "integer.h"
+#include "Point.h"
+#include "Status.h"
+
+// EC-ElGamal in the exponent, for tallies: m is encrypted to the key H = xG as
+// (rG, mG + rH), so the sum of two ciphertexts encrypts the sum of their
+// plaintexts, and decryption gives back mG, from which m is found by a
+// discrete log over a small range (ElGamalDlogTable). Each step is batched:
+// encryption reads fixed-base combs of G and H, sums stay in Jacobian
+// coordinates with one normalization at the end, and the logs of many mG are
+// searched together, each giant step of all of them normalized with one
+// inversion. Not constant time.
+
+struct ElGamalCiphertext {
+    Point c1;       // rG
+    Point c2;       // mG + rH
+};
+
+// encryption to one key: a comb of H (FixedBaseTable, windows of w bits) is
+// built once, the one of G is the curve's
+class ElGamalEncryptor {
+public:
+    // throws std::invalid_argument if key is not a finite point of curve
+    ElGamalEncryptor(const Curve& curve, const Point& key, std::size_t w = 4);
+
+    const Curve& curve() const { return *this->c; }
+    const Point& key() const { return this->h.base(); }
+
+    // (rG, mG + rH), not normalized; throws std::invalid_argument for m or r
+    // not in [0, n)
+    ElGamalCiphertext encrypt(const integer& m, const integer& r) const;
+    // the same with r drawn from rng
+    ElGamalCiphertext encrypt(const integer& m, ChaCha20Rng& rng = ChaCha20Rng::local()) const;
+    // every m[i] under its own r, all of the points normalized with one inversion
+    std::vector<ElGamalCiphertext> encrypt_batch(const std::vector<integer>& m,
+                                                 ChaCha20Rng& rng = ChaCha20Rng::local()) const;
+
+private:
+    const Curve* c;
+    FixedBaseTable h;
+};
+
+// the ciphertext of the sum of a's and b's plaintexts
+ElGamalCiphertext elgamal_add(const ElGamalCiphertext& a, const ElGamalCiphertext& b);
+
+// The tally of count ballots of candidates ciphertexts each, ballot i's
+// ciphertext for candidate j at ballots[i * candidates + j]: the sum for every
+// candidate, normalized together with one inversion. The ballots are cut into
+// ranges summed on executor in Jacobian coordinates (mixed additions for
+// normalized ballots), and the partial sums added at the end. Throws
+// std::invalid_argument if ballots is empty or not whole ballots, and what the
+// additions throw for points of another curve
+std::vector<ElGamalCiphertext> elgamal_tally(const std::vector<ElGamalCiphertext>& ballots, std::size_t candidates,
+                                             Executor& executor);
+
+// mG = c2 - secret * c1 for every ciphertext, normalized with one inversion
+std::vector<Point> elgamal_decrypt_points(const integer& secret, const std::vector<ElGamalCiphertext>& ciphertexts);
+
+// Discrete logs base G of plaintexts in [0, bound), by baby-step giant-step
+// with the baby steps kept: the hashes of the x of jG for j = 1, .., m in
+// open-addressing slots of 64 bits (the step in the low bits, the rest of the
+// hash above, linear probing over a power of two of slots at most half full),
+// so a giant step P - i(2m + 1)G matches +j and -j alike. Built once per
+// bound, under 32 m bytes; save() writes it to a file that load() maps
+// read-only, so every tallying process shares its pages. m defaults to
+// isqrt(bound / 2) + 1, the fewest additions for one log; a larger m takes
+// fewer giant steps for each of many
+class ElGamalDlogTable {
+public:
+    // the most baby steps, 2^32
+    static constexpr uint64_t MAX_BABY_STEPS = uint64_t(1) << 32;
+
+    // throws std::invalid_argument for bound < 1 or baby_steps above MAX_BABY_STEPS
+    ElGamalDlogTable(const Curve& curve, uint64_t bound, uint64_t baby_steps = 0);
+
+    const Curve& curve() const { return *this->c; }
+    uint64_t bound() const { return this->max; }
+    uint64_t baby_steps() const { return this->m; }
+    // number of slots
+    std::size_t size() const { return this->capacity; }
+
+    // the log of every point, Status::out_of_range for one that is not mG
+    // for m in [0, bound). The points walk their giant steps side by side, one
+    // inversion normalizing a step of all that are left, and a hash match is
+    // confirmed by a multiplication of the comb. Points of another curve throw
+    // std::runtime_error, as their sums do
+    std::vector<Result<uint64_t>> solve(const std::vector<Point>& points) const;
+
+    // Writes the table to path: a versioned header with the curve, bound and
+    // m, the slots, and a checksum of all of it, in host byte order. Throws
+    // std::runtime_error if the file cannot be written
+    void save(const std::string& path) const;
+    // Maps a file written by save() (read into memory where there is no mmap).
+    // Throws std::runtime_error if the file cannot be read, is not a table of
+    // this version or fails its checksum, and std::invalid_argument if it was
+    // built for another curve
+    static ElGamalDlogTable load(const std::string& path, const Curve& curve);
+
+private:
+    // layout version of save(); bump when the header or slots change
+    static constexpr uint64_t VERSION = 1;
+
+    const Curve* c;
+    uint64_t max;
+    uint64_t m;
+    std::size_t capacity;
+    unsigned bits;                      // of a step
+    // owned, or inside a file mapping
+    std::shared_ptr<const uint64_t> slots;
+
+    ElGamalDlogTable(const Curve& curve, uint64_t bound, uint64_t baby_steps, std::shared_ptr<const uint64_t> slots);
+    uint64_t fingerprint(uint64_t hash) const { return hash >> this->bits << this->bits; }
+};
+
+// the plaintexts of ciphertexts under secret, through table:
+// elgamal_decrypt_points, then table.solve
+std::vector<Result<uint64_t>> elgamal_decrypt(const ElGamalDlogTable& table, const integer& secret,
+                                              const std::vector<ElGamalCiphertext>& ciphertexts);
+
+#endif //ECC_ELGAMAL_H
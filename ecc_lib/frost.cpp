@@ -0,0 +1,408 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+
+#include "Curve.h"
+#include "decompress.h"
+#include "frost.h"
+#include "msm.h"
+#include "sec1.h"
+#include "sha256.h"
+#include "tagged_hash.h"
+#include "trace.h"
+
+namespace {
+
+// in[0, 32) as a scalar in [1, n), or false
+bool read_secret(const uint8_t* in, Scalar& out) {
+    const PrimeField& order = Curve::secp256k1().scalar_field();
+    const uint256 v = uint256::load_be(in, 32);
+    if (v.is_zero() || !(v < order.fixed_prime())) {
+        return false;
+    }
+    out = Scalar(v.to_integer(), order);
+    return true;
+}
+
+const Sha256Tag& nonce_tag() {
+    static const Sha256Tag& tag = Sha256Tag::named("FROST/nonce");
+    return tag;
+}
+
+const Sha256Tag& rho_tag() {
+    static const Sha256Tag& tag = Sha256Tag::named("FROST/rho");
+    return tag;
+}
+
+const Sha256Tag& message_tag() {
+    static const Sha256Tag& tag = Sha256Tag::named("FROST/msg");
+    return tag;
+}
+
+const Sha256Tag& commitments_tag() {
+    static const Sha256Tag& tag = Sha256Tag::named("FROST/com");
+    return tag;
+}
+
+// whether the normalized point p has even y
+bool even_y(const Point& p) {
+    return !p.y().value().test_bit(0);
+}
+
+void check_sizes(std::size_t threshold, std::size_t count) {
+    if (threshold < 1 || threshold > count || count > UINT32_MAX) {
+        throw std::invalid_argument("FROST needs 1 <= threshold <= participants < 2^32");
+    }
+}
+
+void write_identifier(uint32_t identifier, uint8_t* out) {
+    for (std::size_t j = 0; j < 4; j++) {
+        out[j] = static_cast<uint8_t>(identifier >> (8 * (3 - j)));
+    }
+}
+
+// nonce_generate: hash_FROST/nonce(32 bytes of rng || share), drawn again for 0
+Scalar nonce(const uint8_t* share, ChaCha20Rng& rng) {
+    const PrimeField& order = Curve::secp256k1().scalar_field();
+    for (;;) {
+        uint8_t random[32], digest[32];
+        rng.fill(random, 32);
+        TaggedHash(nonce_tag()).update(random, 32).update(share, 32).finish(digest);
+        const Scalar k = Scalar::from_bytes(digest, 32, order);
+        std::memset(digest, 0, 32);
+        if (!k.is_zero()) {
+            return k;
+        }
+    }
+}
+
+}
+
+Status frost_keygen(uint8_t* shares, uint8_t* public_shares, uint8_t* group_key, const uint8_t* secret,
+                    std::size_t threshold, std::size_t count, ChaCha20Rng& rng) {
+    check_sizes(threshold, count);
+    const Curve& curve = Curve::secp256k1();
+    const PrimeField& order = curve.scalar_field();
+    Scalar s(order);
+    if (secret) {
+        if (!read_secret(secret, s)) {
+            return Status::out_of_range;
+        }
+    } else {
+        s = Scalar(rng.random_below(curve.n() - 1) + 1, order);
+    }
+
+    // f(x) = s + a_1 x + .. + a_(t-1) x^(t-1), share i = f(i) by Horner's rule
+    std::vector<Scalar> coefficients(1, s);
+    for (std::size_t k = 1; k < threshold; k++) {
+        coefficients.push_back(rng.random_scalar(order));
+    }
+    std::vector<Point> points;
+    points.reserve(count + 1);
+    for (std::size_t i = 1; i <= count; i++) {
+        const Scalar x(integer(i), order);
+        Scalar y = coefficients.back();
+        for (std::size_t k = threshold - 1; k-- > 0;) {
+            y = y * x + coefficients[k];
+        }
+        y.to_bytes(shares + 32 * (i - 1));
+        points.push_back(curve.mul_base_ct(y.value()));
+    }
+    points.push_back(curve.mul_base_ct(s.value()));
+    std::vector<uint8_t> encoded(33 * (count + 1));
+    sec1_encode_batch(points, true, encoded.data(), encoded.size());
+    std::memcpy(public_shares, encoded.data(), 33 * count);
+    std::memcpy(group_key, encoded.data() + 33 * count, 33);
+    return Status::ok;
+}
+
+Status frost_preprocess(uint8_t* secnonces, uint8_t* commitments, std::size_t count, const uint8_t* share,
+                        ChaCha20Rng& rng) {
+    ECC_TRACE_SPAN("frost.preprocess");
+    const Curve& curve = Curve::secp256k1();
+    Scalar s(curve.scalar_field());
+    if (!read_secret(share, s)) {
+        return Status::out_of_range;
+    }
+    // D_0, E_0, D_1, .. so the encodings fall in place as D || E pairs
+    std::vector<Point> points;
+    points.reserve(2 * count);
+    for (std::size_t i = 0; i < count; i++) {
+        for (std::size_t k = 0; k < 2; k++) {
+            const Scalar nonce_k = nonce(share, rng);
+            nonce_k.to_bytes(secnonces + 64 * i + 32 * k);
+            points.push_back(curve.mul_base_ct(nonce_k.value()));
+        }
+    }
+    return sec1_encode_batch(points, true, commitments, FROST_COMMITMENT_SIZE * count);
+}
+
+FrostGroup::FrostGroup(const Point& q, std::size_t threshold, std::shared_ptr<const std::vector<Point>> keys)
+        : q(q), t(threshold), keys(std::move(keys)) {}
+
+Result<FrostGroup> FrostGroup::make(const uint8_t* group_key, const uint8_t* public_shares, std::size_t count,
+                                    std::size_t threshold) {
+    check_sizes(threshold, count);
+    const Curve& curve = Curve::secp256k1();
+    std::vector<uint8_t> keys(33 * (count + 1));
+    std::memcpy(keys.data(), public_shares, 33 * count);
+    std::memcpy(keys.data() + 33 * count, group_key, 33);
+    DecompressedKeys lifted = decompress_keys(keys.data(), count + 1, curve);
+    if (lifted.invalid_count()) {
+        return Status::not_on_curve;
+    }
+    const Point q = lifted.points.back();
+    lifted.points.pop_back();
+    return FrostGroup(q, threshold, std::make_shared<const std::vector<Point>>(std::move(lifted.points)));
+}
+
+void FrostGroup::x_only(uint8_t* out) const {
+    this->q.x().to_bytes(out, 32);
+}
+
+FrostSession::FrostSession(const FrostGroup& group, std::vector<Signer> signers, const Scalar& c, const uint8_t* rx,
+                           bool r_even)
+        : group(group), signers(std::move(signers)), c(c), r_even(r_even) {
+    std::memcpy(this->rx, rx, 32);
+}
+
+Result<FrostSession> FrostSession::start(const FrostGroup& group, const std::vector<FrostCommitment>& commitments,
+                                         const uint8_t* message, std::size_t len, std::size_t* culprit) {
+    ThreadExecutor executor(1);
+    return start(group, commitments, message, len, executor, culprit);
+}
+
+Result<FrostSession> FrostSession::start(const FrostGroup& group, const std::vector<FrostCommitment>& commitments,
+                                         const uint8_t* message, std::size_t len, Executor& executor,
+                                         std::size_t* culprit) {
+    ECC_TRACE_SPAN("frost.session");
+    const Curve& curve = Curve::secp256k1();
+    const PrimeField& order = curve.scalar_field();
+    const std::size_t count = commitments.size();
+    if (count < group.threshold()) {
+        return Status::out_of_range;
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        const uint32_t id = commitments[i].identifier;
+        if (id < 1 || id > group.size() || (i && id <= commitments[i - 1].identifier)) {
+            return Status::out_of_range;
+        }
+    }
+
+    // the commitment list, identifier (4 bytes, big-endian) || D || E each,
+    // hashed as one, and the points lifted together
+    std::vector<uint8_t> list(70 * count), points(FROST_COMMITMENT_SIZE * count);
+    for (std::size_t i = 0; i < count; i++) {
+        write_identifier(commitments[i].identifier, &list[70 * i]);
+        std::memcpy(&list[70 * i + 4], commitments[i].commitment, FROST_COMMITMENT_SIZE);
+        std::memcpy(&points[FROST_COMMITMENT_SIZE * i], commitments[i].commitment, FROST_COMMITMENT_SIZE);
+    }
+    const DecompressedKeys lifted = decompress_keys(points.data(), 2 * count, curve, executor);
+    for (std::size_t i = 0; i < count; i++) {
+        if (!lifted.valid(2 * i) || !lifted.valid(2 * i + 1)) {
+            if (culprit) {
+                *culprit = i;
+            }
+            return Status::not_on_curve;
+        }
+    }
+
+    // rho_i = hash_FROST/rho(Q || hash_FROST/msg(m) || hash_FROST/com(list) || i)
+    uint8_t prefix[33 + 32 + 32 + 4];
+    sec1_encode(group.point(), true, prefix, 33);
+    TaggedHash(message_tag()).update(message, len).finish(prefix + 33);
+    TaggedHash(commitments_tag()).update(list.data(), list.size()).finish(prefix + 65);
+    std::vector<Signer> signers;
+    signers.reserve(count);
+    std::vector<integer> scalars;
+    scalars.reserve(2 * count);
+    for (std::size_t i = 0; i < count; i++) {
+        uint8_t digest[32];
+        write_identifier(commitments[i].identifier, prefix + 97);
+        TaggedHash(rho_tag()).update(prefix, sizeof(prefix)).finish(digest);
+        const Scalar rho = Scalar::from_bytes(digest, 32, order);
+        signers.push_back({commitments[i].identifier, lifted.points[2 * i], lifted.points[2 * i + 1], rho,
+                           Scalar(order)});
+        scalars.push_back(1);
+        scalars.push_back(rho.value());
+    }
+
+    // lambda_i = prod x_j / (x_j - x_i) over j != i, the denominators inverted together
+    std::vector<Scalar> numerators, denominators;
+    for (std::size_t i = 0; i < count; i++) {
+        Scalar num(integer(1), order), den(integer(1), order);
+        const Scalar xi(integer(signers[i].identifier), order);
+        for (std::size_t j = 0; j < count; j++) {
+            if (j != i) {
+                const Scalar xj(integer(signers[j].identifier), order);
+                num *= xj;
+                den *= xj - xi;
+            }
+        }
+        numerators.push_back(num);
+        denominators.push_back(den);
+    }
+    Scalar::batch_invert(denominators);
+    for (std::size_t i = 0; i < count; i++) {
+        signers[i].lambda = numerators[i] * denominators[i];
+    }
+
+    Point r = multi_scalar_mul(scalars, lifted.points, executor);
+    if (r.is_infinity()) {
+        return Status::infinity;
+    }
+    r = r.normalized();
+    uint8_t rx[32], qx[32], digest[32];
+    r.x().to_bytes(rx, 32);
+    group.x_only(qx);
+    TaggedHash(BIP340_CHALLENGE_TAG).update(rx, 32).update(qx, 32).update(message, len).finish(digest);
+    return FrostSession(group, std::move(signers), Scalar::from_bytes(digest, 32, order), rx, even_y(r));
+}
+
+std::size_t FrostSession::find(uint32_t identifier) const {
+    const auto it = std::lower_bound(this->signers.begin(), this->signers.end(), identifier,
+                                     [](const Signer& s, uint32_t id) { return s.identifier < id; });
+    return it != this->signers.end() && it->identifier == identifier
+           ? static_cast<std::size_t>(it - this->signers.begin()) : this->signers.size();
+}
+
+Status FrostSession::sign(uint8_t* partial, uint8_t* secnonce, uint32_t identifier,
+                          const uint8_t* share) const noexcept {
+    const PrimeField& order = Curve::secp256k1().scalar_field();
+    Scalar d(order), e(order), s(order);
+    if (!read_secret(secnonce, d) || !read_secret(secnonce + 32, e) || !read_secret(share, s)) {
+        return Status::out_of_range;
+    }
+    const std::size_t i = find(identifier);
+    if (i == this->signers.size()) {
+        return Status::out_of_range;
+    }
+    // the nonces negated for R of odd y, the share for a group key of odd y
+    const limb_t r_mask = 0 - static_cast<limb_t>(!this->r_even);
+    const limb_t q_mask = 0 - static_cast<limb_t>(!even_y(this->group.point()));
+    d = Scalar::select(r_mask, -d, d);
+    e = Scalar::select(r_mask, -e, e);
+    s = Scalar::select(q_mask, -s, s);
+    const Signer& signer = this->signers[i];
+    const Scalar z = d + signer.rho * e + signer.lambda * this->c * s;
+    std::memset(secnonce, 0, FROST_SECNONCE_SIZE);
+    z.to_bytes(partial);
+    return Status::ok;
+}
+
+Status FrostSession::verify(uint32_t identifier, const uint8_t* partial) const noexcept {
+    const Curve& curve = Curve::secp256k1();
+    const uint256 z = uint256::load_be(partial, 32);
+    if (!(z < curve.scalar_field().fixed_prime())) {
+        return Status::bad_encoding;
+    }
+    const std::size_t i = find(identifier);
+    if (i == this->signers.size()) {
+        return Status::out_of_range;
+    }
+    const Signer& signer = this->signers[i];
+    // z G - lambda c g Y against D + rho E, negated for R of odd y
+    const Scalar key = signer.lambda * this->c;
+    const Point lhs = Point::mul_add(z.to_integer(), curve.generator(),
+                                     (even_y(this->group.point()) ? -key : key).value(),
+                                     this->group.public_share(identifier));
+    const Point r = signer.d + signer.e * signer.rho.value();
+    return lhs == (this->r_even ? r : -r) ? Status::ok : Status::bad_signature;
+}
+
+Status FrostSession::verify_batch(const uint8_t* partials, unsigned threads, std::size_t* culprit) const {
+    ThreadExecutor executor(threads);
+    return verify_batch(partials, executor, culprit);
+}
+
+Status FrostSession::verify_batch(const uint8_t* partials, Executor& executor, std::size_t* culprit) const {
+    ECC_TRACE_SPAN("frost.verify_batch");
+    const Curve& curve = Curve::secp256k1();
+    const PrimeField& order = curve.scalar_field();
+    const std::size_t count = this->signers.size();
+    // one by one for the first failure
+    const auto blame = [&]() {
+        for (std::size_t i = 0; i < count; i++) {
+            const Status status = verify(this->signers[i].identifier, partials + 32 * i);
+            if (status != Status::ok) {
+                if (culprit) {
+                    *culprit = i;
+                }
+                return status;
+            }
+        }
+        return Status::ok;
+    };
+
+    Sha256 seed_hash;
+    std::random_device device;
+    for (std::size_t i = 0; i < 8; i++) {
+        const uint32_t word = device();
+        const uint8_t bytes[4] = {static_cast<uint8_t>(word), static_cast<uint8_t>(word >> 8),
+                                  static_cast<uint8_t>(word >> 16), static_cast<uint8_t>(word >> 24)};
+        seed_hash.update(bytes, 4);
+    }
+    seed_hash.update(this->rx, 32);
+    for (std::size_t i = 0; i < count; i++) {
+        if (!(uint256::load_be(partials + 32 * i, 32) < order.fixed_prime())) {
+            return blame();
+        }
+    }
+    seed_hash.update(partials, 32 * count);
+    uint8_t seed[Sha256::DIGEST_SIZE];
+    seed_hash.finish(seed);
+
+    // (sum a_i z_i) G - sum a_i (D_i + rho_i E_i) (negated for odd R) - sum a_i lambda_i c g Y_i
+    // for a_1 = 1 and the next a_i 128 bits of ChaCha20 keyed by the seed
+    ChaCha20Rng rng(seed);
+    std::vector<uint8_t> randomizers(16 * count);
+    rng.fill(randomizers.data(), randomizers.size());
+    const Scalar one(integer(1), order);
+    const Scalar sign = this->r_even ? -one : one;
+    const Scalar key = even_y(this->group.point()) ? -this->c : this->c;
+    Scalar base(order);
+    std::vector<integer> scalars(1);
+    std::vector<Point> points(1, curve.generator());
+    scalars.reserve(3 * count + 1);
+    points.reserve(3 * count + 1);
+    for (std::size_t i = 0; i < count; i++) {
+        const Signer& signer = this->signers[i];
+        const Scalar a = i ? Scalar::from_bytes(randomizers.data() + 16 * i, 16, order) : one;
+        base += a * Scalar::from_bytes(partials + 32 * i, 32, order);
+        const Scalar ar = a * sign;
+        scalars.push_back(ar.value());
+        points.push_back(signer.d);
+        scalars.push_back((ar * signer.rho).value());
+        points.push_back(signer.e);
+        scalars.push_back((a * signer.lambda * key).value());
+        points.push_back(this->group.public_share(signer.identifier));
+    }
+    scalars[0] = base.value();
+    if (multi_scalar_mul(scalars, points, executor).is_infinity()) {
+        return Status::ok;
+    }
+    const Status status = blame();
+    return status == Status::ok ? Status::bad_signature : status;
+}
+
+Status FrostSession::aggregate(uint8_t* signature, const uint8_t* partials, std::size_t* culprit) const noexcept {
+    const PrimeField& order = Curve::secp256k1().scalar_field();
+    Scalar s(order);
+    for (std::size_t i = 0; i < this->signers.size(); i++) {
+        const uint256 z = uint256::load_be(partials + 32 * i, 32);
+        if (!(z < order.fixed_prime())) {
+            if (culprit) {
+                *culprit = i;
+            }
+            return Status::bad_encoding;
+        }
+        s += Scalar(z.to_integer(), order);
+    }
+    std::memcpy(signature, this->rx, 32);
+    s.to_bytes(signature + 32);
+    return Status::ok;
+}
@@ -0,0 +1,156 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_FROST_H
+#define ECC_FROST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "chacha20.h"
+#include "Executor.h"
+#include "Point.h"
+#include "Scalar.h"
+#include "Status.h"
+
+// FROST t-of-n threshold signatures on secp256k1 (RFC 9591's two rounds),
+// signing BIP340 signatures that schnorr_verify takes under the x-only group
+// key. Participants are numbered 1 to n. Round one is moved offline: each
+// participant makes nonce pairs (d, e) and their commitments (D, E) = (dG, eG)
+// ahead of time, in bulk. Round two costs the coordinator one multi_scalar_mul
+// for the group commitment R = sum D_i + rho_i E_i and each signer scalar
+// arithmetic only. Secret nonces are 64 bytes d || e, commitments 66, D || E
+// compressed, and shares and partial signatures 32; hashes are SHA-256 tagged
+// "FROST/...". A group key of odd y has its shares negated when they sign and
+// an R of odd y its nonces, as BIP340 keys and nonces are.
+
+constexpr std::size_t FROST_SECNONCE_SIZE = 64;
+constexpr std::size_t FROST_COMMITMENT_SIZE = 66;
+constexpr std::size_t FROST_PARTIAL_SIZE = 32;
+
+// A trusted dealer's keys: the secret (32 bytes, or random from rng when
+// null) split by a random polynomial of degree threshold - 1 into count
+// shares, share i at shares[32 (i - 1), 32 i) with its public share at
+// public_shares[33 (i - 1), 33 i), and the 33-byte group key. The public
+// points are made by the generator's comb and normalized together.
+// Status::out_of_range for a secret not in [1, n). Throws
+// std::invalid_argument unless 1 <= threshold <= count < 2^32
+Status frost_keygen(uint8_t* shares, uint8_t* public_shares, uint8_t* group_key, const uint8_t* secret,
+                    std::size_t threshold, std::size_t count, ChaCha20Rng& rng = ChaCha20Rng::local());
+
+// Round one, offline: count nonce pairs of the participant with the 32-byte
+// share, each scalar hashed from 32 bytes of rng and the share (RFC 9591's
+// nonce_generate), at secnonces[64 i, 64 (i + 1)) with their commitments at
+// commitments[66 i, 66 (i + 1)). The 2 count points are made by
+// FixedBaseTable::mul_ct of the generator's comb and normalized with one
+// inversion, so a batch costs about 64 complete additions a point.
+// Status::out_of_range for a share not in [1, n)
+Status frost_preprocess(uint8_t* secnonces, uint8_t* commitments, std::size_t count, const uint8_t* share,
+                        ChaCha20Rng& rng = ChaCha20Rng::local());
+
+// the group key and every participant's public share, lifted once
+class FrostGroup {
+public:
+    // from the 33-byte group key and the count public shares at
+    // public_shares[33 i, 33 (i + 1)), the keys lifted together
+    // (decompress_keys). Status::not_on_curve for a key that does not decode.
+    // Throws std::invalid_argument unless 1 <= threshold <= count < 2^32
+    static Result<FrostGroup> make(const uint8_t* group_key, const uint8_t* public_shares, std::size_t count,
+                                   std::size_t threshold);
+
+    // the group key, normalized
+    const Point& point() const { return this->q; }
+    // the x-only key of the group in out[0, 32), what signatures verify under
+    void x_only(uint8_t* out) const;
+    std::size_t threshold() const { return this->t; }
+    std::size_t size() const { return this->keys->size(); }
+    // the public share of participant identifier, 1 to size()
+    const Point& public_share(uint32_t identifier) const { return (*this->keys)[identifier - 1]; }
+
+private:
+    Point q;
+    std::size_t t;
+    std::shared_ptr<const std::vector<Point>> keys;
+
+    FrostGroup(const Point& q, std::size_t threshold, std::shared_ptr<const std::vector<Point>> keys);
+};
+
+// a signer's commitment for one session
+struct FrostCommitment {
+    uint32_t identifier;
+    const uint8_t* commitment;      // 66 bytes
+};
+
+// Round two: the values of one signing session, computed once by whoever
+// gathers the commitments: every signer's binding factor rho_i and Lagrange
+// coefficient lambda_i (the denominators inverted together), the group
+// commitment R and the BIP340 challenge c. Signing is then
+// z_i = d_i + rho_i e_i + lambda_i c s_i, with signs for odd y
+class FrostSession {
+public:
+    // the session of the signers whose commitments are given, in ascending
+    // order of identifier, on message[0, len): their commitments lifted
+    // together and R = sum D_i + rho_i E_i by one multi_scalar_mul on
+    // executor. Status::out_of_range for fewer than the threshold of signers,
+    // identifiers out of range or not ascending, Status::not_on_curve (its
+    // index in *culprit when culprit is not null) for a commitment that does
+    // not decode, Status::infinity for R at infinity
+    static Result<FrostSession> start(const FrostGroup& group, const std::vector<FrostCommitment>& commitments,
+                                      const uint8_t* message, std::size_t len, Executor& executor,
+                                      std::size_t* culprit = nullptr);
+    static Result<FrostSession> start(const FrostGroup& group, const std::vector<FrostCommitment>& commitments,
+                                      const uint8_t* message, std::size_t len, std::size_t* culprit = nullptr);
+
+    // the signers, in the order of start
+    std::size_t size() const { return this->signers.size(); }
+    uint32_t identifier(std::size_t i) const { return this->signers[i].identifier; }
+
+    // the 32-byte partial signature of signer identifier from its share and
+    // the secnonce of the commitment it gave, whose nonces are then zeroed so
+    // it cannot sign twice. Status::out_of_range for a share or nonce not in
+    // [1, n), a used secnonce among them, or an identifier not of the
+    // session. Scalars only; the negations are masked, as in schnorr_sign
+    Status sign(uint8_t* partial, uint8_t* secnonce, uint32_t identifier, const uint8_t* share) const noexcept;
+
+    // one signer's partial signature: z G against D + rho E (negated for R of
+    // odd y) + lambda c Y by one Point::mul_add. Status::bad_encoding for z
+    // not below n, Status::out_of_range for an identifier not of the session,
+    // Status::bad_signature when it does not hold
+    Status verify(uint32_t identifier, const uint8_t* partial) const noexcept;
+    // whether the partial signatures of every signer, 32 bytes each in the
+    // order of start, all verify, by the randomized batch equation of
+    // MusigSession::verify_batch: one multi_scalar_mul of 3 size() + 1 points
+    // on executor. On a failure the signers are checked one by one for the
+    // first that fails, its index in *culprit when culprit is not null, and
+    // its status returned
+    Status verify_batch(const uint8_t* partials, Executor& executor, std::size_t* culprit = nullptr) const;
+    Status verify_batch(const uint8_t* partials, unsigned threads = 1, std::size_t* culprit = nullptr) const;
+
+    // the 64-byte BIP340 signature R.x || sum z_i of the partial signatures of
+    // every signer, 32 bytes each in the order of start. Status::bad_encoding
+    // for a z_i not below n, its index in *culprit when culprit is not null
+    Status aggregate(uint8_t* signature, const uint8_t* partials, std::size_t* culprit = nullptr) const noexcept;
+
+private:
+    struct Signer {
+        uint32_t identifier;
+        Point d, e;
+        Scalar rho, lambda;
+    };
+
+    FrostGroup group;
+    std::vector<Signer> signers;
+    Scalar c;
+    uint8_t rx[32];
+    bool r_even;
+
+    FrostSession(const FrostGroup& group, std::vector<Signer> signers, const Scalar& c, const uint8_t* rx,
+                 bool r_even);
+    // the index of identifier among the signers, or size() if not one of them
+    std::size_t find(uint32_t identifier) const;
+};
+
+#endif //ECC_FROST_H
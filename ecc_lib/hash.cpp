@@ -0,0 +1,14 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <random>
+
+#include "hash.h"
+
+uint64_t hash_seed() {
+    static const uint64_t seed = []() {
+        std::random_device device;
+        return (static_cast<uint64_t>(device()) << 32) | device();
+    }();
+    return seed;
+}
@@ -0,0 +1,46 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_HASH_H
+#define ECC_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "limb.h"
+
+// Hashes of limbs for hash-map keys, in the manner of wyhash: two words at a
+// time folded into the state by one 64x64 -> 128 bit multiply, so a 256-bit
+// value costs three multiplies. Not a cryptographic hash, but under a seed
+// nobody outside the process knows, keys cannot be picked to collide
+// (HashDoS); the std::hash specializations of integer, FieldElement, Scalar
+// and Point take hash_seed(), and their hash(seed) members any other.
+
+// the two halves of a * b folded together
+constexpr uint64_t hash_mix(uint64_t a, uint64_t b) {
+    limb_t hi = 0;
+    const limb_t lo = limb_mul(a, b, hi);
+    return lo ^ hi;
+}
+
+// words[0, count) under seed, each word widened to 64 bits
+template <typename T>
+constexpr uint64_t hash_words(const T* words, std::size_t count, uint64_t seed) {
+    constexpr uint64_t P0 = 0xa0761d6478bd642full, P1 = 0xe7037ed1a0b428dbull, P2 = 0x8ebc6af09c88c6dbull;
+    seed ^= hash_mix(seed ^ P0, P1);
+    std::size_t i = 0;
+    for (; i + 1 < count; i += 2) {
+        seed = hash_mix(static_cast<uint64_t>(words[i]) ^ P1, static_cast<uint64_t>(words[i + 1]) ^ seed);
+    }
+    if (i < count) {
+        seed = hash_mix(static_cast<uint64_t>(words[i]) ^ P1, seed ^ P2);
+    }
+    return hash_mix(seed ^ P0, static_cast<uint64_t>(count) ^ P1);
+}
+
+// drawn from std::random_device once per process, so hash-map layouts differ
+// from run to run
+uint64_t hash_seed();
+
+#endif //ECC_HASH_H
@@ -0,0 +1,355 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "hash_to_curve.h"
+#include "sha256.h"
+
+namespace {
+
+limb_t mask(bool condition) {
+    return 0 - static_cast<limb_t>(condition);
+}
+
+// the parity of the value, sgn0 for a prime field
+bool sgn0(const FieldElement& x) {
+    uint8_t bytes[64];
+    const std::size_t len = (x.prime_field().bits() + 7) / 8;
+    x.to_bytes(bytes, len);
+    return bytes[len - 1] & 1;
+}
+
+FieldElement negated(const FieldElement& x) {
+    return FieldElement(0, x.prime_field()) - x;
+}
+
+// x^3 + a x + b
+FieldElement curve_g(const FieldElement& x, const FieldElement& a, const FieldElement& b) {
+    return (x.square() + a) * x + b;
+}
+
+// the root candidate, the power to (p + 1) / 4: a root of x when x is a
+// square, of -x when it is not, for p = 3 mod 4
+FieldElement root(const FieldElement& x) {
+    return x.power(x.prime_field().sqrt_exponent());
+}
+
+// 1 / x[i] for every i, zero for zero (inv0), with one inversion
+void invert0(std::vector<FieldElement>& x) {
+    const FieldElement zero(0, x[0].prime_field()), one(1, x[0].prime_field());
+    std::vector<limb_t> zeros(x.size());
+    for (std::size_t i = 0; i < x.size(); i++) {
+        zeros[i] = mask(x[i].is_zero());
+        x[i] = FieldElement::select(zeros[i], one, x[i]);
+    }
+    FieldElement::batch_invert(x);
+    for (std::size_t i = 0; i < x.size(); i++) {
+        x[i] = FieldElement::select(zeros[i], zero, x[i]);
+    }
+}
+
+FieldElement element(const char* hex, const PrimeField& field) {
+    return FieldElement(integer(hex, 16), field);
+}
+
+// RFC 9380 H.1: the first Z of 1, -1, 2, -2, .. for which the SVDW map is defined
+FieldElement find_z_svdw(const FieldElement& a, const FieldElement& b) {
+    const PrimeField& field = a.prime_field();
+    const FieldElement two(2, field), three(3, field), four(4, field);
+    for (int ctr = 1;; ctr++) {
+        for (const FieldElement& z : {FieldElement(ctr, field), negated(FieldElement(ctr, field))}) {
+            const FieldElement gz = curve_g(z, a, b);
+            const FieldElement t = three * z.square() + four * a;
+            if (gz.is_zero() || t.is_zero()) {
+                continue;
+            }
+            const FieldElement h = negated(t) / (four * gz);
+            if (h.is_square() && (gz.is_square() || curve_g(negated(z) / two, a, b).is_square())) {
+                return z;
+            }
+        }
+    }
+}
+
+}
+
+void expand_message_xmd(const uint8_t* msg, std::size_t msg_len, const uint8_t* dst, std::size_t dst_len,
+                        uint8_t* out, std::size_t len) {
+    static const char oversize[] = "H2C-OVERSIZE-DST-";
+    const std::size_t ell = (len + Sha256::DIGEST_SIZE - 1) / Sha256::DIGEST_SIZE;
+    if (len == 0 || ell > 255) {
+        throw std::invalid_argument("expand_message_xmd takes 1 to 8160 bytes");
+    }
+    uint8_t short_dst[Sha256::DIGEST_SIZE];
+    if (dst_len > 255) {
+        Sha256 h;
+        h.update(reinterpret_cast<const uint8_t*>(oversize), sizeof(oversize) - 1);
+        h.update(dst, dst_len);
+        h.finish(short_dst);
+        dst = short_dst;
+        dst_len = sizeof(short_dst);
+    }
+    const uint8_t dst_size = static_cast<uint8_t>(dst_len);
+
+    // b_0 = H(Z_pad || msg || I2OSP(len, 2) || 0 || DST_prime)
+    static const uint8_t z_pad[64] = {0};
+    const uint8_t tail[3] = {static_cast<uint8_t>(len >> 8), static_cast<uint8_t>(len), 0};
+    Sha256 h;
+    h.update(z_pad, sizeof(z_pad));
+    h.update(msg, msg_len);
+    h.update(tail, sizeof(tail));
+    h.update(dst, dst_len);
+    h.update(&dst_size, 1);
+    uint8_t b0[Sha256::DIGEST_SIZE], bi[Sha256::DIGEST_SIZE];
+    h.finish(b0);
+
+    // b_i = H((b_0 xor b_(i - 1)) || I2OSP(i, 1) || DST_prime), b_0 xor b_0 = 0 for i = 1
+    std::memset(bi, 0, sizeof(bi));
+    for (std::size_t i = 1; i <= ell; i++) {
+        for (std::size_t j = 0; j < sizeof(bi); j++) {
+            bi[j] ^= b0[j];
+        }
+        const uint8_t index = static_cast<uint8_t>(i);
+        h.update(bi, sizeof(bi));
+        h.update(&index, 1);
+        h.update(dst, dst_len);
+        h.update(&dst_size, 1);
+        h.finish(bi);
+        const std::size_t take = std::min(sizeof(bi), len - (i - 1) * sizeof(bi));
+        std::memcpy(out + (i - 1) * sizeof(bi), bi, take);
+    }
+}
+
+std::vector<FieldElement> hash_to_field(const uint8_t* msg, std::size_t msg_len, const uint8_t* dst,
+                                        std::size_t dst_len, const PrimeField& field, std::size_t count) {
+    const std::size_t l = (field.bits() + 128 + 7) / 8;
+    std::vector<uint8_t> bytes(l * count);
+    std::vector<FieldElement> u;
+    if (count == 0) {
+        return u;
+    }
+    expand_message_xmd(msg, msg_len, dst, dst_len, bytes.data(), bytes.size());
+    for (std::size_t i = 0; i < count; i++) {
+        u.emplace_back(integer::from_bytes(&bytes[i * l], l) % field.prime(), field);
+    }
+    return u;
+}
+
+HashToCurve::HashToCurve(const Curve& curve, std::string suite, method m, const integer& a, const integer& b,
+                         const integer& z)
+        : c(&curve), id(std::move(suite)), m(m), l((curve.field().bits() + 128 + 7) / 8),
+          a(a, curve.field()), b(b, curve.field()), z(z, curve.field()), h_eff(1) {
+    const PrimeField& field = curve.field();
+    if (m == method::sswu) {
+        // sqrt(-Z) Z, the root of -Z^3
+        this->k.push_back(root(negated(this->z)) * this->z);
+        // -B / A and B / (Z A), x1 for 1 / (Z^2 u^4 + Z u^2) of zero
+        this->k.push_back(negated(this->b) / this->a);
+        this->k.push_back(this->b / (this->z * this->a));
+        return;
+    }
+    this->z = find_z_svdw(this->a, this->b);
+    const FieldElement two(2, field), three(3, field), four(4, field);
+    const FieldElement gz = curve_g(this->z, this->a, this->b);
+    const FieldElement t = three * this->z.square() + four * this->a;
+    FieldElement c3 = root(negated(gz) * t);
+    c3 = FieldElement::select(mask(sgn0(c3)), negated(c3), c3);
+    this->k.push_back(gz);
+    this->k.push_back(negated(this->z) / two);
+    this->k.push_back(c3);
+    this->k.push_back(negated(four * gz) / t);
+}
+
+const HashToCurve& HashToCurve::secp256k1() {
+    static const HashToCurve h = [] {
+        const Curve& curve = Curve::secp256k1();
+        const PrimeField& field = curve.field();
+        HashToCurve s(curve, "secp256k1_XMD:SHA-256_SSWU_RO_", method::sswu,
+                      integer("3f8731abdd661adca08a5558f0f5d272e953d363cb6f0e5d405447c01a444533", 16),
+                      integer(1771), curve.p() - 11);
+        // RFC 9380 E.1
+        for (const char* k : {
+                // x_num
+                "8e38e38e38e38e38e38e38e38e38e38e38e38e38e38e38e38e38e38daaaaa8c7",
+                "07d3d4c80bc321d5b9f315cea7fd44c5d595d2fc0bf63b92dfff1044f17c6581",
+                "534c328d23f234e6e2a413deca25caece4506144037c40314ecbd0b53d9dd262",
+                "8e38e38e38e38e38e38e38e38e38e38e38e38e38e38e38e38e38e38daaaaa88c",
+                // x_den
+                "d35771193d94918a9ca34ccbb7b640dd86cd409542f8487d9fe6b745781eb49b",
+                "edadc6f64383dc1df7c4b2d51b54225406d36b641f5e41bbc52a56612a8c6d14",
+                // y_num
+                "4bda12f684bda12f684bda12f684bda12f684bda12f684bda12f684b8e38e23c",
+                "c75e0c32d5cb7c0fa9d0a54b12a0a6d5647ab046d686da6fdffc90fc201d71a3",
+                "29a6194691f91a73715209ef6512e576722830a201be2018a765e85a9ecee931",
+                "2f684bda12f684bda12f684bda12f684bda12f684bda12f684bda12f38e38d84",
+                // y_den
+                "fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffff93b",
+                "7a06534bb8bdb49fd5e9e6632722c2989467c1bfc8e8d978dfb425d2685c2573",
+                "6484aa716545ca2cf3a70c3fa8fe337e0a3d21162f0d6299a7bf8192bfd2a76f"}) {
+            s.iso.push_back(element(k, field));
+        }
+        return s;
+    }();
+    return h;
+}
+
+const HashToCurve& HashToCurve::p256() {
+    static const HashToCurve h(Curve::p256(), "P256_XMD:SHA-256_SSWU_RO_", method::sswu, Curve::p256().a().value(),
+                               Curve::p256().b().value(), Curve::p256().p() - 10);
+    return h;
+}
+
+const HashToCurve& HashToCurve::bls12_381() {
+    static const HashToCurve h = [] {
+        const Curve& curve = Curve::bls12_381();
+        HashToCurve s(curve, "BLS12381G1_XMD:SHA-256_SVDW_RO_", method::svdw, curve.a().value(), curve.b().value(),
+                      integer(0));
+        s.h_eff = integer("d201000000010001", 16);
+        return s;
+    }();
+    return h;
+}
+
+void HashToCurve::map(const std::vector<FieldElement>& u, std::vector<FieldElement>& x,
+                      std::vector<FieldElement>& y) const {
+    const PrimeField& field = this->c->field();
+    const std::size_t n = u.size();
+    const FieldElement one(1, field);
+    for (const FieldElement& e : u) {
+        if (&e.prime_field() != &field) {
+            throw std::runtime_error("Cannot map an element of another field to the curve");
+        }
+    }
+    x.clear();
+    y.clear();
+    std::vector<FieldElement> tv, den;
+    if (this->m == method::sswu) {
+        // Z u^2, then 1 / (Z^2 u^4 + Z u^2) for all at once
+        for (const FieldElement& e : u) {
+            tv.push_back(this->z * e.square());
+            den.push_back(tv.back().square() + tv.back());
+        }
+        invert0(den);
+        for (std::size_t i = 0; i < n; i++) {
+            const FieldElement x1 = FieldElement::select(mask(den[i].is_zero()), this->k[2],
+                                                         this->k[1] * (one + den[i]));
+            const FieldElement gx1 = curve_g(x1, this->a, this->b);
+            const FieldElement r = root(gx1);
+            const limb_t square = mask(r.square() == gx1);
+            x.push_back(FieldElement::select(square, x1, tv[i] * x1));
+            y.push_back(FieldElement::select(square, r, r * this->k[0] * u[i].square() * u[i]));
+        }
+    } else {
+        // tv1 = 1 - u^2 c1, tv2 = 1 + u^2 c1 and 1 / (tv1 tv2) for all at once
+        std::vector<FieldElement> tv2;
+        for (const FieldElement& e : u) {
+            const FieldElement t = e.square() * this->k[0];
+            tv.push_back(one - t);
+            tv2.push_back(one + t);
+            den.push_back(tv.back() * tv2.back());
+        }
+        invert0(den);
+        for (std::size_t i = 0; i < n; i++) {
+            const FieldElement tv4 = u[i] * tv[i] * den[i] * this->k[2];
+            const FieldElement x1 = this->k[1] - tv4, x2 = this->k[1] + tv4;
+            const FieldElement x3 = (tv2[i].square() * den[i]).square() * this->k[3] + this->z;
+            const FieldElement gx1 = curve_g(x1, this->a, this->b), gx2 = curve_g(x2, this->a, this->b);
+            const FieldElement gx3 = curve_g(x3, this->a, this->b);
+            const FieldElement r1 = root(gx1), r2 = root(gx2), r3 = root(gx3);
+            const limb_t e1 = mask(r1.square() == gx1), e2 = mask(r2.square() == gx2) & ~e1;
+            x.push_back(FieldElement::select(e1, x1, FieldElement::select(e2, x2, x3)));
+            y.push_back(FieldElement::select(e1, r1, FieldElement::select(e2, r2, r3)));
+        }
+    }
+    for (std::size_t i = 0; i < n; i++) {
+        y[i] = FieldElement::select(mask(sgn0(u[i]) != sgn0(y[i])), negated(y[i]), y[i]);
+    }
+    if (this->iso.empty()) {
+        return;
+    }
+
+    // the 3-isogeny: x = x_num / x_den and y = y' y_num / y_den, the
+    // denominators of all the points inverted together
+    const std::vector<FieldElement>& k = this->iso;
+    std::vector<FieldElement> xn, yn, inverse;
+    for (std::size_t i = 0; i < n; i++) {
+        const FieldElement& t = x[i];
+        xn.push_back(((k[3] * t + k[2]) * t + k[1]) * t + k[0]);
+        inverse.push_back((t + k[5]) * t + k[4]);
+        yn.push_back(((k[9] * t + k[8]) * t + k[7]) * t + k[6]);
+        inverse.push_back(((t + k[12]) * t + k[11]) * t + k[10]);
+    }
+    invert0(inverse);
+    for (std::size_t i = 0; i < n; i++) {
+        x[i] = xn[i] * inverse[2 * i];
+        y[i] = y[i] * yn[i] * inverse[2 * i + 1];
+    }
+}
+
+std::vector<Point> HashToCurve::finish(const std::vector<FieldElement>& x, const std::vector<FieldElement>& y,
+                                       bool pairs) const {
+    const Curve& curve = *this->c;
+    std::vector<Point> q0, q1;
+    for (std::size_t i = 0; i < x.size(); i++) {
+        // a zero isogeny denominator, for one of the kernel's points, maps to infinity
+        const bool infinity = !this->iso.empty() && x[i].is_zero() && y[i].is_zero();
+        (pairs && i % 2 ? q1 : q0).push_back(infinity ? curve.infinity() : Point(x[i], y[i], curve.a(), curve.b()));
+    }
+    if (pairs) {
+        Point::batch_add(q0, q1, q0);
+    }
+    if (this->h_eff != 1) {
+        for (Point& p : q0) {
+            p = p.mul(this->h_eff);
+        }
+        Point::batch_normalize(q0);
+    }
+    return q0;
+}
+
+Point HashToCurve::hash(const uint8_t* msg, std::size_t msg_len, const uint8_t* dst, std::size_t dst_len) const {
+    std::vector<FieldElement> x, y;
+    map(hash_to_field(msg, msg_len, dst, dst_len, this->c->field(), 2), x, y);
+    return finish(x, y, true)[0];
+}
+
+Point HashToCurve::hash(const std::string& msg, const std::string& dst) const {
+    return hash(reinterpret_cast<const uint8_t*>(msg.data()), msg.size(), reinterpret_cast<const uint8_t*>(dst.data()),
+                dst.size());
+}
+
+std::vector<Point> HashToCurve::hash_batch(const std::vector<std::string>& messages, const std::string& dst) const {
+    if (messages.empty()) {
+        return {};
+    }
+    std::vector<FieldElement> u, x, y;
+    u.reserve(2 * messages.size());
+    for (const std::string& msg : messages) {
+        for (FieldElement& e : hash_to_field(reinterpret_cast<const uint8_t*>(msg.data()), msg.size(),
+                                             reinterpret_cast<const uint8_t*>(dst.data()), dst.size(),
+                                             this->c->field(), 2)) {
+            u.push_back(std::move(e));
+        }
+    }
+    map(u, x, y);
+    return finish(x, y, true);
+}
+
+Point HashToCurve::map(const FieldElement& u) const {
+    std::vector<FieldElement> x, y;
+    map(std::vector<FieldElement>(1, u), x, y);
+    return finish(x, y, false)[0];
+}
+
+std::vector<Point> HashToCurve::map_batch(const std::vector<FieldElement>& u) const {
+    if (u.empty()) {
+        return {};
+    }
+    std::vector<FieldElement> x, y;
+    map(u, x, y);
+    return finish(x, y, false);
+}
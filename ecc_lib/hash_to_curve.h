@@ -0,0 +1,99 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_HASH_TO_CURVE_H
+#define ECC_HASH_TO_CURVE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Curve.h"
+#include "FieldElement.h"
+#include "Point.h"
+
+// Hashing to elliptic curves by RFC 9380: expand_message_xmd with SHA-256,
+// hash_to_field into two elements, a map of each to the curve and the sum
+// of the two points, with the cofactor cleared (the random-oracle _RO_
+// suites). Every field of the suites here has p = 3 mod 4, so a square root
+// is one power to (p + 1) / 4, through the addition chain where the field
+// has one, and a square is told by squaring the root back: the map runs the
+// same operations whatever the input, with selects for its branches, where
+// the field arithmetic itself does (primes of up to 256 bits).
+
+// RFC 9380 5.3.1: len uniform bytes from msg[0, msg_len) under the domain
+// separation tag dst[0, dst_len), a tag over 255 bytes replaced by
+// SHA-256("H2C-OVERSIZE-DST-" || dst). Throws std::invalid_argument for len
+// of 0 or over 255 * 32
+void expand_message_xmd(const uint8_t* msg, std::size_t msg_len, const uint8_t* dst, std::size_t dst_len,
+                        uint8_t* out, std::size_t len);
+
+// RFC 9380 5.2: count elements of field, each from ceil((bits + 128) / 8)
+// bytes of expand_message_xmd reduced mod p
+std::vector<FieldElement> hash_to_field(const uint8_t* msg, std::size_t msg_len, const uint8_t* dst,
+                                        std::size_t dst_len, const PrimeField& field, std::size_t count);
+
+// One hash-to-curve suite. The simplified SWU map (RFC 9380 6.6.2) takes
+// one inversion and one square root per element: x1 = (-B / A)(1 + 1 / (Z^2
+// u^4 + Z u^2)), and when g(x1) is not a square x2 = Z u^2 x1 with the root
+// sqrt(-Z) Z u^3 times the power of g(x1) that failed to be its root, as g(x2)
+// = Z^3 u^6 g(x1). A batch shares each inversion among all its messages:
+// one for the maps' denominators, one for the isogeny's and one for the
+// affine sums of the two points.
+class HashToCurve {
+public:
+    // secp256k1_XMD:SHA-256_SSWU_RO_: simplified SWU onto the curve
+    // y^2 = x^3 + A' x + 1771 and its 3-isogeny to secp256k1 (RFC 9380 8.7)
+    static const HashToCurve& secp256k1();
+    // P256_XMD:SHA-256_SSWU_RO_: simplified SWU onto P-256 itself (RFC 9380 8.2)
+    static const HashToCurve& p256();
+    // BLS12381G1_XMD:SHA-256_SVDW_RO_: the Shallue-van de Woestijne map of
+    // RFC 9380 6.6.1, with Z found as its appendix H.1 says, onto G1 and the
+    // cofactor cleared by h_eff = 1 - x. RFC 9380 suites for G1 map through
+    // an 11-isogeny instead, whose constants are not built in, so its points
+    // differ from those of BLS12381G1_XMD:SHA-256_SSWU_RO_
+    static const HashToCurve& bls12_381();
+
+    const Curve& curve() const { return *this->c; }
+    const std::string& suite() const { return this->id; }
+
+    // hash_to_curve(msg) under the domain separation tag dst
+    Point hash(const uint8_t* msg, std::size_t msg_len, const uint8_t* dst, std::size_t dst_len) const;
+    Point hash(const std::string& msg, const std::string& dst) const;
+    // hash() of every message, its inversions shared by the whole batch
+    std::vector<Point> hash_batch(const std::vector<std::string>& messages, const std::string& dst) const;
+    // map_to_curve(u) and clear_cofactor; throws std::runtime_error for u
+    // of another field
+    Point map(const FieldElement& u) const;
+    // map() of every element, the inversions shared as in hash_batch
+    std::vector<Point> map_batch(const std::vector<FieldElement>& u) const;
+
+private:
+    enum class method { sswu, svdw };
+
+    const Curve* c;
+    std::string id;
+    method m;
+    // bytes per element of hash_to_field
+    std::size_t l;
+    // the curve the map lands on, the isogenous one for secp256k1
+    FieldElement a, b, z;
+    // sswu: sqrt(-Z) Z; svdw: the constants c1 to c4 of 6.6.1
+    std::vector<FieldElement> k;
+    // the 3-isogeny's coefficients, x_num, x_den, y_num, y_den from the
+    // constant term up, the leading 1 of the denominators left out
+    std::vector<FieldElement> iso;
+    integer h_eff;
+
+    HashToCurve(const Curve& curve, std::string suite, method m, const integer& a, const integer& b,
+                const integer& z);
+    // the affine x[i], y[i] of map_to_curve(u[i]) on the curve, before clearing the cofactor
+    void map(const std::vector<FieldElement>& u, std::vector<FieldElement>& x, std::vector<FieldElement>& y) const;
+    // the points of (x[i], y[i]) with the cofactor cleared, pairs summed when pairs
+    std::vector<Point> finish(const std::vector<FieldElement>& x, const std::vector<FieldElement>& y,
+                              bool pairs) const;
+};
+
+#endif //ECC_HASH_TO_CURVE_H
@@ -0,0 +1,73 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstring>
+
+#include "hex.h"
+
+namespace {
+
+const char DIGITS[] = "0123456789abcdef";
+
+// the value of each character, or -1 for one that is not a hex digit
+struct NibbleTable {
+    int8_t value[256];
+};
+
+constexpr NibbleTable nibble_table() {
+    NibbleTable table{};
+    for (std::size_t c = 0; c < 256; c++) {
+        table.value[c] = -1;
+    }
+    for (int i = 0; i < 10; i++) {
+        table.value['0' + i] = static_cast<int8_t>(i);
+    }
+    for (int i = 0; i < 6; i++) {
+        table.value['a' + i] = static_cast<int8_t>(10 + i);
+        table.value['A' + i] = static_cast<int8_t>(10 + i);
+    }
+    return table;
+}
+
+constexpr NibbleTable NIBBLES = nibble_table();
+
+void portable_encode(const uint8_t* in, std::size_t len, char* out) {
+    for (std::size_t i = 0; i < len; i++) {
+        out[2 * i] = DIGITS[in[i] >> 4];
+        out[2 * i + 1] = DIGITS[in[i] & 15];
+    }
+}
+
+// the sign bits of the lookups gathered, so one test at the end covers every character
+bool portable_decode(const char* in, std::size_t len, uint8_t* out) {
+    int8_t bad = 0;
+    for (std::size_t i = 0; i < len; i++) {
+        const int8_t hi = NIBBLES.value[static_cast<uint8_t>(in[2 * i])];
+        const int8_t lo = NIBBLES.value[static_cast<uint8_t>(in[2 * i + 1])];
+        bad |= hi | lo;
+        out[i] = static_cast<uint8_t>((static_cast<uint8_t>(hi) << 4) | (lo & 15));
+    }
+    return bad >= 0;
+}
+
+}
+
+const HexCodec* portable_hex_codec() {
+    static const HexCodec codec = {"portable", portable_encode, portable_decode};
+    return &codec;
+}
+
+const HexCodec* hex_codec() {
+    static const HexCodec* const widest = avx2_hex_codec() ? avx2_hex_codec()
+                                          : ssse3_hex_codec() ? ssse3_hex_codec()
+                                          : neon_hex_codec() ? neon_hex_codec()
+                                          : portable_hex_codec();
+    return widest;
+}
+
+Status hex_decode(const char* in, std::size_t len, uint8_t* out) noexcept {
+    if (len % 2 || !hex_codec()->decode(in, len / 2, out)) {
+        return Status::bad_digit;
+    }
+    return Status::ok;
+}
@@ -0,0 +1,48 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_HEX_H
+#define ECC_HEX_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Status.h"
+
+// Hexadecimal over byte buffers, two characters a byte with the high nibble
+// first: the text of keys, signatures and integer::str(16). Each codec turns
+// whole vectors of bytes at a time, with a byte shuffle as the table of
+// digits and, decoding, range compares for the validity of every character
+// and a multiply-add that joins the nibble pairs; what is left over at the
+// end goes through the portable tables. SSSE3 and AVX2 are compiled with
+// target attributes, so the library still runs on any x86-64, and NEON is
+// built only on AArch64.
+struct HexCodec {
+    const char* name;
+    // out[0, 2 len) from in[0, len), lower case
+    void (*encode)(const uint8_t* in, std::size_t len, char* out);
+    // out[0, len) from in[0, 2 len), either case; false, with out partly
+    // written, if a character is not a hex digit
+    bool (*decode)(const char* in, std::size_t len, uint8_t* out);
+};
+
+// a table lookup per character
+const HexCodec* portable_hex_codec();
+// 16 and 32 bytes at a time; null without SSSE3 or AVX2
+const HexCodec* ssse3_hex_codec();
+const HexCodec* avx2_hex_codec();
+// 16 bytes at a time, interleaved by the structure loads and stores; null off AArch64
+const HexCodec* neon_hex_codec();
+// the widest of those the CPU runs, chosen once
+const HexCodec* hex_codec();
+
+// the 2 len characters of in[0, len) in out, lower case
+inline void hex_encode(const uint8_t* in, std::size_t len, char* out) noexcept {
+    hex_codec()->encode(in, len, out);
+}
+// the bytes of the hex in[0, len) in out[0, len / 2): Status::bad_digit for a
+// character that is not a hex digit or for an odd len
+Status hex_decode(const char* in, std::size_t len, uint8_t* out) noexcept;
+
+#endif //ECC_HEX_H
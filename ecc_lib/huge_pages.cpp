@@ -0,0 +1,156 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <new>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
+
+#include "huge_pages.h"
+#include "metrics.h"
+
+namespace {
+
+std::atomic<HugePages> policy{HugePages::transparent};
+
+struct PageMetrics {
+    Metrics::Gauge& policy;
+    Metrics::Gauge& normal;
+    Metrics::Gauge& transparent;
+    Metrics::Gauge& explicit_pages;
+    Metrics::Counter& fallbacks;
+
+    PageMetrics()
+            : policy(Metrics::global().gauge("ecc_huge_page_policy",
+                                             "the huge page policy: 0 off, 1 transparent, 2 explicit")),
+              normal(Metrics::global().gauge("ecc_page_bytes_normal", "bytes of tables and scratch on ordinary pages")),
+              transparent(Metrics::global().gauge("ecc_page_bytes_transparent",
+                                                  "bytes of tables and scratch on transparent huge pages")),
+              explicit_pages(Metrics::global().gauge("ecc_page_bytes_explicit",
+                                                     "bytes of tables and scratch on MAP_HUGETLB pages")),
+              fallbacks(Metrics::global().counter("ecc_huge_page_fallbacks_total",
+                                                  "large blocks that got fewer huge pages than the policy asked for")) {
+        this->policy.set(static_cast<int64_t>(huge_page_policy()));
+    }
+
+    static PageMetrics& get() {
+        static PageMetrics metrics;
+        return metrics;
+    }
+
+    Metrics::Gauge& bytes(HugePages mode) {
+        return mode == HugePages::explicit_pages ? this->explicit_pages
+               : mode == HugePages::transparent ? this->transparent : this->normal;
+    }
+};
+
+// false when transparent_hugepage/enabled says "[never]", where madvise
+// succeeds and does nothing; read once
+bool transparent_enabled() {
+    static const bool enabled = []() {
+        std::ifstream in("/sys/kernel/mm/transparent_hugepage/enabled");
+        std::string line;
+        return !std::getline(in, line) || line.find("[never]") == std::string::npos;
+    }();
+    return enabled;
+}
+
+std::size_t round_up(std::size_t bytes, std::size_t to) {
+    return (bytes + to - 1) / to * to;
+}
+
+PageBlock from_heap(std::size_t bytes) {
+    return PageBlock{::operator new(bytes, std::align_val_t(64)), bytes, HugePages::off, false};
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+// size bytes of anonymous memory starting on a HUGE_PAGE_SIZE boundary: the
+// mapping is made one huge page larger and the ends trimmed
+void* map_aligned(std::size_t size) {
+    const std::size_t length = size + HUGE_PAGE_SIZE;
+    void* map = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED) {
+        return nullptr;
+    }
+    const auto start = reinterpret_cast<std::uintptr_t>(map);
+    const std::uintptr_t aligned = round_up(start, HUGE_PAGE_SIZE);
+    if (aligned > start) {
+        munmap(map, aligned - start);
+    }
+    const std::size_t tail = start + length - (aligned + size);
+    if (tail) {
+        munmap(reinterpret_cast<void*>(aligned + size), tail);
+    }
+    return reinterpret_cast<void*>(aligned);
+}
+
+#endif
+
+}
+
+void set_huge_page_policy(HugePages mode) {
+    policy.store(mode, std::memory_order_relaxed);
+    PageMetrics::get().policy.set(static_cast<int64_t>(mode));
+}
+
+HugePages huge_page_policy() {
+    return policy.load(std::memory_order_relaxed);
+}
+
+PageBlock page_allocate(std::size_t bytes) {
+    PageMetrics& metrics = PageMetrics::get();
+    const HugePages wanted = huge_page_policy();
+    PageBlock block = PageBlock{nullptr, 0, HugePages::off, false};
+#if defined(__unix__) || defined(__APPLE__)
+    if (wanted != HugePages::off && bytes >= HUGE_PAGE_SIZE) {
+        const std::size_t size = round_up(bytes, HUGE_PAGE_SIZE);
+#if defined(MAP_HUGETLB)
+        if (wanted == HugePages::explicit_pages) {
+            void* map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (map != MAP_FAILED) {
+                block = PageBlock{map, size, HugePages::explicit_pages, true};
+            }
+        }
+#endif
+        if (!block.data) {
+            void* map = map_aligned(size);
+            if (map) {
+                block = PageBlock{map, size, HugePages::off, true};
+#if defined(MADV_HUGEPAGE)
+                if (transparent_enabled() && madvise(map, size, MADV_HUGEPAGE) == 0) {
+                    block.mode = HugePages::transparent;
+                }
+#endif
+            }
+        }
+        if (block.mode != wanted) {
+            metrics.fallbacks.add();
+        }
+    }
+#endif
+    if (!block.data) {
+        block = from_heap(bytes);
+    }
+    metrics.bytes(block.mode).add(static_cast<int64_t>(block.size));
+    return block;
+}
+
+void page_free(const PageBlock& block) noexcept {
+    if (!block.data) {
+        return;
+    }
+    PageMetrics::get().bytes(block.mode).add(-static_cast<int64_t>(block.size));
+#if defined(__unix__) || defined(__APPLE__)
+    if (block.mapped) {
+        munmap(block.data, block.size);
+        return;
+    }
+#endif
+    ::operator delete(block.data, std::align_val_t(64));
+}
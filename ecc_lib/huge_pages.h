@@ -0,0 +1,49 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_HUGE_PAGES_H
+#define ECC_HUGE_PAGES_H
+
+#include <cstddef>
+
+// Memory for the large, long-lived buffers (FixedBaseTable entries and the
+// Scratch blocks under Pippenger's buckets) on 2 MiB pages where the system
+// has them: a multi-megabyte table read at random on 4 KiB pages misses the
+// TLB on most reads. Below HUGE_PAGE_SIZE, and where the policy is off or
+// there is no mmap, a block comes from operator new as before.
+//
+// Each mode falls back to the next when the system refuses it: explicit
+// pages (MAP_HUGETLB) need pages reserved in vm.nr_hugepages, transparent
+// ones (an aligned anonymous mapping with madvise(MADV_HUGEPAGE)) need
+// transparent_hugepage/enabled to be other than "never". The metrics
+// ecc_huge_page_policy (the policy as 0, 1 or 2), ecc_page_bytes_normal,
+// ecc_page_bytes_transparent and ecc_page_bytes_explicit (bytes held in each
+// mode) and ecc_huge_page_fallbacks_total say what the process actually got.
+
+enum class HugePages {
+    off,            // operator new
+    transparent,    // madvise(MADV_HUGEPAGE) on a 2 MiB aligned mapping
+    explicit_pages  // MAP_HUGETLB, else transparent
+};
+
+constexpr std::size_t HUGE_PAGE_SIZE = std::size_t(2) << 20;
+
+// the policy for blocks allocated from now on; transparent to start with
+void set_huge_page_policy(HugePages policy);
+HugePages huge_page_policy();
+
+// A block of at least the bytes asked for, 64-byte aligned and not
+// initialized, and the mode it got; give it back with page_free
+struct PageBlock {
+    void* data;
+    std::size_t size;       // bytes held, the request rounded up for huge pages
+    HugePages mode;         // off for operator new or pages the kernel would not back huge
+    bool mapped;            // from mmap rather than operator new
+};
+
+// throws std::bad_alloc when there is no memory in any mode
+PageBlock page_allocate(std::size_t bytes);
+void page_free(const PageBlock& block) noexcept;
+
+#endif //ECC_HUGE_PAGES_H
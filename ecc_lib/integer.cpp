@@ -1,5 +1,35 @@
 #include "integer.h"
 
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "Executor.h"
+#include "hex.h"
+#include "limb.h"
+#include "OperationCounters.h"
+
+#ifdef ECC_HAVE_GMP
+#include <gmp.h>
+
+// GMP works on the digits in place, so they have to be its limbs
+static_assert((GMP_LIMB_BITS == (sizeof(INTEGER_DIGIT_T) << 3)) && (GMP_NAIL_BITS == 0)
+        , "ECC_HAVE_GMP needs INTEGER_DIGIT_T to be the size of mp_limb_t");
+
+static mp_limb_t * gmp_limbs(INTEGER_DIGIT_T * digits){
+    return reinterpret_cast <mp_limb_t *> (digits);
+}
+
+static const mp_limb_t * gmp_limbs(const INTEGER_DIGIT_T * digits){
+    return reinterpret_cast <const mp_limb_t *> (digits);
+}
+#endif
+
 constexpr INTEGER_DIGIT_T integer::NEG1;
 constexpr std::size_t     integer::OCTETS;
 constexpr std::size_t     integer::BITS;
@@ -7,9 +37,85 @@ constexpr INTEGER_DIGIT_T integer::HIGH_BIT;
 constexpr integer::Sign   integer::POSITIVE;
 constexpr integer::Sign   integer::NEGATIVE;
 
+// position of the highest set bit of a nonzero digit, plus one
+static std::size_t digit_bit_length(const INTEGER_DIGIT_T d){
+#if defined(__GNUC__) || defined(__clang__)
+    return (sizeof(unsigned long long) << 3) - __builtin_clzll(static_cast <unsigned long long> (d));
+#else
+    std::size_t out = 0;
+    for(INTEGER_DIGIT_T msb = d; msb; msb >>= 1){
+        out++;
+    }
+    return out;
+#endif
+}
+
+// Division of a digit string by one digit with a precomputed reciprocal
+// (Moller and Granlund, "Improved division by invariant integers", 2011):
+// each quotient digit takes one double digit multiplication and a couple of
+// corrections instead of a double digit division
+struct word_divisor {
+    INTEGER_DIGIT_T d;      // the divisor shifted so its top bit is set
+    INTEGER_DIGIT_T v;      // floor((B^2 - 1) / d) - B
+    std::size_t     shift;  // d is the divisor << shift
+
+    explicit word_divisor(const INTEGER_DIGIT_T divisor) :
+            d(),
+            v(),
+            shift((sizeof(INTEGER_DIGIT_T) << 3) - digit_bit_length(divisor))
+    {
+        d = static_cast <INTEGER_DIGIT_T> (divisor << shift);
+        v = static_cast <INTEGER_DIGIT_T> (static_cast <INTEGER_DOUBLE_DIGIT_T> (-1) / d);
+    }
+
+    // <u1, u0> / d for u1 < d; returns the quotient and leaves the remainder in u1
+    inline INTEGER_DIGIT_T divide(INTEGER_DIGIT_T & u1, const INTEGER_DIGIT_T u0) const {
+        static constexpr std::size_t BITS = sizeof(INTEGER_DIGIT_T) << 3;
+        const INTEGER_DOUBLE_DIGIT_T q = static_cast <INTEGER_DOUBLE_DIGIT_T> (v) * u1
+                                       + ((static_cast <INTEGER_DOUBLE_DIGIT_T> (u1) << BITS) | u0);
+        INTEGER_DIGIT_T q1 = static_cast <INTEGER_DIGIT_T> ((q >> BITS) + 1);
+        const INTEGER_DIGIT_T q0 = static_cast <INTEGER_DIGIT_T> (q);
+        INTEGER_DIGIT_T r = static_cast <INTEGER_DIGIT_T> (u0 - q1 * d);
+        if (r > q0){
+            q1--;
+            r = static_cast <INTEGER_DIGIT_T> (r + d);
+        }
+        if (r >= d){
+            q1++;
+            r = static_cast <INTEGER_DIGIT_T> (r - d);
+        }
+        u1 = r;
+        return q1;
+    }
+};
+
+// x[0..n) / divisor, most significant digit first, into q[0..n) (q may be x,
+// or null for the remainder only); returns the remainder
+static INTEGER_DIGIT_T divide_by_word(INTEGER_DIGIT_T * q, const INTEGER_DIGIT_T * x, const std::size_t n, const word_divisor & divisor){
+    static constexpr std::size_t BITS = sizeof(INTEGER_DIGIT_T) << 3;
+    if (!n){
+        return 0;
+    }
+
+    // divide x << shift, pulling each shifted digit together from two neighbours
+    const std::size_t s = divisor.shift;
+    INTEGER_DIGIT_T r = s?static_cast <INTEGER_DIGIT_T> (x[n - 1] >> (BITS - s)):0;
+    for(std::size_t i = n; i > 0; i--){
+        INTEGER_DIGIT_T u = static_cast <INTEGER_DIGIT_T> (x[i - 1] << s);
+        if (s && (i > 1)){
+            u |= static_cast <INTEGER_DIGIT_T> (x[i - 2] >> (BITS - s));
+        }
+        const INTEGER_DIGIT_T digit = divisor.divide(r, u);
+        if (q){
+            q[i - 1] = digit;
+        }
+    }
+    return static_cast <INTEGER_DIGIT_T> (r >> s);
+}
+
 integer & integer::trim(){                  // remove top 0 digits to save memory
-    while (!_value.empty() && !_value[0]){
-        _value.pop_front();
+    while (!_value.empty() && !_value.back()){
+        _value.pop_back();
     }
     if (_value.empty()){                    // change sign to false if _value is 0
         _sign = integer::POSITIVE;
@@ -18,6 +124,81 @@ integer & integer::trim(){                  // remove top 0 digits to save memor
     return *this;
 }
 
+// Single digit kernels
+integer & integer::add_word(const INTEGER_DIGIT_T w){
+    INTEGER_DIGIT_T carry = w;
+    for(integer::REP_SIZE_T i = 0; carry && (i < _value.size()); i++){
+        _value[i] = static_cast <INTEGER_DIGIT_T> (_value[i] + carry);
+        carry = (_value[i] < carry);
+    }
+    if (carry){
+        _value.push_back(carry);
+    }
+    return *this;
+}
+
+integer & integer::sub_word(const INTEGER_DIGIT_T w){
+    INTEGER_DIGIT_T borrow = w;
+    for(integer::REP_SIZE_T i = 0; borrow && (i < _value.size()); i++){
+        const INTEGER_DIGIT_T d = _value[i];
+        _value[i] = static_cast <INTEGER_DIGIT_T> (d - borrow);
+        borrow = (d < borrow);
+    }
+    return trim();
+}
+
+integer & integer::mul_word(const INTEGER_DIGIT_T w){
+    if (!w){
+        _value.clear();
+        return trim();
+    }
+
+    INTEGER_DIGIT_T carry = 0;
+    for(integer::REP_SIZE_T i = 0; i < _value.size(); i++){
+        const INTEGER_DOUBLE_DIGIT_T prod = static_cast <INTEGER_DOUBLE_DIGIT_T> (_value[i]) * w + carry;
+        _value[i] = static_cast <INTEGER_DIGIT_T> (prod);
+        carry = static_cast <INTEGER_DIGIT_T> (prod >> integer::BITS);
+    }
+    if (carry){
+        _value.push_back(carry);
+    }
+    return trim();
+}
+
+INTEGER_DIGIT_T integer::div_word(const INTEGER_DIGIT_T w){
+    if (!w){
+        throw std::domain_error("Error: division or modulus by 0");
+    }
+
+    const INTEGER_DIGIT_T r = divide_by_word(_value.data(), _value.data(), _value.size(), word_divisor(w));
+    trim();
+    return r;
+}
+
+INTEGER_DIGIT_T integer::mod_word(const INTEGER_DIGIT_T w) const {
+    if (!w){
+        throw std::domain_error("Error: division or modulus by 0");
+    }
+
+    return divide_by_word(nullptr, _value.data(), _value.size(), word_divisor(w));
+}
+
+integer & integer::add_signed_word(const integer::Sign sign, const INTEGER_DIGIT_T w){
+    if (!w){
+        return *this;
+    }
+    if (_value.empty() || (_sign == sign)){     // same sign (or 0): the magnitudes add
+        _sign = sign;
+        return add_word(w);
+    }
+    if ((_value.size() > 1) || (_value[0] >= w)){ // |*this| >= w: the sign of *this stays
+        return sub_word(w);
+    }
+    _value[0] = static_cast <INTEGER_DIGIT_T> (w - _value[0]);
+    _sign = sign;
+    return *this;
+}
+
 // Constructors
 integer::integer() :
         _sign(integer::POSITIVE),
@@ -32,10 +213,11 @@ integer::integer(const integer & copy) :
 }
 
 integer::integer(integer && copy) :
-        _sign(std::move(copy._sign)),
+        _sign(copy._sign),
         _value(std::move(copy._value))
 {
-    copy = 0;
+    copy._value.clear();
+    copy._sign = integer::POSITIVE;
     trim();
 }
 
@@ -53,15 +235,115 @@ integer::integer(const bool & b) :
     trim();
 }
 
+// log2(base) for power-of-two bases, 0 for any other base
+static unsigned int radix_bits(const unsigned int base){
+    unsigned int k = 0;
+    while ((1u << k) < base){
+        k++;
+    }
+    return ((1u << k) == base)?k:0;
+}
+
+// the largest power of base that fits in one digit, and its exponent
+static INTEGER_DIGIT_T radix_chunk(const unsigned int base, std::size_t & chunk){
+    INTEGER_DIGIT_T power = base;
+    chunk = 1;
+    while (power <= std::numeric_limits <INTEGER_DIGIT_T>::max() / base){
+        power *= base;
+        chunk++;
+    }
+    return power;
+}
+
+// n digits of k bits each, most significant first, packed into limbs
+static integer::REP pack_radix_bits(const uint8_t * digits, const std::size_t n, const unsigned int k){
+    static constexpr std::size_t BITS = sizeof(INTEGER_DIGIT_T) << 3;
+    integer::REP out((n * k + BITS - 1) / BITS, 0);
+    for(std::size_t i = 0; i < n; i++){
+        const std::size_t pos = i * k;
+        const INTEGER_DIGIT_T d = digits[n - 1 - i];
+        out[pos / BITS] |= static_cast <INTEGER_DIGIT_T> (d << (pos % BITS));
+        if ((pos % BITS) + k > BITS){
+            out[pos / BITS + 1] |= static_cast <INTEGER_DIGIT_T> (d >> (BITS - (pos % BITS)));
+        }
+    }
+    return out;
+}
+
+// n <= OCTETS bytes at p as one digit, most significant byte first if big
+// big is a template argument so the whole-digit loops below unroll into single loads and stores
+template <bool big>
+static inline INTEGER_DIGIT_T load_digit(const uint8_t * p, const std::size_t n){
+    INTEGER_DIGIT_T d = 0;
+    for(std::size_t i = 0; i < n; i++){
+        d = static_cast <INTEGER_DIGIT_T> ((d << 8) | p[big?i:(n - 1 - i)]);
+    }
+    return d;
+}
+
+// the low n <= OCTETS bytes of d at p, most significant byte first if big
+template <bool big>
+static inline void store_digit(uint8_t * p, const std::size_t n, const INTEGER_DIGIT_T d){
+    for(std::size_t i = 0; i < n; i++){
+        p[big?(n - 1 - i):i] = static_cast <uint8_t> (d >> (i << 3));
+    }
+}
+
+// len bytes at in as digits, least significant first
+template <bool big>
+static void load_bytes(integer::REP & value, const uint8_t * in, const std::size_t len){
+    static constexpr std::size_t OCTETS = sizeof(INTEGER_DIGIT_T);
+    const std::size_t full = len / OCTETS;
+    const std::size_t rem = len % OCTETS;
+    value.resize(full + (rem?1:0));
+    for(std::size_t i = 0; i < full; i++){
+        value[i] = load_digit <big> (big?(in + len - (i + 1) * OCTETS):(in + i * OCTETS), OCTETS);
+    }
+    if (rem){
+        value[full] = load_digit <big> (big?in:(in + full * OCTETS), rem);
+    }
+}
+
+// value into exactly len bytes, zero padded; value must fit
+template <bool big>
+static void store_bytes(const integer::REP & value, uint8_t * out, const std::size_t len){
+    static constexpr std::size_t OCTETS = sizeof(INTEGER_DIGIT_T);
+    const std::size_t full = std::min(static_cast <std::size_t> (value.size()), len / OCTETS);
+    for(std::size_t i = 0; i < full; i++){
+        store_digit <big> (big?(out + len - (i + 1) * OCTETS):(out + i * OCTETS), OCTETS, value[i]);
+    }
+    std::size_t written = full * OCTETS;
+    if ((full < value.size()) && (written < len)){
+        // only the low bytes of the top digit are set
+        const std::size_t n = len - written;
+        store_digit <big> (big?out:(out + written), n, value[full]);
+        written += n;
+    }
+    std::fill(big?out:(out + written), big?(out + len - written):(out + len), 0);
+}
+
 // Special Constructor for Strings
 // bases 2-16 and 256 are allowed
 //      Written by Corbin http://codereview.stackexchange.com/a/13452
 //      Modified by me
 integer::integer(const std::string & str, const integer & base) : integer()
 {
+    Result <integer> out = parse(str, base);
+    if (!out){
+        throw_status(out.status(), ((out.status() == Status::bad_base)?"Error: Cannot convert from base ":"Error: Not a number in base ") + base.str(10));
+    }
+    *this = std::move(*out);
+}
+
+Result <integer> integer::parse(const std::string & str, const integer & base) noexcept {
+    return parse(str.data(), str.size(), base);
+}
+
+Result <integer> integer::parse(const char * str, const std::size_t len, const integer & base) noexcept {
+    integer out;
     if ((2 <= base) && (base <= 16)){
-        if (!str.size()){
-            return;
+        if (!len){
+            return out;
         }
 
         integer::Sign sign = integer::POSITIVE;
@@ -71,49 +353,111 @@ integer::integer(const std::string & str, const integer & base) : integer()
         // minus sign indicates negative value
         if (str[0] == '-'){
             // make sure there are more digits
-            if (str.size() < 2){
-                throw std::runtime_error("Error: Input string is too short");
+            if (len < 2){
+                return Status::bad_digit;
             }
 
             sign = integer::NEGATIVE;
             index++;
         }
 
-        // process characters
-        for(; index < str.size(); index++){
+        const unsigned int b = static_cast <uint32_t> (base);
+        if (b == 16){
+            // whole bytes through the hex codec; an odd count leaves the first character on its own
+            const char * text = str + index;
+            const std::size_t n = len - index;
+            const std::size_t odd = n % 2;
+            small_vector <uint8_t, 64> raw((n + 1) / 2);
+            const char first[2] = {'0', odd?text[0]:'0'};
+            if ((odd && (hex_decode(first, 2, raw.data()) != Status::ok)) ||
+                (hex_decode(text + odd, n - odd, raw.data() + odd) != Status::ok)){
+                return Status::bad_digit;
+            }
+            load_bytes <true> (out._value, raw.data(), raw.size());
+            out._sign = sign;
+            out.trim();
+            return out;
+        }
+
+        // check every character first, then convert them all at once
+        std::vector <uint8_t> digits;
+        digits.reserve(len - index);
+        for(; index < len; index++){
             uint8_t d = std::tolower(str[index]);
             if (std::isdigit(d)){       // 0-9
                 d -= '0';
-                if (d >= base){
-                    throw std::runtime_error(std::string("Error: Not a digit in base ") + base.str(10) + ": '"+ str[index] + "'");
+                if (d >= b){
+                    return Status::bad_digit;
                 }
             }
             else if (std::isxdigit(d)){ // a-f
                 d -= 'a' - 10;
-                if (d >= base){
-                    throw std::runtime_error(std::string("Error: Not a digit in base ") + base.str(10) + ": '"+ str[index] + "'");
+                if (d >= b){
+                    return Status::bad_digit;
                 }
             }
             else{                       // bad character
-                throw std::runtime_error(std::string("Error: Not a digit in base ") + base.str(10) + ": '"+ str[index] + "'");
+                return Status::bad_digit;
             }
+            digits.push_back(d);
+        }
 
-            *this = (*this * base) + d;
+        if (const unsigned int k = radix_bits(b)){
+            out._value = pack_radix_bits(digits.data(), digits.size(), k);
+        }
+        else{
+            // one digit-sized chunk of characters at a time, then merge the chunks
+            std::size_t chunk = 0;
+            const INTEGER_DIGIT_T chunk_base = radix_chunk(b, chunk);
+            const std::size_t first = digits.size() % chunk;
+            std::vector <integer> chunks;
+            chunks.reserve(digits.size() / chunk + 1);
+            for(std::size_t i = 0; i < digits.size();){
+                const std::size_t end = (i == 0 && first)?first:(i + chunk);
+                INTEGER_DIGIT_T value = 0;
+                for(; i < end; i++){
+                    value = value * b + digits[i];
+                }
+                chunks.push_back(value);
+            }
+            out = from_digits(chunks, chunk_base);
         }
 
-        _sign = sign;
+        out._sign = sign;
     }
     else if (base == 256){
-        // process characters
-        for(unsigned char const & c : str){
-            *this = (*this << 8) | (c & 0xff);
-        }
+        out = from_bytes(reinterpret_cast <const uint8_t *> (str), len);
     }
     else{
-        throw std::runtime_error("Error: Cannot convert from base " + base.str(10));
+        return Status::bad_base;
     }
 
-    trim();
+    out.trim();
+    return out;
+}
+
+integer integer::from_digits(std::vector <integer> & digits, const integer & base){
+    if (digits.empty()){
+        return 0;
+    }
+
+    // least significant first, then merge neighbours until one value is left
+    std::reverse(digits.begin(), digits.end());
+    integer power = base;
+    while (digits.size() > 1){
+        const std::size_t pairs = digits.size() / 2;
+        for(std::size_t i = 0; i < pairs; i++){
+            digits[i] = digits[2 * i + 1] * power + digits[2 * i];
+        }
+        if (digits.size() & 1){
+            digits[pairs] = std::move(digits.back());
+        }
+        digits.resize((digits.size() + 1) / 2);
+        if (digits.size() > 1){
+            power = power.square();
+        }
+    }
+    return digits[0];
 }
 
 //  RHS input args only
@@ -126,10 +470,11 @@ integer & integer::operator=(const integer & rhs){
 }
 
 integer & integer::operator=(integer && rhs){
-    if (*this != rhs){
+    if (this != &rhs){
         _sign = rhs._sign;
-        _value = rhs._value;
-        rhs = 0;
+        _value = std::move(rhs._value);
+        rhs._value.clear();
+        rhs._sign = integer::POSITIVE;
     }
     return trim();
 }
@@ -140,7 +485,7 @@ integer::operator bool() const {
 }
 
 integer::operator uint8_t() const {
-    const uint8_t out = static_cast <uint8_t> (_value.empty()?0:_value.back() & 255);
+    const uint8_t out = static_cast <uint8_t> (_value.empty()?0:_value[0] & 255);
     return _sign?-out:out;
 }
 
@@ -149,7 +494,7 @@ integer::operator uint16_t() const {
 
     const integer::REP_SIZE_T d = std::min(digits(), std::max((integer::REP_SIZE_T) 2 / integer::OCTETS, (integer::REP_SIZE_T) 1));
     for(integer::REP_SIZE_T x = 0; x < d; x++){
-        out += static_cast <uint16_t> (_value[digits() - x - 1]) << (x * integer::BITS);
+        out += static_cast <uint16_t> (_value[x]) << (x * integer::BITS);
     }
 
     return _sign?-out:out;
@@ -160,7 +505,7 @@ integer::operator uint32_t() const {
 
     const integer::REP_SIZE_T d = std::min(digits(), std::max((integer::REP_SIZE_T) 4 / integer::OCTETS, (integer::REP_SIZE_T) 1));
     for(integer::REP_SIZE_T x = 0; x < d; x++){
-        out += static_cast <uint32_t> (_value[digits() - x - 1]) << (x * integer::BITS);
+        out += static_cast <uint32_t> (_value[x]) << (x * integer::BITS);
     }
 
     return _sign?-out:out;
@@ -171,14 +516,14 @@ integer::operator uint64_t() const {
 
     const integer::REP_SIZE_T d = std::min(digits(), std::max((integer::REP_SIZE_T) 8 / integer::OCTETS, (integer::REP_SIZE_T) 1));
     for(integer::REP_SIZE_T x = 0; x < d; x++){
-        out += static_cast <uint64_t> (_value[digits() - x - 1]) << (x * integer::BITS);
+        out += static_cast <uint64_t> (_value[x]) << (x * integer::BITS);
     }
 
     return _sign?-out:out;
 }
 
 integer::operator int8_t() const {
-    const int8_t out = static_cast <int8_t> (_value.empty()?0:_value.back() & 255);
+    const int8_t out = static_cast <int8_t> (_value.empty()?0:_value[0] & 255);
     return _sign?-out:out;
 }
 
@@ -187,7 +532,7 @@ integer::operator int16_t() const {
 
     const integer::REP_SIZE_T d = std::min(digits(), std::max((integer::REP_SIZE_T) 2 / integer::OCTETS, (integer::REP_SIZE_T) 1));
     for(integer::REP_SIZE_T x = 0; x < d; x++){
-        out += static_cast <int16_t> (_value[digits() - x - 1]) << (x * integer::BITS);
+        out += static_cast <int16_t> (_value[x]) << (x * integer::BITS);
     }
 
     return _sign?-out:out;
@@ -198,7 +543,7 @@ integer::operator int32_t() const {
 
     const integer::REP_SIZE_T d = std::min(digits(), std::max((integer::REP_SIZE_T) 4 / integer::OCTETS, (integer::REP_SIZE_T) 1));
     for(integer::REP_SIZE_T x = 0; x < d; x++){
-        out += static_cast <int32_t> (_value[digits() - x - 1]) << (x * integer::BITS);
+        out += static_cast <int32_t> (_value[x]) << (x * integer::BITS);
     }
 
     return _sign?-out:out;
@@ -209,107 +554,106 @@ integer::operator int64_t() const {
 
     const integer::REP_SIZE_T d = std::min(digits(), std::max((integer::REP_SIZE_T) 8 / integer::OCTETS, (integer::REP_SIZE_T) 1));
     for(integer::REP_SIZE_T x = 0; x < d; x++){
-        out += static_cast <int64_t> (_value[digits() - x - 1]) << (x * integer::BITS);
+        out += static_cast <int64_t> (_value[x]) << (x * integer::BITS);
     }
 
     return _sign?-out:out;
 }
 
 // Bitwise Operators
-integer integer::operator&(const integer & rhs) const {
-    integer::REP out;
-
-    const integer::REP_SIZE_T max_bits = std::max(bits(), rhs.bits());
-    const integer             left     = (    _sign == integer::POSITIVE)?*this:twos_complement(max_bits);
-    const integer             right    = (rhs._sign == integer::POSITIVE)?rhs:rhs.twos_complement(max_bits);
+namespace {
 
-    // AND matching digits
-    for(integer::REP::const_reverse_iterator i = left._value.rbegin(), j = right._value.rbegin(); (i != left._value.rend()) && (j != right._value.rend()); i++, j++){
-        out.push_front(*i & *j);
+// out[i] = op(out[i], in[i]) for i < n: plain loops over whole digits, which
+// the compiler unrolls and vectorizes for long operands
+template <typename Op>
+void bitwise_words(INTEGER_DIGIT_T * out, const INTEGER_DIGIT_T * in, const std::size_t n, Op op){
+    for(std::size_t i = 0; i < n; i++){
+        out[i] = op(out[i], in[i]);
     }
+}
 
-    // drop any digits that don't match up
-
-    integer OUT(out, integer::POSITIVE);
-    if (_sign & rhs._sign){
-        OUT = OUT.twos_complement(max_bits);
+// x = 2^(n digits) - x in place, the two's complement of n digits
+void negate_words(INTEGER_DIGIT_T * x, const std::size_t n){
+    INTEGER_DIGIT_T carry = 1;
+    for(std::size_t i = 0; i < n; i++){
+        x[i] = static_cast <INTEGER_DIGIT_T> (~x[i]) + carry;
+        carry &= static_cast <INTEGER_DIGIT_T> (x[i] == 0);
     }
-
-    return OUT.trim();
 }
 
-integer & integer::operator&=(const integer & rhs){
-    return *this = *this & rhs;
+void bitwise_dispatch(INTEGER_DIGIT_T * out, const INTEGER_DIGIT_T * in, const std::size_t n, const int op){
+    switch (op){
+        case 0:  bitwise_words(out, in, n, [](INTEGER_DIGIT_T a, INTEGER_DIGIT_T b){ return a & b; }); break;
+        case 1:  bitwise_words(out, in, n, [](INTEGER_DIGIT_T a, INTEGER_DIGIT_T b){ return a | b; }); break;
+        default: bitwise_words(out, in, n, [](INTEGER_DIGIT_T a, INTEGER_DIGIT_T b){ return a ^ b; }); break;
+    }
 }
 
-integer integer::operator|(const integer & rhs) const {
-    const integer::REP_SIZE_T max_bits = std::max(bits(), rhs.bits());
-    const integer             left     = (    _sign == integer::POSITIVE)?*this:twos_complement(max_bits);
-    const integer             right    = (rhs._sign == integer::POSITIVE)?rhs:rhs.twos_complement(max_bits);
-
-    integer::REP out;
-    integer::REP::const_reverse_iterator i = left._value.rbegin(), j = right._value.rbegin();
+}
 
-    // OR matching digits
-    for(; (i != left._value.rend()) && (j != right._value.rend()); i++, j++){
-        out.push_front(*i | *j);
+integer & integer::bitwise(const integer & rhs, const bit_op op){
+    const int code = (op == bit_op::AND)?0:(op == bit_op::OR)?1:2;
+    if ((_sign == integer::POSITIVE) && (rhs._sign == integer::POSITIVE)){
+        // the common case: the magnitudes alone, in place
+        if (op == bit_op::AND){
+            _value.resize(std::min(_value.size(), rhs._value.size()));
+            bitwise_dispatch(_value.data(), rhs._value.data(), _value.size(), code);
+        }
+        else{
+            const std::size_t n = rhs._value.size();
+            if (_value.size() < n){
+                _value.resize(n, 0);
+            }
+            bitwise_dispatch(_value.data(), rhs._value.data(), n, code);
+        }
+        return trim();
     }
 
-    // push rest of *this into value
-    while (i != left._value.rend()){
-        out.push_front(*i++);
+    // two's complement over a digit more than either operand, so the top
+    // digit is all sign bits; a negative result is turned back the same way
+    const std::size_t n = std::max(_value.size(), rhs._value.size()) + 1;
+    integer::REP other = rhs._value;
+    other.resize(n, 0);
+    if (rhs._sign == integer::NEGATIVE){
+        negate_words(other.data(), n);
     }
-
-    // push rest of rhs into value
-    while (j != right._value.rend()){
-        out.push_front(*j++);
+    _value.resize(n, 0);
+    if (_sign == integer::NEGATIVE){
+        negate_words(_value.data(), n);
     }
-
-    integer OUT(out, integer::POSITIVE);
-    if (_sign | rhs._sign){
-        OUT = OUT.twos_complement(max_bits);
+    bitwise_dispatch(_value.data(), other.data(), n, code);
+    _sign = (_value[n - 1] & HIGH_BIT)?integer::NEGATIVE:integer::POSITIVE;
+    if (_sign == integer::NEGATIVE){
+        negate_words(_value.data(), n);
     }
-
-    return OUT.trim();
+    return trim();
 }
 
-integer & integer::operator|=(const integer & rhs){
-    return *this = *this | rhs;
+integer integer::operator&(const integer & rhs) const {
+    integer out(*this);
+    return out.bitwise(rhs, bit_op::AND);
 }
 
-integer integer::operator^(const integer & rhs) const {
-    const integer::REP_SIZE_T max_bits = std::max(bits(), rhs.bits());
-    const integer             left     = (    _sign == integer::POSITIVE)?*this:twos_complement(max_bits);
-    const integer             right    = (rhs._sign == integer::POSITIVE)?rhs:rhs.twos_complement(max_bits);
-
-    integer::REP out;
-    integer::REP::const_reverse_iterator i = left._value.rbegin(), j = right._value.rbegin();
-
-    // XOR matching digits
-    for(; (i != left._value.rend()) && (j != right._value.rend()); i++, j++){
-        out.push_front(*i ^ *j);
-    }
-
-    // push *this into value
-    while (i != left._value.rend()){
-        out.push_front(*i++);
-    }
+integer & integer::operator&=(const integer & rhs){
+    return bitwise(rhs, bit_op::AND);
+}
 
-    // push rhs into value
-    while (j != right._value.rend()){
-        out.push_front(*j++);
-    }
+integer integer::operator|(const integer & rhs) const {
+    integer out(*this);
+    return out.bitwise(rhs, bit_op::OR);
+}
 
-    integer OUT(out, integer::POSITIVE);
-    if (_sign ^ rhs._sign){
-        OUT = OUT.twos_complement(max_bits);
-    }
+integer & integer::operator|=(const integer & rhs){
+    return bitwise(rhs, bit_op::OR);
+}
 
-    return OUT.trim();
+integer integer::operator^(const integer & rhs) const {
+    integer out(*this);
+    return out.bitwise(rhs, bit_op::XOR);
 }
 
 integer & integer::operator^=(const integer & rhs){
-    return *this = *this ^ rhs;
+    return bitwise(rhs, bit_op::XOR);
 }
 
 integer integer::operator~() const {
@@ -318,74 +662,80 @@ integer integer::operator~() const {
         return 1;
     }
 
-    integer::REP out = _value;
-
-    // invert whole digits
-    for(integer::REP_SIZE_T i = 1; i < out.size(); i++){
-        out[i] ^= integer::NEG1;
+    // invert whole digits, then the bits of the top digit below its highest
+    integer out(*this);
+    for(integer::REP_SIZE_T i = 0; (i + 1) < out._value.size(); i++){
+        out._value[i] = ~out._value[i];
     }
+    const std::size_t top = digit_bit_length(out._value.back());
+    out._value.back() ^= (top == integer::BITS)?integer::NEG1:((static_cast <INTEGER_DIGIT_T> (1) << top) - 1);
+    return out.trim();
+}
 
-    INTEGER_DIGIT_T mask = HIGH_BIT;
-    while (!(out[0] & mask)){
-        mask >>= 1;
+uint64_t integer::extract_bits(const std::size_t pos, const std::size_t len) const {
+    if (!len){
+        return 0;
     }
-
-    // invert bits of partial digit
-    while (mask){
-        out[0] ^= mask;
-        mask >>= 1;
+    uint64_t out = 0;
+    std::size_t got = 0;
+    for(std::size_t i = pos / integer::BITS, shift = pos % integer::BITS; (got < len) && (i < _value.size()); i++, shift = 0){
+        out |= static_cast <uint64_t> (_value[i] >> shift) << got;
+        got += integer::BITS - shift;
     }
-
-    return integer(out, _sign);
+    return (len < 64)?(out & ((static_cast <uint64_t> (1) << len) - 1)):out;
 }
 
 // Bit Shift Operators
 
 // left bit shift. sign is maintained
 integer integer::operator<<(const integer & shift) const {
-    if (!*this || !shift){
-        return *this;
-    }
-
     if (shift < 0){
         throw std::runtime_error("Error: Negative shift amount");
     }
 
-    const std::pair <integer, integer> qr = dm(shift, integer::BITS);
-    const integer & whole      = qr.first;             // number of zeros to add to the back
-    const INTEGER_DIGIT_T push = qr.second;            // push left by this many bits
-    const INTEGER_DIGIT_T pull = integer::BITS - push; // pull "push" bits from the right
-
-    integer::REP out = _value;
+    return *this << static_cast <std::size_t> (static_cast <uint64_t> (shift));
+}
 
-    out.push_front(0);                                 // extra digit for shifting into
-    out.push_back(0);                                  // extra digit for shifting from
+integer integer::operator<<(const std::size_t shift) const {
+    integer out(*this);
+    return out <<= shift;
+}
 
-    // do this part first to avoid shifting zeros
-    for(integer::REP_SIZE_T i = 0; i < (out.size() - 1); i++){
-        INTEGER_DOUBLE_DIGIT_T d = out[i];
-        d = (d << push) | (out[i + 1] >> pull);
-        out[i] = d & NEG1;
-        // out[i] = (out[i] << push) | (out[i + 1] >> pull);
+integer & integer::operator<<=(const integer & shift){
+    if (shift < 0){
+        throw std::runtime_error("Error: Negative shift amount");
     }
 
-    if (!out[0]){                                      // if the top digit is still 0
-        out.pop_front();                               // remove it
+    return *this <<= static_cast <std::size_t> (static_cast <uint64_t> (shift));
+}
+
+integer & integer::operator<<=(const std::size_t shift){
+    if (_value.empty() || !shift){
+        return *this;
     }
 
-    if (!whole){                                       // if there was no need for the 0 at the end
-        out.pop_back();                                // remove it
+    const integer::REP_SIZE_T whole = shift / integer::BITS;  // number of zero digits to add to the bottom
+    const std::size_t         push  = shift % integer::BITS;  // push left by this many bits
+    const std::size_t         pull  = integer::BITS - push;   // pull "push" bits from the next lower digit
+    const integer::REP_SIZE_T n     = _value.size();
+
+    // one extra digit for shifting into; work from the top down so nothing is overwritten before it is read
+    _value.resize(n + whole + 1, 0);
+    if (!push){
+        for(integer::REP_SIZE_T i = n; i > 0; i--){
+            _value[whole + i - 1] = _value[i - 1];
+        }
     }
     else{
-        // push back zeros, excluding the one already there
-        out.insert(out.end(), whole - 1, 0);
+        _value[n + whole] = _value[n - 1] >> pull;
+        for(integer::REP_SIZE_T i = n - 1; i > 0; i--){
+            _value[whole + i] = static_cast <INTEGER_DIGIT_T> (_value[i] << push) | (_value[i - 1] >> pull);
+        }
+        _value[whole] = static_cast <INTEGER_DIGIT_T> (_value[0] << push);
     }
+    std::fill(_value.begin(), _value.begin() + whole, 0);
 
-    return integer(out, _sign);
-}
-
-integer & integer::operator<<=(const integer & shift){
-    return *this = *this << integer(shift);
+    return trim();
 }
 
 // right bit shift. sign is maintained
@@ -398,31 +748,52 @@ integer integer::operator>>(const integer & shift) const {
         return 0;
     }
 
-    const std::pair <integer, integer> qr = dm(shift, integer::BITS);
-    const integer & whole      = qr.first;             // number of digits to pop off
-    const INTEGER_DIGIT_T push = qr.second;            // push right by this many bits
-    const INTEGER_DIGIT_T pull = integer::BITS - push; // pull "push" bits from the left
+    return *this >> static_cast <std::size_t> (static_cast <uint64_t> (shift));
+}
 
-    integer::REP out = _value;
+integer integer::operator>>(const std::size_t shift) const {
+    integer out(*this);
+    return out >>= shift;
+}
 
-    // pop off whole digits
-    for(integer i = 0; i < whole; i++){
-        out.pop_back();
+integer & integer::operator>>=(const integer & shift){
+    if (shift < 0){
+        throw std::runtime_error("Error: Negative shift amount");
     }
 
-    if (push){
-        out.push_front(0);                             // extra 0 for shifting from
-        for(integer::REP_SIZE_T i = 1; i < out.size(); i++){
-            out[out.size() - i] = (out[out.size() - i - 1] << pull) | (out[out.size() - i] >> push);
-        }
-        out.pop_front();
+    if (shift >= bits()){
+        return *this = 0;
     }
 
-    return integer(out, _sign);
+    return *this >>= static_cast <std::size_t> (static_cast <uint64_t> (shift));
 }
 
-integer & integer::operator>>=(const integer & shift){
-    return *this = *this >> integer(shift);
+integer & integer::operator>>=(const std::size_t shift){
+    const integer::REP_SIZE_T whole = shift / integer::BITS;  // number of digits to drop off the bottom
+    const std::size_t         push  = shift % integer::BITS;  // push right by this many bits
+    const std::size_t         pull  = integer::BITS - push;   // pull "push" bits from the next higher digit
+
+    if (whole >= _value.size()){
+        _value.clear();
+        return trim();
+    }
+
+    // work from the bottom up, so every digit is read before it is overwritten
+    const integer::REP_SIZE_T n = _value.size() - whole;
+    if (!push){
+        for(integer::REP_SIZE_T i = 0; i < n; i++){
+            _value[i] = _value[whole + i];
+        }
+    }
+    else{
+        for(integer::REP_SIZE_T i = 0; i + 1 < n; i++){
+            _value[i] = (_value[whole + i] >> push) | static_cast <INTEGER_DIGIT_T> (_value[whole + i + 1] << pull);
+        }
+        _value[n - 1] = _value[whole + n - 1] >> push;
+    }
+    _value.resize(n);
+
+    return trim();
 }
 
 // Logical Operators
@@ -431,127 +802,55 @@ bool integer::operator!(){
 }
 
 // Comparison Operators
-bool integer::operator==(const integer & rhs) const {
-    return ((_sign == rhs._sign) && (_value == rhs._value));
-}
-
 bool integer::operator!=(const integer & rhs) const {
     return !(*this == rhs);
 }
 
-// operator> not considering signs
-bool integer::gt(const integer & lhs, const integer & rhs) const {
-    if (lhs._value.size() > rhs._value.size()){
-        return true;
-    }
-    if (lhs._value.size() < rhs._value.size()){
-        return false;
-    }
-    if (lhs._value == rhs._value){
-        return false;
-    }
-    for(integer::REP_SIZE_T i = 0; i < lhs._value.size(); i++){
-        if (lhs._value[i] != rhs._value[i]){
-            return lhs._value[i] > rhs._value[i];
-        }
-    }
-    return false;
-}
-
-bool integer::operator>(const integer & rhs) const {
-    if      (    (_sign == integer::NEGATIVE) &&    // - > +
-                 (rhs._sign == integer::POSITIVE)){
-        return false;
-    }
-    else if (   (_sign == integer::POSITIVE) &&     // + > -
-                (rhs._sign == integer::NEGATIVE)){
-        return true;
-    }
-    else if (   (_sign == integer::NEGATIVE) &&     // - > -
-                (rhs._sign == integer::NEGATIVE)){
-        return gt(rhs, *this);
-    }
-    // else if (    (_sign == integer::POSITIVE) && // + > +
-    //  (rhs._sign == integer::POSITIVE)){
-    return gt(*this, rhs);
-}
-
-bool integer::operator>=(const integer & rhs) const {
-    return ((*this > rhs) | (*this == rhs));
-}
-
-// operator< not considering signs
-bool integer::lt(const integer & lhs, const integer & rhs) const {
-    if (lhs._value.size() < rhs._value.size()){
-        return true;
-    }
-    if (lhs._value.size() > rhs._value.size()){
-        return false;
-    }
-    if (lhs._value == rhs._value){
-        return false;
+int integer::compare_magnitude(const integer & lhs, const integer & rhs){
+    if (lhs._value.size() != rhs._value.size()){
+        return (lhs._value.size() > rhs._value.size())?1:-1;
     }
-    for(integer::REP_SIZE_T i = 0; i < lhs._value.size(); i++){
-        if (lhs._value[i] != rhs._value[i]){
-            return lhs._value[i] < rhs._value[i];
+    for(integer::REP_SIZE_T i = lhs._value.size(); i > 0; i--){
+        if (lhs._value[i - 1] != rhs._value[i - 1]){
+            return (lhs._value[i - 1] > rhs._value[i - 1])?1:-1;
         }
     }
-    return false;
+    return 0;
 }
 
-bool integer::operator<(const integer & rhs) const {
-    if      (    (_sign == integer::NEGATIVE) &&     // - < +
-                 (rhs._sign == integer::POSITIVE)){
-        return true;
-    }
-    else if (    (_sign == integer::POSITIVE) &&     // + < -
-                 (rhs._sign == integer::NEGATIVE)){
-        return false;
-    }
-    else if (    (_sign == integer::NEGATIVE) &&     // - < -
-                 (rhs._sign == integer::NEGATIVE)){
-        return lt(rhs, *this);
+int integer::compare(const integer & rhs) const {
+    if (_sign != rhs._sign){                // - < +
+        return (_sign == integer::NEGATIVE)?-1:1;
     }
-    // else if (    (_sign == integer::POSITIVE) &&  // + < +
-    //  (rhs._sign == integer::POSITIVE)){
-    return lt(*this, rhs);
-}
-
-bool integer::operator<=(const integer & rhs) const {
-    return ((*this < rhs) | (*this == rhs));
+    const int magnitude = compare_magnitude(*this, rhs);
+    return (_sign == integer::NEGATIVE)?-magnitude:magnitude;
 }
 
 // Arithmetic Operators
 integer integer::add(const integer & lhs, const integer & rhs) const {
-    integer::REP out;
-    integer::REP::const_reverse_iterator i = lhs._value.rbegin(), j = rhs._value.rbegin();
-    bool carry = false;
+    const integer::REP & longer  = (lhs._value.size() >= rhs._value.size())?lhs._value:rhs._value;
+    const integer::REP & shorter = (lhs._value.size() >= rhs._value.size())?rhs._value:lhs._value;
+
+    integer::REP out(longer.size() + 1, 0);
     INTEGER_DOUBLE_DIGIT_T sum;
+    INTEGER_DIGIT_T carry = 0;
 
     // add up matching digits
-    for(; ((i != lhs._value.rend()) && (j != rhs._value.rend())); i++, j++){
-        sum = static_cast <INTEGER_DOUBLE_DIGIT_T> (*i) + static_cast <INTEGER_DOUBLE_DIGIT_T> (*j) + carry;
-        out.push_front(sum);
-        carry = (sum > integer::NEG1);
-    }
-
-    // copy in lhs extra digits
-    for(; i != lhs._value.rend(); i++){
-        sum = static_cast <INTEGER_DOUBLE_DIGIT_T> (*i) + carry;
-        out.push_front(sum);
-        carry = (sum > integer::NEG1);
+    integer::REP_SIZE_T i = 0;
+    for(; i < shorter.size(); i++){
+        sum = static_cast <INTEGER_DOUBLE_DIGIT_T> (longer[i]) + static_cast <INTEGER_DOUBLE_DIGIT_T> (shorter[i]) + carry;
+        out[i] = static_cast <INTEGER_DIGIT_T> (sum);
+        carry = static_cast <INTEGER_DIGIT_T> (sum >> integer::BITS);
     }
 
-    // copy in rhs extra digits
-    for(; j != rhs._value.rend(); j++){
-        sum = static_cast <INTEGER_DOUBLE_DIGIT_T> (*j) + carry;
-        out.push_front(sum);
-        carry = (sum > integer::NEG1);
+    // copy in extra digits of the longer value
+    for(; i < longer.size(); i++){
+        sum = static_cast <INTEGER_DOUBLE_DIGIT_T> (longer[i]) + carry;
+        out[i] = static_cast <INTEGER_DIGIT_T> (sum);
+        carry = static_cast <INTEGER_DIGIT_T> (sum >> integer::BITS);
     }
 
-    if (carry){
-        out.push_front(1);
-    }
+    out[i] = carry;
     return integer(out);
 }
 
@@ -565,7 +864,11 @@ integer integer::operator+(const integer & rhs) const {
     }
 
     integer out = *this;
-    if (gt(out, rhs)){              // lhs > rhs
+    if (rhs._value.size() == 1){    // one digit: a single carry or borrow pass
+        return out.add_signed_word(rhs._sign, rhs._value[0]);
+    }
+    const int order = compare_magnitude(out, rhs);
+    if (order > 0){                 // lhs > rhs
         if (_sign == rhs._sign){    // same sign: lhs + rhs
             out = add(out, rhs);
         }
@@ -574,7 +877,7 @@ integer integer::operator+(const integer & rhs) const {
         }
         out._sign = _sign;          // lhs sign dominates
     }
-    else if (lt(out, rhs)){         // lhs < rhs
+    else if (order < 0){            // lhs < rhs
         if (_sign == rhs._sign){    // same sign: rhs + lhs
             out = add(rhs, out);
         }
@@ -597,39 +900,37 @@ integer integer::operator+(const integer & rhs) const {
 }
 
 integer & integer::operator+=(const integer & rhs){
-    return *this = *this + rhs;
+    if (this == &rhs){
+        return *this <<= 1;
+    }
+    if (rhs._value.size() == 1){
+        return add_signed_word(rhs._sign, rhs._value[0]);
+    }
+    if (_sign == rhs._sign){
+        return add_magnitude(rhs._value);
+    }
+    return sub_magnitude(rhs._value);
 }
 
 // Subtraction as done by hand
 integer integer::long_sub(const integer & lhs, const integer & rhs) const {
     // rhs always smaller than lhs
     integer out = lhs;
-    integer::REP_SIZE_T lsize = out._value.size() - 1;
-    integer::REP_SIZE_T rsize = rhs._value.size() - 1;
-
-    for(integer::REP_SIZE_T x = 0; x <= rsize; x++){
-        // if top is bigger than or equal to the bottom, just substract
-        if (out._value[lsize - x] >= rhs._value[rsize - x]){
-            out._value[lsize - x] -= rhs._value[rsize - x];
-        }
-        else{// find a higher digit to carry from
-            integer::REP_SIZE_T y = lsize - x - 1;
-            // if this goes out of bounds, something is wrong
-            while (!out._value[y]){
-                y--;
-            }
+    INTEGER_DIGIT_T borrow = 0;
 
-            out._value[y]--;
-            y++;
-
-            for(; y < lsize - x; y++){
-                out._value[y] = integer::NEG1;
-            }
-
-            out._value[y] = static_cast <INTEGER_DOUBLE_DIGIT_T> (out._value[y]) + (static_cast <uint64_t> (1) << integer::BITS) - rhs._value[rsize - x];
+    for(integer::REP_SIZE_T x = 0; x < out._value.size(); x++){
+        const INTEGER_DIGIT_T r = (x < rhs._value.size())?rhs._value[x]:0;
+        if ((x >= rhs._value.size()) && !borrow){
+            break;
         }
+
+        // the double digit wraps around on underflow, so its low bit above BITS is the borrow
+        const INTEGER_DOUBLE_DIGIT_T diff = static_cast <INTEGER_DOUBLE_DIGIT_T> (out._value[x]) - r - borrow;
+        out._value[x] = static_cast <INTEGER_DIGIT_T> (diff);
+        borrow = static_cast <INTEGER_DIGIT_T> ((diff >> integer::BITS) & 1);
     }
-    return out;
+
+    return out.trim();
 }
 
 //// Two's Complement Subtraction
@@ -656,7 +957,11 @@ integer integer::sub(const integer & lhs, const integer & rhs) const {
 
 integer integer::operator-(const integer & rhs) const {
     integer out = *this;
-    if (gt(out, rhs)){                                  // if lhs > rhs
+    if (rhs._value.size() == 1){                        // one digit: a single carry or borrow pass
+        return out.add_signed_word(!rhs._sign, rhs._value[0]);
+    }
+    const int order = compare_magnitude(out, rhs);
+    if (order > 0){                                     // if lhs > rhs
         if (out._sign == rhs._sign){                    // same signs
             out = sub(out, rhs);
         }
@@ -665,7 +970,7 @@ integer integer::operator-(const integer & rhs) const {
         }
         out._sign = _sign;                              // lhs sign dominates
     }
-    else if (lt(out, rhs)){                             // if lhs < rhs
+    else if (order < 0){                                // if lhs < rhs
         if      (    (_sign == integer::NEGATIVE) &&    // - - -
                      (rhs._sign == integer::NEGATIVE)){
             out = sub(rhs, out);
@@ -701,10 +1006,130 @@ integer integer::operator-(const integer & rhs) const {
 }
 
 integer & integer::operator-=(const integer & rhs){
-    return *this = *this - rhs;
+    if (this == &rhs){
+        _value.clear();
+        return trim();
+    }
+    if (rhs._value.size() == 1){
+        return add_signed_word(!rhs._sign, rhs._value[0]);
+    }
+    if (_sign == rhs._sign){
+        return sub_magnitude(rhs._value);
+    }
+    return add_magnitude(rhs._value);
 }
 
-// // Peasant Multiplication
+integer & integer::addmul(const integer & a, const integer & b){
+    return mac(a, b, a._sign ^ b._sign);
+}
+
+integer & integer::submul(const integer & a, const integer & b){
+    return mac(a, b, !(a._sign ^ b._sign));
+}
+
+integer & integer::mac(const integer & a, const integer & b, const integer::Sign sign){
+    if (!a || !b){
+        return *this;
+    }
+
+    // a single digit factor against a value other than *this: one multiply-accumulate
+    // row straight into the digits when the magnitudes add
+    const bool a_word = (a._value.size() == 1), b_word = (b._value.size() == 1);
+    const integer & x = b_word?a:b;
+    if ((a_word || b_word) && (this != &x) && (_value.empty() || (_sign == sign))){
+        const INTEGER_DIGIT_T w = b_word?b._value[0]:a._value[0];
+        const integer::REP_SIZE_T n = x._value.size();
+        if (_value.size() < n){
+            _value.resize(n, 0);
+        }
+        INTEGER_DIGIT_T carry = 0;
+        for(integer::REP_SIZE_T i = 0; i < n; i++){
+            const INTEGER_DOUBLE_DIGIT_T t = static_cast <INTEGER_DOUBLE_DIGIT_T> (x._value[i]) * w + _value[i] + carry;
+            _value[i] = static_cast <INTEGER_DIGIT_T> (t);
+            carry = static_cast <INTEGER_DIGIT_T> (t >> integer::BITS);
+        }
+        _sign = sign;
+        if (carry){
+            for(integer::REP_SIZE_T i = n; carry && (i < _value.size()); i++){
+                _value[i] = static_cast <INTEGER_DIGIT_T> (_value[i] + carry);
+                carry = (_value[i] < carry);
+            }
+            if (carry){
+                _value.push_back(carry);
+            }
+        }
+        return *this;
+    }
+
+    // otherwise the product gets its own buffer and is accumulated in place
+    integer product = (&a == &b)?a.square():mult(a, b);
+    product._sign = sign;
+    product.trim();
+    return *this += product;
+}
+
+// |*this| += |rhs| in place
+integer & integer::add_magnitude(const integer::REP & rhs){
+    const integer::REP_SIZE_T n = rhs.size();
+    if (_value.size() < n){
+        _value.resize(n, 0);
+    }
+    INTEGER_DIGIT_T carry = 0;
+    integer::REP_SIZE_T i = 0;
+    for(; i < n; i++){
+        const INTEGER_DOUBLE_DIGIT_T sum = static_cast <INTEGER_DOUBLE_DIGIT_T> (_value[i]) + rhs[i] + carry;
+        _value[i] = static_cast <INTEGER_DIGIT_T> (sum);
+        carry = static_cast <INTEGER_DIGIT_T> (sum >> integer::BITS);
+    }
+    for(; carry && (i < _value.size()); i++){
+        _value[i] = static_cast <INTEGER_DIGIT_T> (_value[i] + carry);
+        carry = (_value[i] < carry);
+    }
+    if (carry){
+        _value.push_back(carry);
+    }
+    return trim();
+}
+
+// |*this| - |rhs| in place, flipping the sign when |rhs| is the larger
+integer & integer::sub_magnitude(const integer::REP & rhs){
+    // compare the magnitudes from the top
+    int cmp = (_value.size() > rhs.size()) - (_value.size() < rhs.size());
+    for(integer::REP_SIZE_T i = _value.size(); !cmp && (i > 0); i--){
+        cmp = (_value[i - 1] > rhs[i - 1]) - (_value[i - 1] < rhs[i - 1]);
+    }
+    if (!cmp){
+        _value.clear();
+        return trim();
+    }
+
+    INTEGER_DIGIT_T borrow = 0;
+    if (cmp > 0){               // |*this| - |rhs|
+        integer::REP_SIZE_T i = 0;
+        for(; i < rhs.size(); i++){
+            const INTEGER_DOUBLE_DIGIT_T diff = static_cast <INTEGER_DOUBLE_DIGIT_T> (_value[i]) - rhs[i] - borrow;
+            _value[i] = static_cast <INTEGER_DIGIT_T> (diff);
+            borrow = static_cast <INTEGER_DIGIT_T> ((diff >> integer::BITS) & 1);
+        }
+        for(; borrow && (i < _value.size()); i++){
+            borrow = !_value[i];
+            _value[i] = static_cast <INTEGER_DIGIT_T> (_value[i] - 1);
+        }
+    }
+    else{                       // |rhs| - |*this|, written over *this digit by digit
+        const integer::REP_SIZE_T n = _value.size();
+        _value.resize(rhs.size(), 0);
+        for(integer::REP_SIZE_T i = 0; i < rhs.size(); i++){
+            const INTEGER_DOUBLE_DIGIT_T diff = static_cast <INTEGER_DOUBLE_DIGIT_T> (rhs[i]) - ((i < n)?_value[i]:0) - borrow;
+            _value[i] = static_cast <INTEGER_DIGIT_T> (diff);
+            borrow = static_cast <INTEGER_DIGIT_T> ((diff >> integer::BITS) & 1);
+        }
+        _sign = !_sign;
+    }
+    return trim();
+}
+
+// // Peasant Multiplication
 // integer integer::peasant(const integer & lhs, const integer & rhs) const {
 // integer rhs_copy = rhs;
 // integer sum = 0;
@@ -815,160 +1240,853 @@ integer & integer::operator-=(const integer & rhs){
 // return peasant(peasant(peasant(peasant(r4, B) + r3, B) + r2, B) + r1, B) + r0;
 // }
 
-// // Long multiplication
-// integer integer::long_mult(const integer & lhs, const integer & rhs) const {
-// unsigned int zeros = 0;
-// integer row, out = 0;
-// for(integer::REP::const_reverse_iterator i = lhs._value.rbegin(); i != lhs._value.rend(); i++){
-// row._value = integer::REP(zeros++, 0); // zeros on the right hand side
-// INTEGER_DIGIT_T carry = 0;
-// for(integer::REP::const_reverse_iterator j = rhs._value.rbegin(); j != rhs._value.rend(); j++){
-// INTEGER_DOUBLE_DIGIT_T prod = (INTEGER_DOUBLE_DIGIT_T) *i * (INTEGER_DOUBLE_DIGIT_T) *j + carry;// multiply through
-// row._value.push_front(prod & integer::NEG1);
-// carry = prod >> integer::BITS;
-// }
-// if (carry){
-// row._value.push_front(carry);
-// }
-// out = add(out, row);
-// }
-// return out;
-// }
+// Digit array helpers for the multiplication tiers
+static constexpr std::size_t DIGIT_BITS = sizeof(INTEGER_DIGIT_T) << 3;
+
+// r[0, n + m) = a[0, n) * b[0, m)
+static void mul_basecase(INTEGER_DIGIT_T * r, const INTEGER_DIGIT_T * a, std::size_t n, const INTEGER_DIGIT_T * b, std::size_t m){
+    std::fill(r, r + n + m, 0);
+    for(std::size_t i = 0; i < n; i++){
+        INTEGER_DOUBLE_DIGIT_T carry = 0;
+        for(std::size_t j = 0; j < m; j++){
+            // (2^BITS - 1)^2 + 2 * (2^BITS - 1) still fits in a double digit
+            const INTEGER_DOUBLE_DIGIT_T prod = static_cast <INTEGER_DOUBLE_DIGIT_T> (a[i]) * b[j] + r[i + j] + carry;
+            r[i + j] = static_cast <INTEGER_DIGIT_T> (prod);
+            carry = prod >> DIGIT_BITS;
+        }
+        r[i + m] = static_cast <INTEGER_DIGIT_T> (carry);
+    }
+}
 
-//Private FFT helper function
-int integer::fft(std::deque<double>& data, bool dir) const
-{
-    //Verify size is a power of two
-    std::size_t n = data.size()/2;
-    if ((n == 0) || (n & (n-1))) return 1;
+// r[0, n) += a[0, m) with m <= n, returns the carry out of r
+static INTEGER_DIGIT_T add_digits(INTEGER_DIGIT_T * r, std::size_t n, const INTEGER_DIGIT_T * a, std::size_t m){
+    INTEGER_DIGIT_T carry = 0;
+    std::size_t i = 0;
+    for(; i < m; i++){
+        const INTEGER_DOUBLE_DIGIT_T sum = static_cast <INTEGER_DOUBLE_DIGIT_T> (r[i]) + a[i] + carry;
+        r[i] = static_cast <INTEGER_DIGIT_T> (sum);
+        carry = static_cast <INTEGER_DIGIT_T> (sum >> DIGIT_BITS);
+    }
+    for(; carry && (i < n); i++){
+        carry = !++r[i];
+    }
+    return carry;
+}
+
+// r[0, n) -= a[0, m) with m <= n, returns the borrow out of r
+static INTEGER_DIGIT_T sub_digits(INTEGER_DIGIT_T * r, std::size_t n, const INTEGER_DIGIT_T * a, std::size_t m){
+    INTEGER_DIGIT_T borrow = 0;
+    std::size_t i = 0;
+    for(; i < m; i++){
+        const INTEGER_DOUBLE_DIGIT_T diff = static_cast <INTEGER_DOUBLE_DIGIT_T> (r[i]) - a[i] - borrow;
+        r[i] = static_cast <INTEGER_DIGIT_T> (diff);
+        borrow = static_cast <INTEGER_DIGIT_T> ((diff >> DIGIT_BITS) & 1);
+    }
+    for(; borrow && (i < n); i++){
+        borrow = !r[i]--;
+    }
+    return borrow;
+}
+
+// r[0, 2n) = a[0, n) * b[0, n), t is scratch space of karatsuba_scratch(n) digits
+static void karatsuba_kernel(INTEGER_DIGIT_T * r, const INTEGER_DIGIT_T * a, const INTEGER_DIGIT_T * b, std::size_t n, INTEGER_DIGIT_T * t, std::size_t leaf){
+    if (n <= leaf){
+        mul_basecase(r, a, n, b, n);
+        return;
+    }
+
+    const std::size_t lo = n / 2;   // digits in the low halves
+    const std::size_t hi = n - lo;  // digits in the high halves, hi >= lo
+
+    INTEGER_DIGIT_T * sa   = t;                 // a0 + a1, hi + 1 digits
+    INTEGER_DIGIT_T * sb   = sa + hi + 1;       // b0 + b1, hi + 1 digits
+    INTEGER_DIGIT_T * z1   = sb + hi + 1;       // (a0 + a1) * (b0 + b1), 2 * hi + 2 digits
+    INTEGER_DIGIT_T * next = z1 + 2 * hi + 2;
+
+    std::copy(a + lo, a + n, sa);
+    sa[hi] = add_digits(sa, hi, a, lo);
+    std::copy(b + lo, b + n, sb);
+    sb[hi] = add_digits(sb, hi, b, lo);
+
+    karatsuba_kernel(r, a, b, lo, next, leaf);                  // z0 = a0 * b0 in r[0, 2 lo)
+    karatsuba_kernel(r + 2 * lo, a + lo, b + lo, hi, next, leaf); // z2 = a1 * b1 in r[2 lo, 2n)
+    karatsuba_kernel(z1, sa, sb, hi + 1, next, leaf);
+
+    // z1 - z0 - z2 fits in 2 * hi + 1 digits, and at most 2n - lo of them can be nonzero
+    sub_digits(z1, 2 * hi + 2, r, 2 * lo);
+    sub_digits(z1, 2 * hi + 2, r + 2 * lo, 2 * hi);
+    add_digits(r + lo, 2 * n - lo, z1, std::min(2 * hi + 2, 2 * n - lo));
+}
+
+// r[0, 2n) = a[0, n)^2: the cross products once, doubled, plus the diagonal
+static void sqr_basecase(INTEGER_DIGIT_T * r, const INTEGER_DIGIT_T * a, std::size_t n){
+    std::fill(r, r + 2 * n, 0);
+    for(std::size_t i = 0; i + 1 < n; i++){
+        INTEGER_DOUBLE_DIGIT_T carry = 0;
+        for(std::size_t j = i + 1; j < n; j++){
+            const INTEGER_DOUBLE_DIGIT_T prod = static_cast <INTEGER_DOUBLE_DIGIT_T> (a[i]) * a[j] + r[i + j] + carry;
+            r[i + j] = static_cast <INTEGER_DIGIT_T> (prod);
+            carry = prod >> DIGIT_BITS;
+        }
+        r[i + n] = static_cast <INTEGER_DIGIT_T> (carry);
+    }
+
+    INTEGER_DIGIT_T top = 0;
+    for(std::size_t i = 0; i < 2 * n; i++){
+        const INTEGER_DIGIT_T d = r[i];
+        r[i] = (d << 1) | top;
+        top = d >> (DIGIT_BITS - 1);
+    }
+
+    INTEGER_DOUBLE_DIGIT_T carry = 0;
+    for(std::size_t i = 0; i < n; i++){
+        const INTEGER_DOUBLE_DIGIT_T sq = static_cast <INTEGER_DOUBLE_DIGIT_T> (a[i]) * a[i];
+        INTEGER_DOUBLE_DIGIT_T sum = static_cast <INTEGER_DOUBLE_DIGIT_T> (r[2 * i]) + static_cast <INTEGER_DIGIT_T> (sq) + carry;
+        r[2 * i] = static_cast <INTEGER_DIGIT_T> (sum);
+        sum = static_cast <INTEGER_DOUBLE_DIGIT_T> (r[2 * i + 1]) + (sq >> DIGIT_BITS) + (sum >> DIGIT_BITS);
+        r[2 * i + 1] = static_cast <INTEGER_DIGIT_T> (sum);
+        carry = sum >> DIGIT_BITS;
+    }
+}
+
+// r[0, 2n) = a[0, n)^2 with three half-size squares, the middle one from (a0 + a1)^2;
+// t is scratch space of karatsuba_scratch(n) digits
+static void karatsuba_sqr_kernel(INTEGER_DIGIT_T * r, const INTEGER_DIGIT_T * a, std::size_t n, INTEGER_DIGIT_T * t, std::size_t leaf){
+    if (n <= leaf){
+        sqr_basecase(r, a, n);
+        return;
+    }
+
+    const std::size_t lo = n / 2;
+    const std::size_t hi = n - lo;
 
-    //rearrange data for signal flow chart
-    std::size_t bitr_j = 1;
-    for (std::size_t i = 3; i < 2*n-1; i += 2)
+    INTEGER_DIGIT_T * sa   = t;                 // a0 + a1, hi + 1 digits
+    INTEGER_DIGIT_T * z1   = sa + hi + 1;       // (a0 + a1)^2, 2 * hi + 2 digits
+    INTEGER_DIGIT_T * next = z1 + 2 * hi + 2;
+
+    std::copy(a + lo, a + n, sa);
+    sa[hi] = add_digits(sa, hi, a, lo);
+
+    karatsuba_sqr_kernel(r, a, lo, next, leaf);
+    karatsuba_sqr_kernel(r + 2 * lo, a + lo, hi, next, leaf);
+    karatsuba_sqr_kernel(z1, sa, hi + 1, next, leaf);
+
+    sub_digits(z1, 2 * hi + 2, r, 2 * lo);
+    sub_digits(z1, 2 * hi + 2, r + 2 * lo, 2 * hi);
+    add_digits(r + lo, 2 * n - lo, z1, std::min(2 * hi + 2, 2 * n - lo));
+}
+
+// scratch needed by karatsuba_kernel: each level takes 4 * (hi + 1) digits
+static std::size_t karatsuba_scratch(std::size_t n, std::size_t leaf){
+    std::size_t out = 0;
+    while (n > leaf){
+        const std::size_t hi = n - n / 2;
+        out += 4 * (hi + 1);
+        n = hi + 1;
+    }
+    return out;
+}
+
+// Long multiplication
+integer integer::long_mult(const integer & lhs, const integer & rhs) const {
+    integer out;
+    out._value.assign(lhs._value.size() + rhs._value.size(), 0);
+    mul_basecase(out._value.data(), lhs._value.data(), lhs._value.size(), rhs._value.data(), rhs._value.size());
+    return out.trim();
+}
+
+// Karatsuba Algorithm
+integer integer::karatsuba(const integer & lhs, const integer & rhs) const {
+    // leaves need at least 4 digits so that the hi + 1 sized middle product shrinks
+    const std::size_t LEAF = std::max((std::size_t) 4, (std::size_t) (current_tuning.karatsuba_bits / integer::BITS));
+
+    const integer::REP & longer  = (lhs._value.size() >= rhs._value.size())?lhs._value:rhs._value;
+    const integer::REP & shorter = (lhs._value.size() >= rhs._value.size())?rhs._value:lhs._value;
+    const std::size_t n = longer.size();
+    const std::size_t s = shorter.size();
+
+    integer out;
+    out._value.assign(n + s, 0);
+
+    // one buffer for the zero padded block of the longer operand (s digits),
+    // its product with the shorter one (2s digits) and the kernel scratch
+    integer::REP scratch(3 * s + karatsuba_scratch(s, LEAF));
+    INTEGER_DIGIT_T * block = scratch.data();
+    INTEGER_DIGIT_T * prod  = block + s;
+    INTEGER_DIGIT_T * t     = prod + 2 * s;
+
+    for(std::size_t off = 0; off < n; off += s){
+        const std::size_t len = std::min(s, n - off);
+        std::copy(longer.data() + off, longer.data() + off + len, block);
+        std::fill(block + len, block + s, 0);
+        karatsuba_kernel(prod, block, shorter.data(), s, t, LEAF);
+        add_digits(out._value.data() + off, n + s - off, prod, std::min(2 * s, n + s - off));
+    }
+
+    return out.trim();
+}
+
+// Toom-Cook multiplication
+integer integer::toom_cook_3(const integer & lhs, const integer & rhs) const {
+    const integer::REP_SIZE_T k = (std::max(lhs._value.size(), rhs._value.size()) + 2) / 3;
+
+    // Splitting: x = x2 * B^2 + x1 * B + x0 with B = 2^(k * BITS)
+    auto piece = [k](const integer & x, const integer::REP_SIZE_T i){
+        integer out;
+        const integer::REP_SIZE_T first = std::min(i * k, x._value.size());
+        const integer::REP_SIZE_T last  = std::min(first + k, x._value.size());
+        out._value.assign(last - first, 0);
+        std::copy(x._value.begin() + first, x._value.begin() + last, out._value.begin());
+        return out.trim();
+    };
+
+    const integer m0 = piece(lhs, 0), m1 = piece(lhs, 1), m2 = piece(lhs, 2);
+    const integer n0 = piece(rhs, 0), n1 = piece(rhs, 1), n2 = piece(rhs, 2);
+
+    // exact halving of the magnitude, top digit down
+    auto halve = [](integer x){
+        INTEGER_DIGIT_T carry = 0;
+        for(integer::REP_SIZE_T i = x._value.size(); i > 0; i--){
+            const INTEGER_DIGIT_T d = x._value[i - 1];
+            x._value[i - 1] = (d >> 1) | carry;
+            carry = d << (integer::BITS - 1);
+        }
+        return x.trim();
+    };
+
+    // Evaluation at 0, 1, -1, -2 and infinity
+    integer t = m0 + m2;
+    const integer p1 = t + m1, pm1 = t - m1;
+    t = pm1 + m2;
+    const integer pm2 = t + t - m0;
+    t = n0 + n2;
+    const integer q1 = t + n1, qm1 = t - n1;
+    t = qm1 + n2;
+    const integer qm2 = t + t - n0;
+
+    // Pointwise Multiplication
+    const integer r0   = m0 * n0;
+    const integer r1   = p1 * q1;
+    const integer rm1  = pm1 * qm1;
+    const integer rm2  = pm2 * qm2;
+    const integer rinf = m2 * n2;
+
+    // Interpolation (Bodrato)
+    integer c3 = rm2 - r1;
     {
-        std::size_t msz = n;
-        while (bitr_j >= msz)
-        {
-            bitr_j -= msz;
-            msz >>= 1;
+        // exact division by 3, top digit down
+        INTEGER_DOUBLE_DIGIT_T rem = 0;
+        for(integer::REP_SIZE_T i = c3._value.size(); i > 0; i--){
+            const INTEGER_DOUBLE_DIGIT_T cur = (rem << integer::BITS) | c3._value[i - 1];
+            c3._value[i - 1] = static_cast <INTEGER_DIGIT_T> (cur / 3);
+            rem = cur % 3;
         }
-        bitr_j += msz;
+        c3.trim();
+    }
+    integer c1 = halve(r1 - rm1);
+    integer c2 = rm1 - r0;
+    c3 = halve(c2 - c3) + rinf + rinf;
+    c2 = c2 + c1 - rinf;
+    c1 = c1 - c3;
+
+    // Recomposition: the coefficients of a product of non-negative pieces are non-negative
+    const integer * coef[5] = {&r0, &c1, &c2, &c3, &rinf};
+    integer::REP_SIZE_T len = 0;
+    for(integer::REP_SIZE_T i = 0; i < 5; i++){
+        len = std::max(len, i * k + coef[i]->_value.size());
+    }
+    integer out;
+    out._value.assign(len + 1, 0);
+    for(integer::REP_SIZE_T i = 0; i < 5; i++){
+        add_digits(out._value.data() + i * k, len + 1 - i * k, coef[i]->_value.data(), coef[i]->_value.size());
+    }
+    return out.trim();
+}
+
+// Comba multiplication
+integer integer::comba_mult(const integer & lhs, const integer & rhs) const {
+    const integer::REP_SIZE_T n = lhs._value.size();
+    const integer::REP_SIZE_T m = rhs._value.size();
 
-        if (bitr_j > i)
-        {
-            double swap = data[bitr_j-1];
-            data[bitr_j-1] = data[i-1];
-            data[i-1] = swap;
-            swap = data[bitr_j];
-            data[bitr_j] = data[i];
-            data[i] = swap;
+    integer out;
+    out._value.assign(n + m, 0);
+
+    // column accumulator: acc holds the low two digits, t2 counts its wraparounds
+    INTEGER_DOUBLE_DIGIT_T acc = 0;
+    INTEGER_DIGIT_T        t2  = 0;
+    for(integer::REP_SIZE_T k = 0; k + 1 < n + m; k++){
+        const integer::REP_SIZE_T first = (k < m)?0:(k - m + 1);
+        const integer::REP_SIZE_T last  = (k < n)?k:(n - 1);
+        for(integer::REP_SIZE_T i = first; i <= last; i++){
+            const INTEGER_DOUBLE_DIGIT_T prod = static_cast <INTEGER_DOUBLE_DIGIT_T> (lhs._value[i]) * rhs._value[k - i];
+            acc += prod;
+            t2 += (acc < prod);
         }
+        out._value[k] = static_cast <INTEGER_DIGIT_T> (acc);
+        acc = (acc >> integer::BITS) + (static_cast <INTEGER_DOUBLE_DIGIT_T> (t2) << integer::BITS);
+        t2 = 0;
     }
+    out._value[n + m - 1] = static_cast <INTEGER_DIGIT_T> (acc);
+    return out.trim();
+}
 
-    //Perform "butterfly" calculations
-    std::size_t lmax = 2;
-    while (lmax <= n)
-    {
-        double wr = 1;
-        double wi = 0;
-
-        double theta = (2*M_PI)/double(lmax*(dir?1.0:-1.0));
-        double wpr = cos(theta);
-        double wpi = sin(theta);
-
-        int pstep = 2*lmax;
-        for (std::size_t l = 1; l < lmax; l += 2)
-        {
-            for (std::size_t p = l; p < 2*n; p += pstep)
-            {
-                std::size_t q = p + lmax;
-                double tempr = wr*data[q-1] - wi*data[q];
-                double tempi = wr*data[q] + wi*data[q-1];
-                data[q-1] = data[p-1] - tempr;
-                data[q] = data[p] - tempi;
-                data[p-1] = data[p-1] + tempr;
-                data[p] = data[p] + tempi;
-            }
+// Comba squaring
+integer integer::comba_sqr() const {
+    const integer::REP_SIZE_T n = _value.size();
 
-            //Find the next power of W
-            double wtemp = wr;
-            wr = wr*wpr - wi*wpi;
-            wi = wi*wpr + wtemp*wpi;
+    integer out;
+    out._value.assign(2 * n, 0);
+
+    // acc carries the previous columns; each column's cross sum gets its own
+    // accumulator so that it can be doubled before the carry is added
+    INTEGER_DOUBLE_DIGIT_T acc = 0;
+    for(integer::REP_SIZE_T k = 0; k + 1 < 2 * n; k++){
+        const integer::REP_SIZE_T first = (k < n)?0:(k - n + 1);
+        INTEGER_DOUBLE_DIGIT_T cross = 0;
+        INTEGER_DIGIT_T        c2    = 0;
+        for(integer::REP_SIZE_T i = first; 2 * i < k; i++){
+            const INTEGER_DOUBLE_DIGIT_T prod = static_cast <INTEGER_DOUBLE_DIGIT_T> (_value[i]) * _value[k - i];
+            cross += prod;
+            c2 += (cross < prod);
+        }
+        c2 = (c2 << 1) | static_cast <INTEGER_DIGIT_T> (cross >> (2 * integer::BITS - 1));
+        cross <<= 1;
+        if (!(k & 1)){
+            const INTEGER_DOUBLE_DIGIT_T sq = static_cast <INTEGER_DOUBLE_DIGIT_T> (_value[k / 2]) * _value[k / 2];
+            cross += sq;
+            c2 += (cross < sq);
         }
+        cross += acc;
+        c2 += (cross < acc);
+        out._value[k] = static_cast <INTEGER_DIGIT_T> (cross);
+        acc = (cross >> integer::BITS) + (static_cast <INTEGER_DOUBLE_DIGIT_T> (c2) << integer::BITS);
+    }
+    out._value[2 * n - 1] = static_cast <INTEGER_DIGIT_T> (acc);
+    return out.trim();
+}
 
-        lmax = pstep;
+// Number-theoretic transform helpers for ntt_mult and NttMultiplier
+struct ntt_prime {
+    limb_t p;       // modulus
+    limb_t g;       // primitive root
+    limb_t pinv;    // -p^-1 mod 2^64
+    limb_t r2;      // 2^128 mod p
+};
+
+static ntt_prime make_ntt_prime(const limb_t p, const limb_t g){
+    limb_t inv = 1;                         // Newton's iteration doubles the correct low bits
+    for(int i = 0; i < 6; i++){
+        inv *= 2 - p * inv;
+    }
+    limb_t r = 1;
+    for(int i = 0; i < 128; i++){
+        r <<= 1;
+        if (r >= p){
+            r -= p;
+        }
     }
+    return {p, g, 0 - inv, r};
+}
 
-    //All is good
-    return 0;
+// a - b mod p for a < 2p and b <= p: with p < 2^63 the top bit of the
+// difference is the borrow, so the correction needs no branch
+static inline limb_t ntt_sub(const ntt_prime & q, const limb_t a, const limb_t b){
+    const limb_t d = a - b;
+    return d + (q.p & (0 - (d >> 63)));
 }
 
-// FFT-based multiplication
-//Based on the convolution theorem which states that the Fourier
-//transform of a convolution is the pointwise product of their
-//Fourier transforms.
-integer integer::fft_mult(const integer& lhs, const integer& rhs) const {
-    //Convert each integer to input wanted by fft()
-    size_t size = 1;
-    while (size < lhs._value.size()*2){
-        size <<= 1;
+static inline limb_t ntt_add(const ntt_prime & q, const limb_t a, const limb_t b){
+    return ntt_sub(q, a + b, q.p);
+}
+
+// Montgomery product a * b / 2^64 mod p for any 64-bit a and b < p
+static inline limb_t ntt_mul(const ntt_prime & q, const limb_t a, const limb_t b){
+    limb_t hi, mhi, carry = 0;
+    const limb_t lo  = limb_mul(a, b, hi);
+    const limb_t mlo = limb_mul(lo * q.pinv, q.p, mhi);
+    limb_addc(lo, mlo, carry);              // the low half cancels to 0
+    return ntt_sub(q, hi + mhi + carry, q.p); // < 2p, so no overflow with p < 2^63
+}
+
+// plain a * b mod p
+static inline limb_t ntt_mulmod(const ntt_prime & q, const limb_t a, const limb_t b){
+    return ntt_mul(q, ntt_mul(q, a, b), q.r2);
+}
+
+static limb_t ntt_powmod(const ntt_prime & q, limb_t base, limb_t exp){
+    limb_t out = 1;
+    for(; exp; exp >>= 1){
+        if (exp & 1){
+            out = ntt_mulmod(q, out, base);
+        }
+        base = ntt_mulmod(q, base, base);
     }
-    while (size < rhs._value.size()*2){
-        size <<= 1;
+    return out;
+}
+
+// the n-th root of unity mod p, or its inverse, in Montgomery form
+static limb_t ntt_root(const ntt_prime & q, const std::size_t n, const bool inverse){
+    const limb_t e = (q.p - 1) / n;
+    return ntt_mul(q, ntt_powmod(q, q.g, inverse?(q.p - 1 - e):e), q.r2);
+}
+
+// the first n / 2 powers of ntt_root(q, n, inverse), in Montgomery form
+static std::vector <limb_t> ntt_roots(const ntt_prime & q, const std::size_t n, const bool inverse){
+    const limb_t root = ntt_root(q, n, inverse);
+    std::vector <limb_t> w(std::max <std::size_t> (n >> 1, 1));
+    w[0] = ntt_mul(q, 1, q.r2);
+    for(std::size_t i = 1; i < w.size(); i++){
+        w[i] = ntt_mul(q, w[i - 1], root);
     }
+    return w;
+}
+
+// Everything a transform of n points needs besides the points: the roots of
+// ntt_roots and the bit-reversal permutation (n is far below 2^32)
+struct ntt_plan {
+    std::vector <limb_t>   w;
+    std::vector <uint32_t> rev;         // i with its log2(n) bits reversed
+};
 
-    std::deque<double> lhs_fft;
-    lhs_fft.resize(size*2, 0);
-    for (size_t i = 0; i < lhs._value.size(); i++){
-        lhs_fft[i*2] = double(lhs._value[lhs._value.size()-1-i]);
+// plans of up to this many points are kept once built, larger ones built per call
+static const std::size_t NTT_PLAN_CACHE_POINTS = std::size_t(1) << 22;
+
+static std::shared_ptr <const ntt_plan> make_ntt_plan(const ntt_prime & q, const std::size_t n, const bool inverse){
+    auto plan = std::make_shared <ntt_plan> ();
+    plan->w = ntt_roots(q, n, inverse);
+    plan->rev.assign(n, 0);
+    std::size_t bits = 0;
+    while ((std::size_t(1) << bits) < n){
+        bits++;
+    }
+    for(std::size_t i = 1; i < n; i++){
+        plan->rev[i] = static_cast <uint32_t> ((plan->rev[i >> 1] >> 1) | ((i & 1) << (bits - 1)));
     }
+    return plan;
+}
 
-    std::deque<double> rhs_fft;
-    rhs_fft.resize(size*2, 0);
-    for (size_t i = 0; i < rhs._value.size(); i++){
-        rhs_fft[i*2] = double(rhs._value[rhs._value.size()-1-i]);
+// The plan for a transform of n points modulo q in one direction, built on
+// first use and then shared read-only by every thread, so repeated products
+// of one size compute their roots once
+static std::shared_ptr <const ntt_plan> ntt_get_plan(const ntt_prime & q, const std::size_t n, const bool inverse){
+    if (n > NTT_PLAN_CACHE_POINTS){
+        return make_ntt_plan(q, n, inverse);
+    }
+    static std::mutex lock;
+    static std::map <std::tuple <limb_t, std::size_t, bool>, std::shared_ptr <const ntt_plan> > plans;
+    const std::lock_guard <std::mutex> guard(lock);
+    std::shared_ptr <const ntt_plan> & plan = plans[std::make_tuple(q.p, n, inverse)];
+    if (!plan){
+        plan = make_ntt_plan(q, n, inverse);
     }
+    return plan;
+}
 
-    //Compute the FFT of each
-    fft(lhs_fft);
-    fft(rhs_fft);
+// in-place transform of a[0, n) with n a power of 2 on plan; values stay in
+// plain form because the roots are in Montgomery form
+static void ntt_transform(const ntt_prime & q, limb_t * a, const std::size_t n, const ntt_plan & plan){
+    const uint32_t * rev = plan.rev.data();
+    const limb_t * w = plan.w.data();
+    for(std::size_t i = 1; i < n; i++){
+        if (i < rev[i]){
+            std::swap(a[i], a[rev[i]]);
+        }
+    }
 
-    //Perform pointwise multiplication (numbers are complex)
-    std::deque<double> out_fft(2*size);
-    for (size_t i = 0; i < 2*size; i+=2){
-        out_fft[i] = lhs_fft[i]*rhs_fft[i] - lhs_fft[i+1]*rhs_fft[i+1];
-        out_fft[i+1] = lhs_fft[i]*rhs_fft[i+1] + lhs_fft[i+1]*rhs_fft[i];
+    for(std::size_t len = 2; len <= n; len <<= 1){
+        const std::size_t half = len >> 1, step = n / len;
+        for(std::size_t i = 0; i < n; i += len){
+            for(std::size_t j = 0; j < half; j++){
+                const limb_t u = a[i + j];
+                const limb_t v = ntt_mul(q, a[i + j + half], w[j * step]);
+                a[i + j]        = ntt_add(q, u, v);
+                a[i + j + half] = ntt_sub(q, u, v);
+            }
+        }
     }
+}
 
-    //Compute the inverse FFT of this number
-    //remember to properly scale afterwards!
-    fft(out_fft, false);
-    for (size_t i = 0; i < 2*size; i++){
-        out_fft[i] /= size;
+// body(begin, end) on pieces of [0, count), about four per thread of executor
+template <typename Body>
+static void ntt_parallel(Executor & executor, const std::size_t count, const Body & body){
+    const std::size_t pieces = std::min(count, 4 * std::max <std::size_t> (executor.concurrency(), 1));
+    executor.run(pieces, [&](const std::size_t i){
+        body(count * i / pieces, count * (i + 1) / pieces);
+    });
+}
+
+// columns the four-step transform moves at once: one cache line of each row
+static const std::size_t NTT_COLUMN_BLOCK = 8;
+// the four-step transform below this many points runs as one transform instead
+static const std::size_t NTT_FOUR_STEP_POINTS = 4096;
+
+// Four-step transform of a[0, n) seen as n1 rows of n2 = n / n1 points:
+// length-n1 transforms down the columns, a twiddle of w^(row * column), then
+// length-n2 transforms along the rows, each a few pieces of work for the
+// executor that fit in cache. The columns go through a buffer NTT_COLUMN_BLOCK
+// at a time, so every row is read a cache line at a time. The result is the
+// transform with its index transposed (k1 + n1 k2 at k1 n2 + k2), which a
+// convolution never sees: the inverse takes that order and runs the steps
+// backwards, rows, twiddle, columns, back to natural order.
+static void ntt_four_step(const ntt_prime & q, limb_t * a, const std::size_t n, const bool inverse, Executor & executor){
+    std::size_t n1 = 1;
+    while (n1 * n1 < n){
+        n1 <<= 1;
+    }
+    const std::size_t n2 = n / n1;
+    const std::shared_ptr <const ntt_plan> p1 = ntt_get_plan(q, n1, inverse), p2 = ntt_get_plan(q, n2, inverse);
+    const limb_t root = ntt_root(q, n, inverse);
+    const limb_t one = ntt_mul(q, 1, q.r2);
+
+    const auto columns = [&](const std::size_t begin, const std::size_t end){
+        std::vector <limb_t> buffer(NTT_COLUMN_BLOCK * n1);
+        for(std::size_t b = begin; b < end; b++){
+            const std::size_t c0 = b * NTT_COLUMN_BLOCK;
+            for(std::size_t r = 0; r < n1; r++){
+                for(std::size_t c = 0; c < NTT_COLUMN_BLOCK; c++){
+                    buffer[c * n1 + r] = a[r * n2 + c0 + c];
+                }
+            }
+            for(std::size_t c = 0; c < NTT_COLUMN_BLOCK; c++){
+                limb_t * column = buffer.data() + c * n1;
+                // root^(column * row), row by row
+                const limb_t step = ntt_mul(q, ntt_powmod(q, ntt_mul(q, root, 1), c0 + c), q.r2);
+                if (!inverse){
+                    ntt_transform(q, column, n1, *p1);
+                }
+                limb_t t = one;
+                for(std::size_t r = 0; r < n1; r++){
+                    column[r] = ntt_mul(q, column[r], t);
+                    t = ntt_mul(q, t, step);
+                }
+                if (inverse){
+                    ntt_transform(q, column, n1, *p1);
+                }
+            }
+            for(std::size_t r = 0; r < n1; r++){
+                for(std::size_t c = 0; c < NTT_COLUMN_BLOCK; c++){
+                    a[r * n2 + c0 + c] = buffer[c * n1 + r];
+                }
+            }
+        }
+    };
+    const auto rows = [&](const std::size_t begin, const std::size_t end){
+        for(std::size_t r = begin; r < end; r++){
+            ntt_transform(q, a + r * n2, n2, *p2);
+        }
+    };
+
+    if (!inverse){
+        ntt_parallel(executor, n2 / NTT_COLUMN_BLOCK, columns);
+        ntt_parallel(executor, n1, rows);
     }
+    else{
+        ntt_parallel(executor, n1, rows);
+        ntt_parallel(executor, n2 / NTT_COLUMN_BLOCK, columns);
+    }
+}
 
-    //Convert back to integer, carrying along the way
-    double carry = 0;
-    integer out;
-    for (size_t i = 0; i < 2*size; i+=2){
-        double current = out_fft[i]+carry;
-        if (current > double(integer::NEG1)){
-            carry = current / (double(integer::NEG1)+1);
-            carry = double(floor(carry+0.0001));
-            current = current - (carry*(integer::NEG1+1));
+// in-place transform of a[0, n): four-step on executor where there is one and
+// n is large enough, else one radix-2 transform
+static void ntt(const ntt_prime & q, limb_t * a, const std::size_t n, const bool inverse, Executor * executor){
+    if (executor && (n >= NTT_FOUR_STEP_POINTS)){
+        ntt_four_step(q, a, n, inverse, *executor);
+        return;
+    }
+    ntt_transform(q, a, n, *ntt_get_plan(q, n, inverse));
+}
 
+// f(i) for every i in [0, n), on executor if there is one
+template <typename F>
+static void ntt_for_each(Executor * executor, const std::size_t n, const F & f){
+    const auto body = [&](const std::size_t begin, const std::size_t end){
+        for(std::size_t i = begin; i < end; i++){
+            f(i);
         }
-        else {
-            carry = 0;
+    };
+    if (executor){
+        ntt_parallel(*executor, n, body);
+    }
+    else{
+        body(0, n);
+    }
+}
+
+// forward transform of digits[0, size) zero padded to n points into out
+// (digits enter in Montgomery form, which also reduces them below p)
+static void ntt_forward(const ntt_prime & q, const INTEGER_DIGIT_T * digits, const std::size_t size,
+                        limb_t * out, const std::size_t n, Executor * executor){
+    std::fill(out + size, out + n, 0);
+    ntt_for_each(executor, size, [&](const std::size_t i){ out[i] = ntt_mul(q, digits[i], q.r2); });
+    ntt(q, out, n, false, executor);
+}
+
+// out = inverse transform of out * rhs point by point, the cyclic convolution
+// of the two operands forward transformed into them; rhs may be out
+static void ntt_product(const ntt_prime & q, limb_t * out, const limb_t * rhs, const std::size_t n, Executor * executor){
+    ntt_for_each(executor, n, [&](const std::size_t i){ out[i] = ntt_mul(q, out[i], rhs[i]); });
+    ntt(q, out, n, true, executor);
+
+    // leave Montgomery form and undo the factor n of the inverse transform
+    const limb_t scale = q.p - (q.p - 1) / n;
+    ntt_for_each(executor, n, [&](const std::size_t i){ out[i] = ntt_mul(q, out[i], scale); });
+}
+
+// The three primes and Garner's constants. Each prime is c * 2^k + 1 just
+// below 2^63, so the transforms can be up to 2^55 long and the product of the
+// three (~2^184) bounds every convolution sum of two digit sequences, which
+// makes the CRT result exact.
+struct ntt_crt {
+    ntt_prime q[3];
+    // in Montgomery form so ntt_mul applies them to unreduced values
+    limb_t g2;                          // p1^-1 mod p2
+    limb_t g3;                          // (p1 p2)^-1 mod p3
+    limb_t g31;                         // p1 (p1 p2)^-1 mod p3
+    limb_t p1p2_lo, p1p2_hi;
+};
+
+static const ntt_crt & ntt_crt_constants(){
+    static const ntt_crt crt = []{
+        ntt_crt c;
+        c.q[0] = make_ntt_prime(4179340454199820289ULL, 3);     // 29 * 2^57 + 1
+        c.q[1] = make_ntt_prime(2485986994308513793ULL, 5);     // 69 * 2^55 + 1
+        c.q[2] = make_ntt_prime(1945555039024054273ULL, 5);     // 27 * 2^56 + 1
+        const ntt_prime & q1 = c.q[0], & q2 = c.q[1], & q3 = c.q[2];
+        const limb_t inv_p1_mod_p2   = ntt_powmod(q2, q1.p % q2.p, q2.p - 2);
+        const limb_t inv_p1p2_mod_p3 = ntt_powmod(q3, ntt_mulmod(q3, q1.p % q3.p, q2.p % q3.p), q3.p - 2);
+        c.g2  = ntt_mul(q2, inv_p1_mod_p2, q2.r2);
+        c.g3  = ntt_mul(q3, inv_p1p2_mod_p3, q3.r2);
+        c.g31 = ntt_mul(q3, ntt_mulmod(q3, q1.p % q3.p, inv_p1p2_mod_p3), q3.r2);
+        c.p1p2_lo = limb_mul(q1.p, q2.p, c.p1p2_hi);
+        return c;
+    }();
+    return crt;
+}
+
+// the smallest power of 2 of at least digits - 1 points, the length of a
+// cyclic convolution with no wraparound for a product of digits digits
+static std::size_t ntt_points(const std::size_t digits){
+    std::size_t n = 1;
+    while (n < digits - 1){
+        n <<= 1;
+    }
+    return n;
+}
+
+// Garner's CRT on the convolutions c[0, n), c[n, 2n) and c[2n, 3n) modulo the
+// three primes, carried into the digits of out[0, digits)
+static void ntt_garner(const limb_t * c, const std::size_t n, INTEGER_DIGIT_T * out, const std::size_t digits){
+    const ntt_crt & crt = ntt_crt_constants();
+    const ntt_prime & q1 = crt.q[0], & q2 = crt.q[1], & q3 = crt.q[2];
+    limb_t acc[3] = {0, 0, 0};
+    for(std::size_t i = 0; i < digits; i++){
+        if (i + 1 < digits){
+            // Garner: x = x1 + x2 * p1 + x3 * p1 * p2
+            const limb_t x1 = c[i];
+            const limb_t x2 = ntt_sub(q2, ntt_mul(q2, c[n + i], crt.g2), ntt_mul(q2, x1, crt.g2));
+            const limb_t x3 = ntt_sub(q3, ntt_sub(q3, ntt_mul(q3, c[2 * n + i], crt.g3), ntt_mul(q3, x1, crt.g3)), ntt_mul(q3, x2, crt.g31));
+
+            limb_t v[3], k = 0;
+            v[0] = limb_mul(x2, q1.p, v[1]);
+            v[0] = limb_addc(v[0], x1, k);
+            v[1] += k;
+            k = 0;
+            const limb_t t0 = limb_mul(x3, crt.p1p2_lo, k);
+            const limb_t t1 = limb_mac(x3, crt.p1p2_hi, 0, k);
+            v[2] = k;
+
+            k = 0;
+            acc[0] = limb_addc(acc[0], v[0], k);
+            acc[1] = limb_addc(acc[1], v[1], k);
+            acc[2] = limb_addc(acc[2], v[2], k);
+            k = 0;
+            acc[0] = limb_addc(acc[0], t0, k);
+            acc[1] = limb_addc(acc[1], t1, k);
+            acc[2] += k;
+        }
+
+        out[i] = static_cast <INTEGER_DIGIT_T> (acc[0]);
+        if constexpr (DIGIT_BITS == 64){
+            acc[0] = acc[1];
+            acc[1] = acc[2];
+            acc[2] = 0;
+        }
+        else{
+            acc[0] = (acc[0] >> DIGIT_BITS) | (acc[1] << (64 - DIGIT_BITS));
+            acc[1] = (acc[1] >> DIGIT_BITS) | (acc[2] << (64 - DIGIT_BITS));
+            acc[2] >>= DIGIT_BITS;
         }
-        out._value.push_front(INTEGER_DIGIT_T(current+0.0001));
     }
+}
 
-    //Finish up
-    return out;
+// The calling thread's buffer for the convolutions of one product, kept for
+// the next product unless it holds more than a cached plan's worth of points
+static std::vector <limb_t> & ntt_scratch(){
+    static thread_local std::vector <limb_t> scratch;
+    return scratch;
+}
+
+static void ntt_release_scratch(std::vector <limb_t> & scratch){
+    if (scratch.size() > 4 * NTT_PLAN_CACHE_POINTS){
+        std::vector <limb_t> ().swap(scratch);
+    }
+}
+
+// NTT-based multiplication
+// Convolves whole digits modulo three primes and recombines every
+// coefficient with Garner's CRT, so the product is exact at any size.
+integer integer::ntt_mult(const integer & lhs, const integer & rhs, Executor * executor) const {
+    ECC_COUNT(integer_ntt_mul);
+    static_assert(DIGIT_BITS <= 64, "ntt_mult convolves digits of at most 64 bits");
+
+    const ntt_crt & crt = ntt_crt_constants();
+    const std::size_t digits = lhs._value.size() + rhs._value.size();
+    const std::size_t n = ntt_points(digits);
+
+    // three convolutions, then one scratch transform of rhs
+    const bool square = (lhs._value == rhs._value);
+    std::vector <limb_t> & c = ntt_scratch();
+    c.resize(std::max(c.size(), 4 * n));
+    limb_t * fb = c.data() + 3 * n;
+    for(std::size_t k = 0; k < 3; k++){
+        limb_t * out = c.data() + k * n;
+        ntt_forward(crt.q[k], lhs._value.data(), lhs._value.size(), out, n, executor);
+        if (!square){
+            ntt_forward(crt.q[k], rhs._value.data(), rhs._value.size(), fb, n, executor);
+        }
+        ntt_product(crt.q[k], out, square?out:fb, n, executor);
+    }
+
+    integer out;
+    out._value.assign(digits, 0);
+    ntt_garner(c.data(), n, out._value.data(), digits);
+    ntt_release_scratch(c);
+    return out.trim();
+}
+
+NttMultiplier::NttMultiplier(const integer & value, const std::size_t other_digits) :
+        factor(value),
+        other(other_digits),
+        n(0),
+        executor(nullptr)
+{
+    const std::size_t digits = value.limb_count();
+    if (!digits || !other_digits || (digits * (sizeof(INTEGER_DIGIT_T) << 3) < integer::tuning().ntt_bits)){
+        return;
+    }
+    if (std::min(digits, other_digits) >= INTEGER_PARALLEL_NTT_BITS / (sizeof(INTEGER_DIGIT_T) << 3)){
+        this->executor = integer::executor();
+    }
+    const ntt_crt & crt = ntt_crt_constants();
+    this->n = ntt_points(digits + other_digits);
+    this->transformed.resize(3 * this->n);
+    const integer::limb_span d = value.limbs();
+    for(std::size_t k = 0; k < 3; k++){
+        ntt_forward(crt.q[k], d.data(), d.size(), this->transformed.data() + k * this->n, this->n, this->executor);
+    }
+}
+
+integer NttMultiplier::operator()(const integer & x) const {
+    const std::size_t size = x.limb_count();
+    if (!this->n || (size > this->other)){
+        return this->factor * x;
+    }
+    if (!size){
+        return 0;
+    }
+    ECC_COUNT(integer_ntt_mul);
+
+    const ntt_crt & crt = ntt_crt_constants();
+    const std::size_t digits = this->factor.limb_count() + size;
+    std::vector <limb_t> & c = ntt_scratch();
+    c.resize(std::max(c.size(), 3 * this->n));
+    const integer::limb_span d = x.limbs();
+    for(std::size_t k = 0; k < 3; k++){
+        limb_t * out = c.data() + k * this->n;
+        ntt_forward(crt.q[k], d.data(), d.size(), out, this->n, this->executor);
+        ntt_product(crt.q[k], out, this->transformed.data() + k * this->n, this->n, this->executor);
+    }
+
+    integer::REP rep(digits, 0);
+    ntt_garner(c.data(), this->n, rep.data(), digits);
+    ntt_release_scratch(c);
+    return integer(rep, this->factor.sign() != x.sign());
+}
+
+integer::Tuning integer::current_tuning = {INTEGER_COMBA_BITS, INTEGER_KARATSUBA_BITS, INTEGER_TOOM3_BITS,
+                                           INTEGER_NTT_BITS, INTEGER_RADIX_DC_BITS};
+Executor * integer::current_executor = nullptr;
+
+void integer::set_executor(Executor * executor){
+    current_executor = executor;
+}
+
+void integer::set_tuning(const Tuning & tuning){
+    current_tuning = tuning;
+    // below 8 digits Toom-3's pointwise products are no shorter than its operands
+    current_tuning.toom3_bits = std::max(current_tuning.toom3_bits, 8 * integer::BITS);
+}
+
+// product of the absolute values
+integer integer::mult(const integer & lhs, const integer & rhs) const {
+    const integer::REP_SIZE_T COMBA_DIGITS     = current_tuning.comba_bits / integer::BITS;
+    const integer::REP_SIZE_T KARATSUBA_DIGITS = current_tuning.karatsuba_bits / integer::BITS;
+    const integer::REP_SIZE_T TOOM3_DIGITS     = current_tuning.toom3_bits / integer::BITS;
+    const integer::REP_SIZE_T NTT_DIGITS       = current_tuning.ntt_bits / integer::BITS;
+    const integer::REP_SIZE_T shorter = std::min(lhs._value.size(), rhs._value.size());
+    const integer::REP_SIZE_T longer  = std::max(lhs._value.size(), rhs._value.size());
+
+    // integer out = peasant(lhs, rhs);
+    // integer out = recursive_peasant(lhs, rhs);
+    // integer out = recursive_mult(lhs, rhs);
+    if (longer <= COMBA_DIGITS){
+        return comba_mult(lhs, rhs);
+    }
+    if (current_executor && (shorter >= INTEGER_PARALLEL_NTT_BITS / integer::BITS)){
+        return ntt_mult(lhs, rhs, current_executor);
+    }
+#ifdef ECC_HAVE_GMP
+    if (shorter >= INTEGER_GMP_BITS / integer::BITS){
+        return gmp_mult(lhs, rhs);
+    }
+#endif
+    if (shorter < KARATSUBA_DIGITS){
+        return long_mult(lhs, rhs);
+    }
+    if ((shorter < TOOM3_DIGITS) || (2 * shorter < longer)){
+        // Toom-3 splits by the longer operand, so keep lopsided products on Karatsuba's blocks
+        return (shorter < NTT_DIGITS)?karatsuba(lhs, rhs):ntt_mult(lhs, rhs);
+    }
+    if (shorter < NTT_DIGITS){
+        return toom_cook_3(lhs, rhs);
+    }
+    return ntt_mult(lhs, rhs);
+}
+
+#ifdef ECC_HAVE_GMP
+integer integer::gmp_mult(const integer & lhs, const integer & rhs) const {
+    // mpn_mul takes the longer operand first
+    const bool swap = lhs._value.size() < rhs._value.size();
+    const integer & a = swap?rhs:lhs;
+    const integer & b = swap?lhs:rhs;
+    integer out;
+    out._value.assign(a._value.size() + b._value.size(), 0);
+    mpn_mul(gmp_limbs(out._value.data()), gmp_limbs(a._value.data()), a._value.size(),
+            gmp_limbs(b._value.data()), b._value.size());
+    return out.trim();
+}
+
+integer integer::gmp_sqr() const {
+    integer out;
+    out._value.assign(2 * _value.size(), 0);
+    mpn_sqr(gmp_limbs(out._value.data()), gmp_limbs(_value.data()), _value.size());
+    return out.trim();
 }
+#endif
 
 integer integer::operator*(const integer & rhs) const {
+    ECC_COUNT(integer_mul);
+
     // quick checks
     if (!*this || !rhs){    // if multiplying by 0
         return 0;
@@ -979,21 +2097,58 @@ integer integer::operator*(const integer & rhs) const {
     if (rhs == 1){          // if multiplying by 1
         return *this;
     }
+    if ((_value.size() == 1) || (rhs._value.size() == 1)){ // one digit: a single pass of the other
+        const bool one = (rhs._value.size() == 1);
+        integer out = one?*this:rhs;
+        out._sign = _sign ^ rhs._sign;
+        return out.mul_word(one?rhs._value[0]:_value[0]);
+    }
 
-    // integer out = peasant(*this, rhs);
-    // integer out = recursive_peasant(*this, rhs);
-    // integer out = recursive_mult(*this, rhs);
-    // integer out = karatsuba(*this, rhs);
-    // integer out = toom_cook_3(*this, rhs);
-    // integer out = long_mult(*this, rhs);
-    integer out = fft_mult(*this, rhs);
+    integer out = mult(*this, rhs);
     out._sign = _sign ^ rhs._sign;
     out.trim();
     return out;
 }
 
+integer integer::square() const {
+    const integer::REP_SIZE_T COMBA_DIGITS     = current_tuning.comba_bits / integer::BITS;
+    const integer::REP_SIZE_T KARATSUBA_DIGITS = current_tuning.karatsuba_bits / integer::BITS;
+    const integer::REP_SIZE_T TOOM3_DIGITS     = current_tuning.toom3_bits / integer::BITS;
+    const std::size_t         LEAF             = std::max((std::size_t) 4, (std::size_t) KARATSUBA_DIGITS);
+    ECC_COUNT(integer_mul);
+
+    const integer::REP_SIZE_T n = _value.size();
+    if (n <= COMBA_DIGITS){
+        return comba_sqr();
+    }
+#ifdef ECC_HAVE_GMP
+    if (n >= INTEGER_GMP_BITS / integer::BITS){
+        return gmp_sqr();
+    }
+#endif
+    if (n >= TOOM3_DIGITS){
+        return mult(*this, *this);
+    }
+
+    integer out;
+    out._value.assign(2 * n, 0);
+    if (n < KARATSUBA_DIGITS){
+        sqr_basecase(out._value.data(), _value.data(), n);
+    }
+    else{
+        integer::REP scratch(karatsuba_scratch(n, LEAF));
+        karatsuba_sqr_kernel(out._value.data(), _value.data(), n, scratch.data(), LEAF);
+    }
+    return out.trim();
+}
+
 integer & integer::operator*=(const integer & rhs){
-    return *this = *this * rhs;
+    if (rhs._value.size() == 1){
+        _sign ^= rhs._sign;
+        return mul_word(rhs._value[0]);
+    }
+    // the product kernels read both operands while writing, so the product gets its own buffer
+    return *this = (this == &rhs)?square():(*this * rhs);
 }
 
 // // Naive Division: keep subtracting until lhs == 0
@@ -1053,11 +2208,11 @@ integer & integer::operator*=(const integer & rhs){
 // Non-Recursive version of above algorithm
 std::pair <integer, integer> integer::non_recursive_divmod(const integer & lhs, const integer & rhs) const {
     std::pair <integer, integer> qr (0, 0);
-    for(integer::REP_SIZE_T x = lhs.bits(); x > 0; x--){
+    for(std::size_t x = lhs.bit_length(); x > 0; x--){
         qr.first  <<= 1;
         qr.second <<= 1;
 
-        if (lhs[x - 1]){
+        if (lhs.test_bit(x - 1)){
             qr.second++;
         }
 
@@ -1069,6 +2224,231 @@ std::pair <integer, integer> integer::non_recursive_divmod(const integer & lhs,
     return qr;
 }
 
+// Knuth's Algorithm D (TAOCP vol. 2, 4.3.1): one quotient digit per step
+// from a double digit estimate that is at most 2 too large
+std::pair <integer, integer> integer::knuth_divmod(const integer & lhs, const integer & rhs) const {
+    static constexpr INTEGER_DOUBLE_DIGIT_T B = static_cast <INTEGER_DOUBLE_DIGIT_T> (1) << integer::BITS;
+    const integer::REP_SIZE_T n = rhs._value.size();
+    const integer::REP_SIZE_T m = lhs._value.size() - n;
+
+    std::pair <integer, integer> qr;
+    qr.first._value.assign(m + 1, 0);
+
+    // single digit divisor
+    if (n == 1){
+        const INTEGER_DIGIT_T rem = divide_by_word(qr.first._value.data(), lhs._value.data(), lhs._value.size(), word_divisor(rhs._value[0]));
+        qr.first.trim();
+        qr.second = integer(rem);
+        return qr;
+    }
+
+    // D1: normalize so the top digit of the divisor has its high bit set
+    std::size_t shift = 0;
+    for(INTEGER_DIGIT_T top = rhs._value[n - 1]; !(top & integer::HIGH_BIT); top <<= 1){
+        shift++;
+    }
+    integer::REP u(lhs._value.size() + 1, 0);
+    integer::REP v(n, 0);
+    for(integer::REP_SIZE_T i = 0; i < n; i++){
+        v[i] = static_cast <INTEGER_DIGIT_T> (rhs._value[i] << shift);
+        if (shift && i){
+            v[i] |= rhs._value[i - 1] >> (integer::BITS - shift);
+        }
+    }
+    for(integer::REP_SIZE_T i = 0; i < lhs._value.size(); i++){
+        u[i] = static_cast <INTEGER_DIGIT_T> (lhs._value[i] << shift);
+        if (shift && i){
+            u[i] |= lhs._value[i - 1] >> (integer::BITS - shift);
+        }
+    }
+    if (shift){
+        u[lhs._value.size()] = lhs._value.back() >> (integer::BITS - shift);
+    }
+
+    const INTEGER_DOUBLE_DIGIT_T v1 = v[n - 1], v2 = v[n - 2];
+    for(integer::REP_SIZE_T j = m + 1; j > 0; j--){
+        const integer::REP_SIZE_T k = j - 1;
+
+        // D3: estimate the quotient digit from the top two digits
+        const INTEGER_DOUBLE_DIGIT_T num = (static_cast <INTEGER_DOUBLE_DIGIT_T> (u[k + n]) << integer::BITS) | u[k + n - 1];
+        INTEGER_DOUBLE_DIGIT_T qhat = num / v1;
+        INTEGER_DOUBLE_DIGIT_T rhat = num % v1;
+        while ((qhat >= B) || (qhat * v2 > ((rhat << integer::BITS) | u[k + n - 2]))){
+            qhat--;
+            rhat += v1;
+            if (rhat >= B){
+                break;
+            }
+        }
+
+        // D4: multiply and subtract
+        INTEGER_DOUBLE_DIGIT_T carry = 0, borrow = 0;
+        for(integer::REP_SIZE_T i = 0; i < n; i++){
+            const INTEGER_DOUBLE_DIGIT_T prod = qhat * v[i] + carry;
+            carry = prod >> integer::BITS;
+            const INTEGER_DOUBLE_DIGIT_T diff = static_cast <INTEGER_DOUBLE_DIGIT_T> (u[k + i]) - static_cast <INTEGER_DIGIT_T> (prod) - borrow;
+            u[k + i] = static_cast <INTEGER_DIGIT_T> (diff);
+            borrow = (diff >> integer::BITS) & 1;
+        }
+        const INTEGER_DOUBLE_DIGIT_T diff = static_cast <INTEGER_DOUBLE_DIGIT_T> (u[k + n]) - carry - borrow;
+        u[k + n] = static_cast <INTEGER_DIGIT_T> (diff);
+
+        // D6: the estimate was one too large, add the divisor back
+        if ((diff >> integer::BITS) & 1){
+            qhat--;
+            carry = 0;
+            for(integer::REP_SIZE_T i = 0; i < n; i++){
+                const INTEGER_DOUBLE_DIGIT_T sum = static_cast <INTEGER_DOUBLE_DIGIT_T> (u[k + i]) + v[i] + carry;
+                u[k + i] = static_cast <INTEGER_DIGIT_T> (sum);
+                carry = sum >> integer::BITS;
+            }
+            u[k + n] = static_cast <INTEGER_DIGIT_T> (u[k + n] + carry);
+        }
+        qr.first._value[k] = static_cast <INTEGER_DIGIT_T> (qhat);
+    }
+    qr.first.trim();
+
+    // D8: unnormalize the remainder
+    qr.second._value.assign(n, 0);
+    for(integer::REP_SIZE_T i = 0; i < n; i++){
+        qr.second._value[i] = u[i] >> shift;
+        if (shift){
+            qr.second._value[i] |= static_cast <INTEGER_DIGIT_T> (u[i + 1] << (integer::BITS - shift));
+        }
+    }
+    qr.second.trim();
+    return qr;
+}
+
+integer integer::digit_slice(const integer::REP_SIZE_T from, const integer::REP_SIZE_T count) const {
+    integer out;
+    if (from < _value.size()){
+        const integer::REP_SIZE_T n = std::min(count, _value.size() - from);
+        out._value.assign(n, 0);
+        std::copy(_value.data() + from, _value.data() + from + n, out._value.data());
+    }
+    return out.trim();
+}
+
+std::pair <integer, integer> integer::bz_3n2n(const integer & a12, const integer & a3, const integer & b,
+                                              const integer & b1, const integer & b2, const std::size_t n) const {
+    std::pair <integer, integer> qr;
+    if ((a12 >> n) == b1){
+        // the quotient digit would be 2^n; 2^n - 1 is at most 2 too small
+        qr.first = (integer(1) << n) - 1;
+        qr.second = a12 - (b1 << n) + b1;
+    }
+    else{
+        qr = bz_2n1n(a12, b1, n);
+    }
+    qr.second = (qr.second << n) + a3 - qr.first * b2;
+    while (qr.second._sign == integer::NEGATIVE){
+        qr.first.sub_word(1);
+        qr.second += b;
+    }
+    return qr;
+}
+
+std::pair <integer, integer> integer::bz_2n1n(const integer & a, const integer & b, const std::size_t n) const {
+    if ((n & 1) || (n < INTEGER_BZ_BITS)){
+        return dm(a, b);
+    }
+    const std::size_t half = n / 2;
+    const integer b1 = b >> half;
+    const integer b2 = b - (b1 << half);
+    const integer a_high = a >> half;
+    const integer a4 = a - (a_high << half);
+    const integer a1 = a_high >> half;
+    const integer a3 = a_high - (a1 << half);
+
+    // the top three quarters of a, then the remainder and the last quarter
+    std::pair <integer, integer> high = bz_3n2n(a1, a3, b, b1, b2, half);
+    std::pair <integer, integer> low = bz_3n2n(high.second, a4, b, b1, b2, half);
+    low.first += high.first << half;
+    return low;
+}
+
+integer integer::reciprocal(const integer & b, const std::size_t n) const {
+    const integer one = integer(1) << (2 * n);
+    // guard bits past the half, so a step leaves only a few units to correct
+    const std::size_t h = n / 2 + 16;
+    if ((b._value.size() < INTEGER_NEWTON_BITS / integer::BITS) || (h >= n)){
+        return dm(one, b).first;
+    }
+
+    // y = 2^2h / (b's top h bits) is within a few units of 2^(n + h) / b, so
+    // x0 = y 2^(n - h) has a relative error below 2^(3 - h), and the step
+    // x0 + x0 (2^2n - b x0) / 2^2n squares it. Only the top n + 2 bits of the
+    // error term matter, so both products are n by h bits
+    const integer y = reciprocal(b >> (n - h), h);
+    const integer e = (one - ((b * y) << (n - h))) >> (n - h);
+    return (y << (n - h)) + ((y * e) >> (2 * h));
+}
+
+std::pair <integer, integer> integer::block_divmod(const integer & lhs, const integer & rhs, const bool newton) const {
+    const std::size_t shift = integer::BITS - digit_bit_length(rhs._value.back());
+    const integer a = lhs << shift;
+    const integer b = rhs << shift;
+    const integer::REP_SIZE_T n = b._value.size();
+    const std::size_t bits = n * integer::BITS;
+    // the reciprocal is in (2^n, 2^(n + 1)]; without its top bit the products are n by n bits
+    const integer inverse = newton?(reciprocal(b, bits) - (integer(1) << bits)):integer();
+
+    // a block's quotient fits its n digits, as the remainder above it is below b
+    integer::REP_SIZE_T blocks = (a._value.size() + n - 1) / n;
+    std::pair <integer, integer> qr;
+    qr.second = a.digit_slice((blocks - 1) * n, n);
+    if (lt(qr.second, b)){
+        blocks--;
+    }
+    else{
+        qr.second = 0;
+    }
+    qr.first._value.assign(blocks * n, 0);
+    for(integer::REP_SIZE_T i = blocks; i-- > 0;){
+        const integer x = (qr.second << bits) + a.digit_slice(i * n, n);
+        std::pair <integer, integer> block;
+        if (newton){
+            // x's top half times the reciprocal, within a few units of the quotient
+            const integer high = x >> bits;
+            block.first = ((high * inverse) >> bits) + high;
+            block.second = x - block.first * b;
+            while (block.second._sign == integer::NEGATIVE){
+                block.first.sub_word(1);
+                block.second += b;
+            }
+            while (block.second >= b){
+                block.first.add_word(1);
+                block.second -= b;
+            }
+        }
+        else{
+            block = bz_2n1n(x, b, bits);
+        }
+        std::copy(block.first._value.data(), block.first._value.data() + block.first._value.size(),
+                  qr.first._value.data() + i * n);
+        qr.second = std::move(block.second);
+    }
+    qr.first.trim();
+    qr.second >>= shift;
+    return qr;
+}
+
+#ifdef ECC_HAVE_GMP
+std::pair <integer, integer> integer::gmp_divmod(const integer & lhs, const integer & rhs) const {
+    const integer::REP_SIZE_T n = rhs._value.size();
+    const integer::REP_SIZE_T m = lhs._value.size() - n;
+    std::pair <integer, integer> qr;
+    qr.first._value.assign(m + 1, 0);
+    qr.second._value.assign(n, 0);
+    mpn_tdiv_qr(gmp_limbs(qr.first._value.data()), gmp_limbs(qr.second._value.data()), 0,
+                gmp_limbs(lhs._value.data()), lhs._value.size(), gmp_limbs(rhs._value.data()), n);
+    qr.first.trim();
+    qr.second.trim();
+    return qr;
+}
+#endif
+
 // division and modulus ignoring signs
 std::pair <integer, integer> integer::dm(const integer & lhs, const integer & rhs) const {
     if (!rhs){              // divide by 0 error
@@ -1088,15 +2468,33 @@ std::pair <integer, integer> integer::dm(const integer & lhs, const integer & rh
         return {0, lhs};
     }
 
+    ECC_COUNT(integer_divmod);
     // return naive_divmod(lhs, rhs);
     // return long_divmod(lhs, rhs);
     // return recursive_divmod(lhs, rhs);
-    return non_recursive_divmod(lhs, rhs);
+    // return non_recursive_divmod(lhs, rhs);
+#ifdef ECC_HAVE_GMP
+    if (rhs._value.size() >= INTEGER_GMP_BITS / integer::BITS){
+        return gmp_divmod(lhs, rhs);
+    }
+#endif
+    // the blocks only pay once the quotient is long too
+    const integer::REP_SIZE_T n = rhs._value.size();
+    const integer::REP_SIZE_T m = lhs._value.size() - n;
+    if ((n >= INTEGER_NEWTON_BITS / integer::BITS) && (m >= 4 * n)){
+        return block_divmod(lhs, rhs, true);
+    }
+    if (std::min(n, m) >= INTEGER_BZ_BITS / integer::BITS){
+        return block_divmod(lhs, rhs, false);
+    }
+    return knuth_divmod(lhs, rhs);
 }
 
 // division and modulus with signs
 std::pair <integer, integer> integer::divmod(const integer & lhs, const integer & rhs) const {
-    std::pair <integer, integer> out = dm(abs(lhs), abs(rhs));
+    // dm works on magnitudes; positive operands are their own, so only negative ones are copied
+    std::pair <integer, integer> out = ((lhs._sign == integer::POSITIVE) && (rhs._sign == integer::POSITIVE))?
+                                       dm(lhs, rhs):dm(abs(lhs), abs(rhs));
     out.first._sign = lhs._sign ^ rhs._sign;
 
     if (lhs._sign == integer::NEGATIVE){
@@ -1123,12 +2521,19 @@ std::pair <integer, integer> integer::divmod(const integer & lhs, const integer
     return out;
 }
 
+Result <std::pair <integer, integer> > integer::try_divmod(const integer & lhs, const integer & rhs) noexcept {
+    if (!rhs){
+        return Status::division_by_zero;
+    }
+    return lhs.divmod(lhs, rhs);
+}
+
 integer integer::operator/(const integer & rhs) const {
     return divmod(*this, rhs).first;
 }
 
 integer & integer::operator/=(const integer & rhs){
-    return *this = *this / integer(rhs);
+    return *this = *this / rhs;
 }
 
 integer integer::operator%(const integer & rhs) const {
@@ -1136,6 +2541,16 @@ integer integer::operator%(const integer & rhs) const {
 }
 
 integer & integer::operator%=(const integer & rhs){
+    if (rhs._value.size() == 1){
+        const INTEGER_DIGIT_T r = mod_word(rhs._value[0]);
+        _value.resize(1);
+        _value[0] = r;
+        return trim();
+    }
+    // already below the modulus: the remainder is the value itself
+    if (!rhs._value.empty() && (compare_magnitude(*this, rhs) < 0)){
+        return *this;
+    }
     return *this = *this % rhs;
 }
 
@@ -1180,26 +2595,19 @@ integer::Sign integer::sign() const {
 
 // get minimum number of bits needed to hold this value
 integer integer::bits() const {
-    integer         out = integer(_value.empty()?0:(_value.size() - 1)) * integer::BITS;
-    INTEGER_DIGIT_T msb = _value.empty()?0:_value[0];
-    while (msb){
-        msb >>= 1;
-        out++;
-    }
+    return bit_length();
+}
 
-    return out;
+std::size_t integer::bit_length() const {
+    if (_value.empty()){
+        return 0;
+    }
+    return (_value.size() - 1) * integer::BITS + digit_bit_length(_value.back());
 }
 
 // get minimum number of bytes needed to hold this value
 integer::REP_SIZE_T integer::bytes() const {
-    integer::REP_SIZE_T out = (_value.empty()?0:(_value.size() - 1)) * integer::OCTETS;
-    INTEGER_DIGIT_T     msb = (_value.empty()?0:_value[0]);
-    while (msb){
-        msb >>= 8;
-        out++;
-    }
-
-    return out;
+    return (bit_length() + 7) >> 3;
 }
 
 // get number of digits
@@ -1212,6 +2620,26 @@ integer::REP integer::data() const {
     return _value;
 }
 
+integer::limb_span integer::limbs() const {
+    return limb_span{_value.data(), _value.size()};
+}
+
+std::size_t integer::limb_count() const {
+    return _value.size();
+}
+
+INTEGER_DIGIT_T integer::limb(const std::size_t i) const {
+    return (i < _value.size())?_value[i]:0;
+}
+
+std::size_t integer::heap_bytes() const {
+    return _value.is_inline()?0:_value.capacity() * sizeof(INTEGER_DIGIT_T);
+}
+
+uint64_t integer::hash(const uint64_t seed) const {
+    return hash_words(_value.data(), _value.size(), seed ^ static_cast <uint64_t> (_sign));
+}
+
 // Miscellaneous Functions
 integer & integer::negate(){
     _sign = !_sign;
@@ -1219,83 +2647,288 @@ integer & integer::negate(){
 }
 
 integer integer::twos_complement(const integer::REP_SIZE_T & b) const {
-    integer mask; mask.fill(b);
-    integer out = ((abs(*this) ^ mask) + 1) & mask;
+    // 2^b - |x| mod 2^b over whole digits, then the bits past b dropped
+    integer out(*this);
+    out._value.resize((b + integer::BITS - 1) / integer::BITS, 0);
+    negate_words(out._value.data(), out._value.size());
+    if (b % integer::BITS){
+        out._value.back() &= (static_cast <INTEGER_DIGIT_T> (1) << (b % integer::BITS)) - 1;
+    }
     out._sign = !_sign;
     return out.trim();
 }
 
 // fills an integer with 1s
 integer & integer::fill(const integer::REP_SIZE_T & b){
-    _value = integer::REP(b / integer::BITS, integer::NEG1);
+    _value.assign((b + integer::BITS - 1) / integer::BITS, integer::NEG1);
     if (b % integer::BITS){
-        _value.push_front((1 << (b % integer::BITS)) - 1);
+        _value.back() = (static_cast <INTEGER_DIGIT_T> (1) << (b % integer::BITS)) - 1;
     }
     return *this;
 }
 
 // get bit, where 0 is the lsb and bits() - 1 is the msb
 bool integer::operator[](const integer::REP_SIZE_T & b) const {
-    if (b >= bits()){ // if given index is larger than bits in this _value, return 0
+    return test_bit(b);
+}
+
+bool integer::test_bit(const std::size_t b) const {
+    if ((b / integer::BITS) >= _value.size()){ // if given index is larger than bits in this _value, return 0
         return 0;
     }
-    return (_value[_value.size() - (b / integer::BITS) - 1] >> (b % integer::BITS)) & 1;
+    return (_value[b / integer::BITS] >> (b % integer::BITS)) & 1;
 }
 
-// Output value as a string from base 2 to 16, or base 256
-std::string integer::str(const integer & base, const std::string::size_type & length) const {
-    std::string out = "";
-    if ((2 <= base) && (base <= 16)){
-        static const std::string digits = "0123456789abcdef";
-        integer rhs = abs(*this);       // use absolute value to make sure index stays small
-        if (*this == 0){
-            out = "0";
+// modular inverse
+integer integer::modinv(const integer & modulus) const {
+    Result <integer> out = try_modinv(modulus);
+    if (!out){
+        throw_status(out.status(), (out.status() == Status::bad_modulus)?"Error: modulus must be positive":"Error: value is not invertible");
+    }
+    return std::move(*out);
+}
+
+Result <integer> integer::try_modinv(const integer & modulus) const noexcept {
+    if (modulus < 1){
+        return Status::bad_modulus;
+    }
+
+    integer a = *this % modulus;
+    if (a < 0){
+        a += modulus;
+    }
+    if (modulus == 1){
+        return integer(0);
+    }
+
+    if (!modulus[0]){
+        // extended Euclid, keeping t1 * a == r1 (mod modulus)
+        integer r0 = modulus, r1 = a, t0 = 0, t1 = 1;
+        while (r1){
+            const std::pair <integer, integer> qr = dm(r0, r1);
+            const integer t = t0 - qr.first * t1;
+            r0 = r1;
+            r1 = qr.second;
+            t0 = t1;
+            t1 = t;
         }
-        else{
-            std::pair <integer, integer> qr;
-            do{
-                qr = dm(rhs, base);
-                out = digits[qr.second] + out;
-                rhs = qr.first;
-            } while (rhs);
+        if (r0 != 1){
+            return Status::not_invertible;
         }
+        return (t0 < 0)?(t0 + modulus):t0;
+    }
 
-        // pad with '0's
-        if (out.size() < length){
-            out = std::string(length - out.size(), '0') + out;
+    // binary extended Euclid, keeping x1 * a == u and x2 * a == v (mod modulus)
+    integer u = a, v = modulus, x1 = 1, x2 = 0;
+    while ((u != 1) && (v != 1)){
+        if (!u){
+            return Status::not_invertible;
+        }
+        while (!u[0]){
+            u >>= 1;
+            if (x1[0]){
+                x1 += modulus;
+            }
+            x1 >>= 1;
+        }
+        while (!v[0]){
+            v >>= 1;
+            if (x2[0]){
+                x2 += modulus;
+            }
+            x2 >>= 1;
+        }
+        if (u >= v){
+            u -= v;
+            x1 -= x2;
+            if (x1 < 0){
+                x1 += modulus;
+            }
+        }
+        else{
+            v -= u;
+            x2 -= x1;
+            if (x2 < 0){
+                x2 += modulus;
+            }
         }
     }
-    else if (base == 256){
-        if (_value.empty()){
-            out = std::string(1, 0);
+    return (u == 1)?x1:x2;
+}
+
+int integer::jacobi(const integer & a, const integer & n){
+    if ((n < 1) || !n[0]){
+        throw std::domain_error("Error: Jacobi symbol needs an odd positive modulus");
+    }
+
+    integer x = a % n;
+    if (x < 0){
+        x += n;
+    }
+    integer y = n;
+
+    // the steps of limb_jacobi on the full values, until y fits in a word
+    int t = 1;
+    while (y.bit_length() > 64){
+        if (!x){
+            return 0;                       // y > 1
+        }
+        std::size_t z = 0;
+        while (!x.limb(z / BITS)){
+            z += BITS;
+        }
+        z += limb_ctz(static_cast <limb_t> (x.limb(z / BITS)));
+        x >>= z;
+        const uint64_t low = static_cast <uint64_t> (y.limb(0));
+        if ((z & 1) && (((low >> 1) ^ (low >> 2)) & 1)){
+            t = -t;
+        }
+        if (x < y){
+            if (x.limb(0) & y.limb(0) & 2){
+                t = -t;
+            }
+            std::swap(x, y);
+        }
+        x -= y;
+    }
+    if (x.bit_length() > 64){
+        x %= y;
+    }
+    return limb_jacobi(static_cast <uint64_t> (x), static_cast <uint64_t> (y), t);
+}
+
+// x in base b with one division by chunk_base = b^chunk per chunk characters,
+// written back from end; exactly width characters if width is not 0, and the
+// top chunk stops at its last nonzero digit otherwise
+static char * radix_basecase(integer::REP x, const unsigned int b, const INTEGER_DIGIT_T chunk_base,
+                             const std::size_t chunk, const std::size_t width, char * end){
+    static const char digits[] = "0123456789abcdef";
+    char * p = end;
+    const word_divisor divisor(chunk_base);
+    while (!x.empty()){
+        INTEGER_DIGIT_T d = divide_by_word(x.data(), x.data(), x.size(), divisor);
+        while (!x.empty() && !x.back()){
+            x.pop_back();
+        }
+        if (!x.empty()){
+            for(std::size_t j = 0; j < chunk; j++){
+                *--p = digits[d % b];
+                d /= b;
+            }
         }
         else{
-            // for each digit
-            for(INTEGER_DIGIT_T const & d : _value){
-                // write out each character
-                for(std::size_t i = integer::OCTETS << 3; i > 0; i -= 8){
-                    out += std::string(1, (d >> (i - 8)) & 0xff);
-                }
+            for(; d; d /= b){
+                *--p = digits[d % b];
             }
+        }
+    }
 
-            // remove leading '\x00's
-            // this is possible because _value is being read
-            // one character at a time, not one byte at a time
-            if (out.size() > length){
-                std::size_t i = 0;
-                while ((i < out.size()) && !out[i]){
-                    i++;
-                }
+    // x < b^width, so the rest of width is leading zeros
+    if (width){
+        while (p > end - width){
+            *--p = '0';
+        }
+    }
+    else if (p == end){
+        *--p = '0';
+    }
+    return p;
+}
+
+char * integer::radix_split(const integer & x, const unsigned int b, const std::vector <integer> & powers,
+                            const INTEGER_DIGIT_T chunk_base, const std::size_t chunk, const std::size_t width, char * end) const {
+    const integer::REP_SIZE_T DC_DIGITS = current_tuning.radix_dc_bits / integer::BITS;
+    // the largest cached power that is not above x
+    std::size_t level = powers.size();
+    while (level > 0 && lt(x, powers[level - 1])){
+        level--;
+    }
+    if (x._value.size() < DC_DIGITS || level == 0){
+        return radix_basecase(x._value, b, chunk_base, chunk, width, end);
+    }
+    level--;
+
+    // x = q * powers[level] + r, and r takes exactly chunk * 2^level characters
+    const std::pair <integer, integer> qr = dm(x, powers[level]);
+    const std::size_t low = chunk << level;
+    radix_split(qr.second, b, powers, chunk_base, chunk, low, end);
+    return radix_split(qr.first, b, powers, chunk_base, chunk, width?(width - low):0, end - low);
+}
+
+std::size_t integer::radix_room(const unsigned int b) const {
+    // at most one character per floor(log2(b)) bits; base 16 encodes whole bytes
+    unsigned int k = 0;
+    while ((2u << k) <= b){
+        k++;
+    }
+    const std::size_t n = (b == 16)?(2 * static_cast <std::size_t> (bytes())):((bit_length() + k - 1) / k);
+    return std::max(n, static_cast <std::size_t> (1));
+}
 
-                out = out.substr(i, out.size() - i);
+char * integer::radix_chars(const unsigned int b, char * end) const {
+    static const char digits[] = "0123456789abcdef";
+    if (_value.empty()){
+        *--end = '0';
+        return end;
+    }
+    if (b == 16){
+        // the big endian bytes through the hex codec, less a leading '0'
+        const std::size_t n = bytes();
+        small_vector <uint8_t, 64> buf(n);
+        store_bytes <true> (_value, buf.data(), n);
+        hex_encode(buf.data(), n, end - 2 * n);
+        return end - 2 * n + ((buf[0] < 16)?1:0);
+    }
+    if (const unsigned int k = radix_bits(b)){
+        // k bits per character, read straight from the limbs
+        const std::size_t n = (bit_length() + k - 1) / k;
+        for(std::size_t i = 0; i < n; i++){
+            const std::size_t pos = i * k;
+            const integer::REP_SIZE_T d = pos / integer::BITS;
+            const std::size_t shift = pos % integer::BITS;
+            INTEGER_DIGIT_T v = _value[d] >> shift;
+            if ((shift + k > integer::BITS) && (d + 1 < _value.size())){
+                v |= static_cast <INTEGER_DIGIT_T> (_value[d + 1] << (integer::BITS - shift));
             }
+            *--end = digits[v & (b - 1)];
+        }
+        return end;
+    }
+
+    std::size_t chunk = 0;
+    const INTEGER_DIGIT_T chunk_base = radix_chunk(b, chunk);
+    const integer rhs = abs(*this);
+
+    // chunk_base^(2^i) while its square could still be needed
+    std::vector <integer> powers;
+    if (rhs._value.size() >= current_tuning.radix_dc_bits / integer::BITS){
+        powers.push_back(chunk_base);
+        while (2 * powers.back()._value.size() <= rhs._value.size() + 1){
+            powers.push_back(powers.back().square());
         }
+    }
+    return radix_split(rhs, b, powers, chunk_base, chunk, 0, end);
+}
 
-        // pad with '\x00's
+// Output value as a string from base 2 to 16, or base 256
+std::string integer::str(const integer & base, const std::string::size_type & length) const {
+    std::string out = "";
+    if ((2 <= base) && (base <= 16)){
+        const unsigned int b = static_cast <uint32_t> (base);
+        const std::size_t room = radix_room(b);
+        out.resize(room);
+        out.erase(0, radix_chars(b, &out[0] + room) - &out[0]);
+
+        // pad with '0's
         if (out.size() < length){
-            out = std::string(length - out.size(), '\x00') + out;
+            out.insert(0, length - out.size(), '0');
         }
     }
+    else if (base == 256){
+        // at least one byte, so 0 is "\x00"
+        out.resize(std::max(std::max(static_cast <std::string::size_type> (bytes()), length), static_cast <std::string::size_type> (1)));
+        store_bytes <true> (_value, reinterpret_cast <uint8_t *> (&out[0]), out.size());
+    }
     else{
         throw std::runtime_error("Error: Cannot convert to base " + base.str(10));
     }
@@ -1303,12 +2936,73 @@ std::string integer::str(const integer & base, const std::string::size_type & le
     // if value is negative, add a minus sign in front
     // no special case for leading zeros/nulls
     if (_sign == integer::NEGATIVE){
-        out = "-" + out;
+        out.insert(0, 1, '-');
     }
 
     return out;
 }
 
+integer integer::from_bytes(const uint8_t * in, const std::size_t len, const endian order){
+    integer out;
+    if (order == endian::big){
+        load_bytes <true> (out._value, in, len);
+    }
+    else{
+        load_bytes <false> (out._value, in, len);
+    }
+    out.trim();
+    return out;
+}
+
+void integer::to_bytes(uint8_t * out, const std::size_t len, const endian order) const {
+    if (_sign == integer::NEGATIVE){
+        throw std::runtime_error("Error: Cannot write a negative value as bytes");
+    }
+
+    const integer::REP_SIZE_T needed = bytes();
+    if (needed > len){
+        throw std::runtime_error("Error: Value needs " + std::to_string(needed) + " bytes, but only " + std::to_string(len) + " are available");
+    }
+
+    if (order == endian::big){
+        store_bytes <true> (_value, out, len);
+    }
+    else{
+        store_bytes <false> (_value, out, len);
+    }
+}
+
+Status integer::serialize(const integer * in, const std::size_t count, const std::size_t width,
+                          uint8_t * out, const std::size_t capacity) noexcept {
+    for(std::size_t i = 0; i < count; i++){
+        if ((in[i]._sign == integer::NEGATIVE) || (in[i].bytes() > width)){
+            return Status::out_of_range;
+        }
+    }
+    if (width && (capacity / width < count)){
+        return Status::buffer_too_small;
+    }
+    for(std::size_t i = 0; i < count; i++){
+        store_bytes <false> (in[i]._value, out + i * width, width);
+    }
+    return Status::ok;
+}
+
+Status integer::deserialize(const uint8_t * in, const std::size_t len, const std::size_t width,
+                            std::vector <integer> & out) noexcept {
+    if (!width || (len % width)){
+        return Status::bad_encoding;
+    }
+    out.reserve(out.size() + len / width);
+    for(std::size_t i = 0; i < len; i += width){
+        integer value;
+        load_bytes <false> (value._value, in + i, width);
+        value.trim();
+        out.push_back(std::move(value));
+    }
+    return Status::ok;
+}
+
 // Bitshift Operators
 integer operator<<(const bool & lhs, const integer & rhs){
     return integer(lhs) << rhs;
@@ -1383,36 +3077,167 @@ integer operator>>(const int64_t & lhs, const integer & rhs){
 }
 
 // IO Operators
+// the value of c as a digit of base b, or b if it is not one
+static unsigned int char_digit(const int c, const unsigned int b){
+    unsigned int d = b;
+    if (('0' <= c) && (c <= '9')){
+        d = c - '0';
+    }
+    else if (('a' <= c) && (c <= 'f')){
+        d = c - 'a' + 10;
+    }
+    else if (('A' <= c) && (c <= 'F')){
+        d = c - 'A' + 10;
+    }
+    return std::min(d, b);
+}
+
+// n copies of fill; false if the buffer takes fewer
+static bool fill_stream(std::streambuf & out, const char fill, std::streamsize n){
+    for(; n > 0; n--){
+        if (out.sputc(fill) == std::char_traits <char>::eof()){
+            return false;
+        }
+    }
+    return true;
+}
+
 std::ostream & operator<<(std::ostream & stream, const integer & rhs){
-    if (stream.flags() & stream.oct){
-        stream << rhs.str(8);
+    const std::ostream::sentry guard(stream);
+    if (!guard){
+        return stream;
+    }
+    const std::ios_base::fmtflags flags = stream.flags();
+    const unsigned int base = (flags & std::ios_base::oct)?8:((flags & std::ios_base::hex)?16:10);
+
+    // sign, then the base prefix of showbase; as for the built-in integers, zero
+    // takes no prefix and showpos only applies to decimal
+    char prefix[3];
+    std::streamsize p = 0;
+    if (rhs._sign == integer::NEGATIVE){
+        prefix[p++] = '-';
+    }
+    else if ((flags & std::ios_base::showpos) && (base == 10)){
+        prefix[p++] = '+';
+    }
+    if ((flags & std::ios_base::showbase) && !rhs._value.empty() && (base != 10)){
+        prefix[p++] = '0';
+        if (base == 16){
+            prefix[p++] = (flags & std::ios_base::uppercase)?'X':'x';
+        }
+    }
+
+    small_vector <char, 256> buf(rhs.radix_room(base));
+    char * const end = buf.data() + buf.size();
+    char * const start = rhs.radix_chars(base, end);
+    if ((flags & std::ios_base::uppercase) && (base == 16)){
+        for(char * c = start; c < end; c++){
+            *c = static_cast <char> ((*c >= 'a')?(*c - 'a' + 'A'):*c);
+        }
+    }
+
+    // width and adjustfield as for the built-in integers: right by default,
+    // internal pads between the prefix and the digits
+    const std::streamsize n = p + (end - start);
+    const std::streamsize pad = std::max(stream.width() - n, static_cast <std::streamsize> (0));
+    const std::ios_base::fmtflags adjust = flags & std::ios_base::adjustfield;
+    std::streambuf & out = *stream.rdbuf();
+    bool good = true;
+    if ((adjust != std::ios_base::left) && (adjust != std::ios_base::internal)){
+        good = fill_stream(out, stream.fill(), pad);
     }
-    else if (stream.flags() & stream.hex){
-        stream << rhs.str(16);
+    good = good && (out.sputn(prefix, p) == p);
+    if (adjust == std::ios_base::internal){
+        good = good && fill_stream(out, stream.fill(), pad);
     }
-    else{
-        stream << rhs.str(10);
+    good = good && (out.sputn(start, end - start) == end - start);
+    if (adjust == std::ios_base::left){
+        good = good && fill_stream(out, stream.fill(), pad);
+    }
+    stream.width(0);
+    if (!good){
+        stream.setstate(std::ios_base::badbit);
     }
     return stream;
 }
 
 std::istream & operator>>(std::istream & stream, integer & rhs){
-    uint8_t base;
-    if (stream.flags() & stream.oct){
-        base = 8;
+    const std::istream::sentry guard(stream);
+    if (!guard){
+        return stream;
+    }
+    const std::ios_base::fmtflags flags = stream.flags();
+    const unsigned int base = (flags & std::ios_base::oct)?8:((flags & std::ios_base::hex)?16:10);
+
+    // the characters stay in the buffer up to the first one that is not a digit
+    std::streambuf & in = *stream.rdbuf();
+    small_vector <char, 256> text;
+    int c = in.sgetc();
+    if (c == '-'){
+        text.push_back('-');
+        c = in.snextc();
     }
-    else if (stream.flags() & stream.hex){
-        base = 16;
+    while ((c != std::char_traits <char>::eof()) && (char_digit(c, base) < base)){
+        text.push_back(static_cast <char> (c));
+        c = in.snextc();
     }
-    else{
-        base = 10;
+
+    std::ios_base::iostate state = std::ios_base::goodbit;
+    if (c == std::char_traits <char>::eof()){
+        state |= std::ios_base::eofbit;
+    }
+    if (from_chars(text.data(), text.data() + text.size(), rhs, base).status != Status::ok){
+        state |= std::ios_base::failbit;
     }
-    std::string in;
-    stream >> in;
-    rhs = integer(in, base);
+    stream.setstate(state);
     return stream;
 }
 
+to_chars_result to_chars(char * first, char * last, const integer & value, const int base) noexcept {
+    if ((base < 2) || (16 < base)){
+        return {last, Status::bad_base};
+    }
+    const unsigned int b = static_cast <unsigned int> (base);
+    const std::size_t sign = (value._sign == integer::NEGATIVE)?1:0;
+    const std::size_t room = value.radix_room(b);
+    const std::size_t space = static_cast <std::size_t> (last - first);
+
+    // straight into the buffer when the bound fits, then moved down to first
+    small_vector <char, 256> buf((space < sign + room)?room:0);
+    char * const end = (space < sign + room)?(buf.data() + room):(first + sign + room);
+    const char * const start = value.radix_chars(b, end);
+    const std::size_t n = static_cast <std::size_t> (end - start);
+    if (space < sign + n){
+        return {last, Status::buffer_too_small};
+    }
+    if (sign){
+        *first = '-';
+    }
+    std::memmove(first + sign, start, n);
+    return {first + sign + n, Status::ok};
+}
+
+from_chars_result from_chars(const char * first, const char * last, integer & value, const int base) noexcept {
+    if ((base < 2) || (16 < base)){
+        return {first, Status::bad_base};
+    }
+    const unsigned int b = static_cast <unsigned int> (base);
+    const char * const digits = first + (((first < last) && (*first == '-'))?1:0);
+    const char * end = digits;
+    while ((end < last) && (char_digit(*end, b) < b)){
+        end++;
+    }
+    if (end == digits){
+        return {first, Status::bad_digit};
+    }
+    Result <integer> out = integer::parse(first, static_cast <std::size_t> (end - first), base);
+    if (!out){
+        return {first, out.status()};
+    }
+    value = std::move(*out);
+    return {end, Status::ok};
+}
+
 // Special functions
 std::string makebin(const integer & value, const unsigned int & size){
     // Changes a value into its binary string
@@ -1431,4 +3256,382 @@ std::string makeascii(const integer & value, const unsigned int & size){
 
 integer abs(const integer & value){
     return (value.sign() == integer::POSITIVE)?value:-value;
-}
\ No newline at end of file
+}
+// Lehmer matrices come from the top LEHMER_BITS of the values: two digits where
+// there is a 128-bit type, so one matrix covers about 62 bits of quotients.
+// Cofactors stay below LEHMER_LIMIT, so they apply as single digits
+#if defined(__SIZEOF_INT128__)
+typedef __int128 lehmer_t;
+#else
+typedef int64_t  lehmer_t;
+#endif
+static const std::size_t LEHMER_BITS  = (sizeof(lehmer_t) << 3) - 2;
+static const lehmer_t    LEHMER_LIMIT = static_cast <lehmer_t> (1) << 62;
+
+// x >> shift, which fits in LEHMER_BITS
+static lehmer_t lehmer_top(const integer & x, const std::size_t shift){
+    const integer top = x >> shift;
+    lehmer_t out = 0;
+    for(std::size_t i = top.limb_count(); i-- > 0;){
+        out = (out << (sizeof(INTEGER_DIGIT_T) << 3)) | static_cast <lehmer_t> (top.limb(i));
+    }
+    return out;
+}
+
+// Knuth's Algorithm L (TAOCP vol. 2, 4.5.2): the Euclid steps on u >= v that
+// their top bits u_top and v_top decide, taking a quotient only where its
+// bounds from both ends of the truncation agree. (u, v) becomes
+// (l[0] u + l[1] v, l[2] u + l[3] v), and det is the matrix's determinant;
+// false if no step is decided
+static bool lehmer_matrix(lehmer_t u, lehmer_t v, int64_t (& l)[4], int & det){
+    lehmer_t a = 1, b = 0, c = 0, d = 1;
+    det = 1;
+    while ((v + c != 0) && (v + d != 0)){
+        const lehmer_t q = (u + a) / (v + c);
+        if (q != (u + b) / (v + d)){
+            break;
+        }
+        const lehmer_t t0 = a - q * c;
+        const lehmer_t t1 = b - q * d;
+        if ((t0 >= LEHMER_LIMIT) || (-t0 >= LEHMER_LIMIT) || (t1 >= LEHMER_LIMIT) || (-t1 >= LEHMER_LIMIT)){
+            break;
+        }
+        a = c;
+        c = t0;
+        b = d;
+        d = t1;
+        const lehmer_t t = u - q * v;
+        u = v;
+        v = t;
+        det = -det;
+    }
+    l[0] = static_cast <int64_t> (a);
+    l[1] = static_cast <int64_t> (b);
+    l[2] = static_cast <int64_t> (c);
+    l[3] = static_cast <int64_t> (d);
+    return b != 0;
+}
+
+// one Lehmer matrix on a >= b > 0: (x, y) = l (a, b)
+static bool lehmer_step(const integer & a, const integer & b, integer & x, integer & y, int64_t (& l)[4], int & det){
+    const std::size_t bits = a.bit_length();
+    const std::size_t shift = (bits > LEHMER_BITS)?(bits - LEHMER_BITS):0;
+    if (!lehmer_matrix(lehmer_top(a, shift), lehmer_top(b, shift), l, det)){
+        return false;
+    }
+    x = a * l[0] + b * l[1];
+    y = a * l[2] + b * l[3];
+    return true;
+}
+
+// (a, b) before a run of steps = m (a, b) after it, with nonnegative entries
+// and determinant det, so (a, b) after = det (m11 a - m01 b, m00 b - m10 a)
+struct gcd_matrix {
+    integer m00 = 1, m01 = 0, m10 = 0, m11 = 1;
+    int det = 1;
+    bool changed = false;
+
+    // *this = *this [[p, q], [r, t]], where [[p, q], [r, t]] has determinant d
+    void right_mul(const integer & p, const integer & q, const integer & r, const integer & t, const int d){
+        integer n00 = m00 * p + m01 * r, n01 = m00 * q + m01 * t;
+        integer n10 = m10 * p + m11 * r, n11 = m10 * q + m11 * t;
+        m00 = std::move(n00);
+        m01 = std::move(n01);
+        m10 = std::move(n10);
+        m11 = std::move(n11);
+        det *= d;
+        changed = true;
+    }
+};
+
+static void gcd_swap(integer & a, integer & b, gcd_matrix & m){
+    std::swap(a, b);
+    std::swap(m.m00, m.m01);
+    std::swap(m.m10, m.m11);
+    m.det = -m.det;
+    m.changed = true;
+}
+
+// |a - b| < 2^s
+static bool gcd_reduced(const integer & a, const integer & b, const std::size_t s){
+    return ((a > b)?(a - b):(b - a)).bit_length() <= s;
+}
+
+// a -= q b for the largest q leaving a >= 2^s, where a - b >= 2^s
+static void hgcd_subtract(integer & a, const integer & b, const integer & limit, gcd_matrix & m){
+    const integer q = (a - limit) / b;
+    a -= q * b;
+    m.m01 += q * m.m00;
+    m.m11 += q * m.m10;
+    m.changed = true;
+}
+
+// steps on a, b >= 2^s that keep both at least 2^s, until |a - b| < 2^s:
+// Lehmer matrices while they do not overshoot, then single subtractions
+static void hgcd_base(integer & a, integer & b, const std::size_t s, gcd_matrix & m){
+    const integer limit = integer(1) << s;
+    int64_t l[4];
+    int det;
+    integer x, y;
+    while (!gcd_reduced(a, b, s)){
+        if (a < b){
+            gcd_swap(a, b, m);
+        }
+        if (lehmer_step(a, b, x, y, l, det) && (x >= limit) && (y >= limit)){
+            a = std::move(x);
+            b = std::move(y);
+            // the inverse of l, which is nonnegative
+            m.right_mul(integer(l[3]) * det, integer(l[1]) * -det, integer(l[2]) * -det, integer(l[0]) * det, det);
+        }
+        else{
+            hgcd_subtract(a, b, limit, m);
+        }
+    }
+}
+
+static gcd_matrix hgcd(integer & a, integer & b);
+
+// the steps hgcd finds for the bits of a and b from k up, applied to the full
+// values when they leave both at least 2^s
+static void hgcd_high(integer & a, integer & b, const std::size_t k, const std::size_t s, gcd_matrix & m){
+    integer a1 = a >> k, b1 = b >> k;
+    const integer a0 = a - (a1 << k), b0 = b - (b1 << k);
+    const gcd_matrix h = hgcd(a1, b1);
+    if (!h.changed){
+        return;
+    }
+    integer x = (a1 << k) + (h.m11 * a0 - h.m01 * b0) * h.det;
+    integer y = (b1 << k) + (h.m00 * b0 - h.m10 * a0) * h.det;
+    if ((x < 0) || (y < 0) || (x.bit_length() <= s) || (y.bit_length() <= s)){
+        return;
+    }
+    a = std::move(x);
+    b = std::move(y);
+    m.right_mul(h.m00, h.m01, h.m10, h.m11, h.det);
+}
+
+// Moller's half-GCD ("On Schonhage's algorithm and subquadratic integer gcd
+// computation", 2008): reduces a and b of n bits until |a - b| < 2^s while both
+// stay at least 2^s, s = n / 2 + 1. The steps down to about 3n/4 bits come
+// from the top half of the values, then after one subtraction those down to
+// about n/2 from the top 2 (n' - s) bits, and hgcd_base finishes
+static gcd_matrix hgcd(integer & a, integer & b){
+    gcd_matrix m;
+    const std::size_t n = std::max(a.bit_length(), b.bit_length());
+    const std::size_t s = n / 2 + 1;
+    if (std::min(a.bit_length(), b.bit_length()) <= s){
+        return m;
+    }
+    if (n >= INTEGER_HGCD_BITS){
+        hgcd_high(a, b, n / 2, s, m);
+        if (!gcd_reduced(a, b, s)){
+            if (a < b){
+                gcd_swap(a, b, m);
+            }
+            hgcd_subtract(a, b, integer(1) << s, m);
+        }
+        const std::size_t n2 = std::max(a.bit_length(), b.bit_length());
+        // 2 (n2 - s) < n, so the recursion is on fewer bits
+        if (!gcd_reduced(a, b, s) && (n2 < n)){
+            hgcd_high(a, b, 2 * s - n2, s, m);
+        }
+    }
+    hgcd_base(a, b, s, m);
+    return m;
+}
+
+// Euclid on a, b >= 0 until b is 0, keeping a = c[0] a0 + c[1] b0 and
+// b = c[2] a0 + c[3] b0 for the a0 and b0 it started with when c is given
+static void gcd_loop(integer & a, integer & b, integer * c){
+    int64_t l[4];
+    int det;
+    integer x, y;
+    while (b){
+        if (a < b){
+            std::swap(a, b);
+            if (c){
+                std::swap(c[0], c[2]);
+                std::swap(c[1], c[3]);
+            }
+            continue;
+        }
+        if (!c && (a.bit_length() <= 64)){
+            a = integer(limb_gcd(static_cast <uint64_t> (a), static_cast <uint64_t> (b)));
+            b = 0;
+            return;
+        }
+        if ((b.bit_length() >= INTEGER_HGCD_BITS) && (2 * b.bit_length() > a.bit_length() + 2)){
+            const gcd_matrix m = hgcd(a, b);
+            if (m.changed){
+                for(integer * p = c; p && (p < c + 2); p++){
+                    integer first = (m.m11 * p[0] - m.m01 * p[2]) * m.det;
+                    p[2] = (m.m00 * p[2] - m.m10 * p[0]) * m.det;
+                    p[0] = std::move(first);
+                }
+                continue;
+            }
+        }
+        if (lehmer_step(a, b, x, y, l, det)){
+            a = std::move(x);
+            b = std::move(y);
+            for(integer * p = c; p && (p < c + 2); p++){
+                integer first = p[0] * l[0] + p[2] * l[1];
+                p[2] = p[0] * l[2] + p[2] * l[3];
+                p[0] = std::move(first);
+            }
+            continue;
+        }
+        std::pair <integer, integer> qr = a.divmod(a, b);
+        a = std::move(b);
+        b = std::move(qr.second);
+        for(integer * p = c; p && (p < c + 2); p++){
+            integer next = p[0] - qr.first * p[2];
+            p[0] = std::move(p[2]);
+            p[2] = std::move(next);
+        }
+    }
+}
+
+integer gcd(const integer & a, const integer & b){
+    integer x = abs(a), y = abs(b);
+    gcd_loop(x, y, nullptr);
+    return x;
+}
+
+integer lcm(const integer & a, const integer & b){
+    if (!a || !b){
+        return 0;
+    }
+    return abs(a) / gcd(a, b) * abs(b);
+}
+
+xgcd_result xgcd(const integer & a, const integer & b){
+    xgcd_result out;
+    if (!b){
+        out.g = abs(a);
+        out.x = (a < 0)?-1:(a?1:0);
+        out.y = 0;
+        return out;
+    }
+    integer c[4] = {1, 0, 0, 1};
+    out.g = abs(a);
+    integer y = abs(b);
+    gcd_loop(out.g, y, c);
+
+    // the x of the one solution in [0, |b| / g), and its y
+    const integer period = abs(b) / out.g;
+    out.x = ((a < 0)?-c[0]:c[0]) % period;
+    if (out.x < 0){
+        out.x += period;
+    }
+    out.y = (out.g - a * out.x) / b;
+    return out;
+}
+
+integer isqrt(const integer & x){
+    if (x < 0){
+        throw std::domain_error("Error: square root of a negative value");
+    }
+    if (!x){
+        return 0;
+    }
+
+    // a keeps (a - 1)^2 < (x >> 2 (c - d)) < (a + 1)^2 while d, its bits,
+    // doubles up to c: each step is one Newton step on the next d bits of x
+    const std::size_t c = (x.bit_length() - 1) / 2;
+    integer a = 1;
+    std::size_t d = 0;
+    std::size_t steps = 0;
+    while (c >> steps){
+        steps++;
+    }
+    while (steps--){
+        const std::size_t e = d;
+        d = c >> steps;
+        a = (a << (d - e - 1)) + (x >> (2 * c - e - d + 1)) / a;
+    }
+    return (a.square() > x)?(a - 1):a;
+}
+
+integer iroot(const integer & x, const unsigned int k){
+    if (!k){
+        throw std::domain_error("Error: 0th root");
+    }
+    if (x < 0){
+        if (!(k & 1)){
+            throw std::domain_error("Error: even root of a negative value");
+        }
+        return -iroot(-x, k);
+    }
+    if ((k == 1) || (x < 2)){
+        return x;
+    }
+    if (k == 2){
+        return isqrt(x);
+    }
+    if (k >= x.bit_length()){
+        return 1;
+    }
+
+    // from above the root, the steps fall to floor(x^(1/k)) and then stop falling
+    integer y = integer(1) << static_cast <std::size_t> ((x.bit_length() + k - 1) / k);
+    while (true){
+        integer next = (y * (k - 1) + x / pow(y, k - 1)) / k;
+        if (next >= y){
+            return y;
+        }
+        y = std::move(next);
+    }
+}
+
+// bit r set when r is a square mod m, for m <= 64
+static constexpr uint64_t square_residues(const unsigned int m){
+    uint64_t out = 0;
+    for(unsigned int i = 0; i < m; i++){
+        out |= static_cast <uint64_t> (1) << ((i * i) % m);
+    }
+    return out;
+}
+
+bool is_perfect_square(const integer & x){
+    if (x < 0){
+        return false;
+    }
+    if (!x){
+        return true;
+    }
+
+    static constexpr uint64_t RES64 = square_residues(64), RES63 = square_residues(63), RES5 = square_residues(5),
+                              RES11 = square_residues(11), RES13 = square_residues(13), RES17 = square_residues(17);
+    if (!((RES64 >> (x.limb(0) & 63)) & 1)){
+        return false;
+    }
+    const uint64_t r = static_cast <uint64_t> (x % 765765);     // 63 5 11 13 17
+    if (!((RES63 >> (r % 63)) & (RES5 >> (r % 5)) & (RES11 >> (r % 11)) &
+          (RES13 >> (r % 13)) & (RES17 >> (r % 17)) & 1)){
+        return false;
+    }
+    return isqrt(x).square() == x;
+}
+
+bool is_perfect_power(const integer & x){
+    const integer m = abs(x);
+    if (m < 2){
+        return true;
+    }
+    if ((x > 0) && is_perfect_square(m)){
+        return true;
+    }
+    // an odd prime k, as y^(jk) = (y^j)^k
+    const std::size_t bits = m.bit_length();
+    for(unsigned int k = 3; k < bits; k += 2){
+        bool prime = true;
+        for(unsigned int p = 3; prime && (p * p <= k); p += 2){
+            prime = k % p;
+        }
+        if (prime && (pow(iroot(m, k), k) == m)){
+            return true;
+        }
+    }
+    return false;
+}
@@ -22,94 +22,283 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
-#include <cmath> //For fft sin, cos, M_PI, and floor
+#include <cmath>
 #include <cstdint>
-#include <deque>
 #include <iostream>
 #include <limits>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <sstream>
-
-#ifndef M_PI
-#define M_PI 3.14159265359
+#if defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison >= 201907L
+#include <compare>
 #endif
 
+#include "hash.h"
+#include "limb.h"
+#include "small_vector.h"
+#include "Status.h"
+
 #ifndef __INTEGER__
 #define __INTEGER__
 
+// Digits are machine words by default: 64-bit limbs with a 128-bit double digit
+// where the compiler provides one, 32-bit limbs with a 64-bit double digit otherwise
 #ifndef INTEGER_DIGIT_T
-#define INTEGER_DIGIT_T        uint8_t
+#if defined(__SIZEOF_INT128__)
+#define INTEGER_DIGIT_T        uint64_t
+#else
+#define INTEGER_DIGIT_T        uint32_t
+#endif
 #endif
 
 #ifndef INTEGER_DOUBLE_DIGIT_T
+#if defined(__SIZEOF_INT128__)
+#define INTEGER_DOUBLE_DIGIT_T unsigned __int128
+#else
 #define INTEGER_DOUBLE_DIGIT_T uint64_t
 #endif
+#endif
 
 // INTEGET_DIGIT_T and INTEGER_DOUBLE_DIGIT_T
 // should be unsigned integers
+// (std::is_unsigned is false for unsigned __int128 in strict ISO mode, so check wraparound instead)
 static_assert(std::is_unsigned <INTEGER_DIGIT_T>::value &&
-              std::is_unsigned <INTEGER_DOUBLE_DIGIT_T>::value
+              (static_cast <INTEGER_DOUBLE_DIGIT_T> (-1) > static_cast <INTEGER_DOUBLE_DIGIT_T> (0))
         , "Internal types must be unsigned integers");
 
+// Values up to this many bits are stored inline in the integer itself, so every
+// temporary in 256-bit field arithmetic (including the 512-bit products) stays off the heap
+#ifndef INTEGER_INLINE_BITS
+#define INTEGER_INLINE_BITS    512
+#endif
+
+// the crossovers ecc_tune measured on the build machine: the header named by
+// ECC_INTEGER_TUNING (CMake's ECC_TUNING_HEADER), else an integer_tuning.h on
+// the include path; the defaults below fill in whatever neither defines
+#if defined(ECC_INTEGER_TUNING)
+#include ECC_INTEGER_TUNING
+#elif defined(__has_include)
+#if __has_include("integer_tuning.h")
+#include "integer_tuning.h"
+#endif
+#endif
+
+// operator* picks its algorithm from the operand sizes:
+// Comba while both operands are at most INTEGER_COMBA_BITS, then by the size of the
+// shorter operand schoolbook, Karatsuba from INTEGER_KARATSUBA_BITS,
+// Toom-3 from INTEGER_TOOM3_BITS and NTT from INTEGER_NTT_BITS
+#ifndef INTEGER_COMBA_BITS
+#define INTEGER_COMBA_BITS     1024
+#endif
+
+#ifndef INTEGER_KARATSUBA_BITS
+#define INTEGER_KARATSUBA_BITS 2048
+#endif
+
+#ifndef INTEGER_TOOM3_BITS
+#define INTEGER_TOOM3_BITS     65536
+#endif
+
+#ifndef INTEGER_NTT_BITS
+#define INTEGER_NTT_BITS       131072
+#endif
+
+// with an executor set (integer::set_executor), products whose shorter operand
+// has at least INTEGER_PARALLEL_NTT_BITS run the NTT on it, four-step
+#ifndef INTEGER_PARALLEL_NTT_BITS
+#define INTEGER_PARALLEL_NTT_BITS 1048576
+#endif
+
+// str() in bases that are not powers of two splits values of at least
+// INTEGER_RADIX_DC_BITS at powers of the base and converts the halves separately
+#ifndef INTEGER_RADIX_DC_BITS
+#define INTEGER_RADIX_DC_BITS  4096
+#endif
+
+// divmod picks its algorithm from the sizes of the divisor and the quotient:
+// Algorithm D until both have INTEGER_BZ_BITS, then Burnikel-Ziegler, and
+// Newton reciprocal division for divisors of INTEGER_NEWTON_BITS with
+// quotients at least 4 times as long, which pay for the reciprocal
+#ifndef INTEGER_BZ_BITS
+#define INTEGER_BZ_BITS        4096
+#endif
+
+#ifndef INTEGER_NEWTON_BITS
+#define INTEGER_NEWTON_BITS    131072
+#endif
+
+// gcd, lcm and xgcd run Lehmer's algorithm, and reduce values of at least
+// INTEGER_HGCD_BITS by half-GCD first
+#ifndef INTEGER_HGCD_BITS
+#define INTEGER_HGCD_BITS      8192
+#endif
+
+// built with ECC_HAVE_GMP (the ECC_GMP CMake option), products whose shorter
+// operand has at least INTEGER_GMP_BITS, squares that long and divisions by
+// divisors that long go to GMP's mpn_mul, mpn_sqr and mpn_tdiv_qr on the same
+// digits in place of Karatsuba, Toom-3, NTT and Algorithm D
+#ifndef INTEGER_GMP_BITS
+#define INTEGER_GMP_BITS       4096
+#endif
+
 // INTEGER_DOUBLE_DIGIT_T should be at least 2 times the size of INTEGER_DIGIT_T
 static_assert((2 * sizeof(INTEGER_DIGIT_T)) <= sizeof(INTEGER_DOUBLE_DIGIT_T)
         , "INTEGER_DOUBLE_DIGIT_T should be at least twice the size of INTEGER_DIGIT_T");
 
+struct to_chars_result;
+class Executor;
+
 class integer{
+    friend class BarrettReducer;    // reduces on the digits directly
+    friend class natural;           // the magnitude kernels without the sign cases
+
 public:
-    typedef std::deque <INTEGER_DIGIT_T> REP;                                                 // internal representation of values
-    typedef REP::size_type               REP_SIZE_T;                                          // size type of internal representation
+    // internal representation of values, least significant digit first
+    // two spare digits leave room for the carry digit add and the shifts allocate
+    typedef small_vector <INTEGER_DIGIT_T, INTEGER_INLINE_BITS / (sizeof(INTEGER_DIGIT_T) << 3) + 2> REP;
+    typedef REP::size_type REP_SIZE_T;                                                        // size type of internal representation
 
 private:
     static constexpr INTEGER_DIGIT_T NEG1     = std::numeric_limits <INTEGER_DIGIT_T>::max(); // value with all bits ON - will only work for unsigned integer types
     static constexpr std::size_t     OCTETS   = sizeof(INTEGER_DIGIT_T);                      // number of octets per INTEGER_DIGIT_T
     static constexpr std::size_t     BITS     = OCTETS << 3;                                  // number of bits per INTEGER_DIGIT_T; hardcode this if INTEGER_DIGIT_T is not standard int type
-    static constexpr INTEGER_DIGIT_T HIGH_BIT = 1 << (BITS - 1);                              // highest bit of INTEGER_DIGIT_T (uint8_t -> 128)
+    static constexpr INTEGER_DIGIT_T HIGH_BIT = static_cast <INTEGER_DIGIT_T> (1) << (BITS - 1); // highest bit of INTEGER_DIGIT_T (uint8_t -> 128)
 
 public:
     typedef bool Sign;
     static constexpr Sign POSITIVE = false;                                                   // includes 0
     static constexpr Sign NEGATIVE = true;
 
+    // byte order of the buffers from_bytes and to_bytes work on
+    enum class endian { big, little };
+
 private:
     bool _sign;     // sign of value
     REP _value;     // absolute value of *this
 
+    // unsigned type wide enough to hold the magnitude of a Z
+    template <typename Z, bool = std::is_same <Z, bool>::value>
+    struct magnitude { typedef typename std::make_unsigned <Z>::type type; };
+    template <typename Z>
+    struct magnitude <Z, true> { typedef unsigned char type; };
+
     template <typename Z>
     integer & setFromZ(Z val){
         static_assert( std::is_integral  <Z>::value &&
                        !std::is_const     <Z>::value &&
                        !std::is_reference <Z>::value
                 , "Input to integer::setFromZ should be passed by value");
+        typedef typename magnitude <Z>::type U;
+
         _value.clear();
         _sign = POSITIVE;
 
-        // make positive
+        // make positive; negate in the unsigned type so the minimum value does not overflow
+        U mag = static_cast <U> (val);
         if (std::is_signed <Z>::value && (val < 0)){
             _sign = NEGATIVE;
-            val = -val; // treat as positive even if top bit is still set
+            mag = static_cast <U> (0) - mag;
         }
 
-        // keep this here just in case value is sign extended
-        for(std::size_t d = std::max(sizeof(Z) / OCTETS, (std::size_t) 1); d > 0; d--){
-            _value.push_front(val & NEG1);
-            val >>= BITS;
+        // least significant digit first
+        if constexpr (sizeof(U) > OCTETS){
+            while (mag){
+                _value.push_back(static_cast <INTEGER_DIGIT_T> (mag & NEG1));
+                mag >>= BITS;
+            }
+        }
+        else if (mag){
+            _value.push_back(static_cast <INTEGER_DIGIT_T> (mag));
         }
 
         return trim();
     }
 
-    // remove 0 digits from top of deque to save memory
+    // remove 0 digits from top of _value to save memory
     integer & trim();
 
+    // Single digit operands: one pass over the digits of the magnitude, in place
+    // |*this| += w, |*this| -= w (|*this| >= w), |*this| *= w
+    integer & add_word(const INTEGER_DIGIT_T w);
+    integer & sub_word(const INTEGER_DIGIT_T w);
+    integer & mul_word(const INTEGER_DIGIT_T w);
+    // |*this| /= w, returning the remainder, and the remainder alone;
+    // both throw std::domain_error if w is 0
+    INTEGER_DIGIT_T div_word(const INTEGER_DIGIT_T w);
+    INTEGER_DIGIT_T mod_word(const INTEGER_DIGIT_T w) const;
+
+    // *this += w with the given sign
+    integer & add_signed_word(const Sign sign, const INTEGER_DIGIT_T w);
+
+    // |*this| += |rhs| and |*this| -= |rhs| in the existing digits; sub_magnitude
+    // flips the sign when |rhs| is the larger. rhs must not be _value
+    integer & add_magnitude(const REP & rhs);
+    integer & sub_magnitude(const REP & rhs);
+
+    // *this += |a * b| with the given sign, for addmul and submul
+    integer & mac(const integer & a, const integer & b, const Sign sign);
+
+    // rhs as a sign and a single digit magnitude; false if the magnitude needs more digits
+    template <typename Z>
+    static bool split_word(const Z & rhs, Sign & sign, INTEGER_DIGIT_T & word){
+        typedef typename magnitude <Z>::type U;
+
+        U mag = static_cast <U> (rhs);
+        sign = POSITIVE;
+        if constexpr (std::is_signed <Z>::value){
+            if (rhs < 0){
+                sign = NEGATIVE;
+                mag = static_cast <U> (0) - mag;
+            }
+        }
+        if constexpr (sizeof(U) > OCTETS){
+            if (mag > NEG1){
+                return false;
+            }
+        }
+        word = static_cast <INTEGER_DIGIT_T> (mag);
+        return true;
+    }
+
+    // sum of digits[i] * base^(n - 1 - i), most significant digit first; pairs of
+    // neighbours are merged bottom-up with base, base^2, base^4, ..., so the
+    // work is a few multiplications of every size instead of one per digit
+    static integer from_digits(std::vector <integer> & digits, const integer & base);
+
+    // writes x in base b so that it ends just before end, most significant
+    // first, and returns where it starts; exactly width characters (zero
+    // padded) if width is not 0. powers[i] = b^(chunk * 2^i)
+    char * radix_split(const integer & x, const unsigned int b, const std::vector <integer> & powers,
+                       const INTEGER_DIGIT_T chunk_base, const std::size_t chunk, const std::size_t width, char * end) const;
+
+    // the magnitude in base b (2-16) written back from end as radix_split does,
+    // with no leading zeros; the characters before end must number radix_room(b)
+    char * radix_chars(const unsigned int b, char * end) const;
+    std::size_t radix_room(const unsigned int b) const;
+
+    friend to_chars_result to_chars(char * first, char * last, const integer & value, const int base) noexcept;
+    friend std::ostream & operator<<(std::ostream & stream, const integer & rhs);
+
+    // a built-in shift count as std::size_t; throws std::runtime_error if it is negative
+    template <typename Z>
+    static std::size_t shift_count(const Z & rhs){
+        if constexpr (std::is_signed <Z>::value){
+            if (rhs < 0){
+                throw std::runtime_error("Error: Negative shift amount");
+            }
+        }
+        return static_cast <std::size_t> (rhs);
+    }
+
 public:
     // Constructors
     integer();
     integer(const integer & rhs);
     integer(integer && rhs);
-    integer(const REP & rhs, const Sign & sign = POSITIVE);
+    integer(const REP & rhs, const Sign & sign = POSITIVE);                // rhs is least significant digit first
 
     // Special boolean constructor
     integer(const bool & b);
@@ -127,18 +316,25 @@ public:
     //      Written by Corbin http://codereview.stackexchange.com/a/13452
     //      Modified by me
     integer(const std::string & val, const integer & base);
+    // the same without exceptions: Status::bad_digit or Status::bad_base where
+    // the constructor throws
+    static Result <integer> parse(const std::string & val, const integer & base) noexcept;
+    // the same over the characters val[0, len)
+    static Result <integer> parse(const char * val, const std::size_t len, const integer & base) noexcept;
 
     // Use this to construct integers with other types that have pointers/iterators to their beginning and end
-    // all inputs are treated as positive values
+    // all inputs are treated as positive values, most significant digit first
     template <typename Iterator> integer(Iterator start, const Iterator & end, const integer & base) : integer()
     {
         if (base < 2){
             throw std::runtime_error("Error: Cannot convert from base " + base.str(10));
         }
 
+        std::vector <integer> digits;
         for(; start != end; start++){
-            *this = (*this * base) | *start;
+            digits.push_back(integer(*start));
         }
+        *this = from_digits(digits, base);
     }
 
 public:
@@ -166,7 +362,15 @@ public:
     operator int32_t()  const;
     operator int64_t()  const;
 
+private:
+    enum class bit_op { AND, OR, XOR };
+    // *this op= rhs a digit at a time, in place
+    integer & bitwise(const integer & rhs, const bit_op op);
+
+public:
     // Bitwise Operators
+    // word by word on the digits, in place for the assignments; negative
+    // values take part as their two's complement (-1 is all ones), as in GMP
     integer operator&(const integer & rhs) const;
     template <typename Z>
     integer operator&(const Z & rhs)       const {
@@ -215,48 +419,57 @@ public:
         return *this ^= integer(rhs);
     }
 
+    // the bits of the magnitude below its highest set bit inverted, sign kept
     integer operator~() const;
 
     // Bitshift Operators
+    // shift counts of built-in types go straight to the std::size_t overloads,
+    // which move whole digits and funnel the remaining bits across neighbours;
+    // the compound forms shift in place
     // left bitshift. sign is maintained
     integer operator<<(const integer & shift) const;
+    integer operator<<(const std::size_t shift) const;
     template <typename Z>
     integer operator<<(const Z & rhs)         const {
         static_assert(std::is_integral <Z>::value
                 , "Input type must be integral");
-        return *this << integer(rhs);
+        return *this << shift_count(rhs);
     }
 
     integer & operator<<=(const integer & shift);
+    integer & operator<<=(const std::size_t shift);
     template <typename Z>
     integer & operator<<=(const Z & rhs){
         static_assert(std::is_integral <Z>::value
                 , "Input type must be integral");
-        return *this <<= integer(rhs);
+        return *this <<= shift_count(rhs);
     }
 
     // right bitshift. sign is maintained
     integer operator>>(const integer & shift) const;
+    integer operator>>(const std::size_t shift) const;
     template <typename Z>
     integer operator>>(const Z & rhs)         const {
         static_assert(std::is_integral <Z>::value
                 , "Input type must be integral");
-        return *this >> integer(rhs);
+        return *this >> shift_count(rhs);
     }
 
     integer & operator>>=(const integer & shift);
+    integer & operator>>=(const std::size_t shift);
     template <typename Z>
     integer & operator>>=(const Z & rhs){
         static_assert(std::is_integral <Z>::value
                 , "Input type must be integral");
-        return *this >>= integer(rhs);
+        return *this >>= shift_count(rhs);
     }
 
     // Logical Operators
     bool operator!();
 
     // Comparison Operators
-    bool operator==(const integer & rhs) const;
+    // a memcmp of the digits, inline
+    bool operator==(const integer & rhs) const { return (_sign == rhs._sign) && (_value == rhs._value); }
     template <typename Z>
     integer operator==(const Z & rhs)    const {
         static_assert(std::is_integral <Z>::value
@@ -273,11 +486,23 @@ public:
     }
 
 private:
+    // -1, 0 or 1 as |lhs| is below, equal to or above |rhs|: the digit counts,
+    // then one pass down from the top digit
+    static int compare_magnitude(const integer & lhs, const integer & rhs);
     // operator> not considering signs
-    bool gt(const integer & lhs, const integer & rhs) const;
+    static bool gt(const integer & lhs, const integer & rhs) { return compare_magnitude(lhs, rhs) > 0; }
+    // operator< not considering signs
+    static bool lt(const integer & lhs, const integer & rhs) { return compare_magnitude(lhs, rhs) < 0; }
 
 public:
-    bool operator>(const integer & rhs) const;
+    // -1, 0 or 1 as *this is below, equal to or above rhs, from the signs
+    // alone when they differ; every relational operator is one call of this
+    int compare(const integer & rhs) const;
+#if defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison >= 201907L
+    std::strong_ordering operator<=>(const integer & rhs) const { return compare(rhs) <=> 0; }
+#endif
+
+    bool operator>(const integer & rhs) const { return compare(rhs) > 0; }
     template <typename Z>
     integer operator>(const Z & rhs)    const {
         static_assert(std::is_integral <Z>::value
@@ -285,7 +510,7 @@ public:
         return (*this > integer(rhs));
     }
 
-    bool operator>=(const integer & rhs) const;
+    bool operator>=(const integer & rhs) const { return compare(rhs) >= 0; }
     template <typename Z>
     integer operator>=(const Z & rhs)    const {
         static_assert(std::is_integral <Z>::value
@@ -293,12 +518,7 @@ public:
         return (*this >= integer(rhs));
     }
 
-private:
-    // operator< not considering signs
-    bool lt(const integer & lhs, const integer & rhs) const;
-
-public:
-    bool operator<(const integer & rhs) const;
+    bool operator<(const integer & rhs) const { return compare(rhs) < 0; }
     template <typename Z>
     integer operator<(const Z & rhs)    const {
         static_assert(std::is_integral <Z>::value
@@ -306,7 +526,7 @@ public:
         return (*this < integer(rhs));
     }
 
-    bool operator<=(const integer & rhs) const;
+    bool operator<=(const integer & rhs) const { return compare(rhs) <= 0; }
     template <typename Z>
     integer operator<=(const Z & rhs)    const {
         static_assert(std::is_integral <Z>::value
@@ -324,14 +544,25 @@ public:
     integer operator+(const Z & rhs)       const {
         static_assert(std::is_integral <Z>::value
                 , "Input type must be integral");
+        Sign sign; INTEGER_DIGIT_T word;
+        if (split_word(rhs, sign, word)){
+            integer out(*this);
+            return out.add_signed_word(sign, word);
+        }
         return *this + integer(rhs);
     }
 
+    // +=, -= and the single digit *=, /= and %= work in the existing digits
+    // rather than building a new value
     integer & operator+=(const integer & rhs);
     template <typename Z>
     integer & operator+=(const Z & rhs){
         static_assert(std::is_integral <Z>::value
                 , "Input type must be integral");
+        Sign sign; INTEGER_DIGIT_T word;
+        if (split_word(rhs, sign, word)){
+            return add_signed_word(sign, word);
+        }
         return *this += integer(rhs);
     }
 
@@ -353,6 +584,11 @@ public:
     integer operator-(const Z & rhs)       const {
         static_assert(std::is_integral <Z>::value
                 , "Input type must be integral");
+        Sign sign; INTEGER_DIGIT_T word;
+        if (split_word(rhs, sign, word)){
+            integer out(*this);
+            return out.add_signed_word(!sign, word);
+        }
         return *this - integer(rhs);
     }
 
@@ -361,6 +597,10 @@ public:
     integer & operator-=(const Z & rhs){
         static_assert(std::is_integral <Z>::value
                 , "Input type must be integral");
+        Sign sign; INTEGER_DIGIT_T word;
+        if (split_word(rhs, sign, word)){
+            return add_signed_word(!sign, word);
+        }
         return *this -= integer(rhs);
     }
 
@@ -374,47 +614,107 @@ private:
     // // Recursive Multiplication
     // integer recursive_mult(const integer & lhs, const integer & rhs) const;
 
-    // // Karatsuba Algorithm O(n-log2(3) = n - 1.585)
-    // // The Peasant Multiplication function is needed if Karatsuba is used.
-    // // Thanks to kjo @ stackoverflow for fixing up my original Karatsuba Algorithm implementation
-    // // which I then converted to C++ and made a few changes.
-    // // http://stackoverflow.com/questions/7058838/karatsuba-algorithm-too-much-recursion
-    // integer karatsuba(const integer & lhs, const integer & rhs, integer bm = 0x1000000U) const;
-
-    // // // Toom-Cook multiplication
-    // // // as described at http://en.wikipedia.org/wiki/Toom%E2%80%93Cook_multiplications
-    // // // The peasant function is needed if karatsuba is used.
-    // // // This implementation is a bit weird. In the pointwise Multiplcation step, using
-    // // // operator* and long_mult works, but everything else fails.
-    // // // It's also kind of slow.
-    // // integer toom_cook_3(integer m, integer n, integer bm = 0x1000000U);
-
-    // // Long multiplication
-    // integer long_mult(const integer & lhs, const integer & rhs) const;
-
-    //Private FFT helper function
-    int fft(std::deque<double>& data, bool dir = true) const;
-
-    // FFT-based multiplication
-    //Based on the convolution theorem which states that the Fourier
-    //transform of a convolution is the pointwise product of their
-    //Fourier transforms.
-    integer fft_mult(const integer& lhs, const integer& rhs) const;
+    // Karatsuba Algorithm O(n^log2(3) = n^1.585)
+    // Splits both operands in half and recombines three half-size products.
+    // Runs on raw digit arrays with one scratch buffer and drops to schoolbook
+    // below INTEGER_KARATSUBA_BITS; unbalanced operands are cut into
+    // blocks the size of the shorter one.
+    integer karatsuba(const integer & lhs, const integer & rhs) const;
+
+    // Toom-Cook multiplication
+    // as described at http://en.wikipedia.org/wiki/Toom%E2%80%93Cook_multiplications
+    // Evaluates at 0, 1, -1, -2 and infinity and interpolates with Bodrato's
+    // sequence, so the only divisions are an exact one by 3 and shifts.
+    // The five pointwise products go back through the operator* dispatch.
+    integer toom_cook_3(const integer & lhs, const integer & rhs) const;
+
+    // Long multiplication (schoolbook, one row per lhs digit)
+    integer long_mult(const integer & lhs, const integer & rhs) const;
+
+    // Comba multiplication: schoolbook done column by column, so every
+    // output digit is written once from a three digit accumulator
+    integer comba_mult(const integer & lhs, const integer & rhs) const;
+
+    // product of the absolute values, using the size-based dispatch of operator*
+    integer mult(const integer & lhs, const integer & rhs) const;
+
+    // Comba squaring: each column sums the products a[i] * a[j], i < j, once,
+    // doubles them and adds the square a[k / 2] * a[k / 2]
+    integer comba_sqr() const;
+
+    // NTT-based multiplication
+    // Exact transform multiplication over three primes below 2^63 with CRT
+    // recombination, for operands of at least INTEGER_NTT_BITS. With an
+    // executor the transforms are four-step, their rows and columns spread
+    // over its threads.
+    integer ntt_mult(const integer & lhs, const integer & rhs, Executor * executor = nullptr) const;
+
+#ifdef ECC_HAVE_GMP
+    // mpn_mul and mpn_sqr on the digits, for operands of at least INTEGER_GMP_BITS
+    integer gmp_mult(const integer & lhs, const integer & rhs) const;
+    integer gmp_sqr() const;
+#endif
+
+public:
+    // The crossovers operator*, square and str() dispatch on, in bits, starting
+    // at the INTEGER_*_BITS values. set_tuning is for tuners and benchmarks
+    // trying other values at run time: it is not synchronized with arithmetic
+    // on other threads, and takes toom3_bits as at least 8 digits
+    struct Tuning {
+        std::size_t comba_bits;
+        std::size_t karatsuba_bits;
+        std::size_t toom3_bits;
+        std::size_t ntt_bits;
+        std::size_t radix_dc_bits;
+    };
+    static const Tuning & tuning() { return current_tuning; }
+    static void set_tuning(const Tuning & tuning);
+
+    // The Executor operator* and square() run NTT products of at least
+    // INTEGER_PARALLEL_NTT_BITS on, or null (the default) to keep every product
+    // on the calling thread. Like set_tuning, not synchronized with arithmetic
+    // on other threads; the executor must outlive its use here
+    static Executor * executor() { return current_executor; }
+    static void set_executor(Executor * executor);
+
+private:
+    static Tuning current_tuning;
+    static Executor * current_executor;
 
 public:
     integer operator*(const integer & rhs) const;
+    // *this * *this, computing every cross product once; about 35% less work
+    // than operator* below the Toom-3 threshold, the same above it
+    integer square() const;
     template <typename Z>
     integer operator*(const Z & rhs)       const {
         static_assert(std::is_integral <Z>::value
                 , "Input type must be integral");
+        Sign sign; INTEGER_DIGIT_T word;
+        if (split_word(rhs, sign, word)){
+            integer out(*this);
+            out._sign ^= sign;
+            return out.mul_word(word);
+        }
         return *this * integer(rhs);
     }
 
     integer & operator*=(const integer & rhs);
+
+    // *this += a * b and *this -= a * b, accumulating into the existing digits;
+    // a single digit factor is folded in as one multiply-accumulate pass
+    integer & addmul(const integer & a, const integer & b);
+    integer & submul(const integer & a, const integer & b);
+
     template <typename Z>
     integer & operator*=(const Z & rhs){
         static_assert(std::is_integral <Z>::value
                 , "Input type must be integral");
+        Sign sign; INTEGER_DIGIT_T word;
+        if (split_word(rhs, sign, word)){
+            _sign ^= sign;
+            return mul_word(word);
+        }
         return *this *= integer(rhs);
     }
 
@@ -432,19 +732,51 @@ private:
     // Non-Recursive version of above algorithm
     std::pair <integer, integer> non_recursive_divmod(const integer & lhs, const integer & rhs) const;
 
+    // Knuth's Algorithm D: word-at-a-time long division with normalization
+    // Needs lhs > rhs > 1, which dm guarantees.
+    std::pair <integer, integer> knuth_divmod(const integer & lhs, const integer & rhs) const;
+
+    // the digits [from, from + count) of the magnitude, as a value
+    integer digit_slice(const REP_SIZE_T from, const REP_SIZE_T count) const;
+
+    // The subquadratic tiers. Both operands are shifted until the top bit of
+    // rhs is set and lhs is cut into blocks of rhs's digits; each block, under
+    // the remainder so far, is divided by recursive Burnikel-Ziegler halving
+    // (two 3n/2n steps of half-size quotients, down to Algorithm D below
+    // INTEGER_BZ_BITS), or with newton set by two products with floor(2^2n / rhs)
+    // from reciprocal() and a correction of a few units. Needs lhs > rhs > 1.
+    std::pair <integer, integer> block_divmod(const integer & lhs, const integer & rhs, const bool newton) const;
+    // a < b * 2^n for b of exactly n bits, n even
+    std::pair <integer, integer> bz_2n1n(const integer & a, const integer & b, const std::size_t n) const;
+    // (a12 * 2^n + a3) by b = b1 * 2^n + b2, where a12 < b * 2^n
+    std::pair <integer, integer> bz_3n2n(const integer & a12, const integer & a3, const integer & b,
+                                         const integer & b1, const integer & b2, const std::size_t n) const;
+    // floor(2^2n / b), within a few units, for b of exactly n bits: a Newton
+    // step from the reciprocal of b's top half, down to an exact one by dm
+    integer reciprocal(const integer & b, const std::size_t n) const;
+
+#ifdef ECC_HAVE_GMP
+    // mpn_tdiv_qr on the digits, for divisors of at least INTEGER_GMP_BITS
+    // Needs lhs > rhs > 1 too.
+    std::pair <integer, integer> gmp_divmod(const integer & lhs, const integer & rhs) const;
+#endif
+
     // division and modulus ignoring signs
     std::pair <integer, integer> dm(const integer & lhs, const integer & rhs) const;
 
 public:
     // division and modulus with signs
     std::pair <integer, integer> divmod(const integer & lhs, const integer & rhs) const;
+    // Status::division_by_zero instead of the exception
+    static Result <std::pair <integer, integer> > try_divmod(const integer & lhs, const integer & rhs) noexcept;
 
     integer operator/(const integer & rhs) const;
     template <typename Z>
     integer operator/(const Z & rhs)       const {
         static_assert(std::is_integral <Z>::value
                 , "Input type must be integral");
-        return *this / integer(rhs);
+        integer out(*this);
+        return out /= rhs;
     }
 
     integer & operator/=(const integer & rhs);
@@ -452,6 +784,12 @@ public:
     integer & operator/=(const Z & rhs){
         static_assert(std::is_integral <Z>::value
                 , "Input type must be integral");
+        Sign sign; INTEGER_DIGIT_T word;
+        if (split_word(rhs, sign, word)){
+            div_word(word);
+            _sign ^= sign;
+            return trim();
+        }
         return *this /= integer(rhs);
     }
 
@@ -460,6 +798,13 @@ public:
     integer operator%(const Z & rhs)       const {
         static_assert(std::is_integral <Z>::value
                 , "Input type must be integral");
+        Sign sign; INTEGER_DIGIT_T word;
+        if (split_word(rhs, sign, word)){
+            // the remainder takes the sign of the dividend
+            integer out(mod_word(word));
+            out._sign = out._value.empty()?POSITIVE:_sign;
+            return out;
+        }
         return *this % integer(rhs);
     }
 
@@ -468,7 +813,7 @@ public:
     integer & operator%=(const Z & rhs){
         static_assert(std::is_integral <Z>::value
                 , "Input type must be integral");
-        return *this %= integer(rhs);
+        return *this = *this % rhs;
     }
 
     // Increment Operator
@@ -491,15 +836,45 @@ public:
     // get minimum number of bits needed to hold this value
     integer bits() const;
 
+    // bits() as a std::size_t, from the leading zeros of the top digit
+    std::size_t bit_length() const;
+
     // get minimum number of bytes needed to hold this value
     REP_SIZE_T bytes() const;
 
     // get number of digits of internal representation
     REP_SIZE_T digits() const;
 
-    // get internal data
+    // get internal data (least significant digit first)
     REP data() const;
 
+    // read-only view of the digits, least significant first; std::span is
+    // C++20, so this is the same idea. Valid until *this is next modified
+    struct limb_span {
+        const INTEGER_DIGIT_T * ptr;
+        std::size_t             count;
+
+        const INTEGER_DIGIT_T * data()  const { return ptr; }
+        std::size_t             size()  const { return count; }
+        bool                    empty() const { return !count; }
+        const INTEGER_DIGIT_T * begin() const { return ptr; }
+        const INTEGER_DIGIT_T * end()   const { return ptr + count; }
+        const INTEGER_DIGIT_T & operator[](const std::size_t i) const { return ptr[i]; }
+    };
+    limb_span limbs() const;
+
+    // number of digits, and digit i of the magnitude (0 past the top), without copying
+    std::size_t limb_count() const;
+    INTEGER_DIGIT_T limb(const std::size_t i) const;
+
+    // bytes of heap held beyond sizeof(integer): 0 while the digits fit the
+    // inline buffer (INTEGER_INLINE_BITS), else the capacity of the buffer
+    std::size_t heap_bytes() const;
+
+    // hash_words of the digits under seed, with the sign mixed in, for
+    // hash-map keys; std::hash <integer> is this under hash_seed()
+    uint64_t hash(const uint64_t seed) const;
+
     // Miscellaneous Functions
     integer & negate();
 
@@ -511,9 +886,74 @@ public:
 
     // get bit, where 0 is the lsb and bits() - 1 is the msb
     bool operator[](const REP_SIZE_T & b) const;
+    // bit b of the magnitude; 0 past the top
+    bool test_bit(const std::size_t b) const;
+    // bits [pos, pos + len) of the magnitude, len at most 64, from the one or
+    // two digits holding them; 0 past the top. Windows for wNAF, Pippenger and
+    // fixed-window exponents without a shifted copy
+    uint64_t extract_bits(const std::size_t pos, const std::size_t len) const;
+
+    // inverse modulo modulus in [0, modulus); throws std::domain_error if there is none
+    // binary extended Euclid for odd moduli (shifts and subtractions only),
+    // the classic extended Euclid otherwise. Not constant time.
+    integer modinv(const integer & modulus) const;
+    // Status::bad_modulus or Status::not_invertible instead of the exception
+    Result <integer> try_modinv(const integer & modulus) const noexcept;
+
+    // Jacobi symbol (a / n) in {-1, 0, 1} for odd positive n; throws std::domain_error
+    // otherwise. Binary reduction with shifts and subtractions, no exponentiation,
+    // finishing in a single word once both values fit in 64 bits. Not constant time.
+    static int jacobi(const integer & a, const integer & n);
 
     // Output _value as a string in bases 2 to 16, and 256
+    // power-of-two bases read the bits directly; the others convert large values
+    // by divide and conquer (see INTEGER_RADIX_DC_BITS)
     std::string str(const integer & base = 10, const std::string::size_type & length = 1) const;
+
+    // Raw magnitudes in caller-owned buffers, with no intermediate string
+    // from_bytes reads len bytes as a non-negative value
+    static integer from_bytes(const uint8_t * in, const std::size_t len, const endian order = endian::big);
+
+    // writes the magnitude into exactly len bytes, zero padded
+    // throws std::runtime_error if *this is negative or needs more than len bytes
+    void to_bytes(uint8_t * out, const std::size_t len, const endian order = endian::big) const;
+
+    // The wire format: non-negative values back to back, each little-endian in
+    // exactly width bytes, so a value's bytes are its digits on a little-endian host
+    // Status::out_of_range if a value is negative or needs more than width bytes,
+    // Status::buffer_too_small if capacity is short of count * width; nothing
+    // is written unless every value fits
+    static Status serialize(const integer * in, const std::size_t count, const std::size_t width,
+                            uint8_t * out, const std::size_t capacity) noexcept;
+    // the len / width values at in, appended to out; Status::bad_encoding if
+    // width is 0 or does not divide len
+    static Status deserialize(const uint8_t * in, const std::size_t len, const std::size_t width,
+                              std::vector <integer> & out) noexcept;
+};
+
+// A factor kept in NTT form, for products by the same large value over and
+// over (a modulus or a reciprocal through a long run of reductions): each
+// product transforms only the other operand, two transforms per prime where
+// operator* does three. The transform is sized for other operands of up to
+// other_digits digits; longer ones, and a value below the NTT crossover, go
+// through operator*. Products run on the integer::executor() set when the
+// multiplier was built, which must outlive it.
+class NttMultiplier {
+public:
+    NttMultiplier(const integer & value, const std::size_t other_digits);
+
+    const integer & value() const { return factor; }
+    std::size_t max_digits() const { return other; }
+
+    // value() * x
+    integer operator()(const integer & x) const;
+
+private:
+    integer factor;
+    std::size_t other;
+    std::size_t n;                          // points per transform, 0 to use operator*
+    Executor * executor;
+    std::vector <limb_t> transformed;       // the forward transform of value under each of the three primes
 };
 
 // Give integer type traits
@@ -523,17 +963,169 @@ namespace std {  // This is probably not a good idea
     template <> struct is_signed     <integer> : std::true_type {};
 };
 
-// operators where lhs is not of type integer
+// operators on an expiring integer
+// (a * b) % p, x + (y * z) and the like apply the compound form to the
+// temporary and hand its digits on, instead of building the result in a new
+// buffer. The products and quotients still need one of their own, but +, -,
+// the bitwise operators, the shifts and negation work in the temporary's
+// digits, and % of a value already smaller than the modulus moves it through
+// untouched. The integer operands are deduced rather than converted to, so
+// values of other types never reach these.
+template <typename T, typename Z>
+using if_expiring_integer = typename std::enable_if <std::is_same <T, integer>::value &&
+                                                     std::is_integral <Z>::value, integer>::type;
+
+template <typename T, typename Z>
+if_expiring_integer <T, Z> operator+(T && lhs, const Z & rhs){
+    return std::move(lhs += rhs);
+}
 
-// Bitwise Operators
+template <typename T, typename Z>
+if_expiring_integer <T, Z> operator-(T && lhs, const Z & rhs){
+    return std::move(lhs -= rhs);
+}
+
+template <typename T, typename Z>
+if_expiring_integer <T, Z> operator*(T && lhs, const Z & rhs){
+    return std::move(lhs *= rhs);
+}
+
+template <typename T, typename Z>
+if_expiring_integer <T, Z> operator/(T && lhs, const Z & rhs){
+    return std::move(lhs /= rhs);
+}
+
+template <typename T, typename Z>
+if_expiring_integer <T, Z> operator%(T && lhs, const Z & rhs){
+    return std::move(lhs %= rhs);
+}
+
+template <typename T, typename Z>
+if_expiring_integer <T, Z> operator&(T && lhs, const Z & rhs){
+    return std::move(lhs &= rhs);
+}
+
+template <typename T, typename Z>
+if_expiring_integer <T, Z> operator|(T && lhs, const Z & rhs){
+    return std::move(lhs |= rhs);
+}
+
+template <typename T, typename Z>
+if_expiring_integer <T, Z> operator^(T && lhs, const Z & rhs){
+    return std::move(lhs ^= rhs);
+}
+
+template <typename T, typename Z>
+if_expiring_integer <T, Z> operator<<(T && lhs, const Z & rhs){
+    return std::move(lhs <<= rhs);
+}
+
+template <typename T, typename Z>
+if_expiring_integer <T, Z> operator>>(T && lhs, const Z & rhs){
+    return std::move(lhs >>= rhs);
+}
+
+// an expiring rhs takes the result where the operator commutes, or for -
+// as -(rhs - lhs)
+template <typename L, typename T>
+if_expiring_integer <T, L> operator+(const L & lhs, T && rhs){
+    return std::move(rhs += lhs);
+}
+
+template <typename L, typename T>
+if_expiring_integer <T, L> operator-(const L & lhs, T && rhs){
+    return std::move((rhs -= lhs).negate());
+}
+
+template <typename L, typename T>
+if_expiring_integer <T, L> operator*(const L & lhs, T && rhs){
+    return std::move(rhs *= lhs);
+}
+
+template <typename L, typename T>
+if_expiring_integer <T, L> operator&(const L & lhs, T && rhs){
+    return std::move(rhs &= lhs);
+}
+
+template <typename L, typename T>
+if_expiring_integer <T, L> operator|(const L & lhs, T && rhs){
+    return std::move(rhs |= lhs);
+}
+
+template <typename L, typename T>
+if_expiring_integer <T, L> operator^(const L & lhs, T && rhs){
+    return std::move(rhs ^= lhs);
+}
+
+// both expiring: the longer one, whose digits can hold the result
+template <typename T, typename U>
+if_expiring_integer <T, if_expiring_integer <U, U> > operator+(T && lhs, U && rhs){
+    if (rhs.limb_count() > lhs.limb_count()){
+        return std::move(rhs += lhs);
+    }
+    return std::move(lhs += rhs);
+}
+
+template <typename T, typename U>
+if_expiring_integer <T, if_expiring_integer <U, U> > operator-(T && lhs, U && rhs){
+    if (rhs.limb_count() > lhs.limb_count()){
+        return std::move((rhs -= lhs).negate());
+    }
+    return std::move(lhs -= rhs);
+}
+
+template <typename T, typename U>
+if_expiring_integer <T, if_expiring_integer <U, U> > operator*(T && lhs, U && rhs){
+    if (rhs.limb_count() > lhs.limb_count()){
+        return std::move(rhs *= lhs);
+    }
+    return std::move(lhs *= rhs);
+}
+
+template <typename T, typename U>
+if_expiring_integer <T, if_expiring_integer <U, U> > operator&(T && lhs, U && rhs){
+    if (rhs.limb_count() > lhs.limb_count()){
+        return std::move(rhs &= lhs);
+    }
+    return std::move(lhs &= rhs);
+}
+
+template <typename T, typename U>
+if_expiring_integer <T, if_expiring_integer <U, U> > operator|(T && lhs, U && rhs){
+    if (rhs.limb_count() > lhs.limb_count()){
+        return std::move(rhs |= lhs);
+    }
+    return std::move(lhs |= rhs);
+}
+
+template <typename T, typename U>
+if_expiring_integer <T, if_expiring_integer <U, U> > operator^(T && lhs, U && rhs){
+    if (rhs.limb_count() > lhs.limb_count()){
+        return std::move(rhs ^= lhs);
+    }
+    return std::move(lhs ^= rhs);
+}
+
+template <typename T>
+if_expiring_integer <T, T> operator-(T && value){
+    return std::move(value.negate());
+}
+
+// operators where lhs is not of type integer, only for integral lhs, so that
+// comparisons of other types (iterators, atomics) that convert to integer are
+// not ambiguous with their own operators
 template <typename Z>
+using if_integral = typename std::enable_if <std::is_integral <Z>::value, int>::type;
+
+// Bitwise Operators
+template <typename Z, if_integral <Z> = 0>
 integer operator&(const Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value
             , "Input type must be integral");
     return integer(lhs) & rhs;
 }
 
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 Z & operator&=(Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value &&
                   !std::is_const <Z>::value
@@ -541,14 +1133,14 @@ Z & operator&=(Z & lhs, const integer & rhs){
     return lhs = static_cast <Z> (integer(lhs) & rhs);
 }
 
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 integer operator|(const Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value
             , "Input type must be integral");
     return integer(lhs) | rhs;
 }
 
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 Z & operator|=(Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value &&
                   !std::is_const <Z>::value
@@ -556,14 +1148,14 @@ Z & operator|=(Z & lhs, const integer & rhs){
     return lhs = static_cast <Z> (integer(lhs) | rhs);
 }
 
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 integer operator^(const Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value
             , "Input type must be integral");
     return integer(lhs) ^ rhs;
 }
 
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 Z & operator^=(Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value &&
                   !std::is_const <Z>::value
@@ -582,7 +1174,7 @@ integer operator<<(const int16_t  & lhs, const integer & rhs);
 integer operator<<(const int32_t  & lhs, const integer & rhs);
 integer operator<<(const int64_t  & lhs, const integer & rhs);
 
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 Z & operator<<=(Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value &&
                   !std::is_const <Z>::value
@@ -600,7 +1192,7 @@ integer operator>>(const int16_t  & lhs, const integer & rhs);
 integer operator>>(const int32_t  & lhs, const integer & rhs);
 integer operator>>(const int64_t  & lhs, const integer & rhs);
 
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 Z & operator>>=(Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value &&
                   !std::is_const <Z>::value
@@ -609,42 +1201,42 @@ Z & operator>>=(Z & lhs, const integer & rhs){
 }
 
 // Comparison Operators
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 bool operator==(const Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value
             , "Input type must be integral");
     return (integer(lhs) == rhs);
 }
 
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 bool operator!=(const Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value
             , "Input type must be integral");
     return (integer(lhs) != rhs);
 }
 
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 bool operator>(const Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value
             , "Input type must be integral");
     return (rhs < lhs);
 }
 
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 bool operator>=(const Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value
             , "Input type must be integral");
     return (rhs <= lhs);
 }
 
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 bool operator<(const Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value
             , "Input type must be integral");
     return (rhs > lhs);
 }
 
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 bool operator<=(const Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value
             , "Input type must be integral");
@@ -652,14 +1244,14 @@ bool operator<=(const Z & lhs, const integer & rhs){
 }
 
 // Arithmetic Operators
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 integer operator+(const Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value
             , "Input type must be integral");
     return integer(lhs) + rhs;
 }
 
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 Z & operator+=(Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value &&
                   !std::is_const <Z>::value
@@ -667,14 +1259,14 @@ Z & operator+=(Z & lhs, const integer & rhs){
     return lhs = static_cast <Z> (integer(lhs) + rhs);
 }
 
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 integer operator-(const Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value
             , "Input type must be integral");
     return integer(lhs) - rhs;
 }
 
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 Z & operator-=(Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value &&
                   !std::is_const <Z>::value
@@ -682,14 +1274,14 @@ Z & operator-=(Z & lhs, const integer & rhs){
     return lhs = static_cast <Z> (integer(lhs) - rhs);
 }
 
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 integer operator*(const Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value
             , "Input type must be integral");
     return integer(lhs) * rhs;
 }
 
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 Z & operator*=(Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value &&
                   !std::is_const <Z>::value
@@ -697,14 +1289,14 @@ Z & operator*=(Z & lhs, const integer & rhs){
     return lhs = static_cast <Z> (integer(lhs) * rhs);
 }
 
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 integer operator/(const Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value
             , "Input type must be integral");
     return integer(lhs) / rhs;
 }
 
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 Z & operator/=(Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value &&
                   !std::is_const <Z>::value
@@ -712,14 +1304,14 @@ Z & operator/=(Z & lhs, const integer & rhs){
     return lhs = static_cast <Z> (integer(lhs) / rhs);
 }
 
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 integer operator%(const Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value
             , "Input type must be integral");
     return integer(lhs) % rhs;
 }
 
-template <typename Z>
+template <typename Z, if_integral <Z> = 0>
 Z & operator%=(Z & lhs, const integer & rhs){
     static_assert(std::is_integral <Z>::value &&
                   !std::is_const <Z>::value
@@ -728,9 +1320,33 @@ Z & operator%=(Z & lhs, const integer & rhs){
 }
 
 // IO Operators
+// written straight into the stream buffer: std::oct, std::hex or decimal, with
+// std::showbase, std::showpos, std::uppercase, the width and the adjustment
+// applied as for the built-in integers
 std::ostream & operator<<(std::ostream & stream, const integer & rhs);
+// an optional '-' and the longest run of digits in the stream's base, read
+// straight from the stream buffer; failbit if there are no digits
 std::istream & operator>>(std::istream & stream, integer & rhs);
 
+// std::to_chars_result and std::from_chars_result, with a Status for the errc
+struct to_chars_result {
+    char * ptr;
+    Status status;
+};
+struct from_chars_result {
+    const char * ptr;
+    Status status;
+};
+
+// value in base 2-16 in [first, last), lower case with a leading '-' if it is
+// negative and no terminator: the end of what was written, or last and
+// Status::buffer_too_small if it does not fit (Status::bad_base for other bases)
+to_chars_result to_chars(char * first, char * last, const integer & value, const int base = 10) noexcept;
+// an optional '-' and the longest run of base 2-16 digits at first, either
+// case: the end of the run, or first and Status::bad_digit (value unchanged)
+// if there is none
+from_chars_result from_chars(const char * first, const char * last, integer & value, const int base = 10) noexcept;
+
 // Miscellaneous functions
 std::string makebin  (const integer & value, const unsigned int & size = 1);
 std::string makehex  (const integer & value, const unsigned int & size = 1);
@@ -738,24 +1354,43 @@ std::string makeascii(const integer & value, const unsigned int & size = 1);
 
 integer abs(const integer & value);
 
-// floor(log_b(x))
-template <typename Z>
-integer log(integer value, Z base){
-    static_assert(std::is_integral <Z>::value
-            , "Base type should be a non-negative integer");
-
-    if ((base < 1) || (value <= 0)){
-        throw std::domain_error("Error: Domain error");
-    }
-
-    integer count = 0;
-    while (value){
-        value /= base;
-        count++;
-    }
-    return count;
-}
-
+// greatest common divisor of |a| and |b|, with gcd(0, 0) = 0. Lehmer's
+// algorithm: the Euclid steps that the top two digits decide become one matrix
+// of single-digit cofactors applied to the full values. From INTEGER_HGCD_BITS
+// a half-GCD first finds the steps that halve the values from their top halves,
+// recursively; binary GCD once both fit in a word. Not constant time.
+integer gcd(const integer & a, const integer & b);
+// least common multiple of |a| and |b|, 0 if either is 0
+integer lcm(const integer & a, const integer & b);
+
+// g = gcd(a, b) = a x + b y, with x in [0, |b| / g) when b is not 0
+struct xgcd_result {
+    integer g;
+    integer x;
+    integer y;
+};
+xgcd_result xgcd(const integer & a, const integer & b);
+
+// floor(sqrt(x)); throws std::domain_error if x < 0. Newton's iteration with
+// the precision doubling at each step from a one bit estimate, so the cost is
+// that of a few divisions of the full size rather than one per step.
+integer isqrt(const integer & x);
+// floor(x^(1/k)), toward 0 for an odd root of x < 0; throws std::domain_error
+// if k is 0 or k is even and x < 0. Newton's iteration down from the power of
+// two above the root given by bit_length.
+integer iroot(const integer & x, const unsigned int k);
+// whether x = y^2: squares mod 64, 63, 5, 11, 13 and 17 (from the low digit
+// and one single-digit remainder) turn away more than 99% of other values before isqrt
+bool is_perfect_square(const integer & x);
+// whether x = y^k for some k >= 2 (0, 1 and -1 are); an iroot per prime k up
+// to bit_length
+bool is_perfect_power(const integer & x);
+
+// value^exp, 0 for a negative exp. The factor 2^t of value comes out as one
+// shift of t * exp at the end, so a power-of-two base is no more than that;
+// exponents up to 4 are fixed chains of squarings, and larger ones go left
+// to right, multiplying by the odd part of value alone and never squaring
+// past the result
 template <typename Z>
 integer pow(integer value, Z exp){
     static_assert(std::is_integral <Z>::value
@@ -764,17 +1399,54 @@ integer pow(integer value, Z exp){
     if (exp < 0){
         return 0;
     }
-
-    Z one = 1;
-    integer result = 1;
-    while (exp){
-        if (exp & one){
-            result *= value;
+    if (!exp){
+        return 1;
+    }
+    if (!value){
+        return 0;
+    }
+    const uint64_t e = static_cast <uint64_t> (exp);
+    const bool negative = (value < 0) && (e & 1);
+
+    const integer::limb_span digits = value.limbs();
+    std::size_t low = 0;
+    for(; !digits[low]; low++);
+    const std::size_t t = low * (sizeof(INTEGER_DIGIT_T) << 3) + limb_ctz(digits[low]);
+    integer base = abs(value) >> t;
+
+    integer result;
+    if (base == 1){
+        result = 1;
+    }
+    else if (e == 1){
+        result = base;
+    }
+    else if (e == 2){
+        result = base.square();
+    }
+    else if (e == 3){
+        result = base.square() * base;
+    }
+    else if (e == 4){
+        result = base.square().square();
+    }
+    else{
+        std::size_t top = 63;
+        for(; !((e >> top) & 1); top--);
+        result = base;
+        while (top--){
+            result = result.square();
+            if ((e >> top) & 1){
+                result *= base;
+            }
         }
-        exp >>= one;
-        value *= value;
     }
-
+    if (t){
+        result <<= t * e;
+    }
+    if (negative){
+        result.negate();
+    }
     return result;
 }
 
@@ -802,10 +1474,59 @@ integer pow(integer base, Z_e exponent, const Z_m modulus){
             result = (result * base) % mod;
         }
         exp >>= one;
-        base = (base * base) % mod;
+        base = base.square() % mod;
     }
 
     return result;
 }
 
+// the number of base digits of value, floor(log_b(value)) + 1, without
+// dividing: from bit_length alone for a base that is a power of two, else
+// from the floors of (bit_length - 1) / log2(base) and bit_length / log2(base),
+// which bound it and differ by at most one, so at most a power of the base
+// decides between them
+template <typename Z>
+integer log(const integer & value, Z base){
+    static_assert(std::is_integral <Z>::value
+            , "Base type should be a non-negative integer");
+
+    if ((base < 2) || (value <= 0)){
+        throw std::domain_error("Error: Domain error");
+    }
+
+    const std::size_t bits = value.bit_length();
+    if (!(base & (base - 1))){
+        std::size_t shift = 0;
+        while (base >>= 1){
+            shift++;
+        }
+        return (bits + shift - 1) / shift;
+    }
+
+    // widened past the rounding of the doubles
+    const double r = 1 / std::log2(static_cast <double> (base));
+    std::size_t low  = static_cast <std::size_t> ((bits - 1) * r * (1 - 1e-12));
+    std::size_t high = static_cast <std::size_t> (bits * r * (1 + 1e-12));
+    const integer b = base;
+    while (low < high){
+        const std::size_t mid = high - (high - low) / 2;
+        if (pow(b, mid) <= value){
+            low = mid;
+        }
+        else{
+            high = mid - 1;
+        }
+    }
+    return low + 1;
+}
+
+namespace std {
+template <>
+struct hash <integer> {
+    std::size_t operator()(const integer & value) const {
+        return static_cast <std::size_t> (value.hash(hash_seed()));
+    }
+};
+}
+
 #endif // INTEGER_H
\ No newline at end of file
@@ -0,0 +1,146 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+
+#include "ecdsa.h"
+#include "hash.h"
+#include "key_table_cache.h"
+#include "metrics.h"
+#include "schnorr.h"
+#include "sec1.h"
+
+KeyTableCache::KeyTableCache(std::size_t budget, std::size_t window, std::size_t shards)
+        : shard_count(1), w(window) {
+    if (budget == 0) {
+        throw std::invalid_argument("Key table cache budget must be positive");
+    }
+    if (window < 2 || window > 8) {
+        throw std::invalid_argument("wNAF window must be between 2 and 8");
+    }
+    // a key's tables on secp256k1, both GLV halves
+    const std::size_t table_bytes = (std::size_t(1) << (window - 1)) * sizeof(Point) + sizeof(Entry);
+    while (this->shard_count < shards && budget / (2 * this->shard_count) >= 8 * table_bytes) {
+        this->shard_count <<= 1;
+    }
+    this->shard_budget = budget / this->shard_count;
+    this->shards.reset(new Shard[this->shard_count]);
+}
+
+uint64_t KeyTableCache::KeyHash::wide(const Key& k) {
+    uint64_t words[5] = {reinterpret_cast<uintptr_t>(k.curve) ^ k.encoding[0]};
+    std::memcpy(words + 1, k.encoding.data() + 1, 32);
+    return hash_words(words, 5, hash_seed());
+}
+
+Result<std::shared_ptr<const WnafTable>> KeyTableCache::find(const Key& key, const Point* point) {
+    static Metrics::Counter& hit_count = Metrics::global().counter("ecc_key_table_hits_total",
+                                                                   "verifications with a key's tables cached");
+    static Metrics::Counter& miss_count = Metrics::global().counter("ecc_key_table_misses_total",
+                                                                    "key tables made for KeyTableCache");
+    // the map takes the low bits of the hash, the shard the high ones
+    Shard& s = this->shards[(KeyHash::wide(key) >> 40) & (this->shard_count - 1)];
+    {
+        std::lock_guard<std::mutex> guard(s.lock);
+        const auto it = s.entries.find(key);
+        if (it != s.entries.end()) {
+            s.order.splice(s.order.begin(), s.order, it->second);
+            this->hits.fetch_add(1, std::memory_order_relaxed);
+            hit_count.add();
+            return it->second->table;
+        }
+    }
+
+    // made outside the lock, so a shard is held for map operations only
+    std::optional<Point> decoded;
+    if (!point) {
+        const Result<Point> p = sec1_decode(key.encoding.data(), key.encoding.size(), *key.curve);
+        if (!p) {
+            return p.status() == Status::out_of_range ? Status::bad_encoding : Status::not_on_curve;
+        }
+        point = &decoded.emplace(*p);
+    }
+    std::shared_ptr<const WnafTable> table = std::make_shared<const WnafTable>(point->wnaf_table(this->w));
+    this->misses.fetch_add(1, std::memory_order_relaxed);
+    miss_count.add();
+    const std::size_t bytes = table->memory() + sizeof(Entry);
+    if (bytes > this->shard_budget) {
+        return table;
+    }
+
+    std::lock_guard<std::mutex> guard(s.lock);
+    const auto it = s.entries.find(key);
+    if (it != s.entries.end()) {
+        // made by another thread meanwhile
+        return it->second->table;
+    }
+    while (s.bytes + bytes > this->shard_budget) {
+        s.bytes -= s.order.back().bytes;
+        s.entries.erase(s.order.back().key);
+        s.order.pop_back();
+        this->evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+    s.order.push_front(Entry{key, table, bytes});
+    s.entries.emplace(key, s.order.begin());
+    s.bytes += bytes;
+    return table;
+}
+
+std::shared_ptr<const WnafTable> KeyTableCache::table(const Curve& curve, const Point& public_key) {
+    if (curve.field().bits() > 256 || public_key.is_infinity()
+        || public_key.curve_a() != curve.a() || public_key.curve_b() != curve.b()) {
+        return nullptr;
+    }
+    Key key{&curve, {}};
+    if (!sec1_encode(public_key, true, key.encoding.data(), key.encoding.size())) {
+        return nullptr;
+    }
+    Result<std::shared_ptr<const WnafTable>> table = find(key, &public_key);
+    return table ? *table : nullptr;
+}
+
+Result<std::shared_ptr<const WnafTable>> KeyTableCache::table(const uint8_t* public_key) {
+    Key key{&Curve::secp256k1(), {0x02}};
+    std::memcpy(key.encoding.data() + 1, public_key, 32);
+    return find(key, nullptr);
+}
+
+void KeyTableCache::clear() {
+    for (std::size_t i = 0; i < this->shard_count; i++) {
+        std::lock_guard<std::mutex> guard(this->shards[i].lock);
+        this->shards[i].entries.clear();
+        this->shards[i].order.clear();
+        this->shards[i].bytes = 0;
+    }
+}
+
+KeyTableCache::Stats KeyTableCache::stats() const {
+    Stats out{this->hits.load(std::memory_order_relaxed), this->misses.load(std::memory_order_relaxed),
+              this->evictions.load(std::memory_order_relaxed), 0, 0};
+    for (std::size_t i = 0; i < this->shard_count; i++) {
+        std::lock_guard<std::mutex> guard(this->shards[i].lock);
+        out.entries += this->shards[i].entries.size();
+        out.bytes += this->shards[i].bytes;
+    }
+    return out;
+}
+
+Status ecdsa_verify(const uint8_t* signature, const Curve& curve, const Point& public_key, const uint8_t* hash,
+                    std::size_t len, KeyTableCache& cache) {
+    const std::shared_ptr<const WnafTable> table = cache.table(curve, public_key);
+    if (!table) {
+        return ecdsa_verify(signature, curve, public_key, hash, len);
+    }
+    return ecdsa_verify(signature, curve, *table, hash, len);
+}
+
+Status schnorr_verify(const uint8_t* signature, const uint8_t* message, std::size_t len,
+                      const uint8_t* public_key, KeyTableCache& cache) {
+    const Result<std::shared_ptr<const WnafTable>> table = cache.table(public_key);
+    if (!table) {
+        return schnorr_verify(signature, message, len, public_key);
+    }
+    return schnorr_verify(signature, message, len, public_key, **table);
+}
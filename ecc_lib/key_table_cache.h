@@ -0,0 +1,109 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_KEY_TABLE_CACHE_H
+#define ECC_KEY_TABLE_CACHE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "Curve.h"
+#include "Point.h"
+#include "Status.h"
+
+// The wNAF tables of public keys verified against again and again (exchange
+// wallets, oracles), kept so their verifications skip building them: the odd
+// multiples and their inversion, and for a BIP340 key the square root of
+// lift_x, a quarter to a third of a secp256k1 verification. Opt in by passing
+// the cache to ecdsa_verify or schnorr_verify. A key is held by its curve and
+// compressed SEC1 encoding (a BIP340 key is 0x02 || x), the tables made on a
+// miss and kept within a budget of bytes, split over shards like
+// SignatureCache's, each an LRU list behind its own mutex. Tables are handed
+// out shared, so an eviction never pulls one from a verification using it.
+// Hits and misses count in stats() and in the process's metrics,
+// ecc_key_table_hits_total and ecc_key_table_misses_total.
+class KeyTableCache {
+public:
+    struct Stats {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t evictions;
+        std::size_t entries;
+        std::size_t bytes;
+
+        double hit_rate() const { return this->hits + this->misses ? double(this->hits) / (this->hits + this->misses) : 0; }
+    };
+
+    // tables of window w (2 to 8) in at most budget bytes, in shards rounded
+    // up to a power of two and fewer where a shard would hold under 8 keys'
+    // tables; throws std::invalid_argument for a budget of 0 or a bad window
+    explicit KeyTableCache(std::size_t budget, std::size_t window = 6, std::size_t shards = 16);
+
+    // the tables of public_key, made on a miss; null for a key it does not
+    // take: the point at infinity, another curve's point, or a field of over
+    // 256 bits. A table larger than a shard's budget is made and not kept;
+    // a key that is not normalized costs an inversion to look up
+    std::shared_ptr<const WnafTable> table(const Curve& curve, const Point& public_key);
+    // the tables of the BIP340 key lift_x(public_key); Status::bad_encoding
+    // for x not below p, Status::not_on_curve for an x with no point
+    Result<std::shared_ptr<const WnafTable>> table(const uint8_t* public_key);
+
+    void clear();
+    Stats stats() const;
+    std::size_t budget() const { return this->shard_budget * this->shard_count; }
+    std::size_t window() const { return this->w; }
+
+private:
+    struct Key {
+        const Curve* curve;
+        std::array<uint8_t, 33> encoding;
+
+        bool operator==(const Key& other) const { return this->curve == other.curve && this->encoding == other.encoding; }
+    };
+    struct KeyHash {
+        // 64 bits on every target, std::size_t or not: the map takes the low
+        // bits, the shard the high ones
+        static uint64_t wide(const Key& k);
+        std::size_t operator()(const Key& k) const { return static_cast<std::size_t>(wide(k)); }
+    };
+    struct Entry {
+        Key key;
+        std::shared_ptr<const WnafTable> table;
+        std::size_t bytes;
+    };
+    struct Shard {
+        std::mutex lock;
+        std::list<Entry> order;     // most recent first
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> entries;
+        std::size_t bytes = 0;
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    std::size_t shard_count;
+    std::size_t shard_budget;
+    std::size_t w;
+    std::atomic<uint64_t> hits{0}, misses{0}, evictions{0};
+
+    // the tables of key, from point or, when null, from decoding the key
+    Result<std::shared_ptr<const WnafTable>> find(const Key& key, const Point* point);
+};
+
+// ecdsa_verify with public_key's tables from cache and G's from
+// Curve::generator_wnaf; a key the cache does not take goes to ecdsa_verify.
+// Not noexcept: a miss allocates the tables, and may throw std::bad_alloc
+Status ecdsa_verify(const uint8_t* signature, const Curve& curve, const Point& public_key, const uint8_t* hash,
+                    std::size_t len, KeyTableCache& cache);
+
+// schnorr_verify in the same way; a key with no point goes to schnorr_verify
+// for its status
+Status schnorr_verify(const uint8_t* signature, const uint8_t* message, std::size_t len,
+                      const uint8_t* public_key, KeyTableCache& cache);
+
+#endif //ECC_KEY_TABLE_CACHE_H
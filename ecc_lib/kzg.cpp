@@ -0,0 +1,295 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "chacha20.h"
+#include "Curve.h"
+#include "FixedBaseTable.h"
+#include "kzg.h"
+#include "sha256.h"
+#include "Status.h"
+
+namespace {
+
+const char MAGIC[8] = {'E', 'C', 'C', 'K', 'Z', 'G', '\0', '\0'};
+constexpr uint32_t VERSION = 1;
+constexpr std::size_t HEADER_SIZE = 32;
+// bytes of a coordinate of Fp, of a G1 point and of a G2 point
+constexpr std::size_t FP_SIZE = 48;
+constexpr std::size_t G1_SIZE = 2 * FP_SIZE;
+constexpr std::size_t G2_SIZE = 4 * FP_SIZE;
+
+void put_le(uint8_t* out, uint64_t v, std::size_t len) {
+    for (std::size_t i = 0; i < len; i++) {
+        out[i] = static_cast<uint8_t>(v >> (8 * i));
+    }
+}
+
+uint64_t get_le(const uint8_t* in, std::size_t len) {
+    uint64_t v = 0;
+    for (std::size_t i = len; i > 0; i--) {
+        v = (v << 8) | in[i - 1];
+    }
+    return v;
+}
+
+// the whole file, mapped read-only where there is mmap, and read into memory elsewhere
+std::shared_ptr<const uint8_t> map_file(const std::string& path, std::size_t& bytes) {
+#if defined(__unix__) || defined(__APPLE__)
+    const int fd = open(path.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || st.st_size <= 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        throw std::runtime_error("Cannot read setup file " + path);
+    }
+    const std::size_t size = static_cast<std::size_t>(st.st_size);
+    void* map = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        throw std::runtime_error("Cannot map setup file " + path);
+    }
+    madvise(map, size, MADV_SEQUENTIAL);
+    bytes = size;
+    return std::shared_ptr<const uint8_t>(static_cast<const uint8_t*>(map),
+                                          [size](const uint8_t* p) { munmap(const_cast<uint8_t*>(p), size); });
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("Cannot read setup file " + path);
+    }
+    bytes = static_cast<std::size_t>(in.tellg());
+    std::shared_ptr<uint8_t> data(new uint8_t[bytes + 1], std::default_delete<uint8_t[]>());
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(data.get()), static_cast<std::streamsize>(bytes));
+    if (!in) {
+        throw std::runtime_error("Cannot read setup file " + path);
+    }
+    return data;
+#endif
+}
+
+FieldElement fp(const uint8_t* in) {
+    const Result<FieldElement> v = FieldElement::from_bytes(in, FP_SIZE, Curve::bls12_381().field());
+    if (!v) {
+        throw std::invalid_argument("Setup coordinate is not below the prime");
+    }
+    return *v;
+}
+
+void check_scalar(const FieldElement& v) {
+    if (&v.prime_field() != &KzgSetup::scalar_field()) {
+        throw_status(Status::field_mismatch, "KZG scalars must be elements of the BLS12-381 group order");
+    }
+}
+
+// the affine coordinates of p into a hash, nothing for infinity
+void absorb(Sha256& hash, const Point& p) {
+    if (p.is_infinity()) {
+        return;
+    }
+    uint8_t bytes[G1_SIZE];
+    const std::pair<FieldElement, FieldElement> xy = p.affine();
+    xy.first.to_bytes(bytes, FP_SIZE);
+    xy.second.to_bytes(bytes + FP_SIZE, FP_SIZE);
+    hash.update(bytes, sizeof(bytes));
+}
+
+}
+
+const PrimeField& KzgSetup::scalar_field() {
+    return Curve::bls12_381().scalar_field();
+}
+
+KzgSetup::KzgSetup(std::vector<Point> powers, const G2Point& tau_g2, unsigned threads)
+        : g1(std::move(powers)), tau(tau_g2),
+          msm(this->g1.empty() ? std::vector<Point>(1, Curve::bls12_381().generator()) : this->g1,
+              Curve::bls12_381().n().bit_length(), 0, threads) {
+    if (this->g1.empty()) {
+        throw std::invalid_argument("KZG setup needs at least one power of tau");
+    }
+    for (const Point& p : this->g1) {
+        if (p.is_infinity() || Curve::of(p) != &Curve::bls12_381()) {
+            throw std::invalid_argument("KZG setup powers must be finite points of BLS12-381 G1");
+        }
+    }
+}
+
+KzgSetup KzgSetup::insecure(const integer& tau, std::size_t size, unsigned threads) {
+    const Curve& curve = Curve::bls12_381();
+    const FieldElement t(tau, curve.scalar_field());
+    std::vector<Point> powers;
+    powers.reserve(size);
+    FieldElement ti(1, curve.scalar_field());
+    for (std::size_t i = 0; i < size; i++) {
+        powers.push_back(curve.generator_table().mul(ti.value()));
+        ti *= t;
+    }
+    Point::batch_normalize(powers);
+    return KzgSetup(std::move(powers), G2Point::generator().mul(t.value()), threads);
+}
+
+void KzgSetup::save(const std::string& path) const {
+    std::vector<uint8_t> file(HEADER_SIZE + G2_SIZE + G1_SIZE * this->g1.size(), 0);
+    uint8_t* h = file.data();
+    std::memcpy(h, MAGIC, sizeof(MAGIC));
+    put_le(h + 8, VERSION, 4);
+    put_le(h + 16, this->g1.size(), 8);
+    uint8_t* p = h + HEADER_SIZE;
+    const std::pair<Fp2, Fp2> t = this->tau.affine();
+    for (const FieldElement* v : {&t.first.c0(), &t.first.c1(), &t.second.c0(), &t.second.c1()}) {
+        v->to_bytes(p, FP_SIZE);
+        p += FP_SIZE;
+    }
+    for (const Point& g : this->g1) {
+        const std::pair<FieldElement, FieldElement> xy = g.affine();
+        xy.first.to_bytes(p, FP_SIZE);
+        xy.second.to_bytes(p + FP_SIZE, FP_SIZE);
+        p += G1_SIZE;
+    }
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+    if (!out) {
+        throw std::runtime_error("Cannot write setup file " + path);
+    }
+}
+
+KzgSetup KzgSetup::load(const std::string& path, unsigned threads) {
+    std::size_t bytes = 0;
+    const std::shared_ptr<const uint8_t> file = map_file(path, bytes);
+    const uint8_t* h = file.get();
+    if (bytes < HEADER_SIZE || std::memcmp(h, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("Not a KZG setup file: " + path);
+    }
+    if (get_le(h + 8, 4) != VERSION) {
+        throw std::runtime_error("Unsupported KZG setup file version in " + path);
+    }
+    const uint64_t count = get_le(h + 16, 8);
+    if (count == 0 || bytes < HEADER_SIZE + G2_SIZE || (bytes - HEADER_SIZE - G2_SIZE) % G1_SIZE != 0 ||
+        (bytes - HEADER_SIZE - G2_SIZE) / G1_SIZE != count) {
+        throw std::runtime_error("Corrupt KZG setup file " + path);
+    }
+    const Curve& curve = Curve::bls12_381();
+    const uint8_t* p = h + HEADER_SIZE;
+    const G2Point tau(Fp2(fp(p), fp(p + FP_SIZE)), Fp2(fp(p + 2 * FP_SIZE), fp(p + 3 * FP_SIZE)));
+    p += G2_SIZE;
+    std::vector<Point> powers;
+    powers.reserve(count);
+    for (uint64_t i = 0; i < count; i++, p += G1_SIZE) {
+        powers.emplace_back(fp(p), fp(p + FP_SIZE), curve.a(), curve.b());
+    }
+    return KzgSetup(std::move(powers), tau, threads);
+}
+
+Point KzgSetup::commit(const Polynomial& p, unsigned threads) const {
+    if (&p.prime_field() != &scalar_field()) {
+        throw_status(Status::field_mismatch, "KZG commits to polynomials over the BLS12-381 group order");
+    }
+    if (p.degree() >= static_cast<long>(size())) {
+        throw std::invalid_argument("Polynomial degree is beyond the KZG setup");
+    }
+    if (p.is_zero()) {
+        return Curve::bls12_381().infinity();
+    }
+    std::vector<integer> scalars;
+    scalars.reserve(p.coefficients().size());
+    for (const FieldElement& c : p.coefficients()) {
+        scalars.push_back(c.value());
+    }
+    return this->msm.mul(scalars, threads);
+}
+
+KzgClaim KzgSetup::open(const Polynomial& p, const FieldElement& z, unsigned threads) const {
+    check_scalar(z);
+    if (&p.prime_field() != &scalar_field()) {
+        throw_status(Status::field_mismatch, "KZG commits to polynomials over the BLS12-381 group order");
+    }
+    // (p - p(z)) / (x - z) from the top: q_(i - 1) = p_i + z q_i, and the
+    // last step's value is p(z)
+    const std::vector<FieldElement>& c = p.coefficients();
+    std::vector<FieldElement> q(c.size() > 1 ? c.size() - 1 : 0, FieldElement(0, scalar_field()));
+    FieldElement y(0, scalar_field());
+    for (std::size_t i = c.size(); i-- > 0;) {
+        y *= z;
+        y += c[i];
+        if (i > 0) {
+            q[i - 1] = y;
+        }
+    }
+    const Polynomial quotient(scalar_field(), std::move(q));
+    return {commit(p, threads), z, y, commit(quotient, threads)};
+}
+
+bool KzgSetup::verify(const KzgClaim& claim) const {
+    check_scalar(claim.z);
+    check_scalar(claim.y);
+    const Curve& curve = Curve::bls12_381();
+    const Point p[2] = {claim.commitment - curve.generator_table().mul(claim.y.value()) +
+                        claim.proof.mul(claim.z.value()), -claim.proof};
+    const G2Point q[2] = {G2Point::generator(), this->tau};
+    return bls12_381_pairing_check(p, q, 2);
+}
+
+bool KzgSetup::verify_batch(const std::vector<KzgClaim>& claims, unsigned threads) const {
+    if (claims.empty()) {
+        return true;
+    }
+    const Curve& curve = Curve::bls12_381();
+    Sha256 seed_hash;
+    std::random_device device;
+    for (std::size_t i = 0; i < 8; i++) {
+        const uint32_t word = device();
+        const uint8_t bytes[4] = {static_cast<uint8_t>(word), static_cast<uint8_t>(word >> 8),
+                                  static_cast<uint8_t>(word >> 16), static_cast<uint8_t>(word >> 24)};
+        seed_hash.update(bytes, 4);
+    }
+    for (const KzgClaim& c : claims) {
+        check_scalar(c.z);
+        check_scalar(c.y);
+        uint8_t zy[64];
+        c.z.to_bytes(zy, 32);
+        c.y.to_bytes(zy + 32, 32);
+        seed_hash.update(zy, sizeof(zy));
+        absorb(seed_hash, c.commitment);
+        absorb(seed_hash, c.proof);
+    }
+    uint8_t seed[Sha256::DIGEST_SIZE];
+    seed_hash.finish(seed);
+    ChaCha20Rng rng(seed);
+
+    // sum r_i C_i + sum r_i z_i proof_i - (sum r_i y_i) G, and sum r_i proof_i
+    std::vector<integer> lhs_scalars, proof_scalars;
+    std::vector<Point> lhs_points, proofs;
+    FieldElement ry(0, scalar_field());
+    for (const KzgClaim& c : claims) {
+        uint8_t bytes[16];
+        rng.fill(bytes, sizeof(bytes));
+        const FieldElement r(integer::from_bytes(bytes, sizeof(bytes)), scalar_field());
+        lhs_scalars.push_back(r.value());
+        lhs_points.push_back(c.commitment);
+        lhs_scalars.push_back((r * c.z).value());
+        lhs_points.push_back(c.proof);
+        ry += r * c.y;
+        proof_scalars.push_back(r.value());
+        proofs.push_back(c.proof);
+    }
+    lhs_scalars.push_back(-ry.value());
+    lhs_points.push_back(curve.generator());
+    const Point p[2] = {multi_scalar_mul(lhs_scalars, lhs_points, threads),
+                        -multi_scalar_mul(proof_scalars, proofs, threads)};
+    const G2Point q[2] = {G2Point::generator(), this->tau};
+    return bls12_381_pairing_check(p, q, 2);
+}
@@ -0,0 +1,88 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_KZG_H
+#define ECC_KZG_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "bls12_381.h"
+#include "FieldElement.h"
+#include "integer.h"
+#include "msm.h"
+#include "Point.h"
+#include "Polynomial.h"
+
+// An evaluation p(z) = y claimed for the polynomial behind commitment, with
+// its proof, the commitment to (p - y) / (x - z)
+struct KzgClaim {
+    Point commitment;
+    FieldElement z;
+    FieldElement y;
+    Point proof;
+};
+
+// KZG polynomial commitments over BLS12-381 (Kate, Zaverucha and Goldberg,
+// "Constant-Size Commitments to Polynomials and Their Applications",
+// ASIACRYPT 2010). A setup is the powers [tau^i] G1 for i < size() and
+// [tau] G2 of a secret tau nobody knows; polynomials of degree below size()
+// over the group order r (Curve::bls12_381().scalar_field()) commit to
+// sum p_i [tau^i] G1 = [p(tau)] G1, through a FixedBaseMsm built over the
+// powers when the setup is. Not constant time; nothing here is secret.
+//
+// The setup file is a 32-byte header, little-endian: "ECCKZG\0\0", the version
+// (u32), four zero bytes, the number of G1 powers (u64) and eight zero bytes;
+// then [tau] G2 as x.c0, x.c1, y.c0, y.c1 and every [tau^i] G1 as x, y, each
+// coordinate 48 bytes big-endian. load() maps it read-only (reads it where
+// there is no mmap) and checks every point is on its curve; whether the
+// points are in their subgroups and really powers of one tau is the
+// ceremony's business, not checked here.
+class KzgSetup {
+public:
+    // throws std::invalid_argument for no powers, or powers not of
+    // Curve::bls12_381() or at infinity. The fixed-base tables are built on
+    // threads threads
+    KzgSetup(std::vector<Point> powers, const G2Point& tau_g2, unsigned threads = 1);
+    // the setup of a known tau, for tests and benchmarks: anyone knowing tau
+    // can open a commitment to any value
+    static KzgSetup insecure(const integer& tau, std::size_t size, unsigned threads = 1);
+    // throws std::runtime_error if the file cannot be read, is not a setup
+    // file of this version or has the wrong size, std::invalid_argument for a
+    // point off its curve
+    static KzgSetup load(const std::string& path, unsigned threads = 1);
+    // throws std::runtime_error if the file cannot be written
+    void save(const std::string& path) const;
+
+    std::size_t size() const { return this->g1.size(); }
+    const std::vector<Point>& powers() const { return this->g1; }
+    const G2Point& tau_g2() const { return this->tau; }
+    // the field of the polynomials, the scalars mod r
+    static const PrimeField& scalar_field();
+
+    // [p(tau)] G1; throws std::invalid_argument for p of degree size() or
+    // more, std::runtime_error for p over another field
+    Point commit(const Polynomial& p, unsigned threads = 1) const;
+    // p(z) and the commitment to (p - p(z)) / (x - z), its quotient by
+    // synthetic division; throws as commit
+    KzgClaim open(const Polynomial& p, const FieldElement& z, unsigned threads = 1) const;
+    // e(C - [y] G1 + [z] proof, G2) e(-proof, [tau] G2) = 1, which holds when
+    // C - [y] G1 = [tau - z] proof: one pairing check of two pairs
+    bool verify(const KzgClaim& claim) const;
+    // every claim at once: with random 128-bit r_i, the check of verify for
+    // sum r_i (C_i - [y_i] G1 + [z_i] proof_i) and sum r_i proof_i, two
+    // multi-scalar multiplications and one pairing check of two pairs however
+    // many claims there are. The r_i are the ChaCha20Rng stream of a seed hashed
+    // from std::random_device and the claims, so a batch with a false claim
+    // passes with probability 2^-128; true for no claims
+    bool verify_batch(const std::vector<KzgClaim>& claims, unsigned threads = 1) const;
+
+private:
+    std::vector<Point> g1;
+    G2Point tau;
+    FixedBaseMsm msm;
+};
+
+#endif //ECC_KZG_H
@@ -0,0 +1,118 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_LIMB_H
+#define ECC_LIMB_H
+
+#include <cstdint>
+
+// 64-bit limb primitives shared by the fixed-width and field arithmetic kernels.
+// Each one is a single carry-chain step; compilers turn them into adc/sbb/mul.
+// The carry-chain steps are constexpr, so tables can be built at compile time.
+
+typedef uint64_t limb_t;
+
+// a + b + carry, carry in and out is 0 or 1
+constexpr limb_t limb_addc(limb_t a, limb_t b, limb_t & carry) {
+    const limb_t s = a + b;
+    const limb_t out = s + carry;
+    carry = (s < a) | (out < s);
+    return out;
+}
+
+// a - b - borrow, borrow in and out is 0 or 1
+constexpr limb_t limb_subb(limb_t a, limb_t b, limb_t & borrow) {
+    const limb_t d = a - b;
+    const limb_t out = d - borrow;
+    borrow = (a < b) | (d < borrow);
+    return out;
+}
+
+// full 64x64 -> 128 bit product, returns the low half
+constexpr limb_t limb_mul(limb_t a, limb_t b, limb_t & hi) {
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 p = static_cast <unsigned __int128> (a) * b;
+    hi = static_cast <limb_t> (p >> 64);
+    return static_cast <limb_t> (p);
+#else
+    const limb_t a0 = a & 0xffffffff, a1 = a >> 32;
+    const limb_t b0 = b & 0xffffffff, b1 = b >> 32;
+    const limb_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    const limb_t mid = (p00 >> 32) + (p01 & 0xffffffff) + (p10 & 0xffffffff);
+    hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    return (mid << 32) | (p00 & 0xffffffff);
+#endif
+}
+
+// a * b + c + carry, returns the low half and leaves the high half in carry
+// (cannot overflow: (2^64 - 1)^2 + 2 * (2^64 - 1) = 2^128 - 1)
+constexpr limb_t limb_mac(limb_t a, limb_t b, limb_t c, limb_t & carry) {
+    limb_t hi = 0;
+    limb_t lo = limb_mul(a, b, hi);
+    limb_t k = 0;
+    lo = limb_addc(lo, c, k);
+    hi += k;
+    k = 0;
+    lo = limb_addc(lo, carry, k);
+    carry = hi + k;
+    return lo;
+}
+
+// number of trailing zero bits of a non-zero a
+inline unsigned limb_ctz(limb_t a) {
+#if defined(__GNUC__)
+    return static_cast <unsigned> (__builtin_ctzll(a));
+#else
+    unsigned z = 0;
+    for (; !(a & 1); a >>= 1) {
+        z++;
+    }
+    return z;
+#endif
+}
+
+// t times the Jacobi symbol (a / n) for odd n, in variable time. Binary
+// reduction: factors of two come out with (2 / n) = -1 exactly when
+// n = 3, 5 (mod 8), and the larger odd value is reduced by the smaller after a
+// swap, which flips the sign when both are 3 (mod 4) (quadratic reciprocity).
+inline int limb_jacobi(limb_t a, limb_t n, int t) {
+    while (a) {
+        const unsigned z = limb_ctz(a);
+        a >>= z;
+        if ((z & 1) && (((n >> 1) ^ (n >> 2)) & 1)) {
+            t = -t;
+        }
+        if (a < n) {
+            if (a & n & 2) {
+                t = -t;
+            }
+            const limb_t s = a;
+            a = n;
+            n = s;
+        }
+        a -= n;
+    }
+    return (n == 1) ? t : 0;
+}
+
+// gcd(a, b) by Stein's binary algorithm, in variable time
+inline limb_t limb_gcd(limb_t a, limb_t b) {
+    if (!a || !b) {
+        return a | b;
+    }
+    const unsigned shift = limb_ctz(a | b);
+    a >>= limb_ctz(a);
+    while (b) {
+        b >>= limb_ctz(b);
+        if (a > b) {
+            const limb_t t = a;
+            a = b;
+            b = t;
+        }
+        b -= a;
+    }
+    return a << shift;
+}
+
+#endif //ECC_LIMB_H
@@ -0,0 +1,246 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "merkle.h"
+#include "sha256.h"
+
+namespace {
+
+// levels of a subtree task: MERKLE_SUBTREE = 2^SUBTREE_LEVELS
+constexpr std::size_t SUBTREE_LEVELS = 12;
+static_assert(std::size_t(1) << SUBTREE_LEVELS == MERKLE_SUBTREE, "MERKLE_SUBTREE is 2^SUBTREE_LEVELS");
+
+// the multi-buffer kernel for count messages, or null (one SHA-NI or portable
+// hash at a time) for fewer than it has lanes
+const Sha256MultiBuffer* kernel_for(std::size_t count) {
+    const Sha256MultiBuffer* kernel = sha256_multi_buffer();
+    return kernel && count >= kernel->lanes ? kernel : nullptr;
+}
+
+// the ceil(count / 2) parents of the count nodes at in, at out, the last node
+// of an odd count paired with itself. out may be in: parent i is written only
+// after children 2i and 2i + 1 are read
+void hash_level(uint8_t* out, const uint8_t* in, std::size_t count) {
+    const std::size_t pairs = count / 2;
+    sha256d_64(out, in, pairs, kernel_for(pairs));
+    if (count % 2) {
+        uint8_t last[64];
+        std::memcpy(last, in + 32 * (count - 1), 32);
+        std::memcpy(last + 32, last, 32);
+        sha256d_64(out + 32 * pairs, last, 1, nullptr);
+    }
+}
+
+// levels above count nodes to one
+std::size_t height(std::size_t count) {
+    std::size_t h = 0;
+    while ((std::size_t(1) << h) < count) {
+        h++;
+    }
+    return h;
+}
+
+// the root of count > 0 nodes, the levels reduced in one buffer
+void reduce(uint8_t* root, const uint8_t* nodes, std::size_t count) {
+    if (count == 1) {
+        std::memcpy(root, nodes, 32);
+        return;
+    }
+    std::vector<uint8_t> level(32 * ((count + 1) / 2));
+    hash_level(level.data(), nodes, count);
+    for (count = (count + 1) / 2; count > 1; count = (count + 1) / 2) {
+        hash_level(level.data(), level.data(), count);
+    }
+    std::memcpy(root, level.data(), 32);
+}
+
+// the root of the last subtree, of count leaves, carried from its own height
+// to a full subtree's: alone on its level, it is paired with itself each time
+void lift(uint8_t* root, std::size_t count) {
+    for (std::size_t h = height(count); h < SUBTREE_LEVELS; h++) {
+        hash_level(root, root, 1);
+    }
+}
+
+}
+
+void merkle_root(uint8_t* root, const uint8_t* leaves, std::size_t count, unsigned threads) {
+    ThreadExecutor executor(threads);
+    merkle_root(root, leaves, count, executor);
+}
+
+void merkle_root(uint8_t* root, const uint8_t* leaves, std::size_t count, Executor& executor) {
+    if (count == 0) {
+        std::memset(root, 0, 32);
+        return;
+    }
+    if (count <= MERKLE_SUBTREE || executor.concurrency() == 1) {
+        reduce(root, leaves, count);
+        return;
+    }
+    const std::size_t subtrees = (count + MERKLE_SUBTREE - 1) / MERKLE_SUBTREE;
+    std::vector<uint8_t> roots(32 * subtrees);
+    executor.run(subtrees, [&](std::size_t t) {
+        const std::size_t n = std::min(MERKLE_SUBTREE, count - t * MERKLE_SUBTREE);
+        reduce(&roots[32 * t], leaves + 32 * t * MERKLE_SUBTREE, n);
+        lift(&roots[32 * t], n);
+    });
+    reduce(root, roots.data(), subtrees);
+}
+
+void merkle_branch_root(uint8_t* root, const uint8_t* leaf, std::size_t index, const uint8_t* branch,
+                        std::size_t depth) {
+    uint8_t pair[64];
+    std::memcpy(root, leaf, 32);
+    for (std::size_t h = 0; h < depth; h++, index >>= 1) {
+        std::memcpy(pair + (index & 1 ? 32 : 0), root, 32);
+        std::memcpy(pair + (index & 1 ? 0 : 32), branch + 32 * h, 32);
+        sha256d_64(root, pair, 1, nullptr);
+    }
+}
+
+MerkleTree::MerkleTree(const uint8_t* leaves, std::size_t count, unsigned threads) {
+    ThreadExecutor executor(threads);
+    build(leaves, count, executor);
+}
+
+MerkleTree::MerkleTree(const uint8_t* leaves, std::size_t count, Executor& executor) {
+    build(leaves, count, executor);
+}
+
+void MerkleTree::build(const uint8_t* leaves, std::size_t count, Executor& executor) {
+    this->levels.emplace_back(leaves, leaves + 32 * count);
+    for (std::size_t n = count; n > 1; n = (n + 1) / 2) {
+        this->levels.emplace_back(32 * ((n + 1) / 2));
+    }
+
+    // the lower levels subtree by subtree, one per task: a subtree starts at
+    // an even index on every level below its root, so its pairs are its own
+    const std::size_t low = std::min(SUBTREE_LEVELS, depth());
+    const std::size_t subtrees = (count + MERKLE_SUBTREE - 1) / MERKLE_SUBTREE;
+    const auto subtree = [&](std::size_t t) {
+        for (std::size_t h = 0; h < low; h++) {
+            const std::size_t n = this->levels[h].size() / 32;
+            const std::size_t begin = (t * MERKLE_SUBTREE) >> h;
+            const std::size_t end = std::min(((t + 1) * MERKLE_SUBTREE) >> h, n);
+            hash_level(this->levels[h + 1].data() + 32 * (begin / 2), this->levels[h].data() + 32 * begin,
+                       end - begin);
+        }
+    };
+    if (subtrees > 1 && executor.concurrency() > 1) {
+        executor.run(subtrees, subtree);
+    } else {
+        for (std::size_t t = 0; t < subtrees; t++) {
+            subtree(t);
+        }
+    }
+    for (std::size_t h = low; h < depth(); h++) {
+        hash_level(this->levels[h + 1].data(), this->levels[h].data(), this->levels[h].size() / 32);
+    }
+}
+
+void MerkleTree::root(uint8_t* out) const {
+    if (size() == 0) {
+        std::memset(out, 0, 32);
+    } else {
+        std::memcpy(out, this->levels.back().data(), 32);
+    }
+}
+
+void MerkleTree::update(std::size_t i, const uint8_t* leaf) {
+    update(std::vector<std::size_t>{i}, leaf);
+}
+
+void MerkleTree::update(const std::vector<std::size_t>& indices, const uint8_t* leaves) {
+    for (std::size_t i : indices) {
+        if (i >= size()) {
+            throw std::out_of_range("Merkle leaf index out of range");
+        }
+    }
+    for (std::size_t k = 0; k < indices.size(); k++) {
+        std::memcpy(this->levels[0].data() + 32 * indices[k], leaves + 32 * k, 32);
+    }
+
+    // the parents of the changed nodes, every level's hashed together
+    std::vector<std::size_t> dirty(indices);
+    std::vector<uint8_t> children, parents;
+    for (std::size_t h = 0; h < depth(); h++) {
+        for (std::size_t& i : dirty) {
+            i >>= 1;
+        }
+        std::sort(dirty.begin(), dirty.end());
+        dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+        const std::vector<uint8_t>& level = this->levels[h];
+        const std::size_t n = level.size() / 32;
+        children.resize(64 * dirty.size());
+        parents.resize(32 * dirty.size());
+        for (std::size_t k = 0; k < dirty.size(); k++) {
+            const std::size_t left = 2 * dirty[k], right = left + 1 < n ? left + 1 : left;
+            std::memcpy(&children[64 * k], level.data() + 32 * left, 32);
+            std::memcpy(&children[64 * k + 32], level.data() + 32 * right, 32);
+        }
+        sha256d_64(parents.data(), children.data(), dirty.size(), kernel_for(dirty.size()));
+        for (std::size_t k = 0; k < dirty.size(); k++) {
+            std::memcpy(this->levels[h + 1].data() + 32 * dirty[k], &parents[32 * k], 32);
+        }
+    }
+}
+
+std::vector<uint8_t> MerkleTree::branch(std::size_t i) const {
+    if (i >= size()) {
+        throw std::out_of_range("Merkle leaf index out of range");
+    }
+    std::vector<uint8_t> out(32 * depth());
+    for (std::size_t h = 0; h < depth(); h++, i >>= 1) {
+        const std::size_t sibling = (i ^ 1) < this->levels[h].size() / 32 ? i ^ 1 : i;
+        std::memcpy(&out[32 * h], this->levels[h].data() + 32 * sibling, 32);
+    }
+    return out;
+}
+
+MerkleStream::MerkleStream() : count(0) {
+    this->pending.reserve(32 * MERKLE_SUBTREE);
+}
+
+void MerkleStream::add(const uint8_t* leaf) {
+    add(leaf, 1);
+}
+
+void MerkleStream::add(const uint8_t* leaves, std::size_t count) {
+    while (count) {
+        const std::size_t room = MERKLE_SUBTREE - this->pending.size() / 32;
+        const std::size_t take = std::min(room, count);
+        this->pending.insert(this->pending.end(), leaves, leaves + 32 * take);
+        leaves += 32 * take;
+        count -= take;
+        this->count += take;
+        if (this->pending.size() == 32 * MERKLE_SUBTREE) {
+            this->subtrees.resize(this->subtrees.size() + 32);
+            reduce(&this->subtrees[this->subtrees.size() - 32], this->pending.data(), MERKLE_SUBTREE);
+            this->pending.clear();
+        }
+    }
+}
+
+void MerkleStream::root(uint8_t* out) const {
+    if (this->count == 0) {
+        std::memset(out, 0, 32);
+        return;
+    }
+    const std::size_t waiting = this->pending.size() / 32;
+    if (this->subtrees.empty()) {
+        reduce(out, this->pending.data(), waiting);
+        return;
+    }
+    std::vector<uint8_t> roots(this->subtrees);
+    if (waiting) {
+        roots.resize(roots.size() + 32);
+        reduce(&roots[roots.size() - 32], this->pending.data(), waiting);
+        lift(&roots[roots.size() - 32], waiting);
+    }
+    reduce(out, roots.data(), roots.size() / 32);
+}
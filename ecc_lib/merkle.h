@@ -0,0 +1,89 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_MERKLE_H
+#define ECC_MERKLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Executor.h"
+
+// Bitcoin's Merkle trees of 32-byte leaves (txids in their internal byte
+// order): a parent is SHA-256d of its two children, a level of odd length
+// pairs its last node with itself, and the root of one leaf is the leaf. A
+// level's parents are hashed by sha256d_64, across the lanes of the
+// multi-buffer kernel, and large trees are cut into subtrees of
+// MERKLE_SUBTREE leaves built one per task of an executor, the levels above
+// them after. The root of no leaves is 32 zero bytes. Like Bitcoin's
+// ComputeMerkleRoot, these do not look for the duplicated subtrees of
+// CVE-2012-2459; callers checking blocks compare the transactions.
+
+// leaves per subtree task, a power of two
+constexpr std::size_t MERKLE_SUBTREE = 4096;
+
+// the root of the count leaves at leaves[32 i, 32 (i + 1)) in root[0, 32)
+void merkle_root(uint8_t* root, const uint8_t* leaves, std::size_t count, Executor& executor);
+void merkle_root(uint8_t* root, const uint8_t* leaves, std::size_t count, unsigned threads = 1);
+
+// the root that branch, depth 32-byte siblings from the leaf up, proves for
+// leaf at index, in root[0, 32): what MerkleTree::branch gives checked
+void merkle_branch_root(uint8_t* root, const uint8_t* leaf, std::size_t index, const uint8_t* branch,
+                        std::size_t depth);
+
+// A whole tree kept level by level, for block templates that change a few
+// leaves (the coinbase, mostly) between roots: update() rehashes only the
+// parents above the changed leaves, one sha256d_64 call per level for all of
+// them, so one leaf costs depth() hashes.
+class MerkleTree {
+public:
+    MerkleTree(const uint8_t* leaves, std::size_t count, Executor& executor);
+    explicit MerkleTree(const uint8_t* leaves = nullptr, std::size_t count = 0, unsigned threads = 1);
+
+    std::size_t size() const { return this->levels[0].size() / 32; }
+    // the levels above the leaves, 0 for a tree of one leaf or none
+    std::size_t depth() const { return this->levels.size() - 1; }
+    void root(uint8_t* out) const;
+    const uint8_t* leaf(std::size_t i) const { return this->levels[0].data() + 32 * i; }
+
+    // leaf i becomes leaf[0, 32); throws std::out_of_range for i >= size()
+    void update(std::size_t i, const uint8_t* leaf);
+    // leaf indices[k] becomes leaves[32 k, 32 (k + 1)) for every k, a later
+    // one winning for an index given twice; throws std::out_of_range for an
+    // index not below size()
+    void update(const std::vector<std::size_t>& indices, const uint8_t* leaves);
+
+    // the depth() siblings of leaf i from the bottom up, 32 bytes each, the
+    // node itself where it has none; throws std::out_of_range for i >= size()
+    std::vector<uint8_t> branch(std::size_t i) const;
+
+private:
+    // level 0 the leaves, the last level the root
+    std::vector<std::vector<uint8_t>> levels;
+
+    void build(const uint8_t* leaves, std::size_t count, Executor& executor);
+};
+
+// The root of leaves given one at a time, without keeping them: every
+// MERKLE_SUBTREE leaves are folded into their subtree's root as they fill,
+// so memory is one subtree and a root per subtree before it.
+class MerkleStream {
+public:
+    MerkleStream();
+
+    void add(const uint8_t* leaf);
+    // the count leaves at leaves[32 i, 32 (i + 1))
+    void add(const uint8_t* leaves, std::size_t count);
+    uint64_t size() const { return this->count; }
+    // the root of the leaves so far; more can be added after
+    void root(uint8_t* out) const;
+
+private:
+    std::vector<uint8_t> pending;       // the leaves of the subtree being filled
+    std::vector<uint8_t> subtrees;      // the roots of the full subtrees
+    uint64_t count;
+};
+
+#endif //ECC_MERKLE_H
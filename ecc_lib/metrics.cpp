@@ -0,0 +1,180 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+#include "metrics.h"
+
+Histogram::Histogram() : shards(new Shard[SHARDS]) {
+    for (std::size_t s = 0; s < SHARDS; s++) {
+        for (std::atomic<uint64_t>& b : this->shards[s].buckets) {
+            b.store(0, std::memory_order_relaxed);
+        }
+        this->shards[s].count.store(0, std::memory_order_relaxed);
+        this->shards[s].sum.store(0, std::memory_order_relaxed);
+        this->shards[s].max.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::size_t Histogram::bucket(uint64_t value) noexcept {
+    if (value < SUB_BUCKETS) {
+        return static_cast<std::size_t>(value);
+    }
+    std::size_t e = 63;
+    while (!(value >> e)) {
+        e--;
+    }
+    // e >= 4: the four bits below the top one pick the sub-bucket
+    const std::size_t b = SUB_BUCKETS * (e - 3) + static_cast<std::size_t>((value >> (e - 4)) - SUB_BUCKETS);
+    return std::min(b, BUCKETS - 1);
+}
+
+uint64_t Histogram::bucket_floor(std::size_t bucket) noexcept {
+    if (bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+    const std::size_t e = bucket / SUB_BUCKETS + 3;
+    return (SUB_BUCKETS + bucket % SUB_BUCKETS) << (e - 4);
+}
+
+void Histogram::record(uint64_t value) noexcept {
+    static std::atomic<std::size_t> threads(0);
+    static thread_local const std::size_t mine = threads.fetch_add(1, std::memory_order_relaxed) % SHARDS;
+    Shard& shard = this->shards[mine];
+    shard.buckets[bucket(value)].fetch_add(1, std::memory_order_relaxed);
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(value, std::memory_order_relaxed);
+    uint64_t max = shard.max.load(std::memory_order_relaxed);
+    while (value > max && !shard.max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+}
+
+Histogram::Snapshot Histogram::snapshot() const {
+    Snapshot out;
+    out.buckets.assign(BUCKETS, 0);
+    for (std::size_t s = 0; s < SHARDS; s++) {
+        const Shard& shard = this->shards[s];
+        for (std::size_t b = 0; b < BUCKETS; b++) {
+            out.buckets[b] += shard.buckets[b].load(std::memory_order_relaxed);
+        }
+        out.count += shard.count.load(std::memory_order_relaxed);
+        out.sum += shard.sum.load(std::memory_order_relaxed);
+        out.max = std::max(out.max, shard.max.load(std::memory_order_relaxed));
+    }
+    return out;
+}
+
+uint64_t Histogram::Snapshot::quantile(double q) const {
+    uint64_t total = 0;
+    for (uint64_t n : this->buckets) {
+        total += n;
+    }
+    if (total == 0) {
+        return 0;
+    }
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(total))));
+    uint64_t seen = 0;
+    for (std::size_t b = 0; b < this->buckets.size(); b++) {
+        seen += this->buckets[b];
+        if (seen >= rank) {
+            return b + 1 < BUCKETS ? std::min(this->max, bucket_floor(b + 1) - 1) : this->max;
+        }
+    }
+    return this->max;
+}
+
+Metrics& Metrics::global() {
+    static Metrics metrics;
+    return metrics;
+}
+
+Metrics::Entry& Metrics::entry(const std::string& name, const std::string& help) {
+    Entry& e = this->entries[name];
+    if (e.help.empty()) {
+        e.help = help;
+    }
+    return e;
+}
+
+Histogram& Metrics::histogram(const std::string& name, const std::string& help, double scale) {
+    std::lock_guard<std::mutex> guard(this->lock);
+    Entry& e = entry(name, help);
+    if (e.counter || e.gauge) {
+        throw std::invalid_argument("Metric " + name + " is not a histogram");
+    }
+    if (!e.histogram) {
+        e.histogram.reset(new Histogram());
+        e.scale = scale;
+    }
+    return *e.histogram;
+}
+
+Metrics::Counter& Metrics::counter(const std::string& name, const std::string& help) {
+    std::lock_guard<std::mutex> guard(this->lock);
+    Entry& e = entry(name, help);
+    if (e.histogram || e.gauge) {
+        throw std::invalid_argument("Metric " + name + " is not a counter");
+    }
+    if (!e.counter) {
+        e.counter.reset(new Counter());
+    }
+    return *e.counter;
+}
+
+Metrics::Gauge& Metrics::gauge(const std::string& name, const std::string& help) {
+    std::lock_guard<std::mutex> guard(this->lock);
+    Entry& e = entry(name, help);
+    if (e.histogram || e.counter) {
+        throw std::invalid_argument("Metric " + name + " is not a gauge");
+    }
+    if (!e.gauge) {
+        e.gauge.reset(new Gauge());
+    }
+    return *e.gauge;
+}
+
+Metrics::Snapshot Metrics::snapshot() const {
+    std::lock_guard<std::mutex> guard(this->lock);
+    Snapshot out;
+    for (const auto& named : this->entries) {
+        const Entry& e = named.second;
+        if (e.histogram) {
+            out.histograms.push_back(HistogramSample{named.first, e.help, e.scale, e.histogram->snapshot()});
+        } else if (e.counter) {
+            out.values.push_back(ValueSample{named.first, e.help, true,
+                                             static_cast<int64_t>(e.counter->value.load(std::memory_order_relaxed))});
+        } else if (e.gauge) {
+            out.values.push_back(ValueSample{named.first, e.help, false,
+                                             e.gauge->value.load(std::memory_order_relaxed)});
+        }
+    }
+    return out;
+}
+
+std::string Metrics::prometheus() const {
+    const Snapshot s = snapshot();
+    std::string out;
+    char line[256];
+    for (const HistogramSample& h : s.histograms) {
+        out += "# HELP " + h.name + " " + h.help + "\n# TYPE " + h.name + " summary\n";
+        for (double q : {0.5, 0.9, 0.99, 0.999}) {
+            // NaN until something is recorded, as Prometheus's own summaries give
+            std::snprintf(line, sizeof(line), "%s{quantile=\"%g\"} %.9g\n", h.name.c_str(), q,
+                          h.values.count ? static_cast<double>(h.values.quantile(q)) * h.scale : NAN);
+            out += line;
+        }
+        std::snprintf(line, sizeof(line), "%s_sum %.9g\n%s_count %llu\n", h.name.c_str(),
+                      static_cast<double>(h.values.sum) * h.scale, h.name.c_str(),
+                      static_cast<unsigned long long>(h.values.count));
+        out += line;
+    }
+    for (const ValueSample& v : s.values) {
+        out += "# HELP " + v.name + " " + v.help + "\n# TYPE " + v.name + (v.counter ? " counter\n" : " gauge\n");
+        std::snprintf(line, sizeof(line), "%s %lld\n", v.name.c_str(), static_cast<long long>(v.value));
+        out += line;
+    }
+    return out;
+}
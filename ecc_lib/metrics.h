@@ -0,0 +1,159 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_METRICS_H
+#define ECC_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Latencies, counts and queue depths of the engines, kept always: a record is
+// a few relaxed atomic adds on one of a histogram's shards, so the library
+// leaves them on. The instrumented operations and their names:
+//
+//     ecc_ecdsa_sign_seconds, ecc_ecdsa_verify_seconds,
+//     ecc_schnorr_sign_seconds, ecc_schnorr_verify_seconds     each call
+//     ecc_ecdsa_verify_batch_seconds, ecc_schnorr_verify_batch_seconds
+//     ecc_async_request_seconds       AsyncSchnorr, submission to completion
+//     ecc_async_batch_size            AsyncSchnorr's batches
+//     ecc_async_queue_depth           requests waiting for AsyncSchnorr's dispatcher
+//     ecc_daemon_requests_total, ecc_daemon_request_seconds    ShmServer
+//     ecc_key_table_hits_total, ecc_key_table_misses_total     KeyTableCache lookups
+//     ecc_huge_page_policy, ecc_page_bytes_normal, ecc_page_bytes_transparent,
+//     ecc_page_bytes_explicit, ecc_huge_page_fallbacks_total   huge_pages.h
+//
+// read back with Metrics::global().snapshot() or .prometheus().
+
+// Values in log-linear buckets, in the manner of HdrHistogram: exact below
+// 16, then 16 buckets to each power of two, so a quantile is within 1/16 of
+// the true value, up to 2^49 (six days of nanoseconds). Records go to one of
+// SHARDS copies picked per thread, so threads recording at once rarely share
+// a cache line.
+class Histogram {
+public:
+    static constexpr std::size_t SUB_BUCKETS = 16;
+    static constexpr std::size_t BUCKETS = SUB_BUCKETS * 46;
+    static constexpr std::size_t SHARDS = 8;
+
+    struct Snapshot {
+        std::vector<uint64_t> buckets;
+        uint64_t count = 0;
+        uint64_t sum = 0;
+        uint64_t max = 0;
+
+        // the value below which a fraction q of the records fall, as the top
+        // of its bucket (no more than max); 0 when there are none
+        uint64_t quantile(double q) const;
+        double mean() const { return this->count ? static_cast<double>(this->sum) / this->count : 0; }
+    };
+
+    Histogram();
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    void record(uint64_t value) noexcept;
+    // each count exact, the set of them not one instant's
+    Snapshot snapshot() const;
+
+    // the bucket of value, and the smallest value of bucket
+    static std::size_t bucket(uint64_t value) noexcept;
+    static uint64_t bucket_floor(std::size_t bucket) noexcept;
+
+private:
+    struct alignas(64) Shard {
+        std::array<std::atomic<uint64_t>, BUCKETS> buckets;
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> sum;
+        std::atomic<uint64_t> max;
+    };
+    std::unique_ptr<Shard[]> shards;
+};
+
+// records the nanoseconds from its construction to its destruction
+class HistogramTimer {
+public:
+    explicit HistogramTimer(Histogram& histogram) noexcept
+            : histogram(histogram), start(std::chrono::steady_clock::now()) {}
+    ~HistogramTimer() {
+        this->histogram.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - this->start).count()));
+    }
+    HistogramTimer(const HistogramTimer&) = delete;
+    HistogramTimer& operator=(const HistogramTimer&) = delete;
+
+private:
+    Histogram& histogram;
+    std::chrono::steady_clock::time_point start;
+};
+
+// The named metrics of the process. The getters make a metric on first use
+// and return the same one after; take it once into a static, as the library
+// does, since the lookup holds a lock. A histogram's values are scaled by
+// scale when exported (1e-9 for one of nanoseconds named _seconds).
+class Metrics {
+public:
+    struct Counter {
+        std::atomic<uint64_t> value{0};
+        void add(uint64_t n = 1) noexcept { this->value.fetch_add(n, std::memory_order_relaxed); }
+    };
+    struct Gauge {
+        std::atomic<int64_t> value{0};
+        void add(int64_t n) noexcept { this->value.fetch_add(n, std::memory_order_relaxed); }
+        void set(int64_t n) noexcept { this->value.store(n, std::memory_order_relaxed); }
+    };
+
+    struct HistogramSample {
+        std::string name;
+        std::string help;
+        double scale;
+        Histogram::Snapshot values;
+    };
+    struct ValueSample {
+        std::string name;
+        std::string help;
+        bool counter;
+        int64_t value;
+    };
+    struct Snapshot {
+        std::vector<HistogramSample> histograms;
+        std::vector<ValueSample> values;
+    };
+
+    static Metrics& global();
+
+    // throw std::invalid_argument for a name already taken by another kind
+    Histogram& histogram(const std::string& name, const std::string& help, double scale = 1e-9);
+    Counter& counter(const std::string& name, const std::string& help);
+    Gauge& gauge(const std::string& name, const std::string& help);
+
+    // every metric, by name
+    Snapshot snapshot() const;
+    // snapshot() in the Prometheus text format: histograms as summaries with
+    // the 0.5, 0.9, 0.99 and 0.999 quantiles, _sum and _count
+    std::string prometheus() const;
+
+private:
+    struct Entry {
+        std::string help;
+        double scale = 1;
+        std::unique_ptr<Histogram> histogram;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+    };
+
+    Entry& entry(const std::string& name, const std::string& help);
+
+    mutable std::mutex lock;
+    std::map<std::string, Entry> entries;
+};
+
+#endif //ECC_METRICS_H
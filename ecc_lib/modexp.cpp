@@ -0,0 +1,17 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include "BarrettReducer.h"
+#include "modexp.h"
+
+integer multi_pow(const std::vector<integer>& bases, const std::vector<integer>& exponents, const integer& modulus) {
+    const BarrettReducer reducer(modulus);
+    std::vector<integer> reduced;
+    reduced.reserve(bases.size());
+    for (const integer& base : bases) {
+        reduced.push_back(reducer.reduce(base));
+    }
+    return multi_pow(reduced, exponents, reducer.reduce(1),
+            [&reducer](const integer& x, const integer& y) { return reducer.mul(x, y); },
+            [&reducer](const integer& x) { return reducer.reduce(x.square()); });
+}
@@ -0,0 +1,384 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_MODEXP_H
+#define ECC_MODEXP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "integer.h"
+
+// Windowed exponentiation over any type with an associative multiplication.
+// mul(a, b) returns a * b; one is the identity. Exponents must be non-negative.
+// Each function optionally takes sqr(a) == mul(a, a) as a last argument for
+// types with a faster squaring; most of the multiplications are squarings.
+
+// window width that minimizes multiplications for an exponent of the given size
+inline std::size_t exp_window_width(std::size_t exponent_bits) {
+    if (exponent_bits <= 7) {
+        return 1;
+    }
+    if (exponent_bits <= 25) {
+        return 2;
+    }
+    if (exponent_bits <= 80) {
+        return 3;
+    }
+    if (exponent_bits <= 240) {
+        return 4;
+    }
+    if (exponent_bits <= 672) {
+        return 5;
+    }
+    return 6;
+}
+
+// k-ary: k exponent bits per step, precomputing base^0 .. base^(2^k - 1)
+template <typename T, typename Mul, typename Sqr>
+T fixed_window_pow(const T& base, const integer& exponent, const T& one, Mul mul, Sqr sqr) {
+    const std::size_t bits = exponent.bit_length();
+    const std::size_t k = exp_window_width(bits);
+
+    std::vector<T> table(std::size_t(1) << k, one);
+    for (std::size_t i = 1; i < table.size(); i++) {
+        table[i] = mul(table[i - 1], base);
+    }
+
+    T result = one;
+    bool started = false;
+    for (std::size_t top = (bits + k - 1) / k * k; top > 0; top -= k) {
+        const std::size_t digit = exponent.extract_bits(top - k, k);
+        if (started) {
+            for (std::size_t s = 0; s < k; s++) {
+                result = sqr(result);
+            }
+            if (digit) {
+                result = mul(result, table[digit]);
+            }
+        } else if (digit) {
+            result = table[digit];
+            started = true;
+        }
+    }
+    return result;
+}
+
+template <typename T, typename Mul>
+T fixed_window_pow(const T& base, const integer& exponent, const T& one, Mul mul) {
+    return fixed_window_pow(base, exponent, one, mul, [&mul](const T& a) { return mul(a, a); });
+}
+
+// sliding window: windows start and end on a set bit, so only the odd powers
+// base, base^3, .., base^(2^k - 1) are precomputed and zero runs cost squarings only
+template <typename T, typename Mul, typename Sqr>
+T sliding_window_pow(const T& base, const integer& exponent, const T& one, Mul mul, Sqr sqr) {
+    const std::size_t bits = exponent.bit_length();
+    if (!bits) {
+        return one;
+    }
+    const std::size_t k = exp_window_width(bits);
+
+    std::vector<T> odd(std::size_t(1) << (k - 1), base);
+    if (odd.size() > 1) {
+        const T square = sqr(base);
+        for (std::size_t i = 1; i < odd.size(); i++) {
+            odd[i] = mul(odd[i - 1], square);
+        }
+    }
+
+    T result = one;
+    bool started = false;
+    for (std::size_t i = bits; i > 0;) {
+        if (!exponent.test_bit(i - 1)) {
+            if (started) {
+                result = sqr(result);
+            }
+            i--;
+            continue;
+        }
+        // longest window [j, i) of at most k bits that ends in a set bit
+        std::size_t j = (i > k) ? i - k : 0;
+        while (!exponent.test_bit(j)) {
+            j++;
+        }
+        const std::size_t value = exponent.extract_bits(j, i - j);
+        if (started) {
+            for (std::size_t s = j; s < i; s++) {
+                result = sqr(result);
+            }
+            result = mul(result, odd[value >> 1]);
+        } else {
+            result = odd[value >> 1];
+            started = true;
+        }
+        i = j;
+    }
+    return result;
+}
+
+template <typename T, typename Mul>
+T sliding_window_pow(const T& base, const integer& exponent, const T& one, Mul mul) {
+    return sliding_window_pow(base, exponent, one, mul, [&mul](const T& a) { return mul(a, a); });
+}
+
+// x^(2^n): n squarings, the doubling steps of a hand-written addition chain
+template <typename T, typename Sqr>
+T repeated_square(T x, std::size_t n, Sqr sqr) {
+    for (std::size_t i = 0; i < n; i++) {
+        x = sqr(x);
+    }
+    return x;
+}
+
+// Products of powers, bases[0]^exponents[0] * .. * bases[k - 1]^exponents[k - 1],
+// with one chain of squarings for all k, as verification equations such as
+// g^a h^b y^c need. Each throws std::invalid_argument if the sizes differ or
+// an exponent is negative; no bases give one.
+
+// Strauss (interleaved sliding windows): every base gets its own odd powers
+// and windows as in sliding_window_pow, and a window's power is multiplied in
+// when the shared chain reaches its lowest bit. About top + sum over i of
+// 2^(w_i - 1) + bits_i / (w_i + 1) multiplications for the largest exponent
+// of top bits, where k separate powers take k top squarings
+template <typename T, typename Mul, typename Sqr>
+T strauss_multi_pow(const std::vector<T>& bases, const std::vector<integer>& exponents, const T& one, Mul mul,
+                    Sqr sqr) {
+    if (bases.size() != exponents.size()) {
+        throw std::invalid_argument("Need as many exponents as bases");
+    }
+    const std::size_t k = bases.size();
+    std::vector<std::vector<T>> odd(k);
+    // (lowest bit, value) of each base's windows, from the top
+    std::vector<std::vector<std::pair<std::size_t, std::size_t>>> windows(k);
+    std::size_t top = 0;
+    for (std::size_t b = 0; b < k; b++) {
+        const integer& e = exponents[b];
+        if (e < 0) {
+            throw std::invalid_argument("Exponents must be non-negative");
+        }
+        const std::size_t bits = e.bit_length();
+        if (!bits) {
+            continue;
+        }
+        top = std::max(top, bits);
+        const std::size_t w = exp_window_width(bits);
+        odd[b].assign(std::size_t(1) << (w - 1), bases[b]);
+        if (odd[b].size() > 1) {
+            const T square = sqr(bases[b]);
+            for (std::size_t i = 1; i < odd[b].size(); i++) {
+                odd[b][i] = mul(odd[b][i - 1], square);
+            }
+        }
+        for (std::size_t i = bits; i > 0;) {
+            if (!e.test_bit(i - 1)) {
+                i--;
+                continue;
+            }
+            std::size_t j = (i > w) ? i - w : 0;
+            while (!e.test_bit(j)) {
+                j++;
+            }
+            windows[b].emplace_back(j, e.extract_bits(j, i - j));
+            i = j;
+        }
+    }
+
+    T result = one;
+    bool started = false;
+    std::vector<std::size_t> next(k, 0);
+    for (std::size_t i = top; i > 0; i--) {
+        if (started) {
+            result = sqr(result);
+        }
+        for (std::size_t b = 0; b < k; b++) {
+            if (next[b] < windows[b].size() && windows[b][next[b]].first == i - 1) {
+                const T& power = odd[b][windows[b][next[b]].second >> 1];
+                result = started ? mul(result, power) : power;
+                started = true;
+                next[b]++;
+            }
+        }
+    }
+    return result;
+}
+
+template <typename T, typename Mul>
+T strauss_multi_pow(const std::vector<T>& bases, const std::vector<integer>& exponents, const T& one, Mul mul) {
+    return strauss_multi_pow(bases, exponents, one, mul, [&mul](const T& a) { return mul(a, a); });
+}
+
+// Pippenger's bucket method with c-bit digits (1 to 24): for each window from
+// the top, the chain is squared c times, every base goes into the bucket of
+// its digit, and the buckets are taken to the power of their digit as a
+// product of running products from the top, 2 (2^c - 1) multiplications
+// whatever k. About top + (top / c) (k + 2^(c + 1)) multiplications and
+// 2^c - 1 values of memory, which beats Strauss's per-base tables once k is
+// in the thousands
+template <typename T, typename Mul, typename Sqr>
+T bucket_multi_pow(const std::vector<T>& bases, const std::vector<integer>& exponents, std::size_t c, const T& one,
+                   Mul mul, Sqr sqr) {
+    if (bases.size() != exponents.size()) {
+        throw std::invalid_argument("Need as many exponents as bases");
+    }
+    if (c < 1 || c > 24) {
+        throw std::invalid_argument("Pippenger window must be between 1 and 24 bits");
+    }
+    std::size_t top = 0;
+    for (const integer& e : exponents) {
+        if (e < 0) {
+            throw std::invalid_argument("Exponents must be non-negative");
+        }
+        top = std::max(top, e.bit_length());
+    }
+
+    // x = x * y, or y when x is still empty (one), so no product is by one
+    const auto times = [&mul](T& x, bool& have, const T& y) {
+        x = have ? mul(x, y) : y;
+        have = true;
+    };
+    T result = one;
+    bool started = false;
+    std::vector<T> buckets((std::size_t(1) << c) - 1, one);
+    std::vector<bool> filled(buckets.size());
+    for (std::size_t window = (top + c - 1) / c; window > 0; window--) {
+        if (started) {
+            result = repeated_square(result, c, sqr);
+        }
+        std::fill(filled.begin(), filled.end(), false);
+        for (std::size_t b = 0; b < bases.size(); b++) {
+            const std::size_t d = exponents[b].extract_bits((window - 1) * c, c);
+            if (d) {
+                bool have = filled[d - 1];
+                times(buckets[d - 1], have, bases[b]);
+                filled[d - 1] = true;
+            }
+        }
+        T running = one, product = one;
+        bool have_running = false, have_product = false;
+        for (std::size_t d = buckets.size(); d > 0; d--) {
+            if (filled[d - 1]) {
+                times(running, have_running, buckets[d - 1]);
+            }
+            if (have_running) {
+                times(product, have_product, running);
+            }
+        }
+        if (have_product) {
+            times(result, started, product);
+        }
+    }
+    return result;
+}
+
+template <typename T, typename Mul>
+T bucket_multi_pow(const std::vector<T>& bases, const std::vector<integer>& exponents, std::size_t c, const T& one,
+                   Mul mul) {
+    return bucket_multi_pow(bases, exponents, c, one, mul, [&mul](const T& a) { return mul(a, a); });
+}
+
+// the c minimizing bucket_multi_pow's multiplications for k bases and
+// exponents of bits bits
+inline std::size_t multi_pow_window(std::size_t k, std::size_t bits) {
+    std::size_t best = 1;
+    double best_cost = 0;
+    for (std::size_t c = 1; c <= 20; c++) {
+        const double cost = static_cast<double>((bits + c - 1) / c) * static_cast<double>(k + (std::size_t(2) << c));
+        if (c == 1 || cost < best_cost) {
+            best = c;
+            best_cost = cost;
+        }
+    }
+    return best;
+}
+
+// Strauss or Pippenger, whichever the multiplication counts above make cheaper
+template <typename T, typename Mul, typename Sqr>
+T multi_pow(const std::vector<T>& bases, const std::vector<integer>& exponents, const T& one, Mul mul, Sqr sqr) {
+    double strauss = 0;
+    std::size_t top = 0;
+    for (const integer& e : exponents) {
+        const std::size_t bits = e.bit_length();
+        const std::size_t w = exp_window_width(bits);
+        strauss += static_cast<double>((std::size_t(1) << (w - 1)) + bits / (w + 1));
+        top = std::max(top, bits);
+    }
+    const std::size_t c = multi_pow_window(exponents.size(), top);
+    const double bucket = static_cast<double>((top + c - 1) / c) *
+                          static_cast<double>(exponents.size() + (std::size_t(2) << c));
+    if (bucket < strauss) {
+        return bucket_multi_pow(bases, exponents, c, one, mul, sqr);
+    }
+    return strauss_multi_pow(bases, exponents, one, mul, sqr);
+}
+
+template <typename T, typename Mul>
+T multi_pow(const std::vector<T>& bases, const std::vector<integer>& exponents, const T& one, Mul mul) {
+    return multi_pow(bases, exponents, one, mul, [&mul](const T& a) { return mul(a, a); });
+}
+
+// the product of bases[i]^exponents[i] mod modulus, with Barrett reduction;
+// also throws std::invalid_argument for a modulus below 1
+integer multi_pow(const std::vector<integer>& bases, const std::vector<integer>& exponents, const integer& modulus);
+
+// Montgomery ladder over the low `bits` bits of the exponent: every bit costs the
+// same two conditional swaps, one multiplication and one squaring, set or not.
+// bit(i) returns bit i of the exponent as 0 or 1 and cswap(a, b, mask) swaps a and b
+// when mask is all ones, so with branch-free mul and cswap nothing depends on the
+// exponent's value.
+template <typename T, typename Bit, typename Mul, typename Swap, typename Sqr>
+constexpr T montgomery_ladder_pow(const T& base, std::size_t bits, Bit bit, const T& one, Mul mul, Swap cswap, Sqr sqr) {
+    T r0 = one, r1 = base;      // invariant: r1 = r0 * base
+    for (std::size_t i = bits; i > 0; i--) {
+        const uint64_t mask = 0 - static_cast <uint64_t> (bit(i - 1));
+        cswap(r0, r1, mask);
+        r1 = mul(r0, r1);
+        r0 = sqr(r0);
+        cswap(r0, r1, mask);
+    }
+    return r0;
+}
+
+template <typename T, typename Bit, typename Mul, typename Swap>
+constexpr T montgomery_ladder_pow(const T& base, std::size_t bits, Bit bit, const T& one, Mul mul, Swap cswap) {
+    return montgomery_ladder_pow(base, bits, bit, one, mul, cswap, [&mul](const T& a) { return mul(a, a); });
+}
+
+// width-w non-adjacent form of k >= 0, least significant first: every digit is
+// zero or odd with |digit| < 2^(w - 1), and any w consecutive digits hold at
+// most one non-zero, so k = sum digit[i] * 2^i takes about bits / (w + 1)
+// additions of the odd multiples 1, 3, .., 2^(w - 1) - 1 and their negations.
+// k has bits bits, bit(i) reads bit i of it and is false past the top.
+template <typename Bit>
+std::vector<int> wnaf_digits(std::size_t bits, Bit bit, std::size_t w) {
+    std::vector<int> digits(bits + w, 0);
+    int carry = 0;
+    for (std::size_t i = 0; i < bits || carry;) {
+        if (static_cast<int>(bit(i)) == carry) {
+            i++;
+            continue;
+        }
+        // the next w bits plus the carry are odd; take them as a signed digit
+        int word = carry;
+        for (std::size_t j = 0; j < w; j++) {
+            word += static_cast<int>(bit(i + j)) << j;
+        }
+        carry = (word >> (w - 1)) & 1;
+        digits[i] = word - (carry << w);
+        i += w;
+    }
+    while (!digits.empty() && !digits.back()) {
+        digits.pop_back();
+    }
+    return digits;
+}
+
+inline std::vector<int> wnaf(const integer& k, std::size_t w) {
+    return wnaf_digits(k.bit_length(), [&k](std::size_t i) { return k.test_bit(i); }, w);
+}
+
+#endif //ECC_MODEXP_H
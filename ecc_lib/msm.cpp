@@ -0,0 +1,496 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+
+#include "FieldVector.h"
+#include "msm.h"
+#include "msm_backend.h"
+
+static void check_input(const std::vector<integer>& scalars, const std::vector<Point>& points) {
+    if (points.empty() || scalars.size() != points.size()) {
+        throw std::invalid_argument("Need as many scalars as points, at least one");
+    }
+}
+
+// the sum by the installed backend, if there is one that takes this many points
+static bool offload(const std::vector<integer>& scalars, const std::vector<Point>& points, Point& out) {
+    MsmBackend* backend = msm_backend();
+    if (!backend || points.size() < backend->min_points()) {
+        return false;
+    }
+    MsmBuffers buffers;
+    msm_stage(scalars, points, pippenger_window(points.size(), msm_max_bits(scalars)), buffers);
+    std::vector<limb_t> sums(3 * buffers.width * buffers.windows);
+    if (!backend->window_sums(buffers, sums.data())) {
+        return false;
+    }
+    const Result<Point> sum = msm_combine(buffers, sums.data(), points[0]);
+    if (sum) {
+        out = *sum;
+    }
+    return sum.ok();
+}
+
+msm_executor thread_executor(unsigned threads) {
+    return [threads](std::size_t count, const std::function<void(std::size_t)>& task) {
+        ThreadExecutor(threads).run(count, task);
+    };
+}
+
+std::size_t msm_max_bits(const std::vector<integer>& scalars) {
+    std::size_t bits = 0;
+    for (const integer& k : scalars) {
+        bits = std::max(bits, k.bit_length());
+    }
+    return bits;
+}
+
+// Z = 1 everywhere, so that every bucket addition is mixed
+static void normalize(Point* part, std::size_t count, Scratch& scratch) {
+    Point::batch_normalize(part, count, scratch);
+}
+
+Point multi_scalar_mul(const std::vector<integer>& scalars, const std::vector<Point>& points, unsigned threads) {
+    return multi_scalar_mul(scalars, points, thread_executor(threads), threads);
+}
+
+Point multi_scalar_mul(const std::vector<integer>& scalars, const std::vector<Point>& points, Executor& executor) {
+    return multi_scalar_mul(scalars, points, executor.function(), executor.concurrency());
+}
+
+Point multi_scalar_mul(const std::vector<integer>& scalars, const std::vector<Point>& points,
+                       const msm_executor& executor, std::size_t parallelism) {
+    ECC_TRACE_SPAN("msm");
+    check_input(scalars, points);
+    Point offloaded = points[0];
+    if (offload(scalars, points, offloaded)) {
+        return offloaded;
+    }
+    if (points.size() < MSM_STRAUSS_MAX) {
+        return Point::mul_sum(scalars, points);
+    }
+    const std::size_t c = pippenger_window(points.size(), msm_max_bits(scalars));
+    if (points.size() >= MSM_SORTED_MIN) {
+        return pippenger_sorted(scalars, points, c, executor, parallelism);
+    }
+    return pippenger(scalars, points, c, executor, parallelism);
+}
+
+Point multi_scalar_mul(const std::vector<integer>& scalars, const std::vector<Point>& points, Executor& executor,
+                       Scratch& scratch) {
+    ECC_TRACE_SPAN("msm");
+    check_input(scalars, points);
+    Point offloaded = points[0];
+    if (offload(scalars, points, offloaded)) {
+        return offloaded;
+    }
+    if (points.size() < MSM_STRAUSS_MAX) {
+        return Point::mul_sum(scalars, points);
+    }
+    const std::size_t c = pippenger_window(points.size(), msm_max_bits(scalars));
+    if (points.size() >= MSM_SORTED_MIN) {
+        return pippenger_sorted(scalars, points, c, executor, scratch);
+    }
+    return pippenger(scalars, points, c, executor, scratch);
+}
+
+std::size_t pippenger_window(std::size_t n, std::size_t bits) {
+    std::size_t best = 1;
+    double best_cost = 0;
+    for (std::size_t c = 1; c <= 24; c++) {
+        // bucket additions, then the running sums over 2^(c - 1) buckets
+        const double windows = static_cast<double>(bits / c + 1);
+        const double cost = windows * (static_cast<double>(n) + static_cast<double>(std::size_t(1) << c));
+        if (c == 1 || cost < best_cost) {
+            best = c;
+            best_cost = cost;
+        }
+    }
+    return best;
+}
+
+// the top window holds at most c - 1 bits of k, so it never carries out
+void msm_signed_digits(const integer& k, std::size_t c, std::size_t windows, int* out) {
+    const int half = 1 << (c - 1);
+    int carry = 0;
+    for (std::size_t i = 0; i < windows; i++) {
+        const int v = carry + static_cast<int>(k.extract_bits(i * c, c));
+        carry = v > half;
+        out[i] = v - (carry << c);
+    }
+}
+
+void msm_run_tasks(const msm_executor& executor, std::size_t count, const std::function<void(std::size_t)>& task) {
+    std::vector<std::exception_ptr> errors(count);
+    executor(count, [&](std::size_t i) {
+        try {
+            task(i);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    });
+    for (const std::exception_ptr& e : errors) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+}
+
+Point pippenger(const std::vector<integer>& scalars, const std::vector<Point>& points, std::size_t c,
+                unsigned threads) {
+    return pippenger(scalars, points, c, thread_executor(threads), threads);
+}
+
+Point pippenger(const std::vector<integer>& scalars, const std::vector<Point>& points, std::size_t c,
+                Executor& executor) {
+    return pippenger(scalars, points, c, executor.function(), executor.concurrency());
+}
+
+Point pippenger(const std::vector<integer>& scalars, const std::vector<Point>& points, std::size_t c,
+                Executor& executor, Scratch& scratch) {
+    check_input(scalars, points);
+    return bucket_msm(scalars, points, c, Point(points[0].curve_a(), points[0].curve_b()), normalize,
+                      executor.function(), executor.concurrency(), scratch);
+}
+
+Point pippenger(const std::vector<integer>& scalars, const std::vector<Point>& points, std::size_t c,
+                const msm_executor& executor, std::size_t parallelism) {
+    check_input(scalars, points);
+    return bucket_msm(scalars, points, c, Point(points[0].curve_a(), points[0].curve_b()), normalize, executor,
+                      parallelism, Scratch::local());
+}
+
+// pippenger_sorted()'s accumulation, shared by the tasks of one call, with
+// the affine coordinates of the prepared points made by the first of them
+namespace {
+class SortedBuckets {
+public:
+    SortedBuckets(const Point& curve, std::size_t n) : curve(curve), n(n) {}
+
+    void operator()(const Point* p, const int* digits, std::size_t windows, std::size_t window, std::size_t first,
+                    std::size_t last, Point* buckets, std::size_t count, Scratch& scratch);
+
+private:
+    const Point& curve;
+    std::size_t n;
+    std::once_flag once;
+    std::optional<FieldVector> x, y;
+
+    // the sums of runs[i] at x, y and lengths[i] points from starts[i], one
+    // round of batch additions at a time until every run has one point left
+    void reduce(FieldVector& x, FieldVector& y, const std::vector<std::size_t>& starts,
+                std::vector<std::size_t>& lengths) const;
+};
+}
+
+void SortedBuckets::operator()(const Point* p, const int* digits, std::size_t windows, std::size_t window,
+                               std::size_t first, std::size_t last, Point* buckets, std::size_t count,
+                               Scratch& scratch) {
+    std::call_once(this->once, [&] {
+        const PrimeField& field = this->curve.curve_a().prime_field();
+        this->x.emplace(field, this->n);
+        this->y.emplace(field, this->n);
+        for (std::size_t i = 0; i < this->n; i++) {
+            if (p[i].curve_a() != this->curve.curve_a() || p[i].curve_b() != this->curve.curve_b()) {
+                throw std::runtime_error("Cannot add points on different curves");
+            }
+            if (!p[i].is_infinity()) {
+                const std::pair<FieldElement, FieldElement> xy = p[i].affine();
+                this->x->set(i, xy.first);
+                this->y->set(i, xy.second);
+            }
+        }
+    });
+
+    // a counting sort of the range by bucket: bucket j's entries at
+    // order[start[j]] .. order[start[j + 1]], each a point's index shifted up
+    // by one over the sign of its digit
+    Scratch::Frame frame(scratch);
+    Scratch::vector<std::size_t> start(count + 1, 0, &scratch);
+    for (std::size_t i = first; i < last; i++) {
+        const int d = digits[i * windows + window];
+        if (d && !p[i].is_infinity()) {
+            start[d > 0 ? d : -d]++;
+        }
+    }
+    for (std::size_t j = 0; j < count; j++) {
+        start[j + 1] += start[j];
+    }
+    Scratch::vector<std::size_t> next(start.begin(), start.end() - 1, &scratch);
+    Scratch::vector<std::size_t> order(start[count], 0, &scratch);
+    for (std::size_t i = first; i < last; i++) {
+        const int d = digits[i * windows + window];
+        if (d && !p[i].is_infinity()) {
+            order[next[(d > 0 ? d : -d) - 1]++] = i << 1 | (d < 0);
+        }
+    }
+
+    // the buckets in groups of about MSM_SORTED_GROUP points, each gathered
+    // in bucket order, then reduced
+    const PrimeField& field = this->x->prime_field();
+    std::vector<std::size_t> index, starts, lengths;
+    std::vector<limb_t> negative;
+    for (std::size_t j = 0, end; j < count; j = end) {
+        end = j + 1;
+        while (end < count && start[end + 1] - start[j] <= MSM_SORTED_GROUP) {
+            end++;
+        }
+        index.clear();
+        negative.clear();
+        for (std::size_t k = start[j]; k < start[end]; k++) {
+            index.push_back(order[k] >> 1);
+            negative.push_back(0 - static_cast<limb_t>(order[k] & 1));
+        }
+        FieldVector gx = this->x->gather(index), gy = this->y->gather(index);
+        gy = FieldVector::select(negative, FieldVector(field, gy.size()) - gy, gy);
+        starts.clear();
+        lengths.clear();
+        for (std::size_t i = j; i < end; i++) {
+            starts.push_back(start[i] - start[j]);
+            lengths.push_back(start[i + 1] - start[i]);
+        }
+        reduce(gx, gy, starts, lengths);
+        for (std::size_t i = 0; i < starts.size(); i++) {
+            if (lengths[i]) {
+                buckets[j + i] = Point(gx.get(starts[i]), gy.get(starts[i]), this->curve.curve_a(),
+                                       this->curve.curve_b());
+            }
+        }
+    }
+}
+
+void SortedBuckets::reduce(FieldVector& x, FieldVector& y, const std::vector<std::size_t>& starts,
+                           std::vector<std::size_t>& lengths) const {
+    const PrimeField& field = x.prime_field();
+    std::vector<std::size_t> left, right, odd, to, odd_to, kept;
+    std::vector<bool> gone;
+    for (;;) {
+        left.clear();
+        right.clear();
+        for (std::size_t i = 0; i < starts.size(); i++) {
+            for (std::size_t k = 0; k + 1 < lengths[i]; k += 2) {
+                left.push_back(starts[i] + k);
+                right.push_back(starts[i] + k + 1);
+            }
+        }
+        if (left.empty()) {
+            return;
+        }
+
+        // the chord through each pair, all the slopes' denominators inverted
+        // together
+        const FieldVector x1 = x.gather(left), y1 = y.gather(left);
+        const FieldVector x2 = x.gather(right), y2 = y.gather(right);
+        FieldVector dx = x2 - x1;
+        // pairs with equal x, a doubling or a point and its negative, are
+        // added as Points, their denominators set to one meanwhile
+        const std::vector<std::size_t> same = dx.zeros();
+        std::vector<Point> special;
+        gone.assign(left.size(), false);
+        for (std::size_t i : same) {
+            const Point sum = Point(x1.get(i), y1.get(i), this->curve.curve_a(), this->curve.curve_b())
+                              + Point(x2.get(i), y2.get(i), this->curve.curve_a(), this->curve.curve_b());
+            gone[i] = sum.is_infinity();
+            special.push_back(sum.normalized());
+            dx.set(i, FieldElement(1, field));
+        }
+        const FieldVector slope = (y2 - y1) * dx.inverse();
+        FieldVector x3 = slope.square() - x1 - x2;
+        FieldVector y3 = slope * (x1 - x3) - y1;
+        for (std::size_t k = 0; k < same.size(); k++) {
+            if (!gone[same[k]]) {
+                x3.set(same[k], special[k].x());
+                y3.set(same[k], special[k].y());
+            }
+        }
+
+        // each run is rewritten from its start: its sums, then its odd
+        // point out
+        to.clear();
+        odd.clear();
+        odd_to.clear();
+        kept.clear();
+        for (std::size_t i = 0, pair = 0; i < starts.size(); i++) {
+            std::size_t length = 0;
+            for (std::size_t k = 0; k + 1 < lengths[i]; k += 2, pair++) {
+                if (!gone[pair]) {
+                    kept.push_back(pair);
+                    to.push_back(starts[i] + length++);
+                }
+            }
+            if (lengths[i] & 1) {
+                odd.push_back(starts[i] + lengths[i] - 1);
+                odd_to.push_back(starts[i] + length++);
+            }
+            lengths[i] = length;
+        }
+        const FieldVector odd_x = x.gather(odd), odd_y = y.gather(odd);
+        x.scatter(to, x3.gather(kept));
+        y.scatter(to, y3.gather(kept));
+        x.scatter(odd_to, odd_x);
+        y.scatter(odd_to, odd_y);
+    }
+}
+
+Point pippenger_sorted(const std::vector<integer>& scalars, const std::vector<Point>& points, std::size_t c,
+                       unsigned threads) {
+    return pippenger_sorted(scalars, points, c, thread_executor(threads), threads);
+}
+
+Point pippenger_sorted(const std::vector<integer>& scalars, const std::vector<Point>& points, std::size_t c,
+                       Executor& executor, Scratch& scratch) {
+    check_input(scalars, points);
+    if (!points[0].curve_a().prime_field().fixed()) {
+        return pippenger(scalars, points, c, executor, scratch);
+    }
+    SortedBuckets sorted(points[0], points.size());
+    return bucket_msm(scalars, points, c, Point(points[0].curve_a(), points[0].curve_b()), normalize,
+                      std::ref(sorted), executor.function(), executor.concurrency(), scratch);
+}
+
+Point pippenger_sorted(const std::vector<integer>& scalars, const std::vector<Point>& points, std::size_t c,
+                       const msm_executor& executor, std::size_t parallelism) {
+    check_input(scalars, points);
+    if (!points[0].curve_a().prime_field().fixed()) {
+        return pippenger(scalars, points, c, executor, parallelism);
+    }
+    SortedBuckets sorted(points[0], points.size());
+    return bucket_msm(scalars, points, c, Point(points[0].curve_a(), points[0].curve_b()), normalize,
+                      std::ref(sorted), executor, parallelism, Scratch::local());
+}
+
+std::size_t fixed_base_window(std::size_t n, std::size_t bits, std::size_t stride) {
+    stride = std::max<std::size_t>(stride, 1);
+    std::size_t best = 1;
+    double best_cost = 0;
+    for (std::size_t c = 1; c <= 24; c++) {
+        // every window's additions into the buckets, each round's running sums
+        // and the doublings between rounds
+        const double cost = static_cast<double>(bits / c + 1) * static_cast<double>(n) +
+                            static_cast<double>(stride) * static_cast<double>(std::size_t(1) << c) +
+                            static_cast<double>((stride - 1) * c);
+        if (c == 1 || cost < best_cost) {
+            best = c;
+            best_cost = cost;
+        }
+    }
+    return best;
+}
+
+FixedBaseMsm::FixedBaseMsm(const std::vector<Point>& points, std::size_t bits, std::size_t c, unsigned threads,
+                           std::size_t stride)
+        : FixedBaseMsm(points.data(), points.size(), bits, c, threads, stride) {
+}
+
+FixedBaseMsm::FixedBaseMsm(const Point* points, std::size_t count, std::size_t bits, std::size_t c, unsigned threads,
+                           std::size_t stride)
+        : n(count), max_bits(bits), c(c ? c : fixed_base_window(count, bits, stride)), s(stride) {
+    if (count == 0) {
+        throw std::invalid_argument("Fixed-base MSM needs at least one point");
+    }
+    if (stride == 0) {
+        throw std::invalid_argument("Fixed-base MSM stride must be at least 1");
+    }
+    if (this->c > 24) {
+        throw std::invalid_argument("Pippenger window must be between 1 and 24 bits");
+    }
+    // one more window, for the carry out of the top signed digit
+    this->windows = bits / this->c + 1;
+    this->rows = (this->windows + this->s - 1) / this->s;
+    this->table.assign(this->n * this->rows, points[0]);
+    const std::size_t chunks = std::max<std::size_t>(1, std::min<std::size_t>(threads, this->n));
+    const std::size_t chunk = (this->n + chunks - 1) / chunks;
+    msm_run_tasks(thread_executor(threads), chunks, [&](std::size_t t) {
+        ECC_TRACE_SPAN("msm.fixed_base_table");
+        const std::size_t first = t * chunk, last = std::min(this->n, first + chunk);
+        if (first >= last) {
+            return;
+        }
+        for (std::size_t i = first; i < last; i++) {
+            Point p = points[i];
+            for (std::size_t j = 0; j < this->rows; j++) {
+                this->table[i * this->rows + j] = p;
+                for (std::size_t k = 0; k < this->c * this->s && j + 1 < this->rows; k++) {
+                    p = p.dbl();
+                }
+            }
+        }
+        Point::batch_normalize(&this->table[first * this->rows], (last - first) * this->rows, Scratch::local());
+    });
+}
+
+Point FixedBaseMsm::mul(const std::vector<integer>& scalars, unsigned threads) const {
+    ThreadExecutor executor(threads);
+    return mul(scalars, executor);
+}
+
+Point FixedBaseMsm::mul(const std::vector<integer>& scalars, Executor& executor) const {
+    ECC_TRACE_SPAN("msm.fixed_base");
+    if (scalars.empty() || scalars.size() > this->n) {
+        throw std::invalid_argument("Need at least one scalar and no more than the points");
+    }
+    const std::size_t count = scalars.size();
+    std::vector<int> digits(count * this->windows);
+    for (std::size_t i = 0; i < count; i++) {
+        const integer& k = scalars[i];
+        if (k.bit_length() > this->max_bits) {
+            throw std::invalid_argument("Scalar is too large for the fixed-base tables");
+        }
+        msm_signed_digits(k < 0 ? -k : k, this->c, this->windows, &digits[i * this->windows]);
+        if (k < 0) {
+            for (std::size_t j = 0; j < this->windows; j++) {
+                digits[i * this->windows + j] = -digits[i * this->windows + j];
+            }
+        }
+    }
+
+    // ranges of points with buckets of their own, while each range's
+    // additions in a round outweigh its bucket sum
+    const Point identity(this->table[0].curve_a(), this->table[0].curve_b());
+    const std::size_t buckets = std::size_t(1) << (this->c - 1);
+    const std::size_t ranges = std::max<std::size_t>(1, std::min(executor.concurrency(),
+                                                                 count * this->rows / (2 * buckets)));
+    const std::size_t range = (count + ranges - 1) / ranges;
+    // the sum of round r over range t at t * s + r
+    std::vector<Point> sums(ranges * this->s, identity);
+    msm_run_tasks(executor.function(), ranges, [&](std::size_t t) {
+        const std::size_t first = t * range, last = std::min(count, first + range);
+        std::vector<Point> b(buckets, identity);
+        for (std::size_t r = 0; r < this->s; r++) {
+            std::fill(b.begin(), b.end(), identity);
+            for (std::size_t i = first; i < last; i++) {
+                for (std::size_t j = 0, w = r; w < this->windows; j++, w += this->s) {
+                    const int d = digits[i * this->windows + w];
+                    if (d > 0) {
+                        b[d - 1] += this->table[i * this->rows + j];
+                    } else if (d < 0) {
+                        b[-d - 1] -= this->table[i * this->rows + j];
+                    }
+                }
+            }
+            Point running = identity, sum = identity;
+            for (std::size_t j = buckets; j > 0; j--) {
+                running += b[j - 1];
+                sum += running;
+            }
+            sums[t * this->s + r] = sum;
+        }
+    });
+    // round r is worth 2^(c r): Horner from the top round down
+    Point total = identity;
+    for (std::size_t r = this->s; r > 0; r--) {
+        for (std::size_t k = 0; k < this->c && r < this->s; k++) {
+            total = total.dbl();
+        }
+        for (std::size_t t = 0; t < ranges; t++) {
+            total += sums[t * this->s + r - 1];
+        }
+    }
+    return total;
+}
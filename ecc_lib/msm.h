@@ -0,0 +1,269 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_MSM_H
+#define ECC_MSM_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include "Executor.h"
+#include "integer.h"
+#include "Point.h"
+#include "Scratch.h"
+#include "trace.h"
+
+// Multi-scalar multiplication, the sum of scalars[i] * points[i]. All of these
+// take scalars of any sign and size, points on one curve, and throw
+// std::invalid_argument on empty input or sizes that differ. Not constant time.
+
+// below this many points multi_scalar_mul goes to Strauss
+constexpr std::size_t MSM_STRAUSS_MAX = 64;
+// from this many it fills Pippenger's buckets in bucket order (pippenger_sorted)
+constexpr std::size_t MSM_SORTED_MIN = 128;
+
+// A scheduler to run Pippenger's tasks on, Executor::run as a function: calls
+// task(0), .., task(count - 1) in any order and on any threads, and returns once
+// all of them have finished. The tasks do not throw; an exception from one is
+// rethrown by the caller after the executor returns. The overloads taking an
+// Executor pass its function() and concurrency() on
+typedef Executor::function_type msm_executor;
+
+// ThreadExecutor(threads) as a function: up to threads new std::threads, each
+// taking the next task until none are left; threads <= 1 runs them on the
+// calling thread
+msm_executor thread_executor(unsigned threads);
+
+// Strauss (Point::mul_sum) below MSM_STRAUSS_MAX points, Pippenger above,
+// pippenger_sorted from MSM_SORTED_MIN, with the window picked from the
+// number of points and the scalar size; the installed MsmBackend
+// (msm_backend.h) first, when there is one for this many
+Point multi_scalar_mul(const std::vector<integer>& scalars, const std::vector<Point>& points, unsigned threads = 1);
+Point multi_scalar_mul(const std::vector<integer>& scalars, const std::vector<Point>& points,
+                       const msm_executor& executor, std::size_t parallelism);
+Point multi_scalar_mul(const std::vector<integer>& scalars, const std::vector<Point>& points, Executor& executor);
+// with Pippenger's buffers on the calling thread taken from scratch; the
+// tasks draw from Scratch::local() of the threads running them, which the
+// other overloads use on the calling thread too
+Point multi_scalar_mul(const std::vector<integer>& scalars, const std::vector<Point>& points, Executor& executor,
+                       Scratch& scratch);
+
+// Pippenger's bucket method with windows of c bits (1 to 24): each window
+// recodes the scalars into signed digits, -2^(c - 1) < d <= 2^(c - 1), and adds
+// points[i] (or its negative) into bucket |d|, n mixed additions, then sums the
+// buckets with 2^c more. About bits / c * (n + 2^c) additions in all instead
+// of the bits / 5 * n of one wNAF per point.
+//
+// The work is cut for parallelism workers: the points are normalized and
+// recoded in chunks of at least 256, then there is one task per window and
+// range of points, and the ranges' bucket sums are added up per window at the
+// end. Ranges are only split while they stay longer than the 2^c buckets, as
+// each pays for its own bucket sum; with parallelism windows or more the
+// points stay in one range.
+Point pippenger(const std::vector<integer>& scalars, const std::vector<Point>& points, std::size_t c,
+                unsigned threads = 1);
+Point pippenger(const std::vector<integer>& scalars, const std::vector<Point>& points, std::size_t c,
+                const msm_executor& executor, std::size_t parallelism);
+Point pippenger(const std::vector<integer>& scalars, const std::vector<Point>& points, std::size_t c,
+                Executor& executor);
+Point pippenger(const std::vector<integer>& scalars, const std::vector<Point>& points, std::size_t c,
+                Executor& executor, Scratch& scratch);
+
+// pippenger() with each window's buckets filled in bucket order, the faster
+// from about MSM_SORTED_MIN points: the range's (point, digit) pairs are
+// counting-sorted by bucket, and the buckets taken in groups of about
+// MSM_SORTED_GROUP points, small enough for the cache. A group's points are
+// gathered in bucket order from the affine coordinates of all the points,
+// kept as FieldVectors of 64 bytes a point where a Point takes 848, and each
+// bucket's points summed as a tree: every round adds adjacent points of the
+// group's buckets in pairs, no point in two pairs, so all the chord slopes
+// of a round share one inversion, and the round runs element-wise over the
+// vectors, 2M + 1S a sum and 3M for its share of the inversion against the
+// 7M + 4S of a mixed addition into a Point. Same arguments and result as
+// pippenger(); fields of over 256 bits, which FieldVector does not take, go
+// to pippenger()
+Point pippenger_sorted(const std::vector<integer>& scalars, const std::vector<Point>& points, std::size_t c,
+                       unsigned threads = 1);
+Point pippenger_sorted(const std::vector<integer>& scalars, const std::vector<Point>& points, std::size_t c,
+                       const msm_executor& executor, std::size_t parallelism);
+Point pippenger_sorted(const std::vector<integer>& scalars, const std::vector<Point>& points, std::size_t c,
+                       Executor& executor, Scratch& scratch);
+
+// points the buckets pippenger_sorted() reduces together hold between them
+constexpr std::size_t MSM_SORTED_GROUP = 1024;
+
+// the c minimizing Pippenger's addition count for n points and scalars of bits bits
+std::size_t pippenger_window(std::size_t n, std::size_t bits);
+
+// The pieces of bucket_msm below that do not depend on the group.
+// c-bit signed digits of k >= 0, least significant first: digit i is in
+// (-2^(c - 1), 2^(c - 1)] and their sum with weights 2^(c i) is k
+void msm_signed_digits(const integer& k, std::size_t c, std::size_t windows, int* out);
+// runs task(0), .., task(count - 1) on executor and rethrows the first exception
+void msm_run_tasks(const msm_executor& executor, std::size_t count, const std::function<void(std::size_t)>& task);
+// the largest bit length in scalars
+std::size_t msm_max_bits(const std::vector<integer>& scalars);
+
+// bucket_msm's accumulation in input order: p[i] into buckets[|d| - 1] for i
+// in [first, last), d its digit digits[i * windows + window]
+struct MsmDirect {
+    template <typename P, typename Q>
+    void operator()(const Q* p, const int* digits, std::size_t windows, std::size_t window, std::size_t first,
+                    std::size_t last, P* buckets, std::size_t, Scratch&) const {
+        for (std::size_t i = first; i < last; i++) {
+            const int d = digits[i * windows + window];
+            if (d > 0) {
+                buckets[d - 1] += p[i];
+            } else if (d < 0) {
+                buckets[-d - 1] -= p[i];
+            }
+        }
+    }
+};
+
+// pippenger() over any group: P accumulates, with += and -= of a Q, += of a P
+// and dbl(); Q is the input point, with unary minus. prepare(part, count,
+// scratch) readies a chunk of the inputs (signs already applied) in place for
+// the bucket additions, as Point::batch_normalize does for pippenger().
+// accumulate(p, digits, windows, window, first, last, buckets, count, scratch)
+// fills the count buckets of one window from points first to last, as
+// MsmDirect does. identity is the zero of P. Every buffer is on scratch or,
+// inside the tasks, on Scratch::local() of the thread running them.
+template <typename P, typename Q, typename Prepare, typename Accumulate>
+P bucket_msm(const std::vector<integer>& scalars, const std::vector<Q>& points, std::size_t c, const P& identity,
+             Prepare prepare, Accumulate accumulate, const msm_executor& executor, std::size_t parallelism,
+             Scratch& scratch) {
+    if (points.empty() || scalars.size() != points.size()) {
+        throw std::invalid_argument("Need as many scalars as points, at least one");
+    }
+    if (c < 1 || c > 24) {
+        throw std::invalid_argument("Pippenger window must be between 1 and 24 bits");
+    }
+    const std::size_t n = points.size();
+    // one more bit, so that the top digit takes the last carry
+    const std::size_t windows = msm_max_bits(scalars) / c + 1;
+    parallelism = std::max<std::size_t>(parallelism, 1);
+    const std::size_t ranges = std::max<std::size_t>(1, std::min((parallelism + windows - 1) / windows,
+                                                                  n >> c));
+    const std::size_t range = (n + ranges - 1) / ranges;
+
+    // negative scalars move their sign to the point. Chunks of at least
+    // MIN_CHUNK points, as preparing one may pay for an inversion
+    static constexpr std::size_t MIN_CHUNK = 256;
+    Scratch::Frame frame(scratch);
+    Scratch::vector<Q> p(points.begin(), points.end(), &scratch);
+    Scratch::vector<int> digits(n * windows, 0, &scratch);
+    const std::size_t chunks = std::max<std::size_t>(1, std::min(parallelism, n / MIN_CHUNK));
+    const std::size_t chunk = (n + chunks - 1) / chunks;
+    msm_run_tasks(executor, chunks, [&](std::size_t t) {
+        ECC_TRACE_SPAN("msm.digits");
+        const std::size_t first = t * chunk, last = std::min(n, first + chunk);
+        if (first >= last) {
+            return;
+        }
+        for (std::size_t i = first; i < last; i++) {
+            if (scalars[i] < 0) {
+                p[i] = -p[i];
+            }
+            msm_signed_digits(scalars[i] < 0 ? -scalars[i] : scalars[i], c, windows, &digits[i * windows]);
+        }
+        prepare(&p[first], last - first, Scratch::local());
+    });
+
+    // sum of digit(i) * p[i] over one range of points for one window, then
+    // the sum of (j + 1) * buckets[j] as a sum of running sums from the top
+    Scratch::vector<P> sums(windows * ranges, identity, &scratch);
+    msm_run_tasks(executor, windows * ranges, [&](std::size_t t) {
+        ECC_TRACE_SPAN("msm.buckets");
+        const std::size_t window = t / ranges;
+        const std::size_t first = (t % ranges) * range, last = std::min(n, first + range);
+        Scratch& local = Scratch::local();
+        Scratch::Frame task_frame(local);
+        Scratch::vector<P> buckets(std::size_t(1) << (c - 1), identity, &local);
+        accumulate(p.data(), digits.data(), windows, window, first, last, buckets.data(), buckets.size(), local);
+        P running = identity, sum = identity;
+        for (std::size_t j = buckets.size(); j > 0; j--) {
+            running += buckets[j - 1];
+            sum += running;
+        }
+        sums[t] = sum;
+    });
+
+    ECC_TRACE_SPAN("msm.combine");
+    P r = identity;
+    for (std::size_t i = windows; i > 0; i--) {
+        for (std::size_t j = 0; j < c; j++) {
+            r = r.dbl();
+        }
+        for (std::size_t j = 0; j < ranges; j++) {
+            r += sums[(i - 1) * ranges + j];
+        }
+    }
+    return r;
+}
+
+template <typename P, typename Q, typename Prepare>
+P bucket_msm(const std::vector<integer>& scalars, const std::vector<Q>& points, std::size_t c, const P& identity,
+             Prepare prepare, const msm_executor& executor, std::size_t parallelism, Scratch& scratch) {
+    return bucket_msm(scalars, points, c, identity, prepare, MsmDirect(), executor, parallelism, scratch);
+}
+
+// Multi-scalar multiplication over points fixed in advance and used again and
+// again, as the powers of tau of a KZG setup or the generators of a Pedersen
+// vector commitment are: Pippenger with the shifts of the windows
+// precomputed. With stride s, the table keeps 2^(c s j) points[i] for every
+// s-th window j, normalized, and mul takes s rounds, round r adding the
+// digits of windows r, r + s, r + 2 s, .. into one set of 2^(c - 1) buckets,
+// with c doublings of the total between rounds: n (bits / c + 1) mixed
+// additions, s bucket sums of 2^c and (s - 1) c doublings, where pippenger()
+// pays bits doublings and a bucket sum per window. Stride 1 has no doublings
+// and the largest table, n (bits / c + 1) points; every doubling of the
+// stride halves the table for c more doublings and one more bucket sum a
+// call. Building takes n bits doublings. Build once and share; mul is const.
+class FixedBaseMsm {
+public:
+    // tables for scalars below 2^bits in windows of c bits (1 to 24), or of
+    // the c with the fewest additions for c = 0, keeping every stride-th
+    // window, built on threads threads. Throws std::invalid_argument for no
+    // points or stride 0
+    FixedBaseMsm(const std::vector<Point>& points, std::size_t bits, std::size_t c = 0, unsigned threads = 1,
+                 std::size_t stride = 1);
+    // over points[0], .., points[count - 1], a slice of a longer generator set
+    // without copying it first
+    FixedBaseMsm(const Point* points, std::size_t count, std::size_t bits, std::size_t c = 0, unsigned threads = 1,
+                 std::size_t stride = 1);
+
+    std::size_t size() const { return this->n; }
+    std::size_t bits() const { return this->max_bits; }
+    std::size_t window() const { return this->c; }
+    std::size_t stride() const { return this->s; }
+    // the points the table keeps, n ceil((bits / c + 1) / stride)
+    std::size_t table_size() const { return this->table.size(); }
+
+    // the sum of scalars[i] * points[i] for |scalars[i]| < 2^bits; fewer
+    // scalars than points take the first points. Throws std::invalid_argument
+    // for no scalars, more scalars than points or one out of range
+    Point mul(const std::vector<integer>& scalars, unsigned threads = 1) const;
+    Point mul(const std::vector<integer>& scalars, Executor& executor) const;
+
+private:
+    std::size_t n;
+    std::size_t max_bits;
+    std::size_t c;
+    std::size_t s;
+    std::size_t windows;
+    // the windows the table keeps per point, ceil(windows / s)
+    std::size_t rows;
+    // 2^(c s j) points[i] at i * rows + j
+    std::vector<Point> table;
+};
+
+// the c minimizing FixedBaseMsm's cost for n points, scalars of bits bits
+// and the given stride: additions, bucket sums and doublings between rounds
+std::size_t fixed_base_window(std::size_t n, std::size_t bits, std::size_t stride = 1);
+
+#endif //ECC_MSM_H
@@ -0,0 +1,160 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <atomic>
+#include <stdexcept>
+
+#include "msm.h"
+#include "msm_backend.h"
+
+namespace {
+
+std::atomic<MsmBackend*> installed(nullptr);
+
+void to_limbs(const integer& value, std::size_t width, limb_t* out) {
+    std::vector<uint8_t> bytes(width * sizeof(limb_t));
+    value.to_bytes(bytes.data(), bytes.size(), integer::endian::little);
+    for (std::size_t j = 0; j < width; j++) {
+        limb_t limb = 0;
+        for (std::size_t b = sizeof(limb_t); b > 0; b--) {
+            limb = (limb << 8) | bytes[j * sizeof(limb_t) + b - 1];
+        }
+        out[j] = limb;
+    }
+}
+
+integer from_limbs(const limb_t* in, std::size_t width) {
+    std::vector<uint8_t> bytes(width * sizeof(limb_t));
+    for (std::size_t i = 0; i < bytes.size(); i++) {
+        bytes[i] = static_cast<uint8_t>(in[i / sizeof(limb_t)] >> (8 * (i % sizeof(limb_t))));
+    }
+    return integer::from_bytes(bytes.data(), bytes.size(), integer::endian::little);
+}
+
+}
+
+void set_msm_backend(MsmBackend* backend) {
+    installed.store(backend);
+}
+
+MsmBackend* msm_backend() {
+    return installed.load();
+}
+
+void msm_stage(const std::vector<integer>& scalars, const std::vector<Point>& points, std::size_t c,
+               MsmBuffers& out) {
+    if (points.empty() || scalars.size() != points.size()) {
+        throw std::invalid_argument("Need as many scalars as points, at least one");
+    }
+    if (c < 1 || c > 24) {
+        throw std::invalid_argument("Pippenger window must be between 1 and 24 bits");
+    }
+    const PrimeField& field = points[0].curve_a().prime_field();
+    const std::size_t n = points.size(), width = (field.bits() + 63) / 64;
+    out.count = n;
+    out.width = width;
+    out.c = c;
+    out.windows = msm_max_bits(scalars) / c + 1;
+    out.prime.resize(width);
+    out.a.resize(width);
+    out.b.resize(width);
+    to_limbs(field.prime(), width, out.prime.data());
+    to_limbs(points[0].curve_a().value(), width, out.a.data());
+    to_limbs(points[0].curve_b().value(), width, out.b.data());
+
+    std::vector<Point> p;
+    p.reserve(n);
+    for (std::size_t i = 0; i < n; i++) {
+        if (points[i].curve_a() != points[0].curve_a() || points[i].curve_b() != points[0].curve_b()) {
+            throw std::runtime_error("Cannot add points on different curves");
+        }
+        p.push_back(scalars[i] < 0 ? points[i].neg() : points[i]);
+    }
+    Point::batch_normalize(p);
+    out.x.resize(n * width);
+    out.y.resize(n * width);
+    out.digits.resize(out.windows * n);
+    std::vector<int> digits(out.windows);
+    for (std::size_t i = 0; i < n; i++) {
+        if (p[i].is_infinity()) {
+            to_limbs(field.prime(), width, &out.x[i * width]);
+            to_limbs(0, width, &out.y[i * width]);
+        } else {
+            const std::pair<FieldElement, FieldElement> xy = p[i].affine();
+            to_limbs(xy.first.value(), width, &out.x[i * width]);
+            to_limbs(xy.second.value(), width, &out.y[i * width]);
+        }
+        msm_signed_digits(scalars[i] < 0 ? -scalars[i] : scalars[i], c, out.windows, digits.data());
+        for (std::size_t w = 0; w < out.windows; w++) {
+            out.digits[w * n + i] = digits[w];
+        }
+    }
+}
+
+Result<Point> msm_combine(const MsmBuffers& in, const limb_t* sums, const Point& curve) noexcept {
+    try {
+        const PrimeField& field = curve.curve_a().prime_field();
+        Point r(curve.curve_a(), curve.curve_b());
+        for (std::size_t w = in.windows; w > 0; w--) {
+            for (std::size_t j = 0; j < in.c; j++) {
+                r = r.dbl();
+            }
+            // checked in Jacobian form, so the windows cost no inversions
+            const limb_t* s = sums + 3 * in.width * (w - 1);
+            const Result<Point> window = Point::make(FieldElement(from_limbs(s, in.width), field),
+                                                     FieldElement(from_limbs(s + in.width, in.width), field),
+                                                     FieldElement(from_limbs(s + 2 * in.width, in.width), field),
+                                                     curve.curve_a(), curve.curve_b());
+            if (!window) {
+                return window.status();
+            }
+            r += *window;
+        }
+        return r;
+    } catch (...) {
+        // a coordinate not below the prime
+        return Status::not_on_curve;
+    }
+}
+
+bool HostMsmBackend::window_sums(const MsmBuffers& in, limb_t* sums) {
+    const PrimeField& field = PrimeField::get(from_limbs(in.prime.data(), in.width));
+    const FieldElement a(from_limbs(in.a.data(), in.width), field), b(from_limbs(in.b.data(), in.width), field);
+    const integer prime = field.prime();
+    std::vector<Point> p;
+    p.reserve(in.count);
+    for (std::size_t i = 0; i < in.count; i++) {
+        const integer x = from_limbs(&in.x[i * in.width], in.width);
+        p.push_back(x == prime ? Point(a, b) : Point(FieldElement(x, field),
+                                                      FieldElement(from_limbs(&in.y[i * in.width], in.width), field),
+                                                      a, b));
+    }
+    for (std::size_t w = 0; w < in.windows; w++) {
+        std::vector<Point> buckets(std::size_t(1) << (in.c - 1), Point(a, b));
+        for (std::size_t i = 0; i < in.count; i++) {
+            const int32_t d = in.digits[w * in.count + i];
+            if (d > 0) {
+                buckets[d - 1] += p[i];
+            } else if (d < 0) {
+                buckets[-d - 1] -= p[i];
+            }
+        }
+        Point running(a, b), sum(a, b);
+        for (std::size_t j = buckets.size(); j > 0; j--) {
+            running += buckets[j - 1];
+            sum += running;
+        }
+        limb_t* out = sums + 3 * in.width * w;
+        if (sum.is_infinity()) {
+            to_limbs(1, in.width, out);
+            to_limbs(1, in.width, out + in.width);
+            to_limbs(0, in.width, out + 2 * in.width);
+        } else {
+            const std::pair<FieldElement, FieldElement> xy = sum.affine();
+            to_limbs(xy.first.value(), in.width, out);
+            to_limbs(xy.second.value(), in.width, out + in.width);
+            to_limbs(1, in.width, out + 2 * in.width);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,80 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_MSM_BACKEND_H
+#define ECC_MSM_BACKEND_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "integer.h"
+#include "limb.h"
+#include "Point.h"
+
+// The seam for running large multi-scalar multiplications on another device.
+// The host stages the inputs as flat arrays a kernel reads without any of
+// this library's types, the backend returns one bucket-method sum per window,
+// and the host adds the windows up (bits / c doublings, nothing next to the
+// bucket additions). multi_scalar_mul hands an input of min_points() or more
+// to the installed backend and goes on with its own Pippenger when there is
+// none or it declines.
+//
+// All values are plain (not Montgomery) residues in little-endian limbs, width
+// limbs each, so a device is free to pick its own representation.
+struct MsmBuffers {
+    std::size_t count = 0;          // points
+    std::size_t width = 0;          // limbs per value
+    std::size_t c = 0;              // window bits
+    std::size_t windows = 0;
+    std::vector<limb_t> prime, a, b;
+    // affine coordinates of point i at [i * width, (i + 1) * width), already
+    // negated where its scalar is negative; the point at infinity has x = prime
+    std::vector<limb_t> x, y;
+    // the c-bit signed digits of |scalar i| (msm_signed_digits), window-major
+    // so that the threads of one window read consecutive digits: digit w of
+    // point i at w * count + i
+    std::vector<int32_t> digits;
+};
+
+// the buffers for sum scalars[i] * points[i] in windows of c bits, the points
+// normalized with one inversion; throws std::invalid_argument as pippenger does
+void msm_stage(const std::vector<integer>& scalars, const std::vector<Point>& points, std::size_t c,
+               MsmBuffers& out);
+// sum over w of 2^(c w) S_w for the window sums S_w the backend wrote to sums:
+// Jacobian X, Y, Z, 3 * width limbs per window, Z = 0 for infinity.
+// Status::not_on_curve if one of them is not a point of the curve
+Result<Point> msm_combine(const MsmBuffers& in, const limb_t* sums, const Point& curve) noexcept;
+
+class MsmBackend {
+public:
+    virtual ~MsmBackend() = default;
+    virtual const char* name() const = 0;
+    // the fewest points worth the transfers
+    virtual std::size_t min_points() const = 0;
+    // writes S_w = sum over i of digit(w, i) * point i for every window, as
+    // msm_combine reads them; false to leave the work to the host. Called from
+    // any thread, possibly from several at once
+    virtual bool window_sums(const MsmBuffers& in, limb_t* sums) = 0;
+};
+
+// the backend multi_scalar_mul offloads to, or null (the default) for none;
+// the backend must outlive its installation
+void set_msm_backend(MsmBackend* backend);
+MsmBackend* msm_backend();
+
+// window_sums computed on the host from the buffers alone, bucket by bucket
+// as a device kernel would: the reference a device port is checked against
+class HostMsmBackend : public MsmBackend {
+public:
+    explicit HostMsmBackend(std::size_t min_points = 1) : least(min_points) {}
+    const char* name() const override { return "host"; }
+    std::size_t min_points() const override { return this->least; }
+    bool window_sums(const MsmBuffers& in, limb_t* sums) override;
+
+private:
+    std::size_t least;
+};
+
+#endif //ECC_MSM_BACKEND_H
@@ -0,0 +1,170 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <exception>
+
+#include "chacha20.h"
+#include "muhash.h"
+#include "sha256.h"
+
+namespace {
+
+// p = 2^3072 - 1103717
+uint3072 prime() {
+    uint3072 p;
+    for (limb_t& l : p.limb) {
+        l = ~limb_t(0);
+    }
+    p.limb[0] -= Num3072::PRIME_DIFF - 1;
+    return p;
+}
+
+}
+
+uint3072 Num3072::reduce_once(const uint3072& a) {
+    // a >= p exactly when a + 1103717 carries out of 2^3072, and then the sum
+    // without the carry is a - p
+    uint3072 s;
+    const limb_t carry = uint3072::add(s, a, uint3072(PRIME_DIFF));
+    return uint3072::select(0 - carry, s, a);
+}
+
+Num3072 Num3072::reduce(const fixed_uint <96>& wide) {
+    // lo + hi * 2^3072 = lo + hi * 1103717: 48 limbs and a top limb under 2^22
+    uint3072 r;
+    limb_t mul_carry = 0, add_carry = 0;
+    for (std::size_t i = 0; i < 48; i++) {
+        const limb_t t = limb_mac(wide.limb[48 + i], PRIME_DIFF, 0, mul_carry);
+        r.limb[i] = limb_addc(wide.limb[i], t, add_carry);
+    }
+    // the top (mul_carry + add_carry) * 2^3072, folded once more; a carry out
+    // of that leaves a value below 2^22 * 1103717, and one more fold cannot carry
+    limb_t top = mul_carry + add_carry;
+    for (int round = 0; round < 2; round++) {
+        limb_t hi = 0, carry = 0;
+        const limb_t lo = limb_mul(top, PRIME_DIFF, hi);
+        r.limb[0] = limb_addc(r.limb[0], lo, carry);
+        r.limb[1] = limb_addc(r.limb[1], hi, carry);
+        for (std::size_t i = 2; i < 48; i++) {
+            r.limb[i] = limb_addc(r.limb[i], 0, carry);
+        }
+        top = carry;
+    }
+    return Num3072(reduce_once(r));
+}
+
+Num3072 Num3072::from_bytes(const uint8_t* in) {
+    return Num3072(reduce_once(uint3072::load_le(in, BYTE_SIZE)));
+}
+
+Num3072 Num3072::operator*(const Num3072& other) const {
+    return reduce(uint3072::mul_wide(this->v, other.v));
+}
+
+Num3072 Num3072::square() const {
+    return reduce(uint3072::sqr_wide(this->v));
+}
+
+Num3072 Num3072::inverse() const {
+    static const uint3072 p = prime();
+    if (this->v.is_zero()) {
+        return Num3072(uint3072(0));
+    }
+    return Num3072(uint3072::modinv_ct(this->v, p));
+}
+
+Num3072 MuHash3072::element(const uint8_t* data, std::size_t len) {
+    uint8_t key[Sha256::DIGEST_SIZE];
+    Sha256::hash(data, len, key);
+    uint32_t words[8];
+    for (std::size_t i = 0; i < 8; i++) {
+        words[i] = static_cast<uint32_t>(key[4 * i]) | (static_cast<uint32_t>(key[4 * i + 1]) << 8) |
+                   (static_cast<uint32_t>(key[4 * i + 2]) << 16) | (static_cast<uint32_t>(key[4 * i + 3]) << 24);
+    }
+    static const uint32_t nonce[2] = {0, 0};
+    uint8_t stream[Num3072::BYTE_SIZE];
+    chacha20_blocks(stream, words, 0, nonce, Num3072::BYTE_SIZE / 64);
+    return Num3072::from_bytes(stream);
+}
+
+MuHash3072::MuHash3072(const uint8_t* data, std::size_t len) : numerator(element(data, len)) {
+}
+
+MuHash3072& MuHash3072::insert(const uint8_t* data, std::size_t len) {
+    this->numerator *= element(data, len);
+    return *this;
+}
+
+MuHash3072& MuHash3072::remove(const uint8_t* data, std::size_t len) {
+    this->denominator *= element(data, len);
+    return *this;
+}
+
+MuHash3072& MuHash3072::operator*=(const MuHash3072& other) {
+    this->numerator *= other.numerator;
+    this->denominator *= other.denominator;
+    return *this;
+}
+
+MuHash3072& MuHash3072::operator/=(const MuHash3072& other) {
+    this->numerator *= other.denominator;
+    this->denominator *= other.numerator;
+    return *this;
+}
+
+void MuHash3072::finalize(uint8_t* out) const {
+    uint8_t bytes[Num3072::BYTE_SIZE];
+    (this->numerator * this->denominator.inverse()).to_bytes(bytes);
+    Sha256::hash(bytes, sizeof(bytes), out);
+}
+
+void MuHash3072::serialize(uint8_t* out) const {
+    this->numerator.to_bytes(out);
+    this->denominator.to_bytes(out + Num3072::BYTE_SIZE);
+}
+
+Result<MuHash3072> MuHash3072::deserialize(const uint8_t* in, std::size_t len) noexcept {
+    if (len != STATE_SIZE) {
+        return Status::bad_encoding;
+    }
+    static const uint3072 p = prime();
+    if (!uint3072::all_below_le(in, 2, Num3072::BYTE_SIZE, p)) {
+        return Status::out_of_range;
+    }
+    MuHash3072 h;
+    h.numerator = Num3072::from_bytes(in);
+    h.denominator = Num3072::from_bytes(in + Num3072::BYTE_SIZE);
+    return h;
+}
+
+MuHash3072 MuHash3072::of(const std::vector<std::string>& items, unsigned threads) {
+    ThreadExecutor executor(threads);
+    return of(items, executor);
+}
+
+MuHash3072 MuHash3072::of(const std::vector<std::string>& items, Executor& executor) {
+    const std::size_t parts = std::max<std::size_t>(1, std::min(executor.concurrency(), items.size()));
+    const std::size_t part = (items.size() + parts - 1) / parts;
+    std::vector<MuHash3072> states(parts);
+    std::vector<std::exception_ptr> errors(parts);
+    executor.run(parts, [&](std::size_t t) {
+        try {
+            for (std::size_t i = t * part; i < std::min(items.size(), (t + 1) * part); i++) {
+                states[t].insert(reinterpret_cast<const uint8_t*>(items[i].data()), items[i].size());
+            }
+        } catch (...) {
+            errors[t] = std::current_exception();
+        }
+    });
+    for (const std::exception_ptr& e : errors) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+    MuHash3072 h;
+    for (const MuHash3072& s : states) {
+        h *= s;
+    }
+    return h;
+}
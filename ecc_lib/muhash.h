@@ -0,0 +1,106 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_MUHASH_H
+#define ECC_MUHASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Executor.h"
+#include "Status.h"
+#include "uint256.h"
+
+typedef fixed_uint <48> uint3072;
+
+// An element of the integers mod the safe prime p = 2^3072 - 1103717, in 48
+// limbs and always below p. Products are taken in full (fixed_uint's
+// mul_wide, sqr_wide for squares) and reduced by folding, as 2^3072 = 1103717
+// mod p: the high half times 1103717 added to the low half twice, then one
+// conditional subtraction of p with a mask. Inverses are fixed_uint's
+// constant-time safegcd.
+class Num3072 {
+public:
+    static constexpr std::size_t BYTE_SIZE = 384;
+    static constexpr limb_t PRIME_DIFF = 1103717;
+
+    // one
+    Num3072() : v(1) {}
+    // the little-endian in[0, 384) mod p
+    static Num3072 from_bytes(const uint8_t* in);
+    // the value, little-endian, in out[0, 384)
+    void to_bytes(uint8_t* out) const { this->v.store_le(out, BYTE_SIZE); }
+    const uint3072& value() const { return this->v; }
+
+    Num3072 operator*(const Num3072& other) const;
+    Num3072& operator*=(const Num3072& other) { return *this = *this * other; }
+    Num3072 square() const;
+    // 1 / *this; zero for zero
+    Num3072 inverse() const;
+
+    friend bool operator==(const Num3072& lhs, const Num3072& rhs) { return lhs.v == rhs.v; }
+    friend bool operator!=(const Num3072& lhs, const Num3072& rhs) { return !(lhs == rhs); }
+
+private:
+    uint3072 v;
+
+    explicit Num3072(const uint3072& v) : v(v) {}
+    // a below 2^3072 (at most p + 1103716) down to below p
+    static uint3072 reduce_once(const uint3072& a);
+    static Num3072 reduce(const fixed_uint <96>& wide);
+};
+
+// MuHash3072, the multiset hash of Bitcoin Core's UTXO-set commitments
+// (Maitin-Shepard, Tibouchi and Aranha, "Elliptic Curve Multiset Hash"; the
+// multiplicative variant of Clarke et al.): every item maps to the Num3072 of
+// the 384-byte ChaCha20 keystream, nonce and counter zero, under the key
+// SHA-256(item), and a set hashes to the product of its items' elements, so
+// the order of insertions does not matter. Removals multiply a separate
+// denominator, so neither costs an inversion; finalize() pays the one
+// inversion and hashes numerator / denominator, its 384 little-endian bytes,
+// with SHA-256. States of disjoint parts of a set multiply together, so a
+// set can be hashed in parallel and the parts combined.
+class MuHash3072 {
+public:
+    static constexpr std::size_t DIGEST_SIZE = 32;
+    // numerator then denominator, each Num3072::BYTE_SIZE little-endian bytes
+    static constexpr std::size_t STATE_SIZE = 2 * Num3072::BYTE_SIZE;
+
+    // the empty set
+    MuHash3072() = default;
+    // the set of the one item data[0, len)
+    MuHash3072(const uint8_t* data, std::size_t len);
+
+    MuHash3072& insert(const uint8_t* data, std::size_t len);
+    MuHash3072& remove(const uint8_t* data, std::size_t len);
+    // the union of the two multisets
+    MuHash3072& operator*=(const MuHash3072& other);
+    // the items of other taken out again
+    MuHash3072& operator/=(const MuHash3072& other);
+
+    // the hash of the set in out[0, 32)
+    void finalize(uint8_t* out) const;
+
+    // the state as it stands, to be resumed by deserialize
+    void serialize(uint8_t* out) const;
+    // Status::bad_encoding for a len other than STATE_SIZE, Status::out_of_range
+    // for a value not below p
+    static Result<MuHash3072> deserialize(const uint8_t* in, std::size_t len) noexcept;
+
+    // the set of items, cut into one part per executor.concurrency() whose
+    // states are multiplied together at the end; threads runs the parts on a
+    // ThreadExecutor of that many threads
+    static MuHash3072 of(const std::vector<std::string>& items, unsigned threads = 1);
+    static MuHash3072 of(const std::vector<std::string>& items, Executor& executor);
+
+    // the element of the item data[0, len)
+    static Num3072 element(const uint8_t* data, std::size_t len);
+
+private:
+    Num3072 numerator, denominator;
+};
+
+#endif //ECC_MUHASH_H
@@ -0,0 +1,532 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstring>
+#include <random>
+#include <stdexcept>
+
+#include "chacha20.h"
+#include "Curve.h"
+#include "decompress.h"
+#include "metrics.h"
+#include "msm.h"
+#include "musig.h"
+#include "sec1.h"
+#include "tagged_hash.h"
+#include "trace.h"
+
+struct MusigKeyAgg::KeySet {
+    std::vector<uint8_t> keys;      // 33 bytes each, in the order given
+    std::vector<Point> points;
+    std::vector<Scalar> coefficients;
+    // the first index of every distinct key
+    std::map<std::array<uint8_t, 33>, std::size_t> index;
+};
+
+namespace {
+
+const Sha256Tag& list_tag() {
+    static const Sha256Tag& tag = Sha256Tag::named("KeyAgg list");
+    return tag;
+}
+
+const Sha256Tag& coefficient_tag() {
+    static const Sha256Tag& tag = Sha256Tag::named("KeyAgg coefficient");
+    return tag;
+}
+
+const Sha256Tag& aux_tag() {
+    static const Sha256Tag& tag = Sha256Tag::named("MuSig/aux");
+    return tag;
+}
+
+const Sha256Tag& nonce_tag() {
+    static const Sha256Tag& tag = Sha256Tag::named("MuSig/nonce");
+    return tag;
+}
+
+const Sha256Tag& nonce_coefficient_tag() {
+    static const Sha256Tag& tag = Sha256Tag::named("MuSig/noncecoef");
+    return tag;
+}
+
+// L = hash_KeyAgg list(pk_1 || .. || pk_n)
+void hash_list(const uint8_t* keys, std::size_t count, uint8_t* out) {
+    TaggedHash(list_tag()).update(keys, 33 * count).finish(out);
+}
+
+// whether the normalized point p has even y
+bool even_y(const Point& p) {
+    return !p.y().value().test_bit(0);
+}
+
+void compressed(const Point& p, uint8_t* out) {
+    sec1_encode(p, true, out, 33);
+}
+
+// cpoint of BIP327: a compressed key
+Result<Point> decode(const uint8_t* key) {
+    Result<Point> p = sec1_decode(key, 33, Curve::secp256k1());
+    if (!p) {
+        return p.status() == Status::out_of_range ? Status::bad_encoding : Status::not_on_curve;
+    }
+    return p;
+}
+
+// cpoint_ext: a compressed key, or 33 zero bytes for infinity
+Result<Point> decode_ext(const uint8_t* key) {
+    static const uint8_t zeros[33] = {0};
+    if (std::memcmp(key, zeros, 33) == 0) {
+        return Point(Curve::secp256k1().a(), Curve::secp256k1().b());
+    }
+    return decode(key);
+}
+
+void encode_ext(const Point& p, uint8_t* out) {
+    if (p.is_infinity()) {
+        std::memset(out, 0, 33);
+    } else {
+        compressed(p, out);
+    }
+}
+
+// the nonce k_i of NonceGen
+Scalar nonce(const uint8_t* seed, const uint8_t* public_key, const uint8_t* aggregate_key, const uint8_t* message,
+             std::size_t len, const uint8_t* extra, std::size_t extra_len, uint8_t i) {
+    TaggedHash h(nonce_tag());
+    const uint8_t key_len = 33, aggregate_len = aggregate_key ? 32 : 0;
+    h.update(seed, 32).update(&key_len, 1).update(public_key, 33).update(&aggregate_len, 1);
+    if (aggregate_key) {
+        h.update(aggregate_key, 32);
+    }
+    // the message prefixed by 1 and its length in 8 bytes, or 0 when absent
+    const uint8_t present = message ? 1 : 0;
+    h.update(&present, 1);
+    if (message) {
+        uint8_t length[8];
+        for (std::size_t j = 0; j < 8; j++) {
+            length[j] = static_cast<uint8_t>(static_cast<uint64_t>(len) >> (8 * (7 - j)));
+        }
+        h.update(length, 8).update(message, len);
+    }
+    uint8_t length[4];
+    for (std::size_t j = 0; j < 4; j++) {
+        length[j] = static_cast<uint8_t>(static_cast<uint64_t>(extra_len) >> (8 * (3 - j)));
+    }
+    h.update(length, 4);
+    if (extra) {
+        h.update(extra, extra_len);
+    }
+    uint8_t digest[32];
+    h.update(&i, 1).finish(digest);
+    return Scalar::from_bytes(digest, 32, Curve::secp256k1().scalar_field());
+}
+
+}
+
+MusigKeyAgg::MusigKeyAgg(std::shared_ptr<const KeySet> keys, const Point& q, const Scalar& gacc, const Scalar& tacc)
+        : keys(std::move(keys)), q(q), gacc(gacc), tacc(tacc) {}
+
+Result<MusigKeyAgg> MusigKeyAgg::aggregate(const uint8_t* keys, std::size_t count, unsigned threads) {
+    ThreadExecutor executor(threads);
+    return aggregate(keys, count, executor);
+}
+
+Result<MusigKeyAgg> MusigKeyAgg::aggregate(const uint8_t* keys, std::size_t count, Executor& executor) {
+    if (count == 0) {
+        throw std::invalid_argument("MuSig2 needs at least one key");
+    }
+    uint8_t list[32];
+    hash_list(keys, count, list);
+    return aggregate(keys, count, list, executor);
+}
+
+Result<MusigKeyAgg> MusigKeyAgg::aggregate(const uint8_t* keys, std::size_t count, const uint8_t* list,
+                                           Executor& executor) {
+    ECC_TRACE_SPAN("musig.key_agg");
+    const Curve& curve = Curve::secp256k1();
+    const PrimeField& order = curve.scalar_field();
+    auto set = std::make_shared<KeySet>();
+    set->keys.assign(keys, keys + 33 * count);
+    DecompressedKeys lifted = decompress_keys(keys, count, curve, executor);
+    if (lifted.invalid_count()) {
+        return Status::not_on_curve;
+    }
+    set->points = std::move(lifted.points);
+
+    // a_i = 1 for the first key unlike the first, hash_KeyAgg coefficient(L || pk_i) for the rest
+    const uint8_t* second = nullptr;
+    for (std::size_t i = 1; i < count && !second; i++) {
+        if (std::memcmp(keys + 33 * i, keys, 33) != 0) {
+            second = keys + 33 * i;
+        }
+    }
+    set->coefficients.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+        std::array<uint8_t, 33> key;
+        std::memcpy(key.data(), keys + 33 * i, 33);
+        const auto [it, added] = set->index.emplace(key, i);
+        if (!added) {
+            set->coefficients.push_back(set->coefficients[it->second]);
+        } else if (second && std::memcmp(key.data(), second, 33) == 0) {
+            set->coefficients.emplace_back(1, order);
+        } else {
+            uint8_t digest[32];
+            TaggedHash(coefficient_tag()).update(list, 32).update(key.data(), 33).finish(digest);
+            set->coefficients.push_back(Scalar::from_bytes(digest, 32, order));
+        }
+    }
+
+    std::vector<integer> scalars;
+    scalars.reserve(count);
+    for (const Scalar& a : set->coefficients) {
+        scalars.push_back(a.value());
+    }
+    const Point q = multi_scalar_mul(scalars, set->points, executor);
+    if (q.is_infinity()) {
+        return Status::infinity;
+    }
+    return MusigKeyAgg(std::move(set), q.normalized(), Scalar(1, order), Scalar(order));
+}
+
+Result<MusigKeyAgg> MusigKeyAgg::tweak(const uint8_t* tweak, bool x_only) const {
+    const Curve& curve = Curve::secp256k1();
+    const uint256 t = uint256::load_be(tweak, 32);
+    if (!(t < curve.scalar_field().fixed_prime())) {
+        return Status::out_of_range;
+    }
+    const bool negate = x_only && !even_y(this->q);
+    const Point q = (negate ? -this->q : this->q) + curve.mul_base(t.to_integer());
+    if (q.is_infinity()) {
+        return Status::infinity;
+    }
+    const Scalar ts(t.to_integer(), curve.scalar_field());
+    return MusigKeyAgg(this->keys, q.normalized(), negate ? -this->gacc : this->gacc,
+                       ts + (negate ? -this->tacc : this->tacc));
+}
+
+void MusigKeyAgg::x_only(uint8_t* out) const {
+    this->q.x().to_bytes(out, 32);
+}
+
+std::size_t MusigKeyAgg::size() const {
+    return this->keys->points.size();
+}
+
+std::size_t MusigKeyAgg::find(const uint8_t* key) const {
+    std::array<uint8_t, 33> k;
+    std::memcpy(k.data(), key, 33);
+    const auto it = this->keys->index.find(k);
+    return it == this->keys->index.end() ? this->size() : it->second;
+}
+
+MusigKeyAggCache::MusigKeyAggCache(std::size_t capacity) : capacity(capacity) {
+    if (capacity == 0) {
+        throw std::invalid_argument("MuSig2 key cache capacity must be positive");
+    }
+}
+
+Result<MusigKeyAgg> MusigKeyAggCache::aggregate(const uint8_t* keys, std::size_t count, unsigned threads) {
+    ThreadExecutor executor(threads);
+    return aggregate(keys, count, executor);
+}
+
+Result<MusigKeyAgg> MusigKeyAggCache::aggregate(const uint8_t* keys, std::size_t count, Executor& executor) {
+    static Metrics::Counter& hit_count = Metrics::global().counter("ecc_musig_key_agg_hits_total",
+                                                                   "MuSig2 key sets aggregated from the cache");
+    static Metrics::Counter& miss_count = Metrics::global().counter("ecc_musig_key_agg_misses_total",
+                                                                    "MuSig2 key sets aggregated for the cache");
+    if (count == 0) {
+        throw std::invalid_argument("MuSig2 needs at least one key");
+    }
+    Key key;
+    hash_list(keys, count, key.data());
+    // the same hash of another list cannot be found, but is checked for
+    const auto same = [&](const MusigKeyAgg& agg) {
+        return agg.keys->keys.size() == 33 * count && std::memcmp(agg.keys->keys.data(), keys, 33 * count) == 0;
+    };
+    {
+        std::lock_guard<std::mutex> guard(this->lock);
+        const auto it = this->entries.find(key);
+        if (it != this->entries.end() && same(it->second->agg)) {
+            this->order.splice(this->order.begin(), this->order, it->second);
+            this->hits.fetch_add(1, std::memory_order_relaxed);
+            hit_count.add();
+            return it->second->agg;
+        }
+    }
+
+    // aggregated outside the lock, like KeyTableCache's tables
+    Result<MusigKeyAgg> agg = MusigKeyAgg::aggregate(keys, count, key.data(), executor);
+    this->misses.fetch_add(1, std::memory_order_relaxed);
+    miss_count.add();
+    if (!agg) {
+        return agg;
+    }
+    std::lock_guard<std::mutex> guard(this->lock);
+    if (this->entries.count(key)) {
+        return agg;
+    }
+    while (this->order.size() >= this->capacity) {
+        this->entries.erase(this->order.back().key);
+        this->order.pop_back();
+    }
+    this->order.push_front(Entry{key, *agg});
+    this->entries.emplace(key, this->order.begin());
+    return agg;
+}
+
+void MusigKeyAggCache::clear() {
+    std::lock_guard<std::mutex> guard(this->lock);
+    this->entries.clear();
+    this->order.clear();
+}
+
+MusigKeyAggCache::Stats MusigKeyAggCache::stats() const {
+    std::lock_guard<std::mutex> guard(this->lock);
+    return {this->hits.load(std::memory_order_relaxed), this->misses.load(std::memory_order_relaxed),
+            this->entries.size()};
+}
+
+Status musig_nonce_gen(uint8_t* secnonce, uint8_t* pubnonce, const uint8_t* rand, const uint8_t* secret,
+                       const uint8_t* public_key, const uint8_t* aggregate_key, const uint8_t* message,
+                       std::size_t len, const uint8_t* extra, std::size_t extra_len) noexcept {
+    const Curve& curve = Curve::secp256k1();
+    // rand' itself, or the secret xor hash_MuSig/aux(rand')
+    uint8_t seed[32];
+    if (secret) {
+        TaggedHash(aux_tag()).update(rand, 32).finish(seed);
+        for (std::size_t i = 0; i < 32; i++) {
+            seed[i] ^= secret[i];
+        }
+    } else {
+        std::memcpy(seed, rand, 32);
+    }
+    for (uint8_t i = 0; i < 2; i++) {
+        const Scalar k = nonce(seed, public_key, aggregate_key, message, len, extra, extra_len, i);
+        if (k.is_zero()) {
+            return Status::out_of_range;
+        }
+        compressed(curve.mul_base_ct(k.value()), pubnonce + 33 * i);
+        k.to_bytes(secnonce + 32 * i);
+    }
+    std::memcpy(secnonce + 64, public_key, 33);
+    return Status::ok;
+}
+
+Status musig_nonce_agg(uint8_t* aggnonce, const uint8_t* pubnonces, std::size_t count, std::size_t* culprit) {
+    if (count == 0) {
+        throw std::invalid_argument("MuSig2 needs at least one nonce");
+    }
+    const Curve& curve = Curve::secp256k1();
+    // R1 and R2 of every nonce, one after the other
+    const DecompressedKeys lifted = decompress_keys(pubnonces, 2 * count, curve);
+    Point r1(curve.a(), curve.b()), r2 = r1;
+    for (std::size_t i = 0; i < count; i++) {
+        if (!lifted.valid(2 * i) || !lifted.valid(2 * i + 1)) {
+            if (culprit) {
+                *culprit = i;
+            }
+            return Status::not_on_curve;
+        }
+        r1 += lifted.points[2 * i];
+        r2 += lifted.points[2 * i + 1];
+    }
+    encode_ext(r1, aggnonce);
+    encode_ext(r2, aggnonce + 33);
+    return Status::ok;
+}
+
+MusigSession::MusigSession(const MusigKeyAgg& key, const Scalar& b, const Scalar& e, const Scalar& e_key,
+                           const uint8_t* rx, bool r_even)
+        : key(key), b(b), e(e), e_key(e_key), r_even(r_even) {
+    std::memcpy(this->rx, rx, 32);
+}
+
+Result<MusigSession> MusigSession::start(const MusigKeyAgg& key, const uint8_t* aggnonce, const uint8_t* message,
+                                         std::size_t len) {
+    const Curve& curve = Curve::secp256k1();
+    const PrimeField& order = curve.scalar_field();
+    const Result<Point> r1 = decode_ext(aggnonce), r2 = decode_ext(aggnonce + 33);
+    if (!r1) {
+        return r1.status();
+    }
+    if (!r2) {
+        return r2.status();
+    }
+    uint8_t qx[32], digest[32];
+    key.x_only(qx);
+    // b = hash_MuSig/noncecoef(aggnonce || Q.x || m), R = R1 + b R2 or G at infinity
+    TaggedHash(nonce_coefficient_tag()).update(aggnonce, 66).update(qx, 32).update(message, len).finish(digest);
+    const Scalar b = Scalar::from_bytes(digest, 32, order);
+    Point r = *r1 + *r2 * b.value();
+    r = r.is_infinity() ? curve.generator() : r.normalized();
+    uint8_t rx[32];
+    r.x().to_bytes(rx, 32);
+    TaggedHash(BIP340_CHALLENGE_TAG).update(rx, 32).update(qx, 32).update(message, len).finish(digest);
+    const Scalar e = Scalar::from_bytes(digest, 32, order);
+    const Scalar g = even_y(key.q) ? Scalar(1, order) : -Scalar(1, order);
+    return MusigSession(key, b, e, e * g * key.gacc, rx, even_y(r));
+}
+
+Status MusigSession::sign(uint8_t* partial, uint8_t* secnonce, const uint8_t* secret) const noexcept {
+    const Curve& curve = Curve::secp256k1();
+    const PrimeField& order = curve.scalar_field();
+    const uint256 k1_value = uint256::load_be(secnonce, 32), k2_value = uint256::load_be(secnonce + 32, 32);
+    const uint256 d_value = uint256::load_be(secret, 32);
+    for (const uint256* v : {&k1_value, &k2_value, &d_value}) {
+        if (v->is_zero() || !(*v < order.fixed_prime())) {
+            return Status::out_of_range;
+        }
+    }
+    uint8_t key[33];
+    compressed(curve.mul_base_ct(d_value.to_integer()), key);
+    const std::size_t i = this->key.find(key);
+    if (std::memcmp(key, secnonce + 64, 33) != 0 || i == this->key.size()) {
+        return Status::out_of_range;
+    }
+    // the nonces negated for R of odd y
+    const limb_t mask = 0 - static_cast<limb_t>(!this->r_even);
+    const Scalar k1_prime(k1_value.to_integer(), order), k2_prime(k2_value.to_integer(), order);
+    const Scalar k1 = Scalar::select(mask, -k1_prime, k1_prime), k2 = Scalar::select(mask, -k2_prime, k2_prime);
+    const Scalar d(d_value.to_integer(), order);
+    const Scalar s = k1 + this->b * k2 + this->e_key * this->key.keys->coefficients[i] * d;
+    std::memset(secnonce, 0, 64);
+    s.to_bytes(partial);
+    return Status::ok;
+}
+
+Status MusigSession::verify(const MusigPartial& partial) const noexcept {
+    const Curve& curve = Curve::secp256k1();
+    const PrimeField& order = curve.scalar_field();
+    const uint256 s = uint256::load_be(partial.partial, 32);
+    if (!(s < order.fixed_prime())) {
+        return Status::bad_encoding;
+    }
+    const Result<Point> r1 = decode(partial.pubnonce), r2 = decode(partial.pubnonce + 33);
+    if (!r1) {
+        return r1.status();
+    }
+    if (!r2) {
+        return r2.status();
+    }
+    const std::size_t i = this->key.find(partial.public_key);
+    if (i == this->key.size()) {
+        return Status::out_of_range;
+    }
+    // s G - e a g P against R1 + b R2, negated for R of odd y
+    const Point lhs = Point::mul_add(s.to_integer(), curve.generator(),
+                                     (-(this->e_key * this->key.keys->coefficients[i])).value(),
+                                     this->key.keys->points[i]);
+    const Point r = *r1 + *r2 * this->b.value();
+    return lhs == (this->r_even ? r : -r) ? Status::ok : Status::bad_signature;
+}
+
+Status MusigSession::verify_batch(const std::vector<MusigPartial>& partials, unsigned threads,
+                                  std::size_t* culprit) const {
+    ThreadExecutor executor(threads);
+    return verify_batch(partials, executor, culprit);
+}
+
+Status MusigSession::verify_batch(const std::vector<MusigPartial>& partials, Executor& executor,
+                                  std::size_t* culprit) const {
+    if (partials.empty()) {
+        return Status::ok;
+    }
+    ECC_TRACE_SPAN("musig.verify_batch");
+    const Curve& curve = Curve::secp256k1();
+    const PrimeField& order = curve.scalar_field();
+    const std::size_t count = partials.size();
+    // one by one for the first failure
+    const auto blame = [&]() {
+        for (std::size_t i = 0; i < count; i++) {
+            const Status status = verify(partials[i]);
+            if (status != Status::ok) {
+                if (culprit) {
+                    *culprit = i;
+                }
+                return status;
+            }
+        }
+        return Status::ok;
+    };
+
+    std::vector<uint8_t> nonces(2 * 33 * count);
+    std::vector<std::size_t> index(count);
+    Sha256 seed_hash;
+    std::random_device device;
+    for (std::size_t i = 0; i < 8; i++) {
+        const uint32_t word = device();
+        const uint8_t bytes[4] = {static_cast<uint8_t>(word), static_cast<uint8_t>(word >> 8),
+                                  static_cast<uint8_t>(word >> 16), static_cast<uint8_t>(word >> 24)};
+        seed_hash.update(bytes, 4);
+    }
+    seed_hash.update(this->rx, 32);
+    for (std::size_t i = 0; i < count; i++) {
+        index[i] = this->key.find(partials[i].public_key);
+        if (index[i] == this->key.size() || !(uint256::load_be(partials[i].partial, 32) < order.fixed_prime())) {
+            return blame();
+        }
+        std::memcpy(nonces.data() + 66 * i, partials[i].pubnonce, 66);
+        seed_hash.update(partials[i].partial, 32);
+        seed_hash.update(partials[i].pubnonce, 66);
+        seed_hash.update(partials[i].public_key, 33);
+    }
+    const DecompressedKeys lifted = decompress_keys(nonces.data(), 2 * count, curve, executor);
+    if (lifted.invalid_count()) {
+        return blame();
+    }
+    uint8_t seed[Sha256::DIGEST_SIZE];
+    seed_hash.finish(seed);
+
+    // (sum c_i s_i) G - sum c_i (R1_i + b R2_i) (negated for odd R) - sum c_i e a_i g P_i
+    // for c_1 = 1 and the next c_i 128 bits of ChaCha20 keyed by the seed
+    ChaCha20Rng rng(seed);
+    std::vector<uint8_t> randomizers(16 * count);
+    rng.fill(randomizers.data(), randomizers.size());
+    const Scalar sign = this->r_even ? -Scalar(1, order) : Scalar(1, order);
+    Scalar base(order);
+    std::vector<integer> scalars(1);
+    std::vector<Point> points(1, curve.generator());
+    scalars.reserve(3 * count + 1);
+    points.reserve(3 * count + 1);
+    for (std::size_t i = 0; i < count; i++) {
+        const Scalar c = i ? Scalar::from_bytes(randomizers.data() + 16 * i, 16, order) : Scalar(1, order);
+        base += c * Scalar::from_bytes(partials[i].partial, 32, order);
+        const Scalar cr = c * sign;
+        scalars.push_back(cr.value());
+        points.push_back(lifted.points[2 * i]);
+        scalars.push_back((cr * this->b).value());
+        points.push_back(lifted.points[2 * i + 1]);
+        scalars.push_back((-(c * this->e_key * this->key.keys->coefficients[index[i]])).value());
+        points.push_back(this->key.keys->points[index[i]]);
+    }
+    scalars[0] = base.value();
+    if (multi_scalar_mul(scalars, points, executor).is_infinity()) {
+        return Status::ok;
+    }
+    const Status status = blame();
+    return status == Status::ok ? Status::bad_signature : status;
+}
+
+Status MusigSession::aggregate(uint8_t* signature, const uint8_t* partials, std::size_t count,
+                               std::size_t* culprit) const noexcept {
+    const PrimeField& order = Curve::secp256k1().scalar_field();
+    Scalar s(order);
+    for (std::size_t i = 0; i < count; i++) {
+        const uint256 si = uint256::load_be(partials + 32 * i, 32);
+        if (!(si < order.fixed_prime())) {
+            if (culprit) {
+                *culprit = i;
+            }
+            return Status::bad_encoding;
+        }
+        s += Scalar(si.to_integer(), order);
+    }
+    // the tweaks: e g tacc
+    const Scalar et = this->e * this->key.tacc;
+    s += even_y(this->key.q) ? et : -et;
+    std::memcpy(signature, this->rx, 32);
+    s.to_bytes(signature + 32);
+    return Status::ok;
+}
@@ -0,0 +1,192 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_MUSIG_H
+#define ECC_MUSIG_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Executor.h"
+#include "Point.h"
+#include "Scalar.h"
+#include "Status.h"
+
+// MuSig2 multisignatures on secp256k1 as BIP327 has them: n cosigners'
+// 33-byte compressed keys aggregated into one x-only BIP340 key, two rounds
+// of signing (nonces, then partial signatures), and partial signatures
+// summed into a BIP340 signature that schnorr_verify takes. Secret nonces are
+// 97 bytes k1 || k2 || public key and public nonces 66, two compressed
+// points; hashes are SHA-256 tagged as BIP327 says.
+
+constexpr std::size_t MUSIG_SECNONCE_SIZE = 97;
+constexpr std::size_t MUSIG_PUBNONCE_SIZE = 66;
+constexpr std::size_t MUSIG_PARTIAL_SIZE = 32;
+
+// KeyAgg and its tweaks: Q = sum a_i P_i for the coefficients a_i of BIP327
+// (1 for the second distinct key, a hash of the whole list and the key for
+// the others), with the accumulated sign and tweak of ApplyTweak. The keys,
+// their points and coefficients are shared by every copy and tweak of a
+// context, so holding one per session costs a pointer.
+class MusigKeyAgg {
+public:
+    // the aggregate of the count keys at keys[33 i, 33 (i + 1)), in that
+    // order: the keys lifted together (decompress_keys) and the sum one
+    // multi_scalar_mul on executor. Status::not_on_curve for a key that does
+    // not decode, Status::infinity for keys that sum to infinity. Throws
+    // std::invalid_argument for no keys
+    static Result<MusigKeyAgg> aggregate(const uint8_t* keys, std::size_t count, Executor& executor);
+    static Result<MusigKeyAgg> aggregate(const uint8_t* keys, std::size_t count, unsigned threads = 1);
+
+    // ApplyTweak: g Q + t G for the 32-byte tweak t, g = -1 for an x-only
+    // tweak of a Q with odd y and 1 otherwise. Status::out_of_range for t not
+    // below n, Status::infinity for a sum at infinity
+    Result<MusigKeyAgg> tweak(const uint8_t* tweak, bool x_only) const;
+
+    // Q, normalized
+    const Point& point() const { return this->q; }
+    // the x-only key of Q in out[0, 32), what the final signature verifies under
+    void x_only(uint8_t* out) const;
+    std::size_t size() const;
+
+private:
+    struct KeySet;
+
+    std::shared_ptr<const KeySet> keys;
+    Point q;
+    Scalar gacc, tacc;
+
+    MusigKeyAgg(std::shared_ptr<const KeySet> keys, const Point& q, const Scalar& gacc, const Scalar& tacc);
+    // aggregate with the hash of the key list worked out
+    static Result<MusigKeyAgg> aggregate(const uint8_t* keys, std::size_t count, const uint8_t* list,
+                                         Executor& executor);
+    // the index of the key of the 33-byte encoding, or count if not one of them
+    std::size_t find(const uint8_t* key) const;
+
+    friend class MusigKeyAggCache;
+    friend class MusigSession;
+};
+
+// Aggregated keys kept by the list of keys, so the sessions of a key set that
+// signs again and again skip lifting the keys, hashing the coefficients and
+// the multi_scalar_mul: up to capacity key sets, least recently used evicted,
+// behind one mutex. Hits and misses count in stats() and in the process's
+// metrics, ecc_musig_key_agg_hits_total and ecc_musig_key_agg_misses_total.
+class MusigKeyAggCache {
+public:
+    struct Stats {
+        uint64_t hits;
+        uint64_t misses;
+        std::size_t entries;
+    };
+
+    // throws std::invalid_argument for a capacity of 0
+    explicit MusigKeyAggCache(std::size_t capacity);
+
+    // MusigKeyAgg::aggregate, untweaked, from the cache when the same keys
+    // in the same order were aggregated before; failures are not kept
+    Result<MusigKeyAgg> aggregate(const uint8_t* keys, std::size_t count, Executor& executor);
+    Result<MusigKeyAgg> aggregate(const uint8_t* keys, std::size_t count, unsigned threads = 1);
+
+    void clear();
+    Stats stats() const;
+
+private:
+    // by the hash of the key list KeyAgg makes anyway
+    using Key = std::array<uint8_t, 32>;
+    struct Entry {
+        Key key;
+        MusigKeyAgg agg;
+    };
+
+    mutable std::mutex lock;
+    std::size_t capacity;
+    std::list<Entry> order;     // most recent first
+    std::map<Key, std::list<Entry>::iterator> entries;
+    std::atomic<uint64_t> hits{0}, misses{0};
+};
+
+// NonceGen: k1 and k2 from the 32 fresh random bytes rand and whatever of
+// the rest is given, which may be null for absent: the 32-byte secret, the
+// 32-byte x-only aggregate key, message[0, len) and extra[0, extra_len). The
+// 33-byte public_key is required. Status::out_of_range for a nonce of 0
+Status musig_nonce_gen(uint8_t* secnonce, uint8_t* pubnonce, const uint8_t* rand, const uint8_t* secret,
+                       const uint8_t* public_key, const uint8_t* aggregate_key, const uint8_t* message,
+                       std::size_t len, const uint8_t* extra, std::size_t extra_len) noexcept;
+
+// NonceAgg: the aggregate nonce, 66 bytes, of the count public nonces at
+// pubnonces[66 i, 66 (i + 1)), all lifted together; a sum at infinity is
+// written as 33 zero bytes. Status::not_on_curve for a nonce that does not
+// decode, its index in *culprit when culprit is not null
+Status musig_nonce_agg(uint8_t* aggnonce, const uint8_t* pubnonces, std::size_t count,
+                       std::size_t* culprit = nullptr);
+
+// one cosigner's contribution to a session
+struct MusigPartial {
+    const uint8_t* partial;         // 32 bytes
+    const uint8_t* pubnonce;        // 66 bytes
+    const uint8_t* public_key;      // 33 bytes
+};
+
+// The values of one signing session, BIP327's GetSessionValues: the nonce
+// coefficient b, R = R1 + b R2 and the challenge e of R, the key and the
+// message. Signing and verifying partial signatures then cost no hashing
+class MusigSession {
+public:
+    // the session of key, tweaked as it is, the 66-byte aggregate nonce and
+    // message[0, len): Status::bad_encoding or Status::not_on_curve for a
+    // half of aggnonce that does not decode
+    static Result<MusigSession> start(const MusigKeyAgg& key, const uint8_t* aggnonce, const uint8_t* message,
+                                      std::size_t len);
+
+    // Sign: the 32-byte partial signature of secret with secnonce, whose
+    // nonces are then zeroed so it cannot sign twice. Status::out_of_range
+    // for a secret or nonce not in [1, n), a used secnonce among them, or a
+    // secret not matching secnonce's key or not one of the session's keys.
+    // The nonces' negation is masked, as in schnorr_sign
+    Status sign(uint8_t* partial, uint8_t* secnonce, const uint8_t* secret) const noexcept;
+
+    // PartialSigVerify of one cosigner's contribution: s G against
+    // R1 + b R2 (negated for R of odd y) + e a g P by one Point::mul_add.
+    // Status::bad_encoding for s not below n, Status::not_on_curve for a
+    // nonce that does not decode, Status::out_of_range for a key not of the
+    // session, Status::bad_signature when it does not hold
+    Status verify(const MusigPartial& partial) const noexcept;
+    // whether all of partials verify, by the randomized batch equation of
+    // schnorr_verify_batch: one multi_scalar_mul of 3n + 1 points (the nonces
+    // and key of every cosigner, and G) on executor. On a failure the
+    // cosigners are checked one by one for the first that fails, its index in
+    // *culprit when culprit is not null, and its status returned
+    Status verify_batch(const std::vector<MusigPartial>& partials, Executor& executor,
+                        std::size_t* culprit = nullptr) const;
+    Status verify_batch(const std::vector<MusigPartial>& partials, unsigned threads = 1,
+                        std::size_t* culprit = nullptr) const;
+
+    // PartialSigAgg: the 64-byte BIP340 signature R.x || s of the count
+    // partial signatures at partials[32 i, 32 (i + 1)), s their sum with the
+    // tweaks' e g tacc. Status::bad_encoding for a partial not below n, its
+    // index in *culprit when culprit is not null
+    Status aggregate(uint8_t* signature, const uint8_t* partials, std::size_t count,
+                     std::size_t* culprit = nullptr) const noexcept;
+
+private:
+    MusigKeyAgg key;
+    Scalar b, e;
+    // e g gacc, g = -1 when Q has odd y: the factor of a_i P_i in PartialSigVerify
+    Scalar e_key;
+    uint8_t rx[32];
+    bool r_even;
+
+    MusigSession(const MusigKeyAgg& key, const Scalar& b, const Scalar& e, const Scalar& e_key, const uint8_t* rx,
+                 bool r_even);
+};
+
+#endif //ECC_MUSIG_H
@@ -0,0 +1,69 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <stdexcept>
+
+#include "natural.h"
+
+natural::natural(const integer& v) : n(v) {
+    if (v < 0) {
+        throw std::domain_error("Error: a natural cannot be negative");
+    }
+}
+
+natural::natural(integer&& v) : n(std::move(v)) {
+    if (this->n < 0) {
+        throw std::domain_error("Error: a natural cannot be negative");
+    }
+}
+
+natural& natural::operator+=(const natural& rhs) {
+    if (this == &rhs) {
+        this->n <<= 1;
+        return *this;
+    }
+    this->n.add_magnitude(rhs.n._value);
+    return *this;
+}
+
+natural& natural::operator-=(const natural& rhs) {
+    if (integer::compare_magnitude(this->n, rhs.n) < 0) {
+        throw std::domain_error("Error: natural subtraction would go below 0");
+    }
+    if (this == &rhs) {
+        this->n = 0;
+        return *this;
+    }
+    this->n.sub_magnitude(rhs.n._value);
+    return *this;
+}
+
+natural& natural::operator%=(const natural& rhs) {
+    // already below rhs (and rhs not 0, which dm reports)
+    if (!rhs.is_zero() && (integer::compare_magnitude(this->n, rhs.n) < 0)) {
+        return *this;
+    }
+    this->n = this->n.dm(this->n, rhs.n).second;
+    return *this;
+}
+
+natural& natural::add_mod(const natural& rhs, const integer& m) {
+    *this += rhs;
+    if (integer::compare_magnitude(this->n, m) >= 0) {
+        this->n.sub_magnitude(m._value);
+    }
+    return *this;
+}
+
+natural& natural::sub_mod(const natural& rhs, const integer& m) {
+    if (this == &rhs) {
+        this->n = 0;
+        return *this;
+    }
+    if (integer::compare_magnitude(this->n, rhs.n) < 0) {
+        // wraps: m - (rhs - *this), which is below m
+        this->n.add_magnitude(m._value);
+    }
+    this->n.sub_magnitude(rhs.n._value);
+    return *this;
+}
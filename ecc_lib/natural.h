@@ -0,0 +1,87 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_NATURAL_H
+#define ECC_NATURAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "integer.h"
+
+// An arbitrary-precision value that is never negative, for the values of
+// cryptography, which never are. It is an integer whose sign is always
+// positive, so it runs on integer's digit kernels, but every operation goes
+// straight to the magnitude kernels (add_magnitude, sub_magnitude, mult, dm)
+// without the sign cases operator+ and operator- sort through first, and
+// value() hands the integer on to code that takes one without a copy.
+//
+// There is no width to wrap at, so nothing wraps: a - b throws
+// std::domain_error when b > a rather than going negative. Modular code uses
+// add_mod and sub_mod, which wrap at the modulus.
+class natural {
+public:
+    natural() = default;
+    natural(uint64_t v) : n(v) {}
+    // throws std::domain_error if v is negative
+    explicit natural(const integer& v);
+    explicit natural(integer&& v);
+
+    // the value as an integer, with no copy
+    const integer& value() const { return this->n; }
+
+    bool is_zero() const { return this->n.limb_count() == 0; }
+    explicit operator bool() const { return !is_zero(); }
+    std::size_t bit_length() const { return this->n.bit_length(); }
+    integer::limb_span limbs() const { return this->n.limbs(); }
+    std::size_t heap_bytes() const { return this->n.heap_bytes(); }
+
+    // -1, 0 or 1 as *this is below, equal to or above rhs: the magnitudes alone
+    int compare(const natural& rhs) const { return integer::compare_magnitude(this->n, rhs.n); }
+    bool operator==(const natural& rhs) const { return this->n == rhs.n; }
+    bool operator!=(const natural& rhs) const { return !(this->n == rhs.n); }
+    bool operator<(const natural& rhs) const { return compare(rhs) < 0; }
+    bool operator>(const natural& rhs) const { return compare(rhs) > 0; }
+    bool operator<=(const natural& rhs) const { return compare(rhs) <= 0; }
+    bool operator>=(const natural& rhs) const { return compare(rhs) >= 0; }
+
+    natural& operator+=(const natural& rhs);
+    // throws std::domain_error, leaving *this unchanged, if rhs > *this
+    natural& operator-=(const natural& rhs);
+    natural& operator*=(const natural& rhs) { this->n = this->n.mult(this->n, rhs.n); return *this; }
+    // both throw std::domain_error if rhs is 0
+    natural& operator/=(const natural& rhs) { this->n = this->n.dm(this->n, rhs.n).first; return *this; }
+    natural& operator%=(const natural& rhs);
+    natural& operator<<=(std::size_t shift) { this->n <<= shift; return *this; }
+    natural& operator>>=(std::size_t shift) { this->n >>= shift; return *this; }
+
+    natural operator+(const natural& rhs) const { natural out(*this); return out += rhs; }
+    natural operator-(const natural& rhs) const { natural out(*this); return out -= rhs; }
+    natural operator*(const natural& rhs) const { return natural(this->n.mult(this->n, rhs.n), unchecked()); }
+    natural operator/(const natural& rhs) const { return natural(this->n.dm(this->n, rhs.n).first, unchecked()); }
+    natural operator%(const natural& rhs) const { natural out(*this); return out %= rhs; }
+    natural operator<<(std::size_t shift) const { natural out(*this); return out <<= shift; }
+    natural operator>>(std::size_t shift) const { natural out(*this); return out >>= shift; }
+    natural square() const { return natural(this->n.square(), unchecked()); }
+
+    // *this + rhs and *this - rhs mod m in place, for *this and rhs below m:
+    // one comparison and one correction by m, in the existing digits
+    natural& add_mod(const natural& rhs, const integer& m);
+    natural& sub_mod(const natural& rhs, const integer& m);
+
+    uint64_t hash(uint64_t seed) const { return this->n.hash(seed); }
+
+private:
+    integer n;
+
+    struct unchecked {};
+    natural(integer&& v, unchecked) : n(std::move(v)) {}
+};
+
+inline std::ostream& operator<<(std::ostream& stream, const natural& v) {
+    return stream << v.value();
+}
+
+#endif //ECC_NATURAL_H
@@ -0,0 +1,124 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "numa.h"
+
+std::vector<int> parse_cpulist(const std::string& text) {
+    std::vector<int> out;
+    std::size_t i = 0;
+    const auto number = [&](int& value) {
+        if (i >= text.size() || !std::isdigit(static_cast<unsigned char>(text[i]))) {
+            return false;
+        }
+        value = 0;
+        for (; i < text.size() && std::isdigit(static_cast<unsigned char>(text[i])); i++) {
+            if (value > 1000000) {
+                return false;
+            }
+            value = value * 10 + (text[i] - '0');
+        }
+        return true;
+    };
+    std::size_t end = text.find_last_not_of(" \n");
+    end = end == std::string::npos ? 0 : end + 1;
+    while (i < end) {
+        int first, last;
+        if (!number(first)) {
+            return {};
+        }
+        last = first;
+        if (i < end && text[i] == '-' && (++i, !number(last))) {
+            return {};
+        }
+        if (last < first) {
+            return {};
+        }
+        for (int cpu = first; cpu <= last; cpu++) {
+            out.push_back(cpu);
+        }
+        if (i < end && text[i++] != ',') {
+            return {};
+        }
+    }
+    return out;
+}
+
+NumaTopology::NumaTopology(std::vector<std::vector<int>> nodes) {
+    for (std::vector<int>& node : nodes) {
+        if (!node.empty()) {
+            this->cpus.push_back(std::move(node));
+        }
+    }
+    if (this->cpus.empty()) {
+        const unsigned n = std::max(1u, std::thread::hardware_concurrency());
+        this->cpus.emplace_back();
+        for (unsigned c = 0; c < n; c++) {
+            this->cpus[0].push_back(static_cast<int>(c));
+        }
+    }
+    for (std::size_t node = 0; node < this->cpus.size(); node++) {
+        for (int cpu : this->cpus[node]) {
+            if (cpu >= static_cast<int>(this->node_by_cpu.size())) {
+                this->node_by_cpu.resize(static_cast<std::size_t>(cpu) + 1, 0);
+            }
+            this->node_by_cpu[static_cast<std::size_t>(cpu)] = node;
+        }
+    }
+}
+
+std::size_t NumaTopology::node_of(int cpu) const {
+    return cpu >= 0 && static_cast<std::size_t>(cpu) < this->node_by_cpu.size()
+           ? this->node_by_cpu[static_cast<std::size_t>(cpu)] : 0;
+}
+
+std::size_t NumaTopology::current_node() const {
+#if defined(__linux__)
+    if (this->cpus.size() > 1) {
+        return node_of(sched_getcpu());
+    }
+#endif
+    return 0;
+}
+
+std::vector<int> NumaTopology::spread(unsigned threads) const {
+    std::vector<int> out;
+    for (std::size_t round = 0; out.size() < threads; round++) {
+        for (const std::vector<int>& node : this->cpus) {
+            if (out.size() < threads) {
+                out.push_back(node[round % node.size()]);
+            }
+        }
+    }
+    return out;
+}
+
+const NumaTopology& NumaTopology::system() {
+    static const NumaTopology topology([]() {
+        std::vector<std::vector<int>> nodes;
+#if defined(__linux__)
+        // node ids may have gaps; stop after a run of missing ones
+        for (int id = 0, missing = 0; missing < 64; id++) {
+            std::ifstream in("/sys/devices/system/node/node" + std::to_string(id) + "/cpulist");
+            if (!in) {
+                missing++;
+                continue;
+            }
+            missing = 0;
+            std::string text;
+            std::getline(in, text);
+            nodes.push_back(parse_cpulist(text));
+        }
+#endif
+        return nodes;
+    }());
+    return topology;
+}
@@ -0,0 +1,46 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_NUMA_H
+#define ECC_NUMA_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// The NUMA nodes of the machine and the CPUs of each, for placing threads and
+// the tables they read on the same node. On Linux they come from
+// /sys/devices/system/node; elsewhere, and where that is missing, the machine
+// is one node of hardware_concurrency() CPUs. Nothing here needs libnuma.
+class NumaTopology {
+public:
+    // CPU numbers of each node, node ids renumbered from 0 in the order of
+    // the kernel's; every node listed has at least one CPU
+    explicit NumaTopology(std::vector<std::vector<int>> nodes);
+
+    std::size_t node_count() const { return this->cpus.size(); }
+    const std::vector<int>& node_cpus(std::size_t node) const { return this->cpus[node]; }
+    // the node of cpu, or 0 for a CPU not listed
+    std::size_t node_of(int cpu) const;
+    // the node the calling thread is running on at this moment, 0 where that
+    // cannot be asked
+    std::size_t current_node() const;
+
+    // threads CPUs for WorkStealingPool's list, dealt to the nodes in turn
+    // and to the CPUs of each in order: worker i runs on node i % nodes, and a
+    // CPU takes a second worker only once every CPU of its node has one
+    std::vector<int> spread(unsigned threads) const;
+
+    // read once, on first use
+    static const NumaTopology& system();
+
+private:
+    std::vector<std::vector<int>> cpus;
+    std::vector<std::size_t> node_by_cpu;
+};
+
+// the CPUs of a kernel cpulist such as "0-3,8,10-11"; empty for a malformed one
+std::vector<int> parse_cpulist(const std::string& text);
+
+#endif //ECC_NUMA_H
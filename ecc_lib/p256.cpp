@@ -0,0 +1,95 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include "p256.h"
+
+const uint256 P256_FIELD_P = 0xFFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF_u256;
+const uint256 P256_ORDER_N = 0xFFFFFFFF00000000FFFFFFFFFFFFFFFFBCE6FAADA7179E84F3B9CAC2FC632551_u256;
+
+// (v - low 32 bits of v) / 2^32, the carry of a signed column sum without
+// shifting a negative number
+static int64_t carry_out(int64_t v) {
+    return (v - static_cast<int64_t>(static_cast<uint32_t>(v))) / (int64_t(1) << 32);
+}
+
+// the columns acc[0, 8) carried into 32-bit words, returning the signed carry out
+static int64_t propagate(int64_t* acc, uint32_t* w) {
+    int64_t carry = 0;
+    for (std::size_t i = 0; i < 8; i++) {
+        carry += acc[i];
+        w[i] = static_cast<uint32_t>(carry);
+        carry = carry_out(carry);
+    }
+    return carry;
+}
+
+uint256 p256_reduce_p(const uint512& x) {
+    int64_t c[16];
+    for (std::size_t i = 0; i < 8; i++) {
+        c[2 * i] = static_cast<uint32_t>(x.limb[i]);
+        c[2 * i + 1] = static_cast<uint32_t>(x.limb[i] >> 32);
+    }
+
+    // s1 + 2 s2 + 2 s3 + s4 + s5 - d1 - d2 - d3 - d4, column by column from word 0
+    int64_t acc[8];
+    acc[0] = c[0] + c[8] + c[9] - c[11] - c[12] - c[13] - c[14];
+    acc[1] = c[1] + c[9] + c[10] - c[12] - c[13] - c[14] - c[15];
+    acc[2] = c[2] + c[10] + c[11] - c[13] - c[14] - c[15];
+    acc[3] = c[3] + 2 * (c[11] + c[12]) + c[13] - c[15] - c[8] - c[9];
+    acc[4] = c[4] + 2 * (c[12] + c[13]) + c[14] - c[9] - c[10];
+    acc[5] = c[5] + 2 * (c[13] + c[14]) + c[15] - c[10] - c[11];
+    acc[6] = c[6] + 3 * c[14] + 2 * c[15] + c[13] - c[8] - c[9];
+    acc[7] = c[7] + 3 * c[15] + c[8] - c[10] - c[11] - c[12] - c[13];
+
+    // the sum lies in (-4 * 2^256, 7 * 2^256). Folding its carry back with
+    // 2^256 = 2^224 - 2^192 - 2^96 + 1 leaves a carry of at most one either
+    // way, and a second fold none, so the words are then in [0, 2^256)
+    uint32_t w[8];
+    int64_t top = propagate(acc, w);
+    for (int pass = 0; pass < 2; pass++) {
+        for (std::size_t i = 0; i < 8; i++) {
+            acc[i] = w[i];
+        }
+        acc[0] += top;
+        acc[3] -= top;
+        acc[6] -= top;
+        acc[7] += top;
+        top = propagate(acc, w);
+    }
+
+    uint256 out;
+    for (std::size_t i = 0; i < 4; i++) {
+        out.limb[i] = static_cast<limb_t>(w[2 * i]) | (static_cast<limb_t>(w[2 * i + 1]) << 32);
+    }
+    // 2^256 < 2p, so one subtraction is enough
+    uint256 reduced;
+    const limb_t borrow = uint256::sub(reduced, out, P256_FIELD_P);
+    return uint256::select(0 - (borrow ^ 1), reduced, out);
+}
+
+uint256 p256_reduce_n(const uint512& x) {
+    static const fixed_uint<5> mu = [] {
+        fixed_uint<5> out;
+        out.limb[0] = 0x012FFD85EEDF9BFE;
+        out.limb[1] = 0x43190552DF1A6C21;
+        out.limb[2] = 0xFFFFFFFEFFFFFFFF;
+        out.limb[3] = 0x00000000FFFFFFFF;
+        out.limb[4] = 0x0000000000000001;
+        return out;
+    }();
+    // q3 = floor(floor(x / 2^192) * mu / 2^320) is at most 2 below floor(x / n),
+    // so x - q3 n < 3n < 2^320 is exact in the low five limbs
+    const fixed_uint<5> q1 = (x >> 192).resize<5>();
+    const fixed_uint<5> q3 = (fixed_uint<5>::mul_wide(q1, mu) >> 320).resize<5>();
+    const fixed_uint<5> qn = fixed_uint<5>::mul_wide(q3, P256_ORDER_N).resize<5>();
+    fixed_uint<5> r;
+    fixed_uint<5>::sub(r, x.resize<5>(), qn);
+
+    const fixed_uint<5> n = P256_ORDER_N.resize<5>();
+    for (int pass = 0; pass < 2; pass++) {
+        fixed_uint<5> reduced;
+        const limb_t borrow = fixed_uint<5>::sub(reduced, r, n);
+        r = fixed_uint<5>::select(0 - (borrow ^ 1), reduced, r);
+    }
+    return r.resize<4>();
+}
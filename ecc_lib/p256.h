@@ -0,0 +1,73 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_P256_H
+#define ECC_P256_H
+
+#include "modexp.h"
+#include "uint256.h"
+
+// Field prime p = 2^256 - 2^224 + 2^192 + 2^96 - 1 of NIST P-256
+extern const uint256 P256_FIELD_P;
+// Order n of the base point of P-256
+extern const uint256 P256_ORDER_N;
+
+// x mod p for any 512-bit x by the Solinas reduction of FIPS 186-4, appendix
+// D.2.3: a fixed sum and difference of nine rearrangements of the 32-bit words
+// of x, then two folds of the small carry out and one subtraction of p chosen
+// by mask; no division and no branch on x
+uint256 p256_reduce_p(const uint512& x);
+
+// x mod n for any 512-bit x by Barrett reduction (HAC 14.42) in 64-bit limbs
+// with the fixed mu = floor(2^512 / n): two products, then at most two
+// subtractions of n chosen by mask. n has no sparse form to fold with, unlike
+// the secp256k1 order; PrimeField binds this as the fold of the scalar field.
+uint256 p256_reduce_n(const uint512& x);
+
+// Addition chains for the two fixed exponents of the field prime, in the style
+// of the secp256k1 ones. Both start from xk = a^(2^k - 1) for k = 2, 4, .., 32:
+// 31 squarings and 5 multiplications.
+template <typename T>
+struct P256ChainStart {
+    T x2, x4, x8, x16, x32;
+};
+
+template <typename T, typename Mul, typename Sqr>
+P256ChainStart<T> p256_chain_start(const T& a, Mul mul, Sqr sqr) {
+    const T x2 = mul(sqr(a), a);
+    const T x4 = mul(repeated_square(x2, 2, sqr), x2);
+    const T x8 = mul(repeated_square(x4, 4, sqr), x4);
+    const T x16 = mul(repeated_square(x8, 8, sqr), x8);
+    const T x32 = mul(repeated_square(x16, 16, sqr), x16);
+    return {x2, x4, x8, x16, x32};
+}
+
+// a^((p + 1) / 4), the square root of a when it has one: 253 squarings, 7 multiplications
+template <typename T, typename Mul, typename Sqr>
+T p256_sqrt_candidate(const T& a, Mul mul, Sqr sqr) {
+    const P256ChainStart<T> x = p256_chain_start(a, mul, sqr);
+    // (p + 1) / 4 = ((2^32 - 1) * 2^128 + 2^96 + 1) * 2^94
+    T t = mul(repeated_square(x.x32, 32, sqr), a);
+    t = mul(repeated_square(t, 96, sqr), a);
+    return repeated_square(t, 94, sqr);
+}
+
+// a^(p - 2), the inverse of a non-zero a: 255 squarings, 13 multiplications
+template <typename T, typename Mul, typename Sqr>
+T p256_fermat_inverse(const T& a, Mul mul, Sqr sqr) {
+    const P256ChainStart<T> x = p256_chain_start(a, mul, sqr);
+    // p - 2 = (2^32 - 1) * 2^224 + 2^192 + (2^94 - 1) * 2^2 + 1, the 94 ones
+    // as 32 + 32 + 16 + 8 + 4 + 2
+    T t = mul(repeated_square(x.x32, 32, sqr), a);
+    t = repeated_square(t, 96, sqr);
+    t = mul(repeated_square(t, 32, sqr), x.x32);
+    t = mul(repeated_square(t, 32, sqr), x.x32);
+    t = mul(repeated_square(t, 16, sqr), x.x16);
+    t = mul(repeated_square(t, 8, sqr), x.x8);
+    t = mul(repeated_square(t, 4, sqr), x.x4);
+    t = mul(repeated_square(t, 2, sqr), x.x2);
+    return mul(repeated_square(t, 2, sqr), a);
+}
+
+#endif //ECC_P256_H
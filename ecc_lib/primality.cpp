@@ -0,0 +1,299 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "BarrettReducer.h"
+#include "modexp.h"
+#include "MontgomeryContext.h"
+#include "primality.h"
+
+namespace {
+
+// trial division covers the odd primes below LIMIT, so anything up to LIMIT^2
+// it finds no factor of is prime
+const uint32_t LIMIT = 1000;
+// odd candidates next_prime sieves at a time
+const std::size_t WINDOW = 4096;
+
+struct SmallPrimes {
+    std::vector<uint32_t> primes;
+    // products of consecutive primes that fit in a limb, and the index past
+    // the last prime of each, so one remainder by the product covers them all
+    std::vector<std::pair<uint64_t, std::size_t>> groups;
+};
+
+const SmallPrimes& small_primes() {
+    static const SmallPrimes table = []() {
+        SmallPrimes out;
+        std::vector<bool> composite(LIMIT, false);
+        for (uint32_t i = 3; i < LIMIT; i += 2) {
+            if (composite[i]) {
+                continue;
+            }
+            out.primes.push_back(i);
+            for (uint32_t j = i * i; j < LIMIT; j += 2 * i) {
+                composite[j] = true;
+            }
+        }
+        uint64_t product = 1;
+        for (std::size_t i = 0; i < out.primes.size(); i++) {
+            if (product > UINT64_MAX / out.primes[i]) {
+                out.groups.emplace_back(product, i);
+                product = 1;
+            }
+            product *= out.primes[i];
+        }
+        out.groups.emplace_back(product, out.primes.size());
+        return out;
+    }();
+    return table;
+}
+
+// n mod each of the small primes
+std::vector<uint32_t> small_residues(const integer& n) {
+    const SmallPrimes& table = small_primes();
+    std::vector<uint32_t> out(table.primes.size());
+    std::size_t i = 0;
+    for (const auto& group : table.groups) {
+        const uint64_t r = static_cast<uint64_t>(n % group.first);
+        for (; i < group.second; i++) {
+            out[i] = static_cast<uint32_t>(r % table.primes[i]);
+        }
+    }
+    return out;
+}
+
+// the smallest odd prime below LIMIT dividing n, or 0
+uint32_t small_factor(const integer& n) {
+    const SmallPrimes& table = small_primes();
+    std::size_t i = 0;
+    for (const auto& group : table.groups) {
+        const uint64_t r = static_cast<uint64_t>(n % group.first);
+        for (; i < group.second; i++) {
+            if (r % table.primes[i] == 0) {
+                return table.primes[i];
+            }
+        }
+    }
+    return 0;
+}
+
+// Residues mod an odd n in Montgomery form, for n below 2^256
+class MontgomeryRing {
+public:
+    typedef uint256 value;
+
+    explicit MontgomeryRing(const integer& n) : ctx(n) {}
+
+    value from(const integer& x) const { return this->ctx.to_montgomery(uint256::from_integer(x)); }
+    value one() const { return this->ctx.one(); }
+    value mul(const value& a, const value& b) const { return this->ctx.mul(a, b); }
+    value add(const value& a, const value& b) const { return this->ctx.add(a, b); }
+    value sub(const value& a, const value& b) const { return this->ctx.sub(a, b); }
+    // a / 2, which is the same in Montgomery form: a + n when a is odd, shifted
+    // with the carry out of the sum
+    value half(const value& a) const {
+        if (!(a.limb[0] & 1)) {
+            return a >> 1;
+        }
+        uint256 sum(0);
+        const limb_t carry = uint256::add(sum, a, this->ctx.modulus());
+        sum = sum >> 1;
+        sum.limb[3] |= carry << 63;
+        return sum;
+    }
+    value pow(const value& a, const integer& exponent) const { return this->ctx.pow(a, exponent); }
+
+private:
+    MontgomeryContext ctx;
+};
+
+// Residues mod an odd n of any size, reduced with Barrett's method
+class BarrettRing {
+public:
+    typedef integer value;
+
+    explicit BarrettRing(const integer& n) : reducer(n) {}
+
+    value from(const integer& x) const { return x; }
+    value one() const { return 1; }
+    value mul(const value& a, const value& b) const { return this->reducer.mul(a, b); }
+    value add(const value& a, const value& b) const {
+        integer sum = a + b;
+        return (sum >= this->reducer.modulus()) ? sum - this->reducer.modulus() : sum;
+    }
+    value sub(const value& a, const value& b) const {
+        integer difference = a - b;
+        return (difference < 0) ? difference + this->reducer.modulus() : difference;
+    }
+    value half(const value& a) const { return (a[0] ? a + this->reducer.modulus() : a) >> 1; }
+    value pow(const value& a, const integer& exponent) const {
+        return sliding_window_pow(a, exponent, one(),
+                [this](const integer& x, const integer& y) { return this->reducer.mul(x, y); },
+                [this](const integer& x) { return this->reducer.reduce(x.square()); });
+    }
+
+private:
+    BarrettReducer reducer;
+};
+
+// strong probable prime to base 2: n - 1 = d 2^s, and 2^d = 1 or
+// 2^(d 2^r) = -1 for some r < s
+template <typename Ring>
+bool strong_fermat(const Ring& ring, const integer& n) {
+    integer d = n - 1;
+    std::size_t s = 0;
+    while (!d[0]) {
+        d >>= 1;
+        s++;
+    }
+    const typename Ring::value one = ring.one();
+    const typename Ring::value minus_one = ring.from(n - 1);
+    typename Ring::value x = ring.pow(ring.from(2), d);
+    if (x == one || x == minus_one) {
+        return true;
+    }
+    for (std::size_t r = 1; r < s; r++) {
+        x = ring.mul(x, x);
+        if (x == minus_one) {
+            return true;
+        }
+        if (x == one) {
+            return false;
+        }
+    }
+    return false;
+}
+
+// strong Lucas probable prime with P = 1 and Q = (1 - D) / 4 for the first D
+// of 5, -7, 9, -11, .. with (D / n) = -1 (Selfridge's method A): n + 1 = d 2^s,
+// and U_d = 0 or V_(d 2^r) = 0 for some r < s. n must be past trial division
+// and not a square, or no such D exists.
+template <typename Ring>
+bool strong_lucas(const Ring& ring, const integer& n) {
+    int64_t D = 5;
+    while (true) {
+        const int j = integer::jacobi(D, n);
+        if (j == -1) {
+            break;
+        }
+        if (j == 0) {
+            return false;       // n shares a factor with |D| < n
+        }
+        D = (D > 0) ? -(D + 2) : -D + 2;
+    }
+    const auto residue = [&n](const integer& x) {
+        const integer r = x % n;
+        return (r < 0) ? r + n : r;
+    };
+    const typename Ring::value d_form = ring.from(residue(D));
+    const typename Ring::value q_form = ring.from(residue((1 - D) / 4));
+
+    integer d = n + 1;
+    std::size_t s = 0;
+    while (!d[0]) {
+        d >>= 1;
+        s++;
+    }
+
+    // U_k, V_k and Q^k from k = 1 up the bits of d: k -> 2k, then k -> k + 1
+    typename Ring::value u = ring.one(), v = ring.one(), qk = q_form;
+    for (std::size_t i = d.bit_length() - 1; i-- > 0;) {
+        u = ring.mul(u, v);
+        v = ring.sub(ring.mul(v, v), ring.add(qk, qk));
+        qk = ring.mul(qk, qk);
+        if (d.test_bit(i)) {
+            const typename Ring::value next = ring.half(ring.add(u, v));
+            v = ring.half(ring.add(ring.mul(d_form, u), v));
+            u = next;
+            qk = ring.mul(qk, q_form);
+        }
+    }
+    const typename Ring::value zero = ring.from(0);
+    if (u == zero || v == zero) {
+        return true;
+    }
+    for (std::size_t r = 1; r < s; r++) {
+        v = ring.sub(ring.mul(v, v), ring.add(qk, qk));
+        qk = ring.mul(qk, qk);
+        if (v == zero) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// the tests after trial division, for odd n above LIMIT^2
+bool bpsw(const integer& n) {
+    if (is_perfect_square(n)) {
+        return false;
+    }
+    if (n.bit_length() <= uint256::BITS) {
+        const MontgomeryRing ring(n);
+        return strong_fermat(ring, n) && strong_lucas(ring, n);
+    }
+    const BarrettRing ring(n);
+    return strong_fermat(ring, n) && strong_lucas(ring, n);
+}
+
+}
+
+bool is_probable_prime(const integer& n) {
+    if (n < 2) {
+        return false;
+    }
+    if (!n[0]) {
+        return n == 2;
+    }
+    if (const uint32_t p = small_factor(n)) {
+        return n == p;
+    }
+    if (n < integer(LIMIT) * LIMIT) {
+        return true;
+    }
+    return bpsw(n);
+}
+
+integer next_prime(const integer& n) {
+    if (n < 2) {
+        return 2;
+    }
+    integer start = n + 1;
+    if (!start[0]) {
+        start += 1;
+    }
+    // below LIMIT^2 the small primes are candidates themselves
+    for (; start < integer(LIMIT) * LIMIT; start += 2) {
+        if (is_probable_prime(start)) {
+            return start;
+        }
+    }
+
+    // candidate i of a window is start + 2i; a prime p divides those from the
+    // i with 2i = -start mod p on, every p
+    const std::vector<uint32_t>& primes = small_primes().primes;
+    std::vector<bool> composite(WINDOW);
+    while (true) {
+        std::fill(composite.begin(), composite.end(), false);
+        const std::vector<uint32_t> r = small_residues(start);
+        for (std::size_t j = 0; j < primes.size(); j++) {
+            const uint64_t p = primes[j];
+            for (uint64_t i = (p - r[j]) % p * ((p + 1) / 2) % p; i < WINDOW; i += p) {
+                composite[i] = true;
+            }
+        }
+        for (std::size_t i = 0; i < WINDOW; i++) {
+            if (!composite[i]) {
+                const integer candidate = start + integer(2 * i);
+                if (bpsw(candidate)) {
+                    return candidate;
+                }
+            }
+        }
+        start += integer(2 * WINDOW);
+    }
+}
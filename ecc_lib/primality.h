@@ -0,0 +1,23 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_PRIMALITY_H
+#define ECC_PRIMALITY_H
+
+#include "integer.h"
+
+// Baillie-PSW: trial division by the primes below 1000 (a few single-digit
+// remainders, each by a product of primes that fills a limb), then a strong
+// Miller-Rabin test to base 2 and a strong Lucas test with Selfridge's
+// parameters. Both run in Montgomery form for values that fit in 256 bits
+// (MontgomeryContext) and with Barrett reduction above. No composite passes
+// both below 2^64 and none is known above. Not constant time.
+bool is_probable_prime(const integer& n);
+
+// the smallest probable prime above n, looked for in windows of odd candidates
+// sieved by the same small primes, so the tests run only on the few that
+// survive
+integer next_prime(const integer& n);
+
+#endif //ECC_PRIMALITY_H
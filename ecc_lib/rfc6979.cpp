@@ -0,0 +1,118 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "rfc6979.h"
+
+namespace {
+
+// K and V of steps b and c
+const HmacSha256& initial_key() {
+    static const uint8_t zeros[32] = {0};
+    static const HmacSha256 k(zeros, sizeof(zeros));
+    return k;
+}
+
+const uint8_t INITIAL_V[32] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+                               1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+
+// V = HMAC_K(V)
+void advance(HmacSha256& k, uint8_t* v) {
+    k.update(v, 32);
+    k.finish(v);
+}
+
+}
+
+Rfc6979::Rfc6979(const uint8_t* x, std::size_t rlen) : rlen(rlen), step_d(initial_key()) {
+    if (rlen == 0 || rlen > sizeof(this->x)) {
+        throw std::invalid_argument("RFC 6979 nonces need an order of at most 256 bits");
+    }
+    std::memcpy(this->x, x, rlen);
+    const uint8_t zero = 0x00;
+    this->step_d.update(INITIAL_V, sizeof(INITIAL_V));
+    this->step_d.update(&zero, 1);
+    this->step_d.update(x, rlen);
+}
+
+Rfc6979::Drbg Rfc6979::drbg(const uint8_t* h1) const {
+    uint8_t key[32], v[32];
+    std::memcpy(v, INITIAL_V, sizeof(v));
+
+    // d. K = HMAC_K(V || 0x00 || x || h1), e. V = HMAC_K(V)
+    HmacSha256 d = this->step_d;
+    d.update(h1, this->rlen);
+    d.finish(key);
+    HmacSha256 e(key, sizeof(key));
+    advance(e, v);
+
+    // f. K = HMAC_K(V || 0x01 || x || h1), g. V = HMAC_K(V)
+    const uint8_t one = 0x01;
+    e.update(v, sizeof(v));
+    e.update(&one, 1);
+    e.update(this->x, this->rlen);
+    e.update(h1, this->rlen);
+    e.finish(key);
+    Drbg out{HmacSha256(key, sizeof(key))};
+    std::memcpy(out.v, v, sizeof(v));
+    advance(out.k, out.v);
+    return out;
+}
+
+const uint8_t* Rfc6979::Drbg::next() {
+    if (this->started) {
+        // h.3. K = HMAC_K(V || 0x00), V = HMAC_K(V)
+        uint8_t key[32];
+        const uint8_t zero = 0x00;
+        this->k.update(this->v, sizeof(this->v));
+        this->k.update(&zero, 1);
+        this->k.finish(key);
+        this->k = HmacSha256(key, sizeof(key));
+        advance(this->k, this->v);
+    }
+    this->started = true;
+    advance(this->k, this->v);
+    return this->v;
+}
+
+void Rfc6979::first_candidates(uint8_t* out, const Rfc6979* const* keys, const uint8_t* h1, std::size_t count,
+                               const Sha256MultiBuffer* kernel) {
+    if (count == 0) {
+        return;
+    }
+    const std::size_t rlen = keys[0]->rlen;
+    for (std::size_t i = 1; i < count; i++) {
+        if (keys[i]->rlen != rlen) {
+            throw std::invalid_argument("RFC 6979 keys of a batch need the same order length");
+        }
+    }
+    // V || tag || x || h1 for every message, the messages of steps d and f
+    const std::size_t len = 33 + 2 * rlen;
+    std::vector<uint8_t> k(32 * count, 0), v(32 * count), message(len * count);
+    auto fill = [&](uint8_t tag) {
+        for (std::size_t i = 0; i < count; i++) {
+            uint8_t* m = message.data() + i * len;
+            std::memcpy(m, v.data() + 32 * i, 32);
+            m[32] = tag;
+            std::memcpy(m + 33, keys[i]->x, rlen);
+            std::memcpy(m + 33 + rlen, h1 + 32 * i, rlen);
+        }
+    };
+    for (std::size_t i = 0; i < count; i++) {
+        std::memcpy(v.data() + 32 * i, INITIAL_V, 32);
+    }
+
+    // d. K = HMAC_K(V || 0x00 || x || h1), e. V = HMAC_K(V)
+    fill(0x00);
+    hmac_sha256_many(k.data(), k.data(), message.data(), len, count, kernel);
+    hmac_sha256_many(v.data(), k.data(), v.data(), 32, count, kernel);
+    // f. K = HMAC_K(V || 0x01 || x || h1), g. V = HMAC_K(V)
+    fill(0x01);
+    hmac_sha256_many(k.data(), k.data(), message.data(), len, count, kernel);
+    hmac_sha256_many(v.data(), k.data(), v.data(), 32, count, kernel);
+    // h.2. T = V = HMAC_K(V)
+    hmac_sha256_many(out, k.data(), v.data(), 32, count, kernel);
+}
@@ -0,0 +1,65 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_RFC6979_H
+#define ECC_RFC6979_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "sha256.h"
+
+// The deterministic nonces of RFC 6979, section 3.2, on HMAC-SHA-256, for one
+// secret key and any number of messages, for orders of up to 256 bits (rlen =
+// ceil(qlen / 8) at most 32, so one block of V is a whole candidate). Made
+// once per key: the first K, all zeros, has its padded blocks compressed once
+// for the program, and step d's HMAC has V || 0x00 || int2octets(x) compressed
+// once for the key, so a message pays only for h1 and the MACs whose key
+// depends on it.
+class Rfc6979 {
+public:
+    // x = int2octets(secret), rlen bytes; throws std::invalid_argument for rlen
+    // not in [1, 32]
+    Rfc6979(const uint8_t* x, std::size_t rlen);
+
+    // HMAC_DRBG after steps d to g for one message
+    class Drbg {
+    public:
+        // the next candidate T in 32 bytes, for the caller's bits2int and range
+        // check: step h.2 on the first call, after the update of step h.3 on the rest
+        const uint8_t* next();
+
+    private:
+        friend class Rfc6979;
+
+        HmacSha256 k;
+        uint8_t v[32];
+        bool started = false;
+
+        explicit Drbg(const HmacSha256& k) : k(k) {}
+    };
+
+    // the generator for h1 = bits2octets(H(m)), rlen bytes
+    Drbg drbg(const uint8_t* h1) const;
+
+    // the first candidate of keys[i]->drbg(h1 + 32 i), its first next(), in
+    // out + 32 i, for count messages at once: each of the five MACs of steps d
+    // to h.2 is taken for all of them by hmac_sha256_many through kernel, so
+    // with a multi-buffer SHA-256 the messages are hashed a group of lanes at a
+    // time. A caller that rejects a candidate goes on with drbg(h1), whose
+    // first next() is the same. Throws std::invalid_argument unless every key
+    // has the same rlen
+    static void first_candidates(uint8_t* out, const Rfc6979* const* keys, const uint8_t* h1, std::size_t count,
+                                 const Sha256MultiBuffer* kernel);
+    static void first_candidates(uint8_t* out, const Rfc6979* const* keys, const uint8_t* h1, std::size_t count) {
+        first_candidates(out, keys, h1, count, sha256_multi_buffer());
+    }
+
+private:
+    uint8_t x[32];
+    std::size_t rlen;
+    HmacSha256 step_d;      // under K = 0x00 .. 00 with V || 0x00 || x absorbed
+};
+
+#endif //ECC_RFC6979_H
@@ -0,0 +1,252 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstring>
+
+#include "ripemd160.h"
+#include "sha256.h"
+
+const uint8_t RIPEMD160_R[2][80] = {
+        {
+                0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                7, 4, 13, 1, 10, 6, 15, 3, 12, 0, 9, 5, 2, 14, 11, 8,
+                3, 10, 14, 4, 9, 15, 8, 1, 2, 7, 0, 6, 13, 11, 5, 12,
+                1, 9, 11, 10, 0, 8, 12, 4, 13, 3, 7, 15, 14, 5, 6, 2,
+                4, 0, 5, 9, 7, 12, 2, 10, 14, 1, 3, 8, 11, 6, 15, 13
+        },
+        {
+                5, 14, 7, 0, 9, 2, 11, 4, 13, 6, 15, 8, 1, 10, 3, 12,
+                6, 11, 3, 7, 0, 13, 5, 10, 14, 15, 8, 12, 4, 9, 1, 2,
+                15, 5, 1, 3, 7, 14, 6, 9, 11, 8, 12, 2, 10, 0, 4, 13,
+                8, 6, 4, 1, 3, 11, 15, 0, 5, 12, 2, 13, 9, 7, 10, 14,
+                12, 15, 10, 4, 1, 5, 8, 7, 6, 2, 13, 14, 0, 3, 9, 11
+        }
+};
+
+const uint8_t RIPEMD160_S[2][80] = {
+        {
+                11, 14, 15, 12, 5, 8, 7, 9, 11, 13, 14, 15, 6, 7, 9, 8,
+                7, 6, 8, 13, 11, 9, 7, 15, 7, 12, 15, 9, 11, 7, 13, 12,
+                11, 13, 6, 7, 14, 9, 13, 15, 14, 8, 13, 6, 5, 12, 7, 5,
+                11, 12, 14, 15, 14, 15, 9, 8, 9, 14, 5, 6, 8, 6, 5, 12,
+                9, 15, 5, 11, 6, 8, 13, 12, 5, 12, 13, 14, 11, 8, 5, 6
+        },
+        {
+                8, 9, 9, 11, 13, 15, 15, 5, 7, 7, 8, 11, 14, 14, 12, 6,
+                9, 13, 15, 7, 12, 8, 9, 11, 7, 7, 12, 7, 6, 15, 13, 11,
+                9, 7, 15, 11, 8, 6, 6, 14, 12, 13, 5, 14, 13, 13, 7, 5,
+                15, 5, 8, 11, 14, 14, 6, 14, 6, 9, 12, 9, 12, 5, 15, 8,
+                8, 5, 12, 9, 12, 5, 14, 6, 8, 13, 6, 5, 15, 13, 11, 11
+        }
+};
+
+// the integer parts of 2^30 times the square roots of 2, 3, 5 and 7 on the
+// left, and of the cube roots on the right
+const uint32_t RIPEMD160_K[2][5] = {
+        {0x00000000, 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xA953FD4E},
+        {0x50A28BE6, 0x5C4DD124, 0x6D703EF3, 0x7A6D76E9, 0x00000000}
+};
+
+namespace {
+
+const uint32_t INITIAL[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+
+uint32_t rotl(uint32_t x, unsigned n) {
+    return (x << n) | (x >> (32 - n));
+}
+
+uint32_t load_le32(const uint8_t* in) {
+    return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8)
+           | (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+void store_le32(uint8_t* out, uint32_t x) {
+    for (std::size_t i = 0; i < 4; i++) {
+        out[i] = static_cast<uint8_t>(x);
+        x >>= 8;
+    }
+}
+
+// the five boolean functions, f(0) to f(4); the left line takes them in that
+// order a group of 16 steps at a time, the right line in reverse
+uint32_t f(std::size_t i, uint32_t x, uint32_t y, uint32_t z) {
+    switch (i) {
+        case 0:
+            return x ^ y ^ z;
+        case 1:
+            return (x & y) | (~x & z);
+        case 2:
+            return (x | ~y) ^ z;
+        case 3:
+            return (x & z) | (y & ~z);
+        default:
+            return x ^ (y | ~z);
+    }
+}
+
+// the one padded block of a 32-byte message, a SHA-256 digest: the message,
+// 0x80, zeros, and 256 in bits, little-endian
+void pad32(uint8_t* block, const uint8_t* digest) {
+    std::memcpy(block, digest, 32);
+    block[32] = 0x80;
+    std::memset(block + 33, 0, 31);
+    block[57] = 0x01;
+}
+
+void store_digest(uint8_t* out, const uint32_t* h, std::size_t lanes, std::size_t l) {
+    for (std::size_t w = 0; w < 5; w++) {
+        store_le32(out + 4 * w, h[w * lanes + l]);
+    }
+}
+
+// the widest SHA-256 kernel has 16 lanes; a group of that many messages
+// fills whole RIPEMD-160 groups too
+const std::size_t GROUP = 16;
+
+}
+
+void ripemd160_blocks(uint32_t* h, const uint8_t* in, std::size_t blocks) {
+    for (; blocks; blocks--, in += 64) {
+        uint32_t x[16];
+        for (std::size_t i = 0; i < 16; i++) {
+            x[i] = load_le32(in + 4 * i);
+        }
+        uint32_t al = h[0], bl = h[1], cl = h[2], dl = h[3], el = h[4];
+        uint32_t ar = al, br = bl, cr = cl, dr = dl, er = el;
+        for (std::size_t j = 0; j < 80; j++) {
+            const std::size_t g = j / 16;
+            uint32_t t = rotl(al + f(g, bl, cl, dl) + x[RIPEMD160_R[0][j]] + RIPEMD160_K[0][g], RIPEMD160_S[0][j]) + el;
+            al = el;
+            el = dl;
+            dl = rotl(cl, 10);
+            cl = bl;
+            bl = t;
+            t = rotl(ar + f(4 - g, br, cr, dr) + x[RIPEMD160_R[1][j]] + RIPEMD160_K[1][g], RIPEMD160_S[1][j]) + er;
+            ar = er;
+            er = dr;
+            dr = rotl(cr, 10);
+            cr = br;
+            br = t;
+        }
+        const uint32_t t = h[1] + cl + dr;
+        h[1] = h[2] + dl + er;
+        h[2] = h[3] + el + ar;
+        h[3] = h[4] + al + br;
+        h[4] = h[0] + bl + cr;
+        h[0] = t;
+    }
+}
+
+Ripemd160::Ripemd160() {
+    reset();
+}
+
+void Ripemd160::reset() {
+    for (std::size_t i = 0; i < 5; i++) {
+        this->h[i] = INITIAL[i];
+    }
+    this->used = 0;
+    this->total = 0;
+}
+
+void Ripemd160::update(const uint8_t* data, std::size_t len) {
+    this->total += len;
+    if (this->used) {
+        while (len && this->used < sizeof(this->block)) {
+            this->block[this->used++] = *data++;
+            len--;
+        }
+        if (this->used < sizeof(this->block)) {
+            return;
+        }
+        ripemd160_blocks(this->h, this->block, 1);
+        this->used = 0;
+    }
+    const std::size_t whole = len / sizeof(this->block);
+    if (whole) {
+        ripemd160_blocks(this->h, data, whole);
+        data += whole * sizeof(this->block);
+        len -= whole * sizeof(this->block);
+    }
+    for (std::size_t i = 0; i < len; i++) {
+        this->block[i] = data[i];
+    }
+    this->used = len;
+}
+
+// as SHA-256 pads, but with the length little-endian
+void Ripemd160::finish(uint8_t* out) {
+    const uint64_t bits = this->total << 3;
+    this->block[this->used++] = 0x80;
+    if (this->used > 56) {
+        while (this->used < sizeof(this->block)) {
+            this->block[this->used++] = 0;
+        }
+        ripemd160_blocks(this->h, this->block, 1);
+        this->used = 0;
+    }
+    while (this->used < 56) {
+        this->block[this->used++] = 0;
+    }
+    store_le32(this->block + 56, static_cast<uint32_t>(bits));
+    store_le32(this->block + 60, static_cast<uint32_t>(bits >> 32));
+    ripemd160_blocks(this->h, this->block, 1);
+
+    for (std::size_t i = 0; i < 5; i++) {
+        store_le32(out + 4 * i, this->h[i]);
+    }
+    reset();
+}
+
+void Ripemd160::hash(const uint8_t* data, std::size_t len, uint8_t* out) {
+    Ripemd160 ripemd;
+    ripemd.update(data, len);
+    ripemd.finish(out);
+}
+
+void hash160(const uint8_t* data, std::size_t len, uint8_t* out) {
+    uint8_t digest[Sha256::DIGEST_SIZE], block[64];
+    Sha256::hash(data, len, digest);
+    pad32(block, digest);
+    uint32_t h[5] = {INITIAL[0], INITIAL[1], INITIAL[2], INITIAL[3], INITIAL[4]};
+    ripemd160_blocks(h, block, 1);
+    store_digest(out, h, 1, 0);
+}
+
+void hash160_many(uint8_t* out, const uint8_t* in, std::size_t len, std::size_t count,
+                  const Ripemd160MultiBuffer* kernel) {
+    uint8_t digests[GROUP][Sha256::DIGEST_SIZE], blocks[GROUP][64];
+    uint32_t h[5 * GROUP];
+    const uint8_t* lanes_in[GROUP];
+    for (std::size_t first = 0; first < count; first += GROUP) {
+        const std::size_t used = count - first < GROUP ? count - first : GROUP;
+        sha256_many(digests[0], in + first * len, len, used);
+        for (std::size_t i = 0; i < used; i++) {
+            pad32(blocks[i], digests[i]);
+        }
+        if (!kernel) {
+            for (std::size_t i = 0; i < used; i++) {
+                uint32_t one[5] = {INITIAL[0], INITIAL[1], INITIAL[2], INITIAL[3], INITIAL[4]};
+                ripemd160_blocks(one, blocks[i], 1);
+                store_digest(out + 20 * (first + i), one, 1, 0);
+            }
+            continue;
+        }
+        const std::size_t lanes = kernel->lanes;
+        for (std::size_t start = 0; start < used; start += lanes) {
+            // a short last group repeats its final block in the lanes left over
+            for (std::size_t w = 0; w < 5; w++) {
+                for (std::size_t l = 0; l < lanes; l++) {
+                    h[w * lanes + l] = INITIAL[w];
+                }
+            }
+            for (std::size_t l = 0; l < lanes; l++) {
+                lanes_in[l] = blocks[start + l < used ? start + l : used - 1];
+            }
+            kernel->blocks(h, lanes_in, 1);
+            for (std::size_t l = 0; l < lanes && start + l < used; l++) {
+                store_digest(out + 20 * (first + start + l), h, lanes, l);
+            }
+        }
+    }
+}
@@ -0,0 +1,69 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_RIPEMD160_H
+#define ECC_RIPEMD160_H
+
+#include <cstddef>
+#include <cstdint>
+
+// RIPEMD-160 of Dobbertin, Bosselaers and Preneel, the outer hash of Bitcoin's
+// HASH160, in the shape of Sha256
+class Ripemd160 {
+public:
+    static constexpr std::size_t DIGEST_SIZE = 20;
+
+    Ripemd160();
+    void update(const uint8_t* data, std::size_t len);
+    // the digest of everything given to update(), in out[0, 20); starts over after
+    void finish(uint8_t* out);
+
+    static void hash(const uint8_t* data, std::size_t len, uint8_t* out);
+
+private:
+    uint32_t h[5];
+    uint8_t block[64];
+    std::size_t used;           // bytes waiting in block
+    uint64_t total;             // bytes so far; messages stay below 2^61 bytes
+
+    void reset();
+};
+
+// the compression of RIPEMD-160, any number of consecutive 64-byte blocks into h[0, 5)
+void ripemd160_blocks(uint32_t* h, const uint8_t* in, std::size_t blocks);
+
+// for the instruction-set file: for step j of the left line (0) and the right
+// line (1), the message word taken and the rotation, and the constant of each
+// group of 16 steps
+extern const uint8_t RIPEMD160_R[2][80];
+extern const uint8_t RIPEMD160_S[2][80];
+extern const uint32_t RIPEMD160_K[2][5];
+
+// Multi-buffer RIPEMD-160, laid out as Sha256MultiBuffer: the state of word w
+// of lane l at h[w * lanes + l] and lane l's next blocks at in[l]. AVX2 runs
+// 8 lanes.
+struct Ripemd160MultiBuffer {
+    const char* name;
+    std::size_t lanes;
+    void (*blocks)(uint32_t* h, const uint8_t* const* in, std::size_t blocks);
+};
+
+// null without AVX2
+const Ripemd160MultiBuffer* avx2_ripemd160_multi_buffer();
+
+// HASH160, RIPEMD-160(SHA-256(data)), of data[0, len) in out[0, 20). The
+// SHA-256 digest goes straight into the one padded block RIPEMD-160 needs for
+// it, on the stack, without a Ripemd160 in between.
+void hash160(const uint8_t* data, std::size_t len, uint8_t* out);
+
+// the HASH160 of count messages of len bytes each, message i at in + i * len
+// and its digest at out + 20 i: the SHA-256 through sha256_many, the
+// RIPEMD-160 through kernel (null for one at a time). Nothing is allocated
+void hash160_many(uint8_t* out, const uint8_t* in, std::size_t len, std::size_t count,
+                  const Ripemd160MultiBuffer* kernel);
+inline void hash160_many(uint8_t* out, const uint8_t* in, std::size_t len, std::size_t count) {
+    hash160_many(out, in, len, count, avx2_ripemd160_multi_buffer());
+}
+
+#endif //ECC_RIPEMD160_H
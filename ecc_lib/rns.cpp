@@ -0,0 +1,302 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+
+#include "modexp.h"
+#include "MontgomeryContext.h"
+#include "primality.h"
+#include "rns.h"
+
+namespace {
+
+// a - b mod m for a < 2m and b <= m: with m < 2^63 the top bit of the
+// difference is the borrow
+inline limb_t word_sub(limb_t m, limb_t a, limb_t b) {
+    const limb_t d = a - b;
+    return d + (m & (0 - (d >> 63)));
+}
+
+inline limb_t word_add(limb_t m, limb_t a, limb_t b) {
+    return word_sub(m, a + b, m);
+}
+
+// a b / 2^64 mod m for any a and b < m
+inline limb_t word_mul(limb_t m, limb_t minv, limb_t a, limb_t b) {
+    limb_t hi, mhi, carry = 0;
+    const limb_t lo = limb_mul(a, b, hi);
+    const limb_t mlo = limb_mul(lo * minv, m, mhi);
+    limb_addc(lo, mlo, carry);
+    return word_sub(m, hi + mhi + carry, m);
+}
+
+// sum += a b over three words
+inline void word_mac3(limb_t a, limb_t b, limb_t& lo, limb_t& mid, limb_t& hi) {
+    limb_t ph, carry = 0;
+    const limb_t pl = limb_mul(a, b, ph);
+    lo = limb_addc(lo, pl, carry);
+    mid = limb_addc(mid, ph, carry);
+    hi += carry;
+}
+
+// (hi:mid:lo) / 2^128 mod m for a value below m 2^128, by two word steps of
+// Montgomery reduction
+inline limb_t word_reduce3(limb_t m, limb_t minv, limb_t lo, limb_t mid, limb_t hi) {
+    limb_t ph, carry = 0;
+    limb_t pl = limb_mul(lo * minv, m, ph);
+    limb_addc(lo, pl, carry);
+    mid = limb_addc(mid, ph, carry);
+    hi += carry;
+    carry = 0;
+    pl = limb_mul(mid * minv, m, ph);
+    limb_addc(mid, pl, carry);
+    return word_sub(m, hi + ph + carry, m);
+}
+
+// x^-1 mod 2^64 for odd x
+limb_t inverse_2_64(limb_t x) {
+    return 0 - montgomery_n0(x);
+}
+
+// the primes below 2^62 from the top down, as many as asked for, kept for
+// every context after
+std::vector<limb_t> primes_below_2_62(std::size_t count) {
+    static std::mutex lock;
+    static std::vector<limb_t> primes;
+    std::lock_guard<std::mutex> guard(lock);
+    limb_t candidate = primes.empty() ? (limb_t(1) << 62) - 1 : primes.back() - 2;
+    for (; primes.size() < count; candidate -= 2) {
+        if (is_probable_prime(integer(candidate))) {
+            primes.push_back(candidate);
+        }
+    }
+    return std::vector<limb_t>(primes.begin(), primes.begin() + count);
+}
+
+}
+
+RnsContext::RnsContext(const integer& modulus) : n(modulus) {
+    if (modulus < 3 || !modulus[0]) {
+        throw std::invalid_argument("RNS modulus must be odd and at least 3");
+    }
+    // k primes of about 62 bits in each base, the fewest with M' > (k + 2)^2 N;
+    // a prime dividing N is passed over
+    const std::size_t bits = modulus.bit_length();
+    std::size_t want = 2 * ((bits + 61) / 61);
+    std::vector<limb_t> b, b2;
+    integer product_b, product_b2;
+    while (true) {
+        const std::vector<limb_t> primes = primes_below_2_62(want);
+        std::vector<limb_t> usable;
+        for (const limb_t p : primes) {
+            if (modulus % p != 0) {
+                usable.push_back(p);
+            }
+        }
+        this->k = usable.size() / 2;
+        b.assign(usable.begin(), usable.begin() + this->k);
+        b2.assign(usable.begin() + this->k, usable.begin() + 2 * this->k);
+        product_b = 1;
+        product_b2 = 1;
+        for (std::size_t i = 0; i < this->k; i++) {
+            product_b *= integer(b[i]);
+            product_b2 *= integer(b2[i]);
+        }
+        const integer bound = integer(this->k + 2) * integer(this->k + 2) * modulus;
+        if (product_b > bound && product_b2 > bound) {
+            break;
+        }
+        want += 2;
+    }
+    const std::size_t k = this->k;
+    this->base_primes = b;
+    this->base_primes.insert(this->base_primes.end(), b2.begin(), b2.end());
+    this->big_m = product_b;
+
+    const integer two_64 = integer(1) << 64;
+    const auto residue = [](const integer& x, limb_t m) {
+        const integer r = x % integer(m);
+        return static_cast<limb_t>((r < 0) ? r + integer(m) : r);
+    };
+    const auto low_word = [&two_64](const integer& x) {
+        const integer r = x % two_64;
+        return static_cast<limb_t>((r < 0) ? r + two_64 : r);
+    };
+    for (const limb_t p : this->base_primes) {
+        this->moduli.push_back({p, montgomery_n0(p), residue(two_64 * two_64, p)});
+    }
+    // x R^e mod m for the m of modulus i
+    const auto form = [&](const integer& x, std::size_t i, std::size_t e) {
+        const limb_t m = this->base_primes[i];
+        integer out = residue(x, m);
+        for (std::size_t j = 0; j < e; j++) {
+            out = out * two_64 % integer(m);
+        }
+        return static_cast<limb_t>(out);
+    };
+
+    const integer n_inv_b = modulus.modinv(product_b);
+    for (std::size_t i = 0; i < k; i++) {
+        const limb_t m = b[i];
+        this->m_i.push_back(product_b / integer(m));
+        const integer inv = this->m_i[i].modinv(integer(m));
+        this->m_i_inv.push_back(static_cast<limb_t>(inv));
+        this->q_factor.push_back(residue(-(n_inv_b * inv), m));
+        this->m_i_r.push_back(low_word(this->m_i[i]));
+    }
+    const integer m_inv_b2 = product_b.modinv(product_b2);
+    for (std::size_t j = 0; j < k; j++) {
+        for (std::size_t i = 0; i < k; i++) {
+            this->to_b2.push_back(form(this->m_i[i], k + j, 3));
+        }
+        this->n_b2.push_back(form(modulus, k + j, 1));
+        this->m_inv_b2.push_back(form(m_inv_b2, k + j, 1));
+    }
+    this->n_r = low_word(modulus);
+    this->m_inv_r = inverse_2_64(low_word(product_b));
+
+    std::vector<integer> m2_j;
+    for (std::size_t j = 0; j < k; j++) {
+        m2_j.push_back(product_b2 / integer(b2[j]));
+        this->m2_j_inv.push_back(static_cast<limb_t>(m2_j[j].modinv(integer(b2[j]))));
+        this->m2_j_r.push_back(low_word(m2_j[j]));
+    }
+    for (std::size_t i = 0; i < k; i++) {
+        for (std::size_t j = 0; j < k; j++) {
+            this->to_b.push_back(form(m2_j[j], i, 3));
+        }
+        this->m2_b.push_back(form(product_b2, i, 2));
+    }
+    this->m2_inv_r = inverse_2_64(low_word(product_b2));
+
+    this->unit = to_rns(1);
+}
+
+RnsValue RnsContext::to_rns(const integer& x) const {
+    integer y = x % this->n;
+    if (y < 0) {
+        y += this->n;
+    }
+    y = y * this->big_m % this->n;
+    RnsValue out;
+    out.residues.resize(2 * this->k + 1);
+    for (std::size_t i = 0; i < 2 * this->k; i++) {
+        const WordModulus& q = this->moduli[i];
+        out.residues[i] = word_mul(q.m, q.minv, static_cast<limb_t>(y % integer(q.m)), q.r2);
+    }
+    out.residues[2 * this->k] = static_cast<limb_t>(y);
+    return out;
+}
+
+integer RnsContext::from_rns(const RnsValue& a) const {
+    // a M^-1 times 1 in plain form, then the CRT in B
+    RnsValue plain;
+    plain.residues.resize(2 * this->k + 1);
+    for (std::size_t i = 0; i < 2 * this->k; i++) {
+        const WordModulus& q = this->moduli[i];
+        plain.residues[i] = word_mul(q.m, q.minv, 1, q.r2);
+    }
+    plain.residues[2 * this->k] = 1;
+    const RnsValue r = mul(a, plain);
+
+    integer sum = 0;
+    for (std::size_t i = 0; i < this->k; i++) {
+        const WordModulus& q = this->moduli[i];
+        sum.addmul(this->m_i[i], integer(word_mul(q.m, q.minv, r.residues[i], this->m_i_inv[i])));
+    }
+    return sum % this->big_m % this->n;
+}
+
+void RnsContext::mul_words(limb_t* out, const limb_t* a, const limb_t* b, limb_t* scratch) const {
+    const std::size_t k = this->k;
+    const WordModulus* base = this->moduli.data();
+    const WordModulus* base2 = base + k;
+    limb_t* xi = scratch;
+    limb_t* t2 = scratch + k;
+
+    // t = a b everywhere; in B, xi_i = t_i (-N^-1) (M / m_i)^-1, so that
+    // q = sum xi_i M / m_i is -t N^-1 mod M plus some alpha M, alpha < k
+    for (std::size_t i = 0; i < k; i++) {
+        const WordModulus& q = base[i];
+        xi[i] = word_mul(q.m, q.minv, word_mul(q.m, q.minv, a[i], b[i]), this->q_factor[i]);
+    }
+    for (std::size_t j = 0; j < k; j++) {
+        const WordModulus& q = base2[j];
+        t2[j] = word_mul(q.m, q.minv, a[k + j], b[k + j]);
+    }
+    const limb_t t_r = a[2 * k] * b[2 * k];
+
+    // r = (t + q N) / M in B' and mod 2^64; the k products of each extension
+    // sum below 2^130 and are reduced once
+    limb_t q_r = 0;
+    for (std::size_t i = 0; i < k; i++) {
+        q_r += xi[i] * this->m_i_r[i];
+    }
+    for (std::size_t j = 0; j < k; j++) {
+        const WordModulus& q = base2[j];
+        const limb_t* row = this->to_b2.data() + j * k;
+        limb_t lo = 0, mid = 0, hi = 0;
+        for (std::size_t i = 0; i < k; i++) {
+            word_mac3(xi[i], row[i], lo, mid, hi);
+        }
+        limb_t s = word_reduce3(q.m, q.minv, lo, mid, hi);
+        s = word_add(q.m, t2[j], word_mul(q.m, q.minv, s, this->n_b2[j]));
+        out[k + j] = word_mul(q.m, q.minv, s, this->m_inv_b2[j]);
+    }
+    const limb_t r_r = (t_r + q_r * this->n_r) * this->m_inv_r;
+    out[2 * k] = r_r;
+
+    // r back to B exactly: r = sum xi'_j M' / m'_j - alpha M', alpha < k
+    // read off the residues mod 2^64
+    limb_t sum_r = 0;
+    for (std::size_t j = 0; j < k; j++) {
+        const WordModulus& q = base2[j];
+        xi[j] = word_mul(q.m, q.minv, out[k + j], this->m2_j_inv[j]);
+        sum_r += xi[j] * this->m2_j_r[j];
+    }
+    const limb_t alpha = (sum_r - r_r) * this->m2_inv_r;
+    for (std::size_t i = 0; i < k; i++) {
+        const WordModulus& q = base[i];
+        const limb_t* row = this->to_b.data() + i * k;
+        limb_t lo = 0, mid = 0, hi = 0;
+        for (std::size_t j = 0; j < k; j++) {
+            word_mac3(xi[j], row[j], lo, mid, hi);
+        }
+        const limb_t s = word_reduce3(q.m, q.minv, lo, mid, hi);
+        out[i] = word_sub(q.m, s, word_mul(q.m, q.minv, alpha, this->m2_b[i]));
+    }
+}
+
+RnsValue RnsContext::mul(const RnsValue& a, const RnsValue& b) const {
+    RnsValue out;
+    mul(out, a, b);
+    return out;
+}
+
+void RnsContext::mul(RnsValue& out, const RnsValue& a, const RnsValue& b) const {
+    mul(&out, &a, &b, 1);
+}
+
+void RnsContext::mul(RnsValue* out, const RnsValue* a, const RnsValue* b, std::size_t count) const {
+    std::vector<limb_t> scratch(2 * this->k);
+    for (std::size_t i = 0; i < count; i++) {
+        out[i].residues.resize(2 * this->k + 1);
+        mul_words(out[i].residues.data(), a[i].residues.data(), b[i].residues.data(), scratch.data());
+    }
+}
+
+void RnsContext::mul(RnsValue* out, const RnsValue* a, const RnsValue* b, std::size_t count, Executor& executor) const {
+    const std::size_t chunks = std::min<std::size_t>(std::max<std::size_t>(executor.concurrency(), 1), count);
+    executor.run(chunks, [this, out, a, b, count, chunks](std::size_t c) {
+        const std::size_t begin = count * c / chunks, end = count * (c + 1) / chunks;
+        mul(out + begin, a + begin, b + begin, end - begin);
+    });
+}
+
+RnsValue RnsContext::pow(const RnsValue& a, const integer& exponent) const {
+    return sliding_window_pow(a, exponent, this->unit,
+            [this](const RnsValue& x, const RnsValue& y) { return mul(x, y); },
+            [this](const RnsValue& x) { return mul(x, x); });
+}
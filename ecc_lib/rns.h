@@ -0,0 +1,101 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_RNS_H
+#define ECC_RNS_H
+
+#include <cstddef>
+#include <vector>
+
+#include "Executor.h"
+#include "integer.h"
+#include "limb.h"
+
+// A value in the residue number system of an RnsContext: its residues modulo
+// the k primes of B, then the k of B' (each in that prime's word Montgomery
+// form), then the redundant residue mod 2^64
+struct RnsValue {
+    std::vector<limb_t> residues;
+};
+
+// Montgomery multiplication modulo an odd N of any size in a residue number
+// system, for long runs of mulmods by one large modulus (RSA accumulators). A
+// value is held as its residues modulo two bases B and B' of k primes below
+// 2^62, products M and M' both above (k + 2)^2 N, so a multiplication is 2k
+// independent word products plus two base extensions of k^2 word products
+// each, summed over three words and reduced once per residue, and no carry
+// crosses from one residue to another. mul(a, b) is the RNS Montgomery product
+// a b M^-1 mod N (Bajard, Didier and Kornerup): q = -a b N^-1 mod M in B,
+// q + alpha M extended to B' without correction (which only adds alpha N
+// to the result), and r = (a b + q N) / M in B'. r goes back to B exactly by
+// Shenoy and Kumaresan's extension, its alpha read off the redundant residue
+// mod 2^64, which costs nothing to keep. In place of Kawamura's fixed-point
+// estimate, this one is exact for every r below M'. Results are below
+// (k + 2) N rather than N, which every operation accepts; from_rns reduces.
+// Not constant time.
+class RnsContext {
+public:
+    // throws std::invalid_argument unless modulus is odd and at least 3
+    explicit RnsContext(const integer& modulus);
+
+    const integer& modulus() const { return this->n; }
+    // primes in each base
+    std::size_t base_size() const { return this->k; }
+    const std::vector<limb_t>& primes() const { return this->base_primes; }
+
+    // x mod N in Montgomery form, x M mod N, for any x
+    RnsValue to_rns(const integer& x) const;
+    // the value in [0, N) that a holds, a M^-1 mod N
+    integer from_rns(const RnsValue& a) const;
+    // Montgomery form of 1
+    const RnsValue& one() const { return this->unit; }
+
+    // a b M^-1 mod N, below (k + 2) N; out may be a or b
+    RnsValue mul(const RnsValue& a, const RnsValue& b) const;
+    void mul(RnsValue& out, const RnsValue& a, const RnsValue& b) const;
+    // out[i] = mul(a[i], b[i]), one scratch buffer for the lot; out may be a or b
+    void mul(RnsValue* out, const RnsValue* a, const RnsValue* b, std::size_t count) const;
+    // the same cut over executor's threads
+    void mul(RnsValue* out, const RnsValue* a, const RnsValue* b, std::size_t count, Executor& executor) const;
+
+    // a^exponent for a in Montgomery form, with a sliding window
+    RnsValue pow(const RnsValue& a, const integer& exponent) const;
+
+private:
+    struct WordModulus {
+        limb_t m;
+        limb_t minv;            // -m^-1 mod 2^64
+        limb_t r2;              // 2^128 mod m
+    };
+
+    integer n;
+    std::size_t k;
+    std::vector<limb_t> base_primes;        // B then B'
+    std::vector<WordModulus> moduli;
+    RnsValue unit;
+
+    integer big_m;                          // M
+    std::vector<integer> m_i;               // M / m_i, for from_rns
+    std::vector<limb_t> m_i_inv;            // (M / m_i)^-1 mod m_i
+
+    // B to B'
+    std::vector<limb_t> q_factor;           // -N^-1 (M / m_i)^-1 mod m_i
+    std::vector<limb_t> to_b2;              // row j: (M / m_i) R^3 mod m'_j
+    std::vector<limb_t> m_i_r;              // M / m_i mod 2^64
+    std::vector<limb_t> n_b2;               // N R mod m'_j
+    std::vector<limb_t> m_inv_b2;           // M^-1 R mod m'_j
+    limb_t n_r, m_inv_r;                    // N and M^-1 mod 2^64
+
+    // B' to B
+    std::vector<limb_t> m2_j_inv;           // (M' / m'_j)^-1 mod m'_j
+    std::vector<limb_t> to_b;               // row i: (M' / m'_j) R^3 mod m_i
+    std::vector<limb_t> m2_j_r;             // M' / m'_j mod 2^64
+    std::vector<limb_t> m2_b;               // M' R^2 mod m_i
+    limb_t m2_inv_r;                        // M'^-1 mod 2^64
+
+    // the product of a and b into out, with scratch of 2k words
+    void mul_words(limb_t* out, const limb_t* a, const limb_t* b, limb_t* scratch) const;
+};
+
+#endif //ECC_RNS_H
@@ -0,0 +1,138 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <stdexcept>
+
+#include "modexp.h"
+#include "primality.h"
+#include "rsa.h"
+
+namespace {
+
+// base^exponent mod the reducer's modulus, for 0 <= base below it
+integer pow_mod(const BarrettReducer& reducer, const integer& base, const integer& exponent) {
+    return sliding_window_pow(base, exponent, reducer.reduce(1),
+            [&reducer](const integer& x, const integer& y) { return reducer.mul(x, y); },
+            [&reducer](const integer& x) { return reducer.reduce(x.square()); });
+}
+
+// a prime of bits bits, its top two bits set, with p - 1 coprime to e
+integer random_prime(std::size_t bits, const integer& e, ChaCha20Rng& rng) {
+    const integer top = integer(3) << (bits - 2);
+    for (;;) {
+        const integer p = next_prime(rng.random_below(integer(1) << bits) | top);
+        if (p.bit_length() == bits && gcd(p - 1, e) == 1) {
+            return p;
+        }
+    }
+}
+
+}
+
+RsaKey::RsaKey(const integer& p, const integer& q, const integer& e, const integer& d)
+        : n(p * q), e(e), d(d), mod_n(p * q), mod_p(p), mod_q(q),
+          dp(d % (p - 1)), dq(d % (q - 1)), q_inv(q.modinv(p)) {}
+
+Result<RsaKey> RsaKey::make(const integer& p, const integer& q, const integer& e) {
+    if (p <= 2 || q <= 2 || p == q || !is_probable_prime(p) || !is_probable_prime(q)) {
+        return Status::bad_modulus;
+    }
+    if (e <= 1 || !e.test_bit(0)) {
+        return Status::not_invertible;
+    }
+    // d = e^-1 mod lcm(p - 1, q - 1), which exists just when e is coprime to both
+    const Result<integer> d = e.try_modinv(lcm(p - 1, q - 1));
+    if (!d) {
+        return Status::not_invertible;
+    }
+    return RsaKey(p, q, e, *d);
+}
+
+RsaKey RsaKey::generate(std::size_t bits, ChaCha20Rng& rng, const integer& e) {
+    if (bits < 64 || bits % 2) {
+        throw std::invalid_argument("RSA modulus must be an even number of bits, at least 64");
+    }
+    const integer p = random_prime(bits / 2, e, rng);
+    integer q = random_prime(bits / 2, e, rng);
+    while (q == p) {
+        q = random_prime(bits / 2, e, rng);
+    }
+    Result<RsaKey> key = make(p, q, e);
+    if (!key) {
+        throw_status(key.status(), "RSA public exponent must be odd and above 1");
+    }
+    return std::move(*key);
+}
+
+Result<integer> RsaKey::public_op(const integer& x) const {
+    if (x < 0 || x >= this->n) {
+        return Status::out_of_range;
+    }
+    return pow_mod(this->mod_n, x, this->e);
+}
+
+Result<integer> RsaKey::private_op(const integer& x) const {
+    if (x < 0 || x >= this->n) {
+        return Status::out_of_range;
+    }
+    if (!this->blinding) {
+        return checked(x, crt(x));
+    }
+
+    // take the pair and leave its square for the next caller
+    integer factor, inverse;
+    {
+        const std::lock_guard<std::mutex> hold(this->blinding->lock);
+        Blinding& b = *this->blinding;
+        if (b.uses == BLINDING_REFRESH) {
+            refresh(b);
+        }
+        factor = b.factor;
+        inverse = b.inverse;
+        b.factor = this->mod_n.reduce(factor.square());
+        b.inverse = this->mod_n.reduce(inverse.square());
+        b.uses++;
+    }
+    const integer blinded = this->mod_n.mul(x, factor);
+    const Result<integer> y = checked(blinded, crt(blinded));
+    if (!y) {
+        return y;
+    }
+    return this->mod_n.mul(*y, inverse);
+}
+
+void RsaKey::enable_blinding() {
+    if (!this->blinding) {
+        this->blinding.reset(new Blinding());
+        refresh(*this->blinding);
+    }
+}
+
+void RsaKey::refresh(Blinding& b) const {
+    ChaCha20Rng& rng = ChaCha20Rng::local();
+    for (;;) {
+        const integer r = rng.random_below(this->n);
+        Result<integer> inverse = r.try_modinv(this->n);
+        if (r > 1 && inverse) {
+            b.factor = pow_mod(this->mod_n, r, this->e);
+            b.inverse = std::move(*inverse);
+            b.uses = 0;
+            return;
+        }
+    }
+}
+
+integer RsaKey::crt(const integer& x) const {
+    const integer mp = pow_mod(this->mod_p, this->mod_p.reduce(x), this->dp);
+    const integer mq = pow_mod(this->mod_q, this->mod_q.reduce(x), this->dq);
+    // Garner: h = q^-1 (mp - mq) mod p, m = mq + h q
+    const integer h = this->mod_p.mul(this->q_inv, this->mod_p.reduce(mp - mq));
+    return mq + h * this->mod_q.modulus();
+}
+
+Result<integer> RsaKey::checked(const integer& x, const integer& y) const {
+    if (pow_mod(this->mod_n, y, this->e) != x) {
+        return Status::bad_signature;
+    }
+    return y;
+}
@@ -0,0 +1,237 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <cstring>
+#include <random>
+
+#include "chacha20.h"
+#include "Curve.h"
+#include "decompress.h"
+#include "metrics.h"
+#include "msm.h"
+#include "Scalar.h"
+#include "schnorr.h"
+#include "sec1.h"
+#include "sha256.h"
+#include "tagged_hash.h"
+#include "trace.h"
+
+namespace {
+
+// x of the finite point p in out[0, 32), returning whether y is odd
+bool affine_x(const Point& p, uint8_t* out) {
+    const std::pair<FieldElement, FieldElement> xy = p.affine();
+    uint8_t y[32];
+    xy.first.to_bytes(out, 32);
+    xy.second.to_bytes(y, 32);
+    return y[31] & 1;
+}
+
+// e = hash_BIP0340/challenge(R.x || P.x || m) mod n
+Scalar challenge(const uint8_t* rx, const uint8_t* px, const uint8_t* message, std::size_t len) {
+    uint8_t e[32];
+    TaggedHash(BIP340_CHALLENGE_TAG).update(rx, 32).update(px, 32).update(message, len).finish(e);
+    return Scalar::from_bytes(e, 32, Curve::secp256k1().scalar_field());
+}
+
+// lift_x of BIP340: the point with x and even y
+Result<Point> lift_x(const uint8_t* x) {
+    uint8_t key[33] = {0x02};
+    std::memcpy(key + 1, x, 32);
+    Result<Point> p = sec1_decode(key, sizeof(key), Curve::secp256k1());
+    if (!p) {
+        return p.status() == Status::out_of_range ? Status::bad_encoding : Status::not_on_curve;
+    }
+    return p;
+}
+
+// the checks of schnorr_verify that need no point arithmetic
+Status check_ranges(const uint8_t* signature, const uint8_t* public_key) {
+    const Curve& curve = Curve::secp256k1();
+    if (!(uint256::load_be(public_key, 32) < curve.field().fixed_prime())
+        || !(uint256::load_be(signature, 32) < curve.field().fixed_prime())
+        || !(uint256::load_be(signature + 32, 32) < curve.scalar_field().fixed_prime())) {
+        return Status::bad_encoding;
+    }
+    return Status::ok;
+}
+
+// schnorr_verify with s * G - e * P from combine(s, e), or the status of a
+// key with no point
+template <typename Combine>
+Status verify_with(const uint8_t* signature, const uint8_t* message, std::size_t len, const uint8_t* public_key,
+                   Combine combine) {
+    static Histogram& latency = Metrics::global().histogram("ecc_schnorr_verify_seconds",
+                                                            "BIP340 signatures verified");
+    HistogramTimer timer(latency);
+    const Status range = check_ranges(signature, public_key);
+    if (range != Status::ok) {
+        return range;
+    }
+    const Curve& curve = Curve::secp256k1();
+    const Scalar s = Scalar::from_bytes(signature + 32, 32, curve.scalar_field());
+    const Scalar e = challenge(signature, public_key, message, len);
+    const Result<Point> r = combine(s, e);
+    if (!r) {
+        return r.status();
+    }
+    if (r->is_infinity()) {
+        return Status::bad_signature;
+    }
+    uint8_t rx[32];
+    if (affine_x(*r, rx) || std::memcmp(rx, signature, 32) != 0) {
+        return Status::bad_signature;
+    }
+    return Status::ok;
+}
+
+}
+
+Status schnorr_public_key(uint8_t* out, const uint8_t* secret) noexcept {
+    const Curve& curve = Curve::secp256k1();
+    const uint256 d = uint256::load_be(secret, 32);
+    if (d.is_zero() || !(d < curve.scalar_field().fixed_prime())) {
+        return Status::out_of_range;
+    }
+    affine_x(curve.mul_base_ct(d.to_integer()), out);
+    return Status::ok;
+}
+
+Status schnorr_sign(uint8_t* signature, const uint8_t* message, std::size_t len, const uint8_t* secret,
+                    const uint8_t* aux_rand) noexcept {
+    static Histogram& latency = Metrics::global().histogram("ecc_schnorr_sign_seconds", "BIP340 signatures made");
+    HistogramTimer timer(latency);
+    const Curve& curve = Curve::secp256k1();
+    const PrimeField& order = curve.scalar_field();
+    const uint256 d_value = uint256::load_be(secret, 32);
+    if (d_value.is_zero() || !(d_value < order.fixed_prime())) {
+        return Status::out_of_range;
+    }
+    uint8_t px[32];
+    const Scalar d_prime(d_value.to_integer(), order);
+    const bool odd = affine_x(curve.mul_base_ct(d_value.to_integer()), px);
+    const Scalar d = Scalar::select(0 - static_cast<limb_t>(odd), -d_prime, d_prime);
+
+    // t = bytes(d) xor hash_BIP0340/aux(a), then k' = hash_BIP0340/nonce(t || P.x || m) mod n
+    static const uint8_t zeros[32] = {0};
+    uint8_t t[32], db[32], rand[32];
+    TaggedHash(BIP340_AUX_TAG).update(aux_rand ? aux_rand : zeros, 32).finish(t);
+    d.to_bytes(db);
+    for (std::size_t i = 0; i < 32; i++) {
+        t[i] ^= db[i];
+    }
+    TaggedHash(BIP340_NONCE_TAG).update(t, 32).update(px, 32).update(message, len).finish(rand);
+    const Scalar k_prime = Scalar::from_bytes(rand, 32, order);
+    if (k_prime.is_zero()) {
+        return Status::out_of_range;
+    }
+
+    uint8_t rx[32];
+    const bool r_odd = affine_x(curve.mul_base_ct(k_prime.value()), rx);
+    const Scalar k = Scalar::select(0 - static_cast<limb_t>(r_odd), -k_prime, k_prime);
+    const Scalar s = k + challenge(rx, px, message, len) * d;
+    std::memcpy(signature, rx, 32);
+    s.to_bytes(signature + 32);
+    return Status::ok;
+}
+
+Status schnorr_verify(const uint8_t* signature, const uint8_t* message, std::size_t len,
+                      const uint8_t* public_key) noexcept {
+    return verify_with(signature, message, len, public_key, [&](const Scalar& s, const Scalar& e) -> Result<Point> {
+        const Result<Point> p = lift_x(public_key);
+        if (!p) {
+            return p.status();
+        }
+        return Point::mul_add(s.value(), Curve::secp256k1().generator(), (-e).value(), *p);
+    });
+}
+
+Status schnorr_verify(const uint8_t* signature, const uint8_t* message, std::size_t len,
+                      const uint8_t* public_key, const WnafTable& key_table) noexcept {
+    return verify_with(signature, message, len, public_key, [&](const Scalar& s, const Scalar& e) -> Result<Point> {
+        return Point::mul_add(s.value(), Curve::secp256k1().generator_wnaf(), (-e).value(), key_table);
+    });
+}
+
+Status schnorr_verify_batch(const std::vector<SchnorrSigned>& items, unsigned threads) {
+    ThreadExecutor executor(threads);
+    return schnorr_verify_batch(items, executor);
+}
+
+Status schnorr_verify_batch(const std::vector<SchnorrSigned>& items, Executor& executor) {
+    if (items.empty()) {
+        return Status::ok;
+    }
+    ECC_TRACE_SPAN("schnorr.batch");
+    static Histogram& latency = Metrics::global().histogram("ecc_schnorr_verify_batch_seconds",
+                                                            "schnorr_verify_batch calls");
+    HistogramTimer timer(latency);
+    const Curve& curve = Curve::secp256k1();
+    const PrimeField& order = curve.scalar_field();
+    const std::size_t count = items.size();
+
+    // every public key, then every R.x, as compressed keys with even y
+    std::vector<uint8_t> keys(2 * count * 33, 0x02);
+    for (std::size_t i = 0; i < count; i++) {
+        const Status range = check_ranges(items[i].signature, items[i].public_key);
+        if (range != Status::ok) {
+            return range;
+        }
+        std::memcpy(keys.data() + i * 33 + 1, items[i].public_key, 32);
+        std::memcpy(keys.data() + (count + i) * 33 + 1, items[i].signature, 32);
+    }
+    const DecompressedKeys lifted = decompress_keys(keys.data(), 2 * count, curve, executor);
+    for (std::size_t i = 0; i < count; i++) {
+        if (!lifted.valid(i)) {
+            return Status::not_on_curve;
+        }
+    }
+    // an R.x with no point cannot be the x of s * G - e * P
+    if (lifted.invalid_count()) {
+        return Status::bad_signature;
+    }
+
+    Sha256 seed_hash;
+    std::random_device device;
+    for (std::size_t i = 0; i < 8; i++) {
+        const uint32_t word = device();
+        const uint8_t bytes[4] = {static_cast<uint8_t>(word), static_cast<uint8_t>(word >> 8),
+                                  static_cast<uint8_t>(word >> 16), static_cast<uint8_t>(word >> 24)};
+        seed_hash.update(bytes, 4);
+    }
+    std::vector<Scalar> e;
+    e.reserve(count);
+    {
+        ECC_TRACE_SPAN("schnorr.challenges");
+        for (std::size_t i = 0; i < count; i++) {
+            e.push_back(challenge(items[i].signature, items[i].public_key, items[i].message, items[i].length));
+            uint8_t eb[32];
+            e.back().to_bytes(eb);
+            seed_hash.update(items[i].signature, 64);
+            seed_hash.update(items[i].public_key, 32);
+            seed_hash.update(eb, 32);
+        }
+    }
+    uint8_t seed[Sha256::DIGEST_SIZE];
+    seed_hash.finish(seed);
+
+    Scalar base(order);
+    std::vector<integer> scalars(1);
+    std::vector<Point> points(1, curve.generator());
+    scalars.reserve(2 * count + 1);
+    points.reserve(2 * count + 1);
+    // a_1 = 1 and a_i the next 128 bits of ChaCha20 keyed by the seed
+    ChaCha20Rng rng(seed);
+    std::vector<uint8_t> randomizers(16 * count);
+    rng.fill(randomizers.data(), randomizers.size());
+    for (std::size_t i = 0; i < count; i++) {
+        const Scalar a = i ? Scalar::from_bytes(randomizers.data() + 16 * i, 16, order) : Scalar(1, order);
+        base += a * Scalar::from_bytes(items[i].signature + 32, 32, order);
+        scalars.push_back((-a).value());
+        points.push_back(lifted.points[count + i]);
+        scalars.push_back((-(a * e[i])).value());
+        points.push_back(lifted.points[i]);
+    }
+    scalars[0] = base.value();
+    return multi_scalar_mul(scalars, points, executor).is_infinity() ? Status::ok : Status::bad_signature;
+}
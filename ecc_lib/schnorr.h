@@ -0,0 +1,63 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_SCHNORR_H
+#define ECC_SCHNORR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Executor.h"
+#include "Point.h"
+#include "Status.h"
+
+// BIP340 Schnorr signatures on secp256k1: 32-byte x-only public keys that
+// stand for the point with that x and even y, 64-byte signatures R.x || s, and
+// messages of any length. The hashes are SHA-256, tagged as BIP340 says.
+
+// the x-only public key of the 32-byte big-endian secret, by
+// FixedBaseTable::mul_ct; Status::out_of_range for a secret not in [1, n)
+Status schnorr_public_key(uint8_t* out, const uint8_t* secret) noexcept;
+
+// BIP340 signing of message[0, len) with 32 bytes of auxiliary randomness,
+// which may be null for all zeros (deterministic signatures). Both
+// multiplications by G take FixedBaseTable::mul_ct and the negations of the
+// secret and nonce are masked. Status::out_of_range for a bad secret
+Status schnorr_sign(uint8_t* signature, const uint8_t* message, std::size_t len, const uint8_t* secret,
+                    const uint8_t* aux_rand) noexcept;
+
+// BIP340 verification, s * G - e * P by Point::mul_add with the GLV split:
+// Status::ok, Status::bad_encoding for a key or R.x not below p or s not below
+// n, Status::not_on_curve for a key with no point, Status::bad_signature
+// when the result is at infinity, has odd y or another x
+Status schnorr_verify(const uint8_t* signature, const uint8_t* message, std::size_t len,
+                      const uint8_t* public_key) noexcept;
+// the same with the tables of lift_x(public_key) made already
+// (Point::wnaf_table) and G's from Curve::generator_wnaf, so neither the
+// square root of lift_x nor the tables are paid for the call
+Status schnorr_verify(const uint8_t* signature, const uint8_t* message, std::size_t len,
+                      const uint8_t* public_key, const WnafTable& key_table) noexcept;
+
+struct SchnorrSigned {
+    const uint8_t* signature;       // 64 bytes
+    const uint8_t* message;
+    std::size_t length;
+    const uint8_t* public_key;      // 32 bytes
+};
+
+// Whether every one of items verifies, by the batch equation of BIP340:
+// (sum a_i s_i) G - sum a_i R_i - sum a_i e_i P_i is infinity for a_1 = 1 and
+// random 128-bit a_i, one multi_scalar_mul of 2n + 1 points (Pippenger, with
+// threads as there, from 32 points up). The keys and every R are lifted
+// together by decompress_keys. The a_i are the ChaCha20Rng stream of a seed
+// hashed from std::random_device and all of the inputs, fresh for each call,
+// so a batch with a bad signature passes with probability 2^-128. Returns the
+// first decoding failure as schnorr_verify would, or Status::bad_signature
+// without saying which signature failed.
+Status schnorr_verify_batch(const std::vector<SchnorrSigned>& items, unsigned threads = 1);
+// the same with the lifting and the multiplication run on executor
+Status schnorr_verify_batch(const std::vector<SchnorrSigned>& items, Executor& executor);
+
+#endif //ECC_SCHNORR_H
@@ -0,0 +1,325 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include "metrics.h"
+#include "schnorr_async.h"
+#include "secure_zero.h"
+
+namespace {
+
+// the process-wide metrics of every instance, beside each one's own metrics()
+Metrics::Gauge& queue_depth() {
+    static Metrics::Gauge& depth = Metrics::global().gauge("ecc_async_queue_depth",
+                                                           "requests waiting for AsyncSchnorr's dispatcher");
+    return depth;
+}
+
+Histogram& request_seconds() {
+    static Histogram& latency = Metrics::global().histogram("ecc_async_request_seconds",
+                                                            "AsyncSchnorr requests, submission to completion");
+    return latency;
+}
+
+Histogram& batch_size() {
+    static Histogram& sizes = Metrics::global().histogram("ecc_async_batch_size", "AsyncSchnorr batches", 1);
+    return sizes;
+}
+
+}
+
+AsyncSchnorr::AsyncSchnorr(Executor& executor, std::chrono::microseconds budget, std::size_t max_batch,
+                           bool adaptive)
+        : executor(executor), budget(budget), max_batch(max_batch ? max_batch : 1), adaptive(adaptive),
+          head(&stub), tail(&stub), queued(0), wanted(SIZE_MAX), stopping(false), rate(0),
+          last_take(std::chrono::steady_clock::now()), requests(0), batches(0), full_batches(0), failed_batches(0) {
+    this->stub.next.store(nullptr);
+    for (std::atomic<uint64_t>& n : this->batch_sizes) {
+        n.store(0);
+    }
+    for (std::atomic<uint64_t>& n : this->latencies) {
+        n.store(0);
+    }
+    this->dispatcher = std::thread([this]() { dispatch(); });
+}
+
+AsyncSchnorr::~AsyncSchnorr() {
+    {
+        std::lock_guard<std::mutex> guard(this->lock);
+        this->stopping = true;
+    }
+    this->arrived.notify_one();
+    this->dispatcher.join();
+}
+
+AsyncSchnorr& AsyncSchnorr::shared() {
+    static AsyncSchnorr instance(WorkStealingPool::shared());
+    return instance;
+}
+
+void AsyncSchnorr::push(Node* node) {
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Node* prev = this->head.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+}
+
+AsyncSchnorr::Request* AsyncSchnorr::pop() {
+    Node* first = this->tail;
+    Node* next = first->next.load(std::memory_order_acquire);
+    if (first == &this->stub) {
+        if (!next) {
+            return nullptr;
+        }
+        this->tail = next;
+        first = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+    if (next) {
+        this->tail = next;
+        return static_cast<Request*>(first);
+    }
+    if (first != this->head.load(std::memory_order_acquire)) {
+        return nullptr;     // a producer is between its two steps
+    }
+    // first is the last node: put the stub behind it so it can be taken
+    push(&this->stub);
+    next = first->next.load(std::memory_order_acquire);
+    if (next) {
+        this->tail = next;
+        return static_cast<Request*>(first);
+    }
+    return nullptr;
+}
+
+void AsyncSchnorr::submit(std::unique_ptr<Request> request) {
+    request->arrived = std::chrono::steady_clock::now();
+    push(request.release());
+    queue_depth().add(1);
+    // queued goes up before wanted is read, and the dispatcher sets wanted
+    // before it reads queued, so one of the two sees the other
+    if (this->queued.fetch_add(1) + 1 >= this->wanted.load()) {
+        { std::lock_guard<std::mutex> guard(this->lock); }
+        this->arrived.notify_one();
+    }
+}
+
+void AsyncSchnorr::drain(std::vector<std::unique_ptr<Request>>& batch) {
+    while (batch.size() < this->max_batch && this->queued.load()) {
+        Request* r = pop();
+        if (!r) {
+            std::this_thread::yield();
+            continue;
+        }
+        this->queued--;
+        queue_depth().add(-1);
+        batch.emplace_back(r);
+    }
+}
+
+bool AsyncSchnorr::await(std::size_t want, const std::chrono::steady_clock::time_point* deadline) {
+    std::unique_lock<std::mutex> guard(this->lock);
+    this->wanted.store(want);
+    const auto ready = [&]() { return this->stopping || this->queued.load() >= want; };
+    if (deadline) {
+        this->arrived.wait_until(guard, *deadline, ready);
+    } else {
+        this->arrived.wait(guard, ready);
+    }
+    this->wanted.store(SIZE_MAX);
+    return this->stopping;
+}
+
+std::chrono::microseconds AsyncSchnorr::wait_for(std::size_t have) const {
+    if (!this->adaptive) {
+        return this->budget;
+    }
+    const double budget = static_cast<double>(this->budget.count());
+    if (this->rate * budget < 1) {
+        return std::chrono::microseconds(0);
+    }
+    const double fill = static_cast<double>(this->max_batch - have) / this->rate;
+    return std::chrono::microseconds(static_cast<int64_t>(std::min(budget, fill)));
+}
+
+void AsyncSchnorr::verify(const uint8_t* signature, const uint8_t* message, std::size_t len,
+                          const uint8_t* public_key, VerifyCallback done) {
+    std::unique_ptr<Request> request(new Request());
+    request->signing = false;
+    request->message.assign(message, message + len);
+    std::memcpy(request->signature, signature, 64);
+    std::memcpy(request->key, public_key, 32);
+    request->has_aux = false;
+    request->verified = std::move(done);
+    submit(std::move(request));
+}
+
+std::future<Status> AsyncSchnorr::verify(const uint8_t* signature, const uint8_t* message, std::size_t len,
+                                         const uint8_t* public_key) {
+    std::shared_ptr<std::promise<Status>> promise = std::make_shared<std::promise<Status>>();
+    std::future<Status> future = promise->get_future();
+    verify(signature, message, len, public_key, [promise](Status status) { promise->set_value(status); });
+    return future;
+}
+
+void AsyncSchnorr::sign(const uint8_t* message, std::size_t len, const uint8_t* secret, const uint8_t* aux_rand,
+                        SignCallback done) {
+    std::unique_ptr<Request> request(new Request());
+    request->signing = true;
+    request->message.assign(message, message + len);
+    std::memcpy(request->key, secret, 32);
+    request->has_aux = aux_rand != nullptr;
+    if (aux_rand) {
+        std::memcpy(request->aux, aux_rand, 32);
+    }
+    request->signed_ = std::move(done);
+    submit(std::move(request));
+}
+
+std::future<Result<AsyncSchnorr::Signature>> AsyncSchnorr::sign(const uint8_t* message, std::size_t len,
+                                                                const uint8_t* secret, const uint8_t* aux_rand) {
+    typedef Result<Signature> Signed;
+    std::shared_ptr<std::promise<Signed>> promise = std::make_shared<std::promise<Signed>>();
+    std::future<Signed> future = promise->get_future();
+    sign(message, len, secret, aux_rand, [promise](Status status, const uint8_t* signature) {
+        if (status != Status::ok) {
+            promise->set_value(Signed(status));
+            return;
+        }
+        Signature out;
+        std::memcpy(out.data(), signature, out.size());
+        promise->set_value(Signed(out));
+    });
+    return future;
+}
+
+AsyncSchnorr::Metrics AsyncSchnorr::metrics() const {
+    Metrics m;
+    for (std::size_t k = 0; k < m.batch_size.size(); k++) {
+        m.batch_size[k] = this->batch_sizes[k].load(std::memory_order_relaxed);
+    }
+    for (std::size_t k = 0; k < m.latency.size(); k++) {
+        m.latency[k] = this->latencies[k].load(std::memory_order_relaxed);
+    }
+    m.requests = this->requests.load(std::memory_order_relaxed);
+    m.batches = this->batches.load(std::memory_order_relaxed);
+    m.full_batches = this->full_batches.load(std::memory_order_relaxed);
+    m.failed_batches = this->failed_batches.load(std::memory_order_relaxed);
+    return m;
+}
+
+void AsyncSchnorr::dispatch() {
+    std::vector<std::unique_ptr<Request>> batch;
+    for (;;) {
+        const bool stop = await(1, nullptr);
+        drain(batch);
+        if (batch.empty()) {
+            return;     // stopping, with nothing left
+        }
+        // the deadline runs from the oldest request, so none waits longer
+        // than the budget plus the batch ahead of it
+        const std::chrono::steady_clock::time_point deadline = batch.front()->arrived + wait_for(batch.size());
+        while (!stop && batch.size() < this->max_batch && std::chrono::steady_clock::now() < deadline) {
+            const bool stopped = await(this->max_batch - batch.size(), &deadline);
+            drain(batch);
+            if (stopped) {
+                break;
+            }
+        }
+
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        const double interval = std::max<double>(
+                1, std::chrono::duration_cast<std::chrono::microseconds>(now - this->last_take).count());
+        this->rate = 0.75 * this->rate + 0.25 * static_cast<double>(batch.size()) / interval;
+        this->last_take = now;
+
+        process(batch);
+        batch.clear();
+    }
+}
+
+namespace {
+
+// the bucket of n, by powers of two, the last taking everything above it
+template <std::size_t N>
+void count_in(std::array<std::atomic<uint64_t>, N>& buckets, uint64_t n) {
+    std::size_t k = 0;
+    while (n > 1 && k + 1 < N) {
+        n >>= 1;
+        k++;
+    }
+    buckets[k].fetch_add(1, std::memory_order_relaxed);
+}
+
+}
+
+void AsyncSchnorr::process(std::vector<std::unique_ptr<Request>>& batch) {
+    std::vector<std::size_t> signing, verifying;
+    for (std::size_t i = 0; i < batch.size(); i++) {
+        (batch[i]->signing ? signing : verifying).push_back(i);
+    }
+    std::vector<Status> status(batch.size(), Status::ok);
+
+    // one task per signature, and one for each verification if the batch fails
+    const auto one = [&](std::size_t i) {
+        Request& r = *batch[i];
+        if (r.signing) {
+            status[i] = schnorr_sign(r.signature, r.message.data(), r.message.size(), r.key,
+                                     r.has_aux ? r.aux : nullptr);
+            secure_zero(r.key, sizeof(r.key));
+        } else {
+            status[i] = schnorr_verify(r.signature, r.message.data(), r.message.size(), r.key);
+        }
+    };
+    this->executor.run(signing.size(), [&](std::size_t k) { one(signing[k]); });
+
+    if (verifying.size() > 1) {
+        std::vector<SchnorrSigned> items;
+        items.reserve(verifying.size());
+        for (std::size_t i : verifying) {
+            const Request& r = *batch[i];
+            items.push_back(SchnorrSigned{r.signature, r.message.data(), r.message.size(), r.key});
+        }
+        if (schnorr_verify_batch(items, this->executor) != Status::ok) {
+            this->failed_batches.fetch_add(1, std::memory_order_relaxed);
+            this->executor.run(verifying.size(), [&](std::size_t k) { one(verifying[k]); });
+        }
+    } else if (verifying.size() == 1) {
+        one(verifying[0]);
+    }
+
+    // counted before the callbacks, so a caller woken by one sees its request in metrics()
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    Histogram& latency = request_seconds();
+    for (const std::unique_ptr<Request>& r : batch) {
+        count_in(this->latencies, std::chrono::duration_cast<std::chrono::microseconds>(now - r->arrived).count());
+        latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(now - r->arrived).count());
+    }
+    count_in(this->batch_sizes, batch.size());
+    batch_size().record(batch.size());
+    this->requests.fetch_add(batch.size(), std::memory_order_relaxed);
+    this->batches.fetch_add(1, std::memory_order_relaxed);
+    this->full_batches.fetch_add(batch.size() == this->max_batch, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < batch.size(); i++) {
+        Request& r = *batch[i];
+        if (r.signing) {
+            r.signed_(status[i], r.signature);
+        } else {
+            r.verified(status[i]);
+        }
+    }
+}
+
+std::future<Status> schnorr_verify_async(const uint8_t* signature, const uint8_t* message, std::size_t len,
+                                         const uint8_t* public_key) {
+    return AsyncSchnorr::shared().verify(signature, message, len, public_key);
+}
+
+std::future<Result<AsyncSchnorr::Signature>> schnorr_sign_async(const uint8_t* message, std::size_t len,
+                                                                const uint8_t* secret, const uint8_t* aux_rand) {
+    return AsyncSchnorr::shared().sign(message, len, secret, aux_rand);
+}
@@ -0,0 +1,153 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_SCHNORR_ASYNC_H
+#define ECC_SCHNORR_ASYNC_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Executor.h"
+#include "Status.h"
+#include "schnorr.h"
+
+// BIP340 signing and verification that return at once and complete later, for
+// servers that must not block their event loop for the length of a verify.
+// Requests are copied onto a lock-free queue; a dispatch thread takes them off
+// as a batch once max_batch are waiting or budget has passed since the oldest
+// arrived, and runs the batch on the executor: the verifications as one
+// schnorr_verify_batch, the signatures one task each. When a batch fails, its
+// requests are verified one by one, so every caller gets the status
+// schnorr_verify would have given it. Requests arriving while a batch runs
+// gather into the next one.
+//
+// With adaptive set, the wait is cut to what the recent arrival rate needs to
+// fill a batch, and dropped when fewer than one more request is expected
+// within the budget, so a lightly loaded server answers without the delay.
+//
+// Completion is a callback, run on the dispatch thread, or a std::future. A
+// coroutine front end awaits the callback form: await_suspend hands over a
+// callback that stores the status and resumes the handle on the loop.
+class AsyncSchnorr {
+public:
+    typedef std::function<void(Status)> VerifyCallback;
+    // the signature is valid only during the call, and only for Status::ok
+    typedef std::function<void(Status, const uint8_t* signature)> SignCallback;
+    typedef std::array<uint8_t, 64> Signature;
+
+    // Counts since the instance was made. Bucket k of batch_size counts
+    // batches of 2^k to 2^(k+1) - 1 requests, bucket k of latency requests
+    // completed 2^k to 2^(k+1) - 1 microseconds after they were submitted (the
+    // first also those below a microsecond); the last buckets take everything
+    // above them
+    struct Metrics {
+        std::array<uint64_t, 16> batch_size{};
+        std::array<uint64_t, 24> latency{};
+        uint64_t requests = 0;
+        uint64_t batches = 0;
+        uint64_t full_batches = 0;      // taken at max_batch rather than at the deadline
+        uint64_t failed_batches = 0;    // verifications that fell back to one at a time
+    };
+
+    explicit AsyncSchnorr(Executor& executor, std::chrono::microseconds budget = std::chrono::microseconds(200),
+                          std::size_t max_batch = 1024, bool adaptive = true);
+    // completes every request already queued, then stops the dispatch thread
+    ~AsyncSchnorr();
+    AsyncSchnorr(const AsyncSchnorr&) = delete;
+    AsyncSchnorr& operator=(const AsyncSchnorr&) = delete;
+
+    // schnorr_verify. The callbacks must not throw
+    void verify(const uint8_t* signature, const uint8_t* message, std::size_t len, const uint8_t* public_key,
+                VerifyCallback done);
+    std::future<Status> verify(const uint8_t* signature, const uint8_t* message, std::size_t len,
+                               const uint8_t* public_key);
+    // schnorr_sign; aux_rand may be null. The copy of the secret is zeroed
+    // once the signature is made
+    void sign(const uint8_t* message, std::size_t len, const uint8_t* secret, const uint8_t* aux_rand,
+              SignCallback done);
+    std::future<Result<Signature>> sign(const uint8_t* message, std::size_t len, const uint8_t* secret,
+                                        const uint8_t* aux_rand);
+
+    // read while requests complete; each count is exact, the set of them is
+    // not one instant's
+    Metrics metrics() const;
+
+    // one instance for the process on WorkStealingPool::shared(), started on first use
+    static AsyncSchnorr& shared();
+
+private:
+    struct Node {
+        std::atomic<Node*> next;
+    };
+    struct Request : Node {
+        std::chrono::steady_clock::time_point arrived;
+        bool signing;
+        std::vector<uint8_t> message;
+        uint8_t signature[64];      // the signature to verify
+        uint8_t key[32];            // the public key to verify with, or the secret
+        uint8_t aux[32];
+        bool has_aux;
+        VerifyCallback verified;
+        SignCallback signed_;
+    };
+
+    Executor& executor;
+    std::chrono::microseconds budget;
+    std::size_t max_batch;
+    bool adaptive;
+
+    // Vyukov's intrusive queue: producers swap themselves in at head and then
+    // link the previous node to them; the dispatcher alone follows next from
+    // tail. A node swapped in but not yet linked holds up the ones behind it
+    // for as long as its producer takes between the two steps
+    std::atomic<Node*> head;
+    Node* tail;
+    Node stub;
+    std::atomic<std::size_t> queued;
+    // the dispatcher sleeps until queued reaches wanted; producers that see it
+    // reached take lock and notify
+    std::atomic<std::size_t> wanted;
+    std::mutex lock;
+    std::condition_variable arrived;
+    bool stopping;
+
+    double rate;        // requests per microsecond, a moving average
+    std::chrono::steady_clock::time_point last_take;
+
+    std::array<std::atomic<uint64_t>, 16> batch_sizes;
+    std::array<std::atomic<uint64_t>, 24> latencies;
+    std::atomic<uint64_t> requests, batches, full_batches, failed_batches;
+
+    std::thread dispatcher;
+
+    void submit(std::unique_ptr<Request> request);
+    void push(Node* node);
+    Request* pop();
+    // moves queued requests to batch up to max_batch
+    void drain(std::vector<std::unique_ptr<Request>>& batch);
+    // sleeps until want requests are queued or stopping, or until deadline if
+    // given; whether stopping
+    bool await(std::size_t want, const std::chrono::steady_clock::time_point* deadline);
+    std::chrono::microseconds wait_for(std::size_t have) const;
+    void dispatch();
+    void process(std::vector<std::unique_ptr<Request>>& batch);
+};
+
+// AsyncSchnorr::shared().verify and .sign
+std::future<Status> schnorr_verify_async(const uint8_t* signature, const uint8_t* message, std::size_t len,
+                                         const uint8_t* public_key);
+std::future<Result<AsyncSchnorr::Signature>> schnorr_sign_async(const uint8_t* message, std::size_t len,
+                                                                const uint8_t* secret, const uint8_t* aux_rand);
+
+#endif //ECC_SCHNORR_ASYNC_H
@@ -0,0 +1,151 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <stdexcept>
+
+#include "Curve.h"
+#include "decompress.h"
+#include "msm.h"
+#include "Scalar.h"
+#include "schnorr_halfagg.h"
+#include "tagged_hash.h"
+#include "trace.h"
+
+namespace {
+
+const PrimeField& order() {
+    return Curve::secp256k1().scalar_field();
+}
+
+// z_i for the (R.x, key, message) of each signature in turn: 1 for the first,
+// then hash_HalfAgg/randomizer of all of them so far
+class Randomizers {
+public:
+    Randomizers() : running(Sha256Tag::named("HalfAgg/randomizer")) {}
+
+    void skip(const uint8_t* rx, const uint8_t* key, const uint8_t* message) {
+        this->running.update(rx, 32).update(key, 32).update(message, 32);
+        this->count++;
+    }
+
+    Scalar next(const uint8_t* rx, const uint8_t* key, const uint8_t* message) {
+        skip(rx, key, message);
+        if (this->count == 1) {
+            return Scalar(1, order());
+        }
+        TaggedHash prefix = this->running;
+        uint8_t digest[32];
+        prefix.finish(digest);
+        return Scalar::from_bytes(digest, 32, order());
+    }
+
+private:
+    TaggedHash running;
+    std::size_t count = 0;
+};
+
+}
+
+Status schnorr_half_aggregate(std::vector<uint8_t>& out, const std::vector<SchnorrSigned>& items) {
+    std::vector<uint8_t> aggregate(32, 0);
+    const Status status = schnorr_half_aggregate_append(aggregate, {}, items);
+    if (status == Status::ok) {
+        out.swap(aggregate);
+    }
+    return status;
+}
+
+Status schnorr_half_aggregate_append(std::vector<uint8_t>& aggregate, const std::vector<SchnorrAggregated>& aggregated,
+                                     const std::vector<SchnorrSigned>& items) {
+    const std::size_t v = aggregated.size();
+    if (aggregate.size() != 32 * (v + 1)) {
+        return Status::bad_encoding;
+    }
+    const uint256 s_value = uint256::load_be(aggregate.data() + 32 * v, 32);
+    if (!(s_value < order().fixed_prime())) {
+        return Status::bad_encoding;
+    }
+    Scalar s(s_value.to_integer(), order());
+    Randomizers z;
+    for (std::size_t j = 0; j < v; j++) {
+        z.skip(aggregate.data() + 32 * j, aggregated[j].public_key, aggregated[j].message);
+    }
+
+    std::vector<uint8_t> out(aggregate.begin(), aggregate.begin() + 32 * v);
+    out.reserve(32 * (v + items.size() + 1));
+    for (const SchnorrSigned& item : items) {
+        if (item.length != 32) {
+            throw std::invalid_argument("Half-aggregated messages must be 32 bytes");
+        }
+        const uint256 si = uint256::load_be(item.signature + 32, 32);
+        if (!(si < order().fixed_prime())) {
+            return Status::bad_encoding;
+        }
+        s += z.next(item.signature, item.public_key, item.message) * Scalar(si.to_integer(), order());
+        out.insert(out.end(), item.signature, item.signature + 32);
+    }
+    out.resize(out.size() + 32);
+    s.to_bytes(out.data() + out.size() - 32);
+    aggregate.swap(out);
+    return Status::ok;
+}
+
+Status schnorr_half_verify(const uint8_t* aggregate, std::size_t len, const std::vector<SchnorrAggregated>& items,
+                           unsigned threads) {
+    ThreadExecutor executor(threads);
+    return schnorr_half_verify(aggregate, len, items, executor);
+}
+
+Status schnorr_half_verify(const uint8_t* aggregate, std::size_t len, const std::vector<SchnorrAggregated>& items,
+                           Executor& executor) {
+    ECC_TRACE_SPAN("schnorr.half_verify");
+    const Curve& curve = Curve::secp256k1();
+    const std::size_t count = items.size();
+    if (len != 32 * (count + 1)) {
+        return Status::bad_encoding;
+    }
+    const uint256 s = uint256::load_be(aggregate + 32 * count, 32);
+    if (!(s < order().fixed_prime())) {
+        return Status::bad_encoding;
+    }
+    // every public key, then every R.x, as compressed keys with even y
+    std::vector<uint8_t> keys(2 * count * 33, 0x02);
+    for (std::size_t i = 0; i < count; i++) {
+        if (!(uint256::load_be(items[i].public_key, 32) < curve.field().fixed_prime())
+            || !(uint256::load_be(aggregate + 32 * i, 32) < curve.field().fixed_prime())) {
+            return Status::bad_encoding;
+        }
+        std::copy(items[i].public_key, items[i].public_key + 32, keys.begin() + i * 33 + 1);
+        std::copy(aggregate + 32 * i, aggregate + 32 * (i + 1), keys.begin() + (count + i) * 33 + 1);
+    }
+    const DecompressedKeys lifted = decompress_keys(keys.data(), 2 * count, curve, executor);
+    for (std::size_t i = 0; i < count; i++) {
+        if (!lifted.valid(i)) {
+            return Status::not_on_curve;
+        }
+    }
+    if (lifted.invalid_count()) {
+        return Status::bad_signature;
+    }
+
+    // s G - sum z_i R_i - sum z_i e_i P_i
+    std::vector<integer> scalars(1, s.to_integer());
+    std::vector<Point> points(1, curve.generator());
+    scalars.reserve(2 * count + 1);
+    points.reserve(2 * count + 1);
+    Randomizers z;
+    for (std::size_t i = 0; i < count; i++) {
+        const uint8_t* rx = aggregate + 32 * i;
+        uint8_t digest[32];
+        TaggedHash(BIP340_CHALLENGE_TAG).update(rx, 32).update(items[i].public_key, 32)
+                .update(items[i].message, 32).finish(digest);
+        const Scalar e = Scalar::from_bytes(digest, 32, order());
+        const Scalar zi = z.next(rx, items[i].public_key, items[i].message);
+        scalars.push_back((-zi).value());
+        points.push_back(lifted.points[count + i]);
+        scalars.push_back((-(zi * e)).value());
+        points.push_back(lifted.points[i]);
+    }
+    return multi_scalar_mul(scalars, points, executor).is_infinity() ? Status::ok : Status::bad_signature;
+}
@@ -0,0 +1,55 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_SCHNORR_HALFAGG_H
+#define ECC_SCHNORR_HALFAGG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Executor.h"
+#include "Status.h"
+#include "schnorr.h"
+
+// Non-interactive half-aggregation of BIP340 signatures, as the
+// half-aggregation draft of the cross-input aggregation work has it: u
+// signatures (R_i.x, s_i) on 32-byte messages become R_1.x || .. || R_u.x || s
+// with s = sum z_i s_i, 32 (u + 1) bytes against 64 u. z_1 = 1 and z_i is
+// hash_HalfAgg/randomizer of every (R_j.x, key, message) up to i, so no
+// signature can be moved between aggregates. Anyone can aggregate; no secret
+// is involved. The hashes run from one running state, not one per prefix.
+
+// one signed message as the aggregate lists it
+struct SchnorrAggregated {
+    const uint8_t* public_key;      // 32 bytes
+    const uint8_t* message;         // 32 bytes
+};
+
+// the aggregate of items into out; their messages must be 32 bytes, or
+// std::invalid_argument. The signatures are not verified: an aggregate with a
+// bad one fails verification. Status::bad_encoding for an s not below n
+Status schnorr_half_aggregate(std::vector<uint8_t>& out, const std::vector<SchnorrSigned>& items);
+
+// IncAggregate: items added behind the signatures of aggregated already in
+// aggregate, so a block can take transactions as they come; aggregate is left
+// as it was on a failure. Status::bad_encoding for an aggregate of the wrong
+// length or an s not below n
+Status schnorr_half_aggregate_append(std::vector<uint8_t>& aggregate, const std::vector<SchnorrAggregated>& aggregated,
+                                     const std::vector<SchnorrSigned>& items);
+
+// Whether aggregate[0, len) holds a signature by every one of items on its
+// message: s G = sum z_i (R_i + e_i P_i), one multi_scalar_mul of 2u + 1
+// points (Pippenger, with threads as there, from 32 points up) after every key
+// and every R are lifted together by decompress_keys. Status::bad_encoding for
+// a length other than 32 (u + 1), a key or R.x not below p or s not below n,
+// Status::not_on_curve for a key with no point, Status::bad_signature for an
+// R.x with no point or when the equation fails, without saying which
+// signature is bad
+Status schnorr_half_verify(const uint8_t* aggregate, std::size_t len, const std::vector<SchnorrAggregated>& items,
+                           unsigned threads = 1);
+Status schnorr_half_verify(const uint8_t* aggregate, std::size_t len, const std::vector<SchnorrAggregated>& items,
+                           Executor& executor);
+
+#endif //ECC_SCHNORR_HALFAGG_H
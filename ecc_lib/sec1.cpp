@@ -0,0 +1,107 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <algorithm>
+
+#include "sec1.h"
+
+namespace {
+
+// the encoding of a normalized, finite p into exactly sec1_size bytes
+void write_affine(const Point& p, bool compressed, uint8_t* out) {
+    const std::pair<FieldElement, FieldElement> xy = p.affine();
+    const std::size_t l = (xy.first.prime_field().bits() + 7) / 8;
+    xy.first.to_bytes(out + 1, l);
+    if (compressed) {
+        // the parity of y is the low bit of its last byte
+        uint8_t y[2 * 32];
+        if (l <= sizeof(y)) {
+            xy.second.to_bytes(y, l);
+            out[0] = 2 | (y[l - 1] & 1);
+        } else {
+            out[0] = xy.second.value()[0] ? 3 : 2;
+        }
+    } else {
+        out[0] = 4;
+        xy.second.to_bytes(out + 1 + l, l);
+    }
+}
+
+}
+
+Result<std::size_t> sec1_encode(const Point& p, bool compressed, uint8_t* out, std::size_t capacity) noexcept {
+    if (p.is_infinity()) {
+        if (capacity < 1) {
+            return Status::buffer_too_small;
+        }
+        out[0] = 0;
+        return std::size_t(1);
+    }
+    const std::size_t size = sec1_size(p.curve_a().prime_field(), compressed);
+    if (capacity < size) {
+        return Status::buffer_too_small;
+    }
+    write_affine(p.is_normalized() ? p : p.normalized(), compressed, out);
+    return size;
+}
+
+Status sec1_encode_batch(const std::vector<Point>& points, bool compressed, uint8_t* out, std::size_t capacity) {
+    if (points.empty()) {
+        return Status::ok;
+    }
+    const std::size_t size = sec1_size(points[0].curve_a().prime_field(), compressed);
+    if (capacity / size < points.size()) {
+        return Status::buffer_too_small;
+    }
+    std::vector<Point> affine = points;
+    Point::batch_normalize(affine);
+    for (std::size_t i = 0; i < affine.size(); i++) {
+        uint8_t* slot = out + i * size;
+        if (affine[i].is_infinity()) {
+            std::fill(slot, slot + size, 0);
+        } else {
+            write_affine(affine[i], compressed, slot);
+        }
+    }
+    return Status::ok;
+}
+
+Result<Point> sec1_decode(const uint8_t* in, std::size_t len, const FieldElement& a, const FieldElement& b) noexcept {
+    const PrimeField& field = a.prime_field();
+    if (&b.prime_field() != &field) {
+        return Status::field_mismatch;
+    }
+    if (len == 1 && in[0] == 0) {
+        return Point(a, b);
+    }
+    const std::size_t l = (field.bits() + 7) / 8;
+    const bool compressed = len == 1 + l && (in[0] == 2 || in[0] == 3);
+    if (!compressed && !(len == 1 + 2 * l && in[0] == 4)) {
+        return Status::bad_encoding;
+    }
+
+    Result<FieldElement> x = FieldElement::from_bytes(in + 1, l, field);
+    if (!x) {
+        return x.status();
+    }
+    if (!compressed) {
+        Result<FieldElement> y = FieldElement::from_bytes(in + 1 + l, l, field);
+        if (!y) {
+            return y.status();
+        }
+        return Point::make(*x, *y, a, b);
+    }
+
+    Result<FieldElement> y = (x->square() * *x + a * *x + b).try_sqrt();
+    if (!y) {
+        return y.status();
+    }
+    if (y->value()[0] != (in[0] == 3)) {
+        // y = 0 has no odd form
+        if (y->is_zero()) {
+            return Status::bad_encoding;
+        }
+        *y = FieldElement(0, field) - *y;
+    }
+    return Point::make(*x, *y, a, b);
+}
@@ -0,0 +1,52 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_SEC1_H
+#define ECC_SEC1_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Curve.h"
+#include "FieldElement.h"
+#include "Point.h"
+#include "PrimeField.h"
+#include "Status.h"
+
+// SEC 1 (version 2, section 2.3.3) point encodings in caller-owned buffers:
+// 0x00 for the point at infinity, 0x02 / 0x03 (even / odd y) then x when
+// compressed, 0x04 then x and y when not, each coordinate in exactly
+// ceil(bits of p / 8) big-endian bytes. Coordinates are written straight from
+// the field limbs: no string, no integer and no allocation per point.
+
+// bytes of the encoding of a finite point over field
+inline std::size_t sec1_size(const PrimeField& field, bool compressed) {
+    const std::size_t l = (field.bits() + 7) / 8;
+    return compressed ? 1 + l : 1 + 2 * l;
+}
+
+// writes p to out and returns the number of bytes, 1 at infinity and
+// sec1_size otherwise; Status::buffer_too_small if capacity is less. A point
+// that is not normalized costs one inversion
+Result<std::size_t> sec1_encode(const Point& p, bool compressed, uint8_t* out, std::size_t capacity) noexcept;
+
+// every point into its own slot of sec1_size bytes, slot i at out + i * size,
+// after normalizing all of them with one shared inversion. A point at
+// infinity fills its slot with zeros, which starts with its one-byte
+// encoding. Status::buffer_too_small, with nothing written, if capacity is
+// less than points.size() slots
+Status sec1_encode_batch(const std::vector<Point>& points, bool compressed, uint8_t* out, std::size_t capacity);
+
+// the point encoded in in[0, len) on y^2 = x^3 + ax + b: Status::bad_encoding
+// for a length or prefix that is not one of the three above (or 0x03 for
+// y = 0), Status::out_of_range
+// for a coordinate not below p, Status::not_on_curve for an uncompressed point
+// off the curve and Status::not_a_square for an x with no y
+Result<Point> sec1_decode(const uint8_t* in, std::size_t len, const FieldElement& a, const FieldElement& b) noexcept;
+inline Result<Point> sec1_decode(const uint8_t* in, std::size_t len, const Curve& curve) noexcept {
+    return sec1_decode(in, len, curve.a(), curve.b());
+}
+
+#endif //ECC_SEC1_H
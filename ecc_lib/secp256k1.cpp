@@ -0,0 +1,50 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include "FieldKernels.h"
+#include "secp256k1.h"
+
+const uint256 SECP256K1_FIELD_P = 0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F_u256;
+const uint256 SECP256K1_ORDER_N = 0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141_u256;
+
+// Reduction modulo m = 2^256 - c: write x = hi * 2^256 + lo and replace it by
+// hi * c + lo until it fits in 256 bits. Each fold shrinks x by 256 - bits(c)
+// bits, so this takes two folds for p and three for n, then at most two
+// subtractions of m.
+template <std::size_t CL>
+static uint256 reduce_pseudo_mersenne(uint512 x, const fixed_uint<CL>& c, const uint256& m) {
+    for (;;) {
+        uint256 lo, hi;
+        for (std::size_t i = 0; i < 4; i++) {
+            lo.limb[i] = x.limb[i];
+            hi.limb[i] = x.limb[i + 4];
+        }
+        if (hi.is_zero()) {
+            while (lo >= m) {
+                lo -= m;
+            }
+            return lo;
+        }
+        x = uint256::mul_wide(hi, c).template resize<8>();
+        uint512::add(x, x, lo.resize<8>());
+    }
+}
+
+uint256 secp256k1_reduce_p(const uint512& x) {
+    return field_kernels().secp256k1_reduce_p(x);
+}
+
+// c is only 33 bits, so the general loop above unrolls to two folds
+uint256 secp256k1_reduce_p_portable(const uint512& x) {
+    uint256 lo;
+    limb_t carry = 0;
+    for (std::size_t i = 0; i < 4; i++) {
+        lo.limb[i] = limb_mac(x.limb[i + 4], SECP256K1_FIELD_C, x.limb[i], carry);
+    }
+    return secp256k1_fold_top_p(lo, carry);
+}
+
+uint256 secp256k1_reduce_n(const uint512& x) {
+    static const fixed_uint<3> c = (uint256::zero() - SECP256K1_ORDER_N).resize<3>();
+    return reduce_pseudo_mersenne(x, c, SECP256K1_ORDER_N);
+}
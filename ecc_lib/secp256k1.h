@@ -0,0 +1,108 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_SECP256K1_H
+#define ECC_SECP256K1_H
+
+#include "limb.h"
+#include "modexp.h"
+#include "uint256.h"
+
+// Field prime p = 2^256 - 2^32 - 977 and group order n of secp256k1
+extern const uint256 SECP256K1_FIELD_P;
+extern const uint256 SECP256K1_ORDER_N;
+
+// the same two primes as compile-time constants, limbs least significant
+// first, for StaticFieldElement
+struct Secp256k1FieldPrime {
+    static constexpr limb_t P[4] = {0xFFFFFFFEFFFFFC2F, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFFFFFFFFFF};
+};
+
+struct Secp256k1OrderPrime {
+    static constexpr limb_t P[4] = {0xBFD25E8CD0364141, 0xBAAEDCE6AF48A03B, 0xFFFFFFFFFFFFFFFE, 0xFFFFFFFFFFFFFFFF};
+};
+
+// 2^256 mod p
+constexpr limb_t SECP256K1_FIELD_C = 0x1000003D1;
+
+// x mod p for any 512-bit x, using 2^256 = 2^32 + 977 (mod p); no division.
+// Runs on the field_kernels() backend; secp256k1_reduce_p_portable is the
+// plain C++ version behind it.
+uint256 secp256k1_reduce_p(const uint512& x);
+uint256 secp256k1_reduce_p_portable(const uint512& x);
+
+// the end of every reduction mod p: lo + top * 2^256 after the first fold
+// of the high half, where top < 2^35. A second fold leaves at most one carry
+// out, and after that one subtraction of p.
+inline uint256 secp256k1_fold_top_p(const uint256& lo, limb_t top) {
+    uint256 out;
+    limb_t hi;
+    const limb_t l = limb_mul(top, SECP256K1_FIELD_C, hi);
+    limb_t carry = 0;
+    out.limb[0] = limb_addc(lo.limb[0], l, carry);
+    out.limb[1] = limb_addc(lo.limb[1], hi, carry);
+    out.limb[2] = limb_addc(lo.limb[2], 0, carry);
+    out.limb[3] = limb_addc(lo.limb[3], 0, carry);
+    // a carry out is another 2^256 = c, and what is left is too small to carry again
+    limb_t k = 0;
+    out.limb[0] = limb_addc(out.limb[0], SECP256K1_FIELD_C & (0 - carry), k);
+    out.limb[1] = limb_addc(out.limb[1], 0, k);
+    out.limb[2] = limb_addc(out.limb[2], 0, k);
+    out.limb[3] = limb_addc(out.limb[3], 0, k);
+
+    uint256 reduced;
+    const limb_t borrow = uint256::sub(reduced, out, SECP256K1_FIELD_P);
+    return uint256::select(0 - (borrow ^ 1), reduced, out);
+}
+
+// Addition chains of libsecp256k1 for the two fixed exponents of the field
+// prime, against about 40 multiplications for a windowed power. mul and sqr
+// are the field operations on T. Both start from xk = a^(2^k - 1) for
+// k = 2, 3, 22 and 223: 222 squarings and 11 multiplications.
+template <typename T>
+struct Secp256k1ChainStart {
+    T x2, x3, x22, x223;
+};
+
+template <typename T, typename Mul, typename Sqr>
+Secp256k1ChainStart<T> secp256k1_chain_start(const T& a, Mul mul, Sqr sqr) {
+    const T x2 = mul(sqr(a), a);
+    const T x3 = mul(sqr(x2), a);
+    const T x6 = mul(repeated_square(x3, 3, sqr), x3);
+    const T x9 = mul(repeated_square(x6, 3, sqr), x3);
+    const T x11 = mul(repeated_square(x9, 2, sqr), x2);
+    const T x22 = mul(repeated_square(x11, 11, sqr), x11);
+    const T x44 = mul(repeated_square(x22, 22, sqr), x22);
+    const T x88 = mul(repeated_square(x44, 44, sqr), x44);
+    const T x176 = mul(repeated_square(x88, 88, sqr), x88);
+    const T x220 = mul(repeated_square(x176, 44, sqr), x44);
+    const T x223 = mul(repeated_square(x220, 3, sqr), x3);
+    return {x2, x3, x22, x223};
+}
+
+// a^((p + 1) / 4), the square root of a when it has one: 253 squarings, 13 multiplications
+template <typename T, typename Mul, typename Sqr>
+T secp256k1_sqrt_candidate(const T& a, Mul mul, Sqr sqr) {
+    const Secp256k1ChainStart<T> x = secp256k1_chain_start(a, mul, sqr);
+    // (p + 1) / 4 = (2^223 - 1) * 2^33 + (2^22 - 1) * 2^8 + (2^2 - 1) * 2^2
+    T t = mul(repeated_square(x.x223, 23, sqr), x.x22);
+    t = mul(repeated_square(t, 6, sqr), x.x2);
+    return repeated_square(t, 2, sqr);
+}
+
+// a^(p - 2), the inverse of a non-zero a: 255 squarings, 15 multiplications
+template <typename T, typename Mul, typename Sqr>
+T secp256k1_fermat_inverse(const T& a, Mul mul, Sqr sqr) {
+    const Secp256k1ChainStart<T> x = secp256k1_chain_start(a, mul, sqr);
+    // p - 2 = (2^223 - 1) * 2^33 + (2^22 - 1) * 2^10 + 2^5 + (2^2 - 1) * 2^2 + 1
+    T t = mul(repeated_square(x.x223, 23, sqr), x.x22);
+    t = mul(repeated_square(t, 5, sqr), a);
+    t = mul(repeated_square(t, 3, sqr), x.x2);
+    return mul(repeated_square(t, 2, sqr), a);
+}
+
+// x mod n for any 512-bit x, using 2^256 = 2^256 - n (mod n), a 129-bit constant
+uint256 secp256k1_reduce_n(const uint512& x);
+
+#endif //ECC_SECP256K1_H
@@ -0,0 +1,21 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_SECURE_ZERO_H
+#define ECC_SECURE_ZERO_H
+
+#include <cstddef>
+#include <cstdint>
+
+// zeros data[0, len) through a volatile pointer, so the stores stay even when
+// the buffer is not read again: for secrets about to go out of scope, where a
+// memset may be dropped as dead
+inline void secure_zero(void* data, std::size_t len) noexcept {
+    volatile uint8_t* p = static_cast<uint8_t*>(data);
+    for (std::size_t i = 0; i < len; i++) {
+        p[i] = 0;
+    }
+}
+
+#endif //ECC_SECURE_ZERO_H
@@ -0,0 +1,470 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "sha256.h"
+
+// the first 32 bits of the fractional parts of the cube roots of the first 64 primes
+const uint32_t SHA256_K[64] = {
+        0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+        0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+        0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+        0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+        0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+        0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+        0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+        0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+};
+
+namespace {
+
+// the first 32 bits of the fractional parts of the square roots of the first 8 primes
+const uint32_t INITIAL[8] = {
+        0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+};
+
+uint32_t rotr(uint32_t x, unsigned n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+uint32_t load_be32(const uint8_t* in) {
+    return (static_cast<uint32_t>(in[0]) << 24) | (static_cast<uint32_t>(in[1]) << 16)
+           | (static_cast<uint32_t>(in[2]) << 8) | in[3];
+}
+
+void store_be32(uint8_t* out, uint32_t x) {
+    for (std::size_t i = 4; i-- > 0;) {
+        out[i] = static_cast<uint8_t>(x);
+        x >>= 8;
+    }
+}
+
+void portable_blocks(uint32_t* h, const uint8_t* in, std::size_t blocks) {
+    for (; blocks; blocks--, in += 64) {
+        uint32_t w[64];
+        for (std::size_t i = 0; i < 16; i++) {
+            w[i] = load_be32(in + 4 * i);
+        }
+        for (std::size_t i = 16; i < 64; i++) {
+            const uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            const uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3];
+        uint32_t e = h[4], f = h[5], g = h[6], hh = h[7];
+        for (std::size_t i = 0; i < 64; i++) {
+            const uint32_t t1 = hh + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + SHA256_K[i] + w[i];
+            const uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            hh = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+        h[5] += f;
+        h[6] += g;
+        h[7] += hh;
+    }
+}
+
+const Sha256Backend BACKENDS[] = {Sha256Backend::sha_ni, Sha256Backend::armv8, Sha256Backend::portable};
+
+// the startup choice: ECC_SHA256_BACKEND when it names a supported backend,
+// else the first supported of BACKENDS
+Sha256Backend initial_backend() {
+    if (const char* name = std::getenv("ECC_SHA256_BACKEND")) {
+        for (Sha256Backend backend : BACKENDS) {
+            if (std::strcmp(name, sha256_backend_name(backend)) == 0 && sha256_backend_supported(backend)) {
+                return backend;
+            }
+        }
+    }
+    for (Sha256Backend backend : BACKENDS) {
+        if (sha256_backend_supported(backend)) {
+            return backend;
+        }
+    }
+    return Sha256Backend::portable;
+}
+
+// the backend and its compression, published together
+struct ActiveBackend {
+    Sha256Backend backend;
+    Sha256Blocks blocks;
+};
+
+std::atomic<const ActiveBackend*>& active_backend() {
+    static const ActiveBackend initial = []() {
+        const Sha256Backend backend = initial_backend();
+        return ActiveBackend{backend, sha256_blocks(backend)};
+    }();
+    static std::atomic<const ActiveBackend*> active(&initial);
+    return active;
+}
+
+}
+
+const char* sha256_backend_name(Sha256Backend backend) {
+    switch (backend) {
+        case Sha256Backend::portable:
+            return "portable";
+        case Sha256Backend::sha_ni:
+            return "sha_ni";
+        case Sha256Backend::armv8:
+            return "armv8";
+    }
+    throw std::invalid_argument("Unknown SHA-256 backend");
+}
+
+Sha256Blocks sha256_blocks(Sha256Backend backend) {
+    switch (backend) {
+        case Sha256Backend::portable:
+            return portable_blocks;
+        case Sha256Backend::sha_ni:
+            return sha_ni_sha256_blocks();
+        case Sha256Backend::armv8:
+            return armv8_sha256_blocks();
+    }
+    return nullptr;
+}
+
+bool sha256_backend_supported(Sha256Backend backend) {
+    return sha256_blocks(backend) != nullptr;
+}
+
+Sha256Backend sha256_backend() {
+    return active_backend().load(std::memory_order_acquire)->backend;
+}
+
+void force_sha256_backend(Sha256Backend backend) {
+    // one descriptor per backend, built once, so switching never frees one a reader may hold
+    static const ActiveBackend choices[] = {
+        {Sha256Backend::portable, sha256_blocks(Sha256Backend::portable)},
+        {Sha256Backend::sha_ni, sha256_blocks(Sha256Backend::sha_ni)},
+        {Sha256Backend::armv8, sha256_blocks(Sha256Backend::armv8)},
+    };
+    for (const ActiveBackend& choice : choices) {
+        if (choice.backend == backend) {
+            if (!choice.blocks) {
+                throw std::invalid_argument(std::string("SHA-256 backend ") + sha256_backend_name(backend)
+                        + " is not supported on this CPU");
+            }
+            active_backend().store(&choice, std::memory_order_release);
+            return;
+        }
+    }
+    throw std::invalid_argument("Unknown SHA-256 backend");
+}
+
+Sha256::Sha256() {
+    reset();
+}
+
+Sha256::Sha256(const uint32_t* midstate, uint64_t bytes) {
+    for (std::size_t i = 0; i < 8; i++) {
+        this->h[i] = midstate[i];
+    }
+    this->used = 0;
+    this->total = bytes;
+}
+
+void Sha256::reset() {
+    for (std::size_t i = 0; i < 8; i++) {
+        this->h[i] = INITIAL[i];
+    }
+    this->used = 0;
+    this->total = 0;
+}
+
+void Sha256::update(const uint8_t* data, std::size_t len) {
+    const Sha256Blocks blocks = active_backend().load(std::memory_order_acquire)->blocks;
+    this->total += len;
+    if (this->used) {
+        while (len && this->used < sizeof(this->block)) {
+            this->block[this->used++] = *data++;
+            len--;
+        }
+        if (this->used < sizeof(this->block)) {
+            return;
+        }
+        blocks(this->h, this->block, 1);
+        this->used = 0;
+    }
+    const std::size_t whole = len / sizeof(this->block);
+    if (whole) {
+        blocks(this->h, data, whole);
+        data += whole * sizeof(this->block);
+        len -= whole * sizeof(this->block);
+    }
+    for (std::size_t i = 0; i < len; i++) {
+        this->block[i] = data[i];
+    }
+    this->used = len;
+}
+
+// a one bit, zeros, then the length in bits as 64 bits
+void Sha256::finish(uint8_t* out) {
+    const Sha256Blocks blocks = active_backend().load(std::memory_order_acquire)->blocks;
+    const uint64_t bits = this->total << 3;
+    this->block[this->used++] = 0x80;
+    if (this->used > 56) {
+        while (this->used < sizeof(this->block)) {
+            this->block[this->used++] = 0;
+        }
+        blocks(this->h, this->block, 1);
+        this->used = 0;
+    }
+    while (this->used < 56) {
+        this->block[this->used++] = 0;
+    }
+    store_be32(this->block + 56, static_cast<uint32_t>(bits >> 32));
+    store_be32(this->block + 60, static_cast<uint32_t>(bits));
+    blocks(this->h, this->block, 1);
+
+    for (std::size_t i = 0; i < 8; i++) {
+        store_be32(out + 4 * i, this->h[i]);
+    }
+    reset();
+}
+
+void Sha256::midstate(uint32_t* out) const {
+    for (std::size_t i = 0; i < 8; i++) {
+        out[i] = this->h[i];
+    }
+}
+
+void Sha256::hash(const uint8_t* data, std::size_t len, uint8_t* out) {
+    Sha256 sha;
+    sha.update(data, len);
+    sha.finish(out);
+}
+
+const Sha256MultiBuffer* sha256_multi_buffer() {
+    static const Sha256MultiBuffer* const widest =
+            avx512_sha256_multi_buffer() ? avx512_sha256_multi_buffer() : avx2_sha256_multi_buffer();
+    return widest;
+}
+
+namespace {
+
+// the initial state in every one of lanes lanes
+void initial_lanes(uint32_t* h, std::size_t lanes) {
+    for (std::size_t w = 0; w < 8; w++) {
+        for (std::size_t l = 0; l < lanes; l++) {
+            h[w * lanes + l] = INITIAL[w];
+        }
+    }
+}
+
+void store_lane(uint8_t* out, const uint32_t* h, std::size_t lanes, std::size_t l) {
+    for (std::size_t w = 0; w < 8; w++) {
+        store_be32(out + 4 * w, h[w * lanes + l]);
+    }
+}
+
+// the widest kernel has 16 lanes
+const std::size_t MAX_LANES = 16;
+
+}
+
+void sha256_many(uint8_t* out, const uint8_t* in, std::size_t len, std::size_t count,
+                 const Sha256MultiBuffer* kernel) {
+    if (!kernel) {
+        for (std::size_t i = 0; i < count; i++) {
+            Sha256::hash(in + i * len, len, out + 32 * i);
+        }
+        return;
+    }
+    // the final blocks of every message: the bytes after the last whole block,
+    // 0x80, zeros, and the length in bits, one block or two
+    const std::size_t whole = len / 64, rest = len % 64;
+    const std::size_t tail_blocks = rest < 56 ? 1 : 2;
+    const uint64_t bits = static_cast<uint64_t>(len) << 3;
+    const std::size_t lanes = kernel->lanes;
+    uint32_t h[8 * MAX_LANES];
+    uint8_t tails[MAX_LANES][128];
+    const uint8_t* blocks[MAX_LANES];
+    for (std::size_t first = 0; first < count; first += lanes) {
+        // a short last group repeats its final message in the lanes left over
+        const std::size_t used = count - first < lanes ? count - first : lanes;
+        initial_lanes(h, lanes);
+        for (std::size_t l = 0; l < lanes; l++) {
+            blocks[l] = in + (first + (l < used ? l : used - 1)) * len;
+        }
+        if (whole) {
+            kernel->blocks(h, blocks, whole);
+        }
+        for (std::size_t l = 0; l < lanes; l++) {
+            uint8_t* tail = tails[l];
+            std::memcpy(tail, blocks[l] + 64 * whole, rest);
+            tail[rest] = 0x80;
+            std::memset(tail + rest + 1, 0, 64 * tail_blocks - rest - 9);
+            store_be32(tail + 64 * tail_blocks - 8, static_cast<uint32_t>(bits >> 32));
+            store_be32(tail + 64 * tail_blocks - 4, static_cast<uint32_t>(bits));
+            blocks[l] = tail;
+        }
+        kernel->blocks(h, blocks, tail_blocks);
+        for (std::size_t l = 0; l < used; l++) {
+            store_lane(out + 32 * (first + l), h, lanes, l);
+        }
+    }
+}
+
+void sha256d_64(uint8_t* out, const uint8_t* in, std::size_t count, const Sha256MultiBuffer* kernel) {
+    if (!kernel) {
+        for (std::size_t i = 0; i < count; i++) {
+            uint8_t inner[Sha256::DIGEST_SIZE];
+            Sha256::hash(in + 64 * i, 64, inner);
+            Sha256::hash(inner, sizeof(inner), out + 32 * i);
+        }
+        return;
+    }
+    // the padding block of a 64-byte message: 0x80, zeros, and 512 in bits
+    uint8_t padding[64] = {0x80};
+    padding[62] = 0x02;
+    const std::size_t lanes = kernel->lanes;
+    uint32_t h[8 * MAX_LANES];
+    uint8_t second[MAX_LANES][64];
+    const uint8_t* blocks[MAX_LANES];
+    for (std::size_t first = 0; first < count; first += lanes) {
+        const std::size_t used = count - first < lanes ? count - first : lanes;
+        initial_lanes(h, lanes);
+        for (std::size_t l = 0; l < lanes; l++) {
+            blocks[l] = in + 64 * (first + (l < used ? l : used - 1));
+        }
+        kernel->blocks(h, blocks, 1);
+        for (std::size_t l = 0; l < lanes; l++) {
+            blocks[l] = padding;
+        }
+        kernel->blocks(h, blocks, 1);
+        // the digests, padded as 256 bits
+        for (std::size_t l = 0; l < lanes; l++) {
+            store_lane(second[l], h, lanes, l);
+            second[l][32] = 0x80;
+            std::memset(second[l] + 33, 0, 29);
+            second[l][62] = 0x01;
+            second[l][63] = 0;
+            blocks[l] = second[l];
+        }
+        initial_lanes(h, lanes);
+        kernel->blocks(h, blocks, 1);
+        for (std::size_t l = 0; l < used; l++) {
+            store_lane(out + 32 * (first + l), h, lanes, l);
+        }
+    }
+}
+
+void hmac_sha256_many(uint8_t* out, const uint8_t* keys, const uint8_t* in, std::size_t len, std::size_t count,
+                      const Sha256MultiBuffer* kernel) {
+    if (!kernel) {
+        for (std::size_t i = 0; i < count; i++) {
+            HmacSha256 mac(keys + 32 * i, 32);
+            mac.update(in + i * len, len);
+            mac.finish(out + 32 * i);
+        }
+        return;
+    }
+    // the inner hash covers the key block and the message, the outer one the
+    // key block and the 32-byte inner digest
+    const std::size_t whole = len / 64, rest = len % 64;
+    const std::size_t tail_blocks = rest < 56 ? 1 : 2;
+    const uint64_t bits = static_cast<uint64_t>(64 + len) << 3;
+    const std::size_t lanes = kernel->lanes;
+    uint32_t h[8 * MAX_LANES];
+    uint8_t pads[MAX_LANES][64], tails[MAX_LANES][128];
+    const uint8_t* blocks[MAX_LANES];
+    for (std::size_t first = 0; first < count; first += lanes) {
+        const std::size_t used = count - first < lanes ? count - first : lanes;
+        for (std::size_t l = 0; l < lanes; l++) {
+            const uint8_t* key = keys + 32 * (first + (l < used ? l : used - 1));
+            for (std::size_t i = 0; i < 64; i++) {
+                pads[l][i] = static_cast<uint8_t>((i < 32 ? key[i] : 0) ^ 0x36);
+            }
+            blocks[l] = pads[l];
+        }
+        initial_lanes(h, lanes);
+        kernel->blocks(h, blocks, 1);
+        for (std::size_t l = 0; l < lanes; l++) {
+            blocks[l] = in + (first + (l < used ? l : used - 1)) * len;
+        }
+        if (whole) {
+            kernel->blocks(h, blocks, whole);
+        }
+        for (std::size_t l = 0; l < lanes; l++) {
+            uint8_t* tail = tails[l];
+            std::memcpy(tail, blocks[l] + 64 * whole, rest);
+            tail[rest] = 0x80;
+            std::memset(tail + rest + 1, 0, 64 * tail_blocks - rest - 9);
+            store_be32(tail + 64 * tail_blocks - 8, static_cast<uint32_t>(bits >> 32));
+            store_be32(tail + 64 * tail_blocks - 4, static_cast<uint32_t>(bits));
+            blocks[l] = tail;
+        }
+        kernel->blocks(h, blocks, tail_blocks);
+
+        // the inner digests, padded as 96 bytes (768 bits), after the outer key blocks
+        for (std::size_t l = 0; l < lanes; l++) {
+            uint8_t* tail = tails[l];
+            store_lane(tail, h, lanes, l);
+            tail[32] = 0x80;
+            std::memset(tail + 33, 0, 29);
+            tail[62] = 0x03;
+            tail[63] = 0;
+            for (uint8_t& byte : pads[l]) {
+                byte ^= 0x36 ^ 0x5C;
+            }
+            blocks[l] = pads[l];
+        }
+        initial_lanes(h, lanes);
+        kernel->blocks(h, blocks, 1);
+        for (std::size_t l = 0; l < lanes; l++) {
+            blocks[l] = tails[l];
+        }
+        kernel->blocks(h, blocks, 1);
+        for (std::size_t l = 0; l < used; l++) {
+            store_lane(out + 32 * (first + l), h, lanes, l);
+        }
+    }
+}
+
+HmacSha256::HmacSha256(const uint8_t* key, std::size_t len) {
+    uint8_t pad[64] = {0};
+    if (len > sizeof(pad)) {
+        Sha256::hash(key, len, pad);
+    } else {
+        for (std::size_t i = 0; i < len; i++) {
+            pad[i] = key[i];
+        }
+    }
+    for (uint8_t& byte : pad) {
+        byte ^= 0x36;
+    }
+    this->inner_start.update(pad, sizeof(pad));
+    for (uint8_t& byte : pad) {
+        byte ^= 0x36 ^ 0x5C;
+    }
+    this->outer_start.update(pad, sizeof(pad));
+    this->inner = this->inner_start;
+}
+
+void HmacSha256::finish(uint8_t* out) {
+    uint8_t digest[Sha256::DIGEST_SIZE];
+    this->inner.finish(digest);
+    Sha256 outer = this->outer_start;
+    outer.update(digest, sizeof(digest));
+    outer.finish(out);
+    this->inner = this->inner_start;
+}
@@ -0,0 +1,128 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_SHA256_H
+#define ECC_SHA256_H
+
+#include <cstddef>
+#include <cstdint>
+
+// SHA-256 of FIPS 180-4, the hash of BIP340, in the shape of Sha512
+class Sha256 {
+public:
+    static constexpr std::size_t DIGEST_SIZE = 32;
+
+    Sha256();
+    // the state left after bytes of input, a multiple of 64, have been
+    // compressed into midstate[0, 8); finish() starts over from the initial state
+    Sha256(const uint32_t* midstate, uint64_t bytes);
+    void update(const uint8_t* data, std::size_t len);
+    // the digest of everything given to update(), in out[0, 32); starts over after
+    void finish(uint8_t* out);
+    // the state in out[0, 8), for the other constructor; meaningful when the
+    // bytes taken in so far are a multiple of 64
+    void midstate(uint32_t* out) const;
+
+    static void hash(const uint8_t* data, std::size_t len, uint8_t* out);
+
+private:
+    uint32_t h[8];
+    uint8_t block[64];
+    std::size_t used;           // bytes waiting in block
+    uint64_t total;             // bytes so far; messages stay below 2^61 bytes
+
+    void reset();
+};
+
+// The compression function underneath Sha256, which takes any number of
+// consecutive 64-byte blocks into the state h[0, 8), one per instruction set:
+// the portable C++, the SHA extensions of x86 (SHA-NI, compiled with target
+// attributes so the library still runs on any x86-64) and the SHA2
+// instructions of ARMv8 (built only on AArch64). As with the field kernels,
+// Sha256 starts out on the fastest backend the CPU supports, or on the one
+// named by the ECC_SHA256_BACKEND environment variable ("portable", "sha_ni",
+// "armv8") if that is set and supported, and changes only through
+// force_sha256_backend().
+typedef void (*Sha256Blocks)(uint32_t* h, const uint8_t* in, std::size_t blocks);
+
+enum class Sha256Backend {
+    portable,
+    sha_ni,
+    armv8,
+};
+
+const char* sha256_backend_name(Sha256Backend backend);
+// the compression of backend, or null where this CPU cannot run it
+Sha256Blocks sha256_blocks(Sha256Backend backend);
+bool sha256_backend_supported(Sha256Backend backend);
+Sha256Backend sha256_backend();
+// switches every later hash, in all threads, to backend; throws
+// std::invalid_argument if this CPU cannot run it. Digests are the same in
+// every backend
+void force_sha256_backend(Sha256Backend backend);
+
+// for the instruction-set files: the round constants, and their compressions
+// (null where the CPU lacks the instructions)
+extern const uint32_t SHA256_K[64];
+Sha256Blocks sha_ni_sha256_blocks();
+Sha256Blocks armv8_sha256_blocks();
+
+// Multi-buffer SHA-256: independent messages hashed side by side, one per
+// SIMD lane, with the state of word w of lane l at h[w * lanes + l] and
+// lane l's next blocks at in[l]. AVX2 runs 8 lanes and AVX-512 16.
+struct Sha256MultiBuffer {
+    const char* name;
+    std::size_t lanes;
+    void (*blocks)(uint32_t* h, const uint8_t* const* in, std::size_t blocks);
+};
+
+// null without AVX2, or without AVX-512 F and VL
+const Sha256MultiBuffer* avx2_sha256_multi_buffer();
+const Sha256MultiBuffer* avx512_sha256_multi_buffer();
+// the widest of those the CPU runs, or null for none
+const Sha256MultiBuffer* sha256_multi_buffer();
+
+// the digests of count messages of len bytes each, message i at in + i * len
+// and its digest at out + 32 i, through kernel (null for one Sha256 at a time)
+void sha256_many(uint8_t* out, const uint8_t* in, std::size_t len, std::size_t count,
+                 const Sha256MultiBuffer* kernel);
+inline void sha256_many(uint8_t* out, const uint8_t* in, std::size_t len, std::size_t count) {
+    sha256_many(out, in, len, count, sha256_multi_buffer());
+}
+// SHA-256(SHA-256(m)) of count 64-byte m, the parent of two 32-byte children
+// in a Merkle tree: the padding block of m is the same for every message and
+// the second hash is a single block, so a digest is three compressions
+void sha256d_64(uint8_t* out, const uint8_t* in, std::size_t count, const Sha256MultiBuffer* kernel);
+inline void sha256d_64(uint8_t* out, const uint8_t* in, std::size_t count) {
+    sha256d_64(out, in, count, sha256_multi_buffer());
+}
+
+// HMAC-SHA-256 of count messages of len bytes each, message i at in + i * len
+// under the 32-byte key at keys + 32 i and its MAC at out + 32 i, through
+// kernel (null for one HmacSha256 at a time): the padded key blocks, the
+// messages and the outer hashes of a group of lanes are compressed side by
+// side. out may be keys, or in when len is 32
+void hmac_sha256_many(uint8_t* out, const uint8_t* keys, const uint8_t* in, std::size_t len, std::size_t count,
+                      const Sha256MultiBuffer* kernel);
+inline void hmac_sha256_many(uint8_t* out, const uint8_t* keys, const uint8_t* in, std::size_t len,
+                             std::size_t count) {
+    hmac_sha256_many(out, keys, in, len, count, sha256_multi_buffer());
+}
+
+// HMAC-SHA-256 of RFC 2104 under one key. The key's two padded blocks are
+// compressed once, when the object is made, and kept as midstates, so each MAC
+// after that costs the compressions of its message and one more; copies share
+// the work. Keys longer than a block are hashed first, as the RFC says.
+class HmacSha256 {
+public:
+    HmacSha256(const uint8_t* key, std::size_t len);
+    void update(const uint8_t* data, std::size_t len) { this->inner.update(data, len); }
+    // the MAC of everything given to update() in out[0, 32); starts over after
+    void finish(uint8_t* out);
+
+private:
+    Sha256 inner_start, outer_start, inner;
+};
+
+#endif //ECC_SHA256_H
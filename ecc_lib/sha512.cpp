@@ -0,0 +1,185 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include "sha512.h"
+
+namespace {
+
+// the first 64 bits of the fractional parts of the cube roots of the first 80 primes
+const uint64_t K[80] = {
+        0x428A2F98D728AE22, 0x7137449123EF65CD, 0xB5C0FBCFEC4D3B2F, 0xE9B5DBA58189DBBC,
+        0x3956C25BF348B538, 0x59F111F1B605D019, 0x923F82A4AF194F9B, 0xAB1C5ED5DA6D8118,
+        0xD807AA98A3030242, 0x12835B0145706FBE, 0x243185BE4EE4B28C, 0x550C7DC3D5FFB4E2,
+        0x72BE5D74F27B896F, 0x80DEB1FE3B1696B1, 0x9BDC06A725C71235, 0xC19BF174CF692694,
+        0xE49B69C19EF14AD2, 0xEFBE4786384F25E3, 0x0FC19DC68B8CD5B5, 0x240CA1CC77AC9C65,
+        0x2DE92C6F592B0275, 0x4A7484AA6EA6E483, 0x5CB0A9DCBD41FBD4, 0x76F988DA831153B5,
+        0x983E5152EE66DFAB, 0xA831C66D2DB43210, 0xB00327C898FB213F, 0xBF597FC7BEEF0EE4,
+        0xC6E00BF33DA88FC2, 0xD5A79147930AA725, 0x06CA6351E003826F, 0x142929670A0E6E70,
+        0x27B70A8546D22FFC, 0x2E1B21385C26C926, 0x4D2C6DFC5AC42AED, 0x53380D139D95B3DF,
+        0x650A73548BAF63DE, 0x766A0ABB3C77B2A8, 0x81C2C92E47EDAEE6, 0x92722C851482353B,
+        0xA2BFE8A14CF10364, 0xA81A664BBC423001, 0xC24B8B70D0F89791, 0xC76C51A30654BE30,
+        0xD192E819D6EF5218, 0xD69906245565A910, 0xF40E35855771202A, 0x106AA07032BBD1B8,
+        0x19A4C116B8D2D0C8, 0x1E376C085141AB53, 0x2748774CDF8EEB99, 0x34B0BCB5E19B48A8,
+        0x391C0CB3C5C95A63, 0x4ED8AA4AE3418ACB, 0x5B9CCA4F7763E373, 0x682E6FF3D6B2B8A3,
+        0x748F82EE5DEFB2FC, 0x78A5636F43172F60, 0x84C87814A1F0AB72, 0x8CC702081A6439EC,
+        0x90BEFFFA23631E28, 0xA4506CEBDE82BDE9, 0xBEF9A3F7B2C67915, 0xC67178F2E372532B,
+        0xCA273ECEEA26619C, 0xD186B8C721C0C207, 0xEADA7DD6CDE0EB1E, 0xF57D4F7FEE6ED178,
+        0x06F067AA72176FBA, 0x0A637DC5A2C898A6, 0x113F9804BEF90DAE, 0x1B710B35131C471B,
+        0x28DB77F523047D84, 0x32CAAB7B40C72493, 0x3C9EBE0A15C9BEBC, 0x431D67C49C100D4C,
+        0x4CC5D4BECB3E42B6, 0x597F299CFC657E2A, 0x5FCB6FAB3AD6FAEC, 0x6C44198C4A475817
+};
+
+uint64_t rotr(uint64_t x, unsigned n) {
+    return (x >> n) | (x << (64 - n));
+}
+
+uint64_t load_be64(const uint8_t* in) {
+    uint64_t out = 0;
+    for (std::size_t i = 0; i < 8; i++) {
+        out = (out << 8) | in[i];
+    }
+    return out;
+}
+
+void store_be64(uint8_t* out, uint64_t x) {
+    for (std::size_t i = 8; i-- > 0;) {
+        out[i] = static_cast<uint8_t>(x);
+        x >>= 8;
+    }
+}
+
+}
+
+Sha512::Sha512() {
+    reset();
+}
+
+// the square roots of the first 8 primes, likewise
+void Sha512::reset() {
+    static const uint64_t initial[8] = {
+            0x6A09E667F3BCC908, 0xBB67AE8584CAA73B, 0x3C6EF372FE94F82B, 0xA54FF53A5F1D36F1,
+            0x510E527FADE682D1, 0x9B05688C2B3E6C1F, 0x1F83D9ABFB41BD6B, 0x5BE0CD19137E2179
+    };
+    for (std::size_t i = 0; i < 8; i++) {
+        this->h[i] = initial[i];
+    }
+    this->used = 0;
+    this->total = 0;
+}
+
+void Sha512::compress(const uint8_t* in) {
+    uint64_t w[80];
+    for (std::size_t i = 0; i < 16; i++) {
+        w[i] = load_be64(in + 8 * i);
+    }
+    for (std::size_t i = 16; i < 80; i++) {
+        const uint64_t s0 = rotr(w[i - 15], 1) ^ rotr(w[i - 15], 8) ^ (w[i - 15] >> 7);
+        const uint64_t s1 = rotr(w[i - 2], 19) ^ rotr(w[i - 2], 61) ^ (w[i - 2] >> 6);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint64_t a = this->h[0], b = this->h[1], c = this->h[2], d = this->h[3];
+    uint64_t e = this->h[4], f = this->h[5], g = this->h[6], hh = this->h[7];
+    for (std::size_t i = 0; i < 80; i++) {
+        const uint64_t t1 = hh + (rotr(e, 14) ^ rotr(e, 18) ^ rotr(e, 41)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+        const uint64_t t2 = (rotr(a, 28) ^ rotr(a, 34) ^ rotr(a, 39)) + ((a & b) ^ (a & c) ^ (b & c));
+        hh = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    this->h[0] += a;
+    this->h[1] += b;
+    this->h[2] += c;
+    this->h[3] += d;
+    this->h[4] += e;
+    this->h[5] += f;
+    this->h[6] += g;
+    this->h[7] += hh;
+}
+
+void Sha512::update(const uint8_t* data, std::size_t len) {
+    this->total += len;
+    if (this->used) {
+        while (len && this->used < sizeof(this->block)) {
+            this->block[this->used++] = *data++;
+            len--;
+        }
+        if (this->used < sizeof(this->block)) {
+            return;
+        }
+        compress(this->block);
+        this->used = 0;
+    }
+    for (; len >= sizeof(this->block); data += sizeof(this->block), len -= sizeof(this->block)) {
+        compress(data);
+    }
+    for (std::size_t i = 0; i < len; i++) {
+        this->block[i] = data[i];
+    }
+    this->used = len;
+}
+
+// a one bit, zeros, then the length in bits as 128 bits, of which the top 61 are zero
+void Sha512::finish(uint8_t* out) {
+    const uint64_t bits = this->total << 3;
+    const uint64_t bits_high = this->total >> 61;
+    this->block[this->used++] = 0x80;
+    if (this->used > 112) {
+        while (this->used < sizeof(this->block)) {
+            this->block[this->used++] = 0;
+        }
+        compress(this->block);
+        this->used = 0;
+    }
+    while (this->used < 112) {
+        this->block[this->used++] = 0;
+    }
+    store_be64(this->block + 112, bits_high);
+    store_be64(this->block + 120, bits);
+    compress(this->block);
+
+    for (std::size_t i = 0; i < 8; i++) {
+        store_be64(out + 8 * i, this->h[i]);
+    }
+    reset();
+}
+
+void Sha512::hash(const uint8_t* data, std::size_t len, uint8_t* out) {
+    Sha512 sha;
+    sha.update(data, len);
+    sha.finish(out);
+}
+
+HmacSha512::HmacSha512(const uint8_t* key, std::size_t len) {
+    uint8_t pad[128] = {0};
+    if (len > sizeof(pad)) {
+        Sha512::hash(key, len, pad);
+    } else {
+        for (std::size_t i = 0; i < len; i++) {
+            pad[i] = key[i];
+        }
+    }
+    for (uint8_t& byte : pad) {
+        byte ^= 0x36;
+    }
+    this->inner_start.update(pad, sizeof(pad));
+    for (uint8_t& byte : pad) {
+        byte ^= 0x36 ^ 0x5C;
+    }
+    this->outer_start.update(pad, sizeof(pad));
+    this->inner = this->inner_start;
+}
+
+void HmacSha512::finish(uint8_t* out) {
+    uint8_t digest[Sha512::DIGEST_SIZE];
+    this->inner.finish(digest);
+    Sha512 outer = this->outer_start;
+    outer.update(digest, sizeof(digest));
+    outer.finish(out);
+    this->inner = this->inner_start;
+}
@@ -0,0 +1,47 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_SHA512_H
+#define ECC_SHA512_H
+
+#include <cstddef>
+#include <cstdint>
+
+// SHA-512 of FIPS 180-4, the hash of Ed25519: fed in pieces with update() or
+// in one call with hash(). Not for secrets that must not stay in memory; the
+// state is not wiped.
+class Sha512 {
+public:
+    static constexpr std::size_t DIGEST_SIZE = 64;
+
+    Sha512();
+    void update(const uint8_t* data, std::size_t len);
+    // the digest of everything given to update(), in out[0, 64); starts over after
+    void finish(uint8_t* out);
+
+    static void hash(const uint8_t* data, std::size_t len, uint8_t* out);
+
+private:
+    uint64_t h[8];
+    uint8_t block[128];
+    std::size_t used;           // bytes waiting in block
+    uint64_t total;             // bytes so far; messages stay below 2^64 bytes
+
+    void reset();
+    void compress(const uint8_t* in);
+};
+
+// HMAC-SHA-512 of RFC 2104 under one key, kept as midstates as HmacSha256 is
+class HmacSha512 {
+public:
+    HmacSha512(const uint8_t* key, std::size_t len);
+    void update(const uint8_t* data, std::size_t len) { this->inner.update(data, len); }
+    // the MAC of everything given to update() in out[0, 64); starts over after
+    void finish(uint8_t* out);
+
+private:
+    Sha512 inner_start, outer_start, inner;
+};
+
+#endif //ECC_SHA512_H
@@ -0,0 +1,243 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <atomic>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "shm_ring.h"
+
+struct ShmRing::Control {
+    alignas(64) std::atomic<uint64_t> head;         // next slot the producer writes
+    alignas(64) std::atomic<uint64_t> tail;         // next slot the consumer reads
+    alignas(64) std::atomic<uint32_t> bell;         // bumped by every push, the futex word
+    std::atomic<uint32_t> sleepers;
+};
+
+static_assert(sizeof(std::atomic<uint64_t>) == 8 && std::atomic<uint64_t>::is_always_lock_free,
+              "the ring's positions are shared between processes");
+
+// the control block's three cache lines
+static constexpr std::size_t CONTROL_BYTES = 192;
+
+std::size_t ShmRing::bytes(std::size_t slots) {
+    return CONTROL_BYTES + slots * sizeof(ShmMessage);
+}
+
+ShmRing::ShmRing(void* memory, std::size_t slots, bool init)
+        : control(static_cast<Control*>(memory)),
+          slots(reinterpret_cast<ShmMessage*>(static_cast<char*>(memory) + CONTROL_BYTES)),
+          mask(slots - 1), head_seen(0), tail_seen(0) {
+    static_assert(sizeof(Control) == CONTROL_BYTES, "the control block is three cache lines");
+    if (slots == 0 || (slots & (slots - 1)) != 0) {
+        throw std::invalid_argument("Ring size must be a power of two");
+    }
+    if (init) {
+        new (memory) Control();
+        this->control->head.store(0);
+        this->control->tail.store(0);
+        this->control->bell.store(0);
+        this->control->sleepers.store(0);
+    }
+    this->head_seen = this->control->head.load(std::memory_order_acquire);
+    this->tail_seen = this->control->tail.load(std::memory_order_acquire);
+}
+
+#if defined(__linux__)
+// not FUTEX_PRIVATE_FLAG: the word is shared between processes
+static void futex_wait(std::atomic<uint32_t>* word, uint32_t expected, std::chrono::microseconds timeout) {
+    struct timespec ts;
+    ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000);
+    ts.tv_nsec = static_cast<long>(timeout.count() % 1000000 * 1000);
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, &ts, nullptr, 0);
+}
+
+static void futex_wake(std::atomic<uint32_t>* word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+}
+#endif
+
+bool ShmRing::try_push(const ShmMessage& message) {
+    const uint64_t head = this->control->head.load(std::memory_order_relaxed);
+    if (head - this->tail_seen > this->mask) {
+        this->tail_seen = this->control->tail.load(std::memory_order_acquire);
+        if (head - this->tail_seen > this->mask) {
+            return false;
+        }
+    }
+    this->slots[head & this->mask] = message;
+    this->control->head.store(head + 1, std::memory_order_release);
+    // a consumer about to sleep either sees the new head or the new bell
+    this->control->bell.fetch_add(1, std::memory_order_seq_cst);
+    if (this->control->sleepers.load(std::memory_order_seq_cst) != 0) {
+#if defined(__linux__)
+        futex_wake(&this->control->bell);
+#endif
+    }
+    return true;
+}
+
+bool ShmRing::try_pop(ShmMessage& message) {
+    const uint64_t tail = this->control->tail.load(std::memory_order_relaxed);
+    if (tail == this->head_seen) {
+        this->head_seen = this->control->head.load(std::memory_order_acquire);
+        if (tail == this->head_seen) {
+            return false;
+        }
+    }
+    message = this->slots[tail & this->mask];
+    this->control->tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool ShmRing::empty() const {
+    return this->control->tail.load(std::memory_order_relaxed) == this->control->head.load(std::memory_order_acquire);
+}
+
+bool ShmRing::wait(std::chrono::microseconds timeout) {
+    // a short spin first: a busy peer answers sooner than a futex round trip
+    for (int i = 0; i < 256; i++) {
+        if (!empty()) {
+            return true;
+        }
+    }
+#if defined(__linux__)
+    const uint32_t bell = this->control->bell.load(std::memory_order_acquire);
+    this->control->sleepers.fetch_add(1, std::memory_order_seq_cst);
+    if (empty()) {
+        futex_wait(&this->control->bell, bell, timeout);
+    }
+    this->control->sleepers.fetch_sub(1, std::memory_order_seq_cst);
+#else
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (empty() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+#endif
+    return !empty();
+}
+
+struct ShmChannel::Header {
+    std::atomic<uint64_t> magic;
+    uint64_t slots;
+    std::atomic<uint32_t> claimed;
+};
+
+static constexpr uint64_t CHANNEL_MAGIC = 0x314e4843434345ULL;     // "ECCCHN1"
+
+// the header's cache line, before the rings
+static constexpr std::size_t HEADER_BYTES = 64;
+
+static std::string shm_name(const std::string& name) {
+    return name.empty() || name[0] != '/' ? "/" + name : name;
+}
+
+ShmChannel::ShmChannel(const std::string& name, std::size_t slots)
+        : name(shm_name(name)), owner(true), memory(nullptr), length(0), header(nullptr) {
+    if (slots == 0 || (slots & (slots - 1)) != 0) {
+        throw std::invalid_argument("Ring size must be a power of two");
+    }
+#if defined(__linux__)
+    this->length = HEADER_BYTES + 2 * ShmRing::bytes(slots);
+    shm_unlink(this->name.c_str());
+    const int fd = shm_open(this->name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0 || ftruncate(fd, static_cast<off_t>(this->length)) != 0) {
+        if (fd >= 0) {
+            close(fd);
+            shm_unlink(this->name.c_str());
+        }
+        throw std::runtime_error("Cannot create shared memory " + this->name);
+    }
+    this->memory = mmap(nullptr, this->length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (this->memory == MAP_FAILED) {
+        shm_unlink(this->name.c_str());
+        throw std::runtime_error("Cannot map shared memory " + this->name);
+    }
+    char* base = static_cast<char*>(this->memory);
+    try {
+        this->request_ring.reset(new ShmRing(base + HEADER_BYTES, slots, true));
+        this->response_ring.reset(new ShmRing(base + HEADER_BYTES + ShmRing::bytes(slots), slots, true));
+    } catch (...) {
+        // no destructor runs for a constructor that throws
+        munmap(this->memory, this->length);
+        shm_unlink(this->name.c_str());
+        throw;
+    }
+    this->header = new (base) Header();
+    this->header->slots = slots;
+    this->header->claimed.store(0);
+    // published last, so a client never opens a half-made channel
+    this->header->magic.store(CHANNEL_MAGIC, std::memory_order_release);
+#else
+    throw std::runtime_error("Shared memory channels need Linux");
+#endif
+}
+
+ShmChannel::ShmChannel(const std::string& name)
+        : name(shm_name(name)), owner(false), memory(nullptr), length(0), header(nullptr) {
+#if defined(__linux__)
+    const int fd = shm_open(this->name.c_str(), O_RDWR, 0);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < HEADER_BYTES) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        throw std::runtime_error("Cannot open shared memory " + this->name);
+    }
+    this->length = static_cast<std::size_t>(st.st_size);
+    this->memory = mmap(nullptr, this->length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (this->memory == MAP_FAILED) {
+        throw std::runtime_error("Cannot map shared memory " + this->name);
+    }
+    char* base = static_cast<char*>(this->memory);
+    this->header = reinterpret_cast<Header*>(base);
+    const bool made = this->header->magic.load(std::memory_order_acquire) == CHANNEL_MAGIC;
+    const uint64_t slots = this->header->slots;
+    if (!made || slots == 0 ||
+        this->length != HEADER_BYTES + 2 * ShmRing::bytes(static_cast<std::size_t>(slots))) {
+        munmap(this->memory, this->length);
+        throw std::runtime_error("Not an ecc channel: " + this->name);
+    }
+    // a slots that is not a power of two throws here
+    try {
+        this->request_ring.reset(new ShmRing(base + HEADER_BYTES, static_cast<std::size_t>(slots), false));
+        this->response_ring.reset(new ShmRing(base + HEADER_BYTES + ShmRing::bytes(static_cast<std::size_t>(slots)),
+                                              static_cast<std::size_t>(slots), false));
+    } catch (...) {
+        munmap(this->memory, this->length);
+        throw;
+    }
+#else
+    throw std::runtime_error("Shared memory channels need Linux");
+#endif
+}
+
+ShmChannel::~ShmChannel() {
+#if defined(__linux__)
+    munmap(this->memory, this->length);
+    if (this->owner) {
+        shm_unlink(this->name.c_str());
+    }
+#endif
+}
+
+bool ShmChannel::claim() {
+    uint32_t expected = 0;
+    return this->header->claimed.compare_exchange_strong(expected, 1);
+}
+
+void ShmChannel::release() {
+    this->header->claimed.store(0);
+}
@@ -0,0 +1,99 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_SHM_RING_H
+#define ECC_SHM_RING_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// One message of the daemon's protocol, the size of four cache lines. A
+// request carries op and scheme and its input in body[0, length); the answer
+// to it has the same id, status and any output in body
+struct ShmMessage {
+    static constexpr std::size_t capacity = 232;
+
+    uint64_t id;
+    uint32_t op;
+    uint32_t scheme;
+    uint32_t status;
+    uint32_t length;
+    uint8_t body[capacity];
+};
+static_assert(sizeof(ShmMessage) == 256, "ShmMessage is four cache lines");
+
+// A single-producer single-consumer ring of ShmMessages in memory that two
+// processes map. The positions written by each side sit on their own cache
+// lines, and each side keeps a copy of the other's position, rereading it only
+// when the ring looks full or empty, so a message costs one cache line
+// transfer each way. The consumer sleeps in wait() on a futex (a yield loop
+// where there is none) that push() rings only when someone is asleep
+class ShmRing {
+public:
+    // bytes of a ring of slots messages, slots a power of two
+    static std::size_t bytes(std::size_t slots);
+
+    // the ring in memory[0, bytes(slots)), set up empty when init; throws
+    // std::invalid_argument for slots not a power of two
+    ShmRing(void* memory, std::size_t slots, bool init);
+
+    // producer side: false when full
+    bool try_push(const ShmMessage& message);
+    // consumer side: false when empty
+    bool try_pop(ShmMessage& message);
+    bool empty() const;
+    // consumer side: until a message is there (true) or timeout has passed
+    bool wait(std::chrono::microseconds timeout);
+
+    std::size_t size() const { return static_cast<std::size_t>(this->mask + 1); }
+
+private:
+    struct Control;
+
+    Control* control;
+    ShmMessage* slots;
+    uint64_t mask;
+    uint64_t head_seen;     // the consumer's copy of the producer's position
+    uint64_t tail_seen;     // the producer's copy of the consumer's position
+};
+
+// A request ring and a response ring in one POSIX shared memory object. The
+// daemon creates it (and unlinks it when done); a client opens it and claims
+// it, so there is only ever one producer on each ring. Throws
+// std::runtime_error where shared memory cannot be had (or on other than
+// Linux)
+class ShmChannel {
+public:
+    // creates name, replacing any stale object of that name
+    ShmChannel(const std::string& name, std::size_t slots);
+    // opens name as made by the other constructor
+    explicit ShmChannel(const std::string& name);
+    ~ShmChannel();
+    ShmChannel(const ShmChannel&) = delete;
+    ShmChannel& operator=(const ShmChannel&) = delete;
+
+    ShmRing& requests() { return *this->request_ring; }
+    ShmRing& responses() { return *this->response_ring; }
+
+    // the client's claim on the channel: false if another holds it. A client
+    // that dies holding it leaves it claimed until the daemon restarts
+    bool claim();
+    void release();
+
+private:
+    struct Header;
+
+    std::string name;
+    bool owner;
+    void* memory;
+    std::size_t length;
+    Header* header;
+    std::unique_ptr<ShmRing> request_ring;
+    std::unique_ptr<ShmRing> response_ring;
+};
+
+#endif //ECC_SHM_RING_H
@@ -0,0 +1,141 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <cstring>
+#include <random>
+#include <stdexcept>
+
+#include "ecdsa.h"
+#include "schnorr.h"
+#include "sha256.h"
+#include "signature_cache.h"
+
+SignatureCache::SignatureCache(std::size_t capacity, std::size_t shards, Eviction eviction)
+        : shard_count(1), eviction(eviction) {
+    if (capacity == 0) {
+        throw std::invalid_argument("Signature cache capacity must be positive");
+    }
+    while (this->shard_count < shards && 2 * this->shard_count <= capacity) {
+        this->shard_count <<= 1;
+    }
+    this->shard_capacity = capacity / this->shard_count;
+    this->shards.reset(new Shard[this->shard_count]);
+    std::random_device device;
+    for (std::size_t i = 0; i < sizeof(this->salt); i += 4) {
+        const uint32_t word = device();
+        std::memcpy(this->salt + i, &word, 4);
+    }
+}
+
+std::size_t SignatureCache::DigestHash::operator()(const Digest& d) const {
+    // already uniform: the shard took byte 0, the map takes the next eight
+    std::size_t out = 0;
+    std::memcpy(&out, d.data() + 1, sizeof(out));
+    return out;
+}
+
+SignatureCache::Digest SignatureCache::digest(std::initializer_list<Piece> pieces) const {
+    Sha256 sha;
+    sha.update(this->salt, sizeof(this->salt));
+    for (const Piece& piece : pieces) {
+        uint8_t length[8];
+        for (std::size_t i = 0; i < 8; i++) {
+            length[i] = static_cast<uint8_t>(static_cast<uint64_t>(piece.second) >> (8 * i));
+        }
+        sha.update(length, sizeof(length));
+        sha.update(piece.first, piece.second);
+    }
+    Digest out;
+    sha.finish(out.data());
+    return out;
+}
+
+bool SignatureCache::contains(const Digest& digest) {
+    Shard& s = shard(digest);
+    std::lock_guard<std::mutex> guard(s.lock);
+    const auto it = s.entries.find(digest);
+    if (it == s.entries.end()) {
+        return false;
+    }
+    if (this->eviction == Eviction::least_recent) {
+        s.order.splice(s.order.begin(), s.order, it->second);
+    }
+    return true;
+}
+
+void SignatureCache::insert(const Digest& digest) {
+    Shard& s = shard(digest);
+    std::lock_guard<std::mutex> guard(s.lock);
+    if (s.entries.count(digest)) {
+        return;
+    }
+    if (s.entries.size() == this->shard_capacity) {
+        s.entries.erase(s.order.back());
+        s.order.pop_back();
+    }
+    s.order.push_front(digest);
+    s.entries.emplace(digest, s.order.begin());
+}
+
+void SignatureCache::clear() {
+    for (std::size_t i = 0; i < this->shard_count; i++) {
+        std::lock_guard<std::mutex> guard(this->shards[i].lock);
+        this->shards[i].entries.clear();
+        this->shards[i].order.clear();
+    }
+}
+
+std::size_t SignatureCache::size() const {
+    std::size_t out = 0;
+    for (std::size_t i = 0; i < this->shard_count; i++) {
+        std::lock_guard<std::mutex> guard(this->shards[i].lock);
+        out += this->shards[i].entries.size();
+    }
+    return out;
+}
+
+Status ecdsa_verify(const uint8_t* signature, const Curve& curve, const Point& public_key, const uint8_t* hash,
+                    std::size_t len, SignatureCache& cache) noexcept {
+    if (curve.field().bits() > 256 || public_key.is_infinity()
+        || public_key.curve_a() != curve.a() || public_key.curve_b() != curve.b()) {
+        return ecdsa_verify(signature, curve, public_key, hash, len);
+    }
+    // the curve by p, a and b, the key by its affine coordinates
+    uint8_t key[5][32];
+    const std::pair<FieldElement, FieldElement> xy = public_key.affine();
+    curve.p().to_bytes(key[0], 32);
+    curve.a().to_bytes(key[1], 32);
+    curve.b().to_bytes(key[2], 32);
+    xy.first.to_bytes(key[3], 32);
+    xy.second.to_bytes(key[4], 32);
+    static const uint8_t tag[] = "ecdsa";
+    const SignatureCache::Digest digest = cache.digest({SignatureCache::Piece(tag, sizeof(tag)),
+                                                        SignatureCache::Piece(key[0], sizeof(key)),
+                                                        SignatureCache::Piece(hash, len),
+                                                        SignatureCache::Piece(signature, 64)});
+    if (cache.contains(digest)) {
+        return Status::ok;
+    }
+    const Status status = ecdsa_verify(signature, curve, public_key, hash, len);
+    if (status == Status::ok) {
+        cache.insert(digest);
+    }
+    return status;
+}
+
+Status schnorr_verify(const uint8_t* signature, const uint8_t* message, std::size_t len,
+                      const uint8_t* public_key, SignatureCache& cache) noexcept {
+    static const uint8_t tag[] = "bip340";
+    const SignatureCache::Digest digest = cache.digest({SignatureCache::Piece(tag, sizeof(tag)),
+                                                        SignatureCache::Piece(public_key, 32),
+                                                        SignatureCache::Piece(message, len),
+                                                        SignatureCache::Piece(signature, 64)});
+    if (cache.contains(digest)) {
+        return Status::ok;
+    }
+    const Status status = schnorr_verify(signature, message, len, public_key);
+    if (status == Status::ok) {
+        cache.insert(digest);
+    }
+    return status;
+}
@@ -0,0 +1,83 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_SIGNATURE_CACHE_H
+#define ECC_SIGNATURE_CACHE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "Curve.h"
+#include "Point.h"
+#include "Status.h"
+
+// A bounded set of signatures known to be valid, so that one seen again (on
+// entry to a mempool and then in a block) is not verified twice. Entries are
+// SHA-256 of a salt drawn from std::random_device when the cache is made and
+// of the key, message and signature, so nobody outside can aim collisions at
+// it, and only successes are kept. The capacity is split over shards, each an
+// LRU list behind its own mutex, picked by the digest; threads meet only when
+// they land on the same shard, and each holds it for a hash map operation.
+class SignatureCache {
+public:
+    typedef std::array<uint8_t, 32> Digest;
+
+    enum class Eviction {
+        least_recent,       // a hit moves the entry to the front
+        oldest              // entries leave in the order they came
+    };
+
+    // at most capacity entries, in shards rounded up to a power of two and
+    // fewer where capacity is smaller; throws std::invalid_argument for zero
+    explicit SignatureCache(std::size_t capacity, std::size_t shards = 16,
+                            Eviction eviction = Eviction::least_recent);
+
+    typedef std::pair<const uint8_t*, std::size_t> Piece;
+    // the salted SHA-256 of the pieces, each after its length in 8 bytes
+    Digest digest(std::initializer_list<Piece> pieces) const;
+
+    bool contains(const Digest& digest);
+    // adds digest, evicting from its shard when that is full
+    void insert(const Digest& digest);
+    void clear();
+    std::size_t size() const;
+    std::size_t capacity() const { return this->shard_capacity * this->shard_count; }
+
+private:
+    struct DigestHash {
+        std::size_t operator()(const Digest& d) const;
+    };
+    struct Shard {
+        mutable std::mutex lock;
+        std::list<Digest> order;    // most recent first
+        std::unordered_map<Digest, std::list<Digest>::iterator, DigestHash> entries;
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    std::size_t shard_count;
+    std::size_t shard_capacity;
+    Eviction eviction;
+    uint8_t salt[32];
+
+    Shard& shard(const Digest& digest) const { return this->shards[digest[0] & (this->shard_count - 1)]; }
+};
+
+// ecdsa_verify, answering Status::ok without the arithmetic for a signature
+// that cache holds, and adding those that verify. A key on another curve, the
+// point at infinity and fields above 256 bits go to ecdsa_verify uncached
+Status ecdsa_verify(const uint8_t* signature, const Curve& curve, const Point& public_key, const uint8_t* hash,
+                    std::size_t len, SignatureCache& cache) noexcept;
+
+// schnorr_verify in the same way
+Status schnorr_verify(const uint8_t* signature, const uint8_t* message, std::size_t len,
+                      const uint8_t* public_key, SignatureCache& cache) noexcept;
+
+#endif //ECC_SIGNATURE_CACHE_H
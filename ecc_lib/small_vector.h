@@ -0,0 +1,189 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_SMALL_VECTOR_H
+#define ECC_SMALL_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+#include "OperationCounters.h"
+
+// The memory resource small_vector heap storage comes from on the calling
+// thread. Each thread starts with std::pmr::new_delete_resource(); swap another
+// in for a scope (see IntegerArena.h), not for good.
+inline std::pmr::memory_resource *& small_vector_resource() {
+    static thread_local std::pmr::memory_resource * current = std::pmr::new_delete_resource();
+    return current;
+}
+
+// Contiguous vector of trivially copyable values that keeps up to N of them
+// inline and only goes to the heap once it grows past that. Heap buffers are
+// taken from small_vector_resource() and remember which resource to return to.
+// Supports the subset of the std::vector interface that integer uses.
+template <typename T, std::size_t N>
+class small_vector {
+    static_assert(std::is_trivially_copyable <T>::value, "small_vector only holds trivially copyable values");
+    static_assert(N > 0, "small_vector needs at least one inline slot");
+
+public:
+    typedef T                                     value_type;
+    typedef std::size_t                           size_type;
+    typedef T *                                   iterator;
+    typedef const T *                             const_iterator;
+    typedef std::reverse_iterator <iterator>       reverse_iterator;
+    typedef std::reverse_iterator <const_iterator> const_reverse_iterator;
+
+    small_vector() : _data(_inline), _size(0), _capacity(N), _resource(nullptr) {}
+
+    explicit small_vector(size_type n, const T & v = T()) : small_vector() {
+        assign(n, v);
+    }
+
+    small_vector(const small_vector & rhs) : small_vector() {
+        *this = rhs;
+    }
+
+    small_vector(small_vector && rhs) noexcept : small_vector() {
+        *this = std::move(rhs);
+    }
+
+    ~small_vector() {
+        release();
+    }
+
+    small_vector & operator=(const small_vector & rhs) {
+        if (this != &rhs) {
+            _size = 0;
+            reserve(rhs._size);
+            std::memcpy(_data, rhs._data, rhs._size * sizeof(T));
+            _size = rhs._size;
+        }
+        return *this;
+    }
+
+    small_vector & operator=(small_vector && rhs) noexcept {
+        if (this != &rhs) {
+            if (rhs.is_inline()) {
+                // inline storage can't be stolen, but it is small enough to copy
+                _size = 0;
+                reserve(rhs._size);
+                std::memcpy(_data, rhs._data, rhs._size * sizeof(T));
+                _size = rhs._size;
+            }
+            else {
+                release();
+                _data = rhs._data;
+                _size = rhs._size;
+                _capacity = rhs._capacity;
+                _resource = rhs._resource;
+                rhs._data = rhs._inline;
+                rhs._capacity = N;
+            }
+            rhs._size = 0;
+        }
+        return *this;
+    }
+
+    // element access
+    T & operator[](size_type i)             { return _data[i]; }
+    const T & operator[](size_type i) const { return _data[i]; }
+    T & front()                             { return _data[0]; }
+    const T & front() const                 { return _data[0]; }
+    T & back()                              { return _data[_size - 1]; }
+    const T & back() const                  { return _data[_size - 1]; }
+    T * data()                              { return _data; }
+    const T * data() const                  { return _data; }
+
+    // iterators
+    iterator begin()                        { return _data; }
+    const_iterator begin() const            { return _data; }
+    iterator end()                          { return _data + _size; }
+    const_iterator end() const              { return _data + _size; }
+    reverse_iterator rbegin()               { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const   { return const_reverse_iterator(end()); }
+    reverse_iterator rend()                 { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const     { return const_reverse_iterator(begin()); }
+
+    // capacity
+    bool empty() const                      { return !_size; }
+    size_type size() const                  { return _size; }
+    size_type capacity() const              { return _capacity; }
+    bool is_inline() const                  { return _data == _inline; }
+
+    void reserve(size_type n) {
+        if (n <= _capacity) {
+            return;
+        }
+        const size_type cap = std::max(n, _capacity * 2);
+        std::pmr::memory_resource * resource = small_vector_resource();
+        T * grown = static_cast <T *> (resource->allocate(cap * sizeof(T), alignof(T)));
+        ECC_COUNT(allocations);
+        ECC_COUNT_ADD(allocated_bytes, cap * sizeof(T));
+        std::memcpy(grown, _data, _size * sizeof(T));
+        release();
+        _data = grown;
+        _capacity = cap;
+        _resource = resource;
+    }
+
+    // modifiers
+    void clear()                            { _size = 0; }
+
+    void assign(size_type n, const T & v) {
+        _size = 0;
+        resize(n, v);
+    }
+
+    void resize(size_type n, const T & v = T()) {
+        reserve(n);
+        for (size_type i = _size; i < n; i++) {
+            _data[i] = v;
+        }
+        _size = n;
+    }
+
+    void push_back(const T & v) {
+        if (_size == _capacity) {
+            const T copy = v;   // v may live in our own buffer
+            reserve(_size + 1);
+            _data[_size++] = copy;
+        }
+        else {
+            _data[_size++] = v;
+        }
+    }
+
+    void pop_back()                         { _size--; }
+
+    friend bool operator==(const small_vector & lhs, const small_vector & rhs) {
+        return (lhs._size == rhs._size) && !std::memcmp(lhs._data, rhs._data, lhs._size * sizeof(T));
+    }
+
+    friend bool operator!=(const small_vector & lhs, const small_vector & rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    void release() {
+        if (!is_inline()) {
+            _resource->deallocate(_data, _capacity * sizeof(T), alignof(T));
+            _data = _inline;
+            _capacity = N;
+        }
+    }
+
+    T *       _data;
+    size_type _size;
+    size_type _capacity;
+    std::pmr::memory_resource * _resource;     // owner of _data when it is not inline
+    T         _inline[N];
+};
+
+#endif //ECC_SMALL_VECTOR_H
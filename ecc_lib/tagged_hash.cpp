@@ -0,0 +1,51 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "tagged_hash.h"
+
+Sha256Tag::Sha256Tag(const uint8_t* tag, std::size_t len) : state{} {
+    uint8_t t[Sha256::DIGEST_SIZE];
+    Sha256::hash(tag, len, t);
+    Sha256 sha;
+    sha.update(t, sizeof(t));
+    sha.update(t, sizeof(t));
+    sha.midstate(this->state);
+}
+
+const Sha256Tag& Sha256Tag::named(const std::string& tag) {
+    static const std::map<std::string, const Sha256Tag*> standard = {
+            {"BIP0340/challenge", &BIP340_CHALLENGE_TAG},
+            {"BIP0340/aux", &BIP340_AUX_TAG},
+            {"BIP0340/nonce", &BIP340_NONCE_TAG},
+            {"TapLeaf", &TAP_LEAF_TAG},
+            {"TapBranch", &TAP_BRANCH_TAG},
+            {"TapTweak", &TAP_TWEAK_TAG},
+    };
+    const auto known = standard.find(tag);
+    if (known != standard.end()) {
+        return *known->second;
+    }
+    // never freed: callers keep references
+    static std::mutex lock;
+    static std::map<std::string, std::unique_ptr<const Sha256Tag>> custom;
+
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = custom.find(tag);
+    if (it == custom.end()) {
+        it = custom.emplace(tag, std::unique_ptr<const Sha256Tag>(new Sha256Tag(tag))).first;
+    }
+    return *it->second;
+}
+
+void TaggedHash::finish(uint8_t* out) {
+    this->sha.finish(out);
+    this->sha = this->tagged;
+}
+
+void TaggedHash::hash(const Sha256Tag& tag, const uint8_t* data, std::size_t len, uint8_t* out) {
+    TaggedHash(tag).update(data, len).finish(out);
+}
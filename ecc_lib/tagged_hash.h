@@ -0,0 +1,80 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_TAGGED_HASH_H
+#define ECC_TAGGED_HASH_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "sha256.h"
+
+// The tagged hashes of BIP340, SHA-256(SHA-256(tag) || SHA-256(tag) || data).
+// The 64 bytes in front of the data are one whole block that depends only on
+// the tag, so a Sha256Tag keeps the state after it (the midstate) and every
+// hash under the tag starts from there, one compression fewer.
+class Sha256Tag {
+public:
+    // the midstate of tag[0, len), one hash of the tag and one compression
+    Sha256Tag(const uint8_t* tag, std::size_t len);
+    explicit Sha256Tag(const std::string& tag)
+            : Sha256Tag(reinterpret_cast<const uint8_t*>(tag.data()), tag.size()) {}
+    // a midstate computed beforehand, as for the tags below
+    constexpr explicit Sha256Tag(const std::array<uint32_t, 8>& midstate)
+            : state{midstate[0], midstate[1], midstate[2], midstate[3],
+                    midstate[4], midstate[5], midstate[6], midstate[7]} {}
+
+    // the tag of that name: one of the constants below, or else the midstate
+    // computed the first time the name is asked for and kept, under a mutex, for
+    // as long as the program runs (a registry of custom tags, like PrimeField::get)
+    static const Sha256Tag& named(const std::string& tag);
+
+    const uint32_t* midstate() const { return this->state; }
+    // a Sha256 that has taken in the 64 bytes of the tag
+    Sha256 start() const { return Sha256(this->state, 64); }
+
+private:
+    uint32_t state[8];
+};
+
+// the tags of BIP340 and BIP341, their midstates worked out beforehand
+// "BIP0340/challenge"
+inline constexpr Sha256Tag BIP340_CHALLENGE_TAG(std::array<uint32_t, 8>{0x9CECBA11, 0x23925381, 0x11679112, 0xD1627E0F,
+                                                                     0x97C87550, 0x003CC765, 0x90F61164, 0x33E9B66A});
+// "BIP0340/aux"
+inline constexpr Sha256Tag BIP340_AUX_TAG(std::array<uint32_t, 8>{0x24DD3219, 0x4EBA7E70, 0xCA0FABB9, 0x0FA3166D,
+                                                               0x3AFBE4B1, 0x4C44DF97, 0x4AAC2739, 0x249E850A});
+// "BIP0340/nonce"
+inline constexpr Sha256Tag BIP340_NONCE_TAG(std::array<uint32_t, 8>{0x46615B35, 0xF4BFBFF7, 0x9F8DC671, 0x83627AB3,
+                                                                 0x60217180, 0x57358661, 0x21A29E54, 0x68B07B4C});
+// "TapLeaf"
+inline constexpr Sha256Tag TAP_LEAF_TAG(std::array<uint32_t, 8>{0x9CE0E4E6, 0x7C116C39, 0x38B3CAF2, 0xC30F5089,
+                                                             0xD3F3936C, 0x47636E60, 0x7DB33EEA, 0xDDC6F0C9});
+// "TapBranch"
+inline constexpr Sha256Tag TAP_BRANCH_TAG(std::array<uint32_t, 8>{0x23A865A9, 0xB8A40DA7, 0x977C1E04, 0xC49E246F,
+                                                               0xB5BE1376, 0x9D24C9B7, 0xB583B5D4, 0xA8D226D2});
+// "TapTweak"
+inline constexpr Sha256Tag TAP_TWEAK_TAG(std::array<uint32_t, 8>{0xD129A2F3, 0x701C655D, 0x6583B6C3, 0xB9419727,
+                                                              0x95F4E232, 0x94FD54F4, 0xA2AE8D85, 0x47CA590B});
+
+// one tagged hash, in the shape of Sha256
+class TaggedHash {
+public:
+    explicit TaggedHash(const Sha256Tag& tag) : tagged(tag.start()), sha(tagged) {}
+    TaggedHash& update(const uint8_t* data, std::size_t len) {
+        this->sha.update(data, len);
+        return *this;
+    }
+    // the digest in out[0, 32); starts over from the tag after
+    void finish(uint8_t* out);
+
+    static void hash(const Sha256Tag& tag, const uint8_t* data, std::size_t len, uint8_t* out);
+
+private:
+    Sha256 tagged, sha;
+};
+
+#endif //ECC_TAGGED_HASH_H
@@ -0,0 +1,58 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_TAPROOT_H
+#define ECC_TAPROOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Executor.h"
+#include "Status.h"
+
+// The output keys of BIP341 taproot: Q = lift_x(P) + t G for the 32-byte
+// x-only internal key P and t = hash_TapTweak(P.x || merkle root), the root
+// left out for a key with no script tree (BIP86). The output key is the x of
+// Q, and the parity of its y goes into the control blocks of script spends.
+
+// Q of one internal key, merkle_root null for none: its x in output_key[0, 32)
+// and whether its y is odd in *odd when odd is not null. Status::bad_encoding
+// for a key not below p, Status::not_on_curve for a key with no point,
+// Status::out_of_range for t not below n, Status::infinity for Q at infinity
+Status taproot_tweak(uint8_t* output_key, bool* odd, const uint8_t* internal_key,
+                     const uint8_t* merkle_root) noexcept;
+
+struct TweakedKeys {
+    // the output key of key i in [32 i, 32 (i + 1)), zero where it is invalid
+    std::vector<uint8_t> keys;
+    // 1 where the output key has odd y
+    std::vector<uint8_t> odd;
+    // bit i % 64 of word i / 64 is set where key i fails as taproot_tweak would
+    std::vector<uint64_t> invalid;
+
+    bool valid(std::size_t i) const { return !((this->invalid[i / 64] >> (i % 64)) & 1); }
+    std::size_t invalid_count() const;
+};
+
+// keys normalized together by taproot_tweak_batch, a multiple of 64
+constexpr std::size_t TAPROOT_TWEAK_CHUNK = 1024;
+// batches from this many keys take the wider comb
+constexpr std::size_t TAPROOT_WIDE_TABLE_MIN = 1024;
+
+// the output keys of count internal keys at internal_keys[32 i, 32 (i + 1)),
+// with the merkle roots at merkle_roots[32 i, 32 (i + 1)) or none for null.
+// In chunks of TAPROOT_TWEAK_CHUNK keys: lifted together (decompress_keys),
+// t G by a fixed-base comb in Jacobian coordinates plus the lifted key in a
+// mixed addition, and the sums normalized with one inversion, against a
+// square root and an inversion per key for taproot_tweak. From
+// TAPROOT_WIDE_TABLE_MIN keys the comb is a table of G in windows of 8 bits,
+// half the additions of Curve::generator_table's, built once for the process.
+// Bad keys are reported in the mask and do not stop the batch
+TweakedKeys taproot_tweak_batch(const uint8_t* internal_keys, const uint8_t* merkle_roots, std::size_t count);
+// the same with the chunks spread over executor's tasks
+TweakedKeys taproot_tweak_batch(const uint8_t* internal_keys, const uint8_t* merkle_roots, std::size_t count,
+                                Executor& executor);
+
+#endif //ECC_TAPROOT_H
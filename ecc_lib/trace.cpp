@@ -0,0 +1,136 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "trace.h"
+
+namespace {
+
+struct Event {
+    const char* name;
+    uint64_t start;
+    uint64_t end;
+};
+
+// one thread's events, written by that thread alone: the slot first, then
+// head with release, so a reader that acquires head sees the slots below it
+struct Ring {
+    explicit Ring(uint32_t tid) : tid(tid), head(0), events(Trace::CAPACITY) {}
+
+    const uint32_t tid;
+    std::atomic<uint64_t> head;
+    std::vector<Event> events;
+};
+
+std::atomic<bool> active(false);
+// the window start() and stop() set; spans outside it belong to another trace
+std::atomic<uint64_t> window_start(0), window_end(0);
+
+std::mutex rings_mutex;
+std::vector<std::shared_ptr<Ring>> rings;
+
+// the calling thread's ring, made and registered on its first span; the
+// registry keeps it after the thread exits so its spans can still be read
+Ring& local_ring() {
+    static thread_local std::shared_ptr<Ring> ring;
+    if (!ring) {
+        std::lock_guard<std::mutex> lock(rings_mutex);
+        ring = std::make_shared<Ring>(static_cast<uint32_t>(rings.size() + 1));
+        rings.push_back(ring);
+    }
+    return *ring;
+}
+
+void append_escaped(std::string& out, const char* s) {
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') {
+            out += '\\';
+        }
+        out += *s;
+    }
+}
+
+}
+
+void Trace::start() {
+    window_end.store(~uint64_t(0), std::memory_order_relaxed);
+    window_start.store(Trace::now(), std::memory_order_relaxed);
+    active.store(true, std::memory_order_release);
+}
+
+void Trace::stop() {
+    active.store(false, std::memory_order_release);
+    window_end.store(Trace::now(), std::memory_order_relaxed);
+}
+
+bool Trace::enabled() noexcept {
+    return active.load(std::memory_order_relaxed);
+}
+
+uint64_t Trace::now() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Trace::record(const char* name, uint64_t start, uint64_t end) noexcept {
+    try {
+        Ring& ring = local_ring();
+        const uint64_t head = ring.head.load(std::memory_order_relaxed);
+        ring.events[head % Trace::CAPACITY] = Event{name, start, end};
+        ring.head.store(head + 1, std::memory_order_release);
+    } catch (...) {
+        // out of memory for a new thread's ring: the span is dropped
+    }
+}
+
+std::string Trace::chrome_json() {
+    const uint64_t from = window_start.load(std::memory_order_relaxed);
+    const uint64_t to = window_end.load(std::memory_order_relaxed);
+    std::vector<std::shared_ptr<Ring>> all;
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex);
+        all = rings;
+    }
+    std::string out = "{\"traceEvents\":[\n";
+    bool first = true;
+    char number[96];
+    for (const std::shared_ptr<Ring>& ring : all) {
+        const uint64_t head = ring->head.load(std::memory_order_acquire);
+        for (uint64_t i = head - std::min<uint64_t>(head, Trace::CAPACITY); i < head; i++) {
+            const Event& e = ring->events[i % Trace::CAPACITY];
+            if (e.start < from || e.end > to) {
+                continue;
+            }
+            out += first ? "" : ",\n";
+            first = false;
+            out += "{\"name\":\"";
+            append_escaped(out, e.name);
+            // microseconds from start(), as the format has them
+            std::snprintf(number, sizeof(number), "\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                          (e.start - from) / 1e3, (e.end - e.start) / 1e3, ring->tid);
+            out += number;
+        }
+    }
+    out += "\n],\"displayTimeUnit\":\"ns\"}\n";
+    return out;
+}
+
+void Trace::write_chrome(const std::string& path) {
+    const std::string json = Trace::chrome_json();
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) {
+        throw std::runtime_error("Cannot write trace file " + path);
+    }
+    const bool written = std::fwrite(json.data(), 1, json.size(), f) == json.size();
+    if (std::fclose(f) != 0 || !written) {
+        throw std::runtime_error("Cannot write trace file " + path);
+    }
+}
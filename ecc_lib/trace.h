@@ -0,0 +1,73 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_TRACE_H
+#define ECC_TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Scoped spans around the stages of the batch pipelines (decoding, key
+// decompression, the MSM's digits, buckets and combination, the final check),
+// for seeing where a slow batch spent its time:
+//
+//     Trace::start();
+//     bulk_verify(file, executor);
+//     Trace::stop();
+//     Trace::write_chrome("verify.json");     // chrome://tracing or ui.perfetto.dev
+//
+// The library's spans are ECC_TRACE_SPAN, compiled in only with ECC_TRACING
+// defined (the ECC_TRACING CMake option) and otherwise nothing, the way
+// ECC_COUNT is. Compiled in, a span costs a relaxed load while tracing is
+// stopped and two clock reads and a store into the thread's own ring of
+// Trace::CAPACITY events while it runs: no lock and no allocation after a
+// thread's first span. A ring keeps only the thread's latest events.
+class Trace {
+public:
+    static constexpr std::size_t CAPACITY = 1 << 16;
+
+    // begins recording, dropping what earlier traces recorded
+    static void start();
+    static void stop();
+    static bool enabled() noexcept;
+
+    // the spans recorded between start() and stop(), as Chrome trace-event
+    // JSON of complete ("X") events; call once the traced work is done
+    static std::string chrome_json();
+    // chrome_json() into the file at path; throws std::runtime_error if it cannot be written
+    static void write_chrome(const std::string& path);
+
+    // nanoseconds on the clock spans are timed with
+    static uint64_t now() noexcept;
+    // a span of the calling thread; name must outlive the trace (a literal)
+    static void record(const char* name, uint64_t start, uint64_t end) noexcept;
+};
+
+// records the time from its construction to its destruction as name, when tracing
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name) noexcept : name(name), start(Trace::enabled() ? Trace::now() : 0) {}
+    ~TraceSpan() {
+        if (this->start != 0) {
+            Trace::record(this->name, this->start, Trace::now());
+        }
+    }
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* name;
+    uint64_t start;
+};
+
+#define ECC_TRACE_JOIN2(a, b)   a##b
+#define ECC_TRACE_JOIN(a, b)    ECC_TRACE_JOIN2(a, b)
+#ifdef ECC_TRACING
+#define ECC_TRACE_SPAN(name)    TraceSpan ECC_TRACE_JOIN(ecc_trace_span_, __LINE__)(name)
+#else
+#define ECC_TRACE_SPAN(name)    ((void) 0)
+#endif
+
+#endif //ECC_TRACE_H
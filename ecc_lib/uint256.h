@@ -0,0 +1,703 @@
+//
+// Created by preston on 10/14/2026.
+//
+
+#ifndef ECC_UINT256_H
+#define ECC_UINT256_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "integer.h"
+#include "limb.h"
+
+// Fixed-width unsigned integer made of LIMBS little-endian 64-bit limbs.
+// It is trivially copyable and never allocates; add, sub, mul and the shifts
+// wrap modulo 2^(64 * LIMBS) and carries are propagated through every limb.
+template <std::size_t LIMBS>
+struct fixed_uint {
+    static constexpr std::size_t BITS = LIMBS * 64;
+
+    limb_t limb[LIMBS];
+
+    fixed_uint() = default;
+    constexpr fixed_uint(limb_t v) : limb{v} {}
+
+    static constexpr fixed_uint zero() {
+        return fixed_uint(0);
+    }
+
+    // value must be non-negative and fit in BITS bits
+    static fixed_uint from_integer(const integer & value) {
+        static constexpr std::size_t DIGIT_BITS = sizeof(INTEGER_DIGIT_T) << 3;
+        static_assert(DIGIT_BITS <= 64, "integer digits must not be wider than a limb");
+
+        if ((value < 0) || (value.bit_length() > BITS)) {
+            throw std::out_of_range("Value does not fit in fixed_uint");
+        }
+
+        fixed_uint out(0);
+        const integer::limb_span digits = value.limbs();
+        for (std::size_t i = 0; i < digits.size(); i++) {
+            const std::size_t bit = i * DIGIT_BITS;
+            out.limb[bit / 64] |= static_cast <limb_t> (digits[i]) << (bit % 64);
+        }
+        return out;
+    }
+
+    integer to_integer() const {
+        static constexpr std::size_t DIGIT_BITS = sizeof(INTEGER_DIGIT_T) << 3;
+
+        integer::REP digits(BITS / DIGIT_BITS);
+        for (std::size_t i = 0; i < digits.size(); i++) {
+            const std::size_t bit = i * DIGIT_BITS;
+            digits[i] = static_cast <INTEGER_DIGIT_T> (limb[bit / 64] >> (bit % 64));
+        }
+        return integer(digits);
+    }
+
+    // the little-endian in[0, len), len <= 8 * LIMBS, zero extended; on a
+    // little-endian host the bytes are the limbs and this is a copy
+    static fixed_uint load_le(const uint8_t * in, std::size_t len) {
+        fixed_uint out(0);
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+        std::memcpy(out.limb, in, len);
+#else
+        for (std::size_t i = 0; i < len; i++) {
+            out.limb[i / 8] |= static_cast <limb_t> (in[i]) << (8 * (i % 8));
+        }
+#endif
+        return out;
+    }
+
+    // the low len bytes, little-endian, as load_le reads them
+    void store_le(uint8_t * out, std::size_t len) const {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+        std::memcpy(out, limb, len);
+#else
+        for (std::size_t i = 0; i < len; i++) {
+            out[i] = static_cast <uint8_t> (limb[i / 8] >> (8 * (i % 8)));
+        }
+#endif
+    }
+
+    // the big-endian in[0, len), len <= 8 * LIMBS, zero extended
+    static fixed_uint load_be(const uint8_t * in, std::size_t len) {
+        fixed_uint out(0);
+        for (std::size_t i = 0; i < len; i++) {
+            out.limb[i / 8] |= static_cast <limb_t> (in[len - 1 - i]) << (8 * (i % 8));
+        }
+        return out;
+    }
+
+    // the low len bytes, big-endian, as load_be reads them
+    void store_be(uint8_t * out, std::size_t len) const {
+        for (std::size_t i = 0; i < len; i++) {
+            out[len - 1 - i] = static_cast <uint8_t> (limb[i / 8] >> (8 * (i % 8)));
+        }
+    }
+
+    // whether each of the count little-endian values of width bytes at in is
+    // below bound: the borrows of the subtractions ORed together, with no branch
+    // on a value, so one pass covers them all
+    static bool all_below_le(const uint8_t * in, std::size_t count, std::size_t width, const fixed_uint & bound) {
+        limb_t at_least = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            fixed_uint diff;
+            at_least |= sub(diff, load_le(in + i * width, width), bound) ^ 1;
+        }
+        return !at_least;
+    }
+
+    // widen with zeros or truncate to another width
+    template <std::size_t M>
+    constexpr fixed_uint <M> resize() const {
+        fixed_uint <M> out(0);
+        for (std::size_t i = 0; i < ((M < LIMBS) ? M : LIMBS); i++) {
+            out.limb[i] = limb[i];
+        }
+        return out;
+    }
+
+    constexpr bool is_zero() const {
+        limb_t acc = 0;
+        for (std::size_t i = 0; i < LIMBS; i++) {
+            acc |= limb[i];
+        }
+        return !acc;
+    }
+
+    constexpr bool bit(std::size_t i) const {
+        return (i < BITS) && ((limb[i / 64] >> (i % 64)) & 1);
+    }
+
+    // minimum number of bits needed to hold this value
+    constexpr std::size_t bits() const {
+        for (std::size_t i = LIMBS; i > 0; i--) {
+            if (limb[i - 1]) {
+                std::size_t out = (i - 1) * 64;
+                for (limb_t top = limb[i - 1]; top; top >>= 1) {
+                    out++;
+                }
+                return out;
+            }
+        }
+        return 0;
+    }
+
+    // out = a + b, returns the carry out of the top limb
+    static constexpr limb_t add(fixed_uint & out, const fixed_uint & a, const fixed_uint & b) {
+        limb_t carry = 0;
+        for (std::size_t i = 0; i < LIMBS; i++) {
+            out.limb[i] = limb_addc(a.limb[i], b.limb[i], carry);
+        }
+        return carry;
+    }
+
+    // out = a - b, returns the borrow out of the top limb
+    static constexpr limb_t sub(fixed_uint & out, const fixed_uint & a, const fixed_uint & b) {
+        limb_t borrow = 0;
+        for (std::size_t i = 0; i < LIMBS; i++) {
+            out.limb[i] = limb_subb(a.limb[i], b.limb[i], borrow);
+        }
+        return borrow;
+    }
+
+    // full product a * b, no truncation
+    template <std::size_t M>
+    static constexpr fixed_uint <LIMBS + M> mul_wide(const fixed_uint & a, const fixed_uint <M> & b) {
+        fixed_uint <LIMBS + M> out(0);
+        for (std::size_t i = 0; i < LIMBS; i++) {
+            limb_t carry = 0;
+            for (std::size_t j = 0; j < M; j++) {
+                out.limb[i + j] = limb_mac(a.limb[i], b.limb[j], out.limb[i + j], carry);
+            }
+            out.limb[i + M] = carry;
+        }
+        return out;
+    }
+
+    // full square a * a: the cross products once, doubled, plus the diagonal
+    static constexpr fixed_uint <2 * LIMBS> sqr_wide(const fixed_uint & a) {
+        fixed_uint <2 * LIMBS> out(0);
+        for (std::size_t i = 0; i + 1 < LIMBS; i++) {
+            limb_t carry = 0;
+            for (std::size_t j = i + 1; j < LIMBS; j++) {
+                out.limb[i + j] = limb_mac(a.limb[i], a.limb[j], out.limb[i + j], carry);
+            }
+            out.limb[i + LIMBS] = carry;
+        }
+        limb_t top = 0;
+        for (std::size_t i = 0; i < 2 * LIMBS; i++) {
+            const limb_t d = out.limb[i];
+            out.limb[i] = (d << 1) | top;
+            top = d >> 63;
+        }
+        limb_t carry = 0;
+        for (std::size_t i = 0; i < LIMBS; i++) {
+            limb_t hi = 0;
+            const limb_t lo = limb_mul(a.limb[i], a.limb[i], hi);
+            out.limb[2 * i] = limb_addc(out.limb[2 * i], lo, carry);
+            out.limb[2 * i + 1] = limb_addc(out.limb[2 * i + 1], hi, carry);
+        }
+        return out;
+    }
+
+    constexpr fixed_uint operator+(const fixed_uint & rhs) const {
+        fixed_uint out(0);
+        add(out, *this, rhs);
+        return out;
+    }
+
+    constexpr fixed_uint operator-(const fixed_uint & rhs) const {
+        fixed_uint out(0);
+        sub(out, *this, rhs);
+        return out;
+    }
+
+    // product truncated to LIMBS limbs
+    constexpr fixed_uint operator*(const fixed_uint & rhs) const {
+        fixed_uint out(0);
+        for (std::size_t i = 0; i < LIMBS; i++) {
+            limb_t carry = 0;
+            for (std::size_t j = 0; i + j < LIMBS; j++) {
+                out.limb[i + j] = limb_mac(limb[i], rhs.limb[j], out.limb[i + j], carry);
+            }
+        }
+        return out;
+    }
+
+    constexpr fixed_uint operator<<(std::size_t shift) const {
+        fixed_uint out(0);
+        if (shift >= BITS) {
+            return out;
+        }
+        const std::size_t whole = shift / 64, part = shift % 64;
+        for (std::size_t i = LIMBS; i > whole; i--) {
+            out.limb[i - 1] = limb[i - 1 - whole] << part;
+            if (part && (i - 1 > whole)) {
+                out.limb[i - 1] |= limb[i - 2 - whole] >> (64 - part);
+            }
+        }
+        return out;
+    }
+
+    constexpr fixed_uint operator>>(std::size_t shift) const {
+        fixed_uint out(0);
+        if (shift >= BITS) {
+            return out;
+        }
+        const std::size_t whole = shift / 64, part = shift % 64;
+        for (std::size_t i = 0; i + whole < LIMBS; i++) {
+            out.limb[i] = limb[i + whole] >> part;
+            if (part && (i + whole + 1 < LIMBS)) {
+                out.limb[i] |= limb[i + whole + 1] << (64 - part);
+            }
+        }
+        return out;
+    }
+
+    constexpr fixed_uint operator&(const fixed_uint & rhs) const {
+        fixed_uint out(0);
+        for (std::size_t i = 0; i < LIMBS; i++) {
+            out.limb[i] = limb[i] & rhs.limb[i];
+        }
+        return out;
+    }
+
+    constexpr fixed_uint operator|(const fixed_uint & rhs) const {
+        fixed_uint out(0);
+        for (std::size_t i = 0; i < LIMBS; i++) {
+            out.limb[i] = limb[i] | rhs.limb[i];
+        }
+        return out;
+    }
+
+    constexpr fixed_uint operator^(const fixed_uint & rhs) const {
+        fixed_uint out(0);
+        for (std::size_t i = 0; i < LIMBS; i++) {
+            out.limb[i] = limb[i] ^ rhs.limb[i];
+        }
+        return out;
+    }
+
+    constexpr fixed_uint operator~() const {
+        fixed_uint out(0);
+        for (std::size_t i = 0; i < LIMBS; i++) {
+            out.limb[i] = ~limb[i];
+        }
+        return out;
+    }
+
+    // constant-time helpers: mask is all zero or all one bits and picks or applies the change
+    static constexpr fixed_uint select(limb_t mask, const fixed_uint & a, const fixed_uint & b) {
+        fixed_uint out(0);
+        for (std::size_t i = 0; i < LIMBS; i++) {
+            out.limb[i] = (a.limb[i] & mask) | (b.limb[i] & ~mask);
+        }
+        return out;
+    }
+
+    static constexpr void cswap(fixed_uint & a, fixed_uint & b, limb_t mask) {
+        for (std::size_t i = 0; i < LIMBS; i++) {
+            const limb_t t = (a.limb[i] ^ b.limb[i]) & mask;
+            a.limb[i] ^= t;
+            b.limb[i] ^= t;
+        }
+    }
+
+    // two's complement negation when mask is set
+    constexpr fixed_uint cneg(limb_t mask) const {
+        fixed_uint out(0);
+        limb_t carry = mask & 1;
+        for (std::size_t i = 0; i < LIMBS; i++) {
+            out.limb[i] = limb_addc(limb[i] ^ mask, 0, carry);
+        }
+        return out;
+    }
+
+    // shift right by one, copying the top bit (signed two's complement view)
+    constexpr fixed_uint sar1() const {
+        fixed_uint out(0);
+        for (std::size_t i = 0; i + 1 < LIMBS; i++) {
+            out.limb[i] = (limb[i] >> 1) | (limb[i + 1] << 63);
+        }
+        out.limb[LIMBS - 1] = static_cast <limb_t> (static_cast <int64_t> (limb[LIMBS - 1]) >> 1);
+        return out;
+    }
+
+    // x^-1 mod m for odd m and 0 < x < m with gcd(x, m) = 1, in constant time:
+    // a fixed number of Bernstein-Yang divsteps (safegcd), each done with masks
+    // instead of branches. The result is meaningless if x is not invertible.
+    static fixed_uint modinv_ct(const fixed_uint & x, const fixed_uint & m) {
+#if defined(__SIZEOF_INT128__)
+        return safegcd62(x, m);
+#else
+        return safegcd1(x, m);
+#endif
+    }
+
+    // Jacobi symbol (a / n) for odd n, in variable time: the binary reduction of
+    // limb_jacobi on the full width until both values fit in one limb
+    static int jacobi(fixed_uint a, fixed_uint n) {
+        int t = 1;
+        for (;;) {
+            limb_t high = 0;
+            for (std::size_t i = 1; i < LIMBS; i++) {
+                high |= a.limb[i] | n.limb[i];
+            }
+            if (!high) {
+                return limb_jacobi(a.limb[0], n.limb[0], t);
+            }
+            if (a.is_zero()) {
+                return 0;                                   // n > 1
+            }
+            std::size_t z = 0;
+            while (!a.limb[z / 64]) {
+                z += 64;
+            }
+            z += limb_ctz(a.limb[z / 64]);
+            a >>= z;
+            if ((z & 1) && (((n.limb[0] >> 1) ^ (n.limb[0] >> 2)) & 1)) {
+                t = -t;
+            }
+            if (a < n) {
+                if (a.limb[0] & n.limb[0] & 2) {
+                    t = -t;
+                }
+                std::swap(a, n);
+            }
+            a -= n;
+        }
+    }
+
+private:
+    static constexpr std::size_t DIVSTEPS = (49 * BITS + 57) / 17;  // divstep bound for BITS >= 46
+
+    // one divstep per iteration on the full-width values
+    static fixed_uint safegcd1(const fixed_uint & x, const fixed_uint & m) {
+        typedef fixed_uint <LIMBS + 1> wide;                        // f and g are signed
+
+        // a + b mod m for a, b < m
+        auto add_mod = [&m](const fixed_uint & a, const fixed_uint & b) {
+            fixed_uint s, t;
+            const limb_t carry = add(s, a, b);
+            const limb_t borrow = sub(t, s, m);
+            return select(0 - (carry | (borrow ^ 1)), t, s);
+        };
+        // -a mod m when mask is set, a otherwise
+        auto cneg_mod = [&m](const fixed_uint & a, limb_t mask) {
+            fixed_uint t;
+            const limb_t borrow = sub(t, zero(), a);                // borrow unless a == 0
+            add(t, t, select(0 - borrow, m, zero()));
+            return select(mask, t, a);
+        };
+        // a / 2 mod m
+        auto half_mod = [&m](const fixed_uint & a) {
+            fixed_uint s;
+            const limb_t carry = add(s, a, select(0 - (a.limb[0] & 1), m, zero()));
+            s = s >> 1;
+            s.limb[LIMBS - 1] |= carry << 63;
+            return s;
+        };
+
+        // invariants: d * x == f and e * x == g (mod m)
+        wide f = m.template resize <LIMBS + 1> ();
+        wide g = x.template resize <LIMBS + 1> ();
+        fixed_uint d(0), e(1);
+        int64_t delta = 1;
+
+        for (std::size_t i = 0; i < DIVSTEPS; i++) {
+            const limb_t odd  = 0 - (g.limb[0] & 1);
+            const limb_t swap = odd & (0 - (static_cast <limb_t> (-delta) >> 63));  // delta > 0 and g odd
+
+            // (delta, f, g, d, e) -> (-delta, g, -f, e, -d)
+            wide::cswap(f, g, swap);
+            cswap(d, e, swap);
+            g = g.cneg(swap);
+            e = cneg_mod(e, swap);
+            delta = (delta ^ static_cast <int64_t> (swap)) - static_cast <int64_t> (swap);
+
+            // (delta, f, g, d, e) -> (1 + delta, f, (g + odd * f) / 2, d, (e + odd * d) / 2)
+            delta += 1;
+            g = (g + wide::select(odd, f, wide::zero())).sar1();
+            e = half_mod(add_mod(e, select(odd, d, zero())));
+        }
+
+        // f is +-1 now, so x^-1 = d * f
+        return cneg_mod(d, 0 - (f.limb[LIMBS] >> 63));
+    }
+
+#if defined(__SIZEOF_INT128__)
+    // Values as signed 62-bit limbs, so a 2x2 matrix of 62-bit entries can be
+    // applied with 128-bit accumulators; the top limb carries the sign.
+    static constexpr std::size_t S62 = BITS / 62 + 1;
+    static constexpr uint64_t M62 = UINT64_MAX >> 2;
+
+    struct divstep_matrix {
+        int64_t u, v, q, r;
+    };
+
+    // 62 divsteps on the low words of f and g. The returned matrix maps the
+    // full (f, g) to 2^62 times their values after those steps.
+    static int64_t divsteps62(int64_t delta, uint64_t f, uint64_t g, divstep_matrix & t) {
+        uint64_t u = 1, v = 0, q = 0, r = 1;
+        for (int i = 0; i < 62; i++) {
+            const uint64_t odd  = 0 - (g & 1);
+            const uint64_t swap = odd & static_cast <uint64_t> ((0 - delta) >> 63);  // delta > 0 and g odd
+
+            // (delta, f, g, u, v, q, r) -> (-delta, g, -f, q, r, -u, -v)
+            uint64_t k = (f ^ g) & swap;
+            f ^= k;
+            g ^= k;
+            g = (g ^ swap) - swap;
+            k = (u ^ q) & swap;
+            u ^= k;
+            q ^= k;
+            q = (q ^ swap) - swap;
+            k = (v ^ r) & swap;
+            v ^= k;
+            r ^= k;
+            r = (r ^ swap) - swap;
+            delta = (delta ^ static_cast <int64_t> (swap)) - static_cast <int64_t> (swap);
+
+            // (delta, f, g) -> (1 + delta, f, (g + odd * f) / 2), tracked as doubling f's row
+            delta += 1;
+            g = (g + (f & odd)) >> 1;
+            q += u & odd;
+            r += v & odd;
+            u <<= 1;
+            v <<= 1;
+        }
+        t = {static_cast <int64_t> (u), static_cast <int64_t> (v), static_cast <int64_t> (q), static_cast <int64_t> (r)};
+        return delta;
+    }
+
+    static void to_s62(const fixed_uint & a, int64_t * out) {
+        for (std::size_t i = 0; i < S62; i++) {
+            const std::size_t bit = 62 * i, w = bit / 64, sh = bit % 64;
+            uint64_t chunk = (w < LIMBS) ? (a.limb[w] >> sh) : 0;
+            if (sh > 2 && w + 1 < LIMBS) {
+                chunk |= a.limb[w + 1] << (64 - sh);
+            }
+            out[i] = static_cast <int64_t> (chunk & M62);
+        }
+    }
+
+    // (f, g) <- [u v; q r] (f, g) / 2^62, exact
+    static void update_fg(int64_t * f, int64_t * g, const divstep_matrix & t) {
+        __int128 cf = static_cast <__int128> (t.u) * f[0] + static_cast <__int128> (t.v) * g[0];
+        __int128 cg = static_cast <__int128> (t.q) * f[0] + static_cast <__int128> (t.r) * g[0];
+        cf >>= 62;
+        cg >>= 62;
+        for (std::size_t i = 1; i < S62; i++) {
+            cf += static_cast <__int128> (t.u) * f[i] + static_cast <__int128> (t.v) * g[i];
+            cg += static_cast <__int128> (t.q) * f[i] + static_cast <__int128> (t.r) * g[i];
+            f[i - 1] = static_cast <int64_t> (static_cast <uint64_t> (cf) & M62);
+            g[i - 1] = static_cast <int64_t> (static_cast <uint64_t> (cg) & M62);
+            cf >>= 62;
+            cg >>= 62;
+        }
+        f[S62 - 1] = static_cast <int64_t> (cf);
+        g[S62 - 1] = static_cast <int64_t> (cg);
+    }
+
+    // (d, e) <- [u v; q r] (d, e) / 2^62 mod m, keeping both in (-2m, m): the
+    // multiples of m added are chosen to clear the low 62 bits before the shift
+    static void update_de(int64_t * d, int64_t * e, const divstep_matrix & t, const int64_t * m, uint64_t minv) {
+        const int64_t sd = d[S62 - 1] >> 63, se = e[S62 - 1] >> 63;
+        int64_t md = (t.u & sd) + (t.v & se);
+        int64_t me = (t.q & sd) + (t.r & se);
+        __int128 cd = static_cast <__int128> (t.u) * d[0] + static_cast <__int128> (t.v) * e[0];
+        __int128 ce = static_cast <__int128> (t.q) * d[0] + static_cast <__int128> (t.r) * e[0];
+        md -= static_cast <int64_t> ((minv * static_cast <uint64_t> (cd) + md) & M62);
+        me -= static_cast <int64_t> ((minv * static_cast <uint64_t> (ce) + me) & M62);
+        cd += static_cast <__int128> (m[0]) * md;
+        ce += static_cast <__int128> (m[0]) * me;
+        cd >>= 62;
+        ce >>= 62;
+        for (std::size_t i = 1; i < S62; i++) {
+            cd += static_cast <__int128> (t.u) * d[i] + static_cast <__int128> (t.v) * e[i] + static_cast <__int128> (m[i]) * md;
+            ce += static_cast <__int128> (t.q) * d[i] + static_cast <__int128> (t.r) * e[i] + static_cast <__int128> (m[i]) * me;
+            d[i - 1] = static_cast <int64_t> (static_cast <uint64_t> (cd) & M62);
+            e[i - 1] = static_cast <int64_t> (static_cast <uint64_t> (ce) & M62);
+            cd >>= 62;
+            ce >>= 62;
+        }
+        d[S62 - 1] = static_cast <int64_t> (cd);
+        e[S62 - 1] = static_cast <int64_t> (ce);
+    }
+
+    // r in (-2m, m) -> r * sign(f) mod m in [0, m)
+    static fixed_uint normalize(int64_t * r, int64_t sign, const int64_t * m) {
+        for (int pass = 0; pass < 2; pass++) {
+            const int64_t add = r[S62 - 1] >> 63;
+            for (std::size_t i = 0; i < S62; i++) {
+                r[i] += m[i] & add;
+            }
+            if (!pass) {
+                const int64_t neg = sign >> 63;
+                for (std::size_t i = 0; i < S62; i++) {
+                    r[i] = (r[i] ^ neg) - neg;
+                }
+            }
+            for (std::size_t i = 0; i + 1 < S62; i++) {
+                r[i + 1] += r[i] >> 62;
+                r[i] &= M62;
+            }
+        }
+
+        fixed_uint out(0);
+        for (std::size_t i = 0; i < S62; i++) {
+            const std::size_t bit = 62 * i, w = bit / 64, sh = bit % 64;
+            const uint64_t chunk = static_cast <uint64_t> (r[i]);
+            if (w < LIMBS) {
+                out.limb[w] |= chunk << sh;
+            }
+            if (sh > 2 && w + 1 < LIMBS) {
+                out.limb[w + 1] |= chunk >> (64 - sh);
+            }
+        }
+        return out;
+    }
+
+    // batches of 62 divsteps on the low words, each applied to the full values once
+    static fixed_uint safegcd62(const fixed_uint & x, const fixed_uint & m) {
+        int64_t f[S62], g[S62], d[S62] = {0}, e[S62] = {0}, m62[S62];
+        to_s62(m, f);
+        to_s62(x, g);
+        to_s62(m, m62);
+        e[0] = 1;
+
+        limb_t inv = 1;                                     // m^-1 mod 2^64 by Newton's iteration
+        for (int i = 0; i < 6; i++) {
+            inv *= 2 - m.limb[0] * inv;
+        }
+        const uint64_t minv = inv & M62;
+
+        int64_t delta = 1;
+        for (std::size_t i = 0; i < (DIVSTEPS + 61) / 62; i++) {
+            divstep_matrix t;
+            delta = divsteps62(delta, static_cast <uint64_t> (f[0]) | (static_cast <uint64_t> (f[1]) << 62),
+                               static_cast <uint64_t> (g[0]) | (static_cast <uint64_t> (g[1]) << 62), t);
+            update_fg(f, g, t);
+            update_de(d, e, t, m62, minv);
+        }
+
+        // f is +-1 now, so x^-1 = d * f
+        return normalize(d, f[S62 - 1], m62);
+    }
+#endif
+
+public:
+    constexpr fixed_uint & operator+=(const fixed_uint & rhs) { add(*this, *this, rhs); return *this; }
+    constexpr fixed_uint & operator-=(const fixed_uint & rhs) { sub(*this, *this, rhs); return *this; }
+    constexpr fixed_uint & operator<<=(std::size_t shift)     { return *this = *this << shift; }
+    constexpr fixed_uint & operator>>=(std::size_t shift)     { return *this = *this >> shift; }
+
+    friend constexpr bool operator==(const fixed_uint & lhs, const fixed_uint & rhs) {
+        limb_t diff = 0;
+        for (std::size_t i = 0; i < LIMBS; i++) {
+            diff |= lhs.limb[i] ^ rhs.limb[i];
+        }
+        return !diff;
+    }
+
+    friend constexpr bool operator!=(const fixed_uint & lhs, const fixed_uint & rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend constexpr bool operator<(const fixed_uint & lhs, const fixed_uint & rhs) {
+        for (std::size_t i = LIMBS; i > 0; i--) {
+            if (lhs.limb[i - 1] != rhs.limb[i - 1]) {
+                return lhs.limb[i - 1] < rhs.limb[i - 1];
+            }
+        }
+        return false;
+    }
+
+    friend constexpr bool operator>(const fixed_uint & lhs, const fixed_uint & rhs)  { return rhs < lhs; }
+    friend constexpr bool operator<=(const fixed_uint & lhs, const fixed_uint & rhs) { return !(rhs < lhs); }
+    friend constexpr bool operator>=(const fixed_uint & lhs, const fixed_uint & rhs) { return !(lhs < rhs); }
+
+    friend std::ostream & operator<<(std::ostream & os, const fixed_uint & a) {
+        return os << a.to_integer();
+    }
+};
+
+typedef fixed_uint <4> uint256;
+typedef fixed_uint <8> uint512;
+
+static_assert(std::is_trivially_copyable <uint256>::value && std::is_trivially_copyable <uint512>::value
+        , "fixed-width values must stay memcpy-able");
+static_assert(sizeof(uint256) == 32 && sizeof(uint512) == 64
+        , "fixed-width values must not carry padding");
+
+// The value of the literal digits s[0, len) in base (2, 8, 10 or 16, either
+// case), skipping ' separators. Throws std::invalid_argument for a digit the
+// base does not have and std::out_of_range past LIMBS limbs, which the
+// compiler reports as an error wherever it evaluates this.
+template <std::size_t LIMBS>
+constexpr fixed_uint <LIMBS> parse_fixed_uint(const char * s, std::size_t len, limb_t base) {
+    fixed_uint <LIMBS> out(0);
+    for (std::size_t i = 0; i < len; i++) {
+        const char c = s[i];
+        if (c == '\'') {
+            continue;
+        }
+        const limb_t d = (c >= '0' && c <= '9') ? limb_t(c - '0')
+                       : (c >= 'a' && c <= 'f') ? limb_t(c - 'a' + 10)
+                       : (c >= 'A' && c <= 'F') ? limb_t(c - 'A' + 10) : base;
+        if (d >= base) {
+            throw std::invalid_argument("Digit out of range for the literal's base");
+        }
+        limb_t carry = d;
+        for (std::size_t j = 0; j < LIMBS; j++) {
+            out.limb[j] = limb_mac(out.limb[j], base, 0, carry);
+        }
+        if (carry) {
+            throw std::out_of_range("Literal does not fit in fixed_uint");
+        }
+    }
+    return out;
+}
+
+// a C++ integer literal's characters: 0x, 0b and 0 prefixes as the language reads them
+template <std::size_t LIMBS>
+constexpr fixed_uint <LIMBS> parse_fixed_uint_literal(const char * s, std::size_t len) {
+    if (len > 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) {
+        return parse_fixed_uint <LIMBS> (s + 2, len - 2, 16);
+    }
+    if (len > 2 && s[0] == '0' && (s[1] == 'b' || s[1] == 'B')) {
+        return parse_fixed_uint <LIMBS> (s + 2, len - 2, 2);
+    }
+    return parse_fixed_uint <LIMBS> (s, len, (len > 1 && s[0] == '0') ? 8 : 10);
+}
+
+template <char... C>
+struct uint256_literal {
+    static constexpr char digits[] = {C...};
+    static constexpr uint256 value = parse_fixed_uint_literal <4> (digits, sizeof...(C));
+};
+
+// Constants the compiler builds, in place of integer("...", 16) at static
+// initialization: 0x79BE667E..._u256 is a uint256 with nothing left to run
+// (a value past 256 bits does not compile), and "79be667e..."_hex reads a hex
+// string as specifications print them, compile time wherever it initializes
+// a constexpr value. Both convert to integer through to_integer(), and
+// StaticFieldElement takes them in constexpr constructors.
+template <char... C>
+constexpr uint256 operator"" _u256() {
+    return uint256_literal <C...>::value;
+}
+
+constexpr uint256 operator"" _hex(const char * s, std::size_t len) {
+    return (len > 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) ? parse_fixed_uint <4> (s + 2, len - 2, 16)
+                                                                    : parse_fixed_uint <4> (s, len, 16);
+}
+
+#endif //ECC_UINT256_H
@@ -0,0 +1,26 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include "gtest/gtest.h"
+#include "BarrettReducer.h"
+
+TEST(BarrettReducerTest, MatchesModulus) {
+    const integer moduli[] = {
+            integer(7),
+            integer(1) << 64,
+            integer("fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f", 16),
+            (integer(1) << 521) - 1,
+            (integer(3) << 1500) + 12345,
+    };
+    for (const integer& m : moduli) {
+        BarrettReducer br(m);
+        const integer a = m - 3, b = m / 7 + 1;
+        EXPECT_EQ(br.mul(a, b), (a * b) % m);
+        EXPECT_EQ(br.reduce(m * m - 1), m - 1);
+        EXPECT_EQ(br.reduce(m), 0);
+        EXPECT_EQ(br.reduce(-(a * b)), m - (a * b) % m);
+        // past 2k digits it falls back to division
+        EXPECT_EQ(br.reduce(a * b * b * a + 5), (a * b * b * a + 5) % m);
+    }
+    EXPECT_THROW(BarrettReducer(integer(0)), std::invalid_argument);
+}
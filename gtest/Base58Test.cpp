@@ -0,0 +1,77 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base58.h"
+#include "gtest/gtest.h"
+#include "test_hex.h"
+
+static std::string encode(const std::vector<uint8_t>& in) {
+    std::string out(base58_max_encoded(in.size()), '\0');
+    out.resize(*base58_encode(in.data(), in.size(), &out[0], out.size()));
+    return out;
+}
+
+static std::vector<uint8_t> decode(const std::string& in) {
+    std::vector<uint8_t> out(base58_max_decoded(in.size()));
+    out.resize(*base58_decode(in.data(), in.size(), out.data(), out.size()));
+    return out;
+}
+
+// Bitcoin Core's base58_encode_decode vectors, both ways
+TEST(Base58Test, KnownEncodings) {
+    const char* vectors[][2] = {
+            {"", ""},
+            {"61", "2g"},
+            {"626262", "a3gV"},
+            {"636363", "aPEr"},
+            {"73696d706c792061206c6f6e6720737472696e67", "2cFupjhnEsSn59qHXstmK2ffpLv2"},
+            {"00eb15231dfceb60925886b67d065299925915aeb172c06647", "1NS17iag9jJgTHD1VXjvLCEnZuQ3rJDE9L"},
+            {"516b6fcd0f", "ABnLTmg"},
+            {"bf4f89001e670274dd", "3SEo3LWLoPntC"},
+            {"572e4794", "3EFU7m"},
+            {"ecac89cad93923c02321", "EJDM8drfXA6uyA"},
+            {"10c8511e", "Rt5zm"},
+            {"00000000000000000000", "1111111111"},
+            {"000111d38e5fc9071ffcd20b4a763cc9ae4f252bb4e48fd66a835e252ada93ff480d6dd43dc62a641155a5",
+             "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz"},
+    };
+    for (const auto& vector : vectors) {
+        EXPECT_EQ(encode(unhex(vector[0])), vector[1]) << vector[0];
+        EXPECT_EQ(decode(vector[1]), unhex(vector[0])) << vector[1];
+    }
+
+    // every length of zeros and ones about the limb boundaries
+    std::vector<uint8_t> data;
+    for (std::size_t i = 0; i < 100; i++) {
+        data.push_back(static_cast<uint8_t>(i < 3 ? 0 : i * 73 + 11));
+        EXPECT_EQ(decode(encode(data)), data) << i;
+    }
+
+    uint8_t out[8];
+    EXPECT_TRUE(base58_decode("2g0", 3, out, sizeof(out)).status() == Status::bad_digit);
+    EXPECT_TRUE(base58_decode("2gl", 3, out, sizeof(out)).status() == Status::bad_digit);
+    EXPECT_TRUE(base58_decode("a3gV", 4, out, 2).status() == Status::buffer_too_small);
+    char text[8];
+    EXPECT_TRUE(base58_encode(out, 8, text, 4).status() == Status::buffer_too_small);
+}
+
+// the address of the compressed key of secret key 1, version 0 and its HASH160
+TEST(Base58Test, Check) {
+    const std::vector<uint8_t> payload = unhex("00751e76e8199196d454941c45d1b3a323f1433bd6");
+    char text[64];
+    const std::size_t size = *base58check_encode(payload.data(), payload.size(), text, sizeof(text));
+    EXPECT_EQ(std::string(text, size), "1BgGZ9tcN4rm9KBzDn7KprQz87SZ26SAMH");
+
+    uint8_t out[32];
+    ASSERT_EQ(*base58check_decode(text, size, out, sizeof(out)), payload.size());
+    EXPECT_EQ(std::vector<uint8_t>(out, out + payload.size()), payload);
+    EXPECT_TRUE(base58check_decode(text, size, out, 20).status() == Status::buffer_too_small);
+
+    text[10] = text[10] == 'z' ? 'y' : 'z';
+    EXPECT_TRUE(base58check_decode(text, size, out, sizeof(out)).status() == Status::bad_encoding);
+    EXPECT_TRUE(base58check_decode("2g", 2, out, sizeof(out)).status() == Status::bad_encoding);
+}
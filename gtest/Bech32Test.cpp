@@ -0,0 +1,127 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "bech32.h"
+#include "gtest/gtest.h"
+#include "test_hex.h"
+
+// the valid strings of BIP173 and BIP350, decoded, checked for their variant
+// and encoded again; the encoding is lower case
+TEST(Bech32Test, ValidStrings) {
+    const std::pair<const char*, Bech32Variant> valid[] = {
+            {"A12UEL5L", Bech32Variant::bech32},
+            {"a12uel5l", Bech32Variant::bech32},
+            {"an83characterlonghumanreadablepartthatcontainsthenumber1andtheexcludedcharactersbio1tt5tgs",
+             Bech32Variant::bech32},
+            {"abcdef1qpzry9x8gf2tvdw0s3jn54khce6mua7lmqqqxw", Bech32Variant::bech32},
+            {"11qqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqqc8247j",
+             Bech32Variant::bech32},
+            {"split1checkupstagehandshakeupstreamerranterredcaperred2y9e3w", Bech32Variant::bech32},
+            {"?1ezyfcl", Bech32Variant::bech32},
+            {"A1LQFN3A", Bech32Variant::bech32m},
+            {"a1lqfn3a", Bech32Variant::bech32m},
+            {"abcdef1l7aum6echk45nj3s0wdvt2fg8x9yrzpqzd3ryx", Bech32Variant::bech32m},
+            {"split1checkupstagehandshakeupstreamerranterredcaperredlc445v", Bech32Variant::bech32m},
+            {"?1v759aa", Bech32Variant::bech32m},
+    };
+    for (const auto& string : valid) {
+        const std::size_t len = std::strlen(string.first);
+        char hrp[90], out[90];
+        uint8_t data[90];
+        const Result<Bech32Decoded> decoded = bech32_decode(string.first, len, hrp, sizeof(hrp), data, sizeof(data));
+        ASSERT_TRUE(decoded.ok()) << string.first;
+        EXPECT_TRUE(decoded->variant == string.second) << string.first;
+        const Result<std::size_t> size = bech32_encode(hrp, decoded->hrp_len, data, decoded->data_len,
+                                                       decoded->variant, out, sizeof(out));
+        ASSERT_TRUE(size.ok()) << string.first;
+        std::string lower(string.first);
+        for (char& c : lower) {
+            c = static_cast<char>(std::tolower(c));
+        }
+        EXPECT_EQ(std::string(out, *size), lower);
+    }
+}
+
+TEST(Bech32Test, InvalidStrings) {
+    const std::pair<std::string, Status> invalid[] = {
+            {"x1b4n0q5v", Status::bad_digit},                   // 'b' is not in the alphabet
+            {"li1dgmt3", Status::bad_encoding},                 // too short a checksum
+            {"A1G7SGD8", Status::bad_encoding},                 // the checksum of the upper-case hrp
+            {"1qzzfhee", Status::bad_encoding},                 // empty hrp
+            {"a12UEL5L", Status::bad_encoding},                 // mixed case
+            {std::string("de1lg7wt\xff", 9), Status::bad_encoding},
+            {"an84characterslonghumanreadablepartthatcontainsthenumber1andtheexcludedcharactersbio1569pvx",
+             Status::bad_encoding},                             // 91 characters
+            {"a12uel5m", Status::bad_encoding},                 // a character off
+    };
+    char hrp[90];
+    uint8_t data[90];
+    for (const auto& string : invalid) {
+        EXPECT_TRUE(bech32_decode(string.first.data(), string.first.size(), hrp, sizeof(hrp), data, sizeof(data))
+                            .status() == string.second) << string.first;
+    }
+    const uint8_t too_big[] = {32};
+    char out[16];
+    EXPECT_TRUE(bech32_encode("a", 1, too_big, 1, Bech32Variant::bech32, out, sizeof(out)).status()
+                == Status::bad_encoding);
+    EXPECT_TRUE(bech32_encode("a", 1, data, 0, Bech32Variant::bech32, out, 7).status() == Status::buffer_too_small);
+}
+
+// every length across a group of five bytes, and padding that is too long or not zero
+TEST(Bech32Test, ConvertsBits) {
+    std::vector<uint8_t> bytes;
+    for (std::size_t len = 0; len < 24; len++) {
+        uint8_t values[64], back[64];
+        const std::size_t count = *bech32_from_bytes(bytes.data(), bytes.size(), values, sizeof(values));
+        EXPECT_EQ(count, (8 * len + 4) / 5);
+        ASSERT_EQ(*bech32_to_bytes(values, count, back, sizeof(back)), len);
+        EXPECT_EQ(hex(back, len), hex(bytes.data(), len));
+        bytes.push_back(static_cast<uint8_t>(len * 97 + 5));
+    }
+    const uint8_t one_pad[] = {31, 1};        // 10 bits, 2 of them padding, not zero
+    const uint8_t long_pad[] = {31, 0, 0};    // 15 bits, 7 of them padding
+    uint8_t out[4];
+    EXPECT_TRUE(bech32_to_bytes(one_pad, 2, out, sizeof(out)).status() == Status::bad_encoding);
+    EXPECT_TRUE(bech32_to_bytes(long_pad, 3, out, sizeof(out)).status() == Status::bad_encoding);
+}
+
+// the segwit addresses of BIP173 and BIP350, a version 0 and a version 1 program
+TEST(Bech32Test, SegwitAddresses) {
+    const std::string key = "751e76e8199196d454941c45d1b3a323f1433bd6";
+    const std::pair<const char*, std::string> addresses[] = {
+            {"BC1QW508D6QEJXTDG4Y5R3ZARVARY0C5XW7KV8F3T4", key},
+            {"bc1pw508d6qejxtdg4y5r3zarvary0c5xw7kw508d6qejxtdg4y5r3zarvary0c5xw7kt5nd6y", key + key},
+    };
+    for (const auto& address : addresses) {
+        uint8_t program[40];
+        const Result<SegwitAddress> decoded = segwit_address_decode("bc", 2, address.first, std::strlen(address.first),
+                                                                    program, sizeof(program));
+        ASSERT_TRUE(decoded.ok()) << address.first;
+        EXPECT_EQ(hex(program, decoded->program_len), address.second);
+        char out[90];
+        const std::size_t size = *segwit_address_encode("bc", 2, decoded->version, program, decoded->program_len, out,
+                                                        sizeof(out));
+        std::string lower(address.first);
+        for (char& c : lower) {
+            c = static_cast<char>(std::tolower(c));
+        }
+        EXPECT_EQ(std::string(out, size), lower);
+    }
+
+    uint8_t program[40];
+    for (const char* bad : {
+            "bc1zw508d6qejxtdg4y5r3zarvaryvqyzf3du",            // version 2 under Bech32
+            "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kemeawh",       // version 0 under Bech32m
+            "tb1q0sqzfp3zj42u0perxr6jahhu4y03uw4dypk6sc",       // another hrp
+            "bc1q9zpgru",                                       // a one-byte program
+    }) {
+        EXPECT_FALSE(segwit_address_decode("bc", 2, bad, std::strlen(bad), program, sizeof(program)).ok()) << bad;
+    }
+    EXPECT_TRUE(segwit_address_encode("bc", 2, 0, program, 21, nullptr, 0).status() == Status::bad_encoding);
+}
@@ -0,0 +1,103 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "BinaryField.h"
+
+static integer random_bits(std::mt19937_64& random, unsigned bits) {
+    integer out;
+    for (unsigned i = 0; i < bits; i += 64) {
+        out = (out << 64) | integer(static_cast<uint64_t>(random()));
+    }
+    return out >> (out.bit_length() > bits ? out.bit_length() - bits : 0);
+}
+
+// the product mod f one bit at a time, from integer shifts and exclusive ors
+static integer reference_mul(const integer& a, const integer& b, const integer& f) {
+    integer product;
+    for (std::size_t i = 0; i < b.bit_length(); i++) {
+        if (b.test_bit(i)) {
+            product ^= a << i;
+        }
+    }
+    const std::size_t m = f.bit_length() - 1;
+    while (product.bit_length() > m) {
+        product ^= f << (product.bit_length() - 1 - m);
+    }
+    return product;
+}
+
+TEST(BinaryFieldTest, KernelsAgree) {
+    std::mt19937_64 random(1);
+    std::vector<const ClmulKernel*> kernels = {&portable_clmul_kernel()};
+    for (const ClmulKernel* k : {pclmul_clmul_kernel(), pmull_clmul_kernel()}) {
+        if (k) {
+            kernels.push_back(k);
+        }
+    }
+    for (std::size_t n = 1; n <= BinaryField::MAX_LIMBS; n++) {
+        std::vector<limb_t> a(n), b(n);
+        for (std::size_t i = 0; i < n; i++) {
+            a[i] = random();
+            b[i] = random();
+        }
+        a[n - 1] |= limb_t(7) << 61;
+        std::vector<limb_t> expected(2 * n), out(2 * n);
+        portable_clmul_kernel().mul(expected.data(), a.data(), b.data(), n);
+        for (const ClmulKernel* k : kernels) {
+            k->mul(out.data(), a.data(), b.data(), n);
+            EXPECT_EQ(out, expected) << k->name << " " << n;
+        }
+    }
+}
+
+TEST(BinaryFieldTest, MatchesReference) {
+    std::mt19937_64 random(2);
+    for (const BinaryField* field : {&BinaryField::sect233(), &BinaryField::sect283(), &BinaryField::get(571, 10, 5, 2),
+                                     &BinaryField::get(127, 1)}) {
+        const integer f = field->polynomial();
+        for (int i = 0; i < 20; i++) {
+            const integer x = random_bits(random, field->degree()), y = random_bits(random, field->degree());
+            const BinaryFieldElement a(x, *field), b(y, *field);
+            EXPECT_EQ((a + b).value(), x ^ y);
+            EXPECT_EQ((a * b).value(), reference_mul(x, y, f));
+            EXPECT_EQ(a.square().value(), reference_mul(x, x, f));
+        }
+    }
+}
+
+TEST(BinaryFieldTest, InverseSqrtTrace) {
+    std::mt19937_64 random(3);
+    for (const BinaryField* field : {&BinaryField::sect233(), &BinaryField::sect283()}) {
+        const BinaryFieldElement one = BinaryFieldElement::one(*field);
+        for (int i = 0; i < 10; i++) {
+            const BinaryFieldElement a(random_bits(random, field->degree()) | integer(1), *field);
+            const BinaryFieldElement b(random_bits(random, field->degree()), *field);
+            EXPECT_EQ(a * a.inverse(), one);
+            EXPECT_EQ(b / a * a, b);
+            EXPECT_EQ(a.sqrt().square(), a);
+            EXPECT_EQ(a.power(integer(1) << field->degree()), a);
+            EXPECT_EQ(a.power(-3) * a.power(3), one);
+            // the trace is linear, and z^2 + z has trace 0
+            EXPECT_EQ((a + b).trace(), a.trace() ^ b.trace());
+            EXPECT_EQ((b.square() + b).trace(), 0u);
+        }
+        EXPECT_EQ(one.trace(), field->degree() % 2);
+    }
+}
+
+TEST(BinaryFieldTest, Errors) {
+    const BinaryField& field = BinaryField::sect233();
+    EXPECT_EQ(&BinaryField::get(233, 74), &field);
+    EXPECT_THROW(BinaryFieldElement::zero(field).inverse(), std::domain_error);
+    EXPECT_THROW(BinaryFieldElement(integer(1) << 233, field), std::invalid_argument);
+    EXPECT_THROW(BinaryFieldElement(-1, field), std::invalid_argument);
+    EXPECT_THROW(BinaryFieldElement::one(field) + BinaryFieldElement::one(BinaryField::sect283()), std::runtime_error);
+    EXPECT_THROW(BinaryField::get(233, 233), std::invalid_argument);
+    EXPECT_THROW(BinaryField::get(283, 12, 5, 7), std::invalid_argument);
+    EXPECT_THROW(BinaryField::get(1000, 3), std::invalid_argument);
+}
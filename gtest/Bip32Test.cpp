@@ -0,0 +1,87 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "bip32.h"
+#include "test_hex.h"
+
+static std::string secret_hex(const Bip32Key& key) {
+    uint8_t secret[32];
+    key.private_key(secret);
+    return hex(secret, 32);
+}
+
+static const uint32_t H = Bip32Key::HARDENED;
+
+static Bip32Key vector1_master() {
+    uint8_t seed[16];
+    for (uint8_t i = 0; i < 16; i++) {
+        seed[i] = i;
+    }
+    return *Bip32Key::from_seed(seed, sizeof(seed));
+}
+
+// BIP32 test vector 1, m/0H/1/2H/2/1000000000
+TEST(Bip32Test, TestVector1) {
+    const Bip32Key m = vector1_master();
+    EXPECT_EQ(hex(m.chain_code(), 32), "873dff81c02f525623fd1fe5167eac3a55a049de3d314bb42ee227ffed37d508");
+    EXPECT_EQ(secret_hex(m), "e8f32e723decf4051aefac8e2c93c9c5b214313817cdb01a1494b917c8436b35");
+    EXPECT_EQ(hex(m.public_key_bytes(), 33), "0339a36013301597daef41fbe593a02cc513d0b55527ec2df1050e2e8ff49c85c2");
+
+    const Result<Bip32Key> a = m.derive({0 | H, 1});
+    ASSERT_TRUE(a.ok());
+    EXPECT_EQ(hex(a->chain_code(), 32), "2a7857631386ba23dacac34180dd1983734e444fdbf774041578e9b6adb37c19");
+    EXPECT_EQ(secret_hex(*a), "3c6cb8d0f6a264c91ea8b5030fadaa8e538b020f0a387421a12de9319dc93368");
+    EXPECT_EQ(hex(a->public_key_bytes(), 33), "03501e454bf00751f24b1b489aa925215d66af2234e3891c3b21a52bedb3cd711c");
+    EXPECT_EQ(a->depth(), 2);
+    EXPECT_EQ(a->child_number(), 1u);
+
+    const Result<Bip32Key> b = a->derive({2 | H, 2, 1000000000});
+    ASSERT_TRUE(b.ok());
+    EXPECT_EQ(hex(b->chain_code(), 32), "c783e67b921d2beb8f6b389cc646d7263b4145701dadd2161548a8b078e65e9e");
+    EXPECT_EQ(secret_hex(*b), "471b76e389e528d6de6d816857e012c5455051cad6660850e58372a6c3e6e7c8");
+    EXPECT_EQ(hex(b->public_key_bytes(), 33), "022a471424da5e657499d1ff51cb43c47481a03b1e77f951fe64cec9f5a48f7011");
+
+    // CKDpub of m/0H/1/2H gives the public half of the same leaf
+    const Result<Bip32Key> pub = a->derive({2 | H})->neutered().derive({2, 1000000000});
+    ASSERT_TRUE(pub.ok());
+    EXPECT_FALSE(pub->is_private());
+    EXPECT_EQ(hex(pub->public_key_bytes(), 33), hex(b->public_key_bytes(), 33));
+    EXPECT_EQ(hex(pub->chain_code(), 32), hex(b->chain_code(), 32));
+    EXPECT_TRUE(pub->child(H).status() == Status::out_of_range);
+    EXPECT_THROW(pub->private_key(nullptr), std::domain_error);
+
+    EXPECT_TRUE(Bip32Key::from_seed(m.chain_code(), 15).status() == Status::bad_encoding);
+}
+
+TEST(Bip32Test, ChildrenAndCache) {
+    const Bip32Key m = vector1_master();
+    for (const Bip32Key& parent : {*m.child(H), m.child(H)->neutered()}) {
+        const std::vector<Result<Bip32Key>> kids = parent.children(H - 3, 6);
+        ASSERT_EQ(kids.size(), 6u);
+        for (std::size_t j = 0; j < kids.size(); j++) {
+            const Result<Bip32Key> one = parent.child(static_cast<uint32_t>(H - 3 + j));
+            ASSERT_TRUE(one.status() == kids[j].status()) << j;
+            if (one) {
+                EXPECT_EQ(hex(one->public_key_bytes(), 33), hex(kids[j]->public_key_bytes(), 33));
+                EXPECT_TRUE(kids[j]->public_key().is_normalized());
+            }
+        }
+        EXPECT_EQ(kids[3].ok(), parent.is_private());
+    }
+    EXPECT_THROW(m.children(0xFFFFFFFF, 2), std::invalid_argument);
+
+    Bip32Cache cache(m);
+    const std::vector<uint32_t> path = {44 | H, 0 | H, 0 | H, 0, 7};
+    const Result<Bip32Key> leaf = cache.derive(path);
+    ASSERT_TRUE(leaf.ok());
+    EXPECT_EQ(cache.size(), 4u);
+    EXPECT_EQ(secret_hex(*leaf), secret_hex(*m.derive(path)));
+    const std::vector<Result<Bip32Key>> range = cache.children({44 | H, 0 | H, 0 | H, 0}, 7, 3);
+    EXPECT_EQ(secret_hex(*range[0]), secret_hex(*leaf));
+    EXPECT_EQ(cache.size(), 4u);
+}
@@ -0,0 +1,87 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "bls12_381.h"
+#include "Curve.h"
+
+static const Curve& g1() {
+    return Curve::bls12_381();
+}
+
+TEST(Bls12381Test, GroupOrders) {
+    const integer& r = g1().n();
+    EXPECT_TRUE(g1().generator().mul(r).is_infinity());
+    EXPECT_TRUE(G2Point::generator().in_subgroup());
+    EXPECT_EQ(Curve::find("BLS12-381"), &g1());
+    EXPECT_EQ(Curve::of(g1().generator()), &g1());
+    // p = (x - 1)^2 (x^4 - x^2 + 1) / 3 + x and r = x^4 - x^2 + 1
+    const integer x = -integer(BLS12_381_X);
+    EXPECT_EQ(r, x * x * x * x - x * x + 1);
+    EXPECT_EQ(g1().p(), (x - 1) * (x - 1) * r / 3 + x);
+    EXPECT_EQ(g1().cofactor(), (x - 1) * (x - 1) / 3);
+}
+
+TEST(Bls12381Test, G2Arithmetic) {
+    const G2Point& g = G2Point::generator();
+    EXPECT_EQ(g + g, g.dbl());
+    EXPECT_EQ(g.mul(5) + g.mul(7), g.mul(12));
+    EXPECT_EQ(g.mul(-3), -g.mul(3));
+    EXPECT_TRUE((g - g).is_infinity());
+    EXPECT_EQ(g.mul(g1().n() + 2), g.dbl());
+    const std::pair<Fp2, Fp2> a = g.mul(9).affine();
+    EXPECT_EQ(G2Point(a.first, a.second), g.mul(9));
+    EXPECT_THROW(G2Point(a.first, a.first), std::invalid_argument);
+    EXPECT_THROW(G2Point().affine(), std::domain_error);
+}
+
+TEST(Bls12381Test, PairingIsBilinear) {
+    const Point& p = g1().generator();
+    const G2Point& q = G2Point::generator();
+    const Fp12 e = bls12_381_pairing(p, q);
+    EXPECT_FALSE(e.is_one());
+    EXPECT_TRUE(e.power(g1().n()).is_one());
+
+    const integer a(0x1234567), b(0x89abcdef);
+    EXPECT_EQ(bls12_381_pairing(p.mul(a), q.mul(b)), e.power(a * b));
+    EXPECT_EQ(bls12_381_pairing(p.mul(b), q), bls12_381_pairing(p, q.mul(b)));
+    EXPECT_EQ(bls12_381_pairing(-p, q), e.conjugate());
+}
+
+TEST(Bls12381Test, FinalExponentiationIsAFixedPower) {
+    const Fp12 f = bls12_381_miller_loop(&g1().generator(), &G2Point::generator(), 1);
+    const integer p = g1().p();
+    const integer p2 = p * p, p4 = p2 * p2;
+    const integer exponent = (p4 * p4 * p4 - 1) / g1().n();
+    // the hard part computes the cube of the textbook pairing
+    EXPECT_EQ(bls12_381_final_exponentiation(f), f.power(exponent * 3));
+    // the easy part lands in the cyclotomic subgroup, where both squarings agree
+    const Fp12 t = f.conjugate() * f.inverse();
+    const Fp12 c = t.frobenius(2) * t;
+    EXPECT_EQ(c.cyclotomic_square(), c.square());
+}
+
+TEST(Bls12381Test, MultiPairing) {
+    const Point& p = g1().generator();
+    const G2Point& q = G2Point::generator();
+    const integer a(77), b(1001);
+    const std::vector<Point> ps = {p.mul(a), p.mul(b), g1().infinity()};
+    const std::vector<G2Point> qs = {q, q.mul(3), q};
+    EXPECT_EQ(bls12_381_multi_pairing(ps, qs), bls12_381_pairing(p, q).power(a + 3 * b));
+
+    // a BLS signature check: e(sig, g2) == e(H(m), pk) for sig = sk H(m), pk = sk g2
+    const integer sk(0x5eed);
+    const Point h = p.mul(31337);
+    const std::vector<Point> check = {h.mul(sk), -h};
+    const std::vector<G2Point> against = {q, q.mul(sk)};
+    EXPECT_TRUE(bls12_381_pairing_check(check.data(), against.data(), 2));
+    const std::vector<G2Point> wrong = {q, q.mul(sk + 1)};
+    EXPECT_FALSE(bls12_381_pairing_check(check.data(), wrong.data(), 2));
+
+    EXPECT_TRUE(bls12_381_multi_pairing(nullptr, nullptr, 0).is_one());
+    EXPECT_THROW(bls12_381_pairing(Curve::secp256k1().generator(), q), std::invalid_argument);
+    EXPECT_THROW(bls12_381_multi_pairing(ps, {q}), std::invalid_argument);
+}
@@ -0,0 +1,145 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "bulk_cluster.h"
+#include "gtest/gtest.h"
+#include "schnorr.h"
+#include "sha256.h"
+#include "test_files.h"
+
+// count BIP340 records, those in bad with a spoiled message
+static void write_schnorr(const std::string& path, std::size_t count, const std::vector<uint64_t>& bad) {
+    BulkWriter writer(path, BulkScheme::schnorr);
+    for (std::size_t i = 0; i < count; i++) {
+        const uint8_t secret[32] = {static_cast<uint8_t>(i + 1), 0x44};
+        uint8_t message[32] = {static_cast<uint8_t>(i), 0x17}, key[32], signature[64];
+        schnorr_public_key(key, secret);
+        schnorr_sign(signature, message, 32, secret, nullptr);
+        for (uint64_t b : bad) {
+            if (b == i) {
+                message[2] ^= 1;
+            }
+        }
+        writer.add(key, message, signature);
+    }
+}
+
+TEST(BulkClusterTest, RangesAreSlicesOfTheWholeFile) {
+    const std::string path = temp_path("cluster_range.bin");
+    write_schnorr(path, 30, {4, 17, 29});
+    const BulkFile file(path);
+    ThreadExecutor executor(1);
+    const BulkVerifyResult slice = bulk_verify_range(file, 10, 20, executor, 6);
+    EXPECT_EQ(slice.records, 20u);
+    EXPECT_EQ(slice.valid, 18u);
+    EXPECT_EQ(slice.invalid, (std::vector<uint64_t>{17, 29}));
+    EXPECT_EQ(bulk_verify_range(file, 30, 0, executor).records, 0u);
+    EXPECT_THROW(bulk_verify_range(file, 25, 6, executor), std::invalid_argument);
+    std::remove(path.c_str());
+}
+
+// two workers over shards of 16 records find what bulk_verify finds, and a
+// coordinator started again on the checkpoint has nothing left to hand out
+TEST(BulkClusterTest, WorkersMatchBulkVerify) {
+    const std::string path = temp_path("cluster_schnorr.bin"), checkpoint = temp_path("cluster.checkpoint");
+    std::remove(checkpoint.c_str());
+    write_schnorr(path, 100, {7, 50, 51, 99});
+    const BulkFile file(path);
+    ThreadExecutor local(1);
+    const BulkVerifyResult expected = bulk_verify(file, local);
+
+    BulkClusterOptions options;
+    options.shard_records = 16;
+    options.checkpoint = checkpoint;
+    BulkVerifyResult result;
+    {
+        BulkCoordinator coordinator(file, 0, options);
+        EXPECT_EQ(coordinator.shards(), 7u);
+        EXPECT_EQ(coordinator.resumed(), 0u);
+        std::thread serving([&]() { result = coordinator.run(); });
+        uint64_t verified[2] = {};
+        std::vector<std::thread> workers;
+        for (std::size_t w = 0; w < 2; w++) {
+            workers.emplace_back([&, w]() {
+                ThreadExecutor executor(1);
+                verified[w] = bulk_worker(file, "127.0.0.1", coordinator.port(), executor, 5);
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        serving.join();
+        EXPECT_EQ(verified[0] + verified[1], 7u);
+    }
+    EXPECT_EQ(result.records, expected.records);
+    EXPECT_EQ(result.valid, expected.valid);
+    EXPECT_EQ(result.invalid, expected.invalid);
+
+    BulkCoordinator again(file, 0, options);
+    EXPECT_EQ(again.resumed(), 7u);
+    const BulkVerifyResult resumed = again.run();
+    EXPECT_EQ(resumed.invalid, expected.invalid);
+
+    options.shard_records = 32;
+    EXPECT_THROW(BulkCoordinator(file, 0, options), std::runtime_error);
+    std::remove(checkpoint.c_str());
+    std::remove(path.c_str());
+}
+
+// a worker that takes a shard and disappears, and one with another file:
+// the first's shard is verified by the next worker, the second (its first
+// record differs) is turned away
+TEST(BulkClusterTest, LostShardsGoToTheNextWorker) {
+    const std::string path = temp_path("cluster_lost.bin"), other = temp_path("cluster_other.bin");
+    write_schnorr(path, 40, {3, 38});
+    write_schnorr(other, 40, {0});
+    const BulkFile file(path), other_file(other);
+    BulkClusterOptions options;
+    options.shard_records = 10;
+    options.window = 1;
+    BulkCoordinator coordinator(file, 0, options);
+    BulkVerifyResult result;
+    std::thread serving([&]() { result = coordinator.run(); });
+
+    // the hello of the protocol, by hand
+    uint8_t hello[64] = {'E', 'C', 'C', 'S', 'H', 'A', 'R', 'D', 1};
+    hello[12] = static_cast<uint8_t>(BulkScheme::schnorr);
+    hello[16] = static_cast<uint8_t>(file.record_size());
+    hello[24] = static_cast<uint8_t>(file.size());
+    Sha256 digest;
+    digest.update(file.record(0), file.record_size());
+    digest.update(file.record(file.size() - 1), file.record_size());
+    digest.finish(hello + 32);
+    const int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(coordinator.port());
+    ASSERT_EQ(connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    ASSERT_EQ(send(fd, hello, sizeof(hello), 0), static_cast<ssize_t>(sizeof(hello)));
+    uint8_t assignment[24];
+    ASSERT_EQ(recv(fd, assignment, sizeof(assignment), MSG_WAITALL), static_cast<ssize_t>(sizeof(assignment)));
+    EXPECT_EQ(assignment[16], 10);
+    close(fd);
+
+    ThreadExecutor executor(1);
+    EXPECT_THROW(bulk_worker(other_file, "127.0.0.1", coordinator.port(), executor), std::runtime_error);
+    EXPECT_EQ(bulk_worker(file, "localhost", coordinator.port(), executor), 4u);
+    serving.join();
+    EXPECT_EQ(result.valid, 38u);
+    EXPECT_EQ(result.invalid, (std::vector<uint64_t>{3, 38}));
+    std::remove(path.c_str());
+    std::remove(other.c_str());
+}
@@ -0,0 +1,171 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bulk.h"
+#include "ecdsa.h"
+#include "gtest/gtest.h"
+#include "schnorr.h"
+#include "sec1.h"
+#include "test_files.h"
+
+// records signed under secrets 1, 2, ..., with every seventh signature, one
+// hash and one key spoiled; only those show up as invalid, in every chunking
+TEST(BulkTest, EcdsaFindsTheBadRecords) {
+    const Curve& curve = Curve::p256();
+    const std::string path = temp_path("bulk_ecdsa.bin");
+    const std::size_t count = 50;
+    std::vector<uint64_t> bad;
+    {
+        BulkWriter writer(path, BulkScheme::ecdsa_p256);
+        for (std::size_t i = 0; i < count; i++) {
+            uint8_t secret[32] = {}, hash[32] = {static_cast<uint8_t>(i), 0x5a}, signature[64], key[33];
+            secret[31] = static_cast<uint8_t>(i + 1);
+            ASSERT_TRUE(ecdsa_sign(signature, curve, secret, hash, 32) == Status::ok);
+            ASSERT_TRUE(sec1_encode(curve.generator() * integer(i + 1), true, key, 33).ok());
+            if (i % 7 == 3) {
+                signature[40] ^= 1;
+            } else if (i == 10) {
+                hash[5] ^= 1;
+            } else if (i == 20) {
+                key[0] = 0x05;
+            } else {
+                writer.add(key, hash, signature);
+                continue;
+            }
+            bad.push_back(i);
+            writer.add(key, hash, signature);
+        }
+        EXPECT_EQ(writer.size(), count);
+    }
+
+    const BulkFile file(path);
+    EXPECT_TRUE(file.scheme() == BulkScheme::ecdsa_p256);
+    EXPECT_EQ(file.size(), count);
+    EXPECT_EQ(file.record_size(), 129u);
+    WorkStealingPool pool(2);
+    for (std::size_t chunk : {std::size_t(1), std::size_t(16), std::size_t(1000)}) {
+        const BulkVerifyResult result = bulk_verify(file, pool, chunk);
+        EXPECT_EQ(result.records, count);
+        EXPECT_EQ(result.valid, count - bad.size());
+        EXPECT_EQ(result.invalid, bad) << chunk;
+    }
+    std::remove(path.c_str());
+}
+
+TEST(BulkTest, SchnorrFallsBackToSingleChecks) {
+    const std::string path = temp_path("bulk_schnorr.bin");
+    const std::size_t count = 40;
+    {
+        BulkWriter writer(path, BulkScheme::schnorr);
+        for (std::size_t i = 0; i < count; i++) {
+            const uint8_t secret[32] = {static_cast<uint8_t>(i + 1), 0x33};
+            uint8_t message[32] = {static_cast<uint8_t>(i)}, key[32], signature[64];
+            schnorr_public_key(key, secret);
+            schnorr_sign(signature, message, 32, secret, nullptr);
+            if (i == 9 || i == 33) {
+                message[1] ^= 1;
+            }
+            writer.add(key, message, signature);
+        }
+    }
+
+    const BulkFile file(path);
+    EXPECT_EQ(file.record_size(), 128u);
+    WorkStealingPool pool(2);
+    const BulkVerifyResult bad = bulk_verify(file, pool, 8);
+    EXPECT_EQ(bad.valid, count - 2);
+    EXPECT_EQ(bad.invalid, (std::vector<uint64_t>{9, 33}));
+    std::remove(path.c_str());
+}
+
+TEST(BulkTest, RejectsMalformedFiles) {
+    const std::string path = temp_path("bulk_bad.bin");
+    EXPECT_THROW(BulkFile(temp_path("bulk_missing.bin")), std::runtime_error);
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "not a bulk file at all, just some bytes";
+    }
+    EXPECT_THROW(BulkFile file(path), std::runtime_error);
+
+    // a header promising more records than follow it
+    {
+        BulkWriter writer(path, BulkScheme::schnorr);
+        const uint8_t zero[64] = {};
+        writer.add(zero, zero, zero);
+        writer.add(zero, zero, zero);
+    }
+    {
+        std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+        f.seekp(24);
+        f.put(3);
+    }
+    EXPECT_THROW(BulkFile file(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+// a checkpoint after every chunk; the last entry torn as by a kill, and
+// then a record spoiled behind the checkpoint, which a resumed run skips
+TEST(BulkTest, ResumesFromTheCheckpoint) {
+    const std::string path = temp_path("bulk_resume.bin"), sidecar = temp_path("bulk_resume.ckpt");
+    std::remove(sidecar.c_str());
+    const std::size_t count = 60;
+    {
+        BulkWriter writer(path, BulkScheme::schnorr);
+        for (std::size_t i = 0; i < count; i++) {
+            const uint8_t secret[32] = {static_cast<uint8_t>(i + 1), 0x55};
+            uint8_t message[32] = {static_cast<uint8_t>(i)}, key[32], signature[64];
+            schnorr_public_key(key, secret);
+            schnorr_sign(signature, message, 32, secret, nullptr);
+            if (i == 5 || i == 42) {
+                message[1] ^= 1;
+            }
+            writer.add(key, message, signature);
+        }
+    }
+    const auto read = [](const std::string& name) {
+        std::ifstream in(name, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    };
+    ThreadExecutor executor(1);
+    {
+        const BulkFile file(path);
+        const BulkVerifyResult whole = bulk_verify_resumable(file, sidecar, executor, 8, 0);
+        EXPECT_EQ(whole.valid, count - 2);
+        EXPECT_EQ(whole.invalid, (std::vector<uint64_t>{5, 42}));
+        const std::string saved = read(sidecar);
+        {
+            std::ofstream out(sidecar, std::ios::binary | std::ios::trunc);
+            out << saved.substr(0, saved.size() - 13);
+        }
+        EXPECT_EQ(bulk_verify_resumable(file, sidecar, executor, 8, 0).invalid, whole.invalid);
+        EXPECT_EQ(read(sidecar), saved);
+    }
+    {
+        std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+        f.seekp(32 + 20 * 128 + 32 + 3);
+        f.put(1);
+    }
+    const BulkFile spoiled(path);
+    EXPECT_EQ(bulk_verify_resumable(spoiled, sidecar, executor).invalid, (std::vector<uint64_t>{5, 42}));
+    std::remove(sidecar.c_str());
+    EXPECT_EQ(bulk_verify_resumable(spoiled, sidecar, executor).invalid, (std::vector<uint64_t>{5, 20, 42}));
+
+    // the sidecar of another file
+    {
+        BulkWriter writer(path, BulkScheme::schnorr);
+        const uint8_t zero[64] = {};
+        writer.add(zero, zero, zero);
+    }
+    const BulkFile other(path);
+    EXPECT_THROW(bulk_verify_resumable(other, sidecar, executor), std::runtime_error);
+    std::remove(sidecar.c_str());
+    std::remove(path.c_str());
+}
@@ -0,0 +1,108 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "bulletproofs.h"
+#include "Curve.h"
+
+static const PrimeField& order() {
+    return Curve::secp256k1().scalar_field();
+}
+
+TEST(BulletproofsTest, PedersenCommitments) {
+    const Curve& curve = Curve::secp256k1();
+    const Point& h = pedersen_h();
+    EXPECT_TRUE(h.is_normalized());
+    EXPECT_NE(h, curve.generator());
+    EXPECT_EQ(h, hash_to_secp256k1("pedersen", 0));
+    EXPECT_NE(h, hash_to_secp256k1("pedersen", 1));
+    const Scalar v(integer(1000), order()), r(integer("123456789abcdef", 16), order());
+    EXPECT_EQ(pedersen_commit(v, r), curve.generator() * v.value() + h * r.value());
+    // additively homomorphic
+    const Scalar v2(integer(234), order()), r2(integer(99), order());
+    EXPECT_EQ(pedersen_commit(v, r) + pedersen_commit(v2, r2), pedersen_commit(v + v2, r + r2));
+    EXPECT_THROW(pedersen_commit(Scalar(integer(1), Curve::p256().scalar_field()), r), std::runtime_error);
+}
+
+TEST(BulletproofsTest, ProveAndVerify) {
+    uint8_t seed[ChaCha20Rng::SEED_SIZE] = {1};
+    ChaCha20Rng rng(seed);
+    for (std::size_t bits : {1, 8, 32, 64}) {
+        const Bulletproofs bp(bits, 2);
+        EXPECT_EQ(bp.bits(), bits);
+        EXPECT_EQ(bp.g().size(), bits);
+        const uint64_t top = bits == 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+        for (uint64_t value : {uint64_t(0), uint64_t(1), top, top / 3}) {
+            const Scalar blinding = rng.random_scalar(order());
+            const Point v = pedersen_commit(Scalar(integer(value), order()), blinding);
+            const RangeProof proof = bp.prove(value, blinding, rng);
+            EXPECT_EQ(1u << proof.L.size(), bits);
+            EXPECT_TRUE(bp.verify(v, proof)) << bits << " " << value;
+            // another commitment, or a proof changed anywhere, fails
+            EXPECT_FALSE(bp.verify(v + pedersen_h(), proof));
+            RangeProof bad = proof;
+            bad.t_hat += Scalar(integer(1), order());
+            EXPECT_FALSE(bp.verify(v, bad));
+            bad = proof;
+            bad.a += Scalar(integer(1), order());
+            EXPECT_FALSE(bp.verify(v, bad));
+            bad = proof;
+            bad.A = bad.A + pedersen_h();
+            EXPECT_FALSE(bp.verify(v, bad));
+            if (!proof.L.empty()) {
+                bad = proof;
+                bad.L.pop_back();
+                EXPECT_FALSE(bp.verify(v, bad));
+            }
+        }
+        if (bits < 64) {
+            EXPECT_THROW(bp.prove(top + 1, Scalar(order()), rng), std::invalid_argument);
+        }
+    }
+}
+
+TEST(BulletproofsTest, OutOfRangeValueFails) {
+    // a proof for a 16-bit value does not verify against 8 bits' generators,
+    // nor does one for value 300 forced through 8 bits
+    uint8_t seed[ChaCha20Rng::SEED_SIZE] = {2};
+    ChaCha20Rng rng(seed);
+    const Bulletproofs bp8(8), bp16(16);
+    const Scalar blinding = rng.random_scalar(order());
+    const Point v = pedersen_commit(Scalar(integer(300), order()), blinding);
+    EXPECT_TRUE(bp16.verify(v, bp16.prove(300, blinding, rng)));
+    EXPECT_FALSE(bp8.verify(v, bp16.prove(300, blinding, rng)));
+    EXPECT_FALSE(bp8.verify(v, bp8.prove(300 & 0xff, blinding, rng)));
+}
+
+TEST(BulletproofsTest, BatchVerification) {
+    uint8_t seed[ChaCha20Rng::SEED_SIZE] = {3};
+    ChaCha20Rng rng(seed);
+    const Bulletproofs bp(32);
+    std::vector<Point> commitments;
+    std::vector<RangeProof> proofs;
+    for (uint64_t i = 0; i < 6; i++) {
+        const uint64_t value = i * 123456789 % (uint64_t(1) << 32);
+        const Scalar blinding = rng.random_scalar(order());
+        commitments.push_back(pedersen_commit(Scalar(integer(value), order()), blinding));
+        proofs.push_back(bp.prove(value, blinding, rng));
+    }
+    EXPECT_TRUE(bp.verify_batch(commitments, proofs));
+    EXPECT_TRUE(bp.verify_batch(commitments, proofs, 3));
+    EXPECT_TRUE(bp.verify_batch({}, {}));
+    std::swap(commitments[1], commitments[2]);
+    EXPECT_FALSE(bp.verify_batch(commitments, proofs));
+    std::swap(commitments[1], commitments[2]);
+    proofs[4].tau_x += Scalar(integer(1), order());
+    EXPECT_FALSE(bp.verify_batch(commitments, proofs));
+    EXPECT_THROW(bp.verify_batch(commitments, {proofs[0]}), std::invalid_argument);
+}
+
+TEST(BulletproofsTest, Errors) {
+    for (std::size_t bits : {0, 3, 48, 128}) {
+        EXPECT_THROW(Bulletproofs{bits}, std::invalid_argument) << bits;
+    }
+}
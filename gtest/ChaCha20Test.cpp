@@ -0,0 +1,110 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "chacha20.h"
+#include "FieldVector.h"
+#include "test_hex.h"
+
+TEST(ChaCha20Test, Rfc8439BlockFunction) {
+    // RFC 8439 2.3.2: counter 1, nonce 00:00:00:09:00:00:00:4a:00:00:00:00, whose
+    // first word is the high half of the 64-bit counter here
+    uint32_t key[8];
+    for (uint32_t i = 0; i < 8; i++) {
+        key[i] = (4 * i) | ((4 * i + 1) << 8) | ((4 * i + 2) << 16) | ((4 * i + 3) << 24);
+    }
+    const uint32_t nonce[2] = {0x4a000000, 0};
+    uint8_t out[64];
+    chacha20_blocks(out, key, 1 | (uint64_t(0x09000000) << 32), nonce, 1, nullptr);
+    EXPECT_EQ(hex(out, 64), "10f1e7e4d13b5915500fdd1fa32071c4c7d1f4c733c068030422aa9ac3d46c4e"
+                            "d2826446079faa0914c2d705d98b02a2b5129cd1de164eb9cbd083e8a2503c4e");
+}
+
+TEST(ChaCha20Test, KernelsMatchPortable) {
+    const ChaCha20Kernel* kernel = avx2_chacha20_kernel();
+    if (!kernel) {
+        GTEST_SKIP() << "no AVX2";
+    }
+    const uint32_t key[8] = {1, 2, 3, 4, 5, 6, 7, 0xffffffff};
+    const uint32_t nonce[2] = {9, 10};
+    // 19 blocks: two passes of the kernel and three portable ones, across a
+    // carry into the counter's high word
+    const uint64_t counter = 0xfffffff8;
+    std::vector<uint8_t> portable(64 * 19), wide(64 * 19);
+    chacha20_blocks(portable.data(), key, counter, nonce, 19, nullptr);
+    chacha20_blocks(wide.data(), key, counter, nonce, 19, kernel);
+    EXPECT_EQ(portable, wide);
+}
+
+TEST(ChaCha20Test, SeededStreamIsReproducible) {
+    uint8_t seed[ChaCha20Rng::SEED_SIZE] = {7};
+    ChaCha20Rng a(seed), b(seed);
+    // the same bytes whatever the pieces they are asked for in
+    std::vector<uint8_t> whole(3000), pieces(3000);
+    a.fill(whole.data(), whole.size());
+    for (std::size_t i = 0; i < pieces.size(); i += 37) {
+        b.fill(pieces.data() + i, std::min<std::size_t>(37, pieces.size() - i));
+    }
+    EXPECT_EQ(whole, pieces);
+    EXPECT_EQ(a.next(), b.next());
+
+    ChaCha20Rng os, other;
+    EXPECT_NE(os.next(), other.next());
+    EXPECT_NE(&ChaCha20Rng::local(), nullptr);
+}
+
+TEST(ChaCha20Test, RandomBelowIsInRangeAndCoversIt) {
+    uint8_t seed[ChaCha20Rng::SEED_SIZE] = {1, 2, 3};
+    ChaCha20Rng rng(seed);
+    EXPECT_THROW(rng.random_below(integer(0)), std::domain_error);
+    EXPECT_EQ(rng.random_below(integer(1)), 0);
+
+    // every residue of a small bound shows up, at about the same rate
+    std::vector<int> seen(10, 0);
+    for (int i = 0; i < 10000; i++) {
+        const integer v = rng.random_below(integer(10));
+        ASSERT_TRUE(v >= 0 && v < 10);
+        seen[static_cast<uint64_t>(v)]++;
+    }
+    for (int count : seen) {
+        EXPECT_GT(count, 850);
+        EXPECT_LT(count, 1150);
+    }
+
+    // bounds just past a power of two (half the draws rejected) and of several digits
+    for (const integer& n : {(integer(1) << 64) + 1, (integer(1) << 255) + 19, (integer(1) << 1000) - 5}) {
+        bool high = false;
+        for (int i = 0; i < 64; i++) {
+            const integer v = rng.random_below(n);
+            ASSERT_TRUE(v >= 0 && v < n);
+            high |= v.bit_length() == n.bit_length() - 1;
+        }
+        EXPECT_TRUE(high) << n;
+    }
+
+    const PrimeField& field = PrimeField::get((integer(1) << 127) - 1);
+    EXPECT_EQ(&rng.random_element(field).prime_field(), &field);
+    EXPECT_LT(rng.random_scalar(field).value(), field.prime());
+}
+
+TEST(ChaCha20Test, RandomFieldVector) {
+    uint8_t seed[ChaCha20Rng::SEED_SIZE] = {4};
+    ChaCha20Rng rng(seed);
+    for (const integer& p : {integer(1000003), (integer(1) << 127) - 1, (integer(1) << 255) - 19}) {
+        const PrimeField& field = PrimeField::get(p);
+        const FieldVector v = FieldVector::random(field, 500, rng);
+        ASSERT_EQ(v.size(), 500u);
+        std::size_t high = 0;
+        for (const FieldElement& e : v.elements()) {
+            ASSERT_LT(e.value(), p);
+            high += e.value() >= (p >> 1);
+        }
+        // about half in the top half of the range
+        EXPECT_GT(high, 200u) << p;
+        EXPECT_LT(high, 300u) << p;
+    }
+}
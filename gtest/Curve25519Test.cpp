@@ -0,0 +1,121 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "curve25519.h"
+#include "Curve25519Field51.h"
+#include "FieldElement.h"
+#include "PrimeField.h"
+#include "test_hex.h"
+
+static std::string x25519_hex(const std::string& scalar, const std::string& u) {
+    uint8_t k[32], v[32], out[32];
+    unhex(k, scalar);
+    unhex(v, u);
+    EXPECT_TRUE(x25519(out, k, v) == Status::ok);
+    uint8_t portable[32];
+    EXPECT_TRUE(x25519_portable(portable, k, v) == Status::ok);
+    EXPECT_EQ(hex(portable, 32), hex(out, 32));
+    return hex(out, 32);
+}
+
+// RFC 7748, section 5.2
+TEST(Curve25519Test, Rfc7748Vectors) {
+    EXPECT_EQ(x25519_hex("a546e36bf0527c9d3b16154b82465edd62144c0ac1fc5a18506a2244ba449ac4",
+                         "e6db6867583030db3594c1a424b15f7c726624ec26b3353b10a903a6d0ab1c4c"),
+              "c3da55379de9c6908e94ea4df28d084f32eccf03491c71f754b4075577a28552");
+    // the top bit of this u is set and ignored
+    EXPECT_EQ(x25519_hex("4b66e9d4d1b4673c5ad22691957d6af5c11b6421e0ea01d42ca4169e7918ba0d",
+                         "e5210f12786811d3f4b7959d0538ae2c31dbe7106fc03c3efc4cd549c715a493"),
+              "95cbde9476e8907d7aade45cb4b873f88b595a68799fa152e6f8f7647aac7957");
+
+    // the first iterations of k, u = X25519(k, u), k
+    uint8_t k[32] = {9}, u[32] = {9}, r[32];
+    for (int i = 0; i < 1000; i++) {
+        x25519(r, k, u);
+        std::copy(k, k + 32, u);
+        std::copy(r, r + 32, k);
+        if (i == 0) {
+            EXPECT_EQ(hex(k, 32), "422c8e7a6227d7bca1350b3e2bb7279f7897b87bb6854b783c60e80311ae3079");
+        }
+    }
+    EXPECT_EQ(hex(k, 32), "684cf59ba83309552800ef566f2f4d3c1c3887c49360e3875f2eb94d99532c51");
+}
+
+// RFC 7748, section 6.1
+TEST(Curve25519Test, DiffieHellman) {
+    uint8_t alice[32], bob[32], alice_public[32], bob_public[32], shared_a[32], shared_b[32];
+    unhex(alice, "77076d0a7318a57d3c16c17251b26645df4c2f87ebc0992ab177fba51db92c2a");
+    unhex(bob, "5dab087e624a8a4b79e17f8b83800ee66f3bb1292618b6fd1c2f8b27ff88e0eb");
+    ASSERT_TRUE(x25519_base(alice_public, alice) == Status::ok);
+    ASSERT_TRUE(x25519_base(bob_public, bob) == Status::ok);
+    EXPECT_EQ(hex(alice_public, 32), "8520f0098930a754748b7ddcb43ef75a0dbf3a0d26381af4eba4a98eaa9b4e6a");
+    EXPECT_EQ(hex(bob_public, 32), "de9edb7d7b7dc1b4d35b61c2ece435373f8343c85b78674dadfc7e146f882b4f");
+
+    ASSERT_TRUE(x25519(shared_a, alice, bob_public) == Status::ok);
+    ASSERT_TRUE(x25519(shared_b, bob, alice_public) == Status::ok);
+    EXPECT_EQ(hex(shared_a, 32), "4a5d9d5ba4ce2de1728e3bf480350f25e07e21c947d19e3376f09b3c1e161742");
+    EXPECT_EQ(hex(shared_b, 32), hex(shared_a, 32));
+}
+
+TEST(Curve25519Test, SmallOrderPointsGiveZero) {
+    uint8_t k[32], out[32];
+    unhex(k, "77076d0a7318a57d3c16c17251b26645df4c2f87ebc0992ab177fba51db92c2a");
+    // u = 0 has order 2 and u = 1 order 4, and a clamped scalar is a multiple of 8
+    for (uint8_t small : {0, 1}) {
+        uint8_t u[32] = {small};
+        EXPECT_TRUE(x25519(out, k, u) == Status::infinity);
+        EXPECT_EQ(hex(out, 32), std::string(64, '0'));
+        EXPECT_TRUE(x25519_portable(out, k, u) == Status::infinity);
+    }
+}
+
+TEST(Curve25519Test, ReductionAndField51MatchFieldElement) {
+    const PrimeField& field = PrimeField::get(CURVE25519_FIELD_P.to_integer());
+    EXPECT_EQ(field.fold(), &curve25519_reduce_p);
+    const integer p = field.prime();
+
+    std::mt19937_64 rng(25519);
+    auto random_bytes = [&rng](uint8_t* out) {
+        for (std::size_t i = 0; i < 32; i++) {
+            out[i] = static_cast<uint8_t>(rng());
+        }
+    };
+    for (int i = 0; i < 200; i++) {
+        uint512 wide;
+        for (std::size_t j = 0; j < 8; j++) {
+            wide.limb[j] = i == 0 ? ~limb_t(0) : rng();
+        }
+        EXPECT_EQ(curve25519_reduce_p(wide).to_integer(), wide.to_integer() % p);
+
+#if defined(__SIZEOF_INT128__)
+        uint8_t a_bytes[32], b_bytes[32];
+        random_bytes(a_bytes);
+        random_bytes(b_bytes);
+        const Curve25519Field51 a = Curve25519Field51::from_bytes(a_bytes);
+        const Curve25519Field51 b = Curve25519Field51::from_bytes(b_bytes);
+        const FieldElement fa(a.value(), field), fb(b.value(), field);
+        EXPECT_EQ((a * b).value(), (fa * fb).value());
+        EXPECT_EQ((a - b).square().value(), ((fa - fb) * (fa - fb)).value());
+        EXPECT_EQ(((a + b) * (a - b)).value(), ((fa + fb) * (fa - fb)).value());
+        EXPECT_EQ(a.mul_small(121665).value(), (fa * FieldElement(121665, field)).value());
+        EXPECT_EQ(a * a.inverse(), Curve25519Field51(1));
+#endif
+    }
+
+#if defined(__SIZEOF_INT128__)
+    // p and 2^255 - 1 decode to 0 and 18, whose encodings are canonical
+    uint8_t bytes[32];
+    for (std::size_t i = 0; i < 32; i++) {
+        bytes[i] = static_cast<uint8_t>(CURVE25519_FIELD_P.limb[i / 8] >> (8 * (i % 8)));
+    }
+    EXPECT_EQ(Curve25519Field51::from_bytes(bytes).value(), integer(0));
+    std::fill(bytes, bytes + 32, 0xFF);
+    EXPECT_EQ(Curve25519Field51::from_bytes(bytes).value(), integer(18));
+    EXPECT_EQ(Curve25519Field51(0).inverse(), Curve25519Field51(0));
+#endif
+}
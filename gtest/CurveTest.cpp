@@ -0,0 +1,103 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <stdexcept>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "Curve.h"
+
+// the compiled-in parameters against the published hex values and the group law
+TEST(CurveTest, StandardParameters) {
+    const Curve& k1 = Curve::secp256k1();
+    EXPECT_EQ(k1.p(), integer("fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f", 16));
+    EXPECT_EQ(k1.generator().x().value(), integer("79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798", 16));
+    EXPECT_TRUE(k1.reduction() == Curve::backend::secp256k1);
+    EXPECT_TRUE(k1.field().addition_chain() == PrimeField::chain::secp256k1);
+
+    const Curve& r1 = Curve::p256();
+    EXPECT_EQ(r1.n(), integer("ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551", 16));
+    EXPECT_TRUE(r1.field().addition_chain() == PrimeField::chain::p256);
+
+    const Curve& p384 = Curve::p384();
+    EXPECT_EQ(p384.p(), (integer(1) << 384) - (integer(1) << 128) - (integer(1) << 96) + (integer(1) << 32) - 1);
+    EXPECT_EQ(p384.field().bits(), 384u);
+
+    for (const Curve* curve : {&k1, &r1, &p384}) {
+        EXPECT_TRUE(curve->generator().is_normalized());
+        EXPECT_TRUE(curve->generator().mul(curve->n()).is_infinity()) << curve->name();
+        EXPECT_EQ(curve->cofactor(), integer(1));
+        EXPECT_EQ(&curve->a().prime_field(), &curve->field());
+    }
+
+    // looked up twice, the same object
+    EXPECT_EQ(&Curve::secp256k1(), &k1);
+    EXPECT_EQ(Curve::find("P-256"), &r1);
+    EXPECT_EQ(Curve::find("prime256v1"), &r1);
+    EXPECT_EQ(Curve::find("secp384r1"), &p384);
+    EXPECT_EQ(Curve::find("secp256k1"), &k1);
+    EXPECT_EQ(Curve::find("P-521"), nullptr);
+
+    EXPECT_EQ(Curve::of(r1.generator().dbl()), &r1);
+    const FieldElement a(2, 97), b(3, 97);
+    EXPECT_EQ(Curve::of(Point(FieldElement(3, 97), FieldElement(6, 97), a, b)), nullptr);
+}
+
+TEST(CurveTest, EndomorphismAndGeneratorTable) {
+    const Curve& k1 = Curve::secp256k1();
+    ASSERT_TRUE(k1.has_endomorphism());
+    const Point g = k1.generator();
+    const Point lg = g.mul(k1.lambda());
+    EXPECT_EQ(lg.x(), g.x() * FieldElement(k1.beta(), k1.field()));
+    EXPECT_EQ(lg.y(), g.y());
+    EXPECT_FALSE(Curve::p256().has_endomorphism());
+    EXPECT_THROW(Curve::p384().beta(), std::domain_error);
+
+    const integer k("b7e151628aed2a6abf7158809cf4f3c762e7160f38b4da56a784d9045190cfef", 16);
+    for (const Curve* curve : {&k1, &Curve::p256(), &Curve::p384()}) {
+        const Point& base = curve->generator();
+        EXPECT_EQ(curve->mul_base(k), base.mul(k)) << curve->name();
+        EXPECT_EQ(curve->mul_base(-k), -base.mul(k)) << curve->name();
+        EXPECT_EQ(curve->mul_base(curve->n() + 5), base.mul(5)) << curve->name();
+        EXPECT_TRUE(curve->mul_base(curve->n()).is_infinity());
+        EXPECT_EQ(&curve->generator_table(), &curve->generator_table());
+    }
+}
+
+TEST(CurveTest, BaseRange) {
+    for (const Curve* curve : {&Curve::secp256k1(), &Curve::p256()}) {
+        // across a chunk boundary, and across n, where the range passes infinity
+        const integer start("31415926535897932384626433832795028841971693993751", 10);
+        const std::vector<Point> keys = curve->mul_base_range(start, 515);
+        ASSERT_EQ(keys.size(), 515u);
+        for (std::size_t i : {0, 1, 511, 512, 514}) {
+            EXPECT_EQ(keys[i], curve->mul_base(start + integer(i))) << i;
+            EXPECT_TRUE(keys[i].is_normalized()) << i;
+        }
+        const std::vector<Point> wrap = curve->mul_base_range(curve->n() - 2, 4);
+        EXPECT_EQ(wrap[0], -curve->generator().mul(2));
+        EXPECT_TRUE(wrap[2].is_infinity());
+        EXPECT_EQ(wrap[3], curve->generator());
+        EXPECT_TRUE(curve->mul_base_range(start, 0).empty());
+    }
+}
+
+// mul_base and mul_base_ct answer while the warm-up runs, by whichever path
+// is ready, and the tables are there once it has finished
+TEST(CurveTest, Warmup) {
+    const Curve& curve = Curve::p384();
+    curve.warmup(WorkStealingPool::shared());
+    curve.warmup(WorkStealingPool::shared());
+    const integer k("27182818284590452353602874713526624977572470936999", 10);
+    const Point expected = curve.generator().mul(k);
+    EXPECT_EQ(curve.mul_base(k), expected);
+    EXPECT_EQ(curve.mul_base_ct(k), expected);
+    curve.generator_table();
+    curve.generator_wnaf();
+    EXPECT_TRUE(curve.tables_ready());
+    EXPECT_EQ(curve.mul_base(k), expected);
+    EXPECT_EQ(curve.mul_base_ct(k), expected);
+    EXPECT_TRUE(curve.mul_base_ct(0).is_infinity());
+    EXPECT_THROW(curve.mul_base_ct(curve.n()), std::invalid_argument);
+    EXPECT_THROW(curve.mul_base_ct(-1), std::invalid_argument);
+}
@@ -0,0 +1,93 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include "daemon.h"
+#include "ecdsa.h"
+#include "gtest/gtest.h"
+#include "schnorr.h"
+#include "sec1.h"
+
+static std::string channel_name(const char* test) {
+    return "ecc-test-" + std::to_string(getpid()) + "-" + test;
+}
+
+// more messages than slots, through a ring between two threads in order
+TEST(DaemonTest, RingKeepsOrderWhenFull) {
+    std::vector<uint64_t> memory(ShmRing::bytes(8) / 8 + 1);
+    ShmRing producer(memory.data(), 8, true), consumer(memory.data(), 8, false);
+    EXPECT_THROW(ShmRing(memory.data(), 6, false), std::invalid_argument);
+    EXPECT_TRUE(consumer.empty());
+
+    const uint64_t count = 10000;
+    std::thread writer([&]() {
+        ShmMessage m = {};
+        for (uint64_t i = 0; i < count; i++) {
+            m.id = i;
+            while (!producer.try_push(m)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    ShmMessage m;
+    for (uint64_t i = 0; i < count; i++) {
+        while (!consumer.try_pop(m)) {
+            consumer.wait(std::chrono::milliseconds(10));
+        }
+        ASSERT_EQ(m.id, i);
+    }
+    writer.join();
+    EXPECT_FALSE(consumer.wait(std::chrono::microseconds(100)));
+}
+
+TEST(DaemonTest, ServesVerifyAndSign) {
+    const std::string name = channel_name("serve");
+    ShmServer server(name, 2, 16);
+    ShmClient first(name, 2), second(name, 2);
+    EXPECT_THROW(ShmClient(name, 2), std::runtime_error);
+
+    // BIP340 signatures made by the daemon verify here and there
+    const uint8_t secret[32] = {7, 1, 2, 3};
+    const uint8_t message[11] = {'s', 'h', 'a', 'r', 'e', 'd', ' ', 'm', 'e', 'm', '!'};
+    uint8_t key[32], expected[64];
+    schnorr_public_key(key, secret);
+    schnorr_sign(expected, message, sizeof(message), secret, nullptr);
+    const Result<ShmClient::Signature> made = first.sign(BulkScheme::schnorr, secret, message, sizeof(message));
+    ASSERT_TRUE(made.ok());
+    EXPECT_TRUE(std::equal(made->begin(), made->end(), expected));
+    EXPECT_TRUE(second.verify(BulkScheme::schnorr, key, made->data(), message, sizeof(message)) == Status::ok);
+    ShmClient::Signature bad = *made;
+    bad[3] ^= 1;
+    EXPECT_TRUE(second.verify(BulkScheme::schnorr, key, bad.data(), message, sizeof(message)) ==
+                schnorr_verify(bad.data(), message, sizeof(message), key));
+
+    // ECDSA on P-256, the answers those of the library's own calls
+    const Curve& curve = Curve::p256();
+    const uint8_t hash[32] = {0xab, 0xcd};
+    uint8_t compressed[33];
+    ASSERT_TRUE(sec1_encode(curve.generator() * integer(5), true, compressed, 33).ok());
+    const uint8_t five[32] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                              0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5};
+    const Result<ShmClient::Signature> signed_hash = first.sign(BulkScheme::ecdsa_p256, five, hash, 32);
+    ASSERT_TRUE(signed_hash.ok());
+    EXPECT_TRUE(first.verify(BulkScheme::ecdsa_p256, compressed, signed_hash->data(), hash, 32) == Status::ok);
+    EXPECT_TRUE(first.verify(BulkScheme::ecdsa_secp256k1, compressed, signed_hash->data(), hash, 32) != Status::ok);
+    const uint8_t zero[32] = {};
+    EXPECT_TRUE(first.sign(BulkScheme::ecdsa_p256, zero, hash, 32).status() == Status::out_of_range);
+
+    const std::vector<uint8_t> long_message(300);
+    EXPECT_TRUE(first.verify(BulkScheme::schnorr, key, expected, long_message.data(), long_message.size()) ==
+                Status::buffer_too_small);
+    EXPECT_EQ(server.served(), 7u);
+}
+
+TEST(DaemonTest, ClientNeedsADaemon) {
+    EXPECT_THROW(ShmClient(channel_name("missing")), std::runtime_error);
+}
@@ -0,0 +1,64 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "decompress.h"
+
+// appends the compressed encoding of p
+static void compress(const Point& p, std::size_t size, std::vector<uint8_t>& out) {
+    const std::size_t at = out.size();
+    out.resize(at + size);
+    out[at] = p.y().value()[0] ? 3 : 2;
+    p.x().value().to_bytes(out.data() + at + 1, size - 1);
+}
+
+TEST(DecompressTest, RecoversPointsAndFlagsBadKeys) {
+    for (const Curve* curve : {&Curve::secp256k1(), &Curve::p256(), &Curve::p384()}) {
+        const std::size_t size = compressed_key_size(*curve);
+        std::vector<Point> points;
+        std::vector<uint8_t> data;
+        Point q = curve->generator();
+        for (std::size_t i = 0; i < 70; i++) {
+            points.push_back(q);
+            compress(q, size, data);
+            q = q.dbl() + curve->generator();
+        }
+
+        // a bad prefix, an x of p, the wrong parity and an x off the curve
+        data[5 * size] = 4;
+        data[9 * size] = 0;
+        uint8_t* x = &data[20 * size];
+        x[0] = 2;
+        curve->p().to_bytes(x + 1, size - 1);
+        data[33 * size] ^= 1;
+        integer v = 1;
+        for (;; v++) {
+            const FieldElement fv(v, curve->field());
+            if (!(fv.square() * fv + curve->a() * fv + curve->b()).is_square()) {
+                break;
+            }
+        }
+        data[64 * size] = 2;
+        v.to_bytes(&data[64 * size + 1], size - 1);
+
+        const DecompressedKeys keys = decompress_keys(data.data(), points.size(), *curve);
+        ASSERT_EQ(keys.points.size(), points.size());
+        EXPECT_EQ(keys.invalid_count(), 4u) << curve->name();
+        for (std::size_t i = 0; i < points.size(); i++) {
+            if (i == 5 || i == 9 || i == 20 || i == 64) {
+                EXPECT_FALSE(keys.valid(i)) << curve->name() << " " << i;
+                EXPECT_TRUE(keys.points[i].is_infinity());
+            } else if (i == 33) {
+                EXPECT_TRUE(keys.valid(i));
+                EXPECT_EQ(keys.points[i], -points[i]) << curve->name();
+            } else {
+                EXPECT_TRUE(keys.valid(i)) << curve->name() << " " << i;
+                EXPECT_EQ(keys.points[i], points[i]) << curve->name() << " " << i;
+            }
+        }
+    }
+    EXPECT_TRUE(decompress_keys(nullptr, 0).points.empty());
+}
@@ -0,0 +1,84 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "der.h"
+#include "ecdsa.h"
+#include "gtest/gtest.h"
+#include "test_hex.h"
+
+// short integers, one with its top bit set and so a zero in front, and the
+// longest form
+TEST(DerTest, EncodesMinimalIntegers) {
+    uint8_t signature[64] = {0}, out[DER_MAX_SIZE], back[64];
+    signature[31] = 0x01;
+    signature[63] = 0x80;
+    ASSERT_EQ(*der_encode(signature, out, sizeof(out)), 9u);
+    EXPECT_EQ(hex(out, 9), "300702010102020080");
+    ASSERT_TRUE(der_decode(back, out, 9) == Status::ok);
+    EXPECT_EQ(hex(back, 64), hex(signature, 64));
+
+    for (uint8_t& byte : signature) {
+        byte = 0xFF;
+    }
+    ASSERT_EQ(*der_encode(signature, out, sizeof(out)), DER_MAX_SIZE);
+    EXPECT_EQ(hex(out, 6), "3046022100ff");
+    ASSERT_TRUE(der_decode(back, out, DER_MAX_SIZE) == Status::ok);
+    EXPECT_EQ(hex(back, 64), hex(signature, 64));
+    EXPECT_TRUE(der_encode(signature, out, DER_MAX_SIZE - 1).status() == Status::buffer_too_small);
+}
+
+// each rule of BIP66 broken once
+TEST(DerTest, RejectsWhatBip66Rejects) {
+    uint8_t signature[64];
+    for (const char* bad : {
+            "30050201010201",               // too short
+            "3107020101020180",             // not a SEQUENCE
+            "300802010102020080",           // SEQUENCE length off
+            "300703010102020080",           // r not an INTEGER
+            "300702010103020080",           // s not an INTEGER
+            "300702020102020080",           // r runs into s
+            "300702010102030080",           // s runs past the end
+            "30080201010202008000",         // a byte left over
+            "300702018102020080",           // r negative
+            "3006020101020180",             // s negative
+            "30080202000102020080",         // r padded with a zero it does not need
+            "300702000203010080",           // r empty
+    }) {
+        const std::vector<uint8_t> in = unhex(bad);
+        EXPECT_TRUE(der_decode(signature, in.data(), in.size()) == Status::bad_encoding) << bad;
+    }
+    // 33 bytes is only for a zero ahead of a top bit, 34 never
+    std::vector<uint8_t> in = unhex("3026022101" + std::string(64, '1') + "020101");
+    EXPECT_TRUE(der_decode(signature, in.data(), in.size()) == Status::bad_encoding);
+    in = unhex("302702220000" + std::string(64, 'f') + "020101");
+    EXPECT_TRUE(der_decode(signature, in.data(), in.size()) == Status::bad_encoding);
+}
+
+// a signature of ecdsa_sign through the encoding and back, to Scalars that
+// are then checked against the order
+TEST(DerTest, RoundTripsEcdsaSignatures) {
+    const Curve& curve = Curve::secp256k1();
+    uint8_t secret[32] = {0}, hash[32] = {0}, signature[64], out[DER_MAX_SIZE];
+    secret[31] = 7;
+    for (uint8_t i = 0; i < 16; i++) {
+        for (uint8_t& byte : hash) {
+            byte = static_cast<uint8_t>(byte * 31 + i);
+        }
+        ASSERT_TRUE(ecdsa_sign(signature, curve, secret, hash, sizeof(hash)) == Status::ok);
+        const std::size_t size = *der_encode(signature, out, sizeof(out));
+        const auto rs = der_decode(out, size, curve.scalar_field());
+        ASSERT_TRUE(rs.ok());
+        uint8_t back[DER_MAX_SIZE];
+        ASSERT_EQ(*der_encode(rs->first, rs->second, back, sizeof(back)), size);
+        EXPECT_EQ(hex(back, size), hex(out, size));
+    }
+
+    uint8_t zero[64] = {0};
+    zero[63] = 1;
+    const std::size_t size = *der_encode(zero, out, sizeof(out));
+    EXPECT_TRUE(der_decode(out, size, curve.scalar_field()).status() == Status::out_of_range);
+}
@@ -0,0 +1,99 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+#include "dlog.h"
+#include "primality.h"
+
+namespace {
+
+// y^2 = x^3 + 1 over p = 6q - 1, supersingular with p + 1 = 6q points
+struct Supersingular {
+    integer p, q;
+    Point g;     // of order 6q
+};
+
+Supersingular supersingular(const integer& start) {
+    integer q = next_prime(start);
+    while (!is_probable_prime(6 * q - 1)) {
+        q = next_prime(q + 1);
+    }
+    const integer p = 6 * q - 1;
+    const FieldElement a(0, p), b(1, p);
+    // x = cbrt(y^2 - 1), cubing being a bijection for p = 2 mod 3
+    for (integer y = 2;; y += 1) {
+        const FieldElement fy(y, p);
+        const FieldElement x = (fy.square() - b).power((2 * p - 1) / 3);
+        const Point g(x, fy, a, b);
+        if (!(g * (3 * q)).is_infinity() && !(g * (2 * q)).is_infinity() && !(g * 6).is_infinity()) {
+            return {p, q, g};
+        }
+    }
+}
+
+}
+
+TEST(DlogTest, Factor) {
+    EXPECT_EQ(factor(1).size(), 0u);
+    const std::map<integer, std::size_t> small{{2, 3}, {3, 1}, {97, 2}};
+    EXPECT_EQ(factor(8 * 3 * 97 * 97), small);
+    // two primes past trial division, and a square of one
+    const integer p = next_prime(integer(1) << 31), q = next_prime(integer(1) << 40);
+    const std::map<integer, std::size_t> large{{5, 1}, {p, 2}, {q, 1}};
+    EXPECT_EQ(factor(5 * p * p * q), large);
+    EXPECT_THROW(factor(0), std::invalid_argument);
+}
+
+TEST(DlogTest, SmallCurve) {
+    // y^2 = x^3 + 2x + 3 over GF(97): 100 points, (3, 6) of order 5
+    const FieldElement a(2, 97), b(3, 97);
+    const Point g(FieldElement(3, 97), FieldElement(6, 97), a, b);
+    ASSERT_TRUE((g * 5).is_infinity());
+    for (int x = 0; x < 5; x++) {
+        const Point h = g * x;
+        EXPECT_EQ(*dlog_bsgs(g, h, 5), integer(x));
+        EXPECT_EQ(*dlog_rho(g, h, 5), integer(x));
+        EXPECT_EQ(*dlog(g, h, 5), integer(x));
+    }
+    // not a multiple of g
+    const Point other(FieldElement(0, 97), FieldElement(10, 97), a, b);
+    EXPECT_TRUE(dlog_bsgs(g, other, 5).status() == Status::out_of_range);
+    EXPECT_TRUE(dlog(g, other, 5).status() == Status::out_of_range);
+    EXPECT_THROW(dlog(g, g, 7), std::invalid_argument);
+    EXPECT_THROW(dlog_bsgs(g, g, 0), std::invalid_argument);
+}
+
+TEST(DlogTest, BabyStepGiantStep) {
+    const Supersingular c = supersingular(integer(1) << 30);
+    const Point g = c.g * 6;
+    for (const integer& x : {integer(0), integer(1), c.q - 1, c.q / 3, integer("123456789", 10) % c.q}) {
+        DlogStats stats;
+        EXPECT_EQ(*dlog_bsgs(g, g * x, c.q, &stats), x);
+        EXPECT_LE(stats.additions, 4 * static_cast<uint64_t>(isqrt(c.q)) + 4);
+    }
+}
+
+TEST(DlogTest, PollardRho) {
+    const Supersingular c = supersingular(integer(1) << 28);
+    const Point g = c.g * 6;
+    const integer x = integer("987654321", 10) % c.q;
+    for (unsigned threads : {1u, 4u}) {
+        DlogStats stats;
+        EXPECT_EQ(*dlog_rho(g, g * x, c.q, threads, threads, &stats), x) << threads;
+        EXPECT_GT(stats.distinguished, 0u);
+    }
+    EXPECT_EQ(*dlog_rho(g, Point(g.curve_a(), g.curve_b()), c.q), integer(0));
+    EXPECT_TRUE(dlog_rho(g, g, 6 * c.q).status() == Status::bad_modulus);
+    // a point of order 6q is not in the subgroup
+    EXPECT_TRUE(dlog_rho(g, c.g, c.q).status() == Status::out_of_range);
+}
+
+TEST(DlogTest, PohligHellman) {
+    const Supersingular c = supersingular(integer(1) << 20);
+    const integer n = 6 * c.q;
+    for (const integer& x : {integer(0), integer(5), n - 1, integer("31415926", 10) % n}) {
+        EXPECT_EQ(*dlog(c.g, c.g * x, n, 2), x);
+    }
+}
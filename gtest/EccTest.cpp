@@ -0,0 +1,182 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Curve.h"
+#include "ecc.h"
+#include "FieldElement.h"
+#include "gtest/gtest.h"
+#include "msm.h"
+#include "sec1.h"
+#include "sha256.h"
+#include "tagged_hash.h"
+
+// secret i + 1 as 32 big-endian bytes
+static void secret_bytes(std::size_t i, uint8_t* out) {
+    std::memset(out, 0, 32);
+    out[30] = static_cast<uint8_t>((i + 1) >> 8);
+    out[31] = static_cast<uint8_t>(i + 1);
+}
+
+TEST(EccTest, SignsAndVerifiesBatches) {
+    EXPECT_EQ(ecc_abi_version(), ECC_ABI_VERSION);
+    EXPECT_EQ(std::string(ecc_status_name(ECC_BAD_SIGNATURE)), "bad_signature");
+
+    const std::size_t count = 20;
+    for (int scheme : {ECC_ECDSA_SECP256K1, ECC_ECDSA_P256, ECC_SCHNORR}) {
+        const Curve& curve = scheme == ECC_ECDSA_P256 ? Curve::p256() : Curve::secp256k1();
+        const std::size_t key_size = scheme == ECC_SCHNORR ? 32 : 33;
+        std::vector<uint8_t> secrets(count * 32), messages(count * 32, 0x42), keys(count * key_size);
+        std::vector<uint8_t> signatures(count * 64);
+        std::vector<int32_t> results(count);
+        for (std::size_t i = 0; i < count; i++) {
+            secret_bytes(i, &secrets[i * 32]);
+            messages[i * 32] = static_cast<uint8_t>(i);
+            const Point q = curve.generator() * integer(static_cast<int>(i + 1));
+            if (scheme == ECC_SCHNORR) {
+                q.affine().first.to_bytes(&keys[i * 32], 32);
+            } else {
+                ASSERT_TRUE(sec1_encode(q, true, &keys[i * 33], 33).ok());
+            }
+        }
+        ASSERT_EQ(ecc_sign_batch(scheme, count, secrets.data(), messages.data(), 32, nullptr, signatures.data(),
+                                 results.data(), 2), ECC_OK);
+        EXPECT_EQ(ecc_verify_batch(scheme, count, keys.data(), messages.data(), 32, signatures.data(), nullptr, 0),
+                  ECC_OK);
+
+        signatures[7 * 64 + 40] ^= 1;
+        EXPECT_NE(ecc_verify_batch(scheme, count, keys.data(), messages.data(), 32, signatures.data(), nullptr, 1),
+                  ECC_OK);
+        EXPECT_EQ(ecc_verify_batch(scheme, count, keys.data(), messages.data(), 32, signatures.data(),
+                                   results.data(), 3), ECC_BAD_SIGNATURE);
+        for (std::size_t i = 0; i < count; i++) {
+            EXPECT_EQ(results[i], i == 7 ? ECC_BAD_SIGNATURE : ECC_OK) << scheme << " " << i;
+        }
+    }
+
+    // a zero secret fails alone, its signature zeroed
+    std::vector<uint8_t> secrets(64, 0), message(64, 1), signatures(128, 0xff);
+    secrets[63] = 1;
+    int32_t results[2];
+    EXPECT_EQ(ecc_sign_batch(ECC_ECDSA_SECP256K1, 2, secrets.data(), message.data(), 32, nullptr, signatures.data(),
+                             results, 1), ECC_OUT_OF_RANGE);
+    EXPECT_EQ(results[0], ECC_OUT_OF_RANGE);
+    EXPECT_EQ(results[1], ECC_OK);
+    EXPECT_EQ(std::vector<uint8_t>(signatures.begin(), signatures.begin() + 64), std::vector<uint8_t>(64, 0));
+    EXPECT_EQ(ecc_verify_batch(9, 1, message.data(), message.data(), 32, message.data(), nullptr, 1),
+              ECC_OUT_OF_RANGE);
+}
+
+TEST(EccTest, MsmMatchesTheLibrary) {
+    const Curve& curve = Curve::p256();
+    const std::size_t count = 40;
+    std::vector<uint8_t> scalars(count * 32), points(count * 33);
+    std::vector<integer> k;
+    std::vector<Point> p;
+    for (std::size_t i = 0; i < count; i++) {
+        secret_bytes(i * 977 + 3, &scalars[i * 32]);
+        scalars[i * 32] = static_cast<uint8_t>(i);
+        k.push_back(integer::from_bytes(&scalars[i * 32], 32));
+        p.push_back(curve.generator() * integer(static_cast<int>(i + 2)));
+        ASSERT_TRUE(sec1_encode(p.back(), true, &points[i * 33], 33).ok());
+    }
+    uint8_t out[33], expected[33];
+    ASSERT_EQ(ecc_msm(ECC_P256, count, scalars.data(), points.data(), out, 2), ECC_OK);
+    ASSERT_TRUE(sec1_encode(multi_scalar_mul(k, p), true, expected, 33).ok());
+    EXPECT_EQ(std::memcmp(out, expected, 33), 0);
+
+    EXPECT_EQ(ecc_msm(ECC_P256, 0, nullptr, nullptr, out, 1), ECC_INFINITY);
+    points[5 * 33] = 0x07;
+    EXPECT_EQ(ecc_msm(ECC_P256, count, scalars.data(), points.data(), out, 1), ECC_BAD_ENCODING);
+    EXPECT_EQ(ecc_msm(3, count, scalars.data(), points.data(), out, 1), ECC_OUT_OF_RANGE);
+}
+
+TEST(EccTest, FieldBatchMul) {
+    const PrimeField& field = Curve::secp256k1().field();
+    const std::size_t count = 100;
+    std::vector<FieldElement> x, y;
+    for (std::size_t i = 0; i < count; i++) {
+        x.push_back(FieldElement(integer(static_cast<int>(3 * i + 1)), field) / FieldElement(integer(7), field));
+        y.push_back(FieldElement(integer(static_cast<int>(i + 11)), field));
+    }
+    std::vector<uint8_t> a(count * 32), b(count * 32), out(count * 32), expected(count * 32);
+    ASSERT_TRUE(FieldElement::serialize(x, a.data(), a.size()) == Status::ok);
+    ASSERT_TRUE(FieldElement::serialize(y, b.data(), b.size()) == Status::ok);
+    for (std::size_t i = 0; i < count; i++) {
+        x[i] *= y[i];
+    }
+    ASSERT_TRUE(FieldElement::serialize(x, expected.data(), expected.size()) == Status::ok);
+    EXPECT_EQ(ecc_field_batch_mul(ECC_SECP256K1, count, a.data(), b.data(), out.data(), 3), ECC_OK);
+    EXPECT_EQ(out, expected);
+    // in place
+    EXPECT_EQ(ecc_field_batch_mul(ECC_SECP256K1, count, a.data(), b.data(), a.data(), 0), ECC_OK);
+    EXPECT_EQ(a, expected);
+
+    std::fill(b.begin() + 32, b.begin() + 64, 0xff);
+    std::fill(out.begin(), out.end(), 0);
+    EXPECT_EQ(ecc_field_batch_mul(ECC_SECP256K1, count, a.data(), b.data(), out.data(), 1), ECC_OUT_OF_RANGE);
+    EXPECT_EQ(out, std::vector<uint8_t>(count * 32, 0));
+}
+
+TEST(EccTest, FieldBatchAddSubInverse) {
+    const PrimeField& field = Curve::p256().field();
+    const std::size_t count = 70;
+    std::vector<FieldElement> x, y;
+    for (std::size_t i = 0; i < count; i++) {
+        x.push_back(FieldElement(integer(static_cast<int>(5 * i + 2)), field) / FieldElement(integer(3), field));
+        y.push_back(FieldElement(integer(0), field) - FieldElement(integer(static_cast<int>(i + 1)), field));
+    }
+    std::vector<uint8_t> a(count * 32), b(count * 32), out(count * 32), expected(count * 32);
+    ASSERT_TRUE(FieldElement::serialize(x, a.data(), a.size()) == Status::ok);
+    ASSERT_TRUE(FieldElement::serialize(y, b.data(), b.size()) == Status::ok);
+
+    std::vector<FieldElement> sum, difference, inverse;
+    for (std::size_t i = 0; i < count; i++) {
+        sum.push_back(x[i] + y[i]);
+        difference.push_back(x[i] - y[i]);
+        inverse.push_back(FieldElement(integer(1), field) / x[i]);
+    }
+    ASSERT_TRUE(FieldElement::serialize(sum, expected.data(), expected.size()) == Status::ok);
+    EXPECT_EQ(ecc_field_batch_add(ECC_P256, count, a.data(), b.data(), out.data()), ECC_OK);
+    EXPECT_EQ(out, expected);
+    ASSERT_TRUE(FieldElement::serialize(difference, expected.data(), expected.size()) == Status::ok);
+    EXPECT_EQ(ecc_field_batch_sub(ECC_P256, count, a.data(), b.data(), out.data()), ECC_OK);
+    EXPECT_EQ(out, expected);
+    ASSERT_TRUE(FieldElement::serialize(inverse, expected.data(), expected.size()) == Status::ok);
+    EXPECT_EQ(ecc_field_batch_inverse(ECC_P256, count, a.data(), out.data()), ECC_OK);
+    EXPECT_EQ(out, expected);
+
+    // a zero has no inverse, and nothing is written
+    std::fill(a.begin() + 64, a.begin() + 96, 0);
+    std::fill(out.begin(), out.end(), 0);
+    EXPECT_EQ(ecc_field_batch_inverse(ECC_P256, count, a.data(), out.data()), ECC_NOT_INVERTIBLE);
+    EXPECT_EQ(out, std::vector<uint8_t>(count * 32, 0));
+    EXPECT_EQ(ecc_field_batch_add(3, count, a.data(), b.data(), out.data()), ECC_OUT_OF_RANGE);
+}
+
+TEST(EccTest, HashBatches) {
+    const std::size_t count = 37, len = 80;
+    std::vector<uint8_t> in(count * len), out(count * 32);
+    for (std::size_t i = 0; i < in.size(); i++) {
+        in[i] = static_cast<uint8_t>(i * 7);
+    }
+    const std::string tag = "ecc/test";
+    ASSERT_EQ(ecc_sha256_batch(count, in.data(), len, out.data()), ECC_OK);
+    for (std::size_t i = 0; i < count; i++) {
+        uint8_t digest[32];
+        Sha256::hash(&in[i * len], len, digest);
+        EXPECT_EQ(std::vector<uint8_t>(digest, digest + 32), std::vector<uint8_t>(&out[32 * i], &out[32 * (i + 1)]));
+    }
+    ASSERT_EQ(ecc_tagged_hash_batch(reinterpret_cast<const uint8_t*>(tag.data()), tag.size(), count, in.data(), len,
+                                    out.data()), ECC_OK);
+    for (std::size_t i = 0; i < count; i++) {
+        uint8_t digest[32];
+        TaggedHash::hash(Sha256Tag(tag), &in[i * len], len, digest);
+        EXPECT_EQ(std::vector<uint8_t>(digest, digest + 32), std::vector<uint8_t>(&out[32 * i], &out[32 * (i + 1)]));
+    }
+    EXPECT_EQ(ecc_sha256_batch(count, nullptr, len, out.data()), ECC_OUT_OF_RANGE);
+}
@@ -0,0 +1,74 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ecdh.h"
+#include "sec1.h"
+
+// a secret of curve's order bytes from i and the SEC 1 encoding of its key
+static std::vector<uint8_t> secret_of(const Curve& curve, uint8_t i) {
+    std::vector<uint8_t> out(ecdh_secret_size(curve), 0);
+    out[0] = 0x21;
+    out[out.size() - 1] = i;
+    out[out.size() / 2] = static_cast<uint8_t>(i * 97);
+    return out;
+}
+
+static std::vector<uint8_t> key_of(const Curve& curve, const std::vector<uint8_t>& secret, bool compressed) {
+    const Point q = curve.generator() * integer::from_bytes(secret.data(), secret.size());
+    std::vector<uint8_t> out(1 + 2 * ecdh_shared_size(curve));
+    out.resize(*sec1_encode(q, compressed, out.data(), out.size()));
+    return out;
+}
+
+TEST(EcdhTest, BothSidesAgree) {
+    for (const Curve* curve : {&Curve::secp256k1(), &Curve::p256(), &Curve::p384()}) {
+        const std::vector<uint8_t> a = secret_of(*curve, 1), b = secret_of(*curve, 2);
+        const std::size_t size = ecdh_shared_size(*curve);
+        std::vector<uint8_t> ab(size), ba(size), expected(size);
+        ASSERT_TRUE(ecdh(ab.data(), *curve, a.data(), key_of(*curve, b, true).data(), 1 + size) == Status::ok);
+        ASSERT_TRUE(ecdh(ba.data(), *curve, b.data(), key_of(*curve, a, false).data(), 1 + 2 * size) == Status::ok);
+        EXPECT_EQ(ab, ba);
+        const Point s = curve->generator() * (integer::from_bytes(a.data(), a.size())
+                                              * integer::from_bytes(b.data(), b.size()));
+        s.x().to_bytes(expected.data(), size);
+        EXPECT_EQ(ab, expected);
+    }
+}
+
+TEST(EcdhTest, BatchMatchesSingle) {
+    for (const Curve* curve : {&Curve::secp256k1(), &Curve::p256(), &Curve::p384()}) {
+        const std::size_t n = 12, size = ecdh_shared_size(*curve);
+        std::vector<std::vector<uint8_t>> secrets, keys;
+        for (uint8_t i = 0; i < n; i++) {
+            secrets.push_back(secret_of(*curve, i + 3));
+            keys.push_back(key_of(*curve, secret_of(*curve, i + 40), i % 2 == 0));
+        }
+        secrets[3].assign(secrets[3].size(), 0);
+        curve->n().to_bytes(secrets[4].data(), secrets[4].size());
+        keys[5][0] = 0x05;
+        keys[6].back() ^= 1;        // compressed: an x that may have no y; uncompressed: off the curve
+        keys[7][1] ^= 0x40;
+        std::vector<EcdhJob> jobs;
+        for (std::size_t i = 0; i < n; i++) {
+            jobs.push_back(EcdhJob{secrets[i].data(), keys[i].data(), keys[i].size()});
+        }
+
+        std::vector<uint8_t> shared(n * size, 0xEE);
+        const std::vector<Status> results = ecdh_batch(shared.data(), *curve, jobs);
+        ASSERT_EQ(results.size(), n);
+        for (std::size_t i = 0; i < n; i++) {
+            std::vector<uint8_t> single(size);
+            EXPECT_TRUE(results[i] == ecdh(single.data(), *curve, jobs[i].secret, jobs[i].public_key, jobs[i].length)) << i;
+            if (results[i] == Status::ok) {
+                EXPECT_EQ(std::vector<uint8_t>(shared.begin() + i * size, shared.begin() + (i + 1) * size), single) << i;
+            }
+        }
+        EXPECT_TRUE(results[3] == Status::out_of_range);
+        EXPECT_TRUE(results[4] == Status::out_of_range);
+        EXPECT_TRUE(results[5] == Status::bad_encoding);
+        EXPECT_TRUE(results[0] == Status::ok);
+    }
+}
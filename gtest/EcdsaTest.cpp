@@ -0,0 +1,241 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ecdsa.h"
+#include "sha256.h"
+#include "test_hex.h"
+
+static Point affine_point(const Curve& curve, const char* x, const char* y) {
+    return Point(FieldElement(integer(x, 16), curve.field()), FieldElement(integer(y, 16), curve.field()),
+                 curve.a(), curve.b());
+}
+
+// RFC 6979, appendix A.2.5: P-256, SHA-512, message "sample"
+TEST(EcdsaTest, Rfc6979Vector) {
+    const Curve& curve = Curve::p256();
+    const std::vector<uint8_t> secret = unhex("c9afa9d845ba75166b5c215767b1d6934e50c3db36e89b127b8a622b120f6721");
+    const Point q = affine_point(curve, "60fed4ba255a9d31c961eb74c6356d68c049b8923b61fa6ce669622e60f29fb6",
+                                 "7903fe1008b8bc99a41ae9e95628bc64f2f1b20c2d7e9f5177a3c294d4462299");
+    EXPECT_TRUE(*ecdsa_public_key(curve, secret.data()) == q);
+
+    const std::string message = "sample";
+    uint8_t hash[32], signature[64];
+    Sha256::hash(reinterpret_cast<const uint8_t*>(message.data()), message.size(), hash);
+    EXPECT_TRUE(ecdsa_sign(signature, curve, secret.data(), hash, 32) == Status::ok);
+    EXPECT_EQ(hex(signature, 64), "efd48b2aacb6a8fd1140dd9cd45e81d69d2c877b56aaf991c34d0ea84eaf3716"
+                                  "f7cb1c942d657c41d436c7a1b6e29f65f3e900dbb9aff4064dc4ab2f843acda8");
+    EXPECT_TRUE(ecdsa_verify(signature, curve, q, hash, 32) == Status::ok);
+
+    // a signer keeps its key's midstates across messages
+    const EcdsaSigner signer(curve, secret.data());
+    for (int i = 0; i < 2; i++) {
+        uint8_t again[64];
+        EXPECT_TRUE(signer.sign(again, hash, 32) == Status::ok);
+        EXPECT_EQ(hex(again, 64), hex(signature, 64));
+    }
+    const std::vector<uint8_t> zero(32, 0);
+    EXPECT_TRUE(EcdsaSigner::make(curve, zero.data()).status() == Status::out_of_range);
+    EXPECT_THROW(EcdsaSigner(curve, zero.data()), std::invalid_argument);
+
+    hash[0] ^= 1;
+    EXPECT_TRUE(ecdsa_verify(signature, curve, q, hash, 32) == Status::bad_signature);
+}
+
+// a signature OpenSSL made over secp256k1 for SHA-256("abc")
+TEST(EcdsaTest, VerifiesForeignSignature) {
+    const Curve& curve = Curve::secp256k1();
+    const Point q = affine_point(curve, "f2b831fe2bc6a7643e7dbe71929b0a46b5c99b7a80d05190dcd010f9c50014da",
+                                 "e9dc595c3f85f465f7aa0b0c178b22ef7933de9b673c5d1829a6aa50e0f42dbc");
+    const std::vector<uint8_t> hash = unhex("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    std::vector<uint8_t> signature = unhex("8cc9ea6ba0caaa0f92f5732de6f645db6c4b4e4e3102d3ce5c4f01548c68cded"
+                                           "c90d9579a8d981e7a625cc96d51a6a1caa8deb9e8811833d53aff2c0f49c6b8d");
+    EXPECT_TRUE(ecdsa_verify(signature.data(), curve, q, hash.data(), hash.size()) == Status::ok);
+    EXPECT_TRUE(ecdsa_verify(signature.data(), curve, curve.generator(), hash.data(), hash.size())
+                == Status::bad_signature);
+    EXPECT_TRUE(ecdsa_verify(signature.data(), Curve::p256(), q, hash.data(), hash.size()) == Status::not_on_curve);
+    EXPECT_TRUE(ecdsa_verify(signature.data(), curve, curve.infinity(), hash.data(), hash.size()) == Status::infinity);
+
+    // s = 0 and r = n are not signatures
+    std::fill(signature.begin() + 32, signature.end(), 0);
+    EXPECT_TRUE(ecdsa_verify(signature.data(), curve, q, hash.data(), hash.size()) == Status::bad_encoding);
+    curve.n().to_bytes(signature.data(), 32);
+    EXPECT_TRUE(ecdsa_verify(signature.data(), curve, q, hash.data(), hash.size()) == Status::bad_encoding);
+}
+
+TEST(EcdsaTest, SignAndVerify) {
+    for (const Curve* curve : {&Curve::secp256k1(), &Curve::p256()}) {
+        for (uint8_t i = 1; i <= 8; i++) {
+            uint8_t secret[32] = {0}, hash[32], signature[64];
+            secret[31] = i;
+            secret[3] = static_cast<uint8_t>(i * 37);
+            for (std::size_t j = 0; j < 32; j++) {
+                hash[j] = static_cast<uint8_t>(i * j + 1);
+            }
+            const Result<Point> q = ecdsa_public_key(*curve, secret);
+            ASSERT_TRUE(q.ok());
+            EXPECT_TRUE(ecdsa_sign(signature, *curve, secret, hash, 32) == Status::ok);
+            EXPECT_TRUE(ecdsa_verify(signature, *curve, *q, hash, 32) == Status::ok);
+            // a short hash is taken as it is, a long one cut to 256 bits
+            EXPECT_TRUE(ecdsa_verify(signature, *curve, *q, hash, 31) == Status::bad_signature);
+            uint8_t long_hash[40] = {0};
+            std::copy(hash, hash + 32, long_hash);
+            EXPECT_TRUE(ecdsa_verify(signature, *curve, *q, long_hash, 40) == Status::ok);
+        }
+        uint8_t zero[32] = {0}, signature[64];
+        EXPECT_TRUE(ecdsa_sign(signature, *curve, zero, zero, 32) == Status::out_of_range);
+        EXPECT_TRUE(ecdsa_public_key(*curve, zero).status() == Status::out_of_range);
+    }
+    uint8_t secret[32] = {1}, signature[64];
+    EXPECT_TRUE(ecdsa_sign(signature, Curve::p384(), secret, secret, 32) == Status::out_of_range);
+}
+
+TEST(EcdsaTest, BatchVerify) {
+    const Curve& curve = Curve::secp256k1();
+    const std::size_t n = 70;
+    std::vector<std::vector<uint8_t>> hashes(n, std::vector<uint8_t>(32)), signatures(n, std::vector<uint8_t>(64));
+    std::vector<Point> keys;
+    for (std::size_t i = 0; i < n; i++) {
+        uint8_t secret[32] = {0};
+        secret[31] = static_cast<uint8_t>(i + 1);
+        secret[0] = 0x5A;
+        hashes[i][i % 32] = static_cast<uint8_t>(i);
+        keys.push_back(*ecdsa_public_key(curve, secret));
+        ecdsa_sign(signatures[i].data(), curve, secret, hashes[i].data(), 32);
+    }
+    signatures[5][40] ^= 1;
+    signatures[33][0] = 0xFF;
+    // an s of zero and one of n: 1 / s is taken over the batch, and these fail alone
+    std::fill(signatures[12].begin() + 32, signatures[12].end(), 0);
+    curve.n().to_bytes(signatures[20].data() + 32, 32);
+    std::vector<EcdsaJob> jobs;
+    for (std::size_t i = 0; i < n; i++) {
+        jobs.push_back(EcdsaJob{signatures[i].data(), hashes[i].data(), 32, &keys[(i == 60) ? 61 : i]});
+    }
+
+    for (unsigned threads : {1u, 3u}) {
+        const std::vector<Status> results = ecdsa_verify_batch(curve, jobs, threads);
+        ASSERT_EQ(results.size(), n);
+        for (std::size_t i = 0; i < n; i++) {
+            EXPECT_TRUE(results[i] == ecdsa_verify(jobs[i].signature, curve, *jobs[i].public_key, jobs[i].hash, 32)) << i;
+            EXPECT_EQ(results[i] == Status::ok, i != 5 && i != 12 && i != 20 && i != 33 && i != 60) << i;
+        }
+    }
+    EXPECT_TRUE(ecdsa_verify_batch(curve, {}).empty());
+}
+
+// the batched first candidates of RFC 6979 against one Drbg a message
+TEST(EcdsaTest, Rfc6979FirstCandidates) {
+    std::vector<Rfc6979> keys;
+    std::vector<const Rfc6979*> pointers;
+    std::vector<uint8_t> h1(32 * 21);
+    for (std::size_t i = 0; i < 21; i++) {
+        uint8_t x[32] = {0};
+        x[0] = static_cast<uint8_t>(i + 1);
+        keys.emplace_back(x, 32);
+        h1[32 * i + i] = static_cast<uint8_t>(i * 7 + 1);
+    }
+    for (std::size_t i = 0; i < 21; i++) {
+        pointers.push_back(&keys[i % 5]);
+    }
+    for (const Sha256MultiBuffer* kernel : {static_cast<const Sha256MultiBuffer*>(nullptr),
+                                            avx2_sha256_multi_buffer(), sha256_multi_buffer()}) {
+        std::vector<uint8_t> out(32 * 21);
+        Rfc6979::first_candidates(out.data(), pointers.data(), h1.data(), 21, kernel);
+        for (std::size_t i = 0; i < 21; i++) {
+            Rfc6979::Drbg drbg = pointers[i]->drbg(h1.data() + 32 * i);
+            EXPECT_EQ(hex(out.data() + 32 * i, 32), hex(drbg.next(), 32)) << i;
+        }
+    }
+    const uint8_t x[32] = {1};
+    const Rfc6979 short_key(x, 31);
+    pointers[3] = &short_key;
+    std::vector<uint8_t> out(32 * 21);
+    EXPECT_THROW(Rfc6979::first_candidates(out.data(), pointers.data(), h1.data(), 21), std::invalid_argument);
+}
+
+// batch signatures against EcdsaSigner::sign, for several keys on both curves
+TEST(EcdsaTest, BatchSign) {
+    for (const Curve* curve : {&Curve::secp256k1(), &Curve::p256()}) {
+        const std::size_t n = 45;
+        std::vector<EcdsaSigner> signers;
+        for (uint8_t i = 1; i <= 4; i++) {
+            uint8_t secret[32] = {0};
+            secret[31] = i;
+            secret[5] = static_cast<uint8_t>(i * 91);
+            signers.emplace_back(*curve, secret);
+        }
+        const uint8_t other_secret[32] = {0, 7};
+        const EcdsaSigner other(curve == &Curve::p256() ? Curve::secp256k1() : Curve::p256(), other_secret);
+        std::vector<std::vector<uint8_t>> hashes(n, std::vector<uint8_t>(32)), signatures(n, std::vector<uint8_t>(64));
+        std::vector<EcdsaSignJob> jobs;
+        for (std::size_t i = 0; i < n; i++) {
+            hashes[i][i % 32] = static_cast<uint8_t>(i + 1);
+            jobs.push_back(EcdsaSignJob{signatures[i].data(), i == 17 ? &other : &signers[i % signers.size()],
+                                        hashes[i].data(), i == 9 ? 20u : 32u});
+        }
+        for (unsigned threads : {1u, 3u}) {
+            const std::vector<Status> results = ecdsa_sign_batch(*curve, jobs, threads);
+            ASSERT_EQ(results.size(), n);
+            for (std::size_t i = 0; i < n; i++) {
+                if (i == 17) {
+                    EXPECT_TRUE(results[i] == Status::not_on_curve);
+                    continue;
+                }
+                uint8_t expected[64];
+                ASSERT_TRUE(jobs[i].signer->sign(expected, jobs[i].hash, jobs[i].length) == Status::ok);
+                EXPECT_TRUE(results[i] == Status::ok) << i;
+                EXPECT_EQ(hex(signatures[i].data(), 64), hex(expected, 64)) << i;
+            }
+        }
+    }
+    EXPECT_TRUE(ecdsa_sign_batch(Curve::secp256k1(), {}).empty());
+}
+
+TEST(EcdsaTest, RecoverPublicKey) {
+    for (const Curve* curve : {&Curve::secp256k1(), &Curve::p256()}) {
+        const std::size_t n = 40;
+        std::vector<std::vector<uint8_t>> hashes(n, std::vector<uint8_t>(32)), signatures(n, std::vector<uint8_t>(64));
+        std::vector<Point> keys;
+        std::vector<EcdsaRecoveryJob> jobs;
+        for (std::size_t i = 0; i < n; i++) {
+            uint8_t secret[32] = {0};
+            secret[31] = static_cast<uint8_t>(i / 4 + 1);
+            secret[7] = 0x3C;
+            hashes[i][i / 4] = static_cast<uint8_t>(i / 4 + 9);
+            keys.push_back(*ecdsa_public_key(*curve, secret));
+            ecdsa_sign(signatures[i].data(), *curve, secret, hashes[i].data(), 32);
+            jobs.push_back(EcdsaRecoveryJob{signatures[i].data(), hashes[i].data(), 32, static_cast<int>(i % 4)});
+        }
+        signatures[9][33] ^= 1;
+        jobs[13].recid = 4;
+
+        const std::vector<Result<Point>> batch = ecdsa_recover_batch(*curve, jobs, 2);
+        ASSERT_EQ(batch.size(), n);
+        for (std::size_t i = 0; i < n; i++) {
+            const Result<Point> q = ecdsa_recover(jobs[i].signature, *curve, jobs[i].recid, jobs[i].hash, 32);
+            ASSERT_TRUE(q.status() == batch[i].status()) << i;
+            if (q) {
+                EXPECT_TRUE(*q == *batch[i]) << i;
+                EXPECT_TRUE(ecdsa_verify(jobs[i].signature, *curve, *q, jobs[i].hash, 32) == Status::ok) << i;
+            }
+        }
+        EXPECT_TRUE(batch[13].status() == Status::bad_encoding);
+        EXPECT_FALSE(batch[9] && *batch[9] == keys[9]);
+        // each four jobs share a signature: x = r + n is not below p for any of
+        // them, and one of the parities gives back the signing key
+        for (std::size_t i = 0; i < n; i += 4) {
+            if (i == 8 || i == 12) {
+                continue;
+            }
+            EXPECT_TRUE(batch[i + 2].status() == Status::bad_signature) << i;
+            EXPECT_NE(batch[i] && *batch[i] == keys[i], batch[i + 1] && *batch[i + 1] == keys[i]) << i;
+        }
+    }
+    EXPECT_TRUE(ecdsa_recover_batch(Curve::secp256k1(), {}).empty());
+}
@@ -0,0 +1,186 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ecvrf.h"
+#include "ed25519.h"
+#include "test_hex.h"
+
+namespace {
+
+const uint8_t* bytes(const std::string& text) {
+    return reinterpret_cast<const uint8_t*>(text.data());
+}
+
+// count keys of suite, each with a batch-compatible proof of its own message
+struct Proofs {
+    std::vector<uint8_t> keys, proofs;
+    std::vector<std::string> alphas;
+    std::vector<EcvrfProved> items;
+
+    Proofs(const Ecvrf& suite, std::size_t count)
+            : keys(Ecvrf::KEY_SIZE * count), proofs(Ecvrf::BATCH_PROOF_SIZE * count) {
+        for (std::size_t i = 0; i < count; i++) {
+            const uint8_t secret[32] = {static_cast<uint8_t>(i + 1), 0x5c};
+            alphas.push_back("epoch 7 slot " + std::to_string(i));
+            EXPECT_TRUE(suite.public_key(&keys[Ecvrf::KEY_SIZE * i], secret) == Status::ok);
+            EXPECT_TRUE(suite.prove_batchable(&proofs[Ecvrf::BATCH_PROOF_SIZE * i], secret, bytes(alphas[i]),
+                                              alphas[i].size()) == Status::ok);
+        }
+        for (std::size_t i = 0; i < count; i++) {
+            items.push_back({&keys[Ecvrf::KEY_SIZE * i], &proofs[Ecvrf::BATCH_PROOF_SIZE * i], bytes(alphas[i]),
+                             alphas[i].size()});
+        }
+    }
+};
+
+}
+
+// RFC 9381, appendix B.1, examples 10 and 11
+TEST(EcvrfTest, P256TaiVectors) {
+    const Ecvrf& suite = Ecvrf::p256_tai();
+    const std::vector<uint8_t> secret = unhex("c9afa9d845ba75166b5c215767b1d6934e50c3db36e89b127b8a622b120f6721");
+    uint8_t key[Ecvrf::KEY_SIZE];
+    ASSERT_TRUE(suite.public_key(key, secret.data()) == Status::ok);
+    EXPECT_EQ(hex(key, sizeof(key)), "0360fed4ba255a9d31c961eb74c6356d68c049b8923b61fa6ce669622e60f29fb6");
+    const struct {
+        std::string alpha, proof, beta;
+    } vectors[] = {
+            {"sample",
+             "035b5c726e8c0e2c488a107c600578ee75cb702343c153cb1eb8dec77f4b5071b4a53f0a46f018bc2c56e58d383f2305e0"
+             "975972c26feea0eb122fe7893c15af376b33edf7de17c6ea056d4d82de6bc02f",
+             "a3ad7b0ef73d8fc6655053ea22f9bede8c743f08bbed3d38821f0e16474b505e"},
+            {"test",
+             "034dac60aba508ba0c01aa9be80377ebd7562c4a52d74722e0abae7dc3080ddb56c19e067b15a8a8174905b1361780453"
+             "4214f935b94c2287f797e393eb0816969d864f37625b443f30f1a5a33f2b3c854",
+             "a284f94ceec2ff4b3794629da7cbafa49121972671b466cab4ce170aa365f26d"},
+    };
+    for (const auto& v : vectors) {
+        uint8_t proof[Ecvrf::PROOF_SIZE], beta[Ecvrf::HASH_SIZE];
+        ASSERT_TRUE(suite.prove(proof, secret.data(), bytes(v.alpha), v.alpha.size()) == Status::ok);
+        EXPECT_EQ(hex(proof, sizeof(proof)), v.proof);
+        ASSERT_TRUE(suite.verify(beta, key, proof, bytes(v.alpha), v.alpha.size()) == Status::ok);
+        EXPECT_EQ(hex(beta, sizeof(beta)), v.beta);
+        ASSERT_TRUE(suite.proof_to_hash(beta, proof) == Status::ok);
+        EXPECT_EQ(hex(beta, sizeof(beta)), v.beta);
+    }
+}
+
+TEST(EcvrfTest, ProveAndVerify) {
+    for (const Ecvrf* suite : {&Ecvrf::p256_tai(), &Ecvrf::p256_sswu(), &Ecvrf::secp256k1_sswu()}) {
+        const uint8_t secret[32] = {0x11, 0x22, 0x33};
+        const std::string alpha = "leader election";
+        uint8_t key[Ecvrf::KEY_SIZE], proof[Ecvrf::PROOF_SIZE], batchable[Ecvrf::BATCH_PROOF_SIZE];
+        uint8_t beta[Ecvrf::HASH_SIZE], beta_batch[Ecvrf::HASH_SIZE];
+        ASSERT_TRUE(suite->public_key(key, secret) == Status::ok);
+        ASSERT_TRUE(suite->prove(proof, secret, bytes(alpha), alpha.size()) == Status::ok);
+        ASSERT_TRUE(suite->verify(beta, key, proof, bytes(alpha), alpha.size()) == Status::ok);
+
+        // the same Gamma and s either way, so the same beta
+        ASSERT_TRUE(suite->prove_batchable(batchable, secret, bytes(alpha), alpha.size()) == Status::ok);
+        EXPECT_EQ(hex(batchable, 33), hex(proof, 33));
+        EXPECT_EQ(hex(batchable + 99, 32), hex(proof + 49, 32));
+        ASSERT_TRUE(suite->verify_batch(beta_batch, {{key, batchable, bytes(alpha), alpha.size()}}) == Status::ok);
+        EXPECT_EQ(hex(beta, sizeof(beta)), hex(beta_batch, sizeof(beta_batch)));
+
+        const std::string other = "leader electioN";
+        EXPECT_TRUE(suite->verify(beta, key, proof, bytes(other), other.size()) == Status::bad_signature);
+        proof[40] ^= 1;
+        EXPECT_TRUE(suite->verify(beta, key, proof, bytes(alpha), alpha.size()) == Status::bad_signature);
+        std::fill(proof + 49, proof + 81, 0xff);
+        EXPECT_TRUE(suite->verify(beta, key, proof, bytes(alpha), alpha.size()) == Status::bad_encoding);
+        key[0] = 0x04;
+        EXPECT_TRUE(suite->verify(beta, key, proof, bytes(alpha), alpha.size()) == Status::bad_encoding);
+        const uint8_t zero[32] = {0};
+        EXPECT_TRUE(suite->prove(proof, zero, bytes(alpha), alpha.size()) == Status::out_of_range);
+    }
+}
+
+TEST(EcvrfTest, VerifyBatch) {
+    for (const Ecvrf* suite : {&Ecvrf::p256_tai(), &Ecvrf::secp256k1_sswu()}) {
+        Proofs p(*suite, 40);
+        std::vector<uint8_t> betas(Ecvrf::HASH_SIZE * p.items.size());
+        ASSERT_TRUE(suite->verify_batch(betas.data(), p.items, 2) == Status::ok);
+        for (std::size_t i = 0; i < p.items.size(); i++) {
+            uint8_t beta[Ecvrf::HASH_SIZE];
+            ASSERT_TRUE(suite->proof_to_hash(beta, p.items[i].proof) == Status::ok);
+            EXPECT_EQ(hex(beta, sizeof(beta)), hex(&betas[Ecvrf::HASH_SIZE * i], Ecvrf::HASH_SIZE));
+        }
+        EXPECT_TRUE(suite->verify_batch(betas.data(), {}) == Status::ok);
+
+        // another message, two proofs swapped, an s out of range
+        p.items[7].alpha = bytes(p.alphas[8]);
+        EXPECT_TRUE(suite->verify_batch(betas.data(), p.items) == Status::bad_signature);
+        p.items[7].alpha = bytes(p.alphas[7]);
+        std::swap(p.items[3].proof, p.items[4].proof);
+        EXPECT_TRUE(suite->verify_batch(betas.data(), p.items) == Status::bad_signature);
+        std::swap(p.items[3].proof, p.items[4].proof);
+        std::fill(&p.proofs[Ecvrf::BATCH_PROOF_SIZE * 6 + 99], &p.proofs[Ecvrf::BATCH_PROOF_SIZE * 7], 0xff);
+        EXPECT_TRUE(suite->verify_batch(betas.data(), p.items) == Status::bad_encoding);
+    }
+}
+
+#if defined(__SIZEOF_INT128__)
+
+// RFC 9381, appendix B.3, example 16
+TEST(EcvrfTest, Edwards25519Vector) {
+    const std::vector<uint8_t> secret = unhex("9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60");
+    const std::vector<uint8_t> key = unhex("d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a");
+    uint8_t proof[ECVRF_ED25519_PROOF_SIZE], beta[ECVRF_ED25519_HASH_SIZE];
+    ASSERT_TRUE(ecvrf_ed25519_prove(proof, secret.data(), nullptr, 0) == Status::ok);
+    EXPECT_EQ(hex(proof, sizeof(proof)),
+              "8657106690b5526245a92b003bb079ccd1a92130477671f6fc01ad16f26f723f26f8a57ccaed74ee1b190bed1f479d97"
+              "27d2d0f9b005a6e456a35d4fb0daab1268a1b0db10836d9826a528ca76567805");
+    ASSERT_TRUE(ecvrf_ed25519_verify(beta, key.data(), proof, nullptr, 0) == Status::ok);
+    EXPECT_EQ(hex(beta, sizeof(beta)),
+              "90cf1df3b703cce59e2a35b925d411164068269d7b2d29f3301c03dd757876ff66b71dda49d2de59d03450451af02679"
+              "8e8f81cd2e333de5cdf4f3e140fdd8ae");
+    proof[70] ^= 1;
+    EXPECT_TRUE(ecvrf_ed25519_verify(beta, key.data(), proof, nullptr, 0) == Status::bad_signature);
+
+    // the identity is a key of small order
+    uint8_t identity[32] = {1};
+    EXPECT_TRUE(ecvrf_ed25519_verify(beta, identity, proof, nullptr, 0) == Status::infinity);
+}
+
+TEST(EcvrfTest, Edwards25519Batch) {
+    const std::size_t count = 24;
+    std::vector<uint8_t> keys(32 * count), proofs(ECVRF_ED25519_BATCH_PROOF_SIZE * count);
+    std::vector<uint8_t> betas(ECVRF_ED25519_HASH_SIZE * count);
+    std::vector<std::string> alphas;
+    std::vector<EcvrfProved> items;
+    for (std::size_t i = 0; i < count; i++) {
+        const uint8_t secret[32] = {static_cast<uint8_t>(i), 0xed};
+        alphas.push_back("round " + std::to_string(i));
+        ed25519_public_key(&keys[32 * i], secret);
+        ASSERT_TRUE(ecvrf_ed25519_prove_batchable(&proofs[ECVRF_ED25519_BATCH_PROOF_SIZE * i], secret,
+                                                  bytes(alphas[i]), alphas[i].size()) == Status::ok);
+
+        // the Gamma and s of the standard proof
+        uint8_t proof[ECVRF_ED25519_PROOF_SIZE], beta[ECVRF_ED25519_HASH_SIZE];
+        ASSERT_TRUE(ecvrf_ed25519_prove(proof, secret, bytes(alphas[i]), alphas[i].size()) == Status::ok);
+        ASSERT_TRUE(ecvrf_ed25519_verify(beta, &keys[32 * i], proof, bytes(alphas[i]), alphas[i].size())
+                    == Status::ok);
+        EXPECT_EQ(hex(proof, 32), hex(&proofs[ECVRF_ED25519_BATCH_PROOF_SIZE * i], 32));
+        EXPECT_EQ(hex(proof + 48, 32), hex(&proofs[ECVRF_ED25519_BATCH_PROOF_SIZE * i + 96], 32));
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        items.push_back({&keys[32 * i], &proofs[ECVRF_ED25519_BATCH_PROOF_SIZE * i], bytes(alphas[i]),
+                         alphas[i].size()});
+    }
+    ASSERT_TRUE(ecvrf_ed25519_verify_batch(betas.data(), items, 2) == Status::ok);
+    for (std::size_t i = 0; i < count; i++) {
+        uint8_t beta[ECVRF_ED25519_HASH_SIZE];
+        ASSERT_TRUE(ecvrf_ed25519_proof_to_hash(beta, items[i].proof) == Status::ok);
+        EXPECT_EQ(hex(beta, sizeof(beta)),
+                  hex(&betas[ECVRF_ED25519_HASH_SIZE * i], ECVRF_ED25519_HASH_SIZE));
+    }
+    items[5].alpha = bytes(alphas[6]);
+    EXPECT_TRUE(ecvrf_ed25519_verify_batch(betas.data(), items) == Status::bad_signature);
+}
+
+#endif
@@ -0,0 +1,144 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ed25519.h"
+#include "msm.h"
+#include "test_hex.h"
+
+#if defined(__SIZEOF_INT128__)
+
+static void scalar_bytes(uint8_t* out, uint64_t k) {
+    for (std::size_t i = 0; i < 32; i++) {
+        out[i] = i < 8 ? static_cast<uint8_t>(k >> (8 * i)) : 0;
+    }
+}
+
+// RFC 8032, section 7.1, tests 1 to 3
+TEST(Ed25519Test, Rfc8032Vectors) {
+    struct Vector {
+        const char* secret;
+        const char* public_key;
+        const char* message;
+        const char* signature;
+    };
+    const Vector vectors[] = {
+        {"9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60",
+         "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a", "",
+         "e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e065224901555fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b"},
+        {"4ccd089b28ff96da9db6c346ec114e0f5b8a319f35aba624da8cf6ed4fb8a6fb",
+         "3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c", "72",
+         "92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da085ac1e43e15996e458f3613d0f11d8c387b2eaeb4302aeeb00d291612bb0c00"},
+        {"c5aa8df43f9f837bedb7442f31dcb7b166d38535076f094b85ce3a2e0b4458f7",
+         "fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025", "af82",
+         "6291d657deec24024827e69c3abe01a30ce548a284743a445e3680d7db5ac3ac18ff9b538d16f290ae67f760984dc6594a7c15e9716ed28dc027beceea1ec40a"},
+    };
+    for (const Vector& v : vectors) {
+        const std::vector<uint8_t> secret = unhex(v.secret), message = unhex(v.message);
+        uint8_t public_key[32], signature[64];
+        ed25519_public_key(public_key, secret.data());
+        EXPECT_EQ(hex(public_key, 32), v.public_key);
+        ed25519_sign(signature, message.data(), message.size(), secret.data());
+        EXPECT_EQ(hex(signature, 64), v.signature);
+        EXPECT_TRUE(ed25519_verify(signature, message.data(), message.size(), public_key) == Status::ok);
+
+        // any flipped bit of message, R or S fails
+        const uint8_t other[1] = {0x01};
+        EXPECT_TRUE(ed25519_verify(signature, other, 1, public_key) != Status::ok);
+        for (std::size_t byte : {0, 40}) {
+            signature[byte] ^= 0x10;
+            EXPECT_TRUE(ed25519_verify(signature, message.data(), message.size(), public_key) != Status::ok);
+            signature[byte] ^= 0x10;
+        }
+    }
+}
+
+TEST(Ed25519Test, GroupLaw) {
+    const Ed25519Point& b = Ed25519Point::base();
+    uint8_t bytes[32];
+    b.to_bytes(bytes);
+    EXPECT_EQ(hex(bytes, 32), "5866666666666666666666666666666666666666666666666666666666666666");
+
+    // the order, the identity's encoding, negation and doubling
+    uint8_t order[32];
+    const uint256 l = uint256::from_integer(ed25519_order());
+    for (std::size_t i = 0; i < 32; i++) {
+        order[i] = static_cast<uint8_t>(l.limb[i / 8] >> (8 * (i % 8)));
+    }
+    EXPECT_TRUE(b.mul(order).is_identity());
+    EXPECT_TRUE(Ed25519Point::mul_base(order).is_identity());
+    EXPECT_TRUE((b - b).is_identity());
+    EXPECT_TRUE(b + b == b.dbl());
+    EXPECT_TRUE(b + Ed25519Point() == b);
+    Ed25519Point().to_bytes(bytes);
+    EXPECT_EQ(hex(bytes, 32), "01" + std::string(62, '0'));
+
+    // k * B three ways, and a round trip through the encoding
+    Ed25519Point sum;
+    uint8_t k[32];
+    for (uint64_t i = 1; i <= 40; i++) {
+        sum += b;
+        scalar_bytes(k, i);
+        EXPECT_TRUE(b.mul(k) == sum);
+        EXPECT_TRUE(Ed25519Point::mul_base(k) == sum);
+        sum.to_bytes(bytes);
+        EXPECT_TRUE(*Ed25519Point::from_bytes(bytes) == sum);
+    }
+}
+
+TEST(Ed25519Test, RejectsBadEncodings) {
+    // y = p is not canonical; y = 2 has no x
+    std::vector<uint8_t> bytes = unhex("edffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f");
+    EXPECT_TRUE(Ed25519Point::from_bytes(bytes.data()).status() == Status::bad_encoding);
+    bytes = unhex("0200000000000000000000000000000000000000000000000000000000000000");
+    EXPECT_TRUE(Ed25519Point::from_bytes(bytes.data()).status() == Status::not_on_curve);
+    // y = 1 with the sign bit: x = 0 cannot be negative
+    bytes = unhex("0100000000000000000000000000000000000000000000000000000000000080");
+    EXPECT_TRUE(Ed25519Point::from_bytes(bytes.data()).status() == Status::bad_encoding);
+
+    // S = S + L no longer verifies
+    uint8_t secret[32] = {7}, public_key[32], signature[64];
+    ed25519_public_key(public_key, secret);
+    ed25519_sign(signature, secret, 32, secret);
+    const uint256 l = uint256::from_integer(ed25519_order());
+    limb_t carry = 0;
+    for (std::size_t i = 0; i < 32; i++) {
+        const limb_t sum = signature[32 + i] + ((l.limb[i / 8] >> (8 * (i % 8))) & 0xFF) + carry;
+        signature[32 + i] = static_cast<uint8_t>(sum);
+        carry = sum >> 8;
+    }
+    EXPECT_TRUE(ed25519_verify(signature, secret, 32, public_key) == Status::bad_encoding);
+}
+
+TEST(Ed25519Test, BatchVerify) {
+    const std::size_t n = 80;
+    std::vector<std::vector<uint8_t>> keys(n, std::vector<uint8_t>(32)), signatures(n, std::vector<uint8_t>(64));
+    std::vector<std::vector<uint8_t>> messages(n);
+    std::vector<Ed25519Signed> items;
+    for (std::size_t i = 0; i < n; i++) {
+        uint8_t secret[32] = {static_cast<uint8_t>(i), 0x5A};
+        messages[i].assign(i % 5 * 17, static_cast<uint8_t>(i));
+        ed25519_public_key(keys[i].data(), secret);
+        ed25519_sign(signatures[i].data(), messages[i].data(), messages[i].size(), secret);
+        items.push_back(Ed25519Signed{signatures[i].data(), messages[i].data(), messages[i].size(), keys[i].data()});
+    }
+    EXPECT_TRUE(ed25519_verify_batch(items) == Status::ok);
+    EXPECT_TRUE(ed25519_verify_batch(items, 3) == Status::ok);
+    EXPECT_TRUE(ed25519_verify_batch(std::vector<Ed25519Signed>(items.begin(), items.begin() + 1)) == Status::ok);
+
+    // a swapped pair of public keys fails the batch, and each signature on its own
+    std::swap(items[10].public_key, items[11].public_key);
+    EXPECT_TRUE(ed25519_verify_batch(items) == Status::bad_signature);
+    EXPECT_TRUE(ed25519_verify(items[10].signature, items[10].message, items[10].length, items[10].public_key)
+                == Status::bad_signature);
+    std::swap(items[10].public_key, items[11].public_key);
+
+    signatures[3][0] ^= 1;
+    EXPECT_TRUE(ed25519_verify_batch(items) != Status::ok);
+}
+
+#endif
@@ -0,0 +1,122 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "elgamal.h"
+#include "gtest/gtest.h"
+#include "test_files.h"
+
+// the values of results, with UINT64_MAX for a failed one
+static std::vector<uint64_t> values(const std::vector<Result<uint64_t>>& results) {
+    std::vector<uint64_t> out;
+    for (const Result<uint64_t>& r : results) {
+        out.push_back(r.value_or(UINT64_MAX));
+    }
+    return out;
+}
+
+TEST(ElGamalTest, EncryptsAndDecrypts) {
+    const Curve& curve = Curve::secp256k1();
+    const integer secret = 0x1234567;
+    const ElGamalEncryptor encryptor(curve, curve.mul_base(secret));
+    const ElGamalCiphertext c = encryptor.encrypt(5, 77);
+    EXPECT_EQ(c.c1, curve.mul_base(77));
+    EXPECT_EQ(c.c2, curve.mul_base(5) + encryptor.key() * integer(77));
+    EXPECT_THROW(encryptor.encrypt(-1, 3), std::invalid_argument);
+    EXPECT_THROW(encryptor.encrypt(3, curve.n()), std::invalid_argument);
+    EXPECT_THROW(ElGamalEncryptor(curve, curve.infinity()), std::invalid_argument);
+    EXPECT_THROW(ElGamalEncryptor(curve, Curve::p256().generator()), std::invalid_argument);
+
+    const ElGamalDlogTable table(curve, 1000);
+    const std::vector<integer> plaintexts = {0, 1, 7, 500, 999, 1000, 123456};
+    const std::vector<ElGamalCiphertext> batch = encryptor.encrypt_batch(plaintexts);
+    for (const ElGamalCiphertext& e : batch) {
+        EXPECT_TRUE(e.c1.is_normalized());
+        EXPECT_TRUE(e.c2.is_normalized());
+    }
+    const std::vector<Result<uint64_t>> decrypted = elgamal_decrypt(table, secret, batch);
+    EXPECT_EQ(values(decrypted), (std::vector<uint64_t>{0, 1, 7, 500, 999, UINT64_MAX, UINT64_MAX}));
+    EXPECT_TRUE(decrypted[5].status() == Status::out_of_range);
+    EXPECT_EQ(values(elgamal_decrypt(table, secret + 1, {encryptor.encrypt(7)})), (std::vector<uint64_t>{UINT64_MAX}));
+}
+
+// one-hot ballots of four candidates, summed on three threads: the sums
+// decrypt to the counts, and adding ciphertexts adds their plaintexts
+TEST(ElGamalTest, TallyAddsBallots) {
+    const Curve& curve = Curve::secp256k1();
+    const integer secret = 987654321;
+    const ElGamalEncryptor encryptor(curve, curve.mul_base(secret));
+    std::vector<integer> votes;
+    std::vector<uint64_t> counts(4, 0);
+    for (std::size_t i = 0; i < 61; i++) {
+        const std::size_t choice = (i * i + 3) % 4 == 1 ? 1 : i % 3;
+        counts[choice]++;
+        for (std::size_t j = 0; j < 4; j++) {
+            votes.push_back(j == choice ? 1 : 0);
+        }
+    }
+    const std::vector<ElGamalCiphertext> ballots = encryptor.encrypt_batch(votes);
+    ThreadExecutor executor(3);
+    const std::vector<ElGamalCiphertext> tally = elgamal_tally(ballots, 4, executor);
+    ASSERT_EQ(tally.size(), 4u);
+    const ElGamalDlogTable table(curve, 100);
+    EXPECT_EQ(values(elgamal_decrypt(table, secret, tally)), counts);
+
+    const ElGamalCiphertext sum = elgamal_add(encryptor.encrypt(40), encryptor.encrypt(59));
+    EXPECT_EQ(values(elgamal_decrypt(table, secret, {sum})), (std::vector<uint64_t>{99}));
+
+    EXPECT_THROW(elgamal_tally(ballots, 5, executor), std::invalid_argument);
+    EXPECT_THROW(elgamal_tally({}, 4, executor), std::invalid_argument);
+}
+
+// few baby steps and many giant ones, on both sides of every stride, for a
+// curve without the compiled-in comb
+TEST(ElGamalTest, SolvesWithAnyBabySteps) {
+    const Curve& curve = Curve::p256();
+    EXPECT_THROW(ElGamalDlogTable(curve, 0), std::invalid_argument);
+    EXPECT_THROW(ElGamalDlogTable(curve, 10, ElGamalDlogTable::MAX_BABY_STEPS + 1), std::invalid_argument);
+    const ElGamalDlogTable table(curve, 5000, 8);
+    EXPECT_EQ(table.baby_steps(), 8u);
+    EXPECT_EQ(table.size(), 16u);
+    std::vector<uint64_t> expected;
+    std::vector<Point> points;
+    for (uint64_t x : {0u, 1u, 8u, 9u, 16u, 17u, 18u, 2000u, 4991u, 4999u}) {
+        expected.push_back(x);
+        points.push_back(curve.mul_base(x));
+    }
+    points.push_back(curve.mul_base(5000));
+    points.push_back(-curve.mul_base(3));
+    expected.push_back(UINT64_MAX);
+    expected.push_back(UINT64_MAX);
+    EXPECT_EQ(values(table.solve(points)), expected);
+    EXPECT_EQ(values(ElGamalDlogTable(curve, 3).solve({curve.mul_base(2), curve.mul_base(3)})),
+              (std::vector<uint64_t>{2, UINT64_MAX}));
+}
+
+TEST(ElGamalTest, TableSavesAndMaps) {
+    const std::string path = temp_path("elgamal_table.bin");
+    const Curve& curve = Curve::secp256k1();
+    const ElGamalDlogTable table(curve, 20000);
+    table.save(path);
+    const ElGamalDlogTable mapped = ElGamalDlogTable::load(path, curve);
+    EXPECT_EQ(mapped.bound(), 20000u);
+    EXPECT_EQ(mapped.baby_steps(), table.baby_steps());
+    EXPECT_EQ(values(mapped.solve({curve.mul_base(19999), curve.mul_base(12345), curve.mul_base(20000)})),
+              (std::vector<uint64_t>{19999, 12345, UINT64_MAX}));
+    EXPECT_THROW(ElGamalDlogTable::load(path, Curve::p256()), std::invalid_argument);
+
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(100);
+        file.put('\x5a');
+    }
+    EXPECT_THROW(ElGamalDlogTable::load(path, curve), std::runtime_error);
+    std::remove(path.c_str());
+    EXPECT_THROW(ElGamalDlogTable::load(path, curve), std::runtime_error);
+}
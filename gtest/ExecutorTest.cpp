@@ -0,0 +1,137 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Executor.h"
+#include "FieldElement.h"
+#include "decompress.h"
+#include "msm.h"
+#include "schnorr.h"
+
+// every index runs exactly once, for counts around the number of threads
+static void expect_each_once(Executor& executor) {
+    for (std::size_t count : {0, 1, 2, 3, 7, 64, 1000, 4099}) {
+        std::vector<std::atomic<int>> hits(count);
+        for (std::atomic<int>& hit : hits) {
+            hit = 0;
+        }
+        executor.run(count, [&](std::size_t i) { hits[i]++; });
+        for (std::size_t i = 0; i < count; i++) {
+            EXPECT_EQ(hits[i].load(), 1) << count << " " << i;
+        }
+    }
+}
+
+TEST(ExecutorTest, RunsEachTaskOnce) {
+    for (unsigned threads : {1, 2, 3, 8}) {
+        WorkStealingPool pool(threads);
+        EXPECT_EQ(pool.concurrency(), threads + 1);
+        expect_each_once(pool);
+        ThreadExecutor spawn(threads);
+        expect_each_once(spawn);
+    }
+    WorkStealingPool none(0);
+    EXPECT_GE(none.concurrency(), 1u);
+    expect_each_once(none);
+    expect_each_once(WorkStealingPool::shared());
+    // pinned to the first CPU, which every machine has
+    WorkStealingPool pinned(3, {0});
+    expect_each_once(pinned);
+
+    std::size_t calls = 0;
+    FunctionExecutor serial([&](std::size_t count, const std::function<void(std::size_t)>& task) {
+        calls++;
+        for (std::size_t i = 0; i < count; i++) {
+            task(i);
+        }
+    }, 0);
+    EXPECT_EQ(serial.concurrency(), 1u);
+    expect_each_once(serial);
+    EXPECT_EQ(calls, 8u);
+}
+
+// tasks calling run on the same pool, and several outside threads calling it at once
+TEST(ExecutorTest, NestedAndConcurrentCalls) {
+    WorkStealingPool pool(3);
+    std::atomic<std::size_t> sum(0);
+    pool.run(16, [&](std::size_t i) {
+        pool.run(50, [&](std::size_t j) { sum += i * 50 + j; });
+    });
+    EXPECT_EQ(sum.load(), 800u * 799 / 2);
+
+    std::vector<std::thread> callers;
+    std::vector<std::size_t> sums(4, 0);
+    for (std::size_t t = 0; t < sums.size(); t++) {
+        callers.emplace_back([&, t]() {
+            for (int round = 0; round < 20; round++) {
+                std::atomic<std::size_t> local(0);
+                pool.run(300, [&](std::size_t i) { local += i; });
+                sums[t] += local.load();
+            }
+        });
+    }
+    for (std::thread& caller : callers) {
+        caller.join();
+    }
+    for (std::size_t s : sums) {
+        EXPECT_EQ(s, 20u * 300 * 299 / 2);
+    }
+}
+
+// the batch APIs give the same answers on a pool as on the calling thread
+TEST(ExecutorTest, BatchApis) {
+    WorkStealingPool pool(3);
+    const Curve& curve = Curve::secp256k1();
+
+    std::vector<FieldElement> serial, parallel;
+    for (int i = 1; i <= 2000; i++) {
+        serial.emplace_back(integer(i) * 7919 + 3, curve.p());
+    }
+    parallel = serial;
+    FieldElement::batch_invert(serial);
+    FieldElement::batch_invert(parallel, pool);
+    EXPECT_EQ(serial, parallel);
+
+    const std::size_t size = compressed_key_size(curve);
+    std::vector<Point> points;
+    std::vector<integer> scalars;
+    std::vector<uint8_t> data;
+    Point q = curve.generator();
+    integer k(12345);
+    for (std::size_t i = 0; i < 700; i++) {
+        points.push_back(q);
+        scalars.push_back(k);
+        data.resize(data.size() + size);
+        uint8_t* key = &data[data.size() - size];
+        key[0] = q.y().value()[0] ? 3 : 2;
+        q.x().value().to_bytes(key + 1, size - 1);
+        q = q.dbl() + curve.generator();
+        k = (k * k + 11) % curve.n();
+    }
+    data[size * 300] = 5;
+    const DecompressedKeys one = decompress_keys(data.data(), points.size(), curve);
+    const DecompressedKeys many = decompress_keys(data.data(), points.size(), curve, pool);
+    EXPECT_EQ(many.invalid, one.invalid);
+    EXPECT_EQ(many.invalid_count(), 1u);
+    EXPECT_EQ(many.points, one.points);
+
+    EXPECT_EQ(multi_scalar_mul(scalars, points, pool), multi_scalar_mul(scalars, points));
+
+    std::vector<std::vector<uint8_t>> keys(30, std::vector<uint8_t>(32)), signatures(30, std::vector<uint8_t>(64));
+    std::vector<SchnorrSigned> items;
+    const uint8_t message[3] = {'a', 'b', 'c'};
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        const uint8_t secret[32] = {static_cast<uint8_t>(i + 1), 0x33};
+        schnorr_public_key(keys[i].data(), secret);
+        schnorr_sign(signatures[i].data(), message, 3, secret, nullptr);
+        items.push_back(SchnorrSigned{signatures[i].data(), message, 3, keys[i].data()});
+    }
+    EXPECT_TRUE(schnorr_verify_batch(items, pool) == Status::ok);
+    signatures[17][40] ^= 1;
+    EXPECT_TRUE(schnorr_verify_batch(items, pool) == Status::bad_signature);
+}
@@ -0,0 +1,118 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ExtensionField.h"
+
+static FieldElement random_element(std::mt19937_64& random, const PrimeField& field) {
+    std::vector<uint8_t> bytes((field.bits() + 7) / 8 + 8);
+    for (uint8_t& b : bytes) {
+        b = static_cast<uint8_t>(random());
+    }
+    return FieldElement(integer::from_bytes(bytes.data(), bytes.size(), integer::endian::big) % field.prime(), field);
+}
+
+static Fp2 random_fp2(std::mt19937_64& random, const PrimeField& field) {
+    return Fp2(random_element(random, field), random_element(random, field));
+}
+
+static Fp6 random_fp6(std::mt19937_64& random, const ExtensionTower& tower) {
+    const PrimeField& field = tower.prime_field();
+    return Fp6(tower, random_fp2(random, field), random_fp2(random, field), random_fp2(random, field));
+}
+
+static Fp12 random_fp12(std::mt19937_64& random, const ExtensionTower& tower) {
+    return Fp12(random_fp6(random, tower), random_fp6(random, tower));
+}
+
+static std::vector<const ExtensionTower*> towers() {
+    return {&ExtensionTower::bn254(), &ExtensionTower::bls12_381()};
+}
+
+TEST(ExtensionFieldTest, Fp2MatchesSchoolbook) {
+    std::mt19937_64 random(1);
+    for (const ExtensionTower* tower : towers()) {
+        const PrimeField& field = tower->prime_field();
+        for (int i = 0; i < 20; i++) {
+            const Fp2 a = random_fp2(random, field), b = random_fp2(random, field);
+            const Fp2 expected(a.c0() * b.c0() - a.c1() * b.c1(), a.c0() * b.c1() + a.c1() * b.c0());
+            EXPECT_EQ(a * b, expected);
+            EXPECT_EQ(a.square(), a * a);
+            EXPECT_EQ(a * a.inverse(), Fp2::one(field));
+            EXPECT_EQ(a.norm(), (a * a.conjugate()).c0());
+            EXPECT_EQ(a.mul_by_xi(tower->xi0()), a * tower->xi());
+        }
+    }
+}
+
+TEST(ExtensionFieldTest, Fp6MatchesSchoolbook) {
+    std::mt19937_64 random(2);
+    for (const ExtensionTower* tower : towers()) {
+        for (int i = 0; i < 10; i++) {
+            const Fp6 a = random_fp6(random, *tower), b = random_fp6(random, *tower);
+            // the product of degree 4 in v, then v^3 = xi
+            const Fp2 d0 = a.c0() * b.c0();
+            const Fp2 d1 = a.c0() * b.c1() + a.c1() * b.c0();
+            const Fp2 d2 = a.c0() * b.c2() + a.c1() * b.c1() + a.c2() * b.c0();
+            const Fp2 d3 = a.c1() * b.c2() + a.c2() * b.c1();
+            const Fp2 d4 = a.c2() * b.c2();
+            const Fp6 expected(*tower, d0 + d3 * tower->xi(), d1 + d4 * tower->xi(), d2);
+            EXPECT_EQ(a * b, expected);
+            EXPECT_EQ(a.square(), a * a);
+            EXPECT_EQ(a * a.inverse(), Fp6::one(*tower));
+            const Fp2 z = Fp2::zero(tower->prime_field());
+            EXPECT_EQ(a.mul_by_v(), a * Fp6(*tower, z, Fp2::one(tower->prime_field()), z));
+        }
+    }
+}
+
+TEST(ExtensionFieldTest, Fp12Arithmetic) {
+    std::mt19937_64 random(3);
+    for (const ExtensionTower* tower : towers()) {
+        for (int i = 0; i < 5; i++) {
+            const Fp12 a = random_fp12(random, *tower), b = random_fp12(random, *tower);
+            const Fp12 c = random_fp12(random, *tower);
+            EXPECT_EQ(a.square(), a * a);
+            EXPECT_EQ((a * b) * c, a * (b * c));
+            EXPECT_EQ(a * (b + c), a * b + a * c);
+            EXPECT_TRUE((a * a.inverse()).is_one());
+            EXPECT_EQ(a.power(5), a * a * a * a * a);
+            EXPECT_EQ(a.power(-2), (a * a).inverse());
+        }
+    }
+}
+
+TEST(ExtensionFieldTest, FrobeniusIsPowerOfP) {
+    std::mt19937_64 random(4);
+    for (const ExtensionTower* tower : towers()) {
+        const integer& p = tower->prime_field().prime();
+        const Fp12 a = random_fp12(random, *tower);
+        const Fp12 ap = a.power(p);
+        EXPECT_EQ(a.frobenius(1), ap);
+        EXPECT_EQ(a.frobenius(2), ap.frobenius(1));
+        EXPECT_EQ(a.frobenius(6), a.conjugate());
+        EXPECT_EQ(a.frobenius(12), a);
+        EXPECT_EQ(a.frobenius(5).frobenius(7), a);
+        EXPECT_EQ((a * a).frobenius(3), a.frobenius(3) * a.frobenius(3));
+
+        const Fp6 b = random_fp6(random, *tower);
+        EXPECT_EQ(Fp12(b, Fp6::zero(*tower)).frobenius(1), Fp12(b.frobenius(1), Fp6::zero(*tower)));
+        EXPECT_EQ(b.c0().conjugate(), b.c0().power(p));
+    }
+}
+
+TEST(ExtensionFieldTest, Errors) {
+    const ExtensionTower& tower = ExtensionTower::bn254();
+    EXPECT_THROW(Fp2::zero(tower.prime_field()).inverse(), std::domain_error);
+    EXPECT_THROW(Fp12::zero(tower).inverse(), std::domain_error);
+    EXPECT_THROW(Fp12::one(tower) * Fp12::one(ExtensionTower::bls12_381()), std::runtime_error);
+    // 13 is 1 mod 4, so u^2 + 1 splits
+    EXPECT_THROW(ExtensionTower(PrimeField::get(13), 1), std::invalid_argument);
+    // over 19, 1 + u is a square: its norm 2 is not a residue, but 2 + u has norm 5, a square
+    EXPECT_THROW(ExtensionTower(PrimeField::get(19), 2), std::invalid_argument);
+    EXPECT_NO_THROW(ExtensionTower(PrimeField::get(19), 1));
+}
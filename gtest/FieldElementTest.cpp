@@ -1,3 +1,427 @@
 //
 // Created by preston on 10/2/2023.
 //
+#include "gtest/gtest.h"
+#include "FieldElement.h"
+#include "FieldExpression.h"
+#include "modexp.h"
+
+#include <sstream>
+#include <unordered_set>
+
+static const integer SECP256K1_P("fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f", 16);
+
+TEST(FieldElementTest, SmallFieldArithmetic) {
+    FieldElement a(2, 31);
+    FieldElement b(15, 31);
+    FieldElement c(17, 31);
+    FieldElement d(29, 31);
+
+    EXPECT_EQ(a + b, c);
+    EXPECT_EQ(c + d, FieldElement(15, 31));
+    EXPECT_EQ(a - d, FieldElement(4, 31));
+    EXPECT_EQ(b * c, FieldElement(7, 31));
+    EXPECT_EQ(c * integer(3), FieldElement(20, 31));
+}
+
+TEST(FieldElementTest, DifferentFieldsDoNotMix) {
+    FieldElement a(2, 31);
+    FieldElement b(2, 37);
+    EXPECT_NE(a, b);
+    EXPECT_THROW(a + b, std::runtime_error);
+    EXPECT_THROW(FieldElement(31, 31), std::invalid_argument);
+}
+
+TEST(FieldElementTest, Secp256k1Arithmetic) {
+    FieldElement one(1, SECP256K1_P);
+    FieldElement minusOne(SECP256K1_P - 1, SECP256K1_P);
+    FieldElement zero(0, SECP256K1_P);
+
+    EXPECT_EQ(minusOne + one, zero);
+    EXPECT_EQ(zero - one, minusOne);
+    EXPECT_EQ(minusOne * minusOne, one);
+}
+
+TEST(FieldElementTest, WordPrimesMatchIntegerArithmetic) {
+    const integer p("4611686018427387847", 10);
+    auto ctx = std::make_shared<const MontgomeryContext>(p);
+    integer x = 5, y = p - 2;
+    for (int i = 0; i < 50; i++) {
+        const FieldElement a(x, p), b(y, p), m(x, ctx);
+        EXPECT_EQ((a * b).value(), (x * y) % p);
+        EXPECT_EQ((a + b).value(), (x + y) % p);
+        EXPECT_EQ((a - b).value(), (x - y + p) % p);
+        EXPECT_EQ((a * integer(-3)).value(), (p - (3 * x) % p) % p);
+        EXPECT_EQ((a / b * b), a);
+        EXPECT_EQ(a.power(p - 2), FieldElement(1, p) / a);
+        EXPECT_EQ((m * b + m).value(), (x * y + x) % p);
+        x = (x * x + 1) % p;
+        y = (y * 3 + x) % p;
+    }
+    EXPECT_THROW(FieldElement(1, 223) / FieldElement(0, 223), std::domain_error);
+}
+
+TEST(FieldElementTest, WidePrimeFallsBackToInteger) {
+    // 2^521 - 1
+    integer p = (integer(1) << 521) - 1;
+    FieldElement a(p - 1, p);
+    FieldElement b(2, p);
+    EXPECT_EQ(a + b, FieldElement(1, p));
+    EXPECT_EQ(b - a, FieldElement(3, p));
+    EXPECT_EQ(a * a, FieldElement(1, p));
+}
+
+TEST(FieldElementTest, CompoundAssignmentAndTemporaries) {
+    const FieldElement a(2, 31);
+    const FieldElement b(15, 31);
+    EXPECT_EQ(a * b + a - b / a, FieldElement(9, 31));
+
+    FieldElement x = a;
+    x += b;
+    EXPECT_EQ(x, FieldElement(17, 31));
+    x -= a;
+    x *= b;
+    EXPECT_EQ(x, FieldElement(8, 31));
+    x /= b;
+    EXPECT_EQ(x, FieldElement(15, 31));
+    x *= integer(2);
+    EXPECT_EQ(x, FieldElement(30, 31));
+    x *= x;
+    EXPECT_EQ(x, FieldElement(1, 31));
+    EXPECT_EQ(a, FieldElement(2, 31));
+
+    FieldElement y(2, 37);
+    EXPECT_THROW(y += a, std::runtime_error);
+}
+
+TEST(FieldElementTest, SquareMatchesProduct) {
+    const integer x("6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296", 16);
+    auto ctx = std::make_shared<const MontgomeryContext>(SECP256K1_P);
+    const integer wide = (integer(1) << 521) - 1;
+    const FieldElement elements[] = {
+            FieldElement(x, SECP256K1_P),
+            FieldElement(x, ctx),
+            FieldElement(x, integer("ffffffffffffffffffffffffffffffff0000000000000000000000000000000a", 16)),
+            FieldElement(x, wide),
+            FieldElement(7, 31),
+    };
+    for (const FieldElement& e : elements) {
+        EXPECT_EQ(e.square(), e * e) << e;
+    }
+}
+
+TEST(FieldElementTest, LazyExpressionsMatchEagerArithmetic) {
+    const integer x("6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296", 16);
+    const integer y("4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5", 16);
+    auto ctx = std::make_shared<const MontgomeryContext>(SECP256K1_P);
+    const integer wide = (integer(1) << 521) - 1;
+    const integer plain("ffffffffffffffffffffffffffffffff0000000000000000000000000000000a", 16);
+    const std::pair<FieldElement, FieldElement> pairs[] = {
+            {FieldElement(x, SECP256K1_P), FieldElement(y, SECP256K1_P)},
+            {FieldElement(x, ctx), FieldElement(y, ctx)},
+            {FieldElement(x, ctx), FieldElement(y, SECP256K1_P)},
+            {FieldElement(x, plain), FieldElement(y, plain)},
+            {FieldElement(x, wide), FieldElement(y, wide)},
+            {FieldElement(7, 31), FieldElement(30, 31)},
+    };
+    for (const auto& pair : pairs) {
+        const FieldElement& a = pair.first;
+        const FieldElement& b = pair.second;
+        FieldElement r = lazy(a) * a * 3 + b;
+        EXPECT_EQ(r, a * a * integer(3) + b) << a;
+        EXPECT_TRUE(3 * (lazy(a) * a) + b == r) << a;
+        EXPECT_EQ(FieldElement(lazy(b) * 2), b + b) << a;
+        FieldElement minusSeven(a.prime_field().prime() - 7, a.prime_field());
+        EXPECT_EQ(FieldElement(-7 * lazy(a) - b), a * minusSeven - b) << a;
+        EXPECT_EQ(FieldElement(a - lazy(a) * b * b + (lazy(b) - a) * (lazy(a) + b)),
+                a - a * b * b + (b - a) * (a + b)) << a;
+        EXPECT_EQ(FieldElement(lazy(a) * (lazy(b) - a - a - a - a) * (lazy(b) * 5 - a)),
+                a * (b - a - a - a - a) * (b * integer(5) - a)) << a;
+        r = b - lazy(r) * r;
+        EXPECT_EQ(r, b - (a * a * integer(3) + b).square()) << a;
+    }
+
+    FieldElement c(2, 37);
+    EXPECT_THROW(FieldElement(lazy(c) * 2 + pairs[5].first), std::runtime_error);
+}
+
+TEST(FieldElementTest, DivisionAndPowerStayInTheField) {
+    FieldElement a(3, 31);
+    FieldElement b(24, 31);
+    EXPECT_EQ(a / b, FieldElement(4, 31));
+    EXPECT_EQ(a.power(3), FieldElement(27, 31));
+    EXPECT_EQ(a.power(-3), FieldElement(23, 31));
+    EXPECT_EQ(a.power(0), FieldElement(1, 31));
+
+    FieldElement x(integer("1234567890abcdef1234567890abcdef", 16), SECP256K1_P);
+    FieldElement one(1, SECP256K1_P);
+    EXPECT_EQ((one / x) * x, one);
+    EXPECT_EQ(x.power(SECP256K1_P - 1), one);
+}
+
+TEST(FieldElementTest, BatchInvert) {
+    std::vector<FieldElement> xs;
+    for (int i = 1; i <= 600; i++) {
+        xs.emplace_back(integer(i) * 7919, SECP256K1_P);
+    }
+    std::vector<FieldElement> serial = xs, parallel = xs;
+    FieldElement::batch_invert(serial);
+    FieldElement::batch_invert(parallel, 3);
+
+    FieldElement one(1, SECP256K1_P);
+    for (std::size_t i = 0; i < xs.size(); i++) {
+        EXPECT_EQ(serial[i] * xs[i], one);
+        EXPECT_EQ(parallel[i], serial[i]);
+    }
+
+    std::vector<FieldElement> withZero = {FieldElement(3, 31), FieldElement(0, 31)};
+    EXPECT_THROW(FieldElement::batch_invert(withZero), std::domain_error);
+}
+
+TEST(FieldElementTest, SquareRoots) {
+    // 3 mod 4 shortcut, Tonelli-Shanks for 1 mod 4 (including 2^255 - 19)
+    const integer p25519 = (integer(1) << 255) - 19;
+    for (const integer & p : {integer(31), SECP256K1_P, integer(97), integer(7681), p25519}) {
+        for (int v : {2, 3, 5, 10, 12345}) {
+            FieldElement x(integer(v) % p, p);
+            FieldElement square = x * x;
+            FieldElement root = square.sqrt();
+            EXPECT_EQ(root * root, square) << p << " " << v;
+        }
+    }
+    EXPECT_THROW(FieldElement(3, 31).sqrt(), std::domain_error);
+    EXPECT_THROW(FieldElement(5, 97).sqrt(), std::domain_error);
+
+    // secp256k1 takes an addition chain for (p + 1) / 4, in either representation
+    auto ctx = std::make_shared<const MontgomeryContext>(SECP256K1_P);
+    const integer x("6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296", 16);
+    for (const FieldElement& square : {FieldElement(x, SECP256K1_P).square(), FieldElement(x, ctx).square()}) {
+        EXPECT_EQ(square.sqrt(), square.power((SECP256K1_P + 1) >> 2));
+        EXPECT_EQ(square.sqrt().square(), square);
+    }
+    EXPECT_THROW(FieldElement(SECP256K1_P - 1, SECP256K1_P).sqrt(), std::domain_error);
+}
+
+TEST(FieldElementTest, AdditionChainsMatchWindowedPowers) {
+    // secp256k1 and P-256 take addition chains for p - 2 and (p + 1) / 4
+    const integer p256("ffffffff00000001000000000000000000000000ffffffffffffffffffffffff", 16);
+    const integer x("6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296", 16);
+    EXPECT_TRUE(PrimeField::get(p256).addition_chain() == PrimeField::chain::p256);
+    EXPECT_TRUE(PrimeField::get(SECP256K1_P).addition_chain() == PrimeField::chain::secp256k1);
+    EXPECT_TRUE(PrimeField::get(97).addition_chain() == PrimeField::chain::none);
+    for (const integer & p : {SECP256K1_P, p256}) {
+        auto ctx = std::make_shared<const MontgomeryContext>(p);
+        for (const FieldElement& a : {FieldElement(x % p, p), FieldElement(x % p, ctx)}) {
+            EXPECT_EQ(a.power(p - 2).value(), pow(x % p, p - 2, p)) << p;
+            EXPECT_EQ(a.power(p - 2) * a, FieldElement(1, p)) << p;
+            const FieldElement square = a.square();
+            EXPECT_EQ(square.sqrt().value(), pow(square.value(), (p + 1) >> 2, p)) << p;
+            EXPECT_EQ(square.sqrt().square(), square) << p;
+        }
+        EXPECT_THROW(FieldElement(p - 1, p).sqrt(), std::domain_error);
+    }
+}
+
+TEST(FieldElementTest, IsSquareMatchesEulersCriterion) {
+    auto ctx = std::make_shared<const MontgomeryContext>(SECP256K1_P);
+    const integer p25519 = (integer(1) << 255) - 19;
+    const integer wide = (integer(1) << 521) - 1;
+    for (const integer & p : {integer(2), integer(31), integer(7681), integer("4611686018427387847", 10), SECP256K1_P, p25519, wide}) {
+        for (int v : {0, 1, 2, 3, 5, 10, 12345}) {
+            const integer x = integer(v) % p;
+            const bool expected = p == 2 || pow(x, p >> 1, p) != p - 1;
+            EXPECT_EQ(FieldElement(x, p).is_square(), expected) << p << " " << v;
+            EXPECT_EQ((FieldElement(x, p) * FieldElement(x, p)).is_square(), true) << p << " " << v;
+        }
+    }
+    const integer x("6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296", 16);
+    EXPECT_TRUE(FieldElement(x, ctx).square().is_square());
+    EXPECT_FALSE(FieldElement(SECP256K1_P - x * x % SECP256K1_P, ctx).is_square());
+}
+
+TEST(FieldElementTest, WindowedPowerMatchesSquareAndMultiply) {
+    const integer e("b7e151628aed2a6abf7158809cf4f3c762e7160f38b4da56a784d9045190cfef", 16);
+    FieldElement x(integer("deadbeef", 16), SECP256K1_P);
+    FieldElement expected(pow(x.value(), e, SECP256K1_P), SECP256K1_P);
+    EXPECT_EQ(x.power(e), expected);
+
+    auto ctx = std::make_shared<const MontgomeryContext>(SECP256K1_P);
+    EXPECT_EQ(FieldElement(x.value(), ctx).power(e), expected);
+
+    auto mul = [](const integer & a, const integer & b) { return (a * b) % SECP256K1_P; };
+    EXPECT_EQ(fixed_window_pow(x.value(), e, integer(1), mul), expected.value());
+    EXPECT_EQ(sliding_window_pow(x.value(), e, integer(1), mul), expected.value());
+    EXPECT_EQ(sliding_window_pow(x.value(), integer(0), integer(1), mul), 1);
+}
+
+TEST(FieldElementTest, ConstantTimePowerMatchesPower) {
+    const integer e("b7e151628aed2a6abf7158809cf4f3c762e7160f38b4da56a784d9045190cfef", 16);
+    FieldElement x(integer("deadbeef", 16), SECP256K1_P);
+    auto ctx = std::make_shared<const MontgomeryContext>(SECP256K1_P);
+    EXPECT_EQ(x.power_ct(e), x.power(e));
+    EXPECT_EQ(FieldElement(x.value(), ctx).power_ct(e), x.power(e));
+    EXPECT_EQ(x.power_ct(0), FieldElement(1, SECP256K1_P));
+    EXPECT_EQ(x.power_ct(-1) * x, FieldElement(1, SECP256K1_P));
+    EXPECT_EQ(FieldElement(3, 31).power_ct(5), FieldElement(26, 31));
+
+    integer p = (integer(1) << 521) - 1;
+    FieldElement w(12345, p);
+    EXPECT_EQ(w.power_ct(e), w.power(e));
+}
+
+TEST(FieldElementTest, SelectByMask) {
+    const FieldElement x(5, SECP256K1_P), y(9, SECP256K1_P);
+    EXPECT_EQ(FieldElement::select(~limb_t(0), x, y), x);
+    EXPECT_EQ(FieldElement::select(0, x, y), y);
+    // across representations, the result in the first one's
+    auto ctx = std::make_shared<const MontgomeryContext>(SECP256K1_P);
+    const FieldElement m(9, ctx);
+    EXPECT_EQ(FieldElement::select(0, x, m), y);
+    EXPECT_EQ(FieldElement::select(~limb_t(0), m, x), y);
+
+    integer p = (integer(1) << 521) - 1;
+    EXPECT_EQ(FieldElement::select(0, FieldElement(1, p), FieldElement(2, p)), FieldElement(2, p));
+    EXPECT_THROW(FieldElement::select(0, x, FieldElement(1, 31)), std::runtime_error);
+}
+
+TEST(FieldElementTest, StatusResults) {
+    const PrimeField& f = PrimeField::get(31);
+    const PrimeField& g = PrimeField::get(37);
+    EXPECT_EQ(*FieldElement::make(30, f), FieldElement(30, 31));
+    EXPECT_TRUE(FieldElement::make(31, f).status() == Status::out_of_range);
+    EXPECT_TRUE(FieldElement::make(-1, f).status() == Status::out_of_range);
+
+    const FieldElement a(12, f), b(5, f), zero(0, f), c(5, g);
+    EXPECT_EQ(*a.try_add(b), a + b);
+    EXPECT_EQ(*a.try_sub(b), a - b);
+    EXPECT_EQ(*a.try_mul(b), a * b);
+    EXPECT_EQ(*a.try_div(b), a / b);
+    EXPECT_TRUE(a.try_add(c).status() == Status::field_mismatch);
+    EXPECT_TRUE(a.try_mul(c).status() == Status::field_mismatch);
+    EXPECT_TRUE(a.try_div(zero).status() == Status::division_by_zero);
+    EXPECT_EQ(b.try_sqrt()->square(), b);
+    // 3 mod 31 fails the root check, 2 mod 37 the Tonelli-Shanks one
+    EXPECT_TRUE(FieldElement(3, f).try_sqrt().status() == Status::not_a_square);
+    EXPECT_TRUE(FieldElement(2, g).try_sqrt().status() == Status::not_a_square);
+    EXPECT_TRUE(zero.try_sqrt().ok());
+
+    // the throwing API keeps its exception types
+    EXPECT_THROW(FieldElement(31, f), std::invalid_argument);
+    EXPECT_THROW(a / zero, std::domain_error);
+    EXPECT_THROW(a + c, std::runtime_error);
+    EXPECT_THROW(FieldElement(3, f).sqrt(), std::domain_error);
+}
+
+TEST(FieldElementTest, ToCharsAndFromChars) {
+    const PrimeField& f = PrimeField::get(SECP256K1_P);
+    const FieldElement a(SECP256K1_P - 1, f);
+    char buf[80];
+    const to_chars_result w = to_chars(buf, buf + sizeof(buf), a, 16);
+    ASSERT_TRUE(w.status == Status::ok);
+    EXPECT_EQ(std::string(buf, w.ptr), (SECP256K1_P - 1).str(16));
+
+    FieldElement b(0, f);
+    const from_chars_result r = from_chars(buf, w.ptr, b, f, 16);
+    ASSERT_TRUE(r.status == Status::ok);
+    EXPECT_EQ(r.ptr, w.ptr);
+    EXPECT_EQ(b, a);
+
+    // the prime itself and negative values are out of range
+    const std::string p = SECP256K1_P.str(10);
+    EXPECT_TRUE(from_chars(p.data(), p.data() + p.size(), b, f).status == Status::out_of_range);
+    EXPECT_TRUE(from_chars("-1", "-1" + 2, b, f).status == Status::out_of_range);
+    EXPECT_EQ(b, a);
+
+    std::ostringstream out;
+    out << std::hex << FieldElement(30, 31);
+    EXPECT_EQ(out.str(), "FieldElement_1f(1e)");
+}
+
+TEST(FieldElementTest, WireFormat) {
+    const PrimeField& f = PrimeField::get(SECP256K1_P);
+    auto ctx = std::make_shared<const MontgomeryContext>(SECP256K1_P);
+    const std::vector<FieldElement> elements = {FieldElement(0, f), FieldElement(SECP256K1_P - 1, f),
+                                                FieldElement(integer("0102030405060708090a", 16), ctx),
+                                                FieldElement(0x1234, f)};
+    ASSERT_EQ(FieldElement::wire_size(f), 32u);
+    std::vector<uint8_t> wire(32 * elements.size());
+    ASSERT_TRUE(FieldElement::serialize(elements, wire.data(), wire.size()) == Status::ok);
+    // little-endian, the Montgomery element in its plain value
+    EXPECT_EQ(wire[64], 0x0A);
+    EXPECT_EQ(wire[73], 0x01);
+    EXPECT_EQ(wire[74], 0x00);
+    EXPECT_EQ(wire[96], 0x34);
+    EXPECT_EQ(wire[97], 0x12);
+
+    std::vector<FieldElement> back;
+    ASSERT_TRUE(FieldElement::deserialize(wire.data(), wire.size(), f, back) == Status::ok);
+    ASSERT_EQ(back.size(), elements.size());
+    for (std::size_t i = 0; i < back.size(); i++) {
+        EXPECT_EQ(back[i].value(), elements[i].value());
+    }
+
+    EXPECT_TRUE(FieldElement::serialize(elements, wire.data(), wire.size() - 1) == Status::buffer_too_small);
+    const FieldElement mixed[] = {FieldElement(1, f), FieldElement(1, 31)};
+    EXPECT_TRUE(FieldElement::serialize(mixed, 2, wire.data(), wire.size()) == Status::field_mismatch);
+    EXPECT_TRUE(FieldElement::deserialize(wire.data(), 33, f, back) == Status::bad_encoding);
+
+    // the prime in the last element fails the whole batch
+    (SECP256K1_P - 1).to_bytes(wire.data() + 96, 32, integer::endian::little);
+    wire[96]++;
+    back.clear();
+    EXPECT_TRUE(FieldElement::deserialize(wire.data(), wire.size(), f, back) == Status::out_of_range);
+    EXPECT_TRUE(back.empty());
+
+    // one byte per element of a small prime, and a prime above 256 bits
+    uint8_t small[3];
+    const FieldElement smalls[] = {FieldElement(30, 31), FieldElement(2, 31), FieldElement(0, 31)};
+    ASSERT_TRUE(FieldElement::serialize(smalls, 3, small, sizeof(small)) == Status::ok);
+    EXPECT_EQ(small[0], 30);
+    small[2] = 31;
+    EXPECT_TRUE(FieldElement::deserialize(small, 3, PrimeField::get(31), back) == Status::out_of_range);
+
+    const integer wide = (integer(1) << 521) - 1;
+    const FieldElement big[] = {FieldElement(wide - 2, wide), FieldElement(5, wide)};
+    std::vector<uint8_t> wide_wire(2 * 66);
+    ASSERT_TRUE(FieldElement::serialize(big, 2, wide_wire.data(), wide_wire.size()) == Status::ok);
+    ASSERT_TRUE(FieldElement::deserialize(wide_wire.data(), wide_wire.size(), PrimeField::get(wide), back) == Status::ok);
+    EXPECT_EQ(back[0], big[0]);
+    EXPECT_EQ(back[1], big[1]);
+}
+
+TEST(FieldElementTest, HeapBytes) {
+    const integer x("6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296", 16);
+    EXPECT_EQ(FieldElement(x, SECP256K1_P).heap_bytes(), 0u);
+    EXPECT_EQ(FieldElement(x, std::make_shared<const MontgomeryContext>(SECP256K1_P)).heap_bytes(), 0u);
+    // 2^1279 - 1 is past the inline digits of an integer
+    const integer wide = (integer(1) << 1279) - 1;
+    const FieldElement e(wide - x, wide);
+    EXPECT_GE(e.heap_bytes(), std::size_t(1279 / 8));
+}
+
+TEST(FieldElementTest, HashKeys) {
+    const std::hash<FieldElement> h;
+    const integer x("6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296", 16);
+    const auto mont = std::make_shared<const MontgomeryContext>(SECP256K1_P);
+    const FieldElement plain(x, SECP256K1_P), in_mont(x, mont);
+    // equal values hash alike in either representation
+    ASSERT_EQ(plain, in_mont);
+    EXPECT_EQ(h(plain), h(in_mont));
+    EXPECT_EQ(h(plain), h(FieldElement(x, SECP256K1_P)));
+    EXPECT_EQ(h(in_mont * in_mont), h(FieldElement(x, mont) * FieldElement(x, mont)));
+    EXPECT_NE(h(plain), h(plain + FieldElement(1, SECP256K1_P)));
+
+    const integer wide = (integer(1) << 1279) - 1;
+    EXPECT_EQ(h(FieldElement(x, wide)), h(FieldElement(x, wide)));
+    EXPECT_NE(h(FieldElement(x, wide)), h(FieldElement(x + 1, wide)));
+
+    std::unordered_set<FieldElement> set;
+    for (int i = 0; i < 300; i++) {
+        set.insert(FieldElement(i, mont) * FieldElement(x, mont));
+    }
+    EXPECT_EQ(set.size(), 300u);
+    for (int i = 0; i < 300; i++) {
+        EXPECT_EQ(set.count(FieldElement(i, mont) * FieldElement(x, mont)), 1u);
+    }
+    EXPECT_EQ(set.count(FieldElement(300, mont) * FieldElement(x, mont)), 0u);
+}
@@ -0,0 +1,43 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include "gtest/gtest.h"
+#include "FieldElement.h"
+#include "FieldKernels.h"
+
+static const integer SECP256K1_P("fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f", 16);
+
+TEST(FieldKernelsTest, ReportsTheBackendInUse) {
+    std::vector<FieldBackend> supported = supported_field_backends();
+    ASSERT_FALSE(supported.empty());
+    EXPECT_TRUE(supported.front() == best_field_backend());
+    EXPECT_TRUE(supported.back() == FieldBackend::portable);
+    EXPECT_TRUE(field_backend_supported(field_backend()));
+    EXPECT_STREQ(field_kernels().name, field_backend_name(field_backend()));
+}
+
+TEST(FieldKernelsTest, EveryBackendGivesTheSameResults) {
+    const FieldBackend previous = field_backend();
+    auto compute = []() {
+        auto ctx = std::make_shared<const MontgomeryContext>(SECP256K1_P);
+        FieldElement a(SECP256K1_P - 3, SECP256K1_P), b(SECP256K1_P >> 7, ctx);
+        FieldElement c = a * a + a * b - b;
+        return (c / b).power(SECP256K1_P - 5).value();
+    };
+
+    force_field_backend(FieldBackend::portable);
+    const integer expected = compute();
+    for (FieldBackend backend : supported_field_backends()) {
+        force_field_backend(backend);
+        EXPECT_TRUE(field_backend() == backend);
+        EXPECT_EQ(compute(), expected) << field_backend_name(backend);
+    }
+
+    // one of adx and neon is always missing
+    for (FieldBackend backend : {FieldBackend::adx, FieldBackend::neon}) {
+        if (!field_backend_supported(backend)) {
+            EXPECT_THROW(force_field_backend(backend), std::invalid_argument);
+        }
+    }
+    force_field_backend(previous);
+}
@@ -0,0 +1,114 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include "gtest/gtest.h"
+#include "FieldVector.h"
+
+// element-wise results against FieldElement, for one, two and four limb primes
+// and sizes that leave a partial block
+TEST(FieldVectorTest, MatchesFieldElementArithmetic) {
+    const integer p25519 = (integer(1) << 255) - 19;
+    const integer p127 = (integer(1) << 127) - 1;
+    const integer secp256k1("fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f", 16);
+    for (const integer & p : {integer(31), integer("4611686018427387847", 10), p127, p25519, secp256k1}) {
+        const PrimeField& f = PrimeField::get(p);
+        std::vector<FieldElement> a, b;
+        integer x = 3, y = p - 1;
+        for (int i = 0; i < 150; i++) {
+            a.emplace_back(x, f);
+            b.emplace_back(y, f);
+            x = (x * x + 7) % p;
+            y = (y * 5 + x) % p;
+        }
+        const FieldVector va(f, a), vb(f, b);
+        const std::vector<FieldElement> sum = (va + vb).elements(), difference = (va - vb).elements(),
+                product = (va * vb).elements(), square = va.square().elements();
+        for (std::size_t i = 0; i < a.size(); i++) {
+            EXPECT_EQ(sum[i], a[i] + b[i]) << p << " " << i;
+            EXPECT_EQ(difference[i], a[i] - b[i]) << p << " " << i;
+            EXPECT_EQ(product[i], a[i] * b[i]) << p << " " << i;
+            EXPECT_EQ(square[i], a[i].square()) << p << " " << i;
+        }
+        EXPECT_EQ(vb - vb, FieldVector(f, a.size()));
+
+        std::vector<FieldElement> inverted = b;
+        FieldElement::batch_invert(inverted);
+        EXPECT_EQ(vb.inverse().elements(), inverted);
+        EXPECT_EQ(vb * vb.inverse(), FieldVector(f, std::vector<FieldElement>(b.size(), FieldElement(1, f))));
+    }
+}
+
+TEST(FieldVectorTest, ScalarAccessAndErrors) {
+    const PrimeField& f = PrimeField::get(97);
+    FieldVector v(f, 3);
+    auto ctx = std::make_shared<const MontgomeryContext>(integer(97));
+    v.set(1, FieldElement(5, ctx));
+    v.set(2, FieldElement(96, f));
+    EXPECT_EQ(v.get(0), FieldElement(0, f));
+    EXPECT_EQ(v.get(1), FieldElement(5, f));
+    EXPECT_EQ((v + v).get(2), FieldElement(95, f));
+    EXPECT_TRUE(FieldVector(f, 0).inverse() == FieldVector(f, 0));
+
+    EXPECT_THROW(v.set(0, FieldElement(5, 31)), std::runtime_error);
+    EXPECT_THROW(v + FieldVector(f, 4), std::invalid_argument);
+    EXPECT_THROW(v + FieldVector(PrimeField::get(31), 3), std::runtime_error);
+    EXPECT_THROW(v.inverse(), std::domain_error);
+    EXPECT_THROW(FieldVector(PrimeField::get((integer(1) << 521) - 1), 1), std::invalid_argument);
+}
+
+TEST(FieldVectorTest, GatherAndScatter) {
+    const PrimeField& f = PrimeField::get(97);
+    std::vector<FieldElement> elements;
+    for (int i = 0; i < 20; i++) {
+        elements.emplace_back(i * i % 7, f);
+    }
+    FieldVector v(f, elements);
+    EXPECT_EQ(v.zeros(), (std::vector<std::size_t>{0, 7, 14}));
+
+    const std::vector<std::size_t> index = {19, 3, 3, 0, 12};
+    const FieldVector g = v.gather(index);
+    ASSERT_EQ(g.size(), index.size());
+    for (std::size_t i = 0; i < index.size(); i++) {
+        EXPECT_EQ(g.get(i), elements[index[i]]) << i;
+    }
+    v.scatter({5, 1}, v.gather({1, 5}));
+    EXPECT_EQ(v.get(5), elements[1]);
+    EXPECT_EQ(v.get(1), elements[5]);
+    EXPECT_TRUE(v.gather({}) == FieldVector(f, 0));
+
+    EXPECT_THROW(v.gather({20}), std::out_of_range);
+    EXPECT_THROW(v.scatter({20}, g.gather({0})), std::out_of_range);
+    EXPECT_THROW(v.scatter({1, 2}, g), std::invalid_argument);
+    EXPECT_THROW(v.scatter({1}, FieldVector(PrimeField::get(31), 1)), std::runtime_error);
+}
+
+// every element's power against FieldElement::power, for each reduction the
+// vector can pick (word, pseudo-Mersenne, hand-written fold with addition
+// chains, Montgomery) and on a ThreadExecutor
+TEST(FieldVectorTest, PowMatchesFieldElementPower) {
+    const integer p127 = (integer(1) << 127) - 1;
+    const integer secp256k1("fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f", 16);
+    const integer p256("ffffffff00000001000000000000000000000000ffffffffffffffffffffffff", 16);
+    const integer bn254("30644e72e131a029b85045b68181585d97816a916871ca8d3c208c16d87cfd47", 16);
+    ThreadExecutor executor(3);
+    for (const integer& p : {integer(31), p127, secp256k1, p256, bn254}) {
+        const PrimeField& f = PrimeField::get(p);
+        std::vector<FieldElement> elements;
+        integer x = 0;
+        for (int i = 0; i < 150; i++) {
+            elements.emplace_back(x, f);
+            x = (x * x + 11) % p;
+        }
+        const FieldVector v(f, elements);
+        for (const integer& e : {integer(0), integer(1), integer(2), integer(-1), f.prime_minus_one(),
+                                 f.prime_minus_two(), f.sqrt_exponent(), f.legendre_exponent(),
+                                 (p * p) / 3 + 12345}) {
+            const std::vector<FieldElement> one_thread = v.pow(e).elements();
+            EXPECT_EQ(v.pow(e, executor).elements(), one_thread) << p << " " << e;
+            for (std::size_t i = 0; i < elements.size(); i++) {
+                EXPECT_EQ(one_thread[i], elements[i].power(e)) << p << " " << e << " " << i;
+            }
+        }
+        EXPECT_TRUE(FieldVector(f, 0).pow(5, executor) == FieldVector(f, 0));
+    }
+}
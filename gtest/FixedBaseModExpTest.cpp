@@ -0,0 +1,64 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "FixedBaseModExp.h"
+#include "chacha20.h"
+#include "test_arith.h"
+
+// a Mersenne prime, an odd 1024-bit modulus and an even one, at every window
+// width, against sliding-window exponentiation
+TEST(FixedBaseModExpTest, MatchesSlidingWindow) {
+    const uint8_t key[32] = {0x31};
+    ChaCha20Rng rng(key);
+    const integer mersenne = (integer(1) << 127) - 1;
+    const integer odd = rng.random_below(integer(1) << 1024) | ((integer(1) << 1023) + 1);
+    const integer even = odd + 1;
+    for (const integer& p : {mersenne, odd, even}) {
+        const integer g = rng.random_below(p << 1);
+        for (std::size_t w : {1u, 4u, 5u, 8u}) {
+            const FixedBaseModExp table(g, p, 0, w);
+            EXPECT_EQ(table.bits(), p.bit_length());
+            EXPECT_EQ(table.size(), (p.bit_length() + w - 1) / w * ((std::size_t(1) << w) - 1));
+            EXPECT_EQ(table.pow(0), 1);
+            EXPECT_EQ(table.pow(1), g % p);
+            const integer top = (integer(1) << table.bits()) - 1;
+            EXPECT_EQ(table.pow(top), reference_pow(g, top, p));
+            for (int i = 0; i < 4; i++) {
+                const integer e = rng.random_below(integer(1) << table.bits());
+                EXPECT_EQ(table.pow(e), reference_pow(g, e, p)) << w;
+            }
+        }
+    }
+}
+
+TEST(FixedBaseModExpTest, BatchesAndRanges) {
+    const uint8_t key[32] = {0x32};
+    ChaCha20Rng rng(key);
+    const integer p = (integer(1) << 127) - 1;
+    // exponents of 160 bits, as for DSA's subgroup
+    const FixedBaseModExp table(3, p, 160);
+    std::vector<integer> exponents;
+    for (int i = 0; i < 9; i++) {
+        exponents.push_back(rng.random_below(integer(1) << 160));
+    }
+    ThreadExecutor executor(3);
+    const std::vector<integer> powers = table.pow(exponents, executor);
+    ASSERT_EQ(powers.size(), exponents.size());
+    for (std::size_t i = 0; i < exponents.size(); i++) {
+        EXPECT_EQ(powers[i], reference_pow(3, exponents[i], p));
+    }
+    EXPECT_TRUE(table.pow({}, executor).empty());
+
+    EXPECT_THROW(table.pow(integer(1) << 160), std::invalid_argument);
+    EXPECT_THROW(table.pow(-1), std::invalid_argument);
+    exponents.push_back(integer(1) << 160);
+    EXPECT_THROW(table.pow(exponents, executor), std::invalid_argument);
+    EXPECT_THROW(FixedBaseModExp(3, 0), std::invalid_argument);
+    EXPECT_THROW(FixedBaseModExp(3, p, 0, 0), std::invalid_argument);
+    EXPECT_THROW(FixedBaseModExp(3, p, 0, 9), std::invalid_argument);
+    EXPECT_EQ(FixedBaseModExp(3, 1).pow(1), 0);
+}
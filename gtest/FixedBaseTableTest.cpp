@@ -0,0 +1,136 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "FixedBaseTable.h"
+#include "StaticCombTable.h"
+
+static const integer SECP256K1_P("fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f", 16);
+static const integer SECP256K1_N("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141", 16);
+
+static Point secp256k1_generator() {
+    return Point(FieldElement(integer("79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798", 16), SECP256K1_P),
+                 FieldElement(integer("483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8", 16), SECP256K1_P),
+                 FieldElement(0, SECP256K1_P), FieldElement(7, SECP256K1_P));
+}
+
+TEST(FixedBaseTableTest, MatchesVariableBaseMultiplication) {
+    const Point g = secp256k1_generator();
+    const integer k("b7e151628aed2a6abf7158809cf4f3c762e7160f38b4da56a784d9045190cfef", 16);
+    for (std::size_t w : {1, 4, 6}) {
+        const FixedBaseTable table(g, 256, w);
+        EXPECT_EQ(table.size(), (256 + w - 1) / w * ((std::size_t(1) << w) - 1));
+        EXPECT_EQ(table.mul(k), g.mul(k)) << w;
+        EXPECT_EQ(table.mul(SECP256K1_N - 1), -g) << w;
+        EXPECT_EQ(table.mul(-k), -g.mul(k)) << w;
+        EXPECT_TRUE(table.mul(0).is_infinity());
+        EXPECT_TRUE(table.mul(SECP256K1_N).is_infinity());
+        EXPECT_EQ(table.mul_ct(k), g.mul(k)) << w;
+        EXPECT_EQ(table.mul_ct(SECP256K1_N - 1), -g) << w;
+        EXPECT_TRUE(table.mul_ct(0).is_infinity());
+        EXPECT_TRUE(table.mul_ct(SECP256K1_N).is_infinity());
+    }
+
+    // windows that do not divide the scalar size
+    const FixedBaseTable small(g, 20, 3);
+    for (int i = 0; i < 50; i++) {
+        EXPECT_EQ(small.mul(i * 20011), g.mul(i * 20011)) << i;
+        EXPECT_EQ(small.mul_ct(i * 20011), g.mul(i * 20011)) << i;
+    }
+    EXPECT_THROW(small.mul(integer(1) << 20), std::invalid_argument);
+    EXPECT_THROW(small.mul_ct(-1), std::invalid_argument);
+    EXPECT_THROW(FixedBaseTable(g, 256, 0), std::invalid_argument);
+    EXPECT_THROW(FixedBaseTable(g, 256, 9), std::invalid_argument);
+}
+
+TEST(FixedBaseTableTest, SaveAndLoad) {
+    const Point g = secp256k1_generator();
+    const integer k("b7e151628aed2a6abf7158809cf4f3c762e7160f38b4da56a784d9045190cfef", 16);
+    const std::string path = ::testing::TempDir() + "fixed_base_table.bin";
+
+    const FixedBaseTable table(g, 256, 5);
+    table.save(path);
+    const FixedBaseTable loaded = FixedBaseTable::load(path, g);
+    EXPECT_EQ(loaded.size(), table.size());
+    EXPECT_EQ(loaded.window(), 5u);
+    EXPECT_EQ(loaded.bits(), 256u);
+    EXPECT_EQ(loaded.mul(k), g.mul(k));
+    const FixedBaseTable copy = loaded;
+    EXPECT_EQ(copy.mul(-k), -g.mul(k));
+
+    // the base must match, in the same representation
+    EXPECT_THROW(FixedBaseTable::load(path, g.dbl()), std::invalid_argument);
+    auto ctx = std::make_shared<const MontgomeryContext>(SECP256K1_P);
+    const Point gm(FieldElement(g.x().value(), ctx), FieldElement(g.y().value(), ctx),
+                   g.curve_a(), g.curve_b());
+    EXPECT_THROW(FixedBaseTable::load(path, gm), std::invalid_argument);
+    FixedBaseTable(gm, 256, 5).save(path);
+    EXPECT_EQ(FixedBaseTable::load(path, gm).mul(k), g.mul(k));
+
+    // a flipped bit fails the checksum, another version is refused
+    table.save(path);
+    {
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(1000);
+        f.put('\x5a');
+    }
+    EXPECT_THROW(FixedBaseTable::load(path, g), std::runtime_error);
+    table.save(path);
+    {
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(8);
+        f.put('\x7f');
+    }
+    EXPECT_THROW(FixedBaseTable::load(path, g), std::runtime_error);
+    std::remove(path.c_str());
+    EXPECT_THROW(FixedBaseTable::load(path, g), std::runtime_error);
+
+    // entries at infinity, from a base of order 5, and a prime above 256 bits
+    const FieldElement a(2, 97), b(3, 97);
+    const Point p(FieldElement(3, 97), FieldElement(6, 97), a, b);
+    FixedBaseTable(p, 8, 2).save(path);
+    for (int i = 0; i < 256; i++) {
+        EXPECT_EQ(FixedBaseTable::load(path, p).mul(i), p * integer(i)) << i;
+    }
+    const integer wide = (integer(1) << 521) - 1;
+    const Point q(FieldElement(2, wide), FieldElement(3, wide), FieldElement(0, wide), FieldElement(1, wide));
+    FixedBaseTable(q, 64, 4).save(path);
+    EXPECT_EQ(FixedBaseTable::load(path, q).mul(k >> 192), q.mul(k >> 192));
+    std::remove(path.c_str());
+}
+
+struct Mod97 {
+    static constexpr limb_t P[4] = {97, 0, 0, 0};
+};
+
+// (3, 6) on y^2 = x^3 + 2x + 3 over GF(97) has order 5
+static constexpr StaticCombTable<Mod97, 8, 2> SMALL_COMB = static_comb_table<Mod97, 8, 2>(uint256(3), uint256(6), uint256(2));
+
+TEST(FixedBaseTableTest, CompileTimeEntries) {
+    const Point g = secp256k1_generator();
+    const FixedBaseTable table(g, 256, 4, SECP256K1_GENERATOR_COMB.limbs);
+    const integer k("b7e151628aed2a6abf7158809cf4f3c762e7160f38b4da56a784d9045190cfef", 16);
+    EXPECT_EQ(table.size(), SECP256K1_GENERATOR_COMB.COUNT);
+    EXPECT_EQ(table.mul(k), g.mul(k));
+    EXPECT_EQ(table.mul(SECP256K1_N - 1), -g);
+    for (int i = 1; i < 40; i++) {
+        EXPECT_EQ(table.mul(integer(i) << (6 * i)), g.mul(integer(i) << (6 * i))) << i;
+    }
+
+    const FieldElement a(2, 97), b(3, 97);
+    const Point p(FieldElement(3, 97), FieldElement(6, 97), a, b);
+    const FixedBaseTable small(p, 8, 2, SMALL_COMB.limbs);
+    for (int i = 0; i < 256; i++) {
+        EXPECT_EQ(small.mul(i), p * integer(i)) << i;
+    }
+
+    // the entries must belong to the base, in its representation
+    EXPECT_THROW(FixedBaseTable(g.dbl(), 256, 4, SECP256K1_GENERATOR_COMB.limbs), std::invalid_argument);
+    auto ctx = std::make_shared<const MontgomeryContext>(SECP256K1_P);
+    const Point gm(FieldElement(g.x().value(), ctx), FieldElement(g.y().value(), ctx), g.curve_a(), g.curve_b());
+    EXPECT_THROW(FixedBaseTable(gm, 256, 4, SECP256K1_GENERATOR_COMB.limbs), std::invalid_argument);
+}
@@ -0,0 +1,137 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "frost.h"
+#include "schnorr.h"
+
+namespace {
+
+// a dealer's t-of-n keys from a fixed stream
+struct Keys {
+    std::vector<uint8_t> shares, public_shares;
+    uint8_t group_key[33];
+
+    Keys(const uint8_t* secret, std::size_t threshold, std::size_t count, uint8_t seed)
+            : shares(32 * count), public_shares(33 * count) {
+        const uint8_t key[32] = {seed, 0x77};
+        ChaCha20Rng rng(key);
+        EXPECT_TRUE(frost_keygen(shares.data(), public_shares.data(), group_key, secret, threshold, count, rng)
+                    == Status::ok);
+    }
+};
+
+// every participant's preprocessed nonces, count of them each
+struct Nonces {
+    std::vector<std::vector<uint8_t>> secnonces, commitments;
+
+    Nonces(const Keys& keys, std::size_t participants, std::size_t count) {
+        const uint8_t key[32] = {0x42};
+        ChaCha20Rng rng(key);
+        for (std::size_t i = 0; i < participants; i++) {
+            this->secnonces.emplace_back(FROST_SECNONCE_SIZE * count);
+            this->commitments.emplace_back(FROST_COMMITMENT_SIZE * count);
+            EXPECT_TRUE(frost_preprocess(this->secnonces[i].data(), this->commitments[i].data(), count,
+                                         &keys.shares[32 * i], rng) == Status::ok);
+        }
+    }
+};
+
+}
+
+// 3-of-5 over different signer sets and nonces, group keys of either y: the
+// signatures verify under the x-only group key
+TEST(FrostTest, SignsBip340Signatures) {
+    for (uint8_t seed = 0; seed < 4; seed++) {
+        const Keys keys(nullptr, 3, 5, seed);
+        const Result<FrostGroup> group = FrostGroup::make(keys.group_key, keys.public_shares.data(), 5, 3);
+        ASSERT_TRUE(group.ok());
+        uint8_t qx[32];
+        group->x_only(qx);
+        Nonces nonces(keys, 5, 4);
+        const std::vector<std::vector<uint32_t>> sets = {{1, 2, 3}, {2, 4, 5}, {1, 3, 4, 5}, {1, 2, 3, 4, 5}};
+        for (std::size_t use = 0; use < sets.size(); use++) {
+            const std::string message = "frost " + std::to_string(seed) + "/" + std::to_string(use);
+            const auto* m = reinterpret_cast<const uint8_t*>(message.data());
+            std::vector<FrostCommitment> commitments;
+            for (uint32_t id : sets[use]) {
+                commitments.push_back({id, &nonces.commitments[id - 1][FROST_COMMITMENT_SIZE * use]});
+            }
+            ThreadExecutor executor(2);
+            const Result<FrostSession> session = FrostSession::start(*group, commitments, m, message.size(),
+                                                                     executor);
+            ASSERT_TRUE(session.ok());
+            std::vector<uint8_t> partials(32 * session->size());
+            for (std::size_t i = 0; i < session->size(); i++) {
+                const uint32_t id = session->identifier(i);
+                EXPECT_TRUE(session->sign(&partials[32 * i], &nonces.secnonces[id - 1][FROST_SECNONCE_SIZE * use],
+                                          id, &keys.shares[32 * (id - 1)]) == Status::ok);
+                EXPECT_TRUE(session->verify(id, &partials[32 * i]) == Status::ok);
+            }
+            EXPECT_TRUE(session->verify_batch(partials.data(), executor) == Status::ok);
+            uint8_t signature[64];
+            EXPECT_TRUE(session->aggregate(signature, partials.data()) == Status::ok);
+            EXPECT_TRUE(schnorr_verify(signature, m, message.size(), qx) == Status::ok);
+        }
+    }
+}
+
+TEST(FrostTest, RejectsBadPartialsAndSessions) {
+    const uint8_t secret[32] = {0x12, 0x34};
+    const Keys keys(secret, 2, 3, 9);
+    const Result<FrostGroup> group = FrostGroup::make(keys.group_key, keys.public_shares.data(), 3, 2);
+    ASSERT_TRUE(group.ok());
+    Nonces nonces(keys, 3, 1);
+    const uint8_t message[5] = {'v', 'o', 't', 'e', 's'};
+    const std::vector<FrostCommitment> commitments = {{1, nonces.commitments[0].data()},
+                                                      {3, nonces.commitments[2].data()}};
+    const Result<FrostSession> session = FrostSession::start(*group, commitments, message, 5);
+    ASSERT_TRUE(session.ok());
+
+    std::vector<uint8_t> partials(64);
+    std::vector<uint8_t> spare = nonces.secnonces[0];
+    EXPECT_TRUE(session->sign(&partials[0], nonces.secnonces[0].data(), 1, &keys.shares[0]) == Status::ok);
+    EXPECT_TRUE(session->sign(&partials[0], nonces.secnonces[0].data(), 1, &keys.shares[0]) == Status::out_of_range);
+    EXPECT_TRUE(session->sign(&partials[32], nonces.secnonces[2].data(), 2, &keys.shares[32]) == Status::out_of_range);
+    // participant 3 signs with participant 2's share
+    EXPECT_TRUE(session->sign(&partials[32], nonces.secnonces[2].data(), 3, &keys.shares[32]) == Status::ok);
+    EXPECT_TRUE(session->verify(1, &partials[0]) == Status::ok);
+    EXPECT_TRUE(session->verify(3, &partials[32]) == Status::bad_signature);
+    EXPECT_TRUE(session->verify(2, &partials[32]) == Status::out_of_range);
+    std::size_t culprit = 99;
+    EXPECT_TRUE(session->verify_batch(partials.data(), 1, &culprit) == Status::bad_signature);
+    EXPECT_EQ(culprit, 1u);
+    std::fill(partials.begin() + 32, partials.end(), 0xff);
+    EXPECT_TRUE(session->verify_batch(partials.data(), 1, &culprit) == Status::bad_encoding);
+    uint8_t signature[64];
+    culprit = 99;
+    EXPECT_TRUE(session->aggregate(signature, partials.data(), &culprit) == Status::bad_encoding);
+    EXPECT_EQ(culprit, 1u);
+
+    // too few signers, identifiers out of order or range, a commitment off the curve
+    EXPECT_TRUE(FrostSession::start(*group, {commitments[0]}, message, 5).status() == Status::out_of_range);
+    EXPECT_TRUE(FrostSession::start(*group, {commitments[1], commitments[0]}, message, 5).status()
+                == Status::out_of_range);
+    EXPECT_TRUE(FrostSession::start(*group, {commitments[0], {4, nonces.commitments[1].data()}}, message, 5).status()
+                == Status::out_of_range);
+    std::vector<uint8_t> broken = nonces.commitments[1];
+    broken[33] = 0x05;
+    culprit = 99;
+    EXPECT_TRUE(FrostSession::start(*group, {commitments[0], {2, broken.data()}}, message, 5, &culprit).status()
+                == Status::not_on_curve);
+    EXPECT_EQ(culprit, 1u);
+
+    const uint8_t zero[32] = {0};
+    std::vector<uint8_t> shares(96), public_shares(99);
+    uint8_t group_key[33];
+    EXPECT_TRUE(frost_keygen(shares.data(), public_shares.data(), group_key, zero, 2, 3) == Status::out_of_range);
+    EXPECT_THROW(frost_keygen(shares.data(), public_shares.data(), group_key, nullptr, 4, 3), std::invalid_argument);
+    EXPECT_THROW(frost_keygen(shares.data(), public_shares.data(), group_key, nullptr, 0, 3), std::invalid_argument);
+    EXPECT_TRUE(frost_preprocess(spare.data(), broken.data(), 1, zero) == Status::out_of_range);
+}
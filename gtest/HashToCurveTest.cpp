@@ -0,0 +1,86 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "hash_to_curve.h"
+#include "sha256.h"
+#include "test_hex.h"
+
+// RFC 9380 K.1
+TEST(HashToCurveTest, ExpandMessageXmd) {
+    const std::string dst = "QUUX-V01-CS02-with-expander-SHA256-128";
+    uint8_t out[32];
+    expand_message_xmd(nullptr, 0, reinterpret_cast<const uint8_t*>(dst.data()), dst.size(), out, 32);
+    EXPECT_EQ(hex(out, 32), "68a985b87eb6b46952128911f2a4412bbc302a9d759667f87f7a21d803f07235");
+    expand_message_xmd(reinterpret_cast<const uint8_t*>("abc"), 3, reinterpret_cast<const uint8_t*>(dst.data()),
+                       dst.size(), out, 32);
+    EXPECT_EQ(hex(out, 32), "d8ccab23b5985ccea865c6c97b6e5b8350e794e603b4b97902f53a8a0d605615");
+}
+
+TEST(HashToCurveTest, Secp256k1) {
+    const HashToCurve& h = HashToCurve::secp256k1();
+    const Point p = h.hash("", "QUUX-V01-CS02-with-secp256k1_XMD:SHA-256_SSWU_RO_");
+    EXPECT_EQ(p.x().to_hex(), "c1cae290e291aee617ebaef1be6d73861479c48b841eaba9b7b5852ddfeb1346");
+    EXPECT_EQ(p.y().to_hex(), "64fa678e07ae116126f08b022a94af6de15985c996c3a91b64c406a960e51067");
+}
+
+TEST(HashToCurveTest, P256) {
+    const HashToCurve& h = HashToCurve::p256();
+    const Point p = h.hash("", "QUUX-V01-CS02-with-P256_XMD:SHA-256_SSWU_RO_");
+    EXPECT_EQ(p.x().to_hex(), "2c15230b26dbc6fc9a37051158c95b79656e17a1a920b11394ca91c44247d3e4");
+    EXPECT_EQ(p.y().to_hex(), "8a7a74985cc5c776cdfe4b1f19884970453912e9d31528c060be9ab5c43e8415");
+}
+
+TEST(HashToCurveTest, OversizeTagAndLengths) {
+    const std::string dst(300, 'd');
+    uint8_t out[100], expected[100], short_dst[32];
+    const std::string prefixed = "H2C-OVERSIZE-DST-" + dst;
+    Sha256::hash(reinterpret_cast<const uint8_t*>(prefixed.data()), prefixed.size(), short_dst);
+    expand_message_xmd(reinterpret_cast<const uint8_t*>("m"), 1, reinterpret_cast<const uint8_t*>(dst.data()),
+                       dst.size(), out, sizeof(out));
+    expand_message_xmd(reinterpret_cast<const uint8_t*>("m"), 1, short_dst, 32, expected, sizeof(expected));
+    EXPECT_EQ(hex(out, sizeof(out)), hex(expected, sizeof(expected)));
+    std::vector<uint8_t> longest(255 * 32);
+    expand_message_xmd(nullptr, 0, short_dst, 32, longest.data(), longest.size());
+    EXPECT_THROW(expand_message_xmd(nullptr, 0, short_dst, 32, out, 0), std::invalid_argument);
+    longest.push_back(0);
+    EXPECT_THROW(expand_message_xmd(nullptr, 0, short_dst, 32, longest.data(), longest.size()),
+                 std::invalid_argument);
+}
+
+TEST(HashToCurveTest, BatchMatchesSingle) {
+    const std::vector<std::string> messages = {"", "abc", "abcdef0123456789", std::string(200, 'q'), "abc"};
+    for (const HashToCurve* h : {&HashToCurve::secp256k1(), &HashToCurve::p256(), &HashToCurve::bls12_381()}) {
+        const std::string dst = "ECC-TEST-" + h->suite();
+        const std::vector<Point> points = h->hash_batch(messages, dst);
+        ASSERT_EQ(points.size(), messages.size());
+        for (std::size_t i = 0; i < messages.size(); i++) {
+            EXPECT_EQ(points[i], h->hash(messages[i], dst)) << h->suite() << " " << i;
+            EXPECT_TRUE(points[i].is_normalized());
+            EXPECT_TRUE((points[i] * h->curve().n()).is_infinity()) << h->suite();
+        }
+        EXPECT_EQ(points[1], points[4]);
+        EXPECT_NE(points[0], points[1]);
+        EXPECT_NE(points[1], h->hash("abc", dst + "2"));
+        EXPECT_TRUE(h->hash_batch({}, dst).empty());
+    }
+}
+
+TEST(HashToCurveTest, MapToCurve) {
+    // the exceptional inputs of the maps, u = 0 among them, land on the curve too
+    for (const HashToCurve* h : {&HashToCurve::secp256k1(), &HashToCurve::p256(), &HashToCurve::bls12_381()}) {
+        const PrimeField& field = h->curve().field();
+        for (int u : {0, 1, 2, 12345}) {
+            const Point p = h->map(FieldElement(u, field));
+            EXPECT_TRUE((p * h->curve().n()).is_infinity()) << h->suite() << " " << u;
+        }
+        EXPECT_THROW(h->map(FieldElement(1, Curve::p384().field())), std::runtime_error);
+    }
+    EXPECT_EQ(HashToCurve::bls12_381().suite(), "BLS12381G1_XMD:SHA-256_SVDW_RO_");
+    EXPECT_EQ(&HashToCurve::bls12_381().curve(), &Curve::bls12_381());
+}
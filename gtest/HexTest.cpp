@@ -0,0 +1,136 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cctype>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "FieldElement.h"
+#include "hex.h"
+#include "integer.h"
+#include "gtest/gtest.h"
+
+static std::vector<const HexCodec*> codecs() {
+    std::vector<const HexCodec*> out;
+    for (const HexCodec* codec : {portable_hex_codec(), ssse3_hex_codec(), avx2_hex_codec(), neon_hex_codec()}) {
+        if (codec) {
+            out.push_back(codec);
+        }
+    }
+    return out;
+}
+
+// every codec the CPU runs against the portable one, at lengths across the vector widths
+TEST(HexTest, CodecsAgree) {
+    std::vector<uint8_t> bytes(100);
+    for (std::size_t i = 0; i < bytes.size(); i++) {
+        bytes[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+    for (const HexCodec* codec : codecs()) {
+        for (std::size_t len : {0, 1, 15, 16, 17, 31, 32, 33, 48, 64, 65, 100}) {
+            std::string expected(2 * len, '?'), text(2 * len, '?');
+            portable_hex_codec()->encode(bytes.data(), len, &expected[0]);
+            codec->encode(bytes.data(), len, &text[0]);
+            EXPECT_EQ(text, expected) << codec->name << " " << len;
+
+            std::vector<uint8_t> back(len);
+            EXPECT_TRUE(codec->decode(text.data(), len, back.data())) << codec->name << " " << len;
+            EXPECT_EQ(back, std::vector<uint8_t>(bytes.begin(), bytes.begin() + len)) << codec->name << " " << len;
+        }
+    }
+}
+
+TEST(HexTest, EitherCase) {
+    const std::string text = "00ff7FaBcDeF0123456789ABCDEFabcdef00112233445566778899aAbBcCdDeEfF";
+    std::vector<uint8_t> expected(text.size() / 2);
+    portable_hex_codec()->decode(text.data(), expected.size(), expected.data());
+    EXPECT_EQ(expected[1], 0xFF);
+    EXPECT_EQ(expected[2], 0x7F);
+    EXPECT_EQ(expected[3], 0xAB);
+    for (const HexCodec* codec : codecs()) {
+        std::vector<uint8_t> out(expected.size());
+        EXPECT_TRUE(codec->decode(text.data(), out.size(), out.data())) << codec->name;
+        EXPECT_EQ(out, expected) << codec->name;
+    }
+    std::string lower(2 * expected.size(), '?');
+    hex_encode(expected.data(), expected.size(), &lower[0]);
+    EXPECT_EQ(lower, "00ff7fabcdef0123456789abcdefabcdef00112233445566778899aabbccddeeff");
+}
+
+// the characters either side of each valid range, and bytes with the top bit set,
+// at every position of a buffer long enough for the widest codec
+TEST(HexTest, InvalidCharacters) {
+    const char bad[] = {'/', ':', '@', 'G', '`', 'g', ' ', '\0', 'x', static_cast<char>(0x80), static_cast<char>(0xB0),
+                        static_cast<char>(0xC1), static_cast<char>(0xFF)};
+    for (const HexCodec* codec : codecs()) {
+        for (char c : bad) {
+            for (std::size_t pos = 0; pos < 80; pos += 7) {
+                std::string text(80, 'a');
+                text[pos] = c;
+                uint8_t out[40];
+                EXPECT_FALSE(codec->decode(text.data(), 40, out)) << codec->name << " " << int(uint8_t(c)) << " " << pos;
+            }
+        }
+    }
+    uint8_t out[4];
+    EXPECT_TRUE(hex_decode("abc", 3, out) == Status::bad_digit);
+    EXPECT_TRUE(hex_decode("abcg", 4, out) == Status::bad_digit);
+    EXPECT_TRUE(hex_decode("", 0, out) == Status::ok);
+    EXPECT_TRUE(hex_decode("aBc1", 4, out) == Status::ok);
+    EXPECT_EQ(out[0], 0xAB);
+    EXPECT_EQ(out[1], 0xC1);
+}
+
+TEST(HexTest, Integer) {
+    EXPECT_EQ(integer(0).str(16), "0");
+    EXPECT_EQ(integer(0).str(16, 4), "0000");
+    EXPECT_EQ(integer(15).str(16), "f");
+    EXPECT_EQ(integer(16).str(16), "10");
+    EXPECT_EQ(integer(-255).str(16), "-ff");
+    EXPECT_EQ(integer(0xABC).str(16, 6), "000abc");
+    EXPECT_EQ(makehex(integer(0x1234), 8), "00001234");
+
+    const std::string texts[] = {"1", "abc", "ABCDEF", "123456789abcdef0123456789abcdef",
+                                 "fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f",
+                                 "-deadbeefcafebabe0123", "0000ff"};
+    for (const std::string& text : texts) {
+        const integer value(text, 16);
+        std::string expected = text;
+        for (char& c : expected) {
+            c = static_cast<char>(std::tolower(c));
+        }
+        const std::size_t zeros = expected.find_first_not_of("-0");
+        expected.erase(expected[0] == '-', zeros - (expected[0] == '-'));
+        EXPECT_EQ(value.str(16), expected) << text;
+        EXPECT_EQ(integer(value.str(16), 16), value) << text;
+    }
+    EXPECT_EQ(integer("-1f", 16), integer(-31));
+    EXPECT_EQ(integer("", 16), integer(0));
+
+    EXPECT_TRUE(integer::parse("12g4", 16).status() == Status::bad_digit);
+    EXPECT_TRUE(integer::parse("g", 16).status() == Status::bad_digit);
+    EXPECT_TRUE(integer::parse("-", 16).status() == Status::bad_digit);
+    EXPECT_TRUE(integer::parse("--1", 16).status() == Status::bad_digit);
+    EXPECT_THROW(integer("xyz", 16), std::runtime_error);
+}
+
+TEST(HexTest, FieldElement) {
+    const integer p = integer("fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f", 16);
+    const PrimeField& field = PrimeField::get(p);
+    const FieldElement a(integer("1234", 16), p);
+    EXPECT_EQ(a.to_hex(), std::string(60, '0') + "1234");
+    const std::string text = "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2E";
+    const Result<FieldElement> b = FieldElement::from_hex(text.data(), text.size(), field);
+    ASSERT_TRUE(b.ok());
+    EXPECT_EQ(b->value(), p - 1);
+    EXPECT_EQ(FieldElement::from_hex(a.to_hex().data(), 64, field)->value(), integer(0x1234));
+
+    const std::string over = "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F";
+    EXPECT_TRUE(FieldElement::from_hex(over.data(), over.size(), field).status() == Status::out_of_range);
+    EXPECT_TRUE(FieldElement::from_hex("12z4", 4, field).status() == Status::bad_digit);
+    EXPECT_TRUE(FieldElement::from_hex("123", 3, field).status() == Status::bad_digit);
+
+    const FieldElement small(30, 31);
+    EXPECT_EQ(small.to_hex(), "1e");
+}
@@ -0,0 +1,60 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "huge_pages.h"
+#include "metrics.h"
+
+namespace {
+
+int64_t metric(const std::string& name) {
+    for (const Metrics::ValueSample& sample : Metrics::global().snapshot().values) {
+        if (sample.name == name) {
+            return sample.value;
+        }
+    }
+    return -1;
+}
+
+const char* bytes_metric(HugePages mode) {
+    return mode == HugePages::explicit_pages ? "ecc_page_bytes_explicit"
+           : mode == HugePages::transparent ? "ecc_page_bytes_transparent" : "ecc_page_bytes_normal";
+}
+
+}
+
+// every policy gives usable memory, whatever the machine has reserved, and
+// the metrics account for the mode each block got
+TEST(HugePagesTest, EveryPolicyAllocates) {
+    const HugePages saved = huge_page_policy();
+    for (HugePages policy : {HugePages::off, HugePages::transparent, HugePages::explicit_pages}) {
+        set_huge_page_policy(policy);
+        EXPECT_EQ(metric("ecc_huge_page_policy"), static_cast<int64_t>(policy));
+        for (std::size_t bytes : {std::size_t(1000), HUGE_PAGE_SIZE + 1, 3 * HUGE_PAGE_SIZE}) {
+            const PageBlock block = page_allocate(bytes);
+            ASSERT_NE(block.data, nullptr);
+            EXPECT_GE(block.size, bytes);
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block.data) % 64, 0u);
+            if (bytes < HUGE_PAGE_SIZE || policy == HugePages::off) {
+                EXPECT_EQ(block.mode, HugePages::off);
+                EXPECT_FALSE(block.mapped);
+            } else if (block.mode != HugePages::off) {
+                EXPECT_EQ(block.size % HUGE_PAGE_SIZE, 0u);
+                EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block.data) % HUGE_PAGE_SIZE, 0u);
+            }
+            if (policy != HugePages::explicit_pages) {
+                EXPECT_NE(block.mode, HugePages::explicit_pages);
+            }
+            std::memset(block.data, 0x5a, block.size);
+            const int64_t held = metric(bytes_metric(block.mode));
+            EXPECT_GE(held, static_cast<int64_t>(block.size));
+            page_free(block);
+            EXPECT_EQ(metric(bytes_metric(block.mode)), held - static_cast<int64_t>(block.size));
+        }
+    }
+    set_huge_page_policy(saved);
+}
@@ -0,0 +1,949 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <algorithm>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <unordered_set>
+#include <vector>
+#include "gtest/gtest.h"
+#include "Executor.h"
+#include "integer.h"
+#include "IntegerArena.h"
+
+TEST(IntegerTest, LimbsAreLeastSignificantFirst) {
+    integer a("0123456789abcdeffedcba9876543210", 16);
+    integer::REP limbs = a.data();
+    ASSERT_EQ(limbs.size() * sizeof(INTEGER_DIGIT_T), (std::size_t) 16);
+    EXPECT_EQ(limbs.front() & 0xff, 0x10);
+    EXPECT_EQ(a.str(16), "123456789abcdeffedcba9876543210");
+}
+
+TEST(IntegerTest, AddSubCarryAcrossLimbs) {
+    integer max64("ffffffffffffffff", 16);
+    EXPECT_EQ((max64 + 1).str(16), "10000000000000000");
+    EXPECT_EQ((integer("10000000000000000", 16) - 1).str(16), "ffffffffffffffff");
+    EXPECT_EQ((integer(5) - integer("10000000000000000", 16)).str(10), "-18446744073709551611");
+}
+
+TEST(IntegerTest, ShiftsAcrossLimbs) {
+    integer one(1);
+    EXPECT_EQ((one << 200).str(16), "1" + std::string(50, '0'));
+    EXPECT_EQ(((one << 200) >> 137).str(16), "8" + std::string(15, '0'));
+    EXPECT_EQ((integer(-12) >> 2).str(10), "-3");
+
+    // in place, by whole digits and by parts of one, with built-in and integer counts
+    integer x("123456789abcdef0123456789abcdef", 16);
+    const integer y = x;
+    x <<= static_cast <std::size_t> (132);
+    EXPECT_EQ(x, y << integer(132));
+    x >>= 4;
+    EXPECT_EQ(x, y << 128);
+    x >>= integer(128);
+    EXPECT_EQ(x, y);
+    x >>= 1000;
+    EXPECT_EQ(x, 0);
+    EXPECT_EQ(integer(-1) >> 1, 0);
+    EXPECT_EQ((integer(-1) >> 1).sign(), integer::POSITIVE);
+    EXPECT_THROW(y << -1, std::runtime_error);
+    EXPECT_THROW(y >> integer(-1), std::runtime_error);
+}
+
+TEST(IntegerTest, MulDivRoundTrip) {
+    integer a("fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f", 16);
+    integer b("79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798", 16);
+    integer p = a * b;
+    EXPECT_EQ(p / b, a);
+    EXPECT_EQ(p % a, 0);
+    EXPECT_EQ(((p + 7) % b).str(10), "7");
+}
+
+TEST(IntegerTest, BuiltinConversions) {
+    EXPECT_EQ(integer(INT64_MIN).str(10), "-9223372036854775808");
+    EXPECT_EQ(static_cast <uint64_t> (integer(UINT64_MAX)), UINT64_MAX);
+    EXPECT_EQ(static_cast <uint8_t> (integer(0x1234)), 0x34);
+}
+
+TEST(IntegerTest, LargeValuesRoundTripThroughEveryBase) {
+    // 3^k has a known base-3 form, and crosses the divide-and-conquer threshold
+    integer x(1);
+    for (int i = 0; i < 6000; i++) {
+        x *= 3;
+    }
+    EXPECT_EQ(x.str(3), "1" + std::string(6000, '0'));
+    EXPECT_EQ(integer("1" + std::string(6000, '0'), 3), x);
+    EXPECT_EQ(x.str(9, 4000), std::string(999, '0') + "1" + std::string(3000, '0'));
+
+    const integer y = ((integer(1) << 20000) / 7) * 5 + 123;
+    for (unsigned int base = 2; base <= 16; base++) {
+        EXPECT_EQ(integer(y.str(base), base), y) << base;
+        EXPECT_EQ(integer((-y).str(base), base), -y) << base;
+    }
+    EXPECT_EQ(integer(std::string(5000, '9'), 10) + 1, integer("1" + std::string(5000, '0'), 10));
+
+    // digits given most significant first, in a base that is not a power of two
+    const std::vector <int> digits = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    EXPECT_EQ(integer(digits.begin(), digits.end(), 10), 123456789);
+    EXPECT_EQ(integer(digits.begin(), digits.begin(), 10), 0);
+}
+
+TEST(IntegerTest, BitAndLimbAccess) {
+    const integer x = (integer(1) << 130) + 5;
+    EXPECT_EQ(x.bit_length(), (std::size_t) 131);
+    EXPECT_EQ(x.bits(), 131);
+    EXPECT_EQ(integer(0).bit_length(), (std::size_t) 0);
+    EXPECT_EQ((-x).bit_length(), (std::size_t) 131);
+    EXPECT_EQ(x.bytes(), (integer::REP_SIZE_T) 17);
+    EXPECT_TRUE(x.test_bit(130));
+    EXPECT_TRUE(x.test_bit(2));
+    EXPECT_FALSE(x.test_bit(1));
+    EXPECT_FALSE(x.test_bit(100000));
+
+    const std::size_t digit_bits = sizeof(INTEGER_DIGIT_T) << 3;
+    EXPECT_EQ(x.limb_count(), 130 / digit_bits + 1);
+    EXPECT_EQ(x.limb(0), (INTEGER_DIGIT_T) 5);
+    EXPECT_EQ(x.limb(130 / digit_bits), (INTEGER_DIGIT_T) 1 << (130 % digit_bits));
+    EXPECT_EQ(x.limb(x.limb_count()), (INTEGER_DIGIT_T) 0);
+
+    const integer::limb_span limbs = x.limbs();
+    ASSERT_EQ(limbs.size(), x.limb_count());
+    EXPECT_EQ(limbs[0], x.limb(0));
+    EXPECT_TRUE(std::equal(limbs.begin(), limbs.end(), x.data().begin()));
+    EXPECT_TRUE(integer(0).limbs().empty());
+}
+
+TEST(IntegerTest, BytesInBothOrders) {
+    const uint8_t in[] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a};
+    EXPECT_EQ(integer::from_bytes(in, sizeof(in)).str(16), "102030405060708090a");
+    EXPECT_EQ(integer::from_bytes(in, sizeof(in), integer::endian::little).str(16), "a09080706050403020100");
+    EXPECT_EQ(integer::from_bytes(in, 0), 0);
+
+    const integer x("0102030405060708090a", 16);
+    uint8_t out[12];
+    x.to_bytes(out, sizeof(out));
+    EXPECT_EQ(std::string(reinterpret_cast <char *> (out), sizeof(out)), std::string("\0\0\1\2\3\4\5\6\7\x08\x09\x0a", 12));
+    x.to_bytes(out, sizeof(out), integer::endian::little);
+    EXPECT_EQ(integer::from_bytes(out, sizeof(out), integer::endian::little), x);
+    EXPECT_EQ(out[0], 0x0a);
+    EXPECT_EQ(out[11], 0x00);
+
+    EXPECT_THROW(x.to_bytes(out, 9), std::runtime_error);
+    EXPECT_THROW((-x).to_bytes(out, sizeof(out)), std::runtime_error);
+    EXPECT_EQ(x.str(256, 12), std::string(2, 0) + x.str(256));
+    EXPECT_EQ(integer(0).str(256), std::string(1, 0));
+}
+
+TEST(IntegerTest, FullProductOf256BitValuesStaysInline) {
+    integer a = (integer(1) << 256) - 1;
+    integer p = a * a;
+    EXPECT_EQ(p.bits(), 512);
+    EXPECT_TRUE(p.data().is_inline());
+    EXPECT_FALSE((p << 256).data().is_inline());
+    EXPECT_EQ((p << 256) >> 256, p);
+}
+
+TEST(IntegerTest, ProductsAcrossMultiplicationTiers) {
+    // (2^n - 1)^2 = 2^2n - 2^(n + 1) + 1 for sizes that hit every tier of operator*
+    for (const unsigned n : {1000u, 3000u, 20000u, 70000u, 200000u}) {
+        const integer a = (integer(1) << n) - 1;
+        EXPECT_EQ(a * a, (integer(1) << (2 * n)) - (integer(1) << (n + 1)) + 1) << n;
+        EXPECT_EQ(a * (a - 2), (integer(1) << (2 * n)) - (integer(1) << (n + 2)) + 3) << n;
+        EXPECT_EQ((-a) * a, -(a * a)) << n;
+    }
+    // squares sized for every tier of square()
+    for (const unsigned n : {64u, 700u, 1500u, 5000u, 70000u}) {
+        const integer a = (integer(1) << n) / 3 + 12345;
+        EXPECT_EQ(a.square(), a * a) << n;
+        EXPECT_EQ((-a).square(), a * a) << n;
+    }
+    EXPECT_EQ(integer(0).square(), 0);
+    // operands of very different lengths
+    const integer a = (integer(1) << 70000) - 1, b = (integer(1) << 4000) + 3;
+    EXPECT_EQ(a * b, (a << 4000) + a * 3);
+}
+
+// random operands on both sides of the Comba and NTT cutovers, past the 40k
+// bits where the old FFT's twiddle recurrence drifted, and of unequal lengths,
+// against a product that takes one digit of b at a time through mul_word
+TEST(IntegerTest, ProductsAroundTheCutovers) {
+    constexpr std::size_t DIGIT_BITS = sizeof(INTEGER_DIGIT_T) << 3;
+    std::mt19937_64 random(4);
+    const auto value = [&random](const std::size_t bits){
+        integer out;
+        for(std::size_t i = 0; i < bits; i += 64){
+            out = (out << 64) + integer(static_cast <uint64_t> (random()));
+        }
+        return (out >> (out.bit_length() - bits)) | (integer(1) << (bits - 1));
+    };
+    const auto digitwise = [](const integer & a, const integer & b){
+        const integer::limb_span digits = b.limbs();
+        integer out;
+        for(std::size_t j = digits.size(); j-- > 0;){
+            out = (out << DIGIT_BITS) + a * integer(digits[j]);
+        }
+        return out;
+    };
+
+    const std::size_t comba = integer::tuning().comba_bits, ntt = integer::tuning().ntt_bits;
+    const std::size_t sizes[][2] = {
+        {comba, comba},                             // the largest Comba product
+        {comba + 1, comba + 1},                     // the smallest schoolbook one past it
+        {comba, 200},                               // unequal, both sides
+        {comba + 1, 200},
+        {ntt - DIGIT_BITS, ntt - DIGIT_BITS},       // Toom-3 just below the NTT
+        {ntt, ntt},                                 // the smallest NTT product
+        {3 * ntt, ntt},                             // unequal, both sides
+        {3 * ntt, ntt - DIGIT_BITS},
+        {24000, 24000},                             // 48k bits
+        {45000, 3000},
+    };
+    for(const auto & size : sizes){
+        const integer a = value(size[0]), b = value(size[1]);
+        const integer expected = digitwise(a, b);
+        EXPECT_EQ(a * b, expected) << size[0] << " x " << size[1];
+        EXPECT_EQ(b * a, expected) << size[1] << " x " << size[0];
+        EXPECT_EQ((-a) * b, -expected) << size[0] << " x " << size[1];
+    }
+
+    // the 48k-bit product again with the NTT taking it
+    const integer::Tuning saved = integer::tuning();
+    integer::set_tuning({saved.comba_bits, saved.karatsuba_bits, saved.toom3_bits, 2048, saved.radix_dc_bits});
+    const integer a = value(24000), b = value(24000);
+    EXPECT_EQ(a * b, digitwise(a, b));
+    integer::set_tuning(saved);
+}
+
+TEST(IntegerTest, SingleWordOperands) {
+    const integer x("fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f", 16);
+    const integer one(1);
+    // carries and borrows through every digit
+    EXPECT_EQ(((one << 256) - 1) + 1, one << 256);
+    EXPECT_EQ((one << 256) - 1u, (one << 256) + -1);
+    EXPECT_EQ(integer(5) - 7, -2);
+    EXPECT_EQ(integer(-5) + 7ull, 2);
+    EXPECT_EQ(integer(-5) + 5, 0);
+    EXPECT_EQ((integer(-5) + 5).sign(), integer::POSITIVE);
+    EXPECT_EQ(x * 3, x + x + x);
+    EXPECT_EQ(x * -8, -(x << 3));
+    EXPECT_EQ(3 * x, x * integer(3));
+    EXPECT_EQ(x * 0, 0);
+    EXPECT_EQ(x * INT64_MIN, -(x << 63));
+
+    // truncated division, the remainder taking the dividend's sign
+    EXPECT_EQ((x * 1000003 + 17) / 1000003, x);
+    EXPECT_EQ((x * 1000003 + 17) % 1000003, 17);
+    EXPECT_EQ((-x * 7 - 3) / 7, -x);
+    EXPECT_EQ((-x * 7 - 3) % 7, -3);
+    EXPECT_EQ((x * 7 + 3) / -7, -x);
+    EXPECT_EQ(x % UINT64_MAX, x % integer(UINT64_MAX));
+    EXPECT_EQ(x / UINT64_MAX, x / integer(UINT64_MAX));
+    EXPECT_THROW(x / 0, std::domain_error);
+    EXPECT_THROW(x % 0u, std::domain_error);
+
+    integer y = x;
+    y *= 10;
+    y += 9;
+    y /= 10;
+    EXPECT_EQ(y, x);
+    y -= x;
+    y %= 3;
+    EXPECT_EQ(y, 0);
+}
+
+TEST(IntegerTest, CompoundAssignmentAndAccumulators) {
+    const integer a = (integer(1) << 300) - 12345, b = (integer(1) << 200) + 99;
+
+    integer x = a;
+    x += b;
+    EXPECT_EQ(x, a + b);
+    x -= a;
+    EXPECT_EQ(x, b);
+    x -= a;
+    EXPECT_EQ(x, b - a);            // the sign flips when the subtrahend is larger
+    x += x;
+    EXPECT_EQ(x, (b - a) * 2);
+    x -= x;
+    EXPECT_EQ(x, 0);
+    EXPECT_EQ(x.sign(), integer::POSITIVE);
+    x = a;
+    x *= x;
+    EXPECT_EQ(x, a * a);
+    x %= b;
+    EXPECT_EQ(x, (a * a) % b);
+
+    // addmul and submul against the plain expressions, including aliasing and single digits
+    integer acc = 7;
+    acc.addmul(a, b);
+    EXPECT_EQ(acc, a * b + 7);
+    acc.submul(a, b);
+    EXPECT_EQ(acc, 7);
+    acc.submul(a, 3);
+    EXPECT_EQ(acc, 7 - a * 3);
+    acc.addmul(-a, -3);
+    EXPECT_EQ(acc, 7);
+    acc.addmul(acc, acc);
+    EXPECT_EQ(acc, 56);
+    acc = -a;
+    acc.addmul(b, acc);
+    EXPECT_EQ(acc, -a - a * b);
+}
+
+TEST(IntegerTest, DivisionByMultiLimbDivisor) {
+    const integer one(1);
+    EXPECT_EQ(((one << 512) - 1) / ((one << 256) + 1), (one << 256) - 1);
+    EXPECT_EQ(((one << 512) - 1) % ((one << 256) + 1), 0);
+    EXPECT_EQ((one << 512) / ((one << 256) - 1), (one << 256) + 1);
+    EXPECT_EQ((one << 512) % ((one << 256) - 1), 1);
+    EXPECT_EQ(((one << 300) + 5) % 7, ((one << 300) % 7 + 5) % 7);
+    EXPECT_EQ((-((one << 200) + 3)) / (one << 100), -(one << 100));
+    EXPECT_EQ((-((one << 200) + 3)) % (one << 100), -3);
+}
+
+TEST(IntegerTest, ModularInverse) {
+    const integer p("fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f", 16);
+    const integer a("79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798", 16);
+    EXPECT_EQ((a.modinv(p) * a) % p, 1);
+    EXPECT_EQ(integer(3).modinv(31), 21);
+    EXPECT_EQ(integer(-3).modinv(31), 10);
+    EXPECT_EQ(integer(7).modinv(40), 23);   // even modulus
+    EXPECT_THROW(integer(6).modinv(40), std::domain_error);
+    EXPECT_THROW(integer(0).modinv(31), std::domain_error);
+}
+
+TEST(IntegerTest, JacobiSymbol) {
+    // Euler's criterion for small odd primes, and composite moduli by multiplicativity
+    for (int p : {3, 5, 7, 31, 97}) {
+        for (int a = -p; a < 2 * p; a++) {
+            const integer euler = pow(integer(((a % p) + p) % p), (p - 1) / 2, integer(p));
+            const int expected = (euler == p - 1) ? -1 : static_cast <int> (euler);
+            EXPECT_EQ(integer::jacobi(a, p), expected) << a << " " << p;
+        }
+    }
+    EXPECT_EQ(integer::jacobi(2, 15), integer::jacobi(2, 3) * integer::jacobi(2, 5));
+    EXPECT_EQ(integer::jacobi(6, 15), 0);
+    EXPECT_EQ(integer::jacobi(5, 1), 1);
+
+    // multi-word moduli take the full-width loop before the word one
+    const integer p("fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f", 16);
+    const integer a("79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798", 16);
+    EXPECT_EQ(integer::jacobi(a * a, p), 1);
+    EXPECT_EQ(integer::jacobi(-(a * a), p), -1);    // -1 is a non-residue when p = 3 mod 4
+    EXPECT_EQ(integer::jacobi(a * p, p), 0);
+    const integer m = (integer(1) << 521) - 1;
+    for (const integer & x : {a, a + 1, m - 3, (integer(1) << 300) + 7}) {
+        const integer euler = pow(x, m >> 1, m);
+        EXPECT_EQ(integer::jacobi(x, m), (euler == 1) ? 1 : -1) << x;
+    }
+
+    EXPECT_THROW(integer::jacobi(3, 0), std::domain_error);
+    EXPECT_THROW(integer::jacobi(3, 8), std::domain_error);
+    EXPECT_THROW(integer::jacobi(3, -7), std::domain_error);
+}
+
+TEST(IntegerTest, HeapDigitsComeFromTheScopedResource) {
+    struct counting_resource : std::pmr::memory_resource {
+        std::size_t allocations = 0;
+        void * do_allocate(std::size_t bytes, std::size_t align) override {
+            allocations++;
+            return std::pmr::new_delete_resource()->allocate(bytes, align);
+        }
+        void do_deallocate(void * p, std::size_t bytes, std::size_t align) override {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+        }
+        bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override {
+            return this == &other;
+        }
+    } counter;
+
+    const integer big = (integer(1) << 2000) - 1;
+    integer kept;
+    {
+        IntegerMemoryScope scope(&counter);
+        integer square = big * big;
+        EXPECT_GT(counter.allocations, 0u);
+        EXPECT_EQ(square % big, 0);
+    }
+    {
+        IntegerArena arena;
+        integer square = big * big;
+        kept = IntegerArena::keep(square + 1);
+    }
+    EXPECT_EQ(kept % big, 1);
+}
+
+TEST(IntegerTest, StatusResults) {
+    EXPECT_EQ(*integer::parse("-ff", 16), integer(-255));
+    EXPECT_EQ(*integer::parse("", 10), integer(0));
+    EXPECT_TRUE(integer::parse("12z", 16).status() == Status::bad_digit);
+    EXPECT_TRUE(integer::parse("-", 10).status() == Status::bad_digit);
+    EXPECT_TRUE(integer::parse("12", 17).status() == Status::bad_base);
+    EXPECT_THROW(integer("12z", 16), std::runtime_error);
+
+    const Result <std::pair <integer, integer> > qr = integer::try_divmod(-17, 5);
+    ASSERT_TRUE(qr.ok());
+    EXPECT_EQ(qr->first, integer(-17) / 5);
+    EXPECT_EQ(qr->second, integer(-17) % 5);
+    EXPECT_TRUE(integer::try_divmod(17, 0).status() == Status::division_by_zero);
+
+    EXPECT_EQ(*integer(3).try_modinv(7), integer(5));
+    EXPECT_TRUE(integer(4).try_modinv(8).status() == Status::not_invertible);
+    EXPECT_TRUE(integer(3).try_modinv(0).status() == Status::bad_modulus);
+    EXPECT_THROW(integer(4).modinv(8), std::domain_error);
+}
+
+TEST(IntegerTest, StreamsFollowTheFormatFlags) {
+    const integer big = (integer(1) << 300) - 12345;
+    std::ostringstream dec;
+    dec << big << ' ' << integer(-42) << ' ' << integer(0);
+    EXPECT_EQ(dec.str(), big.str(10) + " -42 0");
+
+    std::ostringstream hex;
+    hex << std::hex << integer(-255) << ' ' << std::showbase << std::uppercase << integer(0xABC) << ' ' << integer(0)
+        << ' ' << std::oct << integer(8) << ' ' << std::noshowbase << std::nouppercase << std::dec << std::showpos
+        << integer(7) << ' ' << integer(-7);
+    EXPECT_EQ(hex.str(), "-ff 0XABC 0 010 +7 -7");
+
+    // width and adjustment, reset after each value as for the built-in integers
+    std::ostringstream padded;
+    padded << std::setw(8) << integer(-42) << '|' << std::left << std::setw(6) << integer(42) << '|'
+           << std::internal << std::setfill('0') << std::setw(7) << integer(-42) << '|' << integer(5);
+    EXPECT_EQ(padded.str(), "     -42|42    |-000042|5");
+
+    // every base against str, across the divide and conquer threshold
+    for (const integer & v : {integer(1) << 5000, (integer(1) << 9000) / 7, integer("-123456789012345678901234567890", 10)}){
+        std::ostringstream out;
+        out << v;
+        EXPECT_EQ(out.str(), v.str(10));
+        EXPECT_EQ(integer(out.str(), 10), v);
+    }
+
+    std::istringstream in("  -123 ff 77 12z");
+    integer a, b, c, d;
+    in >> a >> std::hex >> b >> std::oct >> c >> std::dec >> d;
+    EXPECT_EQ(a, integer(-123));
+    EXPECT_EQ(b, integer(255));
+    EXPECT_EQ(c, integer(63));
+    EXPECT_EQ(d, integer(12));
+    EXPECT_FALSE(in.fail());
+    EXPECT_EQ(in.get(), 'z');
+
+    std::istringstream bad("zz");
+    bad >> a;
+    EXPECT_TRUE(bad.fail());
+    EXPECT_EQ(a, integer(-123));
+}
+
+TEST(IntegerTest, ToCharsAndFromChars) {
+    char buf[128];
+    const integer v("-123456789abcdef0123456789", 16);
+    for (const int base : {2, 8, 10, 16, 3, 7}){
+        const to_chars_result w = to_chars(buf, buf + sizeof(buf), v, base);
+        ASSERT_TRUE(w.status == Status::ok);
+        EXPECT_EQ(std::string(buf, w.ptr), v.str(base));
+
+        integer back;
+        const from_chars_result r = from_chars(buf, w.ptr, back, base);
+        ASSERT_TRUE(r.status == Status::ok);
+        EXPECT_EQ(r.ptr, w.ptr);
+        EXPECT_EQ(back, v);
+    }
+
+    // exactly the length fits, one less does not
+    const std::string text = v.str(10);
+    EXPECT_TRUE(to_chars(buf, buf + text.size(), v).status == Status::ok);
+    const to_chars_result small = to_chars(buf, buf + text.size() - 1, v);
+    EXPECT_TRUE(small.status == Status::buffer_too_small);
+    EXPECT_EQ(small.ptr, buf + text.size() - 1);
+    EXPECT_TRUE(to_chars(buf, buf + sizeof(buf), v, 17).status == Status::bad_base);
+    const to_chars_result zero = to_chars(buf, buf + 1, integer(0), 16);
+    EXPECT_EQ(std::string(buf, zero.ptr), "0");
+
+    // the longest run of digits, either case; nothing read leaves the value alone
+    const char digits[] = "-1aFz";
+    integer x = 5;
+    const from_chars_result r = from_chars(digits, digits + 5, x, 16);
+    EXPECT_EQ(r.ptr, digits + 4);
+    EXPECT_EQ(x, integer(-0x1AF));
+    x = 5;
+    EXPECT_TRUE(from_chars(digits + 4, digits + 5, x, 16).status == Status::bad_digit);
+    EXPECT_TRUE(from_chars(digits, digits + 1, x, 16).status == Status::bad_digit);
+    EXPECT_TRUE(from_chars(digits + 1, digits + 3, x, 10).ptr == digits + 2);
+    EXPECT_EQ(x, integer(1));
+}
+
+TEST(IntegerTest, WireFormat) {
+    const integer values[] = {0, 1, integer("0102030405060708090a0b0c0d0e0f10", 16), (integer(1) << 128) - 1};
+    uint8_t wire[4 * 16];
+    ASSERT_TRUE(integer::serialize(values, 4, 16, wire, sizeof(wire)) == Status::ok);
+    EXPECT_EQ(wire[16], 1);
+    EXPECT_EQ(wire[32], 0x10);
+    EXPECT_EQ(wire[47], 0x01);
+    EXPECT_EQ(wire[63], 0xFF);
+
+    std::vector <integer> back = {7};
+    ASSERT_TRUE(integer::deserialize(wire, sizeof(wire), 16, back) == Status::ok);
+    ASSERT_EQ(back.size(), 5u);
+    for (std::size_t i = 0; i < 4; i++){
+        EXPECT_EQ(back[i + 1], values[i]);
+    }
+
+    const integer wide[] = {integer(1) << 128};
+    const integer negative[] = {-1};
+    EXPECT_TRUE(integer::serialize(wide, 1, 16, wire, sizeof(wire)) == Status::out_of_range);
+    EXPECT_TRUE(integer::serialize(negative, 1, 16, wire, sizeof(wire)) == Status::out_of_range);
+    EXPECT_TRUE(integer::serialize(values, 4, 16, wire, sizeof(wire) - 1) == Status::buffer_too_small);
+    EXPECT_TRUE(integer::deserialize(wire, 17, 16, back) == Status::bad_encoding);
+    EXPECT_TRUE(integer::deserialize(wire, 16, 0, back) == Status::bad_encoding);
+}
+
+// every tier, forced at sizes it would not get by default, gives the same products and digits
+TEST(IntegerTest, TuningChangesOnlySpeed) {
+    const integer::Tuning saved = integer::tuning();
+    std::vector <integer> values;
+    integer x("123456789abcdef0fedcba9876543210", 16);
+    for (std::size_t i = 0; i < 9; i++){
+        values.push_back(x);
+        x = x * x + integer(i + 3);
+    }
+    std::vector <integer> products, squares;
+    std::vector <std::string> digits;
+    for (std::size_t i = 0; i + 1 < values.size(); i++){
+        products.push_back(values[i + 1] * values[i] + values[i + 1] * (values[i + 1] >> 7));
+        squares.push_back(values[i + 1].square());
+        digits.push_back(values[i + 1].str(10));
+    }
+
+    const integer::Tuning tunings[] = {
+        {64, 64, 64, 1 << 30, 128},         // Toom-3 everywhere, clamped to 8 digits
+        {64, 256, 1024, 2048, 256},         // NTT from 2048 bits
+        {1 << 20, 1 << 20, 1 << 20, 1 << 30, 1 << 30},  // Comba and schoolbook only
+    };
+    for (const integer::Tuning & t : tunings){
+        integer::set_tuning(t);
+        EXPECT_GE(integer::tuning().toom3_bits, 512u);
+        for (std::size_t i = 0; i + 1 < values.size(); i++){
+            EXPECT_EQ(values[i + 1] * values[i] + values[i + 1] * (values[i + 1] >> 7), products[i]) << i;
+            EXPECT_EQ(values[i + 1].square(), squares[i]) << i;
+            EXPECT_EQ(values[i + 1].str(10), digits[i]) << i;
+        }
+    }
+    integer::set_tuning(saved);
+}
+
+TEST(IntegerTest, HeapBytes) {
+    EXPECT_EQ(integer().heap_bytes(), 0u);
+    EXPECT_EQ(((integer(1) << (INTEGER_INLINE_BITS - 1)) + 1).heap_bytes(), 0u);
+    const integer big = (integer(1) << 4095) + 1;
+    EXPECT_GE(big.heap_bytes(), big.digits() * sizeof(INTEGER_DIGIT_T));
+    // the buffer moves with the value
+    integer copy = big;
+    const std::size_t held = copy.heap_bytes();
+    const integer moved(std::move(copy));
+    EXPECT_EQ(moved.heap_bytes(), held);
+}
+
+// past INTEGER_GMP_BITS, the sizes that go to GMP when it backs integer
+TEST(IntegerTest, LargeOperandsPastGmpThreshold) {
+    const std::size_t n = 4 * INTEGER_GMP_BITS + 17;
+    const integer ones = (integer(1) << n) - 1;
+    // (2^n - 1)^2 = 2^2n - 2^(n + 1) + 1
+    const integer expected = (integer(1) << (2 * n)) - (integer(1) << (n + 1)) + 1;
+    EXPECT_EQ(ones * ones, expected);
+    EXPECT_EQ(ones.square(), expected);
+    EXPECT_EQ(-ones * ones, -expected);
+
+    // unbalanced, and a division by a divisor of the same size as the quotient
+    const integer b = (integer(1) << (2 * INTEGER_GMP_BITS)) + 12345;
+    EXPECT_EQ(ones * b, (ones << (2 * INTEGER_GMP_BITS)) + ones * 12345);
+    const integer r = ones >> 3;
+    const std::pair <integer, integer> qr = integer().divmod(ones * ones + r, ones);
+    EXPECT_EQ(qr.first, ones);
+    EXPECT_EQ(qr.second, r);
+    EXPECT_EQ((expected - 1) / b * b + (expected - 1) % b, expected - 1);
+    EXPECT_EQ(-(expected + r) / ones, -ones);
+    EXPECT_EQ(-(expected + r) % ones, -r);
+}
+
+// divisors and quotients past INTEGER_BZ_BITS and INTEGER_NEWTON_BITS, checked
+// by a = q * b + r with 0 <= r < b, which only the right q and r satisfy
+TEST(IntegerTest, SubquadraticDivision) {
+    std::mt19937_64 random(7);
+    const auto value = [&random](const std::size_t bits){
+        integer out;
+        for(std::size_t i = 0; i < bits; i += 64){
+            out = (out << 64) + integer(static_cast <uint64_t> (random()));
+        }
+        return (out >> (out.bit_length() - bits)) | (integer(1) << (bits - 1));
+    };
+    const std::size_t sizes[][2] = {
+        {INTEGER_BZ_BITS + 5, INTEGER_BZ_BITS + 64},        // one block
+        {3 * INTEGER_BZ_BITS + 1, INTEGER_BZ_BITS + 17},    // unaligned, several blocks
+        {8 * INTEGER_BZ_BITS, 2 * INTEGER_BZ_BITS},
+        {4 * INTEGER_NEWTON_BITS + 3, INTEGER_NEWTON_BITS + 100},
+    };
+    for(const auto & size : sizes){
+        const integer b = value(size[1]);
+        const integer a = value(size[0]) * b + value(size[1] - 1);
+        const std::pair <integer, integer> qr = integer().divmod(a, b);
+        EXPECT_EQ(qr.first * b + qr.second, a) << size[0];
+        EXPECT_GE(qr.second, 0) << size[0];
+        EXPECT_LT(qr.second, b) << size[0];
+    }
+
+    // the quotient digit that would overflow in a 3n/2n step, and exact division
+    const integer b = (integer(1) << (2 * INTEGER_BZ_BITS)) - 1;
+    const integer q = (integer(1) << (3 * INTEGER_BZ_BITS)) - 1;
+    EXPECT_EQ((q * b) / b, q);
+    EXPECT_EQ((q * b) % b, 0);
+    EXPECT_EQ((q * b + b - 1) / b, q);
+    EXPECT_EQ(-(q * b + 5) / b, -q);
+}
+
+TEST(IntegerTest, GcdLcmXgcd) {
+    EXPECT_EQ(gcd(integer(0), integer(0)), 0);
+    EXPECT_EQ(gcd(integer(0), integer(-6)), 6);
+    EXPECT_EQ(gcd(integer(-240), integer(46)), 2);
+    EXPECT_EQ(lcm(integer(-4), integer(6)), 12);
+    EXPECT_EQ(lcm(integer(0), integer(6)), 0);
+
+    xgcd_result e = xgcd(integer(240), integer(46));
+    EXPECT_EQ(e.g, 2);
+    EXPECT_EQ(e.x, 14);
+    EXPECT_EQ(e.y, -73);
+    e = xgcd(integer(-6), integer(0));
+    EXPECT_EQ(e.g, 6);
+    EXPECT_EQ(e.x, -1);
+    EXPECT_EQ(e.y, 0);
+    e = xgcd(integer(0), integer(0));
+    EXPECT_EQ(e.g, 0);
+
+    // a common factor planted in values on either side of INTEGER_HGCD_BITS,
+    // against Euclid with %
+    std::mt19937_64 random(11);
+    const auto value = [&random](const std::size_t bits){
+        std::vector <uint8_t> bytes((bits + 7) / 8);
+        for(uint8_t & b : bytes){
+            b = static_cast <uint8_t> (random());
+        }
+        bytes[0] |= 0x80;
+        return integer::from_bytes(bytes.data(), bytes.size()) >> (bytes.size() * 8 - bits);
+    };
+    const std::size_t sizes[][2] = {{64, 64}, {200, 190}, {1000, 300}, {3 * INTEGER_HGCD_BITS, 3 * INTEGER_HGCD_BITS - 50},
+                                    {4 * INTEGER_HGCD_BITS, INTEGER_HGCD_BITS + 7}};
+    for(const auto & size : sizes){
+        const integer f = value(size[1] / 3 + 1);
+        const integer a = value(size[0]) * f;
+        const integer b = -value(size[1]) * f;
+        integer x = abs(a), y = abs(b);
+        while (y){
+            const integer r = x % y;
+            x = y;
+            y = r;
+        }
+        EXPECT_EQ(gcd(a, b), x) << size[0];
+        EXPECT_EQ(lcm(a, b) * x, abs(a * b)) << size[0];
+        e = xgcd(a, b);
+        EXPECT_EQ(e.g, x) << size[0];
+        EXPECT_EQ(a * e.x + b * e.y, x) << size[0];
+        EXPECT_GE(e.x, 0) << size[0];
+        EXPECT_LT(e.x, abs(b) / x) << size[0];
+    }
+}
+
+TEST(IntegerTest, IsqrtIrootPerfectPowers) {
+    for(int n = 0; n < 5000; n++){
+        int r = 0;
+        while ((r + 1) * (r + 1) <= n){
+            r++;
+        }
+        ASSERT_EQ(isqrt(integer(n)), r) << n;
+        ASSERT_EQ(is_perfect_square(integer(n)), r * r == n) << n;
+    }
+    EXPECT_FALSE(is_perfect_square(integer(-4)));
+    EXPECT_THROW(isqrt(integer(-1)), std::domain_error);
+    EXPECT_THROW(iroot(integer(-8), 2), std::domain_error);
+    EXPECT_THROW(iroot(integer(8), 0), std::domain_error);
+    EXPECT_EQ(iroot(integer(-30), 3), -3);
+    EXPECT_EQ(iroot(integer(1000), 1), 1000);
+    EXPECT_EQ(iroot(integer(1023), 10), 1);
+    EXPECT_EQ(iroot(integer(1024), 10), 2);
+
+    EXPECT_TRUE(is_perfect_power(integer(-1)));
+    EXPECT_TRUE(is_perfect_power(integer(-125)));
+    EXPECT_FALSE(is_perfect_power(integer(-4)));
+    EXPECT_FALSE(is_perfect_power(integer(72)));
+    EXPECT_TRUE(is_perfect_power(pow(integer(6), 35)));
+
+    // either side of exact powers of values from one digit to past the subquadratic division thresholds
+    std::mt19937_64 random(12);
+    const auto value = [&random](const std::size_t bits){
+        std::vector <uint8_t> bytes((bits + 7) / 8);
+        for(uint8_t & b : bytes){
+            b = static_cast <uint8_t> (random());
+        }
+        bytes[0] |= 0x80;
+        return integer::from_bytes(bytes.data(), bytes.size()) >> (bytes.size() * 8 - bits);
+    };
+    for(const std::size_t bits : {std::size_t(40), std::size_t(200), std::size_t(1500), std::size_t(3 * INTEGER_BZ_BITS)}){
+        const integer r = value(bits);
+        const integer s = r.square();
+        EXPECT_EQ(isqrt(s), r) << bits;
+        EXPECT_EQ(isqrt(s - 1), r - 1) << bits;
+        EXPECT_EQ(isqrt(s + 2 * r), r) << bits;
+        EXPECT_TRUE(is_perfect_square(s)) << bits;
+        EXPECT_FALSE(is_perfect_square(s + 1)) << bits;
+        for(const unsigned int k : {3u, 5u, 16u}){
+            const integer p = pow(r, k);
+            EXPECT_EQ(iroot(p, k), r) << bits << " " << k;
+            EXPECT_EQ(iroot(p - 1, k), r - 1) << bits << " " << k;
+            EXPECT_EQ(iroot(p + 1, k), r) << bits << " " << k;
+        }
+        if (bits <= 200){
+            EXPECT_TRUE(is_perfect_power(pow(r, 3))) << bits;
+        }
+    }
+}
+
+TEST(IntegerTest, LogCountsDigits) {
+    EXPECT_THROW(log(integer(0), 10), std::domain_error);
+    EXPECT_THROW(log(integer(5), 1), std::domain_error);
+    EXPECT_EQ(log(integer(1), 10), 1);
+    EXPECT_EQ(log(integer(9), 10), 1);
+    EXPECT_EQ(log(integer(10), 10), 2);
+    EXPECT_EQ(log(integer(255), 16), 2);
+    EXPECT_EQ(log(integer(256), 16), 3);
+    EXPECT_EQ(log(integer(8), 8u), 2);
+
+    // powers of the base, either side of them, and values in between, against
+    // dividing down to 0
+    for(const unsigned int base : {2u, 3u, 7u, 10u, 16u, 32u, 1000u}){
+        for(const std::size_t e : {std::size_t(1), std::size_t(19), std::size_t(64), std::size_t(301), std::size_t(2000)}){
+            const integer p = pow(integer(base), e);
+            for(const integer & v : {p - 1, p, p + 1, p * 2 + 3}){
+                std::size_t digits = 0;
+                for(integer w = v; w; w /= base){
+                    digits++;
+                }
+                EXPECT_EQ(log(v, base), digits) << base << " " << e;
+            }
+        }
+    }
+}
+
+TEST(IntegerTest, HashKeys) {
+    const std::hash <integer> h;
+    const integer a("123456789abcdef0123456789abcdef0123456789", 16);
+    EXPECT_EQ(h(a), h(integer("123456789abcdef0123456789abcdef0123456789", 16)));
+    EXPECT_NE(h(a), h(-a));
+    EXPECT_NE(h(a), h(a + 1));
+    EXPECT_NE(a.hash(1), a.hash(2));
+    EXPECT_TRUE(a == integer(a));
+    EXPECT_FALSE(a == -a);
+
+    std::unordered_set <integer> set;
+    for(int i = -500; i < 500; i++){
+        set.insert(integer(i) << 100);
+    }
+    EXPECT_EQ(set.size(), 1000u);
+    for(int i = -500; i < 500; i++){
+        EXPECT_EQ(set.count(integer(i) << 100), 1u);
+        EXPECT_EQ(set.count((integer(i) << 100) + 1), 0u);
+    }
+}
+
+TEST(IntegerTest, CompareIsThreeWay) {
+    const integer big("123456789abcdef0123456789abcdef0123456789", 16);
+    const std::vector <integer> sorted = {-big - 1, -big, integer(-1) << 64, integer(-2), integer(-1), integer(0),
+                                          integer(1), integer(2), integer(1) << 64, (integer(1) << 64) + 1, big, big + 1};
+    for(std::size_t i = 0; i < sorted.size(); i++){
+        for(std::size_t j = 0; j < sorted.size(); j++){
+            const int expected = (i < j)?-1:(i > j)?1:0;
+            EXPECT_EQ(sorted[i].compare(sorted[j]), expected) << i << " " << j;
+            EXPECT_EQ(sorted[i] < sorted[j], i < j);
+            EXPECT_EQ(sorted[i] <= sorted[j], i <= j);
+            EXPECT_EQ(sorted[i] > sorted[j], i > j);
+            EXPECT_EQ(sorted[i] >= sorted[j], i >= j);
+        }
+    }
+}
+
+// products past INTEGER_PARALLEL_NTT_BITS with an executor set, four-step on
+// 2^16 points (square rows) and 2^17 (rows twice as long), against the
+// single-threaded transform
+TEST(IntegerTest, ParallelNttMatches) {
+    std::mt19937_64 random(13);
+    const auto value = [&random](const std::size_t bits){
+        std::vector <uint8_t> bytes(bits / 8);
+        for(uint8_t & b : bytes){
+            b = static_cast <uint8_t> (random());
+        }
+        bytes[0] |= 0x80;
+        return integer::from_bytes(bytes.data(), bytes.size(), integer::endian::big);
+    };
+    const std::size_t sizes[][2] = {
+        {INTEGER_PARALLEL_NTT_BITS + 8192, INTEGER_PARALLEL_NTT_BITS + 8192},
+        {INTEGER_PARALLEL_NTT_BITS + 65536, 2 * INTEGER_PARALLEL_NTT_BITS},
+        {3 * INTEGER_PARALLEL_NTT_BITS, 3 * INTEGER_PARALLEL_NTT_BITS},
+    };
+    ThreadExecutor executor(4);
+    for(const auto & size : sizes){
+        const integer a = value(size[0]), b = value(size[1]);
+        ASSERT_EQ(integer::executor(), nullptr);
+        const integer product = a * b, square = a.square();
+        integer::set_executor(&executor);
+        EXPECT_EQ(a * b, product) << size[0] << " " << size[1];
+        EXPECT_EQ(a.square(), square) << size[0];
+        EXPECT_EQ(product % 1000000007, (a % 1000000007) * (b % 1000000007) % 1000000007);
+        integer::set_executor(nullptr);
+    }
+}
+
+// one factor held transformed against operator*, in and out of its size limit
+TEST(IntegerTest, NttMultiplierMatches) {
+    std::mt19937_64 random(17);
+    const auto value = [&random](const std::size_t bits){
+        std::vector <uint8_t> bytes(bits / 8);
+        for(uint8_t & b : bytes){
+            b = static_cast <uint8_t> (random());
+        }
+        bytes[0] |= 0x80;
+        return integer::from_bytes(bytes.data(), bytes.size(), integer::endian::big);
+    };
+    const std::size_t digit_bits = sizeof(INTEGER_DIGIT_T) << 3;
+    const integer m = value(4 * INTEGER_NTT_BITS);
+    const NttMultiplier times_m(m, m.limb_count());
+    EXPECT_EQ(times_m.value(), m);
+    for(const std::size_t bits : {64, 4 * INTEGER_NTT_BITS - 256, 4 * INTEGER_NTT_BITS}){
+        const integer x = value(bits);
+        EXPECT_EQ(times_m(x), m * x) << bits;
+        EXPECT_EQ(times_m(-x), -(m * x)) << bits;
+    }
+    EXPECT_EQ(times_m(0), 0);
+    const integer longer = value(4 * INTEGER_NTT_BITS + 8 * digit_bits);
+    EXPECT_EQ(times_m(longer), m * longer);
+
+    // below the crossover it is operator*
+    const integer small = value(256);
+    EXPECT_EQ(NttMultiplier(small, 4)(m), small * m);
+
+    // transformed four-step on an executor
+    ThreadExecutor executor(4);
+    integer::set_executor(&executor);
+    const integer big = value(INTEGER_PARALLEL_NTT_BITS + 8192);
+    const NttMultiplier times_big(big, big.limb_count());
+    const integer y = value(INTEGER_PARALLEL_NTT_BITS);
+    integer::set_executor(nullptr);
+    EXPECT_EQ(times_big(y), big * y);
+}
+
+// the shift, fixed-chain and left-to-right paths against repeated multiplication
+TEST(IntegerTest, PowFastPaths) {
+    EXPECT_EQ(pow(integer(2), 256), integer(1) << 256);
+    EXPECT_EQ(pow(integer(-2), 3), -integer(8));
+    EXPECT_EQ(pow(integer(-8), 4), integer(4096));
+    EXPECT_EQ(pow(integer(1) << 100, 3u), integer(1) << 300);
+    EXPECT_EQ(pow(integer(0), 0), 1);
+    EXPECT_EQ(pow(integer(0), 5), 0);
+    EXPECT_EQ(pow(integer(-1), 7), -1);
+    EXPECT_EQ(pow(integer(5), -1), 0);
+    for(const integer & base : {integer(3), integer(-12), integer(10), integer("123456789abcdef012345", 16) << 70,
+                                -integer("fedcba9876543210fedcba98765", 16)}){
+        integer expected = 1;
+        for(int e = 0; e < 40; e++){
+            EXPECT_EQ(pow(base, e), expected) << base << " " << e;
+            EXPECT_EQ(pow(base, static_cast <uint64_t> (e)), expected);
+            expected *= base;
+        }
+    }
+}
+
+// against the same operations on int64_t, whose operators are two's complement
+TEST(IntegerTest, BitwiseTwosComplement) {
+    const int64_t values[] = {0, 1, 2, 3, 5, 7, 8, 255, 256, 0x123456789a, -1, -2, -3, -4, -5, -7, -8, -255, -256,
+                              -0x123456789a, INT64_MAX >> 1, -(INT64_MAX >> 1)};
+    for(const int64_t a : values){
+        for(const int64_t b : values){
+            EXPECT_EQ(integer(a) & integer(b), integer(a & b)) << a << " " << b;
+            EXPECT_EQ(integer(a) | integer(b), integer(a | b)) << a << " " << b;
+            EXPECT_EQ(integer(a) ^ integer(b), integer(a ^ b)) << a << " " << b;
+            integer x(a);
+            x &= integer(b);
+            EXPECT_EQ(x, integer(a & b));
+        }
+    }
+
+    // long operands past a few digits, and the old semantics of ~, fill and
+    // twos_complement
+    const integer big = (integer(1) << 700) - 12345, other = (integer(1) << 300) + 99;
+    EXPECT_EQ(big & other, (integer(1) << 300) + ((big % 128) & 99));
+    EXPECT_EQ((big | other) - (big & other), big ^ other);
+    EXPECT_EQ(big ^ big, 0);
+    EXPECT_EQ(-(big << 3) & (big << 3), 8);     // the lowest set bit
+    EXPECT_EQ(~integer(5), 2);
+    EXPECT_EQ(~integer(0), 1);
+    EXPECT_EQ(~((integer(1) << 128) - 1), 0);
+    EXPECT_EQ(~(integer(1) << 128), (integer(1) << 128) - 1);
+    integer ones;
+    ones.fill(130);
+    EXPECT_EQ(ones, (integer(1) << 130) - 1);
+    EXPECT_EQ(integer(5).twos_complement(8), -integer(251));
+    EXPECT_EQ(integer(-5).twos_complement(8), integer(251));
+    EXPECT_EQ(big.twos_complement(800), -((integer(1) << 800) - big));
+}
+
+// expiring operands give up their digits to the result, with the values unchanged
+TEST(IntegerTest, RvalueOperators) {
+    const integer a = (integer(1) << 2000) + 12345, b = (integer(1) << 1500) - 99, p = (integer(1) << 1279) - 1;
+    const auto reused = [](integer && t, integer (*op)(integer &&)){
+        const INTEGER_DIGIT_T * digits = t.limbs().data();
+        const integer out = op(std::move(t));
+        return out.limbs().data() == digits;
+    };
+    EXPECT_TRUE(reused(integer(a), [](integer && t){ return std::move(t) + integer(7); }));
+    EXPECT_TRUE(reused(integer(a), [](integer && t){ return std::move(t) - (integer(1) << 1700); }));
+    EXPECT_TRUE(reused(integer(a), [](integer && t){ return std::move(t) ^ (integer(1) << 1700); }));
+    EXPECT_TRUE(reused(integer(a), [](integer && t){ return std::move(t) >> 3; }));
+    EXPECT_TRUE(reused(integer(a), [](integer && t){ return -std::move(t); }));
+    EXPECT_TRUE(reused(integer(b), [](integer && t){ return std::move(t) % ((integer(1) << 1600) + 1); }));
+    EXPECT_TRUE(reused(integer(b), [](integer && t){ return integer(5) + std::move(t); }));
+
+    for(const integer & x : {a, -a}){
+        for(const integer & y : {b, -b}){
+            EXPECT_EQ(integer(x) + y, x + y);
+            EXPECT_EQ(integer(x) - y, x - y);
+            EXPECT_EQ(x - integer(y), x - y);
+            EXPECT_EQ(integer(x) - integer(y), x - y);
+            EXPECT_EQ(integer(x) * y, x * y);
+            EXPECT_EQ(x * integer(y), x * y);
+            EXPECT_EQ(integer(x) / y, x / y);
+            EXPECT_EQ(integer(x) % y, x % y);
+            EXPECT_EQ(integer(y) % x, y % x);
+            EXPECT_EQ(integer(x) & y, x & y);
+            EXPECT_EQ(x | integer(y), x | y);
+            EXPECT_EQ(integer(x) ^ integer(y), x ^ y);
+            EXPECT_EQ((x * y) % p, ((x % p) * (y % p)) % p);
+        }
+        EXPECT_EQ(integer(x) + 5, x + 5);
+        EXPECT_EQ(integer(x) % 1000003, x % 1000003);
+        EXPECT_EQ(integer(x) << 67, x << 67);
+        EXPECT_EQ(-integer(x), -x);
+    }
+    integer c = a;
+    EXPECT_EQ(std::move(c) - c, 0);
+}
+
+TEST(IntegerTest, ExtractBits) {
+    const integer x("f0e1d2c3b4a5968778695a4b3c2d1e0f123456789abcdef", 16);
+    for(std::size_t len : {1u, 3u, 7u, 31u, 63u, 64u}){
+        for(std::size_t pos = 0; pos < 200; pos += 5){
+            uint64_t expected = 0;
+            for(std::size_t j = 0; j < len; j++){
+                expected |= static_cast <uint64_t> (x.test_bit(pos + j)) << j;
+            }
+            EXPECT_EQ(x.extract_bits(pos, len), expected) << pos << " " << len;
+        }
+    }
+    EXPECT_EQ(x.extract_bits(10, 0), 0u);
+    EXPECT_EQ(integer(-6).extract_bits(1, 2), 3u);
+}
@@ -0,0 +1,125 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ecdsa.h"
+#include "key_table_cache.h"
+#include "schnorr.h"
+
+TEST(KeyTableCacheTest, WnafTables) {
+    const integer u1("123456789abcdef0123456789abcdef0123456789abcdef", 16), u2("fedcba987654321fedcba9876543210", 16);
+    for (const Curve* curve : {&Curve::secp256k1(), &Curve::p256(), &Curve::p384()}) {
+        const Point q = curve->generator() * integer(12345);
+        const WnafTable table = q.wnaf_table(6);
+        EXPECT_EQ(table.window(), 6u);
+        EXPECT_EQ(table.base(), q);
+        // both GLV halves' tables on secp256k1
+        EXPECT_EQ(table.size(), curve == &Curve::secp256k1() ? 32u : 16u);
+        EXPECT_GE(table.memory(), table.size() * sizeof(Point));
+        EXPECT_EQ(Point::mul_add(u1, curve->generator_wnaf(), u2, table),
+                  Point::mul_add(u1, curve->generator(), u2, q)) << curve->name();
+        EXPECT_EQ(Point::mul_add(-u1, curve->generator_wnaf(), integer(0), table), curve->generator() * -u1);
+        EXPECT_EQ(&curve->generator_wnaf(), &curve->generator_wnaf());
+    }
+    EXPECT_THROW(Point::mul_add(u1, Curve::p256().generator_wnaf(), u2, Curve::secp256k1().generator_wnaf()),
+                 std::runtime_error);
+    EXPECT_THROW(Curve::p256().generator().wnaf_table(9), std::invalid_argument);
+}
+
+TEST(KeyTableCacheTest, Verification) {
+    KeyTableCache cache(1 << 20);
+    uint8_t secret[32] = {0}, hash[32] = {0}, signature[64], x_only[32], schnorr[64];
+    secret[31] = 7;
+    hash[5] = 1;
+    for (const Curve* curve : {&Curve::secp256k1(), &Curve::p256()}) {
+        const Point q = *ecdsa_public_key(*curve, secret);
+        ecdsa_sign(signature, *curve, secret, hash, 32);
+        for (int i = 0; i < 3; i++) {
+            EXPECT_TRUE(ecdsa_verify(signature, *curve, q, hash, 32, cache) == Status::ok);
+        }
+        hash[5] ^= 1;
+        EXPECT_TRUE(ecdsa_verify(signature, *curve, q, hash, 32, cache) == Status::bad_signature);
+        hash[5] ^= 1;
+        EXPECT_TRUE(ecdsa_verify(signature, *curve, curve->infinity(), hash, 32, cache) == Status::infinity);
+    }
+    KeyTableCache::Stats stats = cache.stats();
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.hits, 6u);
+    EXPECT_EQ(stats.entries, 2u);
+    EXPECT_DOUBLE_EQ(stats.hit_rate(), 0.75);
+
+    // a BIP340 key shares the entry of the point with even y
+    schnorr_public_key(x_only, secret);
+    schnorr_sign(schnorr, hash, 32, secret, nullptr);
+    EXPECT_TRUE(schnorr_verify(schnorr, hash, 32, x_only, cache) == Status::ok);
+    EXPECT_TRUE(schnorr_verify(schnorr, hash, 31, x_only, cache) == Status::bad_signature);
+    const bool even = (*ecdsa_public_key(Curve::secp256k1(), secret)).y().value() % integer(2) == integer(0);
+    EXPECT_EQ(cache.stats().entries, even ? 2u : 3u);
+    // keys with no point get schnorr_verify's status
+    uint8_t bad[32];
+    std::fill(bad, bad + 32, 0xff);
+    EXPECT_TRUE(schnorr_verify(schnorr, hash, 32, bad, cache) == Status::bad_encoding);
+    EXPECT_TRUE(cache.table(bad).status() == Status::bad_encoding);
+    cache.clear();
+    EXPECT_EQ(cache.stats().entries, 0u);
+    EXPECT_EQ(cache.stats().bytes, 0u);
+}
+
+TEST(KeyTableCacheTest, Budget) {
+    const Curve& curve = Curve::secp256k1();
+    const std::size_t one = curve.generator().wnaf_table(5).memory();
+    // one shard with room for three keys' tables
+    KeyTableCache cache(4 * one, 5, 1);
+    std::vector<Point> keys;
+    for (int i = 1; i <= 4; i++) {
+        keys.push_back(curve.mul_base(integer(i)));
+        EXPECT_TRUE(cache.table(curve, keys.back()) != nullptr);
+    }
+    KeyTableCache::Stats stats = cache.stats();
+    EXPECT_EQ(stats.entries, 3u);
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_LE(stats.bytes, cache.budget());
+    // the least recently used went: the first key misses, the last hits
+    cache.table(curve, keys[3]);
+    EXPECT_EQ(cache.stats().hits, 1u);
+    cache.table(curve, keys[0]);
+    EXPECT_EQ(cache.stats().misses, 5u);
+
+    // a table over the budget is made and not kept
+    KeyTableCache tiny(64, 5);
+    EXPECT_TRUE(tiny.table(curve, keys[0]) != nullptr);
+    EXPECT_EQ(tiny.stats().entries, 0u);
+    // a budget that divides over the shards is kept whole
+    EXPECT_EQ(KeyTableCache(64 << 20).budget(), std::size_t(64 << 20));
+    EXPECT_THROW(KeyTableCache(0), std::invalid_argument);
+    EXPECT_THROW(KeyTableCache(1 << 20, 1), std::invalid_argument);
+    // keys the cache does not take
+    EXPECT_TRUE(cache.table(curve, curve.infinity()) == nullptr);
+    EXPECT_TRUE(cache.table(Curve::p256(), keys[0]) == nullptr);
+    EXPECT_TRUE(cache.table(Curve::p384(), Curve::p384().generator()) == nullptr);
+}
+
+// keys spread over every shard: with each shard full, four of them hold four
+// times the keys of one shard alone
+TEST(KeyTableCacheTest, FillsEveryShard) {
+    const Curve& curve = Curve::secp256k1();
+    const std::size_t shard = 32 * curve.generator().wnaf_table(2).memory();
+    std::vector<Point> keys;
+    for (int i = 1; i <= 400; i++) {
+        keys.push_back(curve.mul_base(integer(i)));
+    }
+    KeyTableCache one(shard, 2, 1), four(4 * shard, 2, 4);
+    for (const Point& q : keys) {
+        one.table(curve, q);
+        four.table(curve, q);
+    }
+    const std::size_t per_shard = one.stats().entries;
+    EXPECT_GT(one.stats().evictions, 0u);
+    EXPECT_GT(per_shard, 8u);
+    EXPECT_EQ(four.stats().entries, 4 * per_shard);
+}
@@ -0,0 +1,99 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Curve.h"
+#include "kzg.h"
+
+static const KzgSetup& setup() {
+    static const KzgSetup s = KzgSetup::insecure(integer("5eed0f7a0", 16), 33, 2);
+    return s;
+}
+
+static Polynomial random_polynomial(std::mt19937_64& random, std::size_t n) {
+    const PrimeField& field = KzgSetup::scalar_field();
+    std::vector<FieldElement> c;
+    for (std::size_t i = 0; i < n; i++) {
+        c.emplace_back((integer(static_cast<uint64_t>(random())) << 128) + integer(static_cast<uint64_t>(random())),
+                       field);
+    }
+    return Polynomial(field, std::move(c));
+}
+
+TEST(KzgTest, CommitIsEvaluationAtTau) {
+    std::mt19937_64 random(1);
+    const PrimeField& field = KzgSetup::scalar_field();
+    const FieldElement tau(integer("5eed0f7a0", 16), field);
+    for (std::size_t n : {1, 2, 20, 33}) {
+        const Polynomial p = random_polynomial(random, n);
+        EXPECT_EQ(setup().commit(p), Curve::bls12_381().generator() * p.evaluate(tau).value()) << n;
+    }
+    EXPECT_TRUE(setup().commit(Polynomial(field)).is_infinity());
+}
+
+TEST(KzgTest, OpenAndVerify) {
+    std::mt19937_64 random(2);
+    const PrimeField& field = KzgSetup::scalar_field();
+    std::vector<KzgClaim> claims;
+    for (std::size_t n : {1, 5, 33}) {
+        const Polynomial p = random_polynomial(random, n);
+        const FieldElement z(integer(static_cast<uint64_t>(random())), field);
+        const KzgClaim claim = setup().open(p, z, 2);
+        EXPECT_EQ(claim.y, p.evaluate(z));
+        EXPECT_TRUE(setup().verify(claim)) << n;
+        KzgClaim wrong = claim;
+        wrong.y += FieldElement(1, field);
+        EXPECT_FALSE(setup().verify(wrong)) << n;
+        claims.push_back(claim);
+    }
+    EXPECT_TRUE(setup().verify_batch(claims));
+    EXPECT_TRUE(setup().verify_batch({}));
+    claims[1].z += FieldElement(1, field);
+    EXPECT_FALSE(setup().verify_batch(claims, 2));
+}
+
+TEST(KzgTest, SaveAndLoad) {
+    const std::string path = ::testing::TempDir() + "kzg_setup_test.bin";
+    setup().save(path);
+    const KzgSetup loaded = KzgSetup::load(path);
+    EXPECT_EQ(loaded.size(), setup().size());
+    EXPECT_EQ(loaded.tau_g2(), setup().tau_g2());
+    for (std::size_t i = 0; i < loaded.size(); i++) {
+        EXPECT_EQ(loaded.powers()[i], setup().powers()[i]) << i;
+    }
+    std::mt19937_64 random(3);
+    const Polynomial p = random_polynomial(random, 10);
+    EXPECT_EQ(loaded.commit(p), setup().commit(p));
+
+    // a flipped coordinate byte leaves the point off the curve, a short file is corrupt
+    std::vector<char> bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    bytes[bytes.size() - 5] ^= 1;
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), bytes.size());
+    EXPECT_THROW(KzgSetup::load(path), std::invalid_argument);
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), bytes.size() - 96);
+    EXPECT_THROW(KzgSetup::load(path), std::runtime_error);
+    std::remove(path.c_str());
+    EXPECT_THROW(KzgSetup::load(path), std::runtime_error);
+}
+
+TEST(KzgTest, Errors) {
+    std::mt19937_64 random(4);
+    EXPECT_THROW(setup().commit(random_polynomial(random, 34)), std::invalid_argument);
+    const Polynomial other(Curve::secp256k1().scalar_field(), {FieldElement(1, Curve::secp256k1().scalar_field())});
+    EXPECT_THROW(setup().commit(other), std::runtime_error);
+    EXPECT_THROW(setup().open(random_polynomial(random, 3), FieldElement(1, Curve::secp256k1().scalar_field())),
+                 std::runtime_error);
+    EXPECT_THROW(KzgSetup({}, G2Point::generator()), std::invalid_argument);
+    EXPECT_THROW(KzgSetup({Curve::secp256k1().generator()}, G2Point::generator()), std::invalid_argument);
+}
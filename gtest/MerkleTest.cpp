@@ -0,0 +1,138 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "merkle.h"
+#include "sha256.h"
+#include "test_hex.h"
+
+namespace {
+
+// count leaves, the SHA-256 of i each
+std::vector<uint8_t> make_leaves(std::size_t count, uint8_t salt = 0) {
+    std::vector<uint8_t> leaves(32 * count);
+    for (std::size_t i = 0; i < count; i++) {
+        const uint8_t seed[9] = {static_cast<uint8_t>(i), static_cast<uint8_t>(i >> 8),
+                                 static_cast<uint8_t>(i >> 16), 0, 0, 0, 0, 0, salt};
+        Sha256::hash(seed, sizeof(seed), &leaves[32 * i]);
+    }
+    return leaves;
+}
+
+// Bitcoin's ComputeMerkleRoot, one double hash at a time
+std::vector<uint8_t> reference_root(std::vector<uint8_t> level) {
+    if (level.empty()) {
+        return std::vector<uint8_t>(32, 0);
+    }
+    while (level.size() > 32) {
+        if (level.size() % 64) {
+            level.insert(level.end(), level.end() - 32, level.end());
+        }
+        std::vector<uint8_t> next(level.size() / 2);
+        for (std::size_t i = 0; i < next.size(); i += 32) {
+            uint8_t inner[32];
+            Sha256::hash(&level[2 * i], 64, inner);
+            Sha256::hash(inner, 32, &next[i]);
+        }
+        level = next;
+    }
+    return level;
+}
+
+std::vector<uint8_t> reversed(const std::string& text) {
+    std::vector<uint8_t> out = unhex(text);
+    std::reverse(out.begin(), out.end());
+    return out;
+}
+
+}
+
+// block 100000's four transactions, txids and root as block explorers show
+// them (byte-reversed)
+TEST(MerkleTest, Block100000) {
+    std::vector<uint8_t> leaves;
+    for (const char* txid : {"8c14f0db3df150123e6f3dbbf30f8b955a8249b62ac1d1ff16284aefa3d06d87",
+                             "fff2525b8931402dd09222c50775608f75787bd2b87e56995a7bdd30f79702c4",
+                             "6359f0868171b1d194cbee1af2f16ea598ae8fad666d9b012c8ed2b79a236ec4",
+                             "e9a66845e05d5abc0ad04ec80f774a7e585c6e8db975962d069a522137b80c1d"}) {
+        const std::vector<uint8_t> leaf = reversed(txid);
+        leaves.insert(leaves.end(), leaf.begin(), leaf.end());
+    }
+    uint8_t root[32];
+    merkle_root(root, leaves.data(), 4);
+    EXPECT_EQ(std::vector<uint8_t>(root, root + 32),
+              reversed("f3e94742aca4b5ef85488dc37c06c3282295ffec960994b2c0d5ac2a25a95766"));
+}
+
+// every way of building agrees with the one-at-a-time reference, at sizes
+// around the subtree size where the last subtree is lifted
+TEST(MerkleTest, RootsMatchTheReference) {
+    for (std::size_t count : {0u, 1u, 2u, 3u, 5u, 7u, 64u, 4095u, 4096u, 4097u, 10000u, 3u * 4096u + 1u}) {
+        const std::vector<uint8_t> leaves = make_leaves(count);
+        const std::vector<uint8_t> expected = reference_root(leaves);
+        for (unsigned threads : {1u, 4u}) {
+            uint8_t root[32];
+            merkle_root(root, leaves.data(), count, threads);
+            EXPECT_EQ(std::vector<uint8_t>(root, root + 32), expected) << count << " leaves, " << threads;
+            const MerkleTree tree(leaves.data(), count, threads);
+            EXPECT_EQ(tree.size(), count);
+            tree.root(root);
+            EXPECT_EQ(std::vector<uint8_t>(root, root + 32), expected) << count << " leaves, " << threads;
+        }
+        MerkleStream stream;
+        for (std::size_t i = 0; i < count;) {
+            const std::size_t n = std::min<std::size_t>(count - i, i % 3 ? 1000 : 1);
+            stream.add(&leaves[32 * i], n);
+            i += n;
+        }
+        EXPECT_EQ(stream.size(), count);
+        uint8_t root[32];
+        stream.root(root);
+        EXPECT_EQ(std::vector<uint8_t>(root, root + 32), expected) << count << " streamed leaves";
+    }
+}
+
+TEST(MerkleTest, UpdatesAndBranches) {
+    const std::size_t count = 5000;
+    std::vector<uint8_t> leaves = make_leaves(count);
+    MerkleTree tree(leaves.data(), count, 2);
+    EXPECT_EQ(tree.depth(), 13u);
+
+    // the coinbase alone, then a batch with an index twice
+    const std::vector<uint8_t> other = make_leaves(4, 1);
+    tree.update(0, other.data());
+    std::memcpy(leaves.data(), other.data(), 32);
+    uint8_t root[32];
+    tree.root(root);
+    EXPECT_EQ(std::vector<uint8_t>(root, root + 32), reference_root(leaves));
+    const std::vector<std::size_t> indices = {4999, 17, 4096, 17};
+    tree.update(indices, other.data());
+    for (std::size_t k = 0; k < indices.size(); k++) {
+        std::memcpy(&leaves[32 * indices[k]], &other[32 * k], 32);
+    }
+    tree.root(root);
+    EXPECT_EQ(std::vector<uint8_t>(root, root + 32), reference_root(leaves));
+    EXPECT_EQ(std::memcmp(tree.leaf(17), &other[96], 32), 0);
+    EXPECT_THROW(tree.update(count, other.data()), std::out_of_range);
+
+    for (std::size_t i : {0u, 1u, 17u, 4095u, 4096u, 4998u, 4999u}) {
+        const std::vector<uint8_t> branch = tree.branch(i);
+        uint8_t proven[32];
+        merkle_branch_root(proven, tree.leaf(i), i, branch.data(), tree.depth());
+        EXPECT_EQ(std::memcmp(proven, root, 32), 0) << i;
+        merkle_branch_root(proven, tree.leaf(i), i ^ 1, branch.data(), tree.depth());
+        EXPECT_NE(std::memcmp(proven, root, 32), 0) << i;
+    }
+    EXPECT_THROW(tree.branch(count), std::out_of_range);
+
+    const MerkleTree single(other.data(), 1);
+    EXPECT_EQ(single.depth(), 0u);
+    EXPECT_TRUE(single.branch(0).empty());
+}
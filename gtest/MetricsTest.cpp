@@ -0,0 +1,89 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "metrics.h"
+#include "schnorr.h"
+
+TEST(MetricsTest, HistogramBuckets) {
+    for (uint64_t v = 0; v < 16; v++) {
+        EXPECT_EQ(Histogram::bucket(v), v);
+    }
+    // each bucket starts where the last ended, and is under 1/16 of its values wide
+    for (std::size_t b = 1; b + 1 < Histogram::BUCKETS; b++) {
+        const uint64_t floor = Histogram::bucket_floor(b), next = Histogram::bucket_floor(b + 1);
+        ASSERT_GT(next, floor);
+        EXPECT_EQ(Histogram::bucket(floor), b);
+        EXPECT_EQ(Histogram::bucket(next - 1), b);
+        EXPECT_LE((next - floor) * 16, floor < 16 ? 16 : floor) << b;
+    }
+    EXPECT_EQ(Histogram::bucket(~uint64_t(0)), Histogram::BUCKETS - 1);
+}
+
+TEST(MetricsTest, QuantilesFromManyThreads) {
+    Histogram h;
+    EXPECT_EQ(h.snapshot().quantile(0.5), 0u);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&h]() {
+            for (uint64_t v = 1; v <= 10000; v++) {
+                h.record(v * 1000);
+            }
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+    const Histogram::Snapshot s = h.snapshot();
+    EXPECT_EQ(s.count, 40000u);
+    EXPECT_EQ(s.max, 10000000u);
+    EXPECT_EQ(s.sum, uint64_t(4) * 1000 * 10000 * 10001 / 2);
+    for (double q : {0.5, 0.99, 0.999}) {
+        const double exact = q * 10000000;
+        EXPECT_NEAR(static_cast<double>(s.quantile(q)), exact, exact / 16) << q;
+    }
+    EXPECT_EQ(s.quantile(1), s.max);
+}
+
+TEST(MetricsTest, RegistryAndPrometheus) {
+    Metrics metrics;
+    Histogram& h = metrics.histogram("test_seconds", "a test");
+    EXPECT_EQ(&metrics.histogram("test_seconds", "again"), &h);
+    metrics.counter("test_total", "things").add(3);
+    metrics.gauge("test_depth", "waiting").add(-2);
+    EXPECT_THROW(metrics.gauge("test_total", "clash"), std::invalid_argument);
+    h.record(2000);
+
+    const Metrics::Snapshot s = metrics.snapshot();
+    ASSERT_EQ(s.histograms.size(), 1u);
+    EXPECT_EQ(s.histograms[0].values.count, 1u);
+    ASSERT_EQ(s.values.size(), 2u);
+    EXPECT_EQ(s.values[0].name, "test_depth");
+    EXPECT_EQ(s.values[0].value, -2);
+
+    const std::string text = metrics.prometheus();
+    EXPECT_NE(text.find("# HELP test_seconds a test\n# TYPE test_seconds summary\n"), std::string::npos);
+    EXPECT_NE(text.find("test_seconds{quantile=\"0.99\"} 2e-06\n"), std::string::npos);
+    EXPECT_NE(text.find("test_seconds_count 1\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE test_total counter\ntest_total 3\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE test_depth gauge\ntest_depth -2\n"), std::string::npos);
+}
+
+TEST(MetricsTest, LibraryRecordsVerifications) {
+    Histogram& verify = Metrics::global().histogram("ecc_schnorr_verify_seconds", "");
+    const uint64_t before = verify.snapshot().count;
+    uint8_t secret[32] = {0}, key[32], signature[64], message[32] = {7};
+    secret[31] = 3;
+    ASSERT_TRUE(schnorr_public_key(key, secret) == Status::ok);
+    ASSERT_TRUE(schnorr_sign(signature, message, 32, secret, nullptr) == Status::ok);
+    EXPECT_TRUE(schnorr_verify(signature, message, 32, key) == Status::ok);
+    EXPECT_TRUE(schnorr_verify(signature, message, 31, key) == Status::bad_signature);
+    EXPECT_EQ(verify.snapshot().count, before + 2);
+    EXPECT_NE(Metrics::global().prometheus().find("ecc_schnorr_sign_seconds_count"), std::string::npos);
+}
@@ -0,0 +1,69 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "BarrettReducer.h"
+#include "chacha20.h"
+#include "modexp.h"
+
+namespace {
+
+// the product of the separate powers
+integer reference_multi_pow(const std::vector<integer>& bases, const std::vector<integer>& exponents,
+                            const integer& modulus) {
+    const BarrettReducer reducer(modulus);
+    integer product = reducer.reduce(1);
+    for (std::size_t i = 0; i < bases.size(); i++) {
+        product = reducer.mul(product, sliding_window_pow(reducer.reduce(bases[i]), exponents[i], reducer.reduce(1),
+                [&reducer](const integer& x, const integer& y) { return reducer.mul(x, y); }));
+    }
+    return product;
+}
+
+}
+
+// Strauss, Pippenger at several windows and the dispatch agree with separate
+// powers, over exponents of mixed sizes, zeros among them
+TEST(ModExpTest, MultiPowMatchesSeparatePowers) {
+    const uint8_t key[32] = {0x6d, 0x70};
+    ChaCha20Rng rng(key);
+    const integer p = (integer(1) << 521) - 1;
+    for (std::size_t k : {1u, 2u, 3u, 7u, 40u}) {
+        std::vector<integer> bases, exponents;
+        for (std::size_t i = 0; i < k; i++) {
+            bases.push_back(rng.random_below(p));
+            exponents.push_back(i % 5 == 4 ? integer(0) : rng.random_below(integer(1) << (64 + 100 * (i % 5))));
+        }
+        const integer expected = reference_multi_pow(bases, exponents, p);
+        EXPECT_EQ(multi_pow(bases, exponents, p), expected) << k;
+
+        const BarrettReducer reducer(p);
+        const auto mul = [&reducer](const integer& x, const integer& y) { return reducer.mul(x, y); };
+        EXPECT_EQ(strauss_multi_pow(bases, exponents, integer(1), mul), expected) << k;
+        for (std::size_t c : {1u, 4u, 9u}) {
+            EXPECT_EQ(bucket_multi_pow(bases, exponents, c, integer(1), mul), expected) << k << " " << c;
+        }
+    }
+}
+
+TEST(ModExpTest, MultiPowEdges) {
+    const integer p = 1000003;
+    EXPECT_EQ(multi_pow({}, {}, p), 1);
+    EXPECT_EQ(multi_pow({5, 7}, {0, 0}, p), 1);
+    EXPECT_EQ(multi_pow({-2, 3}, {3, 2}, p), p - 72);
+    EXPECT_EQ(multi_pow({2, 3}, {10, 1}, 1), 0);
+    // even moduli work, as Barrett reduction does not need odd ones
+    EXPECT_EQ(multi_pow({3, 5}, {4, 3}, 1000), 125);
+    // many small exponents, which multi_pow gives to Pippenger
+    EXPECT_EQ(multi_pow(std::vector<integer>(5000, 2), std::vector<integer>(5000, 3), p),
+              reference_multi_pow({2}, {15000}, p));
+
+    EXPECT_THROW(multi_pow({2, 3}, {1}, p), std::invalid_argument);
+    EXPECT_THROW(multi_pow({2}, {-1}, p), std::invalid_argument);
+    EXPECT_THROW(multi_pow({2}, {1}, 0), std::invalid_argument);
+    const auto mul = [](const integer& x, const integer& y) { return x * y; };
+    EXPECT_THROW(bucket_multi_pow<integer>({2}, {1}, 0, integer(1), mul), std::invalid_argument);
+}
@@ -0,0 +1,119 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include "gtest/gtest.h"
+#include "FieldElement.h"
+#include "FieldKernels.h"
+#include "MontgomeryContext.h"
+
+static const integer SECP256K1_P("fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f", 16);
+
+TEST(MontgomeryContextTest, MatchesIntegerArithmetic) {
+    // 2^256 - 189 is the largest 256-bit prime, so the CIOS top carry is exercised
+    for (const integer & p : {integer(31), SECP256K1_P, (integer(1) << 256) - 189}) {
+        MontgomeryContext ctx(p);
+        integer a = p - 2, b = (p >> 1) + 5;
+        uint256 ma = ctx.to_montgomery(uint256::from_integer(a));
+        uint256 mb = ctx.to_montgomery(uint256::from_integer(b));
+
+        EXPECT_EQ(ctx.from_montgomery(ma).to_integer(), a);
+        EXPECT_EQ(ctx.from_montgomery(ctx.mul(ma, mb)).to_integer(), (a * b) % p);
+        EXPECT_EQ(ctx.from_montgomery(ctx.sqr(ma)).to_integer(), (a * a) % p);
+        EXPECT_EQ(ctx.from_montgomery(ctx.add(ma, mb)).to_integer(), (a + b) % p);
+        EXPECT_EQ(ctx.from_montgomery(ctx.sub(mb, ma)).to_integer(), (b - a + p) % p);
+        EXPECT_EQ(ctx.from_montgomery(ctx.one()).to_integer(), 1);
+    }
+}
+
+TEST(MontgomeryContextTest, RejectsUnsupportedModuli) {
+    EXPECT_THROW(MontgomeryContext(integer(30)), std::invalid_argument);
+    EXPECT_THROW(MontgomeryContext((integer(1) << 257) - 1), std::invalid_argument);
+}
+
+TEST(MontgomeryContextTest, FieldElementOptIn) {
+    auto ctx = std::make_shared<const MontgomeryContext>(SECP256K1_P);
+    FieldElement a(SECP256K1_P - 3, ctx);
+    FieldElement b(12345, ctx);
+    FieldElement plainB(12345, SECP256K1_P);
+
+    EXPECT_EQ(b, plainB);
+    EXPECT_EQ((a * b).value(), ((SECP256K1_P - 3) * 12345) % SECP256K1_P);
+    EXPECT_EQ(a * b, a * plainB);
+    EXPECT_EQ((a + b).value(), integer(12342));
+    EXPECT_EQ((b - a).value(), integer(12348));
+    EXPECT_EQ((a * integer(2)).value(), SECP256K1_P - 6);
+}
+
+static std::vector<const FieldKernels*> kernel_tables() {
+    return {&portable_field_kernels(), adx_field_kernels(), avx2_field_kernels(), avx512ifma_field_kernels(),
+            neon_field_kernels(), simd128_field_kernels()};
+}
+
+TEST(MontgomeryContextTest, SingleKernelsMatchPortable) {
+    const FieldKernels& portable = portable_field_kernels();
+    MontgomeryContext ctx(SECP256K1_P);
+    // all ones first, for the longest carry chains, then pseudo-random limbs
+    uint256 a = uint256::zero() - uint256(1), b = a;
+    limb_t seed = 1;
+    for (std::size_t i = 0; i < 200; i++) {
+        uint512 wide = portable.mul_wide(a, b);
+        uint256 ma = uint256::from_integer(a.to_integer() % SECP256K1_P);
+        uint256 mb = uint256::from_integer(b.to_integer() % SECP256K1_P);
+        for (const FieldKernels* k : kernel_tables()) {
+            if (!k) {
+                continue;
+            }
+            EXPECT_EQ(k->mul_wide(a, b), wide) << k->name;
+            EXPECT_EQ(k->secp256k1_reduce_p(wide).to_integer(), wide.to_integer() % SECP256K1_P) << k->name;
+            EXPECT_EQ(k->montgomery_mul(ma, mb, ctx.modulus(), ctx.n0()),
+                    portable.montgomery_mul(ma, mb, ctx.modulus(), ctx.n0())) << k->name;
+        }
+        for (std::size_t j = 0; j < 4; j++) {
+            seed = seed * 6364136223846793005 + 1442695040888963407;
+            a.limb[j] = seed;
+            seed = seed * 6364136223846793005 + 1442695040888963407;
+            b.limb[j] = seed;
+        }
+    }
+}
+
+TEST(MontgomeryContextTest, BatchKernelsMatchScalar) {
+    std::vector<const FieldKernels*> tables = kernel_tables();
+    for (const integer & p : {integer(31), SECP256K1_P, (integer(1) << 256) - 189}) {
+        MontgomeryContext ctx(p);
+        // 19 is not a multiple of any lane count, so the tails run too
+        std::vector<uint256> a, b;
+        integer x = p - 1, y = p >> 3;
+        for (std::size_t i = 0; i < 19; i++) {
+            a.push_back(ctx.to_montgomery(uint256::from_integer(x)));
+            b.push_back(ctx.to_montgomery(uint256::from_integer(y)));
+            x = (x * x + 7) % p;
+            y = (y * 3 + x) % p;
+        }
+        for (const FieldKernels* k : tables) {
+            if (!k) {
+                continue;
+            }
+            std::vector<uint256> out(a.size());
+            k->mul(out.data(), a.data(), b.data(), a.size(), ctx.modulus(), ctx.n0());
+            for (std::size_t i = 0; i < a.size(); i++) {
+                EXPECT_EQ(out[i], ctx.mul(a[i], b[i])) << k->name;
+            }
+            k->add(out.data(), a.data(), b.data(), a.size(), ctx.modulus());
+            for (std::size_t i = 0; i < a.size(); i++) {
+                EXPECT_EQ(out[i], ctx.add(a[i], b[i])) << k->name;
+            }
+            k->sub(out.data(), a.data(), b.data(), a.size(), ctx.modulus());
+            for (std::size_t i = 0; i < a.size(); i++) {
+                EXPECT_EQ(out[i], ctx.sub(a[i], b[i])) << k->name;
+            }
+        }
+
+        // in place, through the context's own choice of kernels
+        std::vector<uint256> c = a;
+        ctx.mul(c.data(), c.data(), b.data(), c.size());
+        for (std::size_t i = 0; i < a.size(); i++) {
+            EXPECT_EQ(c[i], ctx.mul(a[i], b[i]));
+        }
+    }
+}
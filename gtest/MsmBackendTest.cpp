@@ -0,0 +1,113 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Curve.h"
+#include "msm.h"
+#include "msm_backend.h"
+
+namespace {
+
+// the host reference, counting its calls, or declining them all
+class CountingBackend : public HostMsmBackend {
+public:
+    CountingBackend(std::size_t min_points, bool decline) : HostMsmBackend(min_points), decline(decline) {}
+    bool window_sums(const MsmBuffers& in, limb_t* sums) override {
+        this->calls++;
+        return !this->decline && HostMsmBackend::window_sums(in, sums);
+    }
+    std::atomic<int> calls{0};
+
+private:
+    bool decline;
+};
+
+void inputs(const Curve& curve, std::size_t n, std::vector<integer>& scalars, std::vector<Point>& points) {
+    Point q = curve.generator();
+    integer k(424242);
+    for (std::size_t i = 0; i < n; i++) {
+        points.push_back(i == 7 ? curve.infinity() : q);
+        scalars.push_back(i % 4 == 1 ? -k : (i == 11 ? integer(0) : k));
+        q = q.dbl() + curve.generator();
+        k = (k * k + 5) % curve.n();
+    }
+}
+
+}
+
+TEST(MsmBackendTest, StagedLayout) {
+    const Curve& curve = Curve::p256();
+    std::vector<integer> scalars;
+    std::vector<Point> points;
+    inputs(curve, 20, scalars, points);
+    MsmBuffers buffers;
+    msm_stage(scalars, points, 5, buffers);
+    EXPECT_EQ(buffers.count, 20u);
+    EXPECT_EQ(buffers.width, 4u);
+    EXPECT_EQ(buffers.windows, msm_max_bits(scalars) / 5 + 1);
+    EXPECT_EQ(buffers.x.size(), 80u);
+    EXPECT_EQ(buffers.digits.size(), buffers.windows * 20);
+    // infinity as x = p, and a negative scalar's point negated
+    EXPECT_TRUE(std::equal(buffers.prime.begin(), buffers.prime.end(), buffers.x.begin() + 7 * 4));
+    const integer y1 = curve.p() - points[1].y().value();
+    std::vector<uint8_t> bytes(32);
+    y1.to_bytes(bytes.data(), 32, integer::endian::little);
+    EXPECT_EQ(buffers.y[4] & 0xFF, bytes[0]);
+    // digits window-major, and summing back to |k|
+    for (std::size_t i : {0, 1, 11}) {
+        integer k = 0;
+        for (std::size_t w = buffers.windows; w > 0; w--) {
+            k = k * 32 + buffers.digits[(w - 1) * 20 + i];
+        }
+        EXPECT_EQ(k, scalars[i] < 0 ? -scalars[i] : scalars[i]) << i;
+    }
+    EXPECT_THROW(msm_stage(scalars, points, 0, buffers), std::invalid_argument);
+}
+
+// multi_scalar_mul hands large enough inputs to the backend and gets the same
+// sum, and goes on by itself when the backend declines
+TEST(MsmBackendTest, OffloadsMultiScalarMul) {
+    for (const Curve* curve : {&Curve::secp256k1(), &Curve::p384()}) {
+        std::vector<integer> scalars;
+        std::vector<Point> points;
+        inputs(*curve, 90, scalars, points);
+        const Point expected = multi_scalar_mul(scalars, points);
+
+        CountingBackend host(80, false);
+        set_msm_backend(&host);
+        EXPECT_EQ(multi_scalar_mul(scalars, points), expected);
+        EXPECT_EQ(host.calls.load(), 1);
+        const std::vector<integer> few(scalars.begin(), scalars.begin() + 10);
+        const std::vector<Point> near(points.begin(), points.begin() + 10);
+        EXPECT_EQ(multi_scalar_mul(few, near), Point::mul_sum(few, near));
+        EXPECT_EQ(host.calls.load(), 1);
+
+        CountingBackend declining(1, true);
+        set_msm_backend(&declining);
+        EXPECT_EQ(multi_scalar_mul(scalars, points, 2), expected);
+        EXPECT_EQ(declining.calls.load(), 1);
+        set_msm_backend(nullptr);
+    }
+}
+
+TEST(MsmBackendTest, CombineRejectsBadSums) {
+    const Curve& curve = Curve::secp256k1();
+    std::vector<integer> scalars;
+    std::vector<Point> points;
+    inputs(curve, 10, scalars, points);
+    MsmBuffers buffers;
+    msm_stage(scalars, points, 4, buffers);
+    std::vector<limb_t> sums(3 * buffers.width * buffers.windows);
+    HostMsmBackend host;
+    ASSERT_TRUE(host.window_sums(buffers, sums.data()));
+    const Result<Point> sum = msm_combine(buffers, sums.data(), points[0]);
+    ASSERT_TRUE(sum.ok());
+    EXPECT_EQ(*sum, multi_scalar_mul(scalars, points));
+    sums[0] ^= 1;
+    sums[2 * buffers.width] = 1;
+    EXPECT_TRUE(msm_combine(buffers, sums.data(), points[0]).status() == Status::not_on_curve);
+}
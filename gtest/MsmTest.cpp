@@ -0,0 +1,183 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "msm.h"
+
+static const integer SECP256K1_P("fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f", 16);
+
+// against one scalar multiplication per term: Strauss below the threshold,
+// Pippenger above it, with negative, zero and repeated terms
+TEST(MsmTest, MatchesTermByTermSums) {
+    const FieldElement a(0, SECP256K1_P), b(7, SECP256K1_P);
+    const Point g(FieldElement(integer("79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798", 16), SECP256K1_P),
+                  FieldElement(integer("483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8", 16), SECP256K1_P), a, b);
+    const integer n("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141", 16);
+
+    std::vector<Point> points;
+    std::vector<integer> scalars;
+    Point q = g;
+    integer k("b7e151628aed2a6abf7158809cf4f3c762e7160f38b4da56a784d9045190cfef", 16);
+    for (std::size_t i = 0; i < MSM_STRAUSS_MAX + 6; i++) {
+        points.push_back(q);
+        scalars.push_back(i % 5 == 3 ? -k : k);
+        q = q.dbl() + g;
+        k = (k * k + 7) % n;
+    }
+    scalars[4] = 0;
+    points[7] = points[8];
+    points[9] = Point(a, b);
+
+    for (std::size_t count : {std::size_t(1), std::size_t(5), MSM_STRAUSS_MAX + 6}) {
+        const std::vector<Point> p(points.begin(), points.begin() + count);
+        const std::vector<integer> s(scalars.begin(), scalars.begin() + count);
+        Point expected(a, b);
+        for (std::size_t i = 0; i < count; i++) {
+            expected += p[i].mul(s[i]);
+        }
+        EXPECT_EQ(multi_scalar_mul(s, p), expected) << count;
+        EXPECT_EQ(multi_scalar_mul(s, p, 3), expected) << count;
+        EXPECT_EQ(Point::mul_sum(s, p), expected) << count;
+    }
+}
+
+TEST(MsmTest, PippengerWindows) {
+    const FieldElement a(0, SECP256K1_P), b(7, SECP256K1_P);
+    const Point g(FieldElement(integer("79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798", 16), SECP256K1_P),
+                  FieldElement(integer("483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8", 16), SECP256K1_P), a, b);
+    std::vector<Point> points;
+    std::vector<integer> scalars;
+    Point expected(a, b);
+    integer k("243f6a8885a308d313198a2e03707344a4093822299f31d0082efa98ec4e6c89", 16);
+    for (int i = 1; i <= 12; i++) {
+        points.push_back(g * integer(i * i + 1));
+        scalars.push_back(i % 3 ? k : -k);
+        expected += points.back() * scalars.back();
+        k = k * k >> 256;
+    }
+    // all-ones windows carry through every digit
+    points.push_back(g.dbl());
+    scalars.push_back((integer(1) << 255) - 1);
+    expected += points.back() * scalars.back();
+    for (std::size_t c = 1; c <= 10; c++) {
+        EXPECT_EQ(pippenger(scalars, points, c), expected) << c;
+        EXPECT_EQ(pippenger(scalars, points, c, 4), expected) << c;
+    }
+
+    // windows split across point ranges, on the caller's executor
+    std::size_t tasks = 0;
+    const msm_executor serial = [&tasks](std::size_t count, const std::function<void(std::size_t)>& task) {
+        for (std::size_t i = count; i > 0; i--) {
+            task(i - 1);
+        }
+        tasks += count;
+    };
+    EXPECT_EQ(pippenger(scalars, points, 2, serial, 1000), expected);
+    EXPECT_EQ(tasks, std::size_t(1 + 128 * 3));
+    EXPECT_EQ(pippenger(scalars, points, 2, thread_executor(3), 1000), expected);
+    EXPECT_EQ(multi_scalar_mul(scalars, points, serial, 32), expected);
+
+    // larger windows pay off with more points
+    EXPECT_LE(pippenger_window(64, 256), pippenger_window(1024, 256));
+    EXPECT_LE(pippenger_window(1024, 256), pippenger_window(1 << 16, 256));
+
+    EXPECT_THROW(pippenger(scalars, points, 0), std::invalid_argument);
+    EXPECT_THROW(pippenger(scalars, points, 25), std::invalid_argument);
+    EXPECT_THROW(multi_scalar_mul({}, {}), std::invalid_argument);
+    EXPECT_THROW(multi_scalar_mul({1, 2}, {g}), std::invalid_argument);
+    EXPECT_THROW(Point::mul_sum({1}, {g, g}), std::invalid_argument);
+    const std::vector<Point> mixed = {g, Point(a, FieldElement(5, SECP256K1_P))};
+    EXPECT_THROW(multi_scalar_mul({1, 2}, mixed), std::runtime_error);
+    EXPECT_THROW(pippenger({1, 2}, mixed, 3, thread_executor(2), 2), std::runtime_error);
+    EXPECT_THROW(pippenger_sorted({1, 2}, mixed, 3, thread_executor(2), 2), std::runtime_error);
+}
+
+// buckets filled in bucket order: runs long enough for several rounds and
+// groups, repeated and opposite points that batch_add hands to add(), and
+// the point at infinity
+TEST(MsmTest, SortedBuckets) {
+    const FieldElement a(0, SECP256K1_P), b(7, SECP256K1_P);
+    const Point g(FieldElement(integer("79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798", 16), SECP256K1_P),
+                  FieldElement(integer("483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8", 16), SECP256K1_P), a, b);
+    const integer n("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141", 16);
+    std::vector<Point> points(1, g);
+    std::vector<integer> scalars;
+    integer k("452821e638d01377be5466cf34e90c6cc0ac29b7c97c50dd3f84d5b5b5470917", 16);
+    for (std::size_t i = 0; i < 3 * MSM_SORTED_GROUP; i++) {
+        if (i > 0) {
+            points.push_back(points.back() + g);
+        }
+        scalars.push_back(i % 7 == 2 ? -k : k);
+        k = (k * k + 3) % n;
+    }
+    points[10] = points[11];
+    scalars[10] = scalars[11];
+    points[20] = -points[21];
+    scalars[20] = scalars[21];
+    points[30] = Point(a, b);
+    scalars[40] = 0;
+    for (std::size_t c : {std::size_t(1), std::size_t(3), std::size_t(8)}) {
+        const Point expected = pippenger(scalars, points, c);
+        EXPECT_EQ(pippenger_sorted(scalars, points, c), expected) << c;
+        EXPECT_EQ(pippenger_sorted(scalars, points, c, thread_executor(4), 200), expected) << c;
+    }
+    // small sums, where every bucket holds one point or none
+    const std::vector<Point> few(points.begin(), points.begin() + 5);
+    const std::vector<integer> some(scalars.begin(), scalars.begin() + 5);
+    EXPECT_EQ(pippenger_sorted(some, few, 10), pippenger(some, few, 10));
+    EXPECT_EQ(multi_scalar_mul(scalars, points), pippenger(scalars, points, 8));
+    EXPECT_THROW(pippenger_sorted(some, points, 4), std::invalid_argument);
+    EXPECT_THROW(pippenger_sorted(some, few, 25), std::invalid_argument);
+}
+
+TEST(MsmTest, FixedBase) {
+    const FieldElement a(0, SECP256K1_P), b(7, SECP256K1_P);
+    const Point g(FieldElement(integer("79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798", 16), SECP256K1_P),
+                  FieldElement(integer("483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8", 16), SECP256K1_P), a, b);
+    std::vector<Point> points;
+    std::vector<integer> scalars;
+    integer k("243f6a8885a308d313198a2e03707344a4093822299f31d0082efa98ec4e6c89", 16);
+    for (int i = 1; i <= 40; i++) {
+        points.push_back(g * integer(i * i + 1));
+        scalars.push_back(i % 3 ? k : -k);
+        k = (k * k + 11) % (integer(1) << 256);
+    }
+    points[5] = Point(a, b);
+    scalars[6] = 0;
+    scalars[7] = (integer(1) << 256) - 1;
+
+    for (std::size_t c : {std::size_t(0), std::size_t(1), std::size_t(5), std::size_t(8)}) {
+        const FixedBaseMsm msm(points, 256, c, 2);
+        EXPECT_EQ(msm.size(), points.size());
+        for (std::size_t count : {std::size_t(1), std::size_t(9), points.size()}) {
+            const std::vector<integer> s(scalars.begin(), scalars.begin() + count);
+            const std::vector<Point> p(points.begin(), points.begin() + count);
+            EXPECT_EQ(msm.mul(s), Point::mul_sum(s, p)) << c << " " << count;
+            EXPECT_EQ(msm.mul(s, 3), Point::mul_sum(s, p)) << c << " " << count;
+        }
+    }
+    EXPECT_LE(fixed_base_window(64, 256), fixed_base_window(4096, 256));
+
+    // every stride, over a slice of the points
+    const std::vector<integer> s(scalars.begin() + 8, scalars.begin() + 30);
+    const std::vector<Point> p(points.begin() + 8, points.begin() + 30);
+    for (std::size_t stride : {std::size_t(1), std::size_t(2), std::size_t(3), std::size_t(8), std::size_t(100)}) {
+        const FixedBaseMsm msm(points.data() + 8, p.size(), 256, 0, 2, stride);
+        EXPECT_EQ(msm.stride(), stride);
+        EXPECT_EQ(msm.table_size(), p.size() * ((256 / msm.window() + stride) / stride));
+        EXPECT_EQ(msm.mul(s), Point::mul_sum(s, p)) << stride;
+        EXPECT_EQ(msm.mul(s, 3), Point::mul_sum(s, p)) << stride;
+    }
+
+    const FixedBaseMsm msm(points, 256);
+    EXPECT_THROW(msm.mul({}), std::invalid_argument);
+    EXPECT_THROW(msm.mul(std::vector<integer>(41, 1)), std::invalid_argument);
+    EXPECT_THROW(msm.mul({integer(1) << 256}), std::invalid_argument);
+    EXPECT_THROW(FixedBaseMsm({}, 256), std::invalid_argument);
+    EXPECT_THROW(FixedBaseMsm(points, 256, 25), std::invalid_argument);
+    EXPECT_THROW(FixedBaseMsm(points, 256, 4, 1, 0), std::invalid_argument);
+}
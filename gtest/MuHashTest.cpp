@@ -0,0 +1,123 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "chacha20.h"
+#include "muhash.h"
+#include "test_hex.h"
+
+static integer prime() {
+    return (integer(1) << std::size_t(3072)) - integer(1103717);
+}
+
+static Num3072 random_num(ChaCha20Rng& rng) {
+    uint8_t bytes[Num3072::BYTE_SIZE];
+    rng.fill(bytes, sizeof(bytes));
+    return Num3072::from_bytes(bytes);
+}
+
+TEST(MuHashTest, Num3072MatchesInteger) {
+    uint8_t seed[ChaCha20Rng::SEED_SIZE] = {1};
+    ChaCha20Rng rng(seed);
+    const integer p = prime();
+    for (int i = 0; i < 20; i++) {
+        const Num3072 a = random_num(rng), b = random_num(rng);
+        const integer x = a.value().to_integer(), y = b.value().to_integer();
+        EXPECT_EQ((a * b).value().to_integer(), x * y % p);
+        EXPECT_EQ(a.square().value().to_integer(), x * x % p);
+        EXPECT_TRUE(a * a.inverse() == Num3072());
+    }
+    // the top of the range, where the folds carry: (p - 1)^2 = 1
+    uint8_t bytes[Num3072::BYTE_SIZE];
+    uint3072::from_integer(p - integer(1)).store_le(bytes, sizeof(bytes));
+    const Num3072 minus_one = Num3072::from_bytes(bytes);
+    EXPECT_TRUE(minus_one * minus_one == Num3072());
+    EXPECT_TRUE(minus_one.square() == Num3072());
+    EXPECT_TRUE(minus_one.inverse() == minus_one);
+    // values of p and above are taken mod p
+    uint3072::from_integer(p + integer(5)).store_le(bytes, sizeof(bytes));
+    EXPECT_EQ(Num3072::from_bytes(bytes).value().to_integer(), integer(5));
+    uint3072::from_integer(p).store_le(bytes, sizeof(bytes));
+    EXPECT_TRUE(Num3072::from_bytes(bytes).value().is_zero());
+    EXPECT_TRUE(Num3072::from_bytes(bytes).inverse().value().is_zero());
+}
+
+TEST(MuHashTest, BitcoinCoreVector) {
+    // src/test/crypto_tests.cpp muhash_tests: FromInt(i) is 32 bytes with i first
+    uint8_t items[3][32] = {{0}, {1}, {2}};
+    MuHash3072 acc(items[0], 32);
+    acc *= MuHash3072(items[1], 32);
+    acc /= MuHash3072(items[2], 32);
+    uint8_t out[MuHash3072::DIGEST_SIZE];
+    acc.finalize(out);
+    // uint256 hex shows the bytes last to first
+    std::reverse(out, out + sizeof(out));
+    EXPECT_EQ(hex(out, sizeof(out)), "10d312b100cbd32ada024a6646e40d3482fcff103668d2625f10002a607d5863");
+}
+
+TEST(MuHashTest, SetSemantics) {
+    std::vector<std::string> items;
+    for (int i = 0; i < 40; i++) {
+        items.push_back("item " + std::to_string(i));
+    }
+    const auto bytes = [](const std::string& s) { return reinterpret_cast<const uint8_t*>(s.data()); };
+    uint8_t forward[32], backward[32], empty[32], check[32];
+    MuHash3072 a, b;
+    for (std::size_t i = 0; i < items.size(); i++) {
+        a.insert(bytes(items[i]), items[i].size());
+        const std::string& r = items[items.size() - 1 - i];
+        b.insert(bytes(r), r.size());
+    }
+    a.finalize(forward);
+    b.finalize(backward);
+    EXPECT_EQ(hex(forward, 32), hex(backward, 32));
+    MuHash3072().finalize(empty);
+    EXPECT_NE(hex(forward, 32), hex(empty, 32));
+
+    // removals, before or after the insertions, undo them
+    MuHash3072 c;
+    for (const std::string& s : items) {
+        c.remove(bytes(s), s.size());
+    }
+    c *= a;
+    c.finalize(check);
+    EXPECT_EQ(hex(check, 32), hex(empty, 32));
+    MuHash3072 d = a;
+    d /= b;
+    d.finalize(check);
+    EXPECT_EQ(hex(check, 32), hex(empty, 32));
+    // a multiset: the same item twice is not the item once
+    MuHash3072 twice(bytes(items[0]), items[0].size()), once = twice;
+    twice.insert(bytes(items[0]), items[0].size());
+    twice.finalize(check);
+    once.finalize(forward);
+    EXPECT_NE(hex(check, 32), hex(forward, 32));
+
+    // parallel parts multiply to the same state
+    for (unsigned threads : {1u, 3u, 8u, 64u}) {
+        MuHash3072::of(items, threads).finalize(check);
+        EXPECT_EQ(hex(check, 32), hex(backward, 32)) << threads;
+    }
+    MuHash3072::of({}, 4).finalize(check);
+    EXPECT_EQ(hex(check, 32), hex(empty, 32));
+}
+
+TEST(MuHashTest, Serialize) {
+    MuHash3072 h;
+    h.insert(reinterpret_cast<const uint8_t*>("abc"), 3).remove(reinterpret_cast<const uint8_t*>("de"), 2);
+    uint8_t state[MuHash3072::STATE_SIZE], a[32], b[32];
+    h.serialize(state);
+    const Result<MuHash3072> r = MuHash3072::deserialize(state, sizeof(state));
+    ASSERT_TRUE(r.ok());
+    h.finalize(a);
+    r->finalize(b);
+    EXPECT_EQ(hex(a, 32), hex(b, 32));
+    EXPECT_TRUE(MuHash3072::deserialize(state, sizeof(state) - 1).status() == Status::bad_encoding);
+    uint3072::from_integer(prime()).store_le(state + Num3072::BYTE_SIZE, Num3072::BYTE_SIZE);
+    EXPECT_TRUE(MuHash3072::deserialize(state, sizeof(state)).status() == Status::out_of_range);
+}
@@ -0,0 +1,225 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Curve.h"
+#include "musig.h"
+#include "schnorr.h"
+#include "sec1.h"
+#include "test_hex.h"
+
+namespace {
+
+// the secret 7919 i + 1 in 32 bytes and its compressed key
+struct Signer {
+    uint8_t secret[32] = {0};
+    uint8_t key[33];
+
+    explicit Signer(std::size_t i) {
+        const integer d = integer(i) * 7919 + 1;
+        d.to_bytes(this->secret, 32);
+        sec1_encode(Curve::secp256k1().mul_base(d), true, this->key, 33);
+    }
+};
+
+// one MuSig2 signing of message by signers under agg: the BIP340 signature,
+// each cosigner's contribution checked one by one and in a batch
+std::vector<uint8_t> sign_all(const std::vector<Signer>& signers, const MusigKeyAgg& agg, const std::string& message) {
+    const auto* m = reinterpret_cast<const uint8_t*>(message.data());
+    const std::size_t count = signers.size();
+    std::vector<uint8_t> secnonces(MUSIG_SECNONCE_SIZE * count), pubnonces(MUSIG_PUBNONCE_SIZE * count);
+    uint8_t qx[32];
+    agg.x_only(qx);
+    for (std::size_t i = 0; i < count; i++) {
+        uint8_t rand[32] = {static_cast<uint8_t>(i), 0x5a};
+        EXPECT_TRUE(musig_nonce_gen(&secnonces[MUSIG_SECNONCE_SIZE * i], &pubnonces[MUSIG_PUBNONCE_SIZE * i], rand,
+                                    signers[i].secret, signers[i].key, qx, m, message.size(), nullptr, 0)
+                    == Status::ok);
+    }
+    uint8_t aggnonce[66];
+    EXPECT_TRUE(musig_nonce_agg(aggnonce, pubnonces.data(), count) == Status::ok);
+    const Result<MusigSession> session = MusigSession::start(agg, aggnonce, m, message.size());
+    EXPECT_TRUE(session.ok());
+
+    std::vector<uint8_t> partials(32 * count);
+    std::vector<MusigPartial> contributions;
+    for (std::size_t i = 0; i < count; i++) {
+        EXPECT_TRUE(session->sign(&partials[32 * i], &secnonces[MUSIG_SECNONCE_SIZE * i], signers[i].secret)
+                    == Status::ok);
+        contributions.push_back({&partials[32 * i], &pubnonces[MUSIG_PUBNONCE_SIZE * i], signers[i].key});
+        EXPECT_TRUE(session->verify(contributions.back()) == Status::ok) << i;
+    }
+    EXPECT_TRUE(session->verify_batch(contributions) == Status::ok);
+
+    // a bad contribution fails the batch and is named
+    if (count > 1) {
+        partials[32 * (count - 1) + 31] ^= 1;
+        std::size_t culprit = 0;
+        EXPECT_TRUE(session->verify_batch(contributions, 1, &culprit) == Status::bad_signature);
+        EXPECT_EQ(culprit, count - 1);
+        partials[32 * (count - 1) + 31] ^= 1;
+    }
+    // a secret nonce signs once
+    uint8_t again[32];
+    EXPECT_TRUE(session->sign(again, &secnonces[0], signers[0].secret) == Status::out_of_range);
+
+    std::vector<uint8_t> signature(64);
+    EXPECT_TRUE(session->aggregate(signature.data(), partials.data(), count) == Status::ok);
+    EXPECT_TRUE(schnorr_verify(signature.data(), m, message.size(), qx) == Status::ok);
+    return signature;
+}
+
+}
+
+// the KeyAgg vectors of BIP327
+TEST(MusigTest, KeyAggVectors) {
+    const std::vector<uint8_t> pk = unhex("02F9308A019258C31049344F85F89D5229B531C845836F99B08601F113BCE036F9"
+                                          "03DFF1D77F2A671C5F36183726DB2341BE58FEAE1DA2DECED843240F7B502BA659"
+                                          "023590A94E768F8E1815C2F24B4D80A8E3149316C3518CE7B7AD338368D038CA66");
+    const struct {
+        std::vector<int> indices;
+        std::string expected;
+    } vectors[] = {
+            {{0, 1, 2}, "90539EEDE565F5D054F32CC0C220126889ED1E5D193BAF15AEF344FE59D4610C"},
+            {{2, 1, 0}, "6204DE8B083426DC6EAF9502D27024D53FC826BF7D2012148A0575435DF54B2B"},
+            {{0, 0, 0}, "B436E3BAD62B8CD409969A224731C193D051162D8C5AE8B109306127DA3AA935"},
+            {{0, 0, 1, 1}, "69BC22BFA5D106306E48A20679DE1D7389386124D07571D0D872686028C26A3E"},
+    };
+    for (const auto& v : vectors) {
+        std::vector<uint8_t> keys;
+        for (int i : v.indices) {
+            keys.insert(keys.end(), pk.begin() + 33 * i, pk.begin() + 33 * (i + 1));
+        }
+        const Result<MusigKeyAgg> agg = MusigKeyAgg::aggregate(keys.data(), v.indices.size());
+        ASSERT_TRUE(agg.ok());
+        uint8_t x[32];
+        agg->x_only(x);
+        EXPECT_EQ(std::vector<uint8_t>(x, x + 32), unhex(v.expected)) << v.expected;
+        EXPECT_EQ(agg->size(), v.indices.size());
+    }
+
+    // a key with a bad prefix, and no keys
+    std::vector<uint8_t> keys(pk.begin(), pk.end());
+    keys[33] = 0x04;
+    EXPECT_TRUE(MusigKeyAgg::aggregate(keys.data(), 3).status() == Status::not_on_curve);
+    EXPECT_THROW(MusigKeyAgg::aggregate(keys.data(), 0), std::invalid_argument);
+}
+
+TEST(MusigTest, SignAndAggregate) {
+    for (std::size_t count : {1, 3, 40}) {
+        std::vector<Signer> signers;
+        std::vector<uint8_t> keys;
+        for (std::size_t i = 0; i < count; i++) {
+            signers.emplace_back(i);
+            keys.insert(keys.end(), signers.back().key, signers.back().key + 33);
+        }
+        const Result<MusigKeyAgg> agg = MusigKeyAgg::aggregate(keys.data(), count, 2);
+        ASSERT_TRUE(agg.ok());
+        sign_all(signers, *agg, "message of " + std::to_string(count));
+
+        // a plain tweak then an x-only one, as BIP32 derivation then BIP341 would
+        uint8_t tweak[32];
+        for (std::size_t i = 0; i < 32; i++) {
+            tweak[i] = static_cast<uint8_t>(i + count);
+        }
+        const Result<MusigKeyAgg> plain = agg->tweak(tweak, false);
+        ASSERT_TRUE(plain.ok());
+        const Result<MusigKeyAgg> tweaked = plain->tweak(tweak, true);
+        ASSERT_TRUE(tweaked.ok());
+        EXPECT_FALSE(tweaked->point() == agg->point());
+        sign_all(signers, *tweaked, "tweaked");
+
+        uint8_t n[32];
+        Curve::secp256k1().n().to_bytes(n, 32);
+        EXPECT_TRUE(agg->tweak(n, true).status() == Status::out_of_range);
+    }
+}
+
+TEST(MusigTest, BadContributions) {
+    std::vector<Signer> signers;
+    std::vector<uint8_t> keys;
+    for (std::size_t i = 0; i < 3; i++) {
+        signers.emplace_back(i);
+        keys.insert(keys.end(), signers.back().key, signers.back().key + 33);
+    }
+    const Result<MusigKeyAgg> agg = MusigKeyAgg::aggregate(keys.data(), 3);
+    ASSERT_TRUE(agg.ok());
+
+    std::vector<uint8_t> secnonces(3 * MUSIG_SECNONCE_SIZE), pubnonces(3 * MUSIG_PUBNONCE_SIZE);
+    for (std::size_t i = 0; i < 3; i++) {
+        const uint8_t rand[32] = {static_cast<uint8_t>(i + 1)};
+        ASSERT_TRUE(musig_nonce_gen(&secnonces[MUSIG_SECNONCE_SIZE * i], &pubnonces[MUSIG_PUBNONCE_SIZE * i], rand,
+                                    nullptr, signers[i].key, nullptr, nullptr, 0, nullptr, 0) == Status::ok);
+    }
+    // a nonce with a bad prefix is named
+    std::vector<uint8_t> bad = pubnonces;
+    bad[MUSIG_PUBNONCE_SIZE + 33] = 0x05;
+    uint8_t aggnonce[66];
+    std::size_t culprit = 9;
+    EXPECT_TRUE(musig_nonce_agg(aggnonce, bad.data(), 3, &culprit) == Status::not_on_curve);
+    EXPECT_EQ(culprit, 1u);
+
+    ASSERT_TRUE(musig_nonce_agg(aggnonce, pubnonces.data(), 3) == Status::ok);
+    const Result<MusigSession> session = MusigSession::start(*agg, aggnonce, nullptr, 0);
+    ASSERT_TRUE(session.ok());
+    // a signer not of the key set, and a secret nonce of another key
+    const Signer outsider(100);
+    uint8_t partial[32];
+    std::vector<uint8_t> stranger(secnonces.begin(), secnonces.begin() + MUSIG_SECNONCE_SIZE);
+    std::copy(outsider.key, outsider.key + 33, stranger.begin() + 64);
+    EXPECT_TRUE(session->sign(partial, stranger.data(), outsider.secret) == Status::out_of_range);
+    EXPECT_TRUE(session->sign(partial, &secnonces[MUSIG_SECNONCE_SIZE], signers[0].secret) == Status::out_of_range);
+
+    std::vector<uint8_t> partials(3 * 32);
+    std::vector<MusigPartial> contributions;
+    for (std::size_t i = 0; i < 3; i++) {
+        ASSERT_TRUE(session->sign(&partials[32 * i], &secnonces[MUSIG_SECNONCE_SIZE * i], signers[i].secret)
+                    == Status::ok);
+        contributions.push_back({&partials[32 * i], &pubnonces[MUSIG_PUBNONCE_SIZE * i], signers[i].key});
+    }
+    // another's key, a partial of n, and a partial signature that does not verify
+    contributions[0].public_key = signers[1].key;
+    EXPECT_TRUE(session->verify(contributions[0]) == Status::bad_signature);
+    EXPECT_TRUE(session->verify_batch(contributions, 1, &culprit) == Status::bad_signature);
+    EXPECT_EQ(culprit, 0u);
+    contributions[0].public_key = outsider.key;
+    EXPECT_TRUE(session->verify_batch(contributions, 1, &culprit) == Status::out_of_range);
+    contributions[0].public_key = signers[0].key;
+    Curve::secp256k1().n().to_bytes(&partials[64], 32);
+    EXPECT_TRUE(session->verify_batch(contributions, 1, &culprit) == Status::bad_encoding);
+    EXPECT_EQ(culprit, 2u);
+    uint8_t signature[64];
+    EXPECT_TRUE(session->aggregate(signature, partials.data(), 3, &culprit) == Status::bad_encoding);
+    EXPECT_EQ(culprit, 2u);
+}
+
+TEST(MusigTest, KeyAggCache) {
+    std::vector<uint8_t> keys;
+    for (std::size_t i = 0; i < 50; i++) {
+        const Signer s(i);
+        keys.insert(keys.end(), s.key, s.key + 33);
+    }
+    MusigKeyAggCache cache(2);
+    const Result<MusigKeyAgg> first = cache.aggregate(keys.data(), 50);
+    ASSERT_TRUE(first.ok());
+    const Result<MusigKeyAgg> again = cache.aggregate(keys.data(), 50);
+    ASSERT_TRUE(again.ok());
+    EXPECT_TRUE(again->point() == first->point());
+    EXPECT_TRUE(MusigKeyAgg::aggregate(keys.data(), 50)->point() == first->point());
+    // the first 49 keys, then the first 48: the full set is evicted
+    ASSERT_TRUE(cache.aggregate(keys.data(), 49).ok());
+    ASSERT_TRUE(cache.aggregate(keys.data(), 48).ok());
+    ASSERT_TRUE(cache.aggregate(keys.data(), 50).ok());
+    const MusigKeyAggCache::Stats stats = cache.stats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 4u);
+    EXPECT_EQ(stats.entries, 2u);
+    cache.clear();
+    EXPECT_EQ(cache.stats().entries, 0u);
+    EXPECT_THROW(MusigKeyAggCache(0), std::invalid_argument);
+}
@@ -0,0 +1,65 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "natural.h"
+
+static integer random_value(std::mt19937_64& random, std::size_t bits) {
+    std::vector<uint8_t> bytes((bits + 7) / 8);
+    for (uint8_t& b : bytes) {
+        b = static_cast<uint8_t>(random());
+    }
+    return integer::from_bytes(bytes.data(), bytes.size(), integer::endian::big);
+}
+
+TEST(NaturalTest, MatchesInteger) {
+    std::mt19937_64 random(5);
+    for (std::size_t bits : {64, 200, 1000, 4000}) {
+        const integer x = random_value(random, bits), y = random_value(random, bits / 2) + 1;
+        const natural a(x), b(y);
+        EXPECT_EQ((a + b).value(), x + y);
+        EXPECT_EQ((a - b).value(), x - y);
+        EXPECT_EQ((a * b).value(), x * y);
+        EXPECT_EQ((a / b).value(), x / y);
+        EXPECT_EQ((a % b).value(), x % y);
+        EXPECT_EQ((b % a).value(), y);
+        EXPECT_EQ(a.square().value(), x * x);
+        EXPECT_EQ((a << 70).value(), x << 70);
+        EXPECT_EQ((a >> 70).value(), x >> 70);
+        EXPECT_EQ(a.compare(b), x.compare(y));
+        EXPECT_EQ(b.compare(a), y.compare(x));
+        EXPECT_TRUE(b < a);
+        natural c = a;
+        c += c;
+        EXPECT_EQ(c.value(), x + x);
+        c -= c;
+        EXPECT_TRUE(c.is_zero());
+    }
+}
+
+// no value goes below 0: subtraction throws rather than wrap, except modulo m
+TEST(NaturalTest, UnderflowAndModularWrap) {
+    EXPECT_THROW(natural(integer(-1)), std::domain_error);
+    natural a(5);
+    EXPECT_THROW(a -= natural(6), std::domain_error);
+    EXPECT_EQ(a, natural(5));
+    EXPECT_THROW(a / natural(), std::domain_error);
+    EXPECT_THROW(a % natural(), std::domain_error);
+
+    const integer m = (integer(1) << 521) - 1;
+    const natural x(m - 3), y(integer(10));
+    natural s = x;
+    s.add_mod(y, m);
+    EXPECT_EQ(s.value(), 7);
+    s.sub_mod(y, m);
+    EXPECT_EQ(s, x);
+    natural t = y;
+    t.sub_mod(x, m);
+    EXPECT_EQ(t.value(), 13);
+    t.sub_mod(t, m);
+    EXPECT_TRUE(t.is_zero());
+}
@@ -0,0 +1,60 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <atomic>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Curve.h"
+#include "Executor.h"
+#include "numa.h"
+
+TEST(NumaTest, ParseCpulist) {
+    EXPECT_EQ(parse_cpulist("0-3,8,10-11\n"), (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(parse_cpulist("5"), std::vector<int>{5});
+    EXPECT_TRUE(parse_cpulist("").empty());
+    EXPECT_TRUE(parse_cpulist("3-1").empty());
+    EXPECT_TRUE(parse_cpulist("a").empty());
+    EXPECT_TRUE(parse_cpulist("1-").empty());
+    EXPECT_TRUE(parse_cpulist("1;2").empty());
+}
+
+TEST(NumaTest, Topology) {
+    const NumaTopology two({{0, 1, 2, 3}, {}, {4, 5}});
+    EXPECT_EQ(two.node_count(), 2u);
+    EXPECT_EQ(two.node_of(1), 0u);
+    EXPECT_EQ(two.node_of(5), 1u);
+    EXPECT_EQ(two.node_of(99), 0u);
+    EXPECT_EQ(two.spread(5), (std::vector<int>{0, 4, 1, 5, 2}));
+    EXPECT_EQ(two.spread(8), (std::vector<int>{0, 4, 1, 5, 2, 4, 3, 5}));
+
+    const NumaTopology& system = NumaTopology::system();
+    ASSERT_GE(system.node_count(), 1u);
+    EXPECT_LT(system.current_node(), system.node_count());
+    for (std::size_t node = 0; node < system.node_count(); node++) {
+        EXPECT_FALSE(system.node_cpus(node).empty());
+        for (int cpu : system.node_cpus(node)) {
+            EXPECT_EQ(system.node_of(cpu), node);
+        }
+    }
+}
+
+// a replica multiplies as the table it came from, and the pool placed by
+// spread runs every task
+TEST(NumaTest, ReplicasAndPlacement) {
+    const Curve& curve = Curve::p256();
+    const FixedBaseTable replica = curve.generator_table().replicate();
+    EXPECT_EQ(replica.size(), curve.generator_table().size());
+    const integer k("c9afa9d845ba75166b5c215767b1d6934e50c3db36e89b127b8a622b120f6721", 16);
+    EXPECT_EQ(replica.mul(k), curve.mul_base(k));
+    EXPECT_EQ(replica.mul_ct(k), curve.generator_table().mul_ct(k));
+
+    WorkStealingPool pool(4, NumaTopology::system().spread(4));
+    std::atomic<int> hits(0);
+    pool.run(1000, [&](std::size_t) {
+        if (curve.generator_table().mul(integer(3)) == curve.generator().dbl() + curve.generator()) {
+            hits++;
+        }
+    });
+    EXPECT_EQ(hits.load(), 1000);
+}
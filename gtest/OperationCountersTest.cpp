@@ -0,0 +1,40 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <thread>
+#include "gtest/gtest.h"
+#include "FieldElement.h"
+#include "OperationCounters.h"
+
+TEST(OperationCountersTest, CountsWhenCompiledIn) {
+    const integer big = (integer(1) << 2000) - 1;
+    FieldElement a(3, 31), b(24, 31);
+
+    OperationCounters::reset();
+    integer product = big * big;
+    FieldElement c = a * b + a;
+    c /= b;
+    c = c.power(5);
+    OperationCounters counts = OperationCounters::snapshot();
+
+#ifdef ECC_COUNTERS
+    EXPECT_GE(counts.integer_mul, 1u);
+    EXPECT_GE(counts.allocations, 1u);
+    EXPECT_GE(counts.allocated_bytes, 500u);
+    EXPECT_EQ(counts.field_add, 1u);
+    EXPECT_GE(counts.field_mul, 2u);
+    EXPECT_EQ(counts.field_inv, 1u);
+    EXPECT_EQ(counts.field_pow, 1u);
+
+    // counters are per thread
+    std::thread([]() {
+        EXPECT_EQ(OperationCounters::snapshot().field_mul, 0u);
+    }).join();
+#else
+    EXPECT_EQ(counts.integer_mul, 0u);
+    EXPECT_EQ(counts.field_mul, 0u);
+#endif
+    OperationCounters::reset();
+    EXPECT_EQ(OperationCounters::snapshot().field_inv, 0u);
+    EXPECT_EQ(product % big, 0);
+}
@@ -0,0 +1,58 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include "gtest/gtest.h"
+#include "Curve.h"
+#include "FieldElement.h"
+#include "p256.h"
+#include "test_arith.h"
+
+TEST(P256Test, SolinasReductionMatchesIntegerModulus) {
+    const integer p = P256_FIELD_P.to_integer();
+    const uint512 all_ones = ~uint512::zero();
+    EXPECT_EQ(p256_reduce_p(all_ones).to_integer(), all_ones.to_integer() % p);
+    EXPECT_EQ(p256_reduce_p(P256_FIELD_P.resize<8>()).to_integer(), 0);
+    EXPECT_EQ(p256_reduce_p(uint512::zero()).to_integer(), 0);
+
+    // (p - 1)^2, and words that are all ones where the sum adds and zero where
+    // it subtracts, and the other way round: the ends of the carry range
+    const uint256 p1 = P256_FIELD_P - uint256(1);
+    EXPECT_EQ(p256_reduce_p(uint256::mul_wide(p1, p1)).to_integer(), (p - 1) * (p - 1) % p);
+    for (limb_t mask : {limb_t(0xFFFFFFFF00000000), limb_t(0x00000000FFFFFFFF)}) {
+        uint512 x;
+        for (std::size_t i = 0; i < 8; i++) {
+            x.limb[i] = i % 2 ? mask : ~mask;
+        }
+        EXPECT_EQ(p256_reduce_p(x).to_integer(), x.to_integer() % p);
+    }
+    for (limb_t seed = 1; seed < 200; seed++) {
+        const uint512 x = pattern512(seed);
+        EXPECT_EQ(p256_reduce_p(x).to_integer(), x.to_integer() % p);
+    }
+}
+
+TEST(P256Test, CurveFieldTakesTheReduction) {
+    const Curve& curve = Curve::p256();
+    EXPECT_EQ(curve.field().fold(), &p256_reduce_p);
+    const Point& g = curve.generator();
+    const integer x = g.x().value(), y = g.y().value();
+    EXPECT_EQ((g.x() * g.y()).value(), x * y % curve.p());
+    EXPECT_EQ(g.y().square(), g.x().square() * g.x() + curve.a() * g.x() + curve.b());
+    EXPECT_TRUE(curve.mul_base(curve.n() - 1) == -g);
+}
+
+TEST(P256Test, OrderReductionMatchesIntegerModulus) {
+    const integer n = P256_ORDER_N.to_integer();
+    EXPECT_EQ(n, Curve::p256().n());
+    EXPECT_EQ(Curve::p256().scalar_field().fold(), &p256_reduce_n);
+    const uint512 all_ones = ~uint512::zero();
+    EXPECT_EQ(p256_reduce_n(all_ones).to_integer(), all_ones.to_integer() % n);
+    EXPECT_EQ(p256_reduce_n(P256_ORDER_N.resize<8>()).to_integer(), 0);
+    const uint256 n1 = P256_ORDER_N - uint256(1);
+    EXPECT_EQ(p256_reduce_n(uint256::mul_wide(n1, n1)).to_integer(), (n - 1) * (n - 1) % n);
+    for (limb_t seed = 1; seed < 200; seed++) {
+        const uint512 x = pattern512(seed);
+        EXPECT_EQ(p256_reduce_n(x).to_integer(), x.to_integer() % n);
+        EXPECT_EQ(p256_reduce_n(x >> 200).to_integer(), (x >> 200).to_integer() % n);
+    }
+}
@@ -0,0 +1,435 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <cstdlib>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "FixedBaseTable.h"
+#include "gtest/gtest.h"
+#include "modexp.h"
+#include "Point.h"
+
+static const integer SECP256K1_P("fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f", 16);
+
+// every sum of two points of y^2 = x^3 + ax + 3 over GF(97), against the affine
+// chord and tangent formulas, for the a = 0, a = -3 and generic doublings
+TEST(PointTest, MatchesAffineArithmeticOnSmallCurves) {
+    const integer p = 97;
+    for (int ca : {2, 0, 94}) {
+        const FieldElement a(ca, p), b(3, p);
+        const Point infinity(a, b);
+        std::vector<std::pair<integer, integer>> affine;
+        std::vector<Point> points;
+        for (int x = 0; x < 97; x++) {
+            for (int y = 0; y < 97; y++) {
+                if ((y * y - x * x * x - ca * x - 3) % 97 == 0) {
+                    affine.emplace_back(x, y);
+                    points.emplace_back(FieldElement(x, p), FieldElement(y, p), a, b);
+                }
+            }
+        }
+        ASSERT_FALSE(points.empty());
+
+        for (std::size_t i = 0; i < points.size(); i++) {
+            EXPECT_TRUE(points[i].is_normalized());
+            EXPECT_EQ(points[i] + infinity, points[i]);
+            EXPECT_EQ(infinity + points[i], points[i]);
+            EXPECT_TRUE((points[i] - points[i]).is_infinity());
+            EXPECT_EQ(points[i].dbl(), points[i] + points[i]);
+            for (std::size_t j = 0; j < points.size(); j++) {
+                const integer x1 = affine[i].first, y1 = affine[i].second;
+                const integer x2 = affine[j].first, y2 = affine[j].second;
+                const Point sum = points[i] + points[j];
+                if (x1 == x2 && (y1 + y2) % p == 0) {
+                    EXPECT_TRUE(sum.is_infinity());
+                    continue;
+                }
+                const integer l = (x1 == x2) ? (3 * x1 * x1 + ca) * (2 * y1).modinv(p) % p
+                                             : ((y2 - y1) % p + p) * ((x2 - x1) % p + p).modinv(p) % p;
+                const integer x3 = ((l * l - x1 - x2) % p + p) % p;
+                const integer y3 = ((l * (x1 - x3) - y1) % p + p) % p;
+                EXPECT_EQ(sum.x().value(), x3) << ca << " " << i << " " << j;
+                EXPECT_EQ(sum.y().value(), y3) << ca << " " << i << " " << j;
+                // Jacobian + Jacobian, and the Jacobian doublings
+                EXPECT_EQ(sum + sum, points[i].dbl() + points[j].dbl()) << ca << " " << i << " " << j;
+                EXPECT_EQ(sum.normalized().x().value(), x3);
+            }
+        }
+    }
+}
+
+TEST(PointTest, Secp256k1Multiples) {
+    const FieldElement a(0, SECP256K1_P), b(7, SECP256K1_P);
+    const Point g(FieldElement(integer("79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798", 16), SECP256K1_P),
+                  FieldElement(integer("483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8", 16), SECP256K1_P), a, b);
+    const Point g2 = g.dbl(), g3 = g2 + g;
+    EXPECT_EQ(g2.x().value(), integer("c6047f9441ed7d6d3045406e95c07cd85c778e4b8cef3ca7abac09b95c709ee5", 16));
+    EXPECT_EQ(g2.y().value(), integer("1ae168fea63dc339a3c58419466ceaeef7f632653266d0e1236431a950cfe52a", 16));
+    EXPECT_EQ(g3.x().value(), integer("f9308a019258c31049344f85f89d5229b531c845836f99b08601f113bce036f9", 16));
+    EXPECT_EQ(g3.y().value(), integer("388f7b0f632de8140fe337e62a37f3566500a99934c2231b6cb9fd7584b8e672", 16));
+    EXPECT_EQ(g3 - g, g2);
+    EXPECT_EQ(-g + g3, g2);
+    EXPECT_NE(g3, g2);
+    EXPECT_FALSE(g3.is_normalized());
+    EXPECT_TRUE(g3.normalized().is_normalized());
+    EXPECT_EQ(g3.normalized() + g2, g2.normalized() + g3);
+
+    // the same points with Montgomery-form coordinates
+    auto ctx = std::make_shared<const MontgomeryContext>(SECP256K1_P);
+    const Point gm(FieldElement(g.x().value(), ctx), FieldElement(g.y().value(), ctx), a, b);
+    EXPECT_EQ((gm.dbl() + gm).x().value(), g3.x().value());
+}
+
+TEST(PointTest, WnafScalarMultiplication) {
+    const FieldElement a(0, SECP256K1_P), b(7, SECP256K1_P);
+    const Point g(FieldElement(integer("79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798", 16), SECP256K1_P),
+                  FieldElement(integer("483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8", 16), SECP256K1_P), a, b);
+    const integer n("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141", 16);
+
+    // against repeated addition, from a Jacobian base as well as an affine one
+    Point expected(a, b);
+    const Point g2 = g.dbl();
+    for (int k = 0; k < 40; k++) {
+        for (std::size_t w = 2; w <= 8; w++) {
+            EXPECT_EQ(g.mul(k, w), expected) << k << " " << w;
+        }
+        EXPECT_EQ(g2 * integer(k), expected + expected) << k;
+        expected += g;
+    }
+    EXPECT_EQ(integer(-5) * g, -(g * integer(5)));
+
+    // the group order
+    EXPECT_TRUE((g * n).is_infinity());
+    EXPECT_EQ(g * (n - 1), -g);
+    const integer k("b7e151628aed2a6abf7158809cf4f3c762e7160f38b4da56a784d9045190cfef", 16);
+    EXPECT_EQ(g.mul(k, 4), g.mul(k, 6));
+    EXPECT_EQ(g.mul(k) + g.mul(n - k), Point(a, b));
+    EXPECT_EQ(g * (k + n), g * k);
+
+    // the GLV split on Montgomery-form coordinates, and from a Jacobian base
+    auto ctx = std::make_shared<const MontgomeryContext>(SECP256K1_P);
+    const Point gm(FieldElement(g.x().value(), ctx), FieldElement(g.y().value(), ctx), a, b);
+    EXPECT_EQ(gm.mul(k).x().value(), g.mul(k).x().value());
+    EXPECT_EQ(g2.mul(k), g.mul(k + k));
+
+    std::vector<Point> points = {g2, Point(a, b), g2 + g, g};
+    Point::batch_normalize(points);
+    EXPECT_TRUE(points[0].is_normalized() && points[2].is_normalized() && points[1].is_infinity());
+    EXPECT_EQ(points[2], g2 + g);
+
+    EXPECT_THROW(g.mul(k, 1), std::invalid_argument);
+    EXPECT_THROW(g.mul(k, 9), std::invalid_argument);
+}
+
+// every ordered pair of points of a GF(97) curve, plus the point at infinity
+// and a Jacobian operand, in one batch
+TEST(PointTest, BatchAffineAddition) {
+    const FieldElement a(2, 97), b(3, 97);
+    std::vector<Point> points = {Point(a, b)};
+    for (int x = 0; x < 97; x++) {
+        for (int y = 0; y < 97; y++) {
+            if ((y * y - x * x * x - 2 * x - 3) % 97 == 0) {
+                points.emplace_back(FieldElement(x, 97), FieldElement(y, 97), a, b);
+            }
+        }
+    }
+    points.push_back(points[5].dbl());
+    std::vector<Point> lhs, rhs, out;
+    for (const Point& p : points) {
+        for (const Point& q : points) {
+            lhs.push_back(p);
+            rhs.push_back(q);
+        }
+    }
+    Point::batch_add(lhs, rhs, out);
+    ASSERT_EQ(out.size(), lhs.size());
+    for (std::size_t i = 0; i < out.size(); i++) {
+        EXPECT_EQ(out[i], lhs[i] + rhs[i]) << lhs[i] << " + " << rhs[i];
+    }
+    const std::vector<Point> expected = out;
+    Point::batch_add(lhs, rhs, lhs);
+    EXPECT_TRUE(lhs == expected);
+
+    rhs.pop_back();
+    EXPECT_THROW(Point::batch_add(lhs, rhs, out), std::invalid_argument);
+    EXPECT_THROW(Point::batch_add({points[1]}, {Point(a, FieldElement(4, 97))}, out), std::runtime_error);
+}
+
+TEST(PointTest, ConstantTimeScalarMultiplication) {
+    const FieldElement a(0, SECP256K1_P), b(7, SECP256K1_P);
+    const Point g(FieldElement(integer("79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798", 16), SECP256K1_P),
+                  FieldElement(integer("483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8", 16), SECP256K1_P), a, b);
+    const integer n("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141", 16);
+    const integer k("b7e151628aed2a6abf7158809cf4f3c762e7160f38b4da56a784d9045190cfef", 16);
+    const Point q = g.dbl() + g;
+    for (const integer& e : {integer(0), integer(1), integer(17), k, n - 1, n, (integer(1) << 257) - 1}) {
+        EXPECT_EQ(g.mul_ct(e), g.mul(e)) << e;
+        EXPECT_EQ(q.mul_ct(e), q.mul(e)) << e;
+    }
+    EXPECT_TRUE(Point(a, b).mul_ct(k).is_infinity());
+
+    // a = -3, the generic complete formulas
+    const integer p256("ffffffff00000001000000000000000000000000ffffffffffffffffffffffff", 16);
+    const FieldElement a3(p256 - 3, p256);
+    const FieldElement b3(integer("5ac635d8aa3a93e7b3ebbd55769886bc651d06b0cc53b0f63bce3c3e27d2604b", 16), p256);
+    const Point g256(FieldElement(integer("6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296", 16), p256),
+                     FieldElement(integer("4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5", 16), p256),
+                     a3, b3);
+    const integer n256("ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551", 16);
+    EXPECT_EQ(g256.mul_ct(k), g256.mul(k));
+    EXPECT_TRUE(g256.mul_ct(n256).is_infinity());
+    EXPECT_EQ(g256.dbl().mul_ct(n256 - 1), -g256.dbl());
+
+    EXPECT_THROW(g.mul_ct(-1), std::invalid_argument);
+    EXPECT_THROW(g.mul_ct(integer(1) << 257), std::invalid_argument);
+}
+
+TEST(PointTest, DoubleScalarMultiplication) {
+    const FieldElement a(0, SECP256K1_P), b(7, SECP256K1_P);
+    const Point g(FieldElement(integer("79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798", 16), SECP256K1_P),
+                  FieldElement(integer("483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8", 16), SECP256K1_P), a, b);
+    const integer n("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141", 16);
+    const integer u1("b7e151628aed2a6abf7158809cf4f3c762e7160f38b4da56a784d9045190cfef", 16);
+    const integer u2("243f6a8885a308d313198a2e03707344a4093822299f31d0082efa98ec4e6c89", 16);
+    const Point q = g.mul(integer("9e3779b97f4a7c15f39cc0605cedc834", 16)).dbl();
+
+    const Point expected = g.mul(u1) + q.mul(u2);
+    for (std::size_t w = 2; w <= 8; w++) {
+        EXPECT_EQ(Point::mul_add(u1, g, u2, q, w), expected) << w;
+    }
+    EXPECT_EQ(Point::mul_add(-u1, g, u2, q), q.mul(u2) - g.mul(u1));
+    EXPECT_EQ(Point::mul_add(u1, g, n - u1, g), Point(a, b));
+    EXPECT_EQ(Point::mul_add(0, g, u2, q), q.mul(u2));
+    EXPECT_EQ(Point::mul_add(u1, g, u2, Point(a, b)), g.mul(u1));
+
+    const FixedBaseTable table(g, 256);
+    EXPECT_EQ(Point::mul_add(u1, table, u2, q), expected);
+
+    // no GLV on a small curve, scalars beyond the group order
+    const FieldElement a97(2, 97), b97(3, 97);
+    const Point p(FieldElement(3, 97), FieldElement(6, 97), a97, b97), r = p.dbl().dbl() + p;
+    for (int k1 = -20; k1 < 120; k1 += 7) {
+        for (int k2 = 0; k2 < 120; k2 += 11) {
+            EXPECT_EQ(Point::mul_add(k1, p, k2, r, 3), p * integer(k1) + r * integer(k2)) << k1 << " " << k2;
+        }
+    }
+
+    EXPECT_THROW(Point::mul_add(u1, g, u2, p), std::runtime_error);
+    EXPECT_THROW(Point::mul_add(u1, table, u2, p), std::runtime_error);
+    EXPECT_THROW(Point::mul_add(u1, g, u2, q, 9), std::invalid_argument);
+}
+
+TEST(PointTest, WnafDigits) {
+    const integer k("b7e151628aed2a6abf7158809cf4f3c762e7160f38b4da56a784d9045190cfef", 16);
+    for (std::size_t w = 2; w <= 8; w++) {
+        const std::vector<int> digits = wnaf(k, w);
+        integer sum = 0;
+        for (std::size_t i = digits.size(); i > 0; i--) {
+            sum = (sum << 1) + digits[i - 1];
+            if (digits[i - 1]) {
+                EXPECT_TRUE((digits[i - 1] & 1) && std::abs(digits[i - 1]) < (1 << (w - 1)));
+                for (std::size_t j = i; j < std::min(digits.size(), i + w - 1); j++) {
+                    EXPECT_EQ(digits[j], 0);
+                }
+            }
+        }
+        EXPECT_EQ(sum, k) << w;
+    }
+    EXPECT_TRUE(wnaf(0, 5).empty());
+}
+
+TEST(PointTest, Errors) {
+    const FieldElement a(2, 97), b(3, 97);
+    EXPECT_THROW(Point(FieldElement(1, 97), FieldElement(1, 97), a, b), std::invalid_argument);
+    EXPECT_THROW(Point(a, b).affine(), std::domain_error);
+    EXPECT_THROW(Point(a, FieldElement(3, 31)), std::runtime_error);
+    const Point p(FieldElement(3, 97), FieldElement(6, 97), a, b);
+    EXPECT_THROW(p + Point(a, FieldElement(4, 97)), std::runtime_error);
+}
+
+TEST(PointTest, StatusResults) {
+    const FieldElement a(2, 97), b(3, 97);
+    const Result<Point> p = Point::make(FieldElement(3, 97), FieldElement(6, 97), a, b);
+    ASSERT_TRUE(p.ok());
+    EXPECT_EQ(*p, Point(FieldElement(3, 97), FieldElement(6, 97), a, b));
+    EXPECT_TRUE(p->is_normalized());
+    EXPECT_EQ(p->dbl(), *p + *p);
+    EXPECT_TRUE(Point::make(FieldElement(3, 97), FieldElement(7, 97), a, b).status() == Status::not_on_curve);
+    EXPECT_TRUE(Point::make(FieldElement(3, 101), FieldElement(6, 97), a, b).status() == Status::field_mismatch);
+    EXPECT_THROW(Point(FieldElement(3, 97), FieldElement(7, 97), a, b), std::invalid_argument);
+    EXPECT_THROW(Point(FieldElement(3, 101), FieldElement(6, 97), a, b), std::runtime_error);
+}
+
+// the same affine point scaled to other Jacobian coordinates, compared,
+// checked and tested for x without an inversion, for a = 0, -3 and generic
+TEST(PointTest, JacobianChecks) {
+    for (int a_value : {0, 94, 2}) {
+        const FieldElement a(a_value, 97), b(3, 97);
+        for (int x = 0; x < 97; x++) {
+            for (int y = 0; y < 97; y++) {
+                if ((y * y - x * x * x - a_value * x - 3) % 97 != 0) {
+                    continue;
+                }
+                const FieldElement fx(x, 97), fy(y, 97);
+                const Point p(fx, fy, a, b);
+                for (int z = 1; z < 5; z++) {
+                    const FieldElement fz(z, 97);
+                    const Result<Point> q = Point::make(fx * fz.square(), fy * fz.square() * fz, fz, a, b);
+                    ASSERT_TRUE(q.ok()) << x << " " << y << " " << z;
+                    EXPECT_EQ(q->is_normalized(), z == 1);
+                    EXPECT_TRUE(q->is_on_curve());
+                    EXPECT_EQ(*q, p);
+                    EXPECT_TRUE(q->has_x(fx));
+                    EXPECT_FALSE(q->has_x(fx + FieldElement(1, 97)));
+                    // y + 1 has another square unless it is -y
+                    EXPECT_EQ(Point::make(fx * fz.square(), (fy + FieldElement(1, 97)) * fz.square() * fz, fz, a,
+                                          b).ok(), (2 * y + 1) % 97 == 0);
+                }
+                EXPECT_TRUE(p.dbl().is_on_curve());
+                EXPECT_TRUE((p + p.dbl()).is_on_curve());
+            }
+        }
+        const Result<Point> infinity = Point::make(FieldElement(5, 97), FieldElement(1, 97), FieldElement(0, 97), a, b);
+        ASSERT_TRUE(infinity.ok());
+        EXPECT_TRUE(infinity->is_infinity());
+        EXPECT_TRUE(infinity->is_on_curve());
+    }
+    const FieldElement a(2, 97), b(3, 97);
+    EXPECT_TRUE(Point::make(FieldElement(3, 97), FieldElement(6, 97), FieldElement(1, 101), a, b).status()
+                == Status::field_mismatch);
+}
+
+TEST(PointTest, XOnlyLadder) {
+    const FieldElement a0(0, SECP256K1_P), b7(7, SECP256K1_P);
+    const Point g(FieldElement(integer("79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798", 16), SECP256K1_P),
+                  FieldElement(integer("483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8", 16), SECP256K1_P), a0, b7);
+    const integer n("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141", 16);
+    integer k("b7e151628aed2a6abf7158809cf4f3c762e7160f38b4da56a784d9045190cfef", 16);
+    for (int i = 0; i < 8; i++) {
+        EXPECT_EQ(g.mul_x(k), g.mul(k).x()) << i;
+        k = (k * k + 3) % n;
+    }
+    EXPECT_EQ(g.mul_x(1), g.x());
+    EXPECT_EQ(g.mul_x(n - 1), g.x());
+    EXPECT_EQ(g.mul_x(n + 2), g.dbl().x());
+    EXPECT_THROW(g.mul_x(0), std::domain_error);
+    EXPECT_THROW(g.mul_x(n), std::domain_error);
+    EXPECT_THROW(g.mul_x(integer(1) << 257), std::invalid_argument);
+
+    // from x alone, in Montgomery form, and an x on the twist
+    auto ctx = std::make_shared<const MontgomeryContext>(SECP256K1_P);
+    const FieldElement xm(g.x().value(), ctx);
+    EXPECT_EQ(Point::mul_x(k, xm, a0, b7)->value(), g.mul(k).x().value());
+    integer t = 1;
+    while (((FieldElement(t, SECP256K1_P).square() * FieldElement(t, SECP256K1_P)) + b7).is_square()) {
+        t++;
+    }
+    EXPECT_TRUE(Point::mul_x(k, FieldElement(t, SECP256K1_P), a0, b7).status() == Status::not_on_curve);
+
+    // every multiple on y^2 = x^3 + ax + 3 over GF(97), generic a and a = -3,
+    // from every point including x = 0
+    for (int ca : {2, 94}) {
+        const FieldElement a(ca, 97), b(3, 97);
+        for (int x = 0; x < 97; x++) {
+            const FieldElement fx(x, 97);
+            const FieldElement rhs = (fx.square() + a) * fx + b;
+            if (!rhs.is_square() || rhs.is_zero()) {
+                continue;
+            }
+            const Point p(fx, rhs.sqrt(), a, b);
+            for (int m = 0; m < 200; m++) {
+                const Result<FieldElement> r = Point::mul_x(m, fx, a, b);
+                const Point q = p * integer(m);
+                if (q.is_infinity()) {
+                    EXPECT_TRUE(r.status() == Status::infinity) << ca << " " << x << " " << m;
+                } else {
+                    ASSERT_TRUE(r.ok()) << ca << " " << x << " " << m;
+                    EXPECT_EQ(*r, q.x()) << ca << " " << x << " " << m;
+                }
+            }
+        }
+    }
+}
+
+// equal points hash alike whatever their Z
+TEST(PointTest, HashKeys) {
+    const integer p = 97;
+    const FieldElement a(2, p), b(3, p);
+    const Point infinity(a, b);
+    std::vector<Point> points;
+    for (int x = 0; x < 97; x++) {
+        for (int y = 0; y < 97; y++) {
+            if ((y * y - x * x * x - 2 * x - 3) % 97 == 0) {
+                points.emplace_back(FieldElement(x, p), FieldElement(y, p), a, b);
+            }
+        }
+    }
+    ASSERT_FALSE(points.empty());
+    const std::hash<Point> h;
+    std::unordered_set<Point> set(points.begin(), points.end());
+    set.insert(infinity);
+    EXPECT_EQ(set.size(), points.size() + 1);
+    for (const Point& q : points) {
+        const Point twice = q.dbl();
+        EXPECT_EQ(h(twice), h(twice.normalized()));
+        EXPECT_EQ(h(twice - q), h(q));
+        EXPECT_EQ(set.count(twice - q), 1u);
+    }
+    EXPECT_EQ(h(points[0] - points[0]), h(infinity));
+}
+
+// the affine coordinates of a Jacobian point, computed once and kept by the
+// point, its copies and moves, and read by many threads at once
+TEST(PointTest, CachedAffineCoordinates) {
+    const FieldElement a(0, SECP256K1_P), b(7, SECP256K1_P);
+    const Point g(FieldElement(integer("79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798", 16), SECP256K1_P),
+                  FieldElement(integer("483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8", 16), SECP256K1_P), a, b);
+    const Point g2 = g.dbl(), g3 = g2 + g;
+    const std::pair<FieldElement, FieldElement> xy = g3.normalized().affine();
+
+    Point p = g3;
+    EXPECT_TRUE(p.affine() == xy);
+    EXPECT_TRUE(p.affine() == xy);
+    EXPECT_FALSE(p.is_normalized());
+    EXPECT_TRUE(p.has_x(xy.first));
+    EXPECT_FALSE(p.has_x(g2.x()));
+    EXPECT_EQ(p, g3);
+    EXPECT_EQ(p, g3.normalized());
+    EXPECT_NE(p, g2);
+    const Point copy = p;
+    Point moved = Point(p);
+    EXPECT_TRUE(copy.affine() == xy);
+    EXPECT_TRUE(moved.affine() == xy);
+    // assignment replaces the coordinates kept with the new point's
+    p = g2;
+    EXPECT_EQ(p.x(), g2.normalized().x());
+    p = std::move(moved);
+    EXPECT_EQ(p.y(), xy.second);
+
+    std::vector<Point> points = {g2, g3, g3 + g, g};
+    points[1].x();
+    Point::batch_normalize(points.data(), points.size());
+    for (const Point& q : points) {
+        EXPECT_TRUE(q.is_normalized());
+    }
+    EXPECT_TRUE(points[1].affine() == xy);
+    EXPECT_EQ(points[2], g3 + g);
+
+    const Point shared = g3 + g2;
+    const std::pair<FieldElement, FieldElement> expected = shared.normalized().affine();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 50; i++) {
+                const Point copied = shared;
+                EXPECT_TRUE(shared.affine() == expected);
+                EXPECT_TRUE(copied.affine() == expected);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
@@ -0,0 +1,191 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Curve.h"
+#include "Polynomial.h"
+
+static Polynomial random_polynomial(std::mt19937_64& random, const PrimeField& field, std::size_t n) {
+    std::vector<FieldElement> c;
+    for (std::size_t i = 0; i < n; i++) {
+        integer v;
+        for (std::size_t j = 0; j < field.bits(); j += 64) {
+            v = (v << 64) | integer(static_cast<uint64_t>(random()));
+        }
+        c.emplace_back(v % field.prime(), field);
+    }
+    c.back() = FieldElement(1, field);
+    return Polynomial(field, std::move(c));
+}
+
+static std::vector<FieldElement> random_points(std::mt19937_64& random, const PrimeField& field, std::size_t n) {
+    std::vector<FieldElement> points;
+    for (std::size_t i = 0; i < n; i++) {
+        points.emplace_back(integer(static_cast<uint64_t>(random())), field);
+    }
+    return points;
+}
+
+// every product coefficient from its definition
+static Polynomial reference_product(const Polynomial& a, const Polynomial& b) {
+    const PrimeField& field = a.prime_field();
+    std::vector<FieldElement> c(a.degree() + b.degree() + 1, FieldElement(0, field));
+    for (long i = 0; i <= a.degree(); i++) {
+        for (long j = 0; j <= b.degree(); j++) {
+            c[i + j] += a[i] * b[j];
+        }
+    }
+    return Polynomial(field, std::move(c));
+}
+
+TEST(PolynomialTest, Basics) {
+    const PrimeField& field = Curve::secp256k1().scalar_field();
+    const Polynomial zero(field);
+    EXPECT_TRUE(zero.is_zero());
+    EXPECT_EQ(zero.degree(), -1);
+    // (x - 2)(x - 3) = x^2 - 5x + 6
+    const Polynomial p = Polynomial::linear(FieldElement(2, field)) * Polynomial::linear(FieldElement(3, field));
+    EXPECT_EQ(p.degree(), 2);
+    EXPECT_EQ(p[0], FieldElement(6, field));
+    EXPECT_EQ(p[1], FieldElement(field.prime() - 5, field));
+    EXPECT_EQ(p[5], FieldElement(0, field));
+    EXPECT_TRUE(p.evaluate(FieldElement(3, field)).is_zero());
+    EXPECT_EQ(p.evaluate(FieldElement(4, field)), FieldElement(2, field));
+    EXPECT_EQ(p - p, zero);
+    EXPECT_EQ(p + -p, zero);
+    EXPECT_EQ(p * FieldElement(0, field), zero);
+    EXPECT_EQ(Polynomial(field, {FieldElement(1, field), FieldElement(0, field)}).degree(), 0);
+}
+
+TEST(PolynomialTest, ProductsMatchReference) {
+    std::mt19937_64 random(1);
+    // the BLS12-381 group order has 2^32 | r - 1 and takes the transform; the
+    // secp256k1 order has only 2^6 and takes Karatsuba past 64 coefficients
+    for (const PrimeField* field : {&Curve::bls12_381().scalar_field(), &Curve::secp256k1().scalar_field(),
+                                    &Curve::p384().field()}) {
+        for (std::size_t n : {1, 5, 31, 32, 45, 100, 200}) {
+            for (std::size_t m : {1, 33, 77, 150}) {
+                const Polynomial a = random_polynomial(random, *field, n), b = random_polynomial(random, *field, m);
+                EXPECT_EQ(a * b, reference_product(a, b)) << n << " " << m;
+            }
+        }
+        const Polynomial a = random_polynomial(random, *field, 90);
+        EXPECT_EQ(a * a, reference_product(a, a));
+    }
+    EXPECT_TRUE(ntt_friendly(Curve::bls12_381().scalar_field(), std::size_t(1) << 32));
+    EXPECT_FALSE(ntt_friendly(Curve::bls12_381().scalar_field(), (std::size_t(1) << 32) + 1));
+    EXPECT_TRUE(ntt_friendly(Curve::secp256k1().scalar_field(), 64));
+    EXPECT_FALSE(ntt_friendly(Curve::secp256k1().scalar_field(), 65));
+}
+
+TEST(PolynomialTest, Division) {
+    std::mt19937_64 random(2);
+    for (const PrimeField* field : {&Curve::bls12_381().scalar_field(), &Curve::secp256k1().scalar_field()}) {
+        for (std::size_t n : {1, 10, 40, 300}) {
+            for (std::size_t m : {1, 3, 40, 120, 400}) {
+                const Polynomial a = random_polynomial(random, *field, n), b = random_polynomial(random, *field, m);
+                const auto qr = a.divmod(b);
+                EXPECT_LT(qr.second.degree(), b.degree());
+                EXPECT_EQ(b * qr.first + qr.second, a) << n << " " << m;
+            }
+        }
+        const Polynomial a = random_polynomial(random, *field, 100);
+        const Polynomial b = random_polynomial(random, *field, 60);
+        EXPECT_EQ(a * b / b, a);
+        EXPECT_TRUE((a * b % a).is_zero());
+        // f (1 / f) = 1 mod x^n
+        const Polynomial inv = b.inverse_series(70);
+        const Polynomial one = b * inv;
+        EXPECT_EQ(one[0], FieldElement(1, *field));
+        for (std::size_t i = 1; i < 70; i++) {
+            EXPECT_TRUE(one[i].is_zero()) << i;
+        }
+    }
+}
+
+TEST(PolynomialTest, BatchEvaluation) {
+    std::mt19937_64 random(3);
+    const PrimeField& field = Curve::secp256k1().scalar_field();
+    const Polynomial p = random_polynomial(random, field, 50);
+    const std::vector<FieldElement> points = random_points(random, field, 300);
+    for (unsigned threads : {1u, 4u}) {
+        const std::vector<FieldElement> values = p.evaluate(points, threads);
+        ASSERT_EQ(values.size(), points.size());
+        for (std::size_t i = 0; i < points.size(); i++) {
+            EXPECT_EQ(values[i], p.evaluate(points[i]));
+        }
+    }
+    EXPECT_TRUE(p.evaluate(std::vector<FieldElement>()).empty());
+}
+
+TEST(PolynomialTest, MultipointEvaluation) {
+    std::mt19937_64 random(4);
+    for (const PrimeField* field : {&Curve::bls12_381().scalar_field(), &Curve::secp256k1().scalar_field()}) {
+        for (std::size_t n : {1, 7, 16, 100, 300}) {
+            const SubproductTree tree(random_points(random, *field, n));
+            EXPECT_EQ(tree.root().degree(), static_cast<long>(n));
+            for (std::size_t d : {std::size_t(1), n, 2 * n + 3}) {
+                const Polynomial p = random_polynomial(random, *field, d);
+                EXPECT_EQ(tree.evaluate(p), p.evaluate(tree.points())) << n << " " << d;
+            }
+        }
+    }
+}
+
+TEST(PolynomialTest, Interpolation) {
+    std::mt19937_64 random(5);
+    for (const PrimeField* field : {&Curve::bls12_381().scalar_field(), &Curve::secp256k1().scalar_field()}) {
+        for (std::size_t n : {1, 2, 67, 200}) {
+            const std::vector<FieldElement> xs = random_points(random, *field, n);
+            const Polynomial p = random_polynomial(random, *field, n);
+            const std::vector<FieldElement> ys = p.evaluate(xs);
+            EXPECT_EQ(lagrange_interpolate(xs, ys), p) << n;
+            EXPECT_EQ(interpolate(xs, ys), p) << n;
+            const SubproductTree tree(xs);
+            EXPECT_EQ(tree.interpolate(ys), p) << n;
+            // a second set of values reuses the weights
+            const Polynomial q = random_polynomial(random, *field, n);
+            EXPECT_EQ(tree.interpolate(q.evaluate(xs)), q) << n;
+            const FieldElement zero(0, *field);
+            EXPECT_EQ(lagrange_evaluate(xs, ys, zero), p[0]);
+            EXPECT_EQ(lagrange_evaluate(xs, ys, xs[0]), ys[0]);
+        }
+    }
+}
+
+TEST(PolynomialTest, ShamirReconstruction) {
+    // a 3-of-5 sharing of 1234 with f(x) = 1234 + 166 x + 94 x^2 mod 1613
+    const PrimeField& field = PrimeField::get(integer(1613));
+    const Polynomial f(field, {FieldElement(1234, field), FieldElement(166, field), FieldElement(94, field)});
+    std::vector<FieldElement> xs, ys;
+    for (int i : {2, 4, 5}) {
+        xs.emplace_back(i, field);
+        ys.push_back(f.evaluate(xs.back()));
+    }
+    EXPECT_EQ(lagrange_evaluate(xs, ys, FieldElement(0, field)), FieldElement(1234, field));
+    EXPECT_EQ(lagrange_interpolate(xs, ys), f);
+}
+
+TEST(PolynomialTest, Errors) {
+    const PrimeField& field = Curve::secp256k1().scalar_field();
+    const PrimeField& other = Curve::p256().scalar_field();
+    const Polynomial p = Polynomial::constant(FieldElement(5, field));
+    EXPECT_THROW(p.divmod(Polynomial(field)), std::domain_error);
+    EXPECT_THROW(Polynomial(field).inverse_series(4), std::domain_error);
+    EXPECT_THROW(p + Polynomial::constant(FieldElement(5, other)), std::runtime_error);
+    EXPECT_THROW(p.evaluate(FieldElement(1, other)), std::runtime_error);
+    EXPECT_THROW(Polynomial(field, {FieldElement(1, other)}), std::runtime_error);
+
+    const std::vector<FieldElement> xs = {FieldElement(1, field), FieldElement(2, field), FieldElement(1, field)};
+    const std::vector<FieldElement> ys(3, FieldElement(7, field));
+    EXPECT_THROW(lagrange_interpolate(xs, ys), std::invalid_argument);
+    EXPECT_THROW(lagrange_evaluate(xs, ys, FieldElement(0, field)), std::invalid_argument);
+    EXPECT_THROW(SubproductTree(xs).interpolate(ys), std::invalid_argument);
+    EXPECT_THROW(lagrange_interpolate(xs, {ys[0]}), std::invalid_argument);
+    EXPECT_THROW(SubproductTree({}), std::invalid_argument);
+    EXPECT_THROW(SubproductTree(xs).evaluate(Polynomial::constant(FieldElement(1, other))), std::runtime_error);
+}
@@ -0,0 +1,53 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <vector>
+#include "gtest/gtest.h"
+#include "primality.h"
+
+TEST(PrimalityTest, SmallValuesMatchASieve) {
+    const std::size_t n = 1 << 16;
+    std::vector<bool> prime(n, true);
+    prime[0] = prime[1] = false;
+    for (std::size_t i = 2; i * i < n; i++) {
+        for (std::size_t j = i * i; prime[i] && j < n; j += i) {
+            prime[j] = false;
+        }
+    }
+    for (std::size_t i = 0; i < n; i++) {
+        ASSERT_EQ(is_probable_prime(integer(i)), prime[i]) << i;
+    }
+    EXPECT_FALSE(is_probable_prime(integer(-7)));
+}
+
+TEST(PrimalityTest, PseudoprimesAndLargePrimes) {
+    // strong pseudoprimes to base 2 (the last to bases 2 through 7 as well),
+    // Carmichael numbers, and a square of a prime, all past trial division
+    for (const char* composite : {"1373653", "25326001", "3215031751", "2152302898747", "3474749660383",
+                                  "341550071728321", "41041", "825265", "1018081"}) {
+        EXPECT_FALSE(is_probable_prime(integer(composite, 10))) << composite;
+    }
+    const integer m61 = (integer(1) << 61) - 1, m89 = (integer(1) << 89) - 1, m127 = (integer(1) << 127) - 1;
+    const integer m521 = (integer(1) << 521) - 1, m607 = (integer(1) << 607) - 1;
+    const integer top = (integer(1) << 256) - 189;      // the largest prime below 2^256
+    for (const integer& p : {m61, m89, m127, top, m521, m607}) {
+        EXPECT_TRUE(is_probable_prime(p)) << p;
+    }
+    for (const integer& c : {m61 * m89, m127 * m127, top - 2, m521 * m607, m607 + 2}) {
+        EXPECT_FALSE(is_probable_prime(c)) << c;
+    }
+}
+
+TEST(PrimalityTest, NextPrime) {
+    EXPECT_EQ(next_prime(integer(-5)), 2);
+    EXPECT_EQ(next_prime(integer(2)), 3);
+    EXPECT_EQ(next_prime(integer(7)), 11);
+    EXPECT_EQ(next_prime(integer(997)), 1009);
+    EXPECT_EQ(next_prime(integer(1000000)), 1000003);
+    // across the Montgomery and Barrett sizes
+    for (const unsigned int bits : {64u, 128u, 256u, 521u, 700u}) {
+        const integer from = integer(1) << bits;
+        const integer gap = next_prime(from) - from;
+        EXPECT_EQ(gap, bits == 64 ? 13 : bits == 128 ? 51 : bits == 256 ? 297 : bits == 521 ? 887 : 535) << bits;
+    }
+}
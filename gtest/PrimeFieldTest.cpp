@@ -0,0 +1,108 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include "gtest/gtest.h"
+#include "FieldElement.h"
+#include "p256.h"
+#include "PrimeField.h"
+
+TEST(PrimeFieldTest, DescriptorsAreInterned) {
+    const PrimeField& f = PrimeField::get(31);
+    EXPECT_EQ(&f, &PrimeField::get(integer(31)));
+    EXPECT_NE(&f, &PrimeField::get(37));
+    EXPECT_EQ(&FieldElement(3, 31).prime_field(), &f);
+    EXPECT_EQ(FieldElement(3, f), FieldElement(3, 31));
+    EXPECT_THROW(PrimeField::get(1), std::invalid_argument);
+}
+
+TEST(PrimeFieldTest, CachedConstants) {
+    const PrimeField& f = PrimeField::get(41);
+    EXPECT_EQ(f.prime_minus_one(), 40);
+    EXPECT_EQ(f.prime_minus_two(), 39);
+    EXPECT_EQ(f.bits(), 6u);
+    EXPECT_EQ(f.barrett().modulus(), 41);
+    EXPECT_EQ(f.odd_part(), 5);
+    EXPECT_EQ(f.two_adicity(), 3u);
+    EXPECT_EQ(f.sqrt_exponent(), 3);
+    EXPECT_EQ(f.legendre_exponent(), 20);
+    EXPECT_EQ(f.non_residue(), 3);
+    ASSERT_NE(f.montgomery(), nullptr);
+    EXPECT_EQ(f.montgomery()->modulus(), uint256(41));
+
+    const PrimeField& g = PrimeField::get(31);
+    EXPECT_EQ(g.two_adicity(), 1u);
+    EXPECT_EQ(g.sqrt_exponent(), 8);
+
+    const PrimeField& wide = PrimeField::get((integer(1) << 521) - 1);
+    EXPECT_FALSE(wide.fixed());
+    EXPECT_EQ(wide.montgomery(), nullptr);
+}
+
+TEST(PrimeFieldTest, WordPrimes) {
+    // the largest primes below 2^62 and 2^63
+    const integer p62("4611686018427387847", 10);
+    const integer p63("9223372036854775783", 10);
+    EXPECT_TRUE(PrimeField::get(2).word());
+    EXPECT_TRUE(PrimeField::get(31).word());
+    EXPECT_TRUE(PrimeField::get(p62).word());
+    EXPECT_FALSE(PrimeField::get(p63).word());
+
+    for (const integer& p : {integer(2), integer(223), p62}) {
+        const PrimeField& f = PrimeField::get(p);
+        EXPECT_EQ(f.word_prime(), uint256::from_integer(p).limb[0]);
+        integer a = p - 1;
+        for (int i = 0; i < 100; i++) {
+            const integer b = (a * 7 + 3) % p;
+            const limb_t product = f.mul_word(uint256::from_integer(a).limb[0], uint256::from_integer(b).limb[0]);
+            EXPECT_EQ(integer(product), (a * b) % p) << p;
+            a = b;
+        }
+    }
+}
+
+TEST(PrimeFieldTest, CompositeModuli) {
+    EXPECT_TRUE(PrimeField::get(31).is_prime());
+    EXPECT_TRUE(PrimeField::get((integer(1) << 521) - 1).is_prime());
+    EXPECT_FALSE(PrimeField::get(15).is_prime());
+
+    // a word field that is not prime inverts by the extended GCD, not v^(p - 2)
+    EXPECT_EQ(FieldElement(1, 15) / FieldElement(2, 15), FieldElement(8, 15));
+    // and has no Tonelli-Shanks square roots (65 - 1 = 2^6)
+    EXPECT_TRUE(FieldElement(4, 65).try_sqrt().status() == Status::bad_modulus);
+}
+
+TEST(PrimeFieldTest, PseudoMersennePrimes) {
+    const integer p127 = (integer(1) << 127) - 1;
+    const integer p192 = (integer(1) << 192) - 237;
+    const integer p255 = (integer(1) << 255) - 19;
+    const integer p3072 = (integer(1) << 3072) - 1103717;
+    EXPECT_EQ(PrimeField::get(p127).pseudo_mersenne(), 1u);
+    EXPECT_EQ(PrimeField::get(p192).pseudo_mersenne(), 237u);
+    EXPECT_EQ(PrimeField::get(p255).pseudo_mersenne(), 19u);
+    EXPECT_EQ(PrimeField::get(p3072).pseudo_mersenne(), 1103717u);
+    // c above 2^(k / 2), or more than a limb
+    EXPECT_EQ(PrimeField::get(769).pseudo_mersenne(), 0u);
+    EXPECT_EQ(PrimeField::get(P256_FIELD_P.to_integer()).pseudo_mersenne(), 0u);
+    EXPECT_EQ(PrimeField::get((integer(1) << 255) - (integer(1) << 100) - 1).pseudo_mersenne(), 0u);
+
+    // folding against division, at the edges and on pseudo-random values
+    for (const integer& p : {p127, p192, p255, p3072}) {
+        const PrimeField& f = PrimeField::get(p);
+        const integer top = (p - 1) * (p - 1);
+        for (const integer& x : {integer(0), p - 1, p, (integer(1) << f.bits()) - 1, top, -top, top << 70}) {
+            EXPECT_EQ(f.reduce(x), f.barrett().reduce(x)) << p;
+        }
+        integer a = p - 2;
+        for (int i = 0; i < 50; i++) {
+            const integer b = (a * a + 7) % p;
+            EXPECT_EQ(f.reduce(a * b), (a * b) % p) << p;
+            if (f.fixed()) {
+                const uint512 product = uint256::mul_wide(uint256::from_integer(a), uint256::from_integer(b));
+                EXPECT_EQ(f.fold_c(product).to_integer(), (a * b) % p) << p;
+            }
+            EXPECT_EQ(FieldElement(a, p) * FieldElement(b, p), FieldElement((a * b) % p, p)) << p;
+            EXPECT_EQ(FieldElement(a, p).square(), FieldElement((a * a) % p, p)) << p;
+            a = b;
+        }
+    }
+}
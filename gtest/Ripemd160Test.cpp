@@ -0,0 +1,77 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ripemd160.h"
+#include "sha256.h"
+#include "test_hex.h"
+
+static std::string ripemd160_hex(const std::string& message, std::size_t piece) {
+    Ripemd160 ripemd;
+    for (std::size_t i = 0; i < message.size(); i += piece) {
+        const std::string part = message.substr(i, piece);
+        ripemd.update(reinterpret_cast<const uint8_t*>(part.data()), part.size());
+    }
+    uint8_t digest[Ripemd160::DIGEST_SIZE];
+    ripemd.finish(digest);
+    return hex(digest, 20);
+}
+
+// the examples of the RIPEMD-160 page, fed whole and in pieces that straddle the blocks
+TEST(Ripemd160Test, KnownDigests) {
+    for (std::size_t piece : {1, 7, 1000}) {
+        EXPECT_EQ(ripemd160_hex("", piece), "9c1185a5c5e9fc54612808977ee8f548b2258d31");
+        EXPECT_EQ(ripemd160_hex("abc", piece), "8eb208f7e05d987a9b044a8e98c6b087f15a0bfc");
+        EXPECT_EQ(ripemd160_hex("message digest", piece), "5d0689ef49d2fae572b881b123a85ffa21595f36");
+        EXPECT_EQ(ripemd160_hex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", piece),
+                  "12a053384a9c0c88e405a06c27dcf49ada62eb2b");
+    }
+    EXPECT_EQ(ripemd160_hex(std::string(1000000, 'a'), 4096), "52783243c1697bdbe16d37f97f68f08325dc1528");
+}
+
+// the compressed public key of secret key 1, whose HASH160 is that of the
+// best-known address, and the fused form against the two hashes in turn
+TEST(Ripemd160Test, Hash160) {
+    const uint8_t g[33] = {
+            0x02, 0x79, 0xBE, 0x66, 0x7E, 0xF9, 0xDC, 0xBB, 0xAC, 0x55, 0xA0, 0x62, 0x95, 0xCE, 0x87, 0x0B, 0x07,
+            0x02, 0x9B, 0xFC, 0xDB, 0x2D, 0xCE, 0x28, 0xD9, 0x59, 0xF2, 0x81, 0x5B, 0x16, 0xF8, 0x17, 0x98,
+    };
+    uint8_t digest[Ripemd160::DIGEST_SIZE];
+    hash160(g, sizeof(g), digest);
+    EXPECT_EQ(hex(digest, 20), "751e76e8199196d454941c45d1b3a323f1433bd6");
+
+    const std::string message(200, 'q');
+    uint8_t sha[Sha256::DIGEST_SIZE], expected[Ripemd160::DIGEST_SIZE];
+    Sha256::hash(reinterpret_cast<const uint8_t*>(message.data()), message.size(), sha);
+    Ripemd160::hash(sha, sizeof(sha), expected);
+    hash160(reinterpret_cast<const uint8_t*>(message.data()), message.size(), digest);
+    EXPECT_EQ(hex(digest, 20), hex(expected, 20));
+}
+
+// the multi-buffer kernel against one hash160 per message, for counts that
+// leave short groups of both stages
+TEST(Ripemd160Test, MultiBufferMatchesOneAtATime) {
+    std::vector<uint8_t> messages(37 * 65);
+    for (std::size_t i = 0; i < messages.size(); i++) {
+        messages[i] = static_cast<uint8_t>(i * 151 + 3);
+    }
+    for (const Ripemd160MultiBuffer* kernel : {static_cast<const Ripemd160MultiBuffer*>(nullptr),
+                                               avx2_ripemd160_multi_buffer()}) {
+        const char* name = kernel ? kernel->name : "none";
+        for (std::size_t len : {0, 33, 65}) {
+            for (std::size_t count : {1, 8, 16, 37}) {
+                std::vector<uint8_t> out(20 * count);
+                hash160_many(out.data(), messages.data(), len, count, kernel);
+                for (std::size_t i = 0; i < count; i++) {
+                    uint8_t expected[Ripemd160::DIGEST_SIZE];
+                    hash160(messages.data() + i * len, len, expected);
+                    EXPECT_EQ(hex(out.data() + 20 * i, 20), hex(expected, 20)) << name << " " << len << " " << count;
+                }
+            }
+        }
+    }
+}
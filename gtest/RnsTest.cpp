@@ -0,0 +1,89 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "BarrettReducer.h"
+#include "Executor.h"
+#include "gtest/gtest.h"
+#include "modexp.h"
+#include "rns.h"
+
+// an odd value of exactly bits bits
+static integer odd_value(std::mt19937_64& random, std::size_t bits) {
+    std::vector<uint8_t> bytes((bits + 7) / 8);
+    for (uint8_t& b : bytes) {
+        b = static_cast<uint8_t>(random());
+    }
+    integer out = integer::from_bytes(bytes.data(), bytes.size(), integer::endian::big) >> (bytes.size() * 8 - bits);
+    out |= integer(1) << (bits - 1);
+    out |= 1;
+    return out;
+}
+
+TEST(RnsTest, ProductsMatchIntegerArithmetic) {
+    std::mt19937_64 random(21);
+    for (const std::size_t bits : {2, 64, 127, 256, 1024, 3072}) {
+        const integer n = (bits == 2) ? integer(3) : odd_value(random, bits);
+        const RnsContext rns(n);
+        EXPECT_GT(integer(2) * integer(rns.base_size() * 62), integer(n.bit_length()));
+        EXPECT_EQ(rns.from_rns(rns.one()), 1 % n);
+        for (int i = 0; i < 20; i++) {
+            const integer a = odd_value(random, bits + 3) - 5, b = -odd_value(random, bits);
+            const RnsValue x = rns.to_rns(a), y = rns.to_rns(b);
+            integer expected = a * b % n;
+            if (expected < 0) {
+                expected += n;
+            }
+            EXPECT_EQ(rns.from_rns(rns.mul(x, y)), expected) << bits;
+
+            // a chain of products stays below (k + 2) N between reductions
+            RnsValue z = x;
+            integer w = (a % n + n) % n;
+            for (int j = 0; j < 10; j++) {
+                z = rns.mul(z, z);
+                w = w * w % n;
+            }
+            EXPECT_EQ(rns.from_rns(z), w) << bits;
+        }
+    }
+}
+
+TEST(RnsTest, PowAndBatches) {
+    std::mt19937_64 random(22);
+    const integer n = odd_value(random, 3072);
+    const RnsContext rns(n);
+    const BarrettReducer reducer(n);
+    const integer base = odd_value(random, 3000), exponent = odd_value(random, 300);
+    const integer expected = sliding_window_pow(base, exponent, integer(1),
+            [&reducer](const integer& x, const integer& y) { return reducer.mul(x, y); });
+    EXPECT_EQ(rns.from_rns(rns.pow(rns.to_rns(base), exponent)), expected);
+    EXPECT_EQ(rns.from_rns(rns.pow(rns.to_rns(base), 0)), 1);
+
+    std::vector<RnsValue> a, b, out(37), pooled(37);
+    std::vector<integer> plain;
+    for (std::size_t i = 0; i < out.size(); i++) {
+        const integer x = odd_value(random, 3071), y = odd_value(random, 2000);
+        a.push_back(rns.to_rns(x));
+        b.push_back(rns.to_rns(y));
+        plain.push_back(x * y % n);
+    }
+    rns.mul(out.data(), a.data(), b.data(), out.size());
+    ThreadExecutor executor(3);
+    rns.mul(pooled.data(), a.data(), b.data(), pooled.size(), executor);
+    for (std::size_t i = 0; i < out.size(); i++) {
+        EXPECT_EQ(rns.from_rns(out[i]), plain[i]);
+        EXPECT_EQ(rns.from_rns(pooled[i]), plain[i]);
+    }
+    // in place
+    rns.mul(a.data(), a.data(), b.data(), a.size());
+    EXPECT_EQ(rns.from_rns(a[5]), plain[5]);
+}
+
+TEST(RnsTest, RejectsEvenAndSmallModuli) {
+    EXPECT_THROW(RnsContext(integer(1)), std::invalid_argument);
+    EXPECT_THROW(RnsContext(integer(1) << 100), std::invalid_argument);
+    EXPECT_THROW(RnsContext(integer(-7)), std::invalid_argument);
+}
@@ -0,0 +1,70 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "rsa.h"
+#include "test_arith.h"
+
+// the textbook key: p = 61, q = 53, e = 17
+TEST(RsaTest, SmallKey) {
+    const Result<RsaKey> key = RsaKey::make(61, 53, 17);
+    ASSERT_TRUE(key.ok());
+    EXPECT_EQ(key->modulus(), 3233);
+    EXPECT_EQ(key->private_exponent(), 413);
+    EXPECT_EQ(*key->public_op(65), 2790);
+    EXPECT_EQ(*key->private_op(2790), 65);
+    EXPECT_TRUE(key->private_op(3233).status() == Status::out_of_range);
+    EXPECT_TRUE(key->public_op(-1).status() == Status::out_of_range);
+
+    EXPECT_TRUE(RsaKey::make(61, 61, 17).status() == Status::bad_modulus);
+    EXPECT_TRUE(RsaKey::make(61, 51, 17).status() == Status::bad_modulus);
+    EXPECT_TRUE(RsaKey::make(2, 53, 17).status() == Status::bad_modulus);
+    EXPECT_TRUE(RsaKey::make(61, 53, 3).status() == Status::not_invertible);
+    EXPECT_TRUE(RsaKey::make(61, 53, 16).status() == Status::not_invertible);
+    EXPECT_TRUE(RsaKey::make(61, 53, 1).status() == Status::not_invertible);
+    EXPECT_THROW(RsaKey::generate(63), std::invalid_argument);
+}
+
+// the CRT private operation, with and without blinding, from several threads
+// and past a refresh of the blinding pair, against x^d mod n
+TEST(RsaTest, PrivateOperationInvertsPublic) {
+    const uint8_t seed[32] = {0x52, 0x53, 0x41};
+    ChaCha20Rng rng(seed);
+    RsaKey key = RsaKey::generate(1024, rng);
+    EXPECT_EQ(key.bits(), 1024u);
+    EXPECT_EQ(key.p() * key.q(), key.modulus());
+    EXPECT_EQ(key.p().bit_length(), 512u);
+
+    std::vector<integer> inputs;
+    for (int i = 0; i < 40; i++) {
+        inputs.push_back(rng.random_below(key.modulus()));
+    }
+    inputs.push_back(0);
+    inputs.push_back(1);
+    inputs.push_back(key.modulus() - 1);
+    for (const integer& x : inputs) {
+        const integer y = *key.private_op(x);
+        EXPECT_EQ(y, reference_pow(x, key.private_exponent(), key.modulus()));
+        EXPECT_EQ(*key.public_op(y), x);
+    }
+
+    EXPECT_FALSE(key.blinding_enabled());
+    key.enable_blinding();
+    EXPECT_TRUE(key.blinding_enabled());
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; t++) {
+        threads.emplace_back([&key, &inputs]() {
+            for (const integer& x : inputs) {
+                const integer y = *key.private_op(x);
+                EXPECT_EQ(*key.public_op(y), x);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
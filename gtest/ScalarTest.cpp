@@ -0,0 +1,129 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Curve.h"
+#include "Scalar.h"
+#include "test_arith.h"
+
+static integer pattern(limb_t seed, std::size_t limbs) {
+    return pattern512(seed, limbs).to_integer();
+}
+
+TEST(ScalarTest, ArithmeticMatchesInteger) {
+    const PrimeField& small = PrimeField::get(integer(1000003));
+    for (const PrimeField* order : {&Curve::secp256k1().scalar_field(), &Curve::p256().scalar_field(), &small}) {
+        const integer& n = order->prime();
+        for (limb_t seed = 1; seed < 60; seed++) {
+            const integer a = pattern(seed, 4) % n, b = pattern(seed + 1000, 5);
+            const Scalar x(a, *order), y(b, *order), z(-b, *order);
+            EXPECT_EQ(y.value(), b % n);
+            EXPECT_EQ((y + z).value(), 0);
+            EXPECT_EQ((x + y).value(), (a + b) % n);
+            EXPECT_EQ((x - y).value(), ((a - b) % n + n) % n);
+            EXPECT_EQ((x * y).value(), a * b % n);
+            EXPECT_EQ((-x).value(), (n - a) % n);
+            EXPECT_EQ((x * x.inverse()).value(), a == 0 ? 0 : 1);
+            EXPECT_EQ(x.is_high(), a > n / 2);
+
+            uint8_t bytes[64];
+            const uint512 wide = pattern512(seed, 8);
+            for (std::size_t i = 0; i < 64; i++) {
+                bytes[63 - i] = static_cast<uint8_t>(wide.limb[i / 8] >> (8 * (i % 8)));
+            }
+            EXPECT_EQ(Scalar::from_bytes(bytes, 64, *order).value(), wide.to_integer() % n);
+            x.to_bytes(bytes);
+            EXPECT_TRUE(Scalar::from_bytes(bytes, 32, *order) == x);
+        }
+        EXPECT_TRUE(Scalar(*order).inverse().is_zero());
+        EXPECT_TRUE(Scalar(n - 1, *order) + Scalar(1, *order) == Scalar(*order));
+    }
+    EXPECT_THROW(Scalar(1, small) + Scalar(1, Curve::p256().scalar_field()), std::runtime_error);
+    EXPECT_THROW(Scalar(PrimeField::get(integer(2))), std::invalid_argument);
+}
+
+TEST(ScalarTest, BatchInvert) {
+    const PrimeField& order = Curve::secp256k1().scalar_field();
+    std::vector<Scalar> scalars;
+    for (limb_t seed = 1; seed < 20; seed++) {
+        scalars.push_back(seed % 7 == 0 ? Scalar(order) : Scalar(pattern(seed, 4), order));
+    }
+    std::vector<Scalar> inverses = scalars;
+    Scalar::batch_invert(inverses);
+    for (std::size_t i = 0; i < scalars.size(); i++) {
+        // zeros stay zero and the rest are inverted as one by one
+        EXPECT_TRUE(inverses[i] == scalars[i].inverse()) << i;
+    }
+    std::vector<Scalar> none;
+    Scalar::batch_invert(none);
+    std::vector<Scalar> mixed = {Scalar(1, order), Scalar(1, Curve::p256().scalar_field())};
+    EXPECT_THROW(Scalar::batch_invert(mixed), std::runtime_error);
+}
+
+TEST(ScalarTest, WnafOfTheLeastRepresentative) {
+    const PrimeField& order = Curve::p256().scalar_field();
+    const integer& n = order.prime();
+    for (limb_t seed = 1; seed < 20; seed++) {
+        const Scalar k(pattern(seed, 4), order);
+        integer sum = 0;
+        const std::vector<int> digits = k.wnaf(5);
+        for (std::size_t i = digits.size(); i > 0; i--) {
+            sum = (sum << 1) + digits[i - 1];
+        }
+        EXPECT_EQ(((sum % n) + n) % n, k.value());
+        EXPECT_EQ(sum < 0, k.is_high());
+    }
+}
+
+TEST(ScalarTest, LambdaSplitIsShort) {
+    const Curve& curve = Curve::secp256k1();
+    const PrimeField& order = curve.scalar_field();
+    const integer& n = order.prime();
+    const Scalar lambda(integer("5363ad4cc05c30e0a5261c028812645a122e22ea20816678df02967c1b23bd72", 16), order);
+    // lambda^3 = 1, and lambda * G is (beta * x, y)
+    EXPECT_EQ((lambda * lambda * lambda).value(), 1);
+
+    auto magnitude = [&n](const Scalar& s) { return s.is_high() ? n - s.value() : s.value(); };
+    for (limb_t seed = 0; seed < 100; seed++) {
+        const Scalar k = seed ? Scalar(pattern(seed, 4), order) : Scalar(n - 1, order);
+        const std::pair<Scalar, Scalar> halves = k.split_lambda();
+        EXPECT_TRUE(halves.first + halves.second * lambda == k);
+        EXPECT_LE(magnitude(halves.first).bit_length(), 128u);
+        EXPECT_LE(magnitude(halves.second).bit_length(), 128u);
+    }
+    EXPECT_THROW(Scalar(1, Curve::p256().scalar_field()).split_lambda(), std::domain_error);
+
+    // the split feeds Point::mul
+    const Scalar k(pattern(7, 4), order);
+    EXPECT_TRUE(curve.generator().mul(k) == curve.generator().mul_ct(k.value()));
+}
+
+TEST(ScalarTest, WireFormat) {
+    const PrimeField& order = Curve::secp256k1().scalar_field();
+    const Scalar values[] = {Scalar(order), Scalar(-1, order), Scalar(0x0102, order)};
+    uint8_t wire[3 * Scalar::WIRE_SIZE];
+    ASSERT_TRUE(Scalar::serialize(values, 3, wire, sizeof(wire)) == Status::ok);
+    EXPECT_EQ(wire[64], 0x02);
+    EXPECT_EQ(wire[65], 0x01);
+
+    std::vector<Scalar> back;
+    ASSERT_TRUE(Scalar::deserialize(wire, sizeof(wire), order, back) == Status::ok);
+    ASSERT_EQ(back.size(), 3u);
+    for (std::size_t i = 0; i < 3; i++) {
+        EXPECT_TRUE(back[i] == values[i]);
+    }
+
+    // n itself is out of range
+    wire[32]++;
+    back.clear();
+    EXPECT_TRUE(Scalar::deserialize(wire, sizeof(wire), order, back) == Status::out_of_range);
+    EXPECT_TRUE(back.empty());
+    EXPECT_TRUE(Scalar::deserialize(wire, 31, order, back) == Status::bad_encoding);
+    EXPECT_TRUE(Scalar::serialize(values, 3, wire, sizeof(wire) - 1) == Status::buffer_too_small);
+    const Scalar mixed[] = {Scalar(1, order), Scalar(1, Curve::p256().scalar_field())};
+    EXPECT_TRUE(Scalar::serialize(mixed, 2, wire, sizeof(wire)) == Status::field_mismatch);
+    EXPECT_TRUE(Scalar::deserialize(wire, 32, PrimeField::get(integer(2)), back) == Status::bad_modulus);
+}
@@ -0,0 +1,142 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "schnorr_async.h"
+
+// requests from several threads at once, some of them bad, each completing with
+// what schnorr_verify and schnorr_sign give on their own
+TEST(SchnorrAsyncTest, MatchesSynchronousCalls) {
+    WorkStealingPool pool(3);
+    AsyncSchnorr async(pool, std::chrono::microseconds(2000), 64);
+
+    const std::size_t count = 100;
+    std::vector<std::vector<uint8_t>> keys(count, std::vector<uint8_t>(32)), signatures(count, std::vector<uint8_t>(64));
+    std::vector<std::vector<uint8_t>> messages(count);
+    for (std::size_t i = 0; i < count; i++) {
+        const uint8_t secret[32] = {static_cast<uint8_t>(i + 1), 0x77};
+        messages[i].assign(i % 7 * 9, static_cast<uint8_t>(i));
+        schnorr_public_key(keys[i].data(), secret);
+        schnorr_sign(signatures[i].data(), messages[i].data(), messages[i].size(), secret, nullptr);
+        if (i % 13 == 5) {
+            signatures[i][50] ^= 1;
+        }
+    }
+    keys[20][0] ^= 0x40;
+
+    std::vector<std::future<Status>> results(count);
+    std::vector<std::thread> callers;
+    for (std::size_t t = 0; t < 4; t++) {
+        callers.emplace_back([&, t]() {
+            for (std::size_t i = t; i < count; i += 4) {
+                results[i] = async.verify(signatures[i].data(), messages[i].data(), messages[i].size(), keys[i].data());
+            }
+        });
+    }
+    for (std::thread& caller : callers) {
+        caller.join();
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        const Status expected = schnorr_verify(signatures[i].data(), messages[i].data(), messages[i].size(),
+                                               keys[i].data());
+        EXPECT_TRUE(results[i].get() == expected) << i;
+        EXPECT_EQ(expected == Status::ok, i % 13 != 5 && i != 20) << i;
+    }
+
+    const uint8_t secret[32] = {9, 9, 9};
+    const uint8_t aux[32] = {1};
+    const uint8_t message[5] = {'h', 'e', 'l', 'l', 'o'};
+    uint8_t expected[64];
+    schnorr_sign(expected, message, 5, secret, aux);
+    Result<AsyncSchnorr::Signature> made = async.sign(message, 5, secret, aux).get();
+    ASSERT_TRUE(made.ok());
+    EXPECT_EQ(std::vector<uint8_t>(made->begin(), made->end()), std::vector<uint8_t>(expected, expected + 64));
+    const uint8_t zero[32] = {0};
+    EXPECT_TRUE(async.sign(message, 5, zero, nullptr).get().status() == Status::out_of_range);
+}
+
+// callbacks, and requests still queued when the instance goes away
+TEST(SchnorrAsyncTest, CallbacksAndShutdown) {
+    const uint8_t secret[32] = {3};
+    uint8_t key[32], signature[64];
+    const uint8_t message[1] = {42};
+    schnorr_public_key(key, secret);
+    schnorr_sign(signature, message, 1, secret, nullptr);
+
+    std::atomic<int> good(0), done(0);
+    {
+        ThreadExecutor serial(1);
+        AsyncSchnorr async(serial, std::chrono::microseconds(1000000), 8);
+        for (int i = 0; i < 20; i++) {
+            async.verify(signature, message, 1, key, [&](Status status) {
+                good += status == Status::ok;
+                done++;
+            });
+            async.sign(message, 1, secret, nullptr, [&](Status status, const uint8_t* made) {
+                good += status == Status::ok && std::equal(made, made + 64, signature);
+                done++;
+            });
+        }
+    }
+    EXPECT_EQ(done.load(), 40);
+    EXPECT_EQ(good.load(), 40);
+
+    EXPECT_TRUE(schnorr_verify_async(signature, message, 1, key).get() == Status::ok);
+    EXPECT_TRUE(schnorr_sign_async(message, 1, secret, nullptr).get().ok());
+}
+
+// a batch goes out as soon as max_batch are queued, however long the budget,
+// and the histograms count every batch and request
+TEST(SchnorrAsyncTest, FullBatchesAndMetrics) {
+    const uint8_t secret[32] = {5};
+    uint8_t key[32], signature[64];
+    const uint8_t message[2] = {1, 2};
+    schnorr_public_key(key, secret);
+    schnorr_sign(signature, message, 2, secret, nullptr);
+
+    WorkStealingPool pool(2);
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    {
+        AsyncSchnorr async(pool, std::chrono::microseconds(10000000), 8, false);
+        std::vector<std::future<Status>> results;
+        for (int i = 0; i < 32; i++) {
+            results.push_back(async.verify(signature, message, 2, key));
+        }
+        for (std::future<Status>& result : results) {
+            EXPECT_TRUE(result.get() == Status::ok);
+        }
+        EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+
+        const AsyncSchnorr::Metrics m = async.metrics();
+        EXPECT_EQ(m.requests, 32u);
+        EXPECT_EQ(m.batches, 4u);
+        EXPECT_EQ(m.full_batches, 4u);
+        EXPECT_EQ(m.batch_size[3], 4u);
+        EXPECT_EQ(m.failed_batches, 0u);
+        uint64_t latencies = 0;
+        for (uint64_t n : m.latency) {
+            latencies += n;
+        }
+        EXPECT_EQ(latencies, 32u);
+    }
+
+    // adaptive, a lone request finds no traffic to wait for and goes at once
+    AsyncSchnorr adaptive(pool, std::chrono::microseconds(10000000), 8);
+    const std::chrono::steady_clock::time_point before = std::chrono::steady_clock::now();
+    EXPECT_TRUE(adaptive.verify(signature, message, 2, key).get() == Status::ok);
+    EXPECT_LT(std::chrono::steady_clock::now() - before, std::chrono::seconds(5));
+    signature[0] ^= 1;
+    std::future<Status> bad = adaptive.verify(signature, message, 2, key);
+    std::future<Status> short_message = adaptive.verify(signature, message, 1, key);
+    EXPECT_FALSE(bad.get() == Status::ok);
+    EXPECT_FALSE(short_message.get() == Status::ok);
+    EXPECT_EQ(adaptive.metrics().requests, 3u);
+}
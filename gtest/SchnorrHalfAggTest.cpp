@@ -0,0 +1,102 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "schnorr_halfagg.h"
+
+namespace {
+
+// count signatures on messages of 32 bytes, each by its own key
+struct Signatures {
+    std::vector<uint8_t> keys, messages, signatures;
+    std::vector<SchnorrSigned> signed_items;
+    std::vector<SchnorrAggregated> items;
+
+    explicit Signatures(std::size_t count) : keys(32 * count), messages(32 * count), signatures(64 * count) {
+        for (std::size_t i = 0; i < count; i++) {
+            const uint8_t secret[32] = {static_cast<uint8_t>(i + 1), static_cast<uint8_t>(i >> 8), 0x77};
+            messages[32 * i] = static_cast<uint8_t>(i);
+            messages[32 * i + 31] = 0xa5;
+            EXPECT_TRUE(schnorr_public_key(&keys[32 * i], secret) == Status::ok);
+            EXPECT_TRUE(schnorr_sign(&signatures[64 * i], &messages[32 * i], 32, secret, nullptr) == Status::ok);
+        }
+        for (std::size_t i = 0; i < count; i++) {
+            signed_items.push_back({&signatures[64 * i], &messages[32 * i], 32, &keys[32 * i]});
+            items.push_back({&keys[32 * i], &messages[32 * i]});
+        }
+    }
+};
+
+}
+
+TEST(SchnorrHalfAggTest, AggregateAndVerify) {
+    for (std::size_t count : {1, 5, 40}) {
+        Signatures s(count);
+        std::vector<uint8_t> aggregate;
+        ASSERT_TRUE(schnorr_half_aggregate(aggregate, s.signed_items) == Status::ok);
+        ASSERT_EQ(aggregate.size(), 32 * (count + 1));
+        EXPECT_TRUE(schnorr_half_verify(aggregate.data(), aggregate.size(), s.items, 2) == Status::ok) << count;
+
+        // another message, the signatures in another order, a truncated aggregate
+        s.messages[3] ^= 1;
+        EXPECT_TRUE(schnorr_half_verify(aggregate.data(), aggregate.size(), s.items) == Status::bad_signature);
+        s.messages[3] ^= 1;
+        if (count > 1) {
+            std::swap(s.items[0], s.items[1]);
+            EXPECT_TRUE(schnorr_half_verify(aggregate.data(), aggregate.size(), s.items) == Status::bad_signature);
+            std::swap(s.items[0], s.items[1]);
+        }
+        EXPECT_TRUE(schnorr_half_verify(aggregate.data(), aggregate.size() - 1, s.items) == Status::bad_encoding);
+    }
+
+    // nothing aggregated is s = 0
+    std::vector<uint8_t> empty;
+    ASSERT_TRUE(schnorr_half_aggregate(empty, {}) == Status::ok);
+    EXPECT_EQ(empty, std::vector<uint8_t>(32, 0));
+    EXPECT_TRUE(schnorr_half_verify(empty.data(), empty.size(), {}) == Status::ok);
+}
+
+TEST(SchnorrHalfAggTest, IncrementalMatchesWhole) {
+    Signatures s(9);
+    std::vector<uint8_t> whole, growing;
+    ASSERT_TRUE(schnorr_half_aggregate(whole, s.signed_items) == Status::ok);
+
+    const std::vector<SchnorrSigned> first(s.signed_items.begin(), s.signed_items.begin() + 4);
+    const std::vector<SchnorrSigned> rest(s.signed_items.begin() + 4, s.signed_items.end());
+    const std::vector<SchnorrAggregated> done(s.items.begin(), s.items.begin() + 4);
+    ASSERT_TRUE(schnorr_half_aggregate(growing, first) == Status::ok);
+    EXPECT_TRUE(schnorr_half_verify(growing.data(), growing.size(), done) == Status::ok);
+    ASSERT_TRUE(schnorr_half_aggregate_append(growing, done, rest) == Status::ok);
+    EXPECT_EQ(growing, whole);
+
+    // an aggregate not of the signatures listed is left as it was
+    const std::vector<uint8_t> before = growing;
+    EXPECT_TRUE(schnorr_half_aggregate_append(growing, done, rest) == Status::bad_encoding);
+    EXPECT_EQ(growing, before);
+    SchnorrSigned long_message = s.signed_items[0];
+    long_message.length = 33;
+    EXPECT_THROW(schnorr_half_aggregate(growing, {long_message}), std::invalid_argument);
+}
+
+TEST(SchnorrHalfAggTest, BadEncodings) {
+    Signatures s(3);
+    std::vector<uint8_t> aggregate;
+    ASSERT_TRUE(schnorr_half_aggregate(aggregate, s.signed_items) == Status::ok);
+
+    // a key with no point, an R.x with no point, and an s of n
+    std::vector<uint8_t> key(32, 0);
+    key[31] = 5;
+    std::vector<SchnorrAggregated> items = s.items;
+    items[1].public_key = key.data();
+    EXPECT_TRUE(schnorr_half_verify(aggregate.data(), aggregate.size(), items) == Status::not_on_curve);
+    std::vector<uint8_t> bad = aggregate;
+    std::copy(key.begin(), key.end(), bad.begin() + 32);
+    EXPECT_TRUE(schnorr_half_verify(bad.data(), bad.size(), s.items) == Status::bad_signature);
+    bad = aggregate;
+    std::fill(bad.end() - 32, bad.end(), 0xff);
+    EXPECT_TRUE(schnorr_half_verify(bad.data(), bad.size(), s.items) == Status::bad_encoding);
+}
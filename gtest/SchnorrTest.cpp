@@ -0,0 +1,110 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "schnorr.h"
+#include "test_hex.h"
+
+// the BIP340 test vectors 0 and 1
+TEST(SchnorrTest, Bip340Vectors) {
+    struct Vector {
+        const char* secret;
+        const char* public_key;
+        const char* aux;
+        const char* message;
+        const char* signature;
+    };
+    const Vector vectors[] = {
+        {"0000000000000000000000000000000000000000000000000000000000000003",
+         "f9308a019258c31049344f85f89d5229b531c845836f99b08601f113bce036f9",
+         "0000000000000000000000000000000000000000000000000000000000000000",
+         "0000000000000000000000000000000000000000000000000000000000000000",
+         "e907831f80848d1069a5371b402410364bdf1c5f8307b0084c55f1ce2dca8215"
+         "25f66a4a85ea8b71e482a74f382d2ce5ebeee8fdb2172f477df4900d310536c0"},
+        {"b7e151628aed2a6abf7158809cf4f3c762e7160f38b4da56a784d9045190cfef",
+         "dff1d77f2a671c5f36183726db2341be58feae1da2deced843240f7b502ba659",
+         "0000000000000000000000000000000000000000000000000000000000000001",
+         "243f6a8885a308d313198a2e03707344a4093822299f31d0082efa98ec4e6c89",
+         "6896bd60eeae296db48a229ff71dfe071bde413e6d43f917dc8dcf8c78de3341"
+         "8906d11ac976abccb20b091292bff4ea897efcb639ea871cfa95f6de339e4b0a"},
+    };
+    for (const Vector& v : vectors) {
+        const std::vector<uint8_t> secret = unhex(v.secret), aux = unhex(v.aux), message = unhex(v.message);
+        uint8_t public_key[32], signature[64];
+        EXPECT_TRUE(schnorr_public_key(public_key, secret.data()) == Status::ok);
+        EXPECT_EQ(hex(public_key, 32), v.public_key);
+        EXPECT_TRUE(schnorr_sign(signature, message.data(), message.size(), secret.data(), aux.data()) == Status::ok);
+        EXPECT_EQ(hex(signature, 64), v.signature);
+        EXPECT_TRUE(schnorr_verify(signature, message.data(), message.size(), public_key) == Status::ok);
+
+        // a flipped bit of the message, R.x or s fails
+        EXPECT_TRUE(schnorr_verify(signature, message.data(), message.size() - 1, public_key) == Status::bad_signature);
+        for (std::size_t byte : {0, 40}) {
+            signature[byte] ^= 0x10;
+            EXPECT_TRUE(schnorr_verify(signature, message.data(), message.size(), public_key) != Status::ok);
+            signature[byte] ^= 0x10;
+        }
+    }
+}
+
+TEST(SchnorrTest, RejectsBadEncodings) {
+    uint8_t secret[32] = {0}, public_key[32], signature[64];
+    secret[31] = 9;
+    const uint8_t message[3] = {1, 2, 3};
+    EXPECT_TRUE(schnorr_public_key(public_key, secret) == Status::ok);
+    EXPECT_TRUE(schnorr_sign(signature, message, 3, secret, nullptr) == Status::ok);
+    EXPECT_TRUE(schnorr_verify(signature, message, 3, public_key) == Status::ok);
+
+    // x = 5 is on no point of secp256k1; x = p is not a field element; s = n is not a scalar
+    uint8_t bad_key[32] = {0};
+    bad_key[31] = 5;
+    EXPECT_TRUE(schnorr_verify(signature, message, 3, bad_key) == Status::not_on_curve);
+    std::vector<uint8_t> p = unhex("fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f");
+    EXPECT_TRUE(schnorr_verify(signature, message, 3, p.data()) == Status::bad_encoding);
+    std::vector<uint8_t> forged(signature, signature + 64);
+    const std::vector<uint8_t> n = unhex("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141");
+    std::copy(n.begin(), n.end(), forged.begin() + 32);
+    EXPECT_TRUE(schnorr_verify(forged.data(), message, 3, public_key) == Status::bad_encoding);
+
+    const uint8_t zero[32] = {0};
+    EXPECT_TRUE(schnorr_sign(signature, message, 3, zero, nullptr) == Status::out_of_range);
+    EXPECT_TRUE(schnorr_public_key(public_key, n.data()) == Status::out_of_range);
+}
+
+TEST(SchnorrTest, BatchVerify) {
+    const std::size_t count = 40;
+    std::vector<std::vector<uint8_t>> keys(count, std::vector<uint8_t>(32)), signatures(count, std::vector<uint8_t>(64));
+    std::vector<std::vector<uint8_t>> messages(count);
+    std::vector<SchnorrSigned> items;
+    for (std::size_t i = 0; i < count; i++) {
+        uint8_t secret[32] = {static_cast<uint8_t>(i + 1), 0x5A};
+        const uint8_t aux[32] = {static_cast<uint8_t>(i)};
+        messages[i].assign(i % 5 * 17, static_cast<uint8_t>(i));
+        schnorr_public_key(keys[i].data(), secret);
+        schnorr_sign(signatures[i].data(), messages[i].data(), messages[i].size(), secret, aux);
+        items.push_back(SchnorrSigned{signatures[i].data(), messages[i].data(), messages[i].size(), keys[i].data()});
+    }
+    EXPECT_TRUE(schnorr_verify_batch(items) == Status::ok);
+    EXPECT_TRUE(schnorr_verify_batch(items, 3) == Status::ok);
+    EXPECT_TRUE(schnorr_verify_batch(std::vector<SchnorrSigned>(items.begin(), items.begin() + 1)) == Status::ok);
+    EXPECT_TRUE(schnorr_verify_batch({}) == Status::ok);
+
+    // swapped keys fail the batch, as each signature does on its own
+    std::swap(items[10].public_key, items[11].public_key);
+    EXPECT_TRUE(schnorr_verify_batch(items) == Status::bad_signature);
+    EXPECT_TRUE(schnorr_verify(items[10].signature, items[10].message, items[10].length, items[10].public_key)
+                == Status::bad_signature);
+    std::swap(items[10].public_key, items[11].public_key);
+
+    signatures[3][63] ^= 1;
+    EXPECT_TRUE(schnorr_verify_batch(items) == Status::bad_signature);
+    signatures[3][63] ^= 1;
+    uint8_t bad_key[32] = {0};
+    bad_key[31] = 5;
+    items[7].public_key = bad_key;
+    EXPECT_TRUE(schnorr_verify_batch(items) == Status::not_on_curve);
+}
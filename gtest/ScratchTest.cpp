@@ -0,0 +1,86 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Curve.h"
+#include "msm.h"
+#include "Scratch.h"
+
+TEST(ScratchTest, FramesRewindAndBlocksMerge) {
+    Scratch scratch(256);
+    EXPECT_EQ(scratch.heap_allocations(), 1u);
+    {
+        Scratch::Frame job(scratch);
+        Scratch::vector<uint64_t> a(10, 7, &scratch);
+        const std::size_t after_a = scratch.in_use();
+        EXPECT_GE(after_a, 80u);
+        {
+            Scratch::Frame inner(scratch);
+            Scratch::vector<uint64_t> b(1000, 1, &scratch);
+            EXPECT_EQ(b[999], 1u);
+            EXPECT_EQ(scratch.heap_allocations(), 2u);
+        }
+        EXPECT_EQ(scratch.in_use(), after_a);
+        EXPECT_EQ(a[9], 7u);
+        // aligned as asked
+        void* p = scratch.allocate(3, 1);
+        void* q = scratch.allocate(32, 32);
+        EXPECT_NE(p, q);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(q) % 32, 0u);
+    }
+    EXPECT_EQ(scratch.in_use(), 0u);
+    // the two blocks became one that holds the whole job
+    EXPECT_EQ(scratch.heap_allocations(), 3u);
+    const std::size_t capacity = scratch.capacity();
+    EXPECT_GE(capacity, 8080u);
+    for (int round = 0; round < 3; round++) {
+        Scratch::Frame job(scratch);
+        Scratch::vector<uint64_t> a(10, 7, &scratch);
+        Scratch::vector<uint64_t> b(1000, 1, &scratch);
+    }
+    EXPECT_EQ(scratch.heap_allocations(), 3u);
+    EXPECT_EQ(scratch.capacity(), capacity);
+}
+
+// once warm, Pippenger and batch inversion take nothing more from the heap
+// for their buffers, and give the same answers
+TEST(ScratchTest, BatchAlgorithmsReuseTheArena) {
+    const Curve& curve = Curve::secp256k1();
+    std::vector<Point> points;
+    std::vector<integer> scalars;
+    Point q = curve.generator();
+    integer k(987654321);
+    for (std::size_t i = 0; i < 300; i++) {
+        points.push_back(q);
+        scalars.push_back(i % 3 ? k : -k);
+        q = q.dbl() + curve.generator();
+        k = (k * k + 3) % curve.n();
+    }
+
+    ThreadExecutor serial(1);
+    Scratch scratch(1024);
+    const Point expected = multi_scalar_mul(scalars, points);
+    EXPECT_EQ(multi_scalar_mul(scalars, points, serial, scratch), expected);
+    EXPECT_EQ(pippenger(scalars, points, 6, serial, scratch), expected);
+    const std::size_t grown = scratch.heap_allocations();
+    const std::size_t local = Scratch::local().heap_allocations();
+    for (int round = 0; round < 3; round++) {
+        EXPECT_EQ(pippenger(scalars, points, 6, serial, scratch), expected);
+    }
+    EXPECT_EQ(scratch.heap_allocations(), grown);
+    EXPECT_EQ(Scratch::local().heap_allocations(), local);
+    EXPECT_EQ(scratch.in_use(), 0u);
+
+    std::vector<FieldElement> a, b;
+    for (int i = 1; i <= 500; i++) {
+        a.emplace_back(integer(i) * 104729, curve.p());
+    }
+    b = a;
+    FieldElement::batch_invert(a);
+    FieldElement::batch_invert(b.data(), b.size(), scratch);
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(scratch.heap_allocations(), grown);
+}
@@ -0,0 +1,78 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sec1.h"
+#include "test_hex.h"
+
+TEST(Sec1Test, EncodesTheSecp256k1Generator) {
+    const Curve& curve = Curve::secp256k1();
+    uint8_t out[65];
+    ASSERT_EQ(*sec1_encode(curve.generator(), true, out, sizeof(out)), 33u);
+    EXPECT_EQ(hex(out, 33), "0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798");
+    ASSERT_EQ(*sec1_encode(curve.generator(), false, out, sizeof(out)), 65u);
+    EXPECT_EQ(hex(out, 65), "0479be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"
+                            "483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8");
+    EXPECT_TRUE(sec1_encode(curve.generator(), true, out, 32).status() == Status::buffer_too_small);
+
+    ASSERT_EQ(*sec1_encode(curve.infinity(), true, out, sizeof(out)), 1u);
+    EXPECT_EQ(out[0], 0);
+    EXPECT_TRUE(sec1_decode(out, 1, curve)->is_infinity());
+}
+
+TEST(Sec1Test, RoundTripsAndRejectsBadInput) {
+    for (const Curve* curve : {&Curve::secp256k1(), &Curve::p256(), &Curve::p384()}) {
+        std::vector<Point> points;
+        Point q = curve->generator();
+        for (int i = 0; i < 8; i++) {
+            q = q.dbl() + curve->generator();     // not normalized
+            points.push_back(q);
+        }
+        points.push_back(curve->infinity());
+
+        for (bool compressed : {true, false}) {
+            const std::size_t size = sec1_size(curve->field(), compressed);
+            std::vector<uint8_t> batch(points.size() * size), one(size);
+            ASSERT_TRUE(sec1_encode_batch(points, compressed, batch.data(), batch.size()) == Status::ok);
+            for (std::size_t i = 0; i + 1 < points.size(); i++) {
+                ASSERT_EQ(*sec1_encode(points[i], compressed, one.data(), size), size);
+                EXPECT_EQ(std::vector<uint8_t>(batch.begin() + i * size, batch.begin() + (i + 1) * size), one);
+                const Result<Point> back = sec1_decode(one.data(), size, *curve);
+                ASSERT_TRUE(back.ok()) << curve->name() << " " << status_name(back.status());
+                EXPECT_EQ(*back, points[i]);
+            }
+            EXPECT_EQ(std::vector<uint8_t>(batch.end() - size, batch.end()), std::vector<uint8_t>(size, 0));
+            EXPECT_TRUE(sec1_encode_batch(points, compressed, batch.data(), batch.size() - 1) == Status::buffer_too_small);
+
+            EXPECT_TRUE(sec1_decode(one.data(), size - 1, *curve).status() == Status::bad_encoding);
+            one[0] = compressed ? 4 : 2;
+            EXPECT_TRUE(sec1_decode(one.data(), size, *curve).status() == Status::bad_encoding);
+            one[0] = compressed ? 2 : 4;
+            curve->p().to_bytes(one.data() + 1, (curve->field().bits() + 7) / 8);
+            EXPECT_TRUE(sec1_decode(one.data(), size, *curve).status() == Status::out_of_range);
+        }
+
+        // an uncompressed point with y off by one
+        uint8_t out[97];
+        const std::size_t size = *sec1_encode(points[0], false, out, sizeof(out));
+        out[size - 1] ^= 1;
+        EXPECT_TRUE(sec1_decode(out, size, *curve).status() == Status::not_on_curve);
+    }
+}
+
+TEST(Sec1Test, FieldElementBytes) {
+    const integer p("fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f", 16);
+    auto ctx = std::make_shared<const MontgomeryContext>(p);
+    const FieldElement m(p - 2, ctx);
+    uint8_t out[40];
+    m.to_bytes(out, 40);
+    EXPECT_EQ(integer::from_bytes(out, 40), p - 2);
+    EXPECT_THROW(m.to_bytes(out, 31), std::invalid_argument);
+    EXPECT_EQ(FieldElement::from_bytes(out, 40, m.prime_field())->value(), p - 2);
+    out[0] = 1;
+    EXPECT_TRUE(FieldElement::from_bytes(out, 40, m.prime_field()).status() == Status::out_of_range);
+}
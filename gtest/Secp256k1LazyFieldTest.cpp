@@ -0,0 +1,100 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include "gtest/gtest.h"
+#include "Secp256k1LazyField.h"
+#include "StaticFieldElement.h"
+
+template <class F>
+class Secp256k1LazyFieldTest : public ::testing::Test {
+};
+
+#if defined(__SIZEOF_INT128__)
+typedef ::testing::Types<Secp256k1Field52, Secp256k1Field26> LazyFields;
+#else
+typedef ::testing::Types<Secp256k1Field26> LazyFields;
+#endif
+TYPED_TEST_SUITE(Secp256k1LazyFieldTest, LazyFields);
+
+static uint256 random_below_p(uint64_t& state) {
+    uint256 out;
+    do {
+        for (std::size_t i = 0; i < 4; i++) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            out.limb[i] = state ^ (state >> 29);
+        }
+    } while (out >= SECP256K1_FIELD_P);
+    return out;
+}
+
+TYPED_TEST(Secp256k1LazyFieldTest, RoundTripsAndNormalizes) {
+    typedef TypeParam F;
+    const uint256 p1 = SECP256K1_FIELD_P - 1;
+    EXPECT_EQ(F(p1).to_uint256(), p1);
+    EXPECT_EQ((F(p1) + F::one()).to_uint256(), uint256::zero());
+    EXPECT_TRUE((F(p1) + F::one()).is_zero());
+    EXPECT_THROW(F(SECP256K1_FIELD_P).to_uint256(), std::invalid_argument);
+    EXPECT_THROW(F().inverse(), std::domain_error);
+
+    // p itself, unnormalized, is zero
+    F x(p1);
+    x += F::one();
+    x.normalize_weak();
+    EXPECT_TRUE(x.is_zero());
+    x.normalize();
+    EXPECT_FALSE(x.is_odd());
+    const std::size_t limbs = sizeof(x.limbs()[0]) == 8 ? 5 : 10;
+    for (std::size_t i = 0; i < limbs; i++) {
+        EXPECT_EQ(x.limbs()[i], 0u);
+    }
+}
+
+TYPED_TEST(Secp256k1LazyFieldTest, MatchesSecp256k1FieldElement) {
+    typedef TypeParam F;
+    uint64_t state = 1;
+    for (int round = 0; round < 200; round++) {
+        const uint256 x = random_below_p(state), y = random_below_p(state);
+        const Secp256k1FieldElement a(x), b(y);
+        const F a2(x), b2(y);
+
+        EXPECT_EQ((a2 * b2).to_uint256(), (a * b).to_uint256());
+        EXPECT_EQ(a2.square().to_uint256(), (a * a).to_uint256());
+        EXPECT_EQ((a2 * b2.inverse()).to_uint256(), (a / b).to_uint256());
+
+        // a chain with no reduction until the end: 3a - b, times 3(a + b) - a
+        F u = a2;
+        u.mul_int(3);
+        u += b2.negate(1);
+        F v = a2 + b2;
+        v.mul_int(3);
+        v += a2.negate(1);
+        EXPECT_EQ((u * v).to_uint256(),
+                ((a + a + a - b) * (a + a + a + b + b + b - a)).to_uint256());
+
+        // the largest magnitude products take, with every limb near its bound
+        const F w = a2.negate(7);
+        const F z = b2.negate(7);
+        EXPECT_EQ((w * z).to_uint256(), (a * b).to_uint256());
+        EXPECT_EQ(w.square().to_uint256(), (a * a).to_uint256());
+        EXPECT_EQ((w + b2).negate(F::MAX_MAGNITUDE - 1).to_uint256(), (a - b).to_uint256());
+    }
+}
+
+#ifndef NDEBUG
+TYPED_TEST(Secp256k1LazyFieldTest, TracksMagnitude) {
+    typedef TypeParam F;
+    F a = F::one();
+    EXPECT_EQ(F().magnitude(), 0);
+    EXPECT_EQ(a.magnitude(), 1);
+    EXPECT_EQ((a + a + a).magnitude(), 3);
+    EXPECT_EQ(a.negate(4).magnitude(), 5);
+    a.mul_int(6);
+    EXPECT_EQ(a.magnitude(), 6);
+    EXPECT_EQ((a * a).magnitude(), 1);
+    a.normalize_weak();
+    EXPECT_EQ(a.magnitude(), 1);
+    EXPECT_FALSE(a.normalized());
+    a.normalize();
+    EXPECT_TRUE(a.normalized());
+}
+#endif
@@ -0,0 +1,35 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include "gtest/gtest.h"
+#include "FieldElement.h"
+#include "secp256k1.h"
+#include "test_arith.h"
+
+TEST(Secp256k1Test, ReductionsMatchIntegerModulus) {
+    const integer p = SECP256K1_FIELD_P.to_integer();
+    const integer n = SECP256K1_ORDER_N.to_integer();
+    uint512 all_ones = ~uint512::zero();
+
+    EXPECT_EQ(secp256k1_reduce_p(all_ones).to_integer(), all_ones.to_integer() % p);
+    EXPECT_EQ(secp256k1_reduce_n(all_ones).to_integer(), all_ones.to_integer() % n);
+    EXPECT_EQ(secp256k1_reduce_p(SECP256K1_FIELD_P.resize<8>()).to_integer(), 0);
+    EXPECT_EQ(secp256k1_reduce_n(SECP256K1_ORDER_N.resize<8>()).to_integer(), 0);
+    for (limb_t seed = 1; seed < 50; seed++) {
+        const uint512 x = pattern512(seed);
+        EXPECT_EQ(secp256k1_reduce_p(x).to_integer(), x.to_integer() % p);
+        EXPECT_EQ(secp256k1_reduce_n(x).to_integer(), x.to_integer() % n);
+    }
+}
+
+TEST(Secp256k1Test, FieldElementPicksFastReduction) {
+    const integer p = SECP256K1_FIELD_P.to_integer();
+    const integer n = SECP256K1_ORDER_N.to_integer();
+    const integer a("79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798", 16);
+    const integer b("483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8", 16);
+
+    FieldElement fa(a, p), fb(b, p);
+    EXPECT_EQ((fa * fb).value(), (a * b) % p);
+    FieldElement sa(a, n), sb(b, n);
+    EXPECT_EQ((sa * sb).value(), (a * b) % n);
+}
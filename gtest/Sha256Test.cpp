@@ -0,0 +1,193 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "sha256.h"
+#include "tagged_hash.h"
+#include "test_hex.h"
+
+static std::string sha256_hex(const std::string& message, std::size_t piece) {
+    Sha256 sha;
+    for (std::size_t i = 0; i < message.size(); i += piece) {
+        const std::string part = message.substr(i, piece);
+        sha.update(reinterpret_cast<const uint8_t*>(part.data()), part.size());
+    }
+    uint8_t digest[Sha256::DIGEST_SIZE];
+    sha.finish(digest);
+    return hex(digest, 32);
+}
+
+// FIPS 180-4 examples, fed whole and in pieces that straddle the blocks
+TEST(Sha256Test, KnownDigests) {
+    for (std::size_t piece : {1, 7, 1000}) {
+        EXPECT_EQ(sha256_hex("abc", piece), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+        EXPECT_EQ(sha256_hex("", piece), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+        EXPECT_EQ(sha256_hex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", piece),
+                  "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+        // 55 and 56 bytes: the length just fits the last block, and just does not
+        EXPECT_EQ(sha256_hex(std::string(55, 'x'), piece), "d5e285683cd4efc02d021a5c62014694958901005d6f71e89e0989fac77e4072");
+        EXPECT_EQ(sha256_hex(std::string(56, 'x'), piece), "04c26261370ee7541549d16dee320c723e3fd14671e66a099afe0a377c16888e");
+    }
+    EXPECT_EQ(sha256_hex(std::string(1000000, 'a'), 4096).substr(0, 32), "cdc76e5c9914fb9281a1c7e284d73e67");
+}
+
+// RFC 4231 test cases 2 and 6, the second with a key longer than a block; the
+// copy and the second MAC reuse the midstates
+TEST(Sha256Test, Hmac) {
+    const std::string jefe = "Jefe", query = "what do ya want for nothing?";
+    HmacSha256 mac(reinterpret_cast<const uint8_t*>(jefe.data()), jefe.size());
+    HmacSha256 copy = mac;
+    uint8_t digest[Sha256::DIGEST_SIZE];
+    for (HmacSha256* m : {&mac, &mac, &copy}) {
+        m->update(reinterpret_cast<const uint8_t*>(query.data()), query.size());
+        m->finish(digest);
+        EXPECT_EQ(hex(digest, 32), "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+    }
+
+    const std::vector<uint8_t> key(131, 0xaa);
+    const std::string message = "Test Using Larger Than Block-Size Key - Hash Key First";
+    HmacSha256 long_key(key.data(), key.size());
+    long_key.update(reinterpret_cast<const uint8_t*>(message.data()), message.size());
+    long_key.finish(digest);
+    EXPECT_EQ(hex(digest, 32), "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54");
+}
+
+// every block count from 0 to 5 through each supported backend, and the
+// vectors above on each
+TEST(Sha256Test, EveryBackendGivesTheSameDigests) {
+    const Sha256Backend previous = sha256_backend();
+    std::vector<uint8_t> message(5 * 64 + 17);
+    for (std::size_t i = 0; i < message.size(); i++) {
+        message[i] = static_cast<uint8_t>(i * 131 + 7);
+    }
+    auto digests = [&message]() {
+        std::string out;
+        for (std::size_t len = 0; len <= message.size(); len += 29) {
+            uint8_t digest[Sha256::DIGEST_SIZE];
+            Sha256::hash(message.data(), len, digest);
+            out += hex(digest, 32);
+        }
+        return out;
+    };
+
+    force_sha256_backend(Sha256Backend::portable);
+    const std::string expected = digests();
+    for (Sha256Backend backend : {Sha256Backend::portable, Sha256Backend::sha_ni, Sha256Backend::armv8}) {
+        if (!sha256_backend_supported(backend)) {
+            EXPECT_THROW(force_sha256_backend(backend), std::invalid_argument);
+            continue;
+        }
+        force_sha256_backend(backend);
+        EXPECT_TRUE(sha256_backend() == backend);
+        EXPECT_EQ(digests(), expected) << sha256_backend_name(backend);
+        EXPECT_EQ(sha256_hex("abc", 1), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+        EXPECT_EQ(sha256_hex(std::string(1000, 'a'), 300), "41edece42d63e8d9bf515a9ba6932e1c20cbc9f5a5d134645adb5db1b9737ea3");
+    }
+    // one of sha_ni and armv8 is always missing
+    EXPECT_FALSE(sha256_backend_supported(Sha256Backend::sha_ni) && sha256_backend_supported(Sha256Backend::armv8));
+    force_sha256_backend(previous);
+}
+
+// every multi-buffer kernel against one Sha256 per message, for lengths about
+// the padding boundaries and counts that leave a short last group
+TEST(Sha256Test, MultiBufferMatchesOneAtATime) {
+    std::vector<uint8_t> messages(37 * 130);
+    for (std::size_t i = 0; i < messages.size(); i++) {
+        messages[i] = static_cast<uint8_t>(i * 151 + 3);
+    }
+    for (const Sha256MultiBuffer* kernel : {static_cast<const Sha256MultiBuffer*>(nullptr),
+                                            avx2_sha256_multi_buffer(), avx512_sha256_multi_buffer()}) {
+        const char* name = kernel ? kernel->name : "none";
+        for (std::size_t len : {0, 1, 55, 56, 64, 119, 130}) {
+            for (std::size_t count : {1, 8, 16, 37}) {
+                std::vector<uint8_t> out(32 * count);
+                sha256_many(out.data(), messages.data(), len, count, kernel);
+                for (std::size_t i = 0; i < count; i++) {
+                    uint8_t expected[Sha256::DIGEST_SIZE];
+                    Sha256::hash(messages.data() + i * len, len, expected);
+                    EXPECT_EQ(hex(out.data() + 32 * i, 32), hex(expected, 32)) << name << " " << len << " " << count;
+                }
+            }
+        }
+        std::vector<uint8_t> out(32 * 37);
+        sha256d_64(out.data(), messages.data(), 37, kernel);
+        for (std::size_t i = 0; i < 37; i++) {
+            uint8_t inner[Sha256::DIGEST_SIZE], expected[Sha256::DIGEST_SIZE];
+            Sha256::hash(messages.data() + 64 * i, 64, inner);
+            Sha256::hash(inner, sizeof(inner), expected);
+            EXPECT_EQ(hex(out.data() + 32 * i, 32), hex(expected, 32)) << name;
+        }
+    }
+}
+
+// hmac_sha256_many under every kernel against one HmacSha256 per message,
+// and with the MACs written over their keys
+TEST(Sha256Test, HmacMultiBufferMatchesOneAtATime) {
+    std::vector<uint8_t> messages(37 * 130), keys(32 * 37);
+    for (std::size_t i = 0; i < messages.size(); i++) {
+        messages[i] = static_cast<uint8_t>(i * 151 + 3);
+    }
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        keys[i] = static_cast<uint8_t>(i * 29 + 7);
+    }
+    for (const Sha256MultiBuffer* kernel : {static_cast<const Sha256MultiBuffer*>(nullptr),
+                                            avx2_sha256_multi_buffer(), avx512_sha256_multi_buffer()}) {
+        const char* name = kernel ? kernel->name : "none";
+        for (std::size_t len : {0, 32, 55, 56, 64, 97, 130}) {
+            for (std::size_t count : {1, 8, 37}) {
+                std::vector<uint8_t> out = keys;
+                hmac_sha256_many(out.data(), out.data(), messages.data(), len, count, kernel);
+                for (std::size_t i = 0; i < count; i++) {
+                    uint8_t expected[Sha256::DIGEST_SIZE];
+                    HmacSha256 mac(keys.data() + 32 * i, 32);
+                    mac.update(messages.data() + i * len, len);
+                    mac.finish(expected);
+                    EXPECT_EQ(hex(out.data() + 32 * i, 32), hex(expected, 32)) << name << " " << len << " " << count;
+                }
+            }
+        }
+    }
+}
+
+// the precomputed midstates against the tags hashed out, and a tagged hash
+// against SHA-256(SHA-256(tag) || SHA-256(tag) || data)
+TEST(Sha256Test, TaggedHashMidstates) {
+    const std::pair<const char*, const Sha256Tag*> standard[] = {
+            {"BIP0340/challenge", &BIP340_CHALLENGE_TAG}, {"BIP0340/aux", &BIP340_AUX_TAG},
+            {"BIP0340/nonce", &BIP340_NONCE_TAG}, {"TapLeaf", &TAP_LEAF_TAG},
+            {"TapBranch", &TAP_BRANCH_TAG}, {"TapTweak", &TAP_TWEAK_TAG},
+    };
+    for (const auto& tag : standard) {
+        const Sha256Tag computed{std::string(tag.first)};
+        EXPECT_TRUE(std::equal(computed.midstate(), computed.midstate() + 8, tag.second->midstate())) << tag.first;
+        EXPECT_EQ(&Sha256Tag::named(tag.first), tag.second) << tag.first;
+    }
+
+    const Sha256Tag& custom = Sha256Tag::named("ecc-cpp/test");
+    EXPECT_EQ(&Sha256Tag::named("ecc-cpp/test"), &custom);
+    const std::string data(100, 'x');
+    for (const Sha256Tag* tag : {&custom, &BIP340_CHALLENGE_TAG}) {
+        const std::string name = tag == &custom ? "ecc-cpp/test" : "BIP0340/challenge";
+        uint8_t t[Sha256::DIGEST_SIZE], expected[Sha256::DIGEST_SIZE], digest[Sha256::DIGEST_SIZE];
+        Sha256::hash(reinterpret_cast<const uint8_t*>(name.data()), name.size(), t);
+        Sha256 sha;
+        sha.update(t, sizeof(t));
+        sha.update(t, sizeof(t));
+        sha.update(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+        sha.finish(expected);
+
+        TaggedHash tagged(*tag);
+        tagged.update(reinterpret_cast<const uint8_t*>(data.data()), data.size()).finish(digest);
+        EXPECT_EQ(hex(digest, 32), hex(expected, 32)) << name;
+        // starts over from the tag
+        tagged.update(reinterpret_cast<const uint8_t*>(data.data()), data.size()).finish(digest);
+        EXPECT_EQ(hex(digest, 32), hex(expected, 32)) << name;
+    }
+}
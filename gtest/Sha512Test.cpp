@@ -0,0 +1,50 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <cstdint>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "sha512.h"
+#include "test_hex.h"
+
+static std::string sha512_hex(const std::string& message, std::size_t piece) {
+    Sha512 sha;
+    for (std::size_t i = 0; i < message.size(); i += piece) {
+        const std::string part = message.substr(i, piece);
+        sha.update(reinterpret_cast<const uint8_t*>(part.data()), part.size());
+    }
+    uint8_t digest[Sha512::DIGEST_SIZE];
+    sha.finish(digest);
+    return hex(digest, sizeof(digest));
+}
+
+// FIPS 180-4 examples, fed whole and in pieces that straddle the blocks
+TEST(Sha512Test, KnownDigests) {
+    for (std::size_t piece : {1, 7, 1000}) {
+        EXPECT_EQ(sha512_hex("abc", piece),
+                  "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+                  "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+        EXPECT_EQ(sha512_hex("", piece),
+                  "cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce"
+                  "47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e");
+        EXPECT_EQ(sha512_hex("abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmn"
+                             "hijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu", piece),
+                  "8e959b75dae313da8cf4f72814fc143f8f7779c6eb9f7fa17299aeadb6889018"
+                  "501d289e4900f7e4331b99dec4b5433ac7d329eeb6dd26545e96e55b874be909");
+    }
+    EXPECT_EQ(sha512_hex(std::string(1000000, 'a'), 4096).substr(0, 32), "e718483d0ce769644e2e42c7bc15b463");
+}
+
+// RFC 4231 test case 2, twice from the same key
+TEST(Sha512Test, Hmac) {
+    const std::string key = "Jefe", query = "what do ya want for nothing?";
+    HmacSha512 mac(reinterpret_cast<const uint8_t*>(key.data()), key.size());
+    for (int i = 0; i < 2; i++) {
+        uint8_t digest[Sha512::DIGEST_SIZE];
+        mac.update(reinterpret_cast<const uint8_t*>(query.data()), query.size());
+        mac.finish(digest);
+        EXPECT_EQ(hex(digest, sizeof(digest)), "164b7a7bfcf819e2e395fbe73b56e0a387bd64222e831fd610270cd7ea250554"
+                                               "9758bf75c05a994a6d034f65f8f0e6fdcaeab1a34d4a6b4b636e070a38bce737");
+    }
+}
@@ -0,0 +1,69 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include <cstdint>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+#include "ecdsa.h"
+#include "schnorr.h"
+#include "signature_cache.h"
+
+static SignatureCache::Digest entry(const SignatureCache& cache, uint8_t i) {
+    return cache.digest({SignatureCache::Piece(&i, 1)});
+}
+
+TEST(SignatureCacheTest, Eviction) {
+    // one shard of four, so the order of eviction is the whole cache's
+    for (SignatureCache::Eviction eviction : {SignatureCache::Eviction::least_recent, SignatureCache::Eviction::oldest}) {
+        SignatureCache cache(4, 1, eviction);
+        for (uint8_t i = 0; i < 4; i++) {
+            cache.insert(entry(cache, i));
+        }
+        cache.insert(entry(cache, 3));
+        EXPECT_EQ(cache.size(), 4u);
+        EXPECT_TRUE(cache.contains(entry(cache, 0)));
+        cache.insert(entry(cache, 4));
+        EXPECT_EQ(cache.size(), 4u);
+        const bool lru = eviction == SignatureCache::Eviction::least_recent;
+        EXPECT_EQ(cache.contains(entry(cache, 0)), lru);
+        EXPECT_EQ(cache.contains(entry(cache, 1)), !lru);
+        EXPECT_TRUE(cache.contains(entry(cache, 4)));
+        cache.clear();
+        EXPECT_EQ(cache.size(), 0u);
+    }
+
+    // the salt differs between caches; a small capacity takes fewer shards
+    SignatureCache a(100), b(3);
+    EXPECT_NE(entry(a, 1), entry(b, 1));
+    EXPECT_EQ(a.capacity(), 96u);
+    EXPECT_EQ(b.capacity(), 2u);
+    EXPECT_THROW(SignatureCache(0), std::invalid_argument);
+}
+
+TEST(SignatureCacheTest, CachesValidSignatures) {
+    SignatureCache cache(64);
+    const Curve& curve = Curve::secp256k1();
+    uint8_t secret[32] = {0}, hash[32] = {0}, signature[64];
+    secret[31] = 7;
+    hash[5] = 1;
+    const Point q = *ecdsa_public_key(curve, secret);
+    ecdsa_sign(signature, curve, secret, hash, 32);
+    for (int i = 0; i < 2; i++) {
+        EXPECT_TRUE(ecdsa_verify(signature, curve, q, hash, 32, cache) == Status::ok);
+        EXPECT_EQ(cache.size(), 1u);
+    }
+    // failures are not kept
+    hash[5] ^= 1;
+    EXPECT_TRUE(ecdsa_verify(signature, curve, q, hash, 32, cache) == Status::bad_signature);
+    EXPECT_TRUE(ecdsa_verify(signature, curve, curve.generator(), hash, 32, cache) == Status::bad_signature);
+    EXPECT_EQ(cache.size(), 1u);
+
+    uint8_t x_only[32], schnorr[64];
+    schnorr_public_key(x_only, secret);
+    schnorr_sign(schnorr, hash, 32, secret, nullptr);
+    EXPECT_TRUE(schnorr_verify(schnorr, hash, 32, x_only, cache) == Status::ok);
+    EXPECT_TRUE(schnorr_verify(schnorr, hash, 32, x_only, cache) == Status::ok);
+    EXPECT_TRUE(schnorr_verify(schnorr, hash, 31, x_only, cache) == Status::bad_signature);
+    EXPECT_EQ(cache.size(), 2u);
+}
@@ -0,0 +1,58 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include "gtest/gtest.h"
+#include "FieldElement.h"
+#include "StaticFieldElement.h"
+
+struct Mod31 {
+    static constexpr limb_t P[4] = {31, 0, 0, 0};
+};
+typedef StaticFieldElement<Mod31> F31;
+
+// 2^256 = 2 and 2^512 = 4 (mod 31), since 2^5 = 1
+static_assert(F31::R.limb[0] == 2 && F31::R2.limb[0] == 4, "Montgomery constants are constexpr");
+static_assert(F31::N0 * 31 == limb_t(0) - 1, "n0 is -p^-1 mod 2^64");
+// and so is the arithmetic: 3 * 7 + 5 = 26, and 26 * 26^29 = 1
+static_assert((F31(uint256(3)) * F31(uint256(7)) + F31(uint256(5))).to_uint256() == uint256(26), "constexpr arithmetic");
+static_assert(F31(uint256(26)).power_ct(uint256(29)) * F31(uint256(26)) == F31::one(), "constexpr power");
+
+TEST(StaticFieldElementTest, SmallFieldArithmetic) {
+    F31 a(integer(2)), b(integer(15)), c(integer(17));
+    EXPECT_EQ(a + b, c);
+    EXPECT_EQ((a - c).value(), 16);
+    EXPECT_EQ((b * c).value(), 7);
+    EXPECT_EQ((F31(integer(3)) / F31(integer(24))).value(), 4);
+    EXPECT_EQ(F31(integer(3)).power(-3).value(), 23);
+    EXPECT_EQ((-a).value(), 29);
+    EXPECT_THROW(F31(integer(31)), std::invalid_argument);
+    EXPECT_THROW(a / F31(), std::domain_error);
+}
+
+TEST(StaticFieldElementTest, MatchesRuntimeFieldElement) {
+    const integer p = SECP256K1_FIELD_P.to_integer();
+    const integer x("6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296", 16);
+    const integer y("4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5", 16);
+    const integer e("b7e151628aed2a6abf7158809cf4f3c762e7160f38b4da56a784d9045190cfef", 16);
+    Secp256k1FieldElement a(x), b(y);
+    FieldElement ra(x, p), rb(y, p);
+
+    EXPECT_EQ((a * b + a - b).value(), (ra * rb + ra - rb).value());
+    EXPECT_EQ((a / b).value(), (ra / rb).value());
+    EXPECT_EQ(a.power(e).value(), ra.power(e).value());
+    EXPECT_EQ(a.power_ct(uint256::from_integer(e)), a.power(e));
+    EXPECT_EQ(a * a.inverse(), Secp256k1FieldElement::one());
+
+    const integer n = SECP256K1_ORDER_N.to_integer();
+    Secp256k1Scalar s(x);
+    EXPECT_EQ((s * s).value(), (x * x) % n);
+}
+
+// the secp256k1 generator from literals, checked on the curve by the compiler
+TEST(StaticFieldElementTest, LiteralConstants) {
+    typedef StaticFieldElement<Secp256k1FieldPrime> Fp;
+    constexpr Fp x(0x79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798_u256);
+    constexpr Fp y("483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8"_hex);
+    static_assert(y.square() == x.square() * x + Fp(7_u256), "G is on y^2 = x^3 + 7");
+    EXPECT_EQ(x.value(), integer("79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798", 16));
+}
@@ -0,0 +1,76 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "Curve.h"
+#include "schnorr.h"
+#include "taproot.h"
+#include "test_hex.h"
+
+// the scriptPubKey vectors of BIP341
+TEST(TaprootTest, Vectors) {
+    const struct {
+        std::string internal, root, output;
+    } vectors[] = {
+            {"d6889cb081036e0faefa3a35157ad71086b123b2b144b649798b494c300a961d", "",
+             "53a1f6e454df1aa2776a2814a721372d6258050de330b3c6d10ee8f4e0dda343"},
+            {"187791b6f712a8ea41c8ecdd0ee77fab3e85263b37e1ec18a3651926b3a6cf27",
+             "5b75adecf53548f3ec6ad7d78383bf84cc57b55a3127c72b9a2481752dd88b21",
+             "147c9c57132f6e7ecddba9800bb0c4449251c92a1e60371ee77557b6620f3ea3"},
+    };
+    for (const auto& v : vectors) {
+        const std::vector<uint8_t> internal = unhex(v.internal), root = unhex(v.root);
+        uint8_t out[32];
+        ASSERT_TRUE(taproot_tweak(out, nullptr, internal.data(), root.empty() ? nullptr : root.data()) == Status::ok);
+        EXPECT_EQ(std::vector<uint8_t>(out, out + 32), unhex(v.output));
+    }
+    // x = p, and an x with no point
+    std::vector<uint8_t> key(32);
+    Curve::secp256k1().p().to_bytes(key.data(), 32);
+    uint8_t out[32];
+    EXPECT_TRUE(taproot_tweak(out, nullptr, key.data(), nullptr) == Status::bad_encoding);
+    key.assign(32, 0);
+    key[31] = 5;
+    EXPECT_TRUE(taproot_tweak(out, nullptr, key.data(), nullptr) == Status::not_on_curve);
+}
+
+TEST(TaprootTest, BatchMatchesOneByOne) {
+    // over two chunks, with a bad key in each and roots for every other call
+    const std::size_t count = TAPROOT_TWEAK_CHUNK + 77;
+    std::vector<uint8_t> keys(32 * count), roots(32 * count);
+    for (std::size_t i = 0; i < count; i++) {
+        const uint8_t secret[32] = {static_cast<uint8_t>(i + 1), static_cast<uint8_t>(i >> 8), 0x33};
+        ASSERT_TRUE(schnorr_public_key(&keys[32 * i], secret) == Status::ok);
+        roots[32 * i] = static_cast<uint8_t>(i);
+    }
+    Curve::secp256k1().p().to_bytes(&keys[32 * 3], 32);
+    keys.at(32 * (TAPROOT_TWEAK_CHUNK + 5) + 31) ^= 1;
+
+    ThreadExecutor executor(3);
+    for (const uint8_t* r : {static_cast<const uint8_t*>(nullptr), static_cast<const uint8_t*>(roots.data())}) {
+        const TweakedKeys batch = taproot_tweak_batch(keys.data(), r, count, executor);
+        const TweakedKeys serial = taproot_tweak_batch(keys.data(), r, count);
+        EXPECT_EQ(batch.keys, serial.keys);
+        std::size_t bad = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            uint8_t out[32];
+            bool odd = false;
+            const Status status = taproot_tweak(out, &odd, &keys[32 * i], r ? &roots[32 * i] : nullptr);
+            ASSERT_EQ(batch.valid(i), status == Status::ok) << i;
+            if (status == Status::ok) {
+                EXPECT_EQ(std::vector<uint8_t>(out, out + 32),
+                          std::vector<uint8_t>(&batch.keys[32 * i], &batch.keys[32 * (i + 1)]));
+                EXPECT_EQ(batch.odd[i], odd) << i;
+            } else {
+                bad++;
+            }
+        }
+        EXPECT_GE(bad, 1u);
+        EXPECT_EQ(batch.invalid_count(), bad);
+    }
+    EXPECT_EQ(taproot_tweak_batch(keys.data(), nullptr, 0).keys.size(), 0u);
+}
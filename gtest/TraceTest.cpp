@@ -0,0 +1,83 @@
+//
+// Created by preston on 10/15/2026.
+//
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Curve.h"
+#include "Executor.h"
+#include "gtest/gtest.h"
+#include "msm.h"
+#include "trace.h"
+
+static std::size_t occurrences(const std::string& text, const std::string& word) {
+    std::size_t n = 0;
+    for (std::size_t at = text.find(word); at != std::string::npos; at = text.find(word, at + 1)) {
+        n++;
+    }
+    return n;
+}
+
+TEST(TraceTest, RecordsSpansBetweenStartAndStop) {
+    { TraceSpan before("before"); }
+    Trace::start();
+    EXPECT_TRUE(Trace::enabled());
+    {
+        TraceSpan outer("outer");
+        TraceSpan quoted("say \"hi\"");
+    }
+    ThreadExecutor(3).run(6, [](std::size_t) {
+        TraceSpan task("task");
+    });
+    Trace::stop();
+    EXPECT_FALSE(Trace::enabled());
+    { TraceSpan after("after"); }
+
+    const std::string json = Trace::chrome_json();
+    EXPECT_EQ(json.find("{\"traceEvents\":["), 0u);
+    EXPECT_EQ(occurrences(json, "\"name\":\"outer\",\"ph\":\"X\""), 1u);
+    EXPECT_EQ(occurrences(json, "\"name\":\"task\""), 6u);
+    EXPECT_EQ(occurrences(json, "say \\\"hi\\\""), 1u);
+    EXPECT_EQ(occurrences(json, "before"), 0u);
+    EXPECT_EQ(occurrences(json, "after"), 0u);
+
+    // a new trace drops the last one's spans
+    Trace::start();
+    { TraceSpan only("only"); }
+    Trace::stop();
+    const std::string path = ::testing::TempDir() + "trace_test.json";
+    Trace::write_chrome(path);
+    std::ifstream in(path);
+    std::stringstream written;
+    written << in.rdbuf();
+    EXPECT_EQ(occurrences(written.str(), "\"name\""), 1u);
+    EXPECT_EQ(occurrences(written.str(), "only"), 1u);
+    std::remove(path.c_str());
+    EXPECT_THROW(Trace::write_chrome("/nonexistent/dir/trace.json"), std::runtime_error);
+}
+
+TEST(TraceTest, LibrarySpansWhenCompiledIn) {
+    const Curve& curve = Curve::secp256k1();
+    std::vector<integer> k;
+    std::vector<Point> p;
+    for (int i = 0; i < 300; i++) {
+        k.push_back(integer(i * 7919 + 1));
+        p.push_back(curve.generator_table().mul(integer(i + 1)));
+    }
+    ThreadExecutor executor(2);
+    Trace::start();
+    const Point sum = multi_scalar_mul(k, p, executor);
+    Trace::stop();
+    const std::string json = Trace::chrome_json();
+#ifdef ECC_TRACING
+    EXPECT_EQ(occurrences(json, "\"name\":\"msm\""), 1u);
+    EXPECT_GE(occurrences(json, "\"name\":\"msm.buckets\""), 1u);
+    EXPECT_EQ(occurrences(json, "\"name\":\"msm.combine\""), 1u);
+#else
+    EXPECT_EQ(occurrences(json, "\"name\""), 0u);
+#endif
+    EXPECT_FALSE(sum.is_infinity());
+}
@@ -0,0 +1,75 @@
+//
+// Created by preston on 10/14/2026.
+//
+#include "gtest/gtest.h"
+#include "uint256.h"
+
+TEST(Uint256Test, IntegerRoundTrip) {
+    integer v("79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798", 16);
+    uint256 f = uint256::from_integer(v);
+    EXPECT_EQ(f.limb[0], 0x59f2815b16f81798ULL);
+    EXPECT_EQ(f.limb[3], 0x79be667ef9dcbbacULL);
+    EXPECT_EQ(f.to_integer(), v);
+    EXPECT_THROW(uint256::from_integer(integer(1) << 256), std::out_of_range);
+}
+
+TEST(Uint256Test, CarryPropagation) {
+    uint256 max = ~uint256::zero();
+    uint256 out;
+    EXPECT_EQ(uint256::add(out, max, uint256(1)), 1u);
+    EXPECT_TRUE(out.is_zero());
+    EXPECT_EQ(uint256::sub(out, uint256(0), uint256(1)), 1u);
+    EXPECT_EQ(out, max);
+}
+
+TEST(Uint256Test, WideProductMatchesInteger) {
+    integer a("fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f", 16);
+    integer b("483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8", 16);
+    uint512 p = uint256::mul_wide(uint256::from_integer(a), uint256::from_integer(b));
+    EXPECT_EQ(p.to_integer(), a * b);
+    EXPECT_EQ((uint256::from_integer(a) * uint256::from_integer(b)).to_integer(), (a * b) % (integer(1) << 256));
+    EXPECT_EQ(uint256::sqr_wide(uint256::from_integer(a)).to_integer(), a * a);
+    EXPECT_EQ(uint256::sqr_wide(uint256::from_integer(b)).to_integer(), b * b);
+}
+
+TEST(Uint256Test, Shifts) {
+    uint256 one(1);
+    EXPECT_EQ((one << 255).bits(), 256u);
+    EXPECT_EQ(((one << 200) >> 137), one << 63);
+    EXPECT_TRUE((one << 256).is_zero());
+}
+
+TEST(Uint256Test, ConstantTimeModularInverse) {
+    const uint256 p = uint256::from_integer(integer("fffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f", 16));
+    const uint256 m = uint256::from_integer((integer(1) << 256) - 189);
+    for (const uint256 & mod : {p, m, uint256(1000003)}) {
+        for (limb_t v : {1ULL, 2ULL, 3ULL, 977ULL, 999999ULL}) {
+            const uint256 x(v);
+            const uint256 inv = uint256::modinv_ct(x, mod);
+            EXPECT_EQ((x.to_integer() * inv.to_integer()) % mod.to_integer(), 1);
+            EXPECT_LT(inv, mod);
+        }
+        const uint256 top = mod - uint256(1);
+        EXPECT_EQ(uint256::modinv_ct(top, mod), top);
+    }
+}
+
+// built by the compiler: each static_assert only compiles if the literal does
+TEST(Uint256Test, Literals) {
+    constexpr uint256 g = 0x79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798_u256;
+    static_assert(g.limb[0] == 0x59F2815B16F81798 && g.limb[3] == 0x79BE667EF9DCBBAC, "hex literal");
+    static_assert((0x79be667e'f9dcbbac_u256).limb[0] == 0x79be667ef9dcbbac, "separators and lower case");
+    static_assert((1000000000000000000000000_u256).limb[1] == 54210 &&
+                  (1000000000000000000000000_u256).limb[0] == 2003764205206896640ULL, "decimal literal");
+    static_assert((0b101_u256).limb[0] == 5 && (017_u256).limb[0] == 15 && (0_u256).is_zero(), "binary and octal");
+    static_assert("79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798"_hex == g, "hex string");
+    static_assert("0x79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798"_hex == g, "prefixed hex string");
+
+    EXPECT_EQ(g.to_integer(), integer("79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798", 16));
+    EXPECT_EQ((0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF_u256).to_integer(), (integer(1) << 256) - 1);
+    // past 256 bits, or a digit outside the base, throws when run
+    EXPECT_THROW(parse_fixed_uint <4> ("10000000000000000000000000000000000000000000000000000000000000000", 65, 16),
+                 std::out_of_range);
+    EXPECT_THROW(parse_fixed_uint <4> ("12g4", 4, 16), std::invalid_argument);
+    EXPECT_THROW(parse_fixed_uint <4> ("129", 3, 8), std::invalid_argument);
+}
@@ -0,0 +1,34 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_TEST_ARITH_H
+#define ECC_TEST_ARITH_H
+
+#include <cstddef>
+
+#include "BarrettReducer.h"
+#include "integer.h"
+#include "modexp.h"
+#include "uint256.h"
+
+// g^e mod p by sliding windows over Barrett products, the reference the
+// modular exponentiations are checked against
+inline integer reference_pow(const integer& g, const integer& e, const integer& p) {
+    const BarrettReducer reducer(p);
+    return sliding_window_pow(reducer.reduce(g), e, reducer.reduce(1),
+            [&reducer](const integer& x, const integer& y) { return reducer.mul(x, y); });
+}
+
+// the low limbs of a 512-bit value filled from a 64-bit LCG started at seed,
+// zeros above: wide products and reductions without a random source
+inline uint512 pattern512(limb_t seed, std::size_t limbs = 8) {
+    uint512 out(0);
+    for (std::size_t i = 0; i < limbs; i++) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        out.limb[i] = seed;
+    }
+    return out;
+}
+
+#endif //ECC_TEST_ARITH_H
@@ -0,0 +1,17 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_TEST_FILES_H
+#define ECC_TEST_FILES_H
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+// name in the directory gtest gives tests for their files
+inline std::string temp_path(const char* name) {
+    return ::testing::TempDir() + name;
+}
+
+#endif //ECC_TEST_FILES_H
@@ -0,0 +1,35 @@
+//
+// Created by preston on 10/15/2026.
+//
+
+#ifndef ECC_TEST_HEX_H
+#define ECC_TEST_HEX_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "hex.h"
+
+// the hex of the test vectors, through the library's codec
+
+// the 2 len characters of data[0, len), lower case
+inline std::string hex(const uint8_t* data, std::size_t len) {
+    std::string out(2 * len, '\0');
+    hex_encode(data, len, &out[0]);
+    return out;
+}
+
+// the bytes of text in out[0, text.size() / 2); a bad digit fails the test
+inline void unhex(uint8_t* out, const std::string& text) {
+    EXPECT_TRUE(hex_decode(text.data(), text.size(), out) == Status::ok) << text;
+}
+
+inline std::vector<uint8_t> unhex(const std::string& text) {
+    std::vector<uint8_t> out(text.size() / 2);
+    unhex(out.data(), text);
+    return out;
+}
+
+#endif //ECC_TEST_HEX_H
@@ -1,11 +1,492 @@
+// ecc_run: bulk jobs and benchmarks on the batch engines, for qualifying hosts
+// and measuring capacity without a harness of one's own.
+//
+//     ecc_run verify-batch <file> [--chunk N] [--iterations N] [--trace out.json]
+//                             [--checkpoint file]
+//     ecc_run keygen --count N [--scheme secp256k1|p256|schnorr] [--out file]
+//     ecc_run msm-bench [--points N] [--iterations N]
+//     ecc_run field-bench [--count N] [--iterations N]
+//     ecc_run daemon [--name ecc] [--channels N] [--slots N] [--metrics-port N]
+//     ecc_run coordinator <file> [--port N] [--shard N] [--window N] [--attempts N]
+//                                [--timeout N] [--checkpoint file]
+//     ecc_run worker <file> --connect host:port [--chunk N] [--threads N]
+//
+// each of the first four with [--threads N] (all hardware threads by default),
+// printing its throughput and the p50/p90/p99/max of its latencies.
+// verify-batch exits with 1 when a record fails, and every command with 2 on
+// bad arguments or I/O errors. daemon serves ShmClients until SIGINT or SIGTERM,
+// and with --metrics-port the library's metrics (metrics.h) in the Prometheus
+// text format at http://127.0.0.1:N/metrics.
+// coordinator and worker are verify-batch over machines (bulk_cluster.h): the
+// coordinator hands shards of --shard records (262144) to the workers that
+// connect to --port (7426), each with its own copy of the file, and exits as
+// verify-batch once every shard is in. With --checkpoint a coordinator started
+// again skips the shards finished before.
+// --trace writes the spans of the passes as Chrome trace-event JSON, when the
+// library was built with ECC_TRACING (see trace.h). verify-batch with
+// --checkpoint saves its progress there every ten seconds and, run again
+// after being killed, goes on from the last save (bulk_verify_resumable).
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "bulk.h"
+#include "bulk_cluster.h"
+#include "Curve.h"
+#include "daemon.h"
+#include "ecdsa.h"
+#include "Executor.h"
 #include "FieldElement.h"
+#include "metrics.h"
+#include "msm.h"
+#include "schnorr.h"
+#include "sec1.h"
+#include "secure_zero.h"
+#include "trace.h"
 
 using namespace std;
 
-int main() {
-    FieldElement a(2, 31);
-    FieldElement b(2, 31);
-    FieldElement c(15, 31);
+typedef chrono::steady_clock Clock;
+
+static double seconds_since(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+// the --name value options after the command and its positional arguments
+class Options {
+public:
+    Options(int argc, char** argv, int first) {
+        for (int i = first; i < argc; i++) {
+            if (strncmp(argv[i], "--", 2) != 0) {
+                this->positional.push_back(argv[i]);
+            } else if (i + 1 < argc) {
+                this->named[argv[i] + 2] = argv[i + 1];
+                i++;
+            } else {
+                throw invalid_argument(string("Missing value for ") + argv[i]);
+            }
+        }
+    }
+
+    string get(const string& name, const string& fallback) const {
+        const auto it = this->named.find(name);
+        return it == this->named.end() ? fallback : it->second;
+    }
+
+    size_t number(const string& name, size_t fallback) const {
+        const auto it = this->named.find(name);
+        if (it == this->named.end()) {
+            return fallback;
+        }
+        char* end = nullptr;
+        const unsigned long long v = strtoull(it->second.c_str(), &end, 10);
+        if (end == it->second.c_str() || *end != '\0' || v == 0) {
+            throw invalid_argument("--" + name + " needs a positive number");
+        }
+        return static_cast<size_t>(v);
+    }
+
+    vector<string> positional;
+
+private:
+    map<string, string> named;
+};
+
+// --threads threads in all, the calling one included
+static unique_ptr<Executor> make_executor(const Options& options) {
+    const size_t threads = options.number("threads", max(1u, thread::hardware_concurrency()));
+    if (threads == 1) {
+        return unique_ptr<Executor>(new ThreadExecutor(1));
+    }
+    return unique_ptr<Executor>(new WorkStealingPool(static_cast<unsigned>(threads - 1)));
+}
+
+static void report(const char* what, double items, double elapsed, vector<double> latencies, const char* unit) {
+    printf("throughput: %.0f %s/s (%.0f in %.3f s)\n", items / elapsed, what, items, elapsed);
+    if (latencies.empty()) {
+        return;
+    }
+    sort(latencies.begin(), latencies.end());
+    const auto at = [&latencies](double q) {
+        return latencies[min(latencies.size() - 1, static_cast<size_t>(q * latencies.size()))];
+    };
+    printf("latency (%s): p50 %.3f  p90 %.3f  p99 %.3f  max %.3f\n", unit, at(0.50), at(0.90), at(0.99),
+           latencies.back());
+}
+
+// the counts and the first invalid records of result; 1 when any failed
+static int print_result(const string& path, const BulkVerifyResult& result) {
+    printf("%s: %llu records, %llu valid, %zu invalid\n", path.c_str(),
+           static_cast<unsigned long long>(result.records), static_cast<unsigned long long>(result.valid),
+           result.invalid.size());
+    for (size_t i = 0; i < result.invalid.size() && i < 10; i++) {
+        printf("invalid: record %llu\n", static_cast<unsigned long long>(result.invalid[i]));
+    }
+    return result.invalid.empty() ? 0 : 1;
+}
+
+static int verify_batch(const Options& options) {
+    if (options.positional.size() != 1) {
+        throw invalid_argument("verify-batch takes one file");
+    }
+    const BulkFile file(options.positional[0]);
+    const unique_ptr<Executor> executor = make_executor(options);
+    const size_t chunk = options.number("chunk", 16384), iterations = options.number("iterations", 1);
+
+    const string trace = options.get("trace", "");
+    if (!trace.empty()) {
+        Trace::start();
+    }
+
+    BulkVerifyResult result;
+    vector<double> latencies;
+    const Clock::time_point start = Clock::now();
+    const string checkpoint = options.get("checkpoint", "");
+    for (size_t i = 0; i < iterations; i++) {
+        const Clock::time_point t = Clock::now();
+        result = checkpoint.empty() ? bulk_verify(file, *executor, chunk)
+                                    : bulk_verify_resumable(file, checkpoint, *executor, chunk);
+        latencies.push_back(seconds_since(t) * 1e3);
+    }
+    const double elapsed = seconds_since(start);
+    if (!trace.empty()) {
+        Trace::stop();
+        Trace::write_chrome(trace);
+    }
+
+    const int status = print_result(options.positional[0], result);
+    report("records", static_cast<double>(result.records * iterations), elapsed, latencies, "ms per pass");
+    return status;
+}
+
+// keys and signatures over random hashes, for feeding verify-batch. The
+// secrets come from std::random_device and are thrown away: test data only
+static int keygen(const Options& options) {
+    const size_t count = options.number("count", 0);
+    if (count == 0) {
+        throw invalid_argument("keygen needs --count");
+    }
+    const string name = options.get("scheme", "secp256k1"), path = options.get("out", "keys.bulk");
+    BulkScheme scheme;
+    if (name == "secp256k1") {
+        scheme = BulkScheme::ecdsa_secp256k1;
+    } else if (name == "p256") {
+        scheme = BulkScheme::ecdsa_p256;
+    } else if (name == "schnorr") {
+        scheme = BulkScheme::schnorr;
+    } else {
+        throw invalid_argument("Unknown scheme " + name);
+    }
+    const Curve& curve = scheme == BulkScheme::ecdsa_p256 ? Curve::p256() : Curve::secp256k1();
+    const size_t key_size = bulk_key_size(scheme), record_size = bulk_record_size(scheme);
+    const unique_ptr<Executor> executor = make_executor(options);
+
+    vector<uint8_t> records(count * record_size);
+    vector<double> latencies(count);
+    const Clock::time_point start = Clock::now();
+    executor->run(count, [&](size_t i) {
+        random_device random;
+        const auto fill = [&random](uint8_t* out, size_t len) {
+            for (size_t j = 0; j < len; j++) {
+                out[j] = static_cast<uint8_t>(random());
+            }
+        };
+        uint8_t* key = &records[i * record_size];
+        uint8_t* hash = key + key_size;
+        uint8_t* signature = hash + 32;
+        uint8_t secret[32], aux[32];
+        fill(hash, 32);
+        const Clock::time_point t = Clock::now();
+        for (;;) {
+            // a draw not in [1, n) is rejected by signing, and drawn again
+            fill(secret, 32);
+            if (scheme == BulkScheme::schnorr) {
+                fill(aux, 32);
+                if (schnorr_public_key(key, secret) == Status::ok &&
+                    schnorr_sign(signature, hash, 32, secret, aux) == Status::ok) {
+                    break;
+                }
+            } else if (ecdsa_sign(signature, curve, secret, hash, 32) == Status::ok) {
+                const Point q = curve.generator_table().mul(integer::from_bytes(secret, 32));
+                sec1_encode(q, true, key, key_size);
+                break;
+            }
+        }
+        latencies[i] = seconds_since(t) * 1e6;
+        secure_zero(secret, sizeof(secret));
+    });
+    const double elapsed = seconds_since(start);
+
+    BulkWriter writer(path, scheme);
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t* key = &records[i * record_size];
+        writer.add(key, key + key_size, key + key_size + 32);
+    }
+    writer.close();
+    printf("%s: %zu %s records\n", path.c_str(), count, name.c_str());
+    report("keys", static_cast<double>(count), elapsed, latencies, "us per key and signature");
+    return 0;
+}
+
+// multiples of G with random 256-bit scalars, on secp256k1
+static int msm_bench(const Options& options) {
+    const size_t n = options.number("points", 4096), iterations = options.number("iterations", 5);
+    const unique_ptr<Executor> executor = make_executor(options);
+    const Curve& curve = Curve::secp256k1();
+    mt19937_64 random(random_device{}());
+    const auto draw = [&random]() {
+        uint8_t bytes[32];
+        for (uint8_t& b : bytes) {
+            b = static_cast<uint8_t>(random());
+        }
+        return integer::from_bytes(bytes, 32);
+    };
+    vector<integer> scalars;
+    vector<Point> points;
+    for (size_t i = 0; i < n; i++) {
+        scalars.push_back(draw());
+        points.push_back(curve.generator_table().mul(draw()));
+    }
 
+    vector<double> latencies;
+    const Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        const Clock::time_point t = Clock::now();
+        multi_scalar_mul(scalars, points, *executor);
+        latencies.push_back(seconds_since(t) * 1e3);
+    }
+    printf("msm-bench: %zu points, %zu threads\n", n, executor->concurrency());
+    report("points", static_cast<double>(n * iterations), seconds_since(start), latencies, "ms per msm");
     return 0;
 }
+
+// batch inversion of random elements of the secp256k1 field
+static int field_bench(const Options& options) {
+    const size_t n = options.number("count", 1 << 16), iterations = options.number("iterations", 10);
+    const unique_ptr<Executor> executor = make_executor(options);
+    const PrimeField& field = Curve::secp256k1().field();
+    mt19937_64 random(random_device{}());
+    vector<FieldElement> elements;
+    for (size_t i = 0; i < n; i++) {
+        elements.push_back(FieldElement(integer(static_cast<unsigned long long>(random() | 1)), field));
+    }
+
+    vector<double> latencies;
+    const Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        const Clock::time_point t = Clock::now();
+        FieldElement::batch_invert(elements, *executor);
+        latencies.push_back(seconds_since(t) * 1e3);
+    }
+    printf("field-bench: %zu elements, %zu threads\n", n, executor->concurrency());
+    report("inversions", static_cast<double>(n * iterations), seconds_since(start), latencies, "ms per batch");
+    return 0;
+}
+
+static volatile sig_atomic_t stop_requested = 0;
+
+static void request_stop(int) {
+    stop_requested = 1;
+}
+
+// Metrics::global().prometheus() over HTTP on the loopback port, from a thread
+// of its own, for a Prometheus scrape of /metrics; any other path is a 404
+class MetricsEndpoint {
+public:
+    explicit MetricsEndpoint(size_t port) : listener(socket(AF_INET, SOCK_STREAM, 0)), stopping(false) {
+        if (this->listener < 0) {
+            throw runtime_error("Cannot open a socket for metrics");
+        }
+        const int on = 1;
+        setsockopt(this->listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(static_cast<uint16_t>(port));
+        if (port > 65535 || ::bind(this->listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+            || listen(this->listener, 16) != 0) {
+            close(this->listener);
+            throw runtime_error("Cannot listen for metrics on port " + to_string(port));
+        }
+        this->server = thread([this]() { serve(); });
+    }
+
+    ~MetricsEndpoint() {
+        this->stopping = true;
+        this->server.join();
+        close(this->listener);
+    }
+
+private:
+    void serve() {
+        while (!this->stopping) {
+            pollfd ready{this->listener, POLLIN, 0};
+            if (poll(&ready, 1, 100) <= 0) {
+                continue;
+            }
+            const int client = accept(this->listener, nullptr, nullptr);
+            if (client < 0) {
+                continue;
+            }
+            // the request line is all that is read; scrapes send nothing more that matters
+            char request[1024];
+            const ssize_t got = recv(client, request, sizeof(request) - 1, 0);
+            request[got > 0 ? got : 0] = '\0';
+            const bool found = strncmp(request, "GET /metrics ", 13) == 0 || strncmp(request, "GET / ", 6) == 0;
+            const string body = found ? Metrics::global().prometheus() : "not found\n";
+            const string response = string(found ? "HTTP/1.0 200 OK\r\n" : "HTTP/1.0 404 Not Found\r\n")
+                                    + "Content-Type: text/plain; version=0.0.4\r\nContent-Length: "
+                                    + to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+            for (size_t sent = 0; sent < response.size();) {
+                const ssize_t n = send(client, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+                if (n <= 0) {
+                    break;
+                }
+                sent += static_cast<size_t>(n);
+            }
+            close(client);
+        }
+    }
+
+    int listener;
+    atomic<bool> stopping;
+    thread server;
+};
+
+// the tables built once, then requests served from shared memory
+static int run_daemon(const Options& options) {
+    const string name = options.get("name", "ecc");
+    const size_t channels = options.number("channels", 4), slots = options.number("slots", 1024);
+    signal(SIGINT, request_stop);
+    signal(SIGTERM, request_stop);
+    uint64_t served;
+    {
+        unique_ptr<MetricsEndpoint> metrics;
+        if (options.number("metrics-port", 0) != 0) {
+            metrics.reset(new MetricsEndpoint(options.number("metrics-port", 0)));
+        }
+        ShmServer server(name, channels, slots);
+        printf("daemon: serving /%s.0 .. /%s.%zu\n", name.c_str(), name.c_str(), channels - 1);
+        fflush(stdout);
+        while (!stop_requested) {
+            this_thread::sleep_for(chrono::milliseconds(100));
+        }
+        served = server.served();
+    }
+    printf("daemon: %llu requests served\n", static_cast<unsigned long long>(served));
+    return 0;
+}
+
+static int coordinator(const Options& options) {
+    if (options.positional.size() != 1) {
+        throw invalid_argument("coordinator takes one file");
+    }
+    const BulkFile file(options.positional[0]);
+    BulkClusterOptions cluster;
+    cluster.shard_records = options.number("shard", cluster.shard_records);
+    cluster.window = options.number("window", cluster.window);
+    cluster.attempts = static_cast<unsigned>(options.number("attempts", cluster.attempts));
+    cluster.timeout = static_cast<unsigned>(options.number("timeout", cluster.timeout));
+    cluster.checkpoint = options.get("checkpoint", "");
+    const size_t port = options.number("port", 7426);
+    if (port > 65535) {
+        throw invalid_argument("--port needs a port number");
+    }
+    BulkCoordinator coordinator(file, static_cast<uint16_t>(port), cluster);
+    printf("coordinator: %llu shards (%llu from the checkpoint), listening on port %u\n",
+           static_cast<unsigned long long>(coordinator.shards()), static_cast<unsigned long long>(coordinator.resumed()),
+           static_cast<unsigned>(coordinator.port()));
+    fflush(stdout);
+    const Clock::time_point start = Clock::now();
+    const BulkVerifyResult result = coordinator.run();
+    const int status = print_result(options.positional[0], result);
+    report("records", static_cast<double>(result.records), seconds_since(start), {}, "");
+    return status;
+}
+
+static int worker(const Options& options) {
+    if (options.positional.size() != 1) {
+        throw invalid_argument("worker takes one file");
+    }
+    const string address = options.get("connect", "");
+    const size_t colon = address.rfind(':');
+    if (colon == string::npos || colon == 0) {
+        throw invalid_argument("worker needs --connect host:port");
+    }
+    const string host = address.substr(0, colon), port = address.substr(colon + 1);
+    char* end = nullptr;
+    const unsigned long number = strtoul(port.c_str(), &end, 10);
+    if (port.empty() || *end != '\0' || number == 0 || number > 65535) {
+        throw invalid_argument("worker needs --connect host:port");
+    }
+    const BulkFile file(options.positional[0]);
+    const unique_ptr<Executor> executor = make_executor(options);
+    const Clock::time_point start = Clock::now();
+    const uint64_t shards = bulk_worker(file, host, static_cast<uint16_t>(number), *executor,
+                                        options.number("chunk", 16384));
+    printf("worker: %llu shards verified in %.3f s\n", static_cast<unsigned long long>(shards),
+           seconds_since(start));
+    return 0;
+}
+
+static void usage() {
+    fprintf(stderr,
+            "usage: ecc_run verify-batch <file> [--chunk N] [--iterations N] [--trace out.json] [--checkpoint file]"
+            " [--threads N]\n"
+            "       ecc_run keygen --count N [--scheme secp256k1|p256|schnorr] [--out file] [--threads N]\n"
+            "       ecc_run msm-bench [--points N] [--iterations N] [--threads N]\n"
+            "       ecc_run field-bench [--count N] [--iterations N] [--threads N]\n"
+            "       ecc_run daemon [--name ecc] [--channels N] [--slots N] [--metrics-port N]\n"
+            "       ecc_run coordinator <file> [--port N] [--shard N] [--window N] [--attempts N] [--timeout N]"
+            " [--checkpoint file]\n"
+            "       ecc_run worker <file> --connect host:port [--chunk N] [--threads N]\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage();
+        return 2;
+    }
+    const string command = argv[1];
+    try {
+        const Options options(argc, argv, 2);
+        if (command == "verify-batch") {
+            return verify_batch(options);
+        } else if (command == "keygen") {
+            return keygen(options);
+        } else if (command == "msm-bench") {
+            return msm_bench(options);
+        } else if (command == "field-bench") {
+            return field_bench(options);
+        } else if (command == "daemon") {
+            return run_daemon(options);
+        } else if (command == "coordinator") {
+            return coordinator(options);
+        } else if (command == "worker") {
+            return worker(options);
+        }
+    } catch (const exception& e) {
+        fprintf(stderr, "ecc_run %s: %s\n", command.c_str(), e.what());
+        return 2;
+    }
+    usage();
+    return 2;
+}
@@ -0,0 +1,400 @@
+//
+// Created by preston on 10/15/2026.
+//
+// The ecc Python module: the batch entry points of ecc.h over the buffer
+// protocol, so bytes, bytearray, memoryview and contiguous NumPy arrays go in
+// and out without a copy and without one Python object per element. A batch
+// is flat fixed-width encodings as ecc.h lays them out; each call holds its
+// buffers, so they cannot be resized under it, and releases the GIL while
+// the library works.
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ecc.h"
+
+namespace {
+
+PyObject* error_type = nullptr;
+
+// a buffer held for the length of a call, released on the way out
+class Buffer {
+public:
+    Buffer() = default;
+    Buffer(const Buffer&) = delete;
+    Buffer& operator=(const Buffer&) = delete;
+    ~Buffer() {
+        if (this->held) {
+            PyBuffer_Release(&this->view);
+        }
+    }
+
+    // obj's bytes, C-contiguous, writable when asked; false with a TypeError
+    // set (by the buffer protocol) when obj cannot give them
+    bool acquire(PyObject* obj, bool writable) {
+        this->held = PyObject_GetBuffer(obj, &this->view, writable ? PyBUF_C_CONTIGUOUS | PyBUF_WRITABLE
+                                                                   : PyBUF_C_CONTIGUOUS) == 0;
+        return this->held;
+    }
+    bool acquired() const { return this->held; }
+    const uint8_t* data() const { return static_cast<const uint8_t*>(this->view.buf); }
+    uint8_t* mutable_data() { return static_cast<uint8_t*>(this->view.buf); }
+    std::size_t size() const { return static_cast<std::size_t>(this->view.len); }
+
+private:
+    Py_buffer view{};
+    bool held = false;
+};
+
+// ecc.Error(message, status) for a status other than ECC_OK; null to return
+PyObject* raise(int status) {
+    PyObject* args = Py_BuildValue("(si)", ecc_status_name(status), status);
+    if (args) {
+        PyErr_SetObject(error_type, args);
+        Py_DECREF(args);
+    }
+    return nullptr;
+}
+
+PyObject* raise_size(const char* what) {
+    PyErr_Format(PyExc_ValueError, "%s has the wrong size for the batch", what);
+    return nullptr;
+}
+
+// where a call writes size bytes: out when given, which must be that size,
+// else a new bytes object that result takes
+uint8_t* output(PyObject* out, Buffer& buffer, std::size_t size, PyObject*& result) {
+    if (out && out != Py_None) {
+        if (!buffer.acquire(out, true)) {
+            return nullptr;
+        }
+        if (buffer.size() != size) {
+            raise_size("out");
+            return nullptr;
+        }
+        Py_INCREF(out);
+        result = out;
+        return buffer.mutable_data();
+    }
+    result = PyBytes_FromStringAndSize(nullptr, static_cast<Py_ssize_t>(size));
+    return result ? reinterpret_cast<uint8_t*>(PyBytes_AS_STRING(result)) : nullptr;
+}
+
+// result on ECC_OK, else it is dropped and ecc.Error raised
+PyObject* finish(int status, PyObject* result) {
+    if (status != ECC_OK) {
+        Py_DECREF(result);
+        return raise(status);
+    }
+    return result;
+}
+
+std::size_t key_size(int scheme) {
+    return scheme == ECC_SCHNORR ? 32 : 33;
+}
+
+PyObject* status_name(PyObject*, PyObject* args) {
+    int status;
+    if (!PyArg_ParseTuple(args, "i", &status)) {
+        return nullptr;
+    }
+    return PyUnicode_FromString(ecc_status_name(status));
+}
+
+// verify_batch(scheme, keys, messages, signatures, results=None, threads=0) -> status
+PyObject* verify_batch(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"scheme", "keys", "messages", "signatures", "results", "threads", nullptr};
+    int scheme;
+    PyObject *keys_obj, *messages_obj, *signatures_obj, *results_obj = nullptr;
+    unsigned threads = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "iOOO|OI", const_cast<char**>(keywords), &scheme, &keys_obj,
+                                     &messages_obj, &signatures_obj, &results_obj, &threads)) {
+        return nullptr;
+    }
+    Buffer keys, messages, signatures, results;
+    if (!keys.acquire(keys_obj, false) || !messages.acquire(messages_obj, false)
+        || !signatures.acquire(signatures_obj, false)) {
+        return nullptr;
+    }
+    const std::size_t count = signatures.size() / 64;
+    if (signatures.size() % 64 || keys.size() != count * key_size(scheme)
+        || (count ? messages.size() % count : messages.size())) {
+        return raise_size("keys, messages or signatures");
+    }
+    const std::size_t message_len = count ? messages.size() / count : 0;
+    if (results_obj && results_obj != Py_None) {
+        if (!results.acquire(results_obj, true)) {
+            return nullptr;
+        }
+        if (results.size() != count * sizeof(int32_t)) {
+            return raise_size("results");
+        }
+    }
+    int status;
+    Py_BEGIN_ALLOW_THREADS
+    status = ecc_verify_batch(scheme, count, keys.data(), messages.data(), message_len, signatures.data(),
+                              results.acquired() ? reinterpret_cast<int32_t*>(results.mutable_data()) : nullptr,
+                              threads);
+    Py_END_ALLOW_THREADS
+    return PyLong_FromLong(status);
+}
+
+// sign_batch(scheme, secrets, messages, aux=None, out=None, threads=0) -> signatures
+PyObject* sign_batch(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"scheme", "secrets", "messages", "aux", "out", "threads", nullptr};
+    int scheme;
+    PyObject *secrets_obj, *messages_obj, *aux_obj = nullptr, *out_obj = nullptr;
+    unsigned threads = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "iOO|OOI", const_cast<char**>(keywords), &scheme, &secrets_obj,
+                                     &messages_obj, &aux_obj, &out_obj, &threads)) {
+        return nullptr;
+    }
+    Buffer secrets, messages, aux, out;
+    if (!secrets.acquire(secrets_obj, false) || !messages.acquire(messages_obj, false)) {
+        return nullptr;
+    }
+    const std::size_t count = secrets.size() / 32;
+    if (secrets.size() % 32 || (count ? messages.size() % count : messages.size())) {
+        return raise_size("secrets or messages");
+    }
+    if (aux_obj && aux_obj != Py_None) {
+        if (!aux.acquire(aux_obj, false)) {
+            return nullptr;
+        }
+        if (aux.size() != count * 32) {
+            return raise_size("aux");
+        }
+    }
+    PyObject* result;
+    uint8_t* signatures = output(out_obj, out, count * 64, result);
+    if (!signatures) {
+        return nullptr;
+    }
+    int status;
+    Py_BEGIN_ALLOW_THREADS
+    status = ecc_sign_batch(scheme, count, secrets.data(), messages.data(), count ? messages.size() / count : 0,
+                            aux.acquired() ? aux.data() : nullptr, signatures, nullptr, threads);
+    Py_END_ALLOW_THREADS
+    return finish(status, result);
+}
+
+// msm(curve, scalars, points, threads=0) -> the compressed sum, b"\x00" at infinity
+PyObject* msm(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"curve", "scalars", "points", "threads", nullptr};
+    int curve;
+    PyObject *scalars_obj, *points_obj;
+    unsigned threads = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "iOO|I", const_cast<char**>(keywords), &curve, &scalars_obj,
+                                     &points_obj, &threads)) {
+        return nullptr;
+    }
+    Buffer scalars, points;
+    if (!scalars.acquire(scalars_obj, false) || !points.acquire(points_obj, false)) {
+        return nullptr;
+    }
+    const std::size_t count = points.size() / 33;
+    if (points.size() % 33 || scalars.size() != count * 32) {
+        return raise_size("scalars or points");
+    }
+    uint8_t sum[33];
+    int status;
+    Py_BEGIN_ALLOW_THREADS
+    status = ecc_msm(curve, count, scalars.data(), points.data(), sum, threads);
+    Py_END_ALLOW_THREADS
+    if (status == ECC_INFINITY) {
+        return PyBytes_FromStringAndSize("", 1);
+    }
+    if (status != ECC_OK) {
+        return raise(status);
+    }
+    return PyBytes_FromStringAndSize(reinterpret_cast<const char*>(sum), sizeof(sum));
+}
+
+// the element-wise field batches: f(curve, a, b, out=None[, threads=0]) -> out
+template<class Call>
+PyObject* field_binary(PyObject* args, PyObject* kwargs, bool with_threads, Call call) {
+    static const char* keywords[] = {"curve", "a", "b", "out", "threads", nullptr};
+    int curve;
+    PyObject *a_obj, *b_obj, *out_obj = nullptr;
+    unsigned threads = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, with_threads ? "iOO|OI" : "iOO|O", const_cast<char**>(keywords),
+                                     &curve, &a_obj, &b_obj, &out_obj, &threads)) {
+        return nullptr;
+    }
+    Buffer a, b, out;
+    if (!a.acquire(a_obj, false) || !b.acquire(b_obj, false)) {
+        return nullptr;
+    }
+    if (a.size() % 32 || b.size() != a.size()) {
+        return raise_size("a or b");
+    }
+    PyObject* result;
+    uint8_t* target = output(out_obj, out, a.size(), result);
+    if (!target) {
+        return nullptr;
+    }
+    int status;
+    Py_BEGIN_ALLOW_THREADS
+    status = call(curve, a.size() / 32, a.data(), b.data(), target, threads);
+    Py_END_ALLOW_THREADS
+    return finish(status, result);
+}
+
+PyObject* field_mul(PyObject*, PyObject* args, PyObject* kwargs) {
+    return field_binary(args, kwargs, true, ecc_field_batch_mul);
+}
+
+PyObject* field_add(PyObject*, PyObject* args, PyObject* kwargs) {
+    return field_binary(args, kwargs, false,
+                        [](int curve, std::size_t count, const uint8_t* a, const uint8_t* b, uint8_t* out, unsigned) {
+                            return ecc_field_batch_add(curve, count, a, b, out);
+                        });
+}
+
+PyObject* field_sub(PyObject*, PyObject* args, PyObject* kwargs) {
+    return field_binary(args, kwargs, false,
+                        [](int curve, std::size_t count, const uint8_t* a, const uint8_t* b, uint8_t* out, unsigned) {
+                            return ecc_field_batch_sub(curve, count, a, b, out);
+                        });
+}
+
+// field_inverse(curve, a, out=None) -> out
+PyObject* field_inverse(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"curve", "a", "out", nullptr};
+    int curve;
+    PyObject *a_obj, *out_obj = nullptr;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "iO|O", const_cast<char**>(keywords), &curve, &a_obj,
+                                     &out_obj)) {
+        return nullptr;
+    }
+    Buffer a, out;
+    if (!a.acquire(a_obj, false)) {
+        return nullptr;
+    }
+    if (a.size() % 32) {
+        return raise_size("a");
+    }
+    PyObject* result;
+    uint8_t* target = output(out_obj, out, a.size(), result);
+    if (!target) {
+        return nullptr;
+    }
+    int status;
+    Py_BEGIN_ALLOW_THREADS
+    status = ecc_field_batch_inverse(curve, a.size() / 32, a.data(), target);
+    Py_END_ALLOW_THREADS
+    return finish(status, result);
+}
+
+// sha256(data, length, out=None) and tagged_hash(tag, data, length, out=None):
+// the digests of the len(data) / length messages of length bytes in data
+PyObject* hash_batch(PyObject* args, PyObject* kwargs, bool tagged) {
+    static const char* plain_keywords[] = {"data", "length", "out", nullptr};
+    static const char* tagged_keywords[] = {"tag", "data", "length", "out", nullptr};
+    PyObject *tag_obj = nullptr, *data_obj, *out_obj = nullptr;
+    Py_ssize_t length;
+    const bool parsed = tagged
+            ? PyArg_ParseTupleAndKeywords(args, kwargs, "OOn|O", const_cast<char**>(tagged_keywords), &tag_obj,
+                                          &data_obj, &length, &out_obj)
+            : PyArg_ParseTupleAndKeywords(args, kwargs, "On|O", const_cast<char**>(plain_keywords), &data_obj,
+                                          &length, &out_obj);
+    if (!parsed) {
+        return nullptr;
+    }
+    Buffer tag, data, out;
+    if ((tagged && !tag.acquire(tag_obj, false)) || !data.acquire(data_obj, false)) {
+        return nullptr;
+    }
+    const std::size_t len = static_cast<std::size_t>(length);
+    if (length < 0 || (len ? data.size() % len : data.size())) {
+        return raise_size("data");
+    }
+    const std::size_t count = len ? data.size() / len : 0;
+    PyObject* result;
+    uint8_t* digests = output(out_obj, out, count * 32, result);
+    if (!digests) {
+        return nullptr;
+    }
+    int status;
+    Py_BEGIN_ALLOW_THREADS
+    status = tagged ? ecc_tagged_hash_batch(tag.data(), tag.size(), count, data.data(), len, digests)
+                    : ecc_sha256_batch(count, data.data(), len, digests);
+    Py_END_ALLOW_THREADS
+    return finish(status, result);
+}
+
+PyObject* sha256(PyObject*, PyObject* args, PyObject* kwargs) {
+    return hash_batch(args, kwargs, false);
+}
+
+PyObject* tagged_hash(PyObject*, PyObject* args, PyObject* kwargs) {
+    return hash_batch(args, kwargs, true);
+}
+
+PyMethodDef methods[] = {
+        {"status_name", status_name, METH_VARARGS, "status_name(status) -> the name of an ecc status"},
+        {"verify_batch", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(verify_batch)),
+                METH_VARARGS | METH_KEYWORDS,
+                "verify_batch(scheme, keys, messages, signatures, results=None, threads=0) -> status\n"
+                "ecc_verify_batch; results, if given, a writable buffer of one int32 per signature"},
+        {"sign_batch", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(sign_batch)),
+                METH_VARARGS | METH_KEYWORDS,
+                "sign_batch(scheme, secrets, messages, aux=None, out=None, threads=0) -> signatures"},
+        {"msm", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(msm)), METH_VARARGS | METH_KEYWORDS,
+                "msm(curve, scalars, points, threads=0) -> the compressed sum, b'\\x00' at infinity"},
+        {"field_mul", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(field_mul)),
+                METH_VARARGS | METH_KEYWORDS, "field_mul(curve, a, b, out=None, threads=0) -> a * b element-wise"},
+        {"field_add", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(field_add)),
+                METH_VARARGS | METH_KEYWORDS, "field_add(curve, a, b, out=None) -> a + b element-wise"},
+        {"field_sub", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(field_sub)),
+                METH_VARARGS | METH_KEYWORDS, "field_sub(curve, a, b, out=None) -> a - b element-wise"},
+        {"field_inverse", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(field_inverse)),
+                METH_VARARGS | METH_KEYWORDS, "field_inverse(curve, a, out=None) -> 1 / a element-wise"},
+        {"sha256", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(sha256)),
+                METH_VARARGS | METH_KEYWORDS, "sha256(data, length, out=None) -> the digest of every message"},
+        {"tagged_hash", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(tagged_hash)),
+                METH_VARARGS | METH_KEYWORDS,
+                "tagged_hash(tag, data, length, out=None) -> the BIP340 tagged hash of every message"},
+        {nullptr, nullptr, 0, nullptr}
+};
+
+PyModuleDef module = {
+        PyModuleDef_HEAD_INIT, "ecc",
+        "Batch elliptic curve primitives over the buffer protocol (the C ABI of ecc.h)",
+        -1, methods, nullptr, nullptr, nullptr, nullptr
+};
+
+}
+
+PyMODINIT_FUNC PyInit_ecc() {
+    PyObject* m = PyModule_Create(&module);
+    if (!m) {
+        return nullptr;
+    }
+    error_type = PyErr_NewExceptionWithDoc("ecc.Error", "a batch call failed: (status name, status)",
+                                           PyExc_ValueError, nullptr);
+    if (!error_type || PyModule_AddObject(m, "Error", error_type) < 0) {
+        Py_XDECREF(error_type);
+        Py_DECREF(m);
+        return nullptr;
+    }
+    Py_INCREF(error_type);
+    const struct {
+        const char* name;
+        int value;
+    } constants[] = {
+            {"ECDSA_SECP256K1", ECC_ECDSA_SECP256K1}, {"ECDSA_P256", ECC_ECDSA_P256}, {"SCHNORR", ECC_SCHNORR},
+            {"SECP256K1", ECC_SECP256K1}, {"P256", ECC_P256}, {"OK", ECC_OK},
+            {"BAD_SIGNATURE", ECC_BAD_SIGNATURE}, {"ABI_VERSION", ECC_ABI_VERSION},
+    };
+    for (const auto& c : constants) {
+        if (PyModule_AddIntConstant(m, c.name, c.value) < 0) {
+            Py_DECREF(m);
+            return nullptr;
+        }
+    }
+    return m;
+}
@@ -0,0 +1,86 @@
+#
+# Created by preston on 10/15/2026.
+#
+# The ecc module against Python's own arithmetic and hashlib; run from a
+# build with -DECC_PYTHON=ON as PYTHONPATH=<build>/python python3 test_ecc.py
+
+import array
+import hashlib
+import unittest
+
+import ecc
+
+P = 2 ** 256 - 2 ** 32 - 977
+G = bytes.fromhex("0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798")
+G3 = bytes.fromhex("02f9308a019258c31049344f85f89d5229b531c845836f99b08601f113bce036f9")
+
+
+def elements(values):
+    return b"".join(v.to_bytes(32, "little") for v in values)
+
+
+def values(data):
+    return [int.from_bytes(data[i:i + 32], "little") for i in range(0, len(data), 32)]
+
+
+class EccTest(unittest.TestCase):
+    def test_sign_and_verify(self):
+        count = 16
+        secrets = b"".join((i + 1).to_bytes(32, "big") for i in range(count))
+        messages = b"".join(hashlib.sha256(bytes([i])).digest() for i in range(count))
+        for scheme, key_size in ((ecc.SCHNORR, 32), (ecc.ECDSA_SECP256K1, 33)):
+            signatures = bytearray(ecc.sign_batch(scheme, secrets, messages))
+            self.assertEqual(len(signatures), 64 * count)
+            # the keys as the sum of one term, secret * G
+            keys = b"".join(ecc.msm(ecc.SECP256K1, secrets[32 * i:32 * i + 32], G) for i in range(count))
+            if key_size == 32:
+                keys = b"".join(keys[33 * i + 1:33 * i + 33] for i in range(count))
+            results = array.array("i", [-1] * count)
+            self.assertEqual(ecc.verify_batch(scheme, keys, memoryview(messages), signatures, results=results),
+                             ecc.OK)
+            self.assertEqual(list(results), [ecc.OK] * count)
+            signatures[64 * 3 + 40] ^= 1
+            self.assertEqual(ecc.verify_batch(scheme, keys, messages, signatures, results=results, threads=2),
+                             ecc.BAD_SIGNATURE)
+            self.assertEqual(results[3], ecc.BAD_SIGNATURE)
+        with self.assertRaises(ValueError):
+            ecc.verify_batch(ecc.SCHNORR, b"\0" * 31, messages[:32], bytes(64))
+
+    def test_msm(self):
+        scalars = (1).to_bytes(32, "big") + (2).to_bytes(32, "big")
+        self.assertEqual(ecc.msm(ecc.SECP256K1, scalars, G + G, threads=1), G3)
+        self.assertEqual(ecc.msm(ecc.SECP256K1, b"", b""), b"\x00")
+        with self.assertRaises(ecc.Error) as raised:
+            ecc.msm(ecc.SECP256K1, scalars, G + b"\x05" + G[1:])
+        self.assertEqual(raised.exception.args[0], "bad_encoding")
+
+    def test_field(self):
+        a = [(3 * i + 1) * 0x1234567 % P for i in range(50)]
+        b = [P - 1 - 7 * i for i in range(50)]
+        self.assertEqual(values(ecc.field_mul(ecc.SECP256K1, elements(a), elements(b))),
+                         [x * y % P for x, y in zip(a, b)])
+        self.assertEqual(values(ecc.field_add(ecc.SECP256K1, elements(a), elements(b))),
+                         [(x + y) % P for x, y in zip(a, b)])
+        self.assertEqual(values(ecc.field_sub(ecc.SECP256K1, elements(a), elements(b))),
+                         [(x - y) % P for x, y in zip(a, b)])
+        out = bytearray(32 * len(a))
+        self.assertIs(ecc.field_inverse(ecc.SECP256K1, elements(a), out=out), out)
+        self.assertEqual(values(out), [pow(x, P - 2, P) for x in a])
+        with self.assertRaises(ecc.Error):
+            ecc.field_inverse(ecc.SECP256K1, elements([0] + a))
+        with self.assertRaises(ecc.Error):
+            ecc.field_mul(ecc.SECP256K1, elements([P]), elements([1]))
+
+    def test_hashes(self):
+        data = bytes(range(256)) * 3
+        digests = ecc.sha256(data, 48)
+        self.assertEqual(digests, b"".join(hashlib.sha256(data[i:i + 48]).digest() for i in range(0, len(data), 48)))
+        tag = hashlib.sha256(b"BIP0340/challenge").digest()
+        self.assertEqual(ecc.tagged_hash(b"BIP0340/challenge", data, 96),
+                         b"".join(hashlib.sha256(tag + tag + data[i:i + 96]).digest()
+                                  for i in range(0, len(data), 96)))
+        self.assertEqual(ecc.sha256(b"", 32), b"")
+
+
+if __name__ == "__main__":
+    unittest.main()